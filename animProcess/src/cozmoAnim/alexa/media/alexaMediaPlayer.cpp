@@ -38,6 +38,7 @@ TODO (VIC-9853): re-implement this properly. I think it should more closely rese
 #include "attachmentReader.h"
 #include "streamReader.h"
 
+#include "audioEngine/audioTools/pcmBufferPool.h"
 #include "audioEngine/audioTypeTranslator.h"
 #include "audioEngine/plugins/ankiPluginInterface.h"
 #include "audioEngine/plugins/streamingWavePortalPlugIn.h"
@@ -69,6 +70,7 @@ TODO (VIC-9853): re-implement this properly. I think it should more closely rese
 #include <fcntl.h>
 #include <unistd.h>
 #include <array>
+#include <cstring>
 
 namespace Anki {
 namespace Vector {
@@ -173,7 +175,8 @@ AlexaMediaPlayer::AlexaMediaPlayer( Type type,
   , _playableClip( AudioEngine::kInvalidAudioEventId )
   , _mp3Buffer( new Util::RingBuffContiguousRead<uint8_t>{ kAudioBufferSize, kMaxReadSize } )
   , _dataValidity{ DataValidity::Unknown }
-  , _dispatchQueue(Util::Dispatch::Create(("APlayer_" + sAudioInfo.at(type).name).c_str()))
+  // decoding runs ahead of playback, so it can yield to the animation and mic threads
+  , _dispatchQueue(Util::Dispatch::Create(("APlayer_" + sAudioInfo.at(type).name).c_str(), Util::ThreadPriority::Low))
   , _contentFetcherFactory( contentFetcherFactory )
   , _audioInfo( sAudioInfo.at(_type) )
   , _shuttingDown( false )
@@ -554,6 +557,7 @@ bool AlexaMediaPlayer::play( SourceId id )
     _attemptedDecodeBytes = 0;
     _invalidFrames = 0;
     _mp3Buffer->Reset();
+    _decodedPcm.reset();
     
     mpg123_open_feed( _decoderHandle );
     if( _decoderHandle == nullptr ) {
@@ -573,10 +577,6 @@ bool AlexaMediaPlayer::play( SourceId id )
       plugin->AddDataInstance( _waveData, _audioInfo.pluginId );
     }
 
-    // buffer to read mp3 data from source. this is an unnecessary copy if RingBuffContiguousRead had a
-    // raw writable pointer
-    std::array<uint8_t,kDownloadSize> input;
-
     int numBlocks = 0;
     const int kMaxBlocks = 10000; // number of times we can try to check a blocking reader before giving up
 
@@ -624,14 +624,17 @@ bool AlexaMediaPlayer::play( SourceId id )
         const auto numUnreadInStream = reader->GetNumUnreadBytes();
         // it's possible that size==0 if the download hasn't started. ignore size for now, and try reading below,
         // and use the readStatus of that to determine what to do
-        const size_t toReadFromStream = (numUnreadInStream == 0) ? input.size() : std::min(numUnreadInStream, input.size());
+        const size_t toReadFromStream = (numUnreadInStream == 0) ? kDownloadSize : std::min(numUnreadInStream, kDownloadSize);
         if( spaceForWrite < toReadFromStream ) {
           break;
         }
-        const auto bytesRead = reader->Read( input.data(), toReadFromStream, readStatus );
+        // read straight into the ring. Its write space stops at the end of the ring, so a read that would wrap
+        // is cut short there, and the rest is read on the next pass
+        size_t contiguousSpace = 0;
+        uint8_t* writeData = _mp3Buffer->GetWriteData( contiguousSpace );
+        const auto bytesRead = reader->Read( writeData, std::min(toReadFromStream, contiguousSpace), readStatus );
         if( bytesRead > 0 ) {
-          // this won't add if there aren't bytesRead available space, hence the compairson to spaceForWrite above
-          _mp3Buffer->AddData( input.data(), (int)bytesRead );
+          _mp3Buffer->CommitData( (unsigned int)bytesRead );
         }
         if( readStatus != AlexaReader::Status::Ok ) {
           // LOG( "source %llu readStatus %s", id, AlexaReader::StatusToString(readStatus) );
@@ -1000,10 +1003,6 @@ int AlexaMediaPlayer::Decode( const StreamingWaveDataPtr& data, bool flush )
   
   _attemptedDecodeBytes += buffSize;
 
-  size_t decodedSize = 0;
-  unsigned char* outBuff = (unsigned char*) _decodedPcm.data();
-  const int outBuffSize = (int)_decodedPcm.size() * sizeof(short);
-  
   int decodeRes = mpg123_feed ( _decoderHandle, inputBuff, buffSize );
   if( decodeRes == MPG123_ERR ) {
     LOG_ERROR( "AlexaMediaPlayer.Decode.FeedError", "decoder error: %s", mpg123_strerror(_decoderHandle) );
@@ -1054,19 +1053,9 @@ int AlexaMediaPlayer::Decode( const StreamingWaveDataPtr& data, bool flush )
         unsigned char* decodedAudio = nullptr;
         size_t frameBytes = 0;
         decodeRes = mpg123_framebyframe_decode( _decoderHandle, &offset, &decodedAudio, &frameBytes );
-        if( decodedSize + frameBytes >= outBuffSize ) {
-          // there's no room in our output buffer. pass it on and start over
-          if( decodedSize > 0 ) {
-            DEV_ASSERT( (decodedSize & 1) == 0, "Should have decoded full shorts" );
-            const size_t shortBytes = decodedSize / sizeof(short); // decoder uses bytes, we use shorts
-            decoded_ms += CopyToWaveData( shortBytes, data, flush );
-          }
-          decodedSize = 0;
+        if( (decodedAudio != nullptr) && (frameBytes > 0) ) {
+          decoded_ms += AppendDecodedFrame( decodedAudio, frameBytes, data, flush );
         }
-        // there should be space now
-        DEV_ASSERT( decodedSize + frameBytes < outBuffSize, "AlexaMediaPlayer.Decode.NoOutputSpace" );
-        std::copy( decodedAudio, decodedAudio + frameBytes, outBuff + decodedSize );
-        decodedSize += frameBytes;
       }
         
     } else if( decodeRes == MPG123_ERR ) {
@@ -1083,53 +1072,75 @@ int AlexaMediaPlayer::Decode( const StreamingWaveDataPtr& data, bool flush )
     LOG_ERROR( "AlexaMediaPlayer.Decode.DataError", "decoder error: %s", mpg123_strerror(_decoderHandle) );
   }
   
-  if( decodedSize > 0 || flush ) {
-    DEV_ASSERT( (decodedSize & 1) == 0, "Should have decoded full shorts" );
-    const size_t shortBytes = decodedSize / sizeof(short); // decoder uses bytes, we use shorts
-    decoded_ms += CopyToWaveData( shortBytes, data, flush );
-  }
+  decoded_ms += CopyToWaveData( data, flush );
   
 
   return int(decoded_ms);
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-float AlexaMediaPlayer::CopyToWaveData( size_t samples, const StreamingWaveDataPtr& waveData, bool flush )
+float AlexaMediaPlayer::AppendDecodedFrame( const unsigned char* frame,
+                                            size_t numBytes,
+                                            const StreamingWaveDataPtr& waveData,
+                                            bool flush )
 {
   using namespace AudioEngine;
   
-  if( samples == 0 ) {
-    return 0;
-  }
+  DEV_ASSERT( (numBytes % sizeof(short)) == 0, "Should have decoded full shorts" );
+  const size_t numShorts = numBytes / sizeof(short); // decoder uses bytes, we use shorts
   
-  // valid wav data!
-  _dataValidity = DataValidity::Valid;
+  // audio engine only supports mono
+  const bool isStereo = (_mediaInfo.channels == 2);
+  const size_t numSamples = isStereo ? (numShorts / 2) : numShorts;
   
-  uint16_t channels = static_cast<uint16_t>( _mediaInfo.channels );
+  float decoded_ms = 0.0f;
+  if( (_decodedPcm != nullptr) && (_decodedPcm->samples.size() + numSamples > kMaxReadSize) ) {
+    // there's no room in our output buffer. pass it on and start over
+    decoded_ms += CopyToWaveData( waveData, flush );
+  }
   
-  if( channels == 2 ) {
-    // audio engine only supports mono. loop through samples and rewrite in the same buffer
-    int j = 0;
-    for( int i=0; i<samples; i += 2, j += 1) {
-      short left = _decodedPcm[i];
-      short right = _decodedPcm[i + 1];
-      short monoSample = (int(left) + right) / 2;
-      _decodedPcm[j] = monoSample;
-    }
-    samples = samples/2;
-    channels = 1;
+  if( _decodedPcm == nullptr ) {
+    const uint16_t channels = isStereo ? 1 : static_cast<uint16_t>( _mediaInfo.channels );
+    _decodedPcm = PcmBufferPool::GetSharedPool()->Acquire( static_cast<uint32_t>(_mediaInfo.sampleRate), channels );
+    _decodedPcm->samples.reserve( kMaxReadSize );
   }
   
-  float decoded_ms = 1000 * float(samples) / _mediaInfo.sampleRate;
+  // the decoder's buffer isn't necessarily aligned for shorts
+  auto& samples = _decodedPcm->samples;
+  const size_t oldSize = samples.size();
+  samples.resize( oldSize + numSamples );
+  if( isStereo ) {
+    short* out = samples.data() + oldSize;
+    for( size_t i=0; i<numSamples; ++i ) {
+      short leftRight[2];
+      memcpy( leftRight, frame + (2 * i * sizeof(short)), sizeof(leftRight) );
+      out[i] = (int(leftRight[0]) + leftRight[1]) / 2;
+    }
+  } else {
+    memcpy( samples.data() + oldSize, frame, numSamples * sizeof(short) );
+  }
   
-  if( samples > 0 ) {
-    SavePCM( _decodedPcm.data(), samples );
+  return decoded_ms;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+float AlexaMediaPlayer::CopyToWaveData( const StreamingWaveDataPtr& waveData, bool flush )
+{
+  if( (_decodedPcm == nullptr) || _decodedPcm->samples.empty() ) {
+    return 0;
   }
   
-  StandardWaveDataContainer waveContainer{ static_cast<uint32_t>(_mediaInfo.sampleRate), channels, samples };
-  waveContainer.CopyWaveData( _decodedPcm.data(), samples );
+  // valid wav data!
+  _dataValidity = DataValidity::Valid;
+  
+  const size_t samples = _decodedPcm->samples.size();
+  float decoded_ms = 1000 * float(samples) / _mediaInfo.sampleRate;
+  
+  SavePCM( _decodedPcm->samples.data(), samples );
   
-  waveData->AppendStandardWaveData( std::move(waveContainer) );
+  // the plugin converts the pooled buffer as it plays, and returns it to the pool once played
+  waveData->AppendPcmBuffer( std::move(_decodedPcm) );
+  _decodedPcm.reset();
   
   const auto numFrames = waveData->GetNumberOfFramesReceived();
   if( (_state == State::Preparing) && ((numFrames >= _minPlaybackBufferSize) || flush) ) {
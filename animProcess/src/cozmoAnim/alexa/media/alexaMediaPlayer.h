@@ -35,6 +35,7 @@ TODO (VIC-9853): re-implement this properly. I think it should more closely rese
 #ifndef ANIMPROCESS_COZMO_ALEXA_ALEXAMEDIAPLAYER_H
 #define ANIMPROCESS_COZMO_ALEXA_ALEXAMEDIAPLAYER_H
 
+#include "audioEngine/audioTools/pcmBufferPool.h"
 #include "audioEngine/audioTools/standardWaveDataContainer.h"
 #include "audioEngine/audioTools/streamingWaveDataInstance.h"
 #include "audioEngine/audioTypes.h"
@@ -168,8 +169,12 @@ private:
   // decodes from _mp3Buffer into data, returns millisec decoded
   int Decode( const StreamingWaveDataPtr& data, bool flush );
   
-  // copied size shorts in _decodedPcm into waveData, returning the number of milliseconds
-  float CopyToWaveData( size_t size, const StreamingWaveDataPtr& waveData, bool flush );
+  // appends one frame of decoded interleaved pcm to _decodedPcm, downmixed to mono if it is stereo. Hands what was
+  // decoded before it to waveData first if the frame wouldn't fit, returning the number of milliseconds handed over
+  float AppendDecodedFrame( const unsigned char* frame, size_t numBytes, const StreamingWaveDataPtr& waveData, bool flush );
+  
+  // hands _decodedPcm over to waveData, returning the number of milliseconds
+  float CopyToWaveData( const StreamingWaveDataPtr& waveData, bool flush );
 
   void CallOnPlaybackFinished( SourceId id, bool runOnCaller = false );
   void CallOnPlaybackError( SourceId id );
@@ -220,7 +225,9 @@ private:
 
   std::map<SourceId, std::unique_ptr< AlexaReader >> _readers;
   static constexpr size_t kMaxReadSize = 16384; // 16k
-  std::array<short,kMaxReadSize> _decodedPcm;
+  // pcm decoded since it was last handed to the wave data. Comes from the shared pool, so once the pool has warmed up
+  // decoding allocates nothing, and the plugin plays the buffer it was decoded into
+  AudioEngine::PcmBufferPtr _decodedPcm;
   
   struct MediaInfo {
     int channels;
@@ -14,6 +14,7 @@
 
 #include "anki/cozmo/shared/cozmoConfig.h"
 
+#include "coretech/messaging/shared/bootStatus.h"
 #include "coretech/messaging/shared/LocalUdpClient.h"
 #include "coretech/messaging/shared/LocalUdpServer.h"
 #include "coretech/messaging/shared/SocketUtils.h"
@@ -58,6 +59,9 @@ namespace { // "Private members"
 
   // For comms with robot
   LocalUdpClient _robotComms;
+
+  // How long to wait for vic-robot to say it's listening before trying to connect anyway
+  constexpr s32 kRobotCommsReadyTimeout_ms = 2000;
 }
 
 
@@ -130,6 +134,15 @@ Result InitRobotComms()
   const std::string & client_path = std::string(ANIM_ROBOT_CLIENT_PATH) + std::to_string(robotID);
   const std::string & server_path = std::string(ANIM_ROBOT_SERVER_PATH) + std::to_string(robotID);
 
+  BootStatus::Clear(BootMilestone::AnimRobotConnected);
+
+  // There's only one connect attempt, so make sure vic-robot is listening first
+  if (BootStatus::IsAvailable() &&
+      !BootStatus::WaitFor(BootMilestone::RobotCommsReady, kRobotCommsReadyTimeout_ms)) {
+    LOG_WARNING("AnimComms.InitRobotComms.RobotNotReady", "No word from vic-robot after %d ms, connecting anyway",
+                kRobotCommsReadyTimeout_ms);
+  }
+
   LOG_INFO("AnimComms.InitRobotComms", "Connect from %s to %s", client_path.c_str(), server_path.c_str());
 
   bool ok = _robotComms.Connect(client_path.c_str(), server_path.c_str());
@@ -139,6 +152,8 @@ Result InitRobotComms()
     return RESULT_FAIL_IO;
   }
 
+  BootStatus::Publish(BootMilestone::AnimRobotConnected);
+
   return RESULT_OK;
 }
 
@@ -147,6 +162,8 @@ Result InitEngineComms()
   const RobotID_t robotID = OSState::getInstance()->GetRobotID();
   const std::string & server_path = std::string(ENGINE_ANIM_SERVER_PATH) + std::to_string(robotID);
 
+  BootStatus::Clear(BootMilestone::AnimEngineCommsReady);
+
   LOG_INFO("AnimComms.InitEngineComms", "Start listening at %s", server_path.c_str());
 
   if (!_engineComms.StartListening(server_path)) {
@@ -154,20 +171,24 @@ Result InitEngineComms()
     return RESULT_FAIL_IO;
   }
 
+  // Lets vic-engine connect as soon as we're listening, rather than on its next retry
+  BootStatus::Publish(BootMilestone::AnimEngineCommsReady);
+
   return RESULT_OK;
 }
 
 Result InitComms()
 {
-  Result result = InitRobotComms();
+  // Engine first, so vic-engine can connect while we wait on vic-robot
+  Result result = InitEngineComms();
   if (RESULT_OK != result) {
-    LOG_ERROR("AnimComms.InitComms", "Unable to init robot comms (result %d)", result);
+    LOG_ERROR("AnimComms.InitComms", "Unable to init engine comms (result %d)", result);
     return result;
   }
 
-  result = InitEngineComms();
+  result = InitRobotComms();
   if (RESULT_OK != result) {
-    LOG_ERROR("AnimComms.InitComms", "Unable to init engine comms (result %d)", result);
+    LOG_ERROR("AnimComms.InitComms", "Unable to init robot comms (result %d)", result);
     return result;
   }
 
@@ -36,10 +36,15 @@
 
 #include "webServerProcess/src/webService.h"
 
+#include "json/json.h"
+
 #include "osState/osState.h"
 
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/logging/logging.h"
+#include "util/math/math.h"
+#include "util/memoryAccounting/memoryAccounting.h"
+#include "util/messageProfiler/messageProfiler.h"
 
 #define LOG_CHANNEL    "AnimEngine"
 #define NUM_ANIM_OPENCV_THREADS 0
@@ -48,8 +53,8 @@ namespace Anki {
 namespace Vector {
 namespace Anim {
 
+CONSOLE_VAR_RANGED(float, kAnimEngine_TimeMax_ms,     ANKI_CPU_CONSOLEVARGROUP, 33, 2, 33);
 #if ANKI_CPU_PROFILER_ENABLED
-  CONSOLE_VAR_RANGED(float, kAnimEngine_TimeMax_ms,     ANKI_CPU_CONSOLEVARGROUP, 33, 2, 33);
   CONSOLE_VAR_ENUM(u8,      kAnimEngine_TimeLogging,    ANKI_CPU_CONSOLEVARGROUP, 0, Util::CpuProfiler::CpuProfilerLogging());
 #endif
 
@@ -65,6 +70,13 @@ AnimEngine::AnimEngine(Util::Data::DataPlatform* dataPlatform)
       dataPlatform->pathToResource(Util::Data::Scope::Cache, "vic-anim-tracing.json").c_str());
   Anki::Util::CpuThreadProfiler::SendToWebVizCallback([&](const Json::Value& json) { _context->GetWebService()->SendToWebViz("cpuprofile", json); });
 #endif
+#if ANKI_CPU_HITCH_RECORDER_ENABLED
+  Anki::Util::CpuHitchRecorder::SetDumpDirectory(
+      dataPlatform->pathToResource(Util::Data::Scope::Cache, "cpuHitches"), "vic-anim");
+#endif
+#if ANKI_MESSAGE_PROFILER_ENABLED
+  Anki::Util::MessageProfiler::SendToWebVizCallback([&](const Json::Value& json) { _context->GetWebService()->SendToWebViz("messageprofile", json); });
+#endif
 
   if (Anki::Util::gTickTimeProvider == nullptr) {
     Anki::Util::gTickTimeProvider = BaseStationTimer::getInstance();
@@ -108,7 +120,10 @@ Result AnimEngine::Init()
 
   RobotDataLoader * dataLoader = _context->GetDataLoader();
   dataLoader->LoadConfigData();
+  // Returns once the critical animations are loaded, the rest keep loading while we start up
   dataLoader->LoadNonConfigData();
+  LOG_INFO("AnimEngine.Init.CriticalAnimationsLoaded", "%zu animations loaded",
+           dataLoader->GetAnimationNames().size());
 
   _ttsComponent = std::make_unique<TextToSpeechComponent>(_context.get());
   _context->GetMicDataSystem()->Init(*dataLoader);
@@ -200,6 +215,12 @@ Result AnimEngine::Update(const BaseStationTime_t currTime_nanosec)
 
   OSState::getInstance()->Update(currTime_nanosec);
 
+  if (!_allAnimationsLoaded && _context->GetDataLoader()->AreAllAnimationsLoaded()) {
+    _allAnimationsLoaded = true;
+    LOG_INFO("AnimEngine.Update.AllAnimationsLoaded", "%zu animations loaded",
+             _context->GetDataLoader()->GetAnimationNames().size());
+  }
+
   _ttsComponent->Update();
 
   // Clear out sprites that have passed their cache time
@@ -224,6 +245,8 @@ Result AnimEngine::Update(const BaseStationTime_t currTime_nanosec)
   // Update backpack lights
   _context->GetBackpackLightComponent()->Update();
 
+  UpdateMemoryAccounting(currTime_nanosec);
+
 #if ANKI_PROFILE_ANIMCOMMS_SOCKET_BUFFER_STATS
   {
     // Update socket buffer counters
@@ -234,6 +257,28 @@ Result AnimEngine::Update(const BaseStationTime_t currTime_nanosec)
   return RESULT_OK;
 }
 
+void AnimEngine::UpdateMemoryAccounting(const BaseStationTime_t currTime_nanosec)
+{
+  // Same cadence as the engine's RobotHealthReporter: webViz every second, new high water marks every minute
+  if (ANKI_DEV_CHEATS && (currTime_nanosec >= _nextMemoryWebVizTime_ns)) {
+    auto* webService = _context->GetWebService();
+    if (webService->IsWebVizClientSubscribed("memory")) {
+      Json::Value toSend;
+      Util::MemoryAccounting::GetStatsAsJson(toSend);
+      webService->SendToWebViz("memory", toSend);
+    }
+    _nextMemoryWebVizTime_ns = currTime_nanosec + static_cast<BaseStationTime_t>(Util::SecToNanoSec(1.0));
+  }
+
+  if (currTime_nanosec >= _nextMemoryReportTime_ns) {
+    if (_nextMemoryReportTime_ns != 0) {
+      // Skip the first tick, loading is still under way
+      Util::MemoryAccounting::ReportNewHighWaterMarks();
+    }
+    _nextMemoryReportTime_ns = currTime_nanosec + static_cast<BaseStationTime_t>(Util::SecToNanoSec(60.0));
+  }
+}
+
 void AnimEngine::RegisterTickPerformance(const float tickDuration_ms,
                                          const float tickFrequency_ms,
                                          const float sleepDurationIntended_ms,
@@ -82,6 +82,7 @@ public:
 protected:
 
   bool                                          _isInitialized = false;
+  bool                                          _allAnimationsLoaded = false;
   std::unique_ptr<AnimContext>                  _context;
   std::unique_ptr<AnimationStreamer>            _animationStreamer;
   std::unique_ptr<StreamingAnimationModifier>   _streamingAnimationModifier;
@@ -90,6 +91,11 @@ protected:
   std::unique_ptr<SdkAudioComponent>            _sdkAudioComponent;
   Audio::CozmoAudioController*                  _audioControllerPtr = nullptr;
   
+  // Animations, sprites and sound banks live in this process, so it reports its own accounted memory
+  void UpdateMemoryAccounting(const BaseStationTime_t currTime_nanosec);
+  BaseStationTime_t                             _nextMemoryWebVizTime_ns = 0;
+  BaseStationTime_t                             _nextMemoryReportTime_ns = 0;
+  
 }; // class AnimEngine
 
 } // namespace Anim
@@ -42,8 +42,10 @@
 #include "clad/robotInterface/messageEngineToRobot_sendAnimToRobot_helper.h"
 
 #include "anki/cozmo/shared/cozmoConfig.h"
+#include "anki/cozmo/shared/engineAnimMessageBatch.h"
 #include "anki/cozmo/shared/factory/emrHelper.h"
 #include "anki/cozmo/shared/factory/faultCodes.h"
+#include "anki/cozmo/shared/robotStateDelta.h"
 
 #include "osState/osState.h"
 
@@ -70,8 +72,9 @@ namespace {
   static const int kNumTicksToShutdown = 5;
   int _countToShutdown = -1;
 
-  // For comms with engine
-  constexpr int MAX_PACKET_BUFFER_SIZE = 2048;
+  // For comms with engine and robot. Engine packets can be a batch of messages
+  constexpr int MAX_PACKET_BUFFER_SIZE = Anki::Vector::kEngineAnimMaxDatagramSize;
+  constexpr int MAX_ROBOT_PACKET_SIZE = 2048;
   u8 pktBuffer_[MAX_PACKET_BUFFER_SIZE];
 
   Anki::Vector::Anim::AnimEngine*             _animEngine = nullptr;
@@ -89,6 +92,10 @@ namespace {
   const float kNoRobotStateDisconnectTimeout_sec = 2.f;
   float _pendingRobotDisconnectTime_sec = -1.f;
 
+  // Compact RobotState datagrams from the robot. They are forwarded to engine as they are, engine decodes its own copy
+  Anki::Vector::RobotStateDeltaDecoder _robotStateDecoder;
+  bool _robotStateDecoderInSync = true;
+
   // Whether or not engine has finished loading and is ready to do things
   bool _engineLoaded = false;
 
@@ -198,6 +205,16 @@ namespace {
 namespace Anki {
 namespace Vector {
 
+namespace {
+  // Tag names for the message profilers
+  const char* sEngineToRobotTagName(int tag) {
+    return RobotInterface::EngineToRobot::TagToString((RobotInterface::EngineToRobot::Tag)tag);
+  }
+  const char* sRobotToEngineTagName(int tag) {
+    return RobotInterface::RobotToEngine::TagToString((RobotInterface::RobotToEngine::Tag)tag);
+  }
+}
+
 // Note that these are send attempt counts, not a count of successful sends
 uint32_t AnimProcessMessages::_messageCountAnimToRobot = 0;
 uint32_t AnimProcessMessages::_messageCountAnimToEngine = 0;
@@ -737,6 +754,19 @@ static void HandleRobotStateUpdate(const Anki::Vector::RobotState& robotState)
 
   FaceInfoScreenManager::getInstance()->Update(robotState);
 
+  const bool onChargerContacts = (robotState.status & (uint32_t)RobotStatusFlag::IS_ON_CHARGER);
+  _animStreamer->SetOnCharger(onChargerContacts);
+  auto* showStreamStateManager = _context->GetShowAudioStreamStateManager();
+  if (showStreamStateManager != nullptr)
+  {
+    showStreamStateManager->SetOnCharger( onChargerContacts );
+  }
+  auto* alexa = _context->GetAlexa();
+  if (alexa != nullptr)
+  {
+    alexa->SetOnCharger( onChargerContacts );
+  }
+
 #if ANKI_DEV_CHEATS
   auto * micDataSystem = _context->GetMicDataSystem();
   if (micDataSystem != nullptr)
@@ -782,19 +812,6 @@ void AnimProcessMessages::ProcessMessageFromRobot(const RobotInterface::RobotToE
     case RobotInterface::RobotToEngine::Tag_state:
     {
       HandleRobotStateUpdate(msg.state);
-      const bool onChargerContacts = (msg.state.status & (uint32_t)RobotStatusFlag::IS_ON_CHARGER);
-      _animStreamer->SetOnCharger(onChargerContacts);
-      auto* showStreamStateManager = _context->GetShowAudioStreamStateManager();
-      if (showStreamStateManager != nullptr)
-      {
-        showStreamStateManager->SetOnCharger( onChargerContacts );
-      }
-      auto* alexa = _context->GetAlexa();
-      if (alexa != nullptr)
-      {
-        alexa->SetOnCharger( onChargerContacts );
-      }
-
     }
     break;
     case RobotInterface::RobotToEngine::Tag_stillAlive:
@@ -826,6 +843,41 @@ void AnimProcessMessages::ProcessMessageFromRobot(const RobotInterface::RobotToE
 
 } // ProcessMessageFromRobot()
 
+void AnimProcessMessages::ProcessRobotStateDeltaFromRobot(const u8* data, u32 size)
+{
+  // Forward to engine first, so engine's decoder sees every datagram ours does
+  static Util::MessageProfiler msgProfiler("AnimProcessMessages::SendAnimToEngine.StateDelta", sRobotToEngineTagName);
+  if (AnimComms::SendPacketToEngine(data, size)) {
+    msgProfiler.Update(RobotInterface::RobotToEngine::Tag_state, size);
+  } else {
+    msgProfiler.ReportOnFailure();
+  }
+  ++_messageCountAnimToEngine;
+
+  if (!_robotStateDecoder.Decode(data, size)) {
+    if (_robotStateDecoderInSync) {
+      // Stays out of sync until the next keyframe
+      LOG_WARNING("AnimProcessMessages.ProcessRobotStateDeltaFromRobot.OutOfSync",
+                  "Dropping robot state deltas until the next keyframe (%u bytes)", size);
+      _robotStateDecoderInSync = false;
+    }
+    return;
+  }
+  _robotStateDecoderInSync = true;
+
+  RobotInterface::RobotToEngine msg;
+  const uint32_t msgSize = _robotStateDecoder.GetMessageSize();
+  memcpy(msg.GetBuffer(), _robotStateDecoder.GetMessage(), msgSize);
+  if ((msg.Size() != msgSize) || !msg.IsValid() || (msg.tag != RobotInterface::RobotToEngine::Tag_state)) {
+    LOG_WARNING("AnimProcessMessages.ProcessRobotStateDeltaFromRobot.InvalidData",
+                "Decoded robot state is invalid (tag %d, %u bytes)", msg.tag, msgSize);
+    return;
+  }
+
+  HandleRobotStateUpdate(msg.state);
+  _proceduralAudioClient->ProcessMessage(msg);
+}
+
 // ========== END OF PROCESSING MESSAGES FROM ROBOT ==========
 
 // ========== START OF CLASS METHODS ==========
@@ -901,6 +953,33 @@ Result AnimProcessMessages::MonitorConnectionState(BaseStationTime_t currTime_na
   return RESULT_OK;
 }
 
+void AnimProcessMessages::ProcessPacketFromEngine(const u8* data, u32 dataLen)
+{
+  ++_messageCountEngineToAnim;
+  Anki::Vector::RobotInterface::EngineToRobot msg;
+  if (dataLen > sizeof(msg)) {
+    LOG_WARNING("AnimProcessMessages.ProcessPacketFromEngine.TooLarge",
+                "Message from engine too large (%u > %zu)", dataLen, sizeof(msg));
+    return;
+  }
+  memcpy(msg.GetBuffer(), data, dataLen);
+  if (msg.Size() != dataLen) {
+    LOG_WARNING("AnimProcessMessages.ProcessPacketFromEngine.InvalidSize",
+                "Invalid message size from engine (%d != %d)",
+                msg.Size(), dataLen);
+    return;
+  }
+  if (!msg.IsValid()) {
+    LOG_WARNING("AnimProcessMessages.ProcessPacketFromEngine.InvalidData", "Invalid message from engine");
+    return;
+  }
+
+  static Util::MessageProfiler msgProfiler("AnimProcessMessages::EngineToAnim", sEngineToRobotTagName);
+  msgProfiler.Update(msg.tag, dataLen);
+  Util::MessageProfiler::ScopedHandlerTimer handlerTimer(msgProfiler, msg.tag);
+  ProcessMessageFromEngine(msg);
+}
+
 Result AnimProcessMessages::Update(BaseStationTime_t currTime_nanosec)
 {
   if(_countToShutdown > 0)
@@ -959,20 +1038,18 @@ Result AnimProcessMessages::Update(BaseStationTime_t currTime_nanosec)
 
     while((dataLen = AnimComms::GetNextPacketFromEngine(pktBuffer_, MAX_PACKET_BUFFER_SIZE)) > 0)
     {
-      ++_messageCountEngineToAnim;
-      Anki::Vector::RobotInterface::EngineToRobot msg;
-      memcpy(msg.GetBuffer(), pktBuffer_, dataLen);
-      if (msg.Size() != dataLen) {
-        LOG_WARNING("AnimProcessMessages.Update.EngineToRobot.InvalidSize",
-                    "Invalid message size from engine (%d != %d)",
-                    msg.Size(), dataLen);
+      if (!IsEngineAnimMessageBatch(pktBuffer_, dataLen)) {
+        ProcessPacketFromEngine(pktBuffer_, dataLen);
         continue;
       }
-      if (!msg.IsValid()) {
-        LOG_WARNING("AnimProcessMessages.Update.EngineToRobot.InvalidData", "Invalid message from engine");
-        continue;
+
+      const bool isValidBatch = ForEachMessageInBatch(pktBuffer_, dataLen, [](const u8* data, u32 size) {
+        ProcessPacketFromEngine(data, size);
+      });
+      if (!isValidBatch) {
+        LOG_WARNING("AnimProcessMessages.Update.EngineToRobot.InvalidBatch",
+                    "Invalid message batch from engine (%u bytes)", dataLen);
       }
-      ProcessMessageFromEngine(msg);
     }
   }
 
@@ -980,9 +1057,17 @@ Result AnimProcessMessages::Update(BaseStationTime_t currTime_nanosec)
   {
     ANKI_CPU_PROFILE("ProcessMessageFromRobot");
 
-    while ((dataLen = AnimComms::GetNextPacketFromRobot(pktBuffer_, MAX_PACKET_BUFFER_SIZE)) > 0)
+    while ((dataLen = AnimComms::GetNextPacketFromRobot(pktBuffer_, MAX_ROBOT_PACKET_SIZE)) > 0)
     {
       ++_messageCountRobotToAnim;
+      if (IsRobotStateDelta(pktBuffer_, dataLen)) {
+        static Util::MessageProfiler deltaProfiler("AnimProcessMessages::RobotToAnim.StateDelta", sRobotToEngineTagName);
+        deltaProfiler.Update(RobotInterface::RobotToEngine::Tag_state, dataLen);
+        Util::MessageProfiler::ScopedHandlerTimer handlerTimer(deltaProfiler, RobotInterface::RobotToEngine::Tag_state);
+        ProcessRobotStateDeltaFromRobot(pktBuffer_, dataLen);
+        continue;
+      }
+
       Anki::Vector::RobotInterface::RobotToEngine msg;
       memcpy(msg.GetBuffer(), pktBuffer_, dataLen);
       if (msg.Size() != dataLen) {
@@ -995,6 +1080,10 @@ Result AnimProcessMessages::Update(BaseStationTime_t currTime_nanosec)
         LOG_WARNING("AnimProcessMessages.Update.RobotToEngine.InvalidData", "Invalid message from robot");
         continue;
       }
+
+      static Util::MessageProfiler msgProfiler("AnimProcessMessages::RobotToAnim", sRobotToEngineTagName);
+      msgProfiler.Update(msg.tag, dataLen);
+      Util::MessageProfiler::ScopedHandlerTimer handlerTimer(msgProfiler, msg.tag);
       ProcessMessageFromRobot(msg);
       _proceduralAudioClient->ProcessMessage(msg);
     }
@@ -1029,7 +1118,7 @@ Result AnimProcessMessages::Update(BaseStationTime_t currTime_nanosec)
 
 bool AnimProcessMessages::SendAnimToRobot(const RobotInterface::EngineToRobot& msg)
 {
-  static Util::MessageProfiler msgProfiler("AnimProcessMessages::SendAnimToRobot");
+  static Util::MessageProfiler msgProfiler("AnimProcessMessages::SendAnimToRobot", sEngineToRobotTagName);
   LOG_TRACE("AnimProcessMessages.SendAnimToRobot", "Send tag %d size %u", msg.tag, msg.Size());
   bool result = AnimComms::SendPacketToRobot(msg.GetBuffer(), msg.Size());
   if (result) {
@@ -1043,7 +1132,7 @@ bool AnimProcessMessages::SendAnimToRobot(const RobotInterface::EngineToRobot& m
 
 bool AnimProcessMessages::SendAnimToEngine(const RobotInterface::RobotToEngine & msg)
 {
-  static Util::MessageProfiler msgProfiler("AnimProcessMessages::SendAnimToEngine");
+  static Util::MessageProfiler msgProfiler("AnimProcessMessages::SendAnimToEngine", sRobotToEngineTagName);
 
   LOG_TRACE("AnimProcessMessages.SendAnimToEngine", "Send tag %d size %u", msg.tag, msg.Size());
   bool result = AnimComms::SendPacketToEngine(msg.GetBuffer(), msg.Size());
@@ -72,6 +72,12 @@ private:
   // Check state & send firmware handshake when engine connects
   static Result MonitorConnectionState(BaseStationTime_t currTime_nanosec);
 
+  // Unpack and dispatch one packed EngineToRobot message
+  static void ProcessPacketFromEngine(const u8* data, u32 dataLen);
+
+  // Forward a compact RobotState datagram (see robotStateDelta.h) to engine and handle the state it decodes to
+  static void ProcessRobotStateDeltaFromRobot(const u8* data, u32 dataLen);
+
   static uint32_t _messageCountAnimToRobot;
   static uint32_t _messageCountAnimToEngine;
   static uint32_t _messageCountRobotToAnim;
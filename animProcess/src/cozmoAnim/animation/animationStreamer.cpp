@@ -17,7 +17,9 @@
 #include "coretech/common/shared/array2d_impl.h"
 #include "coretech/common/engine/utils/timer.h"
 #include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/messaging/shared/bootStatus.h"
 #include "cozmoAnim/animation/animationStreamer.h"
+#include "cozmoAnim/animation/animationTickStats.h"
 #include "coretech/vision/shared/compositeImage/compositeImageBuilder.h"
 
 #include "cannedAnimLib/cannedAnims/animationInterpolator.h"
@@ -48,6 +50,8 @@
 #include "jo_gif/jo_gif.h"
 #include "gif-h/gif.h"
 
+#include <cstring>
+
 #define LOG_CHANNEL "Animations"
 
 #define DEBUG_ANIMATION_STREAMING 0
@@ -89,6 +93,7 @@ namespace Anim {
   static bool s_faceDataReset = false;
 
   uint16_t AnimationStreamer::_numLayersRendered = 0;
+  Anim::AnimationTickStats AnimationStreamer::_tickStats;
 
 #if ANKI_DEV_CHEATS
   static const Anim::AnimContext* s_context; // copy of AnimContext in first constructed AnimationStreamer, needed for GetDataPlatform
@@ -168,6 +173,7 @@ namespace Anim {
   namespace{
 
   static const std::string kWebVizModuleName = "animations";
+  static const std::string kTickStatsWebVizModuleName = "animtiming";
 
   // Specifies how often to send AnimState message
   static const u32 kAnimStateReportingPeriod_tics = 2;
@@ -200,6 +206,21 @@ namespace Anim {
   u32 kCurrentManualFrameNumber = 0;
   CONSOLE_VAR(bool, kShouldDisplayKeyframeNumber, "ManualAnimationPlayback", false);
 
+  // Decoded canned animations which aren't playing are freed when memory pressure is at least this alert level
+  // (0 = never). They are decoded again from their files the next time they play
+  CONSOLE_VAR_RANGED(u8,  kReleaseColdAnimsMemoryAlert,   "AnimationStreamer.System", 1, 0, 2);
+  CONSOLE_VAR_RANGED(f32, kReleaseColdAnimsMinPeriod_sec, "AnimationStreamer.System", 10.f, 0.f, 600.f);
+
+  // Number of ticks over which the per-stage timing of Update is accumulated before being logged (and sent to
+  // webViz, if subscribed) and cleared. 0 disables. A tick starting more than the tolerance past its time step is
+  // counted as a missed deadline
+  CONSOLE_VAR(u32, kTickStatsReportPeriod_tics, "AnimationStreamer.System", 300);
+  CONSOLE_VAR_RANGED(f32, kTickStatsJitterTolerance_ms, "AnimationStreamer.System", 8.f, 0.f, 33.f);
+
+  // Advancing and merging track layers runs out of pre-allocated storage, so once the layers in use have warmed up
+  // their pools it should never allocate. Assert on every tick where it did (the count is always reported either way)
+  CONSOLE_VAR(bool, kAssertNoLayerHeapAllocations, "AnimationStreamer.System", false);
+
 #if ANKI_DEV_CHEATS
   // Whether or not to display high temperature indicator on face
   CONSOLE_VAR(bool, kDisplayHighTemperature, "AnimationStreamer.System", true);
@@ -415,6 +436,7 @@ namespace Anim {
 
   Result AnimationStreamer::Init(TextToSpeechComponent* ttsComponent)
   {
+    BootStatus::Clear(BootMilestone::AnimFaceReady);
 
     SetDefaultKeepFaceAliveParams();
 
@@ -443,6 +465,7 @@ namespace Anim {
     _proceduralTrackComponent->Init(*this);
 
     _faceDrawBuf.Allocate(static_cast<int16_t>(FACE_DISPLAY_HEIGHT), static_cast<int16_t>(FACE_DISPLAY_WIDTH));
+    _lastFaceDrawn.Allocate(static_cast<int16_t>(FACE_DISPLAY_HEIGHT), static_cast<int16_t>(FACE_DISPLAY_WIDTH));
     _procFaceImg.Allocate(static_cast<int16_t>(FACE_DISPLAY_HEIGHT), static_cast<int16_t>(FACE_DISPLAY_WIDTH));
     _faceImageRGB565.Allocate(static_cast<int16_t>(FACE_DISPLAY_HEIGHT), static_cast<int16_t>(FACE_DISPLAY_WIDTH));
     _faceImageGrayscale.Allocate(static_cast<int16_t>(FACE_DISPLAY_HEIGHT), static_cast<int16_t>(FACE_DISPLAY_WIDTH));
@@ -603,45 +626,56 @@ namespace Anim {
 #       define DEBUG_STREAM_KEYFRAME_MESSAGE(__KF_NAME__)
 #     endif
 
-    if (SendIfTrackUnlocked(stateToSend.moveHeadMessage, AnimTrackFlag::HEAD_TRACK)) {
-      DEBUG_STREAM_KEYFRAME_MESSAGE("HeadAngle");
-    }
+    using StageTimer = Anim::AnimationTickStats::ScopedStageTimer;
 
-    if (SendIfTrackUnlocked(stateToSend.moveLiftMessage, AnimTrackFlag::LIFT_TRACK)) {
-      DEBUG_STREAM_KEYFRAME_MESSAGE("LiftHeight");
-    }
+    {
+      StageTimer timer(_tickStats, Anim::AnimTickStage::MessageSend);
 
-    if (SendIfTrackUnlocked(stateToSend.bodyMotionMessage, AnimTrackFlag::BODY_TRACK)) {
-      DEBUG_STREAM_KEYFRAME_MESSAGE("BodyMotion");
-    }
+      if (SendIfTrackUnlocked(stateToSend.moveHeadMessage, AnimTrackFlag::HEAD_TRACK)) {
+        DEBUG_STREAM_KEYFRAME_MESSAGE("HeadAngle");
+      }
 
-    if (SendIfTrackUnlocked(stateToSend.recHeadMessage, AnimTrackFlag::BODY_TRACK)) {
-      DEBUG_STREAM_KEYFRAME_MESSAGE("RecordHeading");
-    }
+      if (SendIfTrackUnlocked(stateToSend.moveLiftMessage, AnimTrackFlag::LIFT_TRACK)) {
+        DEBUG_STREAM_KEYFRAME_MESSAGE("LiftHeight");
+      }
 
-    if (SendIfTrackUnlocked(stateToSend.turnToRecHeadMessage, AnimTrackFlag::BODY_TRACK)) {
-      DEBUG_STREAM_KEYFRAME_MESSAGE("TurnToRecordedHeading");
-    }
+      if (SendIfTrackUnlocked(stateToSend.bodyMotionMessage, AnimTrackFlag::BODY_TRACK)) {
+        DEBUG_STREAM_KEYFRAME_MESSAGE("BodyMotion");
+      }
+
+      if (SendIfTrackUnlocked(stateToSend.recHeadMessage, AnimTrackFlag::BODY_TRACK)) {
+        DEBUG_STREAM_KEYFRAME_MESSAGE("RecordHeading");
+      }
+
+      if (SendIfTrackUnlocked(stateToSend.turnToRecHeadMessage, AnimTrackFlag::BODY_TRACK)) {
+        DEBUG_STREAM_KEYFRAME_MESSAGE("TurnToRecordedHeading");
+      }
 
-    if (SendIfTrackUnlocked(stateToSend.backpackLightsMessage, AnimTrackFlag::BACKPACK_LIGHTS_TRACK)) {
-      EnableBackpackAnimationLayer(true);
+      if (SendIfTrackUnlocked(stateToSend.backpackLightsMessage, AnimTrackFlag::BACKPACK_LIGHTS_TRACK)) {
+        EnableBackpackAnimationLayer(true);
+      }
     }
 
     if (stateToSend.audioKeyFrameMessage != nullptr) {
+      StageTimer timer(_tickStats, Anim::AnimTickStage::AudioPost);
       _animAudioClient->PlayAudioKeyFrame( *stateToSend.audioKeyFrameMessage, _context->GetRandom() );
       Util::SafeDelete(stateToSend.audioKeyFrameMessage);
     }
 
-    // Send AnimationEvent directly up to engine if it's time to play one
-    if (stateToSend.eventMessage != nullptr) {
-      DEBUG_STREAM_KEYFRAME_MESSAGE("Event");
-      RobotInterface::SendAnimToEngine(*stateToSend.eventMessage);
-      Util::SafeDelete(stateToSend.eventMessage);
-    }
+    {
+      StageTimer timer(_tickStats, Anim::AnimTickStage::MessageSend);
 
-    if (stateToSend.haveFaceToSend) {
-      DEBUG_STREAM_KEYFRAME_MESSAGE("FaceAnimation");
-      BufferFaceToSend(stateToSend.faceImg);
+      // Send AnimationEvent directly up to engine if it's time to play one
+      if (stateToSend.eventMessage != nullptr) {
+        DEBUG_STREAM_KEYFRAME_MESSAGE("Event");
+        RobotInterface::SendAnimToEngine(*stateToSend.eventMessage);
+        Util::SafeDelete(stateToSend.eventMessage);
+      }
+
+      if (stateToSend.haveFaceToSend) {
+        DEBUG_STREAM_KEYFRAME_MESSAGE("FaceAnimation");
+        BufferFaceToSend(stateToSend.faceImg);
+      }
     }
 
 #     undef DEBUG_STREAM_KEYFRAME_MESSAGE
@@ -1042,6 +1076,9 @@ namespace Anim {
     Result lastResult = _streamingAnimation->Init(spriteCache);
     if (lastResult == RESULT_OK)
     {
+      // Lazy soundbanks have to be resident before the first audio keyframe posts its event
+      _animAudioClient->LoadAnimationSoundbanks(*_streamingAnimation);
+
       // Only update should render in eye hue if not looping
       if (shouldOverrideEyeHue)
       {
@@ -1350,6 +1387,39 @@ namespace Anim {
   }
 #endif // ANKI_DEV_CHEATS
 
+  // Bounding rectangle of the pixels that differ between two images of the same size (empty if there are none)
+  static Rectangle<s32> GetChangedRect(const Vision::ImageRGB565& prevImg, const Vision::ImageRGB565& img)
+  {
+    const s32 nrows = img.GetNumRows();
+    const s32 ncols = img.GetNumCols();
+    s32 minRow = nrows, maxRow = -1, minCol = ncols, maxCol = -1;
+    for (s32 i = 0; i < nrows; ++i)
+    {
+      const Vision::PixelRGB565* prev_i = prevImg.GetRow(i);
+      const Vision::PixelRGB565* img_i = img.GetRow(i);
+      if (std::memcmp(prev_i, img_i, ncols * sizeof(Vision::PixelRGB565)) == 0)
+      {
+        continue;
+      }
+      minRow = std::min(minRow, i);
+      maxRow = i;
+
+      // Only look at the columns that would grow the rectangle
+      s32 j = 0;
+      while (j < minCol && prev_i[j].GetValue() == img_i[j].GetValue()) { ++j; }
+      minCol = std::min(minCol, j);
+      j = ncols - 1;
+      while (j > maxCol && prev_i[j].GetValue() == img_i[j].GetValue()) { --j; }
+      maxCol = std::max(maxCol, j);
+    }
+
+    if (maxRow < 0)
+    {
+      return Rectangle<s32>();
+    }
+    return Rectangle<s32>(minCol, minRow, maxCol - minCol + 1, maxRow - minRow + 1);
+  }
+
   void AnimationStreamer::BufferFaceToSend(Vision::ImageRGB565& faceImg565)
   {
     DEV_ASSERT_MSG(faceImg565.GetNumCols() == static_cast<int16_t>(FACE_DISPLAY_WIDTH) &&
@@ -1510,7 +1580,22 @@ namespace Anim {
       faceImg565.DrawText(pos, playbackTime, color, scale);
     }
 
-    FaceDisplay::getInstance()->DrawToFace(faceImg565);
+    // Only the part that changed since the last image has to go to the display
+    const Rectangle<s32> damage = GetChangedRect(_lastFaceDrawn, faceImg565);
+    if (damage.Area() > 0)
+    {
+      faceImg565.CopyTo(_lastFaceDrawn);
+    }
+    auto* faceDisplay = FaceDisplay::getInstance();
+    const u32 numFacesDroppedBefore = faceDisplay->GetNumFacesDropped();
+    faceDisplay->DrawToFace(faceImg565, damage);
+    _tickStats.AddDroppedFaces(faceDisplay->GetNumFacesDropped() - numFacesDroppedBefore);
+
+    if (!_hasDrawnFirstFace)
+    {
+      _hasDrawnFirstFace = true;
+      BootStatus::Publish(BootMilestone::AnimFaceReady);
+    }
   }
 
   Result AnimationStreamer::EnableBackpackAnimationLayer(bool enable)
@@ -1737,11 +1822,16 @@ namespace Anim {
   {
     ANKI_CPU_PROFILE("AnimationStreamer::ExtractMessagesRelatedToProceduralTrackComponent");
 
-    TrackLayerComponent::LayeredKeyFrames layeredKeyFrames;
-    trackComp->ApplyLayersToAnim(anim,
-                                 timeSinceAnimStart_ms,
-                                 layeredKeyFrames,
-                                 storeFace);
+    using StageTimer = Anim::AnimationTickStats::ScopedStageTimer;
+
+    const TrackLayerComponent::LayeredKeyFrames* mergedKeyFrames = nullptr;
+    {
+      StageTimer timer(_tickStats, Anim::AnimTickStage::LayerMerge);
+      mergedKeyFrames = &trackComp->ApplyLayersToAnim(anim,
+                                                      timeSinceAnimStart_ms,
+                                                      storeFace);
+    }
+    const auto& layeredKeyFrames = *mergedKeyFrames;
 
     if (layeredKeyFrames.haveBackpackKeyFrame &&
         !IsTrackLocked(tracksCurrentlyLocked, (u8)AnimTrackFlag::BACKPACK_LIGHTS_TRACK))
@@ -1766,6 +1856,8 @@ namespace Anim {
                                                            timeSinceAnimStart_ms);
     }
 
+    StageTimer timer(_tickStats, Anim::AnimTickStage::FaceCompositing);
+
     if (needToRenderStreamable)
     {
       GetStreamableFace(context, layeredKeyFrames.faceKeyFrame.GetFace(), stateToSend.faceImg);
@@ -1945,8 +2037,13 @@ namespace Anim {
 
   Result AnimationStreamer::Update()
   {
+    using StageTimer = Anim::AnimationTickStats::ScopedStageTimer;
+
+    _tickStats.StartTick();
     _numLayersRendered = 0;
 
+    ReleaseColdAnimationsIfLowOnMemory();
+
     {
       std::lock_guard<std::mutex> lock(_pendingAnimationMutex);
       if (!_pendingAnimation.empty()) {
@@ -1968,15 +2065,18 @@ namespace Anim {
 
     // Make sure the proceduralTrackLayers and streaming animation
     // are advanced to the appropriate keyframe
-    _proceduralTrackComponent->AdvanceTracks(_relativeStreamTime_ms);
-    if (_streamingAnimation != nullptr)
     {
-      _streamingAnimation->AdvanceTracks(_relativeStreamTime_ms);
-
-      // Procedural animation is not presistent
-      if (_streamingAnimation == _proceduralAnimation)
+      StageTimer timer(_tickStats, Anim::AnimTickStage::TrackAdvance);
+      _proceduralTrackComponent->AdvanceTracks(_relativeStreamTime_ms);
+      if (_streamingAnimation != nullptr)
       {
-        _proceduralAnimation->ClearUpToCurrent();
+        _streamingAnimation->AdvanceTracks(_relativeStreamTime_ms);
+
+        // Procedural animation is not presistent
+        if (_streamingAnimation == _proceduralAnimation)
+        {
+          _proceduralAnimation->ClearUpToCurrent();
+        }
       }
     }
 
@@ -2040,6 +2140,7 @@ namespace Anim {
     // Send animState message
     if (--_numTicsToSendAnimState == 0)
     {
+      StageTimer timer(_tickStats, Anim::AnimTickStage::MessageSend);
       const auto numKeyframes = _proceduralAnimation->GetTrack<SpriteSequenceKeyFrame>().TrackLength();
 
       AnimationState msg;
@@ -2051,10 +2152,93 @@ namespace Anim {
       _numTicsToSendAnimState = kAnimStateReportingPeriod_tics;
     }
 
+    const u32 numLayerHeapAllocations = _proceduralTrackComponent->TakeNumHeapAllocations();
+    _tickStats.AddHeapAllocations(numLayerHeapAllocations);
+    if (kAssertNoLayerHeapAllocations)
+    {
+      DEV_ASSERT_MSG(numLayerHeapAllocations == 0,
+                     "AnimationStreamer.Update.LayerHeapAllocations",
+                     "%u heap allocations advancing and merging track layers", numLayerHeapAllocations);
+    }
+
+    _tickStats.EndTick();
+    ReportTickStatsIfDue();
+
     return lastResult;
   } // AnimationStreamer::Update()
 
 
+  void AnimationStreamer::ReportTickStatsIfDue()
+  {
+    _tickStats.SetJitterTolerance_ms(kTickStatsJitterTolerance_ms);
+    if (kTickStatsReportPeriod_tics == 0)
+    {
+      _tickStats.ClearWindow();
+      return;
+    }
+
+    if (_tickStats.GetNumTicks() < kTickStatsReportPeriod_tics)
+    {
+      return;
+    }
+
+    const Json::Value json = _tickStats.GetJson();
+    const Json::Value& update = json["update"];
+    LOG_INFO("AnimationStreamer.ReportTickStats",
+             "NumTicks:%u MissedDeadlines:%u Overruns:%u Update p50:%.2fms p99:%.2fms max:%.2fms "
+             "TicksWithHeapAllocs:%u",
+             json["numTicks"].asUInt(), json["numMissedDeadlines"].asUInt(), json["numOverruns"].asUInt(),
+             update["p50_ms"].asFloat(), update["p99_ms"].asFloat(), update["max_ms"].asFloat(),
+             json["numTicksWithHeapAllocations"].asUInt());
+
+    if (ANKI_DEV_CHEATS && (_context != nullptr))
+    {
+      auto* webService = _context->GetWebService();
+      if ((webService != nullptr) && webService->IsWebVizClientSubscribed(kTickStatsWebVizModuleName))
+      {
+        webService->SendToWebViz(kTickStatsWebVizModuleName, json);
+      }
+    }
+
+    _tickStats.ClearWindow();
+  }
+
+
+  void AnimationStreamer::ReleaseColdAnimationsIfLowOnMemory()
+  {
+    if (kReleaseColdAnimsMemoryAlert == 0) {
+      return;
+    }
+
+    const float currTime_sec = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+    if (currTime_sec < _nextColdAnimReleaseTime_sec) {
+      return;
+    }
+
+    OSState::MemoryInfo info;
+    OSState::getInstance()->GetMemoryInfo(info);
+    if (info.alert < kReleaseColdAnimsMemoryAlert) {
+      return;
+    }
+    _nextColdAnimReleaseTime_sec = currTime_sec + kReleaseColdAnimsMinPeriod_sec;
+
+    // The neutral face is kept for the whole life of the streamer
+    std::set<std::string> animsInUse;
+    for (const Animation* anim : {_streamingAnimation, _neutralFaceAnimation, _proceduralAnimation}) {
+      if (anim != nullptr) {
+        animsInUse.insert(anim->GetName());
+      }
+    }
+
+    const size_t numReleased = _context->GetDataLoader()->ReleaseColdAnimations(animsInUse);
+    if (numReleased > 0) {
+      LOG_INFO("AnimationStreamer.ReleaseColdAnimationsIfLowOnMemory",
+               "Released %zu animations (%u kB available, alert %d)",
+               numReleased, info.availMem_kB, static_cast<int>(info.alert));
+    }
+  }
+
+
   void AnimationStreamer::EnableKeepFaceAlive(bool enable, u32 disableTimeout_ms)
   {
     if (s_enableKeepFaceAlive && !enable)
@@ -19,6 +19,7 @@
 #include "coretech/common/shared/types.h"
 #include "coretech/vision/engine/image.h"
 #include "coretech/vision/shared/compositeImage/compositeImageLayer.h"
+#include "cozmoAnim/animation/animationTickStats.h"
 #include "cozmoAnim/animation/trackLayerComponent.h"
 #include "cozmoAnim/animTimeStamp.h"
 #include "cannedAnimLib/cannedAnims/animation.h"
@@ -209,6 +210,9 @@ namespace Anim {
 
     uint16_t GetNumLayersRendered() { return _numLayersRendered; }
 
+    // Per-stage timing of Update
+    const Anim::AnimationTickStats& GetTickStats() const { return _tickStats; }
+
   private:
     const Anim::AnimContext* _context = nullptr;
 
@@ -294,6 +298,12 @@ namespace Anim {
     // Image buffer that is fed directly to face display (in RGB565 format)
     Vision::ImageRGB565 _faceDrawBuf;
 
+    // Last image sent to the face display, to find what changed in the next one
+    Vision::ImageRGB565 _lastFaceDrawn;
+
+    // Whether the first face has gone to the display since startup
+    bool _hasDrawnFirstFace = false;
+
     // Image buffer for ProceduralFace
     Vision::ImageRGB _procFaceImg;
 
@@ -326,6 +336,9 @@ namespace Anim {
     // Tic counter for sending animState message
     u32           _numTicsToSendAnimState            = 0;
 
+    // Next time cold animations may be released again
+    float         _nextColdAnimReleaseTime_sec       = 0.f;
+
     bool _redirectFaceImagesToDebugScreen = false;
 
     std::vector<NewAnimationCallback> _newAnimationCallbacks;
@@ -336,6 +349,9 @@ namespace Anim {
     
     static uint16_t _numLayersRendered;
 
+    // Static since some of the stages are timed from the static Extract/Render helpers below
+    static Anim::AnimationTickStats _tickStats;
+
     static bool IsTrackLocked(u8 lockedTracks, u8 trackFlagToCheck) {
       return ((lockedTracks & trackFlagToCheck) == trackFlagToCheck);
     }
@@ -416,6 +432,13 @@ namespace Anim {
     // while maintaining expected properties of the procedural anim
     void CopyIntoProceduralAnimation(Animation* desiredAnim = nullptr);
 
+    // When the system is low on memory, free the decoded canned animations that
+    // this streamer is not holding on to
+    void ReleaseColdAnimationsIfLowOnMemory();
+
+    // Logs the tick timing window (and sends it to webViz) once it has kTickStatsReportPeriod_tics ticks
+    void ReportTickStatsIfDue();
+
     static void InsertStreamableFaceIntoCompImg(Vision::ImageRGB565& streamableFace,
                                                 Vision::CompositeImage& image);
     
@@ -0,0 +1,173 @@
+/**
+ * File: animationTickStats.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "cozmoAnim/animation/animationTickStats.h"
+
+#include "anki/cozmo/shared/cozmoConfig.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace Anki {
+namespace Vector {
+namespace Anim {
+
+namespace {
+  // Nearest-rank percentile. Reorders samples
+  f32 GetPercentile(std::vector<f32>& samples, f32 percentile)
+  {
+    if(samples.empty())
+    {
+      return 0.f;
+    }
+    const size_t rank = std::min(samples.size() - 1, static_cast<size_t>(percentile * samples.size() / 100.0));
+    std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+    return samples[rank];
+  }
+
+  Json::Value GetDistributionJson(const std::vector<f32>& samples)
+  {
+    std::vector<f32> sorted(samples);
+    Json::Value json;
+    json["p50_ms"] = GetPercentile(sorted, 50.f);
+    json["p90_ms"] = GetPercentile(sorted, 90.f);
+    json["p99_ms"] = GetPercentile(sorted, 99.f);
+    json["max_ms"] = sorted.empty() ? 0.f : *std::max_element(sorted.begin(), sorted.end());
+    return json;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const char* AnimTickStageToString(AnimTickStage stage)
+{
+  switch(stage)
+  {
+    case AnimTickStage::TrackAdvance:    return "TrackAdvance";
+    case AnimTickStage::LayerMerge:      return "LayerMerge";
+    case AnimTickStage::FaceCompositing: return "FaceCompositing";
+    case AnimTickStage::AudioPost:       return "AudioPost";
+    case AnimTickStage::MessageSend:     return "MessageSend";
+    case AnimTickStage::Count:           break;
+  }
+  return "Invalid";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AnimationTickStats::AnimationTickStats(f32 jitterTolerance_ms)
+: _jitterTolerance_ms(jitterTolerance_ms)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+s64 AnimationTickStats::GetCurrentTime_us()
+{
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AnimationTickStats::StartTick(s64 now_us)
+{
+  _lastTickStart_us = _tickStart_us;
+  _tickStart_us = now_us;
+  _stage_us.fill(0);
+  _heapAllocations = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AnimationTickStats::AddStageTime(AnimTickStage stage, s64 duration_us)
+{
+  if(stage < AnimTickStage::Count)
+  {
+    _stage_us[static_cast<size_t>(stage)] += duration_us;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AnimationTickStats::EndTick(s64 now_us)
+{
+  for(size_t i=0; i<kNumStages; ++i)
+  {
+    _lastStage_ms[i] = _stage_us[i] * 0.001f;
+    _stageSamples_ms[i].push_back(_lastStage_ms[i]);
+  }
+
+  _lastHeapAllocations = _heapAllocations;
+  if(_heapAllocations > 0)
+  {
+    ++_numTicksWithHeapAllocations;
+    _numHeapAllocations += _heapAllocations;
+  }
+
+  _lastTotal_ms = (now_us - _tickStart_us) * 0.001f;
+  _total_ms.push_back(_lastTotal_ms);
+  if(_lastTotal_ms > ANIM_TIME_STEP_MS)
+  {
+    ++_numOverruns;
+  }
+
+  // The first tick has nothing to be late relative to
+  _lastTickLate = false;
+  if(_lastTickStart_us > 0)
+  {
+    const f32 interval_ms = (_tickStart_us - _lastTickStart_us) * 0.001f;
+    _interval_ms.push_back(interval_ms);
+    _lastTickLate = (interval_ms > ANIM_TIME_STEP_MS + _jitterTolerance_ms);
+    if(_lastTickLate)
+    {
+      ++_numMissedDeadlines;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Json::Value AnimationTickStats::GetJson() const
+{
+  Json::Value json;
+  json["numTicks"]           = GetNumTicks();
+  json["numMissedDeadlines"] = _numMissedDeadlines;
+  json["numOverruns"]        = _numOverruns;
+  json["deadline_ms"]        = ANIM_TIME_STEP_MS;
+  json["jitterTolerance_ms"] = _jitterTolerance_ms;
+  json["numTicksWithHeapAllocations"] = _numTicksWithHeapAllocations;
+  json["numHeapAllocations"]          = _numHeapAllocations;
+  json["numDroppedFaces"]             = _numDroppedFaces;
+
+  Json::Value& stages = json["stages"];
+  for(size_t i=0; i<kNumStages; ++i)
+  {
+    stages[AnimTickStageToString(static_cast<AnimTickStage>(i))] = GetDistributionJson(_stageSamples_ms[i]);
+  }
+  json["update"]   = GetDistributionJson(_total_ms);
+  json["interval"] = GetDistributionJson(_interval_ms);
+
+  return json;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AnimationTickStats::ClearWindow()
+{
+  for(auto& samples : _stageSamples_ms)
+  {
+    samples.clear();
+  }
+  _total_ms.clear();
+  _interval_ms.clear();
+  _numMissedDeadlines = 0;
+  _numOverruns = 0;
+  _numTicksWithHeapAllocations = 0;
+  _numHeapAllocations = 0;
+  _numDroppedFaces = 0;
+}
+
+} // namespace Anim
+} // namespace Vector
+} // namespace Anki
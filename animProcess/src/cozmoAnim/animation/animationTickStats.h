@@ -0,0 +1,128 @@
+/**
+ * File: animationTickStats.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: How long each stage of AnimationStreamer::Update took on every tick, and how regularly the ticks
+ *              themselves arrived. A window of ticks is kept so that percentiles of each stage, and the number of
+ *              ticks that came too late to keep the animation on its ANIM_TIME_STEP_MS schedule, can be reported.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Vector_Anim_AnimationTickStats_H__
+#define __Anki_Vector_Anim_AnimationTickStats_H__
+
+#include "coretech/common/shared/types.h"
+
+#include "json/json.h"
+
+#include <array>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+namespace Anim {
+
+// Parts of AnimationStreamer::Update, in the order they happen
+enum class AnimTickStage : u8
+{
+  TrackAdvance,     // Streaming animation and procedural track layers advanced to the current time
+  LayerMerge,       // TrackLayerComponent applied its layers on top of the animation's keyframes
+  FaceCompositing,  // Procedural face drawn and/or sprite sequence frame composited
+  AudioPost,        // Audio keyframe handed to the audio engine
+  MessageSend,      // Motion, light, event and state messages sent, and the face buffered for the display
+  Count
+};
+
+const char* AnimTickStageToString(AnimTickStage stage);
+
+class AnimationTickStats
+{
+public:
+
+  static constexpr size_t kNumStages = static_cast<size_t>(AnimTickStage::Count);
+
+  // A tick is late when it starts more than jitterTolerance_ms after ANIM_TIME_STEP_MS since the previous one
+  explicit AnimationTickStats(f32 jitterTolerance_ms = 8.f);
+
+  // Microseconds on a monotonic clock
+  static s64 GetCurrentTime_us();
+
+  // Measures a stage from construction to destruction. A stage timed more than once in a tick is summed
+  class ScopedStageTimer
+  {
+  public:
+    ScopedStageTimer(AnimationTickStats& stats, AnimTickStage stage)
+    : _stats(stats), _stage(stage), _start_us(GetCurrentTime_us()) {}
+    ~ScopedStageTimer() { _stats.AddStageTime(_stage, GetCurrentTime_us() - _start_us); }
+  private:
+    AnimationTickStats& _stats;
+    const AnimTickStage _stage;
+    const s64           _start_us;
+  };
+
+  void StartTick() { StartTick(GetCurrentTime_us()); }
+  void StartTick(s64 now_us);
+  void AddStageTime(AnimTickStage stage, s64 duration_us);
+  void EndTick() { EndTick(GetCurrentTime_us()); }
+  void EndTick(s64 now_us);
+
+  // Heap allocations made this tick by stages that are meant not to allocate (see ScopedHeapAllocationCounter)
+  void AddHeapAllocations(u32 numAllocations) { _heapAllocations += numAllocations; }
+
+  // Face images this tick that replaced one the display had not started drawing yet (see FaceDisplay)
+  void AddDroppedFaces(u32 numFaces) { _numDroppedFaces += numFaces; }
+
+  void SetJitterTolerance_ms(f32 tolerance_ms) { _jitterTolerance_ms = tolerance_ms; }
+
+  // Stage durations of the last completed tick, for PerfMetric
+  f32  GetLastStageDuration_ms(AnimTickStage stage) const { return _lastStage_ms[static_cast<size_t>(stage)]; }
+  f32  GetLastTickDuration_ms() const { return _lastTotal_ms; }
+  bool WasLastTickLate() const { return _lastTickLate; }
+  u32  GetLastTickHeapAllocations() const { return _lastHeapAllocations; }
+
+  // Ticks completed (and of those, late ones) since the window was last cleared
+  u32 GetNumTicks() const { return static_cast<u32>(_total_ms.size()); }
+  u32 GetNumMissedDeadlines() const { return _numMissedDeadlines; }
+
+  // Percentiles (50/90/99) and max in ms of each stage, the whole Update, and the tick interval, plus the number
+  // of late ticks, of ticks where Update alone took a full time step, of ticks that allocated, and of face images
+  // the display dropped, over the window
+  Json::Value GetJson() const;
+
+  void ClearWindow();
+
+private:
+
+  f32 _jitterTolerance_ms;
+
+  // Current tick
+  s64 _tickStart_us     = 0;
+  s64 _lastTickStart_us = 0;
+  std::array<s64, kNumStages> _stage_us{};
+  u32 _heapAllocations = 0;
+
+  // Last completed tick
+  std::array<f32, kNumStages> _lastStage_ms{};
+  f32  _lastTotal_ms = 0.f;
+  bool _lastTickLate = false;
+  u32  _lastHeapAllocations = 0;
+
+  // Window
+  std::array<std::vector<f32>, kNumStages> _stageSamples_ms;
+  std::vector<f32> _total_ms;
+  std::vector<f32> _interval_ms;
+  u32 _numMissedDeadlines = 0;
+  u32 _numOverruns        = 0;
+  u32 _numTicksWithHeapAllocations = 0;
+  u32 _numHeapAllocations = 0;
+  u32 _numDroppedFaces = 0;
+};
+
+} // namespace Anim
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Vector_Anim_AnimationTickStats_H__
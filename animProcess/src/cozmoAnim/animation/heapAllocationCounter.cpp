@@ -0,0 +1,113 @@
+/**
+ * File: heapAllocationCounter.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "cozmoAnim/animation/heapAllocationCounter.h"
+
+#include "util/global/globalDefinitions.h"
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+  thread_local u32 tNumAllocations = 0;
+}
+
+#if ANKI_DEV_CHEATS
+
+// Replacements for the global allocation functions. They behave like the standard library's, but count every
+// allocation against the thread making it. The matching deallocation functions are replaced too so that they are
+// guaranteed to pair with the malloc below
+void* operator new(std::size_t size)
+{
+  ++tNumAllocations;
+  if (size == 0) {
+    size = 1;
+  }
+  void* ptr = std::malloc(size);
+  while (ptr == nullptr) {
+    std::new_handler handler = std::get_new_handler();
+    if (handler == nullptr) {
+      throw std::bad_alloc();
+    }
+    handler();
+    ptr = std::malloc(size);
+  }
+  return ptr;
+}
+
+void* operator new[](std::size_t size)
+{
+  return ::operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+  try {
+    return ::operator new(size);
+  }
+  catch (...) {
+    return nullptr;
+  }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+  return ::operator new(size, std::nothrow);
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+  std::free(ptr);
+}
+
+#endif // ANKI_DEV_CHEATS
+
+namespace Anki {
+namespace Vector {
+namespace Anim {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ScopedHeapAllocationCounter::ScopedHeapAllocationCounter(u32& numAllocations)
+: _numAllocations(numAllocations)
+, _startCount(tNumAllocations)
+{
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ScopedHeapAllocationCounter::~ScopedHeapAllocationCounter()
+{
+  _numAllocations += (tNumAllocations - _startCount);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u32 ScopedHeapAllocationCounter::GetNumAllocationsOnThisThread()
+{
+  return tNumAllocations;
+}
+
+} // namespace Anim
+} // namespace Vector
+} // namespace Anki
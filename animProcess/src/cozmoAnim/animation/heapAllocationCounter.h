@@ -0,0 +1,47 @@
+/**
+ * File: heapAllocationCounter.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Counts the heap allocations made by the calling thread while a ScopedHeapAllocationCounter is alive,
+ *              to catch allocations in parts of the animation tick that are meant to run without them. Counting
+ *              replaces the global operator new, so it is only built in with ANKI_DEV_CHEATS; without it every
+ *              count is 0.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Vector_Anim_HeapAllocationCounter_H__
+#define __Anki_Vector_Anim_HeapAllocationCounter_H__
+
+#include "coretech/common/shared/types.h"
+
+namespace Anki {
+namespace Vector {
+namespace Anim {
+
+class ScopedHeapAllocationCounter
+{
+public:
+
+  // Adds the number of allocations made on this thread between construction and destruction to numAllocations
+  explicit ScopedHeapAllocationCounter(u32& numAllocations);
+  ~ScopedHeapAllocationCounter();
+
+  ScopedHeapAllocationCounter(const ScopedHeapAllocationCounter&) = delete;
+  ScopedHeapAllocationCounter& operator=(const ScopedHeapAllocationCounter&) = delete;
+
+  // Total allocations made on this thread so far
+  static u32 GetNumAllocationsOnThisThread();
+
+private:
+  u32&      _numAllocations;
+  const u32 _startCount;
+};
+
+} // namespace Anim
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Vector_Anim_HeapAllocationCounter_H__
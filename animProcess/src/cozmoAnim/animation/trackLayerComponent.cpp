@@ -13,6 +13,7 @@
 
 #include "cozmoAnim/animation/trackLayerComponent.h"
 #include "cozmoAnim/animation/animationStreamer.h"
+#include "cozmoAnim/animation/heapAllocationCounter.h"
 #include "cozmoAnim/animation/trackLayerManagers/audioLayerManager.h"
 #include "cozmoAnim/animation/trackLayerManagers/backpackLayerManager.h"
 #include "cozmoAnim/animation/trackLayerManagers/faceLayerManager.h"
@@ -45,6 +46,17 @@ CONSOLE_VAR_RANGED(u32, kAudioAnimationOffset_ms, "Audio.AnimationStreamer", 200
 #endif
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TrackLayerComponent::LayeredKeyFrames::Reset()
+{
+  haveAudioKeyFrame = false;
+  audioKeyFrame.Reset();
+  haveBackpackKeyFrame = false;
+  backpackKeyFrame = BackpackLightsKeyFrame();
+  // faceKeyFrame is always replaced by ApplyFaceLayersToAnim
+  haveFaceKeyFrame = false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TrackLayerComponent::TrackLayerComponent(const Anim::AnimContext* context)
 : _audioLayerManager(new AudioLayerManager(*context->GetRandom()))
@@ -87,21 +99,25 @@ void TrackLayerComponent::Update()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TrackLayerComponent::AdvanceTracks(const TimeStamp_t toTime_ms)
 {
+  ScopedHeapAllocationCounter allocationCounter(_numHeapAllocations);
   _audioLayerManager->AdvanceTracks(toTime_ms);
   _backpackLayerManager->AdvanceTracks(toTime_ms);
   _faceLayerManager->AdvanceTracks(toTime_ms);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void TrackLayerComponent::ApplyLayersToAnim(Animation* anim,
-                                            const TimeStamp_t timeSinceAnimStart_ms,
-                                            LayeredKeyFrames& layeredKeyframes,
-                                            bool storeFace) const
+const TrackLayerComponent::LayeredKeyFrames& TrackLayerComponent::ApplyLayersToAnim(Animation* anim,
+                                                                                   const TimeStamp_t timeSinceAnimStart_ms,
+                                                                                   bool storeFace)
 {
+  ScopedHeapAllocationCounter allocationCounter(_numHeapAllocations);
+  _layeredKeyFrames.Reset();
+
   // Apply layers of individual tracks to anim
-  ApplyAudioLayersToAnim   (anim, timeSinceAnimStart_ms, layeredKeyframes);
-  ApplyBackpackLayersToAnim(anim, timeSinceAnimStart_ms, layeredKeyframes);
-  ApplyFaceLayersToAnim    (anim, timeSinceAnimStart_ms, layeredKeyframes, storeFace);
+  ApplyAudioLayersToAnim   (anim, timeSinceAnimStart_ms, _layeredKeyFrames);
+  ApplyBackpackLayersToAnim(anim, timeSinceAnimStart_ms, _layeredKeyFrames);
+  ApplyFaceLayersToAnim    (anim, timeSinceAnimStart_ms, _layeredKeyFrames, storeFace);
+  return _layeredKeyFrames;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -265,6 +281,15 @@ u32 TrackLayerComponent::GetMaxBlinkSpacingTimeForScreenProtection_ms() const
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u32 TrackLayerComponent::TakeNumHeapAllocations()
+{
+  const u32 numHeapAllocations = _numHeapAllocations;
+  _numHeapAllocations = 0;
+  return numHeapAllocations;
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // Private Methods
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -51,6 +51,9 @@ public:
     
     bool haveFaceKeyFrame = false;
     ProceduralFaceKeyFrame faceKeyFrame;
+
+    // Back to no keyframes, keeping the audio keyframe's storage for the next merge
+    void Reset();
   };
   
   
@@ -66,12 +69,11 @@ public:
   
   // Pulls the current keyframe from various tracks of the anim
   // and combines it with any track layers that may exist
-  // Outputs layeredKeyframes struct which contains the final combined
-  // keyframes from the anim and the various track layers
-  void ApplyLayersToAnim(Animation* anim,
-                         const TimeStamp_t timeSinceAnimStart_ms,
-                         LayeredKeyFrames& layeredKeyFrames,
-                         bool storeFace) const;
+  // Returns the final combined keyframes from the anim and the various track layers. They are
+  // merged into a buffer owned by this component, which stays valid until the next call
+  const LayeredKeyFrames& ApplyLayersToAnim(Animation* anim,
+                                            const TimeStamp_t timeSinceAnimStart_ms,
+                                            bool storeFace);
   
   // Keep Victor's face alive using the params specified
   // (call each tick while the face should be kept alive)
@@ -127,6 +129,10 @@ public:
   
   u32 GetMaxBlinkSpacingTimeForScreenProtection_ms() const;
   
+  // Number of heap allocations made by AdvanceTracks() and ApplyLayersToAnim() since the last call. Once the layer
+  // managers' pools have grown to what the current layers need this should stay 0 (always 0 without ANKI_DEV_CHEATS)
+  u32 TakeNumHeapAllocations();
+  
 private:
   
   // The KeepFaceAlive system consists of multiple Modifiers applied to the face by the
@@ -165,6 +171,10 @@ private:
   std::unique_ptr<ProceduralFace> _lastProceduralFace;
   std::vector<KeepAliveModifier>                _keepAliveModifiers;
 
+  // Reused by every ApplyLayersToAnim() so merging does not construct keyframes on the heap
+  LayeredKeyFrames _layeredKeyFrames;
+  u32 _numHeapAllocations = 0;
+
   // Audio letancy offset tracking vars
   mutable bool _validAudioKeyframeIt = false;
   mutable std::list<RobotAudioKeyFrame>::iterator _audioKeyframeIt;
@@ -38,7 +38,7 @@ CONSOLE_VAR(f32, kMaxBlinkSpacingTimeForScreenProtection_ms, CONSOLE_GROUP_NAME,
 FaceLayerManager::FaceLayerManager(const Util::RandomGenerator& rng)
 : ITrackLayerManager<ProceduralFaceKeyFrame>(rng)
 {
-
+  _keepFaceAliveTrack.AddKeyFrameToBack(ProceduralFaceKeyFrame());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -258,10 +258,7 @@ s32 FaceLayerManager::GetNextEyeDartTime_ms(const std::map<KeepFaceAliveParamete
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FaceLayerManager::AddKeepFaceAliveTrack(const std::string& layerName)
 {
-  ProceduralFaceKeyFrame frame;
-  FaceTrack faceTrack;
-  faceTrack.AddKeyFrameToBack(frame);
-  AddLayer(layerName, faceTrack);
+  AddLayer(layerName, _keepFaceAliveTrack);
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -100,6 +100,12 @@ public:
   
   u32 GetMaxBlinkSpacingTimeForScreenProtection_ms() const;
   
+private:
+  
+  // The single neutral keyframe AddKeepFaceAliveTrack() layers, which happens on most ticks while keeping the face
+  // alive. Built once so that only the layer's pooled copy of it is made each time
+  FaceTrack _keepFaceAliveTrack;
+  
 };
 
 } // namespace Anim
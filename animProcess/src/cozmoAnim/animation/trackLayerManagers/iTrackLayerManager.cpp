@@ -13,6 +13,8 @@
 
 #include "cozmoAnim/animation/trackLayerManagers/iTrackLayerManager.h"
 
+#include <algorithm>
+
 #define LOG_CHANNEL    "TrackLayerManager"
 
 #define DEBUG_FACE_LAYERING 0
@@ -24,14 +26,68 @@ namespace Anim {
 template<class FRAME_TYPE>
 ITrackLayerManager<FRAME_TYPE>::ITrackLayerManager(const Util::RandomGenerator& rng)
 : _rng(rng)
+, _layerStorage(kMaxNumLayers)
+, _framePool(kNumPooledFrames)
 {
-  
+  _layers.reserve(kMaxNumLayers);
+  _freeLayers.reserve(kMaxNumLayers);
+  // Pushed in reverse so layers are handed out from the front of the storage
+  for (auto layerIter = _layerStorage.rbegin(); layerIter != _layerStorage.rend(); ++layerIter)
+  {
+    layerIter->track.SetFramePool(&_framePool);
+    _freeLayers.push_back(&(*layerIter));
+  }
+}
+
+template<class FRAME_TYPE>
+typename ITrackLayerManager<FRAME_TYPE>::LayerList::const_iterator
+ITrackLayerManager<FRAME_TYPE>::FindLayer(const std::string& name) const
+{
+  auto layerIter = std::lower_bound(_layers.begin(), _layers.end(), name, &IsLayerNameLess);
+  if ((layerIter != _layers.end()) && ((*layerIter)->name == name))
+  {
+    return layerIter;
+  }
+  return _layers.end();
+}
+
+template<class FRAME_TYPE>
+typename ITrackLayerManager<FRAME_TYPE>::Layer* ITrackLayerManager<FRAME_TYPE>::AcquireLayer(const std::string& name)
+{
+  if (_freeLayers.empty())
+  {
+    LOG_WARNING("TrackLayerManager.AcquireLayer.TooManyLayers",
+                "All %zu layers are in use, not adding %s", kMaxNumLayers, name.c_str());
+    return nullptr;
+  }
+
+  Layer* layer = _freeLayers.back();
+  _freeLayers.pop_back();
+
+  // Assigning into the free layer's name reuses its storage from whichever layer last had it
+  layer->name = name;
+  layer->sentOnce = false;
+  layer->isPersistent = false;
+
+  auto insertIter = std::lower_bound(_layers.begin(), _layers.end(), name, &IsLayerNameLess);
+  _layers.insert(insertIter, layer);
+  return layer;
+}
+
+template<class FRAME_TYPE>
+typename ITrackLayerManager<FRAME_TYPE>::LayerList::iterator
+ITrackLayerManager<FRAME_TYPE>::ReleaseLayer(typename LayerList::iterator layerIter)
+{
+  Layer* layer = *layerIter;
+  layer->track.Clear();
+  _freeLayers.push_back(layer);
+  return _layers.erase(layerIter);
 }
 
 template<class FRAME_TYPE>
 bool ITrackLayerManager<FRAME_TYPE>::ApplyLayersToFrame(FRAME_TYPE& frame,
                                                         const TimeStamp_t timeSinceAnimStart_ms,
-                                                        ApplyLayerFunc applyLayerFunc) const
+                                                        const ApplyLayerFunc& applyLayerFunc) const
 {
   if (DEBUG_FACE_LAYERING)
   {
@@ -44,66 +100,69 @@ bool ITrackLayerManager<FRAME_TYPE>::ApplyLayersToFrame(FRAME_TYPE& frame,
 
   bool frameUpdated = false;
     
-  for (auto layerIter = _layers.begin(); layerIter != _layers.end(); ++layerIter)
+  for (const Layer* layer : _layers)
   {
-    auto& layer = layerIter->second;
-    
     // Apply the layer's track with frame
-    frameUpdated |= applyLayerFunc(layer.track, timeSinceAnimStart_ms, frame);
+    frameUpdated |= applyLayerFunc(layer->track, timeSinceAnimStart_ms, frame);
   }
   
   return frameUpdated;
 }
 
 template<class FRAME_TYPE>
-Result ITrackLayerManager<FRAME_TYPE>::AddLayer(const std::string& name,
-                                                const Animations::Track<FRAME_TYPE>& track)
+Result ITrackLayerManager<FRAME_TYPE>::AddLayerHelper(const std::string& name,
+                                                      const Animations::Track<FRAME_TYPE>& track,
+                                                      bool isPersistent)
 {
-  if (_layers.find(name) != _layers.end()) {
-    PRINT_NAMED_WARNING("TrackLayerManager.AddLayer.LayerAlreadyExists", "");
+  Layer* layer = nullptr;
+  const auto existingIter = FindLayer(name);
+  if (existingIter != _layers.end()) {
+    if (isPersistent) {
+      PRINT_NAMED_WARNING("TrackLayerManager.AddPersistentLayer.LayerAlreadyExists", "");
+    } else {
+      PRINT_NAMED_WARNING("TrackLayerManager.AddLayer.LayerAlreadyExists", "");
+    }
+    layer = *existingIter;
+  } else {
+    layer = AcquireLayer(name);
+    if (layer == nullptr) {
+      return RESULT_FAIL;
+    }
   }
   
-  Result lastResult = RESULT_OK;
-  
-  Layer newLayer;
-  newLayer.track = track; // COPY the track in
-  newLayer.track.MoveToStart();
-  newLayer.isPersistent = false;
-  newLayer.sentOnce = false;
+  layer->track.CopyFramesFrom(track); // COPY the track in
+  layer->isPersistent = isPersistent;
+  layer->sentOnce = false;
   
-  _layers[name] = std::move(newLayer);
-  
-  return lastResult;
+  return RESULT_OK;
+}
+
+template<class FRAME_TYPE>
+Result ITrackLayerManager<FRAME_TYPE>::AddLayer(const std::string& name,
+                                                const Animations::Track<FRAME_TYPE>& track)
+{
+  return AddLayerHelper(name, track, false);
 }
 
 template<class FRAME_TYPE>
 void ITrackLayerManager<FRAME_TYPE>::AddPersistentLayer(const std::string& name,
                                                         const Animations::Track<FRAME_TYPE>& track)
 {
-  if (_layers.find(name) != _layers.end()) {
-    PRINT_NAMED_WARNING("TrackLayerManager.AddPersistentLayer.LayerAlreadyExists", "");
-  }
-  
   if(ANKI_DEV_CHEATS){
     ValidateTrack(track);
   }
   
-  Layer newLayer;
-  newLayer.track = track;
-  newLayer.track.MoveToStart();
-  newLayer.isPersistent = true;
-  newLayer.sentOnce = false;
-  
-  _layers[name] = std::move(newLayer);
+  AddLayerHelper(name, track, true);
 }
 
 template<class FRAME_TYPE>
 void ITrackLayerManager<FRAME_TYPE>::AddToPersistentLayer(const std::string& layerName, FRAME_TYPE& keyframe)
 {
-  auto layerIter = _layers.find(layerName);
+  auto layerIter = FindLayer(layerName);
   if (layerIter != _layers.end())
   {
-    auto& track = layerIter->second.track;
+    Layer* layer = *layerIter;
+    auto& track = layer->track;
     assert(nullptr != track.GetLastKeyFrame());
     auto* lastKeyframe = track.GetLastKeyFrame();
     
@@ -111,7 +170,7 @@ void ITrackLayerManager<FRAME_TYPE>::AddToPersistentLayer(const std::string& lay
     // the last keyframe's trigger time
     keyframe.SetTriggerTime_ms(lastKeyframe->GetTimestampActionComplete_ms());
     track.AddKeyFrameToBack(keyframe);
-    layerIter->second.sentOnce = false;
+    layer->sentOnce = false;
     
     if(ANKI_DEV_CHEATS){
       ValidateTrack(track);
@@ -124,10 +183,10 @@ void ITrackLayerManager<FRAME_TYPE>::RemovePersistentLayer(const std::string& la
                                                            TimeStamp_t streamTime_ms,
                                                            TimeStamp_t duration_ms)
 {
-  auto layerIter = _layers.find(layerName);
+  auto layerIter = FindLayer(layerName);
   if (layerIter != _layers.end())
   {
-    auto& layerName = layerIter->first;
+    const Layer* layer = *layerIter;
     LOG_INFO("ITrackLayerManager.RemovePersistentLayer",
              "%s, (Layers remaining=%lu)",
              layerName.c_str(), (unsigned long)_layers.size()-1);
@@ -138,7 +197,7 @@ void ITrackLayerManager<FRAME_TYPE>::RemovePersistentLayer(const std::string& la
     Animations::Track<FRAME_TYPE> track;
     if (duration_ms > 0)
     {
-      FRAME_TYPE firstFrame(layerIter->second.track.GetCurrentKeyFrame());
+      FRAME_TYPE firstFrame(layer->track.GetCurrentKeyFrame());
       firstFrame.SetTriggerTime_ms(streamTime_ms);
       track.AddKeyFrameToBack(std::move(firstFrame));
     }
@@ -148,7 +207,8 @@ void ITrackLayerManager<FRAME_TYPE>::RemovePersistentLayer(const std::string& la
     
     AddLayer("Remove" + layerName, track);
     
-    _layers.erase(layerIter);
+    // Adding the removal layer may have moved this one within _layers
+    ReleaseLayer(std::find(_layers.begin(), _layers.end(), layer));
   }
 }
 
@@ -163,9 +223,9 @@ bool ITrackLayerManager<FRAME_TYPE>::HaveLayersToSend() const
   {
     // There are layers, but we want to ignore any that are persistent that
     // have already been sent once
-    for (const auto & layer : _layers)
+    for (const Layer* layer : _layers)
     {
-      if (!layer.second.isPersistent || !layer.second.sentOnce)
+      if (!layer->isPersistent || !layer->sentOnce)
       {
         // There's at least one non-persistent layer, or a persistent layer
         // that has not been sent in its entirety at least once: return that there
@@ -183,17 +243,17 @@ bool ITrackLayerManager<FRAME_TYPE>::HaveLayersToSend() const
 template<class FRAME_TYPE>
 bool ITrackLayerManager<FRAME_TYPE>::HasLayer(const std::string& layerName) const
 {
-  return _layers.find(layerName) != _layers.end();
+  return FindLayer(layerName) != _layers.end();
 }
 
 template<class FRAME_TYPE>
 void ITrackLayerManager<FRAME_TYPE>::AdvanceTracks(const TimeStamp_t toTime_ms)
 {
-  std::list<std::string> layersToErase;
-
-  for(auto& pair: _layers){
-    auto& layerName = pair.first;
-    auto& layer = pair.second;
+  auto layerIter = _layers.begin();
+  while (layerIter != _layers.end())
+  {
+    Layer& layer = **layerIter;
+    const auto& layerName = layer.name;
     layer.track.AdvanceTrack(toTime_ms);
     if(!layer.isPersistent){
       layer.track.ClearUpToCurrent();
@@ -240,17 +300,12 @@ void ITrackLayerManager<FRAME_TYPE>::AdvanceTracks(const TimeStamp_t toTime_ms)
                     layerName.c_str(), (unsigned long)_layers.size()-1);
         }
         
-        layersToErase.push_back(layerName);
+        layerIter = ReleaseLayer(layerIter);
+        continue;
       }
     }
+    ++layerIter;
   }
-  
-  // Actually erase elements from the map
-  for (const auto& layerName : layersToErase)
-  {
-    _layers.erase(layerName);
-  }
-
 }
 
   
@@ -18,7 +18,8 @@
 #include "cannedAnimLib/cannedAnims/animation.h"
 #include "cannedAnimLib/baseTypes/track.h"
 
-#include <map>
+#include <string>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
@@ -29,7 +30,14 @@ class ITrackLayerManager
 {
 public:
 
+  // Layers and their keyframes live in storage allocated up front, so that adding, advancing, applying and
+  // removing layers does not touch the heap once the pool of keyframes has grown to what the layers use
+  static constexpr size_t kMaxNumLayers    = 32;
+  static constexpr size_t kNumPooledFrames = 64;
+
   ITrackLayerManager(const Util::RandomGenerator& rng);
+  ITrackLayerManager(const ITrackLayerManager&) = delete;
+  ITrackLayerManager& operator=(const ITrackLayerManager&) = delete;
   
   using ApplyLayerFunc = std::function<bool(const Animations::Track<FRAME_TYPE>&,
                                             const TimeStamp_t,
@@ -41,9 +49,10 @@ public:
   // Note: applyLayerFunc is responsible for moving to the next keyframe of a layer's track
   bool ApplyLayersToFrame(FRAME_TYPE& frame,
                           const TimeStamp_t timeSinceAnimStart_ms,
-                          ApplyLayerFunc applyLayerFunc) const;
+                          const ApplyLayerFunc& applyLayerFunc) const;
   
   // Adds the given track as a new layer
+  // Fails if all kMaxNumLayers layers are in use
   Result AddLayer(const std::string& name,
                   const Animations::Track<FRAME_TYPE>& track);
   
@@ -82,12 +91,35 @@ private:
 
   // Structure defining an individual layer
   struct Layer {
+    std::string  name;
     Animations::Track<FRAME_TYPE> track;
-    bool         sentOnce;
-    bool         isPersistent;
+    bool         sentOnce = false;
+    bool         isPersistent = false;
   };
 
-  std::map<std::string, Layer> _layers;
+  using LayerList = std::vector<Layer*>;
+
+  // All kMaxNumLayers layers, allocated once so pointers to them stay valid. _layers holds the ones in use sorted
+  // by name (the order they are applied in) and _freeLayers the rest
+  std::vector<Layer> _layerStorage;
+  LayerList _layers;
+  LayerList _freeLayers;
+
+  // Spare keyframes shared by the tracks of all layers
+  typename Animations::Track<FRAME_TYPE>::FrameList _framePool;
+
+  static bool IsLayerNameLess(const Layer* layer, const std::string& layerName) { return layer->name < layerName; }
+
+  typename LayerList::const_iterator FindLayer(const std::string& name) const;
+
+  // Takes a free layer, names it and inserts it into _layers. Returns nullptr if there are none left
+  Layer* AcquireLayer(const std::string& name);
+
+  // Returns the layer's keyframes to the pool and its slot to _freeLayers
+  typename LayerList::iterator ReleaseLayer(typename LayerList::iterator layerIter);
+
+  // Adds or replaces the layer with the given name
+  Result AddLayerHelper(const std::string& name, const Animations::Track<FRAME_TYPE>& track, bool isPersistent);
   
   // Ensures that expected playback parameters are met - this is not a long term
   // fix, it's a hack to try and catch animation streamer issues more quickly
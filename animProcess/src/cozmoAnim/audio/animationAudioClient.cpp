@@ -17,6 +17,7 @@
 #include "cozmoAnim/audio/cozmoAudioController.h"
 #include "cozmoAnim/textToSpeech/textToSpeechComponent.h"
 #include "cannedAnimLib/baseTypes/keyframe.h"
+#include "cannedAnimLib/cannedAnims/animation.h"
 #include "util/helpers/templateHelpers.h"
 #include "util/logging/logging.h"
 #include "util/math/math.h"
@@ -52,6 +53,24 @@ AnimationAudioClient::~AnimationAudioClient()
 {
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AnimationAudioClient::LoadAnimationSoundbanks( const Animation& animation )
+{
+  if ( _audioController == nullptr ) { return; }
+  const auto& audioEvents = animation.GetAudioEvents();
+  if ( audioEvents.empty() ) { return; }
+
+  std::vector<AudioEventId> eventIds;
+  eventIds.reserve( audioEvents.size() );
+  for ( const auto event : audioEvents ) {
+    eventIds.push_back( ToAudioEventId( event ) );
+  }
+  if ( !_audioController->LoadSoundbanksForEvents( eventIds ) ) {
+    PRINT_NAMED_WARNING("AnimationAudioClient.LoadAnimationSoundbanks.Failed",
+                        "Some audio of '%s' may not play", animation.GetName().c_str());
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AnimationAudioClient::InitAnimation()
 {
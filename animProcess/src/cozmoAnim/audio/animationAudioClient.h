@@ -29,6 +29,7 @@ namespace Util {
 class RandomGenerator;
 }
 namespace Vector {
+class Animation;
 class RobotAudioKeyFrame;
 class TextToSpeechComponent;
 
@@ -51,6 +52,9 @@ public:
     _ttsComponent = ttsComponent;
   }
 
+  // Load the lazy soundbanks holding the animation's audio events, so they are resident before it starts playing
+  void LoadAnimationSoundbanks( const Animation& animation );
+
   // Prepare to start animation
   void InitAnimation();
 
@@ -129,6 +129,8 @@ CONSOLE_VAR( bool, kWriteAudioProfilerCapture, CONSOLE_PATH, false );
 CONSOLE_VAR( bool, kWriteAudioOutputCapture, CONSOLE_PATH, false );
 CONSOLE_VAR_RANGED(uint8_t, kWriteAudioProfilerMaxLogCount, CONSOLE_PATH, 3, 1, 5);
 CONSOLE_VAR_RANGED(uint8_t, kWriteAudioOutputMaxLogCount, CONSOLE_PATH, 1, 1, 5);
+// Memory lazy loaded soundbanks may use before the least recently used ones are unloaded, 0 is no limit
+CONSOLE_VAR_RANGED(uint32_t, kLazySoundbankBudget_KB, CONSOLE_PATH, 8192, 0, 65536);
 
 #if REMOTE_CONSOLE_ENABLED
 // Console Functions
@@ -546,6 +548,17 @@ bool CozmoAudioController::GetActivatedParameterValue( AudioMetaData::GameParame
 }
 
 // Private Methods
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CozmoAudioController::LoadSoundbanksForEvents( const std::vector<AudioEventId>& eventIds )
+{
+  if ( _soundbankLoader.get() == nullptr ) {
+    return false;
+  }
+  // Console var may have changed since the last call
+  _soundbankLoader->SetLazyBankMemoryBudget( Console::kLazySoundbankBudget_KB * 1024 );
+  return _soundbankLoader->LoadSoundbanksForEvents( eventIds );
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CozmoAudioController::RegisterCladGameObjectsWithAudioController()
 {
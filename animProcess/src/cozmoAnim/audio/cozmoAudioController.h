@@ -93,6 +93,10 @@ public:
   bool GetActivatedParameterValue( AudioMetaData::GameParameter::ParameterType parameter,
                                    AudioEngine::AudioRTPCValue& out_value );
 
+  // Load the lazy soundbanks holding these events, unloading least recently used ones to stay under the budget
+  // Return false if a needed soundbank failed to load
+  bool LoadSoundbanksForEvents( const std::vector<AudioEventId>& eventIds );
+
 private:
   
   const Anim::AnimContext* _animContext = nullptr;
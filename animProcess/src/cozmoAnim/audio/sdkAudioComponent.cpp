@@ -12,7 +12,7 @@
 #include "sdkAudioComponent.h"
 
 #include "audioEngine/audioCallback.h"
-#include "audioEngine/audioTools/standardWaveDataContainer.h"
+#include "audioEngine/audioTools/pcmBufferPool.h"
 #include "audioEngine/audioTypeTranslator.h"
 #include "audioEngine/plugins/ankiPluginInterface.h"
 #include "audioEngine/plugins/streamingWavePortalPlugIn.h"
@@ -209,12 +209,12 @@ bool SdkAudioComponent::AddAudioChunk(const RobotInterface::ExternalAudioChunk&
     return false; 
   }
 
-  //copy chunk into container, append to waveData
+  //decode chunk into a pooled buffer, append to waveData
   const uint16_t input_chunk_size = msg.audio_chunk_size;
   const uint16_t wave_data_size = input_chunk_size / 2;  //size is in bytes, but buffer samples are 16 bit
-  Anki::AudioEngine::StandardWaveDataContainer waveContainer(_audioRate, 1, wave_data_size); 
-  waveContainer.CopyLittleEndianWaveData( (const unsigned char*)msg.audio_chunk_data, wave_data_size );
-  const bool result = _waveData->AppendStandardWaveData( std::move(waveContainer ));
+  auto pcmBuffer = AudioEngine::PcmBufferPool::GetSharedPool()->Acquire(_audioRate, 1);
+  pcmBuffer->CopyLittleEndianWaveData( (const unsigned char*)msg.audio_chunk_data, wave_data_size );
+  const bool result = _waveData->AppendPcmBuffer( std::move(pcmBuffer) );
 
   if (!result) {
     LOG_ERROR("SdkAudioComponent::AddAudioChunk", "Failed to append audio data");
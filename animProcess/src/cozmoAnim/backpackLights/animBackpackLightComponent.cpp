@@ -26,6 +26,8 @@
 
 #include "osState/osState.h"
 
+#include <algorithm>
+
 #define DEBUG_LIGHTS 0
 
 namespace Anki {
@@ -193,13 +195,9 @@ void BackpackLightComponent::Update()
   auto newConfig = bestNewConfig.lock();
   auto curConfig = _curBackpackLightConfig.lock();
 
-  // Prevent spamming of off lights while both configs are null
-  static bool sBothConfigsWereNull = false;
-
   // If the best config at this time is different from what we had, change it
   if (newConfig != curConfig)
   {
-    sBothConfigsWereNull = false;
     // If the best config is still a thing, use it. Otherwise use the off config
     if (newConfig != nullptr)
     {
@@ -212,11 +210,9 @@ void BackpackLightComponent::Update()
     
     _curBackpackLightConfig = bestNewConfig;
   }
-  // Else if both new and cur configs are null then turn lights off
-  else if(newConfig == nullptr && curConfig == nullptr &&
-          !sBothConfigsWereNull)
+  // Else if both new and cur configs are null then turn lights off (only sent the first time, see SendBackpackLights)
+  else if(newConfig == nullptr && curConfig == nullptr)
   {
-    sBothConfigsWereNull = true;
     SendBackpackLights(BackpackAnimationTrigger::Off);
   }
 }
@@ -342,8 +338,24 @@ Result BackpackLightComponent::SendBackpackLights(const BackpackLightAnimation::
   RobotInterface::SetBackpackLights setBackpackLights = lights.lights;
   setBackpackLights.layer = EnumToUnderlyingType(BackpackLightLayer::BPL_USER);
 
+  // The body keeps showing the user layer's lights until it's sent new ones, so there's no need to send the same
+  // ones again when e.g. the engine replaces its lights with identical ones
   const auto msg = RobotInterface::EngineToRobot(setBackpackLights);
-  const bool res = AnimComms::SendPacketToRobot((char*)msg.GetBuffer(), msg.Size());
+  const uint8_t* buffer = msg.GetBuffer();
+  if ((msg.Size() == _lastSentLights.size()) && std::equal(buffer, buffer + msg.Size(), _lastSentLights.begin()))
+  {
+    return RESULT_OK;
+  }
+
+  const bool res = AnimComms::SendPacketToRobot((char*)buffer, msg.Size());
+  if (res)
+  {
+    _lastSentLights.assign(buffer, buffer + msg.Size());
+  }
+  else
+  {
+    _lastSentLights.clear();
+  }
   return (res ? RESULT_OK : RESULT_FAIL);
 }
 
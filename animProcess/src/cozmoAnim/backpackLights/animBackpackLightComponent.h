@@ -31,6 +31,7 @@
 
 #include <list>
 #include <memory>
+#include <vector>
 #include <future>
 #include <atomic>
 
@@ -128,6 +129,9 @@ private:
   
   // Reference to the most recently used light configuration
   BackpackLightDataRefWeak _curBackpackLightConfig;
+
+  // Packed copy of the last lights message sent to the body
+  std::vector<uint8_t> _lastSentLights;
   
   // Locator handles for the private backpack light sources
   BackpackLightDataLocator _engineLightConfig{};
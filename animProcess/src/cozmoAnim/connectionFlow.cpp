@@ -51,6 +51,15 @@ const ColorRGBA   kColor(0.9f, 0.9f, 0.9f, 1.f);
 const char* kShowPinScreenSpriteName = "pairing_icon_key";
 
 bool s_enteredAnyScreen = false;
+
+// Screens only change when the robot name does, so they are drawn once and reused. Images handed to
+// SetFaceImage() are never drawn into again, since the animation streamer may still be showing them.
+std::string                            s_startPairingRobotName;
+std::shared_ptr<Vision::SpriteWrapper> s_startPairingHandle;
+
+// Everything on the pin screen but the pin itself
+std::string       s_showPinRobotName;
+Vision::ImageRGBA s_showPinBaseImg;
 }
 
 // Draws BLE name and url to screen
@@ -65,19 +74,24 @@ bool DrawStartPairingScreen(Anim::AnimationStreamer* animStreamer)
   
   s_enteredAnyScreen = true;  
 
-  auto* img = new Vision::ImageRGBA(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
-  img->FillWith(Vision::PixelRGBA(0, 0));
+  if((s_startPairingHandle == nullptr) || (robotName != s_startPairingRobotName))
+  {
+    auto* img = new Vision::ImageRGBA(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+    img->FillWith(Vision::PixelRGBA(0, 0));
+
+    img->DrawTextCenteredHorizontally(robotName, CV_FONT_NORMAL, kRobotNameScale, 1, kColor, 15, false);
 
-  img->DrawTextCenteredHorizontally(robotName, CV_FONT_NORMAL, kRobotNameScale, 1, kColor, 15, false);
+    cv::Size textSize;
+    float scale = 0;
+    Vision::Image::MakeTextFillImageWidth(kURL, CV_FONT_NORMAL, 1, img->GetNumCols(), textSize, scale);
+    img->DrawTextCenteredHorizontally(kURL, CV_FONT_NORMAL, scale, 1, kColor, (FACE_DISPLAY_HEIGHT + textSize.height)/2, true);
 
-  cv::Size textSize;
-  float scale = 0;
-  Vision::Image::MakeTextFillImageWidth(kURL, CV_FONT_NORMAL, 1, img->GetNumCols(), textSize, scale);
-  img->DrawTextCenteredHorizontally(kURL, CV_FONT_NORMAL, scale, 1, kColor, (FACE_DISPLAY_HEIGHT + textSize.height)/2, true);
+    s_startPairingHandle = std::make_shared<Vision::SpriteWrapper>(img);
+    s_startPairingRobotName = robotName;
+  }
 
-  auto handle = std::make_shared<Vision::SpriteWrapper>(img);
   const bool shouldRenderInEyeHue = false;
-  animStreamer->SetFaceImage(handle, shouldRenderInEyeHue, 0);
+  animStreamer->SetFaceImage(s_startPairingHandle, shouldRenderInEyeHue, 0);
 
   return true;
 }
@@ -87,20 +101,28 @@ void DrawShowPinScreen(Anim::AnimationStreamer* animStreamer, const Anim::AnimCo
 {
   s_enteredAnyScreen = true;
   
-  Vision::ImageRGB key;
-  key.Load(context->GetDataLoader()->GetSpritePaths()->GetAssetPath(kShowPinScreenSpriteName));
-  if(IsXray()) {
-    key.Resize(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
-  }
+  const std::string& robotName = OSState::getInstance()->GetRobotName();
+  if(s_showPinBaseImg.IsEmpty() || (robotName != s_showPinRobotName))
+  {
+    Vision::ImageRGB key;
+    key.Load(context->GetDataLoader()->GetSpritePaths()->GetAssetPath(kShowPinScreenSpriteName));
+    if(IsXray()) {
+      key.Resize(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+    }
+
+    s_showPinBaseImg.Allocate(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+    s_showPinBaseImg.FillWith(Vision::PixelRGBA(0, 0));
 
-  auto* img = new Vision::ImageRGBA(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
-  img->FillWith(Vision::PixelRGBA(0, 0));
+    Point2f p((FACE_DISPLAY_WIDTH - key.GetNumCols())/2,
+              (FACE_DISPLAY_HEIGHT - key.GetNumRows())/2);
+    s_showPinBaseImg.DrawSubImage(key, p);
 
-  Point2f p((FACE_DISPLAY_WIDTH - key.GetNumCols())/2,
-            (FACE_DISPLAY_HEIGHT - key.GetNumRows())/2);
-  img->DrawSubImage(key, p);
+    s_showPinBaseImg.DrawTextCenteredHorizontally(robotName, CV_FONT_NORMAL, kRobotNameScale, 1, kColor, 15, false);
+    s_showPinRobotName = robotName;
+  }
 
-  img->DrawTextCenteredHorizontally(OSState::getInstance()->GetRobotName(), CV_FONT_NORMAL, kRobotNameScale, 1, kColor, 15, false);
+  auto* img = new Vision::ImageRGBA();
+  s_showPinBaseImg.CopyTo(*img);
 
   img->DrawTextCenteredHorizontally(pin, CV_FONT_NORMAL, 0.8f, 1, kColor, FACE_DISPLAY_HEIGHT-5, false);
 
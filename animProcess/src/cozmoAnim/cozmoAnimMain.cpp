@@ -18,6 +18,7 @@
 
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
+#include "util/logging/asyncLoggerProvider.h"
 #include "util/logging/channelFilter.h"
 #include "util/logging/victorLogger.h"
 
@@ -146,6 +147,10 @@ int main(void)
     Anki::Util::gLoggerProvider->SetFilter(filterPtr);
   }
 
+  // From here on lines are written out by a low priority thread, so that e.g. the mic thread never waits on logd
+  auto asyncLogger = std::make_unique<Anki::Util::AsyncLoggerProvider>(logger.get());
+  Util::gLoggerProvider = asyncLogger.get();
+
   // Set up the console vars to load from file, if it exists
   ANKI_CONSOLE_SYSTEM_INIT(dataPlatform->pathToResource(Anki::Util::Data::Scope::Cache, "consoleVarsAnim.ini").c_str());
 
@@ -158,6 +163,7 @@ int main(void)
     delete animEngine;
     Util::gLoggerProvider = nullptr;
     Util::gEventProvider = nullptr;
+    asyncLogger.reset();
     UninstallCrashReporter();
     sync();
     exit(result);
@@ -249,6 +255,7 @@ int main(void)
 
   Util::gLoggerProvider = nullptr;
   Util::gEventProvider = nullptr;
+  asyncLogger.reset();
 
   UninstallCrashReporter();
   sync();
@@ -29,11 +29,37 @@
 namespace Anki {
 namespace Vector {
 
+CONSOLE_VAR_RANGED(float, maxDrawTime_ms,      ANKI_CPU_CONSOLEVARGROUP, 5, 5, 32);
 #if ANKI_CPU_PROFILER_ENABLED
-  CONSOLE_VAR_RANGED(float, maxDrawTime_ms,      ANKI_CPU_CONSOLEVARGROUP, 5, 5, 32);
   CONSOLE_VAR_ENUM(u8,      kDrawFace_Logging,   ANKI_CPU_CONSOLEVARGROUP, 0, Util::CpuProfiler::CpuProfilerLogging());
 #endif
 
+// Whether to only send the changed part of each face image to the display
+CONSOLE_VAR(bool, kFaceDisplayPartialUpdates, "FaceDisplay", true);
+
+namespace {
+  // FACE_DISPLAY_WIDTH depends on the hardware, so this can't be initialized statically
+  const Rectangle<s32>& GetFullFaceRect()
+  {
+    static const Rectangle<s32> kFullFaceRect(0, 0, FACE_DISPLAY_WIDTH, FACE_DISPLAY_HEIGHT);
+    return kFullFaceRect;
+  }
+
+  // Smallest rectangle containing both, where an empty rectangle contains nothing
+  Rectangle<s32> GetBoundingRect(const Rectangle<s32>& a, const Rectangle<s32>& b)
+  {
+    if (a.Area() <= 0) {
+      return b;
+    }
+    if (b.Area() <= 0) {
+      return a;
+    }
+    const Point2<s32> topLeft(std::min(a.GetX(), b.GetX()), std::min(a.GetY(), b.GetY()));
+    const Point2<s32> bottomRight(std::max(a.GetXmax(), b.GetXmax()), std::max(a.GetYmax(), b.GetYmax()));
+    return Rectangle<s32>(topLeft, bottomRight);
+  }
+}
+
 namespace {
 #if REMOTE_CONSOLE_ENABLED
   FaceDisplayImpl* sDisplayImpl = nullptr;
@@ -115,6 +141,11 @@ void FaceDisplay::UpdateNextImgPtr()
 }
 
 void FaceDisplay::DrawToFaceDebug(const Vision::ImageRGB565& img)
+{
+  DrawToFaceDebug(img, GetFullFaceRect());
+}
+
+void FaceDisplay::DrawToFaceDebug(const Vision::ImageRGB565& img, const Rectangle<s32>& damage)
 {
   // We want to allow FaceInfoScreenManager to draw in the None screen in particular
   // in order to clear since there are no eyes to clear it for us.
@@ -123,7 +154,7 @@ void FaceDisplay::DrawToFaceDebug(const Vision::ImageRGB565& img)
     return;
   }
 
-  DrawToFaceInternal(img);
+  DrawToFaceInternal(img, damage, true);
 }
 
 void FaceDisplay::SetFaceBrightness(LCDBrightness level)
@@ -135,27 +166,62 @@ void FaceDisplay::SetFaceBrightness(LCDBrightness level)
 }
 
 void FaceDisplay::DrawToFace(const Vision::ImageRGB565& img)
+{
+  DrawToFace(img, GetFullFaceRect());
+}
+
+void FaceDisplay::DrawToFace(const Vision::ImageRGB565& img, const Rectangle<s32>& damage)
 {
   if (FaceInfoScreenManager::getInstance()->IsActivelyDrawingToScreen())
   {
+    // The debug screen is on the display now, so the next image has to be drawn whole
+    std::lock_guard<std::mutex> lock(_faceDrawMutex);
+    _faceDrawNeedsFullFrame = true;
     return;
   }
 
-  DrawToFaceInternal(img);
+  DrawToFaceInternal(img, damage, false);
 }
 
-void FaceDisplay::DrawToFaceInternal(const Vision::ImageRGB565& img)
+void FaceDisplay::DrawToFaceInternal(const Vision::ImageRGB565& img, const Rectangle<s32>& damage, bool isDebug)
 {
-  // Don't update images and pointers while the boot animation is still playing
-  if(!_stopBootAnim)
-  {
-    return;
-  }
-
   {
     std::lock_guard<std::mutex> lock(_faceDrawMutex);
+
+    // Don't update images and pointers while the boot animation is still playing
+    if(!_stopBootAnim)
+    {
+      _faceDrawNeedsFullFrame = true;
+      _debugDrawNeedsFullFrame = true;
+      return;
+    }
+
+    // Face images and debug images are each diffed against the last of their own kind
+    bool& needsFullFrame = isDebug ? _debugDrawNeedsFullFrame : _faceDrawNeedsFullFrame;
+    const bool drawAll = needsFullFrame || !kFaceDisplayPartialUpdates;
+    const Rectangle<s32> changed = drawAll ? GetFullFaceRect() : damage.Intersect(GetFullFaceRect());
+    if (changed.Area() <= 0)
+    {
+      // Same as the image that was drawn, or is about to be
+      return;
+    }
+    needsFullFrame = false;
+
+    // What is on the display now is not the last image of the other kind, so the next one of those has to be drawn whole
+    bool& otherNeedsFullFrame = isDebug ? _faceDrawNeedsFullFrame : _debugDrawNeedsFullFrame;
+    otherNeedsFullFrame = true;
+
+    if (_faceDrawNextImg != nullptr)
+    {
+      // The drawing thread is still busy with the one before, so the image waiting for it never gets drawn
+      ++_numFacesDropped;
+    }
+
     UpdateNextImgPtr();
     img.CopyTo(*_faceDrawNextImg);
+
+    // The image may replace one that has not been drawn yet, so it has to cover what that one changed too
+    _faceDrawNextDamage = GetBoundingRect(_faceDrawNextDamage, changed);
   }
 
   // Notify the face-drawing thread that there is a face to draw
@@ -193,6 +259,8 @@ void FaceDisplay::DrawFaceLoop()
     {
       _faceDrawCurImg = _faceDrawNextImg;
       _faceDrawNextImg = nullptr;
+      const Rectangle<s32> damage = _faceDrawNextDamage;
+      _faceDrawNextDamage = Rectangle<s32>();
 
       // Grab a reference to the image we're going to draw so we can release the mutex
       const auto& drawImage = *_faceDrawCurImg;
@@ -209,7 +277,16 @@ void FaceDisplay::DrawFaceLoop()
       // Only draw to the face once the boot anim has been stopped
       if(_displayImpl != nullptr && _stopBootAnim)
       {
-        _displayImpl->FaceDraw(drawImage.GetRawDataPointer());
+        if (damage.Area() < GetFullFaceRect().Area())
+        {
+          _displayImpl->FaceDrawRect(drawImage.GetRawDataPointer(),
+                                     damage.GetX(), damage.GetY(), damage.GetWidth(), damage.GetHeight());
+        }
+        else
+        {
+          _displayImpl->FaceDraw(drawImage.GetRawDataPointer());
+        }
+        ++_numFacesDrawn;
       }
 
       // Done with this image, clear the pointer
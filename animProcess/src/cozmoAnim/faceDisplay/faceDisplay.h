@@ -16,6 +16,7 @@
 
 #include "util/singleton/dynamicSingleton.h"
 #include "anki/cozmo/shared/factory/faultCodes.h"
+#include "coretech/common/shared/math/rect.h"
 
 #include "clad/types/lcdTypes.h"
 
@@ -39,20 +40,36 @@ class FaceDisplay : public Util::DynamicSingleton<FaceDisplay>
 public:
   void DrawToFace(const Vision::ImageRGB565& img);
 
+  // Same as above, where damage is the part of img that differs from the last image passed in. Only that part is
+  // sent to the display, and nothing is if damage is empty
+  void DrawToFace(const Vision::ImageRGB565& img, const Rectangle<s32>& damage);
+
   // For drawing to face in various debug modes
   void DrawToFaceDebug(const Vision::ImageRGB565& img);
 
+  // Same as above, where damage is the part of img that differs from the last debug image passed in. Falls back to
+  // drawing the whole image if something else was drawn to the face since
+  void DrawToFaceDebug(const Vision::ImageRGB565& img, const Rectangle<s32>& damage);
+
 
   void SetFaceBrightness(LCDBrightness level);
 
   // Stops the boot animation process if it is running
   void StopBootAnim();
+
+  // Number of images whose transfer to the display has finished. Like a vsync count, this goes up once for every
+  // image that actually reached the display, so the animation process can tell whether it is drawing faster than
+  // the display can keep up with
+  u32 GetNumFacesDrawn() const { return _numFacesDrawn; }
+
+  // Number of images that were replaced by a newer one before the drawing thread got to them
+  u32 GetNumFacesDropped() const { return _numFacesDropped; }
   
 protected:
   FaceDisplay();
   virtual ~FaceDisplay();
 
-  void DrawToFaceInternal(const Vision::ImageRGB565& img);
+  void DrawToFaceInternal(const Vision::ImageRGB565& img, const Rectangle<s32>& damage, bool isDebug);
 
 private:
   std::unique_ptr<FaceDisplayImpl>  _displayImpl;
@@ -61,9 +78,14 @@ private:
   std::unique_ptr<Vision::ImageRGB565>  _faceDrawImg[2];
   Vision::ImageRGB565*                  _faceDrawNextImg = nullptr;
   Vision::ImageRGB565*                  _faceDrawCurImg = nullptr;
+  Rectangle<s32>                        _faceDrawNextDamage;           // what changed since the last drawn image
+  bool                                  _faceDrawNeedsFullFrame = true; // display may not show the last image passed in
+  bool                                  _debugDrawNeedsFullFrame = true; // same, for the last debug image
   std::thread                           _faceDrawThread;
   std::mutex                            _faceDrawMutex;
   std::atomic<bool>                     _stopDrawFace;
+  std::atomic<u32>                      _numFacesDrawn{0};
+  std::atomic<u32>                      _numFacesDropped{0};
 
   std::mutex                            _readyMutex;
   std::condition_variable               _readyCondition;
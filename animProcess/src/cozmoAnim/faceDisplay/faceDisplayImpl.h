@@ -41,6 +41,10 @@ public:
   //      FaceDisplay::getInstance()->FaceDraw(reinterpret_cast<u16*>(img565.ptr()));
   void FaceDraw(const u16* frame);
 
+  // Draws only the given window of frame (a whole frame as above) to the same place on the face display,
+  // leaving the rest of the display as it was
+  void FaceDrawRect(const u16* frame, s32 x, s32 y, s32 width, s32 height);
+
   // Print text to face display
   void FacePrintf(const char *format, ...);
 
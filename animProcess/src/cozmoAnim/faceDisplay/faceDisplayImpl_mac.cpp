@@ -82,6 +82,23 @@ namespace { // "Private members"
     face_->imagePaste(imgRef, 0, 0);
     face_->imageDelete(imgRef);
   }
+
+  void FaceDisplayImpl::FaceDrawRect(const u16* frame, s32 x, s32 y, s32 width, s32 height)
+  {
+    // Same as FaceDraw, but only converting and pasting the window
+    u32* imgPtr = &faceImg_[0];
+    for (s32 row = y; row < y + height; ++row) {
+      const u16* rowPtr = frame + row * FACE_DISPLAY_WIDTH + x;
+      for (s32 col = 0; col < width; ++col) {
+        Vision::PixelRGB565 rgb565(rowPtr[col]);
+        *imgPtr++ = rgb565.ToBGRA32();
+      }
+    }
+
+    auto imgRef = face_->imageNew(width, height, faceImg_, webots::Display::ARGB);
+    face_->imagePaste(imgRef, x, y);
+    face_->imageDelete(imgRef);
+  }
   
   void FaceDisplayImpl::FacePrintf(const char* format, ...)
   {
@@ -46,6 +46,11 @@ namespace Vector {
   {
     lcd_draw_frame2(frame, FACE_DISPLAY_WIDTH*FACE_DISPLAY_HEIGHT*sizeof(u16));
   }
+
+  void FaceDisplayImpl::FaceDrawRect(const u16* frame, s32 x, s32 y, s32 width, s32 height)
+  {
+    lcd_draw_frame2_rect(frame, x, y, width, height);
+  }
   
   void FaceDisplayImpl::FacePrintf(const char* format, ...)
   {
@@ -83,6 +83,9 @@ public:
   // Moves the menu cursor up/down
   void MoveMenuCursorUp();
   void MoveMenuCursorDown();
+
+  // Index of the selected menu item
+  size_t GetMenuCursor() const { return _menuCursor; }
   
   // Draws the menu items and cursor onto the given image
   void DrawMenu(Vision::ImageRGB565& img) const;
@@ -143,6 +143,9 @@ namespace {
 
   // How long the button needs to be pressed for before it should trigger shutdown animation
   CONSOLE_VAR( u32, kButtonPressDurationForShutdown_ms, "FaceInfoScreenManager", 500 );
+
+  // Redraw only the lines of a text screen that changed since it was last drawn
+  CONSOLE_VAR( bool, kFaceInfoScreenIncrementalRender, "FaceInfoScreenManager", true );
 #if ANKI_DEV_CHEATS
   // Fake one of several types of button presses. This value will get reset immediately, so to
   // run it again from the web interface, first set it to NoOp
@@ -1738,28 +1741,16 @@ void FaceInfoScreenManager::DrawTextOnScreen(const std::vector<std::string>& tex
                                              u32 textSpacing_pix,
                                              f32 textScale)
 {
-  _scratchDrawingImg->FillWith( {bgColor.r(), bgColor.g(), bgColor.b()} );
-
-  const f32 textLocX = loc.x();
-  f32 textLocY = loc.y();
-  // TODO: Expose line and location(?) as arguments
-  const u8  textLineThickness = 8;
-
   textScale = IsXray() ? textScale - 0.05f : textScale;
 
+  ColoredTextLines lines;
+  lines.reserve(textVec.size());
   for(const auto& text : textVec)
   {
-    _scratchDrawingImg->DrawText(
-      {textLocX, textLocY},
-      text.c_str(),
-      textColor,
-      textScale,
-      textLineThickness);
-
-    textLocY += textSpacing_pix;
+    lines.push_back({ColoredText(text, textColor)});
   }
 
-  DrawScratch();
+  DrawTextOnScreen(lines, bgColor, loc, textSpacing_pix, textScale);
 }
 
 void FaceInfoScreenManager::DrawTextOnScreen(const ColoredTextLines& lines,
@@ -1768,44 +1759,154 @@ void FaceInfoScreenManager::DrawTextOnScreen(const ColoredTextLines& lines,
                                              u32 textSpacing_pix,
                                              f32 textScale)
 {
-  _scratchDrawingImg->FillWith( {bgColor.r(), bgColor.g(), bgColor.b()} );
+  const TextScreenLayer& layer = _textScreenLayer;
+  const bool sameLayout = kFaceInfoScreenIncrementalRender &&
+                          layer.valid &&
+                          (layer.screen == _currScreen) &&
+                          (layer.menuCursor == _currScreen->GetMenuCursor()) &&
+                          (layer.debugPixel == ShouldDrawDebugScreensEnabledPixel()) &&
+                          (layer.bgColor.AsRGBA() == bgColor.AsRGBA()) &&
+                          (layer.loc == loc) &&
+                          (layer.textSpacing_pix == textSpacing_pix) &&
+                          (layer.textScale == textScale) &&
+                          (layer.lines.size() == lines.size());
+
+  auto areLinesEqual = [](const std::vector<ColoredText>& line1, const std::vector<ColoredText>& line2) {
+    if(line1.size() != line2.size())
+    {
+      return false;
+    }
+    for(size_t i = 0; i < line1.size(); ++i)
+    {
+      if((line1[i].text != line2[i].text) ||
+         (line1[i].color.AsRGBA() != line2[i].color.AsRGBA()) ||
+         (line1[i].leftAlign != line2[i].leftAlign))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
 
-  const u8  textLineThickness = 8;
+  if(!sameLayout)
+  {
+    _scratchDrawingImg->FillWith( {bgColor.r(), bgColor.g(), bgColor.b()} );
 
-  f32 textLocY = loc.y();
-  for(const auto& line : lines)
+    f32 textLocY = loc.y();
+    for(const auto& line : lines)
+    {
+      DrawTextLine(line, loc, textLocY, textScale);
+      textLocY += textSpacing_pix;
+    }
+
+    DrawScratch();
+  }
+  else
   {
-    f32 textOffsetX = loc.x();
-    f32 textOffsetXRight = loc.x();
-    for(const auto& coloredText : line)
+    // Rows each line can touch: DrawText takes the baseline, glyph descenders reach about half the height of a
+    // capital below it, and the drop shadow is one more pixel down
+    const s32 ascent = static_cast<s32>(Vision::Image::GetTextSize("M", textScale, 1).y());
+    auto getLineTop    = [&](size_t i) { return static_cast<s32>(loc.y() + i*textSpacing_pix) - ascent - 1; };
+    auto getLineBottom = [&](size_t i) { return static_cast<s32>(loc.y() + i*textSpacing_pix) + ascent/2 + 2; };
+
+    // Rows of the lines that changed
+    s32 damageTop = FACE_DISPLAY_HEIGHT;
+    s32 damageBottom = 0;
+    for(size_t i = 0; i < lines.size(); ++i)
     {
-      f32 textLocX = textOffsetX;
-      
-      auto bbox = Vision::Image::GetTextSize(coloredText.text.c_str(), textScale, textLineThickness);
-      if(coloredText.leftAlign)
+      if(!areLinesEqual(lines[i], layer.lines[i]))
       {
-        textOffsetX += bbox.x();
+        damageTop = std::min(damageTop, getLineTop(i));
+        damageBottom = std::max(damageBottom, getLineBottom(i));
       }
-      else
+    }
+
+    // Clearing those rows erases part of any line that overlaps them, so grow them until they cover every line
+    // that has to be redrawn
+    std::vector<bool> redrawLine(lines.size(), false);
+    bool grew = (damageTop < damageBottom);
+    while(grew)
+    {
+      grew = false;
+      for(size_t i = 0; i < lines.size(); ++i)
       {
-        // Right align text, need to account for the width of the text as DrawText expects the bottom left corner
-        // location
-        textLocX = FACE_DISPLAY_WIDTH - bbox.x() - textOffsetXRight;
-        textOffsetXRight += bbox.x();
+        if(!redrawLine[i] && (getLineTop(i) < damageBottom) && (getLineBottom(i) > damageTop))
+        {
+          redrawLine[i] = true;
+          damageTop = std::min(damageTop, getLineTop(i));
+          damageBottom = std::max(damageBottom, getLineBottom(i));
+          grew = true;
+        }
       }
-      
-      _scratchDrawingImg->DrawText({textLocX, textLocY},
-                                   coloredText.text.c_str(),
-                                   coloredText.color,
-                                   textScale,
-                                   textLineThickness);
+    }
 
+    damageTop = std::max(damageTop, 0);
+    damageBottom = std::min(damageBottom, static_cast<s32>(FACE_DISPLAY_HEIGHT));
+    Rectangle<s32> damage(0, 0, 0, 0);
+    if(damageTop < damageBottom)
+    {
+      damage = Rectangle<s32>(0, damageTop, FACE_DISPLAY_WIDTH, damageBottom - damageTop);
 
+      const Rectangle<f32> rect(0.f, damageTop, FACE_DISPLAY_WIDTH, damageBottom - damageTop);
+      _scratchDrawingImg->DrawFilledRect(rect, bgColor);
+      for(size_t i = 0; i < lines.size(); ++i)
+      {
+        if(redrawLine[i])
+        {
+          DrawTextLine(lines[i], loc, loc.y() + i*textSpacing_pix, textScale);
+        }
+      }
     }
-    textLocY += textSpacing_pix;
-  }
 
-  DrawScratch();
+    // Still drawn when nothing changed, in case something else was on the display in the meantime
+    DrawScratch(damage);
+  }
+
+  // DrawScratch() above forgets the layer
+  _textScreenLayer.valid = kFaceInfoScreenIncrementalRender;
+  _textScreenLayer.screen = _currScreen;
+  _textScreenLayer.menuCursor = _currScreen->GetMenuCursor();
+  _textScreenLayer.debugPixel = ShouldDrawDebugScreensEnabledPixel();
+  _textScreenLayer.bgColor = bgColor;
+  _textScreenLayer.loc = loc;
+  _textScreenLayer.textSpacing_pix = textSpacing_pix;
+  _textScreenLayer.textScale = textScale;
+  // ColoredText isn't assignable, so replace the whole vector
+  _textScreenLayer.lines = ColoredTextLines(lines);
+}
+
+void FaceInfoScreenManager::DrawTextLine(const std::vector<ColoredText>& line,
+                                         const Point2f& loc,
+                                         f32 textLocY,
+                                         f32 textScale)
+{
+  const u8  textLineThickness = 8;
+
+  f32 textOffsetX = loc.x();
+  f32 textOffsetXRight = loc.x();
+  for(const auto& coloredText : line)
+  {
+    f32 textLocX = textOffsetX;
+    
+    auto bbox = Vision::Image::GetTextSize(coloredText.text.c_str(), textScale, textLineThickness);
+    if(coloredText.leftAlign)
+    {
+      textOffsetX += bbox.x();
+    }
+    else
+    {
+      // Right align text, need to account for the width of the text as DrawText expects the bottom left corner
+      // location
+      textLocX = FACE_DISPLAY_WIDTH - bbox.x() - textOffsetXRight;
+      textOffsetXRight += bbox.x();
+    }
+    
+    _scratchDrawingImg->DrawText({textLocX, textLocY},
+                                 coloredText.text.c_str(),
+                                 coloredText.color,
+                                 textScale,
+                                 textLineThickness);
+  }
 }
 
 void FaceInfoScreenManager::DrawToF(const RangeDataDisplay& data)
@@ -1994,20 +2095,30 @@ void FaceInfoScreenManager::EnableMirrorModeScreen(bool enable)
   }
 }
 
+bool FaceInfoScreenManager::ShouldDrawDebugScreensEnabledPixel() const
+{
+  return _debugInfoScreensUnlocked && GetCurrScreenName() == ScreenName::Main;
+}
+
 void FaceInfoScreenManager::DrawScratch()
+{
+  // Whatever was drawn into _scratchDrawingImg isn't what DrawTextOnScreen() remembers drawing
+  _textScreenLayer.valid = false;
+  DrawScratch(Rectangle<s32>(0, 0, FACE_DISPLAY_WIDTH, FACE_DISPLAY_HEIGHT));
+}
+
+void FaceInfoScreenManager::DrawScratch(const Rectangle<s32>& damage)
 {
   _currScreen->DrawMenu(*_scratchDrawingImg);
 
   // Draw white pixel in top-right corner of main customer support screen
   // to indicate that debug screens are unlocked
-  const bool drawDebugScreensEnabledPixel = _debugInfoScreensUnlocked &&
-                                            GetCurrScreenName() == ScreenName::Main;
-  if (drawDebugScreensEnabledPixel) {
+  if (ShouldDrawDebugScreensEnabledPixel()) {
     Rectangle<f32> rect(FACE_DISPLAY_WIDTH - 2, 0, 2, 2);
     _scratchDrawingImg->DrawFilledRect(rect, NamedColors::WHITE);
   }
 
-  FaceDisplay::getInstance()->DrawToFaceDebug(*_scratchDrawingImg);
+  FaceDisplay::getInstance()->DrawToFaceDebug(*_scratchDrawingImg, damage);
 }
 
 void FaceInfoScreenManager::Reboot()
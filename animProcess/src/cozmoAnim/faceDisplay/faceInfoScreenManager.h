@@ -21,6 +21,7 @@
 #include "coretech/common/shared/types.h"
 #include "coretech/common/engine/colorRGBA.h"
 #include "coretech/common/shared/math/point_fwd.h"
+#include "coretech/common/shared/math/rect.h"
 #include "cozmoAnim/faceDisplay/faceInfoScreenTypes.h"
 #include "clad/robotInterface/messageEngineToRobot.h"
 #include "clad/cloud/mic.h"
@@ -192,6 +193,11 @@ private:
   // Draw the _scratchDrawingImg to the face
   void DrawScratch();
 
+  // Same as above, where damage is the part of _scratchDrawingImg that DrawTextOnScreen() changed since it last
+  // drew it. Anything else that draws to _scratchDrawingImg must use DrawScratch() above, which forgets what
+  // DrawTextOnScreen() drew so that the next text screen is drawn whole.
+  void DrawScratch(const Rectangle<s32>& damage);
+
   // Updates the FAC screen if needed
   void UpdateFAC();
 
@@ -230,6 +236,27 @@ private:
                         u32 textSpacing_pix = kDefaultTextSpacing_pix,
                         f32 textScale = kDefaultTextScale);
 
+  // Draws one line of DrawTextOnScreen() with its baseline at textLocY
+  void DrawTextLine(const std::vector<ColoredText>& line, const Point2f& loc, f32 textLocY, f32 textScale);
+
+  // What DrawTextOnScreen() last drew into _scratchDrawingImg. When the same screen is drawn again with the same
+  // layout, only the rows of the lines whose text changed are cleared and redrawn, and only those are sent to the
+  // face, so screens like the live sensor readouts are cheap to refresh every tick
+  struct TextScreenLayer {
+    bool                  valid = false;
+    const FaceInfoScreen* screen = nullptr;
+    size_t                menuCursor = 0;
+    bool                  debugPixel = false;
+    ColorRGBA             bgColor;
+    Point2f               loc;
+    u32                   textSpacing_pix = 0;
+    f32                   textScale = 0.f;
+    ColoredTextLines      lines;
+  };
+  TextScreenLayer _textScreenLayer;
+
+  bool ShouldDrawDebugScreensEnabledPixel() const;
+
   RobotInterface::DrawTextOnScreen _customText;
   WebService::WebService* _webService;
   
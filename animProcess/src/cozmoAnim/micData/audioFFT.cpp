@@ -23,6 +23,7 @@ namespace Vector {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 AudioFFT::AudioFFT( unsigned int N )
 : _N{ N }
+, _normFactor{ 1.0f / (static_cast<DataType>(N) * N) }
 , _buff{ N, N }
 , _windowCoeffs(N, 0.0)
 {
@@ -64,37 +65,44 @@ void AudioFFT::AddSamples( const BuffType* samples, size_t numSamples )
 std::vector<AudioFFT::DataType> AudioFFT::GetPower()
 {
   std::vector<DataType> ret;
+  GetPower( ret );
+  return ret;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AudioFFT::GetPower( std::vector<DataType>& power )
+{
+  power.clear();
   
   if( !_hasEnoughSamples ) {
-    return ret;
+    return;
   }
   
-  ret.reserve( _N/2 );
+  power.reserve( _N/2 );
   
   // do dft if needed
   DoDFT();
   
   // compute power from _outData. real and imag components are interleaved
-  static const DataType normFactor = 1.0 / (_N*_N);
-  ret.push_back( (_outData[0]*_outData[0] + _outData[1]*_outData[1])*normFactor );
+  power.push_back( (_outData[0]*_outData[0] + _outData[1]*_outData[1])*_normFactor );
   for( int i=2; i<_N; i+=2 ) {
     const DataType mag = _outData[i]*_outData[i] + _outData[i+1]*_outData[i+1];
-    ret.push_back( 2*normFactor*mag );
+    power.push_back( 2*_normFactor*mag );
   }
-  
-  return ret;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioFFT::Reset()
 {
-  Cleanup();
-
-  _plan = (void*) PFFFT::pffft_new_setup( _N, PFFFT::PFFFT_REAL );
-  
-  int numBytes = _N * sizeof(float);
-  _inData = (float*) PFFFT::pffft_aligned_malloc( numBytes );
-  _outData = (float*) PFFFT::pffft_aligned_malloc( numBytes );
+  // the setup (twiddles) and aligned buffers only depend on _N, so they are made once and kept
+  if( _plan == nullptr ) {
+    _plan = (void*) PFFFT::pffft_new_setup( _N, PFFFT::PFFFT_REAL );
+    DEV_ASSERT_MSG( _plan != nullptr, "AudioFFT.Reset.InvalidLength", "%u", _N );
+    
+    int numBytes = _N * sizeof(float);
+    _inData = (float*) PFFFT::pffft_aligned_malloc( numBytes );
+    _outData = (float*) PFFFT::pffft_aligned_malloc( numBytes );
+  }
   
   _hasEnoughSamples = false;
   _dirty = false;
@@ -123,6 +131,23 @@ void AudioFFT::DoDFT()
   PFFFT::pffft_transform_ordered( (PFFFT::PFFFT_Setup*)_plan, _inData, _outData, work, PFFFT::PFFFT_FORWARD );
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+unsigned int AudioFFT::GetLargestValidLength( unsigned int maxN )
+{
+  for( unsigned int N = maxN - (maxN % 32); N > 0; N -= 32 ) {
+    unsigned int remaining = N / 32;
+    for( const unsigned int factor : {2, 3, 5} ) {
+      while( remaining % factor == 0 ) {
+        remaining /= factor;
+      }
+    }
+    if( remaining == 1 ) {
+      return N;
+    }
+  }
+  return 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void AudioFFT::Cleanup()
 {
@@ -42,8 +42,15 @@ public:
   // returns power of the last N samples in a vector of size N/2+1. Only call this if HasEnoughSamples().
   std::vector<DataType> GetPower();
   
+  // same as above, but fills power in place so that its storage is reused from one call to the next
+  void GetPower( std::vector<DataType>& power );
+  
   void Reset();
   
+  // largest N <= maxN that the FFT library can transform (a multiple of 32 with no prime factors other than 2, 3
+  // and 5), or 0 if there is none
+  static unsigned int GetLargestValidLength( unsigned int maxN );
+  
 private:
   
   // Computes the DFT of _buff, saving to _outData, only if _buff has changed
@@ -52,6 +59,7 @@ private:
   void Cleanup();
   
   const unsigned int _N;
+  const DataType _normFactor;
   Anki::Util::RingBuffContiguousRead<BuffType> _buff;
   
   bool _hasEnoughSamples = false;
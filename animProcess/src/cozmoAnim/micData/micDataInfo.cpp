@@ -10,8 +10,8 @@
 *
 */
 
-#include "cozmoAnim/FftComplex.h"
 #include "cozmoAnim/micData/micDataInfo.h"
+#include "cozmoAnim/micData/audioFFT.h"
 #include "audioUtil/waveFile.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
@@ -344,22 +344,45 @@ std::vector<uint32_t> MicDataInfo::GetFFTResultFromRaw(const AudioUtil::AudioChu
 {
   std::vector<uint32_t> perChannelFFT;
   
+  size_t numSamplesPerChannel = 0;
+  for(const auto& chunk : data)
+  {
+    numSamplesPerChannel += chunk.size() / kNumInputChannels;
+  }
+  
+  // The fft length has to be one the fft library supports, so a few samples at the end may be left out
+  const unsigned int fftLength = AudioFFT::GetLargestValidLength(Util::numeric_cast<unsigned int>(numSamplesPerChannel));
+  if(fftLength == 0)
+  {
+    LOG_WARNING("MicDataInfo.GetFFTResultFromRaw.TooFewSamples", "%zu samples per channel", numSamplesPerChannel);
+    return std::vector<uint32_t>(kNumInputChannels, 0);
+  }
+  
+  // Width of each fft bin in Hz at the rate the samples actually arrived at over length_s
+  const float binWidth_hz = numSamplesPerChannel / (fftLength * length_s);
+  
+  AudioFFT fft{fftLength};
+  std::vector<AudioUtil::AudioSample> channelData;
+  channelData.reserve(fftLength);
+  std::vector<float> power;
+  
   // Run a seperate fft for each of the channels/mics
   for(auto i = 0; i < kNumInputChannels; ++i)
   {
     // Deinterlace the current channel from the raw audio chunks
     // Order in each raw audio chunk is channel 0,1,2,3,0,1,2,3,...
-    std::vector<std::complex<double> > fftArray;
+    channelData.clear();
     for(const auto& chunk : data)
     {
-      for(uint32_t j = i; j < chunk.size(); j += kNumInputChannels)
+      for(uint32_t j = i; (j < chunk.size()) && (channelData.size() < fftLength); j += kNumInputChannels)
       {
-        fftArray.push_back(chunk[j]);
+        channelData.push_back(chunk[j]);
       }
     }
     
-    // Run fft in place
-    Fft::transform(fftArray);
+    fft.Reset();
+    fft.AddSamples(channelData.data(), channelData.size());
+    fft.GetPower(power);
     
     // Keep track of the largest/most prominent value and index
     // from the fft
@@ -369,19 +392,16 @@ std::vector<uint32_t> MicDataInfo::GetFFTResultFromRaw(const AudioUtil::AudioChu
     uint32_t largestValueIdx = 0;
     
     // Skip the first one since it is garbage and often really large
-    // Only look at the first half since the second half is just the inverse of the first
     // Only look at every other element to save processing time
-    for(int i = 1; i < fftArray.size()/2; i += 2)
+    for(int k = 1; k < power.size(); k += 2)
     {
-      const auto& e = fftArray[i];
-      float magSq = e.real()*e.real() + e.imag()*e.imag();
-      if(magSq > largestValue)
+      if(power[k] > largestValue)
       {
-        largestValue = magSq;
-        largestValueIdx = i;
+        largestValue = power[k];
+        largestValueIdx = k;
       }
     }
-    perChannelFFT.push_back((uint32_t)(largestValueIdx/length_s));
+    perChannelFFT.push_back((uint32_t)(largestValueIdx * binWidth_hz));
   }
   
   return perChannelFFT;
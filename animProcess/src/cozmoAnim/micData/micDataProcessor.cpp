@@ -37,6 +37,8 @@
 #include "util/math/math.h"
 #include "util/threading/threadPriority.h"
 #include "clad/robotInterface/messageRobotToEngine_sendAnimToEngine_helper.h"
+#include <algorithm>
+#include <chrono>
 #include <list>
 #include <sched.h>
 
@@ -75,6 +77,57 @@ namespace {
 
   CONSOLE_VAR(bool, kBeatDetectorUseProcessedAudio, CONSOLE_GROUP, true);
   
+  // Periodically log how long blocks wait for, and spend in, each stage of the pipeline
+  CONSOLE_VAR(bool, kMicData_LogPipelineLatencies, CONSOLE_GROUP, false);
+  const auto kPipelineLatencyLogPeriod = std::chrono::seconds(10);
+  
+  // Where each stage of the pipeline runs. Raw and Trigger are on the trigger word's critical path, so on the robot
+  // they each get a core and a realtime priority. Beat shares Raw's core at the default priority, so it only gets the
+  // time Raw leaves over
+  struct PipelineStageThreadConfig {
+    const char* name;
+    int cpu;
+    Anki::Util::ThreadPriority priority;
+  };
+  const PipelineStageThreadConfig kRawStageThread     = { "MicProcRaw",     2, Anki::Util::ThreadPriority::High };
+  const PipelineStageThreadConfig kTriggerStageThread = { "MicProcTrigger", 1, Anki::Util::ThreadPriority::High };
+  const PipelineStageThreadConfig kBeatStageThread    = { "MicProcBeat",    2, Anki::Util::ThreadPriority::Default };
+  
+  // Called from the stage's own thread
+  void ConfigureStageThread(const PipelineStageThreadConfig& config)
+  {
+    Anki::Util::SetThreadName(pthread_self(), config.name);
+    
+#if defined(ANKI_PLATFORM_VICOS)
+    // Setup the thread's affinity mask
+    cpu_set_t cpu_set;
+    CPU_ZERO(&cpu_set);
+    CPU_SET(config.cpu, &cpu_set);
+    int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+    if (error != 0) {
+      LOG_ERROR("MicDataProcessor.ConfigureStageThread", "%s SetAffinityMaskError %d", config.name, error);
+    }
+#endif
+  }
+  
+  void SetStageThreadPriority(std::thread& thread, const PipelineStageThreadConfig& config)
+  {
+#if defined(ANKI_PLATFORM_VICOS)
+    if (config.priority != Anki::Util::ThreadPriority::Default) {
+      Anki::Util::SetThreadPriority(thread, config.priority);
+    }
+#endif
+  }
+  
+  void UpdateMax(std::atomic<uint32_t>& maxValue, uint32_t value)
+  {
+    // Only the stage's own thread raises the max, so this needs no compare-exchange. A reset from
+    // GetPipelineStageLatencies() landing in between only loses that one sample
+    if (value > maxValue.load(std::memory_order_relaxed)) {
+      maxValue.store(value, std::memory_order_relaxed);
+    }
+  }
+  
   #define ENABLE_MIC_PROCESSING_STATE_UPDATE_LOG 0
   using MicProcessingState = MicDataProcessor::ProcessingState;
   const MicProcessingState kDefaultProcessingState = MicProcessingState::SigEsBeamformingOff;
@@ -84,8 +137,8 @@ namespace {
 
 CONSOLE_VAR_RANGED(float, maxProcessingTimePerDrop_ms,      "CpuProfiler", 5, 5, 32);
 
-#if ANKI_CPU_PROFILER_ENABLED
 CONSOLE_VAR_RANGED(float, maxTriggerProcTime_ms,            ANKI_CPU_CONSOLEVARGROUP, 10, 10, 32);
+#if ANKI_CPU_PROFILER_ENABLED
 CONSOLE_VAR_ENUM(u8,      kMicDataProcessorRaw_Logging,     ANKI_CPU_CONSOLEVARGROUP, 0, Util::CpuProfiler::CpuProfilerLogging());
 CONSOLE_VAR_ENUM(u8,      kMicDataProcessorTrigger_Logging, ANKI_CPU_CONSOLEVARGROUP, 0, Util::CpuProfiler::CpuProfilerLogging());
 #endif
@@ -141,9 +194,15 @@ void MicDataProcessor::Init()
   
   // Start the thread doing the SE processing of audio
   _processThread = std::thread(&MicDataProcessor::ProcessRawLoop, this);
+  SetStageThreadPriority(_processThread, kRawStageThread);
   
   // Start the thread doing the Sensory processing of audio
   _processTriggerThread = std::thread(&MicDataProcessor::ProcessTriggerLoop, this);
+  SetStageThreadPriority(_processTriggerThread, kTriggerStageThread);
+  
+  // Start the thread doing beat detection
+  _processBeatThread = std::thread(&MicDataProcessor::ProcessBeatLoop, this);
+  SetStageThreadPriority(_processBeatThread, kBeatStageThread);
 }
 
 void MicDataProcessor::InitVAD()
@@ -377,6 +436,7 @@ MicDataProcessor::~MicDataProcessor()
   _dataReadyCondition.notify_all();
   _processThread.join();
   _processTriggerThread.join();
+  _processBeatThread.join();
 
   MMIfDestroy();
 }
@@ -419,13 +479,9 @@ void MicDataProcessor::ProcessRawAudio(RobotTimeStamp_t timestamp,
     robotStatus,
     robotAngle);
 
-  // Feed the samples to the beat detector. Optionally either use a raw single channel (the first quarter of the
-  // un-interleaved audio block) or the processed audio block
-  auto* audioSource = kBeatDetectorUseProcessedAudio ? nextSample.audioBlock.data() : audioChunk;
-  
-  UpdateBeatDetector(audioSource, kSamplesPerBlockPerChannel);
-  
-  // Now we're done filling out this slot, update the count so it can be consumed
+  // Now we're done filling out this slot, update the count so it can be consumed. This is done before anything else
+  // so that the Trigger stage never waits on the rest
+  nextSample.readyTime = std::chrono::steady_clock::now();
   {
     std::lock_guard<std::mutex> lock(_procAudioXferMutex);
     ++_procAudioXferCount;
@@ -433,6 +489,16 @@ void MicDataProcessor::ProcessRawAudio(RobotTimeStamp_t timestamp,
   }
   _dataReadyCondition.notify_all();
 
+  // Queue the samples for the beat detector. Optionally either use a raw single channel (the first quarter of the
+  // un-interleaved audio block) or the processed audio block. If the Beat stage is behind, the block is dropped
+  auto* audioSource = kBeatDetectorUseProcessedAudio ? nextSample.audioBlock.data() : audioChunk;
+  BeatDetectorBlock* beatBlock = _beatDetectorRing.push_begin();
+  if (nullptr != beatBlock) {
+    std::copy(audioSource, audioSource + kSamplesPerBlockPerChannel, beatBlock->audioBlock.begin());
+    beatBlock->readyTime = nextSample.readyTime;
+    _beatDetectorRing.push_commit();
+  }
+
   // Store off this most recent result in our immedate direction tracking
   _micImmediateDirection->AddDirectionSample(directionResult);
 
@@ -668,19 +734,9 @@ MicDirectionData MicDataProcessor::ProcessMicrophonesSE(const AudioUtil::AudioSa
 
 void MicDataProcessor::ProcessRawLoop()
 {
-  Anki::Util::SetThreadName(pthread_self(), "MicProcRaw");
-  
-#if defined(ANKI_PLATFORM_VICOS)
-  // Setup the thread's affinity mask
-  cpu_set_t cpu_set;
-  CPU_ZERO(&cpu_set);
-  CPU_SET(2, &cpu_set);
-  int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
-  if (error != 0) {
-    LOG_ERROR("MicDataProcessor.ProcessRawLoop", "SetAffinityMaskError %d", error);
-  }
-#endif
+  ConfigureStageThread(kRawStageThread);
   
+  auto lastLatencyLogTime = std::chrono::steady_clock::now();
   static constexpr uint32_t expectedAudioDropsPerAnimLoop = 7;
   static const uint32_t maxProcTime_ms = expectedAudioDropsPerAnimLoop * maxProcessingTimePerDrop_ms;
   const auto maxProcTime = std::chrono::milliseconds(maxProcTime_ms);
@@ -689,21 +745,13 @@ void MicDataProcessor::ProcessRawLoop()
     ANKI_CPU_TICK("MicDataProcessorRaw", maxProcTime_ms, Util::CpuProfiler::CpuProfilerLoggingTime(kMicDataProcessorRaw_Logging));
     const auto start = std::chrono::steady_clock::now();
   
-    // Switch which buffer we're processing if it's empty
-    {
-      std::lock_guard<std::mutex> lock(_rawMicDataMutex);
-      if (_rawAudioBuffers[_rawAudioProcessingIndex].empty())
-      {
-        _rawAudioProcessingIndex = (_rawAudioProcessingIndex == 1) ? 0 : 1;
-      }
-    }
-
-    auto& rawAudioToProcess = _rawAudioBuffers[_rawAudioProcessingIndex];
-    while (rawAudioToProcess.size() > 0)
+    // Everything the producer has published so far. Chunks are processed in place and only released afterwards
+    while (RawMicChunk* nextChunk = _rawAudioRing.front())
     {
       ANKI_CPU_PROFILE("ProcessLoop");
 
-      const auto& nextData = rawAudioToProcess.front();
+      const auto chunkStart = std::chrono::steady_clock::now();
+      const auto& nextData = nextChunk->payload;
       const auto* audioChunk = nextData.data;
       
       // Copy the current set of jobs we have for recording audio, so the list can be added to while processing
@@ -730,7 +778,33 @@ void MicDataProcessor::ProcessRawLoop()
       
       _micDataSystem->UpdateMicJobs();
       
-      rawAudioToProcess.pop_front();
+      GetStageStats(PipelineStage::Raw).Record(nextChunk->receivedTime, chunkStart, std::chrono::steady_clock::now());
+      _rawAudioRing.pop_front();
+    }
+
+    // Report dropped audio at most once a second, since it tends to come in runs
+    const uint32_t numOverruns = _rawAudioRing.GetNumOverruns();
+    if ((numOverruns != _rawAudioReportedOverruns) && (start - _rawAudioOverrunReportTime > std::chrono::seconds(1)))
+    {
+      LOG_WARNING("MicDataProcessor.ProcessRawLoop.RawAudioOverrun",
+                  "Dropped %u incoming mic chunks (%u total), max wait %u us",
+                  numOverruns - _rawAudioReportedOverruns, numOverruns,
+                  GetStageStats(PipelineStage::Raw).maxWait_us.load());
+      _rawAudioReportedOverruns = numOverruns;
+      _rawAudioOverrunReportTime = start;
+    }
+
+    if (kMicData_LogPipelineLatencies && (start - lastLatencyLogTime > kPipelineLatencyLogPeriod))
+    {
+      lastLatencyLogTime = start;
+      uint32_t wait_us[3], process_us[3];
+      GetPipelineStageLatencies(PipelineStage::Raw,     wait_us[0], process_us[0]);
+      GetPipelineStageLatencies(PipelineStage::Trigger, wait_us[1], process_us[1]);
+      GetPipelineStageLatencies(PipelineStage::Beat,    wait_us[2], process_us[2]);
+      LOG_INFO("MicDataProcessor.ProcessRawLoop.PipelineLatencies",
+               "Max wait/process us: Raw %u/%u, Trigger %u/%u, Beat %u/%u (%u beat blocks dropped)",
+               wait_us[0], process_us[0], wait_us[1], process_us[1], wait_us[2], process_us[2],
+               _beatDetectorRing.GetNumOverruns());
     }
 
     const auto end = std::chrono::steady_clock::now();
@@ -744,18 +818,7 @@ void MicDataProcessor::ProcessRawLoop()
 
 void MicDataProcessor::ProcessTriggerLoop()
 {
-  Anki::Util::SetThreadName(pthread_self(), "MicProcTrigger");
-  
-#if defined(ANKI_PLATFORM_VICOS)
-  // Setup the thread's affinity mask
-  cpu_set_t cpu_set;
-  CPU_ZERO(&cpu_set);
-  CPU_SET(1, &cpu_set);
-  int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
-  if (error != 0) {
-    LOG_ERROR("MicDataProcessor.ProcessTriggerLoop", "SetAffinityMaskError %d", error);
-  }
-#endif
+  ConfigureStageThread(kTriggerStageThread);
   
   while (!_processThreadStop)
   {
@@ -779,7 +842,9 @@ void MicDataProcessor::ProcessTriggerLoop()
       readyDataSpot = &_immediateAudioBuffer[_procAudioRawComplete - _procAudioXferCount];
     }
 
+    const auto blockStart = std::chrono::steady_clock::now();
     const auto& processedAudio = readyDataSpot->audioBlock;
+    _triggerStageTimestamp = (TimeStamp_t) readyDataSpot->timestamp;
     std::deque<std::shared_ptr<MicDataInfo>> jobs = _micDataSystem->GetMicDataJobs();
     for (auto& job : jobs)
     {
@@ -795,6 +860,8 @@ void MicDataProcessor::ProcessTriggerLoop()
                                       (_micImmediateDirection->GetLatestSample().activeState != 0));
     }
 
+    GetStageStats(PipelineStage::Trigger).Record(readyDataSpot->readyTime, blockStart, std::chrono::steady_clock::now());
+
     // Now we're done using this audio with the recognizer, so let it go
     {
       std::lock_guard<std::mutex> lock(_procAudioXferMutex);
@@ -804,6 +871,51 @@ void MicDataProcessor::ProcessTriggerLoop()
   }
 }
   
+void MicDataProcessor::ProcessBeatLoop()
+{
+  ConfigureStageThread(kBeatStageThread);
+  
+  // Beat detection isn't latency critical, so it just drains whatever has queued up every few blocks
+  const auto pollPeriod = std::chrono::milliseconds(3 * kTimePerChunk_ms);
+  while (!_processThreadStop)
+  {
+    while (BeatDetectorBlock* nextBlock = _beatDetectorRing.front())
+    {
+      const auto blockStart = std::chrono::steady_clock::now();
+      UpdateBeatDetector(nextBlock->audioBlock.data(), kSamplesPerBlockPerChannel);
+      GetStageStats(PipelineStage::Beat).Record(nextBlock->readyTime, blockStart, std::chrono::steady_clock::now());
+      _beatDetectorRing.pop_front();
+    }
+    std::this_thread::sleep_for(pollPeriod);
+  }
+}
+
+void MicDataProcessor::PipelineStageStats::Record(std::chrono::steady_clock::time_point readyTime,
+                                                  std::chrono::steady_clock::time_point startTime,
+                                                  std::chrono::steady_clock::time_point endTime)
+{
+  using namespace std::chrono;
+  UpdateMax(maxWait_us,    (uint32_t) std::max<int64_t>(0, duration_cast<microseconds>(startTime - readyTime).count()));
+  UpdateMax(maxProcess_us, (uint32_t) duration_cast<microseconds>(endTime - startTime).count());
+  totalProcess_ns.store(totalProcess_ns.load(std::memory_order_relaxed) + duration_cast<nanoseconds>(endTime - startTime).count(),
+                        std::memory_order_relaxed);
+  numBlocks.store(numBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+}
+
+void MicDataProcessor::GetPipelineStageLatencies(PipelineStage stage, uint32_t& out_maxWait_us, uint32_t& out_maxProcess_us)
+{
+  auto& stats = GetStageStats(stage);
+  out_maxWait_us    = stats.maxWait_us.exchange(0);
+  out_maxProcess_us = stats.maxProcess_us.exchange(0);
+}
+
+void MicDataProcessor::GetPipelineStageTotals(PipelineStage stage, uint64_t& out_totalProcess_us, uint32_t& out_numBlocks) const
+{
+  const auto& stats = GetStageStats(stage);
+  out_totalProcess_us = stats.totalProcess_ns.load(std::memory_order_relaxed) / 1000;
+  out_numBlocks       = stats.numBlocks.load(std::memory_order_relaxed);
+}
+
 void MicDataProcessor::UpdateBeatDetector(const AudioUtil::AudioSample* const samples, const uint32_t nSamples)
 {
   ANKI_CPU_PROFILE("BeatDetectorUpdate");
@@ -820,6 +932,7 @@ void MicDataProcessor::UpdateBeatDetector(const AudioUtil::AudioSample* const sa
     
     const bool beatDetected = _beatDetector->AddSamples(samples, nSamples);
     if (beatDetected) {
+      ++_numBeatsDetected;
       auto beatMessage = RobotInterface::BeatDetectorState{_beatDetector->GetLatestBeat()};
       auto engineMessage = std::make_unique<RobotInterface::RobotToEngine>(std::move(beatMessage));
       _micDataSystem->SendMessageToEngine(std::move(engineMessage));
@@ -829,19 +942,26 @@ void MicDataProcessor::UpdateBeatDetector(const AudioUtil::AudioSample* const sa
   
 void MicDataProcessor::ProcessMicDataPayload(const RobotInterface::MicData& payload)
 {
-  // Store off this next job
-  std::lock_guard<std::mutex> lock(_rawMicDataMutex);
-  if (!_muteMics) {
-    // Use whichever buffer is currently _not_ being processed
-    auto& bufferToUse = (_rawAudioProcessingIndex == 1) ? _rawAudioBuffers[0] : _rawAudioBuffers[1];
-    RobotInterface::MicData& nextJob = bufferToUse.push_back();
-    nextJob = payload;
+  if (_muteMics) {
+    return;
   }
+  
+  // Store off this next job. If the processing thread is too far behind the chunk is dropped (and counted)
+  RawMicChunk* nextChunk = _rawAudioRing.push_begin();
+  if (nullptr == nextChunk) {
+    _rawAudioPeakFullness = 1.f;
+    return;
+  }
+  nextChunk->payload = payload;
+  nextChunk->receivedTime = std::chrono::steady_clock::now();
+  _rawAudioRing.push_commit();
+  
+  const float fullness = ((float)_rawAudioRing.size()) / ((float)_rawAudioRing.capacity());
+  _rawAudioPeakFullness = MAX(_rawAudioPeakFullness, fullness);
 }
   
 void MicDataProcessor::MuteMics(bool mute)
 {
-  std::lock_guard<std::mutex> lock(_rawMicDataMutex);
   _muteMics = mute;
 }
 
@@ -853,15 +973,11 @@ void MicDataProcessor::ResetMicListenDirection()
 
 float MicDataProcessor::GetIncomingMicDataPercentUsed()
 {
-  std::lock_guard<std::mutex> lock(_rawMicDataMutex);
-  // Use whichever buffer is currently _not_ being processed
-  const auto inUseIndex = (_rawAudioProcessingIndex == 1) ? 0 : 1;
-  const auto& bufferInUse = _rawAudioBuffers[inUseIndex];
-  const auto updatedFullness = ((float)bufferInUse.size()) / ((float)bufferInUse.capacity());
-  // Cache the current fullness for this buffer and use the greater of the two buffer fullnesses
-  // This way the "fullness" returned is less variable and better covers the worst case
-  _rawAudioBufferFullness[inUseIndex] = updatedFullness;
-  return MAX(_rawAudioBufferFullness[0], _rawAudioBufferFullness[1]);
+  // Use the peak since the last call rather than the current fullness, which saws up and down as the processing
+  // thread drains the ring. This way the "fullness" returned is less variable and better covers the worst case
+  const float peakFullness = _rawAudioPeakFullness;
+  _rawAudioPeakFullness = ((float)_rawAudioRing.size()) / ((float)_rawAudioRing.capacity());
+  return peakFullness;
 }
 
 void MicDataProcessor::SetActiveMicDataProcessingState(MicDataProcessor::ProcessingState state)
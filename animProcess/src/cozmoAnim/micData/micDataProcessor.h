@@ -21,10 +21,12 @@
 #include "cozmoAnim/micData/micTriggerConfig.h"
 #include "clad/cloud/mic.h"
 #include "util/container/fixedCircularBuffer.h"
+#include "util/container/spscRingBuffer.h"
 #include "util/global/globalDefinitions.h"
 
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <memory>
@@ -83,8 +85,40 @@ public:
   void MuteMics(bool mute);
   
   void ResetMicListenDirection();
+  
+  // Highest fullness of the incoming raw audio ring since the last call. Call from the thread that calls
+  // ProcessMicDataPayload()
   float GetIncomingMicDataPercentUsed();
   
+  // Incoming raw audio chunks dropped because the ring was full
+  uint32_t GetNumIncomingMicDataOverruns() const { return _rawAudioRing.GetNumOverruns(); }
+  
+  // The mic processing pipeline. Each stage runs on its own thread and hands blocks to the next through a bounded
+  // queue, so that a slow stage only delays the stages after it:
+  //   Raw:     SE beamforming and VAD of each incoming chunk (fed by ProcessMicDataPayload)
+  //   Trigger: trigger word recognition on the processed audio (fed by Raw)
+  //   Beat:    beat detection on the processed or raw audio (fed by Raw, after Trigger has been handed the block)
+  enum class PipelineStage : uint8_t {
+    Raw = 0,
+    Trigger,
+    Beat,
+    Count
+  };
+  
+  // Longest a block waited in the stage's input queue, and longest the stage spent on one block, since the last
+  // call for that stage. Any thread
+  void GetPipelineStageLatencies(PipelineStage stage, uint32_t& out_maxWait_us, uint32_t& out_maxProcess_us);
+  
+  // Total time the stage has spent processing blocks, and how many it processed, since Init(). Never reset. Any thread
+  void GetPipelineStageTotals(PipelineStage stage, uint64_t& out_totalProcess_us, uint32_t& out_numBlocks) const;
+  
+  // Timestamp of the block the Trigger stage is working on, or last worked on. Read from a trigger word callback, it
+  // is where in the audio the trigger word was recognized
+  RobotTimeStamp_t GetTriggerStageTimestamp() const { return RobotTimeStamp_t(_triggerStageTimestamp.load()); }
+  
+  // Beats found by the beat detector since Init()
+  uint32_t GetNumBeatsDetected() const { return _numBeatsDetected; }
+  
   BeatDetector& GetBeatDetector() { assert(nullptr != _beatDetector); return *_beatDetector.get(); }
 
   // Create and start stream audio data job
@@ -119,22 +153,30 @@ private:
   uint32_t _vadCountdown = 0;
   std::unique_ptr<MicImmediateDirection> _micImmediateDirection;
 
-  static constexpr uint32_t kRawAudioBufferSize = kRawAudioPerBuffer_ms / kTimePerChunk_ms;
-  float _rawAudioBufferFullness[2] = { 0.f, 0.f };
-  // We have 2 fixed buffers for incoming raw audio that we alternate between, so that the processing thread can work
-  // on one set of data while the main thread can copy new data into the other set.
-  Util::FixedCircularBuffer<RobotInterface::MicData, kRawAudioBufferSize> _rawAudioBuffers[2];
-  // Index of the buffer that is currently being used by the processing thread
-  uint32_t _rawAudioProcessingIndex = 0;
+  // Incoming raw audio goes through a single-producer/single-consumer ring, so that the thread receiving mic messages
+  // never waits on the processing thread, nor the other way around. It holds (at least) the two buffers' worth of
+  // kRawAudioPerBuffer_ms that the double buffering it replaced could
+  static constexpr uint32_t kRawAudioRingSize = 256;
+  static_assert(kRawAudioRingSize * kTimePerChunk_ms >= 2 * kRawAudioPerBuffer_ms, "Raw audio ring too small");
+  struct RawMicChunk {
+    RobotInterface::MicData payload;
+    std::chrono::steady_clock::time_point receivedTime;
+  };
+  Util::SpscRingBuffer<RawMicChunk, kRawAudioRingSize> _rawAudioRing;
+  // Producer side only
+  float _rawAudioPeakFullness = 0.f;
+  // Consumer side
+  uint32_t _rawAudioReportedOverruns = 0;
+  std::chrono::steady_clock::time_point _rawAudioOverrunReportTime;
   std::thread _processThread;
   std::thread _processTriggerThread;
-  std::mutex _rawMicDataMutex;
-  bool _muteMics = false;
+  std::thread _processBeatThread;
+  std::atomic<bool> _muteMics{false};
   bool _processThreadStop = false;
   bool _robotWasMoving = false;
   bool _isSpeakerActive = false;
   bool _wasSpeakerActive = false;
-  bool _isInLowPowerMode = false;
+  std::atomic<bool> _isInLowPowerMode{false};
   uint32_t _speakerCooldownCnt = 0;
 
 #if ANKI_DEV_CHEATS
@@ -148,6 +190,7 @@ private:
   struct TimedMicData {
     std::array<AudioUtil::AudioSample, kSamplesPerBlockPerChannel> audioBlock;
     RobotTimeStamp_t timestamp;
+    std::chrono::steady_clock::time_point readyTime; // when it was handed to the Trigger stage
   };
   Util::FixedCircularBuffer<TimedMicData, kImmediateBufferSize> _immediateAudioBuffer;
 
@@ -167,6 +210,32 @@ private:
   // Aubio beat detector
   std::unique_ptr<BeatDetector> _beatDetector;
   
+  // Blocks waiting for the Beat stage. About half a second, after which blocks are dropped rather than ever making
+  // the Raw stage wait
+  static constexpr uint32_t kBeatDetectorRingSize = 64;
+  struct BeatDetectorBlock {
+    std::array<AudioUtil::AudioSample, kSamplesPerBlockPerChannel> audioBlock;
+    std::chrono::steady_clock::time_point readyTime;
+  };
+  Util::SpscRingBuffer<BeatDetectorBlock, kBeatDetectorRingSize> _beatDetectorRing;
+  
+  struct PipelineStageStats {
+    std::atomic<uint32_t> maxWait_us{0};
+    std::atomic<uint32_t> maxProcess_us{0};
+    // Only written by the stage's own thread
+    std::atomic<uint64_t> totalProcess_ns{0};
+    std::atomic<uint32_t> numBlocks{0};
+    void Record(std::chrono::steady_clock::time_point readyTime,
+                std::chrono::steady_clock::time_point startTime,
+                std::chrono::steady_clock::time_point endTime);
+  };
+  std::array<PipelineStageStats, static_cast<size_t>(PipelineStage::Count)> _pipelineStageStats;
+  PipelineStageStats& GetStageStats(PipelineStage stage) { return _pipelineStageStats[static_cast<size_t>(stage)]; }
+  const PipelineStageStats& GetStageStats(PipelineStage stage) const { return _pipelineStageStats[static_cast<size_t>(stage)]; }
+  
+  std::atomic<TimeStamp_t> _triggerStageTimestamp{0};
+  std::atomic<uint32_t> _numBeatsDetected{0};
+  
   enum class TriggerWordDetectSource : uint8_t {
     Invalid=0,
     Voice,
@@ -195,6 +264,7 @@ private:
 
   void ProcessRawLoop();
   void ProcessTriggerLoop();
+  void ProcessBeatLoop();
   
   void UpdateBeatDetector(const AudioUtil::AudioSample* const samples, const uint32_t nSamples);
   
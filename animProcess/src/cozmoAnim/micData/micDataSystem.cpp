@@ -70,6 +70,10 @@ CONSOLE_FUNC(ClearMicData, "zHiddenForSafety");
  
 #endif // ANKI_DEV_CHEATS
 
+// Codec for the audio of cloud mic streams, in MicStreamCodec order. Read when each stream starts. vic-cloud only
+// takes PCM, so ImaAdpcm is for trying out a vic-cloud built to decode it
+CONSOLE_VAR_ENUM(uint8_t, kMicData_CloudStreamCodec, CONSOLE_GROUP, 0, "PCM,ImaAdpcm");
+
 # undef CONSOLE_GROUP
 
   const std::string kMicSettingsFile = "micMuted";
@@ -144,6 +148,10 @@ void MicDataSystem::Init(const Anim::RobotDataLoader& dataLoader)
   // SpeechRecognizerSystem
   SpeechRecognizerSystem::TriggerWordDetectedCallback callback = [this] (const AudioUtil::SpeechRecognizerCallbackInfo& info) {
     
+    if (_triggerWordRecognizedCallback) {
+      _triggerWordRecognizedCallback(info);
+    }
+    
  #if ANKI_DEV_CHEATS
     SendTriggerDetectionToWebViz(info, {});
     if (kSuppressTriggerResponse) {
@@ -484,6 +492,9 @@ void MicDataSystem::Update(BaseStationTime_t currTime_nanosec)
         _currentlyStreaming = true;
         _streamingComplete = ShouldSimulateStreaming();
         _streamingAudioIndex = 0;
+        _streamingBytesSent = 0;
+        _streamEncoder.Reset(kMicData_CloudStreamCodec < (uint8_t) MicStreamCodec::Count ?
+                             (MicStreamCodec) kMicData_CloudStreamCodec : MicStreamCodec::PCM);
 
         // even though this isn't necessarily the exact frame the backpack lights begin (since that's done in a different
         // thread), it doesn't make a noticeable difference since this is an arbitrary number and doesn't need to be precise
@@ -496,7 +507,7 @@ void MicDataSystem::Update(BaseStationTime_t currTime_nanosec)
           hw.mode = _currentStreamingJob->_type;
         }
         SendUdpMessage(CloudMic::Message::Createhotword(std::move(hw)));
-        LOG_INFO("MicDataSystem.Update.StreamingStart", "");
+        LOG_INFO("MicDataSystem.Update.StreamingStart", "%s", MicStreamCodecToString(_streamEncoder.GetCodec()));
       }
       else
       {
@@ -526,7 +537,9 @@ void MicDataSystem::Update(BaseStationTime_t currTime_nanosec)
           {
             SendUdpMessage(CloudMic::Message::CreateaudioDone({}));
           }
-          LOG_INFO("MicDataSystem.Update.StreamingEnd", "%zu ms", _streamingAudioIndex * kTimePerChunk_ms);
+          LOG_INFO("MicDataSystem.Update.StreamingEnd", "%zu ms, %zu bytes sent (%s)",
+                   _streamingAudioIndex * kTimePerChunk_ms, _streamingBytesSent,
+                   MicStreamCodecToString(_streamEncoder.GetCodec()));
           #if ANKI_DEV_CHEATS
             _fakeStreamingState = false;
           #endif
@@ -546,7 +559,9 @@ void MicDataSystem::Update(BaseStationTime_t currTime_nanosec)
             {
               for(const auto& audioChunk : newAudio)
               {
-                SendUdpMessage(CloudMic::Message::Createaudio(CloudMic::AudioData{audioChunk}));
+                _streamEncoder.Encode(audioChunk.data(), audioChunk.size(), _encodedStreamChunk);
+                _streamingBytesSent += _encodedStreamChunk.size() * sizeof(AudioUtil::AudioSample);
+                SendUdpMessage(CloudMic::Message::Createaudio(CloudMic::AudioData{_encodedStreamChunk}));
               }
             }
           }
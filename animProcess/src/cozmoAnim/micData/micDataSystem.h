@@ -16,6 +16,7 @@
 
 #include "micDataTypes.h"
 #include "coretech/common/shared/types.h"
+#include "cozmoAnim/micData/micStreamEncoder.h"
 #include "cozmoAnim/speechRecognizer/speechRecognizerSystem.h"
 #include "util/global/globalDefinitions.h"
 #include "util/environment/locale.h"
@@ -131,6 +132,12 @@ public:
   void AddTriggerWordDetectedCallback(std::function<void(bool)> callback)
     { _triggerWordDetectedCallbacks.push_back(callback); }
 
+  // Called on the Trigger stage thread for every trigger word the recognizer hears, before deciding whether to
+  // respond to it. For tools measuring the recognizer itself, set it before any audio comes in
+  using TriggerWordRecognizedCallback = std::function<void(const AudioUtil::SpeechRecognizerCallbackInfo&)>;
+  void SetTriggerWordRecognizedCallback(TriggerWordRecognizedCallback callback)
+    { _triggerWordRecognizedCallback = std::move(callback); }
+
   // Callback parameter is whether or not the stream was started
   // True if started, False if stopped
   void AddStreamUpdatedCallback(std::function<void(bool)> callback)
@@ -170,6 +177,10 @@ private:
   bool _fakeStreamingState = false;
 #endif
   size_t _streamingAudioIndex = 0;
+  // Compresses the stream's chunks before they go over IPC to vic-cloud
+  MicStreamEncoder _streamEncoder;
+  AudioUtil::AudioChunk _encodedStreamChunk;
+  size_t _streamingBytesSent = 0;
   Util::Locale _locale = {"en", "US"};
   std::string _timeZone = "";
 
@@ -198,6 +209,7 @@ private:
 
   std::vector<std::function<void(bool)>> _triggerWordDetectedCallbacks;
   std::vector<std::function<void(bool)>> _streamUpdatedCallbacks;
+  TriggerWordRecognizedCallback _triggerWordRecognizedCallback;
 
   bool _batteryLow = false;
   bool _enableDataCollection = false;
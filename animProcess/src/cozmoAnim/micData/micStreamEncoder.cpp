@@ -0,0 +1,152 @@
+/**
+ * File: micStreamEncoder.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ */
+
+#include "cozmoAnim/micData/micStreamEncoder.h"
+
+#include "util/math/math.h"
+
+#include <algorithm>
+
+namespace Anki {
+namespace Vector {
+namespace MicData {
+
+namespace {
+  // IMA ADPCM tables
+  const int16_t kStepTable[] = {
+        7,     8,     9,    10,    11,    12,    13,    14,    16,    17,
+       19,    21,    23,    25,    28,    31,    34,    37,    41,    45,
+       50,    55,    60,    66,    73,    80,    88,    97,   107,   118,
+      130,   143,   157,   173,   190,   209,   230,   253,   279,   307,
+      337,   371,   408,   449,   494,   544,   598,   658,   724,   796,
+      876,   963,  1060,  1166,  1282,  1411,  1552,  1707,  1878,  2066,
+     2272,  2499,  2749,  3024,  3327,  3660,  4026,  4428,  4871,  5358,
+     5894,  6484,  7132,  7845,  8630,  9493, 10442, 11487, 12635, 13899,
+    15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+  };
+  constexpr int32_t kMaxStepIndex = (sizeof(kStepTable) / sizeof(kStepTable[0])) - 1;
+  
+  const int8_t kIndexTable[] = { -1, -1, -1, -1, 2, 4, 6, 8 };
+  
+  constexpr size_t kAdpcmHeaderSize = 2;
+  constexpr size_t kCodesPerSample = 4;
+  
+  // Applies one code to the predictor and step index, the same way on both sides
+  inline void ApplyCode(uint8_t code, int32_t& predictor, int32_t& stepIndex)
+  {
+    const int32_t step = kStepTable[stepIndex];
+    int32_t delta = step >> 3;
+    if (code & 4) { delta += step; }
+    if (code & 2) { delta += step >> 1; }
+    if (code & 1) { delta += step >> 2; }
+    predictor += (code & 8) ? -delta : delta;
+    predictor = Util::Clamp(predictor, (int32_t) INT16_MIN, (int32_t) INT16_MAX);
+    stepIndex = Util::Clamp(stepIndex + kIndexTable[code & 7], 0, kMaxStepIndex);
+  }
+  
+  inline uint8_t EncodeSample(int32_t sample, int32_t& predictor, int32_t& stepIndex)
+  {
+    int32_t diff = sample - predictor;
+    uint8_t code = 0;
+    if (diff < 0) {
+      code = 8;
+      diff = -diff;
+    }
+    int32_t step = kStepTable[stepIndex];
+    if (diff >= step) { code |= 4; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { code |= 2; diff -= step; }
+    step >>= 1;
+    if (diff >= step) { code |= 1; }
+    ApplyCode(code, predictor, stepIndex);
+    return code;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const char* MicStreamCodecToString(MicStreamCodec codec)
+{
+  switch (codec)
+  {
+    case MicStreamCodec::PCM:      return "PCM";
+    case MicStreamCodec::ImaAdpcm: return "ImaAdpcm";
+    case MicStreamCodec::Count:    break;
+  }
+  return "Invalid";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MicStreamEncoder::Reset(MicStreamCodec codec)
+{
+  _codec = codec;
+  _predictor = 0;
+  _stepIndex = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t MicStreamEncoder::GetEncodedSize(MicStreamCodec codec, size_t numSamples)
+{
+  switch (codec)
+  {
+    case MicStreamCodec::ImaAdpcm:
+      return kAdpcmHeaderSize + (numSamples + kCodesPerSample - 1) / kCodesPerSample;
+    case MicStreamCodec::PCM:
+    case MicStreamCodec::Count:
+      break;
+  }
+  return numSamples;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MicStreamEncoder::Encode(const AudioUtil::AudioSample* samples, size_t numSamples, AudioUtil::AudioChunk& out)
+{
+  if (_codec != MicStreamCodec::ImaAdpcm) {
+    out.assign(samples, samples + numSamples);
+    return;
+  }
+  
+  out.assign(GetEncodedSize(_codec, numSamples), 0);
+  out[0] = (AudioUtil::AudioSample) _predictor;
+  out[1] = (AudioUtil::AudioSample) _stepIndex;
+  
+  uint16_t* codes = reinterpret_cast<uint16_t*>(out.data() + kAdpcmHeaderSize);
+  for (size_t i=0; i<numSamples; ++i) {
+    const uint8_t code = EncodeSample(samples[i], _predictor, _stepIndex);
+    codes[i / kCodesPerSample] |= (uint16_t) (code << (4 * (i % kCodesPerSample)));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MicStreamEncoder::DecodeImaAdpcm(const AudioUtil::AudioSample* chunk, size_t chunkSize, AudioUtil::AudioChunk& out)
+{
+  out.clear();
+  if ((chunkSize < kAdpcmHeaderSize) || (chunk[1] < 0) || (chunk[1] > kMaxStepIndex)) {
+    return false;
+  }
+  
+  int32_t predictor = chunk[0];
+  int32_t stepIndex = chunk[1];
+  const size_t numSamples = (chunkSize - kAdpcmHeaderSize) * kCodesPerSample;
+  out.reserve(numSamples);
+  
+  const uint16_t* codes = reinterpret_cast<const uint16_t*>(chunk + kAdpcmHeaderSize);
+  for (size_t i=0; i<numSamples; ++i) {
+    const uint8_t code = (codes[i / kCodesPerSample] >> (4 * (i % kCodesPerSample))) & 0xF;
+    ApplyCode(code, predictor, stepIndex);
+    out.push_back((AudioUtil::AudioSample) predictor);
+  }
+  return true;
+}
+
+} // namespace MicData
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,71 @@
+/**
+ * File: micStreamEncoder.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Encodes the chunks of a cloud mic stream before they are sent to vic-cloud.
+ *              ImaAdpcm chunks are compressed about 4:1 and can each be decoded on their own. That way a
+ *              dropped datagram only loses its own 10ms. Each chunk is
+ *                [predictor][step index][codes...]
+ *              in AudioSample words, with four 4-bit codes per word, the lowest nibble first.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ */
+
+#ifndef ANIMPROCESS_COZMO_MICDATA_MICSTREAMENCODER_H
+#define ANIMPROCESS_COZMO_MICDATA_MICSTREAMENCODER_H
+#pragma once
+
+#include "audioUtil/audioDataTypes.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Anki {
+namespace Vector {
+namespace MicData {
+
+enum class MicStreamCodec : uint8_t {
+  PCM,
+  ImaAdpcm,
+  Count
+};
+
+const char* MicStreamCodecToString(MicStreamCodec codec);
+
+class MicStreamEncoder
+{
+public:
+  
+  explicit MicStreamEncoder(MicStreamCodec codec = MicStreamCodec::PCM) { Reset(codec); }
+  
+  // Call at the start of each stream
+  void Reset(MicStreamCodec codec);
+  
+  MicStreamCodec GetCodec() const { return _codec; }
+  
+  // Replaces out with the encoded chunk
+  void Encode(const AudioUtil::AudioSample* samples, size_t numSamples, AudioUtil::AudioChunk& out);
+  
+  static size_t GetEncodedSize(MicStreamCodec codec, size_t numSamples);
+  
+  // Decodes one ImaAdpcm chunk into out, replacing its contents. The sample count comes out rounded up to a multiple
+  // of 4. Returns false if the chunk is malformed
+  static bool DecodeImaAdpcm(const AudioUtil::AudioSample* chunk, size_t chunkSize, AudioUtil::AudioChunk& out);
+  
+private:
+  
+  MicStreamCodec _codec;
+  
+  // ImaAdpcm state, carried from one chunk to the next so that the predictor doesn't restart from silence
+  int32_t _predictor;
+  int32_t _stepIndex;
+  
+};
+
+} // namespace MicData
+} // namespace Vector
+} // namespace Anki
+
+#endif // ANIMPROCESS_COZMO_MICDATA_MICSTREAMENCODER_H
@@ -31,11 +31,11 @@ namespace Vector {
 PerfMetricAnim::PerfMetricAnim(const Anim::AnimContext* context)
   : _frameBuffer(nullptr)
 {
-  _headingLine1 = "                       Anim     Anim    Sleep    Sleep     Over      RtA   AtR   EtA   AtE  Anim Layer";
-  _headingLine2 = "                   Duration     Freq Intended   Actual    Sleep    Count Count Count Count  Time Count";
+  _headingLine1 = "                       Anim     Anim    Sleep    Sleep     Over      RtA   AtR   EtA   AtE  Anim Layer   Track Layer  Face Audio   Msg  Late";
+  _headingLine2 = "                   Duration     Freq Intended   Actual    Sleep    Count Count Count Count  Time Count     Adv Merge  Comp  Post  Send  Tick";
   _headingLine2Extra = "";
-  _headingLine1CSV = ",,Anim,Anim,Sleep,Sleep,Over,RtA,AtR,EtA,AtE,Anim,Layer";
-  _headingLine2CSV = ",,Duration,Freq,Intended,Actual,Sleep,Count,Count,Count,Count,Time,Count";
+  _headingLine1CSV = ",,Anim,Anim,Sleep,Sleep,Over,RtA,AtR,EtA,AtE,Anim,Layer,Track,Layer,Face,Audio,Msg,Late";
+  _headingLine2CSV = ",,Duration,Freq,Intended,Actual,Sleep,Count,Count,Count,Count,Time,Count,Adv,Merge,Comp,Post,Send,Tick";
   _headingLine2ExtraCSV = "";
 }
 
@@ -93,6 +93,13 @@ void PerfMetricAnim::Update(const float tickDuration_ms,
     frame._relativeStreamTime_ms    = _animationStreamer->GetRelativeStreamTime_ms();
     frame._numLayersRendered        = _animationStreamer->GetNumLayersRendered();
 
+    const auto& tickStats = _animationStreamer->GetTickStats();
+    for (size_t i = 0; i < kNumStreamerStages; ++i)
+    {
+      frame._streamerStage_ms[i] = tickStats.GetLastStageDuration_ms(static_cast<Anim::AnimTickStage>(i));
+    }
+    frame._streamerTickLate = tickStats.WasLastTickLate() ? 1 : 0;
+
     if (++_nextFrameIndex >= kNumFramesInBuffer)
     {
       _nextFrameIndex = 0;
@@ -111,6 +118,13 @@ void PerfMetricAnim::InitDumpAccumulators()
   _accMessageCountAtR.Clear();
   _accMessageCountEtA.Clear();
   _accMessageCountAtE.Clear();
+  _accRelativeStreamTime_ms.Clear();
+  _accNumLayersRendered.Clear();
+  for (auto& acc : _accStreamerStage_ms)
+  {
+    acc.Clear();
+  }
+  _accStreamerTickLate.Clear();
 }
 
 
@@ -123,6 +137,11 @@ const PerfMetric::FrameMetric& PerfMetricAnim::UpdateDumpAccumulators(const int
   _accMessageCountAtE += frame._messageCountAnimToEngine;
   _accRelativeStreamTime_ms += frame._relativeStreamTime_ms;
   _accNumLayersRendered     += frame._numLayersRendered;
+  for (size_t i = 0; i < kNumStreamerStages; ++i)
+  {
+    _accStreamerStage_ms[i] += frame._streamerStage_ms[i];
+  }
+  _accStreamerTickLate      += frame._streamerTickLate;
 
   return _frameBuffer[frameBufferIndex];  // Return the base class data
 }
@@ -137,10 +156,13 @@ int PerfMetricAnim::AppendFrameData(const DumpType dumpType,
 #define ANIM_LINE_DATA_VARS \
   frame._messageCountRobotToAnim, frame._messageCountAnimToRobot,\
   frame._messageCountEngineToAnim, frame._messageCountAnimToEngine,\
-  frame._relativeStreamTime_ms, frame._numLayersRendered
+  frame._relativeStreamTime_ms, frame._numLayersRendered,\
+  frame._streamerStage_ms[0], frame._streamerStage_ms[1], frame._streamerStage_ms[2],\
+  frame._streamerStage_ms[3], frame._streamerStage_ms[4], frame._streamerTickLate
 
-  static const char* kFormatLine = "    %5i %5i %5i %5i %5i %5i\n";
-  static const char* kFormatLineCSV = ",%i,%i,%i,%i,%i,%i\n";
+  static_assert(kNumStreamerStages == 5, "Frame data format expects one column per streamer stage");
+  static const char* kFormatLine = "    %5i %5i %5i %5i %5i %5i   %5.2f %5.2f %5.2f %5.2f %5.2f %5i\n";
+  static const char* kFormatLineCSV = ",%i,%i,%i,%i,%i,%i,%.2f,%.2f,%.2f,%.2f,%.2f,%i\n";
 
   const int lenOut = snprintf(&_dumpBuffer[dumpBufferOffset], kSizeDumpBuffer - dumpBufferOffset,
                               dumpType == DT_FILE_CSV ? kFormatLineCSV : kFormatLine,
@@ -159,13 +181,15 @@ int PerfMetricAnim::AppendSummaryData(const DumpType dumpType,
 #define ANIM_SUMMARY_LINE_VARS(StatCall)\
   _accMessageCountRtA.StatCall(), _accMessageCountAtR.StatCall(),\
   _accMessageCountEtA.StatCall(), _accMessageCountAtE.StatCall(),\
-  _accRelativeStreamTime_ms.StatCall(), _accNumLayersRendered.StatCall()
+  _accRelativeStreamTime_ms.StatCall(), _accNumLayersRendered.StatCall(),\
+  _accStreamerStage_ms[0].StatCall(), _accStreamerStage_ms[1].StatCall(), _accStreamerStage_ms[2].StatCall(),\
+  _accStreamerStage_ms[3].StatCall(), _accStreamerStage_ms[4].StatCall(), _accStreamerTickLate.StatCall()
 
-  static const char* kFormatLine = "    %5.1f %5.1f %5.1f %5.1f %5.0f %5.0f\n";
-  static const char* kFormatLineCSV = ",%.1f,%.1f,%.1f,%.1f,%.0f,%.0f\n";
+  static const char* kFormatLine = "    %5.1f %5.1f %5.1f %5.1f %5.0f %5.0f   %5.2f %5.2f %5.2f %5.2f %5.2f %5.2f\n";
+  static const char* kFormatLineCSV = ",%.1f,%.1f,%.1f,%.1f,%.0f,%.0f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f\n";
 
 #define APPEND_SUMMARY_LINE(StatCall)\
-  lenOut = snprintf(&_dumpBuffer[dumpBufferOffset],    - dumpBufferOffset,\
+  lenOut = snprintf(&_dumpBuffer[dumpBufferOffset], kSizeDumpBuffer - dumpBufferOffset,\
                     dumpType == DT_FILE_CSV ? kFormatLineCSV : kFormatLine,\
                     ANIM_SUMMARY_LINE_VARS(StatCall));
 
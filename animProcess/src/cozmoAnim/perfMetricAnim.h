@@ -14,9 +14,11 @@
 #ifndef __Vector_PerfMetric_Anim_H__
 #define __Vector_PerfMetric_Anim_H__
 
+#include "cozmoAnim/animation/animationTickStats.h"
 #include "util/perfMetric/iPerfMetric.h"
 #include "util/stats/statsAccumulator.h"
 
+#include <array>
 #include <string>
 
 
@@ -55,8 +57,10 @@ private:
                                 const int dumpBufferOffset,
                                 const int lineIndex) override final;
 
-  // Frame size:  Base struct is 16 bytes; plus this struct is 20 bytes = 36 bytes total
-  // x 1000 frames is roughly 35 KB
+  static constexpr size_t kNumStreamerStages = Anim::AnimationTickStats::kNumStages;
+
+  // Frame size:  Base struct is 16 bytes; plus this struct is 44 bytes = 60 bytes total
+  // x 2000 frames is roughly 117 KB
   struct FrameMetricAnim : public FrameMetric
   {
     uint32_t _messageCountAnimToRobot;
@@ -65,6 +69,8 @@ private:
     uint32_t _messageCountEngineToAnim;
     uint16_t _relativeStreamTime_ms;
     uint16_t _numLayersRendered;
+    std::array<float, kNumStreamerStages> _streamerStage_ms;
+    uint32_t _streamerTickLate;
   };
 
   FrameMetricAnim*              _frameBuffer = nullptr;
@@ -75,6 +81,8 @@ private:
   Util::Stats::StatsAccumulator _accMessageCountAtE;
   Util::Stats::StatsAccumulator _accRelativeStreamTime_ms;
   Util::Stats::StatsAccumulator _accNumLayersRendered;
+  std::array<Util::Stats::StatsAccumulator, kNumStreamerStages> _accStreamerStage_ms;
+  Util::Stats::StatsAccumulator _accStreamerTickLate;
 
   Anim::AnimationStreamer*            _animationStreamer = nullptr;
 };
@@ -54,6 +54,20 @@ const char* kPathToEngineIndependentSprites = "config/devOnlySprites/independent
 const char* kPathToExternalSpriteSequences = "assets/sprites/spriteSequences/";
 const char* kPathToEngineSpriteSequences   = "config/devOnlySprites/spriteSequences/";
 const char* kProceduralAnimName = "_PROCEDURAL_";
+
+// Lists the prefixes of the animations needed right after boot, most important first
+const char* kAnimationLoadPriorityFile = "config/engine/animationLoadPriority.json";
+const char* kCriticalAnimationsKey = "criticalAnimations";
+
+// Used when there is no priority file: the neutral face, connection flow, mic state and wake word responses
+const std::vector<std::string> kDefaultCriticalAnimPrefixes = {
+  "anim_neutral_eyes_",
+  "anim_pairing_icon_",
+  "anim_micstate_",
+  "anim_onboarding_wakeword_",
+  "anim_avs_",
+  "anim_keepalive_",
+};
 }
 
 RobotDataLoader::RobotDataLoader(const AnimContext* context)
@@ -72,6 +86,10 @@ RobotDataLoader::~RobotDataLoader()
     _abortLoad = true;
     _dataLoadingThread.join();
   }
+  if (_animLoadingThread.joinable()) {
+    _abortLoad = true;
+    _animLoadingThread.join();
+  }
 }
 
 void RobotDataLoader::LoadConfigData()
@@ -149,25 +167,11 @@ void RobotDataLoader::LoadNonConfigData()
     // Set up container
     _cannedAnimations = std::make_unique<CannedAnimationContainer>();
 
-    // Gather the files to load into the animation container
-    CannedAnimationLoader animLoader(_platform,
-                                     _spriteSequenceContainer.get(), 
-                                     _loadingCompleteRatio, _abortLoad);
-
-    std::vector<std::string> paths;
-    if(FACTORY_TEST)
-    {
-      // Only need to load engine animations
-      paths = {"config/engine/animations/"};
-    }
-    else
-    {
-      paths = {"assets/animations/", "config/engine/animations/"};
-    }
+    // Animations are added to the container as they are loaded, so only wait for the critical ones
+    _animLoadingThread = std::thread(&RobotDataLoader::LoadCannedAnimations, this);
 
-    // Load the gathered files into the container
-    const auto& fileInfo = animLoader.CollectAnimFiles(paths);
-    animLoader.LoadAnimationsIntoContainer(fileInfo, _cannedAnimations.get());
+    std::unique_lock<std::mutex> lock(_animLoadingMutex);
+    _animLoadingCondition.wait(lock, [this]{ return _criticalAnimsLoaded.load(); });
   }
 
   // Backpack light animations
@@ -188,6 +192,84 @@ void RobotDataLoader::LoadNonConfigData()
   SetupProceduralAnimation();
 }
 
+void RobotDataLoader::LoadCannedAnimations()
+{
+  Anki::Util::SetThreadName(pthread_self(), "AnimLoader");
+
+#if ALLOW_DEBUG_LOGGING
+  const double startTime = Util::Time::UniversalTime::GetCurrentTimeInMilliseconds();
+#endif
+
+  // Gather the files to load into the animation container
+  CannedAnimationLoader animLoader(_platform,
+                                   _spriteSequenceContainer.get(),
+                                   _loadingCompleteRatio, _abortLoad);
+
+  std::vector<std::string> paths;
+  if(FACTORY_TEST)
+  {
+    // Only need to load engine animations
+    paths = {"config/engine/animations/"};
+  }
+  else
+  {
+    paths = {"assets/animations/", "config/engine/animations/"};
+  }
+
+  auto fileInfo = animLoader.CollectAnimFiles(paths);
+  CannedAnimationLoader::PrioritizeAnimFiles(fileInfo, LoadCriticalAnimPrefixes());
+
+  auto signalLoaded = [this](std::atomic<bool>& loaded) {
+    {
+      std::lock_guard<std::mutex> lock(_animLoadingMutex);
+      loaded = true;
+    }
+    _animLoadingCondition.notify_all();
+  };
+
+  // Load the gathered files into the container
+  animLoader.LoadAnimationsIntoContainer(fileInfo, _cannedAnimations.get(), [&]() {
+#if ALLOW_DEBUG_LOGGING
+    LOG_DEBUG("RobotDataLoader.LoadCannedAnimations.CriticalLoadTime", "Critical animations loaded in %.2f ms",
+              Util::Time::UniversalTime::GetCurrentTimeInMilliseconds() - startTime);
+#endif
+    signalLoaded(_criticalAnimsLoaded);
+  });
+
+  // In case loading was aborted before the critical files were done
+  signalLoaded(_criticalAnimsLoaded);
+  signalLoaded(_allAnimsLoaded);
+
+#if ALLOW_DEBUG_LOGGING
+  LOG_DEBUG("RobotDataLoader.LoadCannedAnimations.LoadTime", "All animations loaded in %.2f ms",
+            Util::Time::UniversalTime::GetCurrentTimeInMilliseconds() - startTime);
+#endif
+}
+
+std::vector<std::string> RobotDataLoader::LoadCriticalAnimPrefixes() const
+{
+  const std::string path = _platform->pathToResource(Util::Data::Scope::Resources, kAnimationLoadPriorityFile);
+  if (!Util::FileUtils::FileExists(path)) {
+    return kDefaultCriticalAnimPrefixes;
+  }
+
+  Json::Value priorityJson;
+  const bool success = _platform->readAsJson(path, priorityJson);
+  const Json::Value& criticalJson = priorityJson[kCriticalAnimationsKey];
+  if (!success || !criticalJson.isArray()) {
+    LOG_ERROR("RobotDataLoader.LoadCriticalAnimPrefixes.InvalidFile",
+              "Animation load priority file %s has no '%s' list, using the defaults",
+              path.c_str(), kCriticalAnimationsKey);
+    return kDefaultCriticalAnimPrefixes;
+  }
+
+  std::vector<std::string> prefixes;
+  for (const auto& prefix : criticalJson) {
+    prefixes.push_back(prefix.asString());
+  }
+  return prefixes;
+}
+
 void RobotDataLoader::LoadAnimationFile(const std::string& path)
 {
   if (_platform == nullptr) {
@@ -234,6 +316,12 @@ void RobotDataLoader::LoadIndependentSpritePaths()
 Animation* RobotDataLoader::GetCannedAnimation(const std::string& name)
 {
   DEV_ASSERT(_cannedAnimations != nullptr, "_cannedAnimations");
+  if (!_allAnimsLoaded && !_cannedAnimations->HasAnimation(name)) {
+    LOG_INFO("RobotDataLoader.GetCannedAnimation.WaitingForLoad",
+             "%s requested before all animations are loaded", name.c_str());
+    std::unique_lock<std::mutex> lock(_animLoadingMutex);
+    _animLoadingCondition.wait(lock, [this]{ return _allAnimsLoaded.load(); });
+  }
   return _cannedAnimations->GetAnimation(name);
 }
 
@@ -243,6 +331,12 @@ std::vector<std::string> RobotDataLoader::GetAnimationNames()
   return _cannedAnimations->GetAnimationNames();
 }
 
+size_t RobotDataLoader::ReleaseColdAnimations(const std::set<std::string>& animsInUse)
+{
+  DEV_ASSERT(_cannedAnimations != nullptr, "_cannedAnimations");
+  return _cannedAnimations->ReleaseColdAnimations(animsInUse);
+}
+
 void RobotDataLoader::NotifyAnimAdded(const std::string& animName, uint32_t animLength)
 {
   AnimationAdded msg;
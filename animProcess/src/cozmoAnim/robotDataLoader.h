@@ -23,8 +23,11 @@
 #include "assert.h"
 #include <json/json.h>
 #include <atomic>
+#include <condition_variable>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <set>
 #include <string>
 #include <thread>
 #include <vector>
@@ -61,7 +64,8 @@ public:
   void LoadConfigData();
   
   // Loads all data excluding configs, using DispatchWorker to parallelize.
-  // Blocks until the data is loaded.
+  // Blocks until the data is loaded, except for the canned animations which keep loading in the
+  // background after the critical ones (see IsCriticalAnimationSetLoaded) are in.
   void LoadNonConfigData();
   void LoadAnimationFile(const std::string& path);
   
@@ -73,8 +77,16 @@ public:
   const Json::Value & GetTextToSpeechConfig() const { return _tts_config; }
   const Json::Value & GetWebServerAnimConfig() const { return _ws_config; }
   const Json::Value & GetMicTriggerConfig() const { return _micTriggerConfig; }
+  // Blocks until all animations are loaded if name isn't loaded yet
   Animation* GetCannedAnimation(const std::string& name);
   std::vector<std::string> GetAnimationNames();
+
+  // Frees decoded canned animations other than animsInUse. Pointers to the released ones must not be used again
+  size_t ReleaseColdAnimations(const std::set<std::string>& animsInUse);
+
+  // The animations needed right after boot are loaded before the others
+  bool IsCriticalAnimationSetLoaded() const { return _criticalAnimsLoaded; }
+  bool AreAllAnimationsLoaded() const { return _allAnimsLoaded; }
   
   const std::string& GetAlexaConfig() const { return _alexaConfig; }
 
@@ -92,6 +104,10 @@ public:
 private:
   void LoadIndependentSpritePaths();
 
+  // Runs on _animLoadingThread
+  void LoadCannedAnimations();
+  std::vector<std::string> LoadCriticalAnimPrefixes() const;
+
   void NotifyAnimAdded(const std::string& animName, uint32_t animLength);
   
   void SetupProceduralAnimation();
@@ -117,6 +133,12 @@ private:
   bool                  _isNonConfigDataLoaded = false;
   std::thread           _dataLoadingThread;
 
+  std::thread             _animLoadingThread;
+  std::atomic<bool>       _criticalAnimsLoaded{false};
+  std::atomic<bool>       _allAnimsLoaded{false};
+  std::mutex              _animLoadingMutex;
+  std::condition_variable _animLoadingCondition;
+
   
   Json::Value _tts_config;
   Json::Value _ws_config;
@@ -27,9 +27,12 @@
 #include "util/environment/locale.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
+#include "util/threading/threadPriority.h"
+#include <algorithm>
 #include <list>
 
 #include <fcntl.h>
+#include <sched.h>
 #include <unistd.h>
 
 
@@ -158,6 +161,28 @@ CONSOLE_VAR(bool, kSaveRawMicInput, CONSOLE_GROUP_ALEXA, false);
 CONSOLE_VAR_RANGED(unsigned int, kForceRunNotchDetector, CONSOLE_GROUP_ALEXA, 0, 0, 2);
   
 CONSOLE_VAR_RANGED(uint, kPlaybackRecognizerSampleCountThreshold, CONSOLE_GROUP_ALEXA_PLAYBACK, 5000, 1000, 10000);
+
+// Run the Alexa mic recognizer on its own thread instead of in Update(). Takes effect the next time Alexa is activated
+CONSOLE_VAR(bool, kRunAlexaRecognizerOnThread, CONSOLE_GROUP_ALEXA, true);
+// Let the cheaper "hey vector" recognizer gate the Alexa one: Alexa's recognizer then only runs for a while after a
+// "hey vector" detection, starting on the audio from just before it. Only applies when it runs on its own thread
+CONSOLE_VAR(bool, kGateAlexaRecognizerOnVector, CONSOLE_GROUP_ALEXA, false);
+CONSOLE_VAR(bool, kLogRecognizerLoad, "SpeechRecognizer", false);
+
+const uint32_t kAlexaGateOpenBlocks    = 4000 / MicData::kTimePerChunk_ms;
+const uint32_t kAlexaGateHistoryBlocks = 500 / MicData::kTimePerChunk_ms;
+const auto kAlexaThreadMaxSleep = std::chrono::milliseconds(2 * MicData::kTimePerChunk_ms);
+const auto kRecognizerLoadLogPeriod = std::chrono::seconds(10);
+// Raw and Trigger mic processing run on cores 2 and 1
+const int kAlexaThreadCpu = 3;
+
+void UpdateMax(std::atomic<uint32_t>& maxValue, uint32_t value)
+{
+  // Only one thread raises each max. A reset from GetRecognizerLoad() in between only loses that one sample
+  if (value > maxValue.load(std::memory_order_relaxed)) {
+    maxValue.store(value, std::memory_order_relaxed);
+  }
+}
   
 bool AlexaLocaleEnabled(const Util::Locale& locale)
 {
@@ -283,12 +308,20 @@ SpeechRecognizerSystem::SpeechRecognizerSystem(const Anim::AnimContext* context,
 , _micDataSystem(micDataSystem)
 , _triggerWordDataDir(triggerWordDataDir)
 , _notchDetector(std::make_shared<NotchDetector>())
+, _lastLoadLogTime(std::chrono::steady_clock::now())
 {
   SetupConsoleFuncs();
+  
+  // Started here rather than in the initializer list, since it uses members declared after it
+  _alexaThread = std::thread(&SpeechRecognizerSystem::AlexaThreadLoop, this);
 }
 
 SpeechRecognizerSystem::~SpeechRecognizerSystem()
 {
+  _alexaThreadStop = true;
+  _alexaThreadCondition.notify_all();
+  _alexaThread.join();
+  
   if (_victorTrigger) {
     _victorTrigger->recognizer->Stop();
   }
@@ -309,10 +342,18 @@ void SpeechRecognizerSystem::InitVector(const Anim::RobotDataLoader& dataLoader,
     return;
   }
   
+  // Detections are made from Update() on the Trigger thread, while the block they end in is being processed. That block
+  // is the next one queued for Alexa, so in gated mode the Alexa recognizer runs from shortly before it on
+  const auto gatingCallback = [this, callback=std::move(callback)](const AudioUtil::SpeechRecognizerCallbackInfo& info)
+  {
+    _alexaGateOpenUntilBlock = _alexaNextBlockIndex + kAlexaGateOpenBlocks;
+    callback(info);
+  };
+  
   const bool useVad = true;
   _victorTrigger = std::make_unique<TriggerContext<SpeechRecognizerPicovoice>>("Vector", useVad);
   _victorTrigger->recognizer->Init();  
-  _victorTrigger->recognizer->SetCallback(callback);
+  _victorTrigger->recognizer->SetCallback(gatingCallback);
   //_victorTrigger->recognizer->Start();
   _victorTrigger->micTriggerConfig->Init("hey_vector_thf", dataLoader.GetMicTriggerConfig());
   
@@ -374,15 +415,26 @@ void SpeechRecognizerSystem::Update(const AudioUtil::AudioSample * audioData, un
   }
   // Update recognizer
   if (_victorTrigger && (vadActive || !_victorTrigger->useVad)) {
+    const auto start = std::chrono::steady_clock::now();
     _victorTrigger->recognizer->Update(audioData, audioDataLen);
+    _vectorLoad.Record(start, start, std::chrono::steady_clock::now());
   }
   
   if (_isAlexaActive) {
     if (!_isDisableAlexaPending) {
+      const uint64_t micSampleIndex = _alexaComponent->GetMicrophoneSampleIndex();
       _alexaComponent->AddMicrophoneSamples(audioData, audioDataLen);
-      _alexaTrigger->recognizer->Update(audioData, audioDataLen);
+      if (_runAlexaOnThread) {
+        QueueAlexaBlock(audioData, audioDataLen, micSampleIndex);
+      }
+      else {
+        const auto start = std::chrono::steady_clock::now();
+        _alexaTrigger->recognizer->Update(audioData, audioDataLen);
+        _alexaLoad.Record(start, start, std::chrono::steady_clock::now());
+      }
     }
     else {
+      std::lock_guard<std::mutex> lock(_alexaRecognizerMutex);
       if (_alexaTrigger) {
         _alexaTrigger->recognizer->Stop();
         _alexaTrigger.reset();
@@ -393,6 +445,9 @@ void SpeechRecognizerSystem::Update(const AudioUtil::AudioSample * audioData, un
       LOG_INFO("SpeechRecognizerSystem.Update", "Alexa mic recognizer has been disabled");
     }
   }
+  
+  ++_alexaNextBlockIndex;
+  LogRecognizerLoad();
 }
 
 bool SpeechRecognizerSystem::UpdateTriggerForLocale(const Util::Locale& newLocale, RecognizerTypeFlag recognizerFlags)
@@ -435,6 +490,7 @@ void SpeechRecognizerSystem::ActivateAlexa(const Util::Locale& locale, AlexaTrig
   }
   
   _alexaComponent = _context->GetAlexa();
+  _runAlexaOnThread = kRunAlexaRecognizerOnThread;
   
   InitAlexa(locale, callback);
   
@@ -507,7 +563,11 @@ void SpeechRecognizerSystem::InitAlexa(const Util::Locale& locale,
   ASSERT_NAMED(_alexaComponent != nullptr, "SpeechRecognizerSystem.InitAlexa._context.GetAlexa.IsNull");
   
   const bool useVad = AlexaLocaleUsesVad(locale);
-  _alexaTrigger = std::make_unique<TriggerContext<SpeechRecognizerPryonLite>>("Alexa", useVad);
+  {
+    std::lock_guard<std::mutex> lock(_alexaRecognizerMutex);
+    _alexaTrigger = std::make_unique<TriggerContext<SpeechRecognizerPryonLite>>("Alexa", useVad);
+    _alexaRecognizerRestarted = true;
+  }
   _alexaTrigger->recognizer->SetCallback(wrappedCallback);
   _alexaTrigger->micTriggerConfig->Init("alexa_pryon", dataLoader->GetMicTriggerConfig());
   _alexaTrigger->recognizer->Start();
@@ -537,6 +597,159 @@ void SpeechRecognizerSystem::InitAlexaPlayback(const Util::Locale& locale,
   _alexaPlaybackTrigger->recognizer->Start();
 }
 
+void SpeechRecognizerSystem::AlexaThreadLoop()
+{
+  Anki::Util::SetThreadName(pthread_self(), "SpeechRecAlexa");
+  
+#if defined(ANKI_PLATFORM_VICOS)
+  // Setup the thread's affinity mask
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(kAlexaThreadCpu, &cpu_set);
+  int error = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set);
+  if (error != 0) {
+    LOG_ERROR("SpeechRecognizerSystem.AlexaThreadLoop", "SetAffinityMaskError %d", error);
+  }
+#endif
+  
+  while (!_alexaThreadStop) {
+    {
+      // Waits are bounded, since a block queued between the check and the wait does not wake it
+      std::unique_lock<std::mutex> lock(_alexaThreadWakeMutex);
+      _alexaThreadCondition.wait_for(lock, kAlexaThreadMaxSleep, [this] {
+        return _alexaThreadStop || HasAlexaThreadWork();
+      });
+    }
+    
+    while (!_alexaThreadStop && HasAlexaThreadWork()) {
+      const AlexaThreadBlock* block = _alexaThreadRing.front();
+      if (IsAlexaBlockGated(*block)) {
+        // Past the history kept for when the gate opens
+        ++_alexaLoad.numDropped;
+      }
+      else {
+        RunAlexaBlock(*block);
+      }
+      _alexaThreadRing.pop_front();
+    }
+  }
+}
+
+bool SpeechRecognizerSystem::IsAlexaBlockGated(const AlexaThreadBlock& block) const
+{
+  return kGateAlexaRecognizerOnVector && (block.blockIndex > _alexaGateOpenUntilBlock);
+}
+
+bool SpeechRecognizerSystem::HasAlexaThreadWork()
+{
+  const AlexaThreadBlock* block = _alexaThreadRing.front();
+  if (nullptr == block) {
+    return false;
+  }
+  // While gated, the last few blocks are held back for the recognizer to start on once the gate opens
+  return !IsAlexaBlockGated(*block) || (_alexaThreadRing.size() > kAlexaGateHistoryBlocks);
+}
+
+void SpeechRecognizerSystem::QueueAlexaBlock(const AudioUtil::AudioSample* audioData,
+                                             unsigned int audioDataLen,
+                                             uint64_t micSampleIndex)
+{
+  AlexaThreadBlock* block = _alexaThreadRing.push_begin();
+  if (nullptr == block) {
+    // The recognizer is behind. It will see a gap, but its detections still line up with the Alexa stream
+    ++_alexaLoad.numDropped;
+    return;
+  }
+  DEV_ASSERT_MSG(audioDataLen <= block->samples.size(), "SpeechRecognizerSystem.QueueAlexaBlock.TooManySamples",
+                 "%u samples", audioDataLen);
+  block->numSamples = std::min(audioDataLen, (unsigned int) block->samples.size());
+  std::copy(audioData, audioData + block->numSamples, block->samples.begin());
+  block->micSampleIndex = micSampleIndex;
+  block->blockIndex = _alexaNextBlockIndex;
+  block->readyTime = std::chrono::steady_clock::now();
+  _alexaThreadRing.push_commit();
+  
+  _alexaThreadCondition.notify_one();
+}
+
+void SpeechRecognizerSystem::RunAlexaBlock(const AlexaThreadBlock& block)
+{
+  std::lock_guard<std::mutex> lock(_alexaRecognizerMutex);
+  // Blocks left over from an earlier activation, or from before the recognizer was disabled
+  if (!_isAlexaActive || _isDisableAlexaPending || !_alexaTrigger) {
+    return;
+  }
+  
+  if (_alexaRecognizerRestarted) {
+    _alexaRecognizerNumSamples = 0;
+    _alexaRecognizerRestarted = false;
+  }
+  // Pryon reports detections in the samples it was fed, which no longer counts the Alexa stream's samples once blocks
+  // are dropped or gated
+  auto* recognizer = _alexaTrigger->recognizer.get();
+  recognizer->SetAlexaMicrophoneOffset(block.micSampleIndex - _alexaRecognizerNumSamples);
+  
+  ANKI_CPU_PROFILE("AlexaRecognizer");
+  const auto start = std::chrono::steady_clock::now();
+  recognizer->Update(block.samples.data(), block.numSamples);
+  _alexaLoad.Record(block.readyTime, start, std::chrono::steady_clock::now());
+  _alexaRecognizerNumSamples += block.numSamples;
+}
+
+void SpeechRecognizerSystem::RecognizerLoadCounters::Record(std::chrono::steady_clock::time_point readyTime,
+                                                            std::chrono::steady_clock::time_point startTime,
+                                                            std::chrono::steady_clock::time_point endTime)
+{
+  using namespace std::chrono;
+  const uint32_t process_us = (uint32_t) duration_cast<microseconds>(endTime - startTime).count();
+  ++numBlocks;
+  totalProcess_us += process_us;
+  UpdateMax(maxProcess_us, process_us);
+  UpdateMax(maxWait_us, (uint32_t) std::max<int64_t>(0, duration_cast<microseconds>(startTime - readyTime).count()));
+}
+
+SpeechRecognizerSystem::RecognizerLoad SpeechRecognizerSystem::GetRecognizerLoad(RecognizerTypeFlag recognizer)
+{
+  RecognizerLoad load;
+  RecognizerLoadCounters* counters = nullptr;
+  switch (recognizer) {
+    case RecognizerTypeFlag::VectorMic: counters = &_vectorLoad; break;
+    case RecognizerTypeFlag::AlexaMic:  counters = &_alexaLoad;  break;
+    default:
+      LOG_WARNING("SpeechRecognizerSystem.GetRecognizerLoad.UntrackedRecognizer", "%d", (int) recognizer);
+      return load;
+  }
+  load.numBlocks       = counters->numBlocks.exchange(0);
+  load.numDropped      = counters->numDropped.exchange(0);
+  load.totalProcess_us = counters->totalProcess_us.exchange(0);
+  load.maxProcess_us   = counters->maxProcess_us.exchange(0);
+  load.maxWait_us      = counters->maxWait_us.exchange(0);
+  return load;
+}
+
+void SpeechRecognizerSystem::LogRecognizerLoad()
+{
+  if (!kLogRecognizerLoad) {
+    return;
+  }
+  const auto now = std::chrono::steady_clock::now();
+  if (now - _lastLoadLogTime < kRecognizerLoadLogPeriod) {
+    return;
+  }
+  const auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(now - _lastLoadLogTime).count();
+  _lastLoadLogTime = now;
+  
+  const auto vector = GetRecognizerLoad(RecognizerTypeFlag::VectorMic);
+  const auto alexa  = GetRecognizerLoad(RecognizerTypeFlag::AlexaMic);
+  LOG_INFO("SpeechRecognizerSystem.RecognizerLoad",
+           "Vector: %u blocks, %.1f%% cpu, max %u us | Alexa (%s): %u blocks, %u dropped, %.1f%% cpu, max %u us, "
+           "max wait %u us",
+           vector.numBlocks, 100.f * vector.totalProcess_us / elapsed_us, vector.maxProcess_us,
+           _runAlexaOnThread ? (kGateAlexaRecognizerOnVector ? "thread, gated" : "thread") : "inline",
+           alexa.numBlocks, alexa.numDropped, 100.f * alexa.totalProcess_us / elapsed_us, alexa.maxProcess_us,
+           alexa.maxWait_us);
+}
+
 void SpeechRecognizerSystem::UpdateAlexaActiveState()
 {
   _isAlexaActive = (_alexaComponent != nullptr &&
@@ -576,6 +789,11 @@ void SpeechRecognizerSystem::ApplyLocaleUpdate()
   }
   
   if (_alexaTrigger) {
+    std::lock_guard<std::mutex> recognizerLock(_alexaRecognizerMutex);
+    // A new model re-creates the Pryon recognizer, which counts its samples from zero again
+    if (_alexaTrigger->currentTriggerPaths != _alexaTrigger->nextTriggerPaths) {
+      _alexaRecognizerRestarted = true;
+    }
     ApplySpeechRecognizerLocaleUpdate(*_alexaTrigger.get());
   }
   
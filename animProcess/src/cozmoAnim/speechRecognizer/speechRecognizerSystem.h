@@ -15,11 +15,17 @@
 
 #include "audioUtil/audioDataTypes.h"
 #include "cozmoAnim/micData/micTriggerConfig.h"
+#include "micDataTypes.h"
+#include "util/container/spscRingBuffer.h"
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 
 namespace Anki {
   namespace AudioUtil {
@@ -105,6 +111,18 @@ public:
   bool UpdateTriggerForLocale(const Util::Locale& newLocale,
                               RecognizerTypeFlag recognizerFlags = RecognizerTypeFlag::All);
   
+  // Processing done by one recognizer since the last GetRecognizerLoad() call for it, which resets it
+  struct RecognizerLoad {
+    uint32_t numBlocks       = 0; // Blocks of audio the recognizer ran on
+    uint32_t numDropped      = 0; // Blocks it skipped, because its thread was behind or it was gated
+    uint64_t totalProcess_us = 0;
+    uint32_t maxProcess_us   = 0;
+    uint32_t maxWait_us      = 0; // Longest a block waited for the recognizer's thread, 0 when it runs in Update()
+  };
+  
+  // Only VectorMic and AlexaMic are tracked
+  RecognizerLoad GetRecognizerLoad(RecognizerTypeFlag recognizer);
+  
   // Alexa Methods
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Alexa has been set active set current locale and callback for Alexa trigger recognitions
@@ -150,7 +168,7 @@ private:
   
   std::unique_ptr<TriggerContextPryon>        _alexaTrigger;
   Alexa*                                      _alexaComponent = nullptr;
-  bool                                        _isAlexaActive = false;
+  std::atomic_bool                            _isAlexaActive{ false };
   
   std::unique_ptr<TriggerContextPryon>        _alexaPlaybackTrigger;
   std::atomic_uint64_t                        _playbackTrigerSampleIdx{ 0 };
@@ -167,6 +185,63 @@ private:
   std::mutex                                  _notchMutex;
   bool                                        _notchDetectorActive = false;
   
+  // Alexa recognizer thread
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // The Alexa mic recognizer can run on its own thread (and core), so it doesn't add to the time "hey vector" takes on
+  // the mic Trigger thread. Update() then only queues each block of processed audio for it. Blocks are stamped with
+  // the Alexa microphone index of their first sample, which keeps detections in the Alexa stream's time when blocks
+  // are dropped
+  struct AlexaThreadBlock {
+    std::array<AudioUtil::AudioSample, MicData::kSamplesPerBlockPerChannel> samples;
+    unsigned int                                numSamples;
+    uint64_t                                    micSampleIndex;
+    uint64_t                                    blockIndex;
+    std::chrono::steady_clock::time_point       readyTime;
+  };
+  static constexpr size_t kAlexaThreadRingSize = 128;
+  Util::SpscRingBuffer<AlexaThreadBlock, kAlexaThreadRingSize> _alexaThreadRing;
+  
+  std::thread                                 _alexaThread;
+  std::mutex                                  _alexaThreadWakeMutex;
+  std::condition_variable                     _alexaThreadCondition;
+  std::atomic_bool                            _alexaThreadStop{ false };
+  // Held by the Alexa thread while it runs the recognizer, and by anything replacing or reconfiguring _alexaTrigger
+  std::mutex                                  _alexaRecognizerMutex;
+  // Whether the current Alexa activation runs its recognizer on _alexaThread, set in ActivateAlexa()
+  std::atomic_bool                            _runAlexaOnThread{ false };
+  // Samples fed to the Pryon recognizer since it was last (re)created, guarded by _alexaRecognizerMutex
+  uint64_t                                    _alexaRecognizerNumSamples = 0;
+  bool                                        _alexaRecognizerRestarted = true;
+  // Block counter on the Trigger thread, and the last block the Alexa recognizer runs on when it is gated
+  uint64_t                                    _alexaNextBlockIndex = 1;
+  std::atomic<uint64_t>                       _alexaGateOpenUntilBlock{ 0 };
+  
+  void AlexaThreadLoop();
+  bool IsAlexaBlockGated(const AlexaThreadBlock& block) const;
+  bool HasAlexaThreadWork();
+  void QueueAlexaBlock(const AudioUtil::AudioSample* audioData, unsigned int audioDataLen, uint64_t micSampleIndex);
+  void RunAlexaBlock(const AlexaThreadBlock& block);
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  
+  // Recognizer load
+  struct RecognizerLoadCounters {
+    std::atomic<uint32_t>                     numBlocks{ 0 };
+    std::atomic<uint32_t>                     numDropped{ 0 };
+    std::atomic<uint64_t>                     totalProcess_us{ 0 };
+    std::atomic<uint32_t>                     maxProcess_us{ 0 };
+    std::atomic<uint32_t>                     maxWait_us{ 0 };
+    
+    void Record(std::chrono::steady_clock::time_point readyTime,
+                std::chrono::steady_clock::time_point startTime,
+                std::chrono::steady_clock::time_point endTime);
+  };
+  RecognizerLoadCounters                      _vectorLoad;
+  RecognizerLoadCounters                      _alexaLoad;
+  std::chrono::steady_clock::time_point       _lastLoadLogTime;
+  
+  // Periodically log the recognizers' load, when enabled. Called from Update()
+  void LogRecognizerLoad();
+  
   // Alexa Methods
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Init Alexa trigger detector
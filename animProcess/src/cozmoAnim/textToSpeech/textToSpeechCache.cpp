@@ -0,0 +1,222 @@
+/**
+ * File: textToSpeechCache.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "cozmoAnim/textToSpeech/textToSpeechCache.h"
+
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#define LOG_CHANNEL "TextToSpeech"
+
+namespace Anki {
+namespace Vector {
+namespace TextToSpeech {
+
+namespace {
+  constexpr const char* kFileExtension = "tts";
+
+  constexpr uint32_t kFileMagic = 0x43535454; // "TTSC"
+  constexpr uint32_t kFileVersion = 1;
+
+  // Followed by the key, then the samples
+  struct FileHeader
+  {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sampleRate;
+    uint16_t numChannels;
+    uint16_t reserved;
+    uint32_t keySize;
+    uint32_t numSamples;
+  };
+
+  // FNV-1a, so that file names stay the same from one build to the next
+  uint64_t HashKey(const std::string & key)
+  {
+    uint64_t hash = 14695981039346656037ull;
+    for (const char c : key) {
+      hash ^= static_cast<uint8_t>(c);
+      hash *= 1099511628211ull;
+    }
+    return hash;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TextToSpeechCache::TextToSpeechCache(const std::string & cachePath, size_t maxSize_bytes)
+: _cachePath(cachePath)
+, _maxSize_bytes(maxSize_bytes)
+{
+  Util::FileUtils::CreateDirectory(_cachePath);
+
+  // Oldest modification time was least recently used
+  std::vector<std::pair<long, std::string>> files;
+  for (const auto & fileName : Util::FileUtils::FilesInDirectory(_cachePath, false, kFileExtension)) {
+    files.emplace_back(Util::FileUtils::GetFileLastModificationTime(GetFilePath(fileName)), fileName);
+  }
+  std::sort(files.begin(), files.end());
+
+  for (const auto & file : files) {
+    const ssize_t fileSize = Util::FileUtils::GetFileSize(GetFilePath(file.second));
+    if (fileSize <= 0) {
+      continue;
+    }
+    Entry & entry = _entries[file.second];
+    entry.size_bytes = static_cast<size_t>(fileSize);
+    entry.lastUsed = ++_useCount;
+    _size_bytes += entry.size_bytes;
+  }
+
+  LOG_INFO("TextToSpeechCache.Init", "%zu cached utterances, %zu of %zu bytes",
+           _entries.size(), _size_bytes, _maxSize_bytes);
+
+  // Budget may have shrunk since the last run
+  Trim();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::string TextToSpeechCache::GetFileName(const std::string & key)
+{
+  char fileName[32];
+  snprintf(fileName, sizeof(fileName), "%016" PRIx64 ".%s", HashKey(key), kFileExtension);
+  return fileName;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::string TextToSpeechCache::GetFilePath(const std::string & fileName) const
+{
+  return Util::FileUtils::FullFilePath({_cachePath, fileName});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TextToSpeechCache::Contains(const std::string & key) const
+{
+  return (_entries.find(GetFileName(key)) != _entries.end());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TextToSpeechCache::Load(const std::string & key, Utterance & out_utterance)
+{
+  const std::string fileName = GetFileName(key);
+  const auto it = _entries.find(fileName);
+  if (it == _entries.end()) {
+    return false;
+  }
+
+  const std::vector<uint8_t> data = Util::FileUtils::ReadFileAsBinary(GetFilePath(fileName));
+
+  FileHeader header;
+  const bool hasHeader = (data.size() >= sizeof(header));
+  if (hasHeader) {
+    memcpy(&header, data.data(), sizeof(header));
+  }
+  const size_t expectedSize = hasHeader ? sizeof(header) + header.keySize + header.numSamples * sizeof(int16_t) : 0;
+  if (!hasHeader || (header.magic != kFileMagic) || (header.version != kFileVersion) || (data.size() != expectedSize)) {
+    LOG_WARNING("TextToSpeechCache.Load.Invalid", "Deleting unreadable %s", fileName.c_str());
+    Remove(fileName);
+    return false;
+  }
+
+  const char* storedKey = reinterpret_cast<const char*>(data.data() + sizeof(header));
+  if ((header.keySize != key.size()) || (0 != memcmp(storedKey, key.data(), key.size()))) {
+    // Another key with the same hash. Left alone, whichever is stored last wins the file
+    LOG_DEBUG("TextToSpeechCache.Load.Collision", "%s holds a different utterance", fileName.c_str());
+    return false;
+  }
+
+  out_utterance.sampleRate = header.sampleRate;
+  out_utterance.numChannels = header.numChannels;
+  out_utterance.samples.resize(header.numSamples);
+  memcpy(out_utterance.samples.data(), storedKey + header.keySize, header.numSamples * sizeof(int16_t));
+
+  Touch(fileName, it->second);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TextToSpeechCache::Store(const std::string & key, const Utterance & utterance)
+{
+  const size_t fileSize = sizeof(FileHeader) + key.size() + utterance.samples.size() * sizeof(int16_t);
+  if (utterance.samples.empty() || (fileSize > _maxSize_bytes)) {
+    return false;
+  }
+
+  FileHeader header;
+  header.magic = kFileMagic;
+  header.version = kFileVersion;
+  header.sampleRate = utterance.sampleRate;
+  header.numChannels = utterance.numChannels;
+  header.reserved = 0;
+  header.keySize = static_cast<uint32_t>(key.size());
+  header.numSamples = static_cast<uint32_t>(utterance.samples.size());
+
+  std::vector<uint8_t> data(fileSize);
+  uint8_t* dest = data.data();
+  memcpy(dest, &header, sizeof(header));
+  dest += sizeof(header);
+  memcpy(dest, key.data(), key.size());
+  dest += key.size();
+  memcpy(dest, utterance.samples.data(), utterance.samples.size() * sizeof(int16_t));
+
+  const std::string fileName = GetFileName(key);
+  if (!Util::FileUtils::WriteFileAtomic(GetFilePath(fileName), data)) {
+    LOG_WARNING("TextToSpeechCache.Store.WriteFailed", "Unable to write %s", fileName.c_str());
+    return false;
+  }
+
+  Entry & entry = _entries[fileName];
+  _size_bytes = _size_bytes - entry.size_bytes + fileSize;
+  entry.size_bytes = fileSize;
+  entry.lastUsed = ++_useCount;
+
+  Trim();
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TextToSpeechCache::Touch(const std::string & fileName, Entry & entry)
+{
+  entry.lastUsed = ++_useCount;
+  Util::FileUtils::TouchFile(GetFilePath(fileName));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TextToSpeechCache::Remove(const std::string & fileName)
+{
+  const auto it = _entries.find(fileName);
+  if (it != _entries.end()) {
+    _size_bytes -= it->second.size_bytes;
+    _entries.erase(it);
+  }
+  Util::FileUtils::DeleteFile(GetFilePath(fileName));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TextToSpeechCache::Trim()
+{
+  while (_size_bytes > _maxSize_bytes && !_entries.empty()) {
+    const auto oldest = std::min_element(_entries.begin(), _entries.end(), [](const auto & a, const auto & b) {
+      return a.second.lastUsed < b.second.lastUsed;
+    });
+    LOG_DEBUG("TextToSpeechCache.Trim", "Evicting %s (%zu bytes)", oldest->first.c_str(), oldest->second.size_bytes);
+    Remove(std::string(oldest->first));
+  }
+}
+
+} // end namespace TextToSpeech
+} // end namespace Vector
+} // end namespace Anki
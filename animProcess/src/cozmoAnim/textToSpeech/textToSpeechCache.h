@@ -0,0 +1,92 @@
+/**
+ * File: textToSpeechCache.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: On-disk cache of synthesized TTS audio. Each utterance is stored in its own file, named after a hash of
+ *              its key: the text as given to the provider plus every provider setting that shapes the audio (locale,
+ *              voice, speed, pitch...), so a changed setting is simply a different entry. The key is stored in the file
+ *              too and checked on load, so a hash collision is a miss rather than the wrong audio. Once the files add up
+ *              to more than the size budget, the least recently used ones are deleted.
+ *
+ *              Not thread safe. TextToSpeechComponent only uses it from its worker queue.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_cozmo_cozmoAnim_textToSpeech_textToSpeechCache_H__
+#define __Anki_cozmo_cozmoAnim_textToSpeech_textToSpeechCache_H__
+
+#include "audioUtil/audioDataTypes.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace Anki {
+namespace Vector {
+namespace TextToSpeech {
+
+class TextToSpeechCache
+{
+public:
+  using AudioChunk = AudioUtil::AudioChunk;
+
+  struct Utterance
+  {
+    uint32_t sampleRate = 0;
+    uint16_t numChannels = 0;
+    AudioChunk samples;
+  };
+
+  // Picks up whatever an earlier run left in cachePath
+  TextToSpeechCache(const std::string & cachePath, size_t maxSize_bytes);
+
+  // Returns false on a miss, or if the file is unreadable (it is then deleted)
+  bool Load(const std::string & key, Utterance & out_utterance);
+
+  // Returns false if the utterance could not be written, or is larger than the whole budget
+  bool Store(const std::string & key, const Utterance & utterance);
+
+  bool Contains(const std::string & key) const;
+
+  size_t GetNumEntries() const { return _entries.size(); }
+  size_t GetSize_bytes() const { return _size_bytes; }
+  size_t GetMaxSize_bytes() const { return _maxSize_bytes; }
+
+  // Name of the file an utterance with this key is stored in
+  static std::string GetFileName(const std::string & key);
+
+private:
+
+  struct Entry
+  {
+    size_t size_bytes = 0;
+    uint64_t lastUsed = 0; // Larger is more recent
+  };
+
+  const std::string _cachePath;
+  const size_t _maxSize_bytes;
+
+  // Keyed by file name
+  std::map<std::string, Entry> _entries;
+  size_t _size_bytes = 0;
+  uint64_t _useCount = 0;
+
+  std::string GetFilePath(const std::string & fileName) const;
+  void Remove(const std::string & fileName);
+
+  // Marks an entry as just used, on disk too so that the order survives a restart
+  void Touch(const std::string & fileName, Entry & entry);
+
+  // Delete least recently used entries until the cache fits its budget
+  void Trim();
+
+};
+
+} // end namespace TextToSpeech
+} // end namespace Vector
+} // end namespace Anki
+
+#endif //__Anki_cozmo_cozmoAnim_textToSpeech_textToSpeechCache_H__
@@ -12,6 +12,7 @@
  */
 
 #include "textToSpeechComponent.h"
+#include "textToSpeechCache.h"
 #include "textToSpeechProvider.h"
 
 #include "cozmoAnim/animContext.h"
@@ -25,6 +26,7 @@
 #include "coretech/common/engine/utils/data/dataPlatform.h"
 
 #include "audioEngine/audioCallback.h"
+#include "audioEngine/audioTools/pcmBufferPool.h"
 #include "audioEngine/audioTypeTranslator.h"
 #include "audioEngine/plugins/ankiPluginInterface.h"
 #include "audioEngine/plugins/streamingWavePortalPlugIn.h"
@@ -54,6 +56,31 @@ namespace {
   // Enable write to /tmp/tts.pcm?
   CONSOLE_VAR(bool, kWriteTTSFile, "TextToSpeech", false);
 
+  // Keep synthesized utterances on disk? Both are read once, at startup
+  CONSOLE_VAR(bool, kEnableTTSCache, "TextToSpeech", true);
+  CONSOLE_VAR_RANGED(u32, kTTSCacheMaxSize_KB, "TextToSpeech", 4096, 0, 65536);
+
+  // Trim white space and end with a short Acapela silence tag, to remove trailing silence at end of audio stream
+  std::string GetProviderText(const std::string & text)
+  {
+    std::size_t firstScan = text.find_first_not_of(' ');
+    std::size_t first     = firstScan == std::string::npos ? text.length() : firstScan;
+    std::size_t last      = text.find_last_not_of(' ');
+    std::string ttsStr = text.substr(first, last-first+1);
+    // Check punctuation . ! ?
+    char lastChar = ttsStr[ttsStr.size() - 1];
+    if (!(lastChar == '.' || lastChar == '?' || lastChar == '!')) {
+      lastChar = '.'; // Set default
+    }
+    else {
+      ttsStr.pop_back();
+    }
+    // Set trailing silence pause to 10 ms and add punctuation to the end of the string
+    ttsStr += " \\pau=10\\";
+    ttsStr.push_back(lastChar);
+    return ttsStr;
+  }
+
 }
 
 namespace Anki {
@@ -72,6 +99,12 @@ TextToSpeechComponent::TextToSpeechComponent(const Anim::AnimContext* context)
   const Json::Value& tts_config = context->GetDataLoader()->GetTextToSpeechConfig();
   _pvdr = std::make_unique<TextToSpeech::TextToSpeechProvider>(context, tts_config);
 
+  const auto * dataPlatform = context->GetDataPlatform();
+  if (kEnableTTSCache && (nullptr != dataPlatform)) {
+    const std::string cachePath = dataPlatform->pathToResource(Util::Data::Scope::Cache, "tts");
+    _cache = std::make_unique<TextToSpeechCache>(cachePath, kTTSCacheMaxSize_KB * 1024);
+  }
+
 } // TextToSpeechComponent()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -131,23 +164,7 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
            ttsID, EnumToString(triggerMode), Util::HidePersonallyIdentifiableInfo(text.c_str()),
            EnumToString(style), durationScalar);
 
-  // Add Acapela Silence tag to remove trailing silence at end of audio stream
-  // Trim white space
-  std::size_t firstScan = text.find_first_not_of(' ');
-  std::size_t first     = firstScan == std::string::npos ? text.length() : firstScan;
-  std::size_t last      = text.find_last_not_of(' ');
-  std::string ttsStr = text.substr(first, last-first+1);
-  // Check punctuation . ! ?
-  char lastChar = ttsStr[ttsStr.size() - 1];
-  if (!(lastChar == '.' || lastChar == '?' || lastChar == '!')) {
-    lastChar = '.'; // Set default
-  }
-  else {
-    ttsStr.pop_back();
-  }
-  // Set trailing silence pause to 10 ms and add punctuation to the end of the string
-  ttsStr += " \\pau=10\\";
-  ttsStr.push_back(lastChar);
+  const std::string ttsStr = GetProviderText(text);
 
   // Get an empty data instance
   auto waveData = AudioEngine::PlugIns::StreamingWavePortalPlugIn::CreateDataInstance();
@@ -178,11 +195,24 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
     // Have we finished generating audio for this utterance?
     bool done = false;
 
-    Result result = GetFirstAudioData(ttsStr, durationScalar, waveData, done);
-    if (RESULT_OK != result) {
-      LOG_ERROR("TextToSpeechComponent.CreateSpeech", "Unable to get first audio data (error %d)", result);
-      PushEvent({ttsID, TextToSpeechState::Invalid, 0.f});
-      return;
+    // Repeatable utterances play straight from the cache when they are in it, else are recorded into it
+    std::string cacheKey;
+    const bool isCacheable = (_cache != nullptr) && _pvdr->GetCacheKey(ttsStr, durationScalar, cacheKey);
+    const bool isCached = isCacheable && GetCachedAudioData(cacheKey, waveData);
+    AudioChunk recorded;
+    AudioChunk * record = (isCacheable && !isCached) ? &recorded : nullptr;
+
+    Result result = RESULT_OK;
+    if (isCached) {
+      LOG_DEBUG("TextToSpeechComponent.CreateSpeech", "TTSID %d audio is cached", ttsID);
+      done = true;
+    } else {
+      result = GetFirstAudioData(ttsStr, durationScalar, waveData, done, record);
+      if (RESULT_OK != result) {
+        LOG_ERROR("TextToSpeechComponent.CreateSpeech", "Unable to get first audio data (error %d)", result);
+        PushEvent({ttsID, TextToSpeechState::Invalid, 0.f});
+        return;
+      }
     }
 
     {
@@ -201,7 +231,7 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
     }
 
     while (result == RESULT_OK && !done) {
-      result = GetNextAudioData(waveData, done);
+      result = GetNextAudioData(waveData, done, record);
       if (RESULT_OK != result) {
         LOG_ERROR("TextToSpeechComponent.CreateSpeech", "Unable to get next audio data (error %d)", result);
         PushEvent({ttsID, TextToSpeechState::Invalid, 0.f});
@@ -246,6 +276,10 @@ Result TextToSpeechComponent::CreateSpeech(const TTSID_t ttsID,
       bundle->state = AudioCreationState::Prepared;
       PushEvent({ttsID, TextToSpeechState::Prepared, duration_ms});
     }
+
+    if (record != nullptr) {
+      StoreInCache(cacheKey, waveData, std::move(recorded));
+    }
   });
 
   return RESULT_OK;
@@ -343,12 +377,21 @@ void TextToSpeechComponent::ClearAllLoadedAudioData()
   _bundleMap.clear();
 } // ClearAllLoadedAudioData()
 
-static void AppendAudioData(const std::shared_ptr<AudioEngine::StreamingWaveDataInstance> & waveData,
-                            const TextToSpeech::TextToSpeechProviderData & ttsData,
-                            bool done)
+// Provider fills ttsData's chunk in place, so lend it a pooled buffer's samples. Whatever capacity the buffer had
+// from an earlier chunk is reused and AppendAudioData() hands the samples back without a copy
+static AudioEngine::PcmBufferPtr LendPooledChunk(TextToSpeech::TextToSpeechProviderData & ttsData)
 {
-  using namespace AudioEngine;
+  auto pcmBuffer = AudioEngine::PcmBufferPool::GetSharedPool()->Acquire(0, 0);
+  ttsData.GetChunk().swap(pcmBuffer->samples);
+  return pcmBuffer;
+}
 
+static void AppendAudioData(const std::shared_ptr<AudioEngine::StreamingWaveDataInstance> & waveData,
+                            TextToSpeech::TextToSpeechProviderData & ttsData,
+                            AudioEngine::PcmBufferPtr && pcmBuffer,
+                            bool done,
+                            AudioUtil::AudioChunk * out_recorded)
+{
   // Enable this to inspect raw PCM
   if (kWriteTTSFile) {
     const auto num_samples = ttsData.GetNumSamples();
@@ -368,16 +411,15 @@ static void AppendAudioData(const std::shared_ptr<AudioEngine::StreamingWaveData
   }
 
   if (ttsData.GetNumSamples() > 0) {
-    const int sample_rate = ttsData.GetSampleRate();
-    const int num_channels = ttsData.GetNumChannels();
-    const size_t num_samples = ttsData.GetNumSamples();
-    const short * samples = ttsData.GetSamples();
-
-    // TBD: How can we get rid of intermediate container?
-    StandardWaveDataContainer waveContainer(sample_rate, num_channels, num_samples);
-    waveContainer.CopyWaveData(samples, num_samples);
-
-    waveData->AppendStandardWaveData(std::move(waveContainer));
+    if (out_recorded != nullptr) {
+      const auto & chunk = ttsData.GetChunk();
+      out_recorded->insert(out_recorded->end(), chunk.begin(), chunk.end());
+    }
+    // Plugin plays the provider's 16 bit samples directly
+    pcmBuffer->sampleRate = ttsData.GetSampleRate();
+    pcmBuffer->numberOfChannels = ttsData.GetNumChannels();
+    pcmBuffer->samples.swap(ttsData.GetChunk());
+    waveData->AppendPcmBuffer(std::move(pcmBuffer));
   }
   if (done) {
     LOG_DEBUG("TextToSpeechComponent.AppendAudioData", "Done producing data");
@@ -389,9 +431,11 @@ static void AppendAudioData(const std::shared_ptr<AudioEngine::StreamingWaveData
 Result TextToSpeechComponent::GetFirstAudioData(const std::string & text,
                                                 float durationScalar,
                                                 const StreamingWaveDataPtr & data,
-                                                bool & done)
+                                                bool & done,
+                                                AudioChunk * out_recorded)
 {
   TextToSpeech::TextToSpeechProviderData ttsData;
+  auto pcmBuffer = LendPooledChunk(ttsData);
   const Result result = _pvdr->GetFirstAudioData(text, durationScalar, ttsData, done);
 
   if (RESULT_OK != result) {
@@ -399,14 +443,17 @@ Result TextToSpeechComponent::GetFirstAudioData(const std::string & text,
     return result;
   }
 
-  AppendAudioData(data, ttsData, done);
+  AppendAudioData(data, ttsData, std::move(pcmBuffer), done, out_recorded);
 
   return RESULT_OK;
 } // GetFirstAudioData()
 
-Result TextToSpeechComponent::GetNextAudioData(const StreamingWaveDataPtr & data, bool & done)
+Result TextToSpeechComponent::GetNextAudioData(const StreamingWaveDataPtr & data,
+                                               bool & done,
+                                               AudioChunk * out_recorded)
 {
   TextToSpeech::TextToSpeechProviderData ttsData;
+  auto pcmBuffer = LendPooledChunk(ttsData);
   const Result result = _pvdr->GetNextAudioData(ttsData, done);
 
   if (RESULT_OK != result) {
@@ -414,11 +461,43 @@ Result TextToSpeechComponent::GetNextAudioData(const StreamingWaveDataPtr & data
     return result;
   }
 
-  AppendAudioData(data, ttsData, done);
+  AppendAudioData(data, ttsData, std::move(pcmBuffer), done, out_recorded);
 
   return RESULT_OK;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool TextToSpeechComponent::GetCachedAudioData(const std::string & cacheKey, const StreamingWaveDataPtr & data)
+{
+  TextToSpeechCache::Utterance utterance;
+  if (!_cache->Load(cacheKey, utterance)) {
+    return false;
+  }
+
+  auto pcmBuffer = AudioEngine::PcmBufferPool::GetSharedPool()->Acquire(utterance.sampleRate, utterance.numChannels);
+  pcmBuffer->samples.swap(utterance.samples);
+  if (!data->AppendPcmBuffer(std::move(pcmBuffer))) {
+    return false;
+  }
+  data->DoneProducingData();
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TextToSpeechComponent::StoreInCache(const std::string & cacheKey,
+                                         const StreamingWaveDataPtr & data,
+                                         AudioChunk && recorded)
+{
+  TextToSpeechCache::Utterance utterance;
+  utterance.sampleRate = data->GetSampleRate();
+  utterance.numChannels = data->GetNumberOfChannels();
+  utterance.samples = std::move(recorded);
+  if (_cache->Store(cacheKey, utterance)) {
+    LOG_DEBUG("TextToSpeechComponent.StoreInCache", "Cached %zu samples, cache holds %zu bytes",
+              utterance.samples.size(), _cache->GetSize_bytes());
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TextToSpeechComponent::BundlePtr TextToSpeechComponent::GetBundle(const TTSID_t ttsID)
 {
@@ -779,6 +858,43 @@ void TextToSpeechComponent::SetLocale(const std::string & locale)
 
 }
 
+void TextToSpeechComponent::Presynthesize(const std::string & text, float durationScalar)
+{
+  if (_cache == nullptr || text.find_first_not_of(' ') == std::string::npos) {
+    return;
+  }
+
+  LOG_DEBUG("TextToSpeechComponent.Presynthesize", "text '%s' durationScalar %.2f",
+            Util::HidePersonallyIdentifiableInfo(text.c_str()), durationScalar);
+
+  //
+  // Queued like any other utterance, so the cache key is built with the locale that a request sent now would use.
+  // The audio goes into a data instance that is never played, only recorded into the cache.
+  //
+  const auto & task = [this, ttsStr = GetProviderText(text), durationScalar] {
+    std::string cacheKey;
+    if (!_pvdr->GetCacheKey(ttsStr, durationScalar, cacheKey) || _cache->Contains(cacheKey)) {
+      return;
+    }
+
+    auto waveData = AudioEngine::PlugIns::StreamingWavePortalPlugIn::CreateDataInstance();
+    AudioChunk recorded;
+    bool done = false;
+    Result result = GetFirstAudioData(ttsStr, durationScalar, waveData, done, &recorded);
+    while (RESULT_OK == result && !done) {
+      result = GetNextAudioData(waveData, done, &recorded);
+    }
+    if (RESULT_OK != result) {
+      LOG_WARNING("TextToSpeechComponent.Presynthesize", "Unable to synthesize audio (error %d)", result);
+      return;
+    }
+
+    StoreInCache(cacheKey, waveData, std::move(recorded));
+  };
+
+  Util::Dispatch::Async(_dispatchQueue, task);
+}
+
 //
 // Called by audio engine to handle keyframe playback start
 //
@@ -15,6 +15,7 @@
 #include "audioEngine/audioTools/standardWaveDataContainer.h"
 #include "audioEngine/audioTools/streamingWaveDataInstance.h"
 #include "audioEngine/audioTypes.h"
+#include "audioUtil/audioDataTypes.h"
 #include "coretech/common/shared/types.h"
 #include "clad/audio/audioEventTypes.h"
 #include "clad/audio/audioGameObjectTypes.h"
@@ -40,6 +41,7 @@ namespace Anki {
       struct TextToSpeechCancel;
     }
     namespace TextToSpeech {
+      class TextToSpeechCache;
       class TextToSpeechProvider;
     }
   }
@@ -87,6 +89,13 @@ public:
   //
   void SetLocale(const std::string & locale);
 
+  //
+  // Called on main thread when text is likely to be spoken soon. The audio is synthesized in the background and
+  // cached, so that a later TextToSpeechPrepare for the same text and settings plays without waiting on the provider.
+  // Does nothing if the text is already cached or its audio is not repeatable.
+  //
+  void Presynthesize(const std::string & text, float durationScalar);
+
   // Callbacks invoked by audio engine
   void OnAudioPlaying(const TTSID_t ttsID);
   void OnAudioComplete(const TTSID_t ttsID);
@@ -100,6 +109,8 @@ private:
   using StreamingWaveDataPtr = std::shared_ptr<AudioEngine::StreamingWaveDataInstance>;
   using AudioTtsProcessingStyle = AudioMetaData::SwitchState::Robot_Vic_External_Processing;
   using TextToSpeechProvider = TextToSpeech::TextToSpeechProvider;
+  using TextToSpeechCache = TextToSpeech::TextToSpeechCache;
+  using AudioChunk = AudioUtil::AudioChunk;
   using DispatchQueue = Util::Dispatch::Queue;
   using EventTuple = std::tuple<TTSID_t, TextToSpeechState, f32>;
   using EventQueue = std::deque<EventTuple>;
@@ -147,6 +158,9 @@ private:
   // Platform-specific provider
   std::unique_ptr<TextToSpeechProvider> _pvdr;
 
+  // Synthesized audio kept on disk, only used on the worker thread. Null if caching is disabled
+  std::unique_ptr<TextToSpeechCache> _cache;
+
   // Thread-safe event queue
   EventQueue _event_queue;
   std::mutex _event_mutex;
@@ -162,12 +176,22 @@ private:
   // Initialize TTS utterance and get first chunk of TTS audio.
   // Returns RESULT_OK on success, else error code.
   // Sets done to true when audio generation is complete.
-  Result GetFirstAudioData(const std::string & text, float durationScalar, const StreamingWaveDataPtr & data, bool & done);
+  // If out_recorded is not null, the audio is also appended to it.
+  Result GetFirstAudioData(const std::string & text, float durationScalar, const StreamingWaveDataPtr & data, bool & done,
+                           AudioChunk * out_recorded);
 
   // Get next chunk of TTS audio.
   // Returns RESULT_OK on success, else error code.
   // Sets done to true when audio generation is complete.
-  Result GetNextAudioData(const StreamingWaveDataPtr & data, bool & done);
+  // If out_recorded is not null, the audio is also appended to it.
+  Result GetNextAudioData(const StreamingWaveDataPtr & data, bool & done, AudioChunk * out_recorded);
+
+  // On a cache hit, append the whole utterance to data and mark it complete.
+  // Returns false on a miss. Worker thread only.
+  bool GetCachedAudioData(const std::string & cacheKey, const StreamingWaveDataPtr & data);
+
+  // Cache the audio recorded by GetFirstAudioData()/GetNextAudioData() for data. Worker thread only.
+  void StoreInCache(const std::string & cacheKey, const StreamingWaveDataPtr & data, AudioChunk && recorded);
 
   // Get bundle for given ID
   // Returns nullptr if ID is not found
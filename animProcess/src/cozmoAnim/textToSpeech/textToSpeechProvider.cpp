@@ -20,6 +20,8 @@
 #error "No text-to-speech provider implemented for this platform"
 #endif
 
+#include "textToSpeechProviderConfig.h"
+
 #include "cozmoAnim/animContext.h"
 #include "json/json.h"
 #include "util/logging/logging.h"
@@ -74,6 +76,20 @@ Result TextToSpeechProvider::GetNextAudioData(TextToSpeechProviderData & data, b
   return _impl->GetNextAudioData(data, done);
 }
 
+bool TextToSpeechProvider::GetCacheKey(const std::string & text, float durationScalar, std::string & out_key) const
+{
+  DEV_ASSERT(_impl != nullptr, "TextToSpeechProvider.GetCacheKey.InvalidImplementation");
+  const auto * config = _impl->GetConfig();
+  std::string settings;
+  if (config == nullptr || !config->GetSettingsKey(text.size(), settings)) {
+    return false;
+  }
+  char scalar[16];
+  snprintf(scalar, sizeof(scalar), "%.3f", durationScalar);
+  out_key = _impl->GetLocale() + "/" + settings + "/" + scalar + "/" + text;
+  return true;
+}
+
 } // end namespace TextToSpeech
 } // end namespace Vector
 } // end namespace Anki
@@ -105,6 +105,10 @@ public:
   // Sets done to true when audio generation is complete.
   Result GetNextAudioData(TextToSpeechProviderData & data, bool & done);
 
+  // Key identifying the audio GetFirstAudioData() would generate for this text with the current locale and settings.
+  // Returns false if that audio is not repeatable (e.g. speed is picked at random) and so should not be cached.
+  bool GetCacheKey(const std::string & text, float durationScalar, std::string & out_key) const;
+
 private:
   // Pointer to platform-specific implementation
   std::unique_ptr<TextToSpeechProviderImpl> _impl;
@@ -237,6 +237,29 @@ int TextToSpeechProviderConfig::GetSpeed(Anki::Util::RandomGenerator * rng, size
   return speed;
 }
 
+bool TextToSpeechProviderConfig::GetSettingsKey(size_t textLength, std::string & out_key) const
+{
+  int speed = GetSpeed();
+  for (const auto & trait : _speedTraits) {
+    if (trait.textLengthMin <= textLength && textLength <= trait.textLengthMax) {
+      if (trait.rangeMin != trait.rangeMax) {
+        return false;
+      }
+      speed = trait.rangeMin;
+      break;
+    }
+  }
+
+  out_key = _tts_language + "/" + _tts_voice;
+  for (const int value : {speed, GetShaping(), GetPitch(),
+                          GetLeadingSilence_ms(), GetTrailingSilence_ms(), GetPausePunctuation_ms(),
+                          GetPauseSemicolon_ms(), GetPauseComma_ms(), GetPauseBracket_ms(), GetPauseSpelling_ms(),
+                          static_cast<int>(GetEnablePauseParams())}) {
+    out_key += "/" + std::to_string(value);
+  }
+  return true;
+}
+
 TextToSpeechProviderConfig::ConfigTrait::ConfigTrait(const Json::Value & json)
 {
   JsonTools::GetValueOptional(json, TTS_TEXTLENGTHMIN_KEY, textLengthMin);
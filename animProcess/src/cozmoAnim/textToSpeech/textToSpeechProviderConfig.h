@@ -59,6 +59,13 @@ public:
   //
   int GetSpeed(Anki::Util::RandomGenerator* rng, size_t textLength) const;
 
+  //
+  // Describe every setting that shapes the audio generated for text of this length, for use in a cache key.
+  // Returns false if the speed for this length is picked at random, since a cached utterance would always
+  // play back the same pick.
+  //
+  bool GetSettingsKey(size_t textLength, std::string & out_key) const;
+
 private:
 
   // Base values
@@ -58,6 +58,10 @@ public:
   // Sets done to true when audio generation is complete.
   Result GetNextAudioData(TextToSpeechProviderData & data, bool & done);
 
+  // Current locale and its configuration. Config is null until a locale has been initialized.
+  const std::string & GetLocale() const { return _locale; }
+  const TextToSpeechProviderConfig * GetConfig() const { return _tts_config.get(); }
+
 private:
   // Pointer to RNG provided by context
   Anki::Util::RandomGenerator * _rng = nullptr;
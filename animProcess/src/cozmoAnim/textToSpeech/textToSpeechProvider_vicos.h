@@ -58,6 +58,10 @@ public:
   // Sets done to true when audio generation is complete.
   Result GetNextAudioData(TextToSpeechProviderData & data, bool & done);
 
+  // Current locale and its configuration. Config is null until a locale has been initialized.
+  const std::string & GetLocale() const { return _locale; }
+  const TextToSpeechProviderConfig * GetConfig() const { return _tts_config.get(); }
+
 private:
   // Path to TTS resources
   std::string _tts_resource_path;
@@ -25,6 +25,7 @@
 #include "clad/robotInterface/messageEngineToRobot.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/helpers/quoteMacro.h"
+#include "util/console/consoleInterface.h"
 #include "util/logging/logging.h"
 
 #include <opencv2/core.hpp>
@@ -41,6 +42,10 @@ bool has_any_digits(const std::string& s)
 
 namespace Anki {
   namespace Vector {
+
+    // Redraw only the sprite boxes of a composite image that changed since the last frame, instead of the whole image
+    CONSOLE_VAR(bool, kCompositeImageIncrementalRender, "Animation", true);
+
 #pragma mark -
 #pragma mark IKeyFrame
     
@@ -302,6 +307,9 @@ void SafeNumericCast(const FromType& fromVal, ToType& toVal, const char* debugNa
       _internalUpdateInterval_ms = other._internalUpdateInterval_ms;
       _compositeImageUpdated     = other._compositeImageUpdated;
       _compositeImageUpdateMap   = other._compositeImageUpdateMap;
+      _spriteStreamCache         = other._spriteStreamCache;
+      _numReadAheadFrames        = other._numReadAheadFrames;
+      _streamHoldFor_ms          = other._streamHoldFor_ms;
       
       if(other._compositeImage != nullptr){
         _compositeImage.reset(new Vision::CompositeImage(*other._compositeImage));
@@ -482,28 +490,47 @@ void SafeNumericCast(const FromType& fromVal, ToType& toVal, const char* debugNa
         const auto& layerLayoutMap = _compositeImage->GetLayerLayoutMap();
         numLayers = layerLayoutMap.size();
 
-        const auto height = _compositeImage->GetHeight();
-        const auto width  = _compositeImage->GetWidth();
-        auto* img = new Vision::ImageRGBA(height, width);
+        const u32 curFrame = GetFrameNumberForTime(timeSinceAnimStart_ms);
+        if(_spriteStreamCache != nullptr){
+          // Only the frame entering the window needs decoding, the rest are already cached from earlier ticks
+          const u32 windowSize = _numReadAheadFrames + 1;
+          const TimeStamp_t cacheFor_ms = (windowSize * _internalUpdateInterval_ms) + _streamHoldFor_ms;
+          _compositeImage->StreamInternalSprites(_spriteStreamCache, curFrame, windowSize, cacheFor_ms);
+        }
+
+        Vision::ImageRGBA* img = nullptr;
+        if(kCompositeImageIncrementalRender){
+          if(_incrementalRender == nullptr){
+            _incrementalRender.reset(new Vision::CompositeImage::IncrementalRender());
+          }
+          _compositeImage->OverlayImageWithFrameIncremental(*_incrementalRender, curFrame);
+          // The handle outlives this tick (it is buffered for the display), so hand out a copy of the persistent image
+          img = new Vision::ImageRGBA();
+          _incrementalRender->image.CopyTo(*img);
+        }else{
+          _incrementalRender.reset();
+          const auto height = _compositeImage->GetHeight();
+          const auto width  = _compositeImage->GetWidth();
+          img = new Vision::ImageRGBA(height, width);
 
-        bool needToClearBuffer = (numLayers == 0);
-        if (!needToClearBuffer)
-        {
-          const auto& firstCompositeImageLayer = layerLayoutMap.begin()->second;
-          const auto& firstSpriteBox = firstCompositeImageLayer.GetLayoutMap().begin()->second;
-          if (firstSpriteBox.GetWidth() != width || firstSpriteBox.GetHeight() != height)
+          bool needToClearBuffer = (numLayers == 0);
+          if (!needToClearBuffer)
           {
-            needToClearBuffer = true;
+            const auto& firstCompositeImageLayer = layerLayoutMap.begin()->second;
+            const auto& firstSpriteBox = firstCompositeImageLayer.GetLayoutMap().begin()->second;
+            if (firstSpriteBox.GetWidth() != width || firstSpriteBox.GetHeight() != height)
+            {
+              needToClearBuffer = true;
+            }
+          }
+          if (needToClearBuffer)
+          {
+            ANKI_CPU_PROFILE("img->FillWith"); // This takes roughly 0.205 ms on robot.
+            img->FillWith(Vision::PixelRGBA());
           }
-        }
-        if (needToClearBuffer)
-        {
-          ANKI_CPU_PROFILE("img->FillWith"); // This takes roughly 0.205 ms on robot.
-          img->FillWith(Vision::PixelRGBA());
-        }
 
-        const u32 curFrame = GetFrameNumberForTime(timeSinceAnimStart_ms);
-        _compositeImage->OverlayImageWithFrame(*img, curFrame);
+          _compositeImage->OverlayImageWithFrame(*img, curFrame);
+        }
         handle = std::make_shared<Vision::SpriteWrapper>(img);
         _compositeImageUpdated = false;
         return true;
@@ -524,6 +551,15 @@ void SafeNumericCast(const FromType& fromVal, ToType& toVal, const char* debugNa
       _compositeImage->CacheInternalSprites(cache, endTime_ms);
     }
 
+    void SpriteSequenceKeyFrame::StreamInternalSprites(Vision::SpriteCache* cache,
+                                                       const u32 numReadAheadFrames,
+                                                       const TimeStamp_t holdFor_ms)
+    {
+      _spriteStreamCache  = cache;
+      _numReadAheadFrames = numReadAheadFrames;
+      _streamHoldFor_ms   = holdFor_ms;
+    }
+
     bool SpriteSequenceKeyFrame::AllowProceduralEyeOverlays() const
     {
       return _compositeImage->GetLayerByName(Vision::LayerName::Procedural_Eyes) != nullptr;
@@ -616,6 +652,15 @@ void SafeNumericCast(const FromType& fromVal, ToType& toVal, const char* debugNa
       otherFrame._audioReferences.clear();
     }
 
+    void RobotAudioKeyFrame::Reset()
+    {
+      AudioRefList audioReferences;
+      audioReferences.swap(_audioReferences);
+      *this = RobotAudioKeyFrame();
+      audioReferences.clear();
+      _audioReferences.swap(audioReferences);
+    }
+
     Result RobotAudioKeyFrame::DefineFromFlatBuf(const CozmoAnim::RobotAudio* audioKeyframe, const std::string& animNameDebug)
     {
       DEV_ASSERT(audioKeyframe != nullptr, "RobotAudioKeyFrame.DefineFromFlatBuf.NullAnim");
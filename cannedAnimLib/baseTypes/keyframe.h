@@ -20,6 +20,7 @@
 #include "coretech/common/engine/colorRGBA.h"
 #include "coretech/vision/engine/image.h"
 #include "cannedAnimLib/baseTypes/audioKeyFrameTypes.h"
+#include "coretech/vision/shared/compositeImage/compositeImage.h"
 #include "coretech/vision/shared/compositeImage/compositeImageLayer.h"
 #include "coretech/vision/shared/spriteSequence/spriteSequenceContainer.h"
 #include "cannedAnimLib/proceduralFace/proceduralFace.h"
@@ -266,6 +267,10 @@ namespace Vector {
     // Note: otherFrame will be invalid after merging
     void MergeKeyFrame(RobotAudioKeyFrame&& otherFrame);
     
+    // Back to a default constructed frame, but keeping the storage for audio references so the frame can be
+    // merged into again without allocating
+    void Reset();
+    
     
   protected:
     virtual Result SetMembersFromJson(const Json::Value &jsonRoot, const std::string& animNameDebug = "") override;
@@ -375,6 +380,10 @@ namespace Vector {
     void OverrideShouldRenderInEyeHue(bool shouldRenderInEyeHue);
 
     void CacheInternalSprites(Vision::SpriteCache* cache, const TimeStamp_t endTime_ms);
+
+    // While playing, keep the current frame and the next numReadAheadFrames decoded in cache, holding each for
+    // holdFor_ms after it was last needed. Pass a null cache to go back to decoding frames as they are drawn
+    void StreamInternalSprites(Vision::SpriteCache* cache, const u32 numReadAheadFrames, const TimeStamp_t holdFor_ms);
     
     bool AllowProceduralEyeOverlays() const;
     
@@ -406,6 +415,14 @@ namespace Vector {
     TimeStamp_t  _internalUpdateInterval_ms = ANIM_TIME_STEP_MS;
     TimeStamp_t _keyframeActiveDuration_ms = 0;
 
+    // Set by StreamInternalSprites
+    Vision::SpriteCache* _spriteStreamCache = nullptr;
+    u32 _numReadAheadFrames = 0;
+    TimeStamp_t _streamHoldFor_ms = 0;
+
+    // Kept between ticks so that only sprite boxes whose frame changed are redrawn. Not copied with the keyframe
+    std::unique_ptr<Vision::CompositeImage::IncrementalRender> _incrementalRender;
+
     
   }; // class SpriteSequenceKeyFrame
 
@@ -122,7 +122,8 @@ namespace Animations {
   void Track<ProceduralFaceKeyFrame>::AdvanceTrack(const TimeStamp_t toTime_ms)
   {
     if(ANKI_DEV_CHEATS){
-      auto allKeyframes = GetCopyOfKeyframes();
+      // Runs every tick for every face layer, so check the frames in place rather than a copy of them
+      const auto& allKeyframes = _frames;
       auto safetyCheckIter = allKeyframes.begin();
       while(safetyCheckIter != allKeyframes.end()) {
         auto nextIter = safetyCheckIter;
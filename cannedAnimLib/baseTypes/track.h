@@ -20,6 +20,7 @@
 #include "util/helpers/boundedWhile.h"
 #include <stdint.h>
 #include <list>
+#include <type_traits>
 
 namespace CozmoAnim {
   struct HeadAngle;
@@ -46,6 +47,8 @@ class Track
 public:
   static constexpr size_t ConstMaxFramesPerTrack() { return 1000; }
 
+  using FrameList = std::list<FRAME_TYPE>;
+
   //
   // Default copy constructor and copy assignment operator do not do the right thing for std::list iterators.
   // When a std::list is copied, any associated iterator must be updated to point to the same location in
@@ -167,12 +170,24 @@ public:
   bool IsEmpty() const { return _frames.empty(); }
   int TrackLength() const { return static_cast<int>(_frames.size()); }
 
+  // Memory held by the keyframes, counting each list node's pointers. Keyframes which point at data elsewhere
+  // (like sprite sequences) only count the pointer
+  size_t GetNumBytes() const { return _frames.size() * (sizeof(FRAME_TYPE) + 2 * sizeof(void*)); }
 
-  void Clear() { _frames.clear(); _frameIter = _frames.end(); }
+
+  void Clear();
 
   // Clear all frames up to, but not including, the current one.
   void ClearUpToCurrent();
 
+  // Frames added to this track take their list nodes from framePool, and frames cleared from it hand theirs back,
+  // instead of allocating and freeing one per frame. The pool must outlive the track and is not copied with it.
+  void SetFramePool(FrameList* framePool) { _framePool = framePool; }
+
+  // Replace this track's frames with copies of other's and move to the start. Unlike copy assignment, this reuses
+  // nodes from the frame pool.
+  void CopyFramesFrom(const Track& other);
+
   // Append Track to current track
   void AppendTrack(const Track& appendTrack, const TimeStamp_t appendStartTime_ms);
 
@@ -186,7 +201,6 @@ public:
 
 private:
 
-  using FrameList = std::list<FRAME_TYPE>;
   using FrameListIter = typename std::list<FRAME_TYPE>::iterator;
 
   // List of frames
@@ -195,6 +209,14 @@ private:
   // Pointer to current position
   FrameListIter _frameIter = _frames.begin();
 
+  // Optional source of list nodes, see SetFramePool()
+  FrameList* _framePool = nullptr;
+
+  // Append a copy of keyFrame, reusing a pooled node when the frame type can be assigned into one
+  void PushBackFrameHelper(const FRAME_TYPE& keyFrame) { PushBackFrameHelper(keyFrame, std::is_copy_assignable<FRAME_TYPE>()); }
+  void PushBackFrameHelper(const FRAME_TYPE& keyFrame, std::true_type);
+  void PushBackFrameHelper(const FRAME_TYPE& keyFrame, std::false_type) { _frames.emplace_back(keyFrame); }
+
   Result AddKeyFrameToBackHelper(const FRAME_TYPE& keyFrame, FRAME_TYPE* &prevKeyFrame);
   Result AddKeyFrameByTimeHelper(const FRAME_TYPE& keyFrame, FRAME_TYPE* &prevKeyFrame);
 
@@ -310,7 +332,7 @@ Result Track<FRAME_TYPE>::AddKeyFrameToBackHelper(const FRAME_TYPE& keyFrame,
     prevKeyFrame = nullptr;
   }
 
-  _frames.emplace_back(keyFrame);
+  PushBackFrameHelper(keyFrame);
 
   // If we just added the first keyframe we need to reset the frameIter to point
   // back to the beginning.
@@ -550,15 +572,55 @@ Result Track<FRAME_TYPE>::AddNewKeyFrameToBack(const FRAME_TYPE& newKeyFrame)
   return lastResult;
 }
 
+template<typename FRAME_TYPE>
+void Track<FRAME_TYPE>::PushBackFrameHelper(const FRAME_TYPE& keyFrame, std::true_type)
+{
+  if((_framePool != nullptr) && !_framePool->empty()) {
+    _frames.splice(_frames.end(), *_framePool, _framePool->begin());
+    _frames.back() = keyFrame;
+  } else {
+    _frames.emplace_back(keyFrame);
+  }
+}
+
+template<typename FRAME_TYPE>
+void Track<FRAME_TYPE>::Clear()
+{
+  if(_framePool != nullptr) {
+    _framePool->splice(_framePool->end(), _frames);
+  } else {
+    _frames.clear();
+  }
+  _frameIter = _frames.end();
+}
+
 template<typename FRAME_TYPE>
 void Track<FRAME_TYPE>::ClearUpToCurrent()
 {
+  if(_framePool != nullptr) {
+    _framePool->splice(_framePool->end(), _frames, _frames.begin(), _frameIter);
+    return;
+  }
   auto iter = _frames.begin();
   while(iter != _frameIter) {
     iter = _frames.erase(iter);
   }
 }
 
+template<typename FRAME_TYPE>
+void Track<FRAME_TYPE>::CopyFramesFrom(const Track<FRAME_TYPE>& other)
+{
+  if(this == &other) {
+    MoveToStart();
+    return;
+  }
+  Clear();
+  for (const FRAME_TYPE& aFrame : other._frames) {
+    PushBackFrameHelper(aFrame);
+  }
+  _frameIter = _frames.begin();
+}
+
 template<class FRAME_TYPE>
 void Track<FRAME_TYPE>::AppendTrack(const Track<FRAME_TYPE>& appendTrack, const TimeStamp_t appendStartTime_ms)
 {
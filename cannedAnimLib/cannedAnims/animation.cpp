@@ -18,6 +18,7 @@
 #include "anki/cozmo/shared/cozmoConfig.h"
 #include "util/logging/logging.h"
 #include "clad/robotInterface/messageEngineToRobot.h"
+#include <algorithm>
 
 #define DEBUG_ANIMATIONS 0
 
@@ -26,6 +27,10 @@ namespace Vector {
 
 static const char* kNameKey = "Name";
 CONSOLE_VAR(bool, kShouldPreCacheSprites, "Animation", false);
+// When not pre-caching, how many frames past the current one sprite sequences decode ahead of time (0 decodes each
+// frame as it is drawn), and how long decoded frames are kept after they were last needed so short loops reuse them
+CONSOLE_VAR_RANGED(u32, kSpriteReadAheadFrames, "Animation", 3, 0, 30);
+CONSOLE_VAR_RANGED(u32, kSpriteStreamHoldTime_ms, "Animation", 500, 0, 10000);
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Animation::Animation(const std::string& name)
@@ -252,6 +257,7 @@ Result Animation::DefineFromFlatBuf(const std::string& name,
     }
   }
 
+  UpdateAudioEvents();
   return RESULT_OK;
 }
 
@@ -341,6 +347,7 @@ Result Animation::DefineFromJson(const std::string& name, const Json::Value &jso
 
   } // for each frame
 
+  UpdateAudioEvents();
   return RESULT_OK;
 }
 
@@ -433,6 +440,8 @@ Result Animation::Init(Vision::SpriteCache* cache)
   ALL_TRACKS(MoveToStart, ;);
   if(kShouldPreCacheSprites){
     CacheAnimationSprites(cache);
+  }else if(kSpriteReadAheadFrames > 0){
+    StreamAnimationSprites(cache);
   }
   _isInitialized = true;
 
@@ -443,6 +452,7 @@ Result Animation::Init(Vision::SpriteCache* cache)
 void Animation::Clear()
 {
   ALL_TRACKS(Clear, ;);
+  _audioEvents.clear();
   _isInitialized = false;
 }
 
@@ -462,12 +472,31 @@ void Animation::CacheAnimationSprites(Vision::SpriteCache* cache)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Animation::StreamAnimationSprites(Vision::SpriteCache* cache)
+{
+  if(cache == nullptr){
+    return;
+  }
+
+  auto& frameList = _spriteSequenceTrack.GetAllFrames();
+  for(auto& frame: frameList){
+    frame.StreamInternalSprites(cache, kSpriteReadAheadFrames, kSpriteStreamHoldTime_ms);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Animation::IsEmpty() const
 {
   return ALL_TRACKS(IsEmpty, &&);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t Animation::GetNumBytes() const
+{
+  return ALL_TRACKS(GetNumBytes, +);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool Animation::HasFramesLeft() const
 {
@@ -498,6 +527,25 @@ void Animation::AppendAnimation(const Animation& appendAnim)
   _turnToRecordedHeadingTrack.AppendTrack(appendAnim.GetTrack<TurnToRecordedHeadingKeyFrame>(), animOffest_ms);
   _robotAudioTrack.AppendTrack(appendAnim.GetTrack<RobotAudioKeyFrame>(), animOffest_ms);
 
+  UpdateAudioEvents();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Animation::UpdateAudioEvents()
+{
+  _audioEvents.clear();
+  for (const auto& keyFrame : _robotAudioTrack.GetAllKeyframes()) {
+    for (const auto& audioRef : keyFrame.GetAudioReferencesList()) {
+      if (audioRef.Tag != AudioKeyFrameType::AudioRefTag::EventGroup) {
+        continue;
+      }
+      for (const auto& eventDef : audioRef.EventGroup.Events) {
+        if (std::find(_audioEvents.begin(), _audioEvents.end(), eventDef.AudioEvent) == _audioEvents.end()) {
+          _audioEvents.push_back(eventDef.AudioEvent);
+        }
+      }
+    }
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -23,6 +23,7 @@
 #include "cannedAnimLib/baseTypes/track.h"
 #include <list>
 #include <queue>
+#include <vector>
 
 namespace CozmoAnim {
   struct AnimClip;
@@ -73,6 +74,9 @@ public:
   // An animation is Empty if *all* its tracks are empty
   bool IsEmpty() const;
 
+  // Approximate memory held by all the tracks' keyframes
+  size_t GetNumBytes() const;
+
   // True if any track has has frames left to play
   bool HasFramesLeft() const;
   
@@ -84,6 +88,10 @@ public:
   // of the animation so that they're not being loaded from disk during playback
   void CacheAnimationSprites(Vision::SpriteCache* cache);
 
+  // Instead of caching all of the sprites up front, have the sprite sequence track keep the next few frames
+  // decoded as it plays, so long sequences don't hold every frame in memory or stall Init decoding them
+  void StreamAnimationSprites(Vision::SpriteCache* cache);
+
 
   void SetName(const std::string& name) { _name = name; }
   const std::string& GetName() const { return _name; }
@@ -101,6 +109,11 @@ public:
   // NOTE: This function only moves tracks forwards
   void AdvanceTracks(const TimeStamp_t toTime_ms);
 
+  // Every audio event the audio track may post, without duplicates. Gathered when the animation is defined or
+  // appended to, so the soundbanks holding them can be loaded before it plays
+  using AudioEventList = std::vector<AudioMetaData::GameEvent::GenericEvent>;
+  const AudioEventList& GetAudioEvents() const { return _audioEvents; }
+
 private:
 
   // Name of this animation
@@ -118,6 +131,9 @@ private:
   Animations::Track<RecordHeadingKeyFrame>  _recordHeadingTrack;
   Animations::Track<TurnToRecordedHeadingKeyFrame> _turnToRecordedHeadingTrack;
   Animations::Track<RobotAudioKeyFrame>     _robotAudioTrack;
+
+  AudioEventList _audioEvents;
+  void UpdateAudioEvents();
   
   // Compare if the track's last key frame time is gerater then the lastFrameTime_ms argument
   // Return the greater time
@@ -16,8 +16,15 @@
 #include "cannedAnimLib/baseTypes/track.h"
 #include "cannedAnimLib/cannedAnims/cannedAnimationLoader.h"
 
+#include "util/cpuProfiler/cpuProfiler.h"
 #include "util/helpers/boundedWhile.h"
 #include "util/logging/logging.h"
+#include "util/math/numericCast.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #define LOG_CHANNEL "Animations"
 
@@ -45,6 +52,42 @@ void SetNewTapHeight(ConsoleFunctionContextRef context)
 CONSOLE_FUNC(SetNewTapHeight, "CubeSpinner");
 #endif
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::shared_ptr<MappedAnimationFile> MappedAnimationFile::Map(const std::string& path)
+{
+  const int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG_ERROR("MappedAnimationFile.Map.OpenFailed", "Could not open %s", path.c_str());
+    return nullptr;
+  }
+
+  struct stat attrib{0};
+  if ((fstat(fd, &attrib) != 0) || (attrib.st_size <= 0)) {
+    LOG_ERROR("MappedAnimationFile.Map.EmptyFile", "Found no data in %s", path.c_str());
+    close(fd);
+    return nullptr;
+  }
+
+  const size_t size = Util::numeric_cast<size_t>(attrib.st_size);
+  void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // The mapping stays valid after the descriptor is closed
+  close(fd);
+  if (data == MAP_FAILED) {
+    LOG_ERROR("MappedAnimationFile.Map.MapFailed", "Could not map %s", path.c_str());
+    return nullptr;
+  }
+
+  return std::shared_ptr<MappedAnimationFile>(new MappedAnimationFile(static_cast<const unsigned char*>(data), size));
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MappedAnimationFile::~MappedAnimationFile()
+{
+  munmap(const_cast<unsigned char*>(_data), _size);
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 CannedAnimationContainer::CannedAnimationContainer()
 {
@@ -64,8 +107,21 @@ CannedAnimationContainer::~CannedAnimationContainer()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool CannedAnimationContainer::HasAnimation(const std::string& name) const
 {
+  return HasAnimation(Util::StringID::Find(name));
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CannedAnimationContainer::HasAnimation(const Util::StringID& name) const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
   auto retVal = _animations.find(name);
-  return retVal != _animations.end();
+  if (retVal != _animations.end()) {
+    return true;
+  }
+
+  return _lazyAnimations.find(name) != _lazyAnimations.end();
 }
 
 
@@ -81,44 +137,199 @@ Animation* CannedAnimationContainer::GetAnimation(const std::string& name)
 const Animation* CannedAnimationContainer::GetAnimation(const std::string& name) const
 {
   const Animation* animPtr = nullptr;
-  
-  auto retVal = _animations.find(name);
-  if(retVal == _animations.end()) {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    animPtr = FindAnimation(Util::StringID::Find(name));
+  }
+
+  if(animPtr == nullptr) {
     PRINT_NAMED_ERROR("CannedAnimationContainer.GetAnimation_Const.InvalidName",
                       "Animation requested for unknown animation '%s'.",
                       name.c_str());
-  } else {
-    animPtr = &retVal->second;
   }
-  
+
+  return animPtr;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Animation* CannedAnimationContainer::GetAnimation(const Util::StringID& name)
+{
+  const Animation* animPtr = const_cast<const CannedAnimationContainer *>(this)->GetAnimation(name);
+  return const_cast<Animation*>(animPtr);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const Animation* CannedAnimationContainer::GetAnimation(const Util::StringID& name) const
+{
+  const Animation* animPtr = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    animPtr = FindAnimation(name);
+  }
+
+  if(animPtr == nullptr) {
+    PRINT_NAMED_ERROR("CannedAnimationContainer.GetAnimation_Const.InvalidName",
+                      "Animation requested for unknown animation '%s'.",
+                      name.c_str());
+  }
+
   return animPtr;
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const Animation* CannedAnimationContainer::FindAnimation(const Util::StringID& name) const
+{
+  auto retVal = _animations.find(name);
+  if(retVal != _animations.end()) {
+    return &retVal->second;
+  }
+
+  return GetOrDecodeLazyAnimation(name);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const Animation* CannedAnimationContainer::GetOrDecodeLazyAnimation(const Util::StringID& name) const
+{
+  auto iter = _lazyAnimations.find(name);
+  if(iter == _lazyAnimations.end()) {
+    return nullptr;
+  }
+
+  LazyAnimation& lazyAnim = iter->second;
+  if(lazyAnim.decoded == nullptr) {
+    ANKI_CPU_PROFILE("CannedAnimationContainer::DecodeLazyAnimation");
+    const std::string& nameStr = name.ToString();
+    auto animation = std::make_unique<Animation>(nameStr);
+    const Result result = animation->DefineFromFlatBuf(nameStr, lazyAnim.animClip, lazyAnim.seqContainer);
+    if(result != RESULT_OK) {
+      PRINT_NAMED_ERROR("CannedAnimationContainer.GetOrDecodeLazyAnimation.DefineFailed",
+                        "Failed to define animation '%s' from FlatBuffers.",
+                        name.c_str());
+      return nullptr;
+    }
+    _memoryAccount.Add(animation->GetNumBytes());
+    lazyAnim.decoded = std::move(animation);
+  }
+
+  return lazyAnim.decoded.get();
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CannedAnimationContainer::AddAnimation(Animation&& animation, bool& outOverwriting)
 {
-  const std::string& name = animation.GetName();
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  const Util::StringID name(animation.GetName());
 
   // Replace animation with the given one because this
   // is mainly for animators testing new animations
   auto iter = _animations.find(name);
   if(iter != _animations.end()) {
+    _memoryAccount.Subtract(iter->second.GetNumBytes());
     _animations.erase(iter);
     outOverwriting = true;
   }
 
+  auto lazyIter = _lazyAnimations.find(name);
+  if(lazyIter != _lazyAnimations.end()) {
+    if(lazyIter->second.decoded != nullptr) {
+      _memoryAccount.Subtract(lazyIter->second.decoded->GetNumBytes());
+    }
+    _lazyAnimations.erase(lazyIter);
+    outOverwriting = true;
+  }
+
+  _memoryAccount.Add(animation.GetNumBytes());
   _animations.emplace(name, std::move(animation));
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationContainer::AddLazyAnimation(const std::string& name,
+                                                const std::shared_ptr<MappedAnimationFile>& file,
+                                                const CozmoAnim::AnimClip* animClip,
+                                                Vision::SpriteSequenceContainer* seqContainer,
+                                                bool& outOverwriting)
+{
+  const Util::StringID nameID(name);
+
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  auto iter = _animations.find(nameID);
+  if(iter != _animations.end()) {
+    _memoryAccount.Subtract(iter->second.GetNumBytes());
+    _animations.erase(iter);
+    outOverwriting = true;
+  }
+
+  LazyAnimation& lazyAnim = _lazyAnimations[nameID];
+  if(lazyAnim.animClip != nullptr) {
+    outOverwriting = true;
+  }
+  if(lazyAnim.decoded != nullptr) {
+    _memoryAccount.Subtract(lazyAnim.decoded->GetNumBytes());
+  }
+  lazyAnim.file = file;
+  lazyAnim.animClip = animClip;
+  lazyAnim.seqContainer = seqContainer;
+  lazyAnim.decoded.reset();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t CannedAnimationContainer::ReleaseColdAnimations(const std::set<std::string>& animsInUse)
+{
+  std::set<Util::StringID> idsInUse;
+  for(const auto& name : animsInUse) {
+    idsInUse.insert(Util::StringID::Find(name));
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  size_t numReleased = 0;
+  for(auto& entry : _lazyAnimations) {
+    if((entry.second.decoded != nullptr) && (idsInUse.find(entry.first) == idsInUse.end())) {
+      _memoryAccount.Subtract(entry.second.decoded->GetNumBytes());
+      entry.second.decoded.reset();
+      ++numReleased;
+    }
+  }
+  return numReleased;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t CannedAnimationContainer::GetNumDecodedLazyAnimations() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  size_t numDecoded = 0;
+  for(const auto& entry : _lazyAnimations) {
+    if(entry.second.decoded != nullptr) {
+      ++numDecoded;
+    }
+  }
+  return numDecoded;
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 std::vector<std::string> CannedAnimationContainer::GetAnimationNames()
 {
+  std::lock_guard<std::mutex> lock(_mutex);
+
   std::vector<std::string> v;
-  v.reserve(_animations.size());
-  for (std::unordered_map<std::string, Animation>::iterator i=_animations.begin(); i != _animations.end(); ++i) {
-    v.push_back(i->first);
+  v.reserve(_animations.size() + _lazyAnimations.size());
+  for (const auto& entry : _animations) {
+    v.push_back(entry.first.ToString());
+  }
+  for (const auto& entry : _lazyAnimations) {
+    v.push_back(entry.first.ToString());
   }
   return v;
 }
@@ -16,13 +16,43 @@
 #define ANKI_COZMO_CANNED_ANIMATION_CONTAINER_H
 
 #include "cannedAnimLib/cannedAnims/animation.h"
+#include "util/helpers/noncopyable.h"
+#include "util/memoryAccounting/memoryAccounting.h"
+#include "util/stringTable/stringID.h"
+#include <memory>
+#include <mutex>
+#include <set>
 #include <unordered_map>
 #include <vector>
 
 namespace Anki {
 
+namespace Vision {
+class SpriteSequenceContainer;
+}
+
 namespace Vector {
 
+// Read-only mapping of an animation .bin file. Clips defined lazily from the file point into
+// the mapping, so it stays alive for as long as any of them is in a container
+class MappedAnimationFile : private Util::noncopyable
+{
+public:
+  // Returns nullptr if the file can't be mapped
+  static std::shared_ptr<MappedAnimationFile> Map(const std::string& path);
+
+  ~MappedAnimationFile();
+
+  const unsigned char* GetData() const { return _data; }
+  size_t GetSize() const { return _size; }
+
+private:
+  MappedAnimationFile(const unsigned char* data, size_t size) : _data(data), _size(size) { }
+
+  const unsigned char* _data = nullptr;
+  size_t _size = 0;
+};
+
 class CannedAnimationContainer
 {
 public:
@@ -30,17 +60,57 @@ public:
                           
   ~CannedAnimationContainer();
   
+  // Animations are keyed by their interned name. Callers that look the same animation up repeatedly can keep its
+  // StringID; the string versions look the name up in the string table first
   bool  HasAnimation(const std::string& name) const;
+  bool  HasAnimation(const Util::StringID& name) const;
   Animation* GetAnimation(const std::string& name);
   const Animation* GetAnimation(const std::string& name) const;
+  Animation* GetAnimation(const Util::StringID& name);
+  const Animation* GetAnimation(const Util::StringID& name) const;
   // If adding the new animation overwrites an existing animation, outOverwriting will be set to true
   void AddAnimation(Animation&& animation, bool& outOverwriting);
 
+  // Registers a clip which is only decoded into an Animation the first time it is requested. The clip lives in file,
+  // which is kept mapped until the animation is replaced or the container is destroyed
+  void AddLazyAnimation(const std::string& name,
+                        const std::shared_ptr<MappedAnimationFile>& file,
+                        const CozmoAnim::AnimClip* animClip,
+                        Vision::SpriteSequenceContainer* seqContainer,
+                        bool& outOverwriting);
+
+  // Frees the decoded tracks of lazily added animations, except those named in animsInUse. They are decoded again from
+  // the mapped file the next time they are requested, so any pointer to a released animation must not be used again.
+  // Returns the number of animations released
+  size_t ReleaseColdAnimations(const std::set<std::string>& animsInUse);
+
+  size_t GetNumDecodedLazyAnimations() const;
+
   std::vector<std::string> GetAnimationNames();
   
 private:
-  using AnimMap = std::unordered_map<std::string, Animation>;
-  std::unordered_map<std::string, Animation> _animations;
+  using AnimMap = std::unordered_map<Util::StringID, Animation>;
+  AnimMap _animations;
+
+  struct LazyAnimation {
+    std::shared_ptr<MappedAnimationFile> file;
+    const CozmoAnim::AnimClip*           animClip     = nullptr;
+    Vision::SpriteSequenceContainer*     seqContainer = nullptr;
+    std::unique_ptr<Animation>           decoded;
+  };
+
+  // Animations are decoded from const accessors too
+  mutable std::unordered_map<Util::StringID, LazyAnimation> _lazyAnimations;
+
+  // Animations are added by the loading threads while others are already being played
+  mutable std::mutex _mutex;
+
+  // Keyframes of the animations and decoded lazy animations, not counting the mapped files. _mutex must be held
+  mutable Util::MemoryAccount _memoryAccount{Util::MemoryTag::CannedAnimations};
+
+  // _mutex must be held
+  const Animation* FindAnimation(const Util::StringID& name) const;
+  const Animation* GetOrDecodeLazyAnimation(const Util::StringID& name) const;
   
 }; // class CannedAnimationContainer
   
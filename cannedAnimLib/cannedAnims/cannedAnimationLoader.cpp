@@ -21,11 +21,13 @@
 
 #include "coretech/common/engine/utils/data/dataPlatform.h"
 #include "coretech/common/engine/utils/timer.h"
+#include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/dispatchWorker/dispatchWorker.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/helpers/boundedWhile.h"
 #include "util/time/universalTime.h"
+#include <algorithm>
 #include <sys/stat.h>
 
 #define LOG_CHANNEL   "RobotDataLoader"
@@ -40,13 +42,18 @@ namespace{
 static constexpr float kAnimationsLoadingRatio = 0.7f;
 }
 
+// Whether clips in .bin files are only decoded into animations when they are first requested. The files
+// stay mapped instead, so boot doesn't pay for animations which never play
+CONSOLE_VAR(bool, kLoadBinaryAnimationsOnDemand, "Animations", true);
+
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void CannedAnimationLoader::LoadAnimationsIntoContainer(const AnimDirInfo& info, CannedAnimationContainer* container)
+void CannedAnimationLoader::LoadAnimationsIntoContainer(const AnimDirInfo& info, CannedAnimationContainer* container,
+                                                        const std::function<void()>& criticalAnimsLoadedCallback)
 {
   {
     ANKI_CPU_PROFILE("CannedAnimationLoader::LoadAnimations");
-    LoadAnimationsInternal(info, container);
+    LoadAnimationsInternal(info, container, criticalAnimsLoadedCallback);
     // The threaded animation loading workers each add to the loading ratio
   }
 
@@ -62,7 +69,7 @@ void CannedAnimationLoader::LoadAnimationIntoContainer(const std::string& path,
   info.jsonFiles.push_back(path);
   {
     ANKI_CPU_PROFILE("CannedAnimationLoader::LoadAnimationFile");
-    LoadAnimationsInternal(info, container);
+    LoadAnimationsInternal(info, container, nullptr);
   }
 
   // TODO: be able to load a face animation
@@ -94,6 +101,44 @@ CannedAnimationLoader::AnimDirInfo CannedAnimationLoader::CollectAnimFiles(const
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CannedAnimationLoader::PrioritizeAnimFiles(AnimDirInfo& info, const std::vector<std::string>& criticalAnimPrefixes)
+{
+  const size_t kNotCritical = criticalAnimPrefixes.size();
+  auto getPriority = [&criticalAnimPrefixes, kNotCritical](const std::string& path) {
+    const std::string fileName = Util::FileUtils::GetFileName(path, true, true);
+    for (size_t i = 0; i < criticalAnimPrefixes.size(); ++i) {
+      if (fileName.compare(0, criticalAnimPrefixes[i].size(), criticalAnimPrefixes[i]) == 0) {
+        return i;
+      }
+    }
+    return kNotCritical;
+  };
+
+  std::vector<std::pair<size_t, std::string>> files;
+  files.reserve(info.jsonFiles.size());
+  for (auto& path : info.jsonFiles) {
+    files.emplace_back(getPriority(path), std::move(path));
+  }
+  std::stable_sort(files.begin(), files.end(), [](const std::pair<size_t, std::string>& a,
+                                                  const std::pair<size_t, std::string>& b) {
+    return a.first < b.first;
+  });
+
+  info.jsonFiles.clear();
+  info.numCriticalFiles = 0;
+  for (auto& file : files) {
+    if (file.first != kNotCritical) {
+      ++info.numCriticalFiles;
+    }
+    info.jsonFiles.push_back(std::move(file.second));
+  }
+
+  LOG_INFO("CannedAnimationLoader.PrioritizeAnimFiles.Results", "%zu of %zu animation files are critical",
+           info.numCriticalFiles, info.jsonFiles.size());
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CannedAnimationLoader::WalkAnimationDir(const Util::Data::DataPlatform* platform,
                                              const std::string& animationDir, AnimDirInfo::TimestampMap& timestamps, 
@@ -143,7 +188,8 @@ void CannedAnimationLoader::AddToLoadingRatio(float delta)
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void CannedAnimationLoader::LoadAnimationsInternal(const AnimDirInfo& info, CannedAnimationContainer* container)
+void CannedAnimationLoader::LoadAnimationsInternal(const AnimDirInfo& info, CannedAnimationContainer* container,
+                                                   const std::function<void()>& criticalAnimsLoadedCallback)
 {
 #if ALLOW_DEBUG_LOGGING
   const double startTime = Util::Time::UniversalTime::GetCurrentTimeInMilliseconds();
@@ -153,14 +199,26 @@ void CannedAnimationLoader::LoadAnimationsInternal(const AnimDirInfo& info, Cann
   // To help find bad/deprecated animations, try removing this.
   ProceduralFace::EnableClippingWarning(false);
 
-  using MyDispatchWorker = Util::DispatchWorker<3, const std::string&, CannedAnimationContainer*>;
-  MyDispatchWorker::FunctionType loadFileFunc = std::bind(&CannedAnimationLoader::LoadAnimationFile, this, 
-                                                          std::placeholders::_1, std::placeholders::_2);
+  // The worker hands out files in order, so the critical ones at the front are loaded first
+  const size_t numCriticalFiles = std::min(info.numCriticalFiles, info.jsonFiles.size());
+  std::atomic<size_t> numCriticalFilesLeft(numCriticalFiles);
+  if ((numCriticalFiles == 0) && (criticalAnimsLoadedCallback != nullptr)) {
+    criticalAnimsLoadedCallback();
+  }
+
+  using MyDispatchWorker = Util::DispatchWorker<3, const std::string&, CannedAnimationContainer*, bool>;
+  MyDispatchWorker::FunctionType loadFileFunc = [this, &numCriticalFilesLeft, &criticalAnimsLoadedCallback]
+    (const std::string& path, CannedAnimationContainer* container, bool isCritical) {
+      LoadAnimationFile(path, container);
+      if (isCritical && (--numCriticalFilesLeft == 0) && (criticalAnimsLoadedCallback != nullptr)) {
+        criticalAnimsLoadedCallback();
+      }
+    };
   MyDispatchWorker myWorker(loadFileFunc);
 
   unsigned long size = info.jsonFiles.size();
   for (int i = 0; i < size; i++) {
-    myWorker.PushJob(info.jsonFiles[i], container);
+    myWorker.PushJob(info.jsonFiles[i], container, static_cast<size_t>(i) < numCriticalFiles);
     //LOG_DEBUG("CannedAnimationLoader.LoadAnimations", "loaded regular anim %d of %zu", i, size);
   }
 
@@ -203,13 +261,13 @@ void CannedAnimationLoader::LoadAnimationFile(const std::string& path, CannedAni
 
   if (binFile) {
 
-    // Read the binary file
-    auto binFileContents = Util::FileUtils::ReadFileAsBinary(path);
-    if (binFileContents.size() == 0) {
+    // Map the binary file. Clips defined on demand keep pointing into it
+    auto mappedFile = MappedAnimationFile::Map(path);
+    if (nullptr == mappedFile) {
       LOG_ERROR("CannedAnimationLoader.LoadAnimationFile.BinaryDataEmpty", "Found no data in %s", path.c_str());
       return;
     }
-    unsigned char *binData = binFileContents.data();
+    const unsigned char *binData = mappedFile->GetData();
     if (nullptr == binData) {
       LOG_ERROR("CannedAnimationLoader.LoadAnimationFile.BinaryDataNull", "Found no data in %s", path.c_str());
       return;
@@ -239,7 +297,17 @@ void CannedAnimationLoader::LoadAnimationFile(const std::string& path, CannedAni
       // TODO: Should this mutex lock happen here or immediately before this for loop (COZMO-8766)?
       std::lock_guard<std::mutex> guard(_parallelLoadingMutex);
 
-      DefineFromFlatBuf(animClip, strName, container);
+      if (kLoadBinaryAnimationsOnDemand) {
+        bool outOverwriting = false;
+        container->AddLazyAnimation(strName, mappedFile, animClip, _spriteSequenceContainer, outOverwriting);
+        if (outOverwriting) {
+          PRINT_NAMED_WARNING("CannedAnimationLoader.LoadAnimationFile.OverwritingExistingAnimation",
+                              "Container already had an animation named %s, overwriting",
+                              strName.c_str());
+        }
+      } else {
+        DefineFromFlatBuf(animClip, strName, container);
+      }
     }
 
   } else {
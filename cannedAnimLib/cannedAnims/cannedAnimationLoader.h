@@ -19,6 +19,7 @@
 #include "cannedAnimLib/cannedAnims/cannedAnimationContainer.h"
 #include "util/helpers/noncopyable.h"
 #include <atomic>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -50,6 +51,8 @@ public:
 
     TimestampMap animFileTimestamps;
     std::vector<std::string> jsonFiles;
+    // The first numCriticalFiles of jsonFiles are needed before anything else (see PrioritizeAnimFiles)
+    size_t numCriticalFiles = 0;
   };
 
   CannedAnimationLoader(const Util::Data::DataPlatform* platform,
@@ -61,11 +64,18 @@ public:
   , _loadingCompleteRatio(loadingCompleteRatio)
   , _abortLoad(abortLoad){}
 
-  void LoadAnimationsIntoContainer(const AnimDirInfo& info, CannedAnimationContainer* container);
+  // Animations are added to container as soon as each file is loaded. If given, criticalAnimsLoadedCallback is called
+  // (from a loading thread) once the critical files are loaded, while the rest are still loading
+  void LoadAnimationsIntoContainer(const AnimDirInfo& info, CannedAnimationContainer* container,
+                                   const std::function<void()>& criticalAnimsLoadedCallback = nullptr);
   void LoadAnimationIntoContainer(const std::string& path, CannedAnimationContainer* container);
 
   AnimDirInfo CollectAnimFiles(const std::vector<std::string>& paths);
 
+  // Moves the files whose names start with any of criticalAnimPrefixes to the front of info, ordered like the
+  // prefixes, so that they are loaded first
+  static void PrioritizeAnimFiles(AnimDirInfo& info, const std::vector<std::string>& criticalAnimPrefixes);
+
 private:
   
   // params passed in by data loader class
@@ -82,7 +92,8 @@ private:
                                const std::string& animationDir, AnimDirInfo::TimestampMap& timestamps,
                                const std::function<void(const std::string& filePath)>& walkFunc);
 
-  void LoadAnimationsInternal(const AnimDirInfo& info, CannedAnimationContainer* container);
+  void LoadAnimationsInternal(const AnimDirInfo& info, CannedAnimationContainer* container,
+                              const std::function<void()>& criticalAnimsLoadedCallback);
   
   void AddToLoadingRatio(float delta);
 
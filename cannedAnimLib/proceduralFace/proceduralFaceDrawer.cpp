@@ -13,6 +13,13 @@
 #include "util/math/math.h"
 #include "util/math/numericCast.h"
 #include "util/random/randomGenerator.h"
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+#include <algorithm>
+#include <iterator>
 #include <mutex>
 
 // switch std::round() to macro for easier change
@@ -59,6 +66,18 @@ namespace Vector {
   CONSOLE_VAR_ENUM(u8, kProcFace_CustomEyeOverlay, CONSOLE_GROUP, 0, "Trans,Lesbian,Gay,Bi,Pan,Frog,All,Galaxy,Custom");
   CONSOLE_FUNC(LoadFaceOverlay, CONSOLE_GROUP);
 
+  // Eye render cache. Like the face cache, it is not cleared when the rendering console vars change
+  CONSOLE_VAR_RANGED(s32, kProcFace_EyeRenderCacheSize,           CONSOLE_GROUP, 16, 0, 64); // 0 disables it
+  CONSOLE_VAR_RANGED(f32, kProcFace_EyeRenderCacheStep,           CONSOLE_GROUP, 0.01f, 0.0001f, 1.f); // parameter quantization
+
+  static void PrintEyeRenderCacheHitRate(ConsoleFunctionContextRef context)
+  {
+    PRINT_NAMED_INFO("ProceduralFaceDrawer.EyeRenderCache.HitRate", "%.1f%%",
+                     100.f * ProceduralFaceDrawer::GetEyeRenderCacheHitRate());
+    ProceduralFaceDrawer::ResetEyeRenderCacheStats();
+  }
+  CONSOLE_FUNC(PrintEyeRenderCacheHitRate, CONSOLE_GROUP);
+
 #if PROCEDURALFACE_GLOW_FEATURE
   CONSOLE_VAR_RANGED(f32, kProcFace_GlowSizeMultiplier,           CONSOLE_GROUP, 1.f, 0.f, 1.f);
   CONSOLE_VAR_RANGED(f32, kProcFace_GlowLightnessMultiplier,      CONSOLE_GROUP, 1.f, 0.f, 10.f);
@@ -92,6 +111,9 @@ namespace Vector {
   Vision::Image ProceduralFaceDrawer::_eyeShape; // temporary working surface, I8
 
   struct ProceduralFaceDrawer::FaceCache ProceduralFaceDrawer::_faceCache;
+  std::list<ProceduralFaceDrawer::EyeRender> ProceduralFaceDrawer::_eyeRenderCache;
+  u32 ProceduralFaceDrawer::_eyeRenderCacheHits = 0;
+  u32 ProceduralFaceDrawer::_eyeRenderCacheLookups = 0;
 
   Rectangle<f32> ProceduralFaceDrawer::_leftBBox;
   Rectangle<f32> ProceduralFaceDrawer::_rightBBox;
@@ -166,6 +188,18 @@ namespace Vector {
 #   undef NUM_FAST_EXP_TERMS
   }
 
+#ifdef __ARM_NEON__
+  // Four lanes of fastExp() above, for the 2 term expansion
+  inline static float32x4_t fastExp_neon(float32x4_t x)
+  {
+    float32x4_t y = vmlaq_n_f32(vdupq_n_f32(1.f), x, 0.25f);
+    y = vmulq_f32(y, y);
+    y = vmulq_f32(y, y);
+    const uint32x4_t isStable = vcgeq_f32(x, vdupq_n_f32(-4.f));
+    return vbslq_f32(isStable, y, vdupq_n_f32(0.f));
+  }
+#endif
+
 #if PROCEDURALFACE_NOISE_FEATURE
   inline Array2d<u8> CreateNoiseImage(const Util::RandomGenerator& rng)
   {
@@ -601,20 +635,45 @@ namespace Vector {
         for(s32 i=upperLeft.y(); i<=bottomRight.y(); ++i) {
 
           u8* eyeShape_i = _eyeShape.GetRow(i);
-          for(s32 j=upperLeft.x(); j<=bottomRight.x(); ++j) {
+          const f32 dy = (f32)i-hotSpotCenter.y();
+
+          // Along a row, [dx dy] * Sigma^(-1) * [dx dy]^T is the quadratic a*dx^2 + b*dx + c
+          const f32 a = sigmaInv(0,0);
+          const f32 b = dy*(sigmaInv(1,0) + sigmaInv(0,1));
+          const f32 c = dy*dy*sigmaInv(1,1);
+
+          s32 j=upperLeft.x();
+#ifdef __ARM_NEON__
+          // Pixels outside the eye are 0 and stay 0, so every pixel can be scaled by the falloff
+          const s32 kNumElementsProcessed = 8;
+          const float32x4_t kLaneOffsets = {0.f, 1.f, 2.f, 3.f};
+          for(; j <= (s32)bottomRight.x()-(kNumElementsProcessed-1); j += kNumElementsProcessed)
+          {
+            const uint16x8_t eye = vmovl_u8(vld1_u8(eyeShape_i + j));
+            float32x4_t eyeLow  = vcvtq_f32_u32(vmovl_u16(vget_low_u16(eye)));
+            float32x4_t eyeHigh = vcvtq_f32_u32(vmovl_u16(vget_high_u16(eye)));
+
+            const float32x4_t dxLow  = vaddq_f32(vdupq_n_f32((f32)j-hotSpotCenter.x()), kLaneOffsets);
+            const float32x4_t dxHigh = vaddq_f32(dxLow, vdupq_n_f32(4.f));
+            // -0.5 * (a*dx^2 + b*dx + c)
+            const float32x4_t xLow  = vmulq_n_f32(vmlaq_f32(vdupq_n_f32(c), dxLow,  vmlaq_n_f32(vdupq_n_f32(b), dxLow,  a)), -0.5f);
+            const float32x4_t xHigh = vmulq_n_f32(vmlaq_f32(vdupq_n_f32(c), dxHigh, vmlaq_n_f32(vdupq_n_f32(b), dxHigh, a)), -0.5f);
+
+            // Round (values are positive) and narrow back to u8
+            eyeLow  = vmlaq_f32(vdupq_n_f32(0.5f), eyeLow,  fastExp_neon(xLow));
+            eyeHigh = vmlaq_f32(vdupq_n_f32(0.5f), eyeHigh, fastExp_neon(xHigh));
+            const uint16x8_t result = vcombine_u16(vmovn_u32(vcvtq_u32_f32(eyeLow)), vmovn_u32(vcvtq_u32_f32(eyeHigh)));
+            vst1_u8(eyeShape_i + j, vmovn_u16(result));
+          }
+#endif
+          for(; j<=bottomRight.x(); ++j) {
 
             u8& eyeValue  = eyeShape_i[j];
             const bool insideEye = (eyeValue > 0);
             if(insideEye) {
               // TODO: Use a separate approximation helper or LUT to get falloff
               const f32 dx = (f32)j-hotSpotCenter.x();
-              const f32 dy = (f32)i-hotSpotCenter.y();
-              
-              // Hardcode simple 1x2 x 2x2 x 2x1 matrix multiplication here:
-              //   [dx dy] * Sigma^(-1) * [dx]
-              //                          [dy]
-              const f32 x = ((dx*sigmaInv(0,0) + dy*sigmaInv(1,0))*dx +
-                             (dx*sigmaInv(0,1) + dy*sigmaInv(1,1))*dy);
+              const f32 x = (a*dx + b)*dx + c;
               
               const f32 falloff = fastExp(-0.5f*x);
               DEV_ASSERT_MSG(Util::InRange(falloff, 0.f, 1.f), "ProceduralFaceDrawer.DrawEye.BadInnerGlowFalloffValue", "%f", falloff);
@@ -680,28 +739,54 @@ namespace Vector {
 
         DEV_ASSERT_MSG(upperLeft.y()>=0 && bottomRight.y()<faceImg.GetNumRows(), "ProceduralFaceDrawer.DrawEye.BadRow", "%f %f", upperLeft.y(), bottomRight.y());
         DEV_ASSERT_MSG(upperLeft.x()>=0 && bottomRight.x()<faceImg.GetNumCols(), "ProceduralFaceDrawer.DrawEye.BadCol", "%f %f", upperLeft.x(), bottomRight.x());
+#if !PROCEDURALFACE_GLOW_FEATURE
+        // Without glow every pixel is the eye value times the same gain, in fixed point (Q7, so gains up
+        // to 2 fit in the u16 products). The scalar tail matches the NEON rounding exactly
+        const f32 gain = Util::Clamp(kProcFace_EyeLightnessMultiplier * eyeLightness, 0.f, 2.f);
+        const u16 gain_q7 = static_cast<u16>(ROUND(gain * 128.f));
         for(s32 i=upperLeft.y(); i<=bottomRight.y(); ++i) {
 
           u8* faceImg_i = faceImg.GetRow(i);
           const u8* eyeShape_i = _eyeShape.GetRow(i);
-#if PROCEDURALFACE_GLOW_FEATURE
-          const u8* glowImg_i  = _glowImg.GetRow(i);
+
+          s32 j=upperLeft.x();
+#ifdef __ARM_NEON__
+          const s32 kNumElementsProcessed = 16;
+          const uint16x8_t kGain = vdupq_n_u16(gain_q7);
+          for(; j <= (s32)bottomRight.x()-(kNumElementsProcessed-1); j += kNumElementsProcessed)
+          {
+            const uint8x16_t eye = vld1q_u8(eyeShape_i + j);
+            const uint16x8_t valueLow  = vmulq_u16(vmovl_u8(vget_low_u8(eye)),  kGain);
+            const uint16x8_t valueHigh = vmulq_u16(vmovl_u8(vget_high_u8(eye)), kGain);
+            // Saturating, rounding narrowing right shift by 7 (divide by 128)
+            const uint8x16_t value = vcombine_u8(vqrshrn_n_u16(valueLow, 7), vqrshrn_n_u16(valueHigh, 7));
+
+            // Note: If we're drawing the right eye, there may already be something in the image
+            //       from when we drew the left eye, so use max
+            vst1q_u8(faceImg_i + j, vmaxq_u8(vld1q_u8(faceImg_i + j), value));
+          }
 #endif
+          for(; j<=bottomRight.x(); ++j) {
+            const s32 value = (static_cast<s32>(eyeShape_i[j]) * gain_q7 + 64) >> 7;
+            faceImg_i[j] = std::max(faceImg_i[j], static_cast<u8>(std::min(value, 255)));
+          }
+        }
+#else
+        for(s32 i=upperLeft.y(); i<=bottomRight.y(); ++i) {
+
+          u8* faceImg_i = faceImg.GetRow(i);
+          const u8* eyeShape_i = _eyeShape.GetRow(i);
+          const u8* glowImg_i  = _glowImg.GetRow(i);
 
           for(s32 j=upperLeft.x(); j<=bottomRight.x(); ++j) {
 
             const u8 eyeValue = eyeShape_i[j];
-#if PROCEDURALFACE_GLOW_FEATURE
             const u8 glowValue = glowImg_i[j];
             const bool somethingToDraw = (eyeValue > 0 || glowValue > 0);
-#else
-            const bool somethingToDraw = (eyeValue > 0);
-#endif
 
             if(somethingToDraw) {
               f32 newValue = static_cast<f32>(eyeValue);
 
-#if PROCEDURALFACE_GLOW_FEATURE
               // Combine everything together: inner glow falloff, and the glow value.
               // Note that the value in glowImg/eyeShape is already [0,255]
               newValue = std::max(newValue,eyeValue);
@@ -712,9 +797,6 @@ namespace Vector {
               } else {
                 newValue *= glowLightness;
               }
-#else
-              newValue *= kProcFace_EyeLightnessMultiplier;
-#endif
 
               newValue *= eyeLightness;
 
@@ -725,6 +807,7 @@ namespace Vector {
             }
           }
         }
+#endif
       }
     }
 
@@ -736,6 +819,37 @@ namespace Vector {
       
   } // DrawEye()
 
+  f32 ProceduralFaceDrawer::GetEyeRenderCacheHitRate()
+  {
+    return (_eyeRenderCacheLookups > 0) ? static_cast<f32>(_eyeRenderCacheHits) / _eyeRenderCacheLookups : 0.f;
+  }
+
+  void ProceduralFaceDrawer::ResetEyeRenderCacheStats()
+  {
+    _eyeRenderCacheHits = _eyeRenderCacheLookups = 0;
+  }
+
+  ProceduralFaceDrawer::EyeRenderKey ProceduralFaceDrawer::GetEyeRenderKey(const ProceduralFace& faceData, f32 step)
+  {
+    EyeRenderKey key;
+    auto keyIt = key.begin();
+    const auto quantize = [step](Value value) {
+      return Util::numeric_cast_clamped<s32>(std::round(value / step));
+    };
+    for(const auto whichEye : {WhichEye::Left, WhichEye::Right}) {
+      for(const auto value : faceData.GetParameters(whichEye)) {
+        *keyIt++ = quantize(value);
+      }
+    }
+    *keyIt++ = quantize(faceData.GetFaceAngle());
+    *keyIt++ = quantize(faceData.GetFacePosition().x());
+    *keyIt++ = quantize(faceData.GetFacePosition().y());
+    *keyIt++ = quantize(faceData.GetFaceScale().x());
+    *keyIt++ = quantize(faceData.GetFaceScale().y());
+    DEV_ASSERT(keyIt == key.end(), "ProceduralFaceDrawer.GetEyeRenderKey.WrongKeySize");
+    return key;
+  }
+
   void ProceduralFaceDrawer::DrawFace(const ProceduralFace& faceData,
                                       const Util::RandomGenerator& rng,
                                       Vision::ImageRGB565& output)
@@ -783,6 +897,30 @@ namespace Vector {
       _faceCache.finalFace = _faceCache.eyes = 0;
       DEV_ASSERT(_faceCache.finalFace < _faceCache.kSize, "ProceduralFaceDrawer.DistortScanlines.FaceCacheTooSmall");
       _faceCache.img8[_faceCache.eyes].Allocate(ProceduralFace::HEIGHT, ProceduralFace::WIDTH); // Will do nothing if already the right size
+
+      // Copy the eyes if a face close enough to this one was drawn recently
+      const size_t maxEyeRenders = static_cast<size_t>(kProcFace_EyeRenderCacheSize);
+      EyeRenderKey eyeRenderKey;
+      if(maxEyeRenders > 0) {
+        eyeRenderKey = GetEyeRenderKey(faceData, kProcFace_EyeRenderCacheStep);
+        ++_eyeRenderCacheLookups;
+        const auto renderIt = std::find_if(_eyeRenderCache.begin(), _eyeRenderCache.end(),
+                                           [&eyeRenderKey](const EyeRender& render) { return render.key == eyeRenderKey; });
+        if(renderIt != _eyeRenderCache.end()) {
+          ++_eyeRenderCacheHits;
+          _eyeRenderCache.splice(_eyeRenderCache.begin(), _eyeRenderCache, renderIt);
+          const EyeRender& render = _eyeRenderCache.front();
+          render.img8.CopyTo(_faceCache.img8[_faceCache.eyes]);
+          _leftBBox = render.leftBBox;
+          _rightBBox = render.rightBBox;
+          _faceColMin = render.faceColMin;
+          _faceColMax = render.faceColMax;
+          _faceRowMin = render.faceRowMin;
+          _faceRowMax = render.faceRowMax;
+          return dirty;
+        }
+      }
+
       _faceCache.img8[_faceCache.eyes].FillWith(0);
 
       // Create a full-face warp matrix if needed and provide it to the eye-rendering call
@@ -829,6 +967,27 @@ namespace Vector {
       _faceRowMax = Util::Clamp(_faceRowMax, 0, ProceduralFace::HEIGHT-1);
 
       _faceCache.finalFace = _faceCache.eyes;
+
+      if(maxEyeRenders > 0) {
+        // Keep this render, reusing the least recently used one when full
+        while(_eyeRenderCache.size() > maxEyeRenders) {
+          _eyeRenderCache.pop_back();
+        }
+        if(_eyeRenderCache.size() == maxEyeRenders) {
+          _eyeRenderCache.splice(_eyeRenderCache.begin(), _eyeRenderCache, std::prev(_eyeRenderCache.end()));
+        } else {
+          _eyeRenderCache.emplace_front();
+        }
+        EyeRender& render = _eyeRenderCache.front();
+        render.key = eyeRenderKey;
+        _faceCache.img8[_faceCache.eyes].CopyTo(render.img8);
+        render.leftBBox = _leftBBox;
+        render.rightBBox = _rightBBox;
+        render.faceColMin = _faceColMin;
+        render.faceColMax = _faceColMax;
+        render.faceRowMin = _faceRowMin;
+        render.faceRowMax = _faceRowMax;
+      }
     }
     
     return dirty;
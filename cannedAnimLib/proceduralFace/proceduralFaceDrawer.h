@@ -7,6 +7,9 @@
 #include "cannedAnimLib/proceduralFace/proceduralFaceModifierTypes.h"
 #include "coretech/vision/engine/image.h"
 
+#include <array>
+#include <list>
+
 namespace Anki {
   
   // Forward declaration:
@@ -79,6 +82,10 @@ namespace Vector {
     // needs to be accessed by console vars
     static void LoadCustomEyePNG();
 
+    // Fraction of the eye renders since the last reset that were copied from the eye render cache
+    static f32 GetEyeRenderCacheHitRate();
+    static void ResetEyeRenderCacheStats();
+
   private:
 
     using Parameter = ProceduralEyeParameter;
@@ -115,6 +122,23 @@ namespace Vector {
       int finalFace;
     } _faceCache;
 
+    // Eye renders for the faces drawn most recently, most recent first. Faces rendered within the
+    // quantization step of each other share an entry, so repeated faces (blinks, keep alive, holds)
+    // are copied instead of drawn again
+    using EyeRenderKey = std::array<s32, 2 * static_cast<size_t>(Parameter::NumParameters) + 5>;
+    struct EyeRender {
+      EyeRenderKey key;
+      Vision::Image img8;
+      Rectangle<f32> leftBBox;
+      Rectangle<f32> rightBBox;
+      s32 faceColMin, faceColMax, faceRowMin, faceRowMax;
+    };
+    static std::list<EyeRender> _eyeRenderCache;
+    static u32 _eyeRenderCacheHits;
+    static u32 _eyeRenderCacheLookups;
+
+    static EyeRenderKey GetEyeRenderKey(const ProceduralFace& faceData, f32 step);
+
     // Bounding boxes, left eye, right eye, combined left/right eyes
     static Rectangle<f32> _leftBBox;
     static Rectangle<f32> _rightBBox;
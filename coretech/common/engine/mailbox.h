@@ -6,8 +6,9 @@
  *
  * Description: "Mailboxes" are used for leaving messages from one thread to another.
  *
- *   There is no use of STL, so these are potentially suitable for use in an
- *   embedded environment, so long as templates are allowed.
+ *   Both kinds are lock-free and meant for exactly one thread putting messages
+ *   and one (possibly different) thread getting them. Messages are moved in and
+ *   moved out, never copied, and neither side ever waits on the other.
  *
  *   Templated implementations are in mailbox_impl.h
  *
@@ -17,12 +18,16 @@
 #ifndef ANKI_CORETECH_COMMON_MAILBOX_H
 #define ANKI_CORETECH_COMMON_MAILBOX_H
 
+#include "coretech/common/shared/types.h"
 
-#include <mutex>
+#include <atomic>
 
 namespace Anki {
   
   // Single-message Mailbox Class
+  //  Latest value wins: putting a message replaces one that hasn't been read yet.
+  //  Implemented as a triple buffer, so the writer always has a buffer of its own
+  //  to fill while the reader holds on to the last one it got.
   template<typename MsgType>
   class Mailbox
   {
@@ -30,17 +35,32 @@ namespace Anki {
     
     Mailbox();
     
-    bool putMessage(const MsgType& newMsg);
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+    
+    // Always succeeds
     bool putMessage(MsgType&& newMsg);
+    
+    // Returns false if nothing new has been put since the last get
     bool getMessage(MsgType& msgOut);
     
   protected:
-    MsgType message_;
-    bool    beenRead_;
-    std::mutex mutex_;
+    static constexpr u8 kIndexMask = 0x03;
+    static constexpr u8 kNewBit    = 0x04;
+    
+    MsgType buffers_[3];
+    
+    // Index of the buffer between writer and reader, with kNewBit set if the writer
+    // swapped it in since the reader last took it
+    std::atomic<u8> sharedIndex_;
+    
+    u8 writeIndex_; // only touched by the writer
+    u8 readIndex_;  // only touched by the reader
   };
   
   // Multiple-message Mailbox Class
+  //  First in, first out ring of up to NUM_BOXES messages. Putting a message when
+  //  all NUM_BOXES are unread fails and leaves the message untouched.
   template<typename MSG_TYPE, u8 NUM_BOXES>
   class MultiMailbox
   {
@@ -48,16 +68,22 @@ namespace Anki {
     
     MultiMailbox();
     
-    bool putMessage(const MSG_TYPE& newMsg);
+    MultiMailbox(const MultiMailbox&) = delete;
+    MultiMailbox& operator=(const MultiMailbox&) = delete;
+    
     bool putMessage(MSG_TYPE&& newMsg);
     bool getMessage(MSG_TYPE& msg);
     
   protected:
-    Mailbox<MSG_TYPE> mailboxes_[NUM_BOXES];
-    u8 readIndex_, writeIndex_;
-    std::mutex mutex_;
+    static_assert(NUM_BOXES > 0, "MultiMailbox needs at least one box");
+    
+    // One slot is always left empty so that full and empty can be told apart
+    static constexpr size_t kNumSlots = NUM_BOXES + 1;
+    
+    MSG_TYPE slots_[kNumSlots];
+    std::atomic<size_t> readIndex_, writeIndex_;
     
-    void advanceIndex(u8 &index);
+    static size_t nextIndex(size_t index);
   };
   
 } // namespace Anki
@@ -10,48 +10,58 @@
  * Copyright: Anki, Inc. 2014
  **/
 
+#ifndef ANKI_CORETECH_COMMON_MAILBOX_IMPL_H
+#define ANKI_CORETECH_COMMON_MAILBOX_IMPL_H
+
 #include "mailbox.h"
 
+#include <utility>
+
 namespace Anki {
   
   //
   // Templated Mailbox Implementations
   //
+  template<typename MSG_TYPE>
+  constexpr u8 Mailbox<MSG_TYPE>::kIndexMask;
+  
+  template<typename MSG_TYPE>
+  constexpr u8 Mailbox<MSG_TYPE>::kNewBit;
+  
   template<typename MSG_TYPE>
   Mailbox<MSG_TYPE>::Mailbox()
-  : beenRead_(true)
+  : sharedIndex_(1)
+  , writeIndex_(0)
+  , readIndex_(2)
   {
     
   }
 
-  template<typename MSG_TYPE>
-  bool Mailbox<MSG_TYPE>::putMessage(const MSG_TYPE& newMsg)
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-    message_  = newMsg;
-    beenRead_ = false;
-    return true;
-  }
-  
   template<typename MSG_TYPE>
   bool Mailbox<MSG_TYPE>::putMessage(MSG_TYPE&& newMsg)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    message_  = newMsg;
-    beenRead_ = false;
+    buffers_[writeIndex_] = std::move(newMsg);
+    
+    // Publish the filled buffer and take back whichever one was shared. If the reader never
+    // took the previous message, it is simply overwritten next time.
+    const u8 prevShared = sharedIndex_.exchange(writeIndex_ | kNewBit, std::memory_order_acq_rel);
+    writeIndex_ = (prevShared & kIndexMask);
     return true;
   }
 
   template<typename MSG_TYPE>
   bool Mailbox<MSG_TYPE>::getMessage(MSG_TYPE& msgOut)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if(!beenRead_) {
-      msgOut = message_;
-      beenRead_ = true;
-      return true;
+    if(0 == (sharedIndex_.load(std::memory_order_acquire) & kNewBit)) {
+      return false;
     }
-    return false;
+    
+    // Only the reader clears kNewBit, so the shared buffer is new no matter how many more
+    // messages the writer puts before this exchange
+    const u8 prevShared = sharedIndex_.exchange(readIndex_, std::memory_order_acq_rel);
+    readIndex_ = (prevShared & kIndexMask);
+    msgOut = std::move(buffers_[readIndex_]);
+    return true;
   }
 
 
@@ -59,6 +69,9 @@ namespace Anki {
   // Templated MultiMailbox Implementations
   //
 
+  template<typename MSG_TYPE, u8 NUM_BOXES>
+  constexpr size_t MultiMailbox<MSG_TYPE, NUM_BOXES>::kNumSlots;
+  
   template<typename MSG_TYPE, u8 NUM_BOXES>
   MultiMailbox<MSG_TYPE, NUM_BOXES>::MultiMailbox()
   : readIndex_(0)
@@ -67,53 +80,45 @@ namespace Anki {
     
   }
   
-  template<typename MSG_TYPE, u8 NUM_BOXES>
-  bool MultiMailbox<MSG_TYPE,NUM_BOXES>::putMessage(const MSG_TYPE& newMsg)
-  {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if(mailboxes_[writeIndex_].putMessage(newMsg) == true) {
-      advanceIndex(writeIndex_);
-      return true;
-    }
-    return false;
-  }
-  
-  
   template<typename MSG_TYPE, u8 NUM_BOXES>
   bool MultiMailbox<MSG_TYPE,NUM_BOXES>::putMessage(MSG_TYPE&& newMsg)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if(mailboxes_[writeIndex_].putMessage(newMsg) == true) {
-      advanceIndex(writeIndex_);
-      return true;
+    const size_t writeIndex = writeIndex_.load(std::memory_order_relaxed);
+    const size_t nextWriteIndex = nextIndex(writeIndex);
+    if(nextWriteIndex == readIndex_.load(std::memory_order_acquire)) {
+      // full
+      return false;
     }
-    return false;
+    
+    slots_[writeIndex] = std::move(newMsg);
+    writeIndex_.store(nextWriteIndex, std::memory_order_release);
+    return true;
   }
 
   template<typename MSG_TYPE, u8 NUM_BOXES>
   bool MultiMailbox<MSG_TYPE,NUM_BOXES>::getMessage(MSG_TYPE& msg)
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-
-    if(mailboxes_[readIndex_].getMessage(msg) == true) {
-      // we got a message out of the mailbox (it wasn't locked and there
-      // was something in it), so move to the next mailbox
-      advanceIndex(readIndex_);
-      return true;
+    const size_t readIndex = readIndex_.load(std::memory_order_relaxed);
+    if(readIndex == writeIndex_.load(std::memory_order_acquire)) {
+      // empty
+      return false;
     }
-    return false;
+    
+    msg = std::move(slots_[readIndex]);
+    readIndex_.store(nextIndex(readIndex), std::memory_order_release);
+    return true;
   }
 
   template<typename MSG_TYPE, u8 NUM_BOXES>
-  void MultiMailbox<MSG_TYPE,NUM_BOXES>::advanceIndex(u8 &index)
+  size_t MultiMailbox<MSG_TYPE,NUM_BOXES>::nextIndex(size_t index)
   {
     ++index;
-    if(index == NUM_BOXES) {
+    if(index == kNumSlots) {
       index = 0;
     }
+    return index;
   }
 
 } // namespace Anki
 
+#endif // ANKI_CORETECH_COMMON_MAILBOX_IMPL_H
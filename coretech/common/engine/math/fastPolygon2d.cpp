@@ -18,8 +18,26 @@
 #include <cmath>
 #include <cfloat>
 
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
 namespace Anki {
 
+// ContainsMany loads points as interleaved x,y floats
+static_assert(sizeof(Point2f) == 2 * sizeof(float), "Point2f must be two packed floats");
+
+#ifdef __ARM_NEON__
+namespace {
+  // true if any lane of the mask is set
+  inline bool AnyLaneSet(uint32x4_t mask)
+  {
+    const uint32x2_t pairs = vorr_u32(vget_low_u32(mask), vget_high_u32(mask));
+    return (0 != (vget_lane_u32(pairs, 0) | vget_lane_u32(pairs, 1)));
+  }
+}
+#endif
+
 int FastPolygon::_numChecks = 0;
 int FastPolygon::_numDotProducts = 0;
 
@@ -38,6 +56,7 @@ FastPolygon::FastPolygon(const Poly2f& basePolygon)
   , _circleCenter( ComputeCentroid() )
 {
   CreateEdgeVectors();
+  CacheEdgeArrays();
   ComputeCircles();
 }
 
@@ -140,17 +159,120 @@ bool FastPolygon::InHalfPlane(const Halfplane2f& H) const
 }
 
 // calculates if the polygon intersects the node
-bool FastPolygon::Intersects(const AxisAlignedQuad& quad) const
+bool FastPolygon::IntersectsQuad(const AxisAlignedQuad& quad) const
 {
+  const Point2f& quadMin = quad.GetMinVertex();
+  const Point2f& quadMax = quad.GetMaxVertex();
+
   // check if any of the bounding box edges create a separating axis
-  if (FLT_LT( GetMaxX(), quad.GetMinVertex().x() )) { return false; }
-  if (FLT_LT( GetMaxY(), quad.GetMinVertex().y() )) { return false; }
-  if (FLT_GT( GetMinX(), quad.GetMaxVertex().x() )) { return false; }
-  if (FLT_GT( GetMinY(), quad.GetMaxVertex().y() )) { return false; }
+  if (FLT_LT( GetMaxX(), quadMin.x() )) { return false; }
+  if (FLT_LT( GetMaxY(), quadMin.y() )) { return false; }
+  if (FLT_GT( GetMinX(), quadMax.x() )) { return false; }
+  if (FLT_GT( GetMinY(), quadMax.y() )) { return false; }
 
   // fastPolygon line segments define the halfplane boundary of points inside the polygon, 
-  // so check negative halfplane instead
-  return std::none_of(_edgeSegments.begin(), _edgeSegments.end(), [&](const LineSegment& l) { return quad.InNegativeHalfPlane(l); });
+  // so check negative halfplane instead. The line equation is linear, so the whole quad is in an edge's negative
+  // halfplane exactly when the corner with the largest value is, which saves evaluating the other three.
+  for( const auto& l : _edgeSegments ) {
+    const Point2f& from = l.GetFrom();
+    const float dX = l.GetTo().x() - from.x();
+    const float dY = l.GetTo().y() - from.y();
+    const float cornerX = (dY >= 0.f) ? quadMax.x() : quadMin.x();
+    const float cornerY = (dX <= 0.f) ? quadMax.y() : quadMin.y();
+    if( FLT_LT( dY * (cornerX - from.x()) - dX * (cornerY - from.y()), 0.f ) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool FastPolygon::ContainsQuad(const AxisAlignedQuad& quad) const
+{
+  const Point2f& quadMin = quad.GetMinVertex();
+  const Point2f& quadMax = quad.GetMaxVertex();
+  return Contains(quadMin.x(), quadMin.y()) && Contains(quadMax.x(), quadMin.y()) &&
+         Contains(quadMin.x(), quadMax.y()) && Contains(quadMax.x(), quadMax.y());
+}
+
+size_t FastPolygon::IntersectsMany(const std::vector<AxisAlignedQuad>& quads, std::vector<bool>& intersects) const
+{
+  intersects.resize(quads.size());
+  size_t numIntersecting = 0;
+  for( size_t i = 0; i < quads.size(); ++i ) {
+    const bool result = IntersectsQuad(quads[i]);
+    intersects[i] = result;
+    numIntersecting += (result ? 1 : 0);
+  }
+  return numIntersecting;
+}
+
+size_t FastPolygon::ContainsMany(const std::vector<Point2f>& points, std::vector<bool>& contained,
+                                 const Point2f& offset) const
+{
+  const size_t numPoints = points.size();
+  contained.resize(numPoints);
+  size_t numContained = 0;
+  size_t i = 0;
+
+#if !USE_LINESEGMENT_CHECKS && defined(__ARM_NEON__)
+  // Same tests as Contains(x,y), on four points at a time. The edges are only checked if one of the points is
+  // between the circles.
+  const size_t numEdges = _edgeArrays.normalX.size();
+  const float32x4_t offsetX = vdupq_n_f32(offset.x());
+  const float32x4_t offsetY = vdupq_n_f32(offset.y());
+  const float32x4_t centerX = vdupq_n_f32(_circleCenter.x());
+  const float32x4_t centerY = vdupq_n_f32(_circleCenter.y());
+  const float32x4_t zero    = vdupq_n_f32(0.f);
+
+  for( ; i + 4 <= numPoints; i += 4 ) {
+    const float32x4x2_t xy = vld2q_f32(reinterpret_cast<const float*>(&points[i]));
+    const float32x4_t x = vaddq_f32(offsetX, xy.val[0]);
+    const float32x4_t y = vaddq_f32(offsetY, xy.val[1]);
+
+    uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(x, vdupq_n_f32(_minX)), vcleq_f32(x, vdupq_n_f32(_maxX))),
+                                  vandq_u32(vcgeq_f32(y, vdupq_n_f32(_minY)), vcleq_f32(y, vdupq_n_f32(_maxY))));
+
+    const float32x4_t dx = vsubq_f32(x, centerX);
+    const float32x4_t dy = vsubq_f32(y, centerY);
+    const float32x4_t distSquared = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+    inside = vandq_u32(inside, vcleq_f32(distSquared, vdupq_n_f32(_circumscribedRadiusSquared)));
+
+    const uint32x4_t needsEdges = vandq_u32(inside, vcgeq_f32(distSquared, vdupq_n_f32(_inscribedRadiusSquared)));
+    if( AnyLaneSet(needsEdges) ) {
+      uint32x4_t insideEdges = vceqq_f32(zero, zero); // all set
+      for( size_t edgeIdx = 0; edgeIdx < numEdges; ++edgeIdx ) {
+        const float32x4_t dot = vaddq_f32(
+          vmulq_f32(vdupq_n_f32(_edgeArrays.normalX[edgeIdx]), vsubq_f32(x, vdupq_n_f32(_edgeArrays.pointX[edgeIdx]))),
+          vmulq_f32(vdupq_n_f32(_edgeArrays.normalY[edgeIdx]), vsubq_f32(y, vdupq_n_f32(_edgeArrays.pointY[edgeIdx]))));
+        insideEdges = vandq_u32(insideEdges, vcleq_f32(dot, zero));
+      }
+#ifndef NDEBUG
+      _numDotProducts += 4 * numEdges;
+#endif
+      // points inside the inscribed circle pass regardless of the edges
+      inside = vandq_u32(inside, vornq_u32(insideEdges, needsEdges));
+    }
+
+    uint32_t lanes[4];
+    vst1q_u32(lanes, inside);
+    for( size_t lane = 0; lane < 4; ++lane ) {
+      const bool result = (0 != lanes[lane]);
+      contained[i + lane] = result;
+      numContained += (result ? 1 : 0);
+    }
+  }
+#ifndef NDEBUG
+  _numChecks += i;
+#endif
+#endif
+
+  for( ; i < numPoints; ++i ) {
+    const bool result = Contains(offset.x() + points[i].x(), offset.y() + points[i].y());
+    contained[i] = result;
+    numContained += (result ? 1 : 0);
+  }
+
+  return numContained;
 }
 
 float FastPolygon::GetCircumscribedRadius() const
@@ -304,6 +426,23 @@ void FastPolygon::SortEdgeVectors()
   }
 
   _perpendicularEdgeVectors.swap(sortedEdges);
+  CacheEdgeArrays();
+}
+
+void FastPolygon::CacheEdgeArrays()
+{
+  const size_t numEdges = _perpendicularEdgeVectors.size();
+  _edgeArrays.normalX.resize(numEdges);
+  _edgeArrays.normalY.resize(numEdges);
+  _edgeArrays.pointX.resize(numEdges);
+  _edgeArrays.pointY.resize(numEdges);
+  for( size_t i = 0; i < numEdges; ++i ) {
+    const auto& edgeVec = _perpendicularEdgeVectors[i];
+    _edgeArrays.normalX[i] = edgeVec.first.x();
+    _edgeArrays.normalY[i] = edgeVec.first.y();
+    _edgeArrays.pointX[i]  = _points[edgeVec.second].x();
+    _edgeArrays.pointY[i]  = _points[edgeVec.second].y();
+  }
 }
 
 unsigned int FastPolygon::CheckTestPoints(std::vector< std::pair< bool, Point2f > >& testPoints,
@@ -57,7 +57,18 @@ public:
   virtual bool InHalfPlane(const Halfplane2f& H) const override;
   
   // intersection with AABB
-  virtual bool Intersects(const AxisAlignedQuad& quad) const override;
+  virtual bool Intersects(const AxisAlignedQuad& quad) const override { return IntersectsQuad(quad); }
+
+  // Same as Intersects and ContainsAll(quad.GetVertices()), but without virtual dispatch (so callers in tight
+  // loops can bind to them directly)
+  bool IntersectsQuad(const AxisAlignedQuad& quad) const;
+  bool ContainsQuad(const AxisAlignedQuad& quad) const;
+
+  // Batch versions of the checks above. ContainsMany checks (points[i] + offset), four points at a time using NEON
+  // where available. Each sets result[i] for every input and returns how many were true.
+  size_t ContainsMany(const std::vector<Point2f>& points, std::vector<bool>& contained,
+                      const Point2f& offset = Point2f(0.f, 0.f)) const;
+  size_t IntersectsMany(const std::vector<AxisAlignedQuad>& quads, std::vector<bool>& intersects) const;
   
   const std::vector<LineSegment>& GetEdgeSegments() const { return _edgeSegments; }
   
@@ -128,11 +139,24 @@ private:
   // efficiency
   std::vector< std::pair< Vec2f, size_t> > _perpendicularEdgeVectors;
   std::vector< LineSegment > _edgeSegments;
-  
+
+  // The perpendicular edge vectors (in the same order) and their start points, split into separate arrays of x's and
+  // y's so the batch checks can load several at once
+  struct EdgeArrays {
+    std::vector<float> normalX;
+    std::vector<float> normalY;
+    std::vector<float> pointX;
+    std::vector<float> pointY;
+  };
+  EdgeArrays _edgeArrays;
+
   void ComputeCircles();
 
   // create (unsorted) edge vectors
   void CreateEdgeVectors();
+
+  // fill _edgeArrays from _perpendicularEdgeVectors
+  void CacheEdgeArrays();
   
 #if USE_LINESEGMENT_CHECKS
   bool Contains_Assumptionless(const Point2f& p) const;
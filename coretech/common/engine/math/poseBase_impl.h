@@ -390,98 +390,47 @@ namespace Anki {
       return true;
     }
 
-    if(!fromPose._node->HasSameRootAs(*toPose._node))
+    // Both transforms w.r.t. the root usually come straight from the nodes' caches, so the whole query is two
+    // lookups and one compose instead of a walk up both paths in the tree
+    const PoseTreeNode* fromRoot = nullptr;
+    const PoseTreeNode* toRoot = nullptr;
+    TransformNd T_from;
+    TransformNd T_to;
+    fromPose._node->GetTransformWrtRoot(T_from, fromRoot);
+    toPose._node->GetTransformWrtRoot(T_to, toRoot);
+
+    if(fromRoot != toRoot)
     {
       // We can't get the transformation between two poses that are not WRT the
       // same root!
       return false;
     }
-    
-    const PoseTreeNode* from = fromPose._node.get();
-    const PoseTreeNode* to   = toPose._node.get();
-    
-    TransformNd T_from(fromPose._node->GetTransform());
-    TransformNd T_to(toPose._node->GetTransform());
-    
-    // First make sure we are pointing at two nodes of the same tree depth,
-    // which is the only way they could possibly share the same _parent.
-    // Until that's true, walk the deeper node up until it is at the same
-    // depth as the shallower node, keeping track of the total transformation
-    // along the way. (NOTE: Only one of the following two while loops should
-    // run, depending on which node is deeper in the tree)
-    
-    int depthDiff = from->GetTreeDepth() - to->GetTreeDepth();
-    
-    while(depthDiff > 0)
+
+    if(fromPose._node == toPose._node)
     {
-      DEV_ASSERT(from->HasParent(), "PoseBase.GetWithRespectTo.FromParentIsNull");
-      
-      T_from.PreComposeWith( from->GetParentTransform() );
-      from = from->GetRawParentPtr();
-      
-      if(from->IsChildOf(*to))
-      {
-        // We bumped into the "to" pose on the way up to the common _parent, so
-        // we've got the the chained transform ready to go, and there's no
-        // need to walk past the "to" pose, up to the common _parent, and right
-        // back down, which would unnecessarily compose two more poses which
-        // are the inverse of one another by construction.
-        std::swap(P_wrt_other._node->GetTransform(), T_from);
-        P_wrt_other.SetParent(toPose);
-        return true;
-      }
-      
-      --depthDiff;
+      // Two poses wrapping the same node
+      P_wrt_other._node->GetTransform() = TransformNd{};
     }
-    
-    while(depthDiff < 0)
+    else if(toPose._node.get() == toRoot)
     {
-      DEV_ASSERT(to->HasParent(), "PoseBase.GetWithRespectTo.ToParentIsNull");
-      
-      T_to.PreComposeWith( to->GetParentTransform() );
-      to = to->GetRawParentPtr();
-      
-      if(to->IsChildOf(*from)) {
-        // We bumped into the "from" pose on the way up to the common _parent,
-        // so we've got the the (inverse of the) chained transform ready to
-        // go, and there's no need to walk past the "from" pose, up to the
-        // common _parent, and right back down, which would unnecessarily
-        // compose two more poses which are the inverse of one another by
-        // construction.
-        T_to.Invert();
-        std::swap(P_wrt_other._node->GetTransform(), T_to);
-        P_wrt_other.SetParent(toPose);
-        return true;
-      }
-      
-      ++depthDiff;
+      // Asked for the pose w.r.t. its root: that's exactly the cached transform
+      std::swap(P_wrt_other._node->GetTransform(), T_from);
     }
-    
-    // Sanity check: Treedepths should now match:
-    DEV_ASSERT(depthDiff == 0, "PoseBase.GetWithRespectTo.NonZeroDepthDiff");
-    DEV_ASSERT(to->GetTreeDepth() == from->GetTreeDepth(), "PoseBase.GetWithRespectTo.TreeDepthMismatch");
-    
-    // Now that we are pointing to the nodes of the same depth, keep moving up
-    // until those nodes have the same _parent, totalling up the transformations
-    // along the way
-    BOUNDED_WHILE(1000, (from != to) && !to->HasSameParentAs(*from))
+    else if(fromPose._node.get() == fromRoot)
     {
-      DEV_ASSERT(from->HasParent(), "PoseBase.GetWithRespectTo.FromParentIsNull");
-      DEV_ASSERT(to->HasParent(), "PoseBase.GetWithRespectTo.ToParentIsNull");
-      
-      T_from.PreComposeWith( from->GetParentTransform() );
-      T_to.PreComposeWith( to->GetParentTransform() );
-      
-      to = to->GetRawParentPtr();
-      from = from->GetRawParentPtr();
+      // Asked for the root w.r.t. one of its descendants
+      T_to.Invert();
+      std::swap(P_wrt_other._node->GetTransform(), T_to);
+    }
+    else
+    {
+      // Compute the total transformation from this pose, up the "from" path
+      // in the tree, to the root, and back down the "to" side to the
+      // final other pose.
+      //     P_wrt_other = P_to.inv * P_from;
+      P_wrt_other._node->GetTransform() = T_to.GetInverse();
+      P_wrt_other._node->GetTransform() *= T_from;
     }
-    
-    // Now compute the total transformation from this pose, up the "from" path
-    // in the tree, to the common ancestor, and back down the "to" side to the
-    // final other pose.
-    //     P_wrt_other = P_to.inv * P_from;
-    P_wrt_other._node->GetTransform() = T_to.GetInverse();
-    P_wrt_other._node->GetTransform() *= T_from;
     
     // The Pose we are about to return is w.r.t. the "other" pose provided (that
     // was the whole point of the exercise!), so set its _parent accordingly:
@@ -0,0 +1,53 @@
+/**
+ * File: poseSnapshot.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Plain-data copy of a flattened Pose3d
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "coretech/common/engine/math/poseSnapshot.h"
+
+#include "coretech/common/engine/math/pose.h"
+#include "coretech/common/engine/math/poseOriginList.h"
+
+namespace Anki {
+
+PoseSnapshot PoseSnapshot::FromFlattenedPose(const Pose3d& pose)
+{
+  DEV_ASSERT(!pose.HasParent() || pose.GetParent().IsRoot(), "PoseSnapshot.FromFlattenedPose.NotFlattened");
+  
+  const UnitQuaternion& Q = pose.GetRotation().GetQuaternion();
+  const Vec3f& T = pose.GetTranslation();
+  
+  PoseSnapshot snapshot;
+  snapshot.qw = Q.w();
+  snapshot.qx = Q.x();
+  snapshot.qy = Q.y();
+  snapshot.qz = Q.z();
+  snapshot.x  = T.x();
+  snapshot.y  = T.y();
+  snapshot.z  = T.z();
+  snapshot.originID = (pose.HasParent() ? pose.GetRootID() : PoseOriginList::UnknownOriginID);
+  return snapshot;
+}
+
+Transform3d PoseSnapshot::GetTransform() const
+{
+  return Transform3d(Rotation3d(UnitQuaternion(qw, qx, qy, qz)), Vec3f(x, y, z));
+}
+
+Pose3d PoseSnapshot::ToPose3d(const Pose3d& parent) const
+{
+  return Pose3d(GetTransform(), parent);
+}
+
+Pose3d PoseSnapshot::ToPose3d() const
+{
+  return Pose3d(GetTransform());
+}
+
+} // namespace Anki
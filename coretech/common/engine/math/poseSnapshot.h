@@ -0,0 +1,51 @@
+/**
+ * File: poseSnapshot.h
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Plain-data copy of a flattened Pose3d: its rotation quaternion, translation and origin ID. Unlike a
+ *              Pose3d, it has no heap allocated pose tree node, name or parent reference, so buffers of many poses
+ *              (e.g. robot state history) can hold these and be copied around freely, making a Pose3d only where
+ *              one is actually needed.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Coretech_Common_PoseSnapshot_H__
+#define __Anki_Coretech_Common_PoseSnapshot_H__
+
+#include "coretech/common/shared/types.h"
+
+#include <type_traits>
+
+namespace Anki {
+
+class Pose3d;
+class Transform3d;
+
+struct PoseSnapshot
+{
+  // Rotation (as a unit quaternion) and translation w.r.t. the origin
+  f32 qw, qx, qy, qz;
+  f32 x,  y,  z;
+  
+  // ID of the origin the pose is w.r.t., or PoseOriginList::UnknownOriginID if it had no parent
+  PoseOriginID_t originID;
+  
+  // The pose must be a root or a direct child of one (see Pose3d::GetWithRespectToRoot): nothing along a longer
+  // chain of parents is kept
+  static PoseSnapshot FromFlattenedPose(const Pose3d& pose);
+  
+  Transform3d GetTransform() const;
+  
+  // A new pose with this snapshot's transform. The parent should be the origin with originID.
+  Pose3d ToPose3d(const Pose3d& parent) const;
+  Pose3d ToPose3d() const;
+};
+
+static_assert(std::is_trivially_copyable<PoseSnapshot>::value, "PoseSnapshot should be plain data");
+
+} // namespace Anki
+
+#endif // __Anki_Coretech_Common_PoseSnapshot_H__
@@ -8,6 +8,12 @@
  * Description: Implements the internal tree node for poses, which contains a 2D or 3D transform, a parent pointer,
  *              a name, and an ID.
  *
+ *              Each node also caches its transform w.r.t. the root of its tree. The cache is stamped with the
+ *              node's own generation, bumped whenever its transform or parent may change, and with a tree
+ *              generation shared by all nodes, bumped whenever a node that has children may change (i.e. whenever
+ *              some node's ancestor changes). Leaf poses, which are most poses, can change freely without
+ *              invalidating anyone else's cache.
+ *
  * Copyright: Anki, Inc. 2017
  *
  **/
@@ -20,6 +26,7 @@
 #include "util/logging/logging.h"
 #include "coretech/common/engine/math/poseBase.h"
 
+#include <atomic>
 #include <list>
 #include <mutex>
 #include <set>
@@ -71,9 +78,14 @@ public:
   // Accessors
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  TransformNd&          GetTransform()       { return _transform; }
+  // NOTE: non-const access assumes the transform is about to change
+  TransformNd&          GetTransform()       { BumpGeneration(); return _transform; }
   const TransformNd&    GetTransform() const { return _transform; }
 
+  // Transform from this node to the root of its tree (not including the root's own transform), and that root.
+  // Served from the cache while neither this node nor any node with children has changed since it was computed.
+  void                  GetTransformWrtRoot(TransformNd& T_wrt_root, const PoseTreeNode*& root) const;
+
   // Just get parent's transform without mucking with shared pointers
   const TransformNd&    GetParentTransform() const { return _parentPtr->GetTransform(); }
 
@@ -109,6 +121,27 @@ private:
   PoseID_t                        _id = 0;
   uint32_t                        _ownerCount = 0;
 
+  // Number of nodes using this one as their parent. Atomic because children are created from different threads.
+  std::atomic<uint32_t>           _numChildren{0};
+
+  // Cached transform w.r.t. root (see GetTransformWrtRoot). The lock is only ever tried: a query that finds it held
+  // by another thread just computes the transform without the cache.
+  uint32_t                        _generation = 0;
+  mutable TransformNd             _cachedTransformWrtRoot;
+  mutable const PoseTreeNode*     _cachedRoot = nullptr;
+  mutable uint32_t                _cachedGeneration = 0;
+  mutable uint64_t                _cachedTreeGeneration = 0;
+  mutable std::atomic_flag        _cacheLock = ATOMIC_FLAG_INIT;
+
+  // Invalidates this node's cached transform, and every other node's if this one has children
+  void BumpGeneration();
+
+  // Created on demand, see the note about static variables below. Starts at 1 so that new nodes' caches are invalid.
+  static std::atomic<uint64_t>& GetTreeGeneration() {
+    static std::atomic<uint64_t> sTreeGeneration{1};
+    return sTreeGeneration;
+  }
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Dev methods
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -294,7 +327,16 @@ void PoseBase<PoseNd,TransformNd>::PoseTreeNode::SetParent(const std::shared_ptr
 {
   DEV_ASSERT(newParent.get() != this, "PoseBase.PoseTreeNode.SetParent.ParentCannotBeSelf");
   Dev_SwitchParent(_parentPtr.get(), newParent.get(), this);
+  if(_parentPtr != nullptr)
+  {
+    --_parentPtr->_numChildren;
+  }
+  if(newParent != nullptr)
+  {
+    ++newParent->_numChildren;
+  }
   _parentPtr = newParent;
+  BumpGeneration();
   Dev_AssertIsValidParentPointer(_parentPtr.get(), this);
 }
 
@@ -333,6 +375,61 @@ std::shared_ptr<typename PoseBase<PoseNd,TransformNd>::PoseTreeNode> PoseBase<Po
   return root;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class PoseNd, class TransformNd>
+inline void PoseBase<PoseNd,TransformNd>::PoseTreeNode::BumpGeneration()
+{
+  ++_generation;
+  if(_numChildren.load(std::memory_order_relaxed) > 0)
+  {
+    GetTreeGeneration().fetch_add(1, std::memory_order_release);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class PoseNd, class TransformNd>
+void PoseBase<PoseNd,TransformNd>::PoseTreeNode::GetTransformWrtRoot(TransformNd& T_wrt_root,
+                                                                     const PoseTreeNode*& root) const
+{
+  if(IsRoot())
+  {
+    T_wrt_root = TransformNd{};
+    root = this;
+    return;
+  }
+
+  // Read the tree generation before walking the tree, so that a change made while walking leaves the cache stale
+  const uint64_t treeGeneration = GetTreeGeneration().load(std::memory_order_acquire);
+  const bool haveCacheLock = !_cacheLock.test_and_set(std::memory_order_acquire);
+
+  if(haveCacheLock && (_cachedGeneration == _generation) && (_cachedTreeGeneration == treeGeneration))
+  {
+    T_wrt_root = _cachedTransformWrtRoot;
+    root = _cachedRoot;
+    _cacheLock.clear(std::memory_order_release);
+    return;
+  }
+
+  // Same composition order as walking up to the root in GetWithRespectTo, so results match exactly
+  T_wrt_root = _transform;
+  const PoseTreeNode* current = this;
+  BOUNDED_WHILE(1000, current->GetRawParentPtr()->HasParent())
+  {
+    T_wrt_root.PreComposeWith( current->GetParentTransform() );
+    current = current->GetRawParentPtr();
+  }
+  root = current->GetRawParentPtr();
+
+  if(haveCacheLock)
+  {
+    _cachedTransformWrtRoot = T_wrt_root;
+    _cachedRoot = root;
+    _cachedGeneration = _generation;
+    _cachedTreeGeneration = treeGeneration;
+    _cacheLock.clear(std::memory_order_release);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<class PoseNd, class TransformNd>
 std::string PoseBase<PoseNd,TransformNd>::PoseTreeNode::GetNamedPathToRoot(bool showTranslations) const
@@ -17,6 +17,7 @@
 #include "util/helpers/includeFstream.h"
 #include "util/helpers/ankiDefines.h"
 #include "util/fileUtils/fileUtils.h"
+#include "util/jsonWriter/jsonStreamWriter.h"
 #include <memory>
 
 #define LOG_CHANNEL "DataPlatform"
@@ -123,15 +124,17 @@ bool DataPlatform::writeAsJson(const std::string& resourceName, const Json::Valu
     LOG_ERROR("DataPlatform.writeAsJson", "Failed to create folder %s", resourceName.c_str());
     return false;
   }
-  Json::StyledStreamWriter writer;
+  // Serialize into one buffer and write it in one go, rather than streaming every token through the fstream
+  std::string buffer;
+  Util::JsonStreamWriter::Write(data, buffer, Util::JsonStreamWriter::Style::Pretty);
   std::fstream fs;
   fs.open(resourceName, std::ios::out);
   if (!fs.is_open()) {
     return false;
   }
-  writer.write(fs, data);
+  fs.write(buffer.data(), buffer.size());
   fs.close();
-  return true;
+  return !fs.fail();
 }
 
 std::unique_ptr<DataPlatform> DataPlatform::GetDataPlatform(const Json::Value & json)
@@ -0,0 +1,127 @@
+/**
+ * File: testMailbox.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for Mailbox and MultiMailbox
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "util/helpers/includeGTest.h" // Used in place of gTest/gTest.h directly to suppress warnings in the header
+
+#include "coretech/common/engine/mailbox_impl.h"
+
+#include <memory>
+#include <thread>
+
+using namespace Anki;
+
+GTEST_TEST(TestMailbox, LatestValueWins)
+{
+  Mailbox<std::unique_ptr<int>> mailbox;
+  std::unique_ptr<int> msg;
+
+  EXPECT_FALSE(mailbox.getMessage(msg));
+
+  EXPECT_TRUE(mailbox.putMessage(std::unique_ptr<int>(new int(1))));
+  EXPECT_TRUE(mailbox.putMessage(std::unique_ptr<int>(new int(2))));
+  EXPECT_TRUE(mailbox.putMessage(std::unique_ptr<int>(new int(3))));
+
+  ASSERT_TRUE(mailbox.getMessage(msg));
+  ASSERT_TRUE(msg != nullptr);
+  EXPECT_EQ(3, *msg);
+  EXPECT_FALSE(mailbox.getMessage(msg));
+
+  EXPECT_TRUE(mailbox.putMessage(std::unique_ptr<int>(new int(4))));
+  ASSERT_TRUE(mailbox.getMessage(msg));
+  ASSERT_TRUE(msg != nullptr);
+  EXPECT_EQ(4, *msg);
+}
+
+GTEST_TEST(TestMailbox, MultiMailboxIsFifoAndBounded)
+{
+  const u8 kNumBoxes = 3;
+  MultiMailbox<std::unique_ptr<int>, kNumBoxes> mailbox;
+  std::unique_ptr<int> msg;
+
+  EXPECT_FALSE(mailbox.getMessage(msg));
+
+  for(int round = 0; round < 3; ++round)
+  {
+    for(int i = 0; i < kNumBoxes; ++i)
+    {
+      EXPECT_TRUE(mailbox.putMessage(std::unique_ptr<int>(new int(10*round + i))));
+    }
+
+    // A failed put leaves the message with the caller
+    std::unique_ptr<int> extra(new int(-1));
+    EXPECT_FALSE(mailbox.putMessage(std::move(extra)));
+    ASSERT_TRUE(extra != nullptr);
+    EXPECT_EQ(-1, *extra);
+
+    for(int i = 0; i < kNumBoxes; ++i)
+    {
+      ASSERT_TRUE(mailbox.getMessage(msg));
+      ASSERT_TRUE(msg != nullptr);
+      EXPECT_EQ(10*round + i, *msg);
+    }
+    EXPECT_FALSE(mailbox.getMessage(msg));
+  }
+}
+
+GTEST_TEST(TestMailbox, ProducerAndConsumerThreads)
+{
+  const int kNumMessages = 10000;
+
+  // Every message arrives, in order, when the consumer waits out a full ring
+  MultiMailbox<std::vector<int>, 8> multiMailbox;
+  std::thread producer([&multiMailbox]() {
+    for(int i = 0; i < kNumMessages; ++i)
+    {
+      std::vector<int> msg(16, i);
+      while(!multiMailbox.putMessage(std::move(msg)))
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  int expected = 0;
+  std::vector<int> received;
+  while(expected < kNumMessages)
+  {
+    if(multiMailbox.getMessage(received))
+    {
+      ASSERT_EQ(16, received.size());
+      EXPECT_EQ(expected, received.front());
+      EXPECT_EQ(expected, received.back());
+      ++expected;
+    }
+  }
+  producer.join();
+
+  // Messages are never torn and never go backwards, though some are skipped
+  Mailbox<std::vector<int>> mailbox;
+  std::thread latestProducer([&mailbox]() {
+    for(int i = 0; i < kNumMessages; ++i)
+    {
+      mailbox.putMessage(std::vector<int>(16, i));
+    }
+  });
+
+  int lastReceived = -1;
+  while(lastReceived < kNumMessages - 1)
+  {
+    if(mailbox.getMessage(received))
+    {
+      ASSERT_EQ(16, received.size());
+      EXPECT_EQ(received.front(), received.back());
+      EXPECT_GT(received.front(), lastReceived);
+      lastReceived = received.front();
+    }
+  }
+  latestProducer.join();
+}
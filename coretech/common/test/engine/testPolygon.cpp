@@ -16,6 +16,7 @@
 #include "coretech/common/engine/math/polygon_impl.h"
 #include "coretech/common/engine/math/quad_impl.h"
 
+#include <algorithm>
 #include <vector>
 
 using namespace Anki;
@@ -202,6 +203,78 @@ GTEST_TEST(TestPolygon, FastPolygonSortedEdges)
 
 }
 
+GTEST_TEST(TestPolygon, FastPolygonBatchChecks)
+{
+  Poly2f poly {
+    {-184.256309,  108.494849},
+    {-201.111228,  150.067496},
+    {-201.111228,  204.267496},
+    {-160.19712,   220.855432},
+    { -82.19712,   220.855432},
+    { -65.342201,  179.282785},
+    { -65.342201,  125.082785},
+    {-106.256309,  108.494849}
+  };
+
+  FastPolygon fastPoly(poly);
+  fastPoly.SortEdgeVectors();
+
+  // An odd number of points exercises the leftovers after the four-at-a-time checks
+  std::vector<Point2f> testPoints;
+  for(float x = -250.0; x < -20.0; x += 3.0) {
+    for(float y = 80.0; y < 250.0; y += 3.0) {
+      testPoints.emplace_back( Point2f {x, y} );
+    }
+  }
+  testPoints.emplace_back( Point2f {-130.0, 164.0} );
+  if( testPoints.size() % 2 == 0 ) {
+    testPoints.emplace_back( Point2f {0.0, 0.0} );
+  }
+
+  const Point2f offset(5.0f, -7.0f);
+  std::vector<bool> contained;
+  const size_t numContained = fastPoly.ContainsMany(testPoints, contained, offset);
+  ASSERT_EQ(contained.size(), testPoints.size());
+
+  size_t expectedNumContained = 0;
+  for( size_t i=0; i<testPoints.size(); ++i ) {
+    const bool expected = fastPoly.Contains( testPoints[i] + offset );
+    expectedNumContained += (expected ? 1 : 0);
+    EXPECT_EQ( expected, contained[i] ) << "point["<<i<<"]: "<<testPoints[i];
+  }
+  EXPECT_EQ(expectedNumContained, numContained);
+  EXPECT_GT(numContained, 0);
+
+  // Quads all around (and straddling) the polygon, compared against checking each edge's halfplane on every corner
+  std::vector<AxisAlignedQuad> quads;
+  for(float x = -260.0; x < -10.0; x += 20.0) {
+    for(float y = 70.0; y < 260.0; y += 20.0) {
+      quads.emplace_back( Point2f{x, y}, Point2f{x + 15.f, y + 25.f} );
+    }
+  }
+
+  std::vector<bool> intersects;
+  const size_t numIntersecting = fastPoly.IntersectsMany(quads, intersects);
+  ASSERT_EQ(intersects.size(), quads.size());
+
+  size_t expectedNumIntersecting = 0;
+  for( size_t i=0; i<quads.size(); ++i ) {
+    const auto& quad = quads[i];
+    const bool separated = FLT_LT( fastPoly.GetMaxX(), quad.GetMinVertex().x() ) ||
+                           FLT_LT( fastPoly.GetMaxY(), quad.GetMinVertex().y() ) ||
+                           FLT_GT( fastPoly.GetMinX(), quad.GetMaxVertex().x() ) ||
+                           FLT_GT( fastPoly.GetMinY(), quad.GetMaxVertex().y() ) ||
+                           std::any_of(fastPoly.GetEdgeSegments().begin(), fastPoly.GetEdgeSegments().end(),
+                                       [&quad](const LineSegment& l) { return quad.InNegativeHalfPlane(l); });
+    expectedNumIntersecting += (separated ? 0 : 1);
+    EXPECT_EQ( !separated, intersects[i] ) << "quad["<<i<<"]";
+    EXPECT_EQ( fastPoly.ContainsAll(quad.GetVertices()), fastPoly.ContainsQuad(quad) ) << "quad["<<i<<"]";
+  }
+  EXPECT_EQ(expectedNumIntersecting, numIntersecting);
+  EXPECT_GT(numIntersecting, 0);
+  EXPECT_LT(numIntersecting, quads.size());
+}
+
 GTEST_TEST(TestPoly, CladConversion)
 {
   // 2D:
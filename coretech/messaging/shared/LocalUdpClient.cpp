@@ -9,12 +9,14 @@
 
 #include "coretech/messaging/shared/LocalUdpClient.h"
 #include "coretech/messaging/shared/LocalUdpServer.h" // for kConnectionPacket
+#include "coretech/messaging/shared/LocalUdpFrame.h"
 #include "coretech/messaging/shared/SocketUtils.h"
 #include "coretech/common/shared/logging.h"
 
 #include <iostream>
 
 #include <assert.h>
+#include <sys/uio.h>
 #include <unistd.h>
 
 // Socket buffer sizes
@@ -180,6 +182,41 @@ ssize_t LocalUdpClient::Send(const char* data, size_t size)
   return bytes_sent;
 }
 
+ssize_t LocalUdpClient::SendFrame(const void* payload, size_t size)
+{
+  if (_socket < 0) {
+    LOG_ERROR("LocalUdpClient.SendFrame", "Socket undefined, skipping send");
+    return 0;
+  }
+
+  if (size > Anki::Messaging::kLocalUdpMaxFramePayloadSize) {
+    LOG_ERROR("LocalUdpClient.SendFrame.TooLarge", "Payload of %zu bytes is over %zu", size,
+              Anki::Messaging::kLocalUdpMaxFramePayloadSize);
+    return -1;
+  }
+
+  Anki::Messaging::LocalUdpFrameSizeType frameSize = (Anki::Messaging::LocalUdpFrameSizeType) size;
+  struct iovec iov[2];
+  iov[0].iov_base = &frameSize;
+  iov[0].iov_len = sizeof(frameSize);
+  iov[1].iov_base = const_cast<void*>(payload);
+  iov[1].iov_len = size;
+
+  // Connected datagram socket, so writev sends both pieces as one datagram
+  const size_t frameLength = sizeof(frameSize) + size;
+  const ssize_t bytes_sent = writev(_socket, iov, 2);
+
+  if (bytes_sent != frameLength) {
+    LOG_ERROR("LocalUdpClient.SendFrame.Fail",
+              "Send error on %s (sock: %d), disconnecting (%s)",
+              _sockname.c_str(), _socket, strerror(errno));
+    Disconnect();
+    return -1;
+  }
+
+  return bytes_sent;
+}
+
 ssize_t LocalUdpClient::Recv(char* data, size_t maxSize)
 {
   assert(data != NULL);
@@ -0,0 +1,61 @@
+#ifndef ANKI_MESSAGING_LOCAL_UDP_FRAME_H
+#define ANKI_MESSAGING_LOCAL_UDP_FRAME_H
+
+/**
+ * File: LocalUdpFrame.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Framing shared by the local-domain socket peers (engine, switchboard, gateway).
+ *
+ * Each datagram is [u16 payload size][payload]. Senders hand the payload to LocalUdpServer::SendFrame or
+ * LocalUdpClient::SendFrame, which gather the size prefix in front of it rather than copying both into one
+ * buffer. Receivers read datagrams into a buffer they keep and find the payload in place with
+ * GetLocalUdpFramePayload.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/types.h>
+
+namespace Anki {
+namespace Messaging {
+
+using LocalUdpFrameSizeType = uint16_t;
+
+constexpr size_t kLocalUdpFrameHeaderSize = sizeof(LocalUdpFrameSizeType);
+
+// Largest datagram any of the local peers send, header included
+constexpr size_t kLocalUdpMaxFrameSize = 2048;
+
+constexpr size_t kLocalUdpMaxFramePayloadSize = kLocalUdpMaxFrameSize - kLocalUdpFrameHeaderSize;
+
+// Points outPayload at the payload of a received datagram. Returns false if the datagram is shorter than its
+// size prefix says, in which case it should be dropped.
+inline bool GetLocalUdpFramePayload(const uint8_t* datagram, ssize_t datagramSize,
+                                    const uint8_t*& outPayload, size_t& outPayloadSize)
+{
+  if (datagramSize < (ssize_t)kLocalUdpFrameHeaderSize) {
+    return false;
+  }
+
+  LocalUdpFrameSizeType payloadSize = 0;
+  memcpy(&payloadSize, datagram, sizeof(payloadSize));
+  if (payloadSize > (size_t)datagramSize - kLocalUdpFrameHeaderSize) {
+    return false;
+  }
+
+  outPayload = datagram + kLocalUdpFrameHeaderSize;
+  outPayloadSize = payloadSize;
+  return true;
+}
+
+} // end namespace Messaging
+} // end namespace Anki
+
+#endif
@@ -8,6 +8,7 @@
  */
 
 #include "coretech/messaging/shared/LocalUdpServer.h"
+#include "coretech/messaging/shared/LocalUdpFrame.h"
 #include "coretech/messaging/shared/SocketUtils.h"
 #include "coretech/common/shared/logging.h"
 
@@ -183,16 +184,62 @@ ssize_t LocalUdpServer::Send(const char* data, size_t size)
 
   if (bytes_sent != size) {
     // If send fails, log it and report it to caller.  It is caller's responsibility to retry at
-    // some appropriate interval.
+    // some appropriate interval. Callers check errno to tell a full socket buffer from a lost peer,
+    // so keep it intact across the log.
+    const int sendErrno = errno;
     LOG_WARNING("LocalUdpServer.Send.Fail",
                 "Sent %zd bytes instead of %zu on %s (sock: %d) (%s)",
-                bytes_sent, size, _sockname.c_str(), _socket, strerror(errno));
+                bytes_sent, size, _sockname.c_str(), _socket, strerror(sendErrno));
+    errno = sendErrno;
   }
 
   return bytes_sent;
 
 }
 
+ssize_t LocalUdpServer::SendFrame(const void* payload, size_t size)
+{
+  if (size > Anki::Messaging::kLocalUdpMaxFramePayloadSize) {
+    LOG_ERROR("LocalUdpServer.SendFrame.TooLarge", "Payload of %zu bytes is over %zu", size,
+              Anki::Messaging::kLocalUdpMaxFramePayloadSize);
+    return -1;
+  }
+
+  if (!HasClient()) {
+    LOG_DEBUG("LocalUdpServer.SendFrame", "No client");
+    return -1;
+  }
+
+  Anki::Messaging::LocalUdpFrameSizeType frameSize = (Anki::Messaging::LocalUdpFrameSizeType) size;
+  struct iovec iov[2];
+  iov[0].iov_base = &frameSize;
+  iov[0].iov_len = sizeof(frameSize);
+  iov[1].iov_base = const_cast<void*>(payload);
+  iov[1].iov_len = size;
+
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = iov;
+  msg.msg_iovlen = 2;
+  if (!_bindClients) {
+    msg.msg_name = &_client;
+    msg.msg_namelen = (socklen_t) SUN_LEN(&_client);
+  }
+
+  const size_t frameLength = sizeof(frameSize) + size;
+  const ssize_t bytes_sent = sendmsg(_socket, &msg, 0);
+  if (bytes_sent != frameLength) {
+    // As in Send, keep errno intact so a full socket buffer can be told from a lost peer
+    const int sendErrno = errno;
+    LOG_WARNING("LocalUdpServer.SendFrame.Fail",
+                "Sent %zd bytes instead of %zu on %s (sock: %d) (%s)",
+                bytes_sent, frameLength, _sockname.c_str(), _socket, strerror(sendErrno));
+    errno = sendErrno;
+  }
+
+  return bytes_sent;
+}
+
 ssize_t LocalUdpServer::Recv(char* data, size_t maxSize)
 {
   struct sockaddr_un saddr;
@@ -43,6 +43,10 @@ public:
   ssize_t Send(const char* data, size_t size);
   ssize_t Recv(char* data, size_t maxSize);
 
+  // Sends payload as one LocalUdpFrame datagram, without copying it behind the size prefix.
+  // Returns bytes sent including the prefix, or -1 on error.
+  ssize_t SendFrame(const void* payload, size_t size);
+
   int GetSocket() const { return _socket; }
 
   // Return count of bytes queued for read or -1 on error
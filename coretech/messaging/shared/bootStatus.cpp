@@ -0,0 +1,305 @@
+/**
+ * File: bootStatus.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "coretech/messaging/shared/bootStatus.h"
+#include "coretech/common/shared/logging.h"
+
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <time.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#endif
+
+#define LOG_CHANNEL "BootStatus"
+
+#define LOG_ERROR(name, format, ...)   CORETECH_LOG_ERROR(name, format, ##__VA_ARGS__)
+#define LOG_INFO(name, format, ...)    CORETECH_LOG_INFO(LOG_CHANNEL, name, format, ##__VA_ARGS__)
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+
+  constexpr const char* kSharedMemoryName  = "/vic-boot-status";
+  constexpr u32         kMagic             = 0x56425331; // "VBS1"
+  constexpr u32         kMagicInitializing = 0x56425330;
+  constexpr u32         kVersion           = 1;
+  constexpr size_t      kCacheLineSize     = 64;
+  constexpr s32         kInitWaitTimeout_ms = 1000;
+  constexpr size_t      kNumMilestones     = static_cast<size_t>(BootMilestone::Count);
+
+  static_assert(kNumMilestones <= 32, "Reached milestones are a 32-bit mask");
+  static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "Doorbell must be a plain 32-bit word for futex use");
+
+  // Lives at the start of the shared object, which is zeroed when first created
+  struct Page
+  {
+    std::atomic<u32> magic;
+    u32              version;
+
+    alignas(kCacheLineSize) std::atomic<u32> doorbell;  // bumped every time a milestone is reached
+    std::atomic<u32>                         reached;   // bit per BootMilestone
+    std::atomic<u32>                         reachedTime_ms[kNumMilestones];
+  };
+
+  inline u32 GetBit(BootMilestone milestone)
+  {
+    return (1u << static_cast<u32>(milestone));
+  }
+
+  // Block until the doorbell's value differs from lastValue or the timeout expires (spurious wakeups are
+  // possible, so callers re-check their condition)
+  void WaitOnDoorbell(std::atomic<u32>& doorbell, u32 lastValue, s32 timeout_ms)
+  {
+    if(timeout_ms <= 0)
+    {
+      return;
+    }
+#if defined(__linux__)
+    struct timespec timeout;
+    timeout.tv_sec  = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
+    // Note: not FUTEX_PRIVATE_FLAG, since the publishers are in other processes
+    syscall(SYS_futex, reinterpret_cast<u32*>(&doorbell), FUTEX_WAIT, lastValue, &timeout, nullptr, 0);
+#else
+    // No futex available (e.g. mac/simulator), so fall back on a short poll
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while(doorbell.load(std::memory_order_acquire) == lastValue && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+#endif
+  }
+
+  void WakeDoorbell(std::atomic<u32>& doorbell)
+  {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<u32*>(&doorbell), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+  }
+
+  inline s32 GetRemaining_ms(const std::chrono::steady_clock::time_point& deadline)
+  {
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline -
+                                                                                std::chrono::steady_clock::now());
+    return static_cast<s32>(remaining.count());
+  }
+
+  Page* MapPage()
+  {
+    const int fd = shm_open(kSharedMemoryName, O_RDWR | O_CREAT, 0666);
+    if(fd < 0)
+    {
+      LOG_ERROR("BootStatus.MapPage.OpenFailed", "%s: %s", kSharedMemoryName, strerror(errno));
+      return nullptr;
+    }
+
+    // The processes run as different users, so don't let the creator's umask lock the others out. Only the
+    // creator is allowed to do this, so failing is expected for everyone else
+    (void) fchmod(fd, 0666);
+
+    struct stat st;
+    if(0 != fstat(fd, &st))
+    {
+      LOG_ERROR("BootStatus.MapPage.StatFailed", "%s: %s", kSharedMemoryName, strerror(errno));
+      close(fd);
+      return nullptr;
+    }
+    if(0 == st.st_size)
+    {
+      if(0 != ftruncate(fd, sizeof(Page)))
+      {
+        LOG_ERROR("BootStatus.MapPage.TruncateFailed", "%s: %s", kSharedMemoryName, strerror(errno));
+        close(fd);
+        return nullptr;
+      }
+    }
+    else if(static_cast<size_t>(st.st_size) != sizeof(Page))
+    {
+      LOG_ERROR("BootStatus.MapPage.SizeMismatch", "%s: Existing:%lld Expected:%zu",
+                kSharedMemoryName, (long long)st.st_size, sizeof(Page));
+      close(fd);
+      return nullptr;
+    }
+
+    void* ptr = mmap(nullptr, sizeof(Page), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // The mapping keeps the object alive on its own
+    close(fd);
+    if(MAP_FAILED == ptr)
+    {
+      LOG_ERROR("BootStatus.MapPage.MapFailed", "%s: %s", kSharedMemoryName, strerror(errno));
+      return nullptr;
+    }
+    Page* page = static_cast<Page*>(ptr);
+
+    // Freshly truncated memory is zeroed, so the first process to flip magic from zero initializes the page
+    u32 expectedMagic = 0;
+    if(page->magic.compare_exchange_strong(expectedMagic, kMagicInitializing))
+    {
+      page->version = kVersion;
+      page->magic.store(kMagic, std::memory_order_release);
+    }
+    else
+    {
+      const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kInitWaitTimeout_ms);
+      while(kMagic != page->magic.load(std::memory_order_acquire) && GetRemaining_ms(deadline) > 0)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+
+    if(kMagic != page->magic.load(std::memory_order_acquire) || kVersion != page->version)
+    {
+      LOG_ERROR("BootStatus.MapPage.HeaderMismatch", "%s: Magic:0x%08X Version:%u",
+                kSharedMemoryName, page->magic.load(), page->version);
+      munmap(page, sizeof(Page));
+      return nullptr;
+    }
+
+    return page;
+  }
+
+  // Mapped on first use and never unmapped, since any thread may publish or wait at any time
+  Page* GetPage()
+  {
+    static Page* sPage = MapPage();
+    return sPage;
+  }
+
+}
+
+const char* BootMilestoneToString(BootMilestone milestone)
+{
+  switch(milestone)
+  {
+    case BootMilestone::RobotCommsReady:      return "RobotCommsReady";
+    case BootMilestone::AnimEngineCommsReady: return "AnimEngineCommsReady";
+    case BootMilestone::AnimRobotConnected:   return "AnimRobotConnected";
+    case BootMilestone::AnimFaceReady:        return "AnimFaceReady";
+    case BootMilestone::EngineDataLoaded:     return "EngineDataLoaded";
+    case BootMilestone::EngineConnected:      return "EngineConnected";
+    case BootMilestone::SwitchboardReady:     return "SwitchboardReady";
+    case BootMilestone::FirstInteraction:     return "FirstInteraction";
+    case BootMilestone::Count:                break;
+  }
+  return "Invalid";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BootStatus::Publish(BootMilestone milestone)
+{
+  Page* page = GetPage();
+  if(nullptr == page)
+  {
+    return;
+  }
+
+  const u32 now_ms = GetTimeSinceBoot_ms();
+  const u32 bit = GetBit(milestone);
+  page->reachedTime_ms[static_cast<size_t>(milestone)].store(now_ms, std::memory_order_relaxed);
+  const u32 prevReached = page->reached.fetch_or(bit, std::memory_order_acq_rel);
+
+  // Waiters read the doorbell before checking the mask, so bumping it after setting the bit can't lose a wakeup
+  page->doorbell.fetch_add(1, std::memory_order_release);
+  WakeDoorbell(page->doorbell);
+
+  if(0 == (prevReached & bit))
+  {
+    LOG_INFO("BootStatus.Publish", "%s at %u ms since boot", BootMilestoneToString(milestone), now_ms);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BootStatus::Clear(BootMilestone milestone)
+{
+  Page* page = GetPage();
+  if(nullptr == page)
+  {
+    return;
+  }
+
+  page->reached.fetch_and(~GetBit(milestone), std::memory_order_acq_rel);
+  page->reachedTime_ms[static_cast<size_t>(milestone)].store(0, std::memory_order_relaxed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BootStatus::IsReached(BootMilestone milestone)
+{
+  const Page* page = GetPage();
+  return (nullptr != page) && (0 != (page->reached.load(std::memory_order_acquire) & GetBit(milestone)));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BootStatus::WaitFor(BootMilestone milestone, s32 timeout_ms)
+{
+  Page* page = GetPage();
+  if(nullptr == page)
+  {
+    return false;
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while(true)
+  {
+    const u32 doorbell = page->doorbell.load(std::memory_order_acquire);
+    if(IsReached(milestone))
+    {
+      return true;
+    }
+    const s32 remaining_ms = GetRemaining_ms(deadline);
+    if(remaining_ms <= 0)
+    {
+      return false;
+    }
+    WaitOnDoorbell(page->doorbell, doorbell, remaining_ms);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u32 BootStatus::GetReachedTime_ms(BootMilestone milestone)
+{
+  const Page* page = GetPage();
+  if(!IsReached(milestone))
+  {
+    return 0;
+  }
+  return page->reachedTime_ms[static_cast<size_t>(milestone)].load(std::memory_order_relaxed);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u32 BootStatus::GetTimeSinceBoot_ms()
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return static_cast<u32>(static_cast<u64>(ts.tv_sec) * 1000 + ts.tv_nsec / 1000000);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BootStatus::IsAvailable()
+{
+  return (nullptr != GetPage());
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,73 @@
+/**
+ * File: bootStatus.h
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Shared-memory status page where vic-robot, vic-anim, vic-engine and switchboard publish their startup
+ *              milestones, so each process can wait to be told the one it depends on is ready instead of retrying
+ *              socket connects on a timer. The sockets are still the transport: this only says when connecting
+ *              will work.
+ *
+ *              The page is a bitmask of reached milestones, the time each was reached and a doorbell counter that
+ *              is bumped on every change, which waiters block on (a futex on Linux, a short poll elsewhere). If the
+ *              page can't be mapped, publishing does nothing and nothing is ever reached, so callers keep their
+ *              old retry as a fallback.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Anki_Messaging_Shared_BootStatus_H__
+#define __Anki_Messaging_Shared_BootStatus_H__
+
+#include "coretech/common/shared/types.h"
+
+namespace Anki {
+namespace Vector {
+
+// Keep in sync with BootMilestoneToString. Roughly in the order they're reached on a normal boot
+enum class BootMilestone : u8 {
+  RobotCommsReady,        // vic-robot is listening for vic-anim
+  AnimEngineCommsReady,   // vic-anim is listening for vic-engine
+  AnimRobotConnected,     // vic-anim has connected to vic-robot
+  AnimFaceReady,          // vic-anim has drawn its first face
+  EngineDataLoaded,       // vic-engine has finished loading its data
+  EngineConnected,        // vic-engine has connected to vic-anim and is running
+  SwitchboardReady,       // switchboard is connected to the engine and ankibluetoothd
+  FirstInteraction,       // the user has first interacted with the robot since vic-engine started
+  Count
+};
+
+const char* BootMilestoneToString(BootMilestone milestone);
+
+class BootStatus
+{
+public:
+
+  // Marks the milestone as reached and wakes everyone waiting on the page
+  static void Publish(BootMilestone milestone);
+
+  // A process clears the milestones it owns as it starts, so a restarted process isn't mistaken for a ready one
+  static void Clear(BootMilestone milestone);
+
+  static bool IsReached(BootMilestone milestone);
+
+  // Blocks until the milestone is reached or the timeout expires. Returns true if reached. Returns false right
+  // away if the page isn't available
+  static bool WaitFor(BootMilestone milestone, s32 timeout_ms);
+
+  // Time since boot (CLOCK_MONOTONIC) when the milestone was last reached, or 0 if it hasn't been
+  static u32 GetReachedTime_ms(BootMilestone milestone);
+
+  // Time since boot, on the same clock as GetReachedTime_ms
+  static u32 GetTimeSinceBoot_ms();
+
+  // False if the shared page couldn't be mapped
+  static bool IsAvailable();
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Messaging_Shared_BootStatus_H__
@@ -6,8 +6,9 @@
  *
  * Description: Interface class to create a standalone process to run forward inference using a neural network.
  *
- *              Currently uses the file system as a poor man's IPC to communicate with the "messenger"
+ *              By default uses the file system as a poor man's IPC to communicate with the "messenger"
  *              NeuralNetRunner::Model implementation in vic-engine's Vision System. See also VIC-2686.
+ *              Models configured with "transport":"sharedMemory" use a SharedMemoryTransport instead.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -26,15 +27,19 @@
 #endif
 
 #include "clad/types/salientPointTypes.h"
+#include "coretech/common/engine/jsonTools.h"
 #include "coretech/common/engine/scopedTicToc.h"
 #include "coretech/neuralnets/iNeuralNetMain.h"
 #include "coretech/neuralnets/neuralNetFilenames.h"
 #include "coretech/neuralnets/neuralNetJsonKeys.h"
 #include "coretech/neuralnets/neuralNetModel_offboard.h"
+#include "coretech/neuralnets/neuralNetScheduler.h"
+#include "coretech/neuralnets/neuralNetSharedMemory.h"
 #include "coretech/vision/engine/image_impl.h"
 #include "json/json.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
+#include "util/memoryAccounting/memoryAccounting.h"
 
 #include "opencv2/imgcodecs/imgcodecs.hpp"
 #include "opencv2/imgproc/imgproc.hpp"
@@ -197,6 +202,43 @@ Result INeuralNetMain::Init(const std::string& configFilename,
       CleanupAndExit(RESULT_FAIL);
     }
     
+    // Set up shared memory instead of polling the cache directory, if requested (not used when processing a
+    // single image file provided on the command line)
+    std::string transport = JsonKeys::FileTransport;
+    JsonTools::GetValueOptional(modelConfig, JsonKeys::Transport, transport);
+    if(JsonKeys::SharedMemoryTransport == transport && _imageFilename.empty())
+    {
+      s32 inputHeight = 0, inputWidth = 0, numSlots = 2;
+      if(!JsonTools::GetValueOptional(modelConfig, JsonKeys::InputHeight, inputHeight) ||
+         !JsonTools::GetValueOptional(modelConfig, JsonKeys::InputWidth, inputWidth))
+      {
+        LOG_ERROR("INeuralNetMain.Init.SharedMemoryNeedsInputSize", "Model '%s'", name.c_str());
+        CleanupAndExit(RESULT_FAIL);
+      }
+      JsonTools::GetValueOptional(modelConfig, JsonKeys::SharedMemoryNumSlots, numSlots);
+      
+      std::unique_ptr<SharedMemoryTransport> sharedMemory(new SharedMemoryTransport());
+      result = sharedMemory->Init(name, SharedMemoryTransport::Role::Consumer, inputHeight, inputWidth, numSlots);
+      if(RESULT_OK != result)
+      {
+        LOG_ERROR("INeuralNetMain.Init.SharedMemoryInitFailed", "Model '%s'", name.c_str());
+        CleanupAndExit(result);
+      }
+      _sharedMemory.emplace(name, std::move(sharedMemory));
+    }
+    else if(JsonKeys::FileTransport != transport && JsonKeys::SharedMemoryTransport != transport)
+    {
+      LOG_ERROR("INeuralNetMain.Init.UnknownTransport", "Model '%s': %s", name.c_str(), transport.c_str());
+      CleanupAndExit(RESULT_FAIL);
+    }
+    
+    s32 inputHeight = 0, inputWidth = 0;
+    if(JsonTools::GetValueOptional(modelConfig, JsonKeys::InputHeight, inputHeight) &&
+       JsonTools::GetValueOptional(modelConfig, JsonKeys::InputWidth, inputWidth))
+    {
+      _inputSizes.emplace(name, std::make_pair(inputHeight, inputWidth));
+    }
+    
     anyVerbose |= neuralNet->IsVerbose();
     _pollPeriod_ms = std::min(_pollPeriod_ms, GetPollPeriod_ms(modelConfig));
   
@@ -209,10 +251,25 @@ Result INeuralNetMain::Init(const std::string& configFilename,
     CleanupAndExit(RESULT_FAIL);
   }
   
+  // Models with an image available at the same time are run as one batch on a shared pool of workers.
+  // Zero threads (the default) runs them in priority order on this thread.
+  s32 schedulerNumThreads = 0;
+  JsonTools::GetValueOptional(config, JsonKeys::SchedulerNumThreads, schedulerNumThreads);
+  _scheduler.reset(new NeuralNetScheduler(schedulerNumThreads));
+  
+  // With a single shared memory model, block on its doorbell instead of sleeping for the poll period. Otherwise
+  // just check each model's ring without waiting so file-based models still get polled on schedule.
+  _sharedMemoryWait_ms = ((_neuralNets.size() == 1 && _sharedMemory.size() == 1) ? _pollPeriod_ms : 0);
+  
   _isInitialized = true;
   
-  LOG_INFO("INeuralNetMain.Init.DetectorInitialized", "Loaded %zu model(s). Polling for images every %dms",
-           _neuralNets.size(), _pollPeriod_ms);
+  LOG_INFO("INeuralNetMain.Init.DetectorInitialized", "Loaded %zu model(s), %zu using shared memory, %d worker(s). "
+           "Polling for images every %dms", _neuralNets.size(), _sharedMemory.size(), _scheduler->GetNumThreads(),
+           _pollPeriod_ms);
+  
+  // The models are all this process holds onto, and they're all loaded now (though models allocated on first use
+  // will add to this once they're warmed up)
+  Util::MemoryAccounting::ReportNewHighWaterMarks();
   
   return RESULT_OK;
 }
@@ -226,44 +283,78 @@ Result INeuralNetMain::Run()
     return RESULT_FAIL;
   }
   
-  Result result = RESULT_OK;
-  
   const bool imageFileProvided = !_imageFilename.empty();
   
+  // Reused every loop to avoid reallocating
+  std::vector<NeuralNetScheduler::Job> jobs;
+  std::vector<PendingOutput> outputs;
+  jobs.reserve(_neuralNets.size());
+  outputs.reserve(_neuralNets.size());
+  
   bool anyFailures = false;
   while(!anyFailures && !ShouldShutdown())
   {
+    jobs.clear();
+    outputs.clear();
+    
+    // Gather every model's available image first so they can be run together as one batch
     for(auto & model : _neuralNets)
     {
       const std::string& networkName = model.first;
       std::unique_ptr<NeuralNets::INeuralNetModel>& neuralNet = model.second;
       
+      NeuralNetScheduler::Job job;
+      job.model = neuralNet.get();
+      
+      PendingOutput output;
+      output.networkName = &networkName;
+      
+      auto sharedMemoryIter = _sharedMemory.find(networkName);
+      if(sharedMemoryIter != _sharedMemory.end())
+      {
+        // Image wraps the shared memory slot directly: no copy, no decode
+        output.sharedMemory = sharedMemoryIter->second.get();
+        if(output.sharedMemory->AcquireImage(_sharedMemoryWait_ms, job.img, output.imageSeq))
+        {
+          if(neuralNet->IsVerbose())
+          {
+            LOG_INFO("INeuralNetMain.Run.FoundSharedMemoryImage", "%s: %dx%d t:%u Seq:%u", networkName.c_str(),
+                     job.img.GetNumCols(), job.img.GetNumRows(), job.img.GetTimestamp(), output.imageSeq);
+          }
+          jobs.emplace_back(std::move(job));
+          outputs.emplace_back(std::move(output));
+        }
+        continue;
+      }
+      
       // Is there an image file available in the cache?
-      const std::string fullImagePath = (imageFileProvided ?
-                                         _imageFilename :
-                                         Util::FileUtils::FullFilePath({_cachePath, networkName, Filenames::Image}));
+      output.imagePath = (imageFileProvided ?
+                          _imageFilename :
+                          Util::FileUtils::FullFilePath({_cachePath, networkName, Filenames::Image}));
       
-      const bool isImageAvailable = Util::FileUtils::FileExists(fullImagePath);
+      const bool isImageAvailable = Util::FileUtils::FileExists(output.imagePath);
       
       if(isImageAvailable)
       {
         if(neuralNet->IsVerbose())
         {
-          LOG_INFO("INeuralNetMain.Run.FoundImage", "%s", fullImagePath.c_str());
+          LOG_INFO("INeuralNetMain.Run.FoundImage", "%s", output.imagePath.c_str());
         }
         
         // Get the image
-        Vision::ImageRGB img;
         {
           ScopedTicToc ticToc("GetImage", LOG_CHANNEL);
           
           const std::string timestampFilename = Util::FileUtils::FullFilePath({_cachePath, networkName, Filenames::Timestamp});
           
-          GetImage(fullImagePath, timestampFilename, img);
+          if(!GetSharedImage(networkName, output.imagePath, timestampFilename, jobs, job.img))
+          {
+            GetImage(output.imagePath, timestampFilename, job.img);
+          }
           
-          if(img.IsEmpty())
+          if(job.img.IsEmpty())
           {
-            LOG_ERROR("INeuralNetMain.Run.ImageReadFailed", "Error while loading image %s", fullImagePath.c_str());
+            LOG_ERROR("INeuralNetMain.Run.ImageReadFailed", "Error while loading image %s", output.imagePath.c_str());
             if(imageFileProvided)
             {
               // If we loaded in image file specified on the command line, we are done
@@ -275,69 +366,16 @@ Result INeuralNetMain::Run()
               // Remove the corrupted image image to show we are ready for a new one
               if(neuralNet->IsVerbose())
               {
-                LOG_INFO("INeuralNetMain.Run.DeletingCorruptedImageFile", "%s", fullImagePath.c_str());
+                LOG_INFO("INeuralNetMain.Run.DeletingCorruptedImageFile", "%s", output.imagePath.c_str());
               }
-              Util::FileUtils::DeleteFile(fullImagePath);
+              Util::FileUtils::DeleteFile(output.imagePath);
               continue; // no need to stop the process, it was just a bad image, won't happen again
             }
           }
         }
         
-        // Detect what's in it
-        std::list<Vision::SalientPoint> salientPoints;
-        {
-          ScopedTicToc ticToc("Detect", LOG_CHANNEL);
-          result = neuralNet->Detect(img, salientPoints);
-          
-          if(RESULT_OK != result)
-          {
-            LOG_ERROR("INeuralNetMain.Run.DetectFailed", "");
-            result = RESULT_OK; // keep trying (?)
-          }
-        }
-        
-        // Convert the results to JSON
-        Json::Value detectionResults;
-        ConvertSalientPointsToJson(salientPoints, neuralNet->IsVerbose(), detectionResults);
-        
-        // Write out the Json
-        {
-          if(!imageFileProvided)
-          {
-            // Remove the image file now that we're done working with it
-            if(neuralNet->IsVerbose())
-            {
-              LOG_INFO("INeuralNetMain.Run.DeletingImageFile", "%s", fullImagePath.c_str());
-            }
-            Util::FileUtils::DeleteFile(fullImagePath);
-          }
-          
-          ScopedTicToc ticToc("WriteJSON", LOG_CHANNEL);
-          const std::string tempFilename = Util::FileUtils::FullFilePath({_cachePath, networkName, "tempResult.json"});
-          if(neuralNet->IsVerbose())
-          {
-            LOG_INFO("INeuralNetMain.Run.WritingTempResults", "%s", tempFilename.c_str());
-          }
-          
-          bool success = WriteResults(tempFilename, detectionResults);
-          if(!success)
-          {
-            anyFailures = true;
-            break;
-          }
-          
-          const std::string jsonFilename = Util::FileUtils::FullFilePath({_cachePath, networkName, Filenames::Result});
-          if(neuralNet->IsVerbose())
-          {
-            LOG_INFO("INeuralNetMain.Run.MovingToFinalResults", "%s", jsonFilename.c_str());
-          }
-          success = Util::FileUtils::MoveFile(jsonFilename, tempFilename);
-          if(!success)
-          {
-            anyFailures = true;
-            break;
-          }
-        }
+        jobs.emplace_back(std::move(job));
+        outputs.emplace_back(std::move(output));
       }
       else if(imageFileProvided)
       {
@@ -351,26 +389,183 @@ Result INeuralNetMain::Run()
         static int count = 0;
         if(count++ * _pollPeriod_ms >= kVerbosePrintFreq_ms)
         {
-          LOG_INFO("INeuralNetMain.Run.WaitingForImage", "%s", fullImagePath.c_str());
+          LOG_INFO("INeuralNetMain.Run.WaitingForImage", "%s", output.imagePath.c_str());
           count = 0;
         }
       }
       
     } // FOR each model
     
+    // Detect what's in them
+    if(!anyFailures && !jobs.empty())
+    {
+      ScopedTicToc ticToc("Detect", LOG_CHANNEL);
+      _scheduler->RunBatch(jobs);
+    }
+    else if(!anyFailures && !imageFileProvided)
+    {
+      // Nothing to do this time around, so get one model's slow first run out of the way before it has a real image
+      WarmUpNextModel();
+    }
+    
+    // Hand back the results
+    for(size_t i=0; i<jobs.size() && !anyFailures; ++i)
+    {
+      NeuralNetScheduler::Job& job = jobs[i];
+      if(RESULT_OK != job.result)
+      {
+        LOG_ERROR("INeuralNetMain.Run.DetectFailed", "%s", job.model->GetName().c_str());
+        // keep trying (?)
+      }
+      
+      const bool success = WriteOutput(*job.model, job, outputs[i], imageFileProvided);
+      if(!success)
+      {
+        anyFailures = true;
+      }
+    }
+    
+    // Release any shared memory slots still held (e.g. after a failure above)
+    for(auto& output : outputs)
+    {
+      if(nullptr != output.sharedMemory)
+      {
+        output.sharedMemory->ReleaseImage();
+      }
+    }
+    
     if(imageFileProvided)
     {
       // No polling needed when a specific image to process is provided, so finish
       break;
     }
     
-    Step(_pollPeriod_ms);
+    // If we already blocked on the shared memory doorbell, don't wait again
+    Step(_sharedMemoryWait_ms > 0 ? 0 : _pollPeriod_ms);
     
   } // WHILE should not shutdown
   
   CleanupAndExit( anyFailures ? RESULT_FAIL : RESULT_OK );
   
-  return result;
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool INeuralNetMain::GetSharedImage(const std::string& networkName,
+                                    const std::string& imageFilename,
+                                    const std::string& timestampFilename,
+                                    const std::vector<NeuralNetScheduler::Job>& jobs,
+                                    Vision::ImageRGB& img) const
+{
+  // The engine writes the same frame, resized to the same input size, for every model with that input size.
+  // Decode it only once per batch and give the other models a copy.
+  auto sizeIter = _inputSizes.find(networkName);
+  if(sizeIter == _inputSizes.end() || !Util::FileUtils::FileExists(timestampFilename))
+  {
+    return false;
+  }
+  
+  std::ifstream file(timestampFilename);
+  std::string line;
+  std::getline(file, line);
+  if(line.empty())
+  {
+    return false;
+  }
+  const TimeStamp_t timestamp = uint(std::stol(line));
+  
+  for(const auto& job : jobs)
+  {
+    auto otherSizeIter = _inputSizes.find(job.model->GetName());
+    if(otherSizeIter != _inputSizes.end() && otherSizeIter->second == sizeIter->second &&
+       job.img.GetTimestamp() == timestamp &&
+       job.img.GetNumRows() == sizeIter->second.first && job.img.GetNumCols() == sizeIter->second.second)
+    {
+      job.img.CopyTo(img);
+      img.SetTimestamp(timestamp);
+      return true;
+    }
+  }
+  
+  return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void INeuralNetMain::WarmUpNextModel()
+{
+  for(auto & model : _neuralNets)
+  {
+    std::unique_ptr<NeuralNets::INeuralNetModel>& neuralNet = model.second;
+    if(neuralNet->NeedsWarmUp())
+    {
+      const Result result = neuralNet->WarmUp();
+      if(RESULT_OK != result)
+      {
+        LOG_WARNING("INeuralNetMain.WarmUpNextModel.Failed", "%s", model.first.c_str());
+      }
+      Util::MemoryAccounting::ReportNewHighWaterMarks();
+      return;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool INeuralNetMain::WriteOutput(const INeuralNetModel& neuralNet, NeuralNetScheduler::Job& job,
+                                 PendingOutput& output, bool imageFileProvided)
+{
+  if(nullptr != output.sharedMemory)
+  {
+    // Done with the slot: let the engine reuse it while we publish results
+    job.img = Vision::ImageRGB();
+    output.sharedMemory->ReleaseImage();
+    
+    if(neuralNet.IsVerbose())
+    {
+      Json::Value detectionResults;
+      ConvertSalientPointsToJson(job.salientPoints, true, detectionResults);
+    }
+    
+    ScopedTicToc ticToc("WriteResults", LOG_CHANNEL);
+    const Result result = output.sharedMemory->WriteResults(output.imageSeq, job.salientPoints);
+    return (RESULT_OK == result);
+  }
+  
+  // Convert the results to JSON
+  Json::Value detectionResults;
+  ConvertSalientPointsToJson(job.salientPoints, neuralNet.IsVerbose(), detectionResults);
+  
+  // Write out the Json
+  if(!imageFileProvided)
+  {
+    // Remove the image file now that we're done working with it
+    if(neuralNet.IsVerbose())
+    {
+      LOG_INFO("INeuralNetMain.Run.DeletingImageFile", "%s", output.imagePath.c_str());
+    }
+    Util::FileUtils::DeleteFile(output.imagePath);
+  }
+  
+  ScopedTicToc ticToc("WriteJSON", LOG_CHANNEL);
+  const std::string& networkName = *output.networkName;
+  const std::string tempFilename = Util::FileUtils::FullFilePath({_cachePath, networkName, "tempResult.json"});
+  if(neuralNet.IsVerbose())
+  {
+    LOG_INFO("INeuralNetMain.Run.WritingTempResults", "%s", tempFilename.c_str());
+  }
+  
+  bool success = WriteResults(tempFilename, detectionResults);
+  if(!success)
+  {
+    return false;
+  }
+  
+  const std::string jsonFilename = Util::FileUtils::FullFilePath({_cachePath, networkName, Filenames::Result});
+  if(neuralNet.IsVerbose())
+  {
+    LOG_INFO("INeuralNetMain.Run.MovingToFinalResults", "%s", jsonFilename.c_str());
+  }
+  success = Util::FileUtils::MoveFile(jsonFilename, tempFilename);
+  return success;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -6,8 +6,9 @@
  *
  * Description: Interface class to create a standalone process to run forward inference using a neural network.
  *
- *              Currently uses the file system as a poor man's IPC to communicate with the "messenger"
+ *              By default uses the file system as a poor man's IPC to communicate with the "messenger"
  *              NeuralNetRunner::Model implementation in vic-engine's Vision System. See also VIC-2686.
+ *              Models configured with "transport":"sharedMemory" use a SharedMemoryTransport instead.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -17,10 +18,13 @@
 #define __Anki_NeuralNets_INeuralNetMain_H__
 
 #include "coretech/common/shared/types.h"
+#include "coretech/neuralnets/neuralNetScheduler.h"
 
 #include <list>
 #include <map>
+#include <memory>
 #include <string>
+#include <vector>
 
 
 namespace Json {
@@ -41,6 +45,7 @@ namespace Vision {
 namespace NeuralNets {
   
 class INeuralNetModel;
+class SharedMemoryTransport;
  
 class INeuralNetMain
 {
@@ -88,6 +93,8 @@ protected:
   virtual int GetPollPeriod_ms(const Json::Value& config) const = 0;
   
   // Define what happens at the end of each loop of Run() (e.g. a wait, check for shutdown, etc)
+  // A pollPeriod_ms of 0 means Run() already blocked waiting for new images (shared memory transport), so
+  // Step should only check for shutdown and not wait any further.
   virtual void Step(int pollPeriod_ms) = 0;
   
 private:
@@ -98,8 +105,41 @@ private:
                        const std::string& timestampFilename,
                        Vision::ImageRGB&  img);
   
+  // Where a scheduled job's image came from and thus where its results go
+  struct PendingOutput
+  {
+    const std::string*     networkName  = nullptr;
+    std::string            imagePath;
+    SharedMemoryTransport* sharedMemory = nullptr;
+    u32                    imageSeq     = 0;
+  };
+  
+  // If another job in this batch already decoded the same frame at the same input size, copy it instead of
+  // decoding this model's image file again. Returns true if img was populated that way.
+  bool GetSharedImage(const std::string& networkName, const std::string& imageFilename,
+                      const std::string& timestampFilename, const std::vector<NeuralNetScheduler::Job>& jobs,
+                      Vision::ImageRGB& img) const;
+  
+  bool WriteOutput(const INeuralNetModel& neuralNet, NeuralNetScheduler::Job& job,
+                   PendingOutput& output, bool imageFileProvided);
+  
+  // Runs the warm-up of the first model that still needs one, if any
+  void WarmUpNextModel();
+  
   std::map<std::string, std::unique_ptr<INeuralNetModel>> _neuralNets;
   
+  // Input (rows,cols) for each model, keyed by network name
+  std::map<std::string, std::pair<s32,s32>> _inputSizes;
+  
+  std::unique_ptr<NeuralNetScheduler> _scheduler;
+  
+  // Keyed by network name, only for models using the shared memory transport
+  std::map<std::string, std::unique_ptr<SharedMemoryTransport>> _sharedMemory;
+  
+  // How long to block waiting on the shared memory doorbell each loop of Run(). Only non-zero when the
+  // single configured model uses shared memory (and thus the wait can stand in for the poll period).
+  int  _sharedMemoryWait_ms = 0;
+  
   std::string _cachePath;
   std::string _imageFilename;
   
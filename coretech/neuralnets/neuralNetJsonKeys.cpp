@@ -28,9 +28,24 @@ namespace JsonKeys {
   const char* const PollingPeriod    = "pollPeriod_ms";
   const char* const TimeoutDuration  = "timeoutDuration_sec";
   const char* const VisualizationDir = "visualizationDirectory";
+  const char* const Transport        = "transport";
+  const char* const SharedMemoryNumSlots = "sharedMemoryNumSlots";
+  const char* const SchedulerNumThreads  = "schedulerNumThreads";
+  const char* const FallbackModel        = "fallbackModel";
+  
+  const char* const StreamHost            = "streamHost";
+  const char* const StreamPort            = "streamPort";
+  const char* const StreamJpegQuality     = "streamJpegQuality";
+  const char* const StreamMaxInFlight     = "streamMaxInFlight";
+  const char* const StreamConnectTimeout  = "streamConnectTimeout_ms";
+  const char* const StreamReconnectPeriod = "streamReconnectPeriod_ms";
   
   const char* const OffboardModelType = "offboard";
   const char* const TFLiteModelType   = "TFLite";
+  
+  const char* const FileTransport         = "file";
+  const char* const SharedMemoryTransport = "sharedMemory";
+  const char* const StreamTransport       = "stream";
 }
   
 } // namespace NeuralNets
@@ -29,11 +29,28 @@ namespace JsonKeys {
   extern const char* const PollingPeriod;
   extern const char* const TimeoutDuration;
   extern const char* const VisualizationDir;
+  extern const char* const Transport;
+  extern const char* const SharedMemoryNumSlots;
+  extern const char* const SchedulerNumThreads;
+  extern const char* const FallbackModel;
+  
+  // Settings for the stream transport:
+  extern const char* const StreamHost;
+  extern const char* const StreamPort;
+  extern const char* const StreamJpegQuality;
+  extern const char* const StreamMaxInFlight;
+  extern const char* const StreamConnectTimeout;
+  extern const char* const StreamReconnectPeriod;
   
   // Model types:
   extern const char* const OffboardModelType;
   extern const char* const TFLiteModelType;
   
+  // Transports between engine and neural net process:
+  extern const char* const FileTransport;
+  extern const char* const SharedMemoryTransport;
+  extern const char* const StreamTransport;
+  
 }
   
 } // namespace NeuralNets
@@ -34,6 +34,10 @@ public:
   
   bool IsVerbose() const { return _params.verbose; }
   
+  // Used by NeuralNetScheduler to order models sharing a batch
+  s32 GetPriority()    const { return _params.priority; }
+  s32 GetDeadline_ms() const { return _params.deadline_ms; }
+  
   // Subclasses are expected to overload the LoadModel and Detect methods below.
   // Note that we are not using virtual abstract methods here because we have no need for polymorphism.
   // There will only ever be one "type" of NeuralNetModel present compiled into the system.
@@ -47,6 +51,11 @@ public:
   // Note that the input imge could be modified (e.g. resized in place)
   virtual Result Detect(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints) = 0;
   
+  // Models whose first inference is much slower than the rest (lazy allocation, caches, delegate setup) can do
+  // that work early with a throwaway run while the process is otherwise idle
+  virtual bool   NeedsWarmUp() const { return false; }
+  virtual Result WarmUp() { return RESULT_OK; }
+  
   const std::string& GetName() const { return _name; }
   
 protected:
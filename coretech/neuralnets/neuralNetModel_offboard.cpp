@@ -16,6 +16,12 @@
 #include "coretech/neuralnets/neuralNetFilenames.h"
 #include "coretech/neuralnets/neuralNetJsonKeys.h"
 #include "coretech/neuralnets/neuralNetModel_offboard.h"
+#include "coretech/neuralnets/neuralNetSharedMemory.h"
+#include "coretech/neuralnets/neuralNetStreamTransport.h"
+
+#if defined(ANKI_NEURALNETS_USE_TFLITE)
+#  include "coretech/neuralnets/neuralNetModel_tflite.h"
+#endif
 
 #include "util/fileUtils/fileUtils.h"
 
@@ -35,6 +41,10 @@ OffboardModel::OffboardModel(const std::string& cachePath)
 
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Must be implemented here (in .cpp) due to use of unique_ptr with a forward declaration
+OffboardModel::~OffboardModel() = default;
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result OffboardModel::LoadModelInternal(const std::string& modelPath, const Json::Value& config)
 {
@@ -65,6 +75,45 @@ Result OffboardModel::LoadModelInternal(const std::string& modelPath, const Json
              _timeoutDuration_sec);
   }
 
+  std::string transport = NeuralNets::JsonKeys::FileTransport;
+  JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::Transport, transport);
+  if(NeuralNets::JsonKeys::SharedMemoryTransport == transport)
+  {
+    s32 inputHeight = 0, inputWidth = 0, numSlots = 2;
+    if(!JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::InputHeight, inputHeight) ||
+       !JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::InputWidth, inputWidth))
+    {
+      LOG_ERROR("OffboardModel.LoadModelInternal.SharedMemoryNeedsInputSize", "");
+      return RESULT_FAIL;
+    }
+    JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::SharedMemoryNumSlots, numSlots);
+    
+    _sharedMemory.reset(new SharedMemoryTransport());
+    const Result result = _sharedMemory->Init(GetName(), SharedMemoryTransport::Role::Producer,
+                                              inputHeight, inputWidth, numSlots);
+    if(RESULT_OK != result)
+    {
+      LOG_ERROR("OffboardModel.LoadModelInternal.SharedMemoryInitFailed", "");
+      _sharedMemory.reset();
+      return result;
+    }
+  }
+  else if(NeuralNets::JsonKeys::StreamTransport == transport)
+  {
+    const Result result = InitStream(modelPath, config);
+    if(RESULT_OK != result)
+    {
+      _stream.reset();
+      _fallbackModel.reset();
+      return result;
+    }
+  }
+  else if(NeuralNets::JsonKeys::FileTransport != transport)
+  {
+    LOG_ERROR("OffboardModel.LoadModelInternal.UnknownTransport", "%s", transport.c_str());
+    return RESULT_FAIL;
+  }
+
   return RESULT_OK;
 }
 
@@ -73,6 +122,162 @@ Result OffboardModel::Detect(Vision::ImageRGB& img, std::list<Vision::SalientPoi
 {
   salientPoints.clear();
 
+  if(_sharedMemory)
+  {
+    return DetectWithSharedMemory(img, salientPoints);
+  }
+  
+  if(_stream)
+  {
+    return DetectWithStream(img, salientPoints);
+  }
+  
+  return DetectWithFiles(img, salientPoints);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result OffboardModel::DetectWithSharedMemory(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints)
+{
+  u32 imageSeq = 0;
+  const Result result = _sharedMemory->WriteImage(img, imageSeq);
+  if(RESULT_OK != result)
+  {
+    LOG_ERROR("OffboardModel.DetectWithSharedMemory.WriteImageFailed", "t:%d", img.GetTimestamp());
+    return result;
+  }
+
+  LOG_DEBUG("OffboardModel.DetectWithSharedMemory.WroteImage", "t:%d Seq:%u", img.GetTimestamp(), imageSeq);
+
+  const bool resultAvailable = _sharedMemory->WaitForResults(imageSeq, _timeoutDuration_sec, salientPoints);
+  if(!resultAvailable)
+  {
+    LOG_WARNING("OffboardModel.DetectWithSharedMemory.WaitForResultTimedOut",
+                "t:%d Seq:%u Timeout:%.1fsec Dropped:%u",
+                img.GetTimestamp(), imageSeq, _timeoutDuration_sec, _sharedMemory->GetNumDroppedFrames());
+  }
+  
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result OffboardModel::InitStream(const std::string& modelPath, const Json::Value& config)
+{
+  std::string host;
+  s32 port = 0, jpegQuality = 80, maxInFlight = 2, connectTimeout_ms = 1000, reconnectPeriod_ms = 5000;
+  if(!JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::StreamHost, host) ||
+     !JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::StreamPort, port))
+  {
+    LOG_ERROR("OffboardModel.InitStream.MissingHostOrPort", "");
+    return RESULT_FAIL;
+  }
+  JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::StreamJpegQuality, jpegQuality);
+  JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::StreamMaxInFlight, maxInFlight);
+  JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::StreamConnectTimeout, connectTimeout_ms);
+  JsonTools::GetValueOptional(config, NeuralNets::JsonKeys::StreamReconnectPeriod, reconnectPeriod_ms);
+
+  if(port <= 0 || port > 0xFFFF || maxInFlight < 1)
+  {
+    LOG_ERROR("OffboardModel.InitStream.InvalidConfig", "Port:%d MaxInFlight:%d", port, maxInFlight);
+    return RESULT_FAIL;
+  }
+  _maxInFlight = static_cast<size_t>(maxInFlight);
+
+  _stream.reset(new StreamTransport());
+  Result result = _stream->Init(host, static_cast<u16>(port), jpegQuality, connectTimeout_ms, reconnectPeriod_ms);
+  if(RESULT_OK != result)
+  {
+    LOG_ERROR("OffboardModel.InitStream.InitFailed", "");
+    return result;
+  }
+
+  if(config.isMember(NeuralNets::JsonKeys::FallbackModel))
+  {
+#if defined(ANKI_NEURALNETS_USE_TFLITE)
+    Json::Value fallbackConfig = config[NeuralNets::JsonKeys::FallbackModel];
+    if(!fallbackConfig.isMember(NeuralNets::JsonKeys::NetworkName))
+    {
+      fallbackConfig[NeuralNets::JsonKeys::NetworkName] = GetName();
+    }
+    _fallbackModel.reset(new TFLiteModel());
+    result = _fallbackModel->LoadModel(modelPath, fallbackConfig);
+    if(RESULT_OK != result)
+    {
+      LOG_ERROR("OffboardModel.InitStream.FallbackModelLoadFailed", "");
+      return result;
+    }
+#else
+    LOG_ERROR("OffboardModel.InitStream.FallbackModelNeedsTFLite", "");
+    return RESULT_FAIL;
+#endif
+  }
+
+  LOG_INFO("OffboardModel.InitStream.Success", "Server: %s:%d, MaxInFlight: %d, Fallback: %s",
+           host.c_str(), port, maxInFlight, (_fallbackModel ? "yes" : "no"));
+
+  // Connect now rather than on the first frame (it is fine if the server isn't up yet)
+  _stream->Connect();
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result OffboardModel::DetectWithStream(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints)
+{
+  u32 imageSeq = 0;
+  if(!_stream->Connect() || (RESULT_OK != _stream->SendImage(img, imageSeq)))
+  {
+    return DetectWithFallback(img, salientPoints);
+  }
+
+  LOG_DEBUG("OffboardModel.DetectWithStream.SentImage", "t:%d Seq:%u", img.GetTimestamp(), imageSeq);
+
+  // Only wait once the pipeline is full, so the round trip for one frame overlaps with sending the next. The
+  // results returned may then be for an earlier frame, but SalientPoints carry the timestamp of their own image.
+  const bool pipelineFull = (_stream->GetNumInFlight() >= _maxInFlight);
+  const s32 timeout_ms = (pipelineFull ? static_cast<s32>(_timeoutDuration_sec * 1000.f) : 0);
+
+  u32 resultSeq = 0;
+  if(_stream->ReceiveResults(timeout_ms, salientPoints, resultSeq))
+  {
+    LOG_DEBUG("OffboardModel.DetectWithStream.GotResults", "Seq:%u NumPoints:%zu Latency:%dms",
+              resultSeq, salientPoints.size(), _stream->GetLastLatency_ms());
+    return RESULT_OK;
+  }
+
+  if(pipelineFull && _stream->IsConnected())
+  {
+    // Server is connected but stuck: drop it so we fall back until it comes back
+    LOG_WARNING("OffboardModel.DetectWithStream.WaitForResultTimedOut", "t:%d Seq:%u Timeout:%.1fsec",
+                img.GetTimestamp(), imageSeq, _timeoutDuration_sec);
+    _stream->Disconnect();
+  }
+
+  if(!_stream->IsConnected())
+  {
+    return DetectWithFallback(img, salientPoints);
+  }
+
+  // Results still on their way
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result OffboardModel::DetectWithFallback(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints)
+{
+  salientPoints.clear();
+  if(!_fallbackModel)
+  {
+    // Nothing to run locally: same as timing out waiting for results
+    return RESULT_OK;
+  }
+
+  LOG_DEBUG("OffboardModel.DetectWithFallback", "t:%d", img.GetTimestamp());
+  return _fallbackModel->Detect(img, salientPoints);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result OffboardModel::DetectWithFiles(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints)
+{
   const std::string imageFilename = Util::FileUtils::FullFilePath({_cachePath, NeuralNets::Filenames::Image});
   {
     // Write image to a temporary file
@@ -8,6 +8,13 @@
  *              a neural network model but instead communicates with an "offboard" process via file I/O.
  *              This eventually could be a local laptop, the cloud, or simply another process on the same device.
  *
+ *              When "transport" is "sharedMemory" in the config, images and results are instead exchanged with
+ *              another process on the same device via a SharedMemoryTransport, avoiding PNG/JSON file I/O.
+ *
+ *              When it is "stream", JPEG frames go to a server on another machine over a persistent TCP connection
+ *              (see StreamTransport), with up to "streamMaxInFlight" frames awaiting results at once. While that
+ *              server can't be reached, frames are run through the optional local "fallbackModel" instead.
+ *
  * Copyright: Anki, Inc. 2018
  **/
 
@@ -16,27 +23,48 @@
 
 #include "coretech/neuralnets/neuralNetModel_interface.h"
 
+#include <memory>
+
 namespace Anki {
 namespace NeuralNets {
 
+class SharedMemoryTransport;
+class StreamTransport;
+  
 class OffboardModel : public INeuralNetModel
 {
 public:
   
   explicit OffboardModel(const std::string& cachePath);
   
-  virtual ~OffboardModel() = default;
+  virtual ~OffboardModel();
   
   virtual Result Detect(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints) override;
   
   bool IsVerbose() const { return _isVerbose; }
   
+  // Only the local fallback model, if any, has anything to warm up
+  virtual bool   NeedsWarmUp() const override { return (_fallbackModel && _fallbackModel->NeedsWarmUp()); }
+  virtual Result WarmUp() override { return (_fallbackModel ? _fallbackModel->WarmUp() : RESULT_OK); }
+  
 protected:
   
   virtual Result LoadModelInternal(const std::string& modelPath, const Json::Value& config) override;
   
 private:
   
+  Result DetectWithFiles(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints);
+  Result DetectWithSharedMemory(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints);
+  Result DetectWithStream(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints);
+  Result DetectWithFallback(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints);
+  
+  Result InitStream(const std::string& modelPath, const Json::Value& config);
+  
+  std::unique_ptr<SharedMemoryTransport> _sharedMemory; // null unless using shared memory transport
+  std::unique_ptr<StreamTransport>       _stream;       // null unless using stream transport
+  std::unique_ptr<INeuralNetModel>       _fallbackModel; // run locally while the stream is disconnected, if any
+  size_t                                 _maxInFlight = 1;
+  
   std::string _cachePath;
   int         _pollPeriod_ms;
   bool        _isVerbose = false;
@@ -105,15 +105,20 @@ Result NeuralNetModel::LoadModel(const std::string& modelPath, const Json::Value
 
   if(_params.memoryMapGraph)
   {
-    // Using memory-mapped graphs needs more testing/work, but this is a start. (VIC-3141)
-    
-    // See also: https://www.tensorflow.org/mobile/optimizing
+    // The graph must have been converted with convert_graphdef_memmapped_format so that its weights can be
+    // mapped straight from the file (see also: https://www.tensorflow.org/mobile/optimizing)
 
     // Note that this is a class member because it needs to persist as long as we
     // use the graph referring to it
     _memmappedEnv.reset(new tensorflow::MemmappedEnv(tensorflow::Env::Default()));
 
     tensorflow::Status mmapStatus = _memmappedEnv->InitializeFromFile(graphFileName);
+    if (!mmapStatus.ok())
+    {
+      PRINT_NAMED_ERROR("NeuralNetModel.Model.LoadGraph.MemoryMapFailed",
+                        "%s Status: %s", graphFileName.c_str(), mmapStatus.ToString().c_str());
+      return RESULT_FAIL;
+    }
     
     tensorflow::Status loadGraphStatus = ReadBinaryProto(_memmappedEnv.get(),
         tensorflow::MemmappedFileSystem::kMemmappedPackageDefaultGraphDef,
@@ -14,6 +14,9 @@
 
 #include "coretech/neuralnets/neuralNetModel_tflite.h"
 #include "coretech/vision/engine/image_impl.h"
+#include <chrono>
+#include <cmath>
+#include <cstring>
 #include <list>
 #include <queue>
 
@@ -32,9 +35,6 @@ namespace NeuralNets {
 
 #define LOG_CHANNEL "NeuralNets"
 
-// TODO: Make this a parameter in config?
-constexpr int kNumThreads = 1;
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 namespace {
 
@@ -52,6 +52,19 @@ struct TFLiteLogReporter : public tflite::ErrorReporter {
 
 TFLiteLogReporter gLogReporter;
 
+// Invoke times are summarized in the log once per this many runs of each model
+constexpr s32 kInvokeTimeReportPeriod = 100;
+
+const char* GetDelegateName(NeuralNetParams::Delegate delegate)
+{
+  switch(delegate)
+  {
+    case NeuralNetParams::Delegate::CPU:   return "cpu";
+    case NeuralNetParams::Delegate::NNAPI: return "nnapi";
+  }
+  return "unknown";
+}
+
 } // anonymous namespace
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -74,8 +87,6 @@ Result TFLiteModel::LoadModelInternal(const std::string& modelPath, const Json::
 
   DEV_ASSERT(!modelPath.empty(), "TFLiteModel.LoadModelInternal.EmptyModelPath");
 
-  std::vector<int> sizes = {1, _params.inputHeight, _params.inputWidth, 3};
-
   const std::string graphFileName = Util::FileUtils::FullFilePath({modelPath,_params.graphFile});
 
   if(!Util::FileUtils::FileExists(graphFileName))
@@ -84,6 +95,7 @@ Result TFLiteModel::LoadModelInternal(const std::string& modelPath, const Json::
     return RESULT_FAIL;
   }
 
+  // Maps the file rather than reading it, so weights are only paged in as the interpreter touches them
   _model = tflite::FlatBufferModel::BuildFromFile(graphFileName.c_str(), &gLogReporter);
 
   if (!_model)
@@ -98,6 +110,38 @@ Result TFLiteModel::LoadModelInternal(const std::string& modelPath, const Json::
   //_model->error_reporter();
   //LOG_INFO("TFLiteModel.LoadModelInternal.ResolvedReporter", "");
 
+  _hasInputScaling = (config.isMember("inputScale") || config.isMember("inputShift"));
+
+  if(!_params.allocateOnFirstUse)
+  {
+    const Result buildResult = BuildInterpreter();
+    if(RESULT_OK != buildResult)
+    {
+      return buildResult;
+    }
+  }
+
+  // Read the label list
+  const std::string labelsFileName = Util::FileUtils::FullFilePath({modelPath, _params.labelsFile});
+  const Result readLabelsResult = ReadLabelsFile(labelsFileName, _labels);
+  if(RESULT_OK != readLabelsResult)
+  {
+    return readLabelsResult;
+  }
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result TFLiteModel::BuildInterpreter()
+{
+  if(_interpreter)
+  {
+    return RESULT_OK;
+  }
+
+  DEV_ASSERT(_model != nullptr, "TFLiteModel.BuildInterpreter.NullModel");
+
 #ifdef TFLITE_CUSTOM_OPS_HEADER
   tflite::MutableOpResolver resolver;
   RegisterSelectedOps(&resolver);
@@ -108,35 +152,101 @@ Result TFLiteModel::LoadModelInternal(const std::string& modelPath, const Json::
   tflite::InterpreterBuilder(*_model, resolver)(&_interpreter);
   if (!_interpreter)
   {
-    LOG_ERROR("TFLiteModel.LoadModelInternal.FailedToConstructInterpreter", "");
+    LOG_ERROR("TFLiteModel.BuildInterpreter.FailedToConstructInterpreter", "%s", GetName().c_str());
     return RESULT_FAIL;
   }
 
-  if (kNumThreads != -1)
+  if (_params.numThreads != -1)
+  {
+    _interpreter->SetNumThreads(_params.numThreads);
+  }
+
+  if (NeuralNetParams::Delegate::NNAPI == _params.delegate)
   {
-    _interpreter->SetNumThreads(kNumThreads);
+    _interpreter->UseNNAPI(true);
+    _usingDelegate = true;
   }
 
+  const std::vector<int> sizes = {1, _params.inputHeight, _params.inputWidth, 3};
   const int input = _interpreter->inputs()[0];
   _interpreter->ResizeInputTensor(input, sizes);
 
   if (_interpreter->AllocateTensors() != kTfLiteOk)
   {
-    LOG_ERROR("TFLiteModel.LoadModelInternal.FailedToAllocateTensors", "");
+    LOG_ERROR("TFLiteModel.BuildInterpreter.FailedToAllocateTensors", "%s", GetName().c_str());
+    _interpreter.reset();
     return RESULT_FAIL;
   }
+  
+  size_t tensorBytes = 0;
+  for (size_t i = 0; i < _interpreter->tensors_size(); ++i)
+  {
+    tensorBytes += _interpreter->tensor(static_cast<int>(i))->bytes;
+  }
+  _memoryAccount.Set(tensorBytes);
+  LOG_INFO("TFLiteModel.BuildInterpreter.TensorBytes", "%s: %zu tensors use %zu bytes",
+           GetName().c_str(), _interpreter->tensors_size(), tensorBytes);
 
-  // Read the label list
-  const std::string labelsFileName = Util::FileUtils::FullFilePath({modelPath, _params.labelsFile});
-  const Result readLabelsResult = ReadLabelsFile(labelsFileName, _labels);
-  if(RESULT_OK != readLabelsResult)
+  const Result inputResult = SetUpInput();
+  if(RESULT_OK != inputResult)
   {
-    return readLabelsResult;
+    _interpreter.reset();
+    _memoryAccount.Set(0);
+    return inputResult;
   }
 
   return RESULT_OK;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result TFLiteModel::SetUpInput()
+{
+  const int inputIndex = _interpreter->inputs()[0];
+  const TfLiteTensor* inputTensor = _interpreter->tensor(inputIndex);
+
+  const TfLiteType expectedType = (_params.useFloatInput ? kTfLiteFloat32 : kTfLiteUInt8);
+  if(inputTensor->type != expectedType)
+  {
+    LOG_ERROR("TFLiteModel.SetUpInput.WrongInputType", "%s: useFloatInput=%d but graph's input type is %d",
+              GetName().c_str(), _params.useFloatInput, inputTensor->type);
+    return RESULT_FAIL;
+  }
+
+  // Quantized graphs without inputScale/inputShift in their config are fed raw pixel values, as they always were
+  _useInputLUT = false;
+  if(_params.useFloatInput || !_hasInputScaling)
+  {
+    return RESULT_OK;
+  }
+
+  const float quantScale = inputTensor->params.scale;
+  const int quantZeroPoint = inputTensor->params.zero_point;
+  if(quantScale <= 0.f)
+  {
+    LOG_ERROR("TFLiteModel.SetUpInput.InputNotQuantized", "%s: uint8 input has no quantization scale",
+              GetName().c_str());
+    return RESULT_FAIL;
+  }
+
+  // Only 256 possible pixel values, so quantizing is a table lookup. Tables that are never more than one step
+  // off the raw values (e.g. [-1,1] inputs quantized with zero point 128) aren't worth applying.
+  bool isIdentity = true;
+  for(s32 value = 0; value < 256; ++value)
+  {
+    const float realValue = (float)value / _params.inputScale + _params.inputShift;
+    const s32 quantValue = (s32)std::round(realValue / quantScale) + quantZeroPoint;
+    _inputLUT[value] = (u8)std::max(0, std::min(255, quantValue));
+    isIdentity &= (std::abs((s32)_inputLUT[value] - value) <= 1);
+  }
+  _useInputLUT = !isIdentity;
+
+  LOG_INFO("TFLiteModel.SetUpInput.QuantizedInput", "%s: Scale:%f ZeroPoint:%d %s",
+           GetName().c_str(), quantScale, quantZeroPoint,
+           (_useInputLUT ? "Quantizing pixels" : "Using raw pixels"));
+
+  return RESULT_OK;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TFLiteModel::ScaleImage(Vision::ImageRGB& img)
 {
@@ -177,21 +287,115 @@ void TFLiteModel::ScaleImage(Vision::ImageRGB& img)
     uint8_t* scaledInputData = _interpreter->typed_tensor<uint8_t>(inputIndex);
     Vision::ImageRGB tensorImg(_params.inputHeight, _params.inputWidth, scaledInputData);
     img.Resize(tensorImg, kResizeMethod);
+
+    if(_useInputLUT)
+    {
+      // Quantize in place, after resizing so there are fewer pixels to do
+      const cv::Mat lut(1, 256, CV_8U, _inputLUT.data());
+      cv::LUT(tensorImg.get_CvMat_(), lut, tensorImg.get_CvMat_());
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result TFLiteModel::Invoke()
+{
+  const auto startTime = std::chrono::steady_clock::now();
+
+  auto invokeResult = _interpreter->Invoke();
+  if (kTfLiteOk != invokeResult && _usingDelegate)
+  {
+    LOG_WARNING("TFLiteModel.Invoke.DelegateFailed", "%s: %s failed, using the cpu from now on",
+                GetName().c_str(), GetDelegateName(_params.delegate));
+    _interpreter->UseNNAPI(false);
+    _usingDelegate = false;
+    invokeResult = _interpreter->Invoke();
+  }
+
+  if (kTfLiteOk != invokeResult)
+  {
+    LOG_ERROR("TFLiteModel.Detect.FailedToInvoke", "");
+    return RESULT_FAIL;
+  }
+
+  const auto elapsed = std::chrono::steady_clock::now() - startTime;
+  const f32 invokeTime_ms = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() * 0.001f;
+  ++_numInvokes;
+  _totalInvokeTime_ms += invokeTime_ms;
+  _maxInvokeTime_ms = std::max(_maxInvokeTime_ms, invokeTime_ms);
+
+  if (_params.verbose)
+  {
+    LOG_INFO("TFLiteModel.Invoke.Time", "%s: %.1fms", GetName().c_str(), invokeTime_ms);
+  }
+
+  if (_numInvokes >= kInvokeTimeReportPeriod)
+  {
+    LOG_INFO("TFLiteModel.Invoke.TimeSummary", "%s: Avg:%.1fms Max:%.1fms over %d runs (%s, %s input)",
+             GetName().c_str(), _totalInvokeTime_ms / (f32)_numInvokes, _maxInvokeTime_ms, _numInvokes,
+             GetDelegateName(_usingDelegate ? _params.delegate : NeuralNetParams::Delegate::CPU),
+             (_params.useFloatInput ? "float" : "uint8"));
+    _numInvokes = 0;
+    _totalInvokeTime_ms = 0.f;
+    _maxInvokeTime_ms = 0.f;
+  }
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result TFLiteModel::WarmUp()
+{
+  // Only tried once: a model that can't build or run will report that again on its first detection
+  _hasRun = true;
+
+  const Result buildResult = BuildInterpreter();
+  if(RESULT_OK != buildResult)
+  {
+    return buildResult;
   }
+
+  // Contents don't matter, only that every kernel runs once (and the delegate, if any, gets set up)
+  TfLiteTensor* inputTensor = _interpreter->tensor(_interpreter->inputs()[0]);
+  memset(inputTensor->data.raw, 0, inputTensor->bytes);
+
+  const auto startTime = std::chrono::steady_clock::now();
+  const Result invokeResult = Invoke();
+  const auto elapsed = std::chrono::steady_clock::now() - startTime;
+  if(RESULT_OK != invokeResult)
+  {
+    return invokeResult;
+  }
+
+  // Nothing else has run yet, so this just keeps the slow first run out of the reported times
+  _numInvokes = 0;
+  _totalInvokeTime_ms = 0.f;
+  _maxInvokeTime_ms = 0.f;
+
+  LOG_INFO("TFLiteModel.WarmUp.Done", "%s: %.1fms",
+           GetName().c_str(), std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() * 0.001f);
+
+  return RESULT_OK;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result TFLiteModel::Detect(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints)
 {
+  const Result buildResult = BuildInterpreter();
+  if(RESULT_OK != buildResult)
+  {
+    return buildResult;
+  }
+  _hasRun = true;
+
   // Scale image, subtract mean, divide by standard deviation and store in the interpreter's input tensor
   ScaleImage(img);
 
   if (_params.benchmarkRuns == 0){
-    const auto invokeResult = _interpreter->Invoke();
-    if (kTfLiteOk != invokeResult)
+    const Result invokeResult = Invoke();
+    if (RESULT_OK != invokeResult)
     {
-      LOG_ERROR("TFLiteModel.Detect.FailedToInvoke", "");
-      return RESULT_FAIL;
+      return invokeResult;
     }
   }
   else
@@ -16,7 +16,9 @@
 #define __Anki_NeuralNets_NeuralNetModel_TFLite_H__
 
 #include "coretech/neuralnets/neuralNetModel_interface.h"
+#include "util/memoryAccounting/memoryAccounting.h"
 
+#include <array>
 #include <list>
 
 // Forward declaration
@@ -38,6 +40,10 @@ public:
   
   virtual Result Detect(Vision::ImageRGB& img, std::list<Vision::SalientPoint>& salientPoints) override;
   
+  // Builds the interpreter if that was put off and runs it once on a blank input
+  virtual bool   NeedsWarmUp() const override { return !_hasRun; }
+  virtual Result WarmUp() override;
+  
 protected:
   
   virtual Result LoadModelInternal(const std::string& modelPath, const Json::Value& config) override;
@@ -46,8 +52,36 @@ private:
   
   void ScaleImage(Vision::ImageRGB& img);
   
+  // Builds the interpreter for the mapped model and allocates its tensors. Only done once.
+  Result BuildInterpreter();
+  
+  // Checks the input tensor's type against the params and, for quantized graphs, sets up _inputLUT
+  Result SetUpInput();
+  
+  // Runs the graph once, timing it. Falls back on the CPU for good if the delegate fails.
+  Result Invoke();
+  
   std::unique_ptr<tflite::FlatBufferModel> _model;
   std::unique_ptr<tflite::Interpreter>     _interpreter;
+  
+  // For quantized graphs whose input doesn't take the raw pixel values: maps each resized pixel value to the
+  // quantized value of inputScale/inputShift applied to it
+  bool               _hasInputScaling = false; // inputScale/inputShift were in the config
+  bool               _useInputLUT = false;
+  std::array<u8,256> _inputLUT;
+  
+  // Whether any inference (detection or warm-up) has been attempted yet
+  bool               _hasRun = false;
+  
+  bool               _usingDelegate = false;
+  
+  // Invoke times since they were last reported
+  s32                _numInvokes = 0;
+  f32                _totalInvokeTime_ms = 0.f;
+  f32                _maxInvokeTime_ms = 0.f;
+  
+  // All the interpreter's tensors: weights mapped from the model file as well as the activations arena
+  Util::MemoryAccount _memoryAccount{Util::MemoryTag::NeuralNets};
 
 }; // class NeuralNetModel
 
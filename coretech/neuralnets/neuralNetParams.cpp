@@ -76,6 +76,30 @@ Result NeuralNetParams::SetFromConfig(const Json::Value& config)
   GetFromConfig(memoryMapGraph);
   GetFromConfig(benchmarkRuns);
 
+  // Optional scheduling/threading parameters
+  if(config.isMember("numThreads"))
+  {
+    SetFromConfigHelper(config["numThreads"], numThreads);
+  }
+  if(config.isMember("priority"))
+  {
+    SetFromConfigHelper(config["priority"], priority);
+  }
+  if(config.isMember("deadline_ms"))
+  {
+    SetFromConfigHelper(config["deadline_ms"], deadline_ms);
+  }
+  if(config.isMember("allocateOnFirstUse"))
+  {
+    SetFromConfigHelper(config["allocateOnFirstUse"], allocateOnFirstUse);
+  }
+  
+  const Result delegateResult = SetDelegateFromConfig(config);
+  if(RESULT_OK != delegateResult)
+  {
+    return delegateResult;
+  }
+  
   if (config.isMember(JsonKeys::VisualizationDir))
   {
     GetFromConfig(visualizationDirectory);
@@ -145,10 +169,21 @@ Result NeuralNetParams::SetFromConfig(const Json::Value& config)
   
   if(useFloatInput)
   {
-    // NOTE: Only used when processing in floating point
     GetFromConfig(inputShift);
     GetFromConfig(inputScale);
   }
+  else
+  {
+    // Quantized graphs whose input quantization already matches the raw pixel values can leave these out
+    if(config.isMember("inputShift"))
+    {
+      SetFromConfigHelper(config["inputShift"], inputShift);
+    }
+    if(config.isMember("inputScale"))
+    {
+      SetFromConfigHelper(config["inputScale"], inputScale);
+    }
+  }
   
   if(OutputType::Classification == outputType)
   {
@@ -220,5 +255,38 @@ Result NeuralNetParams::SetOutputTypeFromConfig(const Json::Value& config)
   return RESULT_OK;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result NeuralNetParams::SetDelegateFromConfig(const Json::Value& config)
+{
+  if(!config.isMember("delegate"))
+  {
+    delegate = Delegate::CPU;
+    return RESULT_OK;
+  }
+  
+  std::string delegateStr;
+  SetFromConfigHelper(config["delegate"], delegateStr);
+  
+  const std::map<std::string, Delegate> kDelegateMap{
+    {"cpu",   Delegate::CPU  },
+    {"nnapi", Delegate::NNAPI},
+  };
+  
+  auto iter = kDelegateMap.find(delegateStr);
+  if(iter == kDelegateMap.end()) {
+    std::string validKeys;
+    for(auto const& entry : kDelegateMap) {
+      validKeys += entry.first;
+      validKeys += " ";
+    }
+    PRINT_NAMED_ERROR("NeuralNetParams.SetDelegateFromConfig.BadDelegate", "%s. Valid delegates: %s",
+                      delegateStr.c_str(), validKeys.c_str());
+    return RESULT_FAIL;
+  }
+  
+  delegate = iter->second;
+  return RESULT_OK;
+}
+
 } // namespace NeuralNets
 } // namespace Anki
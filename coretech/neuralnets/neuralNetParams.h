@@ -19,6 +19,12 @@ struct NeuralNetParams
     Segmentation,       // "segmentation"
   };
   
+  // Optional in config, where inference runs (string to use in JSON config shown for each)
+  enum class Delegate {
+    CPU,                // "cpu" (default): TFLite's own kernels
+    NNAPI,              // "nnapi": Android Neural Networks API, falling back on the CPU if it fails
+  };
+  
   std::string               graphFile;
   std::string               labelsFile;
   std::string               architecture;
@@ -28,6 +34,7 @@ struct NeuralNetParams
   
   // When input to graph is float, data is first divided by scale and then shifted
   // I.e.:  float_input = data / scale + shift
+  // Quantized (uint8) graphs expect the same real values, encoded with their input tensor's quantization
   float                     inputShift = 0.f;
   float                     inputScale = 255.f;
   
@@ -52,13 +59,28 @@ struct NeuralNetParams
   
   bool                      verbose = false;
   
+  // Number of threads the interpreter itself may use for a single inference (-1 lets the platform decide)
+  int32_t                   numThreads = 1;
+  
+  Delegate                  delegate = Delegate::CPU;
+  
+  // Scheduling when several models have an image to process at the same time: higher priority models are
+  // started first, and models with a shorter deadline (from when the batch started, 0 for none) break ties.
+  int32_t                   priority = 0;
+  int32_t                   deadline_ms = 0;
+  
   // Number of times to run benchmarking and report to logs, if this value
   // is zero benchmarking will not be run
   int32_t                   benchmarkRuns = 0;
   
-  // TODO: Not fully supported yet (VIC-3141)
+  // TensorFlow graphs converted with convert_graphdef_memmapped_format are mapped instead of read into memory.
+  // TFLite models are always mapped, so this only matters for TensorFlow.
   bool                      memoryMapGraph = false;
   
+  // TFLite: build the interpreter and allocate its tensors the first time the model is used (a detection or
+  // warm-up run) instead of at load, so models that aren't needed yet don't slow startup or hold memory
+  bool                      allocateOnFirstUse = false;
+  
   std::string               visualizationDirectory = ""; 
 
   // Populate from Json config
@@ -72,6 +94,8 @@ private:
   // Must be called after input/output_layer_names have been set
   Result SetOutputTypeFromConfig(const Json::Value& config);
   
+  Result SetDelegateFromConfig(const Json::Value& config);
+  
 }; // struct NeuralNetParams
   
 } // namespace NeuralNets
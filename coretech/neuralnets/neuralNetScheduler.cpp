@@ -0,0 +1,151 @@
+/**
+ * File: neuralNetScheduler.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "coretech/neuralnets/neuralNetModel_interface.h"
+#include "coretech/neuralnets/neuralNetScheduler.h"
+
+#include "util/logging/logging.h"
+#include "util/threading/threadPriority.h"
+
+#include <algorithm>
+
+#define LOG_CHANNEL "NeuralNets"
+
+namespace Anki {
+namespace NeuralNets {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+NeuralNetScheduler::NeuralNetScheduler(s32 numThreads)
+{
+  for(s32 i=0; i<numThreads; ++i)
+  {
+    _workers.emplace_back(&NeuralNetScheduler::WorkerLoop, this, i);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+NeuralNetScheduler::~NeuralNetScheduler()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shutdown = true;
+  }
+  _workAvailable.notify_all();
+  for(auto& worker : _workers)
+  {
+    if(worker.joinable())
+    {
+      worker.join();
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void NeuralNetScheduler::RunBatch(std::vector<Job>& jobs)
+{
+  if(jobs.empty())
+  {
+    return;
+  }
+
+  std::vector<Job*> ordered;
+  ordered.reserve(jobs.size());
+  for(auto& job : jobs)
+  {
+    DEV_ASSERT(nullptr != job.model, "NeuralNetScheduler.RunBatch.NullModel");
+    ordered.push_back(&job);
+  }
+
+  // Highest priority first. Within a priority, earliest (non-zero) deadline first. Stable so config order
+  // decides the rest.
+  std::stable_sort(ordered.begin(), ordered.end(), [](const Job* a, const Job* b) {
+    const s32 priorityA = a->model->GetPriority();
+    const s32 priorityB = b->model->GetPriority();
+    if(priorityA != priorityB)
+    {
+      return priorityA > priorityB;
+    }
+    const s32 deadlineA = a->model->GetDeadline_ms();
+    const s32 deadlineB = b->model->GetDeadline_ms();
+    if(deadlineA > 0 && deadlineB > 0)
+    {
+      return deadlineA < deadlineB;
+    }
+    return (deadlineA > 0 && deadlineB <= 0);
+  });
+
+  _batchStartTime = std::chrono::steady_clock::now();
+
+  if(_workers.empty())
+  {
+    for(auto* job : ordered)
+    {
+      RunJob(*job);
+    }
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  _pending = std::move(ordered);
+  _nextPending = 0;
+  _numRemaining = _pending.size();
+  _workAvailable.notify_all();
+  _batchComplete.wait(lock, [this]() { return 0 == _numRemaining; });
+  _pending.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void NeuralNetScheduler::RunJob(Job& job)
+{
+  job.salientPoints.clear();
+  job.result = job.model->Detect(job.img, job.salientPoints);
+
+  const auto elapsed = std::chrono::steady_clock::now() - _batchStartTime;
+  job.latency_ms = std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() * 0.001f;
+
+  const s32 deadline_ms = job.model->GetDeadline_ms();
+  job.missedDeadline = (deadline_ms > 0 && job.latency_ms > deadline_ms);
+  if(job.missedDeadline)
+  {
+    LOG_PERIODIC_INFO(30, "NeuralNetScheduler.RunJob.MissedDeadline", "%s: %.1fms > %dms",
+                      job.model->GetName().c_str(), job.latency_ms, deadline_ms);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void NeuralNetScheduler::WorkerLoop(s32 index)
+{
+  Util::SetThreadName(pthread_self(), "NeuralNetWork" + std::to_string(index));
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  while(true)
+  {
+    _workAvailable.wait(lock, [this]() { return _shutdown || _nextPending < _pending.size(); });
+    if(_shutdown)
+    {
+      return;
+    }
+
+    Job* job = _pending[_nextPending++];
+
+    lock.unlock();
+    RunJob(*job);
+    lock.lock();
+
+    if(0 == --_numRemaining)
+    {
+      _batchComplete.notify_one();
+    }
+  }
+}
+
+} // namespace NeuralNets
+} // namespace Anki
@@ -0,0 +1,89 @@
+/**
+ * File: neuralNetScheduler.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Runs a batch of forward inference jobs (one per model) on a shared pool of worker threads.
+ *              Jobs are started highest priority first, with earlier deadlines breaking ties, so that e.g.
+ *              person detection is not stuck behind a slow, low-priority model on the same frame.
+ *
+ *              With zero worker threads, jobs are simply run in priority order on the calling thread.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_NeuralNets_NeuralNetScheduler_H__
+#define __Anki_NeuralNets_NeuralNetScheduler_H__
+
+#include "coretech/common/shared/types.h"
+#include "coretech/vision/engine/image.h"
+
+#include "clad/types/salientPointTypes.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+namespace NeuralNets {
+
+class INeuralNetModel;
+
+class NeuralNetScheduler
+{
+public:
+
+  struct Job
+  {
+    // Inputs
+    INeuralNetModel*                 model = nullptr;
+    Vision::ImageRGB                 img;
+
+    // Outputs
+    std::list<Vision::SalientPoint>  salientPoints;
+    Result                           result = RESULT_OK;
+    bool                             missedDeadline = false;
+    f32                              latency_ms  = 0.f; // from start of batch until this job completed
+  };
+
+  explicit NeuralNetScheduler(s32 numThreads);
+  ~NeuralNetScheduler();
+
+  NeuralNetScheduler(const NeuralNetScheduler&) = delete;
+  NeuralNetScheduler& operator=(const NeuralNetScheduler&) = delete;
+
+  // Runs every job in the batch and blocks until all are complete. Each model may only appear once per batch,
+  // since a single model's interpreter is not safe to use from multiple threads at once.
+  void RunBatch(std::vector<Job>& jobs);
+
+  s32 GetNumThreads() const { return static_cast<s32>(_workers.size()); }
+
+private:
+
+  void WorkerLoop(s32 index);
+  void RunJob(Job& job);
+
+  std::vector<std::thread> _workers;
+
+  std::mutex               _mutex;
+  std::condition_variable  _workAvailable;
+  std::condition_variable  _batchComplete;
+
+  // Current batch, in the order jobs should be started
+  std::vector<Job*>        _pending;
+  size_t                   _nextPending = 0;
+  size_t                   _numRemaining = 0;
+  bool                     _shutdown = false;
+
+  std::chrono::steady_clock::time_point _batchStartTime;
+
+}; // class NeuralNetScheduler
+
+} // namespace NeuralNets
+} // namespace Anki
+
+#endif /* __Anki_NeuralNets_NeuralNetScheduler_H__ */
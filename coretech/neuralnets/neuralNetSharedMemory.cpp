@@ -0,0 +1,592 @@
+/**
+ * File: neuralNetSharedMemory.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "coretech/neuralnets/neuralNetSharedMemory.h"
+#include "coretech/vision/engine/image.h"
+
+#include "clad/types/salientPointTypes.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+#endif
+
+#define LOG_CHANNEL "NeuralNets"
+
+namespace Anki {
+namespace NeuralNets {
+
+namespace {
+
+  constexpr u32    kMagic             = 0x564E4E31; // "VNN1"
+  constexpr u32    kMagicInitializing = 0x564E4E30;
+  constexpr u32    kVersion           = 1;
+  constexpr size_t kCacheLineSize     = 64;
+  constexpr size_t kResultCapacity    = 16*1024;   // plenty for a frame's worth of packed SalientPoints
+  constexpr s32    kMaxNumSlots       = 8;
+  constexpr s32    kInitWaitTimeout_ms = 1000;
+
+  enum SlotState : u32 {
+    Free = 0,
+    Writing,
+    Ready,
+    Reading,
+  };
+
+  static_assert(sizeof(std::atomic<u32>) == sizeof(u32), "Doorbells must be plain 32-bit words for futex use");
+
+  inline size_t AlignToCacheLine(size_t size)
+  {
+    return (size + kCacheLineSize - 1) & ~(kCacheLineSize - 1);
+  }
+
+  // True if sequence number a is newer than b (handles wraparound)
+  inline bool IsNewer(u32 a, u32 b)
+  {
+    return static_cast<s32>(a - b) > 0;
+  }
+
+  // Block until the doorbell's value differs from lastValue or the timeout expires (spurious wakeups are
+  // possible, so callers re-check their condition)
+  void WaitOnDoorbell(std::atomic<u32>& doorbell, u32 lastValue, s32 timeout_ms)
+  {
+    if(timeout_ms <= 0)
+    {
+      return;
+    }
+#if defined(__linux__)
+    struct timespec timeout;
+    timeout.tv_sec  = timeout_ms / 1000;
+    timeout.tv_nsec = (timeout_ms % 1000) * 1000000;
+    // Note: not FUTEX_PRIVATE_FLAG, since the other side of the doorbell is in another process
+    syscall(SYS_futex, reinterpret_cast<u32*>(&doorbell), FUTEX_WAIT, lastValue, &timeout, nullptr, 0);
+#else
+    // No futex available (e.g. mac/simulator), so fall back on a short poll
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+    while(doorbell.load(std::memory_order_acquire) == lastValue && std::chrono::steady_clock::now() < deadline)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+#endif
+  }
+
+  void WakeDoorbell(std::atomic<u32>& doorbell)
+  {
+#if defined(__linux__)
+    syscall(SYS_futex, reinterpret_cast<u32*>(&doorbell), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+#endif
+  }
+
+  inline s32 GetRemaining_ms(const std::chrono::steady_clock::time_point& deadline)
+  {
+    const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline -
+                                                                                std::chrono::steady_clock::now());
+    return static_cast<s32>(remaining.count());
+  }
+
+}
+
+// Lives at the start of the shared object. Everything here is written once at creation except the atomics and
+// the result fields, which are protected by the resultSeq seqlock.
+struct SharedMemoryTransport::Header
+{
+  std::atomic<u32> magic;
+  u32              version;
+  s32              numSlots;
+  s32              maxNumRows;
+  s32              maxNumCols;
+  u32              slotStride;
+  u32              resultCapacity;
+
+  alignas(kCacheLineSize) std::atomic<u32> imageDoorbell;   // incremented by producer for each new frame
+  u32                                      nextImageSeq;    // producer only
+  std::atomic<u32>                         numDroppedFrames;
+
+  alignas(kCacheLineSize) std::atomic<u32> resultSeq;       // seqlock (odd while writing), also result doorbell
+  u32                                      resultImageSeq;
+  u32                                      resultNumBytes;
+};
+
+struct SharedMemoryTransport::SlotHeader
+{
+  std::atomic<u32> state;
+  u32              imageSeq;
+  u32              timestamp;
+  u32              imageId;
+  s32              numRows;
+  s32              numCols;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SharedMemoryTransport::SharedMemoryTransport() = default;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SharedMemoryTransport::~SharedMemoryTransport()
+{
+  Cleanup();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::string SharedMemoryTransport::GetSharedMemoryName(const std::string& networkName)
+{
+  return "/vic-neuralnets-" + networkName;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SharedMemoryTransport::Cleanup()
+{
+  if(_acquiredSlot >= 0)
+  {
+    ReleaseImage();
+  }
+  if(nullptr != _header)
+  {
+    munmap(_header, _mappedSize);
+    _header = nullptr;
+  }
+  if(_fd >= 0)
+  {
+    close(_fd);
+    _fd = -1;
+  }
+  _mappedSize = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result SharedMemoryTransport::Init(const std::string& networkName, Role role,
+                                   s32 maxNumRows, s32 maxNumCols, s32 numSlots)
+{
+  Cleanup();
+
+  if(maxNumRows <= 0 || maxNumCols <= 0 || numSlots < 2 || numSlots > kMaxNumSlots)
+  {
+    LOG_ERROR("SharedMemoryTransport.Init.BadParameters", "%dx%d NumSlots:%d (must be in [2,%d])",
+              maxNumCols, maxNumRows, numSlots, kMaxNumSlots);
+    return RESULT_FAIL_INVALID_PARAMETER;
+  }
+
+  _name = GetSharedMemoryName(networkName);
+  _role = role;
+
+  const size_t headerSize = AlignToCacheLine(sizeof(Header));
+  const size_t slotStride = AlignToCacheLine(sizeof(SlotHeader)) +
+                            AlignToCacheLine(static_cast<size_t>(maxNumRows) * maxNumCols * 3);
+  const size_t totalSize  = headerSize + kResultCapacity + numSlots*slotStride;
+
+  _fd = shm_open(_name.c_str(), O_RDWR | O_CREAT, 0666);
+  if(_fd < 0)
+  {
+    LOG_ERROR("SharedMemoryTransport.Init.OpenFailed", "%s: %s", _name.c_str(), strerror(errno));
+    return RESULT_FAIL;
+  }
+
+  // Whichever side gets here first sizes the object. Since the size is fully determined by the (shared) model
+  // config, a mismatch means the two processes disagree about the model.
+  struct stat st;
+  if(0 != fstat(_fd, &st))
+  {
+    LOG_ERROR("SharedMemoryTransport.Init.StatFailed", "%s: %s", _name.c_str(), strerror(errno));
+    Cleanup();
+    return RESULT_FAIL;
+  }
+  if(0 == st.st_size)
+  {
+    if(0 != ftruncate(_fd, totalSize))
+    {
+      LOG_ERROR("SharedMemoryTransport.Init.TruncateFailed", "%s: %s", _name.c_str(), strerror(errno));
+      Cleanup();
+      return RESULT_FAIL;
+    }
+  }
+  else if(static_cast<size_t>(st.st_size) != totalSize)
+  {
+    LOG_ERROR("SharedMemoryTransport.Init.SizeMismatch", "%s: Existing:%lld Expected:%zu",
+              _name.c_str(), (long long)st.st_size, totalSize);
+    Cleanup();
+    return RESULT_FAIL;
+  }
+
+  void* ptr = mmap(nullptr, totalSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+  if(MAP_FAILED == ptr)
+  {
+    LOG_ERROR("SharedMemoryTransport.Init.MapFailed", "%s: %s", _name.c_str(), strerror(errno));
+    Cleanup();
+    return RESULT_FAIL;
+  }
+  _mappedSize = totalSize;
+  _header = static_cast<Header*>(ptr);
+
+  // Freshly truncated memory is zeroed, so the first side to flip magic from zero initializes the header
+  u32 expectedMagic = 0;
+  if(_header->magic.compare_exchange_strong(expectedMagic, kMagicInitializing))
+  {
+    _header->version        = kVersion;
+    _header->numSlots       = numSlots;
+    _header->maxNumRows     = maxNumRows;
+    _header->maxNumCols     = maxNumCols;
+    _header->slotStride     = static_cast<u32>(slotStride);
+    _header->resultCapacity = static_cast<u32>(kResultCapacity);
+    _header->magic.store(kMagic, std::memory_order_release);
+  }
+  else
+  {
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(kInitWaitTimeout_ms);
+    while(kMagic != _header->magic.load(std::memory_order_acquire) && GetRemaining_ms(deadline) > 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  if(kMagic != _header->magic.load(std::memory_order_acquire) || kVersion != _header->version ||
+     numSlots != _header->numSlots || maxNumRows != _header->maxNumRows || maxNumCols != _header->maxNumCols)
+  {
+    LOG_ERROR("SharedMemoryTransport.Init.HeaderMismatch", "%s: Magic:0x%08X Version:%u Slots:%d Size:%dx%d",
+              _name.c_str(), _header->magic.load(), _header->version, _header->numSlots,
+              _header->maxNumCols, _header->maxNumRows);
+    Cleanup();
+    return RESULT_FAIL;
+  }
+
+  if(Role::Producer == _role)
+  {
+    // A previous engine instance may have died mid-write: reclaim those slots
+    for(s32 i=0; i<numSlots; ++i)
+    {
+      u32 expectedState = SlotState::Writing;
+      GetSlot(i)->state.compare_exchange_strong(expectedState, SlotState::Free);
+    }
+  }
+
+  LOG_INFO("SharedMemoryTransport.Init.Success", "%s: %s, %d slots of %dx%d, %zu bytes",
+           _name.c_str(), (Role::Producer == _role ? "Producer" : "Consumer"),
+           numSlots, maxNumCols, maxNumRows, totalSize);
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+SharedMemoryTransport::SlotHeader* SharedMemoryTransport::GetSlot(s32 index) const
+{
+  u8* base = reinterpret_cast<u8*>(_header) + AlignToCacheLine(sizeof(Header)) + kResultCapacity;
+  return reinterpret_cast<SlotHeader*>(base + index*_header->slotStride);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u8* SharedMemoryTransport::GetSlotData(s32 index) const
+{
+  return reinterpret_cast<u8*>(GetSlot(index)) + AlignToCacheLine(sizeof(SlotHeader));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u32 SharedMemoryTransport::GetNumDroppedFrames() const
+{
+  return (nullptr == _header ? 0 : _header->numDroppedFrames.load(std::memory_order_relaxed));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result SharedMemoryTransport::WriteImage(const Vision::ImageRGB& img, u32& imageSeq)
+{
+  DEV_ASSERT(Role::Producer == _role, "SharedMemoryTransport.WriteImage.NotProducer");
+
+  if(!IsInitialized())
+  {
+    LOG_ERROR("SharedMemoryTransport.WriteImage.NotInitialized", "");
+    return RESULT_FAIL;
+  }
+
+  const s32 numRows = img.GetNumRows();
+  const s32 numCols = img.GetNumCols();
+  if(numRows > _header->maxNumRows || numCols > _header->maxNumCols)
+  {
+    LOG_ERROR("SharedMemoryTransport.WriteImage.ImageTooLarge", "%dx%d > %dx%d",
+              numCols, numRows, _header->maxNumCols, _header->maxNumRows);
+    return RESULT_FAIL_INVALID_SIZE;
+  }
+
+  // Prefer a free slot. Otherwise take over the oldest frame the consumer hasn't gotten to yet.
+  s32 slotIndex = -1;
+  for(s32 i=0; i<_header->numSlots && slotIndex < 0; ++i)
+  {
+    u32 expectedState = SlotState::Free;
+    if(GetSlot(i)->state.compare_exchange_strong(expectedState, SlotState::Writing))
+    {
+      slotIndex = i;
+    }
+  }
+
+  if(slotIndex < 0)
+  {
+    s32 oldestIndex = -1;
+    for(s32 i=0; i<_header->numSlots; ++i)
+    {
+      const SlotHeader* slot = GetSlot(i);
+      if((SlotState::Ready == slot->state.load(std::memory_order_acquire)) &&
+         (oldestIndex < 0 || IsNewer(GetSlot(oldestIndex)->imageSeq, slot->imageSeq)))
+      {
+        oldestIndex = i;
+      }
+    }
+
+    u32 expectedState = SlotState::Ready;
+    if(oldestIndex >= 0 && GetSlot(oldestIndex)->state.compare_exchange_strong(expectedState, SlotState::Writing))
+    {
+      slotIndex = oldestIndex;
+      _header->numDroppedFrames.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  if(slotIndex < 0)
+  {
+    LOG_WARNING("SharedMemoryTransport.WriteImage.NoSlotAvailable", "%s", _name.c_str());
+    return RESULT_FAIL;
+  }
+
+  SlotHeader* slot = GetSlot(slotIndex);
+  u8* data = GetSlotData(slotIndex);
+  const size_t rowBytes = static_cast<size_t>(numCols) * sizeof(Vision::PixelRGB);
+  if(img.IsContinuous())
+  {
+    std::memcpy(data, img.GetDataPointer(), rowBytes*numRows);
+  }
+  else
+  {
+    for(s32 i=0; i<numRows; ++i)
+    {
+      std::memcpy(data + i*rowBytes, img.GetRow(i), rowBytes);
+    }
+  }
+
+  imageSeq = ++_header->nextImageSeq;
+  slot->imageSeq  = imageSeq;
+  slot->timestamp = img.GetTimestamp();
+  slot->imageId   = img.GetImageId();
+  slot->numRows   = numRows;
+  slot->numCols   = numCols;
+  slot->state.store(SlotState::Ready, std::memory_order_release);
+
+  _header->imageDoorbell.fetch_add(1, std::memory_order_release);
+  WakeDoorbell(_header->imageDoorbell);
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SharedMemoryTransport::WaitForResults(u32 imageSeq, f32 timeout_sec, std::list<Vision::SalientPoint>& salientPoints)
+{
+  DEV_ASSERT(Role::Producer == _role, "SharedMemoryTransport.WaitForResults.NotProducer");
+
+  if(!IsInitialized())
+  {
+    return false;
+  }
+
+  const u8* resultData = reinterpret_cast<const u8*>(_header) + AlignToCacheLine(sizeof(Header));
+  std::vector<u8> buffer;
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(static_cast<s32>(1000.f*timeout_sec));
+  while(true)
+  {
+    const u32 seq = _header->resultSeq.load(std::memory_order_acquire);
+    if((seq & 1) == 0 && _header->resultImageSeq == imageSeq)
+    {
+      const u32 numBytes = std::min(_header->resultNumBytes, _header->resultCapacity);
+      buffer.assign(resultData, resultData + numBytes);
+      std::atomic_thread_fence(std::memory_order_acquire);
+      if(_header->resultSeq.load(std::memory_order_relaxed) == seq)
+      {
+        break;
+      }
+      continue; // torn read, try again
+    }
+
+    const s32 remaining_ms = GetRemaining_ms(deadline);
+    if(remaining_ms <= 0)
+    {
+      return false;
+    }
+    WaitOnDoorbell(_header->resultSeq, seq, remaining_ms);
+  }
+
+  // Result format: [u32 numPoints] followed by numPoints x ([u32 numBytes][packed SalientPoint])
+  size_t offset = 0;
+  u32 numPoints = 0;
+  if(buffer.size() >= sizeof(numPoints))
+  {
+    std::memcpy(&numPoints, buffer.data(), sizeof(numPoints));
+    offset += sizeof(numPoints);
+  }
+
+  for(u32 i=0; i<numPoints; ++i)
+  {
+    u32 numBytes = 0;
+    if(offset + sizeof(numBytes) > buffer.size())
+    {
+      LOG_ERROR("SharedMemoryTransport.WaitForResults.TruncatedResult", "Point %u of %u", i, numPoints);
+      break;
+    }
+    std::memcpy(&numBytes, buffer.data() + offset, sizeof(numBytes));
+    offset += sizeof(numBytes);
+
+    if(offset + numBytes > buffer.size())
+    {
+      LOG_ERROR("SharedMemoryTransport.WaitForResults.TruncatedSalientPoint", "Point %u of %u", i, numPoints);
+      break;
+    }
+
+    Vision::SalientPoint salientPoint;
+    const size_t numUnpacked = salientPoint.Unpack(buffer.data() + offset, numBytes);
+    offset += numBytes;
+    if(numUnpacked != numBytes)
+    {
+      LOG_ERROR("SharedMemoryTransport.WaitForResults.UnpackFailed", "Unpacked %zu of %u bytes", numUnpacked, numBytes);
+      continue;
+    }
+    salientPoints.emplace_back(std::move(salientPoint));
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SharedMemoryTransport::AcquireImage(s32 timeout_ms, Vision::ImageRGB& img, u32& imageSeq)
+{
+  DEV_ASSERT(Role::Consumer == _role, "SharedMemoryTransport.AcquireImage.NotConsumer");
+
+  if(!IsInitialized())
+  {
+    return false;
+  }
+
+  if(_acquiredSlot >= 0)
+  {
+    LOG_WARNING("SharedMemoryTransport.AcquireImage.PreviousImageNotReleased", "%s", _name.c_str());
+    ReleaseImage();
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms);
+  while(true)
+  {
+    // Read the doorbell before scanning so a frame arriving mid-scan still wakes the wait below
+    const u32 doorbell = _header->imageDoorbell.load(std::memory_order_acquire);
+
+    s32 newestIndex = -1;
+    for(s32 i=0; i<_header->numSlots; ++i)
+    {
+      const SlotHeader* slot = GetSlot(i);
+      if((SlotState::Ready == slot->state.load(std::memory_order_acquire)) &&
+         (newestIndex < 0 || IsNewer(slot->imageSeq, GetSlot(newestIndex)->imageSeq)))
+      {
+        newestIndex = i;
+      }
+    }
+
+    u32 expectedState = SlotState::Ready;
+    if(newestIndex >= 0 && GetSlot(newestIndex)->state.compare_exchange_strong(expectedState, SlotState::Reading))
+    {
+      // Anything else still waiting is older than what we're about to process: let the producer have it back
+      for(s32 i=0; i<_header->numSlots; ++i)
+      {
+        u32 readyState = SlotState::Ready;
+        if(i != newestIndex && GetSlot(i)->state.compare_exchange_strong(readyState, SlotState::Free))
+        {
+          _header->numDroppedFrames.fetch_add(1, std::memory_order_relaxed);
+        }
+      }
+
+      const SlotHeader* slot = GetSlot(newestIndex);
+      img = Vision::ImageRGB(slot->numRows, slot->numCols, GetSlotData(newestIndex));
+      img.SetTimestamp(slot->timestamp);
+      img.SetImageId(slot->imageId);
+      imageSeq = slot->imageSeq;
+      _acquiredSlot = newestIndex;
+      return true;
+    }
+
+    const s32 remaining_ms = GetRemaining_ms(deadline);
+    if(remaining_ms <= 0)
+    {
+      return false;
+    }
+    WaitOnDoorbell(_header->imageDoorbell, doorbell, remaining_ms);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SharedMemoryTransport::ReleaseImage()
+{
+  if(_acquiredSlot >= 0 && IsInitialized())
+  {
+    GetSlot(_acquiredSlot)->state.store(SlotState::Free, std::memory_order_release);
+  }
+  _acquiredSlot = -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result SharedMemoryTransport::WriteResults(u32 imageSeq, const std::list<Vision::SalientPoint>& salientPoints)
+{
+  DEV_ASSERT(Role::Consumer == _role, "SharedMemoryTransport.WriteResults.NotConsumer");
+
+  if(!IsInitialized())
+  {
+    LOG_ERROR("SharedMemoryTransport.WriteResults.NotInitialized", "");
+    return RESULT_FAIL;
+  }
+
+  u8* resultData = reinterpret_cast<u8*>(_header) + AlignToCacheLine(sizeof(Header));
+  const size_t capacity = _header->resultCapacity;
+
+  const u32 seq = _header->resultSeq.load(std::memory_order_relaxed);
+  _header->resultSeq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  u32 numPoints = 0;
+  size_t offset = sizeof(numPoints);
+  for(const auto& salientPoint : salientPoints)
+  {
+    const u32 numBytes = static_cast<u32>(salientPoint.Size());
+    if(offset + sizeof(numBytes) + numBytes > capacity)
+    {
+      LOG_WARNING("SharedMemoryTransport.WriteResults.ResultsTruncated", "Wrote %u of %zu salient points",
+                  numPoints, salientPoints.size());
+      break;
+    }
+    std::memcpy(resultData + offset, &numBytes, sizeof(numBytes));
+    offset += sizeof(numBytes);
+    salientPoint.Pack(resultData + offset, numBytes);
+    offset += numBytes;
+    ++numPoints;
+  }
+  std::memcpy(resultData, &numPoints, sizeof(numPoints));
+
+  _header->resultImageSeq = imageSeq;
+  _header->resultNumBytes = static_cast<u32>(offset);
+  _header->resultSeq.store(seq + 2, std::memory_order_release);
+  WakeDoorbell(_header->resultSeq);
+
+  return RESULT_OK;
+}
+
+} // namespace NeuralNets
+} // namespace Anki
@@ -0,0 +1,111 @@
+/**
+ * File: neuralNetSharedMemory.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Shared-memory transport between the "offboard" NeuralNetModel in vic-engine and a standalone
+ *              neural net process (INeuralNetMain). Replaces writing/polling PNG and JSON files in the cache path.
+ *
+ *              The shared object holds a small, fixed number of slots for raw RGB frames (sized from the model's
+ *              input width/height) plus a single binary result buffer going back. Both directions use a sequence
+ *              counter as a "doorbell" which the other side can block on (a futex on Linux, a short poll elsewhere).
+ *
+ *              There is exactly one Producer (the engine, writing images and reading results) and one Consumer
+ *              (the neural net process, reading images and writing results) per network name.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_NeuralNets_SharedMemory_H__
+#define __Anki_NeuralNets_SharedMemory_H__
+
+#include "coretech/common/shared/types.h"
+
+#include <list>
+#include <string>
+
+namespace Anki {
+
+namespace Vision {
+  class ImageRGB;
+  struct SalientPoint;
+}
+
+namespace NeuralNets {
+
+class SharedMemoryTransport
+{
+public:
+
+  enum class Role : u8 {
+    Producer, // Engine side: writes images, reads results
+    Consumer, // Neural net process side: reads images, writes results
+  };
+
+  SharedMemoryTransport();
+  ~SharedMemoryTransport();
+
+  SharedMemoryTransport(const SharedMemoryTransport&) = delete;
+  SharedMemoryTransport& operator=(const SharedMemoryTransport&) = delete;
+
+  // Maps (creating if necessary) the shared object for the given network name. Both sides must agree on the
+  // image size and number of slots, which normally come from the same model config.
+  Result Init(const std::string& networkName, Role role, s32 maxNumRows, s32 maxNumCols, s32 numSlots = 2);
+
+  bool IsInitialized() const { return (nullptr != _header); }
+
+  //
+  // Producer
+  //
+
+  // Copies the image into a free slot (or over the oldest unread frame if none is free) and rings the doorbell.
+  // On success, imageSeq is set to the identifier to pass to WaitForResults().
+  Result WriteImage(const Vision::ImageRGB& img, u32& imageSeq);
+
+  // Blocks until results for the given image arrive or the timeout expires. Returns true if results were received.
+  bool WaitForResults(u32 imageSeq, f32 timeout_sec, std::list<Vision::SalientPoint>& salientPoints);
+
+  //
+  // Consumer
+  //
+
+  // Waits up to timeout_ms for a new image. Only the newest ready frame is returned; older unread frames are
+  // dropped. On success, img wraps the slot's memory directly (no copy) and stays valid until ReleaseImage().
+  bool AcquireImage(s32 timeout_ms, Vision::ImageRGB& img, u32& imageSeq);
+
+  // Return the slot acquired with AcquireImage() to the producer
+  void ReleaseImage();
+
+  // Packs and publishes results for the given image, waking the producer
+  Result WriteResults(u32 imageSeq, const std::list<Vision::SalientPoint>& salientPoints);
+
+  // Number of frames overwritten or skipped before the consumer got to them (for diagnostics)
+  u32 GetNumDroppedFrames() const;
+
+  // Name of the shared object used for the given network (exposed for cleanup/debugging)
+  static std::string GetSharedMemoryName(const std::string& networkName);
+
+private:
+
+  struct Header;
+  struct SlotHeader;
+
+  SlotHeader* GetSlot(s32 index) const;
+  u8*         GetSlotData(s32 index) const;
+
+  void Cleanup();
+
+  std::string _name;
+  Role        _role = Role::Producer;
+  int         _fd = -1;
+  size_t      _mappedSize = 0;
+  Header*     _header = nullptr;
+  s32         _acquiredSlot = -1;
+
+}; // class SharedMemoryTransport
+
+} // namespace NeuralNets
+} // namespace Anki
+
+#endif /* __Anki_NeuralNets_SharedMemory_H__ */
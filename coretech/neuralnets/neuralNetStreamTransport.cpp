@@ -0,0 +1,423 @@
+/**
+ * File: neuralNetStreamTransport.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "coretech/neuralnets/neuralNetStreamTransport.h"
+#include "coretech/vision/engine/image.h"
+
+#include "clad/types/salientPointTypes.h"
+#include "json/json.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#define LOG_CHANNEL "NeuralNets"
+
+namespace Anki {
+namespace NeuralNets {
+
+namespace {
+
+  constexpr u32    kImageMagic    = 0x564E4E49; // "VNNI"
+  constexpr u32    kResultMagic   = 0x564E4E52; // "VNNR"
+  constexpr size_t kImageHeaderSize  = 4 * sizeof(u32);
+  constexpr size_t kResultHeaderSize = 3 * sizeof(u32);
+  constexpr size_t kMaxResultSize    = 1024*1024; // anything bigger means we've lost track of the message boundaries
+  constexpr size_t kRecvChunkSize    = 4096;
+  constexpr s32    kSendTimeout_ms   = 1000;
+
+#if defined(MSG_NOSIGNAL)
+  constexpr int kSendFlags = MSG_NOSIGNAL;
+#else
+  constexpr int kSendFlags = 0; // SO_NOSIGPIPE is set on the socket instead
+#endif
+
+  inline void WriteU32(u8* dest, u32 value)
+  {
+    const u32 networkValue = htonl(value);
+    memcpy(dest, &networkValue, sizeof(networkValue));
+  }
+
+  inline u32 ReadU32(const u8* src)
+  {
+    u32 networkValue;
+    memcpy(&networkValue, src, sizeof(networkValue));
+    return ntohl(networkValue);
+  }
+
+  // Non-blocking connect to one resolved address, giving up after timeout_ms. Returns the socket or -1.
+  int ConnectWithTimeout(const struct addrinfo* addr, s32 timeout_ms)
+  {
+    const int sock = socket(addr->ai_family, addr->ai_socktype, addr->ai_protocol);
+    if(sock < 0)
+    {
+      return -1;
+    }
+
+    const int flags = fcntl(sock, F_GETFL, 0);
+    if(flags < 0 || fcntl(sock, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+      close(sock);
+      return -1;
+    }
+
+    if(0 != connect(sock, addr->ai_addr, addr->ai_addrlen))
+    {
+      if(EINPROGRESS != errno)
+      {
+        close(sock);
+        return -1;
+      }
+
+      struct pollfd pfd = {sock, POLLOUT, 0};
+      int error = 0;
+      socklen_t errorLen = sizeof(error);
+      if(poll(&pfd, 1, timeout_ms) <= 0 ||
+         0 != getsockopt(sock, SOL_SOCKET, SO_ERROR, &error, &errorLen) ||
+         0 != error)
+      {
+        close(sock);
+        return -1;
+      }
+    }
+
+    // Frames are written whole, so don't let Nagle hold back the tail of one waiting for more data
+    const int enable = 1;
+    setsockopt(sock, IPPROTO_TCP, TCP_NODELAY, &enable, sizeof(enable));
+#if defined(SO_NOSIGPIPE)
+    setsockopt(sock, SOL_SOCKET, SO_NOSIGPIPE, &enable, sizeof(enable));
+#endif
+
+    return sock;
+  }
+
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StreamTransport::StreamTransport() = default;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+StreamTransport::~StreamTransport()
+{
+  Disconnect();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result StreamTransport::Init(const std::string& host, u16 port, s32 jpegQuality,
+                             s32 connectTimeout_ms, s32 reconnectPeriod_ms)
+{
+  if(host.empty() || 0 == port)
+  {
+    LOG_ERROR("StreamTransport.Init.InvalidAddress", "Host:'%s' Port:%u", host.c_str(), port);
+    return RESULT_FAIL;
+  }
+
+  Disconnect();
+
+  _host               = host;
+  _port               = port;
+  _jpegQuality        = std::max(1, std::min(jpegQuality, 100));
+  _connectTimeout_ms  = connectTimeout_ms;
+  _reconnectPeriod_ms = reconnectPeriod_ms;
+  _hasTriedConnecting = false;
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StreamTransport::Connect()
+{
+  if(IsConnected())
+  {
+    return true;
+  }
+
+  const Clock::time_point now = Clock::now();
+  if(_hasTriedConnecting && (now - _lastConnectAttempt < std::chrono::milliseconds(_reconnectPeriod_ms)))
+  {
+    return false;
+  }
+  _hasTriedConnecting = true;
+  _lastConnectAttempt = now;
+
+  struct addrinfo hints;
+  memset(&hints, 0, sizeof(hints));
+  hints.ai_family   = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  struct addrinfo* addrs = nullptr;
+  const std::string portString = std::to_string(_port);
+  const int gaiResult = getaddrinfo(_host.c_str(), portString.c_str(), &hints, &addrs);
+  if(0 != gaiResult)
+  {
+    LOG_WARNING("StreamTransport.Connect.ResolveFailed", "%s:%u: %s", _host.c_str(), _port, gai_strerror(gaiResult));
+    return false;
+  }
+
+  for(const struct addrinfo* addr = addrs; addr != nullptr && _socket < 0; addr = addr->ai_next)
+  {
+    _socket = ConnectWithTimeout(addr, _connectTimeout_ms);
+  }
+  freeaddrinfo(addrs);
+
+  if(!IsConnected())
+  {
+    LOG_WARNING("StreamTransport.Connect.Failed", "%s:%u, retrying in %dms",
+                _host.c_str(), _port, _reconnectPeriod_ms);
+    return false;
+  }
+
+  LOG_INFO("StreamTransport.Connect.Connected", "%s:%u", _host.c_str(), _port);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StreamTransport::Disconnect()
+{
+  if(IsConnected())
+  {
+    LOG_INFO("StreamTransport.Disconnect", "%s:%u, dropping %zu images in flight",
+             _host.c_str(), _port, _inFlight.size());
+    close(_socket);
+    _socket = -1;
+  }
+  _inFlight.clear();
+  _recvBuffer.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result StreamTransport::SendImage(const Vision::ImageRGB& img, u32& imageSeq)
+{
+  if(!IsConnected())
+  {
+    return RESULT_FAIL;
+  }
+
+  const std::vector<u8>& jpeg = _compressedImage.Compress(img, _jpegQuality);
+  if(jpeg.empty())
+  {
+    LOG_ERROR("StreamTransport.SendImage.CompressFailed", "t:%d", img.GetTimestamp());
+    return RESULT_FAIL;
+  }
+
+  imageSeq = _nextSeq++;
+
+  u8 header[kImageHeaderSize];
+  WriteU32(header,     kImageMagic);
+  WriteU32(header + 4, imageSeq);
+  WriteU32(header + 8, img.GetTimestamp());
+  WriteU32(header + 12, static_cast<u32>(jpeg.size()));
+
+  if(!SendAll(header, sizeof(header)) || !SendAll(jpeg.data(), jpeg.size()))
+  {
+    LOG_WARNING("StreamTransport.SendImage.SendFailed", "t:%d Seq:%u", img.GetTimestamp(), imageSeq);
+    Disconnect();
+    return RESULT_FAIL;
+  }
+
+  _inFlight.push_back(InFlightImage{imageSeq, Clock::now()});
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StreamTransport::SendAll(const u8* data, size_t numBytes)
+{
+  while(numBytes > 0)
+  {
+    const ssize_t numSent = send(_socket, data, numBytes, kSendFlags);
+    if(numSent > 0)
+    {
+      data     += numSent;
+      numBytes -= static_cast<size_t>(numSent);
+    }
+    else if(numSent < 0 && (EAGAIN == errno || EWOULDBLOCK == errno))
+    {
+      // Socket buffer is full: wait for the server to catch up, but not forever
+      struct pollfd pfd = {_socket, POLLOUT, 0};
+      if(poll(&pfd, 1, kSendTimeout_ms) <= 0)
+      {
+        return false;
+      }
+    }
+    else if(numSent < 0 && EINTR == errno)
+    {
+      continue;
+    }
+    else
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StreamTransport::ReceiveResults(s32 timeout_ms, std::list<Vision::SalientPoint>& salientPoints, u32& imageSeq)
+{
+  if(!IsConnected() || _inFlight.empty())
+  {
+    return false;
+  }
+
+  const Clock::time_point deadline = Clock::now() + std::chrono::milliseconds(timeout_ms);
+  while(true)
+  {
+    bool gotResults = false;
+    if(!PopResults(gotResults, salientPoints, imageSeq))
+    {
+      Disconnect();
+      return false;
+    }
+    if(gotResults)
+    {
+      return true;
+    }
+
+    const s32 remaining_ms = static_cast<s32>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now()).count());
+    if(!ReadAvailable(std::max(0, remaining_ms)))
+    {
+      LOG_WARNING("StreamTransport.ReceiveResults.ConnectionLost", "%s:%u", _host.c_str(), _port);
+      Disconnect();
+      return false;
+    }
+
+    if(remaining_ms <= 0)
+    {
+      // One last look at whatever that final read brought in
+      if(!PopResults(gotResults, salientPoints, imageSeq))
+      {
+        Disconnect();
+        return false;
+      }
+      return gotResults;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StreamTransport::ReadAvailable(s32 timeout_ms)
+{
+  struct pollfd pfd = {_socket, POLLIN, 0};
+  const int pollResult = poll(&pfd, 1, timeout_ms);
+  if(pollResult < 0)
+  {
+    return (EINTR == errno);
+  }
+  if(0 == pollResult)
+  {
+    return true;
+  }
+
+  while(true)
+  {
+    const size_t prevSize = _recvBuffer.size();
+    _recvBuffer.resize(prevSize + kRecvChunkSize);
+    const ssize_t numRead = recv(_socket, _recvBuffer.data() + prevSize, kRecvChunkSize, 0);
+    _recvBuffer.resize(prevSize + static_cast<size_t>(std::max<ssize_t>(0, numRead)));
+
+    if(numRead > 0)
+    {
+      continue;
+    }
+    if(0 == numRead)
+    {
+      // Server closed the connection
+      return false;
+    }
+    return (EAGAIN == errno || EWOULDBLOCK == errno || EINTR == errno);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StreamTransport::PopResults(bool& gotResults, std::list<Vision::SalientPoint>& salientPoints, u32& imageSeq)
+{
+  gotResults = false;
+  if(_recvBuffer.size() < kResultHeaderSize)
+  {
+    return true;
+  }
+
+  const u32 magic    = ReadU32(_recvBuffer.data());
+  const u32 seq      = ReadU32(_recvBuffer.data() + 4);
+  const u32 numBytes = ReadU32(_recvBuffer.data() + 8);
+  if(kResultMagic != magic || numBytes > kMaxResultSize)
+  {
+    LOG_ERROR("StreamTransport.PopResults.BadHeader", "Magic:0x%08X Size:%u", magic, numBytes);
+    return false;
+  }
+
+  if(_recvBuffer.size() < kResultHeaderSize + numBytes)
+  {
+    return true;
+  }
+
+  // Results come back in the order the images were sent. Anything older than what the server just answered won't
+  // be answered at all (e.g. the server skipped frames to keep up).
+  while(!_inFlight.empty() && _inFlight.front().seq != seq)
+  {
+    _inFlight.pop_front();
+  }
+  if(_inFlight.empty())
+  {
+    LOG_ERROR("StreamTransport.PopResults.UnexpectedSeq", "Seq:%u", seq);
+    return false;
+  }
+  _lastLatency_ms = static_cast<s32>(std::chrono::duration_cast<std::chrono::milliseconds>(
+    Clock::now() - _inFlight.front().sendTime).count());
+  _inFlight.pop_front();
+
+  const char* jsonBegin = reinterpret_cast<const char*>(_recvBuffer.data() + kResultHeaderSize);
+  Json::Reader reader;
+  Json::Value detectionResult;
+  const bool parsed = reader.parse(jsonBegin, jsonBegin + numBytes, detectionResult);
+  _recvBuffer.erase(_recvBuffer.begin(), _recvBuffer.begin() + kResultHeaderSize + numBytes);
+
+  if(!parsed)
+  {
+    LOG_ERROR("StreamTransport.PopResults.FailedToReadJSON", "Seq:%u", seq);
+    return false;
+  }
+
+  salientPoints.clear();
+  const Json::Value& salientPointsJson = detectionResult["salientPoints"];
+  if(salientPointsJson.isArray())
+  {
+    for(auto const& salientPointJson : salientPointsJson)
+    {
+      Vision::SalientPoint salientPoint;
+      if(!salientPoint.SetFromJSON(salientPointJson))
+      {
+        LOG_ERROR("StreamTransport.PopResults.FailedToSetFromJSON", "Seq:%u", seq);
+        continue;
+      }
+      salientPoints.emplace_back(std::move(salientPoint));
+    }
+  }
+
+  imageSeq = seq;
+  gotResults = true;
+  return true;
+}
+
+} // namespace NeuralNets
+} // namespace Anki
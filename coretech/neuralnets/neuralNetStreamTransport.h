@@ -0,0 +1,119 @@
+/**
+ * File: neuralNetStreamTransport.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Persistent TCP connection between the "offboard" NeuralNetModel and a neural net server on another
+ *              machine (a laptop or the cloud). Replaces writing PNG files and polling for JSON results with JPEG
+ *              frames streamed over one socket, so there is no per-frame connection or file system round trip.
+ *
+ *              Every message is a fixed header (in network byte order) followed by a payload:
+ *                Image:  magic "VNNI", sequence number, image timestamp, payload size, then the JPEG bytes
+ *                Result: magic "VNNR", sequence number of the image it is for, payload size, then the same JSON
+ *                        the file transport's result file holds ({"salientPoints": [...]})
+ *
+ *              Several images may be in flight at once; the server answers them in order. Any I/O error, timeout
+ *              or malformed message closes the connection, and Connect() waits a reconnect period before trying
+ *              again so a missing server doesn't stall every frame.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_NeuralNets_StreamTransport_H__
+#define __Anki_NeuralNets_StreamTransport_H__
+
+#include "coretech/common/shared/types.h"
+#include "coretech/vision/engine/compressedImage.h"
+
+#include <chrono>
+#include <deque>
+#include <list>
+#include <string>
+#include <vector>
+
+namespace Anki {
+
+namespace Vision {
+  struct SalientPoint;
+}
+
+namespace NeuralNets {
+
+class StreamTransport
+{
+public:
+
+  StreamTransport();
+  ~StreamTransport();
+
+  StreamTransport(const StreamTransport&) = delete;
+  StreamTransport& operator=(const StreamTransport&) = delete;
+
+  // Only stores the settings: the connection is made by the first Connect()
+  Result Init(const std::string& host, u16 port, s32 jpegQuality, s32 connectTimeout_ms, s32 reconnectPeriod_ms);
+
+  // Returns true if connected, connecting first if not. Attempts are at most one per reconnect period.
+  bool Connect();
+
+  // Closes the connection, dropping any images still awaiting results
+  void Disconnect();
+
+  bool IsConnected() const { return (_socket >= 0); }
+
+  // JPEG compresses and sends the image. On success, imageSeq identifies it in the results.
+  Result SendImage(const Vision::ImageRGB& img, u32& imageSeq);
+
+  // Waits up to timeout_ms for the results of the oldest image in flight (0 only takes results that already
+  // arrived). Returns true if results were received, setting imageSeq to the image they are for.
+  bool ReceiveResults(s32 timeout_ms, std::list<Vision::SalientPoint>& salientPoints, u32& imageSeq);
+
+  // Images sent whose results haven't been received yet
+  size_t GetNumInFlight() const { return _inFlight.size(); }
+
+  // Round trip time of the last received results
+  s32 GetLastLatency_ms() const { return _lastLatency_ms; }
+
+private:
+
+  using Clock = std::chrono::steady_clock;
+
+  struct InFlightImage
+  {
+    u32               seq;
+    Clock::time_point sendTime;
+  };
+
+  bool SendAll(const u8* data, size_t numBytes);
+
+  // Reads whatever is available into _recvBuffer, waiting up to timeout_ms for something to arrive.
+  // Returns false if the connection failed.
+  bool ReadAvailable(s32 timeout_ms);
+
+  // Takes one complete result message off the front of _recvBuffer, if there is one. Returns false if the
+  // message in the buffer is malformed.
+  bool PopResults(bool& gotResults, std::list<Vision::SalientPoint>& salientPoints, u32& imageSeq);
+
+  std::string _host;
+  u16         _port = 0;
+  s32         _jpegQuality = 80;
+  s32         _connectTimeout_ms = 1000;
+  s32         _reconnectPeriod_ms = 5000;
+
+  int               _socket = -1;
+  bool              _hasTriedConnecting = false;
+  Clock::time_point _lastConnectAttempt;
+
+  u32                       _nextSeq = 0;
+  std::deque<InFlightImage> _inFlight;
+  s32                       _lastLatency_ms = 0;
+
+  Vision::CompressedImage _compressedImage;
+  std::vector<u8>         _recvBuffer;
+
+}; // class StreamTransport
+
+} // namespace NeuralNets
+} // namespace Anki
+
+#endif /* __Anki_NeuralNets_StreamTransport_H__ */
@@ -15,6 +15,7 @@
 #include "coretech/neuralnets/iNeuralNetMain.h"
 #include "coretech/neuralnets/neuralNetFilenames.h"
 #include "coretech/neuralnets/neuralNetJsonKeys.h"
+#include "coretech/neuralnets/neuralNetSharedMemory.h"
 #include "coretech/vision/engine/image_impl.h"
 
 #include "util/fileUtils/fileUtils.h"
@@ -26,6 +27,7 @@
 #include "json/json.h"
 
 #include <fstream>
+#include <sys/mman.h>
 
 namespace TestPaths
 {
@@ -502,6 +504,145 @@ GTEST_TEST(NeuralNets, ClassificationConsensus)
   }
 }
 
+// Round trip an image and results through the shared memory transport (both ends in this process)
+GTEST_TEST(NeuralNets, SharedMemoryTransport)
+{
+  using namespace Anki;
+  
+  const std::string kNetworkName = "sharedMemoryTest";
+  const s32 kNumRows = 48;
+  const s32 kNumCols = 64;
+  
+  // Start clean in case a previous run died before unlinking
+  shm_unlink(NeuralNets::SharedMemoryTransport::GetSharedMemoryName(kNetworkName).c_str());
+  
+  NeuralNets::SharedMemoryTransport producer, consumer;
+  ASSERT_EQ(RESULT_OK, producer.Init(kNetworkName, NeuralNets::SharedMemoryTransport::Role::Producer,
+                                     kNumRows, kNumCols));
+  ASSERT_EQ(RESULT_OK, consumer.Init(kNetworkName, NeuralNets::SharedMemoryTransport::Role::Consumer,
+                                     kNumRows, kNumCols));
+  
+  // Mismatched size should be rejected
+  {
+    NeuralNets::SharedMemoryTransport mismatched;
+    EXPECT_NE(RESULT_OK, mismatched.Init(kNetworkName, NeuralNets::SharedMemoryTransport::Role::Consumer,
+                                         kNumRows*2, kNumCols));
+  }
+  
+  // Nothing there yet
+  Vision::ImageRGB received;
+  u32 receivedSeq = 0;
+  EXPECT_FALSE(consumer.AcquireImage(0, received, receivedSeq));
+  
+  // Send two frames before the consumer looks: only the newest should be processed
+  Vision::ImageRGB img(kNumRows, kNumCols, Vision::PixelRGB(10,20,30));
+  img.SetTimestamp(100);
+  u32 firstSeq = 0, secondSeq = 0;
+  ASSERT_EQ(RESULT_OK, producer.WriteImage(img, firstSeq));
+  img.FillWith(Vision::PixelRGB(40,50,60));
+  img.SetTimestamp(133);
+  ASSERT_EQ(RESULT_OK, producer.WriteImage(img, secondSeq));
+  EXPECT_NE(firstSeq, secondSeq);
+  
+  ASSERT_TRUE(consumer.AcquireImage(10, received, receivedSeq));
+  EXPECT_EQ(secondSeq, receivedSeq);
+  EXPECT_EQ(133u, received.GetTimestamp());
+  ASSERT_EQ(kNumRows, received.GetNumRows());
+  ASSERT_EQ(kNumCols, received.GetNumCols());
+  EXPECT_EQ(40, received(kNumRows/2, kNumCols/2).r());
+  EXPECT_EQ(60, received(kNumRows-1, kNumCols-1).b());
+  EXPECT_EQ(1u, consumer.GetNumDroppedFrames());
+  received = Vision::ImageRGB();
+  consumer.ReleaseImage();
+  
+  std::list<Vision::SalientPoint> results;
+  Vision::SalientPoint salientPoint;
+  salientPoint.timestamp   = 133;
+  salientPoint.x_img       = 0.25f;
+  salientPoint.y_img       = 0.75f;
+  salientPoint.score       = 0.9f;
+  salientPoint.description = "person";
+  results.push_back(salientPoint);
+  ASSERT_EQ(RESULT_OK, consumer.WriteResults(receivedSeq, results));
+  
+  // Results for the dropped frame never arrive
+  std::list<Vision::SalientPoint> detections;
+  EXPECT_FALSE(producer.WaitForResults(firstSeq, 0.01f, detections));
+  EXPECT_TRUE(detections.empty());
+  
+  ASSERT_TRUE(producer.WaitForResults(secondSeq, 0.01f, detections));
+  ASSERT_EQ(1u, detections.size());
+  EXPECT_EQ(salientPoint.timestamp, detections.front().timestamp);
+  EXPECT_FLOAT_EQ(salientPoint.x_img, detections.front().x_img);
+  EXPECT_FLOAT_EQ(salientPoint.score, detections.front().score);
+  EXPECT_EQ(salientPoint.description, detections.front().description);
+  
+  shm_unlink(NeuralNets::SharedMemoryTransport::GetSharedMemoryName(kNetworkName).c_str());
+}
+
+// Delegates are optional in config and must be one TFLite supports
+GTEST_TEST(NeuralNets, DelegateFromConfig)
+{
+  using namespace Anki;
+  
+  Json::Value config;
+  config["verbose"]        = false;
+  config["labelsFile"]     = "mobilenet_labels.txt";
+  config["minScore"]       = 0.5f;
+  config["graphFile"]      = "mobilenet_v1_0.5_128.tflite";
+  config["inputHeight"]    = 128;
+  config["inputWidth"]     = 128;
+  config["architecture"]   = "mobilenet";
+  config["memoryMapGraph"] = false;
+  config["benchmarkRuns"]  = 0;
+  config["inputScale"]     = 127.5f;
+  config["inputShift"]     = -1.f;
+  
+  NeuralNets::NeuralNetParams params;
+  ASSERT_EQ(RESULT_OK, params.SetFromConfig(config));
+  EXPECT_EQ(NeuralNets::NeuralNetParams::Delegate::CPU, params.delegate);
+  
+  config["delegate"] = "nnapi";
+  ASSERT_EQ(RESULT_OK, params.SetFromConfig(config));
+  EXPECT_EQ(NeuralNets::NeuralNetParams::Delegate::NNAPI, params.delegate);
+  
+  config["delegate"] = "gpu";
+  EXPECT_NE(RESULT_OK, params.SetFromConfig(config));
+}
+
+// Models allocated on first use build their interpreter on warm-up, and then don't need warming up again
+GTEST_TEST(NeuralNets, AllocateOnFirstUse)
+{
+  using namespace Anki;
+  
+  Json::Value config;
+  config[NeuralNets::JsonKeys::NetworkName] = "mobilenet";
+  config["verbose"]            = false;
+  config["labelsFile"]         = "mobilenet_labels.txt";
+  config["minScore"]           = 0.1f;
+  config["graphFile"]          = "mobilenet_v1_0.5_128.tflite";
+  config["inputHeight"]        = 128;
+  config["inputWidth"]         = 128;
+  config["architecture"]       = "mobilenet";
+  config["memoryMapGraph"]     = false;
+  config["benchmarkRuns"]      = 0;
+  config["inputScale"]         = 127.5f;
+  config["inputShift"]         = -1.f;
+  config["allocateOnFirstUse"] = true;
+  
+  NeuralNets::TFLiteModel neuralNet;
+  ASSERT_EQ(RESULT_OK, neuralNet.LoadModel(TestPaths::ModelPath, config));
+  EXPECT_TRUE(neuralNet.NeedsWarmUp());
+  
+  ASSERT_EQ(RESULT_OK, neuralNet.WarmUp());
+  EXPECT_FALSE(neuralNet.NeedsWarmUp());
+  
+  Vision::ImageRGB img;
+  ASSERT_EQ(RESULT_OK, img.Load(Util::FileUtils::FullFilePath({TestPaths::ImagePath, "cat.jpg"})));
+  std::list<Vision::SalientPoint> salientPoints;
+  ASSERT_EQ(RESULT_OK, neuralNet.Detect(img, salientPoints));
+  EXPECT_EQ(1, salientPoints.size());
+}
 
 int main(int argc, char ** argv)
 {
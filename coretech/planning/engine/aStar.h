@@ -13,7 +13,9 @@
 #ifndef __Coretech_Planning_AStar_H__
 #define __Coretech_Planning_AStar_H__
 
+#include <algorithm>
 #include <unordered_set>
+#include <vector>
 #include <functional>
 
 namespace Anki {
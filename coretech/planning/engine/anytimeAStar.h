@@ -0,0 +1,344 @@
+/**
+ * File: anytimeAStar.h
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Anytime Repairing A* (ARA*). Quickly finds a path that costs at most epsilon times the optimal
+ *              one, then lowers epsilon and reuses the previous search effort to improve it. The search can be
+ *              kept around between plans: the goal (and so the heuristic) may move, and the parts of the search
+ *              tree that went through a changed area of the map can be thrown away and regrown
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Coretech_Planning_AnytimeAStar_H__
+#define __Coretech_Planning_AnytimeAStar_H__
+
+#include "coretech/planning/engine/aStar.h"
+#include "coretech/common/shared/types.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+namespace Anki {
+
+// Uses the same configuration interface as AStar (GetSuccessors, Heuristic, IsGoal and StopPlanning). StopPlanning
+// only pauses the search, calling ImprovePath again continues where it left off
+template<class T, class ConfigT>
+class AnytimeAStar {
+public:
+
+  // initialEpsilon is the suboptimality bound of the first path, and every completed improvement lowers it by
+  // epsilonStep until it reaches 1 (optimal)
+  AnytimeAStar(ConfigT& config, float initialEpsilon, float epsilonStep)
+  : _config(config)
+  , _initialEpsilon(std::max(initialEpsilon, 1.f))
+  , _epsilonStep(epsilonStep)
+  { Reset({}); }
+
+  // discards any previous search and seeds a new one from the given start states, at the initial epsilon
+  void Reset(const std::vector<T>& start);
+
+  // Searches with the current epsilon until a path within the bound is known, the config asks to stop, or there is
+  // nothing left to expand. Returns true if this iteration completed, in which case HasPlan tells if there is a path.
+  // Once an iteration completed, the next call lowers epsilon and starts improving the path
+  bool ImprovePath();
+
+  // the config's goal or heuristic changed (e.g. the goal moved). Finds the best goal already in the search tree,
+  // and re-sorts the open list for the new heuristic so that the next ImprovePath continues from here
+  void OnGoalChanged();
+
+  // Throws away every state for which isAffected returns true, together with every state that was reached through
+  // it. Their surviving parents are opened again, so the next ImprovePath regrows that part of the tree from there.
+  // isAffected must cover anything whose successors may have changed, not only the states that became invalid.
+  // Epsilon goes back to its initial value, since the path may have to change a lot
+  void Repair(const std::function<bool (const T&)>& isAffected);
+
+  // path from one of the start states to the best goal state found so far, empty if none
+  std::vector<T> GetPlan() const;
+
+  bool   HasPlan()               const { return _hasPlan; }
+  float  GetPlanCost()           const { return _goalG; }
+  float  GetEpsilon()            const { return _epsilon; }
+  bool   IsOptimal()             const { return _iterationDone && _hasPlan && (_epsilon <= 1.f); }
+  size_t GetNumStates()          const { return _nodes.size(); }
+
+private:
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Data Containers
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // one per generated state
+  struct Node {
+    T     parent;
+    float g            = std::numeric_limits<float>::max();
+    u32   closedInIter = 0;     // iteration in which this state was last expanded
+    bool  isStart      = false;
+  };
+
+  // Open list entries are never updated in place. An entry is stale if its g no longer matches the node, or the
+  // node was already expanded in this iteration
+  struct OpenEntry {
+    T     state;
+    float g;
+    float key; // key = g + epsilon * h
+  };
+
+  static bool OpenCompare(const OpenEntry& a, const OpenEntry& b) { return (a.key > b.key); }
+
+  void PushOpen(const T& state, float g)
+  {
+    _open.push_back( {state, g, g + _epsilon * _config.Heuristic(state)} );
+    std::push_heap(_open.begin(), _open.end(), OpenCompare);
+  }
+
+  // recompute every key (epsilon or the heuristic changed), dropping stale entries
+  void RebuildOpen();
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Data Members
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  IAStarConfig<T, ConfigT>&  _config;
+  const float                _initialEpsilon;
+  const float                _epsilonStep;
+
+  std::unordered_map<T, Node> _nodes;
+  std::vector<OpenEntry>      _open;
+  std::vector<T>              _incons;  // states that improved after being expanded in this iteration
+
+  float _epsilon;
+  u32   _iteration;
+  bool  _iterationDone;
+
+  bool  _hasPlan;
+  T     _goal;
+  float _goalG;
+};
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class T, class ConfigT>
+void AnytimeAStar<T, ConfigT>::Reset(const std::vector<T>& start)
+{
+  _nodes.clear();
+  _open.clear();
+  _incons.clear();
+
+  _epsilon = _initialEpsilon;
+  _iteration = 1;
+  _iterationDone = false;
+  _hasPlan = false;
+  _goalG = std::numeric_limits<float>::max();
+
+  for (const auto& s : start) {
+    Node& node = _nodes[s];
+    node.parent = s;
+    node.g = 0.f;
+    node.isStart = true;
+    PushOpen(s, 0.f);
+  }
+
+  OnGoalChanged();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class T, class ConfigT>
+bool AnytimeAStar<T, ConfigT>::ImprovePath()
+{
+  if ( _iterationDone ) {
+    if ( _epsilon <= 1.f ) {
+      // nothing left to improve
+      return true;
+    }
+
+    // start the next iteration with a tighter bound. Everything that improved since its expansion is opened again,
+    // everything else keeps its value
+    _epsilon = std::max(1.f, _epsilon - _epsilonStep);
+    ++_iteration;
+    for (const auto& s : _incons) {
+      _open.push_back( {s, _nodes[s].g, 0.f} );
+    }
+    _incons.clear();
+    RebuildOpen();
+    _iterationDone = false;
+  }
+
+  while ( !_open.empty() ) {
+    // the current plan is within the bound once nothing left in the open list can beat it
+    if ( _hasPlan && (_open.front().key >= _goalG) ) { break; }
+    if ( _config.StopPlanning() ) { return false; }
+
+    std::pop_heap(_open.begin(), _open.end(), OpenCompare);
+    const OpenEntry top = std::move(_open.back());
+    _open.pop_back();
+
+    Node& current = _nodes[top.state];
+    if ( (top.g != current.g) || (current.closedInIter == _iteration) ) { continue; }
+    current.closedInIter = _iteration;
+
+    using Iter = typename IAStarConfig<T, ConfigT>::Successor;
+    for (const Iter& succ : _config.GetSuccessors(top.state) ) {
+      const float newCost = current.g + succ.cost;
+      Node& next = _nodes[succ.state];
+      if ( newCost < next.g ) {
+        next.g = newCost;
+        next.parent = top.state;
+        next.isStart = false;
+
+        if ( (newCost < _goalG) && _config.IsGoal(succ.state) ) {
+          _goal = succ.state;
+          _goalG = newCost;
+          _hasPlan = true;
+        }
+
+        if ( next.closedInIter == _iteration ) {
+          _incons.push_back(succ.state);
+        } else {
+          PushOpen(succ.state, newCost);
+        }
+      }
+    }
+  }
+
+  _iterationDone = true;
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class T, class ConfigT>
+void AnytimeAStar<T, ConfigT>::OnGoalChanged()
+{
+  _hasPlan = false;
+  _goalG = std::numeric_limits<float>::max();
+  for (const auto& entry : _nodes) {
+    if ( (entry.second.g < _goalG) && _config.IsGoal(entry.first) ) {
+      _goal = entry.first;
+      _goalG = entry.second.g;
+      _hasPlan = true;
+    }
+  }
+
+  RebuildOpen();
+  _iterationDone = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class T, class ConfigT>
+void AnytimeAStar<T, ConfigT>::Repair(const std::function<bool (const T&)>& isAffected)
+{
+  // a state is removed if it is affected, or its parent is removed. Resolve every chain of parents once
+  enum class Mark : uint8_t { Unknown, Keep, Remove };
+  std::unordered_map<T, Mark> marks;
+  marks.reserve(_nodes.size());
+
+  std::vector<T> chain;
+  for (const auto& entry : _nodes) {
+    chain.clear();
+    T s = entry.first;
+    Mark result = Mark::Unknown;
+    while ( result == Mark::Unknown ) {
+      const auto known = marks.find(s);
+      if ( known != marks.end() ) {
+        result = known->second;
+        break;
+      }
+
+      const Node& node = _nodes[s];
+      chain.push_back(s);
+      if ( isAffected(s) ) {
+        result = Mark::Remove;
+      } else if ( node.isStart ) {
+        result = Mark::Keep;
+      } else if ( _nodes.find(node.parent) == _nodes.end() ) {
+        result = Mark::Remove;
+      } else {
+        s = node.parent;
+      }
+    }
+
+    for (const auto& c : chain) {
+      marks[c] = result;
+    }
+  }
+
+  // open the surviving parents again so the removed states get generated (or not) from what is there now, and
+  // forget the removed states. Affected start states are seeded again, as there is nowhere else to grow them from
+  std::vector<T> reopen;
+  for (auto it = _nodes.begin(); it != _nodes.end(); ) {
+    if ( marks[it->first] == Mark::Remove ) {
+      if ( it->second.isStart ) {
+        reopen.push_back(it->first);
+      } else if ( marks[it->second.parent] == Mark::Keep ) {
+        reopen.push_back(it->second.parent);
+      }
+      it = _nodes.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  ++_iteration;
+  _epsilon = _initialEpsilon;
+  _incons.clear();
+  for (const auto& s : reopen) {
+    Node& node = _nodes[s];
+    if ( node.g == std::numeric_limits<float>::max() ) {
+      // removed start state
+      node.parent = s;
+      node.g = 0.f;
+      node.isStart = true;
+    }
+    _open.push_back( {s, node.g, 0.f} );
+  }
+
+  // drop open entries for removed states, and re-sort everything for the new epsilon
+  _open.erase( std::remove_if(_open.begin(), _open.end(), [this](const OpenEntry& e) {
+                 return _nodes.find(e.state) == _nodes.end(); }),
+               _open.end() );
+  OnGoalChanged();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class T, class ConfigT>
+void AnytimeAStar<T, ConfigT>::RebuildOpen()
+{
+  std::vector<OpenEntry> entries;
+  entries.swap(_open);
+  for (const auto& e : entries) {
+    const auto node = _nodes.find(e.state);
+    if ( (node != _nodes.end()) && (node->second.g == e.g) && (node->second.closedInIter != _iteration) ) {
+      _open.push_back( {e.state, e.g, e.g + _epsilon * _config.Heuristic(e.state)} );
+    }
+  }
+  std::make_heap(_open.begin(), _open.end(), OpenCompare);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class T, class ConfigT>
+std::vector<T> AnytimeAStar<T, ConfigT>::GetPlan() const
+{
+  std::vector<T> out;
+  if ( !_hasPlan ) { return out; }
+
+  auto next = _nodes.find(_goal);
+  while ( next != _nodes.end() ) {
+    out.push_back(next->first);
+    if ( next->second.isStart ) { break; }
+    next = _nodes.find(next->second.parent);
+  }
+
+  std::reverse(out.begin(), out.end());
+  return out;
+}
+
+} // namespace Anki
+
+
+#endif // __Coretech_Planning_AnytimeAStar_H__
@@ -4,7 +4,7 @@
  * Author: Brad Neuman
  * Created: 2014-04-30
  *
- * Description: open list based on std::map
+ * Description: open list based on an indexed 4-ary min heap
  *
  * Copyright: Anki, Inc. 2014
  *
@@ -12,68 +12,81 @@
 
 #include "openList.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cfloat>
+
 namespace Anki {
 namespace Planning {
 
 using namespace std;
 
-multimap<float, StateID> OpenList::emptyMap_;
-OpenList::iterator OpenList::nullIterator_ = OpenList::emptyMap_.end();
+constexpr OpenList::iterator OpenList::nullIterator_;
 
 OpenList::OpenList()
+  : nextOrder_(0)
 {}
 
 void OpenList::clear()
 {
-  fMap_.clear();
+  heap_.clear();
+  handlePos_.clear();
+  nextOrder_ = 0;
+}
+
+void OpenList::reserve(size_t n)
+{
+  heap_.reserve(n);
+  handlePos_.reserve(n);
 }
 
 StateID OpenList::top() const
 {
-  return (*fMap_.begin()).second;
+  return heap_.front().id;
 }
 
 float OpenList::topF() const
 {
-  return (*fMap_.begin()).first;
+  return heap_.front().f;
 }
 
 StateID OpenList::pop()
 {
-  iterator it = fMap_.begin();
-  StateID ret = (*it).second;
-
-  fMap_.erase(it);
-
+  StateID ret = heap_.front().id;
+  RemoveAt(0);
   return ret;
 }
 
-bool OpenList::empty()
+OpenList::iterator OpenList::insert(StateID id, const float f)
 {
-  return fMap_.empty();
+  const iterator handle = (iterator)handlePos_.size();
+  handlePos_.push_back((u32)heap_.size());
+  heap_.push_back(Node{f, nextOrder_++, id, handle});
+  SiftUp(heap_.size() - 1);
+  return handle;
 }
 
-unsigned int OpenList::size()
+void OpenList::decrease(OpenList::iterator it, const float f)
 {
-  return (unsigned int)fMap_.size();
-}
+  assert(it < handlePos_.size() && handlePos_[it] != nullIterator_);
+  const size_t pos = handlePos_[it];
+  assert(f <= heap_[pos].f);
 
-OpenList::iterator OpenList::insert(StateID id, const float f)
-{
-  return fMap_.insert(pair<float,StateID>(f, id));
+  heap_[pos].f = f;
+  heap_[pos].order = nextOrder_++;
+  SiftUp(pos);
 }
 
 void OpenList::remove(OpenList::iterator it)
 {
-  fMap_.erase(it);
+  assert(it < handlePos_.size() && handlePos_[it] != nullIterator_);
+  RemoveAt(handlePos_[it]);
 }
 
-
 bool OpenList::contains(StateID id) const
 {
-  multimap<float, StateID>::const_iterator it;
-  for(it=fMap_.begin(); it!=fMap_.end(); ++it) {
-    if (it->second == id) {
+  for(const auto& node : heap_) {
+    if (node.id == id) {
       return true;
     }
   }
@@ -82,14 +95,81 @@ bool OpenList::contains(StateID id) const
 
 float OpenList::fVal(StateID id) const
 {
-  multimap<float, StateID>::const_iterator it;
-  for(it=fMap_.begin(); it!=fMap_.end(); ++it) {
-    if (it->second == id) {
-      return it->first;
+  for(const auto& node : heap_) {
+    if (node.id == id) {
+      return node.f;
     }
   }
   return FLT_MAX;
 }
 
+void OpenList::Place(Node&& node, size_t pos)
+{
+  handlePos_[node.handle] = (u32)pos;
+  heap_[pos] = std::move(node);
+}
+
+void OpenList::SiftUp(size_t pos)
+{
+  Node node = heap_[pos];
+  while(pos > 0) {
+    const size_t parent = (pos - 1) / kArity;
+    if( !Before(node, heap_[parent]) ) {
+      break;
+    }
+    Place(std::move(heap_[parent]), pos);
+    pos = parent;
+  }
+  Place(std::move(node), pos);
+}
+
+void OpenList::SiftDown(size_t pos)
+{
+  const size_t n = heap_.size();
+  Node node = heap_[pos];
+  while(true) {
+    const size_t firstChild = pos * kArity + 1;
+    if( firstChild >= n ) {
+      break;
+    }
+
+    size_t best = firstChild;
+    const size_t lastChild = std::min(firstChild + kArity, n);
+    for(size_t child = firstChild + 1; child < lastChild; ++child) {
+      if( Before(heap_[child], heap_[best]) ) {
+        best = child;
+      }
+    }
+
+    if( !Before(heap_[best], node) ) {
+      break;
+    }
+    Place(std::move(heap_[best]), pos);
+    pos = best;
+  }
+  Place(std::move(node), pos);
+}
+
+void OpenList::RemoveAt(size_t pos)
+{
+  handlePos_[heap_[pos].handle] = nullIterator_;
+
+  const size_t last = heap_.size() - 1;
+  if( pos != last ) {
+    // fill the hole with the last node, which may need to go either way from here
+    Place(std::move(heap_[last]), pos);
+    heap_.pop_back();
+    if( pos > 0 && Before(heap_[pos], heap_[(pos - 1) / kArity]) ) {
+      SiftUp(pos);
+    }
+    else {
+      SiftDown(pos);
+    }
+  }
+  else {
+    heap_.pop_back();
+  }
+}
+
 }
 }
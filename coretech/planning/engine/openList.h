@@ -1,10 +1,10 @@
 /**
- * File: openList.cpp
+ * File: openList.h
  *
  * Author: Brad Neuman
  * Created: 2014-04-30
  *
- * Description: open list based on std::multimap
+ * Description: open list based on an indexed 4-ary min heap, with decrease-key
  *
  * Copyright: Anki, Inc. 2014
  *
@@ -14,7 +14,7 @@
 #define _ANKICORETECH_PLANNING_OPENLIST_H_
 
 #include "coretech/planning/engine/xythetaEnvironment.h"
-#include <map>
+#include <vector>
 
 namespace Anki {
 namespace Planning {
@@ -24,13 +24,18 @@ class OpenList
 
 public:
 
-  typedef std::multimap<float, StateID>::iterator iterator;
+  // Stable reference to an entry, valid until it is popped or removed (or the list is cleared). Entries move around
+  // inside the heap, so this is what callers hold on to instead of a position
+  typedef u32 iterator;
 
   OpenList();
 
-  // Clears the open list
+  // Clears the open list. Keeps the memory around for the next search
   void clear();
 
+  // Reserve space for the given number of entries
+  void reserve(size_t n);
+
   // Return the first element
   StateID top() const;
 
@@ -40,28 +45,23 @@ public:
   // Remove and return the first element
   StateID pop();
 
-  bool empty();
+  bool empty() const { return heap_.empty(); }
 
-  unsigned int size();
+  unsigned int size() const { return (unsigned int)heap_.size(); }
 
   // Inserts a new entry into the open list. Do not call this if there
   // is already an entry associated with the state
   iterator insert(StateID stateID, const float f);
 
+  // Lowers the f value of an existing entry. Ties are broken as if it had been removed and inserted again
+  void decrease(iterator it, const float f);
+
   // Returns a "null iterator" that will always be consistent
   static iterator nullIterator() {return nullIterator_;}
 
   // removes an iterator.
   void remove(iterator it);
 
-  // allows iteration through the internal map
-  std::multimap<float, StateID>::iterator begin() { return fMap_.begin(); };
-  std::multimap<float, StateID>::iterator end() { return fMap_.end(); };
-
-  // const versions
-  std::multimap<float, StateID>::const_iterator begin() const { return fMap_.begin(); };
-  std::multimap<float, StateID>::const_iterator end() const { return fMap_.end(); };
-
   // Returns true if the state is contained in the open list. warning:
   // these are both linear time!! don't call these
   bool contains(StateID id) const;
@@ -69,19 +69,41 @@ public:
   // returns very high number if id is not in this list, otherwise
   // returns the f value. Linear time function!
   float fVal(StateID id) const;
-  
+
 private:
 
-  // Multimap is internally stored as a min heap
-  // This multimap maps from a given f value to a state ID
-  std::multimap<float, StateID> fMap_;
+  static constexpr size_t kArity = 4;
+
+  struct Node
+  {
+    float   f;
+    u32     order;  // insertion counter, so that equal f values come out first in, first out
+    StateID id;
+    u32     handle;
+  };
+
+  static bool Before(const Node& a, const Node& b) { return (a.f < b.f) || ((a.f == b.f) && (a.order < b.order)); }
+
+  // move the node at the given position up or down until the heap property holds again
+  void SiftUp(size_t pos);
+  void SiftDown(size_t pos);
+
+  // puts node at pos, and updates its handle
+  void Place(Node&& node, size_t pos);
+
+  // removes the node at the given position
+  void RemoveAt(size_t pos);
+
+  // heap ordered nodes, with the minimum at the front
+  std::vector<Node> heap_;
+
+  // position in heap_ of every handle handed out since the last clear, or nullIterator_ if no longer in the list
+  std::vector<u32> handlePos_;
 
-  // empty map that is used to obtain a valid "null iterator" to
-  // signify an empty slot
-  static std::multimap<float, StateID> emptyMap_;
+  u32 nextOrder_;
 
-  // the null iterator itself
-  static iterator nullIterator_;
+  // signifies an empty slot
+  static constexpr iterator nullIterator_ = (iterator)-1;
 };
 
 }
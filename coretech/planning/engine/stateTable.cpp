@@ -13,38 +13,76 @@
 
 #include "stateTable.h"
 
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+
 namespace Anki
 {
 namespace Planning
 {
 
+namespace {
+  constexpr u32 kInitialSlotBits = 12;
+}
+
 StateTable::StateTable()
+  : slots_(1u << kInitialSlotBits, Slot{0, 0, 0})
+  , slotShift_(32 - kInitialSlotBits)
+  , generation_(1)
 {
 }
 
 void StateTable::Clear()
 {
-  table_.clear();
+  // everything from the previous generation is now considered empty
+  ++generation_;
+  if( generation_ == 0 ) {
+    // wrapped around, so old slots could look in use again
+    std::fill(slots_.begin(), slots_.end(), Slot{0, 0, 0});
+    generation_ = 1;
+  }
+
+  keys_.clear();
+  for( auto& chunk : chunks_ ) {
+    chunk.clear();
+  }
 }
 
-StateEntry& StateTable::operator[](const StateID& sid)
+size_t StateTable::FindSlot(u32 sid) const
 {
-  return table_[sid];
+  // fibonacci hashing spreads the packed x/y/theta bits over the table, then probe linearly
+  const size_t mask = slots_.size() - 1;
+  size_t idx = (size_t)((sid * 2654435769u) >> slotShift_);
+  while( slots_[idx].generation == generation_ && slots_[idx].key != sid ) {
+    idx = (idx + 1) & mask;
+  }
+  return idx;
 }
 
 StateTable::iterator StateTable::find(StateID sid)
 {
-  return table_.find(sid);
+  const Slot& slot = slots_[FindSlot(sid)];
+  return (slot.generation == generation_) ? &GetEntry(slot.entryIdx) : end();
 }
 
-StateTable::const_iterator StateTable::begin() const
+StateTable::const_iterator StateTable::find(StateID sid) const
 {
-  return table_.begin();
+  const Slot& slot = slots_[FindSlot(sid)];
+  return (slot.generation == generation_) ? &GetEntry(slot.entryIdx) : end();
 }
 
-StateTable::const_iterator StateTable::end() const
+StateEntry& StateTable::operator[](const StateID& sid)
 {
-  return table_.end();
+  iterator it = find(sid);
+  if( it == end() ) {
+    // same values as the StateEntry default constructor
+    printf("WARNING: default StateEntry constructor called. This is a performance bug\n");
+    const u32 entryIdx = (u32)keys_.size();
+    emplace(sid, OpenList::nullIterator(), StateID(), 0, 0.0f, -1.0f);
+    it = &GetEntry(entryIdx);
+  }
+  return *it;
 }
 
 void StateTable::emplace(StateID sid,
@@ -54,15 +92,42 @@ void StateTable::emplace(StateID sid,
                          Cost penalty,
                          Cost g)
 {
+  // keep the load factor at or below one half, so probe sequences stay short
+  if( 2 * (keys_.size() + 1) > slots_.size() ) {
+    Grow();
+  }
+
+  const size_t slotIdx = FindSlot(sid);
+  assert( slots_[slotIdx].generation != generation_ );
+
+  const u32 entryIdx = (u32)keys_.size();
+  const size_t chunkIdx = entryIdx / kEntriesPerChunk;
+  if( chunkIdx == chunks_.size() ) {
+    chunks_.emplace_back();
+    chunks_.back().reserve(kEntriesPerChunk);
+  }
+
   // this version of implace uses the argument constructor for
   // StateEntry, so only one state entry is ever created, no copying
-  table_.emplace(std::piecewise_construct,
-                 std::forward_as_tuple(sid),
-                 std::forward_as_tuple(openIt,
-                                       backpointer,
-                                       backpointerAction,
-                                       penalty,
-                                       g));
+  chunks_[chunkIdx].emplace_back(openIt,
+                                 backpointer,
+                                 backpointerAction,
+                                 penalty,
+                                 g);
+  keys_.push_back(sid);
+  slots_[slotIdx] = Slot{sid, entryIdx, generation_};
+}
+
+void StateTable::Grow()
+{
+  slots_.assign(2 * slots_.size(), Slot{0, 0, 0});
+  --slotShift_;
+  generation_ = 1;
+
+  for( u32 entryIdx = 0; entryIdx < (u32)keys_.size(); ++entryIdx ) {
+    const u32 key = keys_[entryIdx];
+    slots_[FindSlot(key)] = Slot{key, entryIdx, generation_};
+  }
 }
 
 }
@@ -16,7 +16,7 @@
 // TODO:(bn) pull out basic defined from environment, so we don't need the whole thing
 #include "coretech/planning/engine/xythetaEnvironment.h"
 #include "openList.h"
-#include <unordered_map>
+#include <vector>
 
 namespace Anki
 {
@@ -63,6 +63,7 @@ struct StateEntry
     }    
 
   StateEntry() :
+    openIt_(OpenList::nullIterator()),
     closedIter_(-1),
     penaltyIntoState_(0.0),
     g_(-1.0)
@@ -87,19 +88,27 @@ struct StateEntry
   Cost g_;
 };
 
+// Open addressed hash table from StateID to StateEntry. Entries are stored in fixed size chunks so that references
+// to them stay valid as the table grows, and all the memory (slots and chunks) is kept when clearing, so a planner
+// that keeps its table around does not allocate again until a search is bigger than any before it
 class StateTable
 {
 public:
-  typedef std::unordered_map<u32, StateEntry>::iterator iterator;
-  typedef std::unordered_map<u32, StateEntry>::const_iterator const_iterator;
+  typedef StateEntry* iterator;
+  typedef const StateEntry* const_iterator;
 
   StateTable();
 
+  // Removes all entries in constant time
   void Clear();
 
+  size_t size() const { return keys_.size(); }
+
+  // returns end() if sid is not in the table
   iterator find(StateID sid);
-  const_iterator begin() const;
-  const_iterator end() const;
+  const_iterator find(StateID sid) const;
+  iterator end() { return nullptr; }
+  const_iterator end() const { return nullptr; }
 
   StateEntry& operator[](const StateID& sid);
 
@@ -113,7 +122,34 @@ public:
                Cost g);
 
 private:
-  std::unordered_map<u32, StateEntry> table_;
+
+  static constexpr size_t kEntriesPerChunk = 4096;
+
+  struct Slot
+  {
+    u32 key;
+    u32 entryIdx;
+    u32 generation; // slot is in use only if this matches generation_
+  };
+
+  // slot where sid is, or the empty slot where it would go
+  size_t FindSlot(u32 sid) const;
+
+  // doubles the number of slots and reinserts all entries
+  void Grow();
+
+  StateEntry& GetEntry(u32 entryIdx) { return chunks_[entryIdx / kEntriesPerChunk][entryIdx % kEntriesPerChunk]; }
+  const StateEntry& GetEntry(u32 entryIdx) const { return chunks_[entryIdx / kEntriesPerChunk][entryIdx % kEntriesPerChunk]; }
+
+  std::vector<Slot> slots_; // size is always a power of two
+  u32 slotShift_;           // 32 - log2(slots_.size()), for hashing into slots_
+  u32 generation_;
+
+  // key of each entry, in insertion order
+  std::vector<u32> keys_;
+
+  // entries in insertion order. Each chunk is reserved to kEntriesPerChunk, so never reallocates
+  std::vector<std::vector<StateEntry>> chunks_;
 };
 
 
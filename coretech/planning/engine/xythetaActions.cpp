@@ -190,7 +190,12 @@ void MotionPrimitive::CacheBoundingBox()
   minY = std::numeric_limits<decltype(minY)>::max();
   maxY = std::numeric_limits<decltype(maxY)>::min();
 
+  intermediatePoints.clear();
+  intermediatePoints.reserve(intermediatePositions.size());
+
   for( const auto& pt : intermediatePositions ) {
+    intermediatePoints.emplace_back(pt.position.x_mm, pt.position.y_mm);
+
     if( pt.position.x_mm < minX ) {
       minX = pt.position.x_mm;
     }
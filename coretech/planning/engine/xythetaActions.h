@@ -143,9 +143,12 @@ public:
   float minY;
   float maxY;
 
+  // just the x/y of each of intermediatePositions, for batch collision checks
+  std::vector<Point2f> intermediatePoints;
+
 private:
 
-  // compute min/max x/y
+  // compute min/max x/y and intermediatePoints
   void CacheBoundingBox(); 
 
   Path pathSegments_;
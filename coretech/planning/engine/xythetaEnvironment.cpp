@@ -35,6 +35,9 @@ namespace Planning {
 
 #define REPLAN_PENALTY_BUFFER 0.5
 
+// upper limit on the number of cached action costs. The cache is simply dropped when it fills up
+#define MAX_NUM_CACHED_ACTION_COSTS 100000
+
 // #define HACK_USE_FIXED_SPEED 60.0
 
 SuccessorIterator::SuccessorIterator(const xythetaEnvironment* env, StateID startID, Cost startG, bool reverse)
@@ -114,7 +117,20 @@ void SuccessorIterator::Next(const xythetaEnvironment& env)
       }
     }
 
-    
+
+    // actions near obstacles need the full check, unless it was already done for an earlier expansion or replan
+    const bool useCache = possibleObstacle && !env.obstaclesChanged_;
+    u64 cacheKey = 0;
+    if( useCache ) {
+      cacheKey = xythetaEnvironment::GetActionCostKey(start_.GetStateID(), nextAction_, reverse_);
+      const auto cached = env.actionCostCache_.find(cacheKey);
+      if( cached != env.actionCostCache_.end() ) {
+        penalty = cached->second.penalty;
+        collision = cached->second.collision;
+        possibleObstacle = false;
+      }
+    }
+
     if( possibleObstacle ) {
 
       // two collision check cases. If the angle is changing, then we'll need to potentially switch which
@@ -133,9 +149,15 @@ void SuccessorIterator::Next(const xythetaEnvironment& env)
             continue;
           }
 
-          for( const auto& pt : prim->intermediatePositions ) {
-            if( obs.first.Contains(primtiveOffset.x_mm + pt.position.x_mm,
-                                   primtiveOffset.y_mm + pt.position.y_mm ) ) {
+          // check all of the points at once, then go through the ones that were inside
+          auto& contained = env.containedPointsScratch_;
+          if( 0 == obs.first.ContainsMany(prim->intermediatePoints, contained, primtiveOffset.GetPointXY_mm()) ) {
+            continue;
+          }
+
+          for( size_t ptIdx = 0; ptIdx < contained.size(); ++ptIdx ) {
+            if( contained[ptIdx] ) {
+              const auto& pt = prim->intermediatePositions[ptIdx];
 
               if(obs.second >= MAX_OBSTACLE_COST) {
                 collision = true;
@@ -181,6 +203,13 @@ void SuccessorIterator::Next(const xythetaEnvironment& env)
           }
         }
       }
+
+      if( useCache ) {
+        if( env.actionCostCache_.size() >= MAX_NUM_CACHED_ACTION_COSTS ) {
+          env.actionCostCache_.clear();
+        }
+        env.actionCostCache_.emplace(cacheKey, xythetaEnvironment::CachedActionCost{penalty, collision});
+      }
     }
 
     assert(!isinf(penalty));
@@ -501,6 +530,138 @@ void xythetaEnvironment::PrepareForPlanning()
       }
     }
   }
+
+  UpdateActionCostCache();
+}
+
+namespace {
+
+bool IsSameObstacle(const std::pair<FastPolygon, Cost>& a, const std::pair<FastPolygon, Cost>& b)
+{
+  if( a.second != b.second ||
+      a.first.size() != b.first.size() ||
+      a.first.GetMinX() != b.first.GetMinX() ||
+      a.first.GetMaxX() != b.first.GetMaxX() ||
+      a.first.GetMinY() != b.first.GetMinY() ||
+      a.first.GetMaxY() != b.first.GetMaxY() ) {
+    return false;
+  }
+
+  for( size_t i = 0; i < a.first.size(); ++i ) {
+    if( a.first[i].x() != b.first[i].x() ||
+        a.first[i].y() != b.first[i].y() ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}
+
+void xythetaEnvironment::UpdateActionCostCache()
+{
+  obstaclesChanged_ = false;
+
+  if( cachedObstaclesPerAngle_.size() != obstaclesPerAngle_.size() ) {
+    ClearActionCostCache();
+    cachedObstaclesPerAngle_ = obstaclesPerAngle_;
+    ++obstacleVersion_;
+    return;
+  }
+
+  // obstacles usually get cleared and re-added before every replan, so compare by value. Anything found in only
+  // one of the two sets has changed
+  std::vector< Bounds > changedBounds;
+  std::vector< bool > matched;
+
+  for(size_t angle = 0; angle < obstaclesPerAngle_.size(); ++angle) {
+    const auto& oldObstacles = cachedObstaclesPerAngle_[angle];
+    matched.assign(oldObstacles.size(), false);
+
+    for( const auto& obs : obstaclesPerAngle_[angle] ) {
+      bool found = false;
+      for( size_t oldIdx = 0; oldIdx < oldObstacles.size(); ++oldIdx ) {
+        if( !matched[oldIdx] && IsSameObstacle(obs, oldObstacles[oldIdx]) ) {
+          matched[oldIdx] = true;
+          found = true;
+          break;
+        }
+      }
+
+      if( !found ) {
+        changedBounds.emplace_back();
+        changedBounds.back().minX = obs.first.GetMinX();
+        changedBounds.back().maxX = obs.first.GetMaxX();
+        changedBounds.back().minY = obs.first.GetMinY();
+        changedBounds.back().maxY = obs.first.GetMaxY();
+      }
+    }
+
+    for( size_t oldIdx = 0; oldIdx < oldObstacles.size(); ++oldIdx ) {
+      if( !matched[oldIdx] ) {
+        changedBounds.emplace_back();
+        changedBounds.back().minX = oldObstacles[oldIdx].first.GetMinX();
+        changedBounds.back().maxX = oldObstacles[oldIdx].first.GetMaxX();
+        changedBounds.back().minY = oldObstacles[oldIdx].first.GetMinY();
+        changedBounds.back().maxY = oldObstacles[oldIdx].first.GetMaxY();
+      }
+    }
+  }
+
+  if( changedBounds.empty() ) {
+    return;
+  }
+
+  ++obstacleVersion_;
+  cachedObstaclesPerAngle_ = obstaclesPerAngle_;
+
+  // drop every cached action which could touch one of the changed obstacles. This is the same bounding box
+  // test the SuccessorIterator uses to decide if an action needs to be checked at all
+  for( auto it = actionCostCache_.begin(); it != actionCostCache_.end(); ) {
+    const GraphState start( StateID( (u32)(it->first >> 9) ) );
+    const ActionID actionIdx = (ActionID)((it->first >> 1) & 0xFF);
+    const bool reverse = (it->first & 1) != 0;
+
+    const MotionPrimitive& prim = reverse ? allActions_.GetReverseMotion((size_t)start.theta, actionIdx)
+                                          : allActions_.GetForwardMotion((size_t)start.theta, actionIdx);
+
+    State_c primitiveOffset = State2State_c(start);
+    if( reverse ) {
+      GraphState result(start);
+      result.x += prim.endStateOffset.x;
+      result.y += prim.endStateOffset.y;
+      result.theta = prim.endStateOffset.theta;
+      primitiveOffset = State2State_c(result);
+    }
+
+    const float minPrimX = prim.minX + primitiveOffset.x_mm;
+    const float maxPrimX = prim.maxX + primitiveOffset.x_mm;
+    const float minPrimY = prim.minY + primitiveOffset.y_mm;
+    const float maxPrimY = prim.maxY + primitiveOffset.y_mm;
+
+    bool overlaps = false;
+    for( const auto& bound : changedBounds ) {
+      if( !( maxPrimX < bound.minX ||
+             minPrimX > bound.maxX ||
+             maxPrimY < bound.minY ||
+             minPrimY > bound.maxY ) ) {
+        overlaps = true;
+        break;
+      }
+    }
+
+    if( overlaps ) {
+      it = actionCostCache_.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+void xythetaEnvironment::ClearActionCostCache()
+{
+  actionCostCache_.clear();
 }
 
 bool xythetaEnvironment::IsInCollision(GraphState s) const
@@ -550,6 +711,8 @@ xythetaEnvironment::~xythetaEnvironment()
 }
 
 xythetaEnvironment::xythetaEnvironment()
+  : obstacleVersion_(0)
+  , obstaclesChanged_(false)
 {
   obstaclesPerAngle_.resize(GraphState::numAngles_);
 }
@@ -557,6 +720,7 @@ xythetaEnvironment::xythetaEnvironment()
 bool xythetaEnvironment::Init(const Json::Value& mprimJson)
 {
   ClearObstacles();
+  ClearActionCostCache();
   return allActions_.ParseMotionPrims(mprimJson);
 }
 
@@ -640,6 +804,7 @@ bool xythetaEnvironment::ReadMotionPrimitives(const char* mprimFilename)
         <<"'\n" << reader.getFormattedErrorMessages()<<endl;
   }
 
+  ClearActionCostCache();
   return allActions_.ParseMotionPrims(mprimTree, false);
 }
 
@@ -692,6 +857,7 @@ bool xythetaEnvironment::ParseObstacles(const Json::Value& config)
         }
 
         obstaclesPerAngle_[theta].push_back( std::make_pair( FastPolygon{ p }, c ) );
+        obstaclesChanged_ = true;
       }
     }
   }
@@ -738,6 +904,7 @@ void xythetaEnvironment::AddObstacleAllThetas(const Quad2f& quad, Cost cost)
   for(size_t i=0; i<GraphState::numAngles_; ++i) {
     obstaclesPerAngle_[i].push_back( std::make_pair( fastPoly, cost ) );
   }
+  obstaclesChanged_ = true;
 }
   
 void xythetaEnvironment::AddObstacleAllThetas(const RotatedRectangle& rect, Cost cost)
@@ -748,6 +915,7 @@ void xythetaEnvironment::AddObstacleAllThetas(const RotatedRectangle& rect, Cost
   for(size_t i=0; i<GraphState::numAngles_; ++i) {
     obstaclesPerAngle_[i].push_back( std::make_pair( fastPoly, cost ) );
   }
+  obstaclesChanged_ = true;
 }
 
 void xythetaEnvironment::ClearObstacles()
@@ -755,6 +923,7 @@ void xythetaEnvironment::ClearObstacles()
   for(size_t i=0; i<GraphState::numAngles_; ++i) {
     obstaclesPerAngle_[i].clear();
   }
+  obstaclesChanged_ = true;
 }
 
 FastPolygon xythetaEnvironment::ExpandCSpace(const ConvexPolygon& obstacle,
@@ -880,6 +1049,7 @@ const FastPolygon& xythetaEnvironment::AddObstacleWithExpansion(const ConvexPoly
   }
 
   obstaclesPerAngle_[theta].emplace_back(std::make_pair(ExpandCSpace(obstacle, robot), cost));
+  obstaclesChanged_ = true;
 
   return obstaclesPerAngle_[theta].back().first;
 }
@@ -12,6 +12,7 @@
 #include <cmath>
 #include <cfloat>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 namespace Anki
@@ -129,6 +130,10 @@ public:
 
   size_t GetNumObstacles() const;
 
+  // Incremented by PrepareForPlanning whenever the set of obstacles differs from the one seen last time. Clearing
+  // and re-adding the same obstacles does not count as a change
+  u32 GetObstacleVersion() const { return obstacleVersion_; }
+
   // Returns an iterator to the successors from state "start". Use this one if you want to check each
   // action. If reverse is true, then get predecessors (reverse successors) instead
   SuccessorIterator GetSuccessors(StateID startID, Cost currG, bool reverse = false) const;
@@ -193,7 +198,8 @@ public:
 
   // If we are going to be doing a full planner cycle, this function
   // will be called to prepare the environment, including
-  // precomputing things, etc.
+  // precomputing things, etc. This is also where cached action costs
+  // which overlap an added or removed obstacle are thrown away
   void PrepareForPlanning();
 
   // Returns true if there is a fatal collision at the given state
@@ -254,6 +260,40 @@ private:
   // in obstaclesPerAngle_
   // NOTE: (mrw) FastPolygon already has the AABB for us...
   std::vector< Bounds > obstacleBounds_;
+
+  // Result of the full collision check of one action from one state
+  struct CachedActionCost {
+    Cost penalty;
+    bool collision;
+  };
+
+  // key for the action cost cache. actionIdx is the index used by the SuccessorIterator, so forward and reverse
+  // motions are stored separately
+  static inline u64 GetActionCostKey(StateID start, ActionID actionIdx, bool reverse) {
+    return ( ((u64)start.v) << 9 ) | ( ((u64)actionIdx) << 1 ) | (reverse ? 1 : 0);
+  }
+
+  // compares the obstacles against the ones the cache was built with, and drops every cached action whose
+  // bounding box overlaps an obstacle that was added or removed
+  void UpdateActionCostCache();
+
+  void ClearActionCostCache();
+
+  // Collision check results for actions that pass close enough to an obstacle to need the full check. Shared
+  // between expansions and between replans, as long as the obstacles near the action didn't change
+  mutable std::unordered_map< u64, CachedActionCost > actionCostCache_;
+
+  // reused by successor collision checks, so batch point checks don't allocate
+  mutable std::vector<bool> containedPointsScratch_;
+
+  // copy of obstaclesPerAngle_ as of the last PrepareForPlanning, used to find which obstacles changed
+  std::vector< std::vector< std::pair<FastPolygon, Cost> > > cachedObstaclesPerAngle_;
+
+  u32 obstacleVersion_;
+
+  // true if obstacles were added or cleared since the last PrepareForPlanning. The cache is not used until that
+  // is called again, since it doesn't know about the new obstacles yet
+  bool obstaclesChanged_;
 };
 
 
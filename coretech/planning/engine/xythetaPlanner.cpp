@@ -697,22 +697,21 @@ void xythetaPlannerImpl::ExpandState(StateID currID)
     }
     // TODO:(bn) opt: delay computing the cost. If the node is closed, don't need to compute it. As I'm
     // computing it, pass in the oldEntry g value, because as soon as we hit that, we could bail out early
-    else if(!oldEntry->second.IsClosed(_searchNum)) {
+    else if(!oldEntry->IsClosed(_searchNum)) {
       // only update if g value is lower
-      if(newG < oldEntry->second.g_) {
+      if(newG < oldEntry->g_) {
         Cost h = heur(nextID);
         Cost f = newG + h;
 
         // if the states are in the table, then they were in the open list at some point. Since they aren't
-        // closed now, they must still be in Open, so remove the old entry to insert the new one
-        assert( oldEntry->second.openIt_ != _open.nullIterator() );
-        _open.remove(oldEntry->second.openIt_);
-        oldEntry->second.openIt_ = _open.insert(nextID, f);
-
-        oldEntry->second.closedIter_ = -1;
-        oldEntry->second.backpointer_ = currID;
-        oldEntry->second.backpointerAction_ = it.Front().actionID;
-        oldEntry->second.g_ = newG;
+        // closed now, they must still be in Open, so lower the f value of their entry
+        assert( oldEntry->openIt_ != _open.nullIterator() );
+        _open.decrease(oldEntry->openIt_, f);
+
+        oldEntry->closedIter_ = -1;
+        oldEntry->backpointer_ = currID;
+        oldEntry->backpointerAction_ = it.Front().actionID;
+        oldEntry->g_ = newG;
       }
     }
 
@@ -762,8 +761,8 @@ void xythetaPlannerImpl::BuildPlan()
     auto it = _table.find(curr);
     assert(it != _table.end());
 
-    _plan.Push(it->second.backpointerAction_, it->second.penaltyIntoState_);
-    curr = it->second.backpointer_;
+    _plan.Push(it->backpointerAction_, it->penaltyIntoState_);
+    curr = it->backpointer_;
   }  
 
   _plan.Reverse();
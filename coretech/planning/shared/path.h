@@ -5,9 +5,9 @@
 #include <string>
 #include <stddef.h>
 
-// The robot has limited memory for paths, so hold fewer segments at a
-// time on the robot. The basestation will dole out the path bit by
-// bit
+// The robot holds as many segments as the basestation does, so PathDolerOuter
+// sends a whole path as soon as it is set. If the robot ever holds fewer, the
+// rest is doled out bit by bit as the robot frees up space.
 //NOTE: these need to be even!!
 #define MAX_NUM_PATH_SEGMENTS_ROBOT 128
 #define MAX_NUM_PATH_SEGMENTS_BASESTATION 128
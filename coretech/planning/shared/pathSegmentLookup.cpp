@@ -0,0 +1,156 @@
+#include "coretech/planning/shared/pathSegmentLookup.h"
+#include "coretech/common/shared/math/radians.h"
+#include "util/math/math.h"
+#include <math.h>
+
+namespace Anki
+{
+  namespace Planning
+  {
+
+    // Lines shorter than this have no usable direction
+    static const f32 MIN_LINE_LENGTH_MM = 1e-3f;
+
+    void PathSegmentLookup::Set(const PathSegment& segment)
+    {
+      type_ = segment.GetType();
+      segment_ = segment;
+      length_ = 0.f;
+
+      switch(type_) {
+        case PST_LINE:
+        {
+          const PathSegmentDef::s_line& line = segment.GetDef().line;
+          const f32 dx = line.endPt_x - line.startPt_x;
+          const f32 dy = line.endPt_y - line.startPt_y;
+          length_ = sqrtf(dx*dx + dy*dy);
+          x_ = line.startPt_x;
+          y_ = line.startPt_y;
+          if (length_ >= MIN_LINE_LENGTH_MM) {
+            dirX_ = dx / length_;
+            dirY_ = dy / length_;
+          } else {
+            dirX_ = dirY_ = 0.f;
+          }
+          angle_ = atan2f(dy, dx);
+          break;
+        }
+        case PST_ARC:
+        {
+          const PathSegmentDef::s_arc& arc = segment.GetDef().arc;
+          length_ = segment.GetLength();
+          x_ = arc.centerPt_x;
+          y_ = arc.centerPt_y;
+          radius_ = arc.radius;
+          sweepRad_ = arc.sweepRad;
+          startRad_ = Radians(arc.startRad).ToFloat();
+          endRad_ = Radians(arc.startRad + arc.sweepRad).ToFloat();
+          movingCCW_ = (arc.sweepRad >= 0);
+
+          // Same thresholds as PathSegment::GetDistToArcSegment()
+          if (movingCCW_) {
+            nearEndWrapRad_   = -0.5f*(2.f*M_PI_F - sweepRad_);
+            nearStartWrapRad_ = nearEndWrapRad_;
+          } else {
+            nearEndWrapRad_   = 0.5f*(2.f*M_PI_F + sweepRad_);
+            nearStartWrapRad_ = 0.5f*(2.f*M_PI_F - sweepRad_);
+          }
+          break;
+        }
+        default:
+          break;
+      }
+    }
+
+    SegmentRangeStatus PathSegmentLookup::GetDistToSegment(const f32 x, const f32 y, const f32 angle,
+                                                           f32 &shortestDistanceToPath, f32 &radDiff,
+                                                           f32 *distAlongSegmentFromClosestPointToEnd) const
+    {
+      SegmentRangeStatus res = OOR_NEAR_END;
+      f32 distToEnd = 0.f;
+
+      switch(type_) {
+        case PST_LINE:
+          res = GetDistToLineSegment(x, y, angle, shortestDistanceToPath, radDiff, distToEnd);
+          break;
+        case PST_ARC:
+          res = GetDistToArcSegment(x, y, angle, shortestDistanceToPath, radDiff, distToEnd);
+          break;
+        default:
+          return segment_.GetDistToSegment(x, y, angle, shortestDistanceToPath, radDiff,
+                                           distAlongSegmentFromClosestPointToEnd);
+      }
+
+      if (distAlongSegmentFromClosestPointToEnd) {
+        *distAlongSegmentFromClosestPointToEnd = distToEnd;
+      }
+      return res;
+    }
+
+    SegmentRangeStatus PathSegmentLookup::GetDistToLineSegment(const f32 x, const f32 y, const f32 angle,
+                                                               f32 &shortestDistanceToPath, f32 &radDiff,
+                                                               f32 &distToEnd) const
+    {
+      // Position of the test point along the line from the start point, and to its left
+      const f32 dx = x - x_;
+      const f32 dy = y - y_;
+      const f32 distAlong = dx*dirX_ + dy*dirY_;
+
+      // +ve when the path is to the right of the test point, i.e. the point is left of the line
+      shortestDistanceToPath = dirX_*dy - dirY_*dx;
+      radDiff = (Radians(angle_) - angle).ToFloat();
+      distToEnd = length_ - distAlong;
+
+      if (length_ < MIN_LINE_LENGTH_MM) {
+        distToEnd = 0.f;
+        return OOR_NEAR_END;
+      }
+
+      // If the closest point on the line is beyond either end, the test point is out of range on that end
+      if (distAlong > length_) {
+        return OOR_NEAR_END;
+      } else if (distAlong < 0.f) {
+        return OOR_NEAR_START;
+      }
+      return IN_SEGMENT_RANGE;
+    }
+
+    SegmentRangeStatus PathSegmentLookup::GetDistToArcSegment(const f32 x, const f32 y, const f32 angle,
+                                                              f32 &shortestDistanceToPath, f32 &radDiff,
+                                                              f32 &distToEnd) const
+    {
+      // Line formed by arc center and test point
+      const f32 dx = x - x_;
+      const f32 dy = y - y_;
+      const Radians theta_line = atan2f(dy, dx);
+      const Radians theta_tangent = theta_line + (movingCCW_ ? M_PI_2_F : -M_PI_2_F);
+      radDiff = (theta_tangent - angle).ToFloat();
+
+      shortestDistanceToPath = sqrtf(dx*dx + dy*dy) - radius_;
+      if (movingCCW_) {
+        shortestDistanceToPath *= -1;
+      }
+
+      distToEnd = fabsf((Radians(endRad_) - theta_line).ToFloat() * radius_);
+
+      const f32 angDiff = (theta_line - startRad_).ToFloat();
+      if (movingCCW_) {
+        if (angDiff > sweepRad_ || angDiff < nearEndWrapRad_) {
+          distToEnd = -distToEnd;
+          return OOR_NEAR_END;
+        } else if (angDiff < 0 && angDiff > nearStartWrapRad_) {
+          return OOR_NEAR_START;
+        }
+      } else {
+        if (angDiff < sweepRad_ || angDiff > nearEndWrapRad_) {
+          distToEnd = -distToEnd;
+          return OOR_NEAR_END;
+        } else if (angDiff > 0 && angDiff < nearStartWrapRad_) {
+          return OOR_NEAR_START;
+        }
+      }
+      return IN_SEGMENT_RANGE;
+    }
+
+  } // namespace Planning
+} // namespace Anki
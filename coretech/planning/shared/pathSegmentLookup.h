@@ -0,0 +1,84 @@
+/**
+ * File: pathSegmentLookup.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Arc-length parameterization of a single path segment, precomputed once when the segment is
+ *              started so that computing the distance to it on every control tick is a constant time projection
+ *              onto a unit direction (lines) or an angle lookup around the center (arcs), rather than
+ *              recomputing slopes, segment angles and range thresholds from the segment definition each time.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef PATH_SEGMENT_LOOKUP_H_
+#define PATH_SEGMENT_LOOKUP_H_
+
+#include "coretech/planning/shared/path.h"
+
+namespace Anki
+{
+  namespace Planning
+  {
+
+    class PathSegmentLookup
+    {
+    public:
+      PathSegmentLookup() : type_(PST_UNKNOWN) {};
+      explicit PathSegmentLookup(const PathSegment& segment) { Set(segment); }
+
+      // Precomputes everything about segment that doesn't depend on the test point.
+      // Must be called again if segment is modified.
+      void Set(const PathSegment& segment);
+
+      PathSegmentType GetType() const {return type_;}
+
+      // Length of the segment in mm (0 for point turns)
+      f32 GetLength() const {return length_;}
+
+      // Same as PathSegment::GetDistToSegment() for the segment passed to Set(). Zero length lines are
+      // reported as already passed (OOR_NEAR_END) so that they are skipped.
+      SegmentRangeStatus GetDistToSegment(const f32 x, const f32 y, const f32 angle,
+                                          f32 &shortestDistanceToPath, f32 &radDiff,
+                                          f32 *distAlongSegmentFromClosestPointToEnd = NULL) const;
+
+    private:
+      SegmentRangeStatus GetDistToLineSegment(const f32 x, const f32 y, const f32 angle,
+                                              f32 &shortestDistanceToPath, f32 &radDiff,
+                                              f32 &distToEnd) const;
+
+      SegmentRangeStatus GetDistToArcSegment(const f32 x, const f32 y, const f32 angle,
+                                             f32 &shortestDistanceToPath, f32 &radDiff,
+                                             f32 &distToEnd) const;
+
+      PathSegmentType type_;
+      f32 length_ = 0.f;
+
+      // Line: start point, unit direction and its angle
+      // Arc: center point, radius, and start/end angles of the line from center to path
+      f32 x_ = 0.f;
+      f32 y_ = 0.f;
+      f32 dirX_ = 0.f;
+      f32 dirY_ = 0.f;
+      f32 angle_ = 0.f;
+      f32 radius_ = 0.f;
+      f32 startRad_ = 0.f;
+      f32 endRad_ = 0.f;
+      f32 sweepRad_ = 0.f;
+      bool movingCCW_ = true;
+
+      // Arc: thresholds on the angle travelled from startRad_ beyond which the test point is out of range,
+      // allowing for wraparound at +/-PI
+      f32 nearEndWrapRad_ = 0.f;
+      f32 nearStartWrapRad_ = 0.f;
+
+      // Any other segment types are handled by the segment itself
+      PathSegment segment_;
+    };
+
+  } // namespace Planning
+} // namespace Anki
+
+#endif // PATH_SEGMENT_LOOKUP_H_
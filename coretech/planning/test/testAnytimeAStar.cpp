@@ -0,0 +1,153 @@
+#include "util/helpers/includeGTest.h" // Used in place of gTest/gTest.h directly to suppress warnings in the header
+
+#include "coretech/planning/engine/anytimeAStar.h"
+
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+using namespace std;
+using namespace Anki;
+
+namespace {
+
+// 4-connected grid, with states encoded as y * kWidth + x
+const int kWidth  = 40;
+const int kHeight = 40;
+
+class GridConfig : public IAStarConfig<int, GridConfig> {
+public:
+  float Heuristic(const int& s) const { return abs(s % kWidth - goal % kWidth) + abs(s / kWidth - goal / kWidth); }
+  bool  IsGoal(const int& s)    const { return s == goal; }
+  bool  StopPlanning()                { return ++numExpansions > maxExpansions; }
+
+  vector<Successor> GetSuccessors(const int& s) const {
+    vector<Successor> out;
+    const int x = s % kWidth;
+    const int y = s / kWidth;
+    const int dx[] = {1, -1, 0, 0};
+    const int dy[] = {0, 0, 1, -1};
+    for (int i = 0; i < 4; ++i) {
+      const int nx = x + dx[i];
+      const int ny = y + dy[i];
+      const int n = ny * kWidth + nx;
+      if ( (nx >= 0) && (nx < kWidth) && (ny >= 0) && (ny < kHeight) && (blocked.count(n) == 0) ) {
+        out.push_back({n, 1.f});
+      }
+    }
+    return out;
+  }
+
+  int      goal = 0;
+  set<int> blocked;
+  size_t   numExpansions = 0;
+  size_t   maxExpansions = 1000000;
+};
+
+int Cell(int x, int y) { return y * kWidth + x; }
+
+void RunToOptimal(AnytimeAStar<int, GridConfig>& search)
+{
+  while ( !search.IsOptimal() && search.ImprovePath() && search.HasPlan() ) {}
+}
+
+void ExpectValidPlan(const vector<int>& plan, int start, int goal, const GridConfig& config)
+{
+  ASSERT_FALSE(plan.empty());
+  EXPECT_EQ(start, plan.front());
+  EXPECT_EQ(goal, plan.back());
+  for (size_t i = 1; i < plan.size(); ++i) {
+    EXPECT_EQ(1, abs(plan[i] % kWidth - plan[i-1] % kWidth) + abs(plan[i] / kWidth - plan[i-1] / kWidth));
+    EXPECT_EQ(0u, config.blocked.count(plan[i]));
+  }
+}
+
+}
+
+GTEST_TEST(TestAnytimeAStar, ImprovesToOptimal)
+{
+  // a wall with a gap at the far end, so the greedy first path is not the shortest one
+  GridConfig config;
+  for (int y = 0; y < kHeight - 2; ++y) {
+    config.blocked.insert(Cell(20, y));
+  }
+  config.goal = Cell(30, 5);
+  const int start = Cell(5, 5);
+
+  AnytimeAStar<int, GridConfig> search(config, 3.f, 1.f);
+  search.Reset({start});
+  ASSERT_TRUE(search.ImprovePath());
+  ASSERT_TRUE(search.HasPlan());
+  EXPECT_FLOAT_EQ(3.f, search.GetEpsilon());
+  const float firstCost = search.GetPlanCost();
+
+  RunToOptimal(search);
+  ASSERT_TRUE(search.IsOptimal());
+  EXPECT_FLOAT_EQ(1.f, search.GetEpsilon());
+  EXPECT_LE(search.GetPlanCost(), firstCost);
+
+  // around the bottom of the wall: up to y=38, across, and back down
+  const float shortest = (38 - 5) + (30 - 5) + (38 - 5);
+  EXPECT_FLOAT_EQ(shortest, search.GetPlanCost());
+
+  const vector<int> plan = search.GetPlan();
+  ExpectValidPlan(plan, start, config.goal, config);
+  EXPECT_EQ((size_t)shortest + 1, plan.size());
+}
+
+GTEST_TEST(TestAnytimeAStar, ResumesAfterStop)
+{
+  GridConfig config;
+  config.goal = Cell(35, 35);
+  config.maxExpansions = 10;
+
+  AnytimeAStar<int, GridConfig> search(config, 1.f, 1.f);
+  search.Reset({Cell(2, 2)});
+  EXPECT_FALSE(search.ImprovePath());
+  EXPECT_FALSE(search.HasPlan());
+
+  config.maxExpansions = 1000000;
+  ASSERT_TRUE(search.ImprovePath());
+  ASSERT_TRUE(search.IsOptimal());
+  EXPECT_FLOAT_EQ(66.f, search.GetPlanCost());
+}
+
+GTEST_TEST(TestAnytimeAStar, GoalChangeAndRepair)
+{
+  GridConfig config;
+  config.goal = Cell(30, 10);
+  const int start = Cell(10, 10);
+
+  AnytimeAStar<int, GridConfig> search(config, 2.f, .5f);
+  search.Reset({start});
+  RunToOptimal(search);
+  ASSERT_TRUE(search.IsOptimal());
+  EXPECT_FLOAT_EQ(20.f, search.GetPlanCost());
+
+  // move the goal, keeping the tree
+  config.goal = Cell(30, 12);
+  search.OnGoalChanged();
+  RunToOptimal(search);
+  ASSERT_TRUE(search.IsOptimal());
+  EXPECT_FLOAT_EQ(22.f, search.GetPlanCost());
+
+  // block the straight line between them, and repair everything around the new obstacle
+  for (int y = 5; y <= 15; ++y) {
+    config.blocked.insert(Cell(20, y));
+  }
+  search.Repair([](const int& s) { return abs(s % kWidth - 20) <= 1 && (s / kWidth >= 4) && (s / kWidth <= 16); });
+  EXPECT_FLOAT_EQ(2.f, search.GetEpsilon());
+  RunToOptimal(search);
+  ASSERT_TRUE(search.IsOptimal());
+
+  // around the end of the wall at y=16 or y=4
+  EXPECT_FLOAT_EQ(20.f + (16 - 10) + (16 - 12), search.GetPlanCost());
+  ExpectValidPlan(search.GetPlan(), start, config.goal, config);
+
+  // repairing the start itself seeds it again
+  search.Repair([start](const int& s) { return s == start; });
+  RunToOptimal(search);
+  ASSERT_TRUE(search.IsOptimal());
+  EXPECT_FLOAT_EQ(30.f, search.GetPlanCost());
+  ExpectValidPlan(search.GetPlan(), start, config.goal, config);
+}
@@ -361,3 +361,67 @@ GTEST_TEST(TestEnvironment, ReverseSuccessorsMatch_WithObstacle)
   EXPECT_GT(numActions, 2);
 }
 
+
+GTEST_TEST(TestEnvironment, ActionCostCacheSurvivesUnchangedObstacles)
+{
+  xythetaEnvironment env;
+
+  EXPECT_TRUE(env.ReadMotionPrimitives((std::string(QUOTE(TEST_DATA_PATH)) + std::string(TEST_PRIM_FILE)).c_str()));
+
+  Anki::RotatedRectangle nearObstacle(-20.0, 100.0, 20.0, 100.0, 20.0);
+  Anki::RotatedRectangle farObstacle(500.0, 500.0, 540.0, 500.0, 20.0);
+
+  env.AddObstacleAllThetas(nearObstacle, 1.0f);
+  env.PrepareForPlanning();
+
+  GraphState curr(State_c(-14,107,15));
+
+  auto collectSuccessors = [&env](StateID sid) {
+    vector<SuccessorIterator::Successor> ret;
+    SuccessorIterator it = env.GetSuccessors(sid, 5.0, false);
+    it.Next(env);
+    while( ! it.Done(env) ) {
+      ret.push_back(it.Front());
+      it.Next(env);
+    }
+    return ret;
+  };
+
+  const auto original = collectSuccessors(curr.GetStateID());
+  ASSERT_GT(original.size(), 2u);
+  const size_t numCached = env.actionCostCache_.size();
+  EXPECT_GT(numCached, 0u);
+  const u32 version = env.GetObstacleVersion();
+
+  // re-adding the same obstacles (as a replan would) keeps every cached action
+  env.ClearObstacles();
+  env.AddObstacleAllThetas(nearObstacle, 1.0f);
+  env.PrepareForPlanning();
+  EXPECT_EQ(version, env.GetObstacleVersion());
+  EXPECT_EQ(numCached, env.actionCostCache_.size());
+
+  // an obstacle far away bumps the version, but doesn't touch actions near the first one
+  env.AddObstacleAllThetas(farObstacle, 1.0f);
+  env.PrepareForPlanning();
+  EXPECT_NE(version, env.GetObstacleVersion());
+  EXPECT_EQ(numCached, env.actionCostCache_.size());
+
+  const auto cached = collectSuccessors(curr.GetStateID());
+  ASSERT_EQ(original.size(), cached.size());
+  for( size_t i = 0; i < original.size(); ++i ) {
+    EXPECT_EQ(original[i].stateID, cached[i].stateID);
+    EXPECT_EQ(original[i].actionID, cached[i].actionID);
+    EXPECT_FLOAT_EQ(original[i].g, cached[i].g);
+    EXPECT_FLOAT_EQ(original[i].penalty, cached[i].penalty);
+  }
+
+  // making the near obstacle fatal must invalidate its cached actions, so some successors go away
+  env.ClearObstacles();
+  env.AddObstacleAllThetas(nearObstacle);
+  env.AddObstacleAllThetas(farObstacle, 1.0f);
+  env.PrepareForPlanning();
+  EXPECT_LT(env.actionCostCache_.size(), numCached);
+
+  const auto fatal = collectSuccessors(curr.GetStateID());
+  EXPECT_LT(fatal.size(), original.size());
+}
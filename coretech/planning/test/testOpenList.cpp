@@ -0,0 +1,112 @@
+#include "util/helpers/includeGTest.h" // Used in place of gTest/gTest.h directly to suppress warnings in the header
+
+#include "coretech/planning/engine/openList.h"
+#include "coretech/planning/engine/stateTable.h"
+
+#include <vector>
+
+using namespace std;
+using namespace Anki::Planning;
+
+GTEST_TEST(TestOpenList, PopsInOrderWithStableTies)
+{
+  OpenList open;
+  open.insert(10, 3.0f);
+  open.insert(11, 1.0f);
+  open.insert(12, 2.0f);
+  open.insert(13, 1.0f); // same f as 11, but inserted later
+  open.insert(14, 5.0f);
+  ASSERT_EQ(5u, open.size());
+
+  vector<u32> popped;
+  while( !open.empty() ) {
+    popped.push_back(open.pop());
+  }
+  EXPECT_EQ((vector<u32>{11, 13, 12, 10, 14}), popped);
+}
+
+GTEST_TEST(TestOpenList, DecreaseAndRemove)
+{
+  OpenList open;
+  vector<OpenList::iterator> its;
+  for( u32 i = 0; i < 50; ++i ) {
+    its.push_back(open.insert(i, 100.0f + i));
+  }
+
+  // move a few entries to the front, and drop some others
+  open.decrease(its[40], 1.0f);
+  open.decrease(its[20], 1.0f); // ties with 40, but was decreased later
+  open.decrease(its[30], 0.5f);
+  open.remove(its[0]);
+  open.remove(its[49]);
+  ASSERT_EQ(48u, open.size());
+
+  EXPECT_FLOAT_EQ(0.5f, open.topF());
+  EXPECT_EQ(30u, (u32)open.pop());
+  EXPECT_EQ(40u, (u32)open.pop());
+  EXPECT_EQ(20u, (u32)open.pop());
+  EXPECT_FALSE(open.contains(0));
+  EXPECT_FLOAT_EQ(101.0f, open.fVal(1));
+
+  // everything else still comes out sorted
+  float lastF = 0.0f;
+  while( !open.empty() ) {
+    const float f = open.topF();
+    EXPECT_LE(lastF, f);
+    lastF = f;
+    const u32 id = open.pop();
+    EXPECT_NE(0u, id);
+    EXPECT_NE(49u, id);
+  }
+}
+
+GTEST_TEST(TestStateTable, FindAcrossGrowthAndClear)
+{
+  StateTable table;
+
+  // enough entries to grow the slots and span several chunks
+  const u32 kNumStates = 20000;
+  StateID first;
+  first.s.x = -100;
+  first.s.y = -50;
+  first.s.theta = 0;
+  const StateEntry* firstEntry = nullptr;
+  for( u32 i = 0; i < kNumStates; ++i ) {
+    StateID sid;
+    sid.s.x = (int)(i % 200) - 100;
+    sid.s.y = (int)(i / 200) - 50;
+    sid.s.theta = i % 16;
+    table.emplace(sid, OpenList::nullIterator(), sid, 0, 0.0f, (float)i);
+    if( 0 == i ) {
+      firstEntry = table.find(first);
+    }
+  }
+  ASSERT_EQ(kNumStates, table.size());
+
+  // references stay valid as the table grows
+  ASSERT_TRUE(firstEntry != table.end());
+  EXPECT_EQ(firstEntry, table.find(first));
+  EXPECT_FLOAT_EQ(0.0f, firstEntry->g_);
+
+  for( u32 i = 0; i < kNumStates; i += 997 ) {
+    StateID sid;
+    sid.s.x = (int)(i % 200) - 100;
+    sid.s.y = (int)(i / 200) - 50;
+    sid.s.theta = i % 16;
+    const StateEntry* entry = table.find(sid);
+    ASSERT_TRUE(entry != table.end());
+    EXPECT_FLOAT_EQ((float)i, entry->g_);
+  }
+
+  StateID missing;
+  missing.s.x = 1000;
+  EXPECT_TRUE(table.find(missing) == table.end());
+
+  table.Clear();
+  EXPECT_EQ(0u, table.size());
+  EXPECT_TRUE(table.find(first) == table.end());
+
+  table.emplace(first, OpenList::nullIterator(), first, 0, 0.0f, 7.0f);
+  ASSERT_TRUE(table.find(first) != table.end());
+  EXPECT_FLOAT_EQ(7.0f, table[first].g_);
+}
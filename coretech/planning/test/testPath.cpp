@@ -3,6 +3,8 @@
 #include "util/math/math.h"
 
 #include "coretech/planning/shared/path.h"
+#include "coretech/planning/shared/pathSegmentLookup.h"
+#include "coretech/common/shared/math/radians.h"
 
 
 using namespace std;
@@ -140,3 +142,75 @@ GTEST_TEST(TestPath, GetDistToArcSegment)
 }
 
 
+
+// Checks that PathSegmentLookup agrees with PathSegment::GetDistToSegment() on a grid of test points
+// around the given segment
+static void CompareLookupToSegment(const PathSegment& segment)
+{
+  const PathSegmentLookup lookup(segment);
+
+  const float kShortestDistTol_mm = 0.05f;
+  const float kDistToEndTol_mm = 0.05f;
+  // PathSegment gets the angle of lines from ATAN2_FAST
+  const float kAngleDiffTol_rad = DEG_TO_RAD(0.5f);
+  // Points whose closest point on the segment is this close to either end may be put on either side of it
+  const float kEndMargin_mm = 0.5f;
+
+  const float kGridStep_mm = 7.3f;
+  const float angle = 0.3f;
+  for (float x = -250.f; x <= 250.f; x += kGridStep_mm) {
+    for (float y = -250.f; y <= 250.f; y += kGridStep_mm) {
+      float expectedDist_mm, expectedRadDiff, expectedDistToEnd_mm;
+      const SegmentRangeStatus expectedStatus = segment.GetDistToSegment(x, y, angle, expectedDist_mm, expectedRadDiff, &expectedDistToEnd_mm);
+
+      float dist_mm, radDiff, distToEnd_mm;
+      const SegmentRangeStatus status = lookup.GetDistToSegment(x, y, angle, dist_mm, radDiff, &distToEnd_mm);
+
+      if (NEAR(expectedDistToEnd_mm, 0.f, kEndMargin_mm) ||
+          NEAR(std::abs(expectedDistToEnd_mm), segment.GetLength(), kEndMargin_mm)) {
+        continue;
+      }
+
+      EXPECT_EQ(expectedStatus, status) << "at (" << x << ", " << y << ")";
+      EXPECT_NEAR(expectedDist_mm, dist_mm, kShortestDistTol_mm) << "at (" << x << ", " << y << ")";
+      EXPECT_NEAR(0.f, (Anki::Radians(expectedRadDiff) - radDiff).ToFloat(), kAngleDiffTol_rad) << "at (" << x << ", " << y << ")";
+      EXPECT_NEAR(expectedDistToEnd_mm, distToEnd_mm, kDistToEndTol_mm) << "at (" << x << ", " << y << ")";
+    }
+  }
+}
+
+GTEST_TEST(TestPath, PathSegmentLookupLine)
+{
+  const float targetSpeed = 100;
+  const float accel = 100;
+  const float decel = 100;
+  const float length_mm = 150;
+
+  // Includes the horizontal and vertical special cases in both directions
+  for (float angle_deg = 0.f; angle_deg < 360.f; angle_deg += 22.5f) {
+    const float angle_rad = DEG_TO_RAD(angle_deg);
+    PathSegment segment;
+    segment.DefineLine(-20.f, 15.f,
+                       -20.f + length_mm * cosf(angle_rad), 15.f + length_mm * sinf(angle_rad),
+                       targetSpeed, accel, decel);
+    CompareLookupToSegment(segment);
+  }
+}
+
+GTEST_TEST(TestPath, PathSegmentLookupArc)
+{
+  const float targetSpeed = 100;
+  const float accel = 100;
+  const float decel = 100;
+  const float radius_mm = 120;
+
+  // Arcs on a path never cross 0 or PI (see Path::AppendArc()), but the segment itself doesn't care
+  for (float startAngle_deg = -180.f; startAngle_deg < 180.f; startAngle_deg += 45.f) {
+    for (const float sweep_deg : {-270.f, -90.f, -30.f, 30.f, 90.f, 270.f}) {
+      PathSegment segment;
+      segment.DefineArc(10.f, -5.f, radius_mm, DEG_TO_RAD(startAngle_deg), DEG_TO_RAD(sweep_deg),
+                        targetSpeed, accel, decel);
+      CompareLookupToSegment(segment);
+    }
+  }
+}
@@ -47,6 +47,20 @@ Result BrightColorDetector::Init ()
 
 Result BrightColorDetector::Detect (const ImageRGB& inputImage,
                                     std::list<SalientPoint>& salientPoints)
+{
+  return DetectHelper(inputImage, nullptr, salientPoints);
+}
+
+Result BrightColorDetector::Detect (const ImageRGB& inputImage,
+                                    const ImageRGB& coarseImage,
+                                    std::list<SalientPoint>& salientPoints)
+{
+  return DetectHelper(inputImage, &coarseImage, salientPoints);
+}
+
+Result BrightColorDetector::DetectHelper (const ImageRGB& inputImage,
+                                          const ImageRGB* coarseImage,
+                                          std::list<SalientPoint>& salientPoints)
 {
   const u32 timestamp = inputImage.GetTimestamp();
   const Vision::SalientPointType type = Vision::SalientPointType::BrightColors;
@@ -68,10 +82,29 @@ Result BrightColorDetector::Detect (const ImageRGB& inputImage,
   // TODO: Turn this into a parameter
   const float kScoreThreshold = 59.f;
 
+  // Downsampling averages away some of a region's color variation, lowering its score, so regions are rescored
+  // at full resolution if they come within this fraction of the threshold at coarse resolution
+  // TODO: Turn this into a parameter
+  const float kCoarseScoreFraction = 0.75f;
+  const s32 coarseStepRow = (coarseImage != nullptr ? coarseImage->GetNumRows()/numStepsRow : 0);
+  const s32 coarseStepCol = (coarseImage != nullptr ? coarseImage->GetNumCols()/numStepsCol : 0);
+  const bool useCoarse = (coarseStepRow > 0) && (coarseStepCol > 0);
+
   // TODO: Add ignore regions argument
 
   for (s32 row = 0; row < rows; row += stepRow){
     for (s32 col = 0; col < cols; col += stepCol) {
+      // Regions left over when the image doesn't divide evenly into steps have no coarse counterpart
+      const s32 stepIndexRow = row/stepRow;
+      const s32 stepIndexCol = col/stepCol;
+      if (useCoarse && (stepIndexRow < numStepsRow) && (stepIndexCol < numStepsCol)) {
+        Rectangle<s32> coarseRoi(stepIndexCol*coarseStepCol, stepIndexRow*coarseStepRow, coarseStepCol, coarseStepRow);
+        const float coarseScore = GetScore(coarseImage->GetROI(coarseRoi));
+        if (coarseScore < kCoarseScoreFraction*kScoreThreshold) {
+          continue;
+        }
+      }
+
       Rectangle<s32> roi(col,row,stepCol,stepRow);
 
       float score = GetScore(inputImage.GetROI(roi));
@@ -32,7 +32,20 @@ public:
   Result Detect(const ImageRGB& inputImage,
                 std::list<SalientPoint>& salientPoints);
 
+  // Coarse-to-fine version of the above: each region is first scored on coarseImage (a smaller version of
+  // inputImage, e.g. from the ImageCache) and only those scoring close enough to the threshold there are
+  // rescored at inputImage's resolution. Reports the same salient points as above for all but marginal regions.
+  Result Detect(const ImageRGB& inputImage,
+                const ImageRGB& coarseImage,
+                std::list<SalientPoint>& salientPoints);
+
 private:
+
+  // coarseImage may be null, to score every region at inputImage's resolution
+  Result DetectHelper(const ImageRGB& inputImage,
+                      const ImageRGB* coarseImage,
+                      std::list<SalientPoint>& salientPoints);
+
   /**
    * @brief Compute colorfulness based on Hasler and Susstrunk, "Measuring colourfulness in natural images"
    * @details Compute the colorfulness core. From "Measuring colourfulness in natural images", the output score
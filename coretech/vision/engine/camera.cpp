@@ -20,6 +20,7 @@
 #include "coretech/vision/engine/camera.h"
 #include "coretech/vision/engine/observableObject.h"
 #include "coretech/vision/engine/perspectivePoseEstimation.h"
+#include "coretech/vision/engine/undistorter.h"
 
 
 // Set to 1 to use OpenCV's iterative pose estimation for quads.
@@ -49,6 +50,7 @@ namespace Anki {
     : _camID(other._camID)
     , _calibration(other._calibration)
     , _pose(other._pose)
+    , _pointUndistorter(other._pointUndistorter)
     , _occluderList(other._occluderList)
     {
       
@@ -82,6 +84,19 @@ namespace Anki {
       }
       
       _calibration = calib;
+      
+      _pointUndistorter.reset();
+      const auto& distCoeffs = _calibration->GetDistortionCoeffs();
+      const bool hasDistortion = std::any_of(distCoeffs.begin(), distCoeffs.end(), [](const f32 c) { return c != 0.f; });
+      if(hasDistortion)
+      {
+        auto undistorter = std::make_shared<Undistorter>(_calibration);
+        if(RESULT_OK == undistorter->CachePointLUT(_calibration->GetNrows(), _calibration->GetNcols()))
+        {
+          _pointUndistorter = std::move(undistorter);
+        }
+      }
+      
       return true;
     }
     
@@ -95,10 +110,11 @@ namespace Anki {
       
       Matrix_3x3f calibMatrix(_calibration->GetCalibrationMatrix());
       
-      const CameraCalibration::DistortionCoeffs& distCoeffs = _calibration->GetDistortionCoeffs();
-      cv::Mat_<f32> distortionCoeffs(1, (s32)distCoeffs.size(), const_cast<f32*>(distCoeffs.data()));
+      std::vector<cv::Point2f> imagePoints(cvImagePoints);
+      cv::Mat_<f32> distortionCoeffs;
+      PrepareImagePointsForPnP(imagePoints, distortionCoeffs);
       
-      cv::solvePnP(cvObjPoints, cvImagePoints,
+      cv::solvePnP(cvObjPoints, imagePoints,
                    calibMatrix.get_CvMatx_(), distortionCoeffs,
                    cvRvec, cvTranslation,
                    false, cv::SOLVEPNP_ITERATIVE);
@@ -113,6 +129,34 @@ namespace Anki {
       
     } // ComputeObjectPoseHelper()
     
+    void Camera::PrepareImagePointsForPnP(std::vector<cv::Point2f>& cvImagePoints,
+                                          cv::Mat_<f32>& distortionCoeffs) const
+    {
+      if(_pointUndistorter)
+      {
+        std::vector<Point2f> distortedPoints, undistortedPoints;
+        distortedPoints.reserve(cvImagePoints.size());
+        for(const auto& cvPoint : cvImagePoints) {
+          distortedPoints.emplace_back(cvPoint.x, cvPoint.y);
+        }
+        
+        const Result result = _pointUndistorter->UndistortPoints(_calibration->GetNrows(), _calibration->GetNcols(),
+                                                                 distortedPoints, undistortedPoints);
+        if(RESULT_OK == result)
+        {
+          for(size_t i=0; i<cvImagePoints.size(); ++i) {
+            cvImagePoints[i] = undistortedPoints[i].get_CvPoint_();
+          }
+          distortionCoeffs.release();
+          return;
+        }
+      }
+      
+      // Let solvePnP undistort the points itself
+      const CameraCalibration::DistortionCoeffs& distCoeffs = _calibration->GetDistortionCoeffs();
+      distortionCoeffs = cv::Mat_<f32>(1, (s32)distCoeffs.size(), const_cast<f32*>(distCoeffs.data()));
+    }
+    
 #endif
     
     
@@ -288,6 +332,67 @@ namespace Anki {
     } // ComputeObjectPose(from quads)
  
     
+    Result Camera::ComputeObjectPoses(const std::vector<QuadCorrespondence>& quads,
+                                      std::vector<Pose3d>&                   poses) const
+    {
+      if(this->IsCalibrated() == false) {
+        CORETECH_THROW("Camera::ComputeObjectPoses() called before calibration set.");
+      }
+      
+      poses.clear();
+      poses.reserve(quads.size());
+      
+#if USE_ITERATIVE_QUAD_POSE_ESTIMATION
+      
+      Matrix_3x3f calibMatrix(_calibration->GetCalibrationMatrix());
+      cv::Mat_<f32> distortionCoeffs;
+      
+      std::vector<cv::Point2f> cvImagePoints(4);
+      std::vector<cv::Point3f> cvObjPoints(4);
+      const std::array<Quad::CornerName,4> cornerOrder{{
+        Quad::TopLeft, Quad::BottomLeft, Quad::TopRight, Quad::BottomRight
+      }};
+      
+      for(const auto& quad : quads)
+      {
+        const Quad2f& imgQuad   = *quad.first;
+        const Quad3f& worldQuad = *quad.second;
+        for(s32 i=0; i<4; ++i) {
+          cvImagePoints[i] = imgQuad[cornerOrder[i]].get_CvPoint_();
+          cvObjPoints[i]   = worldQuad[cornerOrder[i]].get_CvPoint3_();
+        }
+        PrepareImagePointsForPnP(cvImagePoints, distortionCoeffs);
+        
+        cv::Vec3d cvRvec, cvTranslation;
+        cv::solvePnP(cvObjPoints, cvImagePoints,
+                     calibMatrix.get_CvMatx_(), distortionCoeffs,
+                     cvRvec, cvTranslation,
+                     false, cv::SOLVEPNP_ITERATIVE);
+        
+        RotationVector3d rvec(Vec3f(cvRvec[0], cvRvec[1], cvRvec[2]));
+        Vec3f translation(cvTranslation[0], cvTranslation[1], cvTranslation[2]);
+        poses.emplace_back(rvec, translation, _pose);
+      }
+      
+#else
+      
+      for(const auto& quad : quads)
+      {
+        Pose3d pose;
+        const Result result = ComputeObjectPose(*quad.first, *quad.second, pose);
+        if(RESULT_OK != result) {
+          return result;
+        }
+        poses.push_back(std::move(pose));
+      }
+      
+#endif // #if USE_ITERATIVE_QUAD_POSE_ESTIMATION
+      
+      return RESULT_OK;
+      
+    } // ComputeObjectPoses()
+    
+    
     // Explicit instantiation for single and double precision
     template Result Camera::ComputeObjectPose<float>(const Quad2f& imgQuad,
                                                      const Quad3f& worldQuad,
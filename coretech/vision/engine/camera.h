@@ -30,6 +30,7 @@ namespace Anki {
     class ObservableObject;
     
     class KnownMarker;
+    class Undistorter;
     
     // For now, this is always assumed to be a calibrated camera.  If we want
     // a more generic camera that does operations that do not require calibration
@@ -83,6 +84,13 @@ namespace Anki {
                                const Quad3f &objPoints,
                                Pose3d       &objPose) const;
       
+      // Same as above for a batch of quads (e.g. all the markers seen in one image), setting up the calibration
+      // once for the whole batch. poses[i] is computed from quads[i] and is w.r.t. the camera's pose. Returns the
+      // first failure, in which case poses is incomplete.
+      using QuadCorrespondence = std::pair<const Quad2f*, const Quad3f*>;
+      Result ComputeObjectPoses(const std::vector<QuadCorrespondence>& quads,
+                                std::vector<Pose3d>&                   poses) const;
+      
       
       // Compute the projected image locations of 3D point(s). The points
       //  should already be in the camera's coordinate system (i.e. relative to
@@ -139,6 +147,10 @@ namespace Anki {
       // is occluded by a registered occluder.
       bool IsOccluded(const Point2f& projectedPoint, const f32 atDistance) const;
       
+      // Returns true when any corner of the quad (computed by one of the projection
+      // functions above), seen at the specified distance, is occluded.
+      bool IsAnyCornerOccluded(const Quad2f& projectedQuad, const f32 atDistance) const;
+      
       // Returns true when there is a registered "occluder" behind the specified
       // point or quad at the given distance.
       bool IsAnythingBehind(const Point2f& projectedPoint, const f32 atDistance) const;
@@ -156,6 +168,10 @@ namespace Anki {
       std::shared_ptr<CameraCalibration> _calibration;
       Pose3d                             _pose;
       
+      // Point lookup table for the calibration's resolution, used to undistort image points before pose
+      // estimation instead of leaving that to solvePnP. Null if the calibration has no distortion.
+      std::shared_ptr<const Undistorter> _pointUndistorter;
+      
       OccluderList                       _occluderList;
       
       // TODO: Include const reference or pointer to a parent Robot object?
@@ -168,6 +184,11 @@ namespace Anki {
 #if ANKICORETECH_USE_OPENCV
       Pose3d ComputeObjectPoseHelper(const std::vector<cv::Point2f>& cvImagePoints,
                                      const std::vector<cv::Point3f>& cvObjPoints) const;
+      
+      // Undistorts cvImagePoints in place with _pointUndistorter and leaves distortionCoeffs empty, or if
+      // there's no undistorter, leaves the points alone and wraps the calibration's coefficients
+      void PrepareImagePointsForPnP(std::vector<cv::Point2f>& cvImagePoints,
+                                    cv::Mat_<f32>& distortionCoeffs) const;
 #endif
       
     }; // class Camera
@@ -202,6 +223,10 @@ namespace Anki {
       return _occluderList.IsOccluded(projectedPoint, atDistance);
     }
     
+    inline bool Camera::IsAnyCornerOccluded(const Quad2f& projectedQuad, const f32 atDistance) const {
+      return _occluderList.IsAnyCornerOccluded(projectedQuad, atDistance);
+    }
+    
     inline bool Camera::IsAnythingBehind(const Point2f& projectedPoint, const f32 atDistance) const {
       return _occluderList.IsAnythingBehind(projectedPoint, atDistance);
     }
@@ -247,7 +247,8 @@ Result CameraParamsController::UpdateCurrentCameraParams(const CameraParams& new
 Result CameraParamsController::ComputeNextCameraParams(const Image& img,
                                                        const AutoExpMode aeMode,
                                                        const bool useExposureCycling,
-                                                       CameraParams& nextParams)
+                                                       CameraParams& nextParams,
+                                                       const ImageBrightnessHistogram* imgHist)
 {
   // Special case: nothing to do
   if(AutoExpMode::Off == aeMode)
@@ -260,7 +261,7 @@ Result CameraParamsController::ComputeNextCameraParams(const Image& img,
   f32 adjR = 1.f;
   f32 adjB = 1.f;
   
-  const Result result = ComputeExposureAdjustment(img, useExposureCycling, exposureAdjFrac);
+  const Result result = ComputeExposureAdjustment(img, useExposureCycling, imgHist, exposureAdjFrac);
   if(RESULT_OK != result)
   {
     PRINT_NAMED_ERROR("CameraParamsController.ComputeNextCameraParams.Grayscale.ComputeExpFailed", "");
@@ -567,6 +568,7 @@ Result CameraParamsController::ComputeAdjustmentFraction(const bool useCycling,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result CameraParamsController::ComputeExposureAdjustment(const Vision::Image& image,
                                                          const bool useCycling,
+                                                         const ImageBrightnessHistogram* imageHist,
                                                          f32& adjustmentFraction)
 {
   // Initialize in case of early return
@@ -590,11 +592,17 @@ Result CameraParamsController::ComputeExposureAdjustment(const Vision::Image& im
   const bool haveWeights = GetMeteringWeightMask(image.GetNumRows(), image.GetNumCols(), weightMask);
   if(haveWeights)
   {
-    result = _hist.FillFromImage(image, _subSample, linearizeFcn);
+    result = _hist.FillFromImage(image, weightMask, _subSample, linearizeFcn);
+  }
+  else if(nullptr != imageHist)
+  {
+    // Unweighted, so the image's own histogram only needs the linearization applied to its bins
+    _hist.Accumulate(*imageHist, linearizeFcn);
+    result = RESULT_OK;
   }
   else
   {
-    result = _hist.FillFromImage(image, weightMask, _subSample, linearizeFcn);
+    result = _hist.FillFromImage(image, _subSample, linearizeFcn);
   }
   
   if(RESULT_OK != result)
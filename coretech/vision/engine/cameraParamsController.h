@@ -72,10 +72,13 @@ public:
                                  CameraParams& nextParams);
   
   // Just computes exposure, given a grayscale image
+  // If provided, imgHist must be the histogram of img subsampled by GetSubSample(). It is then used instead of
+  // another pass over img whenever there are no metering regions to weight.
   Result ComputeNextCameraParams(const Image& img,
                                  const AutoExpMode autoExpMode,
                                  const bool useExposureCycling,
-                                 CameraParams& nextParams);
+                                 CameraParams& nextParams,
+                                 const ImageBrightnessHistogram* imgHist = nullptr);
   
   // Actual update the "current" camera parameters, presumably after using the "next" params
   // above to update the real camera's settings
@@ -88,6 +91,9 @@ public:
   // Get histogram computed in last ComputeExposureAdjustment() call
   const ImageBrightnessHistogram& GetHistogram() const { return _hist; }
   
+  // Subsampling of the image used when computing exposure
+  s32 GetSubSample() const { return _subSample; }
+  
   s32 GetMinCameraExposureTime_ms() const { return _minExposureTime_ms; }
   s32 GetMaxCameraExposureTime_ms() const { return _maxExposureTime_ms; }
   
@@ -146,6 +152,7 @@ private:
   // Compute multiplicative amount by which to adjust exposure (whether time or gain)
   Result ComputeExposureAdjustment(const Vision::Image& image,
                                    const bool useCycling,
+                                   const ImageBrightnessHistogram* imageHist,
                                    f32& adjustmentFraction);
   
   Result ComputeExposureAdjustment(const std::vector<Vision::Image>& imageROIs, f32& adjustmentFraction);
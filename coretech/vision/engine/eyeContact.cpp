@@ -32,130 +32,67 @@ namespace {
   CONSOLE_VAR(f32, kBlinkAmountThreshold,             "Vision.EyeContact",  .73f);
   CONSOLE_VAR(f32, kDistanceFromCameraThresholdSq_mm, "Vision.EyeContact",  700*700.f);
   CONSOLE_VAR(u32, kExpireThreshold,                  "Vision.EyeContact",  50);
+
+  // These default values are at the limits of the expected range
+  // of the inputs. Since we are looking for when the average
+  // is close to zero, the extremes of the range were chosen for
+  // initialization values.
+  const Point2f kDefaultGaze_deg(-30.f, -20.f);
 }
 
 EyeContact::EyeContact()
-  : _gazeAverage(Point2f(GazeData::kleftRightMin_deg, GazeData::kupDownMin_deg))
+  : _gazeHistory(kHistorySize, kDefaultGaze_deg, true)
+  , _gazeAverage(kDefaultGaze_deg)
 {
-  _gazeHistory.resize(kHistorySize);
 }
 
 void EyeContact::Update(const TrackedFace& face,
                         const TimeStamp_t timeStamp)
 {
-  _face = face;
   _lastUpdated = timeStamp;
 
-  if (_currentIndex > (kHistorySize - 1))
-  {
-    // Make sure we place a "real" value
-    // in every element of the history
-    // before returning a result
-    _initialized = true;
-    _currentIndex = 0;
-  }
-
   // First add our current point to the history, since these
   // angles are range limited without a wrap around we will
   // be able to treat them as Cartesian coordinates
-  _gazeHistory[_currentIndex].Update(
-    Point2f(
-      _face.GetGaze().leftRight_deg,
-      _face.GetGaze().upDown_deg
-    )
-  );
-
-  _gazeAverage = ComputeEntireGazeAverage();
-  _numberOfInliers = FindInliers(_gazeAverage);
-  _gazeAverage = RecomputeGazeAverage();
-  _isMakingEyeContact = DetermineMakingEyeContact();
-
-  _currentIndex += 1;
-}
+  _gazeHistory.Add(Point2f(face.GetGaze().leftRight_deg, face.GetGaze().upDown_deg));
 
-Point2f EyeContact::ComputeEntireGazeAverage()
-{
-  return ComputeGazeAverage(false);
-}
-
-Point2f EyeContact::ComputeGazeAverage(const bool filterOutliers)
-{
-  Point2f averageGaze = Point2f(0.f, 0.f);
-
-  // Find the average, we can treat these as Cartesian
-  // coordinates instead traditional angles because the
-  // range of value does not include a wrap around
-  u32 pointsInAverage = 0;
-  for (const auto& gaze: _gazeHistory) {
-    if (filterOutliers) {
-      if (gaze.inlier) {
-        pointsInAverage += 1;
-        averageGaze += gaze.point;
-      }
-    } else {
-      pointsInAverage += 1;
-      averageGaze += gaze.point;
-    }
-  }
-
-  if (pointsInAverage != 0) {
-    averageGaze *= 1.f/pointsInAverage;
-  } else {
-    averageGaze = Point2f(GazeData::kleftRightMin_deg, GazeData::kupDownMin_deg);
-  }
-  return averageGaze;
-}
-
-int EyeContact::FindInliers(const Point2f& gazeAverage)
-{
-  int numberOfInliers = 0;
-  for (auto& gaze: _gazeHistory) {
-    auto difference = gaze.point - gazeAverage;
-    auto distance = difference.LengthSq();
-    if (distance < kInlierDistanceSq) {
-      gaze.inlier = true;
-      numberOfInliers += 1;
-    } else {
-      gaze.inlier = false;
-    }
-  }
-  return numberOfInliers;
-}
-
-Point2f EyeContact::RecomputeGazeAverage()
-{
-  return ComputeGazeAverage(true);
+  _numberOfInliers = _gazeHistory.ComputeInlierAverage([](const Point2f& difference) {
+    return (difference.LengthSq() < kInlierDistanceSq);
+  }, _gazeAverage);
+  _isMakingEyeContact = DetermineMakingEyeContact(face);
 }
 
-bool EyeContact::DetermineMakingEyeContact()
+bool EyeContact::DetermineMakingEyeContact(const TrackedFace& face) const
 {
   bool eyeContact = false;
   if (_numberOfInliers > kMinNumberOfInliers) {
     // Taking the l_2 norm of the gaze average here works
-    // because the distance is from (0,0)
+    // because the distance is from (0,0). Make sure we
+    // have a "real" value in every element of the history
+    // before returning a result.
     float distance = _gazeAverage.LengthSq();
-    if ((distance < kEyeContactDistanceSq) && _initialized && SecondaryContraints()) {
+    if ((distance < kEyeContactDistanceSq) && _gazeHistory.IsFull() && SecondaryContraints(face)) {
         eyeContact = true;
     }
   }
   return eyeContact;
 }
 
-bool EyeContact::SecondaryContraints()
+bool EyeContact::SecondaryContraints(const TrackedFace& face)
 {
   // Verify that the head in the required cone. We don't need to worry
   // about wrap around here. The okao library ranges for these values
   // are from [-180, 179] degrees.
-  const bool headRotationInCone = ((std::abs(_face.GetHeadPitch().ToFloat()) < kPitchAngleThreshold_rad) &&
-                                   (std::abs(_face.GetHeadYaw().ToFloat()) < kYawAngleThreshold_rad));
+  const bool headRotationInCone = ((std::abs(face.GetHeadPitch().ToFloat()) < kPitchAngleThreshold_rad) &&
+                                   (std::abs(face.GetHeadYaw().ToFloat()) < kYawAngleThreshold_rad));
 
   // Verify that the face isn't blinking
   // TODO we might want to consider using an adaptive threshold here
   // depending on how much the blink amount varies per individual
-  const bool blinking = ((_face.GetBlinkAmount().blinkAmountLeft < kBlinkAmountThreshold) ||
-                         (_face.GetBlinkAmount().blinkAmountRight < kBlinkAmountThreshold));
+  const bool blinking = ((face.GetBlinkAmount().blinkAmountLeft < kBlinkAmountThreshold) ||
+                         (face.GetBlinkAmount().blinkAmountRight < kBlinkAmountThreshold));
 
-  const bool near = (_face.GetHeadPose().GetTranslation().LengthSq() < kDistanceFromCameraThresholdSq_mm);
+  const bool near = (face.GetHeadPose().GetTranslation().LengthSq() < kDistanceFromCameraThresholdSq_mm);
 
   return (headRotationInCone && blinking && near);
 }
@@ -14,32 +14,12 @@
 #ifndef __Anki_Vision_EyeContact_H__
 #define __Anki_Vision_EyeContact_H__
 
+#include "coretech/vision/engine/gazeHistory.h"
 #include "coretech/vision/engine/trackedFace.h"
 
 namespace Anki {
 namespace Vision {
 
-// These default values are at the limits of the expected range
-// of the inputs. Since we are looking for when the average
-// is close to zero, the extremes of the range were chosen for
-// initialization values.
-
-struct GazeData
-{
-  constexpr static const float kleftRightMin_deg = -30.f;
-  constexpr static const float kupDownMin_deg    = -20.f;
-  Point2f point;
-  bool inlier;
-  GazeData()
-    : point(Point2f(kleftRightMin_deg, kupDownMin_deg)),
-      inlier(false) {}
-  void Update(const Point2f& newPoint)
-  {
-    point = newPoint;
-    inlier = false;
-  }
-};
-
 /***************************************************
  *                 EyeContact                      *
  ***************************************************/
@@ -80,6 +60,10 @@ struct GazeData
 
   As far as usage, the value returned from GetGazeAverage is only valid
   if IsMakingEyeContact returns true.
+
+  Only the gaze angles are kept from each face: the secondary constraints
+  are checked on the spot, so the face (with its image and landmarks) is
+  never copied.
 */
 
 class EyeContact
@@ -93,30 +77,21 @@ public:
   bool IsMakingEyeContact() const {return _isMakingEyeContact;}
   Point2f GetGazeAverage() const {return _gazeAverage;}
   bool GetExpired(const TimeStamp_t currentTime) const;
-  std::vector<GazeData> const& GetGazeHistory() {return _gazeHistory;}
 
-private:
-  int FindInliers(const Point2f& gazeAverage);
-
-  bool DetermineMakingEyeContact();
-
-  Point2f ComputeEntireGazeAverage();
+  // Upper limit on the kHistorySize console var
+  static constexpr size_t kMaxHistorySize = 16;
 
-  Point2f ComputeGazeAverage(const bool filterOutliers);
-
-  Point2f RecomputeGazeAverage();
+private:
+  bool DetermineMakingEyeContact(const TrackedFace& face) const;
 
-  bool SecondaryContraints();
+  static bool SecondaryContraints(const TrackedFace& face);
 
-  TrackedFace _face;
-  TimeStamp_t _lastUpdated;
+  TimeStamp_t _lastUpdated = 0;
 
-  int _currentIndex = 0;
   int _numberOfInliers = 0;
   bool _isMakingEyeContact = false;
-  bool _initialized = false;
 
-  std::vector<GazeData> _gazeHistory;
+  GazeHistory<Point2f, kMaxHistorySize> _gazeHistory;
   Point2f _gazeAverage;
 };
 
@@ -21,6 +21,7 @@
 #include "util/logging/DAS.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/console/consoleInterface.h"
+#include "util/dispatchQueue/taskExecutor.h"
 #include "util/helpers/boundedWhile.h"
 #include "util/helpers/cleanupHelper.h"
 #include "util/threading/threadPriority.h"
@@ -29,6 +30,7 @@
 
 #include "OkaoCoAPI.h"
 
+#include <cstdio>
 #include <fstream>
 
 #define LOG_CHANNEL "FaceRecognizer"
@@ -99,6 +101,7 @@ namespace JsonKey
   const char* RunMode = "RunMode";
   const char* Synchronous = "synchronous";
   const char* Asynchronous = "asynchronous";
+  const char* NumWorkers = "NumWorkers";
 
   const char* PerformanceLoggingGroup = "PerformanceLogging";
   const char* TimeBetweenInfoPrints = "TimeBetweenProfilerInfoPrints_sec";
@@ -148,6 +151,8 @@ inline void EmplaceLoadedKnownFace(const EnrolledFaceEntry& entry,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 FaceRecognizer::FaceRecognizer(const Json::Value& config)
+: _enrollmentJobExecutor(new Util::TaskExecutor("FaceEnrollment"))
+, _albumWriter(new Util::TaskExecutor("FaceAlbumWriter"))
 {
   if(config.isMember(JsonKey::FaceRecognitionGroup))
   {
@@ -164,14 +169,22 @@ FaceRecognizer::FaceRecognizer(const Json::Value& config)
         DEV_ASSERT(false, "FaceRecognizer.Constructor.BadRunMode");
       }
     }
+    
+    if(JsonTools::GetValueOptional(recognitionConfig, JsonKey::NumWorkers, _numWorkers)) {
+      if(_numWorkers < 1 || _numWorkers > kMaxNumWorkers) {
+        LOG_WARNING("FaceRecognizer.Constructor.BadNumWorkers",
+                    "%d not in [1,%d], using %d", _numWorkers, kMaxNumWorkers, kDefaultNumWorkers);
+        _numWorkers = kDefaultNumWorkers;
+      }
+    }
   } else {
     LOG_WARNING("FaceRecognizer.Constructor.NoFaceRecParameters",
                 "Did not find '%s' group in config", JsonKey::FaceRecognitionGroup);
   }
 
   LOG_INFO("FaceRecognizer.Constructor.RunMode",
-           "Running in %s mode",
-           (_isRunningAsync ? JsonKey::Asynchronous : JsonKey::Synchronous));
+           "Running in %s mode with %d workers",
+           (_isRunningAsync ? JsonKey::Asynchronous : JsonKey::Synchronous), _numWorkers);
 
   // Set up profiler logging frequencies
   f32 timeBetweenProfilerInfoPrints_sec = 5.f;
@@ -249,6 +262,19 @@ Result FaceRecognizer::Init(HCOMMON okaoCommonHandle)
     return RESULT_FAIL_MEMORY;
   }
 
+  _workers.clear();
+  for(s32 i=0; i<_numWorkers; ++i)
+  {
+    std::unique_ptr<RecognitionWorker> worker(new RecognitionWorker());
+    worker->featureHandle = OKAO_FR_CreateFeatureHandle(_okaoCommonHandle);
+    if(NULL == worker->featureHandle) {
+      LOG_ERROR("FaceRecognizer.Init.FaceLibWorkerFeatureHandleAllocFail", "Worker:%d", i);
+      return RESULT_FAIL_MEMORY;
+    }
+    worker->detectionInfo.nID = -1;
+    _workers.push_back(std::move(worker));
+  }
+
   _detectionInfo.nID = -1;
 
   _isInitialized = true;
@@ -266,6 +292,20 @@ Result FaceRecognizer::Shutdown()
   // Wait for recognition thread to die before destructing since we gave it a
   // reference to *this
   StopThread();
+  
+  // Same for the enrollment job and the album writer, which also needs to finish any pending saves
+  WaitForEnrollmentJob();
+  FlushAlbumWrites();
+
+  for(auto & worker : _workers) {
+    if (NULL != worker->featureHandle) {
+      if (OKAO_NORMAL != OKAO_FR_DeleteFeatureHandle(worker->featureHandle)) {
+        LOG_ERROR("FaceRecognizer.Shutdown.FaceLibWorkerFeatureHandleDeleteFail", "");
+      }
+      worker->featureHandle = NULL;
+    }
+  }
+  _workers.clear();
 
   if (NULL != _okaoFaceAlbum) {
     if (OKAO_NORMAL != OKAO_FR_DeleteAlbumHandle(_okaoFaceAlbum)) {
@@ -304,7 +344,9 @@ void FaceRecognizer::StartThread()
 
     _isRunningAsync = true;
 
-    _featureExtractionThread = std::thread(&FaceRecognizer::Run, this);
+    for(auto & worker : _workers) {
+      worker->thread = std::thread(&FaceRecognizer::Run, this, worker.get());
+    }
   }
   else
   {
@@ -324,8 +366,15 @@ void FaceRecognizer::StopThread()
     }
     _newImageCondition.notify_all();
 
-    if(_featureExtractionThread.joinable()) {
-      _featureExtractionThread.join();
+    for(auto & worker : _workers) {
+      if(worker->thread.joinable()) {
+        worker->thread.join();
+      }
+      
+      // Faces not yet extracted would never finish now, so let the worker take new ones
+      if(ProcessingState::FeaturesReady != worker->state) {
+        worker->state = ProcessingState::Idle;
+      }
     }
   }
 }
@@ -333,6 +382,8 @@ void FaceRecognizer::StopThread()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FaceRecognizer::SetIsSynchronous(bool shouldRunSynchronous)
 {
+  WaitForEnrollmentJob();
+  
   if(shouldRunSynchronous && _isRunningAsync)
   {
     LOG_INFO("FaceRecognizer.SetSynchronousMode.SwitchToSynchronous", "");
@@ -569,6 +620,11 @@ Result FaceRecognizer::UpdateRecognitionData(const FaceID_t recognizedID,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FaceRecognizer::HasRecognitionData(TrackingID_t forTrackingID) const
 {
+  if(_isEnrollmentJobRunning)
+  {
+    return (_published.recognitionData.find(forTrackingID) != _published.recognitionData.end());
+  }
+  
   const bool haveEntry = (_trackingToFaceID.find(forTrackingID) != _trackingToFaceID.end());
   return haveEntry;
 }
@@ -576,6 +632,12 @@ bool FaceRecognizer::HasRecognitionData(TrackingID_t forTrackingID) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FaceRecognizer::HasName(TrackingID_t forTrackingID) const
 {
+  if(_isEnrollmentJobRunning)
+  {
+    auto publishedIter = _published.recognitionData.find(forTrackingID);
+    return ((publishedIter != _published.recognitionData.end()) && !publishedIter->second.IsForThisSessionOnly());
+  }
+  
   auto iter = _trackingToFaceID.find(forTrackingID);
   if(iter == _trackingToFaceID.end())
   {
@@ -606,78 +668,59 @@ bool FaceRecognizer::HasName(TrackingID_t forTrackingID) const
 EnrolledFaceEntry FaceRecognizer::GetRecognitionData(INT32 forTrackingID, s32& enrollmentCountReached,
                                                      DebugImageList<CompressedImage>& debugImages)
 {
+  EnrolledFaceEntry entryToReturn;
+  enrollmentCountReached = 0;
+  
+  if(_isEnrollmentJobRunning)
+  {
+    // The album and bookkeeping belong to the enrollment job until it's done
+    if(_shouldClearAllTrackingData)
+    {
+      _published.recognitionData.clear();
+      _published.bestGuessNames.clear();
+    }
+    
+    auto publishedIter = _published.recognitionData.find(forTrackingID);
+    if(publishedIter != _published.recognitionData.end())
+    {
+      entryToReturn = publishedIter->second;
+    }
+    return entryToReturn;
+  }
+  
+  debugImages.splice(debugImages.end(), _enrollmentJobDebugImages);
+  
   if(_shouldClearAllTrackingData)
   {
     ClearAllTrackingDataInternal();
     _shouldClearAllTrackingData = false;
   }
   
-  if(ProcessingState::FeaturesReady == _state)
+  // Finish recognition of every face whose features are ready. Each result
+  // updates the data for its own tracking ID. When running asynchronously,
+  // faces that may get enrolled are left for the enrollment job, which can
+  // only take one once everything else is finished here.
+  RecognitionWorker* enrollmentWorker = nullptr;
+  for(auto & worker : _workers)
   {
-    if(_detectionInfo.nID == UnknownFaceID)
-    {
-      // If the tracker ID is set to Unknown, it's because a ClearTrackingData call
-      // was received while the recognition thread was running on a detection.
-      // That detection ID is no longer valid, so drop the result on the floor.
-      // This should only be possible when running asynchronously.
-      DEV_ASSERT(_isRunningAsync, "FaceRecognizer.GetRecognitionData.InvalidTrackIDinSyncMode");
-      LOG_INFO("GetRecognitionData.DroppingFeaturesComputedWhileClearing", "");
-    }
-    else if(_isEnrollmentCancelled)
-    {
-      LOG_INFO("GetRecognitionData.DroppingFeaturesComputedWhileCancelled", "");
-      _isEnrollmentCancelled = false;
-    }
-    else
-    {
-      // Verbose, but useful for enrollment debugging
-      //  LOG_DEBUG("GetRecognitionData.EnrollmentStatus",
-      //            "ForTrackingID:%d EnrollmentCount=%d EnrollID=%d",
-      //            -_detectionInfo.nID, _enrollmentCount, _enrollmentID);
-
-      // Feature extraction thread is done: finish the rest of the recognition
-      // process so we can start accepting new requests to recognize
-      FaceID_t recognizedID = UnknownFaceID;
-      RecognitionScore score = 0;
-      Result result = RecognizeFace(recognizedID, score, debugImages);
+    _mutex.lock();
+    const bool featuresReady = (ProcessingState::FeaturesReady == worker->state);
+    _mutex.unlock();
 
-      if(RESULT_OK == result)
+    if(featuresReady)
+    {
+      if(_isRunningAsync && worker->isEnrollmentEnabled)
       {
-        result = UpdateRecognitionData(recognizedID, score);
-        if(RESULT_OK != result)
-        {
-          LOG_ERROR("FaceRecognizer.GetRecognitionData.UpdateRecognitionDataFailed", "");
+        if(nullptr == enrollmentWorker) {
+          enrollmentWorker = worker.get();
         }
       }
       else
       {
-        LOG_ERROR("FaceRecognizer.GetRecognitionData.RecognizeFaceFailed", "");
-      }
-
-      if(kDisplayDebugEnrollmentImages)
-      {
-        //DisplayEnrollmentImages(debugImages);
-      }
-
-      if(ANKI_DEVELOPER_CODE)
-      {
-        const Result sanityResult = SanityCheckBookkeeping(_okaoFaceAlbum,
-                                                           _enrollmentData,
-                                                           _albumEntryToFaceID);
-        DEV_ASSERT(sanityResult == RESULT_OK, "FaceRecognizer.GetRecognitionData.SanityCheckFailed");
+        FinishRecognition(*worker, debugImages);
       }
     }
-
-    // Whether or not we used the computed features, mark that we are ready to
-    // process more
-    _mutex.lock();
-    _state = ProcessingState::Idle;
-    _mutex.unlock();
-
-  } // if(ProcessingState::FeaturesReady == _state)
-
-  EnrolledFaceEntry entryToReturn;
-  enrollmentCountReached = 0;
+  }
 
   auto iter = _trackingToFaceID.find(forTrackingID);
   if(iter != _trackingToFaceID.end()) {
@@ -728,11 +771,135 @@ EnrolledFaceEntry FaceRecognizer::GetRecognitionData(INT32 forTrackingID, s32& e
 
     // no longer "new" or "updated"
     enrolledEntry.UpdatePreviousIDs();
+
+    // Since it has now been reported, this is what to return while an enrollment job runs
+    EnrolledFaceEntry& publishedEntry = _published.recognitionData[forTrackingID];
+    publishedEntry = entryToReturn;
+    publishedEntry.UpdatePreviousIDs();
+  }
+  else
+  {
+    _published.recognitionData.erase(forTrackingID);
+  }
+
+  if(nullptr != enrollmentWorker)
+  {
+    StartEnrollmentJob(*enrollmentWorker);
   }
 
   return entryToReturn;
 } // GetRecognitionData()
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FaceRecognizer::StartEnrollmentJob(RecognitionWorker& worker)
+{
+  DEV_ASSERT(!_isEnrollmentJobRunning, "FaceRecognizer.StartEnrollmentJob.AlreadyRunning");
+  
+  // Forget faces that aren't tracked anymore, then capture what the per-frame queries need for as long as the job
+  // runs: nothing on this thread may touch the album or bookkeeping after this until the job is done
+  for(auto publishedIter = _published.recognitionData.begin(); publishedIter != _published.recognitionData.end(); )
+  {
+    if(_trackingToFaceID.find(publishedIter->first) == _trackingToFaceID.end()) {
+      publishedIter = _published.recognitionData.erase(publishedIter);
+    } else {
+      ++publishedIter;
+    }
+  }
+  _published.bestGuessNames    = _trackingIDtoBestGuessName;
+  _published.enrollmentID      = _enrollmentID;
+  _published.enrollmentTrackID = _enrollmentTrackID;
+  _published.hasEnrollmentData = !_enrollmentData.empty();
+  
+  _isEnrollmentJobRunning = true;
+  _enrollmentJobExecutor->Wake([this, workerPtr = &worker]() {
+    FinishRecognition(*workerPtr, _enrollmentJobDebugImages);
+    
+    // Hands everything back to the caller's thread
+    _isEnrollmentJobRunning = false;
+  }, "FinishEnrollment");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FaceRecognizer::WaitForEnrollmentJob() const
+{
+  if(_isEnrollmentJobRunning) {
+    _enrollmentJobExecutor->WakeSync([]() {}, "WaitForEnrollmentJob");
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FaceRecognizer::FinishRecognition(RecognitionWorker& worker, DebugImageList<CompressedImage>& debugImages)
+{
+  if(worker.isTrackingCleared)
+  {
+    // A ClearTrackingData call was received while the worker was running on a
+    // detection. That detection ID is no longer valid, so drop the result on
+    // the floor. This should only be possible when running asynchronously.
+    DEV_ASSERT(_isRunningAsync, "FaceRecognizer.GetRecognitionData.InvalidTrackIDinSyncMode");
+    LOG_INFO("GetRecognitionData.DroppingFeaturesComputedWhileClearing", "");
+  }
+  else if(worker.isEnrollmentCancelled)
+  {
+    LOG_INFO("GetRecognitionData.DroppingFeaturesComputedWhileCancelled", "");
+  }
+  else
+  {
+    // The worker won't touch its data again until it is given a new face, so
+    // take its features and face data as the ones being recognized. The
+    // worker gets the previous feature handle to use for its next face.
+    std::swap(_okaoRecognitionFeatureHandle, worker.featureHandle);
+    std::swap(_img, worker.img);
+    _detectionInfo = worker.detectionInfo;
+    _isEnrollmentEnabled = worker.isEnrollmentEnabled;
+    _state = ProcessingState::FeaturesReady;
+
+    // Verbose, but useful for enrollment debugging
+    //  LOG_DEBUG("GetRecognitionData.EnrollmentStatus",
+    //            "ForTrackingID:%d EnrollmentCount=%d EnrollID=%d",
+    //            -_detectionInfo.nID, _enrollmentCount, _enrollmentID);
+
+    // Feature extraction is done: finish the rest of the recognition process
+    FaceID_t recognizedID = UnknownFaceID;
+    RecognitionScore score = 0;
+    Result result = RecognizeFace(recognizedID, score, debugImages);
+
+    if(RESULT_OK == result)
+    {
+      result = UpdateRecognitionData(recognizedID, score);
+      if(RESULT_OK != result)
+      {
+        LOG_ERROR("FaceRecognizer.GetRecognitionData.UpdateRecognitionDataFailed", "");
+      }
+    }
+    else
+    {
+      LOG_ERROR("FaceRecognizer.GetRecognitionData.RecognizeFaceFailed", "");
+    }
+
+    if(kDisplayDebugEnrollmentImages)
+    {
+      //DisplayEnrollmentImages(debugImages);
+    }
+
+    if(ANKI_DEVELOPER_CODE)
+    {
+      const Result sanityResult = SanityCheckBookkeeping(_okaoFaceAlbum,
+                                                         _enrollmentData,
+                                                         _albumEntryToFaceID);
+      DEV_ASSERT(sanityResult == RESULT_OK, "FaceRecognizer.GetRecognitionData.SanityCheckFailed");
+    }
+
+    _state = ProcessingState::Idle;
+  }
+
+  // Whether or not we used the computed features, mark that the worker is
+  // ready to process more
+  _mutex.lock();
+  worker.state = ProcessingState::Idle;
+  _mutex.unlock();
+
+} // FinishRecognition()
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FaceRecognizer::RemoveTrackingID(INT32 trackerID)
 {
@@ -768,37 +935,47 @@ void FaceRecognizer::ClearAllTrackingDataInternal()
   }
   _trackingToFaceID.clear();
   _trackingIDtoBestGuessName.clear();
+  _published.recognitionData.clear();
   
   if(_isRunningAsync)
   {
-    // If we're in the middle of computing features on the other thread, then
+    // If we're in the middle of computing features on a worker thread, then
     // we need to mark that the recognition data that comes back is associated
     // with a now-invalidated track ID
-    _detectionInfo.nID = UnknownFaceID;
+    std::lock_guard<std::mutex> lock(_mutex);
+    for(auto & worker : _workers)
+    {
+      if(ProcessingState::Idle != worker->state)
+      {
+        worker->isTrackingCleared = true;
+      }
+    }
   }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void FaceRecognizer::Run()
+void FaceRecognizer::Run(RecognitionWorker* worker)
 {
   Anki::Util::SetThreadName(pthread_self(), "FaceRecognizer");
 
   while(_isRunningAsync)
   {
     _mutex.lock();
-    const bool anythingToDo = ProcessingState::HasNewImage == _state;
+    const bool anythingToDo = ProcessingState::HasNewImage == worker->state;
     _mutex.unlock();
 
     if(anythingToDo) {
 
-      // Note: this puts us in FeaturesReady state when done (or Idle if failure)
-      ExtractFeatures();
+      // Note: this puts the worker in FeaturesReady state when done (or Idle if failure)
+      ExtractFeatures(*worker);
     }
 
     {
       // Wait for a new image to be processed
       std::unique_lock<std::mutex> lock{_mutex};
-      _newImageCondition.wait(lock, [this]{ return (_state == ProcessingState::HasNewImage) || !_isRunningAsync; });
+      _newImageCondition.wait(lock, [this,worker]{
+        return (worker->state == ProcessingState::HasNewImage) || !_isRunningAsync;
+      });
     }
   }
 
@@ -807,23 +984,28 @@ void FaceRecognizer::Run()
 } // Run()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void FaceRecognizer::ExtractFeatures()
+void FaceRecognizer::ExtractFeatures(RecognitionWorker& worker)
 {
-  DEV_ASSERT(ProcessingState::HasNewImage == _state, "FaceRecognizer.ExtractFeatures.ShouldBeInHasNewImageState");
-
   _mutex.lock();
-  _state = ProcessingState::ExtractingFeatures;
+  DEV_ASSERT(ProcessingState::HasNewImage == worker.state, "FaceRecognizer.ExtractFeatures.ShouldBeInHasNewImageState");
+  worker.state = ProcessingState::ExtractingFeatures;
   _mutex.unlock();
 
-  INT32 nWidth  = _img.GetNumCols();
-  INT32 nHeight = _img.GetNumRows();
-  RAWIMAGE* dataPtr = _img.GetDataPointer();
+  INT32 nWidth  = worker.img.GetNumCols();
+  INT32 nHeight = worker.img.GetNumRows();
+  RAWIMAGE* dataPtr = worker.img.GetDataPointer();
 
-  Tic("OkaoFeatureExtraction");
-  OkaoResult okaoResult = OKAO_FR_ExtractPoints_GRAY(_okaoRecognitionFeatureHandle,
+  // Note: the same Profiler timer can't be run from several worker threads at once
+  const bool doProfile = (_workers.size() == 1) || !_isRunningAsync;
+  if(doProfile) {
+    Tic("OkaoFeatureExtraction");
+  }
+  OkaoResult okaoResult = OKAO_FR_ExtractPoints_GRAY(worker.featureHandle,
                                                      dataPtr, nWidth, nHeight, GRAY_ORDER_Y0Y1Y2Y3, PT_POINT_KIND_MAX,
-                                                     _aptPoint, _anConfidence);
-  Toc("OkaoFeatureExtraction");
+                                                     worker.aptPoint, worker.anConfidence);
+  if(doProfile) {
+    Toc("OkaoFeatureExtraction");
+  }
 
   if(kFaceRecognitionSimulatedDelay_ms > 0)
   {
@@ -839,7 +1021,7 @@ void FaceRecognizer::ExtractFeatures()
   }
 
   _mutex.lock();
-  _state = newState;
+  worker.state = newState;
   _mutex.unlock();
 
 } // ExtractFeatures()
@@ -1031,7 +1213,17 @@ void FaceRecognizer::CancelExistingEnrollment()
   {
     LOG_INFO("FaceRecognizer.CancelExistingEnrollment",
              "Cancelling enrollment of FaceID %d", _enrollmentID);
-    _isEnrollmentCancelled = true;
+    {
+      // Drop any features still being computed for the face being enrolled
+      std::lock_guard<std::mutex> lock(_mutex);
+      for(auto & worker : _workers)
+      {
+        if(ProcessingState::Idle != worker->state)
+        {
+          worker->isEnrollmentCancelled = true;
+        }
+      }
+    }
     
     // Remove the (partial) album entry we were in the process of enrolling
     auto enrollDataIter = _enrollmentData.find(_enrollmentID);
@@ -1091,6 +1283,8 @@ void FaceRecognizer::CancelExistingEnrollment()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FaceRecognizer::SetAllowedEnrollments(s32 N, FaceID_t forFaceID, bool forceNewID)
 {
+  WaitForEnrollmentJob();
+  
   if(forFaceID == UnknownFaceID)
   {
     CancelExistingEnrollment();
@@ -1143,9 +1337,31 @@ bool FaceRecognizer::SetNextFaceToRecognize(const Vision::Image& img,
   // Nothing to do if we aren't allowed to enroll anyone and there's nobody
   // in the album yet to match this face to. Also ignore detections that are
   // being "held" (not actually tracked/detected in this frame).
-  const bool anythingToDo = (enableEnrollment || !_enrollmentData.empty()) && detectionInfo.nHoldCount == 0;
+  const bool hasEnrollmentData = (_isEnrollmentJobRunning ? _published.hasEnrollmentData : !_enrollmentData.empty());
+  const bool anythingToDo = (enableEnrollment || hasEnrollmentData) && detectionInfo.nHoldCount == 0;
+
+  // Find a free worker, unless one is already working on this face
+  RecognitionWorker* worker = nullptr;
+  if(anythingToDo)
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    for(auto & candidate : _workers)
+    {
+      if(ProcessingState::Idle == candidate->state)
+      {
+        if(nullptr == worker) {
+          worker = candidate.get();
+        }
+      }
+      else if(candidate->detectionInfo.nID == detectionInfo.nID)
+      {
+        worker = nullptr;
+        break;
+      }
+    }
+  }
 
-  if(ProcessingState::Idle == _state && anythingToDo)
+  if(nullptr != worker)
   {
     // Not currently busy: copy in the given data and start working on it
     
@@ -1163,39 +1379,42 @@ bool FaceRecognizer::SetNextFaceToRecognize(const Vision::Image& img,
                            ptRightBottom.x - ptLeftTop.x,
                            ptRightBottom.y - ptLeftTop.y);
     
-    _mutex.lock();
-    img.GetROI(faceROI).CopyTo(_img); // NOTE: only copying face ROI
+    // The worker is Idle, so its thread won't touch it until we change its state
+    img.GetROI(faceROI).CopyTo(worker->img); // NOTE: only copying face ROI
     
-    DEV_ASSERT(_img.IsContinuous(), "FaceRecognizer.SetNextFaceToRecognize.NonContinuousImage");
+    DEV_ASSERT(worker->img.IsContinuous(), "FaceRecognizer.SetNextFaceToRecognize.NonContinuousImage");
     
     // Update detection info to match ROI's size and face position:
-    _detectionInfo = detectionInfo;
-    _detectionInfo.ptCenter.x -= ptLeftTop.x;
-    _detectionInfo.ptCenter.y -= ptLeftTop.y;
-    _detectionInfo.nHeight = _img.GetNumRows();
-    _detectionInfo.nWidth  = _img.GetNumCols();
+    worker->detectionInfo = detectionInfo;
+    worker->detectionInfo.ptCenter.x -= ptLeftTop.x;
+    worker->detectionInfo.ptCenter.y -= ptLeftTop.y;
+    worker->detectionInfo.nHeight = worker->img.GetNumRows();
+    worker->detectionInfo.nWidth  = worker->img.GetNumCols();
     
-    _isEnrollmentEnabled = enableEnrollment;
+    worker->isEnrollmentEnabled = enableEnrollment;
+    worker->isTrackingCleared = false;
+    worker->isEnrollmentCancelled = false;
     
     // Copy in part info, adjusting positions for ROI location
     for(s32 i = 0; i < FR_PTPOINT_KIND_MAX; ++i)
     {
-      _aptPoint[i].x = facialParts[i].x - ptLeftTop.x;
-      _aptPoint[i].y = facialParts[i].y - ptLeftTop.y;
+      worker->aptPoint[i].x = facialParts[i].x - ptLeftTop.x;
+      worker->aptPoint[i].y = facialParts[i].y - ptLeftTop.y;
     }
-    memcpy(_anConfidence, partConfidences, PT_POINT_KIND_MAX*sizeof(INT32));
+    memcpy(worker->anConfidence, partConfidences, PT_POINT_KIND_MAX*sizeof(INT32));
     
-    // The image is ready to be processed by the thread, so notify that thread
-    _state = ProcessingState::HasNewImage;
+    // The image is ready to be processed by the worker's thread, so notify it
+    _mutex.lock();
+    worker->state = ProcessingState::HasNewImage;
     _mutex.unlock();
     _newImageCondition.notify_all();
 
     //LOG_INFO("SetNextFaceToRecognize.SetNextFace",
-    //         "Setting next face to recognize: tracked ID %d", -_detectionInfo.nID);
+    //         "Setting next face to recognize: tracked ID %d", -detectionInfo.nID);
 
     if(!_isRunningAsync) {
       // Immediately extract features when running synchronously
-      ExtractFeatures();
+      ExtractFeatures(*worker);
     }
 
     return true;
@@ -1205,8 +1424,8 @@ bool FaceRecognizer::SetNextFaceToRecognize(const Vision::Image& img,
 
     // Pretty verbose, but potentially useful for some debugging
     //      LOG_DEBUG("FaceRecognizer.SetNextFaceToRecognize.Ignoring",
-    //                "Idle:%d AnythingToDo:%d EnableEnrollment:%d HoldCount:%d",
-    //                (ProcessingState::Idle == _state), anythingToDo, enableEnrollment,
+    //                "HaveWorker:%d AnythingToDo:%d EnableEnrollment:%d HoldCount:%d",
+    //                (nullptr != worker), anythingToDo, enableEnrollment,
     //                detectionInfo.nHoldCount);
     
     return false;
@@ -2392,10 +2611,13 @@ Result FaceRecognizer::GetSerializedAlbum(std::vector<u8>& serializedAlbum) cons
              "Album with %d permanent faces = %d bytes (%.1f bytes/person)",
              permanentIdCount, albumSize, (f32)albumSize/(f32)permanentIdCount);
     
+    _albumMemoryAccount.Set(albumSize);
+    
   } // if(permanentIdCount == 0)
   else
   {
     LOG_INFO("GetSerializedAlbum.NoNamedIDs", "");
+    _albumMemoryAccount.Set(0);
   }
 
   return RESULT_OK;
@@ -2465,6 +2687,8 @@ s32 FaceRecognizer::GetNumNamedFaces() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FaceRecognizer::CanAddNamedFace() const
 {
+  WaitForEnrollmentJob();
+  
   const s32 numNamedFaces = GetNumNamedFaces();
   return (numNamedFaces < kMaxNamedFacesInAlbum);
 }
@@ -2472,6 +2696,8 @@ bool FaceRecognizer::CanAddNamedFace() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result FaceRecognizer::AssignNameToID(FaceID_t faceID, const std::string& name, FaceID_t mergeWithID)
 {
+  WaitForEnrollmentJob();
+  
   auto iterToRename = _enrollmentData.end();
 
   if(mergeWithID != UnknownFaceID)
@@ -2541,6 +2767,8 @@ Result FaceRecognizer::AssignNameToID(FaceID_t faceID, const std::string& name,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result FaceRecognizer::EraseFace(FaceID_t faceID)
 {
+  WaitForEnrollmentJob();
+  
   auto enrollIter = _enrollmentData.find(faceID);
   if(enrollIter != _enrollmentData.end())
   {
@@ -2560,6 +2788,8 @@ Result FaceRecognizer::EraseFace(FaceID_t faceID)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 std::vector<Vision::LoadedKnownFace> FaceRecognizer::GetEnrolledNames() const
 {
+  WaitForEnrollmentJob();
+  
   std::vector<LoadedKnownFace> ret;
   ret.reserve( _enrollmentData.size() );
   for( const auto& entry : _enrollmentData ) {
@@ -2573,6 +2803,8 @@ std::vector<Vision::LoadedKnownFace> FaceRecognizer::GetEnrolledNames() const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FaceRecognizer::EraseAllFaces()
 {
+  WaitForEnrollmentJob();
+  
   // Remove each user one at a time, to make sure all the cleanup gets done
   // (Like dissociating tracker IDs)
   for(auto enrollIter=_enrollmentData.begin(); enrollIter!=_enrollmentData.end(); )
@@ -2597,6 +2829,8 @@ void FaceRecognizer::EraseAllFaces()
 Result FaceRecognizer::RenameFace(FaceID_t faceID, const std::string& oldName, const std::string& newName,
                                   Vision::RobotRenamedEnrolledFace& renamedFace)
 {
+  WaitForEnrollmentJob();
+  
   auto enrollIter = _enrollmentData.find(faceID);
   if(enrollIter != _enrollmentData.end())
   {
@@ -2637,6 +2871,8 @@ Result FaceRecognizer::RenameFace(FaceID_t faceID, const std::string& oldName, c
 Result FaceRecognizer::GetSerializedData(std::vector<u8>& albumData,
                                          std::vector<u8>& enrollData)
 {
+  WaitForEnrollmentJob();
+  
   Result lastResult = GetSerializedAlbum(albumData);
 
   if(RESULT_OK != lastResult) {
@@ -2656,6 +2892,8 @@ Result FaceRecognizer::SetSerializedData(const std::vector<u8>& albumData,
                                          const std::vector<u8>& enrollData,
                                          std::list<LoadedKnownFace>& loadedFaces)
 {
+  WaitForEnrollmentJob();
+  
   if(NULL == _okaoCommonHandle) {
     LOG_ERROR("FaceRecognizer.SetSerializedData.NullFaceLibCommonHandle", "");
     return RESULT_FAIL;
@@ -2682,6 +2920,7 @@ Result FaceRecognizer::SetSerializedData(const std::vector<u8>& albumData,
       if(RESULT_OK == lastResult)
       {
         LOG_INFO("SetSerializedData.NewNextFaceID", "Setting next FaceID=%d", loadedNextFaceID);
+        _albumMemoryAccount.Set(albumData.size());
 
         _nextFaceID = loadedNextFaceID;
         
@@ -2953,74 +3192,134 @@ Result FaceRecognizer::SetSerializedEnrollData(const std::vector<u8>& serialized
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result FaceRecognizer::SaveAlbum(const std::string &albumName)
 {
-  Result result = RESULT_OK;
+  WaitForEnrollmentJob();
   
+  // Serialize on the caller's thread, since that's where the album lives, but leave the (slow) file writes to the
+  // album writer thread so they don't hold up recognition
   std::vector<u8> serializedAlbum;
-  result = GetSerializedAlbum(serializedAlbum);
+  Result result = GetSerializedAlbum(serializedAlbum);
   if(RESULT_OK != result) {
     return result;
   }
   
+  std::string enrollData;
+  if(!serializedAlbum.empty())
+  {
+    Json::Value json;
+    for(auto & enrollDataEntry : _enrollmentData)
+    {
+      if(false == enrollDataEntry.second.IsForThisSessionOnly())
+      {
+        Json::Value entry;
+        enrollDataEntry.second.FillJson(entry);
+        json[std::to_string(enrollDataEntry.first)] = std::move(entry);
+      }
+    }
+    Json::FastWriter writer;
+    enrollData = writer.write(json);
+  }
+  
+  const u32 saveRequest = ++_numAlbumSavesRequested;
+  _albumWriter->Wake([this, saveRequest, albumName,
+                      serializedAlbum = std::move(serializedAlbum),
+                      enrollData = std::move(enrollData)]() {
+    // A newer save will write everything this one would have
+    if(saveRequest == _numAlbumSavesRequested) {
+      WriteAlbumFiles(albumName, serializedAlbum, enrollData);
+    }
+  }, "SaveAlbum");
+  
+  return result;
+} // SaveAlbum()
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static bool WriteFileAtomically(const std::string& filename, const char* data, size_t size, std::ios::openmode mode)
+{
+  // Write to a temporary file and then rename it over the old one, so that a crash (or power loss) mid-write never
+  // leaves a truncated album behind
+  const std::string tempFilename(filename + ".tmp");
+  std::fstream fs;
+  fs.open(tempFilename, mode | std::ios::out | std::ios::trunc);
+  if(!fs.is_open()) {
+    return false;
+  }
+  
+  fs.write(data, size);
+  fs.close();
+  
+  if((fs.rdstate() & std::ios::badbit) || (fs.rdstate() & std::ios::failbit)) {
+    std::remove(tempFilename.c_str());
+    return false;
+  }
+  
+  return (0 == std::rename(tempFilename.c_str(), filename.c_str()));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result FaceRecognizer::WriteAlbumFiles(const std::string& albumName,
+                                       const std::vector<u8>& serializedAlbum,
+                                       const std::string& enrollData)
+{
+  const bool isSameAlbum = (albumName == _lastWrittenAlbumName);
+  
   if(serializedAlbum.empty()) {
     LOG_INFO("FaceRecognizer.SaveAlbum.EmptyAlbum",
              "No serialized data returned from private implementation; removing folder");
     Util::FileUtils::RemoveDirectory(albumName);
-    return result;
+    _lastWrittenAlbumName.clear();
+    return RESULT_OK;
   }
   
   if(false == Util::FileUtils::CreateDirectory(albumName, false, true)) {
     LOG_WARNING("FaceRecognizer.SaveAlbum.DirCreationFail",
                 "Tried to create: %s", albumName.c_str());
-    result = RESULT_FAIL;
-  } else {
-
+    return RESULT_FAIL;
+  }
+  
+  // Only rewrite the files whose contents changed since we last wrote this album: e.g. renaming a face only changes
+  // the enrollment data, and re-seeing someone often changes neither
+  if(!isSameAlbum || (serializedAlbum != _lastWrittenAlbumData))
+  {
     const std::string dataFilename(albumName + "/data.bin");
-    std::fstream fs;
-    fs.open(dataFilename, std::ios::binary | std::ios::out);
-    if(!fs.is_open()) {
-      LOG_WARNING("FaceRecognizer.SaveAlbum.FileOpenFail", "Filename: %s", dataFilename.c_str());
-      result = RESULT_FAIL;
-    } else {
-
-      fs.write((const char*)&(serializedAlbum[0]), serializedAlbum.size());
-      fs.close();
-
-      if((fs.rdstate() & std::ios::badbit) || (fs.rdstate() & std::ios::failbit)) {
-        LOG_WARNING("FaceRecognizer.SaveAlbum.FileWriteFail", "Filename: %s", dataFilename.c_str());
-        result = RESULT_FAIL;
-      } else {
-        Json::Value json;
-        for(auto & enrollData : _enrollmentData)
-        {
-          if(false == enrollData.second.IsForThisSessionOnly())
-          {
-            Json::Value entry;
-            enrollData.second.FillJson(entry);
-            json[std::to_string(enrollData.first)] = std::move(entry);
-          }
-        }
-
-        const std::string enrollDataFilename(albumName + "/enrollData.json");
-        Json::FastWriter writer;
-        fs.open(enrollDataFilename, std::ios::out);
-        if (!fs.is_open()) {
-          LOG_WARNING("FaceRecognizer.SaveAlbum.EnrollDataFileOpenFail", "");
-          result = RESULT_FAIL;
-        } else {
-          fs << writer.write(json);
-          fs.close();
-        }
-      }
+    if(!WriteFileAtomically(dataFilename, (const char*)serializedAlbum.data(), serializedAlbum.size(), std::ios::binary)) {
+      LOG_WARNING("FaceRecognizer.SaveAlbum.FileWriteFail", "Filename: %s", dataFilename.c_str());
+      _lastWrittenAlbumName.clear();
+      return RESULT_FAIL;
     }
   }
+  
+  if(!isSameAlbum || (enrollData != _lastWrittenEnrollData))
+  {
+    const std::string enrollDataFilename(albumName + "/enrollData.json");
+    if(!WriteFileAtomically(enrollDataFilename, enrollData.data(), enrollData.size(), std::ios::openmode())) {
+      LOG_WARNING("FaceRecognizer.SaveAlbum.EnrollDataFileWriteFail", "Filename: %s", enrollDataFilename.c_str());
+      _lastWrittenAlbumName.clear();
+      return RESULT_FAIL;
+    }
+  }
+  
+  _lastWrittenAlbumName  = albumName;
+  _lastWrittenAlbumData  = serializedAlbum;
+  _lastWrittenEnrollData = enrollData;
+  
+  return RESULT_OK;
+} // WriteAlbumFiles()
 
-  return result;
-} // SaveAlbum()
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void FaceRecognizer::FlushAlbumWrites()
+{
+  if(_albumWriter) {
+    // Anything already queued runs first. Forget what was written, in case the files change underneath us.
+    _albumWriter->WakeSync([this]() { _lastWrittenAlbumName.clear(); }, "FlushAlbumWrites");
+  }
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result FaceRecognizer::LoadAlbum(const std::string& albumName,
                                  std::list<LoadedKnownFace>& namesAndIDs)
 {
+  WaitForEnrollmentJob();
+  
   if(!_isInitialized) {
     LOG_ERROR("FaceRecognizer.LoadAlbum.NotInitialized", "");
     return RESULT_FAIL;
@@ -3031,6 +3330,9 @@ Result FaceRecognizer::LoadAlbum(const std::string& albumName,
     return RESULT_FAIL;
   }
 
+  // Make sure we read what the last SaveAlbum wrote
+  FlushAlbumWrites();
+  
   // Loading a new album, even an "empty" or nonexistent one, clears any existing named or session-only faces.
   EraseAllFaces();
   
@@ -3109,6 +3411,9 @@ Result FaceRecognizer::LoadAlbum(const std::string& albumName,
         }
         
         result = UseLoadedAlbumAndEnrollData(loadedAlbum, loadedEnrollmentData);
+        if(RESULT_OK == result) {
+          _albumMemoryAccount.Set(serializedAlbum.size());
+        }
       }
     }
   }
@@ -3119,6 +3424,16 @@ Result FaceRecognizer::LoadAlbum(const std::string& albumName,
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool FaceRecognizer::GetFaceIDFromTrackingID(const TrackingID_t trackingID, FaceID_t& faceID) const
 {
+  if(_isEnrollmentJobRunning)
+  {
+    auto publishedIter = _published.recognitionData.find(trackingID);
+    if(publishedIter == _published.recognitionData.end()) {
+      return false;
+    }
+    faceID = publishedIter->second.GetFaceID();
+    return true;
+  }
+  
   auto iter = _trackingToFaceID.find(trackingID);
   if(iter == _trackingToFaceID.end()) {
     return false;
@@ -3131,8 +3446,9 @@ bool FaceRecognizer::GetFaceIDFromTrackingID(const TrackingID_t trackingID, Face
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 std::string FaceRecognizer::GetBestGuessNameForTrackingID(const TrackingID_t trackingID) const
 {
-  auto iter = _trackingIDtoBestGuessName.find(trackingID);
-  if(iter == _trackingIDtoBestGuessName.end())
+  const auto& bestGuessNames = (_isEnrollmentJobRunning ? _published.bestGuessNames : _trackingIDtoBestGuessName);
+  auto iter = bestGuessNames.find(trackingID);
+  if(iter == bestGuessNames.end())
   {
     return "";
   }
@@ -3142,6 +3458,18 @@ std::string FaceRecognizer::GetBestGuessNameForTrackingID(const TrackingID_t tra
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FaceRecognizer::TrackingID_t FaceRecognizer::GetEnrollmentTrackID() const
+{
+  return (_isEnrollmentJobRunning ? _published.enrollmentTrackID : _enrollmentTrackID);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+FaceID_t FaceRecognizer::GetEnrollmentID() const
+{
+  return (_isEnrollmentJobRunning ? _published.enrollmentID : _enrollmentID);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result FaceRecognizer::ComputeFeaturesFromFace(const Image& img, const TrackedFace& face,
                                                HFEATURE featureHandle)
@@ -3238,6 +3566,8 @@ Result FaceRecognizer::ComputeFeaturesFromFace(const Image& img, const TrackedFa
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result FaceRecognizer::DevAddFaceToAlbum(const Image& img, const TrackedFace& face, int albumEntry)
 {
+  WaitForEnrollmentJob();
+  
   const Result result = ComputeFeaturesFromFace(img, face, _okaoRecognitionFeatureHandle);
   if(RESULT_OK != result)
   {
@@ -3289,6 +3619,8 @@ Result FaceRecognizer::DevAddFaceToAlbum(const Image& img, const TrackedFace& fa
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result FaceRecognizer::DevFindFaceInAlbum(const Image& img, const TrackedFace& face, int& albumEntry, float& score) const
 {
+  WaitForEnrollmentJob();
+  
   std::vector<std::pair<int,float>> matches;
   const Result result = DevFindFaceInAlbum(img, face, 1, matches);
   if(RESULT_OK == result && !matches.empty())
@@ -3305,6 +3637,8 @@ Result FaceRecognizer::DevFindFaceInAlbum(const Image& img, const TrackedFace& f
 Result FaceRecognizer::DevFindFaceInAlbum(const Image& img, const TrackedFace& face, const int maxMatches,
                                           std::vector<std::pair<int, float>>& matches) const
 {
+  WaitForEnrollmentJob();
+  
   const Result result = ComputeFeaturesFromFace(img, face, _okaoRecognitionFeatureHandle);
   if(RESULT_OK != result)
   {
@@ -3336,6 +3670,8 @@ Result FaceRecognizer::DevFindFaceInAlbum(const Image& img, const TrackedFace& f
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 float FaceRecognizer::DevComputePairwiseMatchScore(int faceID1, int faceID2) const
 {
+  WaitForEnrollmentJob();
+  
   OkaoResult okaoResult = OKAO_FR_GetFeatureFromAlbum(_okaoFaceAlbum, faceID1, 0, _okaoRecognitionFeatureHandle);
   if(OKAO_NORMAL != okaoResult)
   {
@@ -3359,6 +3695,8 @@ float FaceRecognizer::DevComputePairwiseMatchScore(int faceID1, int faceID2) con
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 float FaceRecognizer::DevComputePairwiseMatchScore(int faceID1, const Image& img2, const TrackedFace& face2) const
 {
+  WaitForEnrollmentJob();
+  
   HFEATURE features2 = OKAO_FR_CreateFeatureHandle(_okaoCommonHandle);
   if(NULL == features2) {
     LOG_ERROR("FaceRecognizer.DevComputePairwiseMatchScore.FaceLibFeatureHandle1AllocFail", "");
@@ -3391,6 +3729,8 @@ float FaceRecognizer::DevComputePairwiseMatchScore(int faceID1, const Image& img
 float FaceRecognizer::DevComputePairwiseMatchScore(const Image& img1, const TrackedFace& face1,
                                                    const Image& img2, const TrackedFace& face2)
 {
+  WaitForEnrollmentJob();
+  
   HFEATURE features1 = OKAO_FR_CreateFeatureHandle(_okaoCommonHandle);
   if(NULL == features1) {
     LOG_ERROR("FaceRecognizer.DevComputePairwiseMatchScore.FaceLibFeatureHandle1AllocFail", "");
@@ -3448,6 +3788,8 @@ float FaceRecognizer::DevComputePairwiseMatchScore(const Image& img1, const Trac
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FaceRecognizer::SaveAllRecognitionImages(const std::string& imagePathPrefix)
 {
+  WaitForEnrollmentJob();
+  
   for (const auto& albumEntry: _enrollmentImages) {
     const AlbumEntryID_t entryId = albumEntry.first;
     for (const auto& enrollmentImage: albumEntry.second) {
@@ -3466,6 +3808,8 @@ void FaceRecognizer::SaveAllRecognitionImages(const std::string& imagePathPrefix
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void FaceRecognizer::DeleteAllRecognitionImages()
 {
+  WaitForEnrollmentJob();
+  
   _enrollmentImages.clear();
 }
 #endif // ANKI_DEV_CHEATS
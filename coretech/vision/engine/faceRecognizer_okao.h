@@ -6,8 +6,12 @@
  *
  * Description: Wrapper for OKAO Vision face recognition library. Maintains the 
  *              library of enrolled faces. Supports running facial feature 
- *              extraction on a separate thread by default, since that is the 
- *              slowest part of the recognition process.
+ *              extraction on a pool of separate threads by default, since that
+ *              is the slowest part of the recognition process, so that several
+ *              tracked faces can be worked on at once. When running
+ *              asynchronously, matching a face that may be enrolled and the
+ *              album updates that follow also run on a background job, so
+ *              enrollment doesn't hold up tracking.
  *
  * NOTE: This file should only be included by faceTrackerImpl_okao.h
  *
@@ -20,6 +24,7 @@
 #include "coretech/vision/engine/enrolledFaceEntry.h"
 
 #include "clad/types/loadedKnownFace.h"
+#include "util/memoryAccounting/memoryAccounting.h"
 
 // Omron OKAO Vision
 #include "OkaoAPI.h"
@@ -28,16 +33,23 @@
 #include "CommonDef.h"
 #include "DetectorComDef.h"
 
+#include <atomic>
+#include <condition_variable>
 #include <list>
 #include <map>
+#include <memory>
 #include <thread>
 #include <mutex>
+#include <vector>
 
 namespace Json {
   class Value;
 }
 
 namespace Anki {
+namespace Util {
+  class TaskExecutor;
+}
 namespace Vision {
   
   class CompressedImage;
@@ -69,9 +81,10 @@ namespace Vision {
     // Request that the recognizer work on assigning a new or existing FaceID
     // from its album of known faces to the specified trackerID, using the
     // given facial part data. Returns true if the request is accepted (i.e.,
-    // the recognizer isn't already busy with another request) and false
-    // otherwise. If true, the caller must not modify the part detection handle
-    // while processing is running (i.e. until false is returned).
+    // a recognition worker is free and none is already working on this
+    // trackerID) and false otherwise. The image and part data are copied, so
+    // the caller may reuse them right away. Callers should offer faces in
+    // order of how much they want them recognized.
     // If running synchronously, always returns true.
     bool SetNextFaceToRecognize(const Vision::Image& img,
                                 const DETECTION_INFO& detectionInfo,
@@ -86,8 +99,8 @@ namespace Vision {
     // Use N = -1 to allow ongoing enrollment.
     void SetAllowedEnrollments(s32 N, FaceID_t forFaceID, bool forceNewID = false);
     
-    TrackingID_t GetEnrollmentTrackID() const { return _enrollmentTrackID; }
-    FaceID_t     GetEnrollmentID()      const { return _enrollmentID; }
+    TrackingID_t GetEnrollmentTrackID() const;
+    FaceID_t     GetEnrollmentID()      const;
     
     // Note that this will take effect on the next call to GetRecognitionData below
     // (I.e., this just "queues" the clear to help prevent race conditions when running asynchronously)
@@ -97,6 +110,8 @@ namespace Vision {
     // If a specific enrollment ID and count are in use, and the enrollment just
     // completed (the count was just reached), then that count is returned in
     // 'enrollmentCountReached'. Otherwise 0 is returned.
+    // While an enrollment job is updating the album, returns the data last
+    // returned for this tracking ID (and enrollmentCountReached=0) instead.
     EnrolledFaceEntry GetRecognitionData(TrackingID_t forTrackingID, s32& enrollmentCountReached,
                                          DebugImageList<CompressedImage>& debugImages);
     
@@ -104,6 +119,9 @@ namespace Vision {
     bool HasName(TrackingID_t forTrackingID) const;
     
     Result LoadAlbum(const std::string& albumName, std::list<LoadedKnownFace>& loadedFaces);
+    
+    // Takes a snapshot of the album and writes it on a background thread, so a failure to write the files is only
+    // logged. Loading waits for any pending writes.
     Result SaveAlbum(const std::string& albumName);
     
     Result GetSerializedData(std::vector<u8>& albumData,
@@ -169,11 +187,55 @@ namespace Vision {
     
     using AlbumEntryToFaceID = std::map<AlbumEntryID_t, FaceID_t>;
     
+    // Threading
+    enum class ProcessingState : u8 {
+      Idle,
+      HasNewImage,
+      ExtractingFeatures,
+      FeaturesReady
+    };
+    
+    // Each worker extracts features for one face at a time into its own OKAO
+    // feature handle. Matching against the album happens in GetRecognitionData()
+    // on the caller's thread, or on the enrollment job's, which swaps the
+    // worker's handle and face data with the ones below.
+    struct RecognitionWorker
+    {
+      HFEATURE        featureHandle = NULL;
+      ProcessingState state         = ProcessingState::Idle; // protected by _mutex
+      std::thread     thread;
+      
+      // Passed-in state for processing
+      Image           img;
+      DETECTION_INFO  detectionInfo;
+      POINT           aptPoint[PT_POINT_KIND_MAX];
+      INT32           anConfidence[PT_POINT_KIND_MAX];
+      bool            isEnrollmentEnabled = false;
+      
+      // Only touched by whoever owns the album: set when tracking data is cleared
+      // or enrollment is cancelled while this worker is busy, so its result
+      // gets dropped
+      bool            isTrackingCleared     = false;
+      bool            isEnrollmentCancelled = false;
+    };
+    
     // Called by Run() in async mode whenever there's a new image to be processed.
     // Called on each use of SetNextFaceToRecognize() when running synchronously.
-    // Assumes state is HasNewImage at start and goes to FeaturesReady on success
-    // or Idle on failure.
-    void ExtractFeatures();
+    // Assumes the worker's state is HasNewImage at start and goes to
+    // FeaturesReady on success or Idle on failure.
+    void ExtractFeatures(RecognitionWorker& worker);
+    
+    // Finishes recognition of the given worker's face, whose features are ready
+    void FinishRecognition(RecognitionWorker& worker, DebugImageList<CompressedImage>& debugImages);
+    
+    // Finishes recognition of the given worker's face on the enrollment job's
+    // thread, which owns the album and bookkeeping until it is done
+    void StartEnrollmentJob(RecognitionWorker& worker);
+    
+    // Waits for any running enrollment job to finish. Everything that uses the
+    // album or bookkeeping from the caller's thread (other than the per-frame
+    // queries, which use _published) calls this first.
+    void WaitForEnrollmentJob() const;
     
     AlbumEntryID_t GetNextAlbumEntryToUse();
     FaceID_t GetNextFaceID();
@@ -261,27 +323,26 @@ namespace Vision {
     HFEATURE    _okaoRecogMergeFeatureHandle   = NULL;
     HALBUM      _okaoFaceAlbum                 = NULL;
     
-    POINT       _aptPoint[PT_POINT_KIND_MAX];
-    INT32       _anConfidence[PT_POINT_KIND_MAX];
-
-    // Threading
-    enum class ProcessingState : u8 {
-      Idle,
-      HasNewImage,
-      ExtractingFeatures,
-      FeaturesReady
-    };
+    // The face library allocates the album itself, so this is the size of the named faces' serialized album as
+    // of the last save or load. Session-only faces aren't counted
+    mutable Util::MemoryAccount _albumMemoryAccount{Util::MemoryTag::FaceAlbum};
+    
+    static constexpr s32 kDefaultNumWorkers = 2;
+    static constexpr s32 kMaxNumWorkers     = 4;
+    
     std::mutex      _mutex;
     std::condition_variable _newImageCondition;
-    std::thread     _featureExtractionThread;
+    std::vector<std::unique_ptr<RecognitionWorker>> _workers;
+    s32             _numWorkers = kDefaultNumWorkers;
     bool            _isRunningAsync = true;
-    bool            _isEnrollmentCancelled = false;
+    
+    // FeaturesReady while finishing recognition of a worker's face, Idle otherwise
     ProcessingState _state = ProcessingState::Idle;
     void StartThread();
-    void Run();
+    void Run(RecognitionWorker* worker);
     void StopThread();
 
-    // Passed-in state for processing
+    // State of the face currently being recognized (swapped in from its worker)
     Image          _img;
     DETECTION_INFO _detectionInfo;
     
@@ -317,6 +378,43 @@ namespace Vision {
                             DebugImageList<CompressedImage>& debugImages);
     
     static Result ComputeFeaturesFromFace(const Image& img, const TrackedFace& face, HFEATURE featureHandle);
+    
+    // Matching a face that may be enrolled can add to or update the album and merge faces, which takes long enough
+    // to stall tracking, so in async mode that happens on this thread instead. Only one job runs at a time, and
+    // while it does, it owns the album and all of the bookkeeping above.
+    std::unique_ptr<Util::TaskExecutor> _enrollmentJobExecutor;
+    std::atomic<bool> _isEnrollmentJobRunning{false};
+    DebugImageList<CompressedImage> _enrollmentJobDebugImages; // handed to the caller once the job is done
+    
+    // What the caller's thread answers its per-frame queries with while an enrollment job runs: the recognition
+    // data last returned for each tracking ID (so nothing is reported twice or out of order), and the rest as of
+    // when the job started. Only touched on the caller's thread.
+    struct PublishedState
+    {
+      std::map<TrackingID_t, EnrolledFaceEntry> recognitionData;
+      std::map<TrackingID_t, std::string>       bestGuessNames;
+      FaceID_t     enrollmentID      = UnknownFaceID;
+      TrackingID_t enrollmentTrackID = UnknownFaceID;
+      bool         hasEnrollmentData = false;
+    };
+    PublishedState _published;
+    
+    // Album files are written on this thread so that saving doesn't block recognition. Only the newest of several
+    // queued saves gets written, and each file only if its contents changed since the last write.
+    std::unique_ptr<Util::TaskExecutor> _albumWriter;
+    std::atomic<u32> _numAlbumSavesRequested{0};
+    
+    // Only used on the album writer's thread
+    std::string      _lastWrittenAlbumName;
+    std::vector<u8>  _lastWrittenAlbumData;
+    std::string      _lastWrittenEnrollData;
+    
+    Result WriteAlbumFiles(const std::string& albumName,
+                           const std::vector<u8>& serializedAlbum,
+                           const std::string& enrollData);
+    
+    // Waits for any queued album writes to finish
+    void FlushAlbumWrites();
 
   }; // class FaceRecognizer
   
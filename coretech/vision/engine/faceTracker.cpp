@@ -60,7 +60,7 @@ namespace Vision {
   
   Result FaceTracker::Update(const Vision::Image&        frameOrig,
                              const float                 cropFactor,
-                             std::list<TrackedFace>&     faces,
+                             std::vector<TrackedFace>&     faces,
                              std::list<UpdatedFaceID>&   updatedIDs,
                              DebugImageList<CompressedImage>& debugImages)
   {
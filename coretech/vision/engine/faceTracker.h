@@ -20,6 +20,7 @@
 #include "clad/types/loadedKnownFace.h"
 
 #include <list>
+#include <vector>
 
 // Forward declaration:
 namespace Json {
@@ -48,7 +49,7 @@ namespace Vision {
     // CropFactor is the fraction of original image width to use for detection/tracking
     Result Update(const Vision::Image&        frameOrig,
                   const float                 cropFactor,
-                  std::list<TrackedFace>&     faces,
+                  std::vector<TrackedFace>&     faces,
                   std::list<UpdatedFaceID>&   updatedIDs,
                   DebugImageList<CompressedImage>& debugImages);
     
@@ -65,6 +65,10 @@ namespace Vision {
   CONSOLE_VAR(bool, kReinitDetector,              "Vision.FaceDetectorCommon", false);
   #endif // REMOTE_CONSOLE_ENABLED
 
+  // Expression, smile, gaze and blink estimation run for at most this many faces per frame (0 for every face),
+  // taking turns, so their cost doesn't grow with the number of faces in view
+  CONSOLE_VAR_RANGED(s32, kMaxFacesEstimatedPerFrame, "Vision.FaceTracker", 1, 0, 10);
+
   CONSOLE_VAR(bool, kUseUndistortionForFacePose,  "Vision.FaceDetectorCommon", true);
   CONSOLE_VAR(bool, kAdjustEyeDistByYaw,          "Vision.FaceDetectorCommon", true);
   CONSOLE_VAR(bool, kKeepUndistortedFaceFeatures, "Vision.FaceDetectorCommon", false);
@@ -457,6 +461,7 @@ namespace Vision {
     }
 
     _recognizer.ClearAllTrackingData();
+    _lastEstimates.clear();
   }
 
   void FaceTracker::Impl::ClearAllowedTrackedFaces()
@@ -1050,9 +1055,53 @@ namespace Vision {
     }
   }
 
+  std::set<INT32> FaceTracker::Impl::GetFacesToEstimate(const std::vector<INT32>& trackingIDs) const
+  {
+    const size_t maxFaces = (size_t)kMaxFacesEstimatedPerFrame;
+    if(0 == maxFaces || trackingIDs.size() <= maxFaces)
+    {
+      return std::set<INT32>(trackingIDs.begin(), trackingIDs.end());
+    }
+    
+    // Longest since last estimated goes first, and faces never estimated before go before all others
+    std::vector<std::pair<u32,INT32>> lastEstimatedFrames;
+    lastEstimatedFrames.reserve(trackingIDs.size());
+    for(const auto trackingID : trackingIDs)
+    {
+      const auto iter = _lastEstimates.find(trackingID);
+      lastEstimatedFrames.emplace_back((iter == _lastEstimates.end() ? 0 : iter->second.frameNumber), trackingID);
+    }
+    std::partial_sort(lastEstimatedFrames.begin(), lastEstimatedFrames.begin() + maxFaces, lastEstimatedFrames.end());
+    
+    std::set<INT32> facesToEstimate;
+    for(size_t i = 0; i < maxFaces; ++i)
+    {
+      facesToEstimate.insert(lastEstimatedFrames[i].second);
+    }
+    return facesToEstimate;
+  }
+  
+  static void CopyEstimates(const TrackedFace& from, TrackedFace& to)
+  {
+    const auto& expressionValues = from.GetExpressionValues();
+    for(size_t i = 0; i < expressionValues.size(); ++i)
+    {
+      to.SetExpressionValue((FacialExpression)i, expressionValues[i]);
+    }
+    if(from.GetSmileAmount().wasChecked) {
+      to.SetSmileAmount(from.GetSmileAmount().amount, from.GetSmileAmount().confidence);
+    }
+    if(from.GetGaze().wasChecked) {
+      to.SetGaze(from.GetGaze().leftRight_deg, from.GetGaze().upDown_deg);
+    }
+    if(from.GetBlinkAmount().wasChecked) {
+      to.SetBlinkAmount(from.GetBlinkAmount().blinkAmountLeft, from.GetBlinkAmount().blinkAmountRight);
+    }
+  }
+  
   Result FaceTracker::Impl::Update(const Vision::Image& frameOrig,
                                    const float cropFactor,
-                                   std::list<TrackedFace>& faces,
+                                   std::vector<TrackedFace>& faces,
                                    std::list<UpdatedFaceID>& updatedIDs,
                                    DebugImageList<CompressedImage>& debugImages)
   {
@@ -1104,7 +1153,15 @@ namespace Vision {
     // so that we can choose to run recognition more selectively in the loop below,
     // effectively prioritizing those we don't already recognize
     std::vector<INT32> detectionIndices(numDetections);
+    std::vector<INT32> trackingIDs(numDetections);
     std::set<INT32> skipRecognition;
+    
+    // Faces the recognizer has no data for yet come first, then bigger (closer) faces, which recognize better
+    struct RecognitionPriority {
+      bool  isNew;
+      INT32 size;
+    };
+    std::vector<RecognitionPriority> priorities(numDetections);
 
     for(INT32 detectionIndex=0; detectionIndex<numDetections; ++detectionIndex)
     {
@@ -1135,14 +1192,39 @@ namespace Vision {
       {
         skipRecognition.insert(detectionInfo.nID);
       }
+      
+      priorities[detectionIndex].isNew = !_recognizer.HasRecognitionData(detectionInfo.nID);
+      priorities[detectionIndex].size  = detectionInfo.nHeight;
+      trackingIDs[detectionIndex] = detectionInfo.nID;
+    }
+    
+    ++_frameNumber;
+    const std::set<INT32> facesToEstimate = GetFacesToEstimate(trackingIDs);
+    
+    // Forget estimates for faces no longer being tracked
+    for(auto iter = _lastEstimates.begin(); iter != _lastEstimates.end(); )
+    {
+      if(std::find(trackingIDs.begin(), trackingIDs.end(), iter->first) == trackingIDs.end()) {
+        iter = _lastEstimates.erase(iter);
+      } else {
+        ++iter;
+      }
     }
     
-    // Shuffle the set of unrecognized faces so we don't always try the same one.
-    // If we know everyone, no need to random shuffle (skip all)
+    // Offer faces to the recognizer in priority order, since it only takes as many as it has free workers.
+    // Shuffle first so that among equally important faces we don't always try the same one.
+    // If we know everyone, no need to sort (skip all)
     if(numDetections > 1 && skipRecognition.size() != numDetections)
     {
       std::random_shuffle(detectionIndices.begin(), detectionIndices.end(),
                           [this](int i) { return _rng->RandInt(i); });
+      
+      std::stable_sort(detectionIndices.begin(), detectionIndices.end(), [&priorities](INT32 a, INT32 b) {
+        if(priorities[a].isNew != priorities[b].isNew) {
+          return priorities[a].isNew;
+        }
+        return priorities[a].size > priorities[b].size;
+      });
     }
     
     for(auto const& detectionIndex : detectionIndices)
@@ -1223,7 +1305,15 @@ namespace Vision {
         //                 "Roll=%ddeg, Pitch=%ddeg, Yaw=%ddeg",
         //                 roll_deg, pitch_deg, yaw_deg);
 
-        if(_detectEmotion)
+        const bool isEstimatingThisFrame = (facesToEstimate.count(detectionInfo.nID) > 0);
+        const auto lastEstimatesIter = _lastEstimates.find(detectionInfo.nID);
+        if(!isEstimatingThisFrame && (lastEstimatesIter != _lastEstimates.end()))
+        {
+          // Not this face's turn: keep reporting what was last estimated
+          CopyEstimates(lastEstimatesIter->second.face, face);
+        }
+        
+        if(_detectEmotion && isEstimatingThisFrame)
         {
           // Expression detection
           Tic("ExpressionRecognition");
@@ -1236,7 +1326,7 @@ namespace Vision {
           }
         } // if(_detectEmotion)
         
-        if(_detectSmiling)
+        if(_detectSmiling && isEstimatingThisFrame)
         {
           Tic("SmileDetection");
           Result smileResult = DetectSmile(nWidth, nHeight, dataPtr, face);
@@ -1249,7 +1339,7 @@ namespace Vision {
           }
         }
         
-        if(_detectGaze || _detectBlinks) // In OKAO, gaze and blink are part of the same detector
+        if((_detectGaze || _detectBlinks) && isEstimatingThisFrame) // In OKAO, gaze and blink are one detector
         {
           Tic("GazeAndBlinkDetection");
           Result gbResult = DetectGazeAndBlink(nWidth, nHeight, dataPtr, face);
@@ -1261,6 +1351,13 @@ namespace Vision {
                         detectionIndex, numDetections);
           }
         }
+        
+        if(isEstimatingThisFrame)
+        {
+          LastEstimates& lastEstimates = _lastEstimates[detectionInfo.nID];
+          lastEstimates.face = face;
+          lastEstimates.frameNumber = _frameNumber;
+        }
 
         // This needs to happen after we set the gaze, otherwise
         // the eye pose will have the default gaze values
@@ -33,6 +33,8 @@
 #include "DetectorComDef.h"
 
 #include <list>
+#include <map>
+#include <vector>
 
 namespace Anki {
   
@@ -56,7 +58,7 @@ namespace Vision {
     
     Result Update(const Vision::Image&        frameOrig,
                   const float                 cropFactor,
-                  std::list<TrackedFace>&     faces,
+                  std::vector<TrackedFace>&     faces,
                   std::list<UpdatedFaceID>&   updatedIDs,
                   DebugImageList<CompressedImage>& debugImages);
     
@@ -198,6 +200,18 @@ namespace Vision {
     std::map<FaceID_t, EyeContact> _facesEyeContact;
 
     std::set<FaceID_t> _allowedTrackedFaceID;
+    
+    // Expression, smile, gaze and blink are estimated for a limited number of faces per frame, taking turns. The
+    // others report their last estimates, kept here by OKAO tracking ID.
+    struct LastEstimates {
+      TrackedFace face; // only its expression, smile, gaze and blink are used
+      u32         frameNumber = 0;
+    };
+    std::map<INT32, LastEstimates> _lastEstimates;
+    u32 _frameNumber = 0;
+    
+    // Tracking IDs of the faces whose turn it is this frame
+    std::set<INT32> GetFacesToEstimate(const std::vector<INT32>& trackingIDs) const;
   }; // class FaceTracker::Impl
   
 } // namespace Vision
@@ -27,6 +27,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 namespace Anki {
 namespace Vision {
@@ -37,7 +38,7 @@ namespace Vision {
     Impl(const std::string& modelPath, const Json::Value& config);
     
     Result Update(const Vision::Image& frameOrig,
-                  std::list<TrackedFace>& faces,
+                  std::vector<TrackedFace>& faces,
                   std::list<FaceTracker::UpdatedID>& updatedIDs);
     
     void EnableDisplay(bool enabled) { }
@@ -118,7 +119,7 @@ namespace Vision {
   }
   
   Result FaceTracker::Impl::Update(const Vision::Image& frame,
-                                   std::list<TrackedFace>& returnedFaces,
+                                   std::vector<TrackedFace>& returnedFaces,
                                    std::list<FaceTracker::UpdatedID>& updatedIDs)
   {
     if(!_isInitialized) {
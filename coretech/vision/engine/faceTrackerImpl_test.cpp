@@ -63,7 +63,7 @@ FaceTracker::Impl::~Impl()
 }
 
 Result FaceTracker::Impl::Update(const Vision::Image& frameOrig,
-                                 std::list<TrackedFace>& faces,
+                                 std::vector<TrackedFace>& faces,
                                  std::list<UpdatedFaceID>& updatedIDs)
 {
   // This is the detection time delay to simulate the face detector
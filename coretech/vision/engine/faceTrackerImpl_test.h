@@ -36,7 +36,7 @@ public:
   ~Impl();
 
   Result Update(const Vision::Image&        frameOrig,
-                std::list<TrackedFace>&     faces,
+                std::vector<TrackedFace>&     faces,
                 std::list<UpdatedFaceID>&   updatedIDs);
 
   void EnableEmotionDetection(bool enable) {}
@@ -29,109 +29,36 @@ namespace {
   // of the two points used to find the intersection with the ground plane weren't too close
   // as to cause numerical instabilities. 500 was too small.
   CONSOLE_VAR(f32, kGazeDirectionSecondPointTranslationY_mm,  "Vision.GazeDirection",  1500.f);
+
+  const Point3f kDefaultGazeDirection_mm(-100000.f, -100000.f, -100000.f);
 }
 
 GazeDirection::GazeDirection()
-  : _gazeDirectionAverage(Point3f(GazeDirectionData::kDefaultDistance_mm,
-                                  GazeDirectionData::kDefaultDistance_mm,
-                                  GazeDirectionData::kDefaultDistance_mm))
+  : _gazeDirectionHistory(kGazeDirectionHistorySize, kDefaultGazeDirection_mm, false)
+  , _gazeDirectionAverage(kDefaultGazeDirection_mm)
 {
-  _gazeDirectionHistory.resize(kGazeDirectionHistorySize);
 }
 
 void GazeDirection::Update(const TrackedFace& face)
 {
-  _headPose = face.GetHeadPose();
   _lastUpdated = face.GetTimeStamp();
 
-  if (_currentIndex > (kGazeDirectionHistorySize - 1)) {
-    // Make sure we place a "real" value
-    // in every element of the history
-    // before returning a result
-    _initialized = true;
-    _currentIndex = 0;
-  }
-
+  // Points that don't intersect the ground plane still take up a slot in
+  // the history, they just aren't averaged
   Point3f gazeDirectionPoint;
-  const bool include = GetPointFromHeadPose(_headPose, gazeDirectionPoint);
-  _gazeDirectionHistory[_currentIndex].Update(gazeDirectionPoint, include);
-
-  // This computations only need to happen once we are initialized because
-  // otherwise we're not going to output a point as stable
-  if (_initialized) {
-    _gazeDirectionAverage = ComputeEntireGazeDirectionAverage();
-    _numberOfInliers = FindInliers(_gazeDirectionAverage);
-    _gazeDirectionAverage = RecomputeGazeDirectionAverage();
-  }
-
-  _currentIndex++;
-}
-
-Point3f GazeDirection::ComputeEntireGazeDirectionAverage()
-{
-  return ComputeGazeDirectionAverage(false);
-}
-
-Point3f GazeDirection::ComputeGazeDirectionAverage(const bool filterOutliers)
-{
-  Point3f averageGazeDirection = Point3f(0.f, 0.f, 0.f);
-
-  // Find the average, these are Cartesian
-  // coordinates. However we only want to include
-  // those coordinates that intersected the ground plane.
-  u32 pointsInAverage = 0;
-  for (const auto& gazeDirection: _gazeDirectionHistory) {
-    if (gazeDirection.include) {
-      if (filterOutliers) {
-        if (gazeDirection.inlier) {
-          pointsInAverage++;
-          averageGazeDirection += gazeDirection.point;
-        }
-      } else {
-        pointsInAverage++;
-        averageGazeDirection += gazeDirection.point;
-      }
-    }
-  }
-
-  if (pointsInAverage != 0) {
-    averageGazeDirection *= 1.f/pointsInAverage;
-  } else {
-    averageGazeDirection = Point3f(GazeDirectionData::kDefaultDistance_mm,
-                                   GazeDirectionData::kDefaultDistance_mm,
-                                   GazeDirectionData::kDefaultDistance_mm);
+  const bool include = GetPointFromHeadPose(face.GetHeadPose(), gazeDirectionPoint);
+  _gazeDirectionHistory.Add(gazeDirectionPoint, include);
+
+  // This computations only need to happen once every element of the history
+  // holds a "real" value because otherwise we're not going to output a point
+  // as stable. Here inliners are determined using a l-1 distance.
+  if (_gazeDirectionHistory.IsFull()) {
+    _numberOfInliers = _gazeDirectionHistory.ComputeInlierAverage([](const Point3f& difference) {
+      return (std::abs(difference.x()) < kGazeDirectionInlierXThreshold_mm &&
+              std::abs(difference.y()) < kGazeDirectionInlierYThreshold_mm &&
+              std::abs(difference.z()) < kGazeDirectionInlierZThreshold_mm);
+    }, _gazeDirectionAverage);
   }
-  return averageGazeDirection;
-}
-
-int GazeDirection::FindInliers(const Point3f& gazeDirectionAverage)
-{
-  // Find the inliers given the average, and only include
-  // points that have intersected with the ground plane.
-  // Here inliners are determined using a l-1 distance.
-  int numberOfInliers = 0;
-  for (auto& gazeDirection: _gazeDirectionHistory) {
-
-    if (!gazeDirection.include) {
-      continue;
-    }
-                      
-    auto difference = gazeDirection.point - gazeDirectionAverage;
-    if (std::abs(difference.x()) < kGazeDirectionInlierXThreshold_mm &&
-        std::abs(difference.y()) < kGazeDirectionInlierYThreshold_mm &&
-        std::abs(difference.z()) < kGazeDirectionInlierZThreshold_mm) {
-      gazeDirection.inlier = true;
-      numberOfInliers++;
-    } else {
-      gazeDirection.inlier = false;
-    }
-  }
-  return numberOfInliers;
-}
-
-Point3f GazeDirection::RecomputeGazeDirectionAverage()
-{
-  return ComputeGazeDirectionAverage(true);
 }
 
 bool GazeDirection::GetExpired(const TimeStamp_t currentTime) const
@@ -180,7 +107,7 @@ bool GazeDirection::GetPointFromHeadPose(const Pose3d& headPose, Point3f& gazeDi
 
 bool GazeDirection::IsStable() const
 {
-  return ( (_numberOfInliers > kGazeDirectionMinNumberOfInliers) && _initialized );
+  return ( (_numberOfInliers > kGazeDirectionMinNumberOfInliers) && _gazeDirectionHistory.IsFull() );
 }
 
 Point3f GazeDirection::GetGazeDirectionAverage() const
@@ -190,19 +117,13 @@ Point3f GazeDirection::GetGazeDirectionAverage() const
 
 Point3f GazeDirection::GetCurrentGazeDirection() const
 {
-  return _gazeDirectionHistory[_currentIndex].point + Point3f(kGazeDirectionShiftOutputPointX_mm, 0.f, 0.f);
+  return _gazeDirectionHistory.GetNewest() + Point3f(kGazeDirectionShiftOutputPointX_mm, 0.f, 0.f);
 }
 
 void GazeDirection::ClearHistory()
 {
-  _initialized = false;
-  for (auto& gazeDirection: _gazeDirectionHistory) {
-      gazeDirection.point.x() = GazeDirectionData::kDefaultDistance_mm;
-      gazeDirection.point.y() = GazeDirectionData::kDefaultDistance_mm;
-      gazeDirection.point.z() = GazeDirectionData::kDefaultDistance_mm;
-      gazeDirection.inlier = false;
-      gazeDirection.include  = false;
-  }
+  _gazeDirectionHistory.Clear();
+  _numberOfInliers = 0;
 }
 
 } // namespace Vision
@@ -16,33 +16,12 @@
 #ifndef __Anki_CoreTech_Vision_GazeDirection_H__
 #define __Anki_CoreTech_Vision_GazeDirection_H__
 
+#include "coretech/vision/engine/gazeHistory.h"
 #include "coretech/vision/engine/trackedFace.h"
 
 namespace Anki {
 namespace Vision {
 
-struct GazeDirectionData
-{
-  constexpr static const float kDefaultDistance_mm = -100000.f;
-  Point3f point;
-  bool inlier;
-  bool include;
-
-  GazeDirectionData()
-    : point(kDefaultDistance_mm, kDefaultDistance_mm, kDefaultDistance_mm)
-      ,inlier(false)
-      ,include(false)
-      {
-      }
-
-  void Update(const Point3f& p, bool i)
-  {
-    point = p;
-    inlier = false;
-    include = i;
-  }
-};
-
 /***************************************************
  *                 GazeDirection                   *
  ***************************************************/
@@ -94,22 +73,16 @@ public:
 
   void ClearHistory();
 
-private:
-  int FindInliers(const Point3f& faceDirectionAverage);
-
-  bool GetPointFromHeadPose(const Pose3d& headPose, Point3f& faceDirectionPoint);
-  Point3f ComputeEntireGazeDirectionAverage();
-  Point3f ComputeGazeDirectionAverage(const bool filterOutliers);
-  Point3f RecomputeGazeDirectionAverage();
+  // Upper limit on the kGazeDirectionHistorySize console var
+  static constexpr size_t kMaxHistorySize = 16;
 
-  Pose3d _headPose;
+private:
+  static bool GetPointFromHeadPose(const Pose3d& headPose, Point3f& faceDirectionPoint);
 
   TimeStamp_t _lastUpdated = 0;
-  int _currentIndex = 0;
   int _numberOfInliers = 0;
-  bool _initialized = false;
 
-  std::vector<GazeDirectionData> _gazeDirectionHistory;
+  GazeHistory<Point3f, kMaxHistorySize> _gazeDirectionHistory;
   Point3f _gazeDirectionAverage;
 };
 
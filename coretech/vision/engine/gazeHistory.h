@@ -0,0 +1,121 @@
+/**
+ * File: gazeHistory.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Fixed-size ring of recent gaze samples for one face and the inlier-refined average EyeContact and
+ *              GazeDirection both filter them with: average everything, mark the samples close enough to that
+ *              average as inliers, then average just the inliers. The samples live in the object itself, so
+ *              keeping one per face allocates nothing after construction.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Vision_GazeHistory_H__
+#define __Anki_Vision_GazeHistory_H__
+
+#include "coretech/common/shared/types.h"
+
+#include <algorithm>
+#include <array>
+
+namespace Anki {
+namespace Vision {
+
+template<class PointType, size_t kMaxSize>
+class GazeHistory
+{
+public:
+
+  // Every slot starts out holding defaultPoint, which is excluded from averages unless includeDefault is set
+  GazeHistory(size_t size, const PointType& defaultPoint, bool includeDefault)
+  : _size(std::max<size_t>(1, std::min(size, kMaxSize)))
+  , _defaultPoint(defaultPoint)
+  , _includeDefault(includeDefault)
+  {
+    Clear();
+  }
+
+  // Overwrites the oldest sample. Samples added with include=false take up a slot but aren't averaged.
+  void Add(const PointType& point, bool include = true)
+  {
+    _newestIndex = (_newestIndex + 1) % _size;
+    _samples[_newestIndex] = Sample{point, include, false};
+    _numAdded = std::min(_numAdded + 1, _size);
+  }
+
+  // True once every slot holds a real sample instead of the default
+  bool IsFull() const { return (_numAdded == _size); }
+
+  const PointType& GetNewest() const { return _samples[_newestIndex].point; }
+
+  void Clear()
+  {
+    for(size_t i = 0; i < _size; ++i)
+    {
+      _samples[i] = Sample{_defaultPoint, _includeDefault, false};
+    }
+    _newestIndex = _size - 1;
+    _numAdded = 0;
+  }
+
+  // Sets average to the mean of the samples isInlier(sample - overallMean) accepts and returns how many there were.
+  // With no samples to average, average is the default point.
+  template<class IsInlierFcn>
+  s32 ComputeInlierAverage(IsInlierFcn isInlier, PointType& average)
+  {
+    average = ComputeAverage(false);
+    s32 numInliers = 0;
+    for(size_t i = 0; i < _size; ++i)
+    {
+      Sample& sample = _samples[i];
+      sample.inlier = (sample.include && isInlier(sample.point - average));
+      numInliers += (sample.inlier ? 1 : 0);
+    }
+    average = ComputeAverage(true);
+    return numInliers;
+  }
+
+private:
+
+  struct Sample
+  {
+    PointType point;
+    bool      include;
+    bool      inlier;
+  };
+
+  PointType ComputeAverage(bool inliersOnly) const
+  {
+    PointType sum(0.f);
+    u32 count = 0;
+    for(size_t i = 0; i < _size; ++i)
+    {
+      const Sample& sample = _samples[i];
+      if(sample.include && (!inliersOnly || sample.inlier))
+      {
+        sum += sample.point;
+        ++count;
+      }
+    }
+    if(0 == count)
+    {
+      return _defaultPoint;
+    }
+    sum *= 1.f/count;
+    return sum;
+  }
+
+  std::array<Sample, kMaxSize> _samples;
+  size_t                       _size;
+  size_t                       _newestIndex = 0;
+  size_t                       _numAdded = 0;
+  PointType                    _defaultPoint;
+  bool                         _includeDefault;
+};
+
+} // namespace Vision
+} // namespace Anki
+
+#endif // __Anki_Vision_GazeHistory_H__
@@ -137,6 +137,21 @@ Result ImageBrightnessHistogram::FillFromImage(const Image& img, const Image& we
   return RESULT_OK;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageBrightnessHistogram::Accumulate(const ImageBrightnessHistogram& other, TransformFcn transformFcn)
+{
+  for(s32 value=0; value<256; ++value)
+  {
+    const s32 count = other._counts[value];
+    if(count > 0)
+    {
+      const u8 bin = (transformFcn ? transformFcn((u8)value) : (u8)value);
+      _counts[bin] += count;
+    }
+  }
+  _totalCount += other._totalCount;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 u8 ImageBrightnessHistogram::ComputePercentile(const f32 p) const
 {
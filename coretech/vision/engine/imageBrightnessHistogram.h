@@ -46,6 +46,10 @@ namespace Vision {
     // weight image to effectively do simple masking. Image and Mask must be same size.
     Result FillFromImage(const Image& img, const Image& weights, s32 subSample=1, TransformFcn transformFcn = {});
     
+    // Add another histogram's counts to this one, moving each of its bins through transformFcn if given.
+    // Same result as filling from the image the other histogram was filled from, with that transformFcn.
+    void Accumulate(const ImageBrightnessHistogram& other, TransformFcn transformFcn = {});
+    
     s32 GetTotalCount() const { return _totalCount; }
     
     const std::array<s32,256>& GetCounts() const { return _counts; }
@@ -0,0 +1,228 @@
+/**
+ * File: boxDownsample.cpp
+ *
+ * Author:  Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: 2x and 4x box filter downsampling of gray and RGB images, used by ImageCache to
+ *              build smaller ImageCacheSizes from an already-computed larger one
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
+
+#include "coretech/vision/engine/image_impl.h"
+#include "coretech/vision/engine/neonMacros.h"
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+namespace Anki {
+namespace Vision {
+namespace ImageConversions {
+
+namespace {
+
+// Scalar box filter over factor x factor blocks of a channels-interleaved row-major image.
+// Used directly when NEON is not available and for the columns left over after the NEON loops.
+inline void BoxDownsampleRowScalar(const u8* const* inRows, s32 factor, s32 numChannels,
+                                   s32 outColStart, s32 outNumCols, u8* outRow)
+{
+  const s32 kRound = (factor*factor)/2;
+  const s32 kShift = (factor == 2 ? 2 : 4);
+  for(s32 j = outColStart; j < outNumCols; ++j)
+  {
+    for(s32 c = 0; c < numChannels; ++c)
+    {
+      s32 sum = kRound;
+      for(s32 r = 0; r < factor; ++r)
+      {
+        const u8* in = inRows[r] + (j*factor*numChannels) + c;
+        for(s32 k = 0; k < factor; ++k)
+        {
+          sum += in[k*numChannels];
+        }
+      }
+      outRow[j*numChannels + c] = static_cast<u8>(sum >> kShift);
+    }
+  }
+}
+
+#ifdef __ARM_NEON__
+
+// Sums 2x2 blocks of 16 pixels from two rows and returns the 8 rounded averages
+inline uint8x8_t Box2x(uint8x16_t row1, uint8x16_t row2)
+{
+  const uint16x8_t sum = vaddq_u16(vpaddlq_u8(row1), vpaddlq_u8(row2));
+  return vrshrn_n_u16(sum, 2);
+}
+
+// Sums 4x4 blocks of 32 pixels (as two sets of 16) from four rows and returns the 8 rounded averages
+inline uint8x8_t Box4x(const uint8x16_t* rowsA, const uint8x16_t* rowsB)
+{
+  // Horizontal pairs, summed down the four rows
+  uint16x8_t sumA = vpaddlq_u8(rowsA[0]);
+  uint16x8_t sumB = vpaddlq_u8(rowsB[0]);
+  for(s32 r = 1; r < 4; ++r)
+  {
+    sumA = vpadalq_u8(sumA, rowsA[r]);
+    sumB = vpadalq_u8(sumB, rowsB[r]);
+  }
+
+  // Add adjacent pairs again to get the sum over each 4x4 block (max 16*255, fits in u16)
+  const uint16x8_t sum = vcombine_u16(vpadd_u16(vget_low_u16(sumA), vget_high_u16(sumA)),
+                                      vpadd_u16(vget_low_u16(sumB), vget_high_u16(sumB)));
+  return vrshrn_n_u16(sum, 4);
+}
+
+#endif
+
+template<class ImageType>
+inline void AllocateOutput(const ImageType& in, s32 factor, ImageType& out)
+{
+  DEV_ASSERT(in.GetDataPointer() != out.GetDataPointer(), "ImageConversions.BoxDownsample.InPlaceNotSupported");
+
+  // Reuses out's existing memory if it is already the right size
+  out.Allocate(in.GetNumRows()/factor, in.GetNumCols()/factor);
+  out.SetTimestamp(in.GetTimestamp());
+  out.SetImageId(in.GetImageId());
+}
+
+}
+
+void BoxDownsample2x(const Image& in, Image& out)
+{
+  AllocateOutput(in, 2, out);
+
+  const s32 outNumCols = out.GetNumCols();
+  for(s32 i = 0; i < out.GetNumRows(); ++i)
+  {
+    const u8* inRows[2] = {in.GetRow(2*i), in.GetRow(2*i + 1)};
+    u8* outRow = out.GetRow(i);
+
+    s32 j = 0;
+#ifdef __ARM_NEON__
+    // 16 input pixels per row -> 8 output pixels
+    const s32 kNumOutputsPerIter = 8;
+    for(; j <= outNumCols - kNumOutputsPerIter; j += kNumOutputsPerIter)
+    {
+      const uint8x16_t row1 = vld1q_u8(inRows[0] + 2*j);
+      const uint8x16_t row2 = vld1q_u8(inRows[1] + 2*j);
+      vst1_u8(outRow + j, Box2x(row1, row2));
+    }
+#endif
+
+    BoxDownsampleRowScalar(inRows, 2, 1, j, outNumCols, outRow);
+  }
+}
+
+void BoxDownsample2x(const ImageRGB& in, ImageRGB& out)
+{
+  AllocateOutput(in, 2, out);
+
+  const s32 outNumCols = out.GetNumCols();
+  for(s32 i = 0; i < out.GetNumRows(); ++i)
+  {
+    const u8* inRows[2] = {reinterpret_cast<const u8*>(in.GetRow(2*i)),
+                           reinterpret_cast<const u8*>(in.GetRow(2*i + 1))};
+    u8* outRow = reinterpret_cast<u8*>(out.GetRow(i));
+
+    s32 j = 0;
+#ifdef __ARM_NEON__
+    // 16 input RGB pixels per row, deinterleaved into channels -> 8 output RGB pixels
+    const s32 kNumOutputsPerIter = 8;
+    for(; j <= outNumCols - kNumOutputsPerIter; j += kNumOutputsPerIter)
+    {
+      const uint8x16x3_t row1 = vld3q_u8(inRows[0] + 2*j*3);
+      const uint8x16x3_t row2 = vld3q_u8(inRows[1] + 2*j*3);
+
+      uint8x8x3_t result;
+      result.val[0] = Box2x(row1.val[0], row2.val[0]);
+      result.val[1] = Box2x(row1.val[1], row2.val[1]);
+      result.val[2] = Box2x(row1.val[2], row2.val[2]);
+      vst3_u8(outRow + j*3, result);
+    }
+#endif
+
+    BoxDownsampleRowScalar(inRows, 2, 3, j, outNumCols, outRow);
+  }
+}
+
+void BoxDownsample4x(const Image& in, Image& out)
+{
+  AllocateOutput(in, 4, out);
+
+  const s32 outNumCols = out.GetNumCols();
+  for(s32 i = 0; i < out.GetNumRows(); ++i)
+  {
+    const u8* inRows[4] = {in.GetRow(4*i),     in.GetRow(4*i + 1),
+                           in.GetRow(4*i + 2), in.GetRow(4*i + 3)};
+    u8* outRow = out.GetRow(i);
+
+    s32 j = 0;
+#ifdef __ARM_NEON__
+    // 32 input pixels per row -> 8 output pixels
+    const s32 kNumOutputsPerIter = 8;
+    for(; j <= outNumCols - kNumOutputsPerIter; j += kNumOutputsPerIter)
+    {
+      uint8x16_t rowsA[4], rowsB[4];
+      for(s32 r = 0; r < 4; ++r)
+      {
+        rowsA[r] = vld1q_u8(inRows[r] + 4*j);
+        rowsB[r] = vld1q_u8(inRows[r] + 4*j + 16);
+      }
+      vst1_u8(outRow + j, Box4x(rowsA, rowsB));
+    }
+#endif
+
+    BoxDownsampleRowScalar(inRows, 4, 1, j, outNumCols, outRow);
+  }
+}
+
+void BoxDownsample4x(const ImageRGB& in, ImageRGB& out)
+{
+  AllocateOutput(in, 4, out);
+
+  const s32 outNumCols = out.GetNumCols();
+  for(s32 i = 0; i < out.GetNumRows(); ++i)
+  {
+    const u8* inRows[4] = {reinterpret_cast<const u8*>(in.GetRow(4*i)),
+                           reinterpret_cast<const u8*>(in.GetRow(4*i + 1)),
+                           reinterpret_cast<const u8*>(in.GetRow(4*i + 2)),
+                           reinterpret_cast<const u8*>(in.GetRow(4*i + 3))};
+    u8* outRow = reinterpret_cast<u8*>(out.GetRow(i));
+
+    s32 j = 0;
+#ifdef __ARM_NEON__
+    // 32 input RGB pixels per row, deinterleaved into channels -> 8 output RGB pixels
+    const s32 kNumOutputsPerIter = 8;
+    for(; j <= outNumCols - kNumOutputsPerIter; j += kNumOutputsPerIter)
+    {
+      uint8x16x3_t rowsA[4], rowsB[4];
+      for(s32 r = 0; r < 4; ++r)
+      {
+        rowsA[r] = vld3q_u8(inRows[r] + 4*j*3);
+        rowsB[r] = vld3q_u8(inRows[r] + (4*j + 16)*3);
+      }
+
+      uint8x8x3_t result;
+      for(s32 c = 0; c < 3; ++c)
+      {
+        const uint8x16_t channelA[4] = {rowsA[0].val[c], rowsA[1].val[c], rowsA[2].val[c], rowsA[3].val[c]};
+        const uint8x16_t channelB[4] = {rowsB[0].val[c], rowsB[1].val[c], rowsB[2].val[c], rowsB[3].val[c]};
+        result.val[c] = Box4x(channelA, channelB);
+      }
+      vst3_u8(outRow + j*3, result);
+    }
+#endif
+
+    BoxDownsampleRowScalar(inRows, 4, 3, j, outNumCols, outRow);
+  }
+}
+
+}
+}
+}
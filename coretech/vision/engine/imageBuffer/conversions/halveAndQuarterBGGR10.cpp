@@ -0,0 +1,182 @@
+/**
+ * File: halveAndQuarterBGGR10.cpp
+ *
+ * Author:  Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: BGGR10 bayer to any of half sized Gray, half sized RGB and quarter sized RGB
+ *              in a single pass over the bayer data
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
+
+#include "coretech/vision/engine/image_impl.h"
+#include "coretech/vision/engine/neonMacros.h"
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+namespace Anki {
+namespace Vision {
+namespace ImageConversions {
+
+namespace {
+
+// Which output channels the two non-green pixels of each 2x2 bayer block go to. This matches
+// bayer_mipi_bggr10_downsample (used by HalveBGGR10ToRGB), whose NEON and C implementations
+// differ, so that the fused outputs are identical to the individual conversions on each platform.
+#ifdef __ARM_NEON__
+  constexpr s32 kRow1EvenChannel = 0;
+  constexpr s32 kRow2OddChannel  = 2;
+#else
+  constexpr s32 kRow1EvenChannel = 2;
+  constexpr s32 kRow2OddChannel  = 0;
+#endif
+
+// Returns pixel k (0-3) of a 5 byte packed group of 4 10 bit pixels, as clipped 8 bit data
+inline s32 GetPixel(const u8* group, s32 k)
+{
+#ifdef __ARM_NEON__
+  // Consistent with the NEON conversions which ignore the packed low bits
+  return (static_cast<s32>(group[k]) << 2);
+#else
+  return (static_cast<s32>(group[k]) << 2) | ((group[4] >> (6 - 2*k)) & 0x03);
+#endif
+}
+
+inline u8 Clip(s32 value)
+{
+  return static_cast<u8>(value > 255 ? 255 : value);
+}
+
+#ifdef __ARM_NEON__
+// Loads 10 bytes of bayer data (8 pixels) and returns the 8 high bytes, skipping the packed low bits
+inline uint8x8_t LoadHighBytes(const u8* bayer)
+{
+  const uint8x8_t first  = vld1_u8(bayer);
+  const uint8x8_t second = vld1_u8(bayer + 5);
+  return vext_u8(vreinterpret_u8_u64(vshl_n_u64(vreinterpret_u64_u8(first), 32)), second, 4);
+}
+#endif
+
+// Converts one pair of bayer rows to one row of half sized RGB and/or Gray (either may be null)
+void HalveRowPair(const u8* bayer1, const u8* bayer2, s32 bayerCols, u8* rgbRow, u8* grayRow)
+{
+  s32 j = 0;
+  s32 outCol = 0;
+
+#ifdef __ARM_NEON__
+  // 20 bytes (16 pixels) from each row make 8 output pixels. The loads read 3 bytes past the
+  // 20, so stop early and leave the last chunk of the row to the loop below.
+  const s32 kNumBytesProcessed = 20;
+  for(; j + kNumBytesProcessed < bayerCols; j += kNumBytesProcessed, outCol += 8)
+  {
+    // Unzip into even and odd pixels of each row
+    const uint8x8x2_t row1 = vuzp_u8(LoadHighBytes(bayer1 + j), LoadHighBytes(bayer1 + j + 10));
+    const uint8x8x2_t row2 = vuzp_u8(LoadHighBytes(bayer2 + j), LoadHighBytes(bayer2 + j + 10));
+
+    // Halving add the two greens, then saturating left shift by 2 as if the low bits were all 0
+    const uint8x8_t green = vqshl_n_u8(vhadd_u8(row1.val[1], row2.val[0]), 2);
+
+    if(nullptr != rgbRow)
+    {
+      uint8x8x3_t rgb;
+      rgb.val[kRow1EvenChannel] = vqshl_n_u8(row1.val[0], 2);
+      rgb.val[1]                = green;
+      rgb.val[kRow2OddChannel]  = vqshl_n_u8(row2.val[1], 2);
+      vst3_u8(rgbRow + outCol*3, rgb);
+    }
+
+    if(nullptr != grayRow)
+    {
+      vst1_u8(grayRow + outCol, green);
+    }
+  }
+#endif
+
+  // Each 5 bytes of each row (4 pixels) make 2 output pixels
+  for(; j < bayerCols; j += 5)
+  {
+    for(s32 k = 0; k < 4; k += 2, ++outCol)
+    {
+      const u8 green = Clip((GetPixel(bayer1 + j, k+1) + GetPixel(bayer2 + j, k)) >> 1);
+
+      if(nullptr != rgbRow)
+      {
+        u8* rgb = rgbRow + outCol*3;
+        rgb[kRow1EvenChannel] = Clip(GetPixel(bayer1 + j, k));
+        rgb[1]                = green;
+        rgb[kRow2OddChannel]  = Clip(GetPixel(bayer2 + j, k+1));
+      }
+
+      if(nullptr != grayRow)
+      {
+        grayRow[outCol] = green;
+      }
+    }
+  }
+}
+
+}
+
+void HalveAndQuarterBGGR10(const u8* bayer, s32 rows, s32 cols,
+                           Image* halfGray, ImageRGB* halfRGB, ImageRGB* quarterRGB)
+{
+  const s32 halfRows = rows/2;
+  const s32 halfCols = cols/2;
+
+  if(nullptr != halfGray)
+  {
+    halfGray->Allocate(halfRows, halfCols);
+  }
+
+  if(nullptr != halfRGB)
+  {
+    halfRGB->Allocate(halfRows, halfCols);
+  }
+
+  // Quarter RGB is averaged from each pair of half RGB rows as soon as they are computed, while they are still
+  // in cache. If half RGB was not requested, those rows go into a small scratch buffer instead.
+  ImageRGB scratchRows;
+  if(nullptr != quarterRGB)
+  {
+    quarterRGB->Allocate(halfRows/2, halfCols/2);
+    if(nullptr == halfRGB)
+    {
+      scratchRows.Allocate(2, halfCols);
+    }
+  }
+
+  // Raw Bayer format from camera is 4 10 bit pixels packed into 5 bytes
+  // so convert cols to bayer cols
+  const s32 bayerCols = (cols*5)/4;
+
+  for(s32 i = 0; i < halfRows; ++i)
+  {
+    const u8* bayer1 = bayer + (2*i)*bayerCols;
+    const u8* bayer2 = bayer1 + bayerCols;
+
+    ImageRGB* rgbOut = (nullptr != halfRGB ? halfRGB : (nullptr != quarterRGB ? &scratchRows : nullptr));
+    const s32 rgbRowIndex = (rgbOut == &scratchRows ? (i % 2) : i);
+    u8* rgbRow  = (nullptr != rgbOut   ? reinterpret_cast<u8*>(rgbOut->GetRow(rgbRowIndex)) : nullptr);
+    u8* grayRow = (nullptr != halfGray ? halfGray->GetRow(i) : nullptr);
+
+    HalveRowPair(bayer1, bayer2, bayerCols, rgbRow, grayRow);
+
+    if((nullptr != quarterRGB) && (i % 2 == 1) && (i/2 < quarterRGB->GetNumRows()))
+    {
+      // Wrap the two half rows (contiguous, since they were just allocated) and the quarter row, and box filter
+      ImageRGB twoRows(2, halfCols, reinterpret_cast<u8*>(rgbOut->GetRow(rgbRowIndex - 1)));
+      ImageRGB quarterRow(1, quarterRGB->GetNumCols(), reinterpret_cast<u8*>(quarterRGB->GetRow(i/2)));
+      BoxDownsample2x(twoRows, quarterRow);
+    }
+  }
+}
+
+}
+}
+}
@@ -0,0 +1,163 @@
+/**
+ * File: halveYUV420sp.cpp
+ *
+ * Author:  Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: YUV420sp to half sized RGB and/or Gray in a single pass, converting each 2x2 block of luma
+ *              with the chroma sample it shares instead of converting every full resolution pixel
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
+
+#include "coretech/vision/engine/image_impl.h"
+#include "coretech/vision/engine/neonMacros.h"
+
+#include <algorithm>
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+namespace Anki {
+namespace Vision {
+namespace ImageConversions {
+
+namespace {
+
+// Same fixed point BT.601 coefficients as the scalar part of ConvertYUV420spToRGB
+constexpr s32 ITUR_BT_601_CY    = 1220542;
+constexpr s32 ITUR_BT_601_CUB   = 2116026;
+constexpr s32 ITUR_BT_601_CUG   = -409993;
+constexpr s32 ITUR_BT_601_CVG   = -852492;
+constexpr s32 ITUR_BT_601_CVR   = 1673527;
+constexpr s32 ITUR_BT_601_SHIFT = 20;
+constexpr s32 kRound            = (1 << (ITUR_BT_601_SHIFT - 1));
+
+inline u8 Saturate(s32 value)
+{
+  return static_cast<u8>(value < 0 ? 0 : (value > 255 ? 255 : value));
+}
+
+#ifdef __ARM_NEON__
+// (y + c + kRound) >> SHIFT for 8 values, saturated to u8
+inline uint8x8_t CombineAndNarrow(const int32x4_t y[2], const int32x4_t c[2])
+{
+  const int32x4_t kRoundVec = vdupq_n_s32(kRound);
+  const int32x4_t lo = vshrq_n_s32(vaddq_s32(vaddq_s32(y[0], c[0]), kRoundVec), ITUR_BT_601_SHIFT);
+  const int32x4_t hi = vshrq_n_s32(vaddq_s32(vaddq_s32(y[1], c[1]), kRoundVec), ITUR_BT_601_SHIFT);
+  return vqmovn_u16(vcombine_u16(vqmovun_s32(lo), vqmovun_s32(hi)));
+}
+
+inline void Widen(const int16x8_t in, int32x4_t out[2])
+{
+  out[0] = vmovl_s16(vget_low_s16(in));
+  out[1] = vmovl_s16(vget_high_s16(in));
+}
+#endif
+
+}
+
+void HalveYUV420sp(const u8* yuv, s32 rows, s32 cols, Image* halfGray, ImageRGB* halfRGB)
+{
+  // Expecting even number of rows and colums for 2x2 subsampled YUV data
+  DEV_ASSERT((rows % 2 == 0) && (cols % 2 == 0),
+             "Vision.HalveYUV420sp.OddNumRowsOrCols");
+
+  const s32 outRows = rows / 2;
+  const s32 outCols = cols / 2;
+  if(nullptr != halfGray)
+  {
+    halfGray->Allocate(outRows, outCols);
+  }
+  if(nullptr != halfRGB)
+  {
+    halfRGB->Allocate(outRows, outCols);
+  }
+
+  const u8* uvPlane = yuv + (rows*cols);
+
+  for(s32 i = 0; i < outRows; ++i)
+  {
+    const u8* yPtr  = yuv + (2*i)*cols;
+    const u8* y2Ptr = yPtr + cols;
+    const u8* uvPtr = uvPlane + i*cols;
+    u8* rgbRow  = (nullptr != halfRGB  ? reinterpret_cast<u8*>(halfRGB->GetRow(i)) : nullptr);
+    u8* grayRow = (nullptr != halfGray ? halfGray->GetRow(i) : nullptr);
+
+    s32 j = 0;
+
+#ifdef __ARM_NEON__
+    const uint8x8_t k128 = vdup_n_u8(128);
+    const uint16x8_t k16 = vdupq_n_u16(16);
+
+    // 16 luma from each row and 8 UV pairs make 8 output pixels
+    for(; j <= outCols - 8; j += 8)
+    {
+      // Average each 2x2 block of luma, rounded, then subtract 16 (saturating at 0 like the scalar max())
+      const uint16x8_t sum = vaddq_u16(vpaddlq_u8(vld1q_u8(yPtr + 2*j)), vpaddlq_u8(vld1q_u8(y2Ptr + 2*j)));
+      const uint16x8_t yAvg = vqsubq_u16(vrshrq_n_u16(sum, 2), k16);
+      int32x4_t y[2];
+      Widen(vreinterpretq_s16_u16(yAvg), y);
+      y[0] = vmulq_n_s32(y[0], ITUR_BT_601_CY);
+      y[1] = vmulq_n_s32(y[1], ITUR_BT_601_CY);
+
+      // Same subtraction trick as ConvertYUV420spToRGB: U - 128 underflows into a valid s16
+      const uint8x8x2_t uv = vld2_u8(uvPtr + 2*j);
+      int32x4_t u[2], v[2];
+      Widen(vreinterpretq_s16_u16(vsubl_u8(uv.val[0], k128)), u);
+      Widen(vreinterpretq_s16_u16(vsubl_u8(uv.val[1], k128)), v);
+
+      const int32x4_t guv[2] = {
+        vmlaq_n_s32(vmulq_n_s32(v[0], ITUR_BT_601_CVG), u[0], ITUR_BT_601_CUG),
+        vmlaq_n_s32(vmulq_n_s32(v[1], ITUR_BT_601_CVG), u[1], ITUR_BT_601_CUG),
+      };
+      const uint8x8_t g = CombineAndNarrow(y, guv);
+
+      if(nullptr != grayRow)
+      {
+        vst1_u8(grayRow + j, g);
+      }
+
+      if(nullptr != rgbRow)
+      {
+        const int32x4_t ruv[2] = {vmulq_n_s32(v[0], ITUR_BT_601_CVR), vmulq_n_s32(v[1], ITUR_BT_601_CVR)};
+        const int32x4_t buv[2] = {vmulq_n_s32(u[0], ITUR_BT_601_CUB), vmulq_n_s32(u[1], ITUR_BT_601_CUB)};
+        uint8x8x3_t rgb;
+        rgb.val[0] = CombineAndNarrow(y, ruv);
+        rgb.val[1] = g;
+        rgb.val[2] = CombineAndNarrow(y, buv);
+        vst3_u8(rgbRow + 3*j, rgb);
+      }
+    }
+#endif
+
+    for(; j < outCols; ++j)
+    {
+      const s32 sum = (s32)yPtr[2*j] + (s32)yPtr[2*j+1] + (s32)y2Ptr[2*j] + (s32)y2Ptr[2*j+1];
+      const s32 yVal = std::max(0, ((sum + 2) >> 2) - 16) * ITUR_BT_601_CY;
+      const s32 u = (s32)(uvPtr[2*j])   - 128;
+      const s32 v = (s32)(uvPtr[2*j+1]) - 128;
+
+      const u8 g = Saturate((yVal + kRound + ITUR_BT_601_CVG * v + ITUR_BT_601_CUG * u) >> ITUR_BT_601_SHIFT);
+      if(nullptr != grayRow)
+      {
+        grayRow[j] = g;
+      }
+
+      if(nullptr != rgbRow)
+      {
+        rgbRow[3*j]   = Saturate((yVal + kRound + ITUR_BT_601_CVR * v) >> ITUR_BT_601_SHIFT);
+        rgbRow[3*j+1] = g;
+        rgbRow[3*j+2] = Saturate((yVal + kRound + ITUR_BT_601_CUB * u) >> ITUR_BT_601_SHIFT);
+      }
+    }
+  }
+}
+
+}
+}
+}
@@ -15,12 +15,16 @@
 #define __Anki_Coretech_Vision_Engine_ImageConversions_H__
 
 #include "coretech/common/shared/types.h"
+#include "coretech/common/shared/math/matrix.h"
+
+#include <array>
 
 namespace Anki {
 namespace Vision {
 
 class Image;
 class ImageRGB;
+class ImageRGB565;
 
 namespace ImageConversions {
 
@@ -30,6 +34,14 @@ namespace ImageConversions {
   void ConvertYUV420spToRGB(const u8* yuv, s32 rows, s32 cols,
                             ImageRGB& rgb);
 
+  // Converts YUV420sp formatted data of an image of size rows x cols to half sized RGB and/or Gray
+  // (null outputs are skipped). Each output pixel is the average of a 2x2 block of luma converted with
+  // the chroma sample that block shares, so there is no full resolution conversion. Gray is the green
+  // channel, as GetGray from the full sized RGB would give.
+  // NEON optimized
+  void HalveYUV420sp(const u8* yuv, s32 rows, s32 cols,
+                     Image* halfGray, ImageRGB* halfRGB);
+
   // Converts a Bayer BGGR 10bit image to RGB
   // Halves so output is half the resolution of the bayer image
   void HalveBGGR10ToRGB(const u8* bayer, s32 rows, s32 cols,
@@ -49,6 +61,39 @@ namespace ImageConversions {
   // Output image is quarter the size of the bayer image
   void QuarterBGGR10ToRGB(const u8* bayer, s32 rows, s32 cols,
                          ImageRGB& rgb);
+
+  // Converts a Bayer BGGR 10bit image to any combination of half sized Gray, half sized RGB and
+  // quarter sized RGB in a single pass over the bayer data. Outputs which are null are skipped.
+  // Gray is the averaged green, as in the half RGB output, and quarter RGB is the average of each
+  // 2x2 block of half RGB pixels.
+  // NEON optimized
+  void HalveAndQuarterBGGR10(const u8* bayer, s32 rows, s32 cols,
+                             Image* halfGray, ImageRGB* halfRGB, ImageRGB* quarterRGB);
+
+  // Averages each 2x2 (or 4x4) block of the input image into one output pixel
+  // Equivalent to ResizeMethod::AverageArea (and Linear, at exactly half size)
+  // Output memory is reused if it is already the correct size. In-place is not supported.
+  // NEON optimized
+  void BoxDownsample2x(const Image& in, Image& out);
+  void BoxDownsample2x(const ImageRGB& in, ImageRGB& out);
+  void BoxDownsample4x(const Image& in, Image& out);
+  void BoxDownsample4x(const ImageRGB& in, ImageRGB& out);
+
+  // Resamples in through the homography H, which maps each output pixel's (x,y,1) to homogeneous coordinates
+  // in the input image (i.e. an inverse map, as with cv::WARP_INVERSE_MAP), using bilinear interpolation.
+  // Output pixels which sample outside the input image, or from behind the projection, are black.
+  // Output memory is reused if it is already outNumRows x outNumCols. In-place is not supported.
+  // NEON optimized
+  void WarpPerspectiveBilinear(const ImageRGB& in, const Matrix_3x3f& H, s32 outNumRows, s32 outNumCols,
+                               ImageRGB& out);
+
+  // Nearest neighbor resizes in to out's size, mirrored left to right, and packs it as RGB565 after passing each
+  // channel through gammaLUT, in one pass (equivalent to Resize, cv::flip and ImageRGB565::SetFromImageRGB).
+  // If swapRedBlue, red and blue trade places, as for displays which expect BGR565.
+  // out must already be allocated to the display size.
+  // NEON optimized
+  void ResizeMirroredToRGB565(const ImageRGB& in, const std::array<u8,256>& gammaLUT, bool swapRedBlue,
+                              ImageRGB565& out);
 }
 }
 }
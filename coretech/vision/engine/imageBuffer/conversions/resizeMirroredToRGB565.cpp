@@ -0,0 +1,106 @@
+/**
+ * File: resizeMirroredToRGB565.cpp
+ *
+ * Author:  Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Nearest neighbor resize, horizontal mirror, gamma and RGB565 packing of an RGB image in one
+ *              pass, used to put the camera feed on the face in mirror mode
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
+
+#include "coretech/vision/engine/image_impl.h"
+#include "coretech/vision/engine/neonMacros.h"
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+#include <vector>
+
+namespace Anki {
+namespace Vision {
+namespace ImageConversions {
+
+namespace {
+
+inline u16 PackRGB565(u8 r, u8 g, u8 b)
+{
+  // Same packing as PixelRGB565::SetValue
+  return (u16(0xF8 & r) << 8) | (u16(0xFC & g) << 3) | (u16(0xF8 & b) >> 3);
+}
+
+}
+
+void ResizeMirroredToRGB565(const ImageRGB& in, const std::array<u8,256>& gammaLUT, bool swapRedBlue,
+                            ImageRGB565& out)
+{
+  DEV_ASSERT(!in.IsEmpty() && !out.IsEmpty(), "ImageConversions.ResizeMirroredToRGB565.EmptyImage");
+
+  const s32 inNumRows  = in.GetNumRows();
+  const s32 inNumCols  = in.GetNumCols();
+  const s32 outNumRows = out.GetNumRows();
+  const s32 outNumCols = out.GetNumCols();
+
+  // Byte offset within an input row of the pixel each output column samples, mirrored so that the
+  // last output column samples the first input column
+  std::vector<s32> srcOffsets(outNumCols);
+  for(s32 j = 0; j < outNumCols; ++j)
+  {
+    srcOffsets[j] = 3 * (((outNumCols - 1 - j) * inNumCols) / outNumCols);
+  }
+
+  // One row of gamma corrected channels, gathered so they can be packed several pixels at a time
+  std::vector<u8> channels(3 * outNumCols);
+  u8* const red   = channels.data();
+  u8* const green = red + outNumCols;
+  u8* const blue  = green + outNumCols;
+
+  // The display's red is in the high bits, so swapping means packing blue there instead
+  const s32 kRedIndex  = (swapRedBlue ? 2 : 0);
+  const s32 kBlueIndex = (swapRedBlue ? 0 : 2);
+
+  for(s32 i = 0; i < outNumRows; ++i)
+  {
+    const u8* inRow = reinterpret_cast<const u8*>(in.GetRow((i * inNumRows) / outNumRows));
+    u16* outRow = reinterpret_cast<u16*>(out.GetRow(i));
+
+    for(s32 j = 0; j < outNumCols; ++j)
+    {
+      const u8* pixel = inRow + srcOffsets[j];
+      red[j]   = gammaLUT[pixel[kRedIndex]];
+      green[j] = gammaLUT[pixel[1]];
+      blue[j]  = gammaLUT[pixel[kBlueIndex]];
+    }
+
+    s32 j = 0;
+#ifdef __ARM_NEON__
+    // Widen each channel into the high byte and shift-insert the next one below it, which keeps the
+    // top 5/6/5 bits of each
+    const s32 kNumPixelsPerIter = 8;
+    for(; j <= outNumCols - kNumPixelsPerIter; j += kNumPixelsPerIter)
+    {
+      uint16x8_t packed = vshll_n_u8(vld1_u8(red + j), 8);
+      packed = vsriq_n_u16(packed, vshll_n_u8(vld1_u8(green + j), 8), 5);
+      packed = vsriq_n_u16(packed, vshll_n_u8(vld1_u8(blue + j), 8), 11);
+      vst1q_u16(outRow + j, packed);
+    }
+#endif
+
+    for(; j < outNumCols; ++j)
+    {
+      outRow[j] = PackRGB565(red[j], green[j], blue[j]);
+    }
+  }
+
+  out.SetTimestamp(in.GetTimestamp());
+  out.SetImageId(in.GetImageId());
+}
+
+}
+}
+}
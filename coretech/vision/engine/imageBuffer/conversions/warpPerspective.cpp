@@ -0,0 +1,201 @@
+/**
+ * File: warpPerspective.cpp
+ *
+ * Author:  Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Bilinear perspective warp of RGB images through an inverse homography, used by ImageCache to
+ *              share e.g. the overhead ground plane image between the vision modes that want it
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
+
+#include "coretech/vision/engine/image_impl.h"
+#include "coretech/vision/engine/neonMacros.h"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+namespace Anki {
+namespace Vision {
+namespace ImageConversions {
+
+namespace {
+
+// Bilinear weights are in 1/256ths, so a weighted sum of four pixels fits comfortably in 32 bits
+const s32 kWeightBits = 8;
+const f32 kWeightScale = static_cast<f32>(1 << kWeightBits);
+
+// Projections this close to (or behind) the camera plane are treated as outside the image
+const f32 kMinW = 1e-6f;
+
+// Top-left source pixel and the weights of its right and lower neighbours, for one output pixel
+struct Sample
+{
+  s32 x0, y0;
+  s32 wx, wy;
+};
+
+inline void BlendSample(const u8* const* inRows, const Sample& sample, u8* outPixel)
+{
+  const u8* p00 = inRows[sample.y0]   + 3*sample.x0;
+  const u8* p10 = inRows[sample.y0+1] + 3*sample.x0;
+  const s32 wx = sample.wx;
+  const s32 wy = sample.wy;
+  const s32 w00 = ((1<<kWeightBits) - wx) * ((1<<kWeightBits) - wy);
+  const s32 w01 = wx * ((1<<kWeightBits) - wy);
+  const s32 w10 = ((1<<kWeightBits) - wx) * wy;
+  const s32 w11 = wx * wy;
+  const s32 kRound = 1 << (2*kWeightBits - 1);
+  for(s32 c = 0; c < 3; ++c)
+  {
+    const s32 sum = p00[c]*w00 + p00[c+3]*w01 + p10[c]*w10 + p10[c+3]*w11 + kRound;
+    outPixel[c] = static_cast<u8>(sum >> (2*kWeightBits));
+  }
+}
+
+// Scalar projection and blend of output pixels [jStart, outNumCols) in output row i.
+// Used directly when NEON is not available and for the columns left over after the NEON loop.
+inline void WarpRowScalar(const u8* const* inRows, s32 inNumRows, s32 inNumCols, const Matrix_3x3f& H,
+                          s32 i, s32 jStart, s32 outNumCols, u8* outRow)
+{
+  const f32 maxX = static_cast<f32>(inNumCols - 1);
+  const f32 maxY = static_cast<f32>(inNumRows - 1);
+  for(s32 j = jStart; j < outNumCols; ++j)
+  {
+    u8* outPixel = outRow + 3*j;
+    const f32 W = H(2,0)*j + H(2,1)*i + H(2,2);
+    if(W <= kMinW)
+    {
+      outPixel[0] = outPixel[1] = outPixel[2] = 0;
+      continue;
+    }
+    const f32 invW = 1.f / W;
+    const f32 x = (H(0,0)*j + H(0,1)*i + H(0,2)) * invW;
+    const f32 y = (H(1,0)*j + H(1,1)*i + H(1,2)) * invW;
+    if(x < 0.f || y < 0.f || x > maxX || y > maxY)
+    {
+      outPixel[0] = outPixel[1] = outPixel[2] = 0;
+      continue;
+    }
+
+    // x and y are non-negative here, so truncation is floor. Clamping keeps the right/lower neighbours in
+    // the image when sampling exactly on its last column/row.
+    Sample sample;
+    sample.x0 = std::min(static_cast<s32>(x), inNumCols - 2);
+    sample.y0 = std::min(static_cast<s32>(y), inNumRows - 2);
+    sample.wx = static_cast<s32>((x - static_cast<f32>(sample.x0)) * kWeightScale + 0.5f);
+    sample.wy = static_cast<s32>((y - static_cast<f32>(sample.y0)) * kWeightScale + 0.5f);
+    BlendSample(inRows, sample, outPixel);
+  }
+}
+
+}
+
+void WarpPerspectiveBilinear(const ImageRGB& in, const Matrix_3x3f& H, s32 outNumRows, s32 outNumCols,
+                             ImageRGB& out)
+{
+  DEV_ASSERT(in.GetDataPointer() != out.GetDataPointer(), "ImageConversions.WarpPerspectiveBilinear.InPlaceNotSupported");
+
+  // Reuses out's existing memory if it is already the right size
+  out.Allocate(outNumRows, outNumCols);
+  out.SetTimestamp(in.GetTimestamp());
+  out.SetImageId(in.GetImageId());
+
+  const s32 inNumRows = in.GetNumRows();
+  const s32 inNumCols = in.GetNumCols();
+  if(inNumRows < 2 || inNumCols < 2)
+  {
+    out.FillWith(PixelRGB(0,0,0));
+    return;
+  }
+
+  std::vector<const u8*> inRows(inNumRows);
+  for(s32 i = 0; i < inNumRows; ++i)
+  {
+    inRows[i] = reinterpret_cast<const u8*>(in.GetRow(i));
+  }
+
+#ifdef __ARM_NEON__
+  const f32 kColOffsets[4] = {0.f, 1.f, 2.f, 3.f};
+  const float32x4_t colOffsets = vld1q_f32(kColOffsets);
+  const float32x4_t maxX = vdupq_n_f32(static_cast<f32>(inNumCols - 1));
+  const float32x4_t maxY = vdupq_n_f32(static_cast<f32>(inNumRows - 1));
+  const int32x4_t maxX0 = vdupq_n_s32(inNumCols - 2);
+  const int32x4_t maxY0 = vdupq_n_s32(inNumRows - 2);
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  const float32x4_t half = vdupq_n_f32(0.5f);
+#endif
+
+  for(s32 i = 0; i < outNumRows; ++i)
+  {
+    u8* outRow = reinterpret_cast<u8*>(out.GetRow(i));
+
+    s32 j = 0;
+#ifdef __ARM_NEON__
+    // Projects 4 output pixels at a time. NEON has no gather, so each pixel's four neighbours are then
+    // fetched and blended individually.
+    const float32x4_t rowX = vdupq_n_f32(H(0,1)*i + H(0,2));
+    const float32x4_t rowY = vdupq_n_f32(H(1,1)*i + H(1,2));
+    const float32x4_t rowW = vdupq_n_f32(H(2,1)*i + H(2,2));
+    const s32 kNumOutputsPerIter = 4;
+    for(; j <= outNumCols - kNumOutputsPerIter; j += kNumOutputsPerIter)
+    {
+      const float32x4_t cols = vaddq_f32(vdupq_n_f32(static_cast<f32>(j)), colOffsets);
+      const float32x4_t X = vmlaq_n_f32(rowX, cols, H(0,0));
+      const float32x4_t Y = vmlaq_n_f32(rowY, cols, H(1,0));
+      const float32x4_t W = vmlaq_n_f32(rowW, cols, H(2,0));
+
+      // Reciprocal estimate refined with two Newton-Raphson steps, which is within float rounding of 1/W
+      float32x4_t invW = vrecpeq_f32(W);
+      invW = vmulq_f32(vrecpsq_f32(W, invW), invW);
+      invW = vmulq_f32(vrecpsq_f32(W, invW), invW);
+      const float32x4_t x = vmulq_f32(X, invW);
+      const float32x4_t y = vmulq_f32(Y, invW);
+
+      uint32x4_t isValid = vcgtq_f32(W, vdupq_n_f32(kMinW));
+      isValid = vandq_u32(isValid, vandq_u32(vcgeq_f32(x, zero), vcleq_f32(x, maxX)));
+      isValid = vandq_u32(isValid, vandq_u32(vcgeq_f32(y, zero), vcleq_f32(y, maxY)));
+
+      const int32x4_t x0 = vminq_s32(vcvtq_s32_f32(x), maxX0);
+      const int32x4_t y0 = vminq_s32(vcvtq_s32_f32(y), maxY0);
+      const int32x4_t wx = vcvtq_s32_f32(vmlaq_n_f32(half, vsubq_f32(x, vcvtq_f32_s32(x0)), kWeightScale));
+      const int32x4_t wy = vcvtq_s32_f32(vmlaq_n_f32(half, vsubq_f32(y, vcvtq_f32_s32(y0)), kWeightScale));
+
+      u32 valid[kNumOutputsPerIter];
+      s32 x0s[kNumOutputsPerIter], y0s[kNumOutputsPerIter], wxs[kNumOutputsPerIter], wys[kNumOutputsPerIter];
+      vst1q_u32(valid, isValid);
+      vst1q_s32(x0s, x0);
+      vst1q_s32(y0s, y0);
+      vst1q_s32(wxs, wx);
+      vst1q_s32(wys, wy);
+
+      for(s32 k = 0; k < kNumOutputsPerIter; ++k)
+      {
+        u8* outPixel = outRow + 3*(j+k);
+        if(valid[k] == 0)
+        {
+          outPixel[0] = outPixel[1] = outPixel[2] = 0;
+        }
+        else
+        {
+          BlendSample(inRows.data(), Sample{x0s[k], y0s[k], wxs[k], wys[k]}, outPixel);
+        }
+      }
+    }
+#endif
+
+    WarpRowScalar(inRows.data(), inNumRows, inNumCols, H, i, j, outNumCols, outRow);
+  }
+}
+
+}
+}
+}
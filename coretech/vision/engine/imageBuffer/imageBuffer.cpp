@@ -13,6 +13,7 @@
 #include "coretech/vision/engine/imageBuffer/imageBuffer.h"
 
 #include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
+#include "coretech/vision/engine/imageBuffer/imageConversionAccelerator.h"
 #include "coretech/vision/engine/image_impl.h"
 #include "coretech/vision/engine/imageCache.h"
 #include "coretech/vision/engine/neonMacros.h"
@@ -100,6 +101,14 @@ bool ImageBuffer::GetRGB(ImageRGB& rgb, ImageCacheSize size) const
   DEV_ASSERT(_rawData != nullptr, "ImageBuffer.GetRGB.NullData");
 
   bool res = false;
+
+  // Anything the accelerator can't produce falls through to the CPU conversions
+  if(IsAccelerated(size, true) && _accelerator->GetRGB(*this, size, rgb))
+  {
+    rgb.SetTimestamp(_timestamp);
+    rgb.SetImageId(_imageId);
+    return true;
+  }
   
   switch(_format)
   {
@@ -145,6 +154,13 @@ bool ImageBuffer::GetGray(Image& gray, ImageCacheSize size) const
   DEV_ASSERT(_rawData != nullptr, "ImageBuffer.GetRGB.NullData");
 
   bool res = false;
+
+  if(IsAccelerated(size, false) && _accelerator->GetGray(*this, size, gray))
+  {
+    gray.SetTimestamp(_timestamp);
+    gray.SetImageId(_imageId);
+    return true;
+  }
   
   switch(_format)
   {
@@ -184,6 +200,50 @@ bool ImageBuffer::GetGray(Image& gray, ImageCacheSize size) const
   return res;
 }
 
+bool ImageBuffer::IsAccelerated(ImageCacheSize size, bool isColor) const
+{
+  return (_accelerator != nullptr) && _accelerator->IsSupported(_format, size, isColor);
+}
+
+bool ImageBuffer::GetHalfAndQuarterFromBAYER(Image* halfGray, ImageRGB* halfRGB, ImageRGB* quarterRGB) const
+{
+  DEV_ASSERT(_rawData != nullptr, "ImageBuffer.GetHalfAndQuarterFromBAYER.NullData");
+
+  if(ImageEncoding::BAYER != _format)
+  {
+    return false;
+  }
+
+  // ImageCacheSizes smaller than Full are defined relative to Full,
+  // so Half is halved bayer and Quarter is quartered bayer
+  ImageConversions::HalveAndQuarterBGGR10(_rawData,
+                                          _rawNumRows,
+                                          _rawNumCols,
+                                          halfGray,
+                                          halfRGB,
+                                          quarterRGB);
+
+  if(nullptr != halfGray)
+  {
+    halfGray->SetTimestamp(_timestamp);
+    halfGray->SetImageId(_imageId);
+  }
+
+  if(nullptr != halfRGB)
+  {
+    halfRGB->SetTimestamp(_timestamp);
+    halfRGB->SetImageId(_imageId);
+  }
+
+  if(nullptr != quarterRGB)
+  {
+    quarterRGB->SetTimestamp(_timestamp);
+    quarterRGB->SetImageId(_imageId);
+  }
+
+  return true;
+}
+
 bool ImageBuffer::GetRGBFromBAYER(ImageRGB& rgb, ImageCacheSize size) const
 {
   switch(size)
@@ -260,14 +320,22 @@ bool ImageBuffer::GetRGBFromYUV420sp(ImageRGB& rgb, ImageCacheSize size) const
   s32 rows = 0;
   s32 cols = 0;
   GetNumRowsCols(rows, cols);
-  // TODO Add additional methods to convert and resize at the same time
-  // instead of converting and then resizing
-  ImageConversions::ConvertYUV420spToRGB(_rawData,
-                                         rows,
-                                         cols,
-                                         rgb);
-  
-  rgb.Resize(scaleFactor, _resizeMethod);
+
+  if(ImageCacheSize::Full == size)
+  {
+    ImageConversions::ConvertYUV420spToRGB(_rawData,
+                                           rows,
+                                           cols,
+                                           rgb);
+    return true;
+  }
+
+  // Smaller sizes start from the halved conversion, which never converts the full resolution image
+  ImageConversions::HalveYUV420sp(_rawData, rows, cols, nullptr, &rgb);
+  if(ImageCacheSize::Half != size)
+  {
+    rgb.Resize(2.f*scaleFactor, _resizeMethod);
+  }
 
   return true;
 }
@@ -331,16 +399,29 @@ bool ImageBuffer::GetGrayFromRawRGB(Image& gray, ImageCacheSize size) const
 
 bool ImageBuffer::GetGrayFromYUV420sp(Image& gray, ImageCacheSize size) const
 {
-  ImageRGB rgb;
-  // For now there are no optimized conversions from YUV420sp to Gray so convert to
-  // RGB and then fill gray
-  bool res = GetRGBFromYUV420sp(rgb, size);
-  if(res)
+  if(ImageCacheSize::Full == size)
   {
-    rgb.FillGray(gray);
+    ImageRGB rgb;
+    // For now there is no optimized conversion from YUV420sp to Full Gray so convert to
+    // RGB and then fill gray
+    bool res = GetRGBFromYUV420sp(rgb, size);
+    if(res)
+    {
+      rgb.FillGray(gray);
+    }
+    return res;
   }
-  
-  return res;
+
+  s32 rows = 0;
+  s32 cols = 0;
+  GetNumRowsCols(rows, cols);
+  ImageConversions::HalveYUV420sp(_rawData, rows, cols, &gray, nullptr);
+  if(ImageCacheSize::Half != size)
+  {
+    gray.Resize(2.f*ImageCacheSizeToScaleFactor(size), _resizeMethod);
+  }
+
+  return true;
 }
 
 bool ImageBuffer::GetGrayFromRawGray(Image& gray, ImageCacheSize size) const
@@ -6,6 +6,7 @@
  *
  * Description: Wrapper around raw image data
  *              Safe to copy as no image data will actually be copied
+ *              Can optionally share ownership of the data (e.g. a locked camera frame) among all copies
  *
  * Copyright: Anki, Inc. 2018
  *
@@ -19,9 +20,12 @@
 #include "coretech/vision/engine/imageCacheSizes.h"
 #include "clad/types/imageFormats.h"
 
+#include <memory>
+
 namespace Anki {
 namespace Vision {
 
+class IImageConversionAccelerator;
 class ImageRGB;
   
 class ImageBuffer
@@ -34,9 +38,18 @@ public:
 
   void SetImageId(u32 id) { _imageId = id; }
 
+  // Ties the lifetime of the raw data to this buffer: every copy of the buffer shares the owner, and the owner's
+  // deleter runs (e.g. returning the data to the camera) once the last copy is destroyed or Invalidated.
+  // Buffers without an owner just point at data which the caller must keep alive.
+  using DataOwner = std::shared_ptr<void>;
+  void SetDataOwner(DataOwner owner) { _dataOwner = std::move(owner); }
+
   // Set timestamp at which the raw image data was captured
   void SetTimestamp(u32 timestamp) { _timestamp = timestamp; }
 
+  // Set timestamp at which the sensor started exposing the first row, if the camera knows it
+  void SetExposureStartTimestamp(TimeStamp_t timestamp) { _exposureStartTimestamp = timestamp; }
+
   // Set the original resolution of the image sensor
   // Basically max resolution an image can be from this sensor
   void SetSensorResolution(s32 rows, s32 cols) { _sensorNumRows = rows; _sensorNumCols = cols; }
@@ -44,6 +57,15 @@ public:
   // Sets the resize method used for resizing the image when calling GetRGB/Gray
   // Defaults to ResizeMethod::Linear
   void SetResizeMethod(ResizeMethod method) { _resizeMethod = method; }
+
+  // Optional hardware backend which GetRGB/GetGray try before the CPU conversions, for those
+  // conversions it reports as supported. Shared by all copies of the buffer. Null (the default) is CPU only.
+  using AcceleratorPtr = std::shared_ptr<IImageConversionAccelerator>;
+  void SetAccelerator(AcceleratorPtr accelerator) { _accelerator = std::move(accelerator); }
+  const AcceleratorPtr& GetAccelerator() const { return _accelerator; }
+
+  // Whether GetRGB (isColor) or GetGray at size will first be tried on the accelerator
+  bool IsAccelerated(ImageCacheSize size, bool isColor) const;
   
   // Returns number of rows a converted RGB image will have
   s32 GetNumRows() const;
@@ -53,6 +75,9 @@ public:
 
   TimeStamp_t GetTimestamp() const { return _timestamp; }
 
+  // When the sensor started exposing the first row, or the capture timestamp if the camera did not say
+  TimeStamp_t GetExposureStartTimestamp() const { return (_exposureStartTimestamp != 0 ? _exposureStartTimestamp : _timestamp); }
+
   u32 GetImageId() const { return _imageId; }
 
   ImageEncoding GetFormat() const { return _format; }
@@ -67,7 +92,7 @@ public:
 
   const u8* GetDataPointer() const { return _rawData; }
 
-  void Invalidate() { _rawData = nullptr; _imageId = 0; _timestamp = 0; }
+  void Invalidate() { _rawData = nullptr; _imageId = 0; _timestamp = 0; _exposureStartTimestamp = 0; _dataOwner.reset(); }
 
   // Converts raw image data to rgb
   // Returns true if conversion was successful
@@ -77,6 +102,11 @@ public:
   // Returns true if conversion was successful
   bool GetGray(Image& gray, ImageCacheSize size) const;
 
+  // Converts BAYER data to any combination of Half gray, Half RGB and Quarter RGB (null outputs are skipped)
+  // in a single pass, which is cheaper than calling GetGray/GetRGB for each of them
+  // Returns false if the data is not BAYER
+  bool GetHalfAndQuarterFromBAYER(Image* halfGray, ImageRGB* halfRGB, ImageRGB* quarterRGB) const;
+
 private:
 
   // Calculates number of rows and cols a converted RGB image will have
@@ -100,9 +130,12 @@ private:
   ImageEncoding _format            = ImageEncoding::NoneImageEncoding;
   u32           _imageId           = 0;
   TimeStamp_t   _timestamp         = 0;
+  TimeStamp_t   _exposureStartTimestamp = 0;
   s32           _sensorNumRows     = 0;
   s32           _sensorNumCols     = 0;
   ResizeMethod  _resizeMethod      = ResizeMethod::Linear;
+  DataOwner     _dataOwner;
+  AcceleratorPtr _accelerator;
   
 };
   
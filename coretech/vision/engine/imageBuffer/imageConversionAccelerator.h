@@ -0,0 +1,53 @@
+/**
+ * File: imageConversionAccelerator.h
+ *
+ * Author:  Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Interface for offloading ImageBuffer's format conversions and resizes to hardware
+ *              (e.g. GPU shaders, or scaled planes produced by the camera's ISP)
+ *              ImageBuffer asks the accelerator first and falls back to its own CPU conversions
+ *              for anything the accelerator does not support or fails to produce
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Anki_Coretech_Vision_Engine_ImageConversionAccelerator_H__
+#define __Anki_Coretech_Vision_Engine_ImageConversionAccelerator_H__
+
+#include "coretech/common/shared/types.h"
+#include "coretech/vision/engine/imageCacheSizes.h"
+#include "clad/types/imageFormats.h"
+
+namespace Anki {
+namespace Vision {
+
+class Image;
+class ImageBuffer;
+class ImageRGB;
+
+class IImageConversionAccelerator
+{
+public:
+  virtual ~IImageConversionAccelerator() = default;
+
+  // For logging which backend produced an image
+  virtual const char* GetName() const = 0;
+
+  // Selection policy: whether this accelerator should be used for converting data in format to
+  // gray (isColor = false) or RGB at size. Conversions which are not supported, or not worth
+  // offloading (e.g. because the CPU path is a zero-copy wrap), go straight to the CPU.
+  virtual bool IsSupported(ImageEncoding format, ImageCacheSize size, bool isColor) const = 0;
+
+  // Only called for supported conversions. Output must be the same size as ImageBuffer's own
+  // GetGray/GetRGB would produce. Returning false (e.g. the hardware is busy or the frame was not
+  // available in the needed form) makes the buffer fall back to the CPU for this request.
+  virtual bool GetGray(const ImageBuffer& buffer, ImageCacheSize size, Image& gray) = 0;
+  virtual bool GetRGB(const ImageBuffer& buffer, ImageCacheSize size, ImageRGB& rgb) = 0;
+};
+
+}
+}
+
+#endif
@@ -12,11 +12,15 @@
  **/
 
 #include "coretech/vision/engine/imageCache.h"
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
 
 #include "coretech/common/shared/array2d_impl.h"
+#include "coretech/common/shared/math/matrix_impl.h"
 
 #include "util/math/math.h"
 
+#include <algorithm>
+
 #define DEBUG_IMAGE_CACHE 0
 
 #if DEBUG_IMAGE_CACHE
@@ -28,6 +32,11 @@
 namespace Anki {
 namespace Vision {
 
+namespace {
+  // Who Get requests on this thread are attributed to (see SetRequester)
+  thread_local std::string sCurrentRequester = "Unattributed";
+}
+
 #if DEBUG_IMAGE_CACHE
   namespace {
     //
@@ -55,13 +64,30 @@ namespace Vision {
 // =====================================================================================================================
 //                                  RESIZED ENTRY
 // =====================================================================================================================
-  
+
+template<>
+inline Image& ImageCache::ResizedEntry::PrepareForWrite<Image>()
+{
+  _grayPool.PrepareForWrite(_gray);
+  return _gray;
+}
+
+template<>
+inline ImageRGB& ImageCache::ResizedEntry::PrepareForWrite<ImageRGB>()
+{
+  _rgbPool.PrepareForWrite(_rgb);
+  return _rgb;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<>
 inline Image& ImageCache::ResizedEntry::Get<Image>()
 {
   // Don't already have gray
   if(!_hasValidGray)
   {
+    PrepareForWrite<Image>();
+
     // If buffer is valid use that to get gray
     if(_buffer.HasValidData())
     {
@@ -79,6 +105,7 @@ inline Image& ImageCache::ResizedEntry::Get<Image>()
         
         // ImageBuffer has more support for getting rgb so do that first
         // and then fill gray from rgb
+        PrepareForWrite<ImageRGB>();
         _hasValidRGB = _buffer.GetRGB(_rgb, _size);
         DEV_ASSERT(_hasValidRGB, "ImageCache.ResizeEntry.GetGray.FailedToGetFromBuffer");
       }
@@ -99,6 +126,8 @@ inline ImageRGB& ImageCache::ResizedEntry::Get<ImageRGB>()
   // Don't already have RGB
   if(!_hasValidRGB)
   {
+    PrepareForWrite<ImageRGB>();
+
     if(_buffer.HasValidData())
     {
       _hasValidRGB = _buffer.GetRGB(_rgb, _size);
@@ -152,7 +181,7 @@ s32 ImageCache::GetNumCols(const ImageCacheSize atSize) const
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<class ImageType>
 static void ResizeHelper(const ImageType& origImg, ImageCacheSize size,
-                         ImageType& resizedImg_out)
+                         ImageType& resizedImg_out, ImagePool<ImageType>& pool)
 {
   f32 scaleFactor = ImageCacheSizeToScaleFactor(size);
   if(Util::IsNear(scaleFactor, 1.f))
@@ -161,6 +190,7 @@ static void ResizeHelper(const ImageType& origImg, ImageCacheSize size,
   }
   else
   {
+    pool.PrepareForWrite(resizedImg_out);
     const s32 resizedNumRows = std::round((f32)origImg.GetNumRows() * scaleFactor);
     const s32 resizedNumCols = std::round((f32)origImg.GetNumCols() * scaleFactor);
     resizedImg_out.Allocate(resizedNumRows, resizedNumCols);
@@ -172,7 +202,7 @@ static void ResizeHelper(const ImageType& origImg, ImageCacheSize size,
 template<>
 void ImageCache::ResizedEntry::Update(const Image& origImg, ImageCacheSize size)
 {
-  ResizeHelper(origImg, size, _gray);
+  ResizeHelper(origImg, size, _gray, _grayPool);
   _hasValidGray = true;
   _size = size;
 }
@@ -181,7 +211,7 @@ void ImageCache::ResizedEntry::Update(const Image& origImg, ImageCacheSize size)
 template<>
 void ImageCache::ResizedEntry::Update(const ImageRGB& origImg, ImageCacheSize size)
 {
-  ResizeHelper(origImg, size, _rgb);
+  ResizeHelper(origImg, size, _rgb, _rgbPool);
   _hasValidRGB = true;
   _size = size;
 }
@@ -194,6 +224,55 @@ void ImageCache::ResizedEntry::Update(const ImageBuffer& origImg, ImageCacheSize
   _size = size;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<>
+void ImageCache::ResizedEntry::UpdateFromLargerSize(const Image& largerImg, s32 factor)
+{
+  PrepareForWrite<Image>();
+  if(4 == factor)
+  {
+    ImageConversions::BoxDownsample4x(largerImg, _gray);
+  }
+  else
+  {
+    DEV_ASSERT(2 == factor, "ImageCache.ResizedEntry.UpdateFromLargerSize.UnsupportedFactor");
+    ImageConversions::BoxDownsample2x(largerImg, _gray);
+  }
+  _hasValidGray = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<>
+Image& ImageCache::ResizedEntry::GetForOverwrite<Image>()
+{
+  _hasValidGray = true;
+  return PrepareForWrite<Image>();
+}
+
+template<>
+ImageRGB& ImageCache::ResizedEntry::GetForOverwrite<ImageRGB>()
+{
+  _hasValidRGB = true;
+  return PrepareForWrite<ImageRGB>();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<>
+void ImageCache::ResizedEntry::UpdateFromLargerSize(const ImageRGB& largerImg, s32 factor)
+{
+  PrepareForWrite<ImageRGB>();
+  if(4 == factor)
+  {
+    ImageConversions::BoxDownsample4x(largerImg, _rgb);
+  }
+  else
+  {
+    DEV_ASSERT(2 == factor, "ImageCache.ResizedEntry.UpdateFromLargerSize.UnsupportedFactor");
+    ImageConversions::BoxDownsample2x(largerImg, _rgb);
+  }
+  _hasValidRGB = true;
+}
+
 
 // =====================================================================================================================
 //                                  IMAGE CACHE
@@ -208,10 +287,36 @@ ImageCache::ImageCache()
 void ImageCache::ReleaseMemory()
 {
   _resizedVersions.clear();
+  _statistics.clear();
+  _warpedVersions.clear();
+  _buffer.Invalidate();
   _sensorNumRows = 0;
   _sensorNumCols = 0;
   _hasColor = false;
   _timeStamp = 0;
+  UpdateMemoryAccount();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t ImageCache::ResizedEntry::GetNumBytes() const
+{
+  return ((_gray.GetNumElements() * sizeof(u8)) + (_rgb.GetNumElements() * sizeof(PixelRGB)) +
+          _grayPool.GetNumBytes() + _rgbPool.GetNumBytes());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::UpdateMemoryAccount()
+{
+  size_t numBytes = 0;
+  for(const auto & entry : _resizedVersions)
+  {
+    numBytes += entry.second.GetNumBytes();
+  }
+  for(const auto & entry : _warpedVersions)
+  {
+    numBytes += entry.img.GetNumElements() * sizeof(PixelRGB);
+  }
+  _memoryAccount.Set(numBytes);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -283,6 +388,19 @@ void ImageCache::ResetHelper(const ImageType& img)
   VERBOSE_DEBUG_PRINT(kLogChannelName, "ImageCache.ResetHelper", "Resetting with %s image at t=%ums",
                       GetColorStr(img), img.GetTimestamp());
   
+  // Entries are allocated as they're requested, so count what the previous image's requests grew the cache to
+  UpdateMemoryAccount();
+  
+  // Remember what each requester asked for on the previous image
+  for(auto & entry : _currentRequests)
+  {
+    if(!entry.second.IsEmpty())
+    {
+      _lastRequests[entry.first] = entry.second;
+      entry.second = RequestSet();
+    }
+  }
+  
   // Invalidate all cache entries (but don't necessarily free their memory, since we are likely
   // to reuse them and can potentially reuse that memory)
   for(auto & entry : _resizedVersions)
@@ -290,6 +408,16 @@ void ImageCache::ResetHelper(const ImageType& img)
     entry.second.Invalidate();
   }
   
+  for(auto & entry : _statistics)
+  {
+    entry.second.isValid = false;
+  }
+  
+  for(auto & entry : _warpedVersions)
+  {
+    entry.isValid = false;
+  }
+  
   auto iter = _resizedVersions.find(ImageCacheSize::Full);
   if(iter == _resizedVersions.end())
   {
@@ -324,6 +452,7 @@ void ImageCache::Reset(const Image& imgGray, ResizeMethod method)
                         imgGray.GetTimestamp(),
                         imgGray.GetImageId());
   _buffer.SetResizeMethod(method);
+  _buffer.SetAccelerator(_accelerator);
   
   ResetHelper(_buffer);
 
@@ -352,6 +481,7 @@ void ImageCache::Reset(const ImageRGB& imgColor, ResizeMethod method)
                         imgColor.GetTimestamp(),
                         imgColor.GetImageId());
   _buffer.SetResizeMethod(method);
+  _buffer.SetAccelerator(_accelerator);
   
   ResetHelper(_buffer);
 
@@ -370,27 +500,177 @@ void ImageCache::Reset(const ImageBuffer& buffer)
   // Note: This is a copy but is totally fine as ImageBuffer is just a wrapper around image data
   // so no images are actually copied
   _buffer = buffer;
+  if(_buffer.GetAccelerator() == nullptr)
+  {
+    _buffer.SetAccelerator(_accelerator);
+  }
   ResetHelper(_buffer);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::Reset(const ImageBuffer& buffer, const RequestSet& expectedRequests)
+{
+  Reset(buffer);
+  
+  if(!_buffer.HasValidData() || (ImageEncoding::BAYER != _buffer.GetFormat()))
+  {
+    return;
+  }
+  
+  const auto& gray = expectedRequests.gray;
+  const auto& rgb  = expectedRequests.rgb;
+  const size_t kHalf    = static_cast<size_t>(ImageCacheSize::Half);
+  const size_t kQuarter = static_cast<size_t>(ImageCacheSize::Quarter);
+  const size_t kEighth  = static_cast<size_t>(ImageCacheSize::Eighth);
+  
+  // Smaller gray sizes are built from Half gray, and Eighth RGB from Quarter RGB (see ComputeFromLargerSize).
+  // Anything the accelerator produces is left to it.
+  const bool wantHalfGray   = ((gray[kHalf] || gray[kQuarter] || gray[kEighth]) &&
+                               !_buffer.IsAccelerated(ImageCacheSize::Half, false));
+  const bool wantHalfRGB    = (rgb[kHalf] && !_buffer.IsAccelerated(ImageCacheSize::Half, true));
+  const bool wantQuarterRGB = ((rgb[kQuarter] || rgb[kEighth]) && !_buffer.IsAccelerated(ImageCacheSize::Quarter, true));
+  
+  // Nothing gained over the individual conversions unless at least two outputs share the pass
+  if((static_cast<s32>(wantHalfGray) + static_cast<s32>(wantHalfRGB) + static_cast<s32>(wantQuarterRGB)) < 2)
+  {
+    return;
+  }
+  
+  // The fused conversion works relative to the raw data's resolution, which must match the cache's
+  if((_buffer.GetNumRows() != _sensorNumRows) || (_buffer.GetNumCols() != _sensorNumCols))
+  {
+    return;
+  }
+  
+  auto getEntry = [this](ImageCacheSize size) -> ResizedEntry& {
+    ResizedEntry& entry = _resizedVersions.emplace(size, ResizedEntry(_buffer, size)).first->second;
+    entry.Update(_buffer, size);
+    return entry;
+  };
+  
+  Image*    halfGray   = (wantHalfGray   ? &getEntry(ImageCacheSize::Half).GetForOverwrite<Image>()       : nullptr);
+  ImageRGB* halfRGB    = (wantHalfRGB    ? &getEntry(ImageCacheSize::Half).GetForOverwrite<ImageRGB>()    : nullptr);
+  ImageRGB* quarterRGB = (wantQuarterRGB ? &getEntry(ImageCacheSize::Quarter).GetForOverwrite<ImageRGB>() : nullptr);
+  
+  const bool success = _buffer.GetHalfAndQuarterFromBAYER(halfGray, halfRGB, quarterRGB);
+  DEV_ASSERT(success, "ImageCache.Reset.FusedConversionFailed");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ImageCache::RequestSet::IsEmpty() const
+{
+  return (std::none_of(gray.begin(), gray.end(), [](bool b) { return b; }) &&
+          std::none_of(rgb.begin(),  rgb.end(),  [](bool b) { return b; }));
+}
+
+void ImageCache::RequestSet::Merge(const RequestSet& other)
+{
+  for(size_t i = 0; i < kNumSizes; ++i)
+  {
+    gray[i] = gray[i] || other.gray[i];
+    rgb[i]  = rgb[i]  || other.rgb[i];
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageCache::SetRequester(const std::string& name)
+{
+  sCurrentRequester = name;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const ImageCache::RequestSet& ImageCache::GetLastRequests(const std::string& requester) const
+{
+  static const RequestSet kEmptyRequestSet;
+  auto iter = _lastRequests.find(requester);
+  return (iter == _lastRequests.end() ? kEmptyRequestSet : iter->second);
+}
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Image& ImageCache::GetGray(ImageCacheSize size, GetType* getType)
 {
+  std::lock_guard<std::mutex> lock(_mutex);
   GetType dummy;
-  const Image& imgGray = GetImageHelper<Image>(size, (getType == nullptr ? dummy : *getType));
+  GetType& getTypeRef = (getType == nullptr ? dummy : *getType);
+  _lastComputedFromLargerSize = false;
+  const Image& imgGray = GetImageHelper<Image>(size, getTypeRef);
   DEV_ASSERT(!imgGray.IsEmpty(), "ImageCache.GetGray.EmptyImage");
+  UpdateRequestStats<Image>(size, getTypeRef);
   return imgGray;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const ImageRGB& ImageCache::GetRGB(ImageCacheSize size, GetType* getType)
 {
+  std::lock_guard<std::mutex> lock(_mutex);
   GetType dummy;
-  const ImageRGB& imgRGB = GetImageHelper<ImageRGB>(size, (getType == nullptr ? dummy : *getType));
+  GetType& getTypeRef = (getType == nullptr ? dummy : *getType);
+  _lastComputedFromLargerSize = false;
+  const ImageRGB& imgRGB = GetImageHelper<ImageRGB>(size, getTypeRef);
   DEV_ASSERT(!imgRGB.IsEmpty(), "ImageCache.GetRGB.EmptyImage");
+  UpdateRequestStats<ImageRGB>(size, getTypeRef);
   return imgRGB;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const ImageStatistics& ImageCache::GetStatistics(s32 subSample, ImageCacheSize size)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  StatisticsEntry& entry = _statistics[{size, subSample}];
+  if(!entry.isValid)
+  {
+    GetType getType;
+    _lastComputedFromLargerSize = false;
+    const Image& imgGray = GetImageHelper<Image>(size, getType);
+    DEV_ASSERT(!imgGray.IsEmpty(), "ImageCache.GetStatistics.EmptyImage");
+    UpdateRequestStats<Image>(size, getType);
+    
+    entry.stats.Compute(imgGray, subSample);
+    entry.isValid = true;
+  }
+  return entry.stats;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const ImageRGB& ImageCache::GetWarpedRGB(const Matrix_3x3f& H, s32 outNumRows, s32 outNumCols, ImageCacheSize size)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  WarpedEntry* freeEntry = nullptr;
+  for(auto & entry : _warpedVersions)
+  {
+    if(!entry.isValid)
+    {
+      if(freeEntry == nullptr)
+      {
+        freeEntry = &entry;
+      }
+    }
+    else if((entry.size == size) && (entry.H == H) &&
+            (entry.img.GetNumRows() == outNumRows) && (entry.img.GetNumCols() == outNumCols))
+    {
+      return entry.img;
+    }
+  }
+  
+  if(freeEntry == nullptr)
+  {
+    _warpedVersions.emplace_back();
+    freeEntry = &_warpedVersions.back();
+  }
+  
+  GetType getType;
+  _lastComputedFromLargerSize = false;
+  const ImageRGB& imgRGB = GetImageHelper<ImageRGB>(size, getType);
+  DEV_ASSERT(!imgRGB.IsEmpty(), "ImageCache.GetWarpedRGB.EmptyImage");
+  UpdateRequestStats<ImageRGB>(size, getType);
+  
+  ImageConversions::WarpPerspectiveBilinear(imgRGB, H, outNumRows, outNumCols, freeEntry->img);
+  freeEntry->H = H;
+  freeEntry->size = size;
+  freeEntry->isValid = true;
+  return freeEntry->img;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<class ImageType>
 static inline bool IsRequestingColor() {
@@ -401,6 +681,141 @@ template<>
 inline bool IsRequestingColor<ImageRGB>() {
   return true;
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class ImageType>
+void ImageCache::UpdateRequestStats(ImageCacheSize size, GetType getType)
+{
+  RequestStats& stats = _requestStats[sCurrentRequester];
+  RequestSet& requests = _currentRequests[sCurrentRequester];
+  const size_t index = static_cast<size_t>(size);
+  if(IsRequestingColor<ImageType>())
+  {
+    ++stats.numRGBRequests[index];
+    requests.rgb[index] = true;
+  }
+  else
+  {
+    ++stats.numGrayRequests[index];
+    requests.gray[index] = true;
+  }
+  
+  if(GetType::FullyCached != getType)
+  {
+    ++stats.numComputed;
+  }
+  
+  if(_lastComputedFromLargerSize)
+  {
+    ++stats.numFromLargerSize;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class ImageType>
+static inline bool IsLargerSizeComputedAnyway(const ImageBuffer& buffer, ImageCacheSize size)
+{
+  // Bayer to gray always goes through the Half conversion first, and Bayer to Eighth RGB through
+  // the Quarter one, so caching those intermediate sizes costs nothing extra
+  if(ImageEncoding::BAYER != buffer.GetFormat())
+  {
+    return false;
+  }
+  
+  if(IsRequestingColor<ImageType>())
+  {
+    return (ImageCacheSize::Eighth == size);
+  }
+  
+  return (ImageCacheSize::Quarter == size || ImageCacheSize::Eighth == size);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<class ImageType>
+bool ImageCache::ComputeFromLargerSize(ImageCacheSize size, ResizedEntry& entry)
+{
+  if(ImageCacheSize::Full == size || !_buffer.HasValidData())
+  {
+    return false;
+  }
+  
+  // Offloading to the accelerator frees the CPU, which beats even downsampling a cached size
+  if(_buffer.IsAccelerated(size, IsRequestingColor<ImageType>()))
+  {
+    return false;
+  }
+  
+  // Averaging 2x2 blocks is exactly what Linear does when halving, and averaging NxN blocks is what
+  // AverageArea does for any integer factor. Other methods need to go through the buffer.
+  const ResizeMethod method = _buffer.GetResizeMethod();
+  s32 maxFactor = 0;
+  switch(method)
+  {
+    case ResizeMethod::Linear:
+      maxFactor = 2;
+      break;
+      
+    case ResizeMethod::AverageArea:
+      maxFactor = 4;
+      break;
+      
+    default:
+      return false;
+  }
+  
+  // Bayer data has dedicated conversions straight to Half/Quarter, which are cheaper (and sharper) than
+  // downsampling a demosaiced Full image, so only use the sizes which go through those conversions anyway
+  if(ImageEncoding::BAYER == _buffer.GetFormat())
+  {
+    if(!IsLargerSizeComputedAnyway<ImageType>(_buffer, size))
+    {
+      return false;
+    }
+    maxFactor = 2;
+  }
+  
+  const s32 numRows = GetNumRows(size);
+  const s32 numCols = GetNumCols(size);
+  
+  // Use the closest larger size which already has valid data, if close enough
+  s32 factor = 2;
+  for(s32 larger = static_cast<s32>(size) - 1; larger >= 0 && factor <= maxFactor; --larger, factor *= 2)
+  {
+    auto iter = _resizedVersions.find(static_cast<ImageCacheSize>(larger));
+    if(iter != _resizedVersions.end() && iter->second.IsValid<ImageType>())
+    {
+      const ImageType& largerImg = iter->second.Get<ImageType>();
+      if(largerImg.GetNumRows() != numRows*factor || largerImg.GetNumCols() != numCols*factor)
+      {
+        return false;
+      }
+      
+      VERBOSE_DEBUG_PRINT(kLogChannelName, "ImageCache.ComputeFromLargerSize.Cached",
+                          "%s by %dx from existing entry", GetColorStr(largerImg), factor);
+      entry.UpdateFromLargerSize(largerImg, factor);
+      _lastComputedFromLargerSize = true;
+      return true;
+    }
+  }
+  
+  if(IsLargerSizeComputedAnyway<ImageType>(_buffer, size))
+  {
+    // Compute (and cache) the next larger size, then halve it
+    GetType dummy;
+    const ImageCacheSize largerSize = static_cast<ImageCacheSize>(static_cast<s32>(size) - 1);
+    const ImageType& largerImg = GetImageHelper<ImageType>(largerSize, dummy);
+    if(largerImg.GetNumRows() != numRows*2 || largerImg.GetNumCols() != numCols*2)
+    {
+      return false;
+    }
+    
+    entry.UpdateFromLargerSize(largerImg, 2);
+    _lastComputedFromLargerSize = true;
+    return true;
+  }
+  
+  return false;
+}
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<class ImageType>
@@ -430,6 +845,8 @@ const ImageType& ImageCache::GetImageHelper(ImageCacheSize size, GetType& getTyp
 
         DEV_ASSERT(insertion.second, "ImageCache.GetImageHelper.NewEntryNotInserted");
         
+        ComputeFromLargerSize<ImageType>(size, insertion.first->second);
+        
         const ImageType& img = insertion.first->second.Get<ImageType>();
         getType = GetType::NewEntry;
         
@@ -456,6 +873,10 @@ const ImageType& ImageCache::GetImageHelper(ImageCacheSize size, GetType& getTyp
       if(_buffer.HasValidData())
       {
         entry.Update(_buffer, size);
+        if(!entry.IsValid<ImageType>())
+        {
+          ComputeFromLargerSize<ImageType>(size, entry);
+        }
       }
       else
       {
@@ -14,12 +14,20 @@
 #ifndef __Anki_Cozmo_Basestation_ImageCache_H__
 #define __Anki_Cozmo_Basestation_ImageCache_H__
 
+#include "coretech/common/shared/math/matrix.h"
 #include "coretech/vision/engine/image.h"
 #include "coretech/vision/engine/imageBuffer/imageBuffer.h"
 #include "coretech/vision/engine/imageCacheSizes.h"
+#include "coretech/vision/engine/imagePool.h"
+#include "coretech/vision/engine/imageStatistics.h"
 #include "clad/types/imageFormats.h"
+#include "util/memoryAccounting/memoryAccounting.h"
 
+#include <array>
+#include <list>
 #include <map>
+#include <mutex>
+#include <string>
 
 namespace Anki {
 namespace Vision {
@@ -39,7 +47,28 @@ public:
 
   void Reset(const ImageBuffer& buffer);
   
-  // Invalidate the cache and release all the memory associated with it.
+  // Sizes and colors of images that are expected to be requested from the cache
+  static constexpr size_t kNumSizes = static_cast<size_t>(ImageCacheSize::Eighth) + 1;
+  struct RequestSet
+  {
+    std::array<bool, kNumSizes> gray{};
+    std::array<bool, kNumSizes> rgb{};
+    
+    bool IsEmpty() const;
+    void Merge(const RequestSet& other);
+  };
+  
+  // Same as Reset(buffer), but also computes up front those expected requests which the buffer can produce
+  // together in a single pass over its data (currently Half gray, Half RGB, and Quarter RGB from BAYER data)
+  void Reset(const ImageBuffer& buffer, const RequestSet& expectedRequests);
+  
+  // Hardware backend given to every buffer the cache is Reset with that doesn't already have one of its own
+  // (see ImageBuffer::SetAccelerator). Conversions it doesn't support or fails fall back to the CPU.
+  // Takes effect at the next Reset. Null (the default) converts everything on the CPU.
+  void SetConversionAccelerator(ImageBuffer::AcceleratorPtr accelerator) { _accelerator = std::move(accelerator); }
+  
+  // Invalidate the cache and release all the memory associated with it, including the cache's reference to the
+  // buffer it was last Reset with.
   void ReleaseMemory();
   
   // HasColor is true iff Reset was called with an ImageRGB (even if cached "colorized gray" data exists)
@@ -84,12 +113,53 @@ public:
   // Notes:
   //  * The result of HasColor is not changed by calling GetRGB.
   //  * These are non-const because they could compute a resized version on demand.
+  //  * These are safe to call from multiple threads at once (e.g. VisionModes running in parallel). Returned
+  //    references remain valid until the next Reset.
+  //  * To keep an image past the next Reset, assign it to an image of your own rather than copying it
+  //    (CopyTo). That only adds a reference: the cache never writes into an image someone else references,
+  //    it moves on to other memory from a pool for that size, so what you hold stays as it was. In return,
+  //    don't write into an image you got this way (call MakeUnique on it first).
   static constexpr ImageCacheSize GetDefaultImageCacheSize() { return ImageCacheSize::Half; }
   const Image&    GetGray(ImageCacheSize size = GetDefaultImageCacheSize(), GetType* getType = nullptr);
   const ImageRGB& GetRGB(ImageCacheSize size  = GetDefaultImageCacheSize(), GetType* getType = nullptr);
 
   const ImageBuffer& GetBuffer() const { return _buffer; }
   
+  // Brightness histogram and mean of the gray image at the given size, sampling every subSample'th row and
+  // column. Computed on the first request for each (size, subSample) per image and shared with later ones,
+  // so e.g. image stats and illumination detection with the same subsampling make only one pass over the
+  // frame. The gray image it needs counts as a request. Same thread safety and lifetime as GetGray.
+  const ImageStatistics& GetStatistics(s32 subSample, ImageCacheSize size = GetDefaultImageCacheSize());
+  
+  // RGB image at the given size, bilinearly resampled into an outNumRows x outNumCols image through the
+  // homography H, which maps each output pixel's (x,y,1) into that image (see ImageConversions::WarpPerspectiveBilinear).
+  // Computed on the first request for each (H, output size, size) per image and shared with later ones, so e.g.
+  // the overhead ground plane image for a frame's pose is only warped once, however many modes want it.
+  // The RGB image it needs counts as a request. Same thread safety and lifetime as GetRGB.
+  const ImageRGB& GetWarpedRGB(const Matrix_3x3f& H, s32 outNumRows, s32 outNumCols,
+                               ImageCacheSize size = GetDefaultImageCacheSize());
+  
+  // Counts of Get requests, per size, to see which sizes each part of the vision system (e.g. VisionMode)
+  // actually asks for. Requests are attributed to whichever requester was most recently set.
+  struct RequestStats
+  {
+    std::array<u32, kNumSizes> numGrayRequests{};
+    std::array<u32, kNumSizes> numRGBRequests{};
+    u32 numComputed       = 0; // requests that were not FullyCached
+    u32 numFromLargerSize = 0; // computed by box-downsampling an already-computed larger size
+  };
+  using RequestStatsMap = std::map<std::string, RequestStats>;
+  
+  // Stats are not cleared by Reset or ReleaseMemory, only by ClearRequestStats
+  // The requester is set per calling thread, so parallel requesters are attributed correctly.
+  void SetRequester(const std::string& name);
+  const RequestStatsMap& GetRequestStats() const { return _requestStats; }
+  void ClearRequestStats() { _requestStats.clear(); }
+  
+  // What the given requester asked for during the most recent image for which it asked for anything
+  // (empty if it never has). Not cleared by ClearRequestStats.
+  const RequestSet& GetLastRequests(const std::string& requester) const;
+  
 private:
 
   s32          _sensorNumRows = 0;
@@ -100,6 +170,8 @@ private:
   // When we are Reset with an image buffer, we need keep a copy of it around to
   // give to any newly created ResizedEntrys
   ImageBuffer  _buffer;
+  
+  ImageBuffer::AcceleratorPtr _accelerator;
 
   // Container class to hold ImageBuffer, Image, and/or ImageRGB that
   // were created at a specific ImageCacheSize using a ResizeMethod
@@ -115,6 +187,14 @@ private:
 
     ImageRGB _rgb;
     bool     _hasValidRGB  = false;
+
+    // Where _gray and _rgb go when a new image is due but someone still references the current one
+    ImagePool<Image>    _grayPool;
+    ImagePool<ImageRGB> _rgbPool;
+
+    // Call before writing a new image into _gray or _rgb
+    template<class ImageType>
+    ImageType& PrepareForWrite();
     
   public:
     template<class ImageType>
@@ -133,11 +213,41 @@ private:
 
     template<class ImageType>
     void Update(const ImageType& origImg, ImageCacheSize size);
+    
+    // Fill this entry's ImageType by averaging factor x factor blocks of a larger size's image,
+    // reusing this entry's existing memory
+    template<class ImageType>
+    void UpdateFromLargerSize(const ImageType& largerImg, s32 factor);
+    
+    // Direct access to this entry's image memory, for filling it in from outside. Marks it valid.
+    template<class ImageType>
+    ImageType& GetForOverwrite();
+
+    // Memory held by the gray and color images, valid or not, and their pools
+    size_t GetNumBytes() const;
   };
 
   using ResizeVersionsMap = std::map<ImageCacheSize, ResizedEntry>;
   ResizeVersionsMap _resizedVersions;
   
+  struct StatisticsEntry
+  {
+    ImageStatistics stats;
+    bool            isValid = false;
+  };
+  std::map<std::pair<ImageCacheSize, s32>, StatisticsEntry> _statistics;
+  
+  // Few enough (one per homography in use) that a linear search is fine. A list, so references stay valid as
+  // entries are added, and invalid entries' memory is reused by the next image's warps.
+  struct WarpedEntry
+  {
+    Matrix_3x3f    H;
+    ImageCacheSize size = ImageCacheSize::Full;
+    ImageRGB       img;
+    bool           isValid = false;
+  };
+  std::list<WarpedEntry> _warpedVersions;
+  
   ResizeMethod GetMethod(ImageCacheSize size) const;
   
   template<class ImageType>
@@ -146,6 +256,29 @@ private:
   template<class ImageType>
   const ImageType& GetImageHelper(ImageCacheSize size, GetType& getType);
   
+  // Computes the requested ImageType for an entry at the given size by box-downsampling a larger size, either
+  // one that is already valid or one that is about to be computed anyway (e.g. Half gray from Bayer data).
+  // Returns false (and leaves the entry alone) if the resize method or image dimensions don't allow it.
+  template<class ImageType>
+  bool ComputeFromLargerSize(ImageCacheSize size, ResizedEntry& entry);
+  
+  template<class ImageType>
+  void UpdateRequestStats(ImageCacheSize size, GetType getType);
+  
+  // Counts the memory held by every entry, including invalidated ones kept around for reuse
+  void UpdateMemoryAccount();
+  Util::MemoryAccount _memoryAccount{Util::MemoryTag::ImageCache};
+  
+  // Held for the duration of GetGray/GetRGB/GetStatistics/GetWarpedRGB
+  std::mutex      _mutex;
+  
+  RequestStatsMap _requestStats;
+  
+  // Requests made since the last Reset, and as of the last image each requester asked for anything
+  std::map<std::string, RequestSet> _currentRequests;
+  std::map<std::string, RequestSet> _lastRequests;
+  bool            _lastComputedFromLargerSize = false;
+  
 }; // class ImageCache
   
 } // namespace Vision
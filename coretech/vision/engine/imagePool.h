@@ -0,0 +1,101 @@
+/**
+ * File: imagePool.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Recycles the memory of images of one resolution that were handed out by reference. The owner of
+ *              an image that may have readers (see Array2d::IsShared) gives it back with Release instead of writing
+ *              into it, and gets an image no one else is using from Acquire. The readers keep the data they saw,
+ *              and once they've all let go the memory is handed out again, so steady state allocates nothing.
+ *
+ *              Not thread safe: the pool belongs to the owner. Readers on other threads only ever drop their
+ *              references, which the reference count already handles.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Vision_ImagePool_H__
+#define __Anki_Vision_ImagePool_H__
+
+#include "coretech/common/shared/types.h"
+
+#include <vector>
+
+namespace Anki {
+namespace Vision {
+
+template<class ImageType>
+class ImagePool
+{
+public:
+
+  // Images held (in use by readers or waiting to be reused) before the oldest is let go
+  static constexpr size_t kDefaultMaxSize = 4;
+
+  explicit ImagePool(size_t maxSize = kDefaultMaxSize) : _maxSize(maxSize) { }
+
+  // Gives back an image the owner is done writing to. Its memory is reused once no reader references it.
+  void Release(const ImageType& img)
+  {
+    if(img.IsEmpty())
+    {
+      return;
+    }
+    if(_images.size() >= _maxSize)
+    {
+      // Not freed until its readers are done with it, just no longer reused
+      _images.erase(_images.begin());
+    }
+    _images.push_back(img);
+  }
+
+  // An image of the given size no one else references, with whatever data was last in it. Reuses pooled memory of
+  // that size if a reader has finished with some, else allocates.
+  ImageType Acquire(s32 numRows, s32 numCols)
+  {
+    for(auto iter = _images.begin(); iter != _images.end(); ++iter)
+    {
+      if(!iter->IsShared() && (iter->GetNumRows() == numRows) && (iter->GetNumCols() == numCols))
+      {
+        ImageType img = *iter;
+        _images.erase(iter);
+        return img;
+      }
+    }
+    return ImageType(numRows, numCols);
+  }
+
+  // Writes a new frame into img: if anyone else references it, swaps it for a pooled image of the same size first
+  void PrepareForWrite(ImageType& img)
+  {
+    if(img.IsShared())
+    {
+      Release(img);
+      img = Acquire(img.GetNumRows(), img.GetNumCols());
+    }
+  }
+
+  // Memory held by the pool, including images still in use by readers
+  size_t GetNumBytes() const
+  {
+    size_t numBytes = 0;
+    for(const auto& img : _images)
+    {
+      numBytes += img.GetNumElements() * sizeof(*img.GetDataPointer());
+    }
+    return numBytes;
+  }
+
+  void Clear() { _images.clear(); }
+
+private:
+
+  size_t                 _maxSize;
+  std::vector<ImageType> _images;
+};
+
+} // namespace Vision
+} // namespace Anki
+
+#endif // __Anki_Vision_ImagePool_H__
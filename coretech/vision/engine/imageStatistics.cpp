@@ -0,0 +1,80 @@
+/**
+ * File: imageStatistics.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Brightness statistics of a gray image (histogram and mean), gathered in a single subsampled
+ *              pass. ImageCache computes these once per image for each subsampling asked for, so the vision
+ *              modes that need them share one pass over the frame.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "coretech/vision/engine/imageStatistics.h"
+#include "coretech/vision/engine/image.h"
+
+#include "util/math/numericCast.h"
+
+#include <array>
+
+namespace Anki {
+namespace Vision {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result ImageStatistics::Compute(const Image& img, s32 subSample)
+{
+  _hist.Reset();
+  _sum = 0;
+  
+  if(subSample <= 0)
+  {
+    PRINT_NAMED_ERROR("ImageStatistics.Compute.InvalidSubSample", "%d not > 0. Will use 1 instead.", subSample);
+    subSample = 1;
+  }
+  _subSample = subSample;
+  
+  s32 nrows = img.GetNumRows();
+  s32 ncols = img.GetNumCols();
+  if(img.IsContinuous() && subSample==1) {
+    ncols *= nrows;
+    nrows = 1;
+  }
+  
+  // Count into a local array and hand the totals to the histogram at the end, rather than paying for
+  // its total count bookkeeping on every pixel. The mean falls out of the same counts.
+  std::array<s32,256> counts{};
+  for(s32 i=0; i<nrows; i+=subSample)
+  {
+    const u8* img_i = img.GetRow(i);
+    for(s32 j=0; j<ncols; j+=subSample)
+    {
+      ++counts[img_i[j]];
+    }
+  }
+  
+  for(s32 value=0; value<256; ++value)
+  {
+    if(counts[value] > 0)
+    {
+      _hist.IncrementBin((u8)value, counts[value]);
+      _sum += (s64)value * (s64)counts[value];
+    }
+  }
+  
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u8 ImageStatistics::GetMean() const
+{
+  const s32 count = _hist.GetTotalCount();
+  if(count == 0)
+  {
+    return 0;
+  }
+  return Util::numeric_cast_clamped<u8>(_sum / count);
+}
+  
+} // namespace Vision
+} // namespace Anki
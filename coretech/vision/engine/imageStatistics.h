@@ -0,0 +1,49 @@
+/**
+ * File: imageStatistics.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Brightness statistics of a gray image (histogram and mean), gathered in a single subsampled
+ *              pass. ImageCache computes these once per image for each subsampling asked for, so the vision
+ *              modes that need them share one pass over the frame.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Vision_ImageStatistics_H__
+#define __Anki_Vision_ImageStatistics_H__
+
+#include "coretech/vision/engine/imageBrightnessHistogram.h"
+
+namespace Anki {
+namespace Vision {
+
+class Image;
+
+class ImageStatistics
+{
+public:
+  
+  // Replaces any previous statistics with those of every subSample'th row and column of img
+  Result Compute(const Image& img, s32 subSample);
+  
+  s32 GetSubSample() const { return _subSample; }
+  
+  const ImageBrightnessHistogram& GetHistogram() const { return _hist; }
+  
+  // Integer mean of the sampled pixels (0 if none were sampled)
+  u8 GetMean() const;
+  
+private:
+  
+  ImageBrightnessHistogram _hist;
+  s64 _sum       = 0;
+  s32 _subSample = 1;
+  
+}; // class ImageStatistics
+  
+} // namespace Vision
+} // namespace Anki
+
+#endif /* __Anki_Vision_ImageStatistics_H__ */
@@ -15,6 +15,7 @@
 #include "coretech/vision/engine/image.h"
 #include "coretech/vision/robot/fiducialDetection.h"
 #include "coretech/vision/robot/fiducialMarkers.h"
+#include "coretech/vision/robot/lucasKanade.h"
 
 #include "coretech/common/shared/array2d_impl.h"
 #include "coretech/common/engine/math/quad_impl.h"
@@ -25,12 +26,27 @@
 #include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 
-#include <list>
 
 #define USE_MATLAB_DETECTOR 0
 
 namespace Anki {
 namespace Vision {
+
+namespace {
+  // Threads used to refine and decode candidate quads, including the vision thread itself
+  CONSOLE_VAR_RANGED(s32, kMarkerDetector_NumDecodeThreads, "Vision.MarkerDetection", 2, 1, 8);
+  
+  // Tracking between full detections, see DetectOrTrack()
+  CONSOLE_VAR_RANGED(s32, kMarkerDetector_TrackingKeyframePeriod,        "Vision.MarkerDetection", 5, 1, 30);
+  CONSOLE_VAR_RANGED(s32, kMarkerDetector_TrackingNumPyramidLevels,      "Vision.MarkerDetection", 2, 1, 3);
+  CONSOLE_VAR(s32,        kMarkerDetector_TrackingMaxIterations,         "Vision.MarkerDetection", 25);
+  CONSOLE_VAR(f32,        kMarkerDetector_TrackingConvergenceTolerance,  "Vision.MarkerDetection", 0.05f);
+  CONSOLE_VAR(u8,         kMarkerDetector_TrackingMaxPixelDifference,    "Vision.MarkerDetection", 30);
+  
+  // A track is lost unless enough of its template is still in the image and still looks like the template
+  CONSOLE_VAR_RANGED(f32, kMarkerDetector_TrackingMinInBoundsFraction,   "Vision.MarkerDetection", 0.9f,  0.f, 1.f);
+  CONSOLE_VAR_RANGED(f32, kMarkerDetector_TrackingMinSimilarFraction,    "Vision.MarkerDetection", 0.75f, 0.f, 1.f);
+}
   
 struct MarkerDetector::Parameters : public Embedded::FiducialDetectionParameters
 {
@@ -65,7 +81,27 @@ public:
   // This still relies on Embedded data structures so is part of "Memory" instead of MarkerDetector class for now
   Embedded::FixedLengthList<Embedded::VisionMarker> _markers;
   
+  // Markers followed between keyframes by DetectOrTrack(). Their templates live in _trackingScratch, which is only
+  // reset when the tracks are restarted, unlike the buffers above which are reset every frame.
+  struct Track
+  {
+    Embedded::TemplateTracker::LucasKanadeTracker_Projective tracker;
+    Vision::MarkerType markerType;
+  };
+  std::vector<Track> _tracks;
+  s32 _numRowsTracked = 0;
+  s32 _numColsTracked = 0;
+  s32 _framesSinceKeyframe = 0;
+  
   Result ResetBuffers(s32 numRows, s32 numCols, s32 maxMarkers);
+  
+  // Drops the current tracks and makes all of _trackingScratch available for new ones
+  void ResetTracking();
+  Embedded::MemoryStack& GetTrackingScratch() { return _trackingScratch; }
+  
+private:
+  std::vector<u8> _trackingBuffer;
+  Embedded::MemoryStack _trackingScratch;
 };
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -99,6 +135,19 @@ Result MarkerDetector::Memory::ResetBuffers(s32 numRows, s32 numCols, s32 maxMar
   return RESULT_OK;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MarkerDetector::Memory::ResetTracking()
+{
+  // Enough for the templates of several close-up markers at full resolution
+  static const s32 TRACKING_BUFFER_SIZE = 2000000;
+  
+  _tracks.clear();
+  _framesSinceKeyframe = 0;
+  
+  _trackingBuffer.resize(TRACKING_BUFFER_SIZE);
+  _trackingScratch = Embedded::MemoryStack(_trackingBuffer.data(), Util::numeric_cast<s32>(_trackingBuffer.size()));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 MarkerDetector::MarkerDetector(const Camera& camera)
 : _camera(camera)
@@ -164,7 +213,56 @@ static Result GetImageHelper(const Vision::Image& srcImage, Embedded::Array<u8>&
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result MarkerDetector::Detect(const Image& inputImageGray, std::list<ObservedMarker>& observedMarkers)
+// Construct a basestation quad from an embedded one
+static Quad2f GetQuadHelper(const Embedded::Quadrilateral<f32>& corners)
+{
+  return Quad2f({corners[Embedded::Quadrilateral<f32>::TopLeft].x,
+                 corners[Embedded::Quadrilateral<f32>::TopLeft].y},
+                {corners[Embedded::Quadrilateral<f32>::BottomLeft].x,
+                 corners[Embedded::Quadrilateral<f32>::BottomLeft].y},
+                {corners[Embedded::Quadrilateral<f32>::TopRight].x,
+                 corners[Embedded::Quadrilateral<f32>::TopRight].y},
+                {corners[Embedded::Quadrilateral<f32>::BottomRight].x,
+                 corners[Embedded::Quadrilateral<f32>::BottomRight].y});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result MarkerDetector::Detect(const Image& inputImageGray, ObservedMarkerList& observedMarkers)
+{
+  ResetTracking();
+  return DetectHelper(inputImageGray, observedMarkers, false);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result MarkerDetector::DetectOrTrack(const Image& inputImageGray, ObservedMarkerList& observedMarkers)
+{
+  const bool isKeyframe = (_memory->_tracks.empty() ||
+                           _memory->_framesSinceKeyframe >= kMarkerDetector_TrackingKeyframePeriod ||
+                           _memory->_numRowsTracked != inputImageGray.GetNumRows() ||
+                           _memory->_numColsTracked != inputImageGray.GetNumCols());
+  
+  if(!isKeyframe && TrackHelper(inputImageGray, observedMarkers))
+  {
+    ++_memory->_framesSinceKeyframe;
+    return RESULT_OK;
+  }
+  
+  _memory->ResetTracking();
+  return DetectHelper(inputImageGray, observedMarkers, true);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MarkerDetector::ResetTracking()
+{
+  if(!_memory->_tracks.empty())
+  {
+    _memory->ResetTracking();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result MarkerDetector::DetectHelper(const Image& inputImageGray, ObservedMarkerList& observedMarkers,
+                                    const bool startTracking)
 {
   ANKI_CPU_PROFILE("MarkerDetector_Detect");
   
@@ -200,6 +298,7 @@ Result MarkerDetector::Detect(const Image& inputImageGray, std::list<ObservedMar
   
   _params->SetComputeComponentMinNumPixels(inputImageGray.GetNumRows(), inputImageGray.GetNumCols());
   _params->SetComputeComponentMaxNumPixels(inputImageGray.GetNumRows(), inputImageGray.GetNumCols());
+  _params->decode_numThreads = kMarkerDetector_NumDecodeThreads;
   
   // Victor markers are all light-on-dark
   const bool kDarkOnLightMode = false;
@@ -223,25 +322,110 @@ Result MarkerDetector::Detect(const Image& inputImageGray, std::list<ObservedMar
   {
     const Embedded::VisionMarker& crntMarker = _memory->_markers[i_marker];
     
-    // Construct a basestation quad from an embedded one:
-    Quad2f quad({crntMarker.corners[Embedded::Quadrilateral<f32>::TopLeft].x,
-                 crntMarker.corners[Embedded::Quadrilateral<f32>::TopLeft].y},
-                {crntMarker.corners[Embedded::Quadrilateral<f32>::BottomLeft].x,
-                  crntMarker.corners[Embedded::Quadrilateral<f32>::BottomLeft].y},
-                {crntMarker.corners[Embedded::Quadrilateral<f32>::TopRight].x,
-                  crntMarker.corners[Embedded::Quadrilateral<f32>::TopRight].y},
-                {crntMarker.corners[Embedded::Quadrilateral<f32>::BottomRight].x,
-                  crntMarker.corners[Embedded::Quadrilateral<f32>::BottomRight].y});
-    
     observedMarkers.emplace_back(inputImageGray.GetTimestamp(),
                                  crntMarker.markerType,
-                                 quad, _camera);
+                                 GetQuadHelper(crntMarker.corners), _camera);
   } // for(each marker)
+  
+  if(startTracking && numMarkers > 0)
+  {
+    ANKI_CPU_PROFILE("MarkerDetector_StartTracking");
+    
+    // Every marker needs a track, otherwise the untracked ones would go unseen until the next keyframe
+    Embedded::MemoryStack& trackingScratch = _memory->GetTrackingScratch();
+    for(s32 i_marker = 0; i_marker < numMarkers; ++i_marker)
+    {
+      const Embedded::VisionMarker& crntMarker = _memory->_markers[i_marker];
+      Memory::Track track{
+        Embedded::TemplateTracker::LucasKanadeTracker_Projective(grayscaleImage,
+                                                                 crntMarker.corners,
+                                                                 1.f,
+                                                                 kMarkerDetector_TrackingNumPyramidLevels,
+                                                                 Embedded::Transformations::TRANSFORM_PROJECTIVE,
+                                                                 trackingScratch),
+        crntMarker.markerType
+      };
+      
+      if(!track.tracker.IsValid())
+      {
+        PRINT_NAMED_WARNING("MarkerDetector.DetectHelper.StartTrackingFailed",
+                            "Could not create tracker %d of %d", i_marker+1, numMarkers);
+        _memory->ResetTracking();
+        break;
+      }
+      
+      _memory->_tracks.push_back(std::move(track));
+    }
+    
+    _memory->_numRowsTracked = inputImageGray.GetNumRows();
+    _memory->_numColsTracked = inputImageGray.GetNumCols();
+  }
 
   
   return RESULT_OK;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MarkerDetector::TrackHelper(const Image& inputImageGray, ObservedMarkerList& observedMarkers)
+{
+  ANKI_CPU_PROFILE("MarkerDetector_Track");
+  
+  const Result memResult = _memory->ResetBuffers(inputImageGray.GetNumRows(), inputImageGray.GetNumCols(), _params->maxMarkers);
+  if(RESULT_OK != memResult)
+  {
+    return false;
+  }
+  
+  Embedded::MemoryStack& scratch = _memory->_onchipScratch;
+  Embedded::Array<u8> grayscaleImage(inputImageGray.GetNumRows(), inputImageGray.GetNumCols(),
+                                     scratch, Embedded::Flags::Buffer(false,false,false));
+  
+  if(RESULT_OK != GetImageHelper(inputImageGray, grayscaleImage))
+  {
+    return false;
+  }
+  
+  // Track everything before reporting anything, so that losing any one track falls back to a full detection
+  // without leaving partial results behind
+  const size_t numObservedBefore = observedMarkers.size();
+  for(Memory::Track& track : _memory->_tracks)
+  {
+    bool converged = false;
+    s32 meanAbsoluteDifference = 0;
+    s32 numInBounds = 0;
+    s32 numSimilarPixels = 0;
+    const Result trackResult = track.tracker.UpdateTrack(grayscaleImage,
+                                                         kMarkerDetector_TrackingMaxIterations,
+                                                         kMarkerDetector_TrackingConvergenceTolerance,
+                                                         kMarkerDetector_TrackingMaxPixelDifference,
+                                                         converged,
+                                                         meanAbsoluteDifference,
+                                                         numInBounds,
+                                                         numSimilarPixels,
+                                                         scratch);
+    
+    const s32 numTemplatePixels = track.tracker.get_numTemplatePixels();
+    const bool isTracking = (RESULT_OK == trackResult &&
+                             converged &&
+                             numInBounds >= kMarkerDetector_TrackingMinInBoundsFraction * numTemplatePixels &&
+                             numSimilarPixels >= kMarkerDetector_TrackingMinSimilarFraction * numInBounds);
+    
+    if(!isTracking)
+    {
+      PRINT_NAMED_DEBUG("MarkerDetector.TrackHelper.TrackLost",
+                        "Converged:%d InBounds:%d/%d Similar:%d",
+                        converged, numInBounds, numTemplatePixels, numSimilarPixels);
+      observedMarkers.erase(observedMarkers.begin() + numObservedBefore, observedMarkers.end());
+      return false;
+    }
+    
+    const Embedded::Quadrilateral<f32> corners = track.tracker.get_transformation().get_transformedCorners(scratch);
+    observedMarkers.emplace_back(inputImageGray.GetTimestamp(), track.markerType, GetQuadHelper(corners), _camera);
+  }
+  
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 MarkerDetector::Parameters::Parameters()
 : isInitialized(false)
@@ -333,6 +517,8 @@ void MarkerDetector::Parameters::Initialize()
   
   doCodeExtraction = true;
   
+  decode_numThreads = 1;
+  
   // Return unknown/unverified markers (e.g. for display)
   returnInvalidMarkers = false;
   
@@ -18,7 +18,6 @@
 
 #include "coretech/vision/engine/visionMarker.h"
 
-#include <list>
 #include <vector>
 
 namespace Anki {
@@ -38,10 +37,26 @@ public:
   // TODO: Pass in Json config and set parameters from there
   Result Init(s32 numRows, s32 numCols);
   
-  Result Detect(const Image& inputImage, std::list<ObservedMarker>& observedMarkers);
+  Result Detect(const Image& inputImage, ObservedMarkerList& observedMarkers);
+  
+  // Like Detect(), but between keyframes the markers found by the last full detection are followed with a
+  // projective Lucas-Kanade tracker seeded from their quads, which only looks at the pixels around each one.
+  // A full detection is run instead every kMarkerDetector_TrackingKeyframePeriod frames, whenever any track is
+  // lost, or when the image size changes. Consecutive images must share coordinates, i.e. must not be cropped
+  // differently.
+  Result DetectOrTrack(const Image& inputImage, ObservedMarkerList& observedMarkers);
+  
+  // Drop the current tracks, so the next DetectOrTrack() runs a full detection. Detect() does this too.
+  void ResetTracking();
     
 private:
 
+  // Runs full detection, and if startTracking is true, seeds a tracker for each marker found
+  Result DetectHelper(const Image& inputImage, ObservedMarkerList& observedMarkers, const bool startTracking);
+  
+  // Returns false, leaving observedMarkers untouched, if any track was lost
+  bool TrackHelper(const Image& inputImage, ObservedMarkerList& observedMarkers);
+
   const Camera&           _camera;
   
   // Using forward declaration and unique_ptr pattern for Parameters and Memory because
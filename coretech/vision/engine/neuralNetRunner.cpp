@@ -68,6 +68,15 @@ namespace {
   // 2: save full images
   CONSOLE_VAR_ENUM(s32,   kNeuralNetRunner_SaveImages,  CONSOLE_GROUP, 0, "Off,Save Resized,Save Original Size");
 
+  // While neither the robot nor the scene moves, reuse the last detections instead of running the model again.
+  // The scene has moved once the mean absolute difference of the eighth-size gray image from the one the model last
+  // processed exceeds StaticSceneMaxChange. The model still runs at least every MaxReuseTime_ms.
+  CONSOLE_VAR(bool,       kNeuralNetRunner_ReuseStaticResults,    CONSOLE_GROUP, true);
+  CONSOLE_VAR(f32,        kNeuralNetRunner_StaticSceneMaxChange,  CONSOLE_GROUP, 3.f);
+  CONSOLE_VAR(s32,        kNeuralNetRunner_MaxReuseTime_ms,       CONSOLE_GROUP, 5000);
+
+  constexpr ImageCacheSize kThumbnailSize = ImageCacheSize::Eighth;
+
 #undef CONSOLE_GROUP
 }
   
@@ -90,6 +99,8 @@ Result NeuralNetRunner::Init(const std::string& modelPath, const std::string& ca
   Result result = RESULT_OK;
 
   _isInitialized = false;
+  _hasLastResult = false;
+  _hasReusedResult = false;
   _cachePath = cachePath;
   
   std::string modelTypeString;
@@ -202,7 +213,32 @@ void NeuralNetRunner::ApplyGamma(ImageRGB& img)
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool NeuralNetRunner::StartProcessingIfIdle(ImageCache& imageCache)
+bool NeuralNetRunner::CanReuseLastResult(ImageCache& imageCache, bool isRobotMoving) const
+{
+  if(!kNeuralNetRunner_ReuseStaticResults || isRobotMoving || !_hasLastResult)
+  {
+    return false;
+  }
+  
+  if(imageCache.GetTimeStamp() > _lastProcessedThumbnail.GetTimestamp() + kNeuralNetRunner_MaxReuseTime_ms)
+  {
+    return false;
+  }
+  
+  const Image& thumbnail = imageCache.GetGray(kThumbnailSize);
+  if((thumbnail.GetNumRows() != _lastProcessedThumbnail.GetNumRows()) ||
+     (thumbnail.GetNumCols() != _lastProcessedThumbnail.GetNumCols()))
+  {
+    return false;
+  }
+  
+  const f64 meanChange = (cv::norm(thumbnail.get_CvMat_(), _lastProcessedThumbnail.get_CvMat_(), cv::NORM_L1) /
+                          (f64)thumbnail.GetNumElements());
+  return (meanChange <= kNeuralNetRunner_StaticSceneMaxChange);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool NeuralNetRunner::StartProcessingIfIdle(ImageCache& imageCache, bool isRobotMoving)
 {
   if(!_isInitialized)
   {
@@ -218,7 +254,7 @@ bool NeuralNetRunner::StartProcessingIfIdle(ImageCache& imageCache)
   }
   
   // If we're not already processing an image with a "future", create one to process this image asynchronously.
-  if(!_future.valid())
+  if(!_future.valid() && !_hasReusedResult)
   {
     // Require color data
     if(!imageCache.HasColor())
@@ -226,6 +262,27 @@ bool NeuralNetRunner::StartProcessingIfIdle(ImageCache& imageCache)
       LOG_PERIODIC_DEBUG(30, "NeuralNetRunner.StartProcessingIfIdle.NeedColorData", "");
       return false;
     }
+    
+    if(CanReuseLastResult(imageCache, isRobotMoving))
+    {
+      _reusedSalientPoints = _lastSalientPoints;
+      for(auto& salientPoint : _reusedSalientPoints)
+      {
+        salientPoint.timestamp = imageCache.GetTimeStamp();
+      }
+      _hasReusedResult = true;
+      
+      if(_model->IsVerbose())
+      {
+        LOG_INFO("NeuralNetRunner.StartProcessingIfIdle.ReusingDetections",
+                 "Nothing moved since t=%u, reusing %zu salient points for t=%u",
+                 _lastProcessedThumbnail.GetTimestamp(), _reusedSalientPoints.size(), imageCache.GetTimeStamp());
+      }
+      return true;
+    }
+    
+    // Remember what the model is about to see, to tell whether the scene has changed next time
+    _lastProcessedThumbnail = imageCache.GetGray(kThumbnailSize);
   
     if(kNeuralNetRunner_SaveImages == 2)
     {
@@ -294,6 +351,13 @@ std::list<SalientPoint> NeuralNetRunner::RunModel()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool NeuralNetRunner::GetDetections(std::list<SalientPoint>& salientPoints)
 {
+  if(_hasReusedResult)
+  {
+    salientPoints.splice(salientPoints.end(), _reusedSalientPoints);
+    _hasReusedResult = false;
+    return true;
+  }
+  
   if(_future.valid())
   {
     // Check the future's status and keep waiting until it's ready.
@@ -304,6 +368,8 @@ bool NeuralNetRunner::GetDetections(std::list<SalientPoint>& salientPoints)
     {
       auto newSalientPoints = _future.get();
       std::copy(newSalientPoints.begin(), newSalientPoints.end(), std::back_inserter(salientPoints));
+      _lastSalientPoints = std::move(newSalientPoints);
+      _hasLastResult = true;
 
       DEV_ASSERT(!_future.valid(), "NeuralNetRunner.GetDetections.FutureStillValid");
       
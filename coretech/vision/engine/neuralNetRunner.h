@@ -54,7 +54,9 @@ public:
   Result Init(const std::string& modelPath, const std::string& cachePath, const Json::Value& config);
   
   // Returns true if image was used, false if otherwise occupied or image wasn't suitable (e.g., not color)
-  bool StartProcessingIfIdle(ImageCache& imageCache);
+  // If the robot isn't moving and the scene hasn't changed since the last image the model processed, the model
+  // isn't run: the last detections are returned again by GetDetections, with this image's timestamp.
+  bool StartProcessingIfIdle(ImageCache& imageCache, bool isRobotMoving = true);
   
   // Returns true if processing of the last image provided using StartProcessingIfIdle is complete
   // and populates salientPoints with any detections.
@@ -89,8 +91,18 @@ private:
   f32                   _currentGamma;
   std::array<u8,256>    _gammaLUT{};
   
+  // For reusing the last detections while nothing moves: a thumbnail of the last image the model processed and
+  // what it found there
+  Image                   _lastProcessedThumbnail;
+  std::list<SalientPoint> _lastSalientPoints;
+  bool                    _hasLastResult = false;
+  std::list<SalientPoint> _reusedSalientPoints;
+  bool                    _hasReusedResult = false;
+  
   void ApplyGamma(ImageRGB& img);
   
+  bool CanReuseLastResult(ImageCache& imageCache, bool isRobotMoving) const;
+  
   std::list<SalientPoint> RunModel();
   
 }; // class NeuralNetworkRunner
@@ -232,6 +232,40 @@ namespace Vision {
     }
     
   } // ComputePossiblePoses()
+  
+  void ObservableObject::ComputePossiblePoses(const std::vector<const ObservedMarker*>& obsMarkers,
+                                              std::vector<PoseMatchPair>&              possiblePoses) const
+  {
+    std::vector<MarkerMatch> matches;
+    for(auto obsMarker : obsMarkers)
+    {
+      auto matchingMarkers = _markersWithCode.find(obsMarker->GetCode());
+      if(matchingMarkers != _markersWithCode.end()) {
+        for(auto matchingMarker : matchingMarkers->second) {
+          matches.emplace_back(obsMarker, matchingMarker);
+        }
+      }
+    }
+    
+    if(matches.empty()) {
+      return;
+    }
+    
+    // As above, the known markers' corners are w.r.t. this object, so these are the poses of the object
+    std::vector<Pose3d> markerPosesWrtCamera;
+    const Result result = KnownMarker::EstimateObservedPoses(matches, markerPosesWrtCamera);
+    if(result != RESULT_OK) {
+      PRINT_NAMED_ERROR("ObservableObject.ComputePossiblePoses",
+                        "Failed to estimate poses of %zu observed markers", matches.size());
+      return;
+    }
+    
+    possiblePoses.reserve(possiblePoses.size() + matches.size());
+    for(size_t i=0; i<matches.size(); ++i) {
+      possiblePoses.emplace_back(std::move(markerPosesWrtCamera[i]), matches[i]);
+    }
+    
+  } // ComputePossiblePoses(batch)
 
   /*
   Point3f ObservableObject::GetRotatedBoundingCube(const Pose3d &atPose)
@@ -117,6 +117,11 @@ namespace Anki {
       // list will not be modified.
       void ComputePossiblePoses(const ObservedMarker*     obsMarker,
                                 std::vector<PoseMatchPair>& possiblePoses) const;
+      
+      // Same as above for all the markers of this object seen in one image, estimating their poses in one batch.
+      // Poses are added in the same order as calling the single-marker version on each marker in turn.
+      void ComputePossiblePoses(const std::vector<const ObservedMarker*>& obsMarkers,
+                                std::vector<PoseMatchPair>&              possiblePoses) const;
 
       // Sets all markers with the specified code as having been observed
       // at the given time
@@ -18,6 +18,7 @@
 #include <list>
 #include <set>
 #include <map>
+#include <vector>
 
 #include "coretech/vision/engine/observableObject.h"
 #include "coretech/vision/engine/visionMarker.h"
@@ -49,7 +50,7 @@ namespace Anki {
       
       // Groups markers referring to the same object type, and clusters them into observed objects, returned in
       // objectsSeen. The object poses will be with respect to origin.
-      void CreateObjectsFromMarkers(const std::list<ObservedMarker>& markers,
+      void CreateObjectsFromMarkers(const std::vector<ObservedMarker>& markers,
                                     std::vector<std::shared_ptr<ObsObjectType>>& objectsSeen) const;
       
       // Return a pointer to a known object with at least one of the specified marker or code on it. If there is no
@@ -164,7 +164,7 @@ namespace Vision {
   }
   
   template<class ObsObjectType>
-  void ObservableObjectLibrary<ObsObjectType>::CreateObjectsFromMarkers(const std::list<ObservedMarker>& markers,
+  void ObservableObjectLibrary<ObsObjectType>::CreateObjectsFromMarkers(const std::vector<ObservedMarker>& markers,
                                                                         std::vector<std::shared_ptr<ObsObjectType>>& objectsSeen) const
   {
     std::map<const ObsObjectType*, std::vector<const ObservedMarker*>> markersByLibObject;
@@ -217,19 +217,14 @@ namespace Vision {
         CORETECH_ASSERT(observedTime == (*obsMarker)->GetTimeStamp());
       }
       
-      for(auto obsMarker : libObjectMarkersPair.second)
-      {
-        // For each observed marker, we add to the list of possible poses
-        // (each paired with the observed/known marker match from which the
-        // pose was computed).
-        // (This is all so we can recompute object pose later from clusters of
-        // markers, without having to reassociate observed and known markers.)
-        // Note that each observed marker can generate multiple poses because
-        // an object may have the same known marker on it several times.
-        
-        libObject->ComputePossiblePoses(obsMarker, possiblePoses);
-        
-      } // FOR each observed marker
+      // For all the observed markers at once, we add to the list of possible
+      // poses (each paired with the observed/known marker match from which the
+      // pose was computed).
+      // (This is all so we can recompute object pose later from clusters of
+      // markers, without having to reassociate observed and known markers.)
+      // Note that each observed marker can generate multiple poses because
+      // an object may have the same known marker on it several times.
+      libObject->ComputePossiblePoses(libObjectMarkersPair.second, possiblePoses);
       
       // TODO: make the distance/angle thresholds parameters or else object-type-specific
       std::vector<PoseCluster> poseClusters;
@@ -13,6 +13,11 @@
 #include "coretech/vision/engine/occluderList.h"
 #include "coretech/vision/engine/observableObject.h"
 
+#include "util/math/math.h"
+
+#include <algorithm>
+#include <limits>
+
 namespace Anki {
   
   namespace Vision {
@@ -25,6 +30,7 @@ namespace Anki {
     void OccluderList::Clear()
     {
       rectDepthPairs_.clear();
+      isIndexValid_ = false;
     }
     
     /* Moved to Camera class
@@ -63,6 +69,8 @@ namespace Anki {
     template<class PointContainer>
     void OccluderList::AddOccluderHelper(const PointContainer& points, const f32 atDistance)
     {
+      isIndexValid_ = false;
+      
       Rectangle<f32> occluder(points);
       
       auto currentOccluderAtDistance = rectDepthPairs_.find(atDistance);
@@ -77,28 +85,126 @@ namespace Anki {
     }
     
     
+    void OccluderList::EnsureIndexValid() const
+    {
+      if(isIndexValid_) {
+        return;
+      }
+      
+      sortedOccluders_.clear();
+      for(auto& tile : tiles_) {
+        tile.clear();
+      }
+      
+      f32 xMin = std::numeric_limits<f32>::max();
+      f32 yMin = std::numeric_limits<f32>::max();
+      f32 xMax = std::numeric_limits<f32>::lowest();
+      f32 yMax = std::numeric_limits<f32>::lowest();
+      sortedOccluders_.reserve(rectDepthPairs_.size());
+      for(const auto& rectDepthPair : rectDepthPairs_) {
+        const Rectangle<f32>& rect = rectDepthPair.second;
+        sortedOccluders_.push_back(DepthRect{rectDepthPair.first, rect});
+        xMin = std::min(xMin, rect.GetX());
+        yMin = std::min(yMin, rect.GetY());
+        xMax = std::max(xMax, rect.GetXmax());
+        yMax = std::max(yMax, rect.GetYmax());
+      }
+      
+      if(!sortedOccluders_.empty()) {
+        // Tiles at least a pixel across, so that occluders all in one row or column still get a usable index
+        tilesX_ = xMin;
+        tilesY_ = yMin;
+        tileWidth_  = std::max((xMax - xMin) / kNumTilesPerSide, 1.f);
+        tileHeight_ = std::max((yMax - yMin) / kNumTilesPerSide, 1.f);
+        
+        // Occluders are visited nearest first, so each tile's list is also nearest first
+        for(u32 i=0; i<sortedOccluders_.size(); ++i) {
+          const Rectangle<f32>& rect = sortedOccluders_[i].rect;
+          const s32 colEnd = GetTileCol(rect.GetXmax());
+          const s32 rowEnd = GetTileRow(rect.GetYmax());
+          for(s32 row = GetTileRow(rect.GetY()); row <= rowEnd; ++row) {
+            for(s32 col = GetTileCol(rect.GetX()); col <= colEnd; ++col) {
+              tiles_[row*kNumTilesPerSide + col].push_back(i);
+            }
+          }
+        }
+      }
+      
+      isIndexValid_ = true;
+    }
+    
+    
+    s32 OccluderList::GetTileCol(const f32 x) const
+    {
+      // Clip before converting, since points projected from near the camera plane can be huge
+      const f32 col = std::floor((x - tilesX_) / tileWidth_);
+      return static_cast<s32>(CLIP(col, 0.f, static_cast<f32>(kNumTilesPerSide-1)));
+    }
+    
+    
+    s32 OccluderList::GetTileRow(const f32 y) const
+    {
+      // Clip before converting, since points projected from near the camera plane can be huge
+      const f32 row = std::floor((y - tilesY_) / tileHeight_);
+      return static_cast<s32>(CLIP(row, 0.f, static_cast<f32>(kNumTilesPerSide-1)));
+    }
+    
+    
+    bool OccluderList::IsWithinIndex(const Point2f& point) const
+    {
+      return (!sortedOccluders_.empty() &&
+              point.x() >= tilesX_ && point.x() <= tilesX_ + kNumTilesPerSide*tileWidth_ &&
+              point.y() >= tilesY_ && point.y() <= tilesY_ + kNumTilesPerSide*tileHeight_);
+    }
+    
+    
+    bool OccluderList::IsWithinIndex(const Rectangle<f32>& rect) const
+    {
+      return (!sortedOccluders_.empty() &&
+              rect.GetXmax() >= tilesX_ && rect.GetX() <= tilesX_ + kNumTilesPerSide*tileWidth_ &&
+              rect.GetYmax() >= tilesY_ && rect.GetY() <= tilesY_ + kNumTilesPerSide*tileHeight_);
+    }
+    
+    
+    const std::vector<u32>& OccluderList::GetTile(const Point2f& point) const
+    {
+      return tiles_[GetTileRow(point.y())*kNumTilesPerSide + GetTileCol(point.x())];
+    }
+    
+    
     bool OccluderList::IsOccluded(const Quad2f &quad, const f32 atDistance) const
     {
       if(!IsEmpty()) {
+        EnsureIndexValid();
+        
         // Model the quad by its axis-aligned rectangle for simpler intersection
         // checking
         Rectangle<f32> boundingBox(quad);
+        if(!IsWithinIndex(boundingBox)) {
+          return false;
+        }
         
-        // Don't need to check against occluders in the container that are further
-        // away than the quad I'm checking (they can't possibly be occluding), so
-        // we only have to go until the current occluder is behind the quad we're
-        // checking, since the vector is sorted
-        auto currentOccluder = rectDepthPairs_.begin();
-        auto end = rectDepthPairs_.end();
-        while(currentOccluder != end && atDistance > currentOccluder->first) {
-          
-          if( boundingBox.Intersect(currentOccluder->second).Area() > 0 ) {
-            // The bounding box intersects this occluder, and is thus occluded
-            // by it.
-            return true;
+        // Don't need to check against occluders that are further away than the
+        // quad I'm checking (they can't possibly be occluding), so in each tile
+        // we only have to go until the current occluder is behind the quad,
+        // since the tiles are sorted
+        const s32 colEnd = GetTileCol(boundingBox.GetXmax());
+        const s32 rowEnd = GetTileRow(boundingBox.GetYmax());
+        for(s32 row = GetTileRow(boundingBox.GetY()); row <= rowEnd; ++row) {
+          for(s32 col = GetTileCol(boundingBox.GetX()); col <= colEnd; ++col) {
+            for(const u32 index : tiles_[row*kNumTilesPerSide + col]) {
+              const DepthRect& currentOccluder = sortedOccluders_[index];
+              if(atDistance <= currentOccluder.depth) {
+                break;
+              }
+              
+              if( boundingBox.Intersect(currentOccluder.rect).Area() > 0 ) {
+                // The bounding box intersects this occluder, and is thus occluded
+                // by it.
+                return true;
+              }
+            }
           }
-          
-          ++currentOccluder;
         }
       } // if not empty
       
@@ -111,20 +217,24 @@ namespace Anki {
     bool OccluderList::IsOccluded(const Point2f &point, const f32 atDistance) const
     {
       if(!IsEmpty()) {
-        // Don't need to check against occluders in the container that are further
-        // away than the quad I'm checking (they can't possibly be occluding), so
-        // we only have to go until the current occluder is behind the quad we're
-        // checking, since the vector is sorted
-        auto currentOccluder = rectDepthPairs_.begin();
-        auto end = rectDepthPairs_.end();
-        while(currentOccluder != end && atDistance > currentOccluder->first) {
+        EnsureIndexValid();
+        if(!IsWithinIndex(point)) {
+          return false;
+        }
+        
+        // Don't need to check against occluders that are further away than the
+        // point I'm checking (they can't possibly be occluding), so we only have
+        // to go until the current occluder is behind it, since the tile is sorted
+        for(const u32 index : GetTile(point)) {
+          const DepthRect& currentOccluder = sortedOccluders_[index];
+          if(atDistance <= currentOccluder.depth) {
+            break;
+          }
           
-          if(currentOccluder->second.Contains(point)) {
+          if(currentOccluder.rect.Contains(point)) {
             // This occluder contains the point, and thus occludes it.
             return true;
           }
-          
-          ++currentOccluder;
         }
       } // if not empty
       
@@ -132,30 +242,40 @@ namespace Anki {
       return false;
       
     } // OccluderList::IsOccluded(point)
+    
+    
+    bool OccluderList::IsAnyCornerOccluded(const Quad2f& quad, const f32 atDistance) const
+    {
+      for(const auto& corner : quad) {
+        if(IsOccluded(corner, atDistance)) {
+          return true;
+        }
+      }
+      return false;
+    }
 
     
     bool OccluderList::IsAnythingBehind(const Point2f &point, const f32 atDistance) const
     {
       if(!IsEmpty()) {
-        // Jump to first occluder farther away than the given point
-        auto currentOccluder = rectDepthPairs_.begin();
-        auto end = rectDepthPairs_.end();
-        while(currentOccluder != end && atDistance >= currentOccluder->first) {
-          ++currentOccluder;
+        EnsureIndexValid();
+        if(!IsWithinIndex(point)) {
+          return false;
         }
         
-        // Check the remaining occluders from here back, if there are any
-        while(currentOccluder != end) {
-          // If we get here, the current occluder should be one that is further
-          // away than the specified distance
-          CORETECH_ASSERT(atDistance < currentOccluder->first);
+        // Check the occluders farther away than the given point, from the back
+        // of the tile forward, until reaching one that isn't
+        const std::vector<u32>& tile = GetTile(point);
+        for(auto iter = tile.rbegin(); iter != tile.rend(); ++iter) {
+          const DepthRect& currentOccluder = sortedOccluders_[*iter];
+          if(atDistance >= currentOccluder.depth) {
+            break;
+          }
           
-          if(currentOccluder->second.Contains(point)) {
+          if(currentOccluder.rect.Contains(point)) {
             // If the point is within the occluder, then the occluder is behind it
             return true;
           }
-          
-          ++currentOccluder;
         }
           
       } // if not empty
@@ -168,27 +288,32 @@ namespace Anki {
     bool OccluderList::IsAnythingBehind(const Quad2f &quad, const f32 atDistance) const
     {
       if(!IsEmpty()) {
-        // Jump to first occluder farther away than the given point
-        auto currentOccluder = rectDepthPairs_.begin();
-        auto end = rectDepthPairs_.end();
-        while(currentOccluder != end && atDistance >= currentOccluder->first) {
-          ++currentOccluder;
-        }
+        EnsureIndexValid();
         
         const Rectangle<f32> boundingBox(quad);
+        if(!IsWithinIndex(boundingBox)) {
+          return false;
+        }
         
-        // Check the remaining occluders from here back, if there are any
-        while(currentOccluder != end) {
-          // If we get here, the current occluder should be one that is further
-          // away than the specified distance
-          CORETECH_ASSERT(atDistance < currentOccluder->first);
-          
-          if(boundingBox.Intersect(currentOccluder->second).Area() > 0) {
-            // If the quad's bounding box intersects the occluder, then the occluder is behind it
-            return true;
+        // Check the occluders farther away than the quad in each tile it
+        // overlaps, from the back of the tile forward
+        const s32 colEnd = GetTileCol(boundingBox.GetXmax());
+        const s32 rowEnd = GetTileRow(boundingBox.GetYmax());
+        for(s32 row = GetTileRow(boundingBox.GetY()); row <= rowEnd; ++row) {
+          for(s32 col = GetTileCol(boundingBox.GetX()); col <= colEnd; ++col) {
+            const std::vector<u32>& tile = tiles_[row*kNumTilesPerSide + col];
+            for(auto iter = tile.rbegin(); iter != tile.rend(); ++iter) {
+              const DepthRect& currentOccluder = sortedOccluders_[*iter];
+              if(atDistance >= currentOccluder.depth) {
+                break;
+              }
+              
+              if(boundingBox.Intersect(currentOccluder.rect).Area() > 0) {
+                // If the quad's bounding box intersects the occluder, then the occluder is behind it
+                return true;
+              }
+            }
           }
-          
-          ++currentOccluder;
         }
         
       } // if not empty
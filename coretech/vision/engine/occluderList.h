@@ -11,6 +11,7 @@
 
 #include <vector>
 #include <array>
+#include <map>
 
 #include "coretech/common/shared/math/rect.h"
 
@@ -38,6 +39,10 @@ namespace Anki {
       bool IsOccluded(const Quad2f& quad, const f32 atDistance)   const;
       bool IsOccluded(const Point2f& point, const f32 atDistance) const;
       
+      // True if any of the quad's corners is occluded (as opposed to IsOccluded(quad), which checks its whole
+      // bounding box). Same as checking each corner with IsOccluded(point), in one pass over the index.
+      bool IsAnyCornerOccluded(const Quad2f& quad, const f32 atDistance) const;
+      
       bool IsAnythingBehind(const Point2f& point, const f32 atDistance) const;
       bool IsAnythingBehind(const Quad2f&  quad,  const f32 atDistance) const;
       
@@ -58,6 +63,37 @@ namespace Anki {
       
       //bool isSorted_;
       
+      // Screen-space tile index over the occluders, covering their bounding box, so that queries only look at the
+      // occluders around the point or quad in question instead of every one nearer (or farther) than it. Built on
+      // the first query after the list changes, since occluders are all added before any visibility checks.
+      static constexpr s32 kNumTilesPerSide = 8;
+      
+      struct DepthRect {
+        f32            depth;
+        Rectangle<f32> rect;
+      };
+      
+      mutable std::vector<DepthRect> sortedOccluders_; // rectDepthPairs_ flattened, nearest first
+      mutable std::array<std::vector<u32>, kNumTilesPerSide*kNumTilesPerSide> tiles_; // indexes into sortedOccluders_
+      mutable f32  tilesX_      = 0.f;
+      mutable f32  tilesY_      = 0.f;
+      mutable f32  tileWidth_   = 1.f;
+      mutable f32  tileHeight_  = 1.f;
+      mutable bool isIndexValid_ = false;
+      
+      void EnsureIndexValid() const;
+      
+      // Tile column/row holding x/y, clamped to the index's bounds
+      s32 GetTileCol(const f32 x) const;
+      s32 GetTileRow(const f32 y) const;
+      
+      // Whether the occluders' bounding box (if any) contains the point / intersects the rectangle
+      bool IsWithinIndex(const Point2f& point) const;
+      bool IsWithinIndex(const Rectangle<f32>& rect) const;
+      
+      // Occluders in the tile holding the point, nearest first
+      const std::vector<u32>& GetTile(const Point2f& point) const;
+      
       template<class PointContainer>
       void AddOccluderHelper(const PointContainer& points, const f32 atDistance);
       
@@ -6,6 +6,7 @@
  *
  * Description: Wrapper for Omron Computer Vision (OMCV) pet detection library.
  *
+ *              See petTracker.h for the low resolution candidate pre-filter.
  *
  * Copyright: Anki, Inc. 2016
  **/
@@ -27,6 +28,8 @@
 #include "DetectionInfo.h"
 #include "DetectorComDef.h"
 
+#include <cmath>
+
 #if !defined(ANDROID) && !defined(VICOS)
 extern "C"
 {
@@ -48,6 +51,9 @@ extern "C"
 // If < 0, use value from JSON config. Otherwise use this one (for dev adjustment live)
 CONSOLE_VAR_RANGED(s32, kRuntimePetDetectionThreshold, "Vision.PetDetection", -1, -1, 1000);
 
+// If false, always run the full resolution detector, even when the candidate pre-filter is set up
+CONSOLE_VAR(bool, kUsePetCandidateFilter, "Vision.PetDetection", true);
+
 
 namespace Anki {
 namespace Vision {
@@ -62,6 +68,11 @@ namespace JsonKey {
   static const char * const NewSearchCycle      = "NewSearchCycle";
   static const char * const TrackLostCount      = "TrackLostCount";
   static const char * const TrackSteadiness     = "TrackSteadiness";
+  
+  // Optional: candidate pre-filter
+  static const char * const CandidateScale                 = "CandidateScale";
+  static const char * const CandidateDetectionThreshold    = "CandidateDetectionThreshold";
+  static const char * const MaxFramesBetweenFullDetections = "MaxFramesBetweenFullDetections";
 };
   
 struct PetTracker::Handles
@@ -69,6 +80,10 @@ struct PetTracker::Handles
   // Okao Vision Library "Handles"
   HPET        omcvPetDetector         = NULL;
   HPDRESULT   omcvDetectionResult     = NULL;
+  
+  // Still mode detector run on the downscaled image
+  HPET        omcvCandidateDetector   = NULL;
+  HPDRESULT   omcvCandidateResult     = NULL;
 };
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -189,14 +204,100 @@ Result PetTracker::Init(const Json::Value& config)
     return RESULT_FAIL_INVALID_PARAMETER;
   }
   
+  const Result candidateResult = InitCandidateFilter(petConfig,
+                                                     parameters[JsonKey::MinFaceSize],
+                                                     parameters[JsonKey::MaxFaceSize],
+                                                     parameters[JsonKey::DetectionThreshold]);
+  if(RESULT_OK != candidateResult)
+  {
+    // Not fatal: just always run the full detector
+    PRINT_NAMED_WARNING("PetTracker.Init.CandidateFilterDisabled", "");
+    _isCandidateFilterEnabled = false;
+  }
+  
   _isInitialized = true;
   return RESULT_OK;
       
 } // Init()
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result PetTracker::InitCandidateFilter(const Json::Value& petConfig, s32 minFaceSize, s32 maxFaceSize,
+                                       s32 detectionThreshold)
+{
+  _isCandidateFilterEnabled = false;
+  
+  // By default, look at a quarter of the pixels with half the threshold
+  s32 candidateThreshold = detectionThreshold / 2;
+  JsonTools::GetValueOptional(petConfig, JsonKey::CandidateScale, _candidateScale);
+  JsonTools::GetValueOptional(petConfig, JsonKey::CandidateDetectionThreshold, candidateThreshold);
+  JsonTools::GetValueOptional(petConfig, JsonKey::MaxFramesBetweenFullDetections, _maxFramesBetweenFullDetections);
+  
+  if(_candidateScale <= 0.f || _candidateScale >= 1.f)
+  {
+    PRINT_NAMED_INFO("PetTracker.InitCandidateFilter.Disabled", "CandidateScale=%f", _candidateScale);
+    return RESULT_OK;
+  }
+  
+  _handles->omcvCandidateDetector = OMCV_PD_CreateHandle(DETECTION_MODE_STILL, 1);
+  if(NULL == _handles->omcvCandidateDetector) {
+    PRINT_NAMED_ERROR("PetTracker.InitCandidateFilter.OmcvCreateHandleFail", "");
+    return RESULT_FAIL_MEMORY;
+  }
+  
+  _handles->omcvCandidateResult = OMCV_PD_CreateResultHandle();
+  if(NULL == _handles->omcvCandidateResult) {
+    PRINT_NAMED_ERROR("PetTracker.InitCandidateFilter.OmcvCreateResultHandleFail", "");
+    return RESULT_FAIL_MEMORY;
+  }
+  
+  INT32 omcvResult = OMCV_PD_SetAngle(_handles->omcvCandidateDetector, POSE_YAW_FRONT, ROLL_ANGLE_U45);
+  if(OMCV_NORMAL != omcvResult) {
+    PRINT_NAMED_WARNING("PetTracker.InitCandidateFilter.OmcvSetAngleFailed", "OMCV Result=%d", omcvResult);
+    return RESULT_FAIL_INVALID_PARAMETER;
+  }
+  
+  // Pets look smaller by the same scale in the downscaled image
+  const s32 candidateMinSize = std::round((f32)minFaceSize * _candidateScale);
+  const s32 candidateMaxSize = std::round((f32)maxFaceSize * _candidateScale);
+  omcvResult = OMCV_PD_SetSizeRange(_handles->omcvCandidateDetector, candidateMinSize, candidateMaxSize);
+  if(OMCV_NORMAL != omcvResult) {
+    PRINT_NAMED_WARNING("PetTracker.InitCandidateFilter.OmcvSetSizeRangeFailed",
+                        "Min:%d Max:%d OMCV Result=%d", candidateMinSize, candidateMaxSize, omcvResult);
+    return RESULT_FAIL_INVALID_PARAMETER;
+  }
+  
+  omcvResult = OMCV_PD_SetThreshold(_handles->omcvCandidateDetector, candidateThreshold);
+  if(OMCV_NORMAL != omcvResult) {
+    PRINT_NAMED_WARNING("PetTracker.InitCandidateFilter.OmcvSetThresholdFailed",
+                        "Threshold:%d OMCV Result=%d", candidateThreshold, omcvResult);
+    return RESULT_FAIL_INVALID_PARAMETER;
+  }
+  
+  PRINT_NAMED_INFO("PetTracker.InitCandidateFilter.Enabled",
+                   "Scale:%.2f Sizes:[%d,%d] Threshold:%d MaxFramesBetweenFullDetections:%d",
+                   _candidateScale, candidateMinSize, candidateMaxSize, candidateThreshold,
+                   _maxFramesBetweenFullDetections);
+  
+  _isCandidateFilterEnabled = true;
+  return RESULT_OK;
+  
+} // InitCandidateFilter()
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 PetTracker::~PetTracker()
 {
+  if(NULL != _handles->omcvCandidateResult) {
+    if(OMCV_NORMAL != OMCV_PD_DeleteResultHandle(_handles->omcvCandidateResult)) {
+      PRINT_NAMED_ERROR("PetTracker.Destructor.OmcvDeleteCandidateResultHandleFail", "");
+    }
+  }
+  
+  if(NULL != _handles->omcvCandidateDetector) {
+    if(OMCV_NORMAL != OMCV_PD_DeleteHandle(_handles->omcvCandidateDetector)) {
+      PRINT_NAMED_ERROR("PetTracker.Destructor.OmcvDeleteCandidateHandleFail", "");
+    }
+  }
+  
   if(NULL != _handles->omcvDetectionResult) {
     if(OMCV_NORMAL != OMCV_PD_DeleteResultHandle(_handles->omcvDetectionResult)) {
       PRINT_NAMED_ERROR("PetTracker.Destructor.OmcvDeleteResultHandleFail", "");
@@ -214,7 +315,7 @@ PetTracker::~PetTracker()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result PetTracker::Update(const Vision::Image&       frameOrig,
-                          std::list<TrackedPet>&     pets)
+                          std::vector<TrackedPet>&     pets)
 {
   // Initialize on first use
   if(!_isInitialized) {
@@ -240,6 +341,26 @@ Result PetTracker::Update(const Vision::Image&       frameOrig,
   
   DEV_ASSERT(frameOrig.IsContinuous(), "PetTracker.Update.NonContinuousImage");
   
+  // The movie mode detector needs every frame while it's tracking, so only use the candidates to decide whether to
+  // look for new pets. Every so often look anyway, in case the candidate detector misses one.
+  if(_isCandidateFilterEnabled && kUsePetCandidateFilter &&
+     (0 == _numPetsLastFullDetection) &&
+     (_numFramesSinceFullDetection < _maxFramesBetweenFullDetections))
+  {
+    bool foundCandidates = false;
+    const Result candidateResult = FindCandidates(frameOrig, foundCandidates);
+    if(RESULT_OK != candidateResult) {
+      return candidateResult;
+    }
+    
+    if(!foundCandidates) {
+      ++_numFramesSinceFullDetection;
+      return RESULT_OK;
+    }
+  }
+  _numFramesSinceFullDetection = 0;
+  _numPetsLastFullDetection = 0;
+  
   INT32 omcvResult = OMCV_NORMAL;
   Tic("PetDetect");
   const INT32 nWidth  = frameOrig.GetNumCols();
@@ -261,6 +382,9 @@ Result PetTracker::Update(const Vision::Image&       frameOrig,
   }
   Toc("PetDetect");
   
+  // Includes pets the detector is holding onto after losing them, so it keeps getting frames until it lets go
+  _numPetsLastFullDetection = numDetections;
+  
   for(INT32 detectionIndex=0; detectionIndex<numDetections; ++detectionIndex)
   {
     DETECTION_INFO detectionInfo;
@@ -309,6 +433,40 @@ Result PetTracker::Update(const Vision::Image&       frameOrig,
   
   return RESULT_OK;
 } // Update()
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result PetTracker::FindCandidates(const Vision::Image& frameOrig, bool& foundCandidates)
+{
+  foundCandidates = false;
+  
+  Tic("PetCandidateDetect");
+  const s32 candidateRows = std::round((f32)frameOrig.GetNumRows() * _candidateScale);
+  const s32 candidateCols = std::round((f32)frameOrig.GetNumCols() * _candidateScale);
+  if(_candidateImage.GetNumRows() != candidateRows || _candidateImage.GetNumCols() != candidateCols) {
+    _candidateImage.Allocate(candidateRows, candidateCols);
+  }
+  frameOrig.Resize(_candidateImage, ResizeMethod::AverageArea);
+  
+  RAWIMAGE* dataPtr = _candidateImage.GetDataPointer();
+  INT32 omcvResult = OMCV_PD_Detect(_handles->omcvCandidateDetector, dataPtr, candidateCols, candidateRows,
+                                    _handles->omcvCandidateResult);
+  if(OMCV_NORMAL != omcvResult) {
+    PRINT_NAMED_WARNING("PetTracker.FindCandidates.OmcvDetectFail", "OMCV Result Code=%d", omcvResult);
+    return RESULT_FAIL;
+  }
+  
+  INT32 numCandidates = 0;
+  omcvResult = OMCV_PD_GetResultCount(_handles->omcvCandidateResult, OBJ_TYPE_DOG|OBJ_TYPE_CAT, &numCandidates);
+  if(OMCV_NORMAL != omcvResult) {
+    PRINT_NAMED_WARNING("PetTracker.FindCandidates.OmcvGetResultCountFail", "OMCV Result Code=%d", omcvResult);
+    return RESULT_FAIL;
+  }
+  Toc("PetCandidateDetect");
+  
+  foundCandidates = (numCandidates > 0);
+  return RESULT_OK;
+  
+} // FindCandidates()
   
 } // namespace Vision
 } // namespace Anki
@@ -6,6 +6,10 @@
  *
  * Description: Wrapper for Omron Computer Vision (OMCV) pet detection library.
  *
+ *              Most homes have no pets, so unless pets are already being tracked,
+ *              a still-mode detector with a lower threshold first looks for
+ *              candidates in a downscaled image, and the full resolution detector
+ *              only runs when it finds some (or has been skipped for too long).
  *
  * Copyright: Anki, Inc. 2016
  **/
@@ -18,6 +22,7 @@
 #include "coretech/vision/engine/profiler.h"
 
 #include <list>
+#include <vector>
 
 namespace Anki {
 namespace Vision {
@@ -32,7 +37,7 @@ public:
   Result Init(const Json::Value& config);
   
   Result Update(const Vision::Image&       frameOrig,
-                std::list<TrackedPet>&     pets);
+                std::vector<TrackedPet>&     pets);
   
 private:
 
@@ -43,6 +48,18 @@ private:
   
   std::unique_ptr<Handles> _handles;
   
+  // Candidate pre-filter. Disabled if its detector can't be set up with the configured parameters.
+  bool  _isCandidateFilterEnabled = false;
+  f32   _candidateScale = 0.5f;
+  s32   _maxFramesBetweenFullDetections = 15;
+  s32   _numFramesSinceFullDetection = 0;
+  s32   _numPetsLastFullDetection = 0;
+  Image _candidateImage;
+  
+  Result InitCandidateFilter(const Json::Value& petConfig, s32 minFaceSize, s32 maxFaceSize, s32 detectionThreshold);
+  
+  Result FindCandidates(const Vision::Image& frameOrig, bool& foundCandidates);
+  
   // For dev/live threshold adjustment
   s32 _runtimeDetectionThreshold = -1;
   
@@ -49,6 +49,7 @@ namespace Vision {
   void Profiler::Tic(const char* timerName)
   {
     // Note will construct timer if matching name doesn't already exist
+    std::lock_guard<std::mutex> lock(_mutex);
     _timers[timerName].startTime = ClockType::now();
   }
 
@@ -81,6 +82,7 @@ namespace Vision {
 
   double Profiler::Toc(const char* timerName)
   {
+    std::lock_guard<std::mutex> lock(_mutex);
     auto timerIter = _timers.find(timerName);
     if(timerIter != _timers.end())
     {
@@ -108,6 +110,7 @@ namespace Vision {
 
   double Profiler::AverageToc(const char* timerName)
   {
+    std::lock_guard<std::mutex> lock(_mutex);
     auto timerIter = _timers.find(timerName);
     if(timerIter != _timers.end()) {
       Timer& timer = timerIter->second;
@@ -129,6 +132,7 @@ namespace Vision {
 
   void Profiler::PrintAverageTiming()
   {
+    std::lock_guard<std::mutex> lock(_mutex);
     for(auto & timerPair : _timers)
     {
       PrintTimerData(timerPair.first, timerPair.second);
@@ -23,6 +23,7 @@
 #endif // ANKI_VISION_PROFILER
 
 #include <chrono>
+#include <mutex>
 #include <unordered_map>
 #include <string>
 #include <cstdint>
@@ -119,6 +120,9 @@ namespace Vision {
     using TimerContainer = std::unordered_map<const char*, Profiler::Timer>;
 
     TimerContainer _timers;
+    
+    // Tic/Toc may be called from multiple threads (on differently-named timers)
+    std::mutex _mutex;
 
     std::string _eventName;
     std::string _printChannelName = "Profiler";
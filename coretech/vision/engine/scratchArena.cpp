@@ -0,0 +1,94 @@
+/**
+ * File: scratchArena.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "coretech/vision/engine/scratchArena.h"
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+
+namespace Anki {
+namespace Vision {
+
+namespace {
+  inline size_t RoundUpToAlignment(size_t numBytes)
+  {
+    return (numBytes + ScratchArena::kAlignment - 1) & ~(ScratchArena::kAlignment - 1);
+  }
+}
+
+ScratchArena::ScratchArena(size_t initialCapacity)
+{
+  SetCapacity(initialCapacity);
+}
+
+void ScratchArena::SetCapacity(size_t capacity)
+{
+  _capacity = RoundUpToAlignment(capacity);
+  _buffer.reset(new u8[_capacity + kAlignment - 1]);
+  const uintptr_t address = reinterpret_cast<uintptr_t>(_buffer.get());
+  _alignedBuffer = _buffer.get() + (RoundUpToAlignment(address) - address);
+  _memoryAccount.Set(_capacity);
+}
+
+void* ScratchArena::Allocate(size_t numBytes)
+{
+  const size_t alignedBytes = RoundUpToAlignment(std::max<size_t>(numBytes, 1));
+
+  // Every caller gets its own range, even if the arena is already used up, so that _used is what the
+  // frame would have needed
+  const size_t offset = _used.fetch_add(alignedBytes);
+  if(offset + alignedBytes <= _capacity)
+  {
+    return _alignedBuffer + offset;
+  }
+
+  // new[] of u8 is only guaranteed to be aligned for fundamental types, so over-allocate for kAlignment
+  std::unique_ptr<u8[]> block(new u8[alignedBytes + kAlignment - 1]);
+  const uintptr_t address = reinterpret_cast<uintptr_t>(block.get());
+  u8* alignedBlock = block.get() + (RoundUpToAlignment(address) - address);
+
+  std::lock_guard<std::mutex> lock(_overflowMutex);
+  _overflowBlocks.push_back(std::move(block));
+  return alignedBlock;
+}
+
+Image ScratchArena::GetImage(s32 numRows, s32 numCols)
+{
+  return Image(numRows, numCols, GetBuffer<u8>(size_t(numRows) * size_t(numCols)));
+}
+
+ImageRGB ScratchArena::GetImageRGB(s32 numRows, s32 numCols)
+{
+  return ImageRGB(numRows, numCols, GetBuffer<u8>(size_t(numRows) * size_t(numCols) * 3));
+}
+
+void ScratchArena::Reset()
+{
+  const size_t used = _used.load();
+  _peakUsage = std::max(_peakUsage, used);
+  _used = 0;
+
+  if(!_overflowBlocks.empty())
+  {
+    _overflowBlocks.clear();
+    ++_numOverflows;
+
+    // Grow to the whole frame's usage plus some headroom, so the next frame like this fits in one go
+    const size_t newCapacity = used + used/4;
+    PRINT_NAMED_INFO("ScratchArena.Reset.Growing", "Frame used %zu bytes of %zu, growing to %zu",
+                     used, _capacity, newCapacity);
+    SetCapacity(newCapacity);
+  }
+}
+
+} // namespace Vision
+} // namespace Anki
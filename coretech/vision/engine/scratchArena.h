@@ -0,0 +1,96 @@
+/**
+ * File: scratchArena.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Per-frame bump allocator for the temporary images and buffers vision modes need while processing
+ *              one image (masks, label images, intermediate results). Everything handed out wraps the arena's
+ *              memory without owning it and is only valid until the next Reset(), which the owner calls once per
+ *              frame. The arena grows to the largest frame it has seen, so after the first few frames nothing
+ *              is allocated on the heap.
+ *
+ *              Getting memory is thread safe, since modes may run in parallel. Reset() is not, and must only be
+ *              called while nothing is using the arena.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Vision_ScratchArena_H__
+#define __Anki_Vision_ScratchArena_H__
+
+#include "coretech/common/shared/array2d.h"
+#include "coretech/vision/engine/image.h"
+#include "util/memoryAccounting/memoryAccounting.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Anki {
+namespace Vision {
+
+class ScratchArena
+{
+public:
+
+  // Enough for a handful of full resolution gray images
+  static constexpr size_t kDefaultCapacity = 2 * 1024 * 1024;
+
+  explicit ScratchArena(size_t initialCapacity = kDefaultCapacity);
+
+  ScratchArena(const ScratchArena&) = delete;
+  ScratchArena& operator=(const ScratchArena&) = delete;
+
+  // Invalidates everything handed out since the last Reset. If the last frame didn't fit, grows to what it used.
+  void Reset();
+
+  // Uninitialized memory, aligned to kAlignment. Once the arena is used up, falls back to the heap until Reset.
+  void* Allocate(size_t numBytes);
+
+  template<class T>
+  T* GetBuffer(size_t numElements) { return reinterpret_cast<T*>(Allocate(numElements * sizeof(T))); }
+
+  // Uninitialized images and arrays backed by the arena. Copies share the arena's memory, so anything that
+  // has to outlive the frame must be cloned.
+  Image    GetImage(s32 numRows, s32 numCols);
+  ImageRGB GetImageRGB(s32 numRows, s32 numCols);
+
+  template<class T>
+  Array2d<T> GetArray2d(s32 numRows, s32 numCols)
+  {
+    return Array2d<T>(numRows, numCols, GetBuffer<T>(size_t(numRows) * size_t(numCols)));
+  }
+
+  size_t GetCapacity()     const { return _capacity; }
+  size_t GetUsage()        const { return _used.load(); }
+  size_t GetPeakUsage()    const { return _peakUsage; }
+
+  // Number of frames that didn't fit in the arena and had to allocate
+  u32    GetNumOverflows() const { return _numOverflows; }
+
+  static constexpr size_t kAlignment = 16;
+
+private:
+
+  void SetCapacity(size_t capacity);
+
+  std::unique_ptr<u8[]> _buffer;
+  u8*                   _alignedBuffer = nullptr;
+  size_t                _capacity = 0;
+  std::atomic<size_t>   _used{0};
+
+  std::mutex                         _overflowMutex;
+  std::vector<std::unique_ptr<u8[]>> _overflowBlocks;
+
+  size_t _peakUsage = 0;
+  u32    _numOverflows = 0;
+
+  Util::MemoryAccount _memoryAccount{Util::MemoryTag::VisionScratch};
+};
+
+} // namespace Vision
+} // namespace Anki
+
+#endif // __Anki_Vision_ScratchArena_H__
@@ -7,6 +7,8 @@
  * Description: Handles undistorting images, given a camera calibration.
  *              Computes and caches undistortion maps by image size on first use, then
  *              uses those for subsequent calls for matching image sizes.
+ *              Maps can be saved per calibration and memory mapped back in, and points can be
+ *              undistorted through a lookup table instead of OpenCV's iterative solve.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -17,24 +19,71 @@
 #include "coretech/vision/engine/image.h"
 #include "coretech/vision/engine/undistorter.h"
 
+#include "util/fileUtils/fileUtils.h"
+
 #include "opencv2/core/core.hpp"
 #include "opencv2/imgproc/imgproc.hpp"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 namespace Anki {
 namespace Vision {
 
-Undistorter::Undistorter(const std::shared_ptr<CameraCalibration>& calib)
-: _calib(calib)
-{
-  
-}
+namespace {
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Undistorter::~Undistorter()
-{
-  
+  const char* const kLogChannelName = "VisionSystem";
+
+  // Saved map files are this header, then map1 (CV_16SC2), then map2 (CV_16UC1), each starting on a
+  // kMapDataAlignment boundary. Bump the version if the layout or the way maps are computed changes.
+  struct MapFileHeader
+  {
+    u32 magic;
+    u32 version;
+    u64 calibHash;
+    s32 nrows;
+    s32 ncols;
+  };
+
+  const u32 kMapFileMagic   = 0x50414d55; // "UMAP"
+  const u32 kMapFileVersion = 1;
+  const size_t kMapDataAlignment = 16;
+  const char* const kMapFilePrefix = "undistortionMaps_";
+
+  // Spacing in pixels of the grid held by a PointLUT. Distortion varies slowly enough that interpolating
+  // between grid points lands within a few hundredths of a pixel of the exact solution.
+  const s32 kPointLUTStep = 8;
+
+  size_t AlignUp(size_t numBytes)
+  {
+    return (numBytes + kMapDataAlignment - 1) & ~(kMapDataAlignment - 1);
+  }
+
+  size_t GetMap1Offset()                   { return AlignUp(sizeof(MapFileHeader)); }
+  size_t GetMap1Size(s32 nrows, s32 ncols) { return (size_t)nrows * (size_t)ncols * 2 * sizeof(s16); }
+  size_t GetMap2Offset(s32 nrows, s32 ncols) { return GetMap1Offset() + AlignUp(GetMap1Size(nrows, ncols)); }
+  size_t GetMap2Size(s32 nrows, s32 ncols) { return (size_t)nrows * (size_t)ncols * sizeof(u16); }
+  size_t GetMapFileSize(s32 nrows, s32 ncols) { return GetMap2Offset(nrows, ncols) + GetMap2Size(nrows, ncols); }
+
+  // 64-bit FNV-1a
+  template<typename T>
+  void HashValue(u64& hash, const T value)
+  {
+    const u8* bytes = reinterpret_cast<const u8*>(&value);
+    for(size_t i=0; i<sizeof(value); ++i)
+    {
+      hash ^= bytes[i];
+      hash *= 0x100000001b3ull;
+    }
+  }
 }
-  
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 struct Undistorter::MapPair
 {
@@ -44,23 +93,81 @@ struct Undistorter::MapPair
   //       is (x,y) points), respectively.
   // For more details, see cv::convertMaps:
   // https://docs.opencv.org/2.4/modules/imgproc/doc/geometric_transformations.html?#convertmaps
-  
+
   cv::Mat map1;
   cv::Mat map2;
+
+  // Set when the maps were loaded from a file: then map1 and map2 are headers into this read only
+  // mapping rather than owning their data
+  void*  mappedData = nullptr;
+  size_t mappedSize = 0;
+
+  ~MapPair()
+  {
+    map1.release();
+    map2.release();
+    if(nullptr != mappedData)
+    {
+      munmap(mappedData, mappedSize);
+    }
+  }
 };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct Undistorter::PointLUT
+{
+  // Undistorted location of every kPointLUTStep'th pixel of the distorted image, row major. The last
+  // row and column of the grid are at or just past the bottom and right edges of the image.
+  s32 numGridRows = 0;
+  s32 numGridCols = 0;
+  std::vector<Point2f> undistortedPoints;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Undistorter::Undistorter(const std::shared_ptr<CameraCalibration>& calib, const std::string& mapCacheDir)
+: _calib(calib)
+, _calibHash(calib ? ComputeCalibrationHash(*calib) : 0)
+, _mapCacheDir(mapCacheDir)
+{
+
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Undistorter::~Undistorter()
+{
+
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u64 Undistorter::ComputeCalibrationHash(const CameraCalibration& calib)
+{
+  u64 hash = 0xcbf29ce484222325ull;
+  HashValue(hash, calib.GetNrows());
+  HashValue(hash, calib.GetNcols());
+  HashValue(hash, calib.GetFocalLength_x());
+  HashValue(hash, calib.GetFocalLength_y());
+  HashValue(hash, calib.GetCenter_x());
+  HashValue(hash, calib.GetCenter_y());
+  HashValue(hash, calib.GetSkew());
+  for(const f32 coeff : calib.GetDistortionCoeffs())
+  {
+    HashValue(hash, coeff);
+  }
+  return hash;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result Undistorter::CacheUndistortionMaps(s32 nrows, s32 ncols)
 {
   MapPair* dummy = nullptr;
   return CacheUndistortionMaps(nrows, ncols, dummy);
 }
-  
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result Undistorter::CacheUndistortionMaps(s32 nrows, s32 ncols, MapPair* &mapPair)
 {
   mapPair = nullptr;
-  
+
   // See if we already have a cached pair of maps for this resolution
   const ResolutionKey resolutionKey(nrows,ncols);
   auto iter = _mapCache.find(resolutionKey);
@@ -68,29 +175,40 @@ Result Undistorter::CacheUndistortionMaps(s32 nrows, s32 ncols, MapPair* &mapPai
   {
     mapPair = iter->second.get();
   }
-  
-  // Compute the maps (and cache them) if we didn't find them
+
+  // Load or compute the maps (and cache them) if we didn't find them
   if(mapPair == nullptr)
   {
+    if(!_calib)
+    {
+      PRINT_NAMED_ERROR("Undistorter.CacheDistortionMaps.NoCalibration", "");
+      return RESULT_FAIL;
+    }
+
     auto emplaceResult = _mapCache.emplace(resolutionKey, std::make_unique<MapPair>());
     DEV_ASSERT(emplaceResult.second, "Undistorter.CacheDistortionMaps.DidNotAddNewMapPairAsExpected");
     mapPair = emplaceResult.first->second.get();
-    
+
+    if(LoadMaps(nrows, ncols, *mapPair))
+    {
+      return RESULT_OK;
+    }
+
     // This follows the same process as in cv::undistort, which is really just a wrapper
     // for cv::initUndistortRectifyMap() and cv::remap().
     mapPair->map1.create(nrows, ncols, CV_16SC2);
     mapPair->map2.create(nrows, ncols, CV_16UC1);
-    
+
     const auto& I = cv::Mat_<double>::eye(3,3);
     const auto& scaledCalib = _calib->GetScaled(nrows, ncols);
-    
+
     // NOTE: has to be double, thus the conversion on the next line
     cv::Mat_<double> K;
     cv::Mat(scaledCalib.GetCalibrationMatrix().get_CvMatx_()).convertTo(K, CV_64F);
-    
+
     // NOTE: has to be double
     const cv::Mat_<double> distCoeffs(cv::Mat(scaledCalib.GetDistortionCoeffs()));
-    
+
     try {
       cv::initUndistortRectifyMap(K, distCoeffs, I, K,
                                   cv::Size(ncols, nrows),
@@ -99,13 +217,239 @@ Result Undistorter::CacheUndistortionMaps(s32 nrows, s32 ncols, MapPair* &mapPai
     } catch (cv::Exception& e) {
       PRINT_NAMED_ERROR("Undistorter.CacheDistortionMaps.OpenCvInitUndistortRectifyMapFailed",
                         "%s", e.what());
+      _mapCache.erase(emplaceResult.first);
+      mapPair = nullptr;
       return RESULT_FAIL;
     }
+
+    SaveMaps(nrows, ncols, *mapPair);
   }
-  
+
   return RESULT_OK;
 }
-  
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::string Undistorter::GetMapFilename(s32 nrows, s32 ncols) const
+{
+  char filename[64];
+  snprintf(filename, sizeof(filename), "%s%016" PRIx64 "_%dx%d.bin", kMapFilePrefix, _calibHash, ncols, nrows);
+  return Util::FileUtils::FullFilePath({_mapCacheDir, filename});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool Undistorter::LoadMaps(s32 nrows, s32 ncols, MapPair& mapPair) const
+{
+  if(_mapCacheDir.empty())
+  {
+    return false;
+  }
+
+  const std::string filename = GetMapFilename(nrows, ncols);
+  const int fd = open(filename.c_str(), O_RDONLY);
+  if(fd < 0)
+  {
+    // Not saved yet for this calibration and size
+    return false;
+  }
+
+  const size_t fileSize = GetMapFileSize(nrows, ncols);
+  void* data = MAP_FAILED;
+  struct stat fileStat;
+  if((0 == fstat(fd, &fileStat)) && ((size_t)fileStat.st_size == fileSize))
+  {
+    data = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd); // the mapping stays valid without the descriptor
+
+  if(MAP_FAILED == data)
+  {
+    PRINT_NAMED_WARNING("Undistorter.LoadMaps.MapFailed", "%s (expected %zu bytes)", filename.c_str(), fileSize);
+    return false;
+  }
+
+  const MapFileHeader* header = static_cast<const MapFileHeader*>(data);
+  if((header->magic != kMapFileMagic) || (header->version != kMapFileVersion) ||
+     (header->calibHash != _calibHash) || (header->nrows != nrows) || (header->ncols != ncols))
+  {
+    PRINT_NAMED_WARNING("Undistorter.LoadMaps.HeaderMismatch", "%s", filename.c_str());
+    munmap(data, fileSize);
+    return false;
+  }
+
+  mapPair.mappedData = data;
+  mapPair.mappedSize = fileSize;
+
+  // remap only reads the maps, so wrapping the read only pages is safe
+  u8* bytes = static_cast<u8*>(data);
+  mapPair.map1 = cv::Mat(nrows, ncols, CV_16SC2, bytes + GetMap1Offset());
+  mapPair.map2 = cv::Mat(nrows, ncols, CV_16UC1, bytes + GetMap2Offset(nrows, ncols));
+
+  PRINT_CH_INFO(kLogChannelName, "Undistorter.LoadMaps.Loaded", "%dx%d from %s", ncols, nrows, filename.c_str());
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void Undistorter::SaveMaps(s32 nrows, s32 ncols, const MapPair& mapPair) const
+{
+  if(_mapCacheDir.empty())
+  {
+    return;
+  }
+
+  if(!ANKI_VERIFY(mapPair.map1.isContinuous() && mapPair.map2.isContinuous() &&
+                  (mapPair.map1.type() == CV_16SC2) && (mapPair.map2.type() == CV_16UC1),
+                  "Undistorter.SaveMaps.UnexpectedMapLayout", ""))
+  {
+    return;
+  }
+
+  if(!Util::FileUtils::CreateDirectory(_mapCacheDir))
+  {
+    PRINT_NAMED_WARNING("Undistorter.SaveMaps.CreateDirectoryFailed", "%s", _mapCacheDir.c_str());
+    return;
+  }
+
+  // Maps for any other calibration won't be used again
+  char hashPrefix[40];
+  snprintf(hashPrefix, sizeof(hashPrefix), "%s%016" PRIx64 "_", kMapFilePrefix, _calibHash);
+  for(const auto& existingFile : Util::FileUtils::FilesInDirectory(_mapCacheDir, false, ".bin"))
+  {
+    if((existingFile.compare(0, strlen(kMapFilePrefix), kMapFilePrefix) == 0) &&
+       (existingFile.compare(0, strlen(hashPrefix), hashPrefix) != 0))
+    {
+      Util::FileUtils::DeleteFile(Util::FileUtils::FullFilePath({_mapCacheDir, existingFile}));
+    }
+  }
+
+  std::vector<u8> contents(GetMapFileSize(nrows, ncols), 0);
+
+  MapFileHeader header;
+  header.magic     = kMapFileMagic;
+  header.version   = kMapFileVersion;
+  header.calibHash = _calibHash;
+  header.nrows     = nrows;
+  header.ncols     = ncols;
+  memcpy(contents.data(), &header, sizeof(header));
+  memcpy(contents.data() + GetMap1Offset(), mapPair.map1.data, GetMap1Size(nrows, ncols));
+  memcpy(contents.data() + GetMap2Offset(nrows, ncols), mapPair.map2.data, GetMap2Size(nrows, ncols));
+
+  const std::string filename = GetMapFilename(nrows, ncols);
+  if(!Util::FileUtils::WriteFileAtomic(filename, contents))
+  {
+    PRINT_NAMED_WARNING("Undistorter.SaveMaps.WriteFailed", "%s", filename.c_str());
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result Undistorter::CachePointLUT(s32 nrows, s32 ncols)
+{
+  if(!_calib)
+  {
+    PRINT_NAMED_ERROR("Undistorter.CachePointLUT.NoCalibration", "");
+    return RESULT_FAIL;
+  }
+
+  const ResolutionKey resolutionKey(nrows,ncols);
+  if(_pointLUTs.find(resolutionKey) != _pointLUTs.end())
+  {
+    return RESULT_OK;
+  }
+
+  auto pointLUT = std::make_unique<PointLUT>();
+  pointLUT->numGridRows = std::max(2, (nrows - 1 + kPointLUTStep - 1) / kPointLUTStep + 1);
+  pointLUT->numGridCols = std::max(2, (ncols - 1 + kPointLUTStep - 1) / kPointLUTStep + 1);
+
+  std::vector<Point2f> gridPoints;
+  gridPoints.reserve(pointLUT->numGridRows * pointLUT->numGridCols);
+  for(s32 i=0; i<pointLUT->numGridRows; ++i)
+  {
+    for(s32 j=0; j<pointLUT->numGridCols; ++j)
+    {
+      gridPoints.emplace_back(j*kPointLUTStep, i*kPointLUTStep);
+    }
+  }
+
+  // One call to OpenCV's solve for the whole grid
+  const Result result = UndistortPoints(_calib, nrows, ncols, gridPoints, pointLUT->undistortedPoints);
+  if(RESULT_OK != result)
+  {
+    PRINT_NAMED_ERROR("Undistorter.CachePointLUT.UndistortGridFailed", "%dx%d", ncols, nrows);
+    return result;
+  }
+
+  _pointLUTs.emplace(resolutionKey, std::move(pointLUT));
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result Undistorter::UndistortPoints(const s32 nrows, const s32 ncols,
+                                    const std::vector<Point2f>& distortedPointsIn,
+                                    std::vector<Point2f>& undistortedPointsOut) const
+{
+  undistortedPointsOut.clear();
+
+  auto iter = _pointLUTs.find(ResolutionKey(nrows,ncols));
+  if(iter == _pointLUTs.end())
+  {
+    // No table for this size, just call static version with member calibration
+    return Undistorter::UndistortPoints(_calib, nrows, ncols, distortedPointsIn, undistortedPointsOut);
+  }
+
+  const PointLUT& pointLUT = *iter->second;
+  const f32 maxX = (f32)(ncols - 1);
+  const f32 maxY = (f32)(nrows - 1);
+
+  std::vector<size_t>  outsideIndices;
+  std::vector<Point2f> outsidePoints;
+
+  undistortedPointsOut.reserve(distortedPointsIn.size());
+  for(const auto& point : distortedPointsIn)
+  {
+    if(point.x() < 0.f || point.x() > maxX || point.y() < 0.f || point.y() > maxY)
+    {
+      // Table doesn't cover this point, solve for it below
+      outsideIndices.push_back(undistortedPointsOut.size());
+      outsidePoints.push_back(point);
+      undistortedPointsOut.push_back(point);
+      continue;
+    }
+
+    // Bilinear interpolation between the four surrounding grid points
+    const f32 gridX = point.x() / (f32)kPointLUTStep;
+    const f32 gridY = point.y() / (f32)kPointLUTStep;
+    const s32 j = std::min((s32)gridX, pointLUT.numGridCols - 2);
+    const s32 i = std::min((s32)gridY, pointLUT.numGridRows - 2);
+    const f32 alphaX = gridX - (f32)j;
+    const f32 alphaY = gridY - (f32)i;
+
+    const Point2f* topRow    = pointLUT.undistortedPoints.data() + i*pointLUT.numGridCols + j;
+    const Point2f* bottomRow = topRow + pointLUT.numGridCols;
+
+    const f32 topX    = topRow[0].x()    + alphaX*(topRow[1].x()    - topRow[0].x());
+    const f32 topY    = topRow[0].y()    + alphaX*(topRow[1].y()    - topRow[0].y());
+    const f32 bottomX = bottomRow[0].x() + alphaX*(bottomRow[1].x() - bottomRow[0].x());
+    const f32 bottomY = bottomRow[0].y() + alphaX*(bottomRow[1].y() - bottomRow[0].y());
+
+    undistortedPointsOut.emplace_back(topX + alphaY*(bottomX - topX), topY + alphaY*(bottomY - topY));
+  }
+
+  if(!outsidePoints.empty())
+  {
+    std::vector<Point2f> solvedPoints;
+    const Result result = Undistorter::UndistortPoints(_calib, nrows, ncols, outsidePoints, solvedPoints);
+    if(RESULT_OK != result)
+    {
+      return result;
+    }
+    for(size_t k=0; k<outsideIndices.size(); ++k)
+    {
+      undistortedPointsOut[outsideIndices[k]] = solvedPoints[k];
+    }
+  }
+
+  return RESULT_OK;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template<class T>
 Result Undistorter::UndistortImageHelper(const ImageBase<T>& img, ImageBase<T>& undistortedImage)
@@ -7,6 +7,8 @@
  * Description: Handles undistorting images, given a camera calibration.
  *              Computes and caches undistortion maps by image size on first use, then
  *              uses those for subsequent calls for matching image sizes.
+ *              Maps can be saved per calibration and memory mapped back in, and points can be
+ *              undistorted through a lookup table instead of OpenCV's iterative solve.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -16,6 +18,8 @@
 
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace Anki {
 namespace Vision {
@@ -29,28 +33,35 @@ class ImageRGB;
 class Undistorter
 {
 public:
-  Undistorter(const std::shared_ptr<CameraCalibration>& calib);
+  // If mapCacheDir is not empty, maps are loaded from files there when one matches the calibration and
+  // size, and written there after being computed. Files are named by calibration hash and image size.
+  Undistorter(const std::shared_ptr<CameraCalibration>& calib, const std::string& mapCacheDir = "");
   virtual ~Undistorter();
   
   // Pre-cache undistortion maps for a given image size (does nothing if they already exist)
   Result CacheUndistortionMaps(s32 nrows, s32 ncols);
   
-  // TODO: Provide ability to load from / save to disk (question: how to store per calibration?)
-  //Result Save(const std::string& filename);
-  //Result Load(const std::string& filename);
+  // Hash of the calibration's size, intrinsics and distortion coefficients
+  u64 GetCalibrationHash() const { return _calibHash; }
+  static u64 ComputeCalibrationHash(const CameraCalibration& calib);
+  
+  // Pre-cache a table of undistorted points on a coarse grid over an (nrows x ncols) image, which the
+  // non-static UndistortPoint(s) then interpolate into instead of solving for each point
+  Result CachePointLUT(s32 nrows, s32 ncols);
   
   // Will compute and cache distortion maps if needed, or used pre-cached ones if available
   Result UndistortImage(const ImageRGB& img, ImageRGB& undistortedImage);
   Result UndistortImage(const Image&    img, Image&    undistortedImage);
   
   // Undistort one or more points from an (nrows x ncols) image. Scales calibration as needed.
+  // Uses the point LUT for this size if one was cached, except for points outside the image.
   Result UndistortPoint(const s32 nrows, const s32 ncols,
                         const Point2f& distortedPointIn,
-                        Point2f& undistortedPointOut);
+                        Point2f& undistortedPointOut) const;
   
   Result UndistortPoints(const s32 nrows, const s32 ncols,
                          const std::vector<Point2f>& distortedPointsIn,
-                         std::vector<Point2f>& undistortedPointsOut);
+                         std::vector<Point2f>& undistortedPointsOut) const;
   
   // Static versions if you just want to pass in the calibration instead of having
   // an instantiated Undistorter laying around
@@ -66,13 +77,22 @@ public:
 private:
   
   std::shared_ptr<CameraCalibration> _calib;
+  u64 _calibHash = 0;
+  std::string _mapCacheDir;
 
   using ResolutionKey = std::pair<s32, s32>; // first=nrows, second=ncols
   struct MapPair;
   std::map<ResolutionKey, std::unique_ptr<MapPair>> _mapCache;
   
+  struct PointLUT;
+  std::map<ResolutionKey, std::unique_ptr<PointLUT>> _pointLUTs;
+  
   Result CacheUndistortionMaps(s32 nrows, s32 ncols, MapPair* &mapPair);
   
+  std::string GetMapFilename(s32 nrows, s32 ncols) const;
+  bool LoadMaps(s32 nrows, s32 ncols, MapPair& mapPair) const;
+  void SaveMaps(s32 nrows, s32 ncols, const MapPair& mapPair) const;
+  
   template<class T>
   Result UndistortImageHelper(const ImageBase<T>& img, ImageBase<T>& undistortedImage);
   
@@ -85,19 +105,15 @@ private:
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 inline Result Undistorter::UndistortPoint(const s32 nrows, const s32 ncols,
                                           const Point2f& distortedPointIn,
-                                          Point2f& undistortedPointOut)
-{
-  // Just call static version with member calibration
-  return Undistorter::UndistortPoint(_calib, nrows, ncols, distortedPointIn, undistortedPointOut);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-inline Result Undistorter::UndistortPoints(const s32 nrows, const s32 ncols,
-                                           const std::vector<Point2f>& distortedPointsIn,
-                                           std::vector<Point2f>& undistortedPointsOut)
+                                          Point2f& undistortedPointOut) const
 {
-  // Just call static version with member calibration
-  return Undistorter::UndistortPoints(_calib, nrows, ncols, distortedPointsIn, undistortedPointsOut);
+  std::vector<Point2f> undistortedPoints;
+  const Result result = UndistortPoints(nrows, ncols, {distortedPointIn}, undistortedPoints);
+  if(RESULT_OK == result)
+  {
+    undistortedPointOut = undistortedPoints.front();
+  }
+  return result;
 }
   
 } // namespace Vision
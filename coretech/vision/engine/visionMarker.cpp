@@ -252,10 +252,7 @@ namespace Anki {
         atDistance = std::fmin(atDistance, corner.z());
       }
 
-      if(camera.IsOccluded(imgCorners[TopLeft]    , atDistance) ||
-         camera.IsOccluded(imgCorners[TopRight]   , atDistance) ||
-         camera.IsOccluded(imgCorners[BottomLeft] , atDistance) ||
-         camera.IsOccluded(imgCorners[BottomRight], atDistance))
+      if(camera.IsAnyCornerOccluded(imgCorners, atDistance))
       {
         reason = NotVisibleReason::OCCLUDED;
         return false;
@@ -340,6 +337,64 @@ namespace Anki {
 #     endif // if NUM_AVERAGE_POSES > 1
       
     } // EstimateObservedPose()
+    
+    Result KnownMarker::EstimateObservedPoses(const std::vector<MarkerPair>& matches,
+                                              std::vector<Pose3d>& poses)
+    {
+      poses.clear();
+      poses.reserve(matches.size());
+      
+#     if NUM_AVERAGE_POSES > 1
+      
+      for(const auto& match : matches)
+      {
+        Pose3d pose;
+        const Result result = match.second->EstimateObservedPose(*match.first, pose);
+        if(RESULT_OK != result) {
+          return result;
+        }
+        poses.push_back(std::move(pose));
+      }
+      
+#     else
+      
+      std::vector<Camera::QuadCorrespondence> quads;
+      std::vector<Pose3d> batchPoses;
+      
+      auto batchBegin = matches.begin();
+      while(batchBegin != matches.end())
+      {
+        const Camera& camera = batchBegin->first->GetSeenBy();
+        const CameraCalibration* calib = camera.GetCalibration().get();
+        
+        quads.clear();
+        auto batchEnd = batchBegin;
+        while((batchEnd != matches.end()) && (batchEnd->first->GetSeenBy().GetCalibration().get() == calib))
+        {
+          quads.emplace_back(&batchEnd->first->GetImageCorners(), &batchEnd->second->Get3dCorners());
+          ++batchEnd;
+        }
+        
+        const Result result = camera.ComputeObjectPoses(quads, batchPoses);
+        if(RESULT_OK != result) {
+          return result;
+        }
+        
+        // The poses only depend on the calibration, so each one can be made w.r.t. the camera pose of the marker it
+        // came from, even if that isn't the camera the batch was computed with
+        for(auto & pose : batchPoses)
+        {
+          pose.SetParent(batchBegin->first->GetSeenBy().GetPose());
+          poses.push_back(std::move(pose));
+          ++batchBegin;
+        }
+      }
+      
+#     endif // if NUM_AVERAGE_POSES > 1
+      
+      return RESULT_OK;
+      
+    } // EstimateObservedPoses()
 
     const char* NotVisibleReasonToString(KnownMarker::NotVisibleReason reason)
     {
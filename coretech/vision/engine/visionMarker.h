@@ -16,6 +16,7 @@
 #include "coretech/common/engine/math/quad_impl.h"
 #include "coretech/common/engine/math/pose.h"
 #include "coretech/vision/engine/camera.h"
+#include "util/container/smallVector.h"
 
 namespace Anki {
   namespace Vision{
@@ -83,6 +84,10 @@ namespace Anki {
       
     }; // class ObservedMarker
     
+    // Markers seen in one image. Rebuilt every frame and rarely more than a handful, so kept inline to avoid
+    // allocating per marker (or per frame) on the vision thread.
+    using ObservedMarkerList = Util::SmallVector<ObservedMarker, 8>;
+    
     
     class KnownMarker : public Marker
     {
@@ -93,6 +98,13 @@ namespace Anki {
       Result EstimateObservedPose(const ObservedMarker& obsMarker,
                                   Pose3d& pose) const;
       
+      // Same as above for a batch of observed/known marker pairs, e.g. all the matches for one object in one image.
+      // Consecutive pairs seen by cameras with the same calibration are estimated together. poses[i] is w.r.t. the
+      // camera that saw matches[i].first. Returns the first failure, in which case poses is incomplete.
+      using MarkerPair = std::pair<const ObservedMarker*, const KnownMarker*>;
+      static Result EstimateObservedPoses(const std::vector<MarkerPair>& matches,
+                                          std::vector<Pose3d>& poses);
+      
       // Update this marker's pose and, in turn, its 3d corners' locations.
       //
       // Note that it is your responsibility to make sure the new pose has the
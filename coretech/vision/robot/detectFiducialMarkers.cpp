@@ -17,6 +17,13 @@ For internal use only. No part of this code may be used without a signed non-dis
 
 #include "coretech/common/robot/matlabInterface.h"
 
+#include "util/dispatchQueue/taskPool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
 #if RECOGNITION_METHOD == RECOGNITION_METHOD_NEAREST_NEIGHBOR
 #  define NEAREST_NEIGHBOR_DISTANCE_THRESHOLD 50 // TODO: Make this a VisionParameter and pass it in dynamically
 #endif
@@ -104,6 +111,193 @@ namespace Anki
     
 
     
+    // Refines and decodes one candidate quad. Only touches currentMarker, and the pixels of image inside the marker's
+    // ROI, which illumination normalization filters and then restores.
+    static void DecodeMarker(VisionMarker &currentMarker,
+                             const s32 iMarker,
+                             const s32 numMarkers,
+                             const Array<u8> &image,
+                             cv::Mat_<u8> &cvImage,
+                             const FiducialDetectionParameters &params,
+                             const bool isDarkOnLight,
+                             MemoryStack scratch)
+    {
+      Result lastResult;
+
+      // meanGrayvalueThreshold is computed by currentMarker.RefineCorners(), then used by currentMarker.Extract()
+      u8 meanGrayvalueThreshold;
+
+      cv::Mat_<u8> cvImageROI, cvImageROI_orig;
+      if(params.useIlluminationNormalization)
+      {
+        lastResult = IlluminationNormalization(currentMarker.corners, params.fiducialThicknessFraction, cvImage, cvImageROI, cvImageROI_orig);
+        if(lastResult != RESULT_OK) {
+          AnkiWarn("DetectFiducialMarkers", "Illumination normalization failed, skipping marker %d", iMarker);
+          return;
+        }
+      }
+      
+      if(currentMarker.validity == VisionMarker::UNKNOWN) {
+        // If refine_quadRefinementIterations > 0, then make this marker's corners more accurate
+        lastResult = currentMarker.RefineCorners(image,
+                                                 params.decode_minContrastRatio,
+                                                 params.refine_quadRefinementIterations,
+                                                 params.refine_numRefinementSamples,
+                                                 params.refine_quadRefinementMaxCornerChange,
+                                                 params.refine_quadRefinementMinCornerChange,
+                                                 params.quads_minQuadArea,
+                                                 params.quads_quadSymmetryThreshold,
+                                                 params.quads_minDistanceFromImageEdge,
+                                                 params.fiducialThicknessFraction,
+                                                 params.roundedCornersFraction,
+                                                 isDarkOnLight,
+                                                 meanGrayvalueThreshold,
+                                                 scratch);
+
+        if(params.useIlluminationNormalization)
+        {
+          // Put back the original (non-illumination-normalized) pixel values within the ROI
+          cvImageROI_orig.copyTo(cvImageROI);
+        }
+        
+        if(lastResult == RESULT_OK) {
+          // Refinement succeeded...
+          if(currentMarker.validity == VisionMarker::LOW_CONTRAST) {
+            // ... but there wasn't enough contrast to use the marker
+            currentMarker.markerType = Anki::Vision::MARKER_UNKNOWN;
+          } else if(params.doCodeExtraction) {
+            // ... and there was enough contrast, so proceed with with decoding
+            // the marker
+            lastResult = currentMarker.Extract(image,
+#if RECOGNITION_METHOD == RECOGNITION_METHOD_NEAREST_NEIGHBOR
+                                               NEAREST_NEIGHBOR_DISTANCE_THRESHOLD,
+#                                                else
+                                               meanGrayvalueThreshold,
+#                                                endif
+                                               params.decode_minContrastRatio,
+                                               scratch);
+            
+            AnkiConditionalWarn(lastResult == RESULT_OK, "DetectFiducialMarkers",
+                                "Marker extraction for quad %d of %d failed",
+                                iMarker, numMarkers);
+
+            if (currentMarker.markerType == Vision::MARKER_INVALID && !params.returnInvalidMarkers) {
+              currentMarker.validity = VisionMarker::UNKNOWN;
+            }
+            
+          } else {
+            currentMarker.markerType = Vision::MARKER_UNKNOWN;
+            currentMarker.validity = VisionMarker::VALID_BUT_NOT_DECODED;
+          }
+        } else {
+          currentMarker.validity = VisionMarker::REFINEMENT_FAILURE;
+          currentMarker.markerType = Anki::Vision::MARKER_UNKNOWN;
+        }
+      } else { // if(currentMarker.validity == VisionMarker::UNKNOWN)
+        // Put back the original (non-illumination-normalized) pixel values within the ROI
+        cvImageROI_orig.copyTo(cvImageROI);
+      }
+    } // DecodeMarker()
+
+
+    // Decodes each marker, spread over up to params.decode_numThreads threads (this one included). Markers are
+    // independent, except that illumination normalization filters the image in place, so every extra thread works on
+    // its own copy of the image. Each thread also gets its own slice of scratch, as MemoryStacks aren't thread safe.
+    static Result DecodeMarkers(const Array<u8> &image,
+                                FixedLengthList<VisionMarker> &markers,
+                                const FiducialDetectionParameters &params,
+                                const bool isDarkOnLight,
+                                MemoryStack scratch)
+    {
+      const s32 numMarkers = markers.get_size();
+
+      // The benchmarking events are global, so keep to one thread when they're compiled in
+      s32 numThreads = ANKI_EMBEDDED_BENCHMARK ? 1 : MIN(params.decode_numThreads, numMarkers);
+
+      struct ThreadData {
+        Array<u8> image;
+        MemoryStack scratch;
+      };
+      std::vector<ThreadData> extraThreads;
+
+      if(numThreads > 1) {
+        const s32 imageHeight = image.get_size(0);
+        const s32 imageWidth = image.get_size(1);
+        extraThreads.resize(numThreads - 1);
+        for(ThreadData& thread : extraThreads) {
+          thread.image = Array<u8>(imageHeight, imageWidth, scratch, Flags::Buffer(false,false,false));
+          if(!thread.image.IsValid() || (thread.image.Set(image) != imageHeight*imageWidth)) {
+            numThreads = 1;
+            break;
+          }
+        }
+
+        // Split what's left evenly, this thread keeps the remainder of scratch
+        const s32 sliceBytes = (scratch.ComputeLargestPossibleAllocation() / numThreads) - MEMORY_ALIGNMENT;
+        for(s32 iThread = 0; (numThreads > 1) && (iThread < (numThreads - 1)); iThread++) {
+          void* sliceBuffer = (sliceBytes > 0) ? scratch.Allocate(sliceBytes) : NULL;
+          if(sliceBuffer == NULL) {
+            numThreads = 1;
+            break;
+          }
+          extraThreads[iThread].scratch = MemoryStack(sliceBuffer, sliceBytes);
+        }
+
+        AnkiConditionalWarn(numThreads > 1, "DetectFiducialMarkers.DecodeMarkers.NotEnoughScratch",
+                            "Decoding %d markers on one thread", numMarkers);
+      }
+
+      // Wrap a cv::Mat around the image data
+      // NOTE: This will permit us to modify the image, despite the input
+      //  Array2d obect being a const reference!!!
+      cv::Mat_<u8> cvImage;
+      ArrayToCvMat(image, &cvImage);
+
+      if(numThreads <= 1) {
+        for(s32 iMarker=0; iMarker<numMarkers; iMarker++) {
+          DecodeMarker(markers[iMarker], iMarker, numMarkers, image, cvImage, params, isDarkOnLight, scratch);
+        }
+        return RESULT_OK;
+      }
+
+      // Every thread, this one included, takes the next undecoded marker until there are none left
+      std::atomic<s32> nextMarker(0);
+      auto decodeLoop = [&](const Array<u8>& threadImage, cv::Mat_<u8>& threadCvImage, MemoryStack threadScratch) {
+        s32 iMarker;
+        while((iMarker = nextMarker.fetch_add(1)) < numMarkers) {
+          DecodeMarker(markers[iMarker], iMarker, numMarkers, threadImage, threadCvImage, params, isDarkOnLight, threadScratch);
+        }
+      };
+
+      std::mutex doneMutex;
+      std::condition_variable doneCondition;
+      s32 numRunning = numThreads - 1;
+
+      Util::TaskPool& pool = Util::TaskPool::GetShared();
+      for(ThreadData& thread : extraThreads) {
+        ThreadData* threadData = &thread;
+        pool.Submit([&, threadData]() {
+          cv::Mat_<u8> threadCvImage;
+          ArrayToCvMat(threadData->image, &threadCvImage);
+          decodeLoop(threadData->image, threadCvImage, threadData->scratch);
+
+          std::lock_guard<std::mutex> lock(doneMutex);
+          if(--numRunning == 0) {
+            doneCondition.notify_one();
+          }
+        });
+      }
+
+      decodeLoop(image, cvImage, scratch);
+
+      // Everything the tasks use lives on this stack, so wait for them even once every marker has been claimed
+      std::unique_lock<std::mutex> lock(doneMutex);
+      doneCondition.wait(lock, [&numRunning]() { return numRunning == 0; });
+
+      return RESULT_OK;
+    } // DecodeMarkers()
+
+
     Result DetectFiducialMarkers(const Array<u8> &image,
                                  FixedLengthList<VisionMarker> &markers,
                                  const FiducialDetectionParameters &params,
@@ -348,93 +542,9 @@ namespace Anki
 
       BeginBenchmark("ExtractVisionMarker");
 
-      // refinedHomography and meanGrayvalueThreshold are computed by currentMarker.RefineCorners(), then used by currentMarker.Extract()
-      Array<f32> refinedHomography(3, 3, scratchOnchip);
-      u8 meanGrayvalueThreshold;
-
-      // Wrap a cv::Mat around the image data
-      // NOTE: This will permit us to modify the image, despite the input
-      //  Array2d obect being a const reference!!!
-      cv::Mat_<u8> cvImage;
-      ArrayToCvMat(image, &cvImage);
-      
-      for(s32 iMarker=0; iMarker<markers.get_size(); iMarker++)
-      {
-        VisionMarker &currentMarker = markers[iMarker];
-        
-        cv::Mat_<u8> cvImageROI, cvImageROI_orig;
-        if(params.useIlluminationNormalization)
-        {
-          lastResult = IlluminationNormalization(currentMarker.corners, params.fiducialThicknessFraction, cvImage, cvImageROI, cvImageROI_orig);
-          if(lastResult != RESULT_OK) {
-            AnkiWarn("DetectFiducialMarkers", "Illumination normalization failed, skipping marker %d", iMarker);
-            continue;
-          }
-        }
-        
-        if(currentMarker.validity == VisionMarker::UNKNOWN) {
-          // If refine_quadRefinementIterations > 0, then make this marker's corners more accurate
-          lastResult = currentMarker.RefineCorners(image,
-                                                   params.decode_minContrastRatio,
-                                                   params.refine_quadRefinementIterations,
-                                                   params.refine_numRefinementSamples,
-                                                   params.refine_quadRefinementMaxCornerChange,
-                                                   params.refine_quadRefinementMinCornerChange,
-                                                   params.quads_minQuadArea,
-                                                   params.quads_quadSymmetryThreshold,
-                                                   params.quads_minDistanceFromImageEdge,
-                                                   params.fiducialThicknessFraction,
-                                                   params.roundedCornersFraction,
-                                                   isDarkOnLight,
-                                                   meanGrayvalueThreshold,
-                                                   scratchOnchip);
-
-          if(params.useIlluminationNormalization)
-          {
-            // Put back the original (non-illumination-normalized) pixel values within the ROI
-            cvImageROI_orig.copyTo(cvImageROI);
-          }
-          
-          if(lastResult == RESULT_OK) {
-            // Refinement succeeded...
-            if(currentMarker.validity == VisionMarker::LOW_CONTRAST) {
-              // ... but there wasn't enough contrast to use the marker
-              currentMarker.markerType = Anki::Vision::MARKER_UNKNOWN;
-            } else if(params.doCodeExtraction) {
-              // ... and there was enough contrast, so proceed with with decoding
-              // the marker
-              lastResult = currentMarker.Extract(image,
-#if RECOGNITION_METHOD == RECOGNITION_METHOD_NEAREST_NEIGHBOR
-                                                 NEAREST_NEIGHBOR_DISTANCE_THRESHOLD,
-#                                                else
-                                                 meanGrayvalueThreshold,
-#                                                endif
-                                                 params.decode_minContrastRatio,
-                                                 scratchOnchip);
-              
-              AnkiConditionalWarn(lastResult == RESULT_OK, "DetectFiducialMarkers",
-                                  "Marker extraction for quad %d of %d failed",
-                                  iMarker, markers.get_size());
-
-              if (currentMarker.markerType == Vision::MARKER_INVALID && !params.returnInvalidMarkers) {
-                currentMarker.validity = VisionMarker::UNKNOWN;
-              }
-              
-            } else {
-              currentMarker.markerType = Vision::MARKER_UNKNOWN;
-              currentMarker.validity = VisionMarker::VALID_BUT_NOT_DECODED;
-            }
-          } else {
-            currentMarker.validity = VisionMarker::REFINEMENT_FAILURE;
-            currentMarker.markerType = Anki::Vision::MARKER_UNKNOWN;
-          }
-        } else { // if(currentMarker.validity == VisionMarker::UNKNOWN)
-          // Put back the original (non-illumination-normalized) pixel values within the ROI
-          cvImageROI_orig.copyTo(cvImageROI);
-        }
-
-        
-      } // for(s32 iMarker=0; iMarker<markers.get_size(); iMarker++)
+      if((lastResult = DecodeMarkers(image, markers, params, isDarkOnLight, scratchOnchip)) != RESULT_OK) {
+        return lastResult;
+      }
 
       // Remove invalid markers from the list
       if(!params.returnInvalidMarkers) {
@@ -1299,7 +1299,7 @@ namespace Anki
       
       std::string className;
       size_t classLabel;
-      static cv::Mat_<u8> _probeValues(VisionMarker::GRIDSIZE, VisionMarker::GRIDSIZE);
+      static thread_local cv::Mat_<u8> _probeValues(VisionMarker::GRIDSIZE, VisionMarker::GRIDSIZE);
       VisionMarker::GetProbeValues(image, homography, true, _probeValues);
       lastResult = cnn.Run(_probeValues, classLabel, className);
       
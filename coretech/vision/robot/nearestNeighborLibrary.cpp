@@ -26,8 +26,7 @@ namespace Embedded {
                                                  const s16* probeCenters_X, const s16* probeCenters_Y,
                                                  const s16* probePoints_X, const s16* probePoints_Y,
                                                  const s32 numProbePoints, const s32 numFractionalBits)
-  : _probeValues(1, dataDim)
-  , _data(numDataPoints, dataDim)
+  : _data(numDataPoints, dataDim)
   , _numDataPoints(numDataPoints)
   , _dataDimension(dataDim)
   , _labels(1, numDataPoints)
@@ -67,8 +66,7 @@ namespace Embedded {
                                                  const s16* probeCenters_X, const s16* probeCenters_Y,
                                                  const s16* probePoints_X, const s16* probePoints_Y,
                                                  const s32 numProbePoints, const s32 numFractionalBits)
-  : _probeValues(1, dataDim)
-  , _data(numDataPoints, dataDim)
+  : _data(numDataPoints, dataDim)
   , _numDataPoints(numDataPoints)
   , _dataDimension(dataDim)
   , _labels(1, numDataPoints, const_cast<u16*>(labels))
@@ -89,9 +87,13 @@ namespace Embedded {
     s32 closestIndex = -1;
     s32 secondClosestIndex = -1;
   
+    // Per thread, so markers can be decoded on several threads against the one shared library
+    static thread_local cv::Mat_<u8> probeValues;
+    probeValues.create(1, _dataDimension);
+    
     Result lastResult = VisionMarker::GetProbeValues(image, homography,
                                                      false, //USE_ILLUMINATION_NORMALIZATION,
-                                                     _probeValues);
+                                                     probeValues);
     
     AnkiConditionalErrorAndReturnValue(lastResult == RESULT_OK, lastResult,
                                        "NearestNeighborLibrary.GetNearestNeighbor.GetProbesFailed",
@@ -102,12 +104,12 @@ namespace Embedded {
     closestDistance = distThreshold;
     s32 secondClosestDistance = std::numeric_limits<s32>::max();
     
-    cv::normalize(_probeValues, _probeValues, 255, 0, CV_MINMAX);
+    cv::normalize(probeValues, probeValues, 255, 0, CV_MINMAX);
     
     cv::Mat_<u8> diffImage, bestDiffImage, secondBestDiffImage;
     for(s32 iExample=0; iExample<_numDataPoints; ++iExample)
     {
-      cv::absdiff(_probeValues, _data.row(iExample), diffImage);
+      cv::absdiff(probeValues, _data.row(iExample), diffImage);
       
       const s32 currentDistance = cv::sum(diffImage)[0] / _dataDimension;
       
@@ -148,7 +150,7 @@ namespace Embedded {
         // change
         const u8* restrict example1 = _data[closestIndex];
         const u8* restrict example2 = _data[secondClosestIndex];
-        const u8* restrict probeData = _probeValues[0];
+        const u8* restrict probeData = probeValues[0];
         s32 count = 0;
         maskedDist = 0;
         for(s32 i=0; i<_dataDimension; ++i)
@@ -183,7 +185,7 @@ namespace Embedded {
         const s32 dispSize = 256;
  
         cv::Mat probeDisp;
-        cv::resize(_probeValues.reshape(0, VisionMarker::GRIDSIZE), probeDisp,
+        cv::resize(probeValues.reshape(0, VisionMarker::GRIDSIZE), probeDisp,
                    cv::Size(dispSize,dispSize));
         cv::imshow("Probes", probeDisp);
         
@@ -55,7 +55,6 @@ namespace Embedded {
     
   protected:
     
-    cv::Mat_<u8> _probeValues;
     cv::Mat_<u8> _data;    // numDataPoints rows x dataDimension cols
     
     s32 _numDataPoints;
@@ -20,6 +20,8 @@
 #include "util/helpers/templateHelpers.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+
 #define LOG_CHANNEL "CompositeImage"
 
 namespace Anki {
@@ -43,6 +45,20 @@ const std::string kEmptyBoxLayout = R"json(
       }
     ]
     })json";
+
+// Smallest rectangle containing both, where an empty rectangle contains nothing
+Rectangle<s32> GetBoundingRect(const Rectangle<s32>& a, const Rectangle<s32>& b)
+{
+  if(a.Area() <= 0){
+    return b;
+  }
+  if(b.Area() <= 0){
+    return a;
+  }
+  const Point2<s32> topLeft(std::min(a.GetX(), b.GetX()), std::min(a.GetY(), b.GetY()));
+  const Point2<s32> bottomRight(std::max(a.GetXmax(), b.GetXmax()), std::max(a.GetYmax(), b.GetYmax()));
+  return Rectangle<s32>(topLeft, bottomRight);
+}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -272,109 +288,228 @@ void CompositeImage::OverlayImageWithFrame(ImageRGBA& baseImage,
     if(layersToIgnore.find(layerName) != layersToIgnore.end()){
       return;
     }
-    // If implementation quad was found, draw it into the image at the point
-    // specified by the layout quad def
-    Vision::SpriteHandle handle;
-    if(spriteEntry.ContentIsValid() &&
-       spriteEntry.GetFrame(frameIdx, handle)){
-      Point2i topCornerInt = {};
-      int width = 0;
-      int height = 0;
-      spriteBox.GetPositionForFrame(frameIdx, topCornerInt, width, height);
-      Point2f topCorner = {static_cast<float>(topCornerInt.x()), static_cast<float>(topCornerInt.y())};
-      // Always use the faster 'draw blank pixels' rendering on the first
-      // image, since it's always drawn over the initial blank image
-      const bool drawBlankPixels = firstImage;
+    // Always use the faster 'draw blank pixels' rendering on the first
+    // image, since it's always drawn over the initial blank image
+    if(DrawSpriteBoxFrame(baseImage, {0,0}, layerName, spriteBoxName, spriteBox, spriteEntry, frameIdx, firstImage)){
+      firstImage = false;
+    }
+  };
+  ProcessAllSpriteBoxes(callback);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Rectangle<s32> CompositeImage::OverlayImageWithFrameIncremental(IncrementalRender& render, const u32 frameIdx) const
+{
+  ANKI_CPU_PROFILE("CompositeImage::OverlayImageWithFrameIncremental");
+
+  // Work out what every sprite box draws this frame
+  IncrementalRender::DrawnSpriteBoxMap drawn;
+  auto getDrawnCallback = [this, &frameIdx, &drawn](Vision::LayerName layerName, SpriteBoxName spriteBoxName,
+                                                    const SpriteBox& spriteBox, const SpriteEntry& spriteEntry){
+    IncrementalRender::DrawnSpriteBox box;
+    if(!spriteEntry.ContentIsValid() || !spriteEntry.GetFrame(frameIdx, box.sprite)){
+      box.sprite.reset();
+    }
+
+    Point2i topCorner;
+    int width = 0;
+    int height = 0;
+    spriteBox.GetPositionForFrame(frameIdx, topCorner, width, height);
+    box.rect = Rectangle<s32>(topCorner.x(), topCorner.y(), width, height);
+
+    box.renderMethod = spriteBox.renderConfig.renderMethod;
+    box.hue = spriteBox.renderConfig.hue;
+    box.saturation = spriteBox.renderConfig.saturation;
+    const bool rendersInEyeHue = (box.renderMethod == SpriteRenderMethod::CustomHue) &&
+                                 (box.hue == 0) && (box.saturation == 0) &&
+                                 (_faceHSImageHandle != nullptr);
+    if(rendersInEyeHue){
+      box.hue = _faceHSImageHandle->GetHue();
+      box.saturation = _faceHSImageHandle->GetSaturation();
+    }
+
+    drawn.emplace(std::make_pair(layerName, spriteBoxName), std::move(box));
+  };
+  ProcessAllSpriteBoxes(getDrawnCallback);
+
+  // Anything drawn differently than last time damages both where it was and where it is now. This uses the sprite
+  // box positions, so it relies on sprites being the size of their boxes (which dev builds verify when drawing)
+  const Rectangle<s32> fullRect(0, 0, _width, _height);
+  Rectangle<s32> damage;
+  const bool renderAll = !render.isValid || (render.image.GetNumRows() != _height) ||
+                         (render.image.GetNumCols() != _width);
+  if(renderAll){
+    if((render.image.GetNumRows() != _height) || (render.image.GetNumCols() != _width)){
+      render.image.Allocate(_height, _width);
+    }
+    damage = fullRect;
+  }else{
+    for(const auto& entry : drawn){
+      const auto iter = render.drawnSpriteBoxes.find(entry.first);
+      if(iter == render.drawnSpriteBoxes.end()){
+        damage = GetBoundingRect(damage, entry.second.rect);
+      }else if(!(iter->second == entry.second)){
+        damage = GetBoundingRect(damage, iter->second.rect);
+        damage = GetBoundingRect(damage, entry.second.rect);
+      }
+    }
+    for(const auto& entry : render.drawnSpriteBoxes){
+      if(drawn.find(entry.first) == drawn.end()){
+        damage = GetBoundingRect(damage, entry.second.rect);
+      }
+    }
+    damage = damage.Intersect(fullRect);
+  }
+
+  render.drawnSpriteBoxes = std::move(drawn);
+  render.isValid = true;
+
+  if(damage.Area() <= 0){
+    return Rectangle<s32>();
+  }
+
+  // Redraw everything that overlaps the damage, clipped to it, in the same order and with the same blank pixel
+  // handling as a full render
+  ImageRGBA damagedImage = render.image.GetROI(damage);
+  damagedImage.FillWith(PixelRGBA());
+
+  const Point2i origin(damage.GetX(), damage.GetY());
+  bool firstImage = true;
+  auto drawCallback = [this, &damagedImage, &origin, &damage, &frameIdx, &firstImage]
+                         (Vision::LayerName layerName, SpriteBoxName spriteBoxName,
+                          const SpriteBox& spriteBox, const SpriteEntry& spriteEntry){
+    Point2i topCorner;
+    int width = 0;
+    int height = 0;
+    spriteBox.GetPositionForFrame(frameIdx, topCorner, width, height);
+    const Rectangle<s32> boxRect(topCorner.x(), topCorner.y(), width, height);
+    if(boxRect.Intersect(damage).Area() <= 0){
+      // Still counts as the first image if it has content, so later boxes render the same as a full render
+      Vision::SpriteHandle handle;
+      if(spriteEntry.ContentIsValid() && spriteEntry.GetFrame(frameIdx, handle)){
+        firstImage = false;
+      }
+      return;
+    }
+    if(DrawSpriteBoxFrame(damagedImage, origin, layerName, spriteBoxName, spriteBox, spriteEntry, frameIdx, firstImage)){
       firstImage = false;
-      switch(spriteBox.renderConfig.renderMethod){
-        case SpriteRenderMethod::RGBA:
-        {
-          // Check to see if the RGBA image is cached
-          if(handle->IsContentCached().rgba){
-            const ImageRGBA& subImage = handle->GetCachedSpriteContentsRGBA();
-            baseImage.DrawSubImage(subImage, topCorner, drawBlankPixels);
-            if(ANKI_DEV_CHEATS){
-              VerifySubImageProperties(subImage, spriteBox, frameIdx);
-            }
-          }else{
-            const ImageRGBA& subImage = handle->GetSpriteContentsRGBA();
-            baseImage.DrawSubImage(subImage, topCorner, drawBlankPixels);
-            if(ANKI_DEV_CHEATS){
-              VerifySubImageProperties(subImage, spriteBox, frameIdx);
-            }
+    }
+  };
+  ProcessAllSpriteBoxes(drawCallback);
+
+  return damage;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CompositeImage::DrawSpriteBoxFrame(ImageRGBA& baseImage, const Point2i& origin,
+                                        Vision::LayerName layerName, SpriteBoxName spriteBoxName,
+                                        const SpriteBox& spriteBox, const SpriteEntry& spriteEntry,
+                                        const u32 frameIdx, const bool drawBlankPixels) const
+{
+  // If implementation quad was found, draw it into the image at the point
+  // specified by the layout quad def
+  Vision::SpriteHandle handle;
+  if(spriteEntry.ContentIsValid() &&
+     spriteEntry.GetFrame(frameIdx, handle)){
+    Point2i topCornerInt = {};
+    int width = 0;
+    int height = 0;
+    spriteBox.GetPositionForFrame(frameIdx, topCornerInt, width, height);
+    Point2f topCorner = {static_cast<float>(topCornerInt.x() - origin.x()),
+                         static_cast<float>(topCornerInt.y() - origin.y())};
+    switch(spriteBox.renderConfig.renderMethod){
+      case SpriteRenderMethod::RGBA:
+      {
+        // Check to see if the RGBA image is cached
+        if(handle->IsContentCached().rgba){
+          const ImageRGBA& subImage = handle->GetCachedSpriteContentsRGBA();
+          baseImage.DrawSubImage(subImage, topCorner, drawBlankPixels);
+          if(ANKI_DEV_CHEATS){
+            VerifySubImageProperties(subImage, spriteBox, frameIdx);
           }
-          break;
-        }
-        case SpriteRenderMethod::CustomHue:
-        {
-          Vision::HueSatWrapper::ImageSize imageSize(static_cast<uint32_t>(height),
-                                                     static_cast<uint32_t>(width));
-          std::shared_ptr<Vision::HueSatWrapper> hsImageHandle;
-          
-          const bool shouldRenderInEyeHue = (spriteBox.renderConfig.hue == 0) &&
-                                            (spriteBox.renderConfig.saturation == 0);
-          const bool canRenderInEyeHue = _faceHSImageHandle != nullptr;
-          // Print error if should but cant render in eye hue
-          if(shouldRenderInEyeHue && !canRenderInEyeHue){
-            LOG_ERROR("CompositeImage.OverlayImageWithFrame.ShouldRenderInEyeHueButCant",
-                      "HS Image handle missing - image will be renderd with 0,0 hue saturation");
+        }else{
+          const ImageRGBA& subImage = handle->GetSpriteContentsRGBA();
+          baseImage.DrawSubImage(subImage, topCorner, drawBlankPixels);
+          if(ANKI_DEV_CHEATS){
+            VerifySubImageProperties(subImage, spriteBox, frameIdx);
           }
-          
-          if(shouldRenderInEyeHue && canRenderInEyeHue){
-            // Render the sprite with procedural face hue/saturation
-            // TODO: Kevin K. Copy is happening here due to way we can resize image handles with cached data
-            // do something better
-            auto hue = _faceHSImageHandle->GetHue();
-            auto sat = _faceHSImageHandle->GetSaturation();
-            hsImageHandle = std::make_shared<Vision::HueSatWrapper>(hue,
-                                                                     sat,
-                                                                     imageSize);
-          }else{
-            hsImageHandle = std::make_shared<Vision::HueSatWrapper>(spriteBox.renderConfig.hue,
-                                                                     spriteBox.renderConfig.saturation,
-                                                                     imageSize);
+        }
+        break;
+      }
+      case SpriteRenderMethod::CustomHue:
+      {
+        Vision::HueSatWrapper::ImageSize imageSize(static_cast<uint32_t>(height),
+                                                   static_cast<uint32_t>(width));
+        std::shared_ptr<Vision::HueSatWrapper> hsImageHandle;
+        
+        const bool shouldRenderInEyeHue = (spriteBox.renderConfig.hue == 0) &&
+                                          (spriteBox.renderConfig.saturation == 0);
+        const bool canRenderInEyeHue = _faceHSImageHandle != nullptr;
+        // Print error if should but cant render in eye hue
+        if(shouldRenderInEyeHue && !canRenderInEyeHue){
+          LOG_ERROR("CompositeImage.OverlayImageWithFrame.ShouldRenderInEyeHueButCant",
+                    "HS Image handle missing - image will be renderd with 0,0 hue saturation");
+        }
+        
+        if(shouldRenderInEyeHue && canRenderInEyeHue){
+          // Render the sprite with procedural face hue/saturation
+          // TODO: Kevin K. Copy is happening here due to way we can resize image handles with cached data
+          // do something better
+          auto hue = _faceHSImageHandle->GetHue();
+          auto sat = _faceHSImageHandle->GetSaturation();
+          hsImageHandle = std::make_shared<Vision::HueSatWrapper>(hue,
+                                                                   sat,
+                                                                   imageSize);
+        }else{
+          hsImageHandle = std::make_shared<Vision::HueSatWrapper>(spriteBox.renderConfig.hue,
+                                                                   spriteBox.renderConfig.saturation,
+                                                                   imageSize);
+        }
+        
+        // Render the sprite - use the cached RGBA image if possible
+        if(handle->IsContentCached(hsImageHandle).rgba){
+          const ImageRGBA& subImage = handle->GetCachedSpriteContentsRGBA(hsImageHandle);
+          baseImage.DrawSubImage(subImage, topCorner, drawBlankPixels);
+          if(ANKI_DEV_CHEATS){
+            VerifySubImageProperties(subImage, spriteBox, frameIdx);
           }
-          
-          // Render the sprite - use the cached RGBA image if possible
-          if(handle->IsContentCached(hsImageHandle).rgba){
-            const ImageRGBA& subImage = handle->GetCachedSpriteContentsRGBA(hsImageHandle);
-            baseImage.DrawSubImage(subImage, topCorner, drawBlankPixels);
-            if(ANKI_DEV_CHEATS){
-              VerifySubImageProperties(subImage, spriteBox, frameIdx);
-            }
-          }else{
-            const ImageRGBA& subImage = handle->GetSpriteContentsRGBA(hsImageHandle);
-            baseImage.DrawSubImage(subImage, topCorner, drawBlankPixels);
-            if(ANKI_DEV_CHEATS){
-              VerifySubImageProperties(subImage, spriteBox, frameIdx);
-            }
+        }else{
+          const ImageRGBA& subImage = handle->GetSpriteContentsRGBA(hsImageHandle);
+          baseImage.DrawSubImage(subImage, topCorner, drawBlankPixels);
+          if(ANKI_DEV_CHEATS){
+            VerifySubImageProperties(subImage, spriteBox, frameIdx);
           }
-          break;
-        }
-        default:
-        {
-          LOG_ERROR("CompositeImage.OverlayImageWithFrame.InvalidRenderMethod",
-                    "Layer %s Sprite Box %s does not have a valid render method",
-                    LayerNameToString(layerName),
-                    SpriteBoxNameToString(spriteBoxName));
-          break;
         }
-      } // end switch
+        break;
+      }
+      default:
+      {
+        LOG_ERROR("CompositeImage.OverlayImageWithFrame.InvalidRenderMethod",
+                  "Layer %s Sprite Box %s does not have a valid render method",
+                  LayerNameToString(layerName),
+                  SpriteBoxNameToString(spriteBoxName));
+        break;
+      }
+    } // end switch
 
-    }else{
+    return true;
+  }else{
 #if ANKI_DEV_CHEATS
-      // Draw a "missing_asset" indicator into the base image 
-      Rectangle<f32> spriteBoxRect = spriteBox.GetRect();
-      baseImage.DrawRect(spriteBoxRect, Anki::NamedColors::RED);
-      baseImage.DrawLine(spriteBoxRect.GetTopLeft(), spriteBoxRect.GetBottomRight(), Anki::NamedColors::RED);
-      baseImage.DrawLine(spriteBoxRect.GetBottomLeft(), spriteBoxRect.GetTopRight(), Anki::NamedColors::RED);
+    // Draw a "missing_asset" indicator into the base image 
+    const Rectangle<f32> boxRect = spriteBox.GetRect();
+    const Rectangle<f32> spriteBoxRect(boxRect.GetX() - origin.x(), boxRect.GetY() - origin.y(),
+                                       boxRect.GetWidth(), boxRect.GetHeight());
+    baseImage.DrawRect(spriteBoxRect, Anki::NamedColors::RED);
+    baseImage.DrawLine(spriteBoxRect.GetTopLeft(), spriteBoxRect.GetBottomRight(), Anki::NamedColors::RED);
+    baseImage.DrawLine(spriteBoxRect.GetBottomLeft(), spriteBoxRect.GetTopRight(), Anki::NamedColors::RED);
 #endif
-      LOG_ERROR("CompositeImage.OverlayImageWithFrame.NoImageForSpriteBox",
-                "Sprite Box %s will not be rendered - no valid image found",
-                SpriteBoxNameToString(spriteBoxName));
-    }
-  };
-  ProcessAllSpriteBoxes(callback);
+    LOG_ERROR("CompositeImage.OverlayImageWithFrame.NoImageForSpriteBox",
+              "Sprite Box %s will not be rendered - no valid image found",
+              SpriteBoxNameToString(spriteBoxName));
+    return false;
+  }
 }
 
 
@@ -434,6 +569,32 @@ void CompositeImage::CacheInternalSprites(Vision::SpriteCache* cache, const Time
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void CompositeImage::StreamInternalSprites(Vision::SpriteCache* cache, const u32 firstFrameIdx, const u32 numFrames,
+                                           const TimeStamp_t cacheFor_ms)
+{
+  auto callback = [cache, firstFrameIdx, numFrames, cacheFor_ms](Vision::LayerName layerName, SpriteBoxName spriteBoxName, 
+                                                                 const SpriteBox& spriteBox, const SpriteEntry& spriteEntry){
+    const bool cacheRGBA = (spriteBox.renderConfig.renderMethod == SpriteRenderMethod::RGBA);
+    const ISpriteWrapper::ImgTypeCacheSpec cacheSpec(!cacheRGBA, cacheRGBA);
+    auto hs = std::make_shared<HueSatWrapper>(spriteBox.renderConfig.hue, 
+                                              spriteBox.renderConfig.saturation);
+
+    // Frames before the entry's start offset aren't drawn, so skip them quietly. The window stops at the end of the
+    // entry rather than asking sequences that don't loop for frames they don't have
+    const u32 endFrameIdx = std::min(firstFrameIdx + numFrames, static_cast<u32>(spriteEntry.GetNumFrames()));
+    Vision::SpriteHandle handle;
+    for(u32 i = firstFrameIdx; i < endFrameIdx; i++){
+      if(spriteEntry.GetFrame(i, handle) && (handle != nullptr)){
+        cache->StreamSprite(handle, cacheSpec, cacheFor_ms, hs);
+      }
+    }
+  };
+
+  ProcessAllSpriteBoxes(callback);
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void CompositeImage::AddEmptyLayer(SpriteSequenceContainer* seqContainer, Vision::LayerName layerName)
 {
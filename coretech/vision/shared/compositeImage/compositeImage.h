@@ -20,6 +20,7 @@
 
 #include "clad/types/compositeImageTypes.h"
 #include "coretech/vision/engine/image.h"
+#include <map>
 #include <set>
 
 namespace Anki {
@@ -102,6 +103,34 @@ public:
   void OverlayImageWithFrame(ImageRGBA& baseImage,
                              const u32 frameIdx = 0,
                              std::set<Vision::LayerName> layersToIgnore = {}) const;
+
+  // What OverlayImageWithFrameIncremental rendered last time, so the next call can tell what changed
+  struct IncrementalRender {
+    struct DrawnSpriteBox {
+      Vision::SpriteHandle sprite;
+      Rectangle<s32>       rect;
+      SpriteRenderMethod   renderMethod = SpriteRenderMethod::RGBA;
+      uint8_t              hue = 0;
+      uint8_t              saturation = 0;
+
+      bool operator ==(const DrawnSpriteBox& other) const {
+        return (sprite == other.sprite) && (renderMethod == other.renderMethod) &&
+               (rect.GetX() == other.rect.GetX()) && (rect.GetY() == other.rect.GetY()) &&
+               (rect.GetWidth() == other.rect.GetWidth()) && (rect.GetHeight() == other.rect.GetHeight()) &&
+               (hue == other.hue) && (saturation == other.saturation);
+      }
+    };
+    using DrawnSpriteBoxMap = std::map<std::pair<Vision::LayerName, SpriteBoxName>, DrawnSpriteBox>;
+
+    ImageRGBA         image;
+    DrawnSpriteBoxMap drawnSpriteBoxes;
+    bool              isValid = false;
+  };
+
+  // Render the frame into render.image, which holds the previous render, redrawing only the region covered by
+  // sprite boxes that draw something different than last time. The image is rendered in full on the first call
+  // or if it is invalidated. Returns the region that was redrawn, which is empty if nothing changed
+  Rectangle<s32> OverlayImageWithFrameIncremental(IncrementalRender& render, const u32 frameIdx = 0) const;
   
   // Returns the length of the longest subsequence
   uint GetFullLoopLength();
@@ -115,6 +144,11 @@ public:
   // The composite image should cache all of its sprites for the time specifed
   void CacheInternalSprites(Vision::SpriteCache* cache, const TimeStamp_t endTime_ms);
 
+  // Keep the sprites for frames [firstFrameIdx, firstFrameIdx + numFrames) decoded for cacheFor_ms, so that they
+  // are ready by the time they are drawn. Frames that are already cached only have their expiration pushed back
+  void StreamInternalSprites(Vision::SpriteCache* cache, const u32 firstFrameIdx, const u32 numFrames,
+                             const TimeStamp_t cacheFor_ms);
+
 
   // Utility function which adds the "empty layer" to the image - useful for instances
   // where a blank composite image is needed at the start of an animation so that updates
@@ -144,6 +178,13 @@ private:
   // Othrewise, returns HSImage to use in render
   HSImageHandle HowToRenderRGBA(const SpriteRenderConfig& config) const;
 
+  // Draw one sprite box's frame into baseImage, whose top left corner is at origin in the composite image.
+  // Returns false if the sprite box had nothing to draw
+  bool DrawSpriteBoxFrame(ImageRGBA& baseImage, const Point2i& origin,
+                          Vision::LayerName layerName, SpriteBoxName spriteBoxName,
+                          const SpriteBox& spriteBox, const SpriteEntry& spriteEntry,
+                          const u32 frameIdx, const bool drawBlankPixels) const;
+
   template<typename ImageType>
   void VerifySubImageProperties(const ImageType& image, const SpriteBox& sb, const int frameIdx) const;
 
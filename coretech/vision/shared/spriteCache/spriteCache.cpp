@@ -171,6 +171,45 @@ void SpriteCache::CacheSprite(const SpriteHandle& handle,
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SpriteCache::StreamSprite(const SpriteHandle& handle, 
+                               ImgTypeCacheSpec cacheSpec,
+                               BaseStationTime_t cacheFor_ms, 
+                               const HSImageHandle& hueAndSaturation)
+{
+  InternalHandle internalHandle = ConvertToInternalHandle(handle, hueAndSaturation);
+  if(internalHandle == nullptr){
+    PRINT_NAMED_WARNING("SpriteCache.StreamSprite.UnableToFindSpriteToCache", "");
+    return;
+  }
+
+  const auto cached = internalHandle->IsContentCached(hueAndSaturation);
+  const ImgTypeCacheSpec missing(cacheSpec.grayscale && !cached.grayscale,
+                                 cacheSpec.rgba && !cached.rgba);
+  if(missing.grayscale || missing.rgba){
+    internalHandle->CacheSprite(missing, hueAndSaturation);
+  }
+
+  // Drop the entries that would clear the sprite before the new expiration, unless one already outlasts it
+  const auto expire_ns = _lastUpdateTime_nanosec + Util::MilliSecToNanoSec(cacheFor_ms);
+  bool alreadyHeld = false;
+  for(auto iter = _cacheTimeoutMap.begin(); iter != _cacheTimeoutMap.end();){
+    if(iter->second != internalHandle){
+      ++iter;
+    }else if((iter->first == 0) || (iter->first >= expire_ns)){
+      alreadyHeld = true;
+      ++iter;
+    }else{
+      iter = _cacheTimeoutMap.erase(iter);
+    }
+  }
+
+  if(!alreadyHeld){
+    _cacheTimeoutMap.emplace(expire_ns, internalHandle);
+  }
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SpriteCache::ClearCachedSprite(SpriteHandle handle, 
                                     ImgTypeCacheSpec cacheSpec, 
@@ -56,6 +56,13 @@ public:
                    BaseStationTime_t cacheFor_ms = 0, 
                    const HSImageHandle& hueAndSaturation = {});
 
+  // Like CacheSprite, but only decodes what isn't cached yet and otherwise pushes the expiration back, so that a
+  // window of upcoming frames can be requested every tick while a sequence plays
+  void StreamSprite(const SpriteHandle& handle,
+                    ImgTypeCacheSpec cacheSpec,
+                    BaseStationTime_t cacheFor_ms,
+                    const HSImageHandle& hueAndSaturation = {});
+
   void ClearCachedSprite(SpriteHandle handle, 
                          ImgTypeCacheSpec cacheSpec, 
                          const HSImageHandle& hueAndSaturation = {});
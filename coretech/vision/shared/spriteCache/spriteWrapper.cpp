@@ -35,6 +35,7 @@ SpriteWrapper::SpriteWrapper(const std::string& fullSpritePath)
 SpriteWrapper::SpriteWrapper(ImageRGBA* sprite)
 {
   _spriteRGBA.reset(sprite);
+  UpdateMemoryAccount();
 }
 
   
@@ -42,6 +43,7 @@ SpriteWrapper::SpriteWrapper(ImageRGBA* sprite)
 SpriteWrapper::SpriteWrapper(Image* sprite)
 {
   _spriteGrayscale.reset(sprite);
+  UpdateMemoryAccount();
 }
 
 
@@ -194,7 +196,9 @@ void SpriteWrapper::CacheSprite(const ImgTypeCacheSpec& typesToCache, const HSIm
       _spriteRGBA = std::unique_ptr<ImageRGBA>(new ImageRGBA());
       LoadSprite(_spriteRGBA.get(), hsImage);
     }
-  } 
+  }
+  
+  UpdateMemoryAccount();
 }
 
 
@@ -216,6 +220,21 @@ void SpriteWrapper::ClearCachedSprite()
 
   _spriteRGBA.reset();
   _spriteGrayscale.reset();
+  UpdateMemoryAccount();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SpriteWrapper::UpdateMemoryAccount()
+{
+  size_t numBytes = 0;
+  if(_spriteGrayscale != nullptr){
+    numBytes += _spriteGrayscale->GetNumElements() * sizeof(u8);
+  }
+  if(_spriteRGBA != nullptr){
+    numBytes += _spriteRGBA->GetNumElements() * sizeof(PixelRGBA);
+  }
+  _memoryAccount.Set(numBytes);
 }
 
   
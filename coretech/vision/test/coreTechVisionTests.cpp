@@ -8,13 +8,16 @@
 #include "coretech/common/engine/math/pose.h"
 
 #include "coretech/common/engine/math/quad_impl.h"
+#include "coretech/common/shared/math/rect_impl.h"
 
 #include "coretech/vision/engine/camera.h"
 #include "coretech/vision/engine/compressedImage.h"
 #include "coretech/vision/engine/image.h"
 #include "coretech/vision/engine/observableObject.h"
+#include "coretech/vision/engine/occluderList.h"
 #include "coretech/vision/engine/perspectivePoseEstimation.h"
 #include "coretech/vision/engine/profiler.h"
+#include "coretech/vision/engine/undistorter.h"
 
 using namespace Anki;
 
@@ -617,3 +620,132 @@ GTEST_TEST(CompressedImage, Decompress)
   EXPECT_TRUE(res);
   EXPECT_EQ(rgb, outGray);
 }
+
+GTEST_TEST(OccluderList, MatchesLinearSearch)
+{
+  // Overlapping occluders at various depths, one far from the rest to stretch the tile index
+  struct Occluder { Quad2f quad; f32 depth; };
+  std::vector<Occluder> occluders;
+  for(s32 i=0; i<12; ++i) {
+    const f32 x = 20.f*(i % 4);
+    const f32 y = 30.f*(i / 4);
+    occluders.push_back({Quad2f({x,y}, {x,y+35.f}, {x+25.f,y}, {x+25.f,y+35.f}), 100.f + 10.f*((i*7) % 12)});
+  }
+  occluders.push_back({Quad2f({600.f,400.f}, {600.f,440.f}, {640.f,400.f}, {640.f,440.f}), 50.f});
+  
+  Vision::OccluderList occluderList;
+  for(const auto& occluder : occluders) {
+    occluderList.AddOccluder(occluder.quad, occluder.depth);
+  }
+  
+  auto isOccludedLinear = [&occluders](const Point2f& point, const f32 atDistance) {
+    for(const auto& occluder : occluders) {
+      if(occluder.depth < atDistance && Rectangle<f32>(occluder.quad).Contains(point)) {
+        return true;
+      }
+    }
+    return false;
+  };
+  
+  auto isAnythingBehindLinear = [&occluders](const Quad2f& quad, const f32 atDistance) {
+    const Rectangle<f32> boundingBox(quad);
+    for(const auto& occluder : occluders) {
+      if(occluder.depth > atDistance && boundingBox.Intersect(Rectangle<f32>(occluder.quad)).Area() > 0) {
+        return true;
+      }
+    }
+    return false;
+  };
+  
+  for(f32 x = -10.f; x < 660.f; x += 7.f) {
+    for(f32 y = -10.f; y < 460.f; y += 9.f) {
+      const Point2f point(x, y);
+      const Quad2f quad(point, {x,y+6.f}, {x+6.f,y}, {x+6.f,y+6.f});
+      for(const f32 atDistance : {0.f, 75.f, 125.f, 155.f, 1000.f}) {
+        EXPECT_EQ(isOccludedLinear(point, atDistance), occluderList.IsOccluded(point, atDistance));
+        EXPECT_EQ(isAnythingBehindLinear(quad, atDistance), occluderList.IsAnythingBehind(quad, atDistance));
+      }
+    }
+  }
+  
+  // Adding another occluder rebuilds the index
+  occluderList.AddOccluder(Quad2f({300.f,200.f}, {300.f,210.f}, {310.f,200.f}, {310.f,210.f}), 10.f);
+  EXPECT_TRUE(occluderList.IsOccluded(Point2f(305.f, 205.f), 20.f));
+  EXPECT_TRUE(occluderList.IsAnyCornerOccluded(Quad2f({305.f,205.f}, {305.f,250.f}, {350.f,205.f}, {350.f,250.f}), 20.f));
+  EXPECT_FALSE(occluderList.IsAnyCornerOccluded(Quad2f({305.f,205.f}, {305.f,250.f}, {350.f,205.f}, {350.f,250.f}), 5.f));
+  
+  occluderList.Clear();
+  EXPECT_FALSE(occluderList.IsOccluded(Point2f(305.f, 205.f), 20.f));
+}
+
+GTEST_TEST(Undistorter, PointLUTMatchesExact)
+{
+  const std::vector<f32> distCoeffs{-0.1f, 0.02f, 0.001f, -0.001f, 0.f};
+  auto calib = std::make_shared<Vision::CameraCalibration>(360, 640, 300.f, 300.f, 320.f, 180.f, 0.f, distCoeffs);
+  
+  std::vector<Point2f> points;
+  for(f32 x = -20.f; x < 660.f; x += 13.7f) {
+    for(f32 y = -20.f; y < 380.f; y += 11.3f) {
+      points.emplace_back(x, y);
+    }
+  }
+  points.emplace_back(639.f, 359.f);
+  
+  std::vector<Point2f> exactPoints;
+  ASSERT_EQ(RESULT_OK, Vision::Undistorter::UndistortPoints(calib, 360, 640, points, exactPoints));
+  
+  Vision::Undistorter undistorter(calib);
+  ASSERT_EQ(RESULT_OK, undistorter.CachePointLUT(360, 640));
+  std::vector<Point2f> lutPoints;
+  ASSERT_EQ(RESULT_OK, undistorter.UndistortPoints(360, 640, points, lutPoints));
+  
+  ASSERT_EQ(exactPoints.size(), lutPoints.size());
+  for(size_t i=0; i<points.size(); ++i) {
+    EXPECT_LT((exactPoints[i] - lutPoints[i]).Length(), 0.05f) << points[i].x() << "," << points[i].y();
+  }
+}
+
+GTEST_TEST(Undistorter, SavedMapsMatchComputed)
+{
+  const std::string cacheDir("/tmp/testUndistorterMapCache");
+  Util::FileUtils::RemoveDirectory(cacheDir);
+  
+  const std::vector<f32> distCoeffs{-0.1f, 0.02f, 0.001f, -0.001f, 0.f};
+  auto calib = std::make_shared<Vision::CameraCalibration>(360, 640, 300.f, 300.f, 320.f, 180.f, 0.f, distCoeffs);
+  
+  Vision::ImageRGB img(180, 320);
+  for(s32 i=0; i<img.GetNumRows(); ++i) {
+    Vision::PixelRGB* img_i = img.GetRow(i);
+    for(s32 j=0; j<img.GetNumCols(); ++j) {
+      img_i[j] = Vision::PixelRGB((u8)(j*3), (u8)(i*5), (u8)((i+j)*7));
+    }
+  }
+  
+  // Computes the maps and saves them
+  Vision::ImageRGB computed;
+  {
+    Vision::Undistorter undistorter(calib, cacheDir);
+    ASSERT_EQ(RESULT_OK, undistorter.UndistortImage(img, computed));
+  }
+  EXPECT_EQ(1u, Util::FileUtils::FilesInDirectory(cacheDir, false, ".bin").size());
+  
+  // Loads them back
+  Vision::ImageRGB loaded;
+  {
+    Vision::Undistorter undistorter(calib, cacheDir);
+    ASSERT_EQ(RESULT_OK, undistorter.UndistortImage(img, loaded));
+  }
+  EXPECT_EQ(0.0, cv::norm(computed.get_CvMat_(), loaded.get_CvMat_(), cv::NORM_INF));
+  
+  // A different calibration gets its own maps and replaces the old ones
+  const std::vector<f32> otherDistCoeffs{-0.05f, 0.01f, 0.f, 0.f, 0.f};
+  auto otherCalib = std::make_shared<Vision::CameraCalibration>(360, 640, 300.f, 300.f, 320.f, 180.f, 0.f, otherDistCoeffs);
+  EXPECT_NE(Vision::Undistorter::ComputeCalibrationHash(*calib), Vision::Undistorter::ComputeCalibrationHash(*otherCalib));
+  {
+    Vision::Undistorter undistorter(otherCalib, cacheDir);
+    ASSERT_EQ(RESULT_OK, undistorter.CacheUndistortionMaps(180, 320));
+  }
+  EXPECT_EQ(1u, Util::FileUtils::FilesInDirectory(cacheDir, false, ".bin").size());
+  
+  Util::FileUtils::RemoveDirectory(cacheDir);
+}
@@ -3,9 +3,16 @@
 #include "coretech/common/shared/types.h"
 
 #include "coretech/vision/engine/image_impl.h"
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
 #include "coretech/vision/engine/imageBuffer/imageBuffer.h"
+#include "coretech/vision/engine/imageBuffer/imageConversionAccelerator.h"
 #include "coretech/vision/engine/imageCache.h"
 
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
 using namespace Anki;
 
 GTEST_TEST(ImageCache, CachedGetters)
@@ -261,3 +268,500 @@ GTEST_TEST(ImageCache, ResizeMethod)
   ASSERT_EQ(method, ResizeMethod::Cubic);
   ASSERT_EQ(buffer.GetResizeMethod(), ResizeMethod::Cubic);
 }
+
+GTEST_TEST(ImageCache, ComputeFromLargerSize)
+{
+  using namespace Anki::Vision;
+
+  ImageCache cache;
+
+  const s32 nrows = 16;
+  const s32 ncols = 40;
+  Image imgGray(nrows, ncols);
+  for(s32 i = 0; i < nrows; ++i)
+  {
+    for(s32 j = 0; j < ncols; ++j)
+    {
+      imgGray(i,j) = (u8)((i*ncols + j) % 251);
+    }
+  }
+  cache.Reset(imgGray, ResizeMethod::AverageArea);
+  cache.SetRequester("Test");
+
+  // Half and Quarter should both match OpenCV's area averaging, whether computed from Full directly (2x)
+  // or from the newly cached Half (2x), and Eighth from Half (4x)
+  ImageCache::GetType getType;
+  for(auto size : {ImageCacheSize::Half, ImageCacheSize::Quarter, ImageCacheSize::Eighth})
+  {
+    const Image& resized = cache.GetGray(size, &getType);
+    ASSERT_EQ(ImageCache::GetType::NewEntry, getType);
+
+    Image expected(cache.GetNumRows(size), cache.GetNumCols(size));
+    imgGray.Resize(expected, ResizeMethod::AverageArea);
+    ASSERT_EQ(expected.GetNumRows(), resized.GetNumRows());
+    ASSERT_EQ(expected.GetNumCols(), resized.GetNumCols());
+    for(s32 i = 0; i < expected.GetNumRows(); ++i)
+    {
+      for(s32 j = 0; j < expected.GetNumCols(); ++j)
+      {
+        ASSERT_NEAR(expected(i,j), resized(i,j), 1);
+      }
+    }
+  }
+
+  // Resetting must reuse the existing pyramid memory
+  const u8* quarterData = cache.GetGray(ImageCacheSize::Quarter).GetDataPointer();
+  Image newImg(nrows, ncols);
+  newImg.FillWith(7);
+  cache.Reset(newImg, ResizeMethod::AverageArea);
+  const Image& newQuarter = cache.GetGray(ImageCacheSize::Quarter, &getType);
+  ASSERT_EQ(ImageCache::GetType::ResizeIntoExisting, getType);
+  ASSERT_EQ(quarterData, newQuarter.GetDataPointer());
+  ASSERT_EQ(7, newQuarter(0,0));
+
+  const auto& stats = cache.GetRequestStats();
+  const auto statsIter = stats.find("Test");
+  ASSERT_NE(stats.end(), statsIter);
+  ASSERT_EQ(1u, statsIter->second.numGrayRequests[(size_t)ImageCacheSize::Half]);
+  ASSERT_EQ(3u, statsIter->second.numGrayRequests[(size_t)ImageCacheSize::Quarter]);
+  ASSERT_EQ(0u, statsIter->second.numRGBRequests[(size_t)ImageCacheSize::Quarter]);
+  ASSERT_EQ(4u, statsIter->second.numComputed);
+  ASSERT_EQ(4u, statsIter->second.numFromLargerSize);
+
+  cache.ClearRequestStats();
+  ASSERT_TRUE(cache.GetRequestStats().empty());
+}
+
+GTEST_TEST(ImageCache, FusedBayerConversion)
+{
+  using namespace Anki::Vision;
+
+  const s32 nrows = 8;
+  const s32 ncols = 64;
+  std::vector<u8> bayerData(nrows*ncols*5/4);
+  for(size_t i = 0; i < bayerData.size(); ++i)
+  {
+    bayerData[i] = (u8)((i*37 + 11) % 256);
+  }
+  ImageBuffer buffer(bayerData.data(), nrows, ncols, ImageEncoding::BAYER, 1, 2);
+  buffer.SetSensorResolution(nrows, ncols);
+
+  // Reference results from the individual conversions
+  ImageCache refCache;
+  refCache.Reset(buffer);
+  ImageRGB refHalfRGB, refQuarterRGB;
+  refCache.GetRGB(ImageCacheSize::Half).CopyTo(refHalfRGB);
+  refCache.GetRGB(ImageCacheSize::Quarter).CopyTo(refQuarterRGB);
+
+  ImageCache::RequestSet expected;
+  expected.gray[(size_t)ImageCacheSize::Half] = true;
+  expected.rgb[(size_t)ImageCacheSize::Half] = true;
+  expected.rgb[(size_t)ImageCacheSize::Quarter] = true;
+  ASSERT_FALSE(expected.IsEmpty());
+
+  ImageCache cache;
+  cache.SetRequester("Test");
+  cache.Reset(buffer, expected);
+
+  // Everything expected should already be computed
+  ImageCache::GetType getType;
+  const Image& halfGray = cache.GetGray(ImageCacheSize::Half, &getType);
+  ASSERT_EQ(ImageCache::GetType::FullyCached, getType);
+  ASSERT_EQ(buffer.GetTimestamp(), halfGray.GetTimestamp());
+  ASSERT_EQ(buffer.GetImageId(),   halfGray.GetImageId());
+
+  const ImageRGB& halfRGB = cache.GetRGB(ImageCacheSize::Half, &getType);
+  ASSERT_EQ(0u, cache.GetRequestStats().at("Test").numFromLargerSize);
+  ASSERT_EQ(refHalfRGB.GetNumRows(), halfRGB.GetNumRows());
+  ASSERT_EQ(refHalfRGB.GetNumCols(), halfRGB.GetNumCols());
+  for(s32 i = 0; i < halfRGB.GetNumRows(); ++i)
+  {
+    for(s32 j = 0; j < halfRGB.GetNumCols(); ++j)
+    {
+      ASSERT_EQ(refHalfRGB(i,j), halfRGB(i,j));
+      ASSERT_EQ(halfRGB(i,j).g(), halfGray(i,j));
+    }
+  }
+
+  const ImageRGB& quarterRGB = cache.GetRGB(ImageCacheSize::Quarter, &getType);
+  ASSERT_EQ(refQuarterRGB.GetNumRows(), quarterRGB.GetNumRows());
+  ASSERT_EQ(refQuarterRGB.GetNumCols(), quarterRGB.GetNumCols());
+  for(s32 i = 0; i < quarterRGB.GetNumRows(); ++i)
+  {
+    for(s32 j = 0; j < quarterRGB.GetNumCols(); ++j)
+    {
+      ASSERT_NEAR(refQuarterRGB(i,j).r(), quarterRGB(i,j).r(), 1);
+      ASSERT_NEAR(refQuarterRGB(i,j).g(), quarterRGB(i,j).g(), 1);
+      ASSERT_NEAR(refQuarterRGB(i,j).b(), quarterRGB(i,j).b(), 1);
+    }
+  }
+
+  // What was requested for this image is what is expected for the next one
+  cache.Reset(buffer);
+  const auto& lastRequests = cache.GetLastRequests("Test");
+  ASSERT_TRUE(lastRequests.gray[(size_t)ImageCacheSize::Half]);
+  ASSERT_TRUE(lastRequests.rgb[(size_t)ImageCacheSize::Quarter]);
+  ASSERT_FALSE(lastRequests.gray[(size_t)ImageCacheSize::Full]);
+  ASSERT_TRUE(cache.GetLastRequests("Unknown").IsEmpty());
+}
+
+GTEST_TEST(ImageCache, BufferDataOwner)
+{
+  using namespace Anki::Vision;
+
+  // Stand-in for a camera frame lock, released once nothing holds the buffer anymore
+  s32 numReleases = 0;
+  auto makeOwner = [&numReleases]() {
+    return ImageBuffer::DataOwner(nullptr, [&numReleases](void*) { ++numReleases; });
+  };
+
+  std::vector<u8> bayerData1(64*48, 128);
+  std::vector<u8> bayerData2(64*48, 64);
+
+  ImageCache cache;
+  {
+    ImageBuffer buffer(bayerData1.data(), 48, 64, ImageEncoding::BAYER, 1, 1);
+    buffer.SetSensorResolution(48, 64);
+    buffer.SetDataOwner(makeOwner());
+    cache.Reset(buffer);
+
+    // Dropping the caller's reference isn't enough, since the cache can still compute sizes from it
+    buffer.Invalidate();
+    ASSERT_EQ(0, numReleases);
+    cache.GetGray(ImageCacheSize::Quarter);
+    ASSERT_EQ(0, numReleases);
+  }
+
+  // Resetting with the next frame lets go of the previous one
+  {
+    ImageBuffer buffer(bayerData2.data(), 48, 64, ImageEncoding::BAYER, 2, 2);
+    buffer.SetSensorResolution(48, 64);
+    buffer.SetDataOwner(makeOwner());
+    cache.Reset(buffer);
+  }
+  ASSERT_EQ(1, numReleases);
+
+  // Releasing the cache's memory lets go of the current one too (e.g. before changing camera formats)
+  cache.GetGray(ImageCacheSize::Half);
+  cache.ReleaseMemory();
+  ASSERT_EQ(2, numReleases);
+}
+
+GTEST_TEST(ImageCache, SharedStatistics)
+{
+  using namespace Anki::Vision;
+  
+  Image imgGray(60, 80);
+  for(s32 i=0; i<imgGray.GetNumRows(); ++i) {
+    u8* img_i = imgGray.GetRow(i);
+    for(s32 j=0; j<imgGray.GetNumCols(); ++j) {
+      img_i[j] = (u8)((i*7 + j*13) % 256);
+    }
+  }
+  
+  ImageCache cache;
+  cache.Reset(imgGray);
+  
+  for(const s32 subSample : {1, 3}) {
+    const Image& half = cache.GetGray(ImageCacheSize::Half);
+    ImageBrightnessHistogram expectedHist;
+    expectedHist.FillFromImage(half, subSample);
+    
+    s32 sum = 0;
+    for(s32 i=0; i<half.GetNumRows(); i+=subSample) {
+      for(s32 j=0; j<half.GetNumCols(); j+=subSample) {
+        sum += half(i,j);
+      }
+    }
+    
+    const ImageStatistics& stats = cache.GetStatistics(subSample, ImageCacheSize::Half);
+    EXPECT_EQ(subSample, stats.GetSubSample());
+    EXPECT_EQ(expectedHist.GetCounts(), stats.GetHistogram().GetCounts());
+    EXPECT_EQ(expectedHist.GetTotalCount(), stats.GetHistogram().GetTotalCount());
+    EXPECT_EQ(sum / expectedHist.GetTotalCount(), stats.GetMean());
+    
+    // Shared rather than recomputed
+    EXPECT_EQ(&stats, &cache.GetStatistics(subSample, ImageCacheSize::Half));
+  }
+  
+  // Recomputed for the next image
+  imgGray.FillWith(200);
+  cache.Reset(imgGray);
+  EXPECT_EQ(200, cache.GetStatistics(3).GetMean());
+  
+  // Linearizing a shared histogram's bins matches linearizing while filling
+  const ImageBrightnessHistogram::TransformFcn halve = [](u8 value) { return (u8)(value / 2); };
+  cache.Reset(Image(imgGray.GetNumRows(), imgGray.GetNumCols(), (u8)90));
+  ImageBrightnessHistogram filled, accumulated;
+  filled.FillFromImage(cache.GetGray(), 2, halve);
+  accumulated.Accumulate(cache.GetStatistics(2).GetHistogram(), halve);
+  EXPECT_EQ(filled.GetCounts(), accumulated.GetCounts());
+  EXPECT_EQ(filled.GetTotalCount(), accumulated.GetTotalCount());
+}
+
+GTEST_TEST(ImageCache, SharedWarpedRGB)
+{
+  using namespace Anki::Vision;
+  
+  ImageRGB imgColor(40, 60);
+  for(s32 i=0; i<imgColor.GetNumRows(); ++i) {
+    PixelRGB* img_i = imgColor.GetRow(i);
+    for(s32 j=0; j<imgColor.GetNumCols(); ++j) {
+      img_i[j] = PixelRGB((u8)(4*j), (u8)(6*i), (u8)(2*(i+j)));
+    }
+  }
+  
+  ImageCache cache;
+  cache.Reset(imgColor);
+  const ImageRGB& full = cache.GetRGB(ImageCacheSize::Full);
+  
+  // Identity reproduces the image
+  const Matrix_3x3f identity{1.f, 0.f, 0.f,  0.f, 1.f, 0.f,  0.f, 0.f, 1.f};
+  const ImageRGB& same = cache.GetWarpedRGB(identity, full.GetNumRows(), full.GetNumCols(), ImageCacheSize::Full);
+  ASSERT_EQ(full.GetNumRows(), same.GetNumRows());
+  ASSERT_EQ(full.GetNumCols(), same.GetNumCols());
+  for(s32 i=0; i<full.GetNumRows(); ++i) {
+    for(s32 j=0; j<full.GetNumCols(); ++j) {
+      EXPECT_TRUE(full(i,j) == same(i,j));
+    }
+  }
+  
+  // Shared rather than recomputed, but a different homography gets its own entry
+  EXPECT_EQ(&same, &cache.GetWarpedRGB(identity, full.GetNumRows(), full.GetNumCols(), ImageCacheSize::Full));
+  
+  // Half a pixel to the right interpolates between neighbours, and samples off the right edge are black
+  const Matrix_3x3f shift{1.f, 0.f, 0.5f,  0.f, 1.f, 0.f,  0.f, 0.f, 1.f};
+  const ImageRGB& shifted = cache.GetWarpedRGB(shift, 10, full.GetNumCols(), ImageCacheSize::Full);
+  EXPECT_NE(&same, &shifted);
+  for(s32 i=0; i<shifted.GetNumRows(); ++i) {
+    for(s32 j=0; j<shifted.GetNumCols()-1; ++j) {
+      EXPECT_NEAR(0.5f*(full(i,j).r() + full(i,j+1).r()), shifted(i,j).r(), 1.f);
+      EXPECT_NEAR(0.5f*(full(i,j).b() + full(i,j+1).b()), shifted(i,j).b(), 1.f);
+    }
+    EXPECT_TRUE(PixelRGB(0,0,0) == shifted(i, shifted.GetNumCols()-1));
+  }
+  
+  // Recomputed for the next image
+  imgColor.FillWith(PixelRGB(10,20,30));
+  cache.Reset(imgColor);
+  const ImageRGB& next = cache.GetWarpedRGB(identity, 5, 5, ImageCacheSize::Full);
+  EXPECT_TRUE(PixelRGB(10,20,30) == next(2,2));
+}
+
+GTEST_TEST(ImageCache, HalvedYUV420spConversion)
+{
+  using namespace Anki::Vision;
+
+  const s32 nrows = 8;
+  const s32 ncols = 40;
+  std::vector<u8> yuvData(nrows*ncols*3/2);
+  for(size_t i = 0; i < yuvData.size(); ++i)
+  {
+    yuvData[i] = (u8)((i*37 + 11) % 256);
+  }
+  ImageBuffer buffer(yuvData.data(), nrows*3/2, ncols, ImageEncoding::YUV420sp, 1, 2);
+  buffer.SetSensorResolution(nrows, ncols);
+  buffer.SetResizeMethod(ResizeMethod::AverageArea);
+
+  // Reference: full resolution conversion averaged down afterwards
+  ImageRGB fullRGB, refHalfRGB;
+  ASSERT_TRUE(buffer.GetRGB(fullRGB, ImageCacheSize::Full));
+  ImageConversions::BoxDownsample2x(fullRGB, refHalfRGB);
+
+  ImageCache cache;
+  cache.Reset(buffer);
+  const ImageRGB& halfRGB = cache.GetRGB(ImageCacheSize::Half);
+  const Image& halfGray = cache.GetGray(ImageCacheSize::Half);
+  ASSERT_EQ(nrows/2, halfRGB.GetNumRows());
+  ASSERT_EQ(ncols/2, halfRGB.GetNumCols());
+  ASSERT_EQ(buffer.GetTimestamp(), halfRGB.GetTimestamp());
+
+  // Converting the averaged luma differs from averaging the converted pixels only by rounding and
+  // where channels saturate, which the test pattern hits now and then
+  s32 numFarOff = 0;
+  for(s32 i = 0; i < halfRGB.GetNumRows(); ++i)
+  {
+    for(s32 j = 0; j < halfRGB.GetNumCols(); ++j)
+    {
+      ASSERT_EQ(halfRGB(i,j).g(), halfGray(i,j));
+      const s32 maxDiff = std::max({std::abs((s32)refHalfRGB(i,j).r() - (s32)halfRGB(i,j).r()),
+                                    std::abs((s32)refHalfRGB(i,j).g() - (s32)halfRGB(i,j).g()),
+                                    std::abs((s32)refHalfRGB(i,j).b() - (s32)halfRGB(i,j).b())});
+      numFarOff += (maxDiff > 2 ? 1 : 0);
+    }
+  }
+  ASSERT_LT(numFarOff, halfRGB.GetNumElements() / 4);
+
+  const ImageRGB& eighthRGB = cache.GetRGB(ImageCacheSize::Eighth);
+  ASSERT_EQ(nrows/8, eighthRGB.GetNumRows());
+  ASSERT_EQ(ncols/8, eighthRGB.GetNumCols());
+}
+
+namespace {
+
+// Fills supported requests with a constant, so results show which path produced them
+class TestAccelerator : public Anki::Vision::IImageConversionAccelerator
+{
+public:
+  bool shouldFail = false;
+  s32  numCalls = 0;
+
+  virtual const char* GetName() const override { return "Test"; }
+
+  virtual bool IsSupported(Anki::Vision::ImageEncoding format, Anki::Vision::ImageCacheSize size, bool isColor) const override
+  {
+    return isColor && (Anki::Vision::ImageCacheSize::Half == size);
+  }
+
+  virtual bool GetGray(const Anki::Vision::ImageBuffer& buffer, Anki::Vision::ImageCacheSize size,
+                       Anki::Vision::Image& gray) override
+  {
+    return false;
+  }
+
+  virtual bool GetRGB(const Anki::Vision::ImageBuffer& buffer, Anki::Vision::ImageCacheSize size,
+                      Anki::Vision::ImageRGB& rgb) override
+  {
+    ++numCalls;
+    if(shouldFail)
+    {
+      return false;
+    }
+    rgb.Allocate(buffer.GetNumRows()/2, buffer.GetNumCols()/2);
+    rgb.FillWith(Anki::Vision::PixelRGB(1,2,3));
+    return true;
+  }
+};
+
+}
+
+GTEST_TEST(ImageCache, ConversionAccelerator)
+{
+  using namespace Anki::Vision;
+
+  ImageRGB img(16, 32);
+  img.FillWith(PixelRGB(100,100,100));
+
+  auto accelerator = std::make_shared<TestAccelerator>();
+  ImageCache cache;
+  cache.SetConversionAccelerator(accelerator);
+  cache.Reset(img);
+
+  // Supported requests come from the accelerator
+  const ImageRGB& halfRGB = cache.GetRGB(ImageCacheSize::Half);
+  ASSERT_EQ(1, accelerator->numCalls);
+  ASSERT_EQ(8, halfRGB.GetNumRows());
+  ASSERT_TRUE(halfRGB(0,0) == PixelRGB(1,2,3));
+  ASSERT_EQ(img.GetTimestamp(), halfRGB.GetTimestamp());
+
+  // Everything else stays on the CPU
+  ASSERT_EQ(100, cache.GetGray(ImageCacheSize::Half)(0,0));
+  ASSERT_TRUE(cache.GetRGB(ImageCacheSize::Full)(0,0) == PixelRGB(100,100,100));
+  ASSERT_EQ(1, accelerator->numCalls);
+
+  // Failures fall back to the CPU
+  accelerator->shouldFail = true;
+  cache.Reset(img);
+  ASSERT_TRUE(cache.GetRGB(ImageCacheSize::Half)(0,0) == PixelRGB(100,100,100));
+  ASSERT_EQ(2, accelerator->numCalls);
+
+  // Without an accelerator nothing is offloaded
+  cache.SetConversionAccelerator(nullptr);
+  cache.Reset(img);
+  cache.GetRGB(ImageCacheSize::Half);
+  ASSERT_EQ(2, accelerator->numCalls);
+}
+
+GTEST_TEST(ImageCache, SharedImagesKeepTheirFrame)
+{
+  using namespace Anki::Vision;
+
+  ImageRGB img(16, 32);
+  img.FillWith(PixelRGB(10,20,30));
+  img.SetTimestamp(1);
+
+  ImageCache cache;
+  cache.Reset(img);
+
+  // Holding on by assignment only adds a reference
+  ImageRGB heldRGB = cache.GetRGB(ImageCacheSize::Half);
+  Image heldGray = cache.GetGray(ImageCacheSize::Half);
+  ASSERT_TRUE(heldRGB.IsShared());
+  ASSERT_EQ(heldRGB.GetDataPointer(), cache.GetRGB(ImageCacheSize::Half).GetDataPointer());
+
+  // The next frame goes into other memory, so the held images still have the first frame
+  img.FillWith(PixelRGB(200,200,200));
+  img.SetTimestamp(2);
+  cache.Reset(img);
+  const ImageRGB& nextRGB = cache.GetRGB(ImageCacheSize::Half);
+  ASSERT_NE(heldRGB.GetDataPointer(), nextRGB.GetDataPointer());
+  ASSERT_TRUE(nextRGB(0,0) == PixelRGB(200,200,200));
+  ASSERT_TRUE(heldRGB(0,0) == PixelRGB(10,20,30));
+  ASSERT_EQ(1u, heldRGB.GetTimestamp());
+  ASSERT_EQ(20, heldGray(0,0));
+  ASSERT_EQ(200, cache.GetGray(ImageCacheSize::Half)(0,0));
+
+  // Once let go of, the first frame's memory is reused rather than allocating again
+  const u8* heldRGBData = reinterpret_cast<const u8*>(heldRGB.GetDataPointer());
+  heldRGB = ImageRGB();
+  img.SetTimestamp(3);
+  cache.Reset(img);
+  cache.GetRGB(ImageCacheSize::Half); // unshared, so written in place
+  ImageRGB held2 = cache.GetRGB(ImageCacheSize::Half);
+  cache.Reset(img);
+  ASSERT_EQ(heldRGBData, reinterpret_cast<const u8*>(cache.GetRGB(ImageCacheSize::Half).GetDataPointer()));
+
+  // Copy-on-write for readers that do want to change theirs
+  held2.MakeUnique();
+  ASSERT_FALSE(held2.IsShared());
+  held2.FillWith(PixelRGB(0,0,0));
+  ASSERT_TRUE(cache.GetRGB(ImageCacheSize::Half)(0,0) == PixelRGB(200,200,200));
+}
+
+GTEST_TEST(ImageCache, MirroredRGB565Conversion)
+{
+  using namespace Anki::Vision;
+
+  // Columns not a multiple of the NEON width, so the scalar tail is covered too
+  ImageRGB rgb(16, 40);
+  for(s32 i = 0; i < rgb.GetNumRows(); ++i)
+  {
+    for(s32 j = 0; j < rgb.GetNumCols(); ++j)
+    {
+      rgb(i,j) = PixelRGB((u8)(i*13 + j*7), (u8)(i*5 + j*31 + 3), (u8)(255 - i*9 - j*3));
+    }
+  }
+  rgb.SetTimestamp(123);
+
+  std::array<u8,256> gammaLUT;
+  for(s32 value = 0; value < 256; ++value)
+  {
+    gammaLUT[value] = (u8)(255 - value);
+  }
+
+  // Reference: the separate steps mirror mode used to take
+  ImageRGB resized(8, 20);
+  rgb.Resize(resized, ResizeMethod::NearestNeighbor);
+  cv::flip(resized.get_CvMat_(), resized.get_CvMat_(), 1);
+
+  for(const bool swapRedBlue : {false, true})
+  {
+    ImageRGB565 reference;
+    if(swapRedBlue) {
+      reference.SetFromImageRGB2BGR(resized, gammaLUT);
+    } else {
+      reference.SetFromImageRGB(resized, gammaLUT);
+    }
+
+    ImageRGB565 result(8, 20);
+    ImageConversions::ResizeMirroredToRGB565(rgb, gammaLUT, swapRedBlue, result);
+    ASSERT_EQ(rgb.GetTimestamp(), result.GetTimestamp());
+    for(s32 i = 0; i < result.GetNumRows(); ++i)
+    {
+      for(s32 j = 0; j < result.GetNumCols(); ++j)
+      {
+        ASSERT_EQ(reference(i,j).GetValue(), result(i,j).GetValue()) << "(" << i << "," << j << ")";
+      }
+    }
+  }
+}
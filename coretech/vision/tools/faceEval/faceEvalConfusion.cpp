@@ -189,7 +189,7 @@ void FaceEvalConfusion::Run()
     img.Resize(_params.resizeFactor);
     
     const float kCropFactor = 1.f;
-    std::list<TrackedFace> faces;
+    std::vector<TrackedFace> faces;
     std::list<UpdatedFaceID> updatedIDs;
     DebugImageList<CompressedImage> debugImages;
     faceTracker.Update(img, kCropFactor, faces, updatedIDs, debugImages);
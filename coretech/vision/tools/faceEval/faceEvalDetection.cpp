@@ -86,7 +86,7 @@ void FaceEvalDetection::Run()
     img.Resize(_params.resizeFactor);
     
     const float kCropFactor = 1.f;
-    std::list<TrackedFace> faces;
+    std::vector<TrackedFace> faces;
     std::list<UpdatedFaceID> updatedIDs;
     DebugImageList<CompressedImage> debugImages;
     for(int iShow=0; iShow < _params.numTimesToShowImage; ++iShow)
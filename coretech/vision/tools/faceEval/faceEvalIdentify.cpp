@@ -197,7 +197,7 @@ int FaceEvalIdentify::EnrollFace(const std::set<std::string>& enrollFiles, const
     img.Resize(_params.resizeFactor);
     
     const float kCropFactor = 1.f;
-    std::list<TrackedFace> faces;
+    std::vector<TrackedFace> faces;
     std::list<UpdatedFaceID> updatedIDs;
     DebugImageList<CompressedImage> debugImages;
     faceTracker.Update(img, kCropFactor, faces, updatedIDs, debugImages);
@@ -286,7 +286,7 @@ void FaceEvalIdentify::TestIdentification()
     img.Resize(_params.resizeFactor);
     
     const float kCropFactor = 1.f;
-    std::list<TrackedFace> faces;
+    std::vector<TrackedFace> faces;
     std::list<UpdatedFaceID> updatedIDs;
     DebugImageList<CompressedImage> debugImages;
     faceTracker.Update(img, kCropFactor, faces, updatedIDs, debugImages);
@@ -120,7 +120,7 @@ void IFaceEval::DrawFaceOnImage(const TrackedFace& face, Vision::ImageRGB& img)
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void IFaceEval::DrawFaces(const Image& img, const std::list<TrackedFace>& faces,
+void IFaceEval::DrawFaces(const Image& img, const std::vector<TrackedFace>& faces,
                           const FailureFlags& failureFlags,
                           const std::string& displayStr,
                           int pauseTime_ms, const char* windowName,
@@ -43,7 +43,7 @@ public:
   using FailureFlags = Util::BitFlags8<FailureType>;
   
   // Does nothing if display is not enabled
-  void DrawFaces(const Image& img, const std::list<TrackedFace>& faces,
+  void DrawFaces(const Image& img, const std::vector<TrackedFace>& faces,
                  const FailureFlags& failureFlags,
                  const std::string& displayStr = "",
                  int pauseTime_ms = 0,
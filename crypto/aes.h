@@ -1,16 +1,31 @@
-#ifndef __AES_H
-#define __AES_H
-
-#include <stdint.h>
-#include <stddef.h>
-
-static const int AES_KEY_LENGTH = 16;
-
-void AES128_ECB_encrypt(const uint8_t* input, const uint8_t* key, uint8_t *output);
-void AES128_ECB_decrypt(const uint8_t* input, const uint8_t* key, uint8_t *output);
-
-void aes_fix_block(uint8_t* data, int& length);
-void aes_cfb_encode(const void* key, void* iv, const uint8_t* data, uint8_t* output, int length);
-void aes_cfb_decode(const void* key, const void* iv, const uint8_t* data, uint8_t* output, int length, void* iv_out = NULL);
-
-#endif
+#ifndef __AES_H
+#define __AES_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+static const int AES_KEY_LENGTH = 16;
+
+// Round keys for AES-128, expanded once so a whole buffer (or many messages under the same key) can be encrypted
+// without redoing the key schedule for every block
+typedef struct {
+  uint8_t round_key[176];
+} AES128_KEY;
+
+void AES128_expand_key(const uint8_t* key, AES128_KEY* expanded);
+void AES128_encrypt_block(const AES128_KEY* key, const uint8_t* input, uint8_t* output);
+
+void AES128_ECB_encrypt(const uint8_t* input, const uint8_t* key, uint8_t *output);
+void AES128_ECB_decrypt(const uint8_t* input, const uint8_t* key, uint8_t *output);
+
+void aes_fix_block(uint8_t* data, int& length);
+
+// Encrypts or decrypts a whole buffer at a time, with the ARMv8 AES instructions when the CPU has them. The output
+// may overlap the input as long as it doesn't start after it (packet.cpp encodes in place behind the IV)
+void aes_cfb_encode(const AES128_KEY* key, void* iv, const uint8_t* data, uint8_t* output, int length);
+void aes_cfb_decode(const AES128_KEY* key, const void* iv, const uint8_t* data, uint8_t* output, int length, void* iv_out = NULL);
+
+void aes_cfb_encode(const void* key, void* iv, const uint8_t* data, uint8_t* output, int length);
+void aes_cfb_decode(const void* key, const void* iv, const uint8_t* data, uint8_t* output, int length, void* iv_out = NULL);
+
+#endif
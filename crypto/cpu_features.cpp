@@ -0,0 +1,42 @@
+#include "cpu_features.h"
+
+#if defined(__linux__) && (defined(__aarch64__) || defined(__arm__))
+#include <sys/auxv.h>
+#define HAVE_AUXV
+#endif
+
+// From asm/hwcap.h, which older sysroots don't have all of
+#if defined(__aarch64__)
+static const unsigned long HWCAP_TYPE = 16;       // AT_HWCAP
+static const unsigned long HWCAP_AES_BIT = 1 << 3;
+static const unsigned long HWCAP_SHA1_BIT = 1 << 5;
+#else
+static const unsigned long HWCAP_TYPE = 26;       // AT_HWCAP2
+static const unsigned long HWCAP_AES_BIT = 1 << 0;
+static const unsigned long HWCAP_SHA1_BIT = 1 << 2;
+#endif
+
+static bool s_acceleration_disabled = false;
+
+static unsigned long get_hwcap() {
+#ifdef HAVE_AUXV
+  // Read once, the auxiliary vector doesn't change
+  static const unsigned long hwcap = getauxval(HWCAP_TYPE);
+  return hwcap;
+#else
+  (void)HWCAP_TYPE;
+  return 0;
+#endif
+}
+
+bool cpu_has_aes() {
+  return !s_acceleration_disabled && (get_hwcap() & HWCAP_AES_BIT) != 0;
+}
+
+bool cpu_has_sha1() {
+  return !s_acceleration_disabled && (get_hwcap() & HWCAP_SHA1_BIT) != 0;
+}
+
+void cpu_features_disable_acceleration(bool disable) {
+  s_acceleration_disabled = disable;
+}
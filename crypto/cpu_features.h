@@ -0,0 +1,12 @@
+#ifndef __CPU_FEATURES_H
+#define __CPU_FEATURES_H
+
+// ARMv8 crypto extension instructions. These are only used when the CPU has them and the file using them was
+// built with crypto in -march/-mfpu (__ARM_FEATURE_CRYPTO), otherwise the portable code runs
+bool cpu_has_aes();
+bool cpu_has_sha1();
+
+// Forces the portable implementations, for comparing them against the accelerated ones
+void cpu_features_disable_acceleration(bool disable);
+
+#endif
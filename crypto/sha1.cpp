@@ -13,6 +13,12 @@
 #include <stdlib.h>
 #include <string.h>
 #include "sha1.h"
+#include "cpu_features.h"
+
+#if defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#define HAVE_SHA1_INSTRUCTIONS
+#endif
 
 /****************************** MACROS ******************************/
 #define ROTLEFT(a, b) ((a << b) | (a >> (32 - b)))
@@ -75,6 +81,60 @@ void sha1_transform(SHA1_CTX *ctx, const uint8_t data[])
 	ctx->state[4] += e;
 }
 
+#ifdef HAVE_SHA1_INSTRUCTIONS
+// Four rounds per instruction. The message schedule for rounds 16-79 comes from SHA1SU0/SU1 four words at a time,
+// each group replacing the one it was computed from
+static void sha1_transform_neon(SHA1_CTX *ctx, const uint8_t data[], size_t num_blocks)
+{
+	const uint32x4_t k[4] = {
+		vdupq_n_u32(ctx->k[0]), vdupq_n_u32(ctx->k[1]), vdupq_n_u32(ctx->k[2]), vdupq_n_u32(ctx->k[3])
+	};
+	uint32x4_t abcd = vld1q_u32(ctx->state);
+	uint32_t e = ctx->state[4];
+
+	for (; num_blocks > 0; --num_blocks, data += 64) {
+		const uint32x4_t abcd_saved = abcd;
+		const uint32_t e_saved = e;
+
+		uint32x4_t w[4];
+		for (int i = 0; i < 4; ++i)
+			w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+
+		for (int i = 0; i < 20; ++i) {
+			const uint32x4_t wk = vaddq_u32(w[i & 3], k[i / 5]);
+			const uint32_t e_next = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+			if (i < 5)
+				abcd = vsha1cq_u32(abcd, e, wk);
+			else if (i < 10 || i >= 15)
+				abcd = vsha1pq_u32(abcd, e, wk);
+			else
+				abcd = vsha1mq_u32(abcd, e, wk);
+			e = e_next;
+			if (i < 16)
+				w[i & 3] = vsha1su1q_u32(vsha1su0q_u32(w[i & 3], w[(i + 1) & 3], w[(i + 2) & 3]), w[(i + 3) & 3]);
+		}
+
+		abcd = vaddq_u32(abcd, abcd_saved);
+		e += e_saved;
+	}
+
+	vst1q_u32(ctx->state, abcd);
+	ctx->state[4] = e;
+}
+#endif
+
+static void sha1_transform_blocks(SHA1_CTX *ctx, const uint8_t data[], size_t num_blocks)
+{
+#ifdef HAVE_SHA1_INSTRUCTIONS
+	if (cpu_has_sha1()) {
+		sha1_transform_neon(ctx, data, num_blocks);
+		return;
+	}
+#endif
+	for (; num_blocks > 0; --num_blocks, data += 64)
+		sha1_transform(ctx, data);
+}
+
 void sha1_init(SHA1_CTX *ctx)
 {
 	ctx->datalen = 0;
@@ -92,17 +152,30 @@ void sha1_init(SHA1_CTX *ctx)
 
 void sha1_update(SHA1_CTX *ctx, const uint8_t data[], size_t len)
 {
-	size_t i;
-
-	for (i = 0; i < len; ++i) {
-		ctx->data[ctx->datalen] = data[i];
-		ctx->datalen++;
-		if (ctx->datalen == 64) {
-			sha1_transform(ctx, ctx->data);
-			ctx->bitlen += 512;
-			ctx->datalen = 0;
-		}
+	// Top up a partial block first, then hash whole blocks straight from the input
+	if (ctx->datalen > 0) {
+		const size_t n = (len < 64 - ctx->datalen) ? len : (64 - ctx->datalen);
+		memcpy(ctx->data + ctx->datalen, data, n);
+		ctx->datalen += n;
+		data += n;
+		len -= n;
+		if (ctx->datalen < 64)
+			return;
+		sha1_transform_blocks(ctx, ctx->data, 1);
+		ctx->bitlen += 512;
+		ctx->datalen = 0;
+	}
+
+	const size_t num_blocks = len / 64;
+	if (num_blocks > 0) {
+		sha1_transform_blocks(ctx, data, num_blocks);
+		ctx->bitlen += 512 * (uint64_t)num_blocks;
+		data += 64 * num_blocks;
+		len -= 64 * num_blocks;
 	}
+
+	memcpy(ctx->data, data, len);
+	ctx->datalen = len;
 }
 
 void sha1_final(SHA1_CTX *ctx, uint8_t hash[])
@@ -121,7 +194,7 @@ void sha1_final(SHA1_CTX *ctx, uint8_t hash[])
 		ctx->data[i++] = 0x80;
 		while (i < 64)
 			ctx->data[i++] = 0x00;
-		sha1_transform(ctx, ctx->data);
+		sha1_transform_blocks(ctx, ctx->data, 1);
 		memset(ctx->data, 0, 56);
 	}
 
@@ -135,7 +208,7 @@ void sha1_final(SHA1_CTX *ctx, uint8_t hash[])
 	ctx->data[58] = ctx->bitlen >> 40;
 	ctx->data[57] = ctx->bitlen >> 48;
 	ctx->data[56] = ctx->bitlen >> 56;
-	sha1_transform(ctx, ctx->data);
+	sha1_transform_blocks(ctx, ctx->data, 1);
 
 	// Since this implementation uses little endian byte ordering and MD uses big endian,
 	// reverse all the bytes when copying the final state to the output hash.
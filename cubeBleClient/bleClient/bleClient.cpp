@@ -168,6 +168,36 @@ void BleClient::DisconnectFromCube()
 }
 
 
+void BleClient::SetHighConnectionPriority(const bool highPriority)
+{
+  const bool changed = (highPriority != _highConnectionPriority);
+  _highConnectionPriority = highPriority;
+  
+  // While the firmware check is pending, the parameters are requested when it completes
+  if (changed && IsConnectedToServer() && IsConnectedToCube()) {
+    RequestConnectionParameters();
+  }
+}
+
+
+void BleClient::RequestConnectionParameters()
+{
+  if (_highConnectionPriority) {
+    RequestConnectionParameterUpdate(_cubeAddress,
+        kGattConnectionIntervalHighPriorityMinimum,
+        kGattConnectionIntervalHighPriorityMaximum,
+        kGattConnectionLatencyDefault,
+        kGattConnectionTimeoutDefault);
+  } else {
+    RequestConnectionParameterUpdate(_cubeAddress,
+        kGattConnectionIntervalMinimumDefault,
+        kGattConnectionIntervalMaximumDefault,
+        kGattConnectionLatencyDefault,
+        kGattConnectionTimeoutDefault);
+  }
+}
+
+
 void BleClient::StartScanForCubes()
 {
   if (!IsConnectedToServer()) {
@@ -306,6 +336,7 @@ void BleClient::OnCharacteristicReadResult(const int connection_id,
   if (isAppVersion && _pendingFirmwareCheckOrUpdate) {
     const auto& cubeFirmwareVersion = std::string(data.begin(), data.end());
 
+    // Firmware check/update always gets the short connection interval
     RequestConnectionParameterUpdate(_cubeAddress,
         kGattConnectionIntervalHighPriorityMinimum,
         kGattConnectionIntervalHighPriorityMaximum,
@@ -317,6 +348,9 @@ void BleClient::OnCharacteristicReadResult(const int connection_id,
     if (cubeFirmwareVersion == _cubeFirmwareVersionOnDisk) {
       // Firmware versions match! Yay.
       _pendingFirmwareCheckOrUpdate = false;
+      if (!_highConnectionPriority) {
+        RequestConnectionParameters();
+      }
     } else {
       // Flash the cube with the firmware we have on disk
       PRINT_NAMED_INFO("BleClient.OnCharacteristicReadResult.FirmwareVersionMismatch",
@@ -348,6 +382,9 @@ void BleClient::OnReceiveMessage(const int connection_id,
       DASMSG_SET(s1, _cubeAddress, "Cube factory ID");
       DASMSG_SET(s2, cubeFirmwareVersion, "Cube firmware version");
       DASMSG_SEND();
+      if (!_highConnectionPriority) {
+        RequestConnectionParameters();
+      }
     } else {
       PRINT_NAMED_WARNING("BleClient.OnReceiveMessage.FlashingFailure","got = %s exp = %s",cubeFirmwareVersion.c_str(), _cubeFirmwareVersionOnDisk.c_str());
       DASMSG(cube_firmware_flash_fail, "cube.firmware_flash_fail", "Flashing cube firmware failed");
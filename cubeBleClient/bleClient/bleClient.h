@@ -47,6 +47,11 @@ namespace Vector {
     
     void DisconnectFromCube();
     
+    // Whether the cube connection should use the high priority (short) connection interval or
+    // the default one. Applied to the current connection right away, and to future connections
+    // once the firmware check/update (which always uses the high priority interval) is done.
+    void SetHighConnectionPriority(const bool highPriority);
+    
     bool IsConnectedToCube() const {
       return (_connectionId >= 0) && !_pendingFirmwareCheckOrUpdate;
     };
@@ -127,6 +132,9 @@ namespace Vector {
     // Send the application firmware to the cube over BLE
     void FlashCube();
     
+    // Request connection parameters for the current connection according to _highConnectionPriority
+    void RequestConnectionParameters();
+    
     // Connection id for the single cube we are connected to.
     // Equal to -1 if we are not connected to a cube.
     std::atomic<int> _connectionId{-1};
@@ -138,6 +146,9 @@ namespace Vector {
     // OTA'ing the cube.
     std::atomic<bool> _pendingFirmwareCheckOrUpdate{false};
     
+    // Connection interval to request once connected (see SetHighConnectionPriority)
+    std::atomic<bool> _highConnectionPriority{true};
+    
     AdvertisementCallback          _advertisementCallback;
     ReceiveDataCallback            _receiveDataCallback;
     ScanFinishedCallback           _scanFinishedCallback;
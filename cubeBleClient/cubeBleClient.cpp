@@ -94,10 +94,72 @@ bool CubeBleClient::SendMessageToLightCube(const MessageEngineToCube& msg)
                   "Current connection state %s, current cube '%s'",
                   CubeConnectionStateToString(_cubeConnectionState),
                   _currentCube.c_str())) {
-    result = SendMessageInternal(msg);
+    const auto tag = msg.GetTag();
+    if ((tag == MessageEngineToCubeTag::lightKeyframes) && _queuedLightsComplete) {
+      // Keyframes are always sent starting from the first keyframe slot, so a new set of
+      // lights overwrites everything in the queued set
+      PRINT_CH_DEBUG("CubeBleClient", "CubeBleClient.SendMessageToLightCube.DroppingSupersededLights",
+                     "Dropping %zu queued messages",
+                     _queuedMessages.size());
+      _queuedMessages.clear();
+    }
+    _queuedMessages.push_back(PackMessage(msg));
+    _queuedLightsComplete = (tag == MessageEngineToCubeTag::lightSequence);
+    result = true;
   }
   return result;
 }
+
+
+void CubeBleClient::FlushMessages()
+{
+  if (!_inited) {
+    return;
+  }
+  
+  const bool connected = (_cubeConnectionState == CubeConnectionState::Connected);
+  
+  // Connection management goes ahead of lights
+  if (_connectionTypeChanged && connected) {
+    SetConnectionTypeInternal(_connectionType);
+    _connectionTypeChanged = false;
+  }
+  
+  if (connected) {
+    for (const auto& msgData : _queuedMessages) {
+      if (!SendMessageInternal(msgData)) {
+        PRINT_NAMED_WARNING("CubeBleClient.FlushMessages.SendFailed",
+                            "Failed to send message to cube %s",
+                            _currentCube.c_str());
+        break;
+      }
+    }
+  } else if (!_queuedMessages.empty()) {
+    PRINT_NAMED_WARNING("CubeBleClient.FlushMessages.CubeNotConnected",
+                        "Dropping %zu queued messages. Current connection state %s",
+                        _queuedMessages.size(),
+                        CubeConnectionStateToString(_cubeConnectionState));
+  }
+  _queuedMessages.clear();
+  _queuedLightsComplete = false;
+}
+
+
+void CubeBleClient::SetConnectionType(const CubeConnectionType type)
+{
+  if (type != _connectionType) {
+    _connectionType = type;
+    _connectionTypeChanged = true;
+  }
+}
+
+
+std::vector<u8> CubeBleClient::PackMessage(const MessageEngineToCube& msg)
+{
+  std::vector<u8> msgData(msg.Size());
+  msg.Pack(msgData.data(), msgData.size());
+  return msgData;
+}
   
   
 bool CubeBleClient::RequestConnectToCube(const BleFactoryId& factoryId)
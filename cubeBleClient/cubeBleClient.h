@@ -15,11 +15,13 @@
 #define __Victor_CubeBleClient_H__
 
 #include "clad/types/cubeCommsTypes.h"
+#include "clad/types/cubeConnectionTypes.h"
 
 #include "coretech/common/shared/types.h"
 
 #include <vector>
 #include <functional>
+#include <string>
 
 // Forward declaration
 namespace webots {
@@ -84,9 +86,23 @@ public:
   // Stop scanning for available cubes
   void StopScanning();
   
-  // Send a message to the connected light cube. Returns true on success.
+  // Queue a message for the connected light cube. Returns true on success. Queued messages
+  // are sent by FlushMessages(). A complete set of light messages (keyframe chunks followed by
+  // a light sequence) which has not been sent yet is dropped once the next set starts, since
+  // the newer lights replace it on the cube anyway.
   bool SendMessageToLightCube(const MessageEngineToCube&);
   
+  // Sends everything queued by SendMessageToLightCube() in one go, so that the writes can share
+  // connection events rather than being spread over the tick. Any change of connection type is
+  // requested first, so that lights go out at the new connection interval. Should be called once
+  // per tick, after everything that might send lights has been updated.
+  void FlushMessages();
+  
+  // Sets how the connected cube is being used. Interactable connections (games, light animations)
+  // get a short connection interval so that lights keep up. Background connections go back to the
+  // default interval, leaving radio time to others sharing the BLE controller (e.g. switchboard).
+  void SetConnectionType(const CubeConnectionType type);
+  
   // Request to connect to an advertising cube. Returns true on success.
   bool RequestConnectToCube(const BleFactoryId&);
   
@@ -105,6 +121,8 @@ private:
   void SendLightsOffToCube();
 #endif
   
+  static std::vector<u8> PackMessage(const MessageEngineToCube& msg);
+  
   // callbacks for advertisement messages:
   std::vector<ObjectAvailableCallback> _objectAvailableCallbacks;
   
@@ -129,6 +147,15 @@ private:
   // connected to, or pending connection or disconnection to.
   // It is an empty string if there is no current cube.
   BleFactoryId _currentCube;
+  
+  // Packed messages waiting for FlushMessages(), in the order they were sent
+  std::vector<std::vector<u8>> _queuedMessages;
+  
+  // True if the last queued message ends a set of light messages
+  bool _queuedLightsComplete = false;
+  
+  CubeConnectionType _connectionType = CubeConnectionType::Interactable;
+  bool _connectionTypeChanged = false;
 
 ////////////////////////////////////////////////////////////////////////////
 // ---------- Implementation-specific (mac vs. vicos) methods. ---------- //
@@ -151,7 +178,9 @@ private:
   
   void StopScanInternal();
   
-  bool SendMessageInternal(const MessageEngineToCube&);
+  bool SendMessageInternal(const std::vector<u8>& msgData);
+  
+  void SetConnectionTypeInternal(const CubeConnectionType type);
   
   bool RequestConnectInternal(const BleFactoryId&);
   
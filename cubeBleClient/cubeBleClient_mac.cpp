@@ -148,18 +148,22 @@ void CubeBleClient::StopScanInternal()
 }
 
 
-bool CubeBleClient::SendMessageInternal(const MessageEngineToCube& msg)
+bool CubeBleClient::SendMessageInternal(const std::vector<u8>& msgData)
 {
   const int channel = GetEmitterChannel(_currentCube);
   _cubeEmitter->setChannel(channel);
   
-  u8 buff[msg.Size()];
-  msg.Pack(buff, msg.Size());
-  int res = _cubeEmitter->send(buff, (int) msg.Size());
+  int res = _cubeEmitter->send(msgData.data(), (int) msgData.size());
   
   // return value of 1 indicates that the message was successfully queued (see Webots documentation)
   return (res == 1);
 }
+
+
+void CubeBleClient::SetConnectionTypeInternal(const CubeConnectionType type)
+{
+  // Simulated cubes have no connection interval
+}
   
   
 bool CubeBleClient::RequestConnectInternal(const BleFactoryId& factoryId)
@@ -325,8 +329,9 @@ void CubeBleClient::SendLightsOffToCube()
   
   CubeLightSequence lightSequence(0, {{0, 0, 0, 0}});
   
-  SendMessageToLightCube(MessageEngineToCube(std::move(keyframeChunk)));
-  SendMessageToLightCube(MessageEngineToCube(std::move(lightSequence)));
+  // Sent immediately rather than queued, since this is used while disconnecting
+  SendMessageInternal(PackMessage(MessageEngineToCube(std::move(keyframeChunk))));
+  SendMessageInternal(PackMessage(MessageEngineToCube(std::move(lightSequence))));
 }
 
 
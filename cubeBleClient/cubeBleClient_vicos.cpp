@@ -332,15 +332,21 @@ void CubeBleClient::StopScanInternal()
 }
 
 
-bool CubeBleClient::SendMessageInternal(const MessageEngineToCube& msg)
+bool CubeBleClient::SendMessageInternal(const std::vector<u8>& msgData)
 {
-  u8 buff[msg.Size()];
-  msg.Pack(buff, msg.Size());
-  const auto& msgVec = std::vector<u8>(buff, buff + msg.Size());
-
   // Sending from this thread for now. May need to queue this and
   // send it on the client thread if ipc client is not thread safe.
-  return _bleClient->Send(msgVec);
+  return _bleClient->Send(msgData);
+}
+
+
+void CubeBleClient::SetConnectionTypeInternal(const CubeConnectionType type)
+{
+  PRINT_NAMED_INFO("CubeBleClient.SetConnectionTypeInternal",
+                   "Requesting %s connection parameters for cube %s",
+                   EnumToString(type),
+                   _currentCube.c_str());
+  _bleClient->SetHighConnectionPriority(type != CubeConnectionType::Background);
 }
 
 
@@ -0,0 +1,488 @@
+/**
+* File: victor/dasmgr/dasEventSpool.cpp
+*
+* Author: Victor Rebuild
+* Date:   10/14/2026
+*
+* Description: DASEventSpool class implementation
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+
+#include "dasEventSpool.h"
+
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Log options
+#define LOG_CHANNEL "DASManager"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+
+  // File layout: header, then records. The header's size is updated after every record, so whatever is past it (a
+  // record that was being written, or the unused part of a preallocated file) is ignored
+  struct SpoolHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t size;
+  };
+
+  constexpr const uint32_t kSpoolMagic = 0x42534144; // "DASB"
+  constexpr const uint32_t kSpoolVersion = 1;
+
+  // A string record gives the next interned string id its value. An event record's interned fields refer to them
+  constexpr const uint8_t kStringRecord = 1;
+  constexpr const uint8_t kEventRecord = 2;
+
+  constexpr const size_t kFirstInlineField = (size_t) DASEventSpool::Field::S1;
+  constexpr const size_t kFirstIntField = (size_t) DASEventSpool::Field::I1;
+  constexpr const size_t kNumFields = (size_t) DASEventSpool::Field::Count;
+  static_assert(kNumFields - kFirstIntField <= 8, "Integer field mask must fit in a byte");
+
+  void WriteVarint(std::vector<uint8_t> & out, uint64_t value)
+  {
+    while (value >= 0x80) {
+      out.push_back((uint8_t) (value | 0x80));
+      value >>= 7;
+    }
+    out.push_back((uint8_t) value);
+  }
+
+  void WriteSignedVarint(std::vector<uint8_t> & out, int64_t value)
+  {
+    WriteVarint(out, ((uint64_t) value << 1) ^ (uint64_t) (value >> 63));
+  }
+
+  void WriteString(std::vector<uint8_t> & out, const char * value, size_t size)
+  {
+    WriteVarint(out, size);
+    out.insert(out.end(), value, value + size);
+  }
+
+  // JSON helpers. Like the JSON that used to be spooled, values aren't escaped
+  void AppendKey(std::string & json, const char * key)
+  {
+    json += ",\"";
+    json += key;
+    json += "\":";
+  }
+
+  void AppendString(std::string & json, const char * key, const std::string & value)
+  {
+    AppendKey(json, key);
+    json += '"';
+    json += value;
+    json += '"';
+  }
+
+  void AppendInt(std::string & json, const char * key, int64_t value)
+  {
+    AppendKey(json, key);
+    json += std::to_string(value);
+  }
+
+  const char * GetLevelName(uint8_t level)
+  {
+    switch ((Util::LogLevel) level)
+    {
+      case Util::LogLevel::LOG_LEVEL_ERROR:
+        return "error";
+      case Util::LogLevel::LOG_LEVEL_WARN:
+        return "warning";
+      case Util::LogLevel::LOG_LEVEL_EVENT:
+        return "event";
+      case Util::LogLevel::LOG_LEVEL_INFO:
+        return "info";
+      case Util::LogLevel::LOG_LEVEL_DEBUG:
+        return "debug";
+      case Util::LogLevel::_LOG_LEVEL_COUNT:
+        break;
+    }
+    return "count";
+  }
+
+} // end anonymous namespace
+
+//
+// Reads the records of a spool, keeping the same interned strings and deltas as the writer
+//
+class DASEventSpool::Decoder {
+public:
+  struct DecodedEvent {
+    int64_t ts = 0;
+    uint64_t seq = 0;
+    uint8_t level = 0;
+    std::array<std::string, kNumFields> strings;
+    std::array<int64_t, kNumFields> ints;
+    uint8_t intMask = 0;
+  };
+
+  Decoder(const uint8_t * begin, const uint8_t * end)
+  : _pos(begin)
+  , _end(end)
+  {
+  }
+
+  // Returns false at the end of the records, or at the first one that doesn't make sense
+  bool Next(DecodedEvent & event)
+  {
+    while (_pos < _end) {
+      const uint8_t tag = *_pos++;
+      if (tag == kStringRecord) {
+        std::string value;
+        if (!ReadString(value)) {
+          return Fail();
+        }
+        interned.push_back(std::move(value));
+      } else if (tag == kEventRecord) {
+        return ReadEvent(event) || Fail();
+      } else {
+        return Fail();
+      }
+    }
+    return false;
+  }
+
+  bool IsCorrupt() const { return _corrupt; }
+
+  std::vector<std::string> interned;
+  int64_t lastTs = 0;
+  uint64_t lastSeq = 0;
+
+private:
+  const uint8_t * _pos;
+  const uint8_t * _end;
+  bool _corrupt = false;
+
+  bool Fail()
+  {
+    _corrupt = true;
+    _pos = _end;
+    return false;
+  }
+
+  bool ReadVarint(uint64_t & value)
+  {
+    value = 0;
+    for (unsigned int shift = 0; (_pos < _end) && (shift < 64); shift += 7) {
+      const uint8_t byte = *_pos++;
+      value |= (uint64_t) (byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  bool ReadSignedVarint(int64_t & value)
+  {
+    uint64_t zigzag = 0;
+    if (!ReadVarint(zigzag)) {
+      return false;
+    }
+    value = (int64_t) (zigzag >> 1) ^ -(int64_t) (zigzag & 1);
+    return true;
+  }
+
+  bool ReadString(std::string & value)
+  {
+    uint64_t size = 0;
+    if (!ReadVarint(size) || (size > (uint64_t) (_end - _pos))) {
+      return false;
+    }
+    value.assign((const char *) _pos, (size_t) size);
+    _pos += size;
+    return true;
+  }
+
+  bool ReadEvent(DecodedEvent & event)
+  {
+    int64_t tsDelta = 0;
+    uint64_t seqDelta = 0;
+    if (!ReadSignedVarint(tsDelta) || !ReadVarint(seqDelta) || (_pos >= _end)) {
+      return false;
+    }
+    lastTs += tsDelta;
+    lastSeq += seqDelta;
+    event.ts = lastTs;
+    event.seq = lastSeq;
+    event.level = *_pos++;
+
+    for (size_t i = 0; i < kFirstInlineField; ++i) {
+      uint64_t id = 0;
+      if (!ReadVarint(id) || (id > interned.size())) {
+        return false;
+      }
+      event.strings[i] = (id == 0) ? "" : interned[(size_t) id - 1];
+    }
+    for (size_t i = kFirstInlineField; i < kFirstIntField; ++i) {
+      if (!ReadString(event.strings[i])) {
+        return false;
+      }
+    }
+    if (_pos >= _end) {
+      return false;
+    }
+    event.intMask = *_pos++;
+    for (size_t i = kFirstIntField; i < kNumFields; ++i) {
+      if ((event.intMask & (1 << (i - kFirstIntField))) && !ReadSignedVarint(event.ints[i])) {
+        return false;
+      }
+    }
+    return true;
+  }
+};
+
+void DASEventSpool::Event::Set(Field field, const char * value, size_t size)
+{
+  values[(size_t) field] = value;
+  sizes[(size_t) field] = size;
+}
+
+DASEventSpool::~DASEventSpool()
+{
+  Close();
+}
+
+bool DASEventSpool::Open(const std::string & path, size_t capacity)
+{
+  Close();
+
+  _fd = open(path.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR);
+  if (_fd < 0) {
+    LOG_ERROR("DASEventSpool.Open", "Unable to open %s (errno %d)", path.c_str(), errno);
+    return false;
+  }
+
+  // Pick up after the events already in the file, if it has any
+  struct stat st;
+  const size_t fileSize = (fstat(_fd, &st) == 0) ? (size_t) st.st_size : 0;
+  _capacity = std::max(capacity, fileSize);
+  if (ftruncate(_fd, (off_t) _capacity) != 0) {
+    LOG_ERROR("DASEventSpool.Open", "Unable to size %s to %zu (errno %d)", path.c_str(), _capacity, errno);
+    Close();
+    return false;
+  }
+
+  void * data = mmap(nullptr, _capacity, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+  if (data == MAP_FAILED) {
+    LOG_ERROR("DASEventSpool.Open", "Unable to map %s (errno %d)", path.c_str(), errno);
+    Close();
+    return false;
+  }
+  _data = (uint8_t *) data;
+
+  auto * header = (SpoolHeader *) _data;
+  const bool hasEvents = (fileSize >= sizeof(SpoolHeader)) &&
+                         (header->magic == kSpoolMagic) &&
+                         (header->version == kSpoolVersion) &&
+                         (header->size <= _capacity - sizeof(SpoolHeader));
+  if (hasEvents) {
+    Decoder decoder(_data + sizeof(SpoolHeader), _data + sizeof(SpoolHeader) + header->size);
+    Decoder::DecodedEvent event;
+    while (decoder.Next(event)) {
+      ++_numEvents;
+    }
+    if (decoder.IsCorrupt()) {
+      // Events can't be taken apart once one is bad, so start over rather than append to a file that can't be read
+      LOG_ERROR("DASEventSpool.Open.Corrupt", "Dropping %zu events from %s", _numEvents, path.c_str());
+      _numEvents = 0;
+    } else {
+      for (uint32_t id = 0; id < decoder.interned.size(); ++id) {
+        _internedIDs.emplace(decoder.interned[id], id);
+      }
+      _lastTs = decoder.lastTs;
+      _lastSeq = decoder.lastSeq;
+      _size = (size_t) header->size;
+    }
+  }
+  if (_size == 0) {
+    header->magic = kSpoolMagic;
+    header->version = kSpoolVersion;
+    header->size = 0;
+  }
+  return true;
+}
+
+uint32_t DASEventSpool::Intern(const char * value, size_t size, std::vector<uint8_t> & record)
+{
+  const auto result = _internedIDs.emplace(std::string(value, size), (uint32_t) _internedIDs.size());
+  if (result.second) {
+    record.push_back(kStringRecord);
+    WriteString(record, value, size);
+  }
+  return result.first->second;
+}
+
+bool DASEventSpool::Append(const Event & event)
+{
+  if (_data == nullptr) {
+    return false;
+  }
+
+  std::vector<uint8_t> strings;
+  std::vector<uint8_t> record;
+  std::vector<std::string> newlyInterned;
+
+  // Interned strings new to this file are written ahead of the event
+  std::array<uint32_t, kFirstInlineField> ids;
+  for (size_t i = 0; i < kFirstInlineField; ++i) {
+    if (event.sizes[i] == 0) {
+      ids[i] = 0;
+      continue;
+    }
+    const size_t numInterned = _internedIDs.size();
+    ids[i] = Intern(event.values[i], event.sizes[i], strings) + 1;
+    if (_internedIDs.size() != numInterned) {
+      newlyInterned.emplace_back(event.values[i], event.sizes[i]);
+    }
+  }
+
+  record.push_back(kEventRecord);
+  WriteSignedVarint(record, event.ts - _lastTs);
+  WriteVarint(record, event.seq - _lastSeq);
+  record.push_back((uint8_t) event.level);
+  for (size_t i = 0; i < kFirstInlineField; ++i) {
+    WriteVarint(record, ids[i]);
+  }
+  for (size_t i = kFirstInlineField; i < kFirstIntField; ++i) {
+    WriteString(record, event.values[i], event.sizes[i]);
+  }
+  uint8_t intMask = 0;
+  std::vector<uint8_t> ints;
+  for (size_t i = kFirstIntField; i < kNumFields; ++i) {
+    if (event.sizes[i] > 0) {
+      intMask |= (uint8_t) (1 << (i - kFirstIntField));
+      WriteSignedVarint(ints, std::atoll(std::string(event.values[i], event.sizes[i]).c_str()));
+    }
+  }
+  record.push_back(intMask);
+  record.insert(record.end(), ints.begin(), ints.end());
+
+  if (sizeof(SpoolHeader) + _size + strings.size() + record.size() > _capacity) {
+    for (const auto & value : newlyInterned) {
+      _internedIDs.erase(value);
+    }
+    return false;
+  }
+
+  uint8_t * dest = _data + sizeof(SpoolHeader) + _size;
+  if (!strings.empty()) {
+    memcpy(dest, strings.data(), strings.size());
+  }
+  memcpy(dest + strings.size(), record.data(), record.size());
+  _size += strings.size() + record.size();
+  ((SpoolHeader *) _data)->size = _size;
+
+  _lastTs = event.ts;
+  _lastSeq = event.seq;
+  ++_numEvents;
+  return true;
+}
+
+void DASEventSpool::Close()
+{
+  if (_data != nullptr) {
+    munmap(_data, _capacity);
+    _data = nullptr;
+  }
+  if (_fd >= 0) {
+    // Trim the preallocated space so the file holds only what was written
+    if (ftruncate(_fd, (off_t) (sizeof(SpoolHeader) + _size)) != 0) {
+      LOG_ERROR("DASEventSpool.Close", "Unable to trim spool (errno %d)", errno);
+    }
+    close(_fd);
+    _fd = -1;
+  }
+  _capacity = 0;
+  _size = 0;
+  _numEvents = 0;
+  _internedIDs.clear();
+  _lastTs = 0;
+  _lastSeq = 0;
+}
+
+bool DASEventSpool::ConvertToJson(const std::string & path, std::string & json)
+{
+  const std::vector<uint8_t> & data = Util::FileUtils::ReadFileAsBinary(path);
+  if (data.size() < sizeof(SpoolHeader)) {
+    LOG_ERROR("DASEventSpool.ConvertToJson", "Unable to read %s", path.c_str());
+    return false;
+  }
+
+  SpoolHeader header;
+  memcpy(&header, data.data(), sizeof(header));
+  if ((header.magic != kSpoolMagic) || (header.version != kSpoolVersion)) {
+    LOG_ERROR("DASEventSpool.ConvertToJson", "%s is not a version %u spool", path.c_str(), kSpoolVersion);
+    return false;
+  }
+
+  static const std::array<const char *, kNumFields> keys = {{
+    "source", "robot_id", "robot_version", "boot_id", "profile_id", "feature_type", "feature_run_id",
+    "ble_conn_id", "wifi_conn_id", "event", "s1", "s2", "s3", "s4", "i1", "i2", "i3", "i4", "uptime_ms"
+  }};
+
+  const size_t size = (size_t) std::min<uint64_t>(header.size, data.size() - sizeof(header));
+  Decoder decoder(data.data() + sizeof(header), data.data() + sizeof(header) + size);
+  Decoder::DecodedEvent event;
+  size_t numEvents = 0;
+
+  json.clear();
+  json.reserve(size * 4);
+  json += '[';
+  while (decoder.Next(event)) {
+    if (numEvents++ > 0) {
+      json += ',';
+    }
+    // Same fields, in the same order, as the JSON dasmgr spooled before
+    json += "{\"source\":\"";
+    json += event.strings[(size_t) Field::Source];
+    json += '"';
+    AppendInt(json, "ts", event.ts);
+    AppendInt(json, "seq", (int64_t) event.seq);
+    AppendKey(json, "level");
+    json += '"';
+    json += GetLevelName(event.level);
+    json += '"';
+    for (size_t i = (size_t) Field::RobotID; i <= (size_t) Field::FeatureRunID; ++i) {
+      AppendString(json, keys[i], event.strings[i]);
+    }
+    for (size_t i = (size_t) Field::BleConnID; i < kFirstIntField; ++i) {
+      if (!event.strings[i].empty()) {
+        AppendString(json, keys[i], event.strings[i]);
+      }
+    }
+    for (size_t i = kFirstIntField; i < kNumFields; ++i) {
+      if (event.intMask & (1 << (i - kFirstIntField))) {
+        AppendInt(json, keys[i], event.ints[i]);
+      }
+    }
+    json += '}';
+  }
+  json += ']';
+
+  if (decoder.IsCorrupt()) {
+    LOG_ERROR("DASEventSpool.ConvertToJson.Corrupt", "Dropping the rest of %s after %zu events",
+              path.c_str(), numEvents);
+  }
+  if (numEvents == 0) {
+    json.clear();
+  }
+  return true;
+}
+
+} // end namespace Vector
+} // end namespace Anki
@@ -0,0 +1,123 @@
+/**
+* File: victor/dasmgr/dasEventSpool.h
+*
+* Author: Victor Rebuild
+* Date:   10/14/2026
+*
+* Description: Compact binary spool of DAS events. Event names and the global fields that every event repeats
+*              (robot id, version, boot id, profile...) are interned once per file, the others are written as
+*              varints or short strings, so a spooled event takes a fraction of its JSON. The open spool is a
+*              preallocated file mapped into memory, so appending an event is a memcpy and the kernel decides when
+*              the dirty pages reach flash. Spool files are only turned into JSON when they're uploaded.
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+
+#ifndef __victor_dasmgr_dasEventSpool_h
+#define __victor_dasmgr_dasEventSpool_h
+
+#include "util/logging/logtypes.h" // Anki LogLevel
+
+#include <array>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class DASEventSpool {
+public:
+  using LogLevel = Anki::Util::LogLevel;
+
+  // Extension of spool files waiting for upload
+  static constexpr const char * kFileExtension = "das";
+
+  enum class Field : uint8_t {
+    // interned
+    Source,
+    RobotID,
+    RobotVersion,
+    BootID,
+    ProfileID,
+    FeatureType,
+    FeatureRunID,
+    BleConnID,
+    WifiConnID,
+    Event,
+    // written inline
+    S1,
+    S2,
+    S3,
+    S4,
+    // integers, written only if set
+    I1,
+    I2,
+    I3,
+    I4,
+    UptimeMS,
+    Count
+  };
+
+  // Strings aren't owned, they only need to live until Append returns. Empty strings are left out of the JSON, as are
+  // integer fields whose string is empty
+  struct Event {
+    int64_t ts = 0;
+    uint64_t seq = 0;
+    LogLevel level = LogLevel::LOG_LEVEL_EVENT;
+    std::array<const char *, (size_t) Field::Count> values;
+    std::array<size_t, (size_t) Field::Count> sizes;
+
+    Event() { values.fill(""); sizes.fill(0); }
+    void Set(Field field, const char * value, size_t size);
+    void Set(Field field, const std::string & value) { Set(field, value.c_str(), value.size()); }
+  };
+
+  DASEventSpool() = default;
+  ~DASEventSpool();
+
+  DASEventSpool(const DASEventSpool &) = delete;
+  DASEventSpool & operator=(const DASEventSpool &) = delete;
+
+  // Opens the spool at path, picking up after the events already in it (e.g. from before a restart). capacity is
+  // how big the file may grow
+  bool Open(const std::string & path, size_t capacity);
+  bool IsOpen() const { return _data != nullptr; }
+
+  // Returns false if the event doesn't fit in what's left of the capacity (or the spool isn't open)
+  bool Append(const Event & event);
+
+  // Bytes of events written so far
+  size_t GetSize() const { return _size; }
+  size_t GetNumEvents() const { return _numEvents; }
+
+  // Trims the file to what was written and unmaps it
+  void Close();
+
+  // Decodes a closed spool file into the JSON array of events the DAS server expects. Returns false if the file can't
+  // be read; a corrupt tail is dropped with an error
+  static bool ConvertToJson(const std::string & path, std::string & json);
+
+private:
+  class Decoder;
+
+  int _fd = -1;
+  uint8_t * _data = nullptr;
+  size_t _capacity = 0;
+  size_t _size = 0;
+  size_t _numEvents = 0;
+
+  // state that records are relative to
+  std::unordered_map<std::string, uint32_t> _internedIDs;
+  int64_t _lastTs = 0;
+  uint64_t _lastSeq = 0;
+
+  uint32_t Intern(const char * value, size_t size, std::vector<uint8_t> & record);
+};
+
+} // end namespace Vector
+} // end namespace Anki
+
+#endif // __victor_dasmgr_dasEventSpool_h
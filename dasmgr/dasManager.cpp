@@ -65,6 +65,13 @@ namespace {
 
   // Magic file used to expose state of DAS opt-in
   constexpr const char * kAllowUploadFile = "/run/das_allow_upload";
+
+  // Room left in the spool past the file threshold, so the event that crosses it still fits.
+  // Android log entries are capped well below this.
+  constexpr const size_t kSpoolHeadroom = 64 * 1024;
+
+  // Extension of JSON files waiting for upload
+  constexpr const char * kJsonExtension = "json";
 }
 
 //
@@ -111,67 +118,32 @@ inline LogLevel GetLogLevel(const AndroidLogEntry& logEntry)
   return LogLevel::LOG_LEVEL_ERROR;
 }
 
-static inline void serialize(std::ostream & ostr, const std::string & key, const std::string & val)
-{
-  // TO DO: Guard against embedded quotes in value
-  ostr << '"' << key << '"';
-  ostr << ':';
-  ostr << '"' << val << '"';
-}
-
-static inline void serialize(std::ostream & ostr, const std::string & key, int64_t val)
-{
-  ostr << '"' << key << '"';
-  ostr << ':';
-  ostr << val;
-}
-
-static inline void serialize(std::ostream & ostr, const std::string & key, LogLevel val)
-{
-  ostr << '"' << key << '"';
-  ostr << ':';
-  ostr << '"';
-  switch (val)
-  {
-    case LogLevel::LOG_LEVEL_ERROR:
-      ostr << "error";
-      break;
-    case LogLevel::LOG_LEVEL_WARN:
-      ostr << "warning";
-      break;
-    case LogLevel::LOG_LEVEL_EVENT:
-      ostr << "event";
-      break;
-    case LogLevel::LOG_LEVEL_INFO:
-      ostr << "info";
-      break;
-    case LogLevel::LOG_LEVEL_DEBUG:
-      ostr << "debug";
-      break;
-    case LogLevel::_LOG_LEVEL_COUNT:
-      ostr << "count";
-      break;
-  }
-  ostr << '"';
-}
-
 namespace Anki {
 namespace Vector {
 
 DASManager::DASManager(const DASConfig & dasConfig)
 {
   _dasConfig = dasConfig;
-  _logFilePath = Util::FileUtils::FullFilePath({_dasConfig.GetStoragePath(), "das.log"});
+  _spoolPath = Util::FileUtils::FullFilePath({_dasConfig.GetStoragePath(), "das.spool"});
 }
 
 //
-// Attempt to upload a JSON log file
+// Attempt to upload a log file, converting spools to JSON first
 // This is called on the worker thread.
 // Return true on successful upload.
 //
 bool DASManager::PostToServer(const std::string& pathToLogFile)
 {
-  const std::string & json = Util::FileUtils::ReadFile(pathToLogFile);
+  std::string json;
+  if (Util::StringEndsWith(pathToLogFile, std::string(".") + DASEventSpool::kFileExtension)) {
+    if (!DASEventSpool::ConvertToJson(pathToLogFile, json)) {
+      // Nothing in it can be sent, let it be cleaned up
+      ++_workerDroppedCount;
+      return true;
+    }
+  } else {
+    json = Util::FileUtils::ReadFile(pathToLogFile);
+  }
   if (json.empty()) {
     return true;
   }
@@ -208,7 +180,7 @@ void DASManager::PostLogsToServer()
   const auto & directories = {_dasConfig.GetStoragePath(), _dasConfig.GetBackupPath()};
 
   for (const auto & dir : directories) {
-    const auto & jsonFiles = GetJsonFiles(dir);
+    const auto & jsonFiles = GetUploadFiles(dir);
     for (const auto & jsonFile : jsonFiles) {
 
       // Shortcut exit?
@@ -236,7 +208,7 @@ void DASManager::BackupLogFiles()
   const auto & backupPath = _dasConfig.GetBackupPath();
   const auto backupQuota = _dasConfig.GetBackupQuota();
 
-  const auto & jsonFiles = GetJsonFiles(storagePath);
+  const auto & jsonFiles = GetUploadFiles(storagePath);
   for (const auto & jsonFile : jsonFiles) {
     // Create the directory that will hold the json
     if (!Util::FileUtils::CreateDirectory(backupPath, false, true, S_IRWXU)) {
@@ -256,7 +228,7 @@ void DASManager::PurgeBackupFiles()
 {
   LOG_DEBUG("DASManager.PurgeBackupFiles", "Purge backup files");
   const auto & backupPath = _dasConfig.GetBackupPath();
-  const auto & jsonFiles = GetJsonFiles(backupPath);
+  const auto & jsonFiles = GetUploadFiles(backupPath);
   for (const auto & jsonFile : jsonFiles) {
     LOG_DEBUG("DASManager.PurgeBackupFiles", "Purge %s", jsonFile.c_str());
     Util::FileUtils::DeleteFile(jsonFile);
@@ -267,7 +239,7 @@ void DASManager::EnforceStorageQuota()
 {
   //
   // Delete files to make room for incoming data.
-  // GetJsonFiles() returns a sorted list so we remove the oldest files first.
+  // GetUploadFiles() returns a sorted list so we remove the oldest files first.
   //
   const ssize_t quota = (ssize_t) _dasConfig.GetStorageQuota();
   const ssize_t fileThresholdSize = (ssize_t) _dasConfig.GetFileThresholdSize();
@@ -275,14 +247,20 @@ void DASManager::EnforceStorageQuota()
 
   LOG_DEBUG("DASManager.EnforceStorageQuota", "Enforce quota %zd on path %s", quota, path.c_str());
 
-  ssize_t directorySize = Util::FileUtils::GetDirectorySize(path);
+  // The open spool is preallocated to the threshold, which is already what's set aside for it
+  const auto getDirectorySize = [this, &path]() {
+    const ssize_t spoolSize = Util::FileUtils::GetFileSize(_spoolPath);
+    return Util::FileUtils::GetDirectorySize(path) - std::max<ssize_t>(spoolSize, 0);
+  };
+
+  ssize_t directorySize = getDirectorySize();
   if (directorySize + fileThresholdSize > quota) {
-    auto jsonFiles = GetJsonFiles(path);
+    auto jsonFiles = GetUploadFiles(path);
     while (directorySize + fileThresholdSize > quota && !jsonFiles.empty()) {
       LOG_DEBUG("DASManager.EnforceQuota", "Delete %s", jsonFiles.front().c_str());
       Util::FileUtils::DeleteFile(jsonFiles.front());
       jsonFiles.erase(jsonFiles.begin());
-      directorySize = Util::FileUtils::GetDirectorySize(path);
+      directorySize = getDirectorySize();
     }
   }
 }
@@ -309,41 +287,54 @@ void DASManager::SetAllowUpload(bool allow_upload)
   }
 }
 
-std::string DASManager::ConvertLogEntryToJson(const AndroidLogEntry & logEntry)
+bool DASManager::ConvertLogEntry(const AndroidLogEntry & logEntry, DASEventSpool::Event & event)
 {
+  using Field = DASEventSpool::Field;
+
   // These values are always set by library so we don't need to check them
   DEV_ASSERT(logEntry.tag != nullptr, "DASManager.ParseLogEntry.InvalidTag");
   DEV_ASSERT(logEntry.message != nullptr, "DASManager.ParseLogEntry.InvalidMessage");
 
+  // Fields are spooled straight from the message, in the order they appear (event name, s1-s4, i1-i4, uptime).
   // Anki::Util::StringSplit ignores trailing separator so don't use it
-  std::vector<std::string> values;
+  constexpr const size_t kMaxFields = (size_t) Field::Count - (size_t) Field::Event;
+  std::array<const char *, kMaxFields> values;
+  std::array<size_t, kMaxFields> sizes;
+  size_t numFields = 0;
   const char * pos = logEntry.message+1; // (skip leading event marker)
   while (1) {
     const char * end = strchr(pos, Anki::Util::DAS::FIELD_MARKER);
+    if (numFields < kMaxFields) {
+      values[numFields] = pos;
+      sizes[numFields] = (end != nullptr) ? (size_t)(end-pos) : strlen(pos);
+    }
+    ++numFields;
     if (end == nullptr) {
-      values.push_back(std::string(pos));
       break;
     }
-    values.push_back(std::string(pos, (size_t)(end-pos)));
     pos = end+1;
   }
 
-  if (values.size() < Anki::Util::DAS::FIELD_COUNT) {
+  if (numFields < Anki::Util::DAS::FIELD_COUNT) {
     LOG_ERROR("DASManager.ConvertLogEntry", "Unable to parse %s from %s (%zu != %d)",
-              logEntry.message, logEntry.tag, values.size(), Anki::Util::DAS::FIELD_COUNT);
-    return "";
+              logEntry.message, logEntry.tag, numFields, Anki::Util::DAS::FIELD_COUNT);
+    return false;
   }
 
-  const auto & name = values[DAS_NAME];
+  const auto getValue = [&values, &sizes](int index) {
+    return std::string(values[(size_t) index], sizes[(size_t) index]);
+  };
+
+  const std::string & name = getValue(DAS_NAME);
   if (name.empty()) {
-    LOG_ERROR("DASManager.ConvertLogEntryToJson", "Missing event name");
-    return "";
+    LOG_ERROR("DASManager.ConvertLogEntry", "Missing event name");
+    return false;
   }
 
   // Is this a recycled event?
   const auto ts = GetTimeStamp(logEntry);
   if (ts <= _first_event_ts) {
-    return "";
+    return false;
   }
 
   _last_event_ts = ts;
@@ -356,22 +347,22 @@ std::string DASManager::ConvertLogEntryToJson(const AndroidLogEntry & logEntry)
   // If magic event names change, this code should be reviewed for compatibility.
   //
   if (name == DASMSG_FEATURE_START) {
-    _feature_run_id = values[DAS_STR3];
-    _feature_type = values[DAS_STR4];
+    _feature_run_id = getValue(DAS_STR3);
+    _feature_type = getValue(DAS_STR4);
   } else if (name == DASMSG_BLE_CONN_ID_START) {
-    _ble_conn_id = values[DAS_STR1];
+    _ble_conn_id = getValue(DAS_STR1);
   } else if (name == DASMSG_BLE_CONN_ID_STOP) {
     _ble_conn_id.clear();
   } else if (name == DASMSG_WIFI_CONN_ID_START) {
-    _wifi_conn_id = values[DAS_STR1];
+    _wifi_conn_id = getValue(DAS_STR1);
   } else if (name == DASMSG_WIFI_CONN_ID_STOP) {
     _wifi_conn_id.clear();
   } else if (name == DASMSG_PROFILE_ID_START) {
-    _profile_id = values[DAS_STR1];
+    _profile_id = getValue(DAS_STR1);
   } else if (name == DASMSG_PROFILE_ID_STOP) {
     _profile_id.clear();
   } else if (name == DASMSG_DAS_ALLOW_UPLOAD) {
-    const auto i1 = std::atoi(values[DAS_INT1].c_str());
+    const auto i1 = std::atoi(getValue(DAS_INT1).c_str());
     const bool allow_upload = (i1 != 0);
     if (_allow_upload && !allow_upload) {
       // User has opted out of data collection
@@ -380,59 +371,27 @@ std::string DASManager::ConvertLogEntryToJson(const AndroidLogEntry & logEntry)
     SetAllowUpload(allow_upload);
   }
 
-  std::ostringstream ostr;
-  ostr << '{';
-  serialize(ostr, "source", logEntry.tag);
-  ostr << ',';
-  serialize(ostr, "ts", ts);
-  ostr << ',';
-  serialize(ostr, "seq", (int64_t) _seq++);
-  ostr << ',';
-  serialize(ostr, "level", GetLogLevel(logEntry));
-  ostr << ',';
-  serialize(ostr, "robot_id", _robot_id);
-  ostr << ',';
-  serialize(ostr, "robot_version", _robot_version);
-  ostr << ',';
-  serialize(ostr, "boot_id", _boot_id);
-  ostr << ',';
-  serialize(ostr, "profile_id", _profile_id);
-  ostr << ',';
-  serialize(ostr, "feature_type", _feature_type);
-  ostr << ',';
-  serialize(ostr, "feature_run_id", _feature_run_id);
-
-  if (!_ble_conn_id.empty()) {
-    ostr << ',';
-    serialize(ostr, "ble_conn_id", _ble_conn_id);
-  }
-
-  if (!_wifi_conn_id.empty()) {
-    ostr << ',';
-    serialize(ostr, "wifi_conn_id", _wifi_conn_id);
-  }
-
-  static const std::vector<std::string> keys =
-    {"event", "s1", "s2", "s3", "s4", "i1", "i2", "i3", "i4", "uptime_ms"};
-
-  const size_t n = std::min(keys.size(), values.size());
-  for (unsigned int i = 0 ; i < n; ++i) {
-    const std::string & value = values[i];
-    if (value.empty()) {
-      continue;
-    }
-    const std::string & key = keys[i];
-    ostr << ',';
-    if (key[0] == 'i' || key[0] == 'u') {
-      serialize(ostr, key, std::atoll(value.c_str()));
-    } else {
-      serialize(ostr, key, value);
-    }
+  event.ts = ts;
+  event.seq = _seq++;
+  event.level = GetLogLevel(logEntry);
+  event.Set(Field::Source, logEntry.tag, strlen(logEntry.tag));
+  event.Set(Field::RobotID, _robot_id);
+  event.Set(Field::RobotVersion, _robot_version);
+  event.Set(Field::BootID, _boot_id);
+  event.Set(Field::ProfileID, _profile_id);
+  event.Set(Field::FeatureType, _feature_type);
+  event.Set(Field::FeatureRunID, _feature_run_id);
+  event.Set(Field::BleConnID, _ble_conn_id);
+  event.Set(Field::WifiConnID, _wifi_conn_id);
+
+  const size_t n = std::min(kMaxFields, numFields);
+  for (size_t i = 0; i < n; ++i) {
+    event.Set((Field) ((size_t) Field::Event + i), values[i], sizes[i]);
   }
 
-  ostr << '}';
-  return ostr.str();
+  return true;
 }
+
 //
 // Process a log entry
 //
@@ -453,39 +412,55 @@ void DASManager::ProcessLogEntry(const AndroidLogEntry & logEntry)
 
   _eventCount++;
 
-  const std::string & json = ConvertLogEntryToJson(logEntry);
-  if (json.empty()) {
+  DASEventSpool::Event event;
+  if (!ConvertLogEntry(logEntry, event)) {
     return;
   }
 
-  // Append the JSON object to the array stored in the logfile
-  if (!_logFile.is_open()) {
-    _logFile.open(_logFilePath, std::ios::out | std::ofstream::binary | std::ofstream::ate);
+  if (!_spool.IsOpen() && !OpenSpool()) {
+    return;
   }
 
-  off_t logFilePos = (off_t) _logFile.tellp();
-  if (logFilePos == 0) {
-    // This is a new file. Start with '[' to open the array
-    _logFile << '[';
-  } else {
-    // Rewind 1 spot and replace the ']' with a ',' to continue the array
-    _logFile.seekp(-1, std::ofstream::cur);
-    _logFile << ',';
+  // A full spool is rolled for upload and the event goes into a new one
+  if (!_spool.Append(event)) {
+    if (_spool.GetNumEvents() > 0) {
+      RollLogFile();
+    }
+    if (!_spool.Append(event)) {
+      LOG_ERROR("DASManager.ProcessLogEntry", "Unable to spool %s", logEntry.message);
+      ++_workerDroppedCount;
+    }
   }
+}
 
-  // Append the JSON object and close the array
-  _logFile << json << ']';
-
+bool DASManager::OpenSpool()
+{
+  const size_t capacity = _dasConfig.GetFileThresholdSize() + kSpoolHeadroom;
+  if (!_spool.Open(_spoolPath, capacity)) {
+    LOG_ERROR("DASManager.OpenSpool", "Unable to open %s", _spoolPath.c_str());
+    return false;
+  }
+  return true;
 }
 
 void DASManager::RollLogFile()
 {
   // Close current file
-  _logFile.close();
+  const bool hasEvents = (_spool.GetNumEvents() > 0);
+  _spool.Close();
 
   // Rename current file
-  const std::string& fileName = GetPathNameForNextJsonLogFile();
-  Util::FileUtils::MoveFile(fileName, _logFilePath);
+  if (hasEvents) {
+    const std::string& fileName = GetPathNameForNextLogFile(DASEventSpool::kFileExtension);
+    Util::FileUtils::MoveFile(fileName, _spoolPath);
+  } else {
+    Util::FileUtils::DeleteFile(_spoolPath);
+  }
+
+  // Start the next one, unless we're done
+  if (!_exiting) {
+    (void) OpenSpool();
+  }
 
   // Reset flush time
   _last_flush_time = std::chrono::steady_clock::now();
@@ -548,13 +523,16 @@ uint32_t DASManager::GetSecondsSinceLastFlush()
   return (uint32_t) std::chrono::duration_cast<std::chrono::seconds>(diff).count();
 }
 
-std::vector<std::string> DASManager::GetJsonFiles(const std::string& path)
+std::vector<std::string> DASManager::GetUploadFiles(const std::string& path)
 {
-  auto jsonFiles = Util::FileUtils::FilesInDirectory(path, true, ".json", false);
+  const std::string spoolExtension = std::string(".") + DASEventSpool::kFileExtension;
+  const std::string jsonExtension = std::string(".") + kJsonExtension;
+  auto files = Util::FileUtils::FilesInDirectory(path, true, {jsonExtension.c_str(), spoolExtension.c_str()}, false);
 
-  std::sort(jsonFiles.begin(), jsonFiles.end());
+  // Files are named by index, so this is the order they were written
+  std::sort(files.begin(), files.end());
 
-  return jsonFiles;
+  return files;
 }
 
 uint32_t DASManager::GetNextIndexForJsonFile()
@@ -563,7 +541,7 @@ uint32_t DASManager::GetNextIndexForJsonFile()
   const auto & storagePaths = {_dasConfig.GetStoragePath(), _dasConfig.GetBackupPath()};
 
   for (const auto & path : storagePaths) {
-    const auto & jsonFiles = GetJsonFiles(path);
+    const auto & jsonFiles = GetUploadFiles(path);
 
     if (!jsonFiles.empty()) {
       const std::string& lastFile = jsonFiles.back();
@@ -578,12 +556,12 @@ uint32_t DASManager::GetNextIndexForJsonFile()
   return index;
 }
 
-std::string DASManager::GetPathNameForNextJsonLogFile()
+std::string DASManager::GetPathNameForNextLogFile(const char * extension)
 {
   uint32_t index = GetNextIndexForJsonFile();
 
   char filename[19] = {'\0'};
-  std::snprintf(filename, sizeof(filename) - 1, "%012u.json", index);
+  std::snprintf(filename, sizeof(filename) - 1, "%012u.%s", index, extension);
   return Util::FileUtils::FullFilePath({_dasConfig.GetStoragePath(), filename});
 }
 
@@ -793,6 +771,12 @@ Result DASManager::Run(const bool & shutdown)
     return RESULT_FAIL_INVALID_PARAMETER;
   }
 
+  // JSON spooled before events were spooled in binary is ready to send as is
+  const auto & legacyLogFile = Util::FileUtils::FullFilePath({storagePath, "das.log"});
+  if (Util::FileUtils::FileExists(legacyLogFile)) {
+    Util::FileUtils::MoveFile(GetPathNameForNextLogFile(kJsonExtension), legacyLogFile);
+  }
+
   LoadGlobalState();
 
   // Initialize magic state file
@@ -886,7 +870,7 @@ Result DASManager::Run(const bool & shutdown)
     // If we are NOT allowed to upload, let the file keep growing to avoid fragmentation.
     //
     bool rollNow = false;
-    if (_logFile.tellp() > fileThresholdSize) {
+    if (_spool.GetSize() > fileThresholdSize) {
       rollNow = true;
     } else if (_allow_upload && GetSecondsSinceLastFlush() > flushInterval) {
       rollNow = true;
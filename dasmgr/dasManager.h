@@ -11,13 +11,13 @@
 #define __victor_dasmgr_dasManager_h
 
 #include "dasConfig.h"
+#include "dasEventSpool.h"
 #include "coretech/common/shared/types.h" // Anki Result
 #include "util/dispatchQueue/taskExecutor.h" // Anki TaskExecutor
 #include "util/logging/logtypes.h" // Anki LogLevel
 
 #include <chrono>
 #include <deque>
-#include <fstream>
 #include <memory>
 #include <string>
 
@@ -65,8 +65,8 @@ private:
   bool _exiting = false;
   bool _uploading = false;
   bool _gotTerminateEvent = false;
-  std::string _logFilePath;
-  std::ofstream _logFile;
+  std::string _spoolPath;
+  DASEventSpool _spool;
 
   // Worker thread and thread-safe counters
   TaskExecutor _worker;
@@ -85,14 +85,18 @@ private:
   void PurgeBackupFiles();
   void EnforceStorageQuota();
 
-  std::string ConvertLogEntryToJson(const AndroidLogEntry & logEntry);
+  // Fill in event from a log entry, returns false if the entry isn't spooled
+  bool ConvertLogEntry(const AndroidLogEntry & logEntry, DASEventSpool::Event & event);
 
   // Process a log message
   void ProcessLogEntry(const AndroidLogEntry & logEntry);
 
-  // Rename das.log to 00000000000X.json for the uploader task to pick up
+  // Rename das.spool to 00000000000X.das for the uploader task to pick up
   void RollLogFile();
 
+  // Open das.spool, sized so an event always fits once the file threshold is reached
+  bool OpenSpool();
+
   // Log some process stats.
   // This is called on the main thread at regular intervals.
   void ProcessStats();
@@ -100,12 +104,12 @@ private:
   // Get Time Elapsed in seconds since last flush
   uint32_t GetSecondsSinceLastFlush();
 
-  // Get the sorted list of files containing JSON to be uploaded
-  std::vector<std::string> GetJsonFiles(const std::string& path);
+  // Get the sorted list of files containing events to be uploaded (JSON, or spools still to be converted)
+  std::vector<std::string> GetUploadFiles(const std::string& path);
 
   // We don't want to overwrite existing files, get the next index to use
   uint32_t GetNextIndexForJsonFile();
-  std::string GetPathNameForNextJsonLogFile();
+  std::string GetPathNameForNextLogFile(const char * extension);
 
   // Update state flag and magic state file
   void SetAllowUpload(bool allow_upload);
@@ -23,7 +23,14 @@
 
 namespace Anki {
   namespace Vector {
-        
+    
+    namespace {
+      // How far the object can move before its cached preAction poses are regenerated. Small enough not to matter to
+      // driving to or docking with the object, large enough to ignore re-observation noise.
+      const f32     kPreActionPoseCacheDistTol_mm = 1.f;
+      const Radians kPreActionPoseCacheAngleTol_rad = DEG_TO_RAD(0.5f);
+    }
+    
     ActionableObject::ActionableObject(const ObjectType& type)
     : Vector::ObservableObject(type)
     {
@@ -140,6 +147,53 @@ namespace Anki {
     } // IsPreActionPoseValid()
 
     
+    bool ActionableObject::EnsurePreActionPosesCached(const PreActionPose::ActionType type) const
+    {
+      std::vector<PreActionPose>& cachedPoses = _cachedPreActionPoses[type];
+      if(!cachedPoses.empty())
+      {
+        return false;
+      }
+      
+      GeneratePreActionPoses(type, cachedPoses);
+      
+      // Place each of them at the object's pose now, rather than on every request. Other types already cached
+      // were placed at the pose the cache started at, so use that one too.
+      if(!_hasCachedPreActionPoses)
+      {
+        _cachedPreActionPosesObjectPose = GetPose();
+        _hasCachedPreActionPoses = true;
+      }
+      const Pose3d& relToObjectPose = _cachedPreActionPosesObjectPose;
+      
+      std::vector<PosedPreActionPose>& posedPoses = _cachedPosedPreActionPoses[type];
+      posedPoses.clear();
+      posedPoses.reserve(cachedPoses.size());
+      for(const auto& preActionPose : cachedPoses)
+      {
+        PreActionPose posed(preActionPose, relToObjectPose, preActionPose.GetLineLength(), 0);
+        Pose3d poseWrtRoot = posed.GetPose().GetWithRespectToRoot();
+        posedPoses.push_back(PosedPreActionPose{std::move(posed), std::move(poseWrtRoot)});
+      }
+      
+      return true;
+    }
+    
+    
+    void ActionableObject::ClearCachedPreActionPoses()
+    {
+      for(auto& cachedPoses : _cachedPreActionPoses)
+      {
+        cachedPoses.clear();
+      }
+      for(auto& posedPoses : _cachedPosedPreActionPoses)
+      {
+        posedPoses.clear();
+      }
+      _hasCachedPreActionPoses = false;
+    }
+    
+    
     bool ActionableObject::GetCurrentPreActionPoses(std::vector<PreActionPose>& preActionPoses,
                                                     const Pose3d& robotPose,
                                                     const std::set<PreActionPose::ActionType>& withAction,
@@ -149,45 +203,51 @@ namespace Anki {
                                                     bool visualize) const
     {
       bool res = false;
-      const Pose3d& relToObjectPose = GetPose();
-      
-      u8 count = 0;
       
-      std::vector<PreActionPose> genPreActionPoses;
       for(const PreActionPose::ActionType type : withAction)
       {
-        std::vector<PreActionPose>& cachedPoses = _cachedPreActionPoses[type];
-        
         // If we don't have any cached preAction poses, generate them
-        if(cachedPoses.empty())
+        if(EnsurePreActionPosesCached(type))
         {
-          GeneratePreActionPoses(type, cachedPoses);
           res = true;
         }
-        
-        genPreActionPoses.insert(genPreActionPoses.end(), cachedPoses.begin(), cachedPoses.end());
       }
       
-      for(const auto & preActionPose : genPreActionPoses)
+      // The cached poses were placed at the object's pose when they were generated. The object may since have moved
+      // by less than the cache tolerance, so keep using that pose for consistency with them.
+      const Pose3d& relToObjectPose = (_hasCachedPreActionPoses ? _cachedPreActionPosesObjectPose : GetPose());
+      
+      // Only needed for choosing a point along the preActionLine below
+      const Pose3d robot = (offset_mm == 0) ? robotPose.GetWithRespectToRoot() : Pose3d();
+      
+      u8 count = 0;
+      
+      for(const PreActionPose::ActionType type : withAction)
       {
-        if((withCode.empty()   || withCode.count(preActionPose.GetMarker()->GetCode()) > 0) &&
-           (withAction.empty() || withAction.count(preActionPose.GetActionType()) > 0))
+        const std::vector<PreActionPose>& cachedPoses = _cachedPreActionPoses[type];
+        const std::vector<PosedPreActionPose>& posedPoses = _cachedPosedPreActionPoses[type];
+        
+        for(size_t i = 0; i < cachedPoses.size(); ++i)
         {
-          // offset_mm is scaled by some amount because otherwise it might too far to see the marker
-          // it's docking to.
-          PreActionPose currentPose(preActionPose, relToObjectPose, preActionPose.GetLineLength(), PREACTION_POSE_OFFSET_SCALAR * offset_mm);
+          const PreActionPose& preActionPose = cachedPoses[i];
+          if(!withCode.empty() && withCode.count(preActionPose.GetMarker()->GetCode()) == 0)
+          {
+            continue;
+          }
           
           // If our preActionPoses aren't using an offset then use the point on the preActionLine closest to the robot
+          const PosedPreActionPose& posedPose = posedPoses[i];
+          f32 offset = 0.f;
           if(offset_mm == 0)
           {
             // Find the end point of the preActionLine
-            const f32 angle = currentPose.GetPose().GetRotation().GetAngleAroundZaxis().ToFloat();
-            const Point3f endPoint = {currentPose.GetPose().GetTranslation().x() + cosf(angle) * preActionPose.GetLineLength(),
-                                      currentPose.GetPose().GetTranslation().y() + sinf(angle) * preActionPose.GetLineLength(),
-                                      currentPose.GetPose().GetTranslation().z()};
+            const Pose3d& startPose = posedPose.pose.GetPose();
+            const f32 angle = startPose.GetRotation().GetAngleAroundZaxis().ToFloat();
+            const Point3f endPoint = {startPose.GetTranslation().x() + cosf(angle) * preActionPose.GetLineLength(),
+                                      startPose.GetTranslation().y() + sinf(angle) * preActionPose.GetLineLength(),
+                                      startPose.GetTranslation().z()};
             
-            Pose3d p = currentPose.GetPose().GetWithRespectToRoot();
-            Pose3d robot = robotPose.GetWithRespectToRoot();
+            const Pose3d& p = posedPose.poseWrtRoot;
             
             // x and y difference between the intersection point and the start of the preActionLine
             f32 x = 0;
@@ -226,11 +286,20 @@ namespace Anki {
             // Clip the offset so it will stay on the preActionLine
             // Offset will always be positive which is what causes the slightly odd (but desirable) behavior of the
             // preDock pose moving away from the robot when we are infront of the end of the preActionLine closest to the object
-            const f32 offset = CLIP(sqrtf(x*x + y*y), 0.f, preActionPose.GetLineLength());
-          
-            PreActionPose newPose(preActionPose, relToObjectPose, preActionPose.GetLineLength(), offset);
-            currentPose = newPose;
+            offset = CLIP(sqrtf(x*x + y*y), 0.f, preActionPose.GetLineLength());
           }
+          else
+          {
+            // offset_mm is scaled by some amount because otherwise it might too far to see the marker
+            // it's docking to.
+            offset = PREACTION_POSE_OFFSET_SCALAR * offset_mm;
+          }
+          
+          // The start of the preActionLine is already placed, so only poses along the line need building
+          const bool isStartOfLine = (offset == 0.f);
+          const PreActionPose currentPose = (isStartOfLine ?
+                                             posedPose.pose :
+                                             PreActionPose(preActionPose, relToObjectPose, preActionPose.GetLineLength(), offset));
           
           if(IsPreActionPoseValid(currentPose, obstacles)) {
             preActionPoses.emplace_back(currentPose);
@@ -238,8 +307,8 @@ namespace Anki {
             // Draw the preActionLines in viz
             if(visualize)
             {
-              PreActionPose basePose(preActionPose, relToObjectPose, preActionPose.GetLineLength(), 0);
-              Pose3d end = basePose.GetPose();
+              const Pose3d& start = posedPose.pose.GetPose();
+              Pose3d end = start;
               const f32 endAngle = end.GetRotation().GetAngleAroundZaxis().ToFloat();
               end.SetTranslation({end.GetTranslation().x() - cosf(endAngle)*preActionPose.GetLineLength(),
                                   end.GetTranslation().y() - sinf(endAngle)*preActionPose.GetLineLength(),
@@ -250,15 +319,15 @@ namespace Anki {
               _vizPreActionLineIDs.insert(id);
               _vizManager->ErasePath(id);
               _vizManager->AppendPathSegmentLine(id,
-                                                 basePose.GetPose().GetTranslation().x(),
-                                                 basePose.GetPose().GetTranslation().y(),
+                                                 start.GetTranslation().x(),
+                                                 start.GetTranslation().y(),
                                                  end.GetTranslation().x(),
                                                  end.GetTranslation().y());
               _vizManager->SetPathColor(id, NamedColors::CYAN);
             }
           }
-        } // if preActionPose has correct code/action
-      } // for each preActionPose
+        } // for each preActionPose
+      } // for each ActionType
       return res;
     }
     
@@ -308,10 +377,15 @@ namespace Anki {
     
     void ActionableObject::SetPose(const Pose3d& newPose, f32 fromDistance, PoseState newPoseState)
     {
-      // Clear all of the cached preActionPoses
-      for(auto& cachedPoses : _cachedPreActionPoses)
+      // Clear all of the cached preActionPoses, unless the object has barely moved (e.g. it was just re-observed)
+      // since they were generated. Poses in another frame are never the same.
+      if(_hasCachedPreActionPoses &&
+         ((newPose.GetRootID() != _cachedPreActionPosesObjectPose.GetRootID()) ||
+          !newPose.IsSameAs(_cachedPreActionPosesObjectPose,
+                           kPreActionPoseCacheDistTol_mm,
+                           kPreActionPoseCacheAngleTol_rad)))
       {
-        cachedPoses.clear();
+        ClearCachedPreActionPoses();
       }
       
       ObservableObject::SetPose(newPose, fromDistance, newPoseState);
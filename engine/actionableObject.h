@@ -35,6 +35,7 @@ namespace Anki {
       // Return only those pre-action poses that are "valid" (See protected
       // IsPreActionPoseValid() method below.)
       // Optionally, you may filter based on ActionType and Marker Code as well.
+      // Poses are cached per ActionType until the object moves by more than a small tolerance (see SetPose()).
       // Returns true if we had to generate preActionPoses, false if cached poses were used
       // return value is currently only used for unit tests
       bool GetCurrentPreActionPoses(std::vector<PreActionPose>& preActionPoses,
@@ -66,15 +67,35 @@ namespace Anki {
                                           std::vector<PreActionPose>& preActionPoses) const = 0;
       
       // Set the object's pose. newPose should be with respect to world origin.
+      // Clears the cached preAction poses unless newPose is within a small tolerance of the pose they were
+      // generated at.
       virtual void SetPose(const Pose3d& newPose, f32 fromDistance, PoseState newPoseState) override;
       
-    private:      
+    private:
+      
+      // A canonical preAction pose placed at the object's pose (with no offset), along with that pose w.r.t. root
+      struct PosedPreActionPose {
+        PreActionPose pose;
+        Pose3d        poseWrtRoot;
+      };
+      
+      // Generates the canonical and posed preAction poses of the given type, if not already cached.
+      // Returns true if they had to be generated.
+      bool EnsurePreActionPosesCached(const PreActionPose::ActionType type) const;
+      
+      void ClearCachedPreActionPoses();
+      
       mutable std::set<VizManager::Handle_t> _vizPreActionPoseHandles;
       
       // Set of pathIDs for visualizing the preActionLines
       mutable std::set<u32> _vizPreActionLineIDs;
       
       mutable std::array<std::vector<PreActionPose>, PreActionPose::ActionType::NONE> _cachedPreActionPoses;
+      mutable std::array<std::vector<PosedPreActionPose>, PreActionPose::ActionType::NONE> _cachedPosedPreActionPoses;
+      
+      // Object pose the posed preAction poses were computed at
+      mutable Pose3d _cachedPreActionPosesObjectPose;
+      mutable bool   _hasCachedPreActionPoses = false;
       
     }; // class ActionableObject
     
@@ -0,0 +1,156 @@
+/**
+ * File: actionAllocators.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Pooled memory for the actions behaviors create and destroy most often, and for the nodes of the
+ *              containers that hold actions (ActionQueue, ICompoundAction). Memory for objects of one size comes
+ *              from a free list that is only ever grown, so after warming up the steady churn of queuing, running
+ *              and deleting actions doesn't go to the heap.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef ANKI_COZMO_ACTION_ALLOCATORS_H
+#define ANKI_COZMO_ACTION_ALLOCATORS_H
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace Anki {
+  namespace Vector {
+    namespace ActionAllocators {
+
+      // Free list of blocks of kSize bytes, suitably aligned for any type, handed out kBlocksPerChunk at a time.
+      // There is one per size, so every type of that size shares it. Locked, since actions may be deleted from
+      // callbacks run on other threads
+      template <size_t kSize>
+      class FixedSizeFreeList
+      {
+      public:
+        static void* Allocate()
+        {
+          auto& freeList = GetInstance();
+          std::lock_guard<std::mutex> lock(freeList._mutex);
+          if(freeList._head == nullptr) {
+            freeList.AddChunk();
+          }
+          Block* block = freeList._head;
+          freeList._head = block->next;
+          return block;
+        }
+
+        static void Deallocate(void* ptr)
+        {
+          auto& freeList = GetInstance();
+          std::lock_guard<std::mutex> lock(freeList._mutex);
+          Block* block = static_cast<Block*>(ptr);
+          block->next = freeList._head;
+          freeList._head = block;
+        }
+
+      private:
+        static constexpr size_t kBlocksPerChunk = 16;
+
+        union Block
+        {
+          Block* next;
+          typename std::aligned_storage<kSize, alignof(std::max_align_t)>::type storage;
+        };
+
+        // Never destroyed, so that actions still alive during static destruction can be freed
+        static FixedSizeFreeList& GetInstance()
+        {
+          static FixedSizeFreeList* sInstance = new FixedSizeFreeList();
+          return *sInstance;
+        }
+
+        void AddChunk()
+        {
+          _chunks.emplace_back(new Block[kBlocksPerChunk]);
+          Block* blocks = _chunks.back().get();
+          for(size_t i = kBlocksPerChunk; i-- > 0; ) {
+            blocks[i].next = _head;
+            _head = &blocks[i];
+          }
+        }
+
+        std::mutex _mutex;
+        Block* _head = nullptr;
+        std::vector<std::unique_ptr<Block[]>> _chunks;
+      };
+
+      // Class specific operator new/delete for T. Derived classes which don't declare their own are larger than T
+      // (or the same size, in which case they can share its blocks), so anything not of T's size goes to the heap
+      template <class T>
+      struct PooledNewDelete
+      {
+        static void* Allocate(size_t size)
+        {
+          return (size == sizeof(T)) ? FixedSizeFreeList<sizeof(T)>::Allocate() : ::operator new(size);
+        }
+
+        static void Deallocate(void* ptr, size_t size)
+        {
+          if(ptr == nullptr) {
+            return;
+          }
+          if(size == sizeof(T)) {
+            FixedSizeFreeList<sizeof(T)>::Deallocate(ptr);
+          } else {
+            ::operator delete(ptr);
+          }
+        }
+      };
+
+      // Allocator for the nodes of std::list and std::map, and for std::shared_ptr control blocks
+      template <class T>
+      class NodeAllocator
+      {
+      public:
+        using value_type = T;
+
+        NodeAllocator() = default;
+        template <class U>
+        NodeAllocator(const NodeAllocator<U>&) {}
+
+        T* allocate(size_t n)
+        {
+          void* ptr = (n == 1) ? FixedSizeFreeList<sizeof(T)>::Allocate() : ::operator new(n * sizeof(T));
+          return static_cast<T*>(ptr);
+        }
+
+        void deallocate(T* ptr, size_t n)
+        {
+          if(n == 1) {
+            FixedSizeFreeList<sizeof(T)>::Deallocate(ptr);
+          } else {
+            ::operator delete(ptr);
+          }
+        }
+
+        template <class U>
+        bool operator==(const NodeAllocator<U>&) const { return true; }
+        template <class U>
+        bool operator!=(const NodeAllocator<U>&) const { return false; }
+      };
+
+    } // namespace ActionAllocators
+  } // namespace Vector
+} // namespace Anki
+
+// Put in the public section of an action class to allocate it from a pool rather than the heap
+#define ANKI_POOLED_ACTION_ALLOCATION(__ActionType__)                                                       \
+  static void* operator new(size_t size) {                                                                  \
+    return ::Anki::Vector::ActionAllocators::PooledNewDelete<__ActionType__>::Allocate(size);               \
+  }                                                                                                         \
+  static void operator delete(void* ptr, size_t size) {                                                     \
+    ::Anki::Vector::ActionAllocators::PooledNewDelete<__ActionType__>::Deallocate(ptr, size);               \
+  }
+
+#endif // ANKI_COZMO_ACTION_ALLOCATORS_H
@@ -614,7 +614,7 @@ namespace Anki {
         return QueueAtEnd(action, numRetries);
       }
       
-      std::list<IActionRunner*>::iterator queueIter = _queue.begin();
+      Queue::iterator queueIter = _queue.begin();
       ++queueIter;
       _queue.insert(queueIter, action);
       
@@ -648,6 +648,16 @@ namespace Anki {
         {
           vizManager->SetText(TextLabelType::ACTION, NamedColors::GREEN, "Action: %s", _currentAction->GetName().c_str());
           cozmoContext->SetSdkStatus(SdkStatusType::Action, std::string(_currentAction->GetName()));
+
+          // Give the next action a chance to get ready while this one finishes
+          if(!_queue.empty())
+          {
+            IActionRunner* nextAction = _queue.front();
+            if(!nextAction->HasRobot()){
+              nextAction->SetRobot(&_robot);
+            }
+            nextAction->Prepare();
+          }
         }
         else
         {
@@ -692,7 +702,7 @@ namespace Anki {
       }
     }
     
-    bool ActionQueue::DeleteActionAndIter(IActionRunner* &action, std::list<IActionRunner*>::iterator& iter)
+    bool ActionQueue::DeleteActionAndIter(IActionRunner* &action, Queue::iterator& iter)
     {
       if(action != nullptr)
       {
@@ -746,7 +756,7 @@ namespace Anki {
       return DeleteActionAndIter(action, iter);
     }
     
-    bool ActionQueue::DeleteActionIter(std::list<IActionRunner*>::iterator& iter)
+    bool ActionQueue::DeleteActionIter(Queue::iterator& iter)
     {
       return DeleteActionAndIter(*iter, iter);
     }
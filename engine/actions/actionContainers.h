@@ -15,6 +15,7 @@
 #define ANKI_COZMO_ACTION_CONTAINERS_H
 
 #include "coretech/common/shared/types.h"
+#include "engine/actions/actionAllocators.h"
 #include "engine/actions/actionDefinitions.h"
 #include "util/entityComponent/iDependencyManagedComponent.h"
 #include "engine/robotComponents_fwd.h"
@@ -88,22 +89,25 @@ namespace Anki {
 
       void Print() const;
 
-      typedef std::list<IActionRunner*>::const_iterator const_iterator;
+      // Queued actions. List nodes come from a pool, since actions are queued and removed constantly
+      using Queue = std::list<IActionRunner*, ActionAllocators::NodeAllocator<IActionRunner*>>;
+
+      typedef Queue::const_iterator const_iterator;
       const_iterator begin() const { return _queue.begin(); }
       const_iterator end()   const { return _queue.end();   }
 
     private:
       // Deletes the action only if it isn't in the process of being deleted
       // If iter is not the end of the queue, the iter will be removed from the queue (iter should always point to the action)
-      bool DeleteActionIter(std::list<IActionRunner*>::iterator& iter);
+      bool DeleteActionIter(Queue::iterator& iter);
 
-      bool DeleteActionAndIter(IActionRunner* &action, std::list<IActionRunner*>::iterator& iter);
+      bool DeleteActionAndIter(IActionRunner* &action, Queue::iterator& iter);
 
       // Reference to robot so that actions queues receive a robot to inject into actions
       Robot& _robot;
 
       IActionRunner*            _currentAction = nullptr;
-      std::list<IActionRunner*> _queue;
+      Queue                     _queue;
 
       // A set of tags that are in the process of being deleted. This is used to protect
       // actions from being deleted multiple times/recursively
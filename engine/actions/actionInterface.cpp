@@ -356,6 +356,14 @@ namespace Anki {
       _state = ActionResult::SUCCESS;
     }
 
+    void IActionRunner::Prepare()
+    {
+      if(HasRobot() && !HasStarted())
+      {
+        PrepareInternal();
+      }
+    }
+
     ActionResult IActionRunner::Update()
     {
       auto & actionList = GetRobot().GetActionList();
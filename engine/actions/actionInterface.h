@@ -117,6 +117,13 @@ namespace Anki {
       // subclasses implementing InterruptInternal() and Reset().
       bool Interrupt();
 
+      // Called every tick while this action is expected to run next (e.g. it is at the front of an ActionQueue,
+      // or is the next action of a sequential compound action) and the action before it is still running, so
+      // slow work such as path planning can be started early. Does nothing once the action has started. The
+      // action may never run, or the world may change before it does, so Init() must check anything started
+      // here and drop it if it no longer applies.
+      void Prepare();
+
       // Override this to take care of anything that needs to be done on Retry/Interrupt.
       virtual void Reset(bool shouldUnlockTracks) = 0;
 
@@ -175,6 +182,9 @@ namespace Anki {
       // By default, actions are not interruptable
       virtual bool InterruptInternal() { return false; }
 
+      // By default, actions have nothing to prepare. See Prepare()
+      virtual void PrepareInternal() { }
+
       // Override to handle setting of a motion profile. Returns true if the profile was used correctly (or if
       // it was irrelevant, e.g. for an animation action). Returns false if the action is unable to use the
       // profile, e.g. because it is already using manually set speeds. Note that this action only needs to
@@ -33,6 +33,8 @@ namespace Anki {
     class PlayAnimationAction : public IAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(PlayAnimationAction)
+
     
       // Numloops 0 causes the action to loop forever
       // tracksToLock indicates tracks of the animation which should not play
@@ -98,6 +100,8 @@ namespace Anki {
     class TriggerAnimationAction : public PlayAnimationAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(TriggerAnimationAction)
+
       // Preferred constructor, used by the factory CreatePlayAnimationAction
       // Numloops 0 causes the action to loop forever
       explicit TriggerAnimationAction(AnimationTrigger animEvent,
@@ -132,6 +136,8 @@ namespace Anki {
     class TriggerLiftSafeAnimationAction : public TriggerAnimationAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(TriggerLiftSafeAnimationAction)
+
       // Preferred constructor, used by the factory CreatePlayAnimationAction
       // Numloops 0 causes the action to loop forever
       explicit TriggerLiftSafeAnimationAction(AnimationTrigger animEvent,
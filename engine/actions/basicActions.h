@@ -59,6 +59,8 @@ namespace Vector {
     class TurnInPlaceAction : public IAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(TurnInPlaceAction)
+
       explicit TurnInPlaceAction(const float angle_rad, // float instead of Radians to allow angles > 180 deg.
                                  const bool isAbsolute);
       virtual ~TurnInPlaceAction();
@@ -183,6 +185,8 @@ namespace Vector {
     class DriveStraightAction : public IAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(DriveStraightAction)
+
       // Positive distance for forward, negative for backward.
       // Speed should be positive if specified
       DriveStraightAction(f32 dist_mm);
@@ -328,6 +332,8 @@ namespace Vector {
     class MoveHeadToAngleAction : public IAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(MoveHeadToAngleAction)
+
       enum class Preset : u8 {
         GROUND_PLANE_VISIBLE,      // at this head angle, the whole ground plane (or the max amount) will be visible
         IDEAL_BLOCK_VIEW           // ideal angle for looking at blocks
@@ -441,6 +447,8 @@ namespace Vector {
     class MoveLiftToHeightAction : public IAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(MoveLiftToHeightAction)
+
       
       // Named presets:
       enum class Preset : u8 {
@@ -808,6 +816,8 @@ namespace Vector {
     class WaitAction : public IAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(WaitAction)
+
       WaitAction(f32 waitTimeInSeconds);
 
       virtual f32 GetTimeoutInSeconds() const override;
@@ -843,6 +853,8 @@ namespace Vector {
     class WaitForLambdaAction : public IAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(WaitForLambdaAction)
+
       WaitForLambdaAction(std::function<bool(Robot&)> lambda,
                           f32 timeout_sec = std::numeric_limits<f32>::max())
         : IAction("WaitForLambda",
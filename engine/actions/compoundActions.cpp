@@ -98,7 +98,10 @@ namespace Anki {
       // compound action in which they are included
       action->EnableMessageDisplay(IsMessageDisplayEnabled());
 
-      std::shared_ptr<IActionRunner> sharedPtr(action);
+      // Control block comes from the same pool as the list nodes
+      std::shared_ptr<IActionRunner> sharedPtr(action,
+                                               std::default_delete<IActionRunner>(),
+                                               ActionAllocators::NodeAllocator<IActionRunner>());
       
       _actions.emplace_back(sharedPtr);
       name += action->GetName();
@@ -175,7 +178,7 @@ namespace Anki {
       }
     }
     
-    void ICompoundAction::StoreUnionAndDelete(std::list<std::shared_ptr<IActionRunner>>::iterator& currentAction)
+    void ICompoundAction::StoreUnionAndDelete(ChildActionList::iterator& currentAction)
     {
       // This will assert if someone is storing a shared_ptr to this action
       // (locked the weak_ptr returned from AddAction) and has not yet released it
@@ -415,6 +418,14 @@ namespace Anki {
           {
             case ActionResultCategory::RUNNING:
             {
+              // Let the next action get ready while this one finishes
+              auto nextAction = std::next(_currentAction);
+              if(nextAction != _actions.end()) {
+                if(!(*nextAction)->HasRobot()){
+                  (*nextAction)->SetRobot(&GetRobot());
+                }
+                (*nextAction)->Prepare();
+              }
               return ActionResult::RUNNING;
             }
             case ActionResultCategory::SUCCESS:
@@ -476,6 +487,18 @@ namespace Anki {
       
     } // CompoundActionSequential::Update()
     
+    
+    void CompoundActionSequential::PrepareInternal()
+    {
+      if(!_actions.empty())
+      {
+        if(!_actions.front()->HasRobot()){
+          _actions.front()->SetRobot(&GetRobot());
+        }
+        _actions.front()->Prepare();
+      }
+    }
+    
 
     
 #pragma mark ---- CompoundActionParallel ----
@@ -598,5 +621,17 @@ namespace Anki {
       return result;
     } // CompoundActionParallel::Update()
     
+    
+    void CompoundActionParallel::PrepareInternal()
+    {
+      for(auto& action : _actions)
+      {
+        if(!action->HasRobot()){
+          action->SetRobot(&GetRobot());
+        }
+        action->Prepare();
+      }
+    }
+    
   } // namespace Vector
 } // namespace Anki
@@ -20,8 +20,10 @@
 #ifndef ANKI_COZMO_COMPOUND_ACTIONS_H
 #define ANKI_COZMO_COMPOUND_ACTIONS_H
 
+#include "engine/actions/actionAllocators.h"
 #include "engine/actions/actionInterface.h"
 
+#include <list>
 #include <map>
 
 namespace Anki {
@@ -34,6 +36,11 @@ namespace Anki {
     public:
       ICompoundAction(const std::list<IActionRunner*>& actions);
       
+      // Constituent actions. List nodes come from a pool, since compound actions are built and torn down
+      // constantly by behaviors
+      using ChildActionList = std::list<std::shared_ptr<IActionRunner>,
+                                        ActionAllocators::NodeAllocator<std::shared_ptr<IActionRunner>>>;
+      
       // Adds an action to this compound action. Completely hands ownership and memory management
       // of the action over to this compoundAction
       // Internally creates a shared_ptr and will return a weak_ptr to it should the caller
@@ -50,7 +57,7 @@ namespace Anki {
       // from this compound action completely.
       void ClearActions();
       
-      const std::list<std::shared_ptr<IActionRunner>>& GetActionList() const { return _actions; }
+      const ChildActionList& GetActionList() const { return _actions; }
       
       // Constituent actions will be deleted upon destruction of the group
       virtual ~ICompoundAction();
@@ -74,7 +81,7 @@ namespace Anki {
       virtual void Reset(bool shouldUnlockTracks = true) override;
       
       // The list of actions in this compound action stored as shared_ptrs
-      std::list<std::shared_ptr<IActionRunner>> _actions;
+      ChildActionList _actions;
       
       bool ShouldIgnoreFailure(ActionResult result, const std::shared_ptr<IActionRunner>& action) const;
       
@@ -85,10 +92,11 @@ namespace Anki {
       };
       
       // Map of action tag to completion data
-      std::map<u32, CompletionData> _completedActionInfoStack;
+      std::map<u32, CompletionData, std::less<u32>,
+               ActionAllocators::NodeAllocator<std::pair<const u32, CompletionData>>> _completedActionInfoStack;
       
       // NOTE: Moves currentAction iterator to next action after deleting
-      void StoreUnionAndDelete(std::list<std::shared_ptr<IActionRunner>>::iterator& currentAction);
+      void StoreUnionAndDelete(ChildActionList::iterator& currentAction);
 
       virtual void OnRobotSet() override final;
       virtual void OnRobotSetInternalCompound() {};
@@ -96,7 +104,8 @@ namespace Anki {
     private:
       
       // If actions are in this list, we ignore their failures
-      std::map<const IActionRunner*, ShouldIgnoreFailureFcn> _ignoreFailure;
+      std::map<const IActionRunner*, ShouldIgnoreFailureFcn, std::less<const IActionRunner*>,
+               ActionAllocators::NodeAllocator<std::pair<const IActionRunner* const, ShouldIgnoreFailureFcn>>> _ignoreFailure;
       u32  _proxyTag;
       bool _proxySet = false;
       
@@ -110,6 +119,8 @@ namespace Anki {
     class CompoundActionSequential : public ICompoundAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(CompoundActionSequential)
+
       CompoundActionSequential();
       CompoundActionSequential(const std::list<IActionRunner*>& actions);
       
@@ -127,11 +138,14 @@ namespace Anki {
       
       virtual ActionResult UpdateInternal() override final;
       
+      // Prepares the first constituent action
+      virtual void PrepareInternal() override final;
+      
       ActionResult MoveToNextAction(float currentTime_secs);
       
       f32 _delayBetweenActionsInSeconds;
       f32 _waitUntilTime;
-      std::list<std::shared_ptr<IActionRunner>>::iterator _currentAction;
+      ChildActionList::iterator _currentAction;
       bool _wasJustReset;
       
     }; // class CompoundActionSequential
@@ -144,6 +158,8 @@ namespace Anki {
     class CompoundActionParallel : public ICompoundAction
     {
     public:
+      ANKI_POOLED_ACTION_ALLOCATION(CompoundActionParallel)
+
       CompoundActionParallel();
       CompoundActionParallel(const std::list<IActionRunner*>& actions);
       
@@ -159,6 +175,9 @@ namespace Anki {
     protected:
       
       virtual ActionResult UpdateInternal() override final;
+      
+      // Prepares all constituent actions
+      virtual void PrepareInternal() override final;
     private:
       bool _endWhenFirstActionCompletes = false;
       
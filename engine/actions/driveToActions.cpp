@@ -45,6 +45,51 @@ namespace Anki {
     namespace {
       CONSOLE_VAR(bool, kEnablePredockDistanceCheckFix, "DriveToActions", true);
       CONSOLE_VAR(f32, kDriveToPoseTimeout, "DriveToActions", 30.f);
+      CONSOLE_VAR(bool, kPrecomputePathsForQueuedActions, "DriveToActions", true);
+      
+      // Paths for actions which haven't started yet are only planned when nothing else is using the planner
+      // and the robot isn't driving, so that the path starts where the robot will be when the action runs
+      bool CanPrecomputePathForQueuedAction(Robot& robot)
+      {
+        return kPrecomputePathsForQueuedActions &&
+               !robot.GetPathComponent().IsActive() &&
+               !robot.GetMoveComponent().AreWheelsMoving();
+      }
+      
+      // Starts planning a path to goals for an action which is about to run. Init() picks the plan up through
+      // PathComponent, which throws it away if the robot or the goals have changed by then. Returns false, and
+      // leaves goalsWrtOrigin empty, if it didn't plan.
+      bool PrecomputePathForQueuedAction(Robot& robot,
+                                         const std::vector<Pose3d>& goals,
+                                         const bool canReplanningChangeGoal,
+                                         std::shared_ptr<Planning::GoalID> selectedGoalIndex,
+                                         std::vector<Pose3d>& goalsWrtOrigin)
+      {
+        goalsWrtOrigin.clear();
+        if( !CanPrecomputePathForQueuedAction(robot) ) {
+          return false;
+        }
+        
+        goalsWrtOrigin.resize(goals.size());
+        for(size_t i = 0; i < goals.size(); ++i) {
+          if(!goals[i].GetWithRespectTo(robot.GetWorldOrigin(), goalsWrtOrigin[i])) {
+            goalsWrtOrigin.clear();
+            return false;
+          }
+        }
+        
+        auto& pathComponent = robot.GetPathComponent();
+        pathComponent.SetCanReplanningChangeGoal(canReplanningChangeGoal);
+        if(pathComponent.PrecomputePath(goalsWrtOrigin, selectedGoalIndex) != RESULT_OK) {
+          goalsWrtOrigin.clear();
+          return false;
+        }
+        
+        LOG_INFO("DriveToActions.PrecomputePathForQueuedAction",
+                 "Planning to %zu goal(s) before the action starts",
+                 goalsWrtOrigin.size());
+        return true;
+      }
     }
     
 #pragma mark ---- DriveToObjectAction ----
@@ -105,6 +150,15 @@ namespace Anki {
                  _objectID.GetValue());
         GetRobot().GetCubeLightComponent().StopLightAnimAndResumePrevious(CubeAnimationTrigger::DrivingTo, _objectID);
       }
+      
+      // Drop the path planned by PrepareInternal if this never ran and nothing else has taken over the planner
+      if(HasRobot() && !HasStarted() && !_preparedGoals.empty())
+      {
+        auto& pathComponent = GetRobot().GetPathComponent();
+        if(pathComponent.IsPrecomputedPathTo(_preparedGoals)) {
+          pathComponent.Abort();
+        }
+      }
       _compoundAction.PrepForCompletion();
     }
     
@@ -223,24 +277,23 @@ namespace Anki {
       return ActionResult::SUCCESS;
     } // GetPossiblePoses()
     
-    ActionResult DriveToObjectAction::InitHelper(ActionableObject* object)
+    ActionResult DriveToObjectAction::ComputeGoalPoses(ActionableObject* object,
+                                                       std::vector<Pose3d>& possiblePoses,
+                                                       bool& alreadyInPosition)
     {
       ActionResult result = ActionResult::RUNNING;
       
-      std::vector<Pose3d> possiblePoses;
-      bool alreadyInPosition = false;
-      
       if(PreActionPose::ActionType::NONE == _actionType) {
         
         if(_distance_mm < 0.f) {
-          PRINT_NAMED_ERROR("DriveToObjectAction.InitHelper.NoDistanceSet",
+          PRINT_NAMED_ERROR("DriveToObjectAction.ComputeGoalPoses.NoDistanceSet",
                             "ActionType==NONE but no distance set either.");
           result = ActionResult::NO_DISTANCE_SET;
         } else {
           
           Pose3d objectWrtRobotParent;
           if(false == object->GetPose().GetWithRespectTo(GetRobot().GetPose().GetParent(), objectWrtRobotParent)) {
-            PRINT_NAMED_ERROR("DriveToObjectAction.InitHelper.PoseProblem",
+            PRINT_NAMED_ERROR("DriveToObjectAction.ComputeGoalPoses.PoseProblem",
                               "Could not get object pose w.r.t. robot parent pose.");
             result = ActionResult::BAD_POSE;
           } else {
@@ -264,6 +317,16 @@ namespace Anki {
         result = _getPossiblePosesFunc(object, possiblePoses, alreadyInPosition);
       }
       
+      return result;
+    } // ComputeGoalPoses()
+    
+    ActionResult DriveToObjectAction::InitHelper(ActionableObject* object)
+    {
+      std::vector<Pose3d> possiblePoses;
+      bool alreadyInPosition = false;
+      
+      ActionResult result = ComputeGoalPoses(object, possiblePoses, alreadyInPosition);
+      
       // In case we are re-running this action, make sure compound actions are cleared.
       // These will do nothing if compoundAction has nothing in it yet (i.e., on first Init)
       _compoundAction.ClearActions();
@@ -306,6 +369,29 @@ namespace Anki {
       
     } // InitHelper()
     
+    void DriveToObjectAction::PrepareInternal()
+    {
+      if(_hasPrepared || !CanPrecomputePathForQueuedAction(GetRobot())) {
+        return;
+      }
+      
+      ActionableObject* object = dynamic_cast<ActionableObject*>(GetRobot().GetBlockWorld().GetLocatedObjectByID(_objectID));
+      if(object == nullptr) {
+        return;
+      }
+      
+      // Only try once, whether or not there turns out to be anything to plan
+      _hasPrepared = true;
+      
+      std::vector<Pose3d> possiblePoses;
+      bool alreadyInPosition = false;
+      const ActionResult result = ComputeGoalPoses(object, possiblePoses, alreadyInPosition);
+      if((result == ActionResult::SUCCESS) && !alreadyInPosition && !possiblePoses.empty()) {
+        // Same settings as the DriveToPoseAction that InitHelper creates, which will pick this plan up
+        PrecomputePathForQueuedAction(GetRobot(), possiblePoses, true, {}, _preparedGoals);
+      }
+    }
+    
     ActionResult DriveToObjectAction::Init()
     {
       ActionableObject* object = dynamic_cast<ActionableObject*>(GetRobot().GetBlockWorld().GetLocatedObjectByID(_objectID));
@@ -691,6 +777,19 @@ namespace Anki {
       return result;
     } // Init()
     
+    void DriveToPoseAction::PrepareInternal()
+    {
+      if(_hasPrepared || !_isGoalSet || !CanPrecomputePathForQueuedAction(GetRobot())) {
+        return;
+      }
+      
+      // Only try once. If this never runs, the destructor aborts the plan
+      _hasPrepared = true;
+      *_selectedGoalIndex = 0;
+      std::vector<Pose3d> goalsWrtOrigin;
+      PrecomputePathForQueuedAction(GetRobot(), _goalPoses, !_mustUseOriginalGoal, _selectedGoalIndex, goalsWrtOrigin);
+    }
+    
     ActionResult DriveToPoseAction::CheckIfDone()
     {
       ActionResult result = ActionResult::RUNNING;
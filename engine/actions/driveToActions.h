@@ -70,6 +70,9 @@ namespace Anki {
       virtual ActionResult Init() override;
       virtual ActionResult CheckIfDone() override;
       
+      // Starts planning from the robot's current pose if nothing else is using the planner
+      virtual void PrepareInternal() override;
+      
     private:
       
       ActionResult HandleComputingPath();
@@ -94,6 +97,9 @@ namespace Anki {
       
       bool _mustUseOriginalGoal = false;
       
+      // True once PrepareInternal has tried to plan
+      bool _hasPrepared = false;
+      
     }; // class DriveToPoseAction
 
     
@@ -166,6 +172,14 @@ namespace Anki {
       
       ActionResult InitHelper(ActionableObject* object);
       
+      // Poses InitHelper drives to. alreadyInPosition is set if there's no need to drive
+      ActionResult ComputeGoalPoses(ActionableObject* object,
+                                    std::vector<Pose3d>& possiblePoses,
+                                    bool& alreadyInPosition);
+      
+      // Starts planning to the object's current pre-action poses if nothing else is using the planner
+      virtual void PrepareInternal() override;
+      
       virtual void OnRobotSet() override final;
       virtual void OnRobotSetInternalDriveToObj() {};
       
@@ -191,6 +205,10 @@ namespace Anki {
       bool _lightsSet = false;
       
       bool _visuallyVerifyWhenDone = true;
+      
+      // True once PrepareInternal has tried to plan, and the goals (w.r.t. the world origin) it planned to
+      bool _hasPrepared = false;
+      std::vector<Pose3d> _preparedGoals;
     }; // DriveToObjectAction
 
   
@@ -209,6 +227,9 @@ namespace Anki {
       virtual ActionResult Init() override;
       virtual ActionResult CheckIfDone() override; // Simplified version from DriveToObjectAction
       
+      // The goals depend on the placement pose rather than the carried object, so nothing is planned early
+      virtual void PrepareInternal() override { }
+      
       // checks if the placement destination is free (alternatively we could provide an std::function callback)
       bool IsPlacementGoalFree() const;
 
@@ -83,14 +83,23 @@ void SayTextAction::SetAnimationTrigger(AnimationTrigger trigger, u8 ignoreTrack
 } // SetAnimationTrigger()
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ActionResult SayTextAction::Init()
+UtteranceTriggerType SayTextAction::GetTriggerType() const
+{
+  return ((_animTrigger == AnimationTrigger::Count) ? UtteranceTriggerType::Manual : UtteranceTriggerType::KeyFrame);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SayTextAction::PrefetchUtterance(TextToSpeechCoordinator& ttsCoordinator) const
 {
-  //
-  // If we have an animation, use keyframe trigger, else use manual trigger.
-  //
-  const auto triggerType =
-    ((_animTrigger == AnimationTrigger::Count) ? UtteranceTriggerType::Manual : UtteranceTriggerType::KeyFrame);
+  if (!IsAwaitingUtterance()) {
+    return false;
+  }
+  return ttsCoordinator.PrefetchUtterance(GetTag(), _text, GetTriggerType(), _style, _durationScalar);
+}
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ActionResult SayTextAction::Init()
+{
   _ttsCoordinator = &GetRobot().GetTextToSpeechCoordinator();
   _callbackPtr = std::make_shared<CallbackType>(std::bind(&SayTextAction::TtsCoordinatorStateCallback, this, std::placeholders::_1));
   std::weak_ptr<CallbackType> weakCallback = _callbackPtr;
@@ -100,11 +109,16 @@ ActionResult SayTextAction::Init()
       (*callback)(state);
     }
   };
-  _ttsID = _ttsCoordinator->CreateUtterance(_text,
-                                            triggerType,
-                                            _style,
-                                            _durationScalar,
-                                            ttsCallback);
+
+  // Use the utterance generated while earlier actions ran, if there is one
+  _ttsID = _ttsCoordinator->ClaimPrefetchedUtterance(GetTag(), ttsCallback);
+  if (kInvalidUtteranceID == _ttsID) {
+    _ttsID = _ttsCoordinator->CreateUtterance(_text,
+                                              GetTriggerType(),
+                                              _style,
+                                              _durationScalar,
+                                              ttsCallback);
+  }
 
   _actionState = SayTextActionState::Waiting;
 
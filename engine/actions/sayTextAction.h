@@ -53,6 +53,13 @@ public:
   // Audio::GameEvent::GenericEvent::Play__Robot_Vic__External_Voice_Text
   void SetAnimationTrigger(AnimationTrigger trigger, u8 ignoreTracks = 0);
 
+  // True until Init() has gotten this action an utterance
+  bool IsAwaitingUtterance() const { return (kInvalidUtteranceID == _ttsID); }
+
+  // Asks the coordinator to start generating this action's utterance before the action runs, so that it can play
+  // as soon as the action starts. Init() claims it. Returns false if nothing was prefetched.
+  bool PrefetchUtterance(TextToSpeechCoordinator& ttsCoordinator) const;
+
 protected:
 
   // IAction interface methods
@@ -90,6 +97,9 @@ private:
   f32                             _timeout_sec        = 30.f;
   f32                             _expiration_sec     = 0.f;
 
+  // Keyframe when there is an accompanying animation to trigger the audio, else manual
+  UtteranceTriggerType GetTriggerType() const;
+
   // Internal state machine
   void TtsCoordinatorStateCallback(const UtteranceState& state);
   ActionResult GetTtsCoordinatorActionState();
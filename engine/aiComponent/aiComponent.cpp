@@ -139,7 +139,7 @@ void AIComponent::CheckForSuddenObstacle(Robot& robot)
   int n = 0;
   for(auto st = states.rbegin(); st != states.rend() && st->first > endTime; ++st) {
     const auto& state = st->second;
-    angleVec.push_back(state.GetPose().GetRotationAngle<'Z'>());
+    angleVec.push_back(state.GetPoseSnapshot().GetTransform().GetRotationAngle<'Z'>());
     const auto& proxData = state.GetProxSensorData();
 
     // only check for average prox value if we found an object
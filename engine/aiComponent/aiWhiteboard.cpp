@@ -39,6 +39,8 @@
 #include "util/console/consoleInterface.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+
 #define DEBUG_AI_WHITEBOARD_POSSIBLE_OBJECTS 0
 
 namespace Anki {
@@ -106,6 +108,7 @@ AIWhiteboard::AIWhiteboard(Robot& robot)
 , _edgeInfoClosestEdge_mm(-1.0f)
 , _sayNameProbTable(new SayNameProbabilityTable(*_robot.GetContext()->GetRandom()))
 {
+  _possibleObjects.reserve(kBW_MaxPossibleObjects);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -182,7 +185,8 @@ void AIWhiteboard::ProcessClearQuad(const Quad2f& quad)
     }
   };
   const size_t countBefore = _possibleObjects.size();
-  _possibleObjects.remove_if( isObjectInsideQuad );
+  _possibleObjects.erase( std::remove_if(_possibleObjects.begin(), _possibleObjects.end(), isObjectInsideQuad),
+                          _possibleObjects.end() );
   const size_t countAfter = _possibleObjects.size();
   
   // update render if we removed something
@@ -222,6 +226,7 @@ void AIWhiteboard::SetFailedToUse(const ObservableObject& object, ObjectActionFa
   // check if we need to remove an entry because we have reached the maximum
   const size_t maxItemsInList = GetObjectFailureListMaxSize(action);
   DEV_ASSERT(maxItemsInList > 0, "AIWhiteboard.SetFailedToUse.MaxIs0");
+  DEV_ASSERT(maxItemsInList <= failureListForObj.capacity(), "AIWhiteboard.SetFailedToUse.MaxBeyondCapacity");
   if ( failureListForObj.size() >= maxItemsInList )
   {
     // can't have an empty list or a list bigger than the max (so it has to be equal to the max)
@@ -233,10 +238,10 @@ void AIWhiteboard::SetFailedToUse(const ObservableObject& object, ObjectActionFa
       "Removed failure on ['%s'] for object '%d' atPose (%.2f,%.2f,%.2f) atTime (%fs) to add one (we are at the max=%zu)",
       ObjectActionFailureToString(action),
       object.GetID().GetValue(),
-      failureListForObj.begin()->_pose.GetTranslation().x(),
-      failureListForObj.begin()->_pose.GetTranslation().y(),
-      failureListForObj.begin()->_pose.GetTranslation().z(),
-      failureListForObj.begin()->_timestampSecs,
+      failureListForObj.front()._pose.GetTranslation().x(),
+      failureListForObj.front()._pose.GetTranslation().y(),
+      failureListForObj.front()._pose.GetTranslation().z(),
+      failureListForObj.front()._timestampSecs,
       maxItemsInList);
   
     // remove first
@@ -247,7 +252,9 @@ void AIWhiteboard::SetFailedToUse(const ObservableObject& object, ObjectActionFa
   {
     // insert at back (newest)
     const float curTime = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
-    failureListForObj.emplace_back(atLocation, curTime);
+    failureListForObj.push_back(FailureInfo(atLocation, curTime));
+    ++_failuresGeneration;
+    _lastFailureTime_s = curTime;
     
     // log the new one
     PRINT_CH_INFO("AIWhiteboard", "SetFailedToUse",
@@ -317,9 +324,10 @@ bool AIWhiteboard::DidFailToUse(const int objectID, AIWhiteboard::FailureReasons
 bool AIWhiteboard::DidFailToUse(const int objectID, AIWhiteboard::FailureReasonsContainer reasons, float recentSecs,
   const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold) const
 {
+  const float curTime = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
   for( const auto& reason : reasons ) {
     const ObjectFailureTable& failureTable = GetObjectFailureTable(reason);
-    const bool ret = FindMatchingEntry(failureTable, objectID, recentSecs, atPose, distThreshold_mm, angleThreshold);
+    const bool ret = FindMatchingEntry(failureTable, objectID, curTime, recentSecs, atPose, distThreshold_mm, angleThreshold);
     if( ret ) {
       return true;
     }
@@ -331,7 +339,7 @@ bool AIWhiteboard::DidFailToUse(const int objectID, AIWhiteboard::FailureReasons
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool AIWhiteboard::FindMatchingEntry(const ObjectFailureTable& failureTable, const int objectID,
-  float recentSecs,
+  float curTime, float recentSecs,
   const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold) const
 {
   // if we are looking for failures in any object
@@ -342,10 +350,10 @@ bool AIWhiteboard::FindMatchingEntry(const ObjectFailureTable& failureTable, con
     {
       // iterate all entries in each queue
       const FailureList& failuresForObj = pair.second;
-      for( const FailureInfo& failureInfo : failuresForObj)
+      for( size_t i = 0; i < failuresForObj.size(); ++i )
       {
         // check if the entry matches the search
-        const bool matchesSearch = EntryMatches(failureInfo, recentSecs, atPose, distThreshold_mm, angleThreshold);
+        const bool matchesSearch = EntryMatches(failuresForObj[i], curTime, recentSecs, atPose, distThreshold_mm, angleThreshold);
         if ( matchesSearch ) {
           // it does, we found a failure we care about
           return true;
@@ -364,10 +372,10 @@ bool AIWhiteboard::FindMatchingEntry(const ObjectFailureTable& failureTable, con
     {
       // iterate all entries in this queue
       const FailureList& failuresForObj = failuresForObjIt->second;
-      for( const FailureInfo& failureInfo : failuresForObj)
+      for( size_t i = 0; i < failuresForObj.size(); ++i )
       {
         // check if the entry matches the search
-        const bool matchesSearch = EntryMatches(failureInfo, recentSecs, atPose, distThreshold_mm, angleThreshold);
+        const bool matchesSearch = EntryMatches(failuresForObj[i], curTime, recentSecs, atPose, distThreshold_mm, angleThreshold);
         if ( matchesSearch ) {
           // it does, we found a failure we care about
           return true;
@@ -381,13 +389,13 @@ bool AIWhiteboard::FindMatchingEntry(const ObjectFailureTable& failureTable, con
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool AIWhiteboard::EntryMatches(const FailureInfo& entry, float recentSecs, const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold) const
+bool AIWhiteboard::EntryMatches(const FailureInfo& entry, float curTime, float recentSecs,
+  const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold)
 {
   // if we specified a timestamp (ie: if we care about recent entries only)
   const bool checkTime = FLT_GE(recentSecs, 0.0f);
   if ( checkTime )
   {
-    const float curTime = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
     const float timeSinceFailureSecs = curTime - entry._timestampSecs;
     const bool entryIsTooOld = FLT_GE(timeSinceFailureSecs, recentSecs);
     if ( entryIsTooOld ) {
@@ -639,7 +647,7 @@ void AIWhiteboard::ConsiderNewPossibleObject(ObjectType objectType, const Pose3d
   {
     // we reached the limit, remove oldest entry
     DEV_ASSERT(!_possibleObjects.empty(), "AIWhiteboard.HandleMessage.ReachedLimitEmpty");
-    _possibleObjects.pop_front();
+    _possibleObjects.erase( _possibleObjects.begin() );
     // PRINT_NAMED_INFO("AIWhiteboard.HandleMessage.BeyondObjectLimit", "Reached limit of pending objects, removing oldest one");
   }
 
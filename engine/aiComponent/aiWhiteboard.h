@@ -23,11 +23,14 @@
 #include "clad/types/objectTypes.h"
 #include "clad/types/behaviorComponent/postBehaviorSuggestions.h"
 
+#include "util/container/fixedCircularBuffer.h"
 #include "util/entityComponent/iDependencyManagedComponent.h"
 #include "util/helpers/noncopyable.h"
 #include "util/signals/simpleSignal_fwd.h"
 
+#include <initializer_list>
 #include <list>
+#include <map>
 #include <queue>
 #include <set>
 #include <vector>
@@ -67,7 +70,7 @@ public:
     Pose3d pose;
     ObjectType type;
   };
-  using PossibleObjectList = std::list<PossibleObject>;
+  using PossibleObjectList = std::vector<PossibleObject>; // capacity reserved up to kBW_MaxPossibleObjects
   using PossibleObjectVector = std::vector<PossibleObject>;
   
   // object usage reason for failure
@@ -163,8 +166,8 @@ public:
                     const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold) const;
 
   // same as above, with multiple reasons considered at the same time. Returns true if there is a failure for
-  // _any_ of the specified reasons
-  using FailureReasonsContainer = std::set< ObjectActionFailure >;
+  // _any_ of the specified reasons. Only meant to be passed inline, e.g. {PickUpObject, RollOrPopAWheelie}
+  using FailureReasonsContainer = std::initializer_list< ObjectActionFailure >;
   bool DidFailToUse(const int objectID, FailureReasonsContainer reasons) const;
   bool DidFailToUse(const int objectID, FailureReasonsContainer reasons, float recentSecs) const;
   bool DidFailToUse(const int objectID, FailureReasonsContainer reasons,
@@ -172,6 +175,11 @@ public:
   bool DidFailToUse(const int objectID, FailureReasonsContainer reasons,
                     float recentSecs, const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold) const;
   
+  // incremented by every SetFailedToUse, and the time of the last one (negative if there never was one), so that
+  // caches of results that depend on failures know when they may have changed
+  u32   GetFailuresGeneration() const { return _failuresGeneration; }
+  float GetLastFailureTime_s() const { return _lastFailureTime_s; }
+  
   
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -258,16 +266,19 @@ private:
   // Failures
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   
-  // failure container typedefs
-  using FailureList = std::list<FailureInfo>; // I actually want a queue, but can't iterate queues (deque is more than queue)
+  // failure container typedefs. Each object keeps its newest failures in a fixed ring, whose size is further limited
+  // per action (see GetObjectFailureListMaxSize), so recording a failure never allocates after the first one
+  static constexpr const size_t kMaxFailuresPerObject = 10;
+  using FailureList = Util::FixedCircularBuffer<FailureInfo, kMaxFailuresPerObject>;
   using ObjectFailureTable = std::map<int, FailureList>; // easier to limit size in inner container than multimap
   
   // helper to search for failures in the given failure table
-  bool FindMatchingEntry(const ObjectFailureTable& failureTable, const int objectID, float recentSecs,
+  bool FindMatchingEntry(const ObjectFailureTable& failureTable, const int objectID, float curTime, float recentSecs,
                          const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold) const;
   
   // helper to compare whether the given entry matches the search parameters or not
-  bool EntryMatches(const FailureInfo& entry, float recentSecs, const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold) const;
+  static bool EntryMatches(const FailureInfo& entry, float curTime, float recentSecs,
+                           const Pose3d& atPose, float distThreshold_mm, const Radians& angleThreshold);
   
   // retrieve ObjectFailureTable for the given failure reason/action
   const ObjectFailureTable& GetObjectFailureTable(ObjectActionFailure action) const;
@@ -288,6 +299,8 @@ private:
   ObjectFailureTable _stackOnFailures;
   ObjectFailureTable _placeAtFailures;
   ObjectFailureTable _rollOrPopFailures;
+  u32   _failuresGeneration = 0;
+  float _lastFailureTime_s = -1.0f;
     
   // time at which the engine processed edge information coming from vision
   float _edgeInfoTime_sec;
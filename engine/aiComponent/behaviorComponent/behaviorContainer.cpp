@@ -5,7 +5,7 @@
  * Created: 11/20/15
  *
  * Description: Container which creates and stores behaviors by ID
- * which were generated from data
+ * which were generated from data (see header)
  *
  * Copyright: Anki, Inc. 2015
  *
@@ -42,8 +42,8 @@ BehaviorContainer::BehaviorContainer(const BehaviorIDJsonMap& behaviorData)
     if (!behaviorJson.empty())
     {
       // PRINT_NAMED_DEBUG("BehaviorContainer.Constructor", "Loading '%s'", fullFileName.c_str());
-      const bool createdOK = CreateAndStoreBehavior(behaviorJson);
-      if ( !createdOK ) {
+      const bool registeredOK = RegisterBehavior(behaviorJson);
+      if ( !registeredOK ) {
         PRINT_NAMED_ERROR("Robot.LoadBehavior.CreateFailed",
                           "Failed to create a behavior for behavior id '%s'",
                           BehaviorIDToString(behaviorID));
@@ -66,6 +66,7 @@ BehaviorContainer::~BehaviorContainer()
 {
   // Delete all behaviors owned by the factory
   _idToBehaviorMap.clear();
+  _unconstructedBehaviors.clear();
 }
 
 
@@ -81,12 +82,108 @@ void BehaviorContainer::InitDependent(Robot* robot, const BCCompMap& dependentCo
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void BehaviorContainer::Init(BehaviorExternalInterface& behaviorExternalInterface)
 {
+  _bei = &behaviorExternalInterface;
+
+  // Behaviors looked up by others' Init are constructed and initialized on the spot, so only the ones constructed
+  // before now need initializing here. All of them must be initialized before any operation modifiers are
+  std::vector<ICozmoBehaviorPtr> behaviors;
+  behaviors.reserve(_idToBehaviorMap.size());
   for(auto& behaviorMap: _idToBehaviorMap){
-    behaviorMap.second->Init(behaviorExternalInterface);
+    behaviors.push_back(behaviorMap.second);
   }
 
-  for(auto& behaviorMap: _idToBehaviorMap){
-    behaviorMap.second->InitBehaviorOperationModifiers();
+  _isInitializing = true;
+  for(auto& behavior: behaviors){
+    behavior->Init(behaviorExternalInterface);
+  }
+  _isInitializing = false;
+
+  behaviors.insert(behaviors.end(),
+                   _behaviorsAwaitingOperationModifiers.begin(),
+                   _behaviorsAwaitingOperationModifiers.end());
+  _behaviorsAwaitingOperationModifiers.clear();
+  for(auto& behavior: behaviors){
+    behavior->InitBehaviorOperationModifiers();
+  }
+
+  LOG_INFO("BehaviorContainer.Init.ConstructedBehaviors",
+           "Constructed %zu of %zu registered behaviors",
+           GetNumConstructedBehaviors(),
+           GetNumRegisteredBehaviors());
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BehaviorContainer::RegisterBehavior(const Json::Value& behaviorConfig)
+{
+  BehaviorID behaviorID;
+  const Json::Value& idJson = behaviorConfig["behaviorID"];
+  if( !idJson.isString() || !BehaviorTypesWrapper::BehaviorIDFromString(idJson.asString(), behaviorID) ) {
+    LOG_ERROR("BehaviorContainer.RegisterBehavior.InvalidID",
+              "Config has a missing or unknown behaviorID '%s'",
+              idJson.isString() ? idJson.asCString() : "");
+    return false;
+  }
+
+  if( !behaviorConfig["behaviorClass"].isString() ) {
+    LOG_ERROR("BehaviorContainer.RegisterBehavior.NoClass",
+              "Config for behavior '%s' has no behaviorClass",
+              BehaviorIDToString(behaviorID));
+    return false;
+  }
+
+  if( _idToBehaviorMap.find(behaviorID) != _idToBehaviorMap.end() ) {
+    DEV_ASSERT_MSG(false,
+                   "BehaviorContainer.RegisterBehavior.DuplicateID",
+                   "Attempted to register a second behavior with id %s",
+                   BehaviorIDToString(behaviorID));
+    return false;
+  }
+
+  UnconstructedBehavior unconstructed{behaviorConfig, ICozmoBehavior::ExtractBehaviorClassFromConfig(behaviorConfig)};
+  const bool addedNewEntry = _unconstructedBehaviors.emplace(behaviorID, std::move(unconstructed)).second;
+  DEV_ASSERT_MSG(addedNewEntry,
+                 "BehaviorContainer.RegisterBehavior.DuplicateID",
+                 "Attempted to register a second behavior with id %s",
+                 BehaviorIDToString(behaviorID));
+  return addedNewEntry;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ICozmoBehaviorPtr BehaviorContainer::ConstructBehavior(BehaviorIDToConfigMap::iterator it) const
+{
+  const BehaviorID behaviorID = it->first;
+  ICozmoBehaviorPtr newBehavior = BehaviorFactory::CreateBehavior(it->second.config);
+  // either way, the config is no longer needed
+  _unconstructedBehaviors.erase(it);
+
+  if( newBehavior == nullptr ) {
+    LOG_ERROR("BehaviorContainer.ConstructBehavior.CreateFailed",
+              "Failed to create a behavior for behavior id '%s'",
+              BehaviorIDToString(behaviorID));
+    return nullptr;
+  }
+
+  _idToBehaviorMap.emplace(behaviorID, newBehavior);
+  InitConstructedBehavior(newBehavior);
+  return newBehavior;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BehaviorContainer::InitConstructedBehavior(const ICozmoBehaviorPtr& behavior) const
+{
+  if( _bei == nullptr ) {
+    // Init will get to it
+    return;
+  }
+
+  behavior->Init(*_bei);
+  if( _isInitializing ) {
+    _behaviorsAwaitingOperationModifiers.push_back(behavior);
+  } else {
+    behavior->InitBehaviorOperationModifiers();
   }
 }
 
@@ -102,6 +199,12 @@ ICozmoBehaviorPtr BehaviorContainer::FindBehaviorByID(BehaviorID behaviorID) con
     foundBehavior = scoredIt->second;
     return foundBehavior;
   }
+
+  auto unconstructedIt = _unconstructedBehaviors.find(behaviorID);
+  if (unconstructedIt != _unconstructedBehaviors.end())
+  {
+    return ConstructBehavior(unconstructedIt);
+  }
   
   return nullptr;
 }
@@ -111,6 +214,19 @@ ICozmoBehaviorPtr BehaviorContainer::FindBehaviorByID(BehaviorID behaviorID) con
 std::set<ICozmoBehaviorPtr> BehaviorContainer::FindBehaviorsByClass(BehaviorClass behaviorClass) const
 {
   std::set<ICozmoBehaviorPtr> behaviorList;
+  // Constructing one behavior can construct others (through lookups in its Init), so collect the IDs first
+  std::vector<BehaviorID> unconstructedIDs;
+  for (const auto & unconstructed : _unconstructedBehaviors)
+  {
+    if( unconstructed.second.behaviorClass == behaviorClass ) {
+      unconstructedIDs.push_back(unconstructed.first);
+    }
+  }
+  for (const auto & behaviorID : unconstructedIDs)
+  {
+    FindBehaviorByID(behaviorID);
+  }
+
   for (const auto & behavior : _idToBehaviorMap)
   {
     if( GetBehaviorClass(behavior.second) == behaviorClass )
@@ -128,8 +244,8 @@ bool BehaviorContainer::CreateAndStoreBehavior(const Json::Value& behaviorConfig
   ICozmoBehaviorPtr newBehavior = BehaviorFactory::CreateBehavior(behaviorConfig);
   if( newBehavior ) {
     const BehaviorID behaviorID = newBehavior->GetID();
-    const auto newEntry = _idToBehaviorMap.emplace( behaviorID, newBehavior );
-    const bool addedNewEntry = newEntry.second;
+    const bool isRegistered = (_unconstructedBehaviors.find(behaviorID) != _unconstructedBehaviors.end());
+    const bool addedNewEntry = !isRegistered && _idToBehaviorMap.emplace( behaviorID, newBehavior ).second;
 
     if (addedNewEntry) {
       // PRINT_CH_DEBUG(LOG_CHANNEL, "BehaviorContainer::AddToContainer",
@@ -150,6 +266,18 @@ bool BehaviorContainer::CreateAndStoreBehavior(const Json::Value& behaviorConfig
   }
 }
   
+#if ANKI_DEV_CHEATS
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const BehaviorContainer::BehaviorIDToBehaviorMap& BehaviorContainer::GetBehaviorMap() const
+{
+  while( !_unconstructedBehaviors.empty() ) {
+    ConstructBehavior(_unconstructedBehaviors.begin());
+  }
+  return _idToBehaviorMap;
+}
+#endif
+
+  
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool BehaviorContainer::RemoveBehaviorFromMap(ICozmoBehaviorPtr behavior)
 {
@@ -5,7 +5,9 @@
  * Created: 11/20/15
  *
  * Description: Container which creates and stores behaviors by ID
- * which were generated from data
+ * which were generated from data. Behaviors loaded from data are only
+ * registered with their config, and constructed (and initialized, if
+ * the container already is) the first time they are looked up
  *
  * Copyright: Anki, Inc. 2015
  *
@@ -22,12 +24,12 @@
 #include "util/global/globalDefinitions.h"
 #include "util/helpers/noncopyable.h"
 #include "util/signals/simpleSignal_fwd.h"
-#include <unordered_map>
 
+#include "json/json.h"
 
-namespace Json {
-  class Value;
-}
+#include <map>
+#include <unordered_map>
+#include <vector>
 
 
 namespace Anki {
@@ -59,8 +61,10 @@ public:
   //////
 
 
+  // Constructs the behavior from its registered config if this is the first lookup
   ICozmoBehaviorPtr FindBehaviorByID(BehaviorID behaviorID) const;
   
+  // Constructs every registered behavior of this class that hasn't been yet
   std::set<ICozmoBehaviorPtr> FindBehaviorsByClass(BehaviorClass behaviorClass) const;
 
   // Sometimes it's necessary to downcast to a behavior to a specific behavior pointer, e.g. so an Activity
@@ -74,9 +78,12 @@ public:
 
   // Create a behavior from the given config. Config must specify a behavior ID and class. If the behavior is
   // successfully created and added to the container, True is returned. Errors include malformed JSON or
-  // duplicate behavior IDs
+  // duplicate behavior IDs. Unlike behaviors loaded from data, this one is constructed right away
   bool CreateAndStoreBehavior(const Json::Value& behaviorConfig);
 
+  size_t GetNumConstructedBehaviors() const { return _idToBehaviorMap.size(); }
+  size_t GetNumRegisteredBehaviors() const { return _idToBehaviorMap.size() + _unconstructedBehaviors.size(); }
+
   // ==================== Event/Message Handling ====================
   // Handle various message types
   template<typename T>
@@ -95,14 +102,33 @@ protected:
   using BehaviorIDToBehaviorMap = std::map<BehaviorID, ICozmoBehaviorPtr>;
 
 #if ANKI_DEV_CHEATS
-  const BehaviorIDToBehaviorMap& GetBehaviorMap() const { return _idToBehaviorMap; }
+  // Constructs every registered behavior first, so the map is complete
+  const BehaviorIDToBehaviorMap& GetBehaviorMap() const;
 #endif
 
 private:
   IExternalInterface* _robotExternalInterface;
 
+  // Config of a behavior that has been registered but not constructed yet
+  struct UnconstructedBehavior {
+    Json::Value   config;
+    BehaviorClass behaviorClass;
+  };
+  using BehaviorIDToConfigMap = std::map<BehaviorID, UnconstructedBehavior>;
+
   // ============================== Private Member Funcs ==============================
 
+  // Registers the config so the behavior can be constructed on first lookup. Returns false for malformed
+  // configs or duplicate IDs
+  bool RegisterBehavior(const Json::Value& behaviorConfig);
+
+  // Constructs the registered behavior, moves it to _idToBehaviorMap and initializes it if the container has been
+  ICozmoBehaviorPtr ConstructBehavior(BehaviorIDToConfigMap::iterator it) const;
+
+  // Calls Init and then InitBehaviorOperationModifiers on a newly constructed behavior. During the container's own
+  // Init, the latter waits until every behavior constructed so far has been initialized
+  void InitConstructedBehavior(const ICozmoBehaviorPtr& behavior) const;
+
   bool RemoveBehaviorFromMap(ICozmoBehaviorPtr behavior);
 
   // helper to avoid including ICozmoBehavior.h here
@@ -112,7 +138,13 @@ private:
   std::string GetClassString(BehaviorClass behaviorClass) const;
 
   // ============================== Private Member Vars ==============================
-  BehaviorIDToBehaviorMap _idToBehaviorMap;
+  // Lookups are const but construct behaviors, moving them from one map to the other
+  mutable BehaviorIDToBehaviorMap _idToBehaviorMap;
+  mutable BehaviorIDToConfigMap   _unconstructedBehaviors;
+
+  BehaviorExternalInterface* _bei = nullptr;
+  bool _isInitializing = false;
+  mutable std::vector<ICozmoBehaviorPtr> _behaviorsAwaitingOperationModifiers;
   std::vector<Signal::SmartHandle> _signalHandles;
 
 
@@ -29,17 +29,6 @@
 namespace Anki {
 namespace Vector {
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-const BEIComponentWrapper& BehaviorExternalInterface::GetComponentWrapper(BEIComponentID componentID) const
-{
-  ANKI_VERIFY(_arrayWrapper != nullptr,
-              "BehaviorExternalInterface.GetComponentWrapper.NullArray",
-              ""); 
-  const BEIComponentWrapper& wrapper = _arrayWrapper->_array.GetComponent(componentID);
-  return wrapper;
-}
-
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 BehaviorExternalInterface::~BehaviorExternalInterface()
 {
@@ -183,18 +172,30 @@ void BehaviorExternalInterface::Init(AIComponent*                   aiComponent,
                                                      settingsCommManager,
                                                      settingsManager,
                                                      sleepTracker);
+
+  for( size_t i = 0; i < _wrappers.size(); ++i ) {
+    _wrappers[i] = &_arrayWrapper->_array.GetComponent(static_cast<BEIComponentID>(i));
+  }
+
+  _aiComponent            = aiComponent;
+  _behaviorContainer      = behaviorContainer;
+  _behaviorEventComponent = behaviorEventComponent;
+  _behaviorTimers         = behaviorTimers;
+  _blockWorld             = blockWorld;
+  _faceWorld              = faceWorld;
+  _robotInfo              = robotInfo;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 OffTreadsState BehaviorExternalInterface::GetOffTreadsState() const
 {
-  return GetComponentWrapper(BEIComponentID::RobotInfo).GetComponent<BEIRobotInfo>().GetOffTreadsState();
+  return GetRobotInfo().GetOffTreadsState();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Util::RandomGenerator& BehaviorExternalInterface::GetRNG()
 {
-  return GetComponentWrapper(BEIComponentID::RobotInfo).GetComponent<BEIRobotInfo>().GetRNG();
+  return GetRobotInfo().GetRNG();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
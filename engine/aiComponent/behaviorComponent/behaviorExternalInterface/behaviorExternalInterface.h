@@ -27,6 +27,7 @@
 #include "util/logging/logging.h"
 #include "util/random/randomGenerator.h"
 
+#include <array>
 #include <memory>
 #include <unordered_map>
 
@@ -174,23 +175,28 @@ public:
     
   virtual ~BehaviorExternalInterface();
 
-  const BEIComponentWrapper& GetComponentWrapper(BEIComponentID componentID) const;
+  // Resolved once in Init, so this is an array index rather than a search of the component map
+  const BEIComponentWrapper& GetComponentWrapper(BEIComponentID componentID) const {
+    const BEIComponentWrapper* wrapper = _wrappers[static_cast<size_t>(componentID)];
+    DEV_ASSERT(wrapper != nullptr, "BehaviorExternalInterface.GetComponentWrapper.NotInitialized");
+    return *wrapper;
+  }
   
   // Access components which the BehaviorSystem can count on will always exist
-  // when making decisions
-  AIComponent&             GetAIComponent()               const { return GetComponentWrapper(BEIComponentID::AIComponent).GetComponent<AIComponent>();}
-  const FaceWorld&         GetFaceWorld()                 const { return GetComponentWrapper(BEIComponentID::FaceWorld).GetComponent<FaceWorld>();}
-  FaceWorld&               GetFaceWorldMutable()                { return GetComponentWrapper(BEIComponentID::FaceWorld).GetComponent<FaceWorld>();}
+  // when making decisions. These are never stripped, so they are cached as typed pointers and skip the wrapper checks
+  AIComponent&             GetAIComponent()               const { return Deref(_aiComponent);}
+  const FaceWorld&         GetFaceWorld()                 const { return Deref(_faceWorld);}
+  FaceWorld&               GetFaceWorldMutable()                { return Deref(_faceWorld);}
   const PetWorld&          GetPetWorld()                  const { return GetComponentWrapper(BEIComponentID::PetWorld).GetComponent<PetWorld>();}
-  const BlockWorld&        GetBlockWorld()                const { return GetComponentWrapper(BEIComponentID::BlockWorld).GetComponent<BlockWorld>();}
-  BlockWorld&              GetBlockWorld()                      { return GetComponentWrapper(BEIComponentID::BlockWorld).GetComponent<BlockWorld>();}
-  const BehaviorContainer& GetBehaviorContainer()         const { return GetComponentWrapper(BEIComponentID::BehaviorContainer).GetComponent<BehaviorContainer>();}
-  BehaviorEventComponent&  GetBehaviorEventComponent()    const { return GetComponentWrapper(BEIComponentID::BehaviorEvent).GetComponent<BehaviorEventComponent>();}
-  BehaviorTimerManager&    GetBehaviorTimerManager()      const { return GetComponentWrapper(BEIComponentID::BehaviorTimerManager).GetComponent<BehaviorTimerManager>(); }
+  const BlockWorld&        GetBlockWorld()                const { return Deref(_blockWorld);}
+  BlockWorld&              GetBlockWorld()                      { return Deref(_blockWorld);}
+  const BehaviorContainer& GetBehaviorContainer()         const { return Deref(_behaviorContainer);}
+  BehaviorEventComponent&  GetBehaviorEventComponent()    const { return Deref(_behaviorEventComponent);}
+  BehaviorTimerManager&    GetBehaviorTimerManager()      const { return Deref(_behaviorTimers); }
 
   // Give behaviors/activities access to information about robot
-  BEIRobotInfo& GetRobotInfo() { return GetComponentWrapper(BEIComponentID::RobotInfo).GetComponent<BEIRobotInfo>();}
-  const BEIRobotInfo& GetRobotInfo() const { return GetComponentWrapper(BEIComponentID::RobotInfo).GetComponent<BEIRobotInfo>();}
+  BEIRobotInfo& GetRobotInfo() { return Deref(_robotInfo);}
+  const BEIRobotInfo& GetRobotInfo() const { return Deref(_robotInfo);}
 
   // Access components which may or may not exist - you must call
   // has before get or you may hit a nullptr assert
@@ -289,6 +295,12 @@ public:
   Util::RandomGenerator& GetRNG();
 
 private:
+  template<typename T>
+  static T& Deref(T* component) {
+    DEV_ASSERT(component != nullptr, "BehaviorExternalInterface.Deref.NullComponent");
+    return *component;
+  }
+
   struct CompArrayWrapper{
     public:
       CompArrayWrapper(AIComponent*                   aiComponent,
@@ -334,6 +346,17 @@ private:
       EntityFullEnumeration<BEIComponentID, BEIComponentWrapper, BEIComponentID::Count> _array;
   };
   std::unique_ptr<CompArrayWrapper> _arrayWrapper;
+  
+  // filled in by Init, pointing into _arrayWrapper
+  std::array<const BEIComponentWrapper*, static_cast<size_t>(BEIComponentID::Count)> _wrappers{};
+  
+  AIComponent*            _aiComponent = nullptr;
+  BehaviorContainer*      _behaviorContainer = nullptr;
+  BehaviorEventComponent* _behaviorEventComponent = nullptr;
+  BehaviorTimerManager*   _behaviorTimers = nullptr;
+  BlockWorld*             _blockWorld = nullptr;
+  FaceWorld*              _faceWorld = nullptr;
+  BEIRobotInfo*           _robotInfo = nullptr;
 };
 
 } // namespace Vector
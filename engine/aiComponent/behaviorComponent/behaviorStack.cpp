@@ -22,6 +22,7 @@
 #include "engine/aiComponent/behaviorComponent/stackMonitors/stackCycleMonitor.h"
 #include "engine/aiComponent/behaviorComponent/stackMonitors/stackVizMonitor.h"
 #include "engine/externalInterface/externalInterface.h"
+#include "util/cpuProfiler/cpuProfiler.h"
 #include "util/helpers/boundedWhile.h"
 #include "util/logging/logging.h"
 
@@ -126,6 +127,8 @@ void BehaviorStack::UpdateBehaviorStack(BehaviorExternalInterface& behaviorExter
     LOG_WARNING("BehaviorSystemManager.BehaviorStack.UpdateBehaviorStack.NoStackInitialized", "");
     return;
   }
+  
+  ANKI_CPU_PROFILE("BehaviorStack::UpdateBehaviorStack");
 
   // The stack can be altered during update ticks through the cancel delegation
   // functions - so track the index in the stack rather than the iterator directly
@@ -23,8 +23,10 @@
 #include "engine/aiComponent/behaviorComponent/behaviorExternalInterface/delegationComponent.h"
 #include "engine/aiComponent/behaviorComponent/behaviors/iCozmoBehavior.h"
 #include "engine/aiComponent/behaviorComponent/behaviorStack.h"
+#include "engine/aiComponent/behaviorComponent/behaviorTickProfiler.h"
 #include "engine/aiComponent/behaviorComponent/behaviorTypesWrapper.h"
 #include "engine/aiComponent/behaviorComponent/iBehavior.h"
+#include "engine/aiComponent/beiConditions/beiConditionFactory.h"
 #include "engine/externalInterface/externalInterface.h"
 #include "engine/robot.h"
 #include "engine/viz/vizManager.h"
@@ -160,6 +162,11 @@ void BehaviorSystemManager::UpdateDependent(const BCCompMap& dependentComps)
     _baseBehaviorTmp = nullptr;
   }
 
+  // Conditions built from the same config share their results while behaviors update
+  BEIConditionResultSharingScope conditionResultSharingScope;
+  
+  BehaviorTickProfiler::ScopedTick profilerTick(bei);
+
   auto & delegationComponent = bei.GetDelegationComponent();
   for (const auto& completionMsg : _actionsCompletedThisTick) {
     delegationComponent.HandleActionComplete(completionMsg.idTag);
@@ -186,6 +193,8 @@ void BehaviorSystemManager::UpdateDependent(const BCCompMap& dependentComps)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void BehaviorSystemManager::UpdateInActivatableScope(BehaviorExternalInterface& behaviorExternalInterface, const std::set<IBehavior*>& tickedInStack)
 {
+  ANKI_CPU_PROFILE("BehaviorSystemManager::UpdateInActivatableScope");
+  
   // This is inefficient and should be replaced, but not overengineering right now
   const auto& allInActivatableScope = _behaviorStack->GetBehaviorsInActivatableScope();
 
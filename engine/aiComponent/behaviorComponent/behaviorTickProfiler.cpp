@@ -0,0 +1,220 @@
+/**
+ * File: behaviorTickProfiler.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Attributes behavior system tick time to behaviors and conditions (see header)
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "engine/aiComponent/behaviorComponent/behaviorTickProfiler.h"
+
+#include "coretech/common/engine/utils/timer.h"
+#include "engine/aiComponent/behaviorComponent/behaviorExternalInterface/behaviorExternalInterface.h"
+#include "engine/aiComponent/behaviorComponent/behaviorExternalInterface/beiRobotInfo.h"
+#include "engine/aiComponent/behaviorComponent/iBehavior.h"
+#include "engine/aiComponent/beiConditions/iBEICondition.h"
+#include "engine/cozmoContext.h"
+#include "util/console/consoleInterface.h"
+#include "util/logging/logging.h"
+#include "webServerProcess/src/webService.h"
+
+#include "json/json.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define LOG_CHANNEL "BehaviorSystem"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  #define CONSOLE_GROUP "BehaviorSystem.TickProfiler"
+  // length of each profiling window, 0 = off
+  CONSOLE_VAR(float, kBehaviorTickProfilerWindow_s, CONSOLE_GROUP, 0.0f);
+  // entries sent to webViz per window, and how many of those are also logged
+  CONSOLE_VAR(u32, kBehaviorTickProfilerMaxEntries, CONSOLE_GROUP, 30);
+  CONSOLE_VAR(u32, kBehaviorTickProfilerNumLogged, CONSOLE_GROUP, 5);
+
+  const char* kWebVizModuleName = "behaviorprofile";
+
+  using Clock = std::chrono::steady_clock;
+
+  struct Entry {
+    std::string label;
+    BehaviorTickProfiler::SampleType type = BehaviorTickProfiler::SampleType::Update;
+    uint32_t count = 0;
+    int64_t  total_us = 0;
+    int64_t  self_us = 0;
+    int64_t  max_us = 0;
+  };
+
+  // Keyed by object address plus sample type. Behaviors and conditions have vtables, so their addresses are aligned
+  // well past the few low bits the type takes.
+  std::unordered_map<uintptr_t, Entry> sEntries;
+
+  float    sWindowStart_s = -1.0f;
+  uint32_t sNumTicks = 0;
+  int64_t  sTickTime_us = 0;
+  int64_t  sMaxTickTime_us = 0;
+
+  int64_t ElapsedMicroseconds(const Clock::time_point& start)
+  {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+  }
+
+  const char* SampleTypeToString(BehaviorTickProfiler::SampleType type)
+  {
+    switch( type ) {
+      case BehaviorTickProfiler::SampleType::Update:             return "update";
+      case BehaviorTickProfiler::SampleType::WantsToBeActivated: return "wantsToBeActivated";
+      case BehaviorTickProfiler::SampleType::Condition:          return "condition";
+    }
+    return "unknown";
+  }
+
+  void ResetWindow(float currTime_s)
+  {
+    sEntries.clear();
+    sWindowStart_s = currTime_s;
+    sNumTicks = 0;
+    sTickTime_us = 0;
+    sMaxTickTime_us = 0;
+  }
+
+  void PublishWindow(BehaviorExternalInterface& bei, float windowDuration_s)
+  {
+    std::vector<const Entry*> sorted;
+    sorted.reserve(sEntries.size());
+    for( const auto& keyEntryPair : sEntries ) {
+      sorted.push_back(&keyEntryPair.second);
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const Entry* a, const Entry* b) { return a->self_us > b->self_us; });
+    if( sorted.size() > kBehaviorTickProfilerMaxEntries ) {
+      sorted.resize(kBehaviorTickProfilerMaxEntries);
+    }
+
+    const float tickTime_ms = 0.001f * sTickTime_us;
+    Json::Value window;
+    window["window_s"] = windowDuration_s;
+    window["ticks"] = sNumTicks;
+    window["tickTime_ms"] = tickTime_ms;
+    window["maxTickTime_ms"] = 0.001f * sMaxTickTime_us;
+    Json::Value& entries = window["entries"];
+    entries = Json::Value(Json::arrayValue);
+    for( const auto* entry : sorted ) {
+      Json::Value entryJson;
+      entryJson["label"] = entry->label;
+      entryJson["type"] = SampleTypeToString(entry->type);
+      entryJson["count"] = entry->count;
+      entryJson["self_ms"] = 0.001f * entry->self_us;
+      entryJson["total_ms"] = 0.001f * entry->total_us;
+      entryJson["max_ms"] = 0.001f * entry->max_us;
+      entries.append(entryJson);
+    }
+
+    LOG_INFO("BehaviorTickProfiler.Window",
+             "%u ticks in %.1fs took %.2fms (max %.2fms per tick)",
+             sNumTicks, windowDuration_s, tickTime_ms, 0.001f * sMaxTickTime_us);
+    const size_t numLogged = std::min(sorted.size(), (size_t)kBehaviorTickProfilerNumLogged);
+    for( size_t i = 0; i < numLogged; ++i ) {
+      const Entry& entry = *sorted[i];
+      LOG_INFO("BehaviorTickProfiler.TopEntry",
+               "%s %s: %.2fms self (%.2fms total) over %u calls",
+               entry.label.c_str(),
+               SampleTypeToString(entry.type),
+               0.001f * entry.self_us,
+               0.001f * entry.total_us,
+               entry.count);
+    }
+
+    const auto* context = bei.GetRobotInfo().GetContext();
+    const auto* webService = (context != nullptr) ? context->GetWebService() : nullptr;
+    if( (webService != nullptr) && webService->IsWebVizClientSubscribed(kWebVizModuleName) ) {
+      webService->SendToWebViz(kWebVizModuleName, window);
+    }
+  }
+}
+
+bool BehaviorTickProfiler::sEnabled = false;
+BehaviorTickProfiler::ScopedSample* BehaviorTickProfiler::sCurrentSample = nullptr;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BehaviorTickProfiler::ScopedSample::Start(const void* object, SampleType type)
+{
+  _object = object;
+  _type = type;
+  _parent = sCurrentSample;
+  sCurrentSample = this;
+  _start = Clock::now();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BehaviorTickProfiler::ScopedSample::Stop()
+{
+  const int64_t elapsed_us = ElapsedMicroseconds(_start);
+
+  const uintptr_t key = reinterpret_cast<uintptr_t>(_object) + static_cast<uintptr_t>(_type);
+  Entry& entry = sEntries[key];
+  if( entry.count == 0 ) {
+    entry.type = _type;
+    if( _type == SampleType::Condition ) {
+      const auto* condition = static_cast<const IBEICondition*>(_object);
+      entry.label = condition->GetOwnerDebugLabel() + "/" + condition->GetDebugLabel();
+    } else {
+      entry.label = static_cast<const IBehavior*>(_object)->GetDebugLabel();
+    }
+  }
+  ++entry.count;
+  entry.total_us += elapsed_us;
+  entry.self_us += std::max(elapsed_us - _childTime_us, (int64_t)0);
+  entry.max_us = std::max(entry.max_us, elapsed_us);
+
+  if( _parent != nullptr ) {
+    _parent->_childTime_us += elapsed_us;
+  }
+  sCurrentSample = _parent;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BehaviorTickProfiler::ScopedTick::ScopedTick(BehaviorExternalInterface& bei)
+: _bei(bei)
+, _start(Clock::now())
+{
+  const bool enabled = (kBehaviorTickProfilerWindow_s > 0.0f);
+  if( enabled != sEnabled ) {
+    // start from a clean window either way
+    ResetWindow(-1.0f);
+    sEnabled = enabled;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BehaviorTickProfiler::ScopedTick::~ScopedTick()
+{
+  if( !sEnabled ) {
+    return;
+  }
+
+  const int64_t elapsed_us = ElapsedMicroseconds(_start);
+  ++sNumTicks;
+  sTickTime_us += elapsed_us;
+  sMaxTickTime_us = std::max(sMaxTickTime_us, elapsed_us);
+
+  const float currTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+  if( sWindowStart_s < 0.0f ) {
+    sWindowStart_s = currTime_s;
+  } else if( currTime_s - sWindowStart_s >= kBehaviorTickProfilerWindow_s ) {
+    PublishWindow(_bei, currTime_s - sWindowStart_s);
+    ResetWindow(currTime_s);
+  }
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,100 @@
+/**
+ * File: behaviorTickProfiler.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Attributes the time of each behavior system tick to the behaviors' Update and WantsToBeActivated
+ *              calls and to each condition evaluation, across everything in activatable scope (not only the stack).
+ *
+ *              Off unless the console var BehaviorSystem.TickProfiler.kBehaviorTickProfilerWindow_s is set. Then,
+ *              once per window, the entries with the most self time (time not spent in nested samples, e.g. a
+ *              dispatcher's own work minus its children's WantsToBeActivated) are logged and sent to webViz.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Engine_AiComponent_BehaviorComponent_BehaviorTickProfiler_H__
+#define __Engine_AiComponent_BehaviorComponent_BehaviorTickProfiler_H__
+
+#include <chrono>
+#include <stdint.h>
+
+namespace Anki {
+namespace Vector {
+
+class BehaviorExternalInterface;
+class IBehavior;
+class IBEICondition;
+
+class BehaviorTickProfiler
+{
+public:
+
+  enum class SampleType : uint8_t {
+    Update = 0,
+    WantsToBeActivated,
+    Condition
+  };
+
+  // Times its scope and adds it to the entry for a behavior call or a condition evaluation. Does nothing unless the
+  // profiler is enabled. Samples nest, and a sample's self time excludes the samples nested in it.
+  class ScopedSample
+  {
+  public:
+    ScopedSample(const IBehavior& behavior, SampleType type)
+    {
+      if( sEnabled ) {
+        Start(&behavior, type);
+      }
+    }
+
+    explicit ScopedSample(const IBEICondition& condition)
+    {
+      if( sEnabled ) {
+        Start(&condition, SampleType::Condition);
+      }
+    }
+
+    ~ScopedSample()
+    {
+      if( _object != nullptr ) {
+        Stop();
+      }
+    }
+
+  private:
+    void Start(const void* object, SampleType type);
+    void Stop();
+
+    const void* _object = nullptr;
+    SampleType _type = SampleType::Update;
+    ScopedSample* _parent = nullptr;
+    std::chrono::steady_clock::time_point _start;
+    int64_t _childTime_us = 0;
+  };
+
+  // Times one behavior system tick. Checks whether the profiler is enabled, and publishes and resets the window once
+  // it has elapsed.
+  class ScopedTick
+  {
+  public:
+    explicit ScopedTick(BehaviorExternalInterface& bei);
+    ~ScopedTick();
+
+  private:
+    BehaviorExternalInterface& _bei;
+    std::chrono::steady_clock::time_point _start;
+  };
+
+private:
+
+  static bool sEnabled;
+  static ScopedSample* sCurrentSample;
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Engine_AiComponent_BehaviorComponent_BehaviorTickProfiler_H__
@@ -164,32 +164,19 @@ void BehaviorReactToBody::OnBehaviorActivated()
   }
 
   auto& component = GetAIComp<SalientPointsComponent>();
-  std::list<Vision::SalientPoint> latestPersons;
 
-  //Get all the latest persons
-  component.GetSalientPointSinceTime(latestPersons, Vision::SalientPointType::Person,
-                                     _dVars.persistent.lastSeenTimeStamp);
+  // Select the best one: the latest one, or the biggest if tie
+  const Vision::SalientPoint* latestPerson = component.GetLatestSalientPoint(Vision::SalientPointType::Person,
+                                                                             _dVars.persistent.lastSeenTimeStamp);
 
-  if (latestPersons.empty()) {
+  if (latestPerson == nullptr) {
     LOG_DEBUG( "BehaviorReactToPersonDetected.OnBehaviorActivated.NoPersonDetected",
         "Activated but no person with a timestamp > %u", (TimeStamp_t)_dVars.persistent.lastSeenTimeStamp);
     TransitionToCompleted();
     return;
   }
 
-  // Select the best one
-  // Choose the latest one, or the biggest if tie
-  auto maxElementIter = std::max_element(latestPersons.begin(), latestPersons.end(),
-                                         [](const Vision::SalientPoint& p1, const Vision::SalientPoint& p2) {
-                                           if (p1.timestamp == p2.timestamp) {
-                                             return p1.area_fraction < p2.area_fraction;
-                                           }
-                                           else {
-                                             return  p1.timestamp < p2.timestamp;
-                                           }
-                                         }
-  );
-  _dVars.lastPersonDetected = *maxElementIter;
+  _dVars.lastPersonDetected = *latestPerson;
   _dVars.persistent.lastSeenTimeStamp = _dVars.lastPersonDetected.timestamp;
 
   DEV_ASSERT(_dVars.lastPersonDetected.salientType == Vision::SalientPointType::Person,
@@ -97,6 +97,9 @@ namespace {
   // number of samples before we give up trying to find a non-colliding pose. Note: the behavior will
   // end if no pose was found
   const unsigned int kNumSampleSteps = 50;
+  // candidate positions are sampled and run through the point conditions this many at a time, so each
+  // condition's setup is shared by the batch. Sampling stops after the batch that finds enough poses
+  const unsigned int kSampleBatchSize = 10;
   
   // number of poses to select that are offset from a prox obstacle by some nearby amount
   const unsigned int kNumProxPoses = 1;
@@ -763,21 +766,38 @@ void BehaviorExploring::SampleVisitLocationsOpenSpace( std::shared_ptr<const INa
   _iConfig.condHandleCollisions->SetMemoryMap( memoryMap );
   _iConfig.condHandleUnknowns->SetMemoryMap( memoryMap );
   
+  std::vector<Point2f> sampledPositions;
+  sampledPositions.reserve( kSampleBatchSize );
+  std::vector<bool> acceptedPoints;
+  
   for( unsigned int cnt=0; cnt<kNumSampleSteps; ++cnt ) {
     
-    // sample a point based on either the robot position or charger position
-    Point2f sampledPos = tooFarFromCharger ? chargerPosition : robotPos;
-    {
-      const Point2f pt = RobotPointSamplerHelper::SamplePointInAnnulus( GetRNG(), r1, r2 );
-      sampledPos.x() += pt.x();
-      sampledPos.y() += pt.y();
+    const unsigned int idxInBatch = cnt % kSampleBatchSize;
+    if( idxInBatch == 0 ) {
+      // sample points based on either the robot position or charger position
+      sampledPositions.clear();
+      const unsigned int batchSize = std::min( kSampleBatchSize, kNumSampleSteps - cnt );
+      for( unsigned int i=0; i<batchSize; ++i ) {
+        Point2f sampledPos = tooFarFromCharger ? chargerPosition : robotPos;
+        const Point2f pt = RobotPointSamplerHelper::SamplePointInAnnulus( GetRNG(), r1, r2 );
+        sampledPos.x() += pt.x();
+        sampledPos.y() += pt.y();
+        sampledPositions.push_back( sampledPos );
+      }
+      
+      const size_t numAccepted = _iConfig.openSpacePointEvaluator->EvaluateBatch( GetRNG(),
+                                                                                  sampledPositions,
+                                                                                  acceptedPoints );
+      if( numAccepted == 0 ) {
+        cnt += batchSize - 1;
+        continue;
+      }
     }
     
-    const bool acceptedPoint = _iConfig.openSpacePointEvaluator->Evaluate( GetRNG(), sampledPos );
-    
-    if( !acceptedPoint ) {
+    if( !acceptedPoints[idxInBatch] ) {
       continue;
     }
+    const Point2f& sampledPos = sampledPositions[idxInBatch];
     
     // choose a random angle about the Z axis to create a full test pose
     const float angle = M_TWO_PI * static_cast<float>( GetRNG().RandDbl() );
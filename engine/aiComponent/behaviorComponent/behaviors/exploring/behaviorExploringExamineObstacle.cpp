@@ -233,12 +233,9 @@ void BehaviorExploringExamineObstacle::TransitionToNextAction()
     _dVars.lastImageTime = GetBEI().GetVisionComponent().GetLastProcessedImageTimeStamp();
     WaitForImagesAction* action = new WaitForImagesAction(1, VisionMode::Hands, _dVars.lastImageTime);
     DelegateNow( action, [this]() {
-      std::list<Vision::SalientPoint> handsFound;
       const auto& salientPtsComponent = GetAIComp<SalientPointsComponent>();
-      salientPtsComponent.GetSalientPointSinceTime(handsFound,
-                                                   Vision::SalientPointType::Hand,
-                                                   _dVars.lastImageTime );
-      _dVars.handSeen = !handsFound.empty();
+      _dVars.handSeen = salientPtsComponent.SalientPointDetected(Vision::SalientPointType::Hand,
+                                                                 _dVars.lastImageTime);
       TransitionToNextAction();
     });
     return;
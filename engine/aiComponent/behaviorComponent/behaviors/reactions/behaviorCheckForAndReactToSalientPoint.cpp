@@ -307,9 +307,7 @@ void BehaviorCheckForAndReactToSalientPoint::CheckForStimulus()
   {
     if(_iConfig->HasCooldownPassed(currentTime_sec, reaction.second))
     {
-      std::list<Vision::SalientPoint> salientPoints;
-      salientPointsComp.GetSalientPointSinceTime(salientPoints, reaction.first, _dVars->_lastImageTime_ms);
-      if(!salientPoints.empty())
+      if(salientPointsComp.SalientPointDetected(reaction.first, _dVars->_lastImageTime_ms))
       {
         possibleReactions.emplace_back(reaction.first, &reaction.second);
       }
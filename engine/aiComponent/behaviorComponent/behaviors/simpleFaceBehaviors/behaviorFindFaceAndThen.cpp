@@ -602,27 +602,15 @@ bool BehaviorFindFaceAndThen::GetRecentBodySince( RobotTimeStamp_t sinceTime_ms,
     return false;
   }
   
+  // choose the most recent body, or the largest (big boned) if tied
   const auto& salientPtsComponent = GetAIComp<SalientPointsComponent>();
-  std::list<Vision::SalientPoint> bodiesFound;
-  salientPtsComponent.GetSalientPointSinceTime( bodiesFound,
-                                                Vision::SalientPointType::Person,
-                                                sinceTime_ms );
- 
-  if( bodiesFound.empty() ) {
+  const Vision::SalientPoint* latestBody = salientPtsComponent.GetLatestSalientPoint( Vision::SalientPointType::Person,
+                                                                                     sinceTime_ms );
+  if( latestBody == nullptr ) {
     return false;
   }
  
-  // choose the most recent body, or the largest (big boned) if tied
-  auto maxElementIter = std::max_element( bodiesFound.begin(),
-                                          bodiesFound.end(),
-                                          [](const Vision::SalientPoint& p1, const Vision::SalientPoint& p2) {
-                                            if( p1.timestamp == p2.timestamp ) {
-                                              return p1.area_fraction < p2.area_fraction;
-                                            } else {
-                                              return p1.timestamp < p2.timestamp;
-                                            }
-                                          } );
-  person = *maxElementIter;
+  person = *latestBody;
   return true;
 }
   
@@ -16,6 +16,7 @@
 #include "engine/aiComponent/behaviorComponent/behaviorComponent.h"
 #include "engine/aiComponent/behaviorComponent/behaviorExternalInterface/behaviorExternalInterface.h"
 #include "engine/aiComponent/behaviorComponent/behaviorExternalInterface/delegationComponent.h"
+#include "engine/aiComponent/behaviorComponent/behaviorTickProfiler.h"
 #include "engine/aiComponent/behaviorComponent/iBehavior.h"
 
 #include "util/console/consoleInterface.h"
@@ -95,6 +96,7 @@ void IBehavior::Update()
                 _lastTickOfUpdate);
   _lastTickOfUpdate = tickCount;
 
+  BehaviorTickProfiler::ScopedSample profilerSample(*this, BehaviorTickProfiler::SampleType::Update);
   UpdateInternal();
 }
 
@@ -114,6 +116,7 @@ bool IBehavior::WantsToBeActivated() const
 #endif
   _lastTickWantsToBeActivatedCheckedOn = BaseStationTimer::getInstance()->GetTickCount();
   auto accessGuard = GetBEI().GetComponentWrapper(BEIComponentID::Delegation).StripComponent();
+  BehaviorTickProfiler::ScopedSample profilerSample(*this, BehaviorTickProfiler::SampleType::WantsToBeActivated);
   return WantsToBeActivatedInternal();
 }
 
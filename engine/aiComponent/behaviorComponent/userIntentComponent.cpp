@@ -36,6 +36,7 @@
 
 #include "coretech/common/engine/jsonTools.h"
 #include "coretech/common/engine/utils/timer.h"
+#include "coretech/messaging/shared/bootStatus.h"
 
 #include "util/console/consoleInterface.h"
 #include "util/console/consoleFunction.h"
@@ -94,6 +95,9 @@ UserIntentComponent::UserIntentComponent(const Robot& robot, const Json::Value&
     const bool muteEdgeCase = twd.fromMute;
     SetTriggerWordPending(willStream, muteEdgeCase);
 
+    // Voice or a button press counts as interacting, which lets deferred startup work run
+    BootStatus::Publish(BootMilestone::FirstInteraction);
+
     HandleTriggerWordEventForDas(event.GetData().Get_triggerWordDetected());
   };
 
@@ -220,6 +224,7 @@ UserIntentPtr UserIntentComponent::ActivateUserIntent(UserIntentTag userIntent,
 
   _activeIntent = std::move(_pendingIntent);
   _activeIntent->activationID = ++sActivatedIntentID;
+  ++_intentsGeneration;
 
   // track the owner for easier debugging
   _activeIntentOwner = owner;
@@ -257,6 +262,7 @@ void UserIntentComponent::DeactivateUserIntent(UserIntentTag userIntent)
             _activeIntentOwner.c_str());
   _activeIntent.reset();
   _activeIntentOwner.clear();
+  ++_intentsGeneration;
 
 }
 
@@ -434,6 +440,7 @@ void UserIntentComponent::DropUserIntent(UserIntentTag userIntent)
 {
   if (IsUserIntentPending(userIntent)) {
     _pendingIntent.reset();
+    ++_intentsGeneration;
 
     // just in case we were told to transition, let's stop it as a new one is about to begin
     _activeIntentFeedback.StopTransitionIntoActive();
@@ -453,6 +460,7 @@ void UserIntentComponent::DropAnyUserIntent()
   }
 
   _pendingIntent.reset();
+  ++_intentsGeneration;
 
   // just in case we were told to transition, let's stop it as a new one is about to begin
   _activeIntentFeedback.StopTransitionIntoActive();
@@ -467,6 +475,22 @@ bool UserIntentComponent::IsUserIntentPending(UserIntentTag userIntent, UserInte
   return false;
 }
 
+const UserIntent* UserIntentComponent::GetPendingUserIntentIfAnyOf(const UserIntentTagMask& tags) const
+{
+  if( (_pendingIntent != nullptr) && tags.test(static_cast<size_t>(_pendingIntent->intent.GetTag())) ) {
+    return &_pendingIntent->intent;
+  }
+  return nullptr;
+}
+
+const UserIntent* UserIntentComponent::GetActiveUserIntentIfAnyOf(const UserIntentTagMask& tags) const
+{
+  if( (_activeIntent != nullptr) && tags.test(static_cast<size_t>(_activeIntent->intent.GetTag())) ) {
+    return &_activeIntent->intent;
+  }
+  return nullptr;
+}
+
 void UserIntentComponent::SetUserIntentPending(UserIntentTag userIntent, const UserIntentSource& source)
 {
   // The following ensures that this method is only called for intents of type UserIntent_Void.
@@ -503,6 +527,7 @@ void UserIntentComponent::SetUserIntentPending(UserIntent&& userIntent, const Us
     _pendingIntent->intent = std::move(userIntent);
     _pendingIntent->source = source;
   }
+  ++_intentsGeneration;
 
   if (ANKI_DEV_CHEATS) {
     SendWebVizIntents();
@@ -160,6 +160,11 @@ public:
   // Same as above, but also get data
   bool IsUserIntentPending(UserIntentTag userIntent, UserIntent& extraData) const;
 
+  // Returns the pending (or active) intent if its tag is in the mask (see UserIntentTagMask), otherwise nullptr. This is a single bit
+  // test regardless of how many tags the mask holds, and doesn't copy the intent data
+  const UserIntent* GetPendingUserIntentIfAnyOf(const UserIntentTagMask& tags) const;
+  const UserIntent* GetActiveUserIntentIfAnyOf(const UserIntentTagMask& tags) const;
+
   // Activate the pending user intent. Owner string is stored for debugging because you are responsible to
   // deactivate the intent if you call this function directly. If the given userIntent is pending, this will
   // move it from pending to active (it will no longer be pending) and return a pointer to the full intent
@@ -198,6 +203,9 @@ public:
   // You really really really shouldn't use this. You should almost always be able to check against
   // a specific intent, or GetActiveUserIntent(). 
   const UserIntentData* /* DONT USE THIS */ GetPendingUserIntent() const { return _pendingIntent.get(); }
+  
+  // Incremented whenever the pending or active intent changes
+  size_t GetIntentsGeneration() const { return _intentsGeneration; }
 
   // A helper function to drop a user intent without responding to it. This is meant to be called for a
   // pending user intent and will make it no longer pending without ever making it active. This is generally
@@ -306,6 +314,7 @@ private:
   std::unique_ptr<UserIntentData> _pendingIntent;
   std::shared_ptr<UserIntentData> _activeIntent;
   std::string _activeIntentOwner;
+  size_t _intentsGeneration = 0;
 
   // super lightweight class for tracking the "active user state" which is how we display to the user that Vector
   // is actively responding to their voice intent
@@ -21,6 +21,7 @@
 #include "util/featureGate/featureGate.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
 #include <unordered_set>
 
 namespace Anki {
@@ -50,6 +51,10 @@ UserIntentMap::UserIntentMap(const Json::Value& config, const CozmoContext* ctx)
   std::unordered_set<UserIntentTag> foundUserIntent;
   std::unordered_set<UserIntentTag> gatedUserIntent;
   
+  // collected here, then compiled into the lookup tables
+  MapType cloudToUserMap;
+  MapType appToUserMap;
+  
   ANKI_VERIFY(config[kUserIntentMapKey].size() > 0,
               "UserIntentMap.InvalidConfig",
               "expected to find group '%s'",
@@ -143,8 +148,8 @@ UserIntentMap::UserIntentMap(const Json::Value& config, const CozmoContext* ctx)
       }
     };
     
-    processMapping( mapping, _cloudToUserMap, kCloudIntentKey, kCloudVariableSubstitutionsKey, kCloudVariableNumericsKey, kTestUserIntentParsingKey, "cloud" );
-    processMapping( mapping, _appToUserMap, kAppIntentKey, kAppVariableSubstitutionsKey, kAppVariableNumericsKey, kTestUserIntentParsingKey, "app" );
+    processMapping( mapping, cloudToUserMap, kCloudIntentKey, kCloudVariableSubstitutionsKey, kCloudVariableNumericsKey, kTestUserIntentParsingKey, "cloud" );
+    processMapping( mapping, appToUserMap, kAppIntentKey, kAppVariableSubstitutionsKey, kAppVariableNumericsKey, kTestUserIntentParsingKey, "app" );
     
     if( ANKI_DEVELOPER_CODE ) {
       // prevent typos
@@ -170,6 +175,9 @@ UserIntentMap::UserIntentMap(const Json::Value& config, const CozmoContext* ctx)
     }
   }
 
+  _cloudToUserMap.Build( std::move(cloudToUserMap) );
+  _appToUserMap.Build( std::move(appToUserMap) );
+
   std::string unmatchedString = JsonTools::ParseString(config, kUnmatchedKey, kDebugName);
   ANKI_VERIFY( UserIntentTagFromString(unmatchedString, _unmatchedUserIntent),
                "UserIntentMap.Ctor.InvalidUnmatchedIntent",
@@ -201,10 +209,10 @@ UserIntentMap::UserIntentMap(const Json::Value& config, const CozmoContext* ctx)
 UserIntentTag UserIntentMap::GetUserIntentFromCloudIntent(const std::string& cloudIntent) const
 {
   using Tag = std::underlying_type<UserIntentTag>::type;
-  auto it = _cloudToUserMap.find(cloudIntent);
-  if( it != _cloudToUserMap.end() ) {
-    DEV_ASSERT( static_cast<Tag>( it->second.userIntent ) < static_cast<Tag>( USER_INTENT(INVALID) ), "Invalid intent value" );
-    return it->second.userIntent;
+  const IntentInfo* info = _cloudToUserMap.Find(cloudIntent);
+  if( info != nullptr ) {
+    DEV_ASSERT( static_cast<Tag>( info->userIntent ) < static_cast<Tag>( USER_INTENT(INVALID) ), "Invalid intent value" );
+    return info->userIntent;
   }
   else {
     DEV_ASSERT( static_cast<Tag>(_unmatchedUserIntent) < static_cast<Tag>(USER_INTENT(INVALID)), "Invalid intent value" );
@@ -218,15 +226,15 @@ UserIntentTag UserIntentMap::GetUserIntentFromCloudIntent(const std::string& clo
 
 bool UserIntentMap::IsValidCloudIntent(const std::string& cloudIntent) const
 {
-  const bool found = ( _cloudToUserMap.find(cloudIntent) != _cloudToUserMap.end() );
+  const bool found = ( _cloudToUserMap.Find(cloudIntent) != nullptr );
   return found;
 }
 
 bool UserIntentMap::GetTestParsingBoolFromCloudIntent(const std::string& cloudIntent) const
 {
-  auto it = _cloudToUserMap.find(cloudIntent);
-  if( it != _cloudToUserMap.end() ) {
-    return it->second.testParsing;
+  const IntentInfo* info = _cloudToUserMap.Find(cloudIntent);
+  if( info != nullptr ) {
+    return info->testParsing;
   }
   else {
     PRINT_NAMED_WARNING("UserIntentMap.NoCloudIntentMatch",
@@ -239,10 +247,10 @@ bool UserIntentMap::GetTestParsingBoolFromCloudIntent(const std::string& cloudIn
 UserIntentTag UserIntentMap::GetUserIntentFromAppIntent(const std::string& appIntent) const
 {
   using Tag = std::underlying_type<UserIntentTag>::type;
-  auto it = _appToUserMap.find(appIntent);
-  if( it != _appToUserMap.end() ) {
-    DEV_ASSERT( static_cast<Tag>( it->second.userIntent ) < static_cast<Tag>( USER_INTENT(INVALID) ), "Invalid intent value" );
-    return it->second.userIntent;
+  const IntentInfo* info = _appToUserMap.Find(appIntent);
+  if( info != nullptr ) {
+    DEV_ASSERT( static_cast<Tag>( info->userIntent ) < static_cast<Tag>( USER_INTENT(INVALID) ), "Invalid intent value" );
+    return info->userIntent;
   }
   else {
     DEV_ASSERT( static_cast<Tag>(_unmatchedUserIntent) < static_cast<Tag>(USER_INTENT(INVALID)), "Invalid intent value" );
@@ -256,7 +264,7 @@ UserIntentTag UserIntentMap::GetUserIntentFromAppIntent(const std::string& appIn
   
 bool UserIntentMap::IsValidAppIntent(const std::string& appIntent) const
 {
-  const bool found = ( _appToUserMap.find(appIntent) != _appToUserMap.end() );
+  const bool found = ( _appToUserMap.Find(appIntent) != nullptr );
   return found;
 }
 
@@ -271,13 +279,13 @@ void UserIntentMap::SanitizeAppIntentVariables(const std::string& appIntent, Jso
 }
   
 void UserIntentMap::SanitizeVariables(const std::string& intent,
-                                      const MapType& container,
+                                      const IntentTable& container,
                                       const char* debugName,
                                       Json::Value& paramsList) const
 {
-  const auto it = container.find( intent );
-  if( it != container.end() ) {
-    const auto& subs = it->second.varSubstitutions;
+  const IntentInfo* info = container.Find( intent );
+  if( info != nullptr ) {
+    const auto& subs = info->varSubstitutions;
     for( const auto& varName : paramsList.getMemberNames() ) {
       const auto* varNameP = &varName;
       const auto it = std::find_if( subs.begin(), subs.end(), [&varName](const auto& p) {
@@ -332,24 +340,145 @@ void UserIntentMap::SanitizeVariables(const std::string& intent,
   
 std::vector<std::string> UserIntentMap::DevGetCloudIntentsList() const
 {
-  std::vector<std::string> ret;
-  ret.reserve( _cloudToUserMap.size() );
-  for( const auto& pair : _cloudToUserMap ) {
-    ret.push_back( pair.first );
-  }
-  return ret;
+  return _cloudToUserMap.GetNames();
 }
 
 std::vector<std::string> UserIntentMap::DevGetAppIntentsList() const
+{
+  return _appToUserMap.GetNames();
+}
+
+void UserIntentMap::IntentTable::Build(MapType&& intents)
+{
+  _displacements.clear();
+  _slots.clear();
+  if( intents.empty() ) {
+    return;
+  }
+  
+  std::vector<MapType::value_type*> entries;
+  entries.reserve( intents.size() );
+  for( auto& entry : intents ) {
+    entries.push_back( &entry );
+  }
+  
+  // a slot per intent is nearly always enough. If some bucket can't be placed, try again with more room
+  size_t numSlots = entries.size();
+  while( !TryBuild(entries, numSlots) ) {
+    numSlots *= 2;
+  }
+}
+
+bool UserIntentMap::IntentTable::TryBuild(const std::vector<MapType::value_type*>& intents, size_t numSlots)
+{
+  // give up on a bucket after this many seeds, since the table is too full for it
+  static const uint32_t kMaxSeed = 100000;
+  
+  const size_t numBuckets = intents.size();
+  std::vector<std::vector<size_t>> buckets( numBuckets );
+  for( size_t i = 0; i < intents.size(); ++i ) {
+    buckets[ Hash(intents[i]->first, 0) % numBuckets ].push_back( i );
+  }
+  
+  // place the biggest buckets first, while there are still many free slots
+  std::vector<size_t> bucketOrder( numBuckets );
+  for( size_t i = 0; i < numBuckets; ++i ) {
+    bucketOrder[i] = i;
+  }
+  std::stable_sort( bucketOrder.begin(), bucketOrder.end(), [&buckets](size_t a, size_t b) {
+    return buckets[a].size() > buckets[b].size();
+  });
+  
+  std::vector<int32_t> displacements( numBuckets, 0 );
+  std::vector<size_t> slotForIntent( intents.size() );
+  std::vector<bool> slotUsed( numSlots, false );
+  size_t nextFreeSlot = 0;
+  
+  for( const size_t bucketIdx : bucketOrder ) {
+    const auto& bucket = buckets[bucketIdx];
+    if( bucket.size() == 1 ) {
+      // no seed needed, point straight at any free slot
+      while( slotUsed[nextFreeSlot] ) {
+        ++nextFreeSlot;
+      }
+      slotUsed[nextFreeSlot] = true;
+      slotForIntent[bucket.front()] = nextFreeSlot;
+      displacements[bucketIdx] = -static_cast<int32_t>(nextFreeSlot) - 1;
+    }
+    else if( bucket.size() > 1 ) {
+      std::vector<size_t> bucketSlots;
+      uint32_t seed = 1;
+      for( ; seed < kMaxSeed; ++seed ) {
+        bucketSlots.clear();
+        for( const size_t intentIdx : bucket ) {
+          const size_t slot = Hash(intents[intentIdx]->first, seed) % numSlots;
+          if( slotUsed[slot] || (std::find(bucketSlots.begin(), bucketSlots.end(), slot) != bucketSlots.end()) ) {
+            break;
+          }
+          bucketSlots.push_back( slot );
+        }
+        if( bucketSlots.size() == bucket.size() ) {
+          break;
+        }
+      }
+      if( seed >= kMaxSeed ) {
+        return false;
+      }
+      for( size_t i = 0; i < bucket.size(); ++i ) {
+        slotUsed[bucketSlots[i]] = true;
+        slotForIntent[bucket[i]] = bucketSlots[i];
+      }
+      displacements[bucketIdx] = static_cast<int32_t>(seed);
+    }
+  }
+  
+  _displacements = std::move( displacements );
+  _slots.assign( numSlots, std::pair<std::string, IntentInfo>{} );
+  for( size_t i = 0; i < intents.size(); ++i ) {
+    _slots[slotForIntent[i]] = std::move( *intents[i] );
+  }
+  return true;
+}
+
+const UserIntentMap::IntentInfo* UserIntentMap::IntentTable::Find(const std::string& intent) const
+{
+  // intents with empty names are never added, so unused slots can't match
+  if( _slots.empty() || intent.empty() ) {
+    return nullptr;
+  }
+  
+  const int32_t displacement = _displacements[ Hash(intent, 0) % _displacements.size() ];
+  const size_t slot = (displacement < 0) ? static_cast<size_t>(-displacement - 1)
+                                         : Hash(intent, static_cast<uint32_t>(displacement)) % _slots.size();
+  const auto& entry = _slots[slot];
+  return (entry.first == intent) ? &entry.second : nullptr;
+}
+
+std::vector<std::string> UserIntentMap::IntentTable::GetNames() const
 {
   std::vector<std::string> ret;
-  ret.reserve( _appToUserMap.size() );
-  for( const auto& pair : _appToUserMap ) {
-    ret.push_back( pair.first );
+  ret.reserve( _slots.size() );
+  for( const auto& entry : _slots ) {
+    if( !entry.first.empty() ) {
+      ret.push_back( entry.first );
+    }
   }
+  // same (sorted) order as before these were hashed
+  std::sort( ret.begin(), ret.end() );
   return ret;
 }
 
+uint32_t UserIntentMap::IntentTable::Hash(const std::string& str, uint32_t seed)
+{
+  // FNV-1a, with the seed folded into the offset basis
+  uint32_t hash = 2166136261u ^ (seed * 0x9E3779B9u);
+  for( const char c : str ) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
   
 }
 }
@@ -21,7 +21,9 @@
 
 #include <map>
 #include <set>
+#include <stdint.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Anki {
@@ -78,13 +80,35 @@ private:
   
   using MapType = std::map<std::string, IntentInfo>;
   
-  MapType _cloudToUserMap;
-  MapType _appToUserMap;
+  // Intent names compiled at load time into a minimal perfect hash (hash and displace): the name's hash picks a
+  // bucket, the bucket's displacement picks the only slot the name can be in, and one string compare confirms it
+  class IntentTable
+  {
+  public:
+    void Build(MapType&& intents);
+    
+    // returns nullptr if the intent isn't in the table
+    const IntentInfo* Find(const std::string& intent) const;
+    
+    std::vector<std::string> GetNames() const;
+    
+  private:
+    static uint32_t Hash(const std::string& str, uint32_t seed);
+    bool TryBuild(const std::vector<MapType::value_type*>& intents, size_t numSlots);
+    
+    // one bucket per intent. Negative values are -(slot+1) for buckets holding a single intent, otherwise the seed
+    // that places every intent in the bucket in a free slot
+    std::vector<int32_t> _displacements;
+    std::vector<std::pair<std::string, IntentInfo>> _slots; // unused slots have an empty name
+  };
+  
+  IntentTable _cloudToUserMap;
+  IntentTable _appToUserMap;
 
   UserIntentTag _unmatchedUserIntent;
   
   void SanitizeVariables(const std::string& intent,
-                         const MapType& container,
+                         const IntentTable& container,
                          const char* debugName,
                          Json::Value& paramsList) const;
 };
@@ -18,6 +18,7 @@
 
 #include "util/global/globalDefinitions.h"
 
+#include <bitset>
 #include <cstdint>
 #include <string>
 
@@ -60,6 +61,9 @@ bool IsValidUserIntentTag(const std::string& name);
 bool IsValidUserIntentTag(UserIntentTag intent);
   
 UserIntentTag GetUserIntentTag(const UserIntent& intent);
+
+// A set of user intent tags (UserIntentTag is a uint8_t), for callers that check the same tags every tick
+using UserIntentTagMask = std::bitset<256>;
   
 } // Cozmo
 } // Anki
@@ -74,6 +74,8 @@
 
 #include "clad/types/behaviorComponent/beiConditionTypes.h"
 
+#include "json/json.h"
+
 #include "util/console/consoleInterface.h"
 #include "util/logging/logging.h"
 
@@ -87,9 +89,20 @@ namespace {
   #define CONSOLE_GROUP "Behaviors.ConditionFactory"
   CONSOLE_VAR(bool, kDebugConditionFactory, CONSOLE_GROUP, false);
 
+#if REMOTE_CONSOLE_ENABLED
+  void LogSharedConditionResults(ConsoleFunctionContextRef context)
+  {
+    BEIConditionFactory::LogSharedResultStats();
+  }
+  CONSOLE_FUNC(LogSharedConditionResults, CONSOLE_GROUP);
+#endif
+
 }
 
 std::map< std::string, IBEIConditionPtr > BEIConditionFactory::_customConditionMap;
+std::unordered_map< std::string, std::weak_ptr<BEIConditionSharedResult> > BEIConditionFactory::_sharedResults;
+size_t BEIConditionFactory::_resultSharingScopeID = 0;
+bool BEIConditionFactory::_isResultSharingScopeActive = false;
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -524,10 +537,89 @@ IBEIConditionPtr BEIConditionFactory::CreateBEICondition(const Json::Value& conf
   if( (condition != nullptr) && !ownerDebugLabel.empty() ) {
     condition->SetOwnerDebugLabel( ownerDebugLabel );
   }
+  
+  if( (condition != nullptr) && condition->CanShareResults() ) {
+    condition->SetSharedResult( GetSharedResult( conditionType, config ) );
+  }
 
   return condition;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::shared_ptr<BEIConditionSharedResult> BEIConditionFactory::GetSharedResult(BEIConditionType type,
+                                                                               const Json::Value& config)
+{
+  // Json objects keep their members sorted, so identical configs serialize identically
+  Json::FastWriter writer;
+  const std::string key = writer.write( config );
+  
+  auto& weakResult = _sharedResults[key];
+  std::shared_ptr<BEIConditionSharedResult> result = weakResult.lock();
+  if( result == nullptr ) {
+    result = std::make_shared<BEIConditionSharedResult>( type );
+    weakResult = result;
+  }
+  return result;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool BEIConditionFactory::GetResultSharingScopeID(size_t& scopeID)
+{
+  scopeID = _resultSharingScopeID;
+  return _isResultSharingScopeActive;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void BEIConditionFactory::LogSharedResultStats()
+{
+  struct Stats {
+    size_t numConfigs = 0;
+    size_t numEvaluations = 0;
+    size_t numSharedResults = 0;
+  };
+  std::map<BEIConditionType, Stats> statsByType;
+  
+  for( auto it = _sharedResults.begin(); it != _sharedResults.end(); ) {
+    const auto result = it->second.lock();
+    if( result == nullptr ) {
+      // no conditions with this config remain
+      it = _sharedResults.erase(it);
+      continue;
+    }
+    auto& stats = statsByType[result->conditionType];
+    ++stats.numConfigs;
+    stats.numEvaluations += result->numEvaluations;
+    stats.numSharedResults += result->numSharedResults;
+    ++it;
+  }
+  
+  for( const auto& entry : statsByType ) {
+    const Stats& stats = entry.second;
+    const size_t total = stats.numEvaluations + stats.numSharedResults;
+    PRINT_CH_INFO("Behaviors", "BEIConditionFactory.LogSharedResultStats",
+                  "%s: %zu configs, %zu evaluations, %zu shared (%.1f%% shared)",
+                  BEIConditionTypeToString( entry.first ),
+                  stats.numConfigs,
+                  stats.numEvaluations,
+                  stats.numSharedResults,
+                  (total > 0) ? (100.0f * stats.numSharedResults / total) : 0.0f);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BEIConditionResultSharingScope::BEIConditionResultSharingScope()
+{
+  DEV_ASSERT( !BEIConditionFactory::_isResultSharingScopeActive, "BEIConditionResultSharingScope.Nested" );
+  ++BEIConditionFactory::_resultSharingScopeID;
+  BEIConditionFactory::_isResultSharingScopeActive = true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BEIConditionResultSharingScope::~BEIConditionResultSharingScope()
+{
+  BEIConditionFactory::_isResultSharingScopeActive = false;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 IBEIConditionPtr BEIConditionFactory::CreateBEICondition(BEIConditionType type, const std::string& ownerDebugLabel)
 {
@@ -20,14 +20,18 @@
 #include "json/json-forwards.h"
 
 #include <map>
+#include <string>
+#include <unordered_map>
 
 namespace Anki {
 namespace Vector {
   
 enum class BEIConditionType : uint8_t;
+struct BEIConditionSharedResult;
 
 class BEIConditionFactory {
   friend class CustomBEIConditionHandleInternal;
+  friend class BEIConditionResultSharingScope;
 public:
   static IBEIConditionPtr CreateBEICondition(const Json::Value& config, const std::string& ownerDebugLabel);
 
@@ -47,8 +51,17 @@ public:
 
   // utility to check and print warnings if any conditions seem unused (internally checks ref count)
   static bool CheckConditionsAreUsed(const CustomBEIConditionHandleList& handles, const std::string& debugStr);
+  
+  // Returns true and sets scopeID if a BEIConditionResultSharingScope is active
+  static bool GetResultSharingScopeID(size_t& scopeID);
+  
+  // Logs, per condition type, how many evaluations of conditions that CanShareResults were shared
+  static void LogSharedResultStats();
 
 private:
+  
+  // Shared result for all conditions created from the given config, creating it if none of them still exist
+  static std::shared_ptr<BEIConditionSharedResult> GetSharedResult(BEIConditionType type, const Json::Value& config);
 
   static void RemoveCustomCondition(const std::string& name);
 
@@ -57,6 +70,12 @@ private:
   // container for custom conditions. Will get cleaned up when the handles go out of scope
   static std::map< std::string, IBEIConditionPtr > _customConditionMap;
   
+  // results shared among conditions created from the same config, keyed by the config serialized
+  static std::unordered_map< std::string, std::weak_ptr<BEIConditionSharedResult> > _sharedResults;
+  
+  static size_t _resultSharingScopeID;
+  static bool _isResultSharingScopeActive;
+  
 }; // class BEIConditionFactory
 
 // handle class that can be used to manage injection of custom bei conditions. When it goes out of scope or is
@@ -73,6 +92,16 @@ private:
   std::string _conditionName;
 };
 
+// While one of these exists, conditions that CanShareResults are evaluated at most once per config: the first
+// instance evaluated computes the result, and the others reuse it. BehaviorSystemManager holds one around each of its
+// updates, during which the state those conditions depend on doesn't change. Scopes don't nest.
+class BEIConditionResultSharingScope : private Util::noncopyable
+{
+public:
+  BEIConditionResultSharingScope();
+  ~BEIConditionResultSharingScope();
+};
+
 } // namespace Vector
 } // namespace Anki
 
@@ -25,6 +25,9 @@ class ConditionBatteryLevel : public IBEICondition
 public:
   explicit ConditionBatteryLevel(const Json::Value& config);
 
+  virtual bool CanShareResults() const override { return true; }
+  virtual BEIConditionInputMask GetInputDependencies() const override { return BEIConditionInput::Battery; }
+
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& bei) const override;
 
 private:
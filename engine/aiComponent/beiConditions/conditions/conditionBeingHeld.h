@@ -23,6 +23,8 @@ class ConditionBeingHeld : public IBEICondition
 public:
   explicit ConditionBeingHeld(const Json::Value& config);
   explicit ConditionBeingHeld(const bool shouldBeHeld, const std::string& ownerDebugLabel);
+
+  virtual bool CanShareResults() const override { return true; }
   
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& bei) const override;
 
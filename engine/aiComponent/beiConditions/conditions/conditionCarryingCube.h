@@ -23,6 +23,8 @@ class ConditionCarryingCube : public IBEICondition{
 public:
   explicit ConditionCarryingCube(const Json::Value& config);
 
+  virtual bool CanShareResults() const override { return true; }
+
 protected:
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& behaviorExternalInterface) const override;
 
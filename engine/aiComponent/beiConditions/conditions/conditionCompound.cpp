@@ -112,6 +112,32 @@ void ConditionCompound::InitInternal( BehaviorExternalInterface& bei )
   }
 }
  
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ConditionCompound::CanShareResults() const
+{
+  for( const auto& operand : _operands ) {
+    if( (operand == nullptr) || !operand->CanShareResults() ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BEIConditionInputMask ConditionCompound::GetInputDependencies() const
+{
+  // only if every operand declares its inputs, since an operand that doesn't must be evaluated every time
+  BEIConditionInputMask inputs = 0;
+  for( const auto& operand : _operands ) {
+    const BEIConditionInputMask operandInputs = (operand != nullptr) ? operand->GetInputDependencies() : 0;
+    if( operandInputs == 0 ) {
+      return 0;
+    }
+    inputs |= operandInputs;
+  }
+  return inputs;
+}
+  
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ConditionCompound::AreConditionsMetInternal( BehaviorExternalInterface& bei ) const
 {
@@ -32,6 +32,10 @@ public:
 
   virtual void InitInternal(BehaviorExternalInterface& behaviorExternalInterface) override;
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& behaviorExternalInterface) const override;
+  
+  // true if all operands can share results
+  virtual bool CanShareResults() const override;
+  virtual BEIConditionInputMask GetInputDependencies() const override;
   virtual void SetActiveInternal(BehaviorExternalInterface& behaviorExternalInterface, bool setActive) override;
   virtual void GetRequiredVisionModes(std::set<VisionModeRequest>& requests) const override;
   
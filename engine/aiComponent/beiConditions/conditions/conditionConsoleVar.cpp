@@ -30,6 +30,7 @@ const char* kParseDebug = "ConditionConsoleVar";
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ConditionConsoleVar::ConditionConsoleVar(const Json::Value& config)
   : IBEICondition(config)
+  , _varSlot(Anki::Util::IConsoleVariable::kInvalidSlot)
 {
   _variableName = JsonTools::ParseString(config, kVariableNameKey, kParseDebug);
   _expectedValue = JsonTools::ParseInt32(config, kValueKey, kParseDebug);
@@ -45,7 +46,8 @@ ConditionConsoleVar::~ConditionConsoleVar()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ConditionConsoleVar::AreConditionsMetInternal(BehaviorExternalInterface& behaviorExternalInterface) const
 { 
-  return (_var != nullptr) && (_var->GetAsInt64() == _expectedValue);
+  const Anki::Util::IConsoleVariable* var = Anki::Util::ConsoleSystem::Instance().GetVariable( _varSlot );
+  return (var != nullptr) && (var->GetAsInt64() == _expectedValue);
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -56,9 +58,10 @@ void ConditionConsoleVar::SetActiveInternal(BehaviorExternalInterface& behaviorE
   }
   
   if( isActive ) {
-    _var = Anki::Util::ConsoleSystem::Instance().FindVariable( _variableName.c_str() );
+    const Anki::Util::IConsoleVariable* var = Anki::Util::ConsoleSystem::Instance().FindVariable( _variableName.c_str() );
+    _varSlot = (var != nullptr) ? var->GetSlot() : Anki::Util::IConsoleVariable::kInvalidSlot;
   } else {
-    _var = nullptr;
+    _varSlot = Anki::Util::IConsoleVariable::kInvalidSlot;
   }
 }
 
@@ -18,11 +18,6 @@
 #include "engine/aiComponent/beiConditions/iBEIConditionEventHandler.h"
 
 namespace Anki {
-
-namespace Util {
-  class IConsoleVariable;
-}
-  
 namespace Vector {
 
 
@@ -43,7 +38,8 @@ private:
   std::string _variableName;
   size_t _expectedValue;
   
-  const Anki::Util::IConsoleVariable* _var = nullptr;
+  // slot rather than pointer, so a variable unregistered while active just stops matching
+  uint32_t _varSlot;
 };
   
 } // namespace
@@ -35,6 +35,14 @@ ConditionFaceKnown::ConditionFaceKnown(const Json::Value& config)
   _mustBeNamed = config.get( kMustBeNamed, false ).asBool();
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+BEIConditionInputMask ConditionFaceKnown::GetInputDependencies() const
+{
+  // a max age or distance makes the result change with time or as the robot moves
+  const bool onlyDependsOnFaces = (_maxFaceAge_s < 0) && (_maxFaceDist_mm < 0.0f);
+  return onlyDependsOnFaces ? BEIConditionInput::FaceWorld : 0;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ConditionFaceKnown::AreConditionsMetInternal(BehaviorExternalInterface& behaviorExternalInterface) const
 { 
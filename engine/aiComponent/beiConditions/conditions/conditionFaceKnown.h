@@ -22,6 +22,9 @@ class ConditionFaceKnown : public IBEICondition
 {
 public:
   ConditionFaceKnown(const Json::Value& config);
+
+  virtual bool CanShareResults() const override { return true; }
+  virtual BEIConditionInputMask GetInputDependencies() const override;
   virtual ~ConditionFaceKnown() = default;
 
 protected:
@@ -25,6 +25,8 @@ class ConditionHighTemperature : public IBEICondition
 public:
   explicit ConditionHighTemperature(const Json::Value& config);
 
+  virtual bool CanShareResults() const override { return true; }
+
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& bei) const override;
 
 private:
@@ -26,6 +26,8 @@ class ConditionInCalmMode : public IBEICondition
 public:
   explicit ConditionInCalmMode(const Json::Value& config);
 
+  virtual bool CanShareResults() const override { return true; }
+
   virtual ~ConditionInCalmMode() {};
 
 protected:
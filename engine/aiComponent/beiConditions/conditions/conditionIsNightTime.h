@@ -24,6 +24,8 @@ public:
   
   explicit ConditionIsNightTime(const Json::Value& config);
 
+  virtual bool CanShareResults() const override { return true; }
+
 protected:
   
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& behaviorExternalInterface) const override;
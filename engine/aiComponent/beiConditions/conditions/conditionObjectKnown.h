@@ -35,6 +35,11 @@ public:
   // objects (maybe it's gone now)
   const std::vector<const ObservableObject*> GetObjects(BehaviorExternalInterface& behaviorExternalInterface) const;
   
+  // without a max age, only which objects are located matters
+  virtual BEIConditionInputMask GetInputDependencies() const override {
+    return _setMaxAge ? 0 : BEIConditionInput::BlockWorld;
+  }
+  
 protected:
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& behaviorExternalInterface) const override;
   virtual void SetActiveInternal(BehaviorExternalInterface& behaviorExternalInterface, bool setActive) override;
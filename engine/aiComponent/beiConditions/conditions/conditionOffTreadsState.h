@@ -25,6 +25,8 @@ class ConditionOffTreadsState : public IBEICondition
 public:
   explicit ConditionOffTreadsState(const Json::Value& config);
   explicit ConditionOffTreadsState(const OffTreadsState& targetState, const std::string& ownerDebugLabel);
+
+  virtual bool CanShareResults() const override { return true; }
   
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& bei) const override;
 
@@ -23,6 +23,9 @@ class ConditionOnCharger : public IBEICondition
 public:
   explicit ConditionOnCharger(const Json::Value& config);
 
+  virtual bool CanShareResults() const override { return true; }
+  virtual BEIConditionInputMask GetInputDependencies() const override { return BEIConditionInput::Battery; }
+
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& bei) const override;
 };
 
@@ -23,6 +23,9 @@ class ConditionOnChargerPlatform : public IBEICondition
 public:
   explicit ConditionOnChargerPlatform(const Json::Value& config);
 
+  virtual bool CanShareResults() const override { return true; }
+  virtual BEIConditionInputMask GetInputDependencies() const override { return BEIConditionInput::Battery; }
+
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& bei) const override;
 };
 
@@ -39,13 +39,12 @@ bool ConditionPetInitialDetection::AreConditionsMetInternal(BehaviorExternalInte
   const auto & petWorld = behaviorExternalInterface.GetPetWorld();
   const auto & pets = petWorld.GetAllKnownPets();
 
-  for (const auto & it : pets) {
-    const auto petID = it.first;
+  for (const auto & pet : pets) {
+    const auto petID = pet.GetID();
     if (_reactedTo.find(petID) != _reactedTo.end()) {
       LOG_DEBUG("ConditionPetInitialDetection.AreConditionsMet.AlreadyReacted", "Already reacted to petID %d", petID);
       continue;
     }
-    const auto & pet = it.second;
     const auto numTimesObserved = pet.GetNumTimesObserved();
     if (numTimesObserved < kReactToPetNumTimesObserved) {
       LOG_DEBUG("ConditionPetInitialDetection.AreConditionsMet.NumTimesObserved",
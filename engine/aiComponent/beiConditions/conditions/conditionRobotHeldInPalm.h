@@ -32,6 +32,8 @@ public:
                                     const int minDuration_ms = 0,
                                     const int maxDuration_ms = INT_MAX);
 
+  virtual bool CanShareResults() const override { return true; }
+
   virtual ~ConditionRobotHeldInPalm() {};
 
 protected:
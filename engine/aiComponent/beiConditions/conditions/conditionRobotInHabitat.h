@@ -26,6 +26,8 @@ class ConditionRobotInHabitat : public IBEICondition
 public:
   // constructor
   explicit ConditionRobotInHabitat(const Json::Value& config);
+
+  virtual bool CanShareResults() const override { return true; }
   ~ConditionRobotInHabitat() = default;
   
   virtual void BuildDebugFactorsInternal( BEIConditionDebugFactors& factors ) const override;
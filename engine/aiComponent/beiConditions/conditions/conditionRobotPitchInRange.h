@@ -24,6 +24,8 @@ class ConditionRobotPitchInRange : public IBEICondition{
 public:
   explicit ConditionRobotPitchInRange(const Json::Value& config);
 
+  virtual bool CanShareResults() const override { return true; }
+
 protected:
   virtual bool AreConditionsMetInternal(BehaviorExternalInterface& behaviorExternalInterface) const override;
 
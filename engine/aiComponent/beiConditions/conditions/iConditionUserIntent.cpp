@@ -158,6 +158,7 @@ void IConditionUserIntent::AddUserIntent( const Json::Value& json )
       }
     }
     
+    _tagMask.set( static_cast<size_t>(evals.tag) );
     _evalList.push_back( std::move(evals) );
     
     _isInitialized = true;
@@ -168,6 +169,7 @@ void IConditionUserIntent::AddUserIntent( const Json::Value& json )
 void IConditionUserIntent::AddUserIntent( UserIntentTag tag )
 {
   _evalList.emplace_back( tag );
+  _tagMask.set( static_cast<size_t>(tag) );
   _isInitialized = true;
 }
   
@@ -187,6 +189,7 @@ void IConditionUserIntent::AddUserIntent( UserIntentTag tag, EvalUserIntentFunc&
     
     _evalList.emplace_back( tag );
     _evalList.back().func = funcPtr;
+    _tagMask.set( static_cast<size_t>(tag) );
     
     _isInitialized = true;
   }
@@ -202,6 +205,7 @@ void IConditionUserIntent::AddUserIntent( UserIntent&& intent )
   if( notInvalid ) {
     _evalList.emplace_back( tag );
     _evalList.back().intent.reset( new UserIntent{ std::move(intent) } );
+    _tagMask.set( static_cast<size_t>(tag) );
     _isInitialized = true;
   }
 }
@@ -219,28 +223,16 @@ bool IConditionUserIntent::AreConditionsMetInternal( BehaviorExternalInterface&
   const auto& uic = behaviorExternalInterface.GetAIComponent().GetComponent<BehaviorComponent>().GetComponent<UserIntentComponent>();
   
   const bool checkPending = (_type == BEIConditionType::UserIntentPending);
-  if( checkPending ) {
-    if( !uic.IsAnyUserIntentPending() ) {
-      return false;
-    }
-  } else {
-    if( uic.GetActiveUserIntent() == nullptr ) {
-      return false;
-    }
+  const UserIntent* intentPtr = checkPending ? uic.GetPendingUserIntentIfAnyOf( _tagMask )
+                                             : uic.GetActiveUserIntentIfAnyOf( _tagMask );
+  if( intentPtr == nullptr ) {
+    return false;
   }
   
+  const UserIntent& intent = *intentPtr;
+  const UserIntentTag intentTag = intent.GetTag();
   for( const auto& elem : _evalList ) {
-    UserIntent pendingIntent;
-    UserIntentPtr activeIntent;
-    bool gotIntent = false;
-    if( checkPending ) {
-      gotIntent = uic.IsUserIntentPending( elem.tag, pendingIntent );
-    } else {
-      activeIntent = uic.GetUserIntentIfActive( elem.tag );
-      gotIntent = (activeIntent != nullptr);
-    }
-    if( gotIntent ) {
-      const auto& intent = checkPending ? pendingIntent : activeIntent->intent;
+    if( elem.tag == intentTag ) {
       if( elem.func != nullptr ) {
         // user provided a lambda that wants to check the intent data.
         // todo: enforce that the type of argument to the lambda matches the tag in the pair, i.e.,
@@ -48,6 +48,8 @@ public:
   // if this condition is true, then this condition should be able to return the tag that made it
   // true out of the list passed during construction
   UserIntentTag GetUserIntentTagSelected() const;
+  
+  virtual BEIConditionInputMask GetInputDependencies() const override { return BEIConditionInput::UserIntent; }
 
 protected:
   
@@ -86,6 +88,9 @@ private:
   // list of comparisons to be performed when checking a pending intent
   std::vector< EvalStruct > _evalList;
   
+  // every tag in _evalList, so that an intent with none of them is rejected with one bit test
+  UserIntentTagMask _tagMask;
+  
   // this holds eval funcs that were arguments in the AddUserIntent that accepts lambdas
   std::list< EvalUserIntentFunc > _ownedFuncs;
   
@@ -17,12 +17,21 @@
 
 #include "coretech/common/engine/jsonTools.h"
 #include "coretech/common/engine/utils/timer.h"
+#include "engine/aiComponent/aiComponent.h"
+#include "engine/aiComponent/behaviorComponent/behaviorComponent.h"
 #include "engine/aiComponent/behaviorComponent/behaviorExternalInterface/behaviorExternalInterface.h"
 #include "engine/aiComponent/behaviorComponent/behaviorExternalInterface/beiRobotInfo.h"
+#include "engine/aiComponent/behaviorComponent/behaviorTickProfiler.h"
+#include "engine/aiComponent/behaviorComponent/userIntentComponent.h"
 #include "engine/aiComponent/beiConditions/beiConditionDebugFactors.h"
+#include "engine/aiComponent/beiConditions/beiConditionFactory.h"
+#include "engine/blockWorld/blockWorld.h"
+#include "engine/components/battery/batteryComponent.h"
 #include "engine/components/visionScheduleMediator/visionScheduleMediator.h"
 #include "engine/cozmoContext.h"
+#include "engine/faceWorld.h"
 #include "engine/robot.h"
+#include "util/console/consoleInterface.h"
 #include "webServerProcess/src/webService.h"
 
 namespace Anki {
@@ -31,6 +40,30 @@ namespace Vector {
 namespace {
 using namespace ExternalInterface;
 const char* kWebVizModuleName = "behaviorconds";
+
+// conditions that declare their input dependencies are still re-evaluated at least this often, in case some input
+// changed without bumping its generation
+CONSOLE_VAR(float, kBEIConditionMaxResultReuse_s, "BehaviorSystem.Conditions", 1.0f);
+
+// Since every generation only ever increases, their sum changes whenever any one of them does
+size_t GetInputsGeneration(BehaviorExternalInterface& bei, BEIConditionInputMask inputs)
+{
+  size_t generation = 0;
+  if( inputs & BEIConditionInput::FaceWorld ) {
+    generation += bei.GetFaceWorld().GetFacesGeneration();
+  }
+  if( inputs & BEIConditionInput::BlockWorld ) {
+    generation += bei.GetBlockWorld().GetLocatedObjectsGeneration();
+  }
+  if( inputs & BEIConditionInput::Battery ) {
+    generation += bei.GetRobotInfo().GetBatteryComponent().GetStateGeneration();
+  }
+  if( inputs & BEIConditionInput::UserIntent ) {
+    const auto& uic = bei.GetAIComponent().GetComponent<BehaviorComponent>().GetComponent<UserIntentComponent>();
+    generation += uic.GetIntentsGeneration();
+  }
+  return generation;
+}
 }
   
 const char* const IBEICondition::kConditionTypeKey = "conditionType";
@@ -86,6 +119,7 @@ void IBEICondition::SetActive(BehaviorExternalInterface& bei, bool setToActive)
   }
 
   _isActive = setToActive;
+  _hasCachedResult = false;
   SetActiveInternal(bei, _isActive);
   
   if( ANKI_DEV_CHEATS && !_isActive ) {
@@ -121,6 +155,8 @@ bool IBEICondition::AreConditionsMet(BehaviorExternalInterface& behaviorExternal
   DEV_ASSERT(_isActive, "IBEICondition.AreConditionsMet.IsInactive");
   DEV_ASSERT(_isInitialized, "IBEICondition.AreConditionsMet.NotInitialized");
   
+  BehaviorTickProfiler::ScopedSample profilerSample(*this);
+  
   // If a condition has a child condition, then setting this static flag means it won't check,
   // send, or reset debug factors. that way, the parent can have full control over when debug
   // info is sent. this is a bit hacky, but it's effect is in ANKI_DEV_CHEATS only. setting the
@@ -131,7 +167,42 @@ bool IBEICondition::AreConditionsMet(BehaviorExternalInterface& behaviorExternal
     _checkDebugFactors = false;
   }
   
-  const bool met = AreConditionsMetInternal(behaviorExternalInterface);
+  bool met = false;
+  bool evaluated = true;
+  size_t scopeID = 0;
+  const BEIConditionInputMask inputs = GetInputDependencies();
+  const size_t inputsGeneration = (inputs != 0) ? GetInputsGeneration(behaviorExternalInterface, inputs) : 0;
+  const float currTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+  const bool reuseResult = _hasCachedResult &&
+                           (inputsGeneration == _cachedInputsGeneration) &&
+                           (currTime_s - _cachedResultTime_s < kBEIConditionMaxResultReuse_s);
+  if( reuseResult ) {
+    // nothing this condition depends on has changed since it was last evaluated
+    met = _lastMetValue;
+    evaluated = false;
+  } else if( (_sharedResult != nullptr) && BEIConditionFactory::GetResultSharingScopeID(scopeID) ) {
+    // another instance with the same config may have been evaluated already in this scope
+    if( _sharedResult->hasResult && (_sharedResult->scopeID == scopeID) ) {
+      met = _sharedResult->areConditionsMet;
+      ++_sharedResult->numSharedResults;
+      evaluated = false;
+    } else {
+      met = AreConditionsMetInternal(behaviorExternalInterface);
+      _sharedResult->scopeID = scopeID;
+      _sharedResult->hasResult = true;
+      _sharedResult->areConditionsMet = met;
+      ++_sharedResult->numEvaluations;
+    }
+  } else {
+    met = AreConditionsMetInternal(behaviorExternalInterface);
+  }
+  
+  // a shared result may predate the current generation, so only cache results this condition computed
+  if( (inputs != 0) && evaluated ) {
+    _hasCachedResult = true;
+    _cachedInputsGeneration = inputsGeneration;
+    _cachedResultTime_s = currTime_s;
+  }
   
   if( ANKI_DEV_CHEATS ) {
     if( checkDebugFactors ) {
@@ -23,6 +23,7 @@
 #include "clad/types/behaviorComponent/beiConditionTypes.h"
 #include "json/json-forwards.h"
 
+#include <memory>
 #include <set>
 #include <string>
 
@@ -33,6 +34,34 @@ class BehaviorExternalInterface;
 class IExternalInterface;
 class Robot;
 class BEIConditionDebugFactors;
+
+// Result of a condition, shared by every condition instance the factory created from the same config (see
+// IBEICondition::CanShareResults and BEIConditionResultSharingScope)
+struct BEIConditionSharedResult
+{
+  explicit BEIConditionSharedResult(BEIConditionType type) : conditionType(type) {}
+  
+  BEIConditionType conditionType;
+  size_t scopeID = 0;
+  bool   hasResult = false;
+  bool   areConditionsMet = false;
+  
+  // for debug reporting of how often the result was shared
+  size_t numEvaluations = 0;
+  size_t numSharedResults = 0;
+};
+
+// Inputs a condition can declare its result depends on (see IBEICondition::GetInputDependencies). Each has a
+// generation counter that its owner bumps whenever it changes.
+namespace BEIConditionInput {
+  enum : uint8_t {
+    FaceWorld  = 1 << 0, // FaceWorld::GetFacesGeneration
+    BlockWorld = 1 << 1, // BlockWorld::GetLocatedObjectsGeneration
+    Battery    = 1 << 2, // BatteryComponent::GetStateGeneration
+    UserIntent = 1 << 3, // UserIntentComponent::GetIntentsGeneration
+  };
+}
+using BEIConditionInputMask = uint8_t;
   
 class IBEICondition : public IVisionModeSubscriber
 {
@@ -57,6 +86,18 @@ public:
 
   bool AreConditionsMet(BehaviorExternalInterface& behaviorExternalInterface) const;
   
+  // Conditions whose result depends only on their config and on state that doesn't change while behaviors are
+  // updated (e.g. robot state, which is updated before the behavior component) should return true. Then all instances
+  // the factory creates from the same config share a single evaluation per BEIConditionResultSharingScope.
+  // Conditions that keep state between evaluations, or that report more than their result to their owner, must not.
+  virtual bool CanShareResults() const { return false; }
+  
+  // Conditions whose result depends only on their config and on the BEIConditionInput(s) returned here can declare
+  // them, and their last result is then reused until one of those inputs changes (or a fallback interval passes).
+  // The default, none, means the condition is evaluated every time. Conditions that also depend on time, mood, or
+  // anything else that changes without bumping one of the generations must not declare any.
+  virtual BEIConditionInputMask GetInputDependencies() const { return 0; }
+  
   BEIConditionType GetConditionType() const {return _conditionType;}
   
   void SetDebugLabel(const std::string& label) { _debugLabel = label; }
@@ -92,6 +133,9 @@ protected:
   
 private:
   
+  friend class BEIConditionFactory;
+  void SetSharedResult(const std::shared_ptr<BEIConditionSharedResult>& sharedResult) { _sharedResult = sharedResult; }
+  
   // called when whenever AreConditionsMet is evaluated
   void SendConditionsToWebViz( BehaviorExternalInterface& bei ) const;
   
@@ -109,7 +153,15 @@ private:
   std::string _ownerLabel;
   
   mutable bool _lastMetValue;
+  
+  // for reusing the last result while none of GetInputDependencies changed
+  mutable bool   _hasCachedResult = false;
+  mutable size_t _cachedInputsGeneration = 0;
+  mutable float  _cachedResultTime_s = 0.0f;
   mutable std::unique_ptr<BEIConditionDebugFactors> _debugFactors;
+  
+  // set by the factory for conditions that CanShareResults
+  std::shared_ptr<BEIConditionSharedResult> _sharedResult;
   static bool _checkDebugFactors;
 };
 
@@ -31,6 +31,11 @@ namespace {
 static const float kInvalidObjectCacheUpdateTime_s = -1.0f;
 static const float kTimeObjectInvalidAfterStackFailure_sec = 3.0f;
 static const Radians kAngleToleranceAfterFailure_radians = M_PI;
+
+// Longest any of the filters consider a failure to use an object recent
+static const float kMaxFailureWindow_sec =
+  (DefaultFailToUseParams::kTimeObjectInvalidAfterFailure_sec > kTimeObjectInvalidAfterStackFailure_sec) ?
+  DefaultFailToUseParams::kTimeObjectInvalidAfterFailure_sec : kTimeObjectInvalidAfterStackFailure_sec;
 }
   
 using ObjectActionFailure = AIWhiteboard::ObjectActionFailure;
@@ -231,7 +236,8 @@ const BlockWorldFilter& ObjectInteractionInfoCache::GetDefaultFilterForIntention
 bool ObjectInteractionInfoCache::IsObjectValidForInteraction(ObjectInteractionIntention intention,
                                                              const ObjectID& object)
 {
-  auto validObjs = GetValidObjectsForIntention(intention);
+  EnsureInformationValid(intention);
+  const auto& validObjs = _trackers.find(intention)->second.GetValidObjects();
   
   const auto objectIter = validObjs.find(object);
   // the object is valid if and only if it is in our valid set
@@ -239,17 +245,27 @@ bool ObjectInteractionInfoCache::IsObjectValidForInteraction(ObjectInteractionIn
 }
 
   
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+u32 ObjectInteractionInfoCache::GetGenerationForIntention(ObjectInteractionIntention intention)
+{
+  EnsureInformationValid(intention);
+  return _trackers.find(intention)->second.GetGeneration();
+}
+
+  
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ObjectInteractionInfoCache::EnsureInformationValid(ObjectInteractionIntention intention)
 {
   // Ensure all intentions this intention depends on are valid
   const int intentionIdx = Util::numeric_cast<int>(intention);
-  auto dependentIntentions = *(kDependentIntentionMap[intentionIdx].Value());
+  const auto& dependentIntentions = *(kDependentIntentionMap[intentionIdx].Value());
+  u32 dependenciesGeneration = 0;
   for(const auto& dependentIntention : dependentIntentions){
     EnsureInformationValid(dependentIntention);
+    dependenciesGeneration += _trackers.find(dependentIntention)->second.GetGeneration();
   }
   
-  _trackers.find(intention)->second.EnsureInformationValid();
+  _trackers.find(intention)->second.EnsureInformationValid(dependenciesGeneration);
 }
  
   
@@ -561,12 +577,61 @@ ObjectInteractionCacheEntry::ObjectInteractionCacheEntry(const Robot& robot,
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ObjectInteractionCacheEntry::EnsureInformationValid()
+bool ObjectInteractionCacheEntry::FilterInputs::operator==(const FilterInputs& other) const
+{
+  return ((locatedObjectsGeneration == other.locatedObjectsGeneration) &&
+          (failuresGeneration == other.failuresGeneration) &&
+          (dependenciesGeneration == other.dependenciesGeneration) &&
+          (hasUnexpiredFailure == other.hasUnexpiredFailure) &&
+          (robotOriginID == other.robotOriginID) &&
+          (robotTransform == other.robotTransform) &&
+          (carryingObjectID == other.carryingObjectID));
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ObjectInteractionCacheEntry::FilterInputs ObjectInteractionCacheEntry::GetCurrentFilterInputs(float currentTime_s,
+                                                                                              u32 dependenciesGeneration) const
+{
+  const auto& whiteboard = _robot.GetAIComponent().GetComponent<AIWhiteboard>();
+  const auto& carryingComponent = _robot.GetCarryingComponent();
+  
+  FilterInputs inputs;
+  inputs.locatedObjectsGeneration = _robot.GetBlockWorld().GetLocatedObjectsGeneration();
+  inputs.failuresGeneration = whiteboard.GetFailuresGeneration();
+  inputs.dependenciesGeneration = dependenciesGeneration;
+  // Failures stop counting after a while without anything changing, so until they all have, the objects they
+  // apply to have to be re-filtered every tick
+  const float lastFailureTime_s = whiteboard.GetLastFailureTime_s();
+  inputs.hasUnexpiredFailure = (lastFailureTime_s >= 0.f) && (currentTime_s - lastFailureTime_s <= kMaxFailureWindow_sec);
+  inputs.robotOriginID = _robot.GetWorldOriginID();
+  inputs.robotTransform = _robot.GetPose().GetTransform();
+  if(carryingComponent.IsCarryingObject()) {
+    inputs.carryingObjectID = carryingComponent.GetCarryingObjectID();
+  }
+  return inputs;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ObjectInteractionCacheEntry::EnsureInformationValid(u32 dependenciesGeneration)
 {
   const f32 currentTimeInSeconds = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
   if(!FLT_NEAR(_timeUpdated_s, currentTimeInSeconds)){
     _timeUpdated_s = currentTimeInSeconds;
-    _validObjects.clear();
+    
+    // Skip re-running the filters over BlockWorld if nothing they look at has changed since the last time
+    const FilterInputs inputs = GetCurrentFilterInputs(currentTimeInSeconds, dependenciesGeneration);
+    const bool needsFiltering = (!_areFilterInputsValid || !(inputs == _filterInputs) || inputs.hasUnexpiredFailure);
+    _filterInputs = inputs;
+    _areFilterInputsValid = true;
+    if(!needsFiltering) {
+      return;
+    }
+    
+    const ObjectID oldBestObject = _bestObject;
+    std::set< ObjectID > oldValidObjects;
+    std::swap(oldValidObjects, _validObjects);
     
     std::vector<const ObservableObject*> objects;
     const auto& blockWorld = _robot.GetBlockWorld();
@@ -584,6 +649,9 @@ void ObjectInteractionCacheEntry::EnsureInformationValid()
       _bestObject = _bestObjFunc(_validObjects);
     }
     
+    if((_bestObject != oldBestObject) || (_validObjects != oldValidObjects)) {
+      ++_generation;
+    }
   }
 }
 
@@ -602,7 +670,7 @@ ObjectID ObjectInteractionCacheEntry::GetBestObject() const
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-std::set< ObjectID > ObjectInteractionCacheEntry::GetValidObjects() const
+const std::set< ObjectID >& ObjectInteractionCacheEntry::GetValidObjects() const
 {
 #if ANKI_DEV_CHEATS
   const f32 currentTimeInSeconds = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
@@ -637,8 +705,15 @@ bool ObjectInteractionCacheEntry::ObjectTapInteractionOccurred(const ObjectID& o
     }
     
     _bestObject = objectID;
+    if( oldBest != objectID ) {
+      ++_generation;
+    }
     return true;
   }
+  
+  if( oldBest.IsSet() ) {
+    ++_generation;
+  }
   return false;
 }
 
@@ -647,6 +722,7 @@ bool ObjectInteractionCacheEntry::ObjectTapInteractionOccurred(const ObjectID& o
 void ObjectInteractionCacheEntry::Invalidate()
 {
   _timeUpdated_s = kInvalidObjectCacheUpdateTime_s;
+  _areFilterInputsValid = false;
 }
 
 
@@ -17,6 +17,7 @@
 
 #include "engine/blockWorld/blockWorldFilter.h"
 #include "engine/aiComponent/aiComponents_fwd.h"
+#include "coretech/common/engine/math/transform.h"
 #include "coretech/common/engine/objectIDs.h"
 #include "util/entityComponent/iDependencyManagedComponent.h"
 #include "util/helpers/fullEnumToValueArrayChecker.h"
@@ -68,6 +69,11 @@ public:
   const BlockWorldFilter& GetDefaultFilterForIntention(ObjectInteractionIntention intention);
   
   bool IsObjectValidForInteraction(ObjectInteractionIntention intention, const ObjectID& object);
+  
+  // Changes whenever the best or valid objects for the intention do, so callers can skip redoing anything
+  // they worked out from them while it stays the same
+  u32 GetGenerationForIntention(ObjectInteractionIntention intention);
+  
   // Ensure that all information in the cache that is necessary to get valid/best
   // objects has been updated this tick before accessing it
   void EnsureInformationValid(ObjectInteractionIntention intention);
@@ -134,12 +140,17 @@ public:
                               BlockWorldFilter* validFilter,
                               BestObjectFunction bestFilter);
   ObjectID GetBestObject() const;
-  std::set< ObjectID > GetValidObjects() const;
+  const std::set< ObjectID >& GetValidObjects() const;
   const BlockWorldFilter& GetValidObjectsFilter() const {assert(_blockWorldFilterValidBlocks);
     return *_blockWorldFilterValidBlocks;}
   
-  // Updates the bestObject and validObjects if they haven't been updated this tick
-  void EnsureInformationValid();
+  // Updates the bestObject and validObjects if they haven't been updated this tick. The valid objects are only
+  // re-filtered if something the filters look at may have changed since they last were. dependenciesGeneration
+  // must change whenever any of the entries this entry's filters use do (see GetGeneration).
+  void EnsureInformationValid(u32 dependenciesGeneration);
+  
+  // Incremented whenever the best object or the valid objects change
+  u32 GetGeneration() const { return _generation; }
   // Notify the cache that a tap has been detected on an object
   // Function returns true if the filter can use the object that was tapped, false otherwise
   bool ObjectTapInteractionOccurred(const ObjectID& objectID);
@@ -149,6 +160,22 @@ public:
   void Invalidate();
   
 private:
+  // Everything the filters depend on, outside of the located objects themselves
+  struct FilterInputs {
+    u32            locatedObjectsGeneration = 0;
+    u32            failuresGeneration = 0;
+    u32            dependenciesGeneration = 0;
+    bool           hasUnexpiredFailure = false;
+    PoseOriginID_t robotOriginID = 0;
+    Transform3d    robotTransform;
+    ObjectID       carryingObjectID;
+    
+    bool operator==(const FilterInputs& other) const;
+  };
+  
+  FilterInputs GetCurrentFilterInputs(float currentTime_s, u32 dependenciesGeneration) const;
+  
+
   const Robot&                        _robot;
   std::string                         _debugName;
   ObjectID                            _bestObject;
@@ -156,6 +183,9 @@ private:
   std::unique_ptr< BlockWorldFilter > _blockWorldFilterValidBlocks;
   BestObjectFunction                  _bestObjFunc;
   float                               _timeUpdated_s;
+  FilterInputs                        _filterInputs;
+  bool                                _areFilterInputsValid = false;
+  u32                                 _generation = 0;
   
 };
 
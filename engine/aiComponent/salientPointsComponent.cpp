@@ -18,12 +18,23 @@
 #include "util/console/consoleInterface.h"
 #include "util/random/randomGenerator.h"
 
+#include <algorithm>
+
 
 namespace Anki {
 namespace Vector {
 
 namespace {
 const bool kRandomPersonDetection = false;
+
+// A point this close (in normalized image coordinates) to a point of the same type seen in an earlier image at most
+// kMergeWindow_ms before is taken to be the same thing seen again
+const float kMergeDistance = 0.15f;
+const TimeStamp_t kMergeWindow_ms = 2000;
+
+// Points are forgotten once this much older than the latest of their type, or once there are too many
+const TimeStamp_t kMaxAge_ms = 10000;
+const size_t kMaxPointsPerType = 64;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -46,39 +57,66 @@ void SalientPointsComponent::InitDependent(Robot* robot, const AICompMap& depend
 void SalientPointsComponent::AddSalientPoints(const std::list<Vision::SalientPoint>& c) {
 
   PRINT_CH_DEBUG("Behaviors", "SalientPointsComponent.AddSalientPoints.PointsReceived",
-                 "Number of salient point received: %zu, previous size: %zu", c.size(), _salientPoints.size());
+                 "Number of salient point received: %zu", c.size());
 
-  std::set<Vision::SalientPointType> erased; // which lists (associated with a type) have been erased already
   for (const auto& salientPoint : c) {
+    AddSalientPoint(_salientPoints[salientPoint.salientType], salientPoint);
+  }
+
+#if ANKI_DEVELOPER_CODE
+  for (auto &element : _salientPoints) {
+    PRINT_CH_DEBUG("Behaviors", "SalientPointsComponent.AddSalientPoints.NewPointsSize",
+                   "Number of salient points of type %s after adding: %zu",
+                   Vision::SalientPointTypeToString(element.first), element.second.points.size());
+  }
+#endif
 
-    // if we haven't already, erase the elements of that type in _salientPoints
-    const auto type = salientPoint.salientType;
-    const auto insertionResult = erased.insert(type);
-    if (insertionResult.second) { // we hadn't erased this list yet
-      std::list<Vision::SalientPoint> newlist = {salientPoint};
-      _salientPoints[type] = std::move(newlist);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SalientPointsComponent::AddSalientPoint(PointsOfType& pointsOfType, const Vision::SalientPoint& salientPoint)
+{
+  auto& points = pointsOfType.points;
+  const TimeStamp_t timestamp = salientPoint.timestamp;
+
+  // Is this something we saw in an earlier image? Points from the same image are different things
+  for (auto it = points.rbegin(); it != points.rend(); ++it) {
+    if (it->timestamp >= timestamp) {
+      continue;
     }
-    else {
-      // the list in _salientPoints[type] had already been reset, just add
-      std::list<Vision::SalientPoint>& prevList = _salientPoints[type];
-      prevList.push_back(salientPoint);
+    if (it->timestamp + kMergeWindow_ms < timestamp) {
+      break;
+    }
+    const float dx = it->x_img - salientPoint.x_img;
+    const float dy = it->y_img - salientPoint.y_img;
+    if ((dx*dx + dy*dy) < (kMergeDistance*kMergeDistance)) {
+      points.erase(std::next(it).base());
+      break;
     }
   }
 
-  PRINT_CH_DEBUG("Behaviors", "SalientPointsComponent.AddSalientPoints.NewPointsSize",
-                 "Number of salient point after adding: %zu", _salientPoints.size());
+  // Keep the points in time order, in case detectors report out of order
+  const auto insertIt = std::upper_bound(points.begin(), points.end(), timestamp,
+                                         [](const TimeStamp_t t, const Vision::SalientPoint& p) {
+                                           return t < p.timestamp;
+                                         });
+  points.insert(insertIt, salientPoint);
 
-#if ANKI_DEVELOPER_CODE
-  for (auto &element : _salientPoints) {
-    for (auto &salientPoint : element.second) {
-      PRINT_CH_DEBUG("Behaviors", "SalientPointsComponent.AddSalientPoints.PointInfo",
-                     "Timestamp of SalientPoint: %u", salientPoint.timestamp);
-    }
+  const TimeStamp_t newest = points.back().timestamp;
+  while ((points.front().timestamp + kMaxAge_ms < newest) || (points.size() > kMaxPointsPerType)) {
+    points.pop_front();
   }
-#endif
 
+  Vision::SalientPoint& latest = pointsOfType.latest;
+  if (!pointsOfType.hasLatest ||
+      (timestamp > latest.timestamp) ||
+      ((timestamp == latest.timestamp) && (salientPoint.area_fraction > latest.area_fraction))) {
+    latest = salientPoint;
+    pointsOfType.hasLatest = true;
+  }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void SalientPointsComponent::GetSalientPointSinceTime(std::list<Vision::SalientPoint>& salientPoints,
                                                       const Vision::SalientPointType& type,
                                                       const RobotTimeStamp_t timestamp) const
@@ -88,11 +126,12 @@ void SalientPointsComponent::GetSalientPointSinceTime(std::list<Vision::SalientP
 
   auto it = _salientPoints.find(type);
   if (it != _salientPoints.end()) {
-    const std::list<Vision::SalientPoint>& oldPoints = it->second;
-    std::copy_if(oldPoints.begin(), oldPoints.end(), std::back_inserter(salientPoints),
-                 [timestamp](const Vision::SalientPoint& p) {return p.timestamp > timestamp;}
-    );
-
+    const auto& points = it->second.points;
+    const auto firstNewIt = std::upper_bound(points.begin(), points.end(), (TimeStamp_t)timestamp,
+                                             [](const TimeStamp_t t, const Vision::SalientPoint& p) {
+                                               return t < p.timestamp;
+                                             });
+    std::copy(firstNewIt, points.end(), std::back_inserter(salientPoints));
   }
 
   PRINT_CH_DEBUG("Behaviors", "SalientPointsComponent.GetSalientPointSinceTime.CopiedElements",
@@ -103,6 +142,19 @@ void SalientPointsComponent::GetSalientPointSinceTime(std::list<Vision::SalientP
 
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const Vision::SalientPoint* SalientPointsComponent::GetLatestSalientPoint(const Vision::SalientPointType& type,
+                                                                          const RobotTimeStamp_t timestamp) const
+{
+  auto it = _salientPoints.find(type);
+  if ((it == _salientPoints.end()) || !it->second.hasLatest) {
+    return nullptr;
+  }
+  const Vision::SalientPoint& latest = it->second.latest;
+  return (latest.timestamp > (TimeStamp_t)timestamp) ? &latest : nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool SalientPointsComponent::SalientPointDetected(const Vision::SalientPointType& type, const RobotTimeStamp_t timestamp) const
 {
 
@@ -158,23 +210,8 @@ bool SalientPointsComponent::SalientPointDetected(const Vision::SalientPointType
     }
   }
 
-  auto it = _salientPoints.find(type);
-  // let's see if we have the right type
-  if (it != _salientPoints.end()) {
-    const auto& salientPointsList = it->second;
-    // find a SalientPoint with a greater timestamp
-    return std::any_of(salientPointsList.begin(), salientPointsList.end(),
-                       [timestamp](const Vision::SalientPoint& p) {
-                         return p.timestamp > timestamp;
-                       }
-    );
-  }
-  else {
-    return false;
-  }
-
+  return (GetLatestSalientPoint(type, timestamp) != nullptr);
 }
 
-
 } // namespace Vector
 } // namespace Anki
@@ -26,6 +26,7 @@
 #include "util/helpers/noncopyable.h"
 #include "util/signals/simpleSignal_fwd.h"
 
+#include <deque>
 #include <list>
 #include <map>
 
@@ -62,15 +63,21 @@ public:
 
   ~SalientPointsComponent() override = default;
 
-  // Get all the SalientPoints of a specific type since a specific timestamp
+  // Get all the SalientPoints of a specific type since a specific timestamp, oldest first
   void GetSalientPointSinceTime(std::list<Vision::SalientPoint>& salientPoints,
                                 const Vision::SalientPointType& type, const RobotTimeStamp_t timestamp = 0) const;
 
   // Returns true wheter a SalientPoint of a spefic type has been seen since a specific timestamp
   bool SalientPointDetected(const Vision::SalientPointType& type, const RobotTimeStamp_t timestamp = 0) const;
 
-  // Adds a list of SalientPoint. All the points are stored according to their type. If a specific list of points is
-  // already stored for a type, it will be replaced.
+  // Returns the most recent SalientPoint of a specific type seen since a specific timestamp (the largest one if
+  // several were seen at that time), or nullptr if there is none. The pointer is valid until points are next added.
+  const Vision::SalientPoint* GetLatestSalientPoint(const Vision::SalientPointType& type,
+                                                    const RobotTimeStamp_t timestamp = 0) const;
+
+  // Adds a list of SalientPoint. All the points are stored according to their type. A point close to one of the same
+  // type seen in an earlier image recently is taken to be the same thing seen again, and replaces it. Points are
+  // kept for a limited time.
   void AddSalientPoints(const std::list<Vision::SalientPoint>& c);
 
 private:
@@ -79,9 +86,20 @@ private:
   // Attributes
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-  // a list of the latest salient points organized per type. The points are replaced every time new ones of the
-  // same type arrive
-  std::map<Vision::SalientPointType, std::list<Vision::SalientPoint>> _salientPoints;
+  struct PointsOfType
+  {
+    // sorted by timestamp, oldest first
+    std::deque<Vision::SalientPoint> points;
+
+    // the latest point (the largest one if several were seen at that time), so behaviors don't have to look for it
+    Vision::SalientPoint latest;
+    bool hasLatest = false;
+  };
+
+  void AddSalientPoint(PointsOfType& pointsOfType, const Vision::SalientPoint& salientPoint);
+
+  // the recent salient points organized per type
+  std::map<Vision::SalientPointType, PointsOfType> _salientPoints;
 
   mutable float _timeSinceLastObservation = 0; // TODO this is temporary for testing
 
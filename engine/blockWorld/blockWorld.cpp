@@ -104,6 +104,13 @@ namespace Vector {
     if (ANKI_DEVELOPER_CODE) {
       SanityCheckBookkeeping();
     }
+    
+    // Objects are mostly markers and poses in the base class, so a block is a fair size for any of them
+    size_t numObjects = _connectedObjects.size();
+    for (const auto& objectsByOrigin : _locatedObjects) {
+      numObjects += objectsByOrigin.second.size();
+    }
+    _memoryAccount.Set(numObjects * sizeof(Block));
   }
   
 
@@ -317,6 +324,10 @@ namespace Vector {
       if (!filter.ConsiderOrigin(originID, currRobotOriginId)) {
         continue;
       }
+      if (filter.HasAllowedTypes() &&
+          !filter.MayConsiderTypes(GetLocatedObjectsIndex(originID, objectsByOrigin.second).GetTypeMask())) {
+        continue;
+      }
       for (const auto& object : objectsByOrigin.second) {
         if (nullptr == object) {
           LOG_ERROR("BlockWorld.FindLocatedObjectHelper.NullObject", "origin %d", originID);
@@ -408,31 +419,78 @@ namespace Vector {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   ObservableObject* BlockWorld::FindLocatedObjectClosestToHelper(const Pose3d& pose,
                                                                  const Vec3f&  distThreshold,
-                                                                 const BlockWorldFilter& filterIn) const
+                                                                 const BlockWorldFilter& filter) const
   {
-    // TODO: Keep some kind of OctTree data structure to make these queries faster?
-
     // Note: This function only considers the magnitude of distThreshold, not the individual elements (see VIC-12526)
     float closestDist = distThreshold.Length();
+    ObservableObject* closestObject = nullptr;
 
-    BlockWorldFilter filter(filterIn);
-    filter.AddFilterFcn([&pose, &closestDist](const ObservableObject* current)
-                        {
-                          float dist = 0.f;
-                          if (!ComputeDistanceBetween(pose, current->GetPose(), dist)) {
-                            LOG_ERROR("BlockWorld.FindLocatedObjectClosestToHelper.FilterFcn",
-                                      "Failed to compute distance between input pose and block pose");
-                            return false;
-                          }
-                          if(dist < closestDist) {
-                            closestDist = dist;
-                            return true;
-                          } else {
-                            return false;
-                          }
-                        });
+    const auto& originList = _robot->GetPoseOriginList();
+    const auto& currRobotOriginId = originList.GetCurrentOriginID();
 
-    return FindLocatedObjectHelper(filter);
+    for(const auto & objectsByOrigin : _locatedObjects) {
+      const auto& originID = objectsByOrigin.first;
+      if (!filter.ConsiderOrigin(originID, currRobotOriginId)) {
+        continue;
+      }
+
+      const LocatedObjectsIndex& index = GetLocatedObjectsIndex(originID, objectsByOrigin.second);
+      if (!filter.MayConsiderTypes(index.GetTypeMask())) {
+        continue;
+      }
+
+      // Objects are visited out of container order, so break ties within an origin the way a linear search would:
+      // in favor of the object that comes first
+      bool haveClosestInOrigin = false;
+      u32 closestContainerIndex = 0;
+      auto considerCandidate = [&](ObservableObject* object, u32 containerIndex, float dist) {
+        const bool isCloser = (dist < closestDist) ||
+                              (haveClosestInOrigin && (dist == closestDist) && (containerIndex < closestContainerIndex));
+        if (isCloser && filter.ConsiderType(object->GetType()) && filter.ConsiderObject(object)) {
+          closestDist = dist;
+          closestObject = object;
+          closestContainerIndex = containerIndex;
+          haveClosestInOrigin = true;
+        }
+      };
+
+      auto considerExactly = [&](ObservableObject* object, u32 containerIndex) {
+        float dist = 0.f;
+        if (!ComputeDistanceBetween(pose, object->GetPose(), dist)) {
+          LOG_ERROR("BlockWorld.FindLocatedObjectClosestToHelper.FilterFcn",
+                    "Failed to compute distance between input pose and block pose");
+          return;
+        }
+        considerCandidate(object, containerIndex, dist);
+      };
+
+      Pose3d poseWrtOrigin;
+      const bool isPoseInOrigin = originList.ContainsOriginID(originID) &&
+                                  pose.GetWithRespectTo(originList.GetOriginByID(originID), poseWrtOrigin);
+      if (isPoseInOrigin) {
+        // Only objects no farther away in x than the closest one so far can be closer
+        const Point3f& T = poseWrtOrigin.GetTranslation();
+        index.ForEachOutwardFromX(T.x(), closestDist, [&](const LocatedObjectsIndex::Entry& entry) {
+          considerCandidate(entry.object, entry.containerIndex, (entry.position - T).Length());
+        });
+        for (const auto& entry : index.GetUnindexedEntries()) {
+          considerExactly(entry.object, entry.containerIndex);
+        }
+      } else {
+        for (u32 i = 0; i < objectsByOrigin.second.size(); ++i) {
+          ObservableObject* object = objectsByOrigin.second[i].get();
+          if (nullptr == object) {
+            LOG_ERROR("BlockWorld.FindLocatedObjectClosestToHelper.NullObject", "origin %d", originID);
+            continue;
+          }
+          if (filter.ConsiderType(object->GetType()) && filter.ConsiderObject(object)) {
+            considerExactly(object, i);
+          }
+        }
+      }
+    }
+
+    return closestObject;
   }
 
 
@@ -507,6 +565,32 @@ namespace Vector {
                         });
   }
   
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  const LocatedObjectsIndex& BlockWorld::GetLocatedObjectsIndex(PoseOriginID_t originID,
+                                                                const ObjectsContainer_t& objectsInOrigin) const
+  {
+    if (!_areLocatedObjectsIndexesValid) {
+      // Forget origins that are gone, and rebuild the rest as they are next searched
+      for (auto it = _locatedObjectsIndexes.begin(); it != _locatedObjectsIndexes.end(); ) {
+        if (_locatedObjects.count(it->first) == 0) {
+          it = _locatedObjectsIndexes.erase(it);
+        } else {
+          it->second.Invalidate();
+          ++it;
+        }
+      }
+      _areLocatedObjectsIndexesValid = true;
+    }
+
+    LocatedObjectsIndex& index = _locatedObjectsIndexes[originID];
+    if (!index.IsValid()) {
+      const auto& originList = _robot->GetPoseOriginList();
+      const Pose3d* origin = originList.ContainsOriginID(originID) ? &originList.GetOriginByID(originID) : nullptr;
+      index.Rebuild(origin, objectsInOrigin);
+    }
+    return index;
+  }
+  
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   Result BlockWorld::BroadcastObjectObservation(const ObservableObject* observedObject) const
   {
@@ -672,6 +756,7 @@ namespace Vector {
       
       // Delete from old origin
       objectsInOldOrigin.erase(objectIt);
+      InvalidateLocatedObjectsIndexes();
     }
     
     // Delete any now-zombie origins
@@ -796,6 +881,7 @@ namespace Vector {
       // Use all of oldObject's time bookkeeping, then update the pose and pose state
       newObject->SetObservationTimes(oldObject);
       newObject->SetPose(newPose, oldObject->GetLastPoseUpdateDistance(), oldObject->GetPoseState());
+      InvalidateLocatedObjectsIndexes();
 
       if(addNewObject)
       {
@@ -824,6 +910,7 @@ namespace Vector {
       // Note that we decide to not notify of objects that merge (passive matched by pose), because the old ID in the
       // old origin is not in the current one.
       _locatedObjects.erase(oldOriginID);
+      InvalidateLocatedObjectsIndexes();
     }
 
     // Notify the world about the objects in the new coordinate frame, in case
@@ -844,6 +931,7 @@ namespace Vector {
                  originIt->first, originIt->second.size());
         // With their tanks, and their bombs, and their bombs, and their guns
         originIt = _locatedObjects.erase(originIt);
+        InvalidateLocatedObjectsIndexes();
       } else {
         ++originIt;
       }
@@ -1034,6 +1122,7 @@ namespace Vector {
         matchingObject->SetObservationTimes(objSeen.get());
         const float distToObjSeen = objSeen->GetLastPoseUpdateDistance();
         matchingObject->SetPose(objSeen->GetPose(), distToObjSeen, PoseState::Known);
+        InvalidateLocatedObjectsIndexes();
         
         // If we matched an object from a previous origin, we need to move it into the current origin
         if (matchingObjectOrigin != _robot->GetWorldOriginID()) {
@@ -1504,6 +1593,7 @@ namespace Vector {
     }
     
     objectsInThisOrigin.push_back(object); // store the new object, this increments refcount
+    InvalidateLocatedObjectsIndexes();
 
     // set the viz manager on this new object
     object->SetVizManager(_robot->GetContext()->GetVizManager());
@@ -1596,6 +1686,7 @@ namespace Vector {
     
     const auto& newObjectPose = makeWrtOrigin ? poseWrtOrigin : newPose;
     object->SetPose(newObjectPose, object->GetLastPoseUpdateDistance(), poseState);
+    InvalidateLocatedObjectsIndexes();
     
     // Inform map component of the updated pose
     _robot->GetMapComponent().UpdateObjectPose(*object, &object->GetPose(), object->GetPoseState());
@@ -1639,6 +1730,9 @@ namespace Vector {
     // deselect blockworld's selected object, if it has one
     DeselectCurrentObject();
 
+    // searches of the current origin now return a different set of objects
+    ++_locatedObjectsGeneration;
+
     // notify about updated object states
     BroadcastLocatedObjectStates();
   }
@@ -1702,7 +1796,7 @@ namespace Vector {
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-  Result BlockWorld::UpdateObservedMarkers(const std::list<Vision::ObservedMarker>& currentObsMarkers)
+  Result BlockWorld::UpdateObservedMarkers(const std::vector<Vision::ObservedMarker>& currentObsMarkers)
   {
     ANKI_CPU_PROFILE("BlockWorld::UpdateObservedMarkers");
 
@@ -1993,26 +2087,55 @@ namespace Vector {
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-  namespace {
-
-  // Helper to create a filter common to several methods below
-  static inline BlockWorldFilter GetIntersectingObjectsFilter(const Quad2f& quad, f32 padding_mm,
-                                                              const BlockWorldFilter& filterIn)
+  template<class ObjectPtr>
+  void BlockWorld::FindLocatedIntersectingObjectsHelper(const Quad2f& quad,
+                                                        f32 padding_mm,
+                                                        const BlockWorldFilter& filter,
+                                                        std::vector<ObjectPtr>& result) const
   {
-    BlockWorldFilter filter(filterIn);
-    filter.AddFilterFcn([&quad,padding_mm](const ObservableObject* object) {
-      // Get quad of object and check for intersection
-      Quad2f quadExist = object->GetBoundingQuadXY(object->GetPose(), padding_mm);
-      if( quadExist.Intersects(quad) ) {
-        return true;
-      } else {
-        return false;
+    const auto& currRobotOriginId = _robot->GetPoseOriginList().GetCurrentOriginID();
+
+    std::vector<const LocatedObjectsIndex::Entry*> candidates;
+    for (const auto& objectsByOrigin : _locatedObjects) {
+      const auto& originID = objectsByOrigin.first;
+      if (!filter.ConsiderOrigin(originID, currRobotOriginId)) {
+        continue;
+      }
+
+      const LocatedObjectsIndex& index = GetLocatedObjectsIndex(originID, objectsByOrigin.second);
+      if (!filter.MayConsiderTypes(index.GetTypeMask())) {
+        continue;
       }
-    });
 
-    return filter;
+      // An object's (padded, rotated) corners are within maxRadius + sqrt(3)*padding of its center, and its bounding
+      // quad within sqrt(2) times that, so objects centered any farther than that from the quad in x can't intersect it
+      const f32 margin = static_cast<f32>(M_SQRT2) * (index.GetMaxRadius() + 2.f * std::max(padding_mm, 0.f));
+
+      candidates.clear();
+      index.ForEachInRangeX(quad.GetMinX() - margin, quad.GetMaxX() + margin,
+                            [&candidates](const LocatedObjectsIndex::Entry& entry) {
+                              candidates.push_back(&entry);
+                            });
+      for (const auto& entry : index.GetUnindexedEntries()) {
+        candidates.push_back(&entry);
+      }
+
+      // Return matches in the same order as a linear search
+      std::sort(candidates.begin(), candidates.end(),
+                [](const LocatedObjectsIndex::Entry* a, const LocatedObjectsIndex::Entry* b) {
+                  return a->containerIndex < b->containerIndex;
+                });
+
+      for (const auto* entry : candidates) {
+        ObservableObject* object = entry->object;
+        if (filter.ConsiderType(object->GetType()) &&
+            filter.ConsiderObject(object) &&
+            object->GetBoundingQuadXY(object->GetPose(), padding_mm).Intersects(quad)) {
+          result.push_back(object);
+        }
+      }
+    }
   }
-  };
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   void BlockWorld::FindLocatedIntersectingObjects(const ObservableObject* objectSeen,
@@ -2021,7 +2144,7 @@ namespace Vector {
                                            const BlockWorldFilter& filter) const
   {
     Quad2f quadSeen = objectSeen->GetBoundingQuadXY(objectSeen->GetPose(), padding_mm);
-    FindLocatedMatchingObjects(GetIntersectingObjectsFilter(quadSeen, padding_mm, filter), intersectingExistingObjects);
+    FindLocatedIntersectingObjectsHelper(quadSeen, padding_mm, filter, intersectingExistingObjects);
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2031,7 +2154,7 @@ namespace Vector {
                                            const BlockWorldFilter& filter)
   {
     Quad2f quadSeen = objectSeen->GetBoundingQuadXY(objectSeen->GetPose(), padding_mm);
-    FindLocatedMatchingObjects(GetIntersectingObjectsFilter(quadSeen, padding_mm, filter), intersectingExistingObjects);
+    FindLocatedIntersectingObjectsHelper(quadSeen, padding_mm, filter, intersectingExistingObjects);
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2040,7 +2163,7 @@ namespace Vector {
                                            f32 padding_mm,
                                            const BlockWorldFilter& filterIn) const
   {
-    FindLocatedMatchingObjects(GetIntersectingObjectsFilter(quad, padding_mm, filterIn), intersectingExistingObjects);
+    FindLocatedIntersectingObjectsHelper(quad, padding_mm, filterIn, intersectingExistingObjects);
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2049,7 +2172,7 @@ namespace Vector {
                                            f32 padding_mm,
                                            const BlockWorldFilter& filterIn)
   {
-    FindLocatedMatchingObjects(GetIntersectingObjectsFilter(quad, padding_mm, filterIn), intersectingExistingObjects);
+    FindLocatedIntersectingObjectsHelper(quad, padding_mm, filterIn, intersectingExistingObjects);
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -2162,6 +2285,7 @@ namespace Vector {
           if (object == nullptr) {
             LOG_ERROR("BlockWorld.DeleteLocatedObjects.NullObject", "origin %d", crntOriginID);
             objectIter = objectContainer.erase(objectIter);
+            InvalidateLocatedObjectsIndexes();
           } else if (filter.ConsiderType(object->GetType()) &&
                      filter.ConsiderObject(object)) {
             // clear objects in current origin (others should not be needed)
@@ -2184,6 +2308,7 @@ namespace Vector {
             }
 
             objectIter = objectContainer.erase(objectIter);
+            InvalidateLocatedObjectsIndexes();
           } else {
             ++objectIter;
           }
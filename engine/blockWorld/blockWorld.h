@@ -17,12 +17,14 @@
 
 #include "util/entityComponent/iDependencyManagedComponent.h"
 #include "engine/robotComponents_fwd.h"
+#include "engine/blockWorld/locatedObjectsIndex.h"
 
 #include "clad/types/objectTypes.h"
 
 #include "coretech/common/engine/robotTimeStamp.h"
 #include "coretech/vision/engine/observableObjectLibrary.h"
 
+#include "util/memoryAccounting/memoryAccounting.h"
 #include "util/signals/simpleSignal_fwd.h"
 
 #include <map>
@@ -86,7 +88,7 @@ namespace Anki
       
       // Update the BlockWorld's state by processing all queued ObservedMarkers
       // and updating robot's and objects' poses from them.
-      Result UpdateObservedMarkers(const std::list<Vision::ObservedMarker>& observedMarkers);
+      Result UpdateObservedMarkers(const std::vector<Vision::ObservedMarker>& observedMarkers);
       
       ObjectID CreateFixedCustomObject(const Pose3d& p, const f32 xSize_mm, const f32 ySize_mm, const f32 zSize_mm);
 
@@ -188,6 +190,10 @@ namespace Anki
       using ModifierFcn = std::function<void(ObservableObject*)>;
       inline void ModifyLocatedObjects(const ModifierFcn& modifierFcn, const BlockWorldFilter& filter);
       
+      // Changes whenever a located object is added, removed, or has its pose set, or ModifyLocatedObjects is
+      // called. Lets callers that cache results computed from located objects know when to recompute them.
+      u32 GetLocatedObjectsGeneration() const { return _locatedObjectsGeneration; }
+      
       // Returns (in arguments) all objects matching a filter, among objects that are currently located (their pose
       // is valid in the origins matching the filter)
       // NOTE: does not clear result (thus can be used multiple times with the same vector)
@@ -388,6 +394,20 @@ namespace Anki
                                                              const Radians& angleThreshold,
                                                              const BlockWorldFilter& filter) const;
       
+      // Region search shared by the FindLocatedIntersectingObjects overloads
+      template<class ObjectPtr>
+      void FindLocatedIntersectingObjectsHelper(const Quad2f& quad,
+                                                f32 padding_mm,
+                                                const BlockWorldFilter& filter,
+                                                std::vector<ObjectPtr>& result) const;
+      
+      // Index of the objects located in the given origin, rebuilt first if located objects changed since it was built
+      const LocatedObjectsIndex& GetLocatedObjectsIndex(PoseOriginID_t originID,
+                                                        const ObjectsContainer_t& objectsInOrigin) const;
+      
+      // Must be called whenever a located object is added, removed, or has its pose set
+      void InvalidateLocatedObjectsIndexes() { _areLocatedObjectsIndexesValid = false; ++_locatedObjectsGeneration; }
+      
       // Helper for finding the object with a specified ID in the given container.
       // Returns an iterator to that object's entry.
       ObjectsContainer_t::const_iterator FindInContainerWithID(const ObjectsContainer_t& container,
@@ -468,6 +488,16 @@ namespace Anki
       // connected objects container.
       ObjectsByOrigin_t _locatedObjects;
       
+      // Search indexes over _locatedObjects, built lazily per origin (see GetLocatedObjectsIndex)
+      mutable std::map<PoseOriginID_t, LocatedObjectsIndex> _locatedObjectsIndexes;
+      mutable bool _areLocatedObjectsIndexesValid = false;
+      
+      // Incremented along with invalidating the indexes (see GetLocatedObjectsGeneration)
+      u32 _locatedObjectsGeneration = 0;
+      
+      // Estimate of the memory held by the connected and located object instances, updated every tick
+      Util::MemoryAccount _memoryAccount{Util::MemoryTag::BlockWorld};
+      
       ObjectID _selectedObjectID;
       
       std::vector<Signal::SmartHandle> _eventHandles;
@@ -527,6 +557,7 @@ namespace Anki
         PRINT_NAMED_WARNING("BlockWorld.ModifyLocatedObjects.NullModifierFcn", "Consider just using FilterLocatedObjects?");
       }
       FindLocatedObjectHelper(filter, modifierFcn, false);
+      ++_locatedObjectsGeneration;
     }
     
     // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
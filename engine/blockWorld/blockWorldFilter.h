@@ -47,6 +47,14 @@ namespace Vector {
     bool ConsiderType(ObjectType type) const;
     bool ConsiderObject(const ObservableObject* object) const; // Checks ID and runs FilterFcn(object)
     
+    // Bit for a type in type masks. Several types may share a bit, so a mask can rule types out but not in.
+    static u64 GetTypeBit(ObjectType type) { return u64{1} << (static_cast<u32>(type) % 64); }
+    
+    // False if none of the types in typeMask (a union of GetTypeBit()) could pass ConsiderType, e.g. so that
+    // BlockWorld can skip an origin without looking at its objects
+    bool MayConsiderTypes(u64 typeMask) const;
+    bool HasAllowedTypes() const { return !_allowedTypes.empty(); }
+    
     // Set the entire set of IDs, types, or origins to ignore in one go.
     void SetIgnoreIDs(std::set<ObjectID>&& IDs);
     void SetIgnoreTypes(std::set<ObjectType>&& types);
@@ -92,6 +100,7 @@ namespace Vector {
   protected:
     std::set<ObjectID>             _ignoreIDs,      _allowedIDs;
     std::set<ObjectType>           _ignoreTypes,    _allowedTypes;
+    u64                            _allowedTypesMask = 0; // union of GetTypeBit() of _allowedTypes
     std::set<PoseOriginID_t>       _ignoreOrigins,  _allowedOrigins;
     
     std::list<FilterFcn>    _filterFcns;
@@ -124,6 +133,10 @@ namespace Vector {
   
   inline void BlockWorldFilter::SetAllowedTypes(std::set<ObjectType>&& types) {
     _allowedTypes = types;
+    _allowedTypesMask = 0;
+    for(const auto type : _allowedTypes) {
+      _allowedTypesMask |= GetTypeBit(type);
+    }
   }
   
   inline void BlockWorldFilter::SetAllowedOrigins(std::set<PoseOriginID_t>&& origins) {
@@ -167,6 +180,7 @@ namespace Vector {
   inline void BlockWorldFilter::AddAllowedType(ObjectType type) {
     assert(_ignoreTypes.count(type) == 0); // Should not be in both lists
     _allowedTypes.insert(type);
+    _allowedTypesMask |= GetTypeBit(type);
   }
   
   inline void BlockWorldFilter::AddAllowedOrigin(PoseOriginID_t originID) {
@@ -215,9 +229,17 @@ namespace Vector {
   }
   
   inline bool BlockWorldFilter::ConsiderType(ObjectType type) const {
+    // Most types are ruled out by the mask without searching the set
+    if(!_allowedTypes.empty() && ((_allowedTypesMask & GetTypeBit(type)) == 0)) {
+      return false;
+    }
     return ConsiderHelper(_ignoreTypes, _allowedTypes, type);
   }
   
+  inline bool BlockWorldFilter::MayConsiderTypes(u64 typeMask) const {
+    return _allowedTypes.empty() || ((_allowedTypesMask & typeMask) != 0);
+  }
+  
   inline bool BlockWorldFilter::ConsiderObject(const ObservableObject* object) const
   {
     DEV_ASSERT(nullptr != object, "BlockWorldFilter.ConsiderObject.NullObject");
@@ -0,0 +1,61 @@
+/**
+ * File: locatedObjectsIndex.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Index over the objects BlockWorld has located in one origin (see header)
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "engine/blockWorld/locatedObjectsIndex.h"
+
+#include "engine/blockWorld/blockWorldFilter.h"
+#include "engine/cozmoObservableObject.h"
+
+namespace Anki {
+namespace Vector {
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  void LocatedObjectsIndex::Rebuild(const Pose3d* origin, const std::vector<std::shared_ptr<ObservableObject>>& objects)
+  {
+    _entries.clear();
+    _unindexed.clear();
+    _typeMask = 0;
+    _maxRadius = 0.f;
+
+    for(u32 i = 0; i < objects.size(); ++i)
+    {
+      ObservableObject* object = objects[i].get();
+      if(nullptr == object) {
+        // BlockWorld's searches report these
+        continue;
+      }
+
+      _typeMask |= BlockWorldFilter::GetTypeBit(object->GetType());
+
+      const Pose3d& pose = object->GetPose();
+      if((nullptr != origin) && pose.IsChildOf(*origin))
+      {
+        _entries.push_back(Entry{object, i, pose.GetTranslation()});
+        for(const auto& corner : object->GetCanonicalCorners()) {
+          _maxRadius = std::max(_maxRadius, corner.Length());
+        }
+      }
+      else
+      {
+        _unindexed.push_back(Entry{object, i, Point3f{}});
+      }
+    }
+
+    std::sort(_entries.begin(), _entries.end(), [](const Entry& a, const Entry& b) {
+      return a.position.x() < b.position.x();
+    });
+
+    _isValid = true;
+  }
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,127 @@
+/**
+ * File: locatedObjectsIndex.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Index over the objects BlockWorld has located in one origin, used to narrow down searches before
+ *              running a BlockWorldFilter's checks and filter functions on each object.
+ *
+ *              Keeps a mask of the types present (see BlockWorldFilter::GetTypeBit), so that searches for types an
+ *              origin doesn't have skip it entirely, and the objects whose poses are directly w.r.t. the origin sorted
+ *              by x, so that closest-object and region searches only look at objects that could be close enough.
+ *              Objects with any other parent (e.g. a carried cube, which moves with the lift) are kept aside and
+ *              always checked.
+ *
+ *              The index is a snapshot: BlockWorld invalidates it whenever it adds, removes or moves a located
+ *              object, and rebuilds it on the next search.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Anki_Cozmo_LocatedObjectsIndex_H__
+#define __Anki_Cozmo_LocatedObjectsIndex_H__
+
+#include "coretech/common/engine/math/pose.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <memory>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+  // Forward declaration
+  class ObservableObject;
+
+  class LocatedObjectsIndex
+  {
+  public:
+
+    struct Entry {
+      ObservableObject* object;
+      u32               containerIndex; // position in BlockWorld's container for the origin
+      Point3f           position;       // w.r.t. the origin (only for indexed entries)
+    };
+
+    void Rebuild(const Pose3d* origin, const std::vector<std::shared_ptr<ObservableObject>>& objects);
+    void Invalidate() { _isValid = false; }
+    bool IsValid() const { return _isValid; }
+
+    // Union of BlockWorldFilter::GetTypeBit() of every object in the origin
+    u64 GetTypeMask() const { return _typeMask; }
+
+    // Largest distance from any indexed object's origin to one of its canonical corners
+    f32 GetMaxRadius() const { return _maxRadius; }
+
+    // Objects whose pose is not directly w.r.t. the origin. Searches must check all of these.
+    const std::vector<Entry>& GetUnindexedEntries() const { return _unindexed; }
+
+    // Calls visitFcn(entry) on each indexed entry with minX <= x <= maxX, in order of x
+    template<class VisitFcn>
+    void ForEachInRangeX(f32 minX, f32 maxX, const VisitFcn& visitFcn) const;
+
+    // Calls visitFcn(entry) on indexed entries in order of increasing |entry x - x|, for as long as that is no more
+    // than maxDist. maxDist is re-read after each call, so the visitor can shrink it as it finds closer objects.
+    template<class VisitFcn>
+    void ForEachOutwardFromX(f32 x, const f32& maxDist, const VisitFcn& visitFcn) const;
+
+  private:
+
+    std::vector<Entry> _entries; // sorted by position.x()
+    std::vector<Entry> _unindexed;
+    u64  _typeMask = 0;
+    f32  _maxRadius = 0.f;
+    bool _isValid = false;
+
+    static bool LessX(const Entry& entry, f32 x) { return entry.position.x() < x; }
+  };
+
+# pragma mark - Inlined Implementations
+
+  template<class VisitFcn>
+  void LocatedObjectsIndex::ForEachInRangeX(f32 minX, f32 maxX, const VisitFcn& visitFcn) const
+  {
+    for(auto it = std::lower_bound(_entries.begin(), _entries.end(), minX, LessX);
+        (it != _entries.end()) && (it->position.x() <= maxX); ++it)
+    {
+      visitFcn(*it);
+    }
+  }
+
+  template<class VisitFcn>
+  void LocatedObjectsIndex::ForEachOutwardFromX(f32 x, const f32& maxDist, const VisitFcn& visitFcn) const
+  {
+    // Walk both ways from x, always taking whichever side's next entry is nearer
+    auto above = std::lower_bound(_entries.begin(), _entries.end(), x, LessX);
+    auto below = above;
+    while(true)
+    {
+      const bool haveAbove = (above != _entries.end());
+      const bool haveBelow = (below != _entries.begin());
+      if(!haveAbove && !haveBelow) {
+        return;
+      }
+
+      const f32 distAbove = haveAbove ? (above->position.x() - x) : FLT_MAX;
+      const f32 distBelow = haveBelow ? (x - std::prev(below)->position.x()) : FLT_MAX;
+      if(std::min(distAbove, distBelow) > maxDist) {
+        return;
+      }
+
+      if(distAbove <= distBelow) {
+        visitFcn(*above);
+        ++above;
+      } else {
+        --below;
+        visitFcn(*below);
+      }
+    }
+  }
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Cozmo_LocatedObjectsIndex_H__
@@ -12,31 +12,45 @@
 #include "engine/comms/robotConnectionData.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+
 
 namespace Anki {
 namespace Vector {
 
 namespace {
 static const uint32_t kQueueSizeWarningThreshold = 1024 * 1024;
+
+// Messages the queue has room for before it first grows
+static const size_t kInitialQueueCapacity = 64;
+
+// Once this many popped messages are left at the front of a queue that never empties, they are erased
+static const size_t kMinPoppedMessagesToCompact = 64;
+}
+
+RobotConnectionData::RobotConnectionData()
+{
+  _arrivedMessages.reserve(kInitialQueueCapacity);
 }
   
 bool RobotConnectionData::HasMessages()
 {
   std::lock_guard<std::mutex> lockGuard(_messageMutex);
-  return !_arrivedMessages.empty();
+  return _nextMessageIdx < _arrivedMessages.size();
 }
   
 RobotConnectionMessageData RobotConnectionData::PopNextMessage()
 {
   std::unique_lock<std::mutex> lockGuard(_messageMutex);
   
-  DEV_ASSERT(!_arrivedMessages.empty(), "RobotConnectionData.PopNextMessage.NoMessages");
-  if (_arrivedMessages.empty())
+  const bool hasMessages = (_nextMessageIdx < _arrivedMessages.size());
+  DEV_ASSERT(hasMessages, "RobotConnectionData.PopNextMessage.NoMessages");
+  if (!hasMessages)
   {
     return RobotConnectionMessageData();
   }
   
-  RobotConnectionMessageData nextMessage = std::move(_arrivedMessages.front());
+  RobotConnectionMessageData nextMessage = std::move(_arrivedMessages[_nextMessageIdx]);
   const uint32_t nextMessageSize = nextMessage.GetMemorySize();
   const bool queueSizeOK = _queueSize >= nextMessageSize;
 
@@ -48,7 +62,18 @@ RobotConnectionMessageData RobotConnectionData::PopNextMessage()
     // error will be printed below (outside lock)
   }
   
-  _arrivedMessages.pop_front();
+  ++_nextMessageIdx;
+  if (_nextMessageIdx == _arrivedMessages.size())
+  {
+    _arrivedMessages.clear();
+    _nextMessageIdx = 0;
+  }
+  else if ((_nextMessageIdx >= kMinPoppedMessagesToCompact) && (2 * _nextMessageIdx >= _arrivedMessages.size()))
+  {
+    // Messages keep arriving faster than they are popped. Moving the rest to the front doesn't allocate either
+    _arrivedMessages.erase(_arrivedMessages.begin(), _arrivedMessages.begin() + _nextMessageIdx);
+    _nextMessageIdx = 0;
+  }
   
   // unlock mutex before doing logging and statistics
   lockGuard.unlock();
@@ -77,22 +102,46 @@ void RobotConnectionData::PushArrivedMessage(const uint8_t* buffer, uint32_t num
     messageType = RobotConnectionMessageType::Disconnect;
   }
 
+  if (messageType == RobotConnectionMessageType::Data)
   {
-    std::lock_guard<std::mutex> lockGuard(_messageMutex);
-    if (messageType == RobotConnectionMessageType::Data)
+    if (numBytes > RobotMessageBuffer::kCapacity)
     {
-      // Note we don't bother passing the MessageType::Data into this constructor because that's the default
-      _arrivedMessages.emplace_back(buffer, numBytes, address, TRACK_INCOMING_PACKET_LATENCY_TIMESTAMP_MS());
+      PRINT_NAMED_ERROR("RobotConnectionData.PushArrivedMessage.MessageTooLarge",
+                        "Dropping %u byte message, the most a buffer holds is %u bytes",
+                        numBytes, RobotMessageBuffer::kCapacity);
+      return;
     }
-    else
-    {
-      _arrivedMessages.emplace_back(messageType, address, TRACK_INCOMING_PACKET_LATENCY_TIMESTAMP_MS());
-    }
-    _queueSize += _arrivedMessages.back().GetMemorySize();
+    RobotMessageBufferPtr messageBuffer = _bufferPool.Acquire();
+    std::copy(buffer, buffer + numBytes, messageBuffer->data.begin());
+    messageBuffer->size = numBytes;
+    PushArrivedMessage(std::move(messageBuffer), address);
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lockGuard(_messageMutex);
+    PushArrivedMessageInternal(RobotConnectionMessageData(messageType, address, TRACK_INCOMING_PACKET_LATENCY_TIMESTAMP_MS()));
   }
 
   UpdateQueueSizeStatistics();    
 }
+
+void RobotConnectionData::PushArrivedMessage(RobotMessageBufferPtr buffer, const Util::TransportAddress& address)
+{
+  {
+    std::lock_guard<std::mutex> lockGuard(_messageMutex);
+    // Note we don't bother passing the MessageType::Data into this constructor because that's the default
+    PushArrivedMessageInternal(RobotConnectionMessageData(std::move(buffer), address, TRACK_INCOMING_PACKET_LATENCY_TIMESTAMP_MS()));
+  }
+
+  UpdateQueueSizeStatistics();
+}
+
+void RobotConnectionData::PushArrivedMessageInternal(RobotConnectionMessageData&& message)
+{
+  _queueSize += message.GetMemorySize();
+  _arrivedMessages.push_back(std::move(message));
+}
   
 void RobotConnectionData::ReceiveData(const uint8_t* buffer, unsigned int size, const Util::TransportAddress& sourceAddress)
 {
@@ -116,6 +165,7 @@ void RobotConnectionData::Clear()
   {
     std::lock_guard<std::mutex> lockGuard(_messageMutex);
     _arrivedMessages.clear();
+    _nextMessageIdx = 0;
     _queueSize = 0;
   }
   
@@ -13,18 +13,21 @@
 #define __Cozmo_Basestation_Comms_RobotConnectionData_H_
 
 #include "engine/comms/robotConnectionMessageData.h"
+#include "engine/comms/robotMessageBufferPool.h"
 #include "util/helpers/noncopyable.h"
 #include "util/transport/iNetTransportDataReceiver.h"
 #include "util/transport/transportAddress.h"
 
-#include <deque>
 #include <mutex>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
 
 class RobotConnectionData : Util::noncopyable, public Anki::Util::INetTransportDataReceiver {
 public:
+  RobotConnectionData();
+
   enum class State
   {
     Disconnected,
@@ -39,6 +42,8 @@ public:
   bool HasMessages();
   RobotConnectionMessageData PopNextMessage();
   void PushArrivedMessage(const uint8_t* buffer, uint32_t numBytes, const Util::TransportAddress& address);
+  // Takes a data message already received into a buffer from GetBufferPool(), without copying it
+  void PushArrivedMessage(RobotMessageBufferPtr buffer, const Util::TransportAddress& address);
   void Clear();
   void QueueConnectionDisconnect();
 
@@ -47,12 +52,21 @@ public:
   
   Util::TransportAddress GetAddress() const { return _address; };
   void SetAddress(const Util::TransportAddress& address) { _address = address; }
+
+  // Where data messages are received into. Outlives every message and buffer queued here
+  RobotMessageBufferPool& GetBufferPool() { return _bufferPool; }
+  const RobotMessageBufferPool& GetBufferPool() const { return _bufferPool; }
     
   virtual void ReceiveData(const uint8_t* buffer, unsigned int size, const Util::TransportAddress& sourceAddress) override;
     
 private:
+  // First, so that it is destroyed after the messages holding its buffers
+  RobotMessageBufferPool                  _bufferPool;
   State                                   _currentState = State::Disconnected;
-  std::deque<RobotConnectionMessageData>  _arrivedMessages;
+  // Queued messages are the ones from _nextMessageIdx on. Popped ones are left behind, moved from, until the queue
+  // empties, so that the vector keeps its capacity and pushing doesn't allocate the way a deque's blocks do
+  std::vector<RobotConnectionMessageData> _arrivedMessages;
+  size_t                                  _nextMessageIdx = 0;
   uint32_t                                _queueSize = 0;
   uint32_t                                _maxQueueSize = 0;
   std::mutex                              _messageMutex;
@@ -61,6 +75,9 @@ private:
 
   // call after updating _queueSize to do some logging
   void UpdateQueueSizeStatistics();
+
+  // call with _messageMutex held
+  void PushArrivedMessageInternal(RobotConnectionMessageData&& message);
 };
 
 } // end namespace Vector
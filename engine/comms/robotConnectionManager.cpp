@@ -19,6 +19,7 @@
 #include "anki/cozmo/shared/cozmoConfig.h"
 #include "coretech/messaging/shared/socketConstants.h"
 
+#include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/histogram/histogram.h"
 #include "util/logging/DAS.h"
@@ -26,22 +27,25 @@
 
 #define LOG_CHANNEL "RobotConnectionManager"
 
-// Maximum size of one message
-#define MAX_PACKET_BUFFER_SIZE 2048
-
 
 namespace Anki {
 namespace Vector {
 
 namespace {
 static const int kNumQueueSizeStatsToSendToDas = 4000;
+
+// Messages the ready queue has room for before it first grows
+static const size_t kInitialReadyDataCapacity = 64;
+
+// Messages to the anim process go out together once per tick. Off sends each one in its own datagram right away
+CONSOLE_VAR(bool, kBatchMessagesToAnim, "Network", true);
 }
 
 RobotConnectionManager::RobotConnectionManager(RobotManager* robotManager)
 : _currentConnectionData(new RobotConnectionData())
 , _robotManager(robotManager)
 {
-
+  _readyData.reserve(kInitialReadyDataCapacity);
 }
 
 RobotConnectionManager::~RobotConnectionManager()
@@ -84,6 +88,12 @@ void RobotConnectionManager::SendAndResetQueueStats()
            _queueSizeAccumulator.GetMean(),
            _queueSizeAccumulator.GetMax());
 
+  const auto& bufferPool = GetMessageBufferPool();
+  LOG_INFO("RobotConnectionManager.SendAndResetQueueStats.BufferPool",
+           "%zu messages received, peak %zu of %zu buffers in use, %zu heap allocations",
+           bufferPool.GetNumAcquired(), bufferPool.GetPeakInUse(), bufferPool.GetNumBuffers(),
+           bufferPool.GetNumHeapAllocations());
+
   // clear accumulator so we only send recent stats
   _queueSizeAccumulator.Clear();
 }
@@ -106,6 +116,11 @@ Result RobotConnectionManager::Connect(RobotID_t robotID)
     _udpClient.Disconnect();
   }
 
+  {
+    std::lock_guard<std::mutex> lock(_sendBatchMutex);
+    _sendBatch.Clear();
+  }
+
   const std::string & client_path = ENGINE_ANIM_CLIENT_PATH + std::to_string(robotID);
   const std::string & server_path = ENGINE_ANIM_SERVER_PATH + std::to_string(robotID);
 
@@ -131,6 +146,11 @@ void RobotConnectionManager::DisconnectCurrent()
     _robotID = -1;
   }
 
+  {
+    std::lock_guard<std::mutex> lock(_sendBatchMutex);
+    _sendBatch.Clear();
+  }
+
   _currentConnectionData->SetState(RobotConnectionData::State::Disconnected);
 
   // send connection stats data if there is any
@@ -148,22 +168,77 @@ bool RobotConnectionManager::SendData(const uint8_t* buffer, unsigned int size)
     return false;
   }
 
-  const ssize_t sent = _udpClient.Send((const char *) buffer, size);
-  if (sent != size) {
-    LOG_ERROR("RobotConnectionManager.SendData.Error", "Sent %zd/%d bytes to robot", sent, size);
+  if (kBatchMessagesToAnim && (size <= EngineAnimMessageBatch::kMaxMessageSize))
+  {
+    std::unique_lock<std::mutex> lock(_sendBatchMutex);
+    if (_sendBatch.Append(buffer, size)) {
+      return true;
+    }
+
+    // Full, so send what is there and start the next batch with this message
+    lock.unlock();
+    if (!FlushSendBatch()) {
+      return false;
+    }
+    lock.lock();
+    const bool appended = _sendBatch.Append(buffer, size);
+    DEV_ASSERT(appended, "RobotConnectionManager.SendData.AppendToEmptyBatchFailed");
+    return appended;
+  }
+
+  // Anything already queued has to go first to keep messages in order
+  if (!FlushSendBatch()) {
+    return false;
+  }
+  if (!SendDatagram(buffer, size)) {
     DisconnectCurrent();
     return false;
   }
+  return true;
+}
 
+bool RobotConnectionManager::FlushSendBatch()
+{
+  bool sent = false;
+  {
+    std::lock_guard<std::mutex> lock(_sendBatchMutex);
+    if (_sendBatch.IsEmpty()) {
+      return true;
+    }
+    if (!IsValidConnection()) {
+      _sendBatch.Clear();
+      return false;
+    }
+    sent = SendDatagram(_sendBatch.GetDatagram(), _sendBatch.GetDatagramSize());
+    _sendBatch.Clear();
+  }
+
+  // Not under the lock, since disconnecting clears the batch
+  if (!sent) {
+    DisconnectCurrent();
+  }
+  return sent;
+}
+
+bool RobotConnectionManager::SendDatagram(const uint8_t* buffer, unsigned int size)
+{
+  const ssize_t sent = _udpClient.Send((const char *) buffer, size);
+  if (sent != size) {
+    LOG_ERROR("RobotConnectionManager.SendDatagram.Error", "Sent %zd/%d bytes to robot", sent, size);
+    return false;
+  }
   return true;
 }
 
-void RobotConnectionManager::ProcessArrivedMessages()
+bool RobotConnectionManager::ReceiveArrivedMessages(bool (*isUrgent)(const uint8_t* data, uint32_t size))
 {
   static const Util::TransportAddress addr;
+  RobotMessageBufferPool& bufferPool = _currentConnectionData->GetBufferPool();
+  bool anyUrgent = false;
   while (_udpClient.IsConnected()) {
-    char buf[MAX_PACKET_BUFFER_SIZE];
-    const ssize_t n = _udpClient.Recv(buf, sizeof(buf));
+    // Received straight into the buffer the message is queued and unpacked from
+    RobotMessageBufferPtr buffer = bufferPool.Acquire();
+    const ssize_t n = _udpClient.Recv((char *) buffer->data.data(), buffer->data.size());
     if (n < 0) {
       LOG_ERROR("RobotConnectionManager.ProcessArrivedMessages", "Read error from robot");
       break;
@@ -171,10 +246,20 @@ void RobotConnectionManager::ProcessArrivedMessages()
       //LOG_DEBUG("RobotConnectionManager.ProcessArrivedMessages", "Nothing to read");
       break;
     } else {
-      //LOG_DEBUG("RobotConnectionManager.ProcessArrivedMessages", "Read %zd/%lu from robot", n, sizeof(buf));
-      _currentConnectionData->PushArrivedMessage((const uint8_t *) buf, (uint32_t) n, addr);
+      //LOG_DEBUG("RobotConnectionManager.ProcessArrivedMessages", "Read %zd/%zu from robot", n, buffer->data.size());
+      buffer->size = (uint32_t) n;
+      if ((isUrgent != nullptr) && !anyUrgent) {
+        anyUrgent = isUrgent(buffer->data.data(), buffer->size);
+      }
+      _currentConnectionData->PushArrivedMessage(std::move(buffer), addr);
     }
   }
+  return anyUrgent;
+}
+
+void RobotConnectionManager::ProcessArrivedMessages()
+{
+  ReceiveArrivedMessages(nullptr);
 
   while (_currentConnectionData->HasMessages())
   {
@@ -234,7 +319,7 @@ void RobotConnectionManager::HandleDataMessage(RobotConnectionMessageData& nextM
     return;
   }
 
-  _readyData.push_back(std::move(nextMessage.GetData()));
+  _readyData.push_back(std::move(nextMessage.GetBuffer()));
 }
 
 void RobotConnectionManager::HandleConnectionResponseMessage(RobotConnectionMessageData& nextMessage)
@@ -283,20 +368,34 @@ bool RobotConnectionManager::IsValidConnection() const
   return _currentConnectionData->GetState() == RobotConnectionData::State::Connected;
 }
 
-bool RobotConnectionManager::PopData(std::vector<uint8_t>& data_out)
+bool RobotConnectionManager::PopData(const uint8_t*& out_data, uint32_t& out_size)
 {
-  if (_readyData.empty()) {
+  // Done with the previous one, its buffer goes back to the pool
+  _poppedData.reset();
+
+  if (_nextReadyDataIdx == _readyData.size()) {
+    // Everything was popped, start over at the front without giving up the capacity
+    _readyData.clear();
+    _nextReadyDataIdx = 0;
     return false;
   }
 
-  data_out = std::move(_readyData.front());
-  _readyData.pop_front();
+  _poppedData = std::move(_readyData[_nextReadyDataIdx++]);
+  out_data = _poppedData->data.data();
+  out_size = _poppedData->size;
   return true;
 }
 
 void RobotConnectionManager::ClearData()
 {
   _readyData.clear();
+  _nextReadyDataIdx = 0;
+  _poppedData.reset();
+}
+
+const RobotMessageBufferPool& RobotConnectionManager::GetMessageBufferPool() const
+{
+  return _currentConnectionData->GetBufferPool();
 }
 
 const Anki::Util::Stats::StatsAccumulator& RobotConnectionManager::GetQueuedTimes_ms() const
@@ -13,13 +13,16 @@
 #define __Engine_Comms_RobotConnectionManager_H_
 
 #include "engine/comms/robotConnectionMessageData.h"
+#include "engine/comms/robotMessageBufferPool.h"
+#include "anki/cozmo/shared/engineAnimMessageBatch.h"
 #include "coretech/common/shared/types.h"
 #include "coretech/messaging/shared/LocalUdpClient.h"
 #include "util/stats/recentStatsAccumulator.h"
 #include "util/signals/signalHolder.h"
 
 #include <memory>
-#include <deque>
+#include <mutex>
+#include <vector>
 
 //
 // Enable this to collect socket buffer usage stats at the end of each tick.
@@ -61,12 +64,28 @@ public:
 
   void ProcessArrivedMessages();
 
+  // Receives everything waiting on the socket into the queue ProcessArrivedMessages() works through, without handling
+  // any of it. Returns true if isUrgent said so about any datagram received
+  bool ReceiveArrivedMessages(bool (*isUrgent)(const uint8_t* data, uint32_t size));
+
+  // The socket messages from the robot arrive on, or -1 if not connected
+  int GetSocket() const { return _udpClient.GetSocket(); }
+
+  // Queues the message to go out with the rest of this tick's messages on the next FlushSendBatch(), or sends it
+  // right away if batching is disabled or the message is too large to batch
   bool SendData(const uint8_t* buffer, unsigned int size);
 
-  bool PopData(std::vector<uint8_t>& data_out);
+  // Sends everything queued by SendData() as one datagram. Called once at the end of each engine tick
+  bool FlushSendBatch();
+
+  // The next message from the robot. It stays valid until the next PopData() or ClearData()
+  bool PopData(const uint8_t*& out_data, uint32_t& out_size);
 
   void ClearData();
 
+  // Buffers messages from the robot are received into, with counters to check that receiving stays within them
+  const RobotMessageBufferPool& GetMessageBufferPool() const;
+
   const Anki::Util::Stats::StatsAccumulator& GetQueuedTimes_ms() const;
 
   Result Connect(RobotID_t robotID);
@@ -85,6 +104,8 @@ public:
 private:
   void SendAndResetQueueStats();
 
+  bool SendDatagram(const uint8_t* buffer, unsigned int size);
+
   void HandleDataMessage(RobotConnectionMessageData& nextMessage);
   void HandleConnectionResponseMessage(RobotConnectionMessageData& nextMessage);
   void HandleDisconnectMessage(RobotConnectionMessageData& nextMessage);
@@ -92,7 +113,11 @@ private:
 
   std::unique_ptr<RobotConnectionData>      _currentConnectionData;
   RobotManager*                             _robotManager = nullptr;
-  std::deque<std::vector<uint8_t>>          _readyData;
+  // Same as RobotConnectionData's queue, messages from _nextReadyDataIdx on are the ones still to be popped
+  std::vector<RobotMessageBufferPtr>        _readyData;
+  size_t                                    _nextReadyDataIdx = 0;
+  // The message PopData() last handed out
+  RobotMessageBufferPtr                     _poppedData;
 
 #if TRACK_INCOMING_PACKET_LATENCY
   Util::Stats::RecentStatsAccumulator _queuedTimes_ms = 100; // how many ms between packet arriving and it being passed onto game
@@ -104,6 +129,10 @@ private:
   RobotID_t      _robotID = -1;
   LocalUdpClient _udpClient;
 
+  // Messages sent since the last flush. Guarded since SendData() is not only called from the engine thread
+  EngineAnimMessageBatch _sendBatch;
+  std::mutex             _sendBatchMutex;
+
 #if ANKI_PROFILE_ENGINE_SOCKET_BUFFER_STATS
   using Histogram = Anki::Util::Histogram;
   using HistogramPtr = std::unique_ptr<Histogram>;
@@ -12,11 +12,10 @@
 #ifndef __Cozmo_Basestation_Comms_RobotConnectionMessageData_H_
 #define __Cozmo_Basestation_Comms_RobotConnectionMessageData_H_
 
+#include "engine/comms/robotMessageBufferPool.h"
 #include "util/transport/netTimeStamp.h"
 #include "util/transport/transportAddress.h"
-#include "util/math/numericCast.h"
 
-#include <vector>
 #include <cstdint>
 
 #define TRACK_INCOMING_PACKET_LATENCY 1
@@ -43,8 +42,8 @@ public:
   RobotConnectionMessageData() { };
   
   // This constructor handles messages with data
-  RobotConnectionMessageData(const uint8_t* data, uint32_t numBytes, const Util::TransportAddress& address, Util::NetTimeStamp timeReceived_ms)
-  : _rawMessageData(data, data + numBytes)
+  RobotConnectionMessageData(RobotMessageBufferPtr buffer, const Util::TransportAddress& address, Util::NetTimeStamp timeReceived_ms)
+  : _buffer(std::move(buffer))
   , _address(address)
 #if TRACK_INCOMING_PACKET_LATENCY
   , _timeReceived_ms(timeReceived_ms)
@@ -61,12 +60,11 @@ public:
   { }
   
   RobotConnectionMessageType GetType() const { return _messageType; }
-  // Allows access to the stored data for std::move purposes, so is non-const
-  std::vector<uint8_t>& GetData() { return _rawMessageData; }
+  // Allows access to the stored data for std::move purposes, so is non-const. Null for connection state messages
+  RobotMessageBufferPtr& GetBuffer() { return _buffer; }
 
   // Returns the size in bytes of the raw message data plus overhead
-  uint32_t GetMemorySize() const { return Util::numeric_cast<uint32_t>(
-      _rawMessageData.capacity() * sizeof(decltype(_rawMessageData)::value_type) + sizeof(*this) ); }
+  uint32_t GetMemorySize() const { return (_buffer ? _buffer->size : 0) + sizeof(*this); }
   
   const Util::TransportAddress& GetAddress() const { return _address; }
 #if TRACK_INCOMING_PACKET_LATENCY
@@ -75,7 +73,7 @@ public:
   
 private:
   RobotConnectionMessageType  _messageType = RobotConnectionMessageType::Data;
-  std::vector<uint8_t>        _rawMessageData;
+  RobotMessageBufferPtr       _buffer;
   Util::TransportAddress      _address;
   
 #if TRACK_INCOMING_PACKET_LATENCY
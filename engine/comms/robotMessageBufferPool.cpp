@@ -0,0 +1,130 @@
+/**
+* File: robotMessageBufferPool.cpp
+*
+* Author: Victor Rebuild
+* Date:   10/14/2026
+*
+* Description: See header file.
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#include "engine/comms/robotMessageBufferPool.h"
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+
+#define LOG_CHANNEL "RobotConnectionManager"
+
+namespace Anki {
+namespace Vector {
+
+void RobotMessageBufferReleaser::operator()(RobotMessageBuffer* buffer) const
+{
+  if (nullptr != pool) {
+    pool->Release(buffer);
+  }
+  else {
+    delete buffer;
+  }
+}
+
+RobotMessageBufferPool::RobotMessageBufferPool(size_t numBuffers)
+: _buffers(numBuffers)
+{
+  _freeBuffers.reserve(numBuffers);
+  // Handed out from the back, so this starts with the first buffer
+  for (auto it = _buffers.rbegin(); it != _buffers.rend(); ++it) {
+    _freeBuffers.push_back(&(*it));
+  }
+}
+
+RobotMessageBufferPool::~RobotMessageBufferPool()
+{
+  DEV_ASSERT_MSG(_numInUse == 0, "RobotMessageBufferPool.Destructor.BuffersInUse", "%zu buffers still in use", _numInUse);
+}
+
+RobotMessageBufferPtr RobotMessageBufferPool::Acquire()
+{
+  RobotMessageBuffer* buffer = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    ++_numAcquired;
+    ++_numInUse;
+    _peakInUse = std::max(_peakInUse, _numInUse);
+    if (_freeBuffers.empty()) {
+      ++_numHeapAllocations;
+    }
+    else {
+      buffer = _freeBuffers.back();
+      _freeBuffers.pop_back();
+    }
+  }
+
+  if (nullptr == buffer) {
+    // Only warn the first time each run, and then every time the number of heap buffers doubles
+    const size_t numHeapAllocations = GetNumHeapAllocations();
+    if ((numHeapAllocations & (numHeapAllocations - 1)) == 0) {
+      LOG_WARNING("RobotMessageBufferPool.Acquire.PoolExhausted",
+                  "All %zu buffers in use, %zu allocated from the heap so far",
+                  _buffers.size(), numHeapAllocations);
+    }
+    buffer = new RobotMessageBuffer();
+  }
+
+  buffer->size = 0;
+  return RobotMessageBufferPtr(buffer, RobotMessageBufferReleaser{this});
+}
+
+void RobotMessageBufferPool::Release(RobotMessageBuffer* buffer)
+{
+  if (nullptr == buffer) {
+    return;
+  }
+
+  const bool fromPool = IsFromPool(buffer);
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    --_numInUse;
+    if (fromPool) {
+      _freeBuffers.push_back(buffer);
+    }
+  }
+
+  if (!fromPool) {
+    delete buffer;
+  }
+}
+
+bool RobotMessageBufferPool::IsFromPool(const RobotMessageBuffer* buffer) const
+{
+  return !_buffers.empty() && (buffer >= _buffers.data()) && (buffer < _buffers.data() + _buffers.size());
+}
+
+size_t RobotMessageBufferPool::GetNumInUse() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _numInUse;
+}
+
+size_t RobotMessageBufferPool::GetPeakInUse() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _peakInUse;
+}
+
+size_t RobotMessageBufferPool::GetNumAcquired() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _numAcquired;
+}
+
+size_t RobotMessageBufferPool::GetNumHeapAllocations() const
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  return _numHeapAllocations;
+}
+
+} // end namespace Vector
+} // end namespace Anki
@@ -0,0 +1,92 @@
+/**
+* File: robotMessageBufferPool.h
+*
+* Author: Victor Rebuild
+* Date:   10/14/2026
+*
+* Description: Fixed number of fixed size buffers that messages arriving from the robot are received into, and that
+*              carry them through RobotConnectionData's and RobotConnectionManager's queues until the message has
+*              been unpacked. All of them are allocated up front, and a buffer goes back to the pool when the last
+*              RobotMessageBufferPtr to it goes away, so receiving does no heap allocation once running. If every
+*              buffer is in use, a buffer comes from the heap instead of dropping the message, and is counted.
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#ifndef __Engine_Comms_RobotMessageBufferPool_H_
+#define __Engine_Comms_RobotMessageBufferPool_H_
+
+#include "util/helpers/noncopyable.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+struct RobotMessageBuffer
+{
+  // Largest message from the robot
+  static constexpr uint32_t kCapacity = 2048;
+
+  std::array<uint8_t, kCapacity> data;
+  uint32_t size = 0;
+};
+
+class RobotMessageBufferPool;
+
+// Returns the buffer to its pool, or deletes it if it came from the heap
+struct RobotMessageBufferReleaser
+{
+  RobotMessageBufferPool* pool = nullptr;
+  void operator()(RobotMessageBuffer* buffer) const;
+};
+
+using RobotMessageBufferPtr = std::unique_ptr<RobotMessageBuffer, RobotMessageBufferReleaser>;
+
+class RobotMessageBufferPool : private Util::noncopyable
+{
+public:
+
+  static constexpr size_t kDefaultNumBuffers = 128;
+
+  // Buffers must all be released before the pool is destroyed
+  explicit RobotMessageBufferPool(size_t numBuffers = kDefaultNumBuffers);
+  ~RobotMessageBufferPool();
+
+  // Thread safe. An empty buffer, from the heap if the pool has run out
+  RobotMessageBufferPtr Acquire();
+
+  size_t GetNumBuffers() const { return _buffers.size(); }
+
+  // Counters since construction, to verify that receiving stays within the pool. Thread safe
+  size_t GetNumInUse() const;
+  size_t GetPeakInUse() const;
+  size_t GetNumAcquired() const;
+  size_t GetNumHeapAllocations() const;
+
+private:
+
+  friend struct RobotMessageBufferReleaser;
+  void Release(RobotMessageBuffer* buffer);
+
+  bool IsFromPool(const RobotMessageBuffer* buffer) const;
+
+  std::vector<RobotMessageBuffer>  _buffers;
+  std::vector<RobotMessageBuffer*> _freeBuffers;
+  mutable std::mutex               _mutex;
+
+  size_t _numInUse = 0;
+  size_t _peakInUse = 0;
+  size_t _numAcquired = 0;
+  size_t _numHeapAllocations = 0;
+};
+
+} // end namespace Vector
+} // end namespace Anki
+
+
+#endif //__Engine_Comms_RobotMessageBufferPool_H_
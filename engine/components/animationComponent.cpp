@@ -34,6 +34,7 @@
 
 #include "json/json.h"
 
+#include "util/jsonWriter/jsonSaxReader.h"
 #include "util/string/stringUtils.h"
 
 #define LOG_CHANNEL "Animations"
@@ -51,6 +52,97 @@ namespace {
   // static const u32 kNumHalfImagePixels = kNumImagePixels / 2;
 
   static const int kMaxAnimGroupRecursionDepth = 100;
+
+  // Collects the name and length of each entry in the anim manifest, which is an array of objects
+  class AnimManifestHandler : public Util::JsonSaxHandlerBase
+  {
+  public:
+    using AnimMap = std::unordered_map<Util::StringID, AnimationComponent::AnimationMetaInfo>;
+
+    explicit AnimManifestHandler(AnimMap& anims) : _anims(anims) {}
+
+    virtual bool StartObject() override { return Enter(); }
+    virtual bool StartArray() override { return Enter(); }
+    virtual bool EndArray() override { --_depth; return true; }
+    virtual bool EndObject() override
+    {
+      if (--_depth == kEntryDepth - 1) {
+        AddEntry();
+      }
+      return true;
+    }
+
+    virtual bool Key(const std::string& key) override
+    {
+      if (_depth == kEntryDepth) {
+        _field = (key == kNameField) ? Field::Name : (key == kLengthField) ? Field::Length : Field::Other;
+      }
+      return true;
+    }
+
+    virtual bool String(const std::string& value) override
+    {
+      if (IsField(Field::Name)) {
+        _name = value;
+        _hasName = true;
+      }
+      return true;
+    }
+
+    virtual bool Int(int64_t value) override { return SetLength(static_cast<double>(value)); }
+    virtual bool Uint(uint64_t value) override { return SetLength(static_cast<double>(value)); }
+    virtual bool Double(double value) override { return SetLength(value); }
+
+  private:
+    enum class Field { Other, Name, Length };
+
+    static constexpr const char* kNameField = "name";
+    static constexpr const char* kLengthField = "length_ms";
+    static constexpr int kEntryDepth = 2; // inside an object inside the top level array
+
+    bool Enter()
+    {
+      if (++_depth == kEntryDepth) {
+        _hasName = false;
+        _hasLength = false;
+        _field = Field::Other;
+      }
+      return true;
+    }
+
+    // Only values directly in an entry count, not ones nested deeper in it
+    bool IsField(Field field) const { return (_depth == kEntryDepth) && (_field == field); }
+
+    bool SetLength(double value)
+    {
+      if (IsField(Field::Length)) {
+        _length_ms = static_cast<u32>(value);
+        _hasLength = true;
+      }
+      return true;
+    }
+
+    void AddEntry()
+    {
+      if (!_hasName) {
+        LOG_ERROR("AnimationComponent.Init.MissingJsonField", "%s", kNameField);
+        return;
+      }
+      if (!_hasLength) {
+        LOG_ERROR("AnimationComponent.Init.MissingJsonField", "%s", kLengthField);
+        return;
+      }
+      _anims[Util::StringID(_name)].length_ms = _length_ms;
+    }
+
+    AnimMap&    _anims;
+    int         _depth = 0;
+    Field       _field = Field::Other;
+    std::string _name;
+    u32         _length_ms = 0;
+    bool        _hasName = false;
+    bool        _hasLength = false;
+  };
 }
   
 CONSOLE_VAR(f32, kEyeDartFocusValue_pix, "Animation", 1.0f);
@@ -60,7 +152,7 @@ AnimationComponent::AnimationComponent()
 , _isInitialized(false)
 , _tagCtr(kInvalidAnimationTag)
 , _isDolingAnims(false)
-, _nextAnimToDole("")
+, _nextAnimToDole()
 , _currPlayingAnim("")
 , _isAnimating(false)
 , _currAnimName("")
@@ -129,34 +221,17 @@ void AnimationComponent::Init()
     return;
   }
   
-  // Open manifest file
+  // Read the manifest a token at a time, it's large and only two fields of each entry are needed
   static const std::string manifestFile = "assets/anim_manifest.json";
-  Json::Value jsonManifest;
-  const bool success = _robot->GetContext()->GetDataPlatform()->readAsJson(Util::Data::Scope::Resources, manifestFile, jsonManifest);
-  if (!success) {
-    LOG_ERROR("AnimationComponent.Init.ManifestNotFound", "");
-    return;
-  }
-
-  // Process animations in manifest
+  const std::string manifestPath = _robot->GetContext()->GetDataPlatform()->pathToResource(Util::Data::Scope::Resources,
+                                                                                           manifestFile);
   _availableAnims.clear();
-  for (int i=0; i<jsonManifest.size(); ++i) {
-    const Json::Value& jsonAnim = jsonManifest[i];
-    
-    static const char* kNameField = "name";
-    static const char* kLengthField = "length_ms";
-
-    if (!jsonAnim.isMember(kNameField)) {
-      LOG_ERROR("AnimationComponent.Init.MissingJsonField", "%s", kNameField);
-      continue;
-    }
-
-    if (!jsonAnim.isMember(kLengthField)) {
-      LOG_ERROR("AnimationComponent.Init.MissingJsonField", "%s", kLengthField);
-      continue;
-    }
-
-    _availableAnims[jsonAnim[kNameField].asCString()].length_ms = jsonAnim[kLengthField].asInt();
+  AnimManifestHandler handler(_availableAnims);
+  Util::JsonSaxReader reader;
+  if (!reader.ParseFile(manifestPath, handler)) {
+    LOG_ERROR("AnimationComponent.Init.ManifestNotFound", "%s at %zu", reader.GetError().c_str(), reader.GetErrorOffset());
+    _availableAnims.clear();
+    return;
   }
   LOG_INFO("AnimationComponent.Init.ManifestRead", "%zu animations loaded", _availableAnims.size());
 
@@ -168,7 +243,7 @@ void AnimationComponent::Init()
       // Ensure that at least one available animation has the given prefix
       bool hasMatchingAnim = false;
       for (const auto& availableAnim : _availableAnims) {
-        if (Util::StringStartsWith(availableAnim.first, prefix)) {
+        if (Util::StringStartsWith(availableAnim.first.ToString(), prefix)) {
           hasMatchingAnim = true;
           break;
         }
@@ -214,7 +289,7 @@ void AnimationComponent::UpdateDependent(const RobotCompMap& dependentComps)
 
 Result AnimationComponent::GetAnimationMetaInfo(const std::string& animName, AnimationMetaInfo& metaInfo) const
 {
-  auto it = _availableAnims.find(animName);
+  auto it = _availableAnims.find(Util::StringID::Find(animName));
   if (it != _availableAnims.end()) {
     metaInfo = it->second;
     return RESULT_OK;
@@ -229,17 +304,17 @@ void AnimationComponent::DoleAvailableAnimations()
   if (_isDolingAnims) {
     u32 numAnimsDoledThisTic = 0;
 
-    auto it = _nextAnimToDole.empty() ? _availableAnims.begin() : _availableAnims.find(_nextAnimToDole);
+    auto it = _nextAnimToDole.IsNone() ? _availableAnims.begin() : _availableAnims.find(_nextAnimToDole);
     for (; it != _availableAnims.end() && numAnimsDoledThisTic < kMaxNumAvailableAnimsToReportPerTic; ++it) {
       _robot->Broadcast(ExternalInterface::MessageEngineToGame(
-        ExternalInterface::AnimationAvailable(it->first))
+        ExternalInterface::AnimationAvailable(it->first.ToString()))
       );
       ++numAnimsDoledThisTic;
     }
     if (it == _availableAnims.end()) {
       LOG_INFO("DoleAvailableAnimations.Done", "");
       _isDolingAnims = false;
-      _nextAnimToDole = "";
+      _nextAnimToDole = Util::StringID();
       _robot->Broadcast(ExternalInterface::MessageEngineToGame(
         ExternalInterface::EndOfMessage(ExternalInterface::MessageType::AnimationAvailable))
       );
@@ -300,7 +375,7 @@ Result AnimationComponent::PlayAnimByName(const std::string& animName,
   }
 
   // Check that animName is valid
-  auto it = _availableAnims.find(animName);
+  auto it = _availableAnims.find(Util::StringID::Find(animName));
   if (it == _availableAnims.end()) {
     LOG_WARNING("AnimationComponent.PlayAnimByName.AnimNotFound", "%s", animName.c_str());
     return RESULT_FAIL;
@@ -344,7 +419,7 @@ Result AnimationComponent::PlayCompositeAnimation(const std::string& animName,
   }
 
   // Check that animName is valid
-  auto it = _availableAnims.find(animName);
+  auto it = _availableAnims.find(Util::StringID::Find(animName));
   if (it == _availableAnims.end()) {
     LOG_WARNING("AnimationComponent.PlayCompositeAnimation.AnimNotFound", "%s", animName.c_str());
     return RESULT_FAIL;
@@ -400,7 +475,7 @@ AnimationComponent::Tag AnimationComponent::IsAnimPlaying(const std::string& ani
 Result AnimationComponent::StopAnimByName(const std::string& animName)
 {
   // Verify that the animation is currently playing
-  const auto it = _availableAnims.find(animName);
+  const auto it = _availableAnims.find(Util::StringID::Find(animName));
   if (it != _availableAnims.end()) {
     const Tag tag = IsAnimPlaying(animName);
     if (tag != kNotAnimatingTag) {
@@ -933,7 +1008,7 @@ void AnimationComponent::HandleAnimAdded(const AnkiEvent<RobotInterface::RobotTo
 {
   const auto & payload = message.GetData().Get_animAdded();
   LOG_INFO("HandleAnimAdded", "name=%s length=%d", payload.animName.c_str(), payload.animLength);
-  _availableAnims[payload.animName].length_ms = payload.animLength;
+  _availableAnims[Util::StringID(payload.animName)].length_ms = payload.animLength;
 }
 
 void AnimationComponent::HandleAnimStarted(const AnkiEvent<RobotInterface::RobotToEngine>& message)
@@ -25,6 +25,7 @@
 #include "coretech/vision/shared/compositeImage/compositeImageLayer.h"
 #include "util/helpers/noncopyable.h"
 #include "util/signals/signalHolder.h"
+#include "util/stringTable/stringID.h"
 
 #include <unordered_map>
 #include <unordered_set>
@@ -315,11 +316,11 @@ private:
   };
   std::unique_ptr<AnimationGroupWrapper> _animationGroups;
   
-  // Map of available canned animations to associated metainfo
-  std::unordered_map<std::string, AnimationMetaInfo> _availableAnims;
+  // Map of available canned animations (by interned name) to associated metainfo
+  std::unordered_map<Util::StringID, AnimationMetaInfo> _availableAnims;
   
   bool _isDolingAnims;
-  std::string _nextAnimToDole;
+  Util::StringID _nextAnimToDole;
   
   std::string _currPlayingAnim;
 
@@ -31,6 +31,8 @@
 
 #include "osState/osState.h"
 
+#include <algorithm>
+
 #define DEBUG_LIGHTS 0
 
 namespace Anki {
@@ -77,14 +79,9 @@ void BackpackLightComponent::UpdateDependent(const RobotCompMap& dependentComps)
   auto newConfig = bestNewConfig.lock();
   auto curConfig = _curBackpackLightConfig.lock();
 
-  // Prevent spamming of off trigger while both configs are null
-  static bool sBothConfigsWereNull = false;
-
   // If the best config at this time is different from what we had, change it
   if (newConfig != curConfig)
   {
-    sBothConfigsWereNull = false;
-    
     // If the best config is still a thing, use it. Otherwise use the off config
     if (newConfig != nullptr)
     {
@@ -104,10 +101,9 @@ void BackpackLightComponent::UpdateDependent(const RobotCompMap& dependentComps)
     
     _curBackpackLightConfig = bestNewConfig;
   }
-  // Else if both new and cur configs are null then turn lights off
-  else if(newConfig == nullptr && curConfig == nullptr && !sBothConfigsWereNull)
+  // Else if both new and cur configs are null then turn lights off (only sent the first time, see SendIfChanged)
+  else if(newConfig == nullptr && curConfig == nullptr)
   {
-    sBothConfigsWereNull = true;
     SetBackpackAnimationInternal(BackpackAnimationTrigger::Off);
   }
 }
@@ -133,7 +129,7 @@ void BackpackLightComponent::SetBackpackAnimation(const BackpackAnimationTrigger
 
 void BackpackLightComponent::SetBackpackAnimationInternal(const BackpackAnimationTrigger& trigger)
 {
-  _robot->SendRobotMessage<RobotInterface::TriggerBackpackAnimation>(trigger);
+  SendIfChanged(RobotInterface::EngineToRobot(RobotInterface::TriggerBackpackAnimation(trigger)));
 }
 
 void BackpackLightComponent::StartLoopingBackpackAnimation(const BackpackLightAnimation::BackpackAnimation& lights,
@@ -183,7 +179,29 @@ void BackpackLightComponent::HandleMessage(const ExternalInterface::SetBackpackL
 
 Result BackpackLightComponent::SetBackpackAnimationInternal(const BackpackLightAnimation::BackpackAnimation& lights)
 {
-  return _robot->SendMessage(RobotInterface::EngineToRobot(lights.ToMsg()));
+  return SendIfChanged(RobotInterface::EngineToRobot(lights.ToMsg()));
+}
+
+Result BackpackLightComponent::SendIfChanged(const RobotInterface::EngineToRobot& msg)
+{
+  // Lights stay as they were last set, so the same message again (a config replaced by an identical one, or the
+  // off lights while there's nothing to show) would only restart the pattern
+  const uint8_t* buffer = msg.GetBuffer();
+  if ((msg.Size() == _lastSentLights.size()) && std::equal(buffer, buffer + msg.Size(), _lastSentLights.begin()))
+  {
+    return RESULT_OK;
+  }
+
+  const Result result = _robot->SendMessage(msg);
+  if (result == RESULT_OK)
+  {
+    _lastSentLights.assign(buffer, buffer + msg.Size());
+  }
+  else
+  {
+    _lastSentLights.clear();
+  }
+  return result;
 }
  
   
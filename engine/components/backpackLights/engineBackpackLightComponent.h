@@ -31,6 +31,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
@@ -87,6 +88,9 @@ private:
   
   void SetBackpackAnimationInternal(const BackpackAnimationTrigger& trigger);
 
+  // Sends msg unless it's the same as the last lights message sent
+  Result SendIfChanged(const RobotInterface::EngineToRobot& msg);
+
   Robot* _robot = nullptr;
   std::list<Signal::SmartHandle> _eventHandles;
 
@@ -98,6 +102,9 @@ private:
   
   // Locator handle for the shared light configuration associated with SetBackpackLightAnimation above
   BackpackLightDataLocator _sharedLightConfig{};
+
+  // Packed copy of the last lights message sent
+  std::vector<uint8_t> _lastSentLights;
   
 };
 
@@ -261,6 +261,7 @@ void BatteryComponent::NotifyOfRobotState(const RobotState& msg)
     _lastBatteryLevelChange_sec = now_sec;
     _prevBatteryLevel = _batteryLevel;
     _batteryLevel = level;
+    ++_stateGeneration;
   }
 
 
@@ -343,6 +344,7 @@ void BatteryComponent::SetOnChargeContacts(const bool onChargeContacts)
   // Log events and send message if state changed
   if (onChargeContacts != _isOnChargerContacts) {
     _isOnChargerContacts = onChargeContacts;
+    ++_stateGeneration;
 
     // The voltage usually steps up or down by a few hundred millivolts when we start/stop charging, so reset the low
     // pass filter here to more closely track the actual battery voltage, but only if the battery isn't disconnected
@@ -386,6 +388,7 @@ void BatteryComponent::SetIsCharging(const bool isCharging)
 {
   if (isCharging != _isCharging) {
     _isCharging = isCharging;
+    ++_stateGeneration;
 
     DASMSG(battery_is_charging_changed, "battery.is_charging_changed", "The robot isCharging state has changed");
     DASMSG_SET(i1, IsCharging(), "Is charging (1) or not (0)");
@@ -468,6 +471,7 @@ void BatteryComponent::UpdateOnChargerPlatform()
   // Has OnChargerPlatform state changed?
   if (onPlatform != _isOnChargerPlatform) {
     _isOnChargerPlatform = onPlatform;
+    ++_stateGeneration;
 
     using namespace ExternalInterface;
     _robot->Broadcast(MessageEngineToGame(RobotOnChargerPlatformEvent(_isOnChargerPlatform)));
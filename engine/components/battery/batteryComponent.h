@@ -116,6 +116,9 @@ public:
   // charger contacts is always on the platform (NOTE: even if it thinks it's in the air or on it's side)
   bool IsOnChargerPlatform() const { return _isOnChargerPlatform; }
   
+  // Incremented whenever the battery level, charging state, or on charger contacts/platform state changes
+  size_t GetStateGeneration() const { return _stateGeneration; }
+  
   // Returns whether or not the battery is overheated.
   // A power shutdown is imminent 30 seconds from when this first becomes true.
   bool IsBatteryOverheated() const { return _battOverheated; }
@@ -173,6 +176,8 @@ private:
   bool _isOnChargerContacts = false;
   bool _isOnChargerPlatform = false;
   
+  size_t _stateGeneration = 0;
+  
   float _lastBatteryLevelChange_sec = 0;
   float _lastOnChargerContactsChange_sec = 0;
   float _lastDisconnectedChange_sec = 0;
@@ -125,6 +125,12 @@ void CubeAccelComponent::HandleCubeAccelData(const ActiveID& activeID,
     }
   }
   
+  const auto& iter = _listenerMap.find(objectID);
+  if ((iter == _listenerMap.end()) || iter->second.empty()) {
+    return;
+  }
+  
+  _batchSamples.clear();
   for (const auto& accelReading : accelData.accelReadings) {
     // Convert raw accelerometer data to mm/s^2
     auto rawAccelToMmps = [](const s16 rawAccel) {
@@ -136,15 +142,14 @@ void CubeAccelComponent::HandleCubeAccelData(const ActiveID& activeID,
     accel.x = rawAccelToMmps(accelReading.accel[0]);
     accel.y = rawAccelToMmps(accelReading.accel[1]);
     accel.z = rawAccelToMmps(accelReading.accel[2]);
-    
-    const auto& iter = _listenerMap.find(objectID);
-
-    if(iter != _listenerMap.end()) {
-      // Update all of the listeners with the accel data
-      for(auto& listener : iter->second) {
-        listener->Update(accel);
-      }
-    }
+    _batchSamples.push_back(accel);
+  }
+  
+  // Update all of the listeners with the whole message's accel data at once, so that filter stages
+  // they have in common are only computed once
+  const CubeAccelListeners::CubeAccelBatch batch(_batchSamples, _filterBanks[objectID]);
+  for(auto& listener : iter->second) {
+    listener->Update(batch);
   }
 }
   
@@ -182,6 +187,8 @@ void CubeAccelComponent::HandleMessage(const ExternalInterface::ObjectConnection
     if (_upAxisChangedListeners.find(objectId) != _upAxisChangedListeners.end()) {
       _upAxisChangedListeners.erase(objectId);
     }
+    // Filter state doesn't carry over to the next connection
+    _filterBanks.erase(objectId);
   }
 }
 
@@ -13,6 +13,7 @@
 #ifndef __Anki_Cozmo_Basestation_Components_CubeAccelComponent_H__
 #define __Anki_Cozmo_Basestation_Components_CubeAccelComponent_H__
 
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
 #include "engine/cozmoObservableObject.h"
 #include "engine/events/ankiEvent.h"
 #include "engine/robotComponents_fwd.h"
@@ -29,6 +30,7 @@
 
 #include <list>
 #include <map>
+#include <vector>
 
 static const Anki::TimeStamp_t kDefaultWindowSize_ms = 50;
 
@@ -61,6 +63,8 @@ public:
     dependencies.insert(RobotComponentID::CubeComms);
   };
   virtual void UpdateDependent(const RobotCompMap& dependentComps) override;
+  // Update only prunes unused listeners
+  virtual bool CanUpdateInParallel() const override { return true; }
   //////
   // end IDependencyManagedComponent functions
   //////
@@ -83,6 +87,13 @@ private:
   // Incoming accel data is run on this set of listeners
   std::map<ObjectID, std::set<std::shared_ptr<CubeAccelListeners::ICubeAccelListener>>> _listenerMap;
   
+  // Filter stages shared by all of an object's listeners
+  std::map<ObjectID, CubeAccelListeners::CubeAccelFilterBank> _filterBanks;
+  
+  // Converted readings of the accel message currently being handled. Kept around to avoid reallocating
+  // it for every message.
+  std::vector<ActiveAccel> _batchSamples;
+  
   // Special listeners for detecting when cubes start/stop moving
   std::map<ObjectID, std::shared_ptr<CubeAccelListeners::MovementStartStopListener>> _movementListeners;
   
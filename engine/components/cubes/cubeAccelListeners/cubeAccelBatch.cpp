@@ -0,0 +1,128 @@
+/**
+ * File: cubeAccelBatch.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: A batch of consecutive accel samples from one cube, and the filter stages shared by all
+ *              of the listeners running on that cube's accel stream
+ *              Used by CubeAccelComponent and ICubeAccelListener
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
+
+#include "util/logging/logging.h"
+
+#include <cmath>
+
+namespace Anki {
+namespace Vector {
+namespace CubeAccelListeners {
+
+namespace {
+  inline float MagnitudeSq(const ActiveAccel& accel)
+  {
+    return accel.x * accel.x + accel.y * accel.y + accel.z * accel.z;
+  }
+}
+
+CubeAccelBatch::CubeAccelBatch(const std::vector<ActiveAccel>& samples, CubeAccelFilterBank& filters)
+: _samples(samples)
+, _filters(filters)
+, _sequenceNumber(filters.StartBatch())
+{
+  _magnitudes.reserve(_samples.size());
+  for (const auto& accel : _samples) {
+    _magnitudes.push_back(std::sqrt(MagnitudeSq(accel)));
+  }
+}
+
+
+const CubeAccelFilterOutput& CubeAccelFilterBank::GetLowPass(const Vec3f& coeffs, const CubeAccelBatch& batch)
+{
+  return GetOutput(FilterType::LowPass, coeffs, batch);
+}
+
+
+const CubeAccelFilterOutput& CubeAccelFilterBank::GetHighPass(const Vec3f& coeffs, const CubeAccelBatch& batch)
+{
+  return GetOutput(FilterType::HighPass, coeffs, batch);
+}
+
+
+const CubeAccelFilterOutput& CubeAccelFilterBank::GetOutput(const FilterType type,
+                                                            const Vec3f& coeffs,
+                                                            const CubeAccelBatch& batch)
+{
+  DEV_ASSERT(!batch.IsEmpty(), "CubeAccelFilterBank.GetOutput.EmptyBatch");
+
+  Stage* stage = nullptr;
+  for (auto& existingStage : _stages) {
+    if ((existingStage->type == type) && (existingStage->coeffs == coeffs)) {
+      stage = existingStage.get();
+      break;
+    }
+  }
+
+  if (stage == nullptr) {
+    _stages.emplace_back(new Stage());
+    stage = _stages.back().get();
+    stage->type = type;
+    stage->coeffs = coeffs;
+  }
+
+  if (stage->lastBatch != batch.GetSequenceNumber()) {
+    RunStage(*stage, batch);
+  }
+  return stage->output;
+}
+
+
+void CubeAccelFilterBank::RunStage(Stage& stage, const CubeAccelBatch& batch)
+{
+  const size_t numSamples = batch.GetNumSamples();
+  auto& output = stage.output;
+
+  // Carry on from the last output of the previous batch, unless this stage didn't see it
+  const bool isContinuous = (stage.lastBatch != 0) && (stage.lastBatch + 1 == batch.GetSequenceNumber());
+  ActiveAccel prevOutput = (isContinuous ? output.accel.back() : ActiveAccel());
+
+  output.accel.resize(numSamples);
+  output.magnitudeSq.resize(numSamples);
+
+  const Vec3f& coeffs = stage.coeffs;
+  for (size_t i = 0 ; i < numSamples ; ++i) {
+    const ActiveAccel& accel = batch.GetAccel(i);
+    ActiveAccel& out = output.accel[i];
+
+    if (!isContinuous && (i == 0)) {
+      // Same as the first update of LowPassFilterListener/HighPassFilterListener
+      if (stage.type == FilterType::LowPass) {
+        out = accel;
+      } else {
+        out = ActiveAccel(0.f, 0.f, 0.f);
+      }
+    } else if (stage.type == FilterType::LowPass) {
+      out.x = accel.x * coeffs.x() + prevOutput.x * (1.f - coeffs.x());
+      out.y = accel.y * coeffs.y() + prevOutput.y * (1.f - coeffs.y());
+      out.z = accel.z * coeffs.z() + prevOutput.z * (1.f - coeffs.z());
+    } else {
+      out.x = coeffs.x() * (prevOutput.x + accel.x - stage.prevInput.x);
+      out.y = coeffs.y() * (prevOutput.y + accel.y - stage.prevInput.y);
+      out.z = coeffs.z() * (prevOutput.z + accel.z - stage.prevInput.z);
+    }
+
+    output.magnitudeSq[i] = MagnitudeSq(out);
+    stage.prevInput = accel;
+    prevOutput = out;
+  }
+
+  stage.lastBatch = batch.GetSequenceNumber();
+}
+
+}
+}
+}
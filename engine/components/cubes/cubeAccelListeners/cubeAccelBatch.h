@@ -0,0 +1,123 @@
+/**
+ * File: cubeAccelBatch.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: A batch of consecutive accel samples from one cube, and the filter stages shared by all
+ *              of the listeners running on that cube's accel stream
+ *              Used by CubeAccelComponent and ICubeAccelListener
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Engine_CubeAccelListeners_CubeAccelBatch_H__
+#define __Engine_CubeAccelListeners_CubeAccelBatch_H__
+
+#include "clad/types/activeObjectAccel.h"
+
+#include "coretech/common/shared/math/point.h"
+
+#include "util/helpers/noncopyable.h"
+
+#include <memory>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+namespace CubeAccelListeners {
+
+class CubeAccelBatch;
+
+// Output of a filter stage for every sample in a batch
+struct CubeAccelFilterOutput
+{
+  std::vector<ActiveAccel> accel;
+
+  // Squared magnitude of each sample in accel
+  std::vector<float> magnitudeSq;
+};
+
+// Low and high pass filters over one cube's accel stream. A stage is created the first time a listener asks
+// for a filter with a particular set of coefficients, and after that is run at most once per batch no matter
+// how many listeners use it.
+class CubeAccelFilterBank : private Util::noncopyable
+{
+public:
+  CubeAccelFilterBank() = default;
+
+  // Outputs of a filter with the given coefficients for every sample in batch. See LowPassFilterListener and
+  // HighPassFilterListener for what the coefficients mean. A stage that missed a batch (because nothing asked for
+  // it) starts over from the first sample of the next batch it is run on, as a newly created one does.
+  const CubeAccelFilterOutput& GetLowPass(const Vec3f& coeffs, const CubeAccelBatch& batch);
+  const CubeAccelFilterOutput& GetHighPass(const Vec3f& coeffs, const CubeAccelBatch& batch);
+
+  // Returns the sequence number of a new batch
+  uint32_t StartBatch() { return ++_numBatches; }
+
+private:
+
+  enum class FilterType {
+    LowPass,
+    HighPass,
+  };
+
+  struct Stage {
+    FilterType type;
+    Vec3f coeffs;
+
+    // Sequence number of the last batch this stage was run on (0 if never run)
+    uint32_t lastBatch = 0;
+
+    // Previous input to the filter (high pass only)
+    ActiveAccel prevInput;
+
+    CubeAccelFilterOutput output;
+  };
+
+  const CubeAccelFilterOutput& GetOutput(const FilterType type, const Vec3f& coeffs, const CubeAccelBatch& batch);
+
+  void RunStage(Stage& stage, const CubeAccelBatch& batch);
+
+  // Stages are only ever added, and are held by pointer so that outputs handed out stay valid while new stages
+  // are created
+  std::vector<std::unique_ptr<Stage>> _stages;
+
+  uint32_t _numBatches = 0;
+};
+
+// Accel samples (mm/s^2) which arrived together from one cube, in the order they were measured. Filter stages
+// and magnitudes are computed once per batch and shared by every listener the batch is run on.
+class CubeAccelBatch : private Util::noncopyable
+{
+public:
+  // samples and filters must outlive the batch
+  CubeAccelBatch(const std::vector<ActiveAccel>& samples, CubeAccelFilterBank& filters);
+
+  size_t GetNumSamples() const { return _samples.size(); }
+  bool IsEmpty() const { return _samples.empty(); }
+
+  const ActiveAccel& GetAccel(const size_t i) const { return _samples[i]; }
+
+  // Magnitude of the raw accel of each sample
+  const std::vector<float>& GetMagnitudes() const { return _magnitudes; }
+
+  const CubeAccelFilterOutput& GetLowPass(const Vec3f& coeffs) const { return _filters.GetLowPass(coeffs, *this); }
+  const CubeAccelFilterOutput& GetHighPass(const Vec3f& coeffs) const { return _filters.GetHighPass(coeffs, *this); }
+
+  uint32_t GetSequenceNumber() const { return _sequenceNumber; }
+
+private:
+  const std::vector<ActiveAccel>& _samples;
+  std::vector<float> _magnitudes;
+
+  CubeAccelFilterBank& _filters;
+  const uint32_t _sequenceNumber;
+};
+
+}
+}
+}
+
+#endif //__Engine_CubeAccelListeners_CubeAccelBatch_H__
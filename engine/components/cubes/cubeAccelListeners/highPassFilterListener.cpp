@@ -12,6 +12,8 @@
 
 #include "engine/components/cubes/cubeAccelListeners/highPassFilterListener.h"
 
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
+
 #include "util/logging/logging.h"
 
 namespace Anki {
@@ -22,25 +24,11 @@ HighPassFilterListener::HighPassFilterListener(const Vec3f& coeffs,
                                                std::weak_ptr<ActiveAccel> output)
 : _coeffs(coeffs)
 , _output(output)
-, _prevInput(0,0,0)
 {
 
 }
 
-void HighPassFilterListener::InitInternal(const ActiveAccel& accel)
-{
-  auto output = _output.lock();
-  if(output == nullptr)
-  {
-    DEV_ASSERT(false, "HighPassFilterListener.InitInternal.NullOutput");
-    return;
-  }
-  
-  _prevInput = accel;
-  *output = ActiveAccel(0.f, 0.f, 0.f);
-}
-
-void HighPassFilterListener::UpdateInternal(const ActiveAccel& accel)
+void HighPassFilterListener::UpdateInternal(const CubeAccelBatch& batch)
 {
   auto output = _output.lock();
   if(output == nullptr)
@@ -49,10 +37,8 @@ void HighPassFilterListener::UpdateInternal(const ActiveAccel& accel)
     return;
   }
   
-  output->x = _coeffs.x() * (output->x + accel.x - _prevInput.x);
-  output->y = _coeffs.y() * (output->y + accel.y - _prevInput.y);
-  output->z = _coeffs.z() * (output->z + accel.z - _prevInput.z);
-  _prevInput = accel;
+  // Only the latest output is reported
+  *output = batch.GetHighPass(_coeffs).accel.back();
 }
 
 }
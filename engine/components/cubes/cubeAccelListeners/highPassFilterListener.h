@@ -37,9 +37,7 @@ public:
   HighPassFilterListener(const Vec3f& coeffs, std::weak_ptr<ActiveAccel> output);
   
 protected:
-  virtual void InitInternal(const ActiveAccel& accel) override;
-  
-  virtual void UpdateInternal(const ActiveAccel& accel) override;
+  virtual void UpdateInternal(const CubeAccelBatch& batch) override;
   
 private:
   // Coefficients for each axis
@@ -48,9 +46,6 @@ private:
   // Weak pointer to a variable that will be updated with the output of the filter
   std::weak_ptr<ActiveAccel> _output;
   
-  // Previous input to the filter
-  ActiveAccel _prevInput;
-  
 };
 
 }
@@ -13,23 +13,18 @@
 
 #include "engine/components/cubes/cubeAccelListeners/iCubeAccelListener.h"
 
-#include "clad/types/activeObjectAccel.h"
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
 
 namespace Anki {
 namespace Vector {
 namespace CubeAccelListeners {
   
 
-void ICubeAccelListener::Update(const ActiveAccel& accel)
+void ICubeAccelListener::Update(const CubeAccelBatch& batch)
 {
-  if(!_inited)
+  if(!batch.IsEmpty())
   {
-    InitInternal(accel);
-    _inited = true;
-  }
-  else
-  {
-    UpdateInternal(accel);
+    UpdateInternal(batch);
   }
 }
   
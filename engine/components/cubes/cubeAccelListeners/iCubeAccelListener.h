@@ -16,26 +16,24 @@
 
 namespace Anki {
 namespace Vector {
-  
-struct ActiveAccel;
-  
 namespace CubeAccelListeners {
 
+class CubeAccelBatch;
+
 class ICubeAccelListener
 {
 public:
   virtual ~ICubeAccelListener() {};
 
-  void Update(const ActiveAccel& accel);
+  // Runs the listener on every sample in batch, in order
+  void Update(const CubeAccelBatch& batch);
   
 protected:
   ICubeAccelListener() { };
   
-  virtual void InitInternal(const ActiveAccel& accel) = 0;
-  virtual void UpdateInternal(const ActiveAccel& accel) = 0;
-  
-private:
-  bool _inited = false;
+  // Listeners which filter the accel data should get the filter outputs from batch, so that
+  // filters with the same coefficients are only run once for all the listeners on a cube
+  virtual void UpdateInternal(const CubeAccelBatch& batch) = 0;
   
 };
 
@@ -12,9 +12,7 @@
 
 #include "engine/components/cubes/cubeAccelListeners/lowPassFilterListener.h"
 
-#include "clad/types/activeObjectAccel.h"
-
-#include "coretech/common/shared/math/point.h"
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
 
 #include "util/logging/logging.h"
 
@@ -29,19 +27,7 @@ LowPassFilterListener::LowPassFilterListener(const Vec3f& coeffs, std::weak_ptr<
 
 }
 
-void LowPassFilterListener::InitInternal(const ActiveAccel& accel)
-{
-  auto output = _output.lock();
-  if(output == nullptr)
-  {
-    DEV_ASSERT(false, "LowPassFilterListener.InitInternal.NullOutput");
-    return;
-  }
-  
-  *output = accel;
-}
-
-void LowPassFilterListener::UpdateInternal(const ActiveAccel& accel)
+void LowPassFilterListener::UpdateInternal(const CubeAccelBatch& batch)
 {
   auto output = _output.lock();
   if(output == nullptr)
@@ -50,9 +36,8 @@ void LowPassFilterListener::UpdateInternal(const ActiveAccel& accel)
     return;
   }
   
-  output->x = accel.x * _coeffs.x() + output->x * (1.f - _coeffs.x());
-  output->y = accel.y * _coeffs.y() + output->y * (1.f - _coeffs.y());
-  output->z = accel.z * _coeffs.z() + output->z * (1.f - _coeffs.z());
+  // Only the latest output is reported
+  *output = batch.GetLowPass(_coeffs).accel.back();
 }
 
 }
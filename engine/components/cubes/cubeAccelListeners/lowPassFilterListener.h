@@ -34,9 +34,7 @@ public:
   LowPassFilterListener(const Vec3f& coeffs, std::weak_ptr<ActiveAccel> output);
   
 protected:
-  virtual void InitInternal(const ActiveAccel& accel) override;
-  
-  virtual void UpdateInternal(const ActiveAccel& accel) override;
+  virtual void UpdateInternal(const CubeAccelBatch& batch) override;
   
 private:
   // Coefficients for each axis
@@ -15,7 +15,10 @@
 
 #include "engine/components/cubes/cubeAccelListeners/iCubeAccelListener.h"
 
-#include "engine/components/cubes/cubeAccelListeners/highPassFilterListener.h"
+#include "coretech/common/shared/math/point.h"
+
+#include <functional>
+#include <memory>
 
 namespace Anki {
 namespace Vector {
@@ -44,20 +47,15 @@ public:
                    std::function<void(const float)> callback);
   
 protected:
-  virtual void InitInternal(const ActiveAccel& accel) override;
-
-  virtual void UpdateInternal(const ActiveAccel& accel) override;
+  virtual void UpdateInternal(const CubeAccelBatch& batch) override;
   
 private:
-  // High pass filter used by this filter
-  std::unique_ptr<HighPassFilterListener> _highPassFilter;
+  // Coefficients of the high pass filter used by this filter
+  const Vec3f _hpFilterCoeffs;
   
   // Callback called when movement is detected. Passed in argument is the intensity of the movement
   std::function<void(const float)> _callback;
   
-  // Contains the output of the high pass filter
-  std::shared_ptr<ActiveAccel> _highPassOutput;
-  
   // The max amount movement score can increase each update
   const float _maxMovementScoreToAdd;
   
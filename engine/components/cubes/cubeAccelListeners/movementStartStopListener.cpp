@@ -12,7 +12,7 @@
 
 #include "engine/components/cubes/cubeAccelListeners/movementStartStopListener.h"
 
-#include "clad/types/activeObjectAccel.h"
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
 
 #include "util/logging/logging.h"
 
@@ -62,15 +62,9 @@ MovementStartStopListener::MovementStartStopListener(std::function<void(void)> s
              "MovementStartStopListener.MovementStartStopListener.InvalidThresholds");
 }
 
-void MovementStartStopListener::InitInternal(const ActiveAccel& accel)
+void MovementStartStopListener::UpdateInternal(const CubeAccelBatch& batch)
 {
-  // This will init the movement listener
-  _movementListener->Update(accel);
-}
-
-void MovementStartStopListener::UpdateInternal(const ActiveAccel& accel)
-{
-  _movementListener->Update(accel);
+  _movementListener->Update(batch);
 }
   
 void MovementStartStopListener::MovementCallback(const float movementScore)
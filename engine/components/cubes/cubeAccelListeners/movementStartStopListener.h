@@ -31,16 +31,14 @@ public:
                             std::function<void(void)> stoppedMovingCallback);
   
 protected:
-  virtual void InitInternal(const ActiveAccel& accel) override;
-
-  virtual void UpdateInternal(const ActiveAccel& accel) override;
+  virtual void UpdateInternal(const CubeAccelBatch& batch) override;
   
 private:
   
   // Function that movement listener calls whenever the cube is moving
   void MovementCallback(const float movementScore);
   
-  // High pass filter used by this filter
+  // Movement listener used by this filter
   std::unique_ptr<MovementListener> _movementListener;
   
   std::function<void(void)> _startedMovingCallback;
@@ -12,7 +12,7 @@
 
 #include "engine/components/cubes/cubeAccelListeners/rotationListener.h"
 
-#include "clad/types/activeObjectAccel.h"
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
 
 #include "coretech/common/shared/math/matrix_impl.h"
 
@@ -28,12 +28,7 @@ RotationListener::RotationListener(std::weak_ptr<Rotation3d> output)
 
 }
 
-void RotationListener::InitInternal(const ActiveAccel& accel)
-{
-  UpdateInternal(accel);
-}
-
-void RotationListener::UpdateInternal(const ActiveAccel& accel)
+void RotationListener::UpdateInternal(const CubeAccelBatch& batch)
 {
   auto output = _output.lock();
   if(output == nullptr)
@@ -50,16 +45,29 @@ void RotationListener::UpdateInternal(const ActiveAccel& accel)
   static const Vec3f idealVec = {0,0,-1};
   static const Matrix_3x3f I({1,0,0,0,1,0,0,0,1});
   
-  Vec3f gravVec = Vec3f(accel.x, accel.y, -accel.z);
-  gravVec.MakeUnitLength();
-  
-  const Vec3f v = CrossProduct(gravVec, idealVec);
-  const float c = DotProduct(gravVec, idealVec);
-  
-  // If c == -1 then the calculation of mult results in divide by zero so
-  // just don't update _output
-  if(c != -1)
+  // Each sample overwrites the output of the previous one, so only the rotation for the latest
+  // sample that has one needs to be computed
+  const auto& magnitudes = batch.GetMagnitudes();
+  for(size_t i = batch.GetNumSamples() ; i-- > 0 ; )
   {
+    const ActiveAccel& accel = batch.GetAccel(i);
+    if(magnitudes[i] <= 0.f)
+    {
+      continue;
+    }
+    
+    const Vec3f gravVec = Vec3f(accel.x, accel.y, -accel.z) * (1.f / magnitudes[i]);
+    
+    const Vec3f v = CrossProduct(gravVec, idealVec);
+    const float c = DotProduct(gravVec, idealVec);
+    
+    // If c == -1 then the calculation of mult results in divide by zero so
+    // just don't update _output
+    if(c == -1)
+    {
+      continue;
+    }
+    
     // Vx is the skew-symmetric cross-product matrix of v
     const float initVals[] = { 0,    -v.z(), v.y(),
                                v.z(), 0,    -v.x(),
@@ -74,6 +82,7 @@ void RotationListener::UpdateInternal(const ActiveAccel& accel)
     R += (Vx2 * mult);
     
     *output = Rotation3d(std::move(R));
+    break;
   }
 }
   
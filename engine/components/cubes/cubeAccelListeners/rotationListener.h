@@ -35,9 +35,7 @@ public:
   RotationListener(std::weak_ptr<Rotation3d> output);
   
 protected:
-  virtual void InitInternal(const ActiveAccel& accel);
-  
-  virtual void UpdateInternal(const ActiveAccel& accel);
+  virtual void UpdateInternal(const CubeAccelBatch& batch) override;
   
 private:
   std::weak_ptr<Rotation3d> _output;
@@ -12,7 +12,7 @@
 
 #include "engine/components/cubes/cubeAccelListeners/shakeListener.h"
 
-#include "clad/types/activeObjectAccel.h"
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
 
 #include "util/logging/logging.h"
 
@@ -24,36 +24,30 @@ ShakeListener::ShakeListener(const float highPassFilterCoeff,
                              const float highPassLowerThresh,
                              const float highPassUpperThresh,
                              std::function<void(const float)> callback)
-: _callback(callback)
+: _highPassFilterCoeffs(highPassFilterCoeff)
+, _callback(callback)
 , _lowerThreshSq(highPassLowerThresh*highPassLowerThresh)
 , _upperThreshSq(highPassUpperThresh*highPassUpperThresh)
 {
-  _highPassOutput.reset(new ActiveAccel());
-  _highPassFilter.reset(new HighPassFilterListener(highPassFilterCoeff, _highPassOutput));
-}
 
-void ShakeListener::InitInternal(const ActiveAccel& accel)
-{
-  _highPassFilter->Update(accel); // This will init the high pass filter
 }
 
-void ShakeListener::UpdateInternal(const ActiveAccel& accel)
+void ShakeListener::UpdateInternal(const CubeAccelBatch& batch)
 {
-  _highPassFilter->Update(accel);
-  
-  const float magSq = _highPassOutput->x * _highPassOutput->x +
-                      _highPassOutput->y * _highPassOutput->y +
-                      _highPassOutput->z * _highPassOutput->z;
-  
-  // Once the highPassFilter has exceeded the upperThreshold use the lowerThreshold
-  // to detect smaller movements
-  _shakeDetected = (_shakeDetected ?
-                    magSq > _lowerThreshSq :
-                    magSq > _upperThreshSq);
+  const auto& highPassMagSq = batch.GetHighPass(_highPassFilterCoeffs).magnitudeSq;
   
-  if(_shakeDetected && _callback != nullptr)
+  for(const float magSq : highPassMagSq)
   {
-    _callback(magSq);
+    // Once the highPassFilter has exceeded the upperThreshold use the lowerThreshold
+    // to detect smaller movements
+    _shakeDetected = (_shakeDetected ?
+                      magSq > _lowerThreshSq :
+                      magSq > _upperThreshSq);
+    
+    if(_shakeDetected && _callback != nullptr)
+    {
+      _callback(magSq);
+    }
   }
 }
 
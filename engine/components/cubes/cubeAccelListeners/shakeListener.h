@@ -15,7 +15,7 @@
 
 #include "engine/components/cubes/cubeAccelListeners/iCubeAccelListener.h"
 
-#include "engine/components/cubes/cubeAccelListeners/highPassFilterListener.h"
+#include "coretech/common/shared/math/point.h"
 
 #include <functional>
 #include <memory>
@@ -46,13 +46,11 @@ public:
                 std::function<void(const float)> callback);
   
 protected:
-  virtual void InitInternal(const ActiveAccel& accel) override;
-  
-  virtual void UpdateInternal(const ActiveAccel& accel) override;
+  virtual void UpdateInternal(const CubeAccelBatch& batch) override;
   
 private:
-  // High pass filter used by this filter
-  std::unique_ptr<HighPassFilterListener> _highPassFilter;
+  // Coefficients of the high pass filter used by this filter
+  const Vec3f _highPassFilterCoeffs;
   
   // Callback called when shaking is detected. Passed in argument is the intensity of the shaking
   std::function<void(const float)> _callback;
@@ -63,9 +61,6 @@ private:
   // Used for the initial shake detection (typically larger than the lowerThresh but doesn't have to be)
   const float _upperThreshSq;
   
-  // Contains the output of the high pass filter
-  std::shared_ptr<ActiveAccel> _highPassOutput;
-  
   // Whether or not a shake has been detected
   bool _shakeDetected = false;
   
@@ -12,6 +12,8 @@
 
 #include "engine/components/cubes/cubeAccelListeners/upAxisChangedListener.h"
 
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
+
 #include "coretech/common/shared/math/point.h"
 
 #include "util/logging/logging.h"
@@ -26,28 +28,13 @@ namespace {
 
 UpAxisChangedListener::UpAxisChangedListener(std::function<void(const UpAxis&)> callback)
   : _callback(callback)
-  , _lowPassOutput(std::make_shared<ActiveAccel>())
-  , _lowPassFilterListener(std::make_unique<LowPassFilterListener>(kLowPassFilterCoefs, _lowPassOutput))
 {
   
 }
 
-void UpAxisChangedListener::InitInternal(const ActiveAccel& accel)
-{
-  Init(accel);
-}
-
-void UpAxisChangedListener::UpdateInternal(const ActiveAccel& accel)
+void UpAxisChangedListener::UpdateInternal(const CubeAccelBatch& batch)
 {
-  if (!_inited) {
-    Init(accel);
-    return;
-  }
-  
-  _lowPassFilterListener->Update(accel);
-  
-  // Compute up axis from accel data:
-  auto currUpAxis = _upAxis;
+  const auto& lowPassOutput = batch.GetLowPass(kLowPassFilterCoefs).accel;
   
   static const UpAxis upAxisMap[3][2] = {
     {UpAxis::XPositive, UpAxis::XNegative},
@@ -55,32 +42,37 @@ void UpAxisChangedListener::UpdateInternal(const ActiveAccel& accel)
     {UpAxis::ZPositive, UpAxis::ZNegative},
   };
   
-  const float accelVec[3] = {
-    _lowPassOutput->x,
-    _lowPassOutput->y,
-    _lowPassOutput->z,
-  };
-  
-  float maxAccel = 0;
-  for (int i=0 ; i<3 ; i++) {
-    const auto accel = accelVec[i];
-    if (std::abs(accel) > maxAccel) {
-      currUpAxis = upAxisMap[i][(accel > 0) ? 0 : 1];
-      maxAccel = std::abs(accel);
+  for (const auto& filteredAccel : lowPassOutput) {
+    if (!_inited) {
+      _inited = true;
+      continue;
     }
+    
+    // Compute up axis from accel data:
+    auto currUpAxis = _upAxis;
+    
+    const float accelVec[3] = {
+      filteredAccel.x,
+      filteredAccel.y,
+      filteredAccel.z,
+    };
+    
+    float maxAccel = 0;
+    for (int i=0 ; i<3 ; i++) {
+      const auto accel = accelVec[i];
+      if (std::abs(accel) > maxAccel) {
+        currUpAxis = upAxisMap[i][(accel > 0) ? 0 : 1];
+        maxAccel = std::abs(accel);
+      }
+    }
+    
+    const bool newUpAxis = (currUpAxis != _upAxis) &&
+                           (_upAxis != UpAxis::UnknownAxis);
+    if (newUpAxis) {
+      _callback(currUpAxis);
+    }
+    _upAxis = currUpAxis;
   }
-  
-  const bool newUpAxis = (currUpAxis != _upAxis) &&
-                         (_upAxis != UpAxis::UnknownAxis);
-  if (newUpAxis) {
-    _callback(currUpAxis);
-  }
-  _upAxis = currUpAxis;
-}
-  
-void UpAxisChangedListener::Init(const ActiveAccel& accel) {
-  _lowPassFilterListener->Update(accel);
-  _inited = true;
 }
 
 }
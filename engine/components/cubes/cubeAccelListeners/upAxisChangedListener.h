@@ -15,12 +15,9 @@
 
 #include "engine/components/cubes/cubeAccelListeners/iCubeAccelListener.h"
 
-#include "engine/components/cubes/cubeAccelListeners/lowPassFilterListener.h"
-
 #include "clad/types/activeObjectAccel.h"
 
 #include <functional>
-#include <memory>
 
 namespace Anki {
 namespace Vector {
@@ -37,9 +34,7 @@ public:
   UpAxisChangedListener(std::function<void(const UpAxis&)> callback);
   
 protected:
-  virtual void InitInternal(const ActiveAccel& accel) override;
-
-  virtual void UpdateInternal(const ActiveAccel& accel) override;
+  virtual void UpdateInternal(const CubeAccelBatch& batch) override;
   
 private:
 
@@ -47,13 +42,8 @@ private:
   
   // Callback called when upAxis changes. Passed in argument is the new UpAxis
   std::function<void(const UpAxis&)> _callback;
-
-  std::shared_ptr<ActiveAccel> _lowPassOutput;
-  
-  std::unique_ptr<LowPassFilterListener> _lowPassFilterListener;
   
-  void Init(const ActiveAccel& accel);
-   
+  // Whether the first sample (which only initializes the low pass filter) has been seen
   bool _inited = false;
   
 };
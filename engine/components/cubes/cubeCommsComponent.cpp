@@ -316,6 +316,15 @@ void CubeCommsComponent::ForgetPreferredCube()
   
 bool CubeCommsComponent::SendCubeLights(const CubeLights& cubeLights)
 {
+  // The cube keeps playing the lights it was last sent, so sending the same ones again (e.g. the next pattern of an
+  // animation being the same as this one) would only cost BLE writes and restart the pattern
+  std::vector<uint8_t> packedLights(cubeLights.Size());
+  cubeLights.Pack(packedLights.data(), packedLights.size());
+  if (packedLights == _lastSentCubeLights) {
+    return true;
+  }
+  _lastSentCubeLights.clear();
+
   CubeLightSequence cubeLightSequence;
   std::vector<CubeLightKeyframeChunk> cubeLightKeyframeChunks;
   
@@ -339,6 +348,7 @@ bool CubeCommsComponent::SendCubeLights(const CubeLights& cubeLights)
                         "Failed to send CubeLightSequence message");
     return false;
   }
+  _lastSentCubeLights = std::move(packedLights);
   return true;
 }
 
@@ -599,6 +609,9 @@ void CubeCommsComponent::HandleConnectionStateChange(const BleFactoryId& factory
   LOG_INFO("CubeCommsComponent.HandleConnectionStateChange.Recvd", "FactoryID %s, connected %d",
                    factoryId.c_str(), connected);
   
+  // Whatever the cube was showing is gone either way
+  _lastSentCubeLights.clear();
+  
   if (connected) {
     OnCubeConnected(factoryId);
   } else {
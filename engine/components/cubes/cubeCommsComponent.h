@@ -24,6 +24,7 @@
 #include "util/signals/simpleSignal_fwd.h" // Signal::SmartHandle
 
 #include <unordered_map>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
@@ -102,9 +103,16 @@ public:
   // time a connection is requested. Saves this preference to disk.
   void ForgetPreferredCube();
   
-  // Send CubeLights message to the currently connected cube
+  // Send CubeLights message to the currently connected cube. The messages are queued,
+  // and go out with everything else sent to the cube this tick in FlushCubeMessages().
   bool SendCubeLights(const CubeLights& cubeLights);
   
+  // Send everything queued for the cube this tick. Called by the engine at the end of each tick.
+  void FlushCubeMessages() { _cubeBleClient->FlushMessages(); }
+  
+  // Tell the BLE client how the connected cube is being used, so that it can pick a connection interval
+  void SetCubeConnectionType(const CubeConnectionType type) { _cubeBleClient->SetConnectionType(type); }
+  
   // Returns the ActiveID of the currently-connected cube, or
   // ObservableObject::InvalidActiveID if there is no connected cube
   ActiveID GetConnectedCubeActiveId() const;
@@ -235,6 +243,9 @@ private:
   
   // Next time we should send data to webviz
   float _nextSendWebVizDataTime_sec = 0.f;
+  
+  // Packed copy of the lights last sent to the connected cube, empty if nothing has been since it connected
+  std::vector<uint8_t> _lastSentCubeLights;
 };
 
 
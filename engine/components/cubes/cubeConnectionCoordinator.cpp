@@ -356,6 +356,8 @@ void CubeConnectionCoordinator::TransitionToConnectedInteractable(const RobotCom
 {
   SET_STATE(ConnectedInteractable);
 
+  dependentComps.GetComponent<CubeCommsComponent>().SetCubeConnectionType(CubeConnectionType::Interactable);
+
   // Play connection light animation
   auto& cubeLights = dependentComps.GetComponent<CubeLightComponent>();
   bool connectedInBackground = false;
@@ -426,6 +428,9 @@ void CubeConnectionCoordinator::TransitionToConnectedBackground(const RobotCompM
 {
   SET_STATE(ConnectedBackground);
 
+  // Nothing is playing lights on a background connection, so give up the short connection interval
+  dependentComps.GetComponent<CubeCommsComponent>().SetCubeConnectionType(CubeConnectionType::Background);
+
   if(_subscriptionRecords.empty()){
     // Reset the timeout in case the last unsubscribe was a while ago. This ensures a minimum Background time of 
     // kBackgroundConnectionTimeout_s before disconnecting
@@ -24,11 +24,14 @@
 #include "engine/robotDataLoader.h"
 #include "osState/osState.h"
 #include "util/console/consoleInterface.h"
+#include "util/jsonWriter/jsonStreamWriter.h"
 #include "util/logging/DAS.h"
 #include "util/logging/logging.h"
 #include "clad/robotInterface/messageEngineToRobot.h"
 #include "clad/externalInterface/messageGameToEngine.h"
 
+#include <algorithm>
+
 #define LOG_CHANNEL "JdocsManager"
 
 namespace Anki {
@@ -68,6 +71,11 @@ namespace
 
   JdocsManager* s_JdocsManager = nullptr;
 
+  // Saves requested 'immediately' are held back this long, so that a burst of changes (e.g. several
+  // settings changed in a row during onboarding) becomes one disk write and one cloud write
+  CONSOLE_VAR(float, kJdocImmediateDiskSaveDelay_s, "JdocsManager", 0.5f);
+  CONSOLE_VAR(float, kJdocImmediateCloudSaveDelay_s, "JdocsManager", 2.0f);
+
 #if REMOTE_CONSOLE_ENABLED
 
   static const char* kConsoleGroup = "JdocsManager";
@@ -110,6 +118,7 @@ namespace
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 JdocsManager::JdocsManager()
 : IDependencyManagedComponent(this, RobotComponentID::JdocsManager)
+, _fileSaveQueue(Util::Dispatch::create_queue, "JdocsFileSave")
 {
 }
 
@@ -130,6 +139,9 @@ JdocsManager::~JdocsManager()
   static const bool kIsShuttingDown = true;
   UpdatePeriodicFileSaves(kIsShuttingDown);
 
+  // Let jdoc writes queued before now finish, since the queue drops anything left when it is released
+  Util::Dispatch::Sync(_fileSaveQueue.get(), []{}, "JdocsManager.FlushFileSaves");
+
   for (auto& jdoc : _jdocs)
   {
     // To release the handles
@@ -632,18 +644,17 @@ bool JdocsManager::GetJdoc(const external_interface::JdocType jdocTypeKey,
   jdocOut.set_fmt_version(jdocItem._jdocFormatVersion);
   jdocOut.set_client_metadata(jdocItem._jdocClientMetadata);
 
-  Json::StyledWriter writer;
-  std::string jdocBodyString;
+  // Serialize straight into the message's string instead of building one and copying it in
+  std::string& jdocBodyString = *jdocOut.mutable_json_doc();
   if (transformFunc != nullptr)
   {
     const auto& json = transformFunc(jdocItem._jdocBody);
-    jdocBodyString = writer.write(json);
+    Util::JsonStreamWriter::Write(json, jdocBodyString, Util::JsonStreamWriter::Style::Pretty);
   }
   else
   {
-    jdocBodyString = writer.write(jdocItem._jdocBody);
+    Util::JsonStreamWriter::Write(jdocItem._jdocBody, jdocBodyString, Util::JsonStreamWriter::Style::Pretty);
   }
-  jdocOut.set_json_doc(jdocBodyString);
 
   return true;
 }
@@ -757,15 +768,17 @@ bool JdocsManager::UpdateJdoc(const external_interface::JdocType jdocTypeKey,
 
     if (abuseConfig._abuseLevel == 0)
     {
-      static const bool kIsJdocNewInCloud = false;
-      SubmitJdocToCloud(jdocTypeKey, kIsJdocNewInCloud);
+      // Submitted by the periodic cloud save, so that changes made shortly after this one go in the same write
+      jdocItem._cloudDirty = true;
+      const float submitTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds() + kJdocImmediateCloudSaveDelay_s;
+      jdocItem._nextCloudSaveTime = std::min(jdocItem._nextCloudSaveTime, submitTime_s);
     }
     else
     {
       LOG_INFO("JdocsManager.UpdateJdoc.CloudWritePostponed",
                "Postponing jdoc submission to cloud due to spam abuse");
       jdocItem._cloudDirty = true;
-      SaveJdocFile(jdocTypeKey);
+      ScheduleDiskSave(jdocItem);
     }
   }
   else
@@ -785,7 +798,7 @@ bool JdocsManager::UpdateJdoc(const external_interface::JdocType jdocTypeKey,
     // save would pick it up and do the save.
     if (!saveToCloudImmediately || (_userID == kNotLoggedIn))
     {
-      SaveJdocFile(jdocTypeKey);
+      ScheduleDiskSave(jdocItem);
     }
   }
   else
@@ -872,9 +885,20 @@ bool JdocsManager::LoadJdocFile(const external_interface::JdocType jdocTypeKey)
 }
 
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void JdocsManager::ScheduleDiskSave(JdocInfo& jdocItem)
+{
+  // Left to the periodic file save, so that further changes before it happens don't each cost a write
+  jdocItem._diskFileDirty = true;
+  const float saveTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds() + kJdocImmediateDiskSaveDelay_s;
+  jdocItem._nextDiskSaveTime = std::min(jdocItem._nextDiskSaveTime, saveTime_s);
+}
+
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void JdocsManager::SaveJdocFile(const external_interface::JdocType jdocTypeKey,
-                                const int cloudDirtyRemaining_s)
+                                const int cloudDirtyRemaining_s,
+                                const bool waitForWrite)
 {
   const auto& it = _jdocs.find(jdocTypeKey);
   auto& jdocItem = (*it).second;
@@ -888,11 +912,22 @@ void JdocsManager::SaveJdocFile(const external_interface::JdocType jdocTypeKey,
   jdocJson[kCloudDirtyRemainingSecKey] = cloudDirtyRemaining_s;
   jdocJson[kCloudGetTimeKey]   = jdocItem._lastCloudGetTime;
 
-  if (!_platform->writeAsJson(jdocItem._jdocFullPath, jdocJson))
+  // The document is copied above, so serializing and writing it can happen off the engine thread. Writes
+  // are done in order on one queue, so the file always ends up with the latest version
+  auto writeJdocFile = [platform = _platform, path = jdocItem._jdocFullPath, jdocJson = std::move(jdocJson)]()
   {
-    LOG_ERROR("JdocsManager.SaveJdocFile.Failed", "Failed to write jdoc file %s",
-              jdocItem._jdocFullPath.c_str());
-    return;
+    if (!platform->writeAsJson(path, jdocJson))
+    {
+      LOG_ERROR("JdocsManager.SaveJdocFile.Failed", "Failed to write jdoc file %s", path.c_str());
+    }
+  };
+  if (waitForWrite)
+  {
+    Util::Dispatch::Sync(_fileSaveQueue.get(), writeJdocFile, "JdocsManager.SaveJdocFile");
+  }
+  else
+  {
+    Util::Dispatch::Async(_fileSaveQueue.get(), writeJdocFile, "JdocsManager.SaveJdocFile");
   }
 
   jdocItem._needsCreation = false;
@@ -940,7 +975,8 @@ void JdocsManager::UpdatePeriodicFileSaves(const bool isShuttingDown)
           }
         }
       }
-      SaveJdocFile(jdocPair.first, cloudDirtyRemaining_s);
+      // On shutdown we have to know the file is written before the process goes away
+      SaveJdocFile(jdocPair.first, cloudDirtyRemaining_s, isShuttingDown);
     }
   }
 }
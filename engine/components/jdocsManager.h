@@ -21,6 +21,7 @@
 #include "engine/cozmoContext.h"
 #include "engine/robotComponents_fwd.h"
 
+#include "util/dispatchQueue/dispatchQueue.h"
 #include "util/entityComponent/iDependencyManagedComponent.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/helpers/noncopyable.h"
@@ -108,8 +109,11 @@ public:
 private:
 
   bool LoadJdocFile(const external_interface::JdocType jdocTypeKey);
+  struct JdocInfo;
+  void ScheduleDiskSave(JdocInfo& jdocItem);
   void SaveJdocFile(const external_interface::JdocType jdocTypeKey,
-                    const int cloudDirtyRemaining_s = 0);
+                    const int cloudDirtyRemaining_s = 0,
+                    const bool waitForWrite = false);
   void UpdatePeriodicFileSaves(const bool isShuttingDown = false);
 
   bool ConnectToJdocsServer();
@@ -131,6 +135,7 @@ private:
   Robot*                    _robot = nullptr;
   Util::Data::DataPlatform* _platform = nullptr;
   std::string               _savePath;
+  Util::Dispatch::QueueHandle _fileSaveQueue; // Jdoc files are written on this queue, off the engine thread
   bool                      _cloudJdocResetRequested = false;
   LocalUdpClient            _udpClient;
   std::string               _userID = "";
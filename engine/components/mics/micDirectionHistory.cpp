@@ -21,6 +21,9 @@
 #include "webServerProcess/src/webService.h"
 
 #include "clad/robotInterface/messageRobotToEngine.h"
+#include "json/json.h"
+
+#include <algorithm>
 
 
 #if defined(ANKI_NO_WEBSERVER_ENABLED)
@@ -33,6 +36,7 @@ namespace Anki {
 namespace Vector {
 namespace {
   const EngineTimeStamp_t kVadSessionLength_ms = (30 * 60 * 1000);  // 30 mins == 1,800,000 ms
+  const char* const kWebVizHistoryModuleName = "micdirectionhistory";
 }
 
 CONSOLE_VAR_RANGED( uint32_t,       kRTS_PowerAvgNumSamples,   "SoundReaction", 100, 1, 250 );
@@ -54,6 +58,19 @@ static_assert(std::is_same<decltype(RobotInterface::MicDirection::confidence),
 void MicDirectionHistory::Initialize( const CozmoContext* context )
 {
   _webService = context->GetWebService();
+
+  #if SEND_MICENGINE_DATA
+  if ( nullptr != _webService )
+  {
+    // New subscribers start from the whole history, after that they get the same changes as everyone else
+    auto onSubscribed = [this](const std::function<void(const Json::Value&)>& sendToClient) {
+      Json::Value data = GetHistoryAsJson(0);
+      data["reset"] = true;
+      sendToClient(data);
+    };
+    _signalHandles.emplace_back( _webService->OnWebVizSubscribed( kWebVizHistoryModuleName ).ScopedSubscribe( onSubscribed ) );
+  }
+  #endif
 }
 
 void MicDirectionHistory::PrintNodeData(uint32_t index) const
@@ -75,6 +92,7 @@ void MicDirectionHistory::AddMicSample(const RobotInterface::MicDirection& messa
 
   ProcessSoundReactors();
   SendMicDataToWebserver();
+  SendHistoryToWebserver();
 }
 
 uint32_t MicDirectionHistory::GetNextNodeIdx(uint32_t nodeIndex) const
@@ -87,6 +105,55 @@ uint32_t MicDirectionHistory::GetPrevNodeIdx(uint32_t nodeIndex) const
   return (nodeIndex == 0) ? (kMicDirectionHistoryLen - 1) : (nodeIndex - 1);
 }
 
+const MicDirectionNode& MicDirectionHistory::GetNodeAtPos(uint32_t pos) const
+{
+  // The oldest node is the one right after the newest in the ring
+  return _micDirectionBuffer[(_micDirectionBufferIndex + 1 + pos) % kMicDirectionHistoryLen];
+}
+
+const MicDirectionHistory::DirectionTotals& MicDirectionHistory::GetTotalsThroughPos(uint32_t pos) const
+{
+  if (pos == kNewestNodePos)
+  {
+    return _totals;
+  }
+  // Everything up to the following node
+  return _totalsBeforeNode[(_micDirectionBufferIndex + 2 + pos) % kMicDirectionHistoryLen];
+}
+
+uint32_t MicDirectionHistory::GetNumNodesEndedBy(TimeStamp_t timestamp, uint32_t endPos) const
+{
+  // Nodes end in time order (unused ones end at 0), so this is an upper bound search
+  uint32_t low = 0;
+  uint32_t high = endPos;
+  while (low < high)
+  {
+    const uint32_t mid = low + (high - low) / 2;
+    if ((TimeStamp_t)GetNodeAtPos(mid).timestampEnd <= timestamp)
+    {
+      low = mid + 1;
+    }
+    else
+    {
+      high = mid;
+    }
+  }
+  return low;
+}
+
+uint32_t MicDirectionHistory::GetFirstPosInTimeLength(uint32_t pos, TimeStamp_t timeLength_ms) const
+{
+  // The oldest node is never included since there is no telling when it began. This is the node whose previous node
+  // ended at least timeLength_ms before the one at pos did, otherwise the history runs out first
+  const auto posEnd = (TimeStamp_t)GetNodeAtPos(pos).timestampEnd;
+  if (pos == 0 || posEnd < timeLength_ms)
+  {
+    return 1;
+  }
+  const uint32_t numEnded = GetNumNodesEndedBy(posEnd - timeLength_ms, pos);
+  return (numEnded > 0) ? numEnded : 1;
+}
+
 MicDirectionIndex MicDirectionHistory::GetDirectionAtTime(EngineTimeStamp_t timestampEnd,
                                                           TimeStamp_t timeLength_ms) const
 {
@@ -102,25 +169,19 @@ MicDirectionIndex MicDirectionHistory::GetDirectionAtTime(EngineTimeStamp_t time
     }
   }
 
-  // Find the node containing the timestamp asked about
-  auto endingIndex = _micDirectionBufferIndex;
-  auto prevToEndingIndex = GetPrevNodeIdx(endingIndex);
-  while (prevToEndingIndex != _micDirectionBufferIndex && _micDirectionBuffer[prevToEndingIndex].timestampEnd > timestampEnd)
-  {
-    endingIndex = prevToEndingIndex;
-    prevToEndingIndex = GetPrevNodeIdx(endingIndex);
-  }
-
-  const auto& endingNode = _micDirectionBuffer[endingIndex];
+  // Find the node containing the timestamp asked about, the one after the last node to end by it
+  const auto endingPos = GetNumNodesEndedBy((TimeStamp_t)timestampEnd, kNewestNodePos);
+  const auto& endingNode = GetNodeAtPos(endingPos);
 
   // Did we hit the end of history?
-  if (prevToEndingIndex == _micDirectionBufferIndex)
+  if (endingPos == 0)
   {
     return endingNode.directionIndex;
   }
 
   // Was the full time length requested within this node?
-  const auto timeSpentInEndNode = TimeStamp_t(timestampEnd - _micDirectionBuffer[prevToEndingIndex].timestampEnd);
+  const auto prevToEndingPos = endingPos - 1;
+  const auto timeSpentInEndNode = TimeStamp_t(timestampEnd - GetNodeAtPos(prevToEndingPos).timestampEnd);
   if (timeSpentInEndNode >= timeLength_ms)
   {
     return endingNode.directionIndex;
@@ -128,75 +189,107 @@ MicDirectionIndex MicDirectionHistory::GetDirectionAtTime(EngineTimeStamp_t time
 
   // Start with the count from before the ending node
   const auto timePrevToNode = timeLength_ms - timeSpentInEndNode;
-  DirectionHistoryCount directionCount = GetDirectionCountAtIndex(prevToEndingIndex, timePrevToNode);
+  DirectionTotals directionTotals = GetDirectionTotalsAtPos(prevToEndingPos, timePrevToNode);
 
   // Add in the partial count based on leftover time
-  const auto fullNodeLength = endingNode.timestampEnd - _micDirectionBuffer[prevToEndingIndex].timestampEnd;
-  const auto proportionCount = (timeSpentInEndNode * endingNode.count) / (TimeStamp_t)fullNodeLength;
-  directionCount[endingNode.directionIndex] += proportionCount;
+  if (endingNode.directionIndex < kNumMicDirections)
+  {
+    const auto fullNodeLength = endingNode.timestampEnd - GetNodeAtPos(prevToEndingPos).timestampEnd;
+    const auto proportionCount = (timeSpentInEndNode * endingNode.count) / (TimeStamp_t)fullNodeLength;
+    directionTotals.count[endingNode.directionIndex] += proportionCount;
+  }
 
-  return GetBestDirection(directionCount);
+  return GetBestDirection(directionTotals);
 }
 
 MicDirectionIndex MicDirectionHistory::GetRecentDirection(TimeStamp_t timeLength_ms) const
 {
-  const auto startIndex = _micDirectionBufferIndex;
+  // Special case where we just want the first piece of info we can get.
+  if (timeLength_ms == 0)
+  {
+    return _micDirectionBuffer[_micDirectionBufferIndex].directionIndex;
+  }
+
+  return GetBestDirection(GetDirectionTotalsAtPos(kNewestNodePos, timeLength_ms));
+}
+
+MicDirectionConfidence MicDirectionHistory::GetRecentConfidence(MicDirectionIndex direction,
+                                                                TimeStamp_t timeLength_ms) const
+{
+  if (direction >= kNumMicDirections)
+  {
+    return 0;
+  }
 
   // Special case where we just want the first piece of info we can get.
   if (timeLength_ms == 0)
   {
-    return _micDirectionBuffer[startIndex].directionIndex;
+    const auto& currentEntry = _micDirectionBuffer[_micDirectionBufferIndex];
+    return (currentEntry.directionIndex == direction) ? currentEntry.latestConfidence : 0;
   }
 
-  DirectionHistoryCount directionCount = GetDirectionCountAtIndex(startIndex, timeLength_ms);
-  return GetBestDirection(directionCount);
+  const DirectionTotals directionTotals = GetDirectionTotalsAtPos(kNewestNodePos, timeLength_ms);
+  const uint32_t count = directionTotals.count[direction];
+  if (count == 0)
+  {
+    return 0;
+  }
+  const auto confidenceSum = static_cast<int32_t>(directionTotals.confidence[direction]);
+  return Util::numeric_cast<MicDirectionConfidence>(confidenceSum / static_cast<int32_t>(count));
 }
 
-MicDirectionHistory::DirectionHistoryCount MicDirectionHistory::GetDirectionCountAtIndex(uint32_t startIndex, 
-                                                                                         TimeStamp_t timeLength_ms) const
+MicDirectionHistory::DirectionTotals MicDirectionHistory::GetDirectionTotalsAtPos(uint32_t pos,
+                                                                                 TimeStamp_t timeLength_ms) const
 {
-  DirectionHistoryCount directionCount{};
-  uint32_t curIndex = startIndex;
-  while (timeLength_ms > 0)
-  {
-    const auto& currentNode = _micDirectionBuffer[curIndex];
-    const auto prevNodeIdx = GetPrevNodeIdx(curIndex);
-    // If we've wrapped all the way around, we're done
-    if (prevNodeIdx == _micDirectionBufferIndex)
-    {
-      break;
-    }
-    const auto& prevNode = _micDirectionBuffer[prevNodeIdx];
-    const auto nodeTimeDiff = TimeStamp_t(currentNode.timestampEnd - prevNode.timestampEnd);
+  DirectionTotals directionTotals{};
+  const uint32_t firstPos = GetFirstPosInTimeLength(pos, timeLength_ms);
+  if (timeLength_ms == 0 || firstPos > pos)
+  {
+    return directionTotals;
+  }
 
-    // If we're using up the last of the time we're counting over, do a proportional count and break
-    if (nodeTimeDiff >= timeLength_ms)
-    {
-      const TimeStamp_t divisor = nodeTimeDiff > 0 ? nodeTimeDiff : 1;
-      const auto proportionCount = (timeLength_ms * currentNode.count) / divisor;
-      directionCount[currentNode.directionIndex] += proportionCount;
-      timeLength_ms = 0;
-      break;
-    }
+  // Every node after the first one is fully counted
+  const DirectionTotals& totalsThroughPos = GetTotalsThroughPos(pos);
+  const DirectionTotals& totalsThroughFirst = GetTotalsThroughPos(firstPos);
+  for (MicDirectionIndex i = kFirstMicDirectionIndex; i < kNumMicDirections; ++i)
+  {
+    directionTotals.count[i] = totalsThroughPos.count[i] - totalsThroughFirst.count[i];
+    directionTotals.confidence[i] = totalsThroughPos.confidence[i] - totalsThroughFirst.confidence[i];
+  }
 
-    // otherwise count everything from this node and move on
-    timeLength_ms -= nodeTimeDiff;
-    directionCount[currentNode.directionIndex] += currentNode.count;
-    curIndex = prevNodeIdx;
+  // The first node is counted in full if history runs out with it, otherwise proportionally to the part of it that
+  // is within the time length
+  const auto& firstNode = GetNodeAtPos(firstPos);
+  if (firstNode.directionIndex >= kNumMicDirections)
+  {
+    return directionTotals;
   }
+  const auto posEnd = (TimeStamp_t)GetNodeAtPos(pos).timestampEnd;
+  const auto prevEnd = (TimeStamp_t)GetNodeAtPos(firstPos - 1).timestampEnd;
+  const auto firstEnd = (TimeStamp_t)firstNode.timestampEnd;
+  uint32_t firstCount = firstNode.count;
+  if (posEnd - prevEnd >= timeLength_ms)
+  {
+    const TimeStamp_t nodeTimeDiff = firstEnd - prevEnd;
+    const TimeStamp_t divisor = nodeTimeDiff > 0 ? nodeTimeDiff : 1;
+    const TimeStamp_t timeInNode = timeLength_ms - (posEnd - firstEnd);
+    firstCount = (timeInNode * firstNode.count) / divisor;
+  }
+  directionTotals.count[firstNode.directionIndex] += firstCount;
+  directionTotals.confidence[firstNode.directionIndex] += firstCount * static_cast<int32_t>(firstNode.confidenceAvg);
 
-  return directionCount;
+  return directionTotals;
 }
 
-MicDirectionIndex MicDirectionHistory::GetBestDirection(const DirectionHistoryCount& directionCount)
+MicDirectionIndex MicDirectionHistory::GetBestDirection(const DirectionTotals& directionTotals)
 {
   MicDirectionIndex bestIndex = kMicDirectionUnknown;
   uint32_t bestCount = 0;
   for (MicDirectionIndex i = kFirstMicDirectionIndex; i < kNumMicDirections; ++i) // Don't consider unknown direction
   {
-    if (directionCount[i] > bestCount)
+    if (directionTotals.count[i] > bestCount)
     {
-      bestCount = directionCount[i];
+      bestCount = directionTotals.count[i];
       bestIndex = i;
     }
   }
@@ -219,7 +312,7 @@ MicDirectionNodeList MicDirectionHistory::GetRecentHistory(TimeStamp_t timeLengt
     return results;
   }
 
-  return GetHistoryAtIndex(startIndex, timeLength_ms);
+  return GetHistoryAtPos(kNewestNodePos, timeLength_ms);
 }
 
 MicDirectionNodeList MicDirectionHistory::GetHistoryAtTime(EngineTimeStamp_t timestampEnd,
@@ -237,19 +330,13 @@ MicDirectionNodeList MicDirectionHistory::GetHistoryAtTime(EngineTimeStamp_t tim
     }
   }
 
-  // Find the node containing the timestamp asked about
-  auto endingIndex = _micDirectionBufferIndex;
-  auto prevToEndingIndex = GetPrevNodeIdx(endingIndex);
-  while (prevToEndingIndex != _micDirectionBufferIndex && _micDirectionBuffer[prevToEndingIndex].timestampEnd >= timestampEnd)
-  {
-    endingIndex = prevToEndingIndex;
-    prevToEndingIndex = GetPrevNodeIdx(endingIndex);
-  }
-
-  const auto& endingNode = _micDirectionBuffer[endingIndex];
+  // Find the node containing the timestamp asked about, the one after the last node to end before it
+  const auto timestamp = (TimeStamp_t)timestampEnd;
+  const auto endingPos = (timestamp > 0) ? GetNumNodesEndedBy(timestamp - 1, kNewestNodePos) : 0;
+  const auto& endingNode = GetNodeAtPos(endingPos);
 
   // Did we hit the end of history?
-  if (prevToEndingIndex == _micDirectionBufferIndex)
+  if (endingPos == 0)
   {
     MicDirectionNodeList results;
     if (endingNode.IsValid())
@@ -260,7 +347,8 @@ MicDirectionNodeList MicDirectionHistory::GetHistoryAtTime(EngineTimeStamp_t tim
   }
 
   // Was the full time length requested within this node?
-  const auto timeSpentInEndNode = timestampEnd - _micDirectionBuffer[prevToEndingIndex].timestampEnd;
+  const auto prevToEndingPos = endingPos - 1;
+  const auto timeSpentInEndNode = timestampEnd - GetNodeAtPos(prevToEndingPos).timestampEnd;
   if (timeSpentInEndNode >= timeLength_ms)
   {
     MicDirectionNodeList results;
@@ -273,7 +361,7 @@ MicDirectionNodeList MicDirectionHistory::GetHistoryAtTime(EngineTimeStamp_t tim
 
   // Start with the count from before the ending node
   const auto timePrevToNode = TimeStamp_t(timeLength_ms - timeSpentInEndNode);
-  MicDirectionNodeList results = GetHistoryAtIndex(prevToEndingIndex, timePrevToNode);
+  MicDirectionNodeList results = GetHistoryAtPos(prevToEndingPos, timePrevToNode);
   if (endingNode.IsValid())
   {
     results.push_back(endingNode);
@@ -282,38 +370,21 @@ MicDirectionNodeList MicDirectionHistory::GetHistoryAtTime(EngineTimeStamp_t tim
   return results;
 }
 
-MicDirectionNodeList MicDirectionHistory::GetHistoryAtIndex(uint32_t startIndex,
-                                                                     TimeStamp_t timeLength_ms) const
+MicDirectionNodeList MicDirectionHistory::GetHistoryAtPos(uint32_t pos, TimeStamp_t timeLength_ms) const
 {
   MicDirectionNodeList results;
-  uint32_t curIndex = startIndex;
-  while (timeLength_ms > 0)
+  if (timeLength_ms == 0)
   {
-    const auto& currentNode = _micDirectionBuffer[curIndex];
-    const auto prevNodeIdx = GetPrevNodeIdx(curIndex);
-    // If we've wrapped all the way around, we're done
-    if (prevNodeIdx == _micDirectionBufferIndex)
-    {
-      break;
-    }
-    const auto& prevNode = _micDirectionBuffer[prevNodeIdx];
-    const auto nodeTimeDiff = (TimeStamp_t)(currentNode.timestampEnd - prevNode.timestampEnd);
-
-    // otherwise include this node and move on
-    if (nodeTimeDiff >= timeLength_ms)
-    {
-      timeLength_ms = 0;
-    }
-    else
-    {
-      timeLength_ms -= nodeTimeDiff;
-    }
+    return results;
+  }
 
+  for (uint32_t curPos = GetFirstPosInTimeLength(pos, timeLength_ms); curPos <= pos; ++curPos)
+  {
+    const auto& currentNode = GetNodeAtPos(curPos);
     if (currentNode.IsValid())
     {
-      results.push_front(currentNode);
+      results.push_back(currentNode);
     }
-    curIndex = prevNodeIdx;
   }
 
   return results;
@@ -383,6 +454,8 @@ void MicDirectionHistory::AddDirectionSample(EngineTimeStamp_t timestamp,
   else
   {
     _micDirectionBufferIndex = GetNextNodeIdx(_micDirectionBufferIndex);
+    _totalsBeforeNode[_micDirectionBufferIndex] = _totals;
+    ++_numNodes;
     auto& newEntry = _micDirectionBuffer[_micDirectionBufferIndex];
     newEntry.timestampBegin = timestamp;
     newEntry.timestampEnd = timestamp;
@@ -394,6 +467,12 @@ void MicDirectionHistory::AddDirectionSample(EngineTimeStamp_t timestamp,
     newEntry.count = 1;
   }
 
+  if (newDirection < kNumMicDirections)
+  {
+    ++_totals.count[newDirection];
+    _totals.confidence[newDirection] += static_cast<int32_t>(newConf);
+  }
+
   // only store the selected direction when it is known
   // note: when the robot is moving, selected direction is set to unknown
   //       when no focus direction is set, this will be the same as newDirection
@@ -570,6 +649,60 @@ void MicDirectionHistory::SendMicDataToWebserver()
   #endif
 }
   
+void MicDirectionHistory::SendHistoryToWebserver()
+{
+  #if SEND_MICENGINE_DATA
+  {
+    if ( (nullptr == _webService) || !_webService->IsWebVizClientSubscribed(kWebVizHistoryModuleName) )
+    {
+      return;
+    }
+
+    const double currentTime = BaseStationTimer::getInstance()->GetCurrentTimeInSecondsDouble();
+    const auto& newestNode = _micDirectionBuffer[_micDirectionBufferIndex];
+    const bool hasChanged = ( _numNodes != _webVizHistoryData.newestNodeSent ) ||
+                            ( newestNode.count != _webVizHistoryData.newestNodeCountSent );
+    if ( hasChanged && ( currentTime >= _webVizHistoryData.nextUpdateTime ) )
+    {
+      // The newest node sent last time may have grown since, so it is sent again
+      _webService->SendToWebViz( kWebVizHistoryModuleName, GetHistoryAsJson(_webVizHistoryData.newestNodeSent) );
+
+      _webVizHistoryData.newestNodeSent = _numNodes;
+      _webVizHistoryData.newestNodeCountSent = newestNode.count;
+      _webVizHistoryData.nextUpdateTime = currentTime + kRTS_WebVizUpdateInterval;
+    }
+  }
+  #endif
+}
+
+Json::Value MicDirectionHistory::GetHistoryAsJson(uint64_t fromNode) const
+{
+  // Nodes are keyed by id on the client, a node that is sent again replaces the earlier copy
+  Json::Value data;
+  Json::Value& nodes = data["nodes"];
+  nodes = Json::Value(Json::arrayValue);
+
+  const uint64_t numNodesInHistory = std::min<uint64_t>(_numNodes, kNewestNodePos);
+  for (uint64_t nodeId = std::max(fromNode, _numNodes - numNodesInHistory); nodeId <= _numNodes; ++nodeId)
+  {
+    const auto& node = GetNodeAtPos(Util::numeric_cast<uint32_t>(kNewestNodePos - (_numNodes - nodeId)));
+    if (!node.IsValid())
+    {
+      continue;
+    }
+    Json::Value nodeData;
+    nodeData["id"] = Json::UInt64(nodeId);
+    nodeData["direction"] = node.directionIndex;
+    nodeData["timestampBegin"] = (TimeStamp_t)node.timestampBegin;
+    nodeData["timestampEnd"] = (TimeStamp_t)node.timestampEnd;
+    nodeData["count"] = node.count;
+    nodeData["confidenceAvg"] = node.confidenceAvg;
+    nodeData["confidenceMax"] = node.confidenceMax;
+    nodes.append(nodeData);
+  }
+  return data;
+}
+
 // VadTrackingData struct
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MicDirectionHistory::VadTrackingData::ResetData() {
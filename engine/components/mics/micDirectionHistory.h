@@ -5,6 +5,11 @@
 * Created: 11/14/2017
 *
 * Description: Holds onto microphone direction history
+*              History is a ring of nodes, one per run of samples in the same direction. Next to each node the ring
+*              keeps the per-direction sample counts and confidence sums of all the samples before it, so the counts
+*              over any stretch of history are the difference of two snapshots. Finding the nodes a time range starts
+*              and ends in is a binary search, since samples come in time order, which keeps direction and confidence
+*              queries from walking the history.
 *
 * Copyright: Anki, Inc. 2017
 *
@@ -19,10 +24,16 @@
 #include "engine/robotComponents_fwd.h"
 #include "clad/robotInterface/messageRobotToEngine.h"
 #include "util/entityComponent/iDependencyManagedComponent.h"
+#include "util/signals/simpleSignal_fwd.h"
 
 #include <array>
 #include <cstdint>
 #include <functional>
+#include <vector>
+
+namespace Json {
+  class Value;
+}
 
 namespace Anki {
 namespace Vector {
@@ -55,6 +66,10 @@ public:
   MicDirectionIndex GetRecentDirection(TimeStamp_t timeLength_ms = kDefaultDirectionRecentTime_ms) const;
   MicDirectionIndex GetDirectionAtTime(EngineTimeStamp_t timestampEnd, TimeStamp_t timeLength_ms) const;
 
+  // Average confidence of the samples heard from the direction during the most recent timeLength_ms, 0 if none were
+  MicDirectionConfidence GetRecentConfidence(MicDirectionIndex direction,
+                                              TimeStamp_t timeLength_ms = kDefaultDirectionRecentTime_ms) const;
+
   // Selected direction is only valid when microphone beamforming is enabled, the direction will either be the what the
   // mic processing has determined same as "RecentDirection" or if the beamforming direction has been specifically set.
   MicDirectionIndex GetSelectedDirection() const { return _mostRecentSelectedDirection; }
@@ -75,6 +90,19 @@ private:
   std::array<MicDirectionNode, kMicDirectionHistoryLen> _micDirectionBuffer;
   uint32_t _micDirectionBufferIndex = 0;
 
+  // Running totals of every sample so far, by direction (unknown direction isn't counted)
+  struct DirectionTotals
+  {
+    std::array<uint32_t, kNumMicDirections> count{};
+    std::array<uint32_t, kNumMicDirections> confidence{}; // Sum of sample confidences, wrapping around is harmless
+  };
+  DirectionTotals _totals;
+  // _totals as they were when each node of _micDirectionBuffer was started
+  std::array<DirectionTotals, kMicDirectionHistoryLen> _totalsBeforeNode;
+
+  // Number of nodes started so far, which is also the id of the newest one
+  uint64_t _numNodes = 0;
+
   // direction that we're currently focusing our mics
   MicDirectionIndex _mostRecentSelectedDirection = kMicDirectionUnknown;
 
@@ -119,24 +147,46 @@ private:
     MicDirectionIndex       direction = kMicDirectionUnknown;
   };
   
+  // The direction history webViz module only gets the nodes that changed since it was last sent to
+  struct WebVizHistoryData
+  {
+    uint64_t                newestNodeSent = 0;
+    uint32_t                newestNodeCountSent = 0;
+    double                  nextUpdateTime = 0.0;
+  };
+
   SoundTrackingData         _soundTrackingData;
   VadTrackingData           _vadTrackingData;
   WebServerData             _webServerData;
+  WebVizHistoryData         _webVizHistoryData;
   std::vector<SoundReactionListener> _soundReactors;
-
-  using DirectionHistoryCount = std::array<uint32_t, (kLastMicDirectionIndex - kFirstMicDirectionIndex + 1)>;
+  std::vector<Signal::SmartHandle> _signalHandles;
 
   uint32_t GetNextNodeIdx(uint32_t nodeIndex) const;
   uint32_t GetPrevNodeIdx(uint32_t nodeIndex) const;
   void PrintNodeData(uint32_t index) const;
 
-  DirectionHistoryCount GetDirectionCountAtIndex(uint32_t startIndex, TimeStamp_t timeLength_ms) const;
-  MicDirectionNodeList GetHistoryAtIndex(uint32_t startIndex, TimeStamp_t timeLength_ms) const;
-  static MicDirectionIndex GetBestDirection(const DirectionHistoryCount& directionCount);
+  // Positions count nodes from the oldest one (0) to the newest one (kNewestNodePos)
+  static constexpr uint32_t kNewestNodePos = kMicDirectionHistoryLen - 1;
+  const MicDirectionNode& GetNodeAtPos(uint32_t pos) const;
+  // Totals of all the samples up to and including the node at pos
+  const DirectionTotals& GetTotalsThroughPos(uint32_t pos) const;
+  // Number of nodes before endPos that ended at or before timestamp
+  uint32_t GetNumNodesEndedBy(TimeStamp_t timestamp, uint32_t endPos) const;
+  // First node in the timeLength_ms of history that ends with the node at pos. Unless it is pos itself, it is only
+  // partly included
+  uint32_t GetFirstPosInTimeLength(uint32_t pos, TimeStamp_t timeLength_ms) const;
+
+  DirectionTotals GetDirectionTotalsAtPos(uint32_t pos, TimeStamp_t timeLength_ms) const;
+  MicDirectionNodeList GetHistoryAtPos(uint32_t pos, TimeStamp_t timeLength_ms) const;
+  static MicDirectionIndex GetBestDirection(const DirectionTotals& directionTotals);
 
   double AccumulatePeakPowerLevel( double latestPeakPowerLevel );
   void ProcessSoundReactors();
   void SendMicDataToWebserver();
+  void SendHistoryToWebserver();
+  // Nodes from id fromNode up to the newest one, as far as they are still in the history
+  Json::Value GetHistoryAsJson(uint64_t fromNode) const;
 };
 
 } // namespace Vector
@@ -49,6 +49,7 @@ NVStorageComponent::NVStorageComponent()
 
 NVStorageComponent::~NVStorageComponent()
 {
+  CommitDirtyEntries();
 }
 
 void NVStorageComponent::InitDependent(Vector::Robot* robot, const RobotCompMap& dependentComps) 
@@ -103,6 +104,7 @@ bool NVStorageComponent::Write(NVEntryTag tag,
   }
   
   // All data writes must be word-aligned
+  const size_t dataSize = size;
   size = MakeWordAligned(size);
   
   if(!_writingFactory)
@@ -124,16 +126,26 @@ bool NVStorageComponent::Write(NVEntryTag tag,
     return false;
   }
   
-  PRINT_CH_INFO("NVStorage", "NVStorageComponent.Write.WritingData", "%s", EnumToString(tag));
-  
-  _tagDataMap[tag] = std::vector<u8>(data,data+size);
+  // Pad with zeros rather than reading past the end of the caller's data
+  std::vector<u8> alignedData(data, data + dataSize);
+  alignedData.resize(size, 0);
+
+  // Rewriting what is already stored doesn't need to touch the disk
+  auto iter = _tagDataMap.find(tag);
+  const bool isUnchanged = (iter != _tagDataMap.end()) && (iter->second == alignedData);
+  if (isUnchanged) {
+    PRINT_CH_DEBUG("NVStorage", "NVStorageComponent.Write.Unchanged", "%s", EnumToString(tag));
+  } else {
+    PRINT_CH_INFO("NVStorage", "NVStorageComponent.Write.WritingData", "%s", EnumToString(tag));
+    _tagDataMap[tag] = std::move(alignedData);
+  }
   
   if (callback) {
     PRINT_CH_DEBUG("NVStorage", "NVStorageComponent.Write.ExecutingCallback", "%s", EnumToString(tag));
     callback(NVResult::NV_OKAY);
   }
   
-  return WriteEntryToFile(tag);
+  return isUnchanged || CommitEntry(tag);
 }
 
 bool NVStorageComponent::Erase(NVEntryTag tag,
@@ -171,13 +183,14 @@ bool NVStorageComponent::Erase(NVEntryTag tag,
     callback(NVResult::NV_OKAY);
   }
   
-  return WriteEntryToFile(tag);
+  return CommitEntry(tag);
 }
   
   
 bool NVStorageComponent::WipeAll(NVStorageWriteEraseCallback callback)
 {
   _tagDataMap.clear();
+  _dirtyTags.clear();
   
   if (callback) {
     PRINT_CH_DEBUG("NVStorage", "NVStorageComponent.WipeAll.ExecutingCallback", "");
@@ -278,11 +291,42 @@ bool NVStorageComponent::WriteEntryToFile(NVEntryTag tag)
     return false;
   }
 
-  sync();
-
   #endif // if !defined(ANKI_PLATFORM_OSX)
   return true;
 }
+
+bool NVStorageComponent::CommitEntry(NVEntryTag tag)
+{
+  if (!IsFactoryEntryTag(tag)) {
+    _dirtyTags.insert(tag);
+    return true;
+  }
+
+  // Factory data is written by playpen right before the robot may be powered off, so it can't wait
+  _dirtyTags.erase(tag);
+  const bool success = WriteEntryToFile(tag);
+  #if !defined(ANKI_PLATFORM_OSX)
+  sync();
+  #endif
+  return success;
+}
+
+void NVStorageComponent::CommitDirtyEntries()
+{
+  if (_dirtyTags.empty()) {
+    return;
+  }
+
+  for (const auto tag : _dirtyTags) {
+    WriteEntryToFile(tag);
+  }
+  PRINT_CH_DEBUG("NVStorage", "NVStorageComponent.CommitDirtyEntries", "Committed %zu entries", _dirtyTags.size());
+  _dirtyTags.clear();
+
+  #if !defined(ANKI_PLATFORM_OSX)
+  sync();
+  #endif
+}
   
 void NVStorageComponent::LoadDataFromFiles()
 {
@@ -362,6 +406,7 @@ void NVStorageComponent::LoadDataFromFiles()
   
 void NVStorageComponent::UpdateDependent(const RobotCompMap& dependentComps)
 {
+  CommitDirtyEntries();
 }
   
 #ifdef SIMULATOR
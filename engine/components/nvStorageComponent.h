@@ -24,6 +24,7 @@
 
 #include <vector>
 #include <map>
+#include <set>
 #include <unordered_map>
 
 namespace Anki {
@@ -56,6 +57,8 @@ public:
   
   // Save data to robot under the given tag.
   // Returns true if request was successfully sent.
+  // The data is readable immediately, but is only committed to disk at the end of the tick (along with
+  // any other writes made that tick), except for factory entries which are committed right away.
   using NVStorageWriteEraseCallback = std::function<void(NVStorage::NVResult res)>;
   bool Write(NVStorage::NVEntryTag tag,
              const u8* data, size_t size,
@@ -104,9 +107,18 @@ private:
   using TagDataMap = std::unordered_map<NVStorage::NVEntryTag, std::vector<u8> >;
   TagDataMap _tagDataMap;
   
+  // Entries changed since the last commit
+  std::set<NVStorage::NVEntryTag> _dirtyTags;
+
   // Data file read/write methods
   void LoadDataFromFiles();
   bool WriteEntryToFile(NVStorage::NVEntryTag tag);
+
+  // Writes the entry now if it is a factory entry, otherwise marks it to be written by CommitDirtyEntries()
+  bool CommitEntry(NVStorage::NVEntryTag tag);
+
+  // Writes every dirty entry, then syncs once for all of them
+  void CommitDirtyEntries();
   
   // Path of NVStorage data folder
   std::string _kStoragePath;
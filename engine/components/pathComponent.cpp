@@ -23,13 +23,20 @@
 #include "engine/minimalAnglePlanner.h"
 #include "engine/namedColors/namedColors.h"
 #include "engine/pathDolerOuter.h"
+#include "engine/pathFootprintCache.h"
 #include "engine/pathPlanner.h"
 #include "engine/robot.h"
 #include "engine/robotInterface/messageHandler.h"
 #include "engine/robotManager.h"
 #include "engine/speedChooser.h"
 #include "engine/viz/vizManager.h"
+#include "engine/navMap/iNavMap.h"
+#include "engine/navMap/mapComponent.h"
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "util/console/consoleInterface.h"
+#include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
+#include "json/json.h"
 #include <limits>
 
 #define LOG_CHANNEL "Planner"
@@ -41,8 +48,27 @@ namespace {
 static constexpr const float kMaxDistanceForShortPlanner_mm = 40.0f;
 static constexpr const float kMinDistanceForMinAnglePlanner_mm = 1.0f;
 static constexpr const float kSendMsgFailedTimeout_s = 1.0f;
+
+// how far the robot may have moved since a computed (but not yet sent) path was planned for it to still be used
+static constexpr const float kMaxPlanStartDrift_mm = 5.0f;
+static constexpr const float kMaxPlanStartDrift_rad = DEG_TO_RAD(3.0f);
+
+// cache folder recorded planner scenarios go to. Copy them to resources/test/plannerScenarios to benchmark with them
+static const char* const kPlannerScenarioFolder = "plannerScenarios";
+
+Json::Value PoseToJson(const Pose3d& pose)
+{
+  Json::Value json;
+  json["x_mm"]      = pose.GetTranslation().x();
+  json["y_mm"]      = pose.GetTranslation().y();
+  json["angle_rad"] = pose.GetRotationAngle<'Z'>().ToFloat();
+  return json;
+}
 }
 
+// record the map, start and goals of every plan, for replaying them in the planner benchmark
+CONSOLE_VAR(bool, kRecordPlannerScenarios, "Planner", false);
+
 // info for the current plan
 struct PlanParameters
 {
@@ -113,6 +139,7 @@ void PathComponent::InitDependent(Vector::Robot* robot, const RobotCompMap& depe
   _robot = robot;
   const CozmoContext* context = _robot->GetContext();
   _speedChooser = std::make_unique<SpeedChooser>(*_robot);
+  _footprintCache = std::make_unique<PathFootprintCache>();
   if( context ) {
     // might not exist (e.g. unit tests)
     _pdo.reset(new PathDolerOuter(context->GetRobotManager()->GetMsgHandler()));
@@ -367,6 +394,12 @@ void PathComponent::UpdateCurrentPathSegment(s8 currPathSegment)
 
   if( _driveToPoseStatus == ERobotDriveToPoseStatus::FollowingPath ) {
     if( _pdo ) {
+      // never send segments that became unsafe since the path was planned. Only the segments near map changes since
+      // the last check are checked again
+      if( _selectedPathPlanner && _selectedPathPlanner->ChecksForCollisions() ) {
+        _pdo->SetNumSafeSegments( _footprintCache->Update(_robot->GetMapComponent()) );
+      }
+
       // Dole out more path segments to the physical robot if needed:
       _pdo->Update(_currPathSegment);
     }
@@ -840,21 +873,39 @@ Result PathComponent::ConfigureAndStartPlanner(const std::vector<Pose3d>& poses,
 
   PlanParameters newPlanParams(_robot, poses);
 
+  bool stoppedPlanner = false;
   if( _plannerActive ) {
     if ( !_currPlanParams->IsEqual(newPlanParams) ) {
       _selectedPathPlanner->StopPlanning();
       _plannerActive = false;
+      stoppedPlanner = true;
     } else {
       // already started the planner, and will now start following the path on update cycle after plan completes
       LOG_INFO("PathComponent.ConfigureAndStartPlanner.AlreadyStartedWithMatchingParams","");
+      if( selectedPoseIndexPtr ) {
+        // the plan may have been started by someone else (see PrecomputePath), so report to this caller
+        _plannerSelectedPoseIndex = selectedPoseIndexPtr;
+      }
       return RESULT_OK;
     }
   }
 
   if( IsActive() ) {
+    // A path that hasn't been sent to the robot yet has to be planned again if planning was just stopped, or
+    // if it was computed ahead of time (see PrecomputePath) and the robot has moved since
+    const bool mustReplanUnsentPath = !HasPathToFollow() &&
+                                      (stoppedPlanner ||
+                                       !newPlanParams.driveCenter.IsSameAs(_currPlanParams->driveCenter,
+                                                                           kMaxPlanStartDrift_mm,
+                                                                           kMaxPlanStartDrift_rad));
+    
     // we may be following the same path, so only check the goals and originID for equality
     newPlanParams.driveCenter = _currPlanParams->driveCenter;
-    if ( !_currPlanParams->IsEqual(newPlanParams) ) {
+    if ( mustReplanUnsentPath ) {
+      LOG_INFO("PathComponent.ConfigureAndStartPlanner.ReplanUnsentPath",
+               "Robot moved since the path was planned, or planning was stopped. Planning again");
+      Abort();
+    } else if ( !_currPlanParams->IsEqual(newPlanParams) ) {
       // stop doing what we are doing, so we can make a new plan
       LOG_INFO("PathComponent.ConfigureAndStartPlanner.AlreadyBusy",
                "Path component status was '%s'. Aborting current plan",
@@ -862,6 +913,10 @@ Result PathComponent::ConfigureAndStartPlanner(const std::vector<Pose3d>& poses,
       Abort();
     } else {
       // it's already executing this plan.
+      if( selectedPoseIndexPtr && !HasPathToFollow() ) {
+        // the selected pose is only set once the path is sent, so it can still go to this caller
+        _plannerSelectedPoseIndex = selectedPoseIndexPtr;
+      }
       if( !_plannerActive && IsPlanReady() && _startFollowingPath ) {
         TryCompletingPath();
       } else {
@@ -920,6 +975,10 @@ bool PathComponent::StartPlanner(const Pose3d& driveCenterPose)
     return false;
   }
 
+  if( kRecordPlannerScenarios ) {
+    RecordPlannerScenario(driveCenterPose);
+  }
+
   EComputePathStatus status = _selectedPathPlanner->ComputePath(driveCenterPose, _currPlanParams->targetPoses);
   if( status == EComputePathStatus::Error ) {
     auto fallbackSuccess = ReplanWithFallbackPlanner();
@@ -938,6 +997,45 @@ bool PathComponent::StartPlanner()
   return StartPlanner(driveCenterPose);
 }
 
+void PathComponent::RecordPlannerScenario(const Pose3d& driveCenterPose) const
+{
+  const auto* platform = _robot->GetContextDataPlatform();
+  const auto map = _robot->GetMapComponent().GetCurrentMemoryMap();
+  if( (platform == nullptr) || (map == nullptr) ) {
+    return;
+  }
+
+  // everything is saved relative to the map origin
+  const Pose3d& origin = _robot->GetWorldOrigin();
+  Json::Value scenario;
+  Pose3d pose;
+  if( !driveCenterPose.GetWithRespectTo(origin, pose) ) {
+    LOG_WARNING("PathComponent.RecordPlannerScenario.StartNotInOrigin", "");
+    return;
+  }
+  scenario["start"] = PoseToJson(pose);
+  for( const auto& target : _currPlanParams->targetPoses ) {
+    if( target.GetWithRespectTo(origin, pose) ) {
+      scenario["goals"].append( PoseToJson(pose) );
+    }
+  }
+  scenario["planner"] = _selectedPathPlanner->GetName();
+
+  static int scenarioCount = 0;
+  const std::string name = "scenario_" + std::to_string(BaseStationTimer::getInstance()->GetCurrentTimeStamp()) +
+                           "_" + std::to_string(scenarioCount++);
+  const std::string folder = platform->pathToResource(Util::Data::Scope::Cache, kPlannerScenarioFolder);
+  scenario["map"] = name + ".nmap";
+
+  if( !map->Save( Util::FileUtils::FullFilePath({folder, name + ".nmap"}) ) ||
+      !platform->writeAsJson( Util::Data::Scope::Cache, std::string(kPlannerScenarioFolder) + "/" + name + ".json", scenario ) ) {
+    LOG_WARNING("PathComponent.RecordPlannerScenario.WriteFailed", "%s", name.c_str());
+    return;
+  }
+
+  LOG_INFO("PathComponent.RecordPlannerScenario", "Recorded %s with %u goals", name.c_str(), scenario["goals"].size());
+}
+
 bool PathComponent::ReplanWithFallbackPlanner()
 {
   if( ! _fallbackPathPlanner ) {
@@ -1002,12 +1100,17 @@ void PathComponent::RestartPlannerIfNeeded()
     {
       LOG_DEBUG("PathComponent.Replan.Running", "ComputeNewPathIfNeeded running");
       const Planning::Path currPath = _pdo->GetPath();
+      const size_t numSafeSegments = _selectedPathPlanner->ChecksForCollisions()
+                                     ? _footprintCache->Update(_robot->GetMapComponent())
+                                     : currPath.GetNumSegments();
       if (currPath.GetNumSegments() > 0)
       {
-        const float startAngle = currPath.GetSegmentConstRef(0).GetStartAngle();
-        Planning::Path validSubPath;
-        if (!_selectedPathPlanner->CheckIsPathSafe(currPath, startAngle, validSubPath))
+        if (numSafeSegments < currPath.GetNumSegments())
         {
+          Planning::Path validSubPath;
+          for (u8 i = 0; i < numSafeSegments; ++i) {
+            validSubPath.AppendSegment( currPath.GetSegmentConstRef(i) );
+          }
           _isReplanning = true;
           // entire path is not safe, set the current path to just the valid portion
           if (_currPathSegment >= validSubPath.GetNumSegments())
@@ -1023,6 +1126,8 @@ void PathComponent::RestartPlannerIfNeeded()
             }
             LOG_INFO("PathComponent.RestartPlannerIfNeeded.PathUnsafe.TrimmingToSafeSubpath", "segIdx=%d numValidSeg=%u", (int)_currPathSegment, validSubPath.GetNumSegments());
             _pdo->ReplacePath( validSubPath );
+            _pdo->SetNumSafeSegments( validSubPath.GetNumSegments() );
+            _footprintCache->Truncate( validSubPath.GetNumSegments() );
             // redraw the path
             _robot->GetContext()->GetVizManager()->DrawPath(_robot->GetID(), _pdo->GetPath(), NamedColors::EXECUTED_PATH);
           }
@@ -1053,6 +1158,9 @@ Result PathComponent::ClearPath()
     LOG_DEBUG("PathComponent.ClearPath.ClearingPDO", "sent=%u rcvd=%u cancel=%u", _lastSentPathID, _lastRecvdPathID, _lastCanceledPathID);
     _pdo->ClearPath();
   }
+  if(_footprintCache) {
+    _footprintCache->Clear();
+  }
 
   _currPathSegment = -1;
 
@@ -1086,6 +1194,18 @@ bool PathComponent::IsPlanReady() const
   return ready;
 }
 
+bool PathComponent::IsPrecomputedPathTo(const std::vector<Pose3d>& poses) const
+{
+  if( !IsActive() || HasPathToFollow() || (_currPlanParams == nullptr) ) {
+    return false;
+  }
+  
+  // the robot may have moved since planning, so only compare the goals and origin
+  PlanParameters planParams(_robot, poses);
+  planParams.driveCenter = _currPlanParams->driveCenter;
+  return _currPlanParams->IsEqual(planParams);
+}
+
 bool PathComponent::IsActive() const
 {
   switch(_driveToPoseStatus) {
@@ -1201,6 +1321,7 @@ Result PathComponent::ExecutePath(const Planning::Path& path)
       if( _pdo ) {
         LOG_DEBUG("PathComponent.ExecutePath.SetPathPDO", "sent=%u rcvd=%u cancel=%u", _lastSentPathID, _lastRecvdPathID, _lastCanceledPathID);
         _pdo->SetPath(path);
+        _footprintCache->SetPath(path);
       }
 
       LOG_INFO("PathComponent.SendExecutePath",
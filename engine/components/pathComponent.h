@@ -35,6 +35,7 @@ class CozmoContext;
 class IActionRunner;
 class IPathPlanner;
 class PathDolerOuter;
+class PathFootprintCache;
 class Robot;
 class SpeedChooser;
 struct PlanParameters;
@@ -129,6 +130,9 @@ public:
                         std::shared_ptr<Planning::GoalID> selectedPoseIndexPtr = {});
   // Check if a precomputed path is ready
   bool IsPlanReady() const;
+  
+  // True if a path to these poses is being (or has been) computed but hasn't been sent to the robot yet
+  bool IsPrecomputedPathTo(const std::vector<Pose3d>& poses) const;
 
   // set or clear the custom motion profile that all motion should follow. If cleared, then defaults will be
   // used, or the speed chooser will be used if enabled
@@ -232,6 +236,10 @@ private:
   bool StartPlanner();
   bool StartPlanner(const Pose3d& driveCenterPose);
 
+  // writes the current map, start and targets of a plan to the cache folder, so it can be replayed by the planner
+  // benchmark (see kRecordPlannerScenarios)
+  void RecordPlannerScenario(const Pose3d& driveCenterPose) const;
+
   // configures the start state and goal states for path, and launches the planner if it is 
   // not already computing that path
   Result ConfigureAndStartPlanner(const std::vector<Pose3d>& poses,
@@ -271,6 +279,9 @@ private:
   std::unique_ptr<SpeedChooser>   _speedChooser;
   std::unique_ptr<PathDolerOuter> _pdo;
 
+  // footprint of the path the pdo holds, to tell how much of it is still safe
+  std::unique_ptr<PathFootprintCache> _footprintCache;
+
   // There are multiple planners, only one of which can be selected at a time. Some of these might point to
   // the same planner.
 
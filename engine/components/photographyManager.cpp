@@ -33,6 +33,7 @@
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/DAS.h"
 
+#include <algorithm>
 #include <sstream>
 #include <iomanip>
 
@@ -81,6 +82,7 @@ namespace
   float kSharpeningAmount = 0.f;
   int8_t kSaveQuality     = 95;
   float kThumbnailScale   = 0.125f;
+  uint8_t kBurstLength    = 3; // frames to pick the sharpest photo from
   
   const char* kModuleName = "PhotographyManager";
   
@@ -125,6 +127,7 @@ void PhotographyManager::InitDependent(Robot* robot, const RobotCompMap& depende
   kSharpeningAmount = JsonTools::ParseFloat(config, "SharpeningAmount", kModuleName);
   kSaveQuality = JsonTools::GetValue<int8_t>(config["SaveQuality"]);
   kThumbnailScale = JsonTools::GetValue<float>(config["ThumbnailScale"]);
+  JsonTools::GetValueOptional(config, "BurstLength", kBurstLength);
 
   _platform = robot->GetContextDataPlatform();
   DEV_ASSERT(_platform != nullptr, "PhotographyManager.InitDependent.DataPlatformIsNull");
@@ -285,16 +288,27 @@ PhotographyManager::PhotoHandle PhotographyManager::TakePhoto()
   const uint8_t medianFilterSize = (kTakePhoto_UseRawPhotos ? 0 : kMedianFilterSize);
   const float   sharpeningAmount = (kTakePhoto_UseRawPhotos ? 0.f : kSharpeningAmount);
   
-  _visionComponent->SetSaveImageParameters(ImageSaverParams(GetSavePath(),
-                                                            ImageSendMode::SingleShot,
-                                                            kSaveQuality,
-                                                            GetBasename(_nextPhotoID),
-                                                            Vision::ImageCacheSize::Full,
-                                                            kThumbnailScale,
-                                                            1.f, // saveScale
-                                                            kRemoveDistortion,
-                                                            medianFilterSize,
-                                                            sharpeningAmount));
+  ImageSaverParams params(GetSavePath(),
+                          ImageSendMode::SingleShot,
+                          kSaveQuality,
+                          GetBasename(_nextPhotoID),
+                          Vision::ImageCacheSize::Full,
+                          kThumbnailScale,
+                          1.f, // saveScale
+                          kRemoveDistortion,
+                          medianFilterSize,
+                          sharpeningAmount);
+  
+  // Full resolution frames keep coming while in photo mode, so look at a few and keep the sharpest rather than
+  // whichever one came first
+  params.burstLength = std::max(kBurstLength, uint8_t(1));
+  
+  // The photo is encoded and written off the vision thread, and only counts as taken once it's on disk
+  params.onSaveComplete = [this](const ImageSaverResult& result) {
+    OnPhotoSaved(result);
+  };
+  
+  _visionComponent->SetSaveImageParameters(params);
 
   _lastRequestedPhotoHandle = (TimeStamp_t)_visionComponent->GetLastProcessedImageTimeStamp();
   _state = State::WaitingForTakePhoto;
@@ -366,6 +380,33 @@ void PhotographyManager::SetLastPhotoTimeStamp(RobotTimeStamp_t timestamp)
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PhotographyManager::OnPhotoSaved(const ImageSaverResult& result)
+{
+  if(!IsWaitingForPhoto())
+  {
+    return;
+  }
+  
+  if(RESULT_OK == result.result)
+  {
+    SetLastPhotoTimeStamp(result.timestamp);
+    return;
+  }
+  
+  LOG_WARNING("PhotographyManager.OnPhotoSaved.SaveFailed",
+              "Photo %d with timestamp %u was %s (%s)",
+              _nextPhotoID, result.timestamp, (result.wasDropped ? "dropped" : "not written"),
+              result.fullFilename.c_str());
+  
+  // Ready to try again. The photo ID is only used up by a photo that was saved
+  _state = State::InPhotoMode;
+  _lastRequestedPhotoHandle = 0;
+  
+  static const bool kSucceeded = false;
+  SendDASEvent(kSucceeded, (result.wasDropped ? "SaveDropped" : "SaveFailed"));
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const char * PhotographyManager::GetPhotoExtension()
 {
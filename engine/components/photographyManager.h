@@ -30,6 +30,7 @@ namespace Vector {
 
 class VisionComponent;
 class IGatewayInterface;
+struct ImageSaverResult;
 template <typename T> class AnkiEvent;
 namespace external_interface {
   class DeletePhotoRequest;
@@ -87,7 +88,7 @@ public:
   // Returns true if the user has used up all their photo storage space
   bool IsPhotoStorageFull();
 
-  // Called by VisionComponent when photo has been taken and saved
+  // Called once the photo requested by TakePhoto has been saved
   void SetLastPhotoTimeStamp(RobotTimeStamp_t timestamp);
 
   static const char * GetPhotoExtension();
@@ -109,6 +110,9 @@ private:
 
   bool ImageHelper(const int id, const bool isThumbnail, std::string& fullpath);
 
+  // Save completion callback for TakePhoto, run on the main thread by VisionComponent
+  void OnPhotoSaved(const ImageSaverResult& result);
+
   std::string GetSavePath() const;
   std::string GetBasename(int photoID) const;
   const std::string& GetStateString() const;
@@ -16,6 +16,7 @@
 #include "engine/aiComponent/alexaComponent.h"
 #include "engine/components/mics/micComponent.h"
 #include "engine/components/visionComponent.h"
+#include "engine/components/visionScheduleMediator/visionScheduleMediator.h"
 #include "engine/cozmoContext.h"
 #include "engine/robotInterface/messageHandler.h"
 #include "engine/robotManager.h"
@@ -46,6 +47,9 @@ CONSOLE_VAR( bool, kPowerSave_ProxSensorMap, CONSOLE_GROUP, true);
 
 CONSOLE_VAR( bool, kForceCalmMode, CONSOLE_GROUP, false);
 
+// Cap the CPU and slow down vision as the robot heats up, to stay clear of the kernel's own throttling
+CONSOLE_VAR( bool, kPowerSave_ThermalGovernor, CONSOLE_GROUP, true);
+
 static constexpr const LCDBrightness kLCDBrightnessLow = LCDBrightness::LCDLevel_5mA;
 static constexpr const LCDBrightness kLCDBrightnessNormal = LCDBrightness::LCDLevel_10mA;
 
@@ -56,6 +60,9 @@ static constexpr const DesiredCPUFrequency kCPUFreqNormal = DesiredCPUFrequency:
 static constexpr const float kMicBufferLowMark = 0.1f;
 static constexpr const float kMicBufferHighMark = 0.6f;
 
+// Temperature only changes slowly (and OSState re-reads it every few seconds)
+static constexpr const float kThermalUpdatePeriod_s = 1.0f;
+
 // The minimum amount of time that we must be in active mode before we can
 // go to power save mode, in order to limit fast/expensive mode toggling.
 static constexpr const float kMinActiveModeDuration_s = 10.f;
@@ -170,6 +177,8 @@ void PowerStateManager::UpdateDependent(const RobotCompMap& dependentComps)
     }
   }
 
+  UpdateThermalGovernor(dependentComps);
+
   if( _inPowerSaveMode && kPowerSave_ThrottleCPU ) {
 
     auto& aiComp = dependentComps.GetComponent<AIComponent>();
@@ -180,7 +189,7 @@ void PowerStateManager::UpdateDependent(const RobotCompMap& dependentComps)
       PRINT_CH_DEBUG("PowerStates", "PowerStateManager.Update.CPU.Full.Alexa",
                      "Alexa active, going back to full CPU");
 
-      OSState::getInstance()->SetDesiredCPUFrequency(kCPUFreqNormal);
+      OSState::getInstance()->SetDesiredCPUFrequency(GetNormalCPUFrequency());
       _cpuThrottleLow = false;
     }
     else {
@@ -222,6 +231,9 @@ void PowerStateManager::UpdateDependent(const RobotCompMap& dependentComps)
           }
           ss << "]";
           toSend["powerSaveRequesters"] = ss.str();
+          toSend["thermalLevel"] = ThermalLevelToString(_thermalGovernor.GetLevel());
+          toSend["thermalHighDemand"] = _thermalGovernor.HasHighDemand() ? "true" : "false";
+          toSend["cpuThrottling"] = _thermalGovernor.WasThrottling() ? "true" : "false";
           webService->SendToWebViz(kWebVizPowerModule, toSend);
         }
       }
@@ -230,6 +242,51 @@ void PowerStateManager::UpdateDependent(const RobotCompMap& dependentComps)
   }
 }
 
+void PowerStateManager::UpdateThermalGovernor(const RobotCompMap& components)
+{
+  const float currTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+  if( currTime_s < _nextThermalUpdateTime_s ) {
+    return;
+  }
+  _nextThermalUpdateTime_s = currTime_s + kThermalUpdatePeriod_s;
+
+  auto* osState = OSState::getInstance();
+  auto& visionScheduleMediator = components.GetComponent<VisionScheduleMediator>();
+
+  ThermalGovernor::Inputs inputs;
+  inputs.temperature_C = osState->GetTemperature_C();
+  inputs.isCPUThrottling = osState->IsCPUThrottling();
+  inputs.micBufferFullness = components.GetComponent<MicComponent>().GetBufferFullness();
+  inputs.visionDropFraction = visionScheduleMediator.GetLastDropFraction();
+  _thermalGovernor.Update(currTime_s, inputs);
+
+  if( kPowerSave_ThermalGovernor ) {
+    visionScheduleMediator.SetThermalStretch(_thermalGovernor.GetVisionStretch(),
+                                             _thermalGovernor.GetNeuralNetStretch());
+  }
+  else {
+    visionScheduleMediator.SetThermalStretch(1, 1);
+  }
+
+  // While throttling for power save the CPU is already lower than any thermal cap. It comes back to
+  // GetNormalCPUFrequency() when power save ends
+  const bool cpuHeldForPowerSave = (_enabledSettings.find(PowerSaveSetting::ThrottleCPU) != _enabledSettings.end());
+  const DesiredCPUFrequency freq = GetNormalCPUFrequency();
+  if( !cpuHeldForPowerSave && (freq != osState->GetDesiredCPUFrequency()) ) {
+    PRINT_CH_INFO("PowerStates", "PowerStateManager.UpdateThermalGovernor.CPUFreq",
+                  "Thermal level %s at %uC, setting cpu frequency %u",
+                  ThermalLevelToString(_thermalGovernor.GetLevel()),
+                  inputs.temperature_C,
+                  Util::EnumToUnderlying(freq));
+    osState->SetDesiredCPUFrequency(freq);
+  }
+}
+
+DesiredCPUFrequency PowerStateManager::GetNormalCPUFrequency() const
+{
+  return kPowerSave_ThermalGovernor ? _thermalGovernor.GetDesiredCPUFrequency() : kCPUFreqNormal;
+}
+
 void PowerStateManager::RequestPowerSaveMode(const std::string& requester)
 {
   PRINT_CH_DEBUG("PowerStates", "PowerStateManager.Update.AddRequest",
@@ -335,7 +392,7 @@ void PowerStateManager::TogglePowerSaveSetting( const RobotCompMap& components,
       // most of the time in the lower frequency state, but we may need to jump up to the higher state,
       // e.g. to drain the mic data buffer if it gets backed up. Start out in the higher state, and the code
       // in UpdateDependent will toggle back and forth as needed
-      const auto freq = savePower ? kCPUFreqSaveHigh : kCPUFreqNormal;
+      const auto freq = savePower ? kCPUFreqSaveHigh : GetNormalCPUFrequency();
       OSState::getInstance()->SetDesiredCPUFrequency(freq);
       _cpuThrottleLow = false;
 
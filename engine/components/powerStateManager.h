@@ -14,6 +14,7 @@
 #define __Engine_Components_PowerStateManager_H__
 
 #include "engine/aiComponent/behaviorComponent/behaviorComponents_fwd.h"
+#include "engine/components/thermalGovernor.h"
 #include "engine/robotComponents_fwd.h"
 #include "util/entityComponent/iDependencyManagedComponent.h"
 #include "util/helpers/noncopyable.h"
@@ -58,6 +59,7 @@ public:
     comps.insert(RobotComponentID::Vision);
     comps.insert(RobotComponentID::MicComponent);
     comps.insert(RobotComponentID::ProxSensor);
+    comps.insert(RobotComponentID::VisionScheduleMediator);
   }
 
   virtual void UpdateDependent(const RobotCompMap& dependentComps) override;
@@ -80,6 +82,9 @@ public:
 
   void RequestLCDBrightnessChange(const LCDBrightness& level) const;
 
+  // How hot the robot is running, as judged by the thermal governor (see thermalGovernor.h)
+  ThermalLevel GetThermalLevel() const { return _thermalGovernor.GetLevel(); }
+
   // NOTE: In an ideal system, we'd work the opposite way, where specific behaviors or pieces of code could
   // request a higher power mode, and the _default_ would be power save. This would potentially allow better
   // power saving, but also be harder to debug and have systems understand what to do and not do in power save
@@ -107,6 +112,12 @@ private:
 
   void TogglePowerSaveSetting( const RobotCompMap& components, PowerSaveSetting setting, bool enabled );
 
+  // Samples temperature and demand, then applies the thermal governor's CPU cap and vision stretch
+  void UpdateThermalGovernor( const RobotCompMap& components );
+
+  // The frequency to run at when not throttling for power save: automatic, unless capped by the thermal governor
+  DesiredCPUFrequency GetNormalCPUFrequency() const;
+
   const CozmoContext* _context = nullptr;
 
   std::set<PowerSaveSetting> _enabledSettings;
@@ -121,6 +132,9 @@ private:
   CameraState _cameraState = CameraState::Running;
 
   bool _cpuThrottleLow = true;
+
+  ThermalGovernor _thermalGovernor;
+  float _nextThermalUpdateTime_s = 0.0f;
   
   float _nextSendWebVizDataTime_sec = 0.0f;
 };
@@ -6,7 +6,8 @@
  *
  * Description: Tracks state information about the robot/current behavior/game
  * that engine wants to expose to other parts of the system (music, UI, etc).
- * Full state information is broadcast every time any piece of tracked state changes.
+ * Changes are tracked per field and coalesced: full state information is broadcast
+ * at most once per tick, with a new version number and the fields that changed.
  *
  * Copyright: Anki, Inc. 2017
  *
@@ -51,13 +52,11 @@ PublicStateBroadcaster::PublicStateBroadcaster()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PublicStateBroadcaster::UpdateDependent(const RobotCompMap& dependentComps)
 {
-  bool currentStateUpdated = false;
-  
   const bool isCarryingObject = _robot->GetCarryingComponent().IsCarryingObject();
   // Check if a cube has been added to/removed from the lift
   if(isCarryingObject != _currentState->isCubeInLift){
     _currentState->isCubeInLift = isCarryingObject;
-    currentStateUpdated = true;
+    MarkChanged(Field::CubeInLift);
     PRINT_CH_INFO(kChannelName,
                   "PublicStateBroadcaster.Update.RobotCarryingObjectChanged",
                   "Robot %s carrying an object",
@@ -65,8 +64,8 @@ void PublicStateBroadcaster::UpdateDependent(const RobotCompMap& dependentComps)
                   );
   }
 
-  // After all update checks, if any changed a state property, send the updated state
-  if(currentStateUpdated){
+  // After all update checks, if any changed a state property (here or since the last tick), send the updated state
+  if(_changedFields.AreAnyFlagsSet()){
     SendUpdatedState();
   }
 }
@@ -124,15 +123,17 @@ void PublicStateBroadcaster::UpdateBroadcastBehaviorStage(BehaviorStageTag stage
   
   newStruct.behaviorStageTag = stageType;
   _currentState->userFacingBehaviorStageStruct = newStruct;
-  SendUpdatedState();
+  MarkChanged(Field::BehaviorStage);
 }
 
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PublicStateBroadcaster::UpdateRequestingGame(bool isRequesting)
 {
-  _currentState->isRequestingGame = isRequesting;
-  SendUpdatedState();
+  if(isRequesting != _currentState->isRequestingGame){
+    _currentState->isRequestingGame = isRequesting;
+    MarkChanged(Field::RequestingGame);
+  }
 }
 
 
@@ -179,6 +180,10 @@ Signal::SmartHandle PublicStateBroadcaster::Subscribe(SubscribeFunc messageHandl
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void PublicStateBroadcaster::SendUpdatedState()
 {
+  ++_stateVersion;
+  _lastChangedFields = _changedFields;
+  _changedFields.ClearFlags();
+  
   _eventMgr.Broadcast(AnkiEvent<RobotPublicState>(static_cast<uint32_t>(0), *_currentState));
 }
 
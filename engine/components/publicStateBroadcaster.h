@@ -6,7 +6,8 @@
  *
  * Description: Tracks state information about the robot/current behavior/game
  * that engine wants to expose to other parts of the system (music, UI, etc).
- * Full state information is broadcast every time any piece of tracked state changes.
+ * Changes are tracked per field and coalesced: full state information is broadcast
+ * at most once per tick, with a new version number and the fields that changed.
  *
  * Copyright: Anki, Inc. 2017
  *
@@ -21,6 +22,7 @@
 
 #include "clad/types/robotPublicState.h"
 
+#include "util/bitFlags/bitFlags.h"
 #include "util/helpers/noncopyable.h"
 
 #include <memory>
@@ -33,6 +35,16 @@ class Robot;
 class PublicStateBroadcaster : public IDependencyManagedComponent<RobotComponentID>, private Util::noncopyable
 {
 public:
+  // The parts of RobotPublicState that are tracked separately for changes
+  enum class Field : uint8_t {
+    CubeInLift,
+    RequestingGame,
+    TallestStackHeight,
+    NeedsLevels,
+    BehaviorStage,
+  };
+  using FieldFlags = Util::BitFlags8<Field>;
+  
   PublicStateBroadcaster();
   ~PublicStateBroadcaster() {};
 
@@ -76,6 +88,7 @@ public:
     dependencies.insert(RobotComponentID::MicComponent);
   };
   
+  // Broadcasts the state if anything changed since the last broadcast
   virtual void UpdateDependent(const RobotCompMap& dependentComps) override;
 
   //////
@@ -87,6 +100,15 @@ public:
   
   static int GetBehaviorRoundFromMessage(const RobotPublicState& stateEvent);
   
+  const RobotPublicState& GetCurrentState() const { return *_currentState; }
+  
+  // Incremented with each broadcast, so subscribers can tell whether they missed one
+  uint32_t GetStateVersion() const { return _stateVersion; }
+  
+  // Which fields changed in the latest broadcast. Subscribers can check this while they are being called
+  // to skip the parts of the state they already have.
+  const FieldFlags& GetChangedFields() const { return _lastChangedFields; }
+  
   
   void Update(Robot& robot);
   void UpdateBroadcastBehaviorStage(BehaviorStageTag stageType, uint8_t stage);
@@ -98,6 +120,13 @@ private:
   std::unique_ptr<RobotPublicState> _currentState;
   AnkiEventMgr<RobotPublicState> _eventMgr;
   
+  uint32_t   _stateVersion = 0;
+  FieldFlags _changedFields;     // since the last broadcast
+  FieldFlags _lastChangedFields; // in the last broadcast
+  
+  void MarkChanged(Field field) { _changedFields.SetBitFlag(field, true); }
+  
+  // Every subscriber gets the same event
   void SendUpdatedState();
   static int GetStageForBehaviorStageType(BehaviorStageTag stageType,
                                           const BehaviorStageStruct& stageStruct);
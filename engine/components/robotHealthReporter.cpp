@@ -1,7 +1,7 @@
 /**
  * File: engine/components/robotHealthReporter.cpp
  *
- * Description: Report robot & OS health events to DAS
+ * Description: Report robot & OS health events to DAS, and accounted memory to webViz
  *
  * Copyright: Anki, Inc. 2018
  *
@@ -10,11 +10,17 @@
 
 
 #include "robotHealthReporter.h"
+#include "engine/cozmoContext.h"
+#include "engine/robot.h"
 #include "osState/osState.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/helpers/ankiDefines.h"
 #include "util/logging/logging.h"
 #include "util/logging/DAS.h"
+#include "util/memoryAccounting/memoryAccounting.h"
+#include "webServerProcess/src/webService.h"
+
+#include "json/json.h"
 
 #include <list>
 
@@ -31,6 +37,8 @@ namespace {
   #else
   const std::list<std::string> kDiskInfoPaths = {"/tmp"};
   #endif
+
+  const std::string kWebVizMemoryModule = "memory";
 }
 
 namespace Anki {
@@ -153,6 +161,9 @@ void RobotHealthReporter::MemoryInfoCheck(const OSState * osState)
     DASMSG_SET(i4, info.pressure, "Memory pressure factor");
     DASMSG_SEND();
    _memoryAlert = info.alert;
+
+    // Log where memory is going whenever pressure changes, so logs from low memory units show what grew
+    Util::MemoryAccounting::LogStats();
   }
 }
 
@@ -171,6 +182,24 @@ void RobotHealthReporter::CPUInfoCheck(const OSState * osState)
   }
 }
 
+void RobotHealthReporter::MemoryAccountingCheck()
+{
+  // Only sends to DAS when a subsystem or the total reaches a new high
+  Util::MemoryAccounting::ReportNewHighWaterMarks();
+}
+
+void RobotHealthReporter::SendMemoryAccountingToWebViz()
+{
+  if (ANKI_DEV_CHEATS) {
+    auto* webService = (_context != nullptr) ? _context->GetWebService() : nullptr;
+    if ((webService != nullptr) && webService->IsWebVizClientSubscribed(kWebVizMemoryModule)) {
+      Json::Value toSend;
+      Util::MemoryAccounting::GetStatsAsJson(toSend);
+      webService->SendToWebViz(kWebVizMemoryModule, toSend);
+    }
+  }
+}
+
 void RobotHealthReporter::OncePerBootCheck()
 {
   LOG_DEBUG("RobotHealthReport.OncePerBootCheck", "Run once-per-boot check");
@@ -199,6 +228,7 @@ void RobotHealthReporter::OncePerMinuteCheck()
   const OSState * osState = OSState::getInstance();
   WifiInfoCheck(osState);
   DiskInfoCheck(osState);
+  MemoryAccountingCheck();
 }
 
 void RobotHealthReporter::OncePerSecondCheck()
@@ -207,6 +237,7 @@ void RobotHealthReporter::OncePerSecondCheck()
   const auto * osState = OSState::getInstance();
   MemoryInfoCheck(osState);
   CPUInfoCheck(osState);
+  SendMemoryAccountingToWebViz();
 }
 
 //
@@ -215,7 +246,7 @@ void RobotHealthReporter::OncePerSecondCheck()
 //
 void RobotHealthReporter::InitDependent(Robot * robot, const DependencyManager & dependencyManager)
 {
-  // Nothing to do here?
+  _context = robot->GetContext();
 }
 
 //
@@ -1,7 +1,7 @@
 /**
  * File: engine/components/robotHealthReporter.h
  *
- * Description: Report robot & OS health events to DAS
+ * Description: Report robot & OS health events to DAS, and accounted memory to webViz
  *
  * Copyright: Anki, Inc. 2018
  *
@@ -22,6 +22,8 @@
 namespace Anki {
 namespace Vector {
 
+class CozmoContext;
+
 class RobotHealthReporter : public IDependencyManagedComponent<RobotComponentID>
 {
   public:
@@ -39,6 +41,8 @@ class RobotHealthReporter : public IDependencyManagedComponent<RobotComponentID>
 
   private:
 
+    const CozmoContext* _context = nullptr;
+
     // Reporting state
     bool _once_per_boot = true;
     bool _once_per_startup = true;
@@ -59,6 +63,8 @@ class RobotHealthReporter : public IDependencyManagedComponent<RobotComponentID>
     void DiskInfoCheck(const OSState * osState);
     void MemoryInfoCheck(const OSState * osState);
     void CPUInfoCheck(const OSState * osState);
+    void MemoryAccountingCheck();
+    void SendMemoryAccountingToWebViz();
 
     // Interval tasks
     void OncePerBootCheck();
@@ -121,12 +121,13 @@ void CliffSensorComponent::HandleMessage(const ExternalInterface::RobotOffTreads
 
 void CliffSensorComponent::NotifyOfRobotStateInternal(const RobotState& msg)
 {
-  // Update raw and filtered cliff sensor data
+  // Update raw and filtered cliff sensor data. Both sides of the select are computed for every sensor so that
+  // the loop has no branches and is done for all sensors at once as a single vector operation.
+  _cliffDataRaw = msg.cliffDataRaw;
   for (int i=0 ; i<kNumCliffSensors ; i++) {
-    _cliffDataRaw[i] = msg.cliffDataRaw[i];
-    _cliffDataFilt[i] = Util::IsNearZero(_cliffDataFilt[i]) ?
-                        _cliffDataRaw[i] :
-                        (kCliffFiltCoef * _cliffDataFilt[i]) + ((1.f - kCliffFiltCoef) * static_cast<float>(_cliffDataRaw[i]));
+    const float raw = static_cast<float>(_cliffDataRaw[i]);
+    const float filt = (kCliffFiltCoef * _cliffDataFilt[i]) + ((1.f - kCliffFiltCoef) * raw);
+    _cliffDataFilt[i] = Util::IsNearZero(_cliffDataFilt[i]) ? raw : filt;
   }
   
   _cliffDetectedFlags = msg.cliffDetectedFlags;
@@ -438,7 +439,7 @@ void CliffSensorComponent::UpdateNavMapWithCliffAt(const Pose3d& pose, const uin
 
   MemoryMapData_Cliff cliffFromSensor(pose, timestamp);
   cliffFromSensor.isFromCliffSensor = true;
-  _robot->GetMapComponent().InsertData(Poly2f(cliffquad), cliffFromSensor);
+  _robot->GetMapComponent().AddCliff(Poly2f(cliffquad), cliffFromSensor);
 }
 
 void CliffSensorComponent::EnableStopOnWhite(bool stopOnWhite)
@@ -19,6 +19,8 @@
 #include "util/console/consoleInterface.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+
 #define LOG_CHANNEL "ImuComponent"
 
 namespace Anki {
@@ -57,6 +59,13 @@ void ImuHistory::AddData(IMUDataFrame&& frame)
   _history.emplace_back(frame);
 }
   
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ImuHistory::const_iterator ImuHistory::FindFirstAtOrAfter(RobotTimeStamp_t t) const
+{
+  return std::lower_bound(_history.begin(), _history.end(), t,
+                          [](const IMUDataFrame& frame, RobotTimeStamp_t t) { return frame.timestamp < t; });
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool ImuHistory::GetImuDataBeforeAndAfter(RobotTimeStamp_t t,
                                           IMUDataFrame& before,
@@ -67,18 +76,100 @@ bool ImuHistory::GetImuDataBeforeAndAfter(RobotTimeStamp_t t,
     return false;
   }
 
-  // Start at beginning + 1 because there is no data before the first element
-  for(auto iter = _history.begin() + 1; iter != _history.end(); ++iter)
+  // There is no data before the first element, so start at the one after it
+  auto iter = FindFirstAtOrAfter(t);
+  if(iter == _history.begin())
   {
-    // If we get to the imu data after or equal to the timestamp
-    if(iter->timestamp >= t)
+    ++iter;
+  }
+  if(iter == _history.end())
+  {
+    return false;
+  }
+  
+  after = *iter;
+  before = *(iter - 1);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ImuHistory::GetGyroAt(RobotTimeStamp_t t, Vec3f& gyro, const TimeStamp_t maxExtrapolation_ms) const
+{
+  if(_history.empty())
+  {
+    return false;
+  }
+  
+  const auto afterT = FindFirstAtOrAfter(t);
+  if(afterT == _history.end())
+  {
+    // Nothing after t yet. Use the latest data, if it is recent enough to assume the rates haven't changed much
+    const auto& newest = _history.back();
+    if(t - newest.timestamp > maxExtrapolation_ms)
     {
-      after = *iter;
-      before = *(iter - 1);
-      return true;
+      return false;
     }
+    gyro = Vec3f(newest.gyroRobotFrame.x, newest.gyroRobotFrame.y, newest.gyroRobotFrame.z);
+    return true;
   }
-  return false;
+  
+  if(afterT->timestamp == t)
+  {
+    gyro = Vec3f(afterT->gyroRobotFrame.x, afterT->gyroRobotFrame.y, afterT->gyroRobotFrame.z);
+    return true;
+  }
+  
+  // No data before time t
+  if(afterT == _history.begin())
+  {
+    return false;
+  }
+  
+  const auto beforeT = std::prev(afterT);
+  const f32 alpha = ((f32)(TimeStamp_t)(t - beforeT->timestamp) /
+                     (f32)(TimeStamp_t)(afterT->timestamp - beforeT->timestamp));
+  gyro.x() = beforeT->gyroRobotFrame.x + alpha * (afterT->gyroRobotFrame.x - beforeT->gyroRobotFrame.x);
+  gyro.y() = beforeT->gyroRobotFrame.y + alpha * (afterT->gyroRobotFrame.y - beforeT->gyroRobotFrame.y);
+  gyro.z() = beforeT->gyroRobotFrame.z + alpha * (afterT->gyroRobotFrame.z - beforeT->gyroRobotFrame.z);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool ImuHistory::GetGyroStats(RobotTimeStamp_t fromTime, RobotTimeStamp_t toTime, GyroStats& stats) const
+{
+  stats = GyroStats();
+  if(toTime <= fromTime)
+  {
+    return false;
+  }
+  
+  Vec3f sum(0.f, 0.f, 0.f);
+  for(auto iter = FindFirstAtOrAfter(fromTime + 1); (iter != _history.end()) && (iter->timestamp <= toTime); ++iter)
+  {
+    const Vec3f gyro(iter->gyroRobotFrame.x, iter->gyroRobotFrame.y, iter->gyroRobotFrame.z);
+    if(stats.numFrames == 0)
+    {
+      stats.min = gyro;
+      stats.max = gyro;
+    }
+    else
+    {
+      for(int i=0 ; i<3 ; i++)
+      {
+        stats.min[i] = std::min(stats.min[i], gyro[i]);
+        stats.max[i] = std::max(stats.max[i], gyro[i]);
+      }
+    }
+    sum += gyro;
+    ++stats.numFrames;
+  }
+  
+  if(stats.numFrames == 0)
+  {
+    return false;
+  }
+  stats.mean = sum * (1.f / stats.numFrames);
+  return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -108,23 +199,26 @@ bool ImuHistory::IsImuDataBeforeTimeGreaterThan(const RobotTimeStamp_t t,
     return false;
   }
   
-  for(iter = _history.begin() + 1; iter != _history.end(); ++iter)
+  // Find the imu data after or equal to the timestamp, not counting the first element
+  iter = FindFirstAtOrAfter(t);
+  if(iter == _history.begin())
   {
-    // If we get to the imu data after or equal to the timestamp
-    if(iter->timestamp >= t)
-    {          
-      // Once we get to the imu data after the timestamp look at the numToLookBack imu data before it
-      for(int i = 0; i < numToLookBack; i++)
-      {
-        if(ABS(iter->gyroRobotFrame.x) > rateX && ABS(iter->gyroRobotFrame.y) > rateY && ABS(iter->gyroRobotFrame.z) > rateZ)
-        {
-          return true;
-        }
-        if(iter-- == _history.begin())
-        {
-          return false;
-        }
-      }
+    ++iter;
+  }
+  if(iter == _history.end())
+  {
+    return false;
+  }
+  
+  // Look at the numToLookBack imu data before it
+  for(int i = 0; i < numToLookBack; i++)
+  {
+    if(ABS(iter->gyroRobotFrame.x) > rateX && ABS(iter->gyroRobotFrame.y) > rateY && ABS(iter->gyroRobotFrame.z) > rateZ)
+    {
+      return true;
+    }
+    if(iter-- == _history.begin())
+    {
       return false;
     }
   }
@@ -17,6 +17,7 @@
 
 #include "clad/robotInterface/messageRobotToEngine.h"
 #include "coretech/common/engine/robotTimeStamp.h"
+#include "coretech/common/shared/math/point.h"
 
 #include "util/entityComponent/entity.h"
 #include "util/math/math.h"
@@ -32,6 +33,7 @@ namespace Vector {
 //  Because ImuComponent inherits a bunch of stuff as a component, including being non-copyable.
 //  This gives us a thin wrapper around the actual historical info, which can be copied to, and
 //  queried by, the vision thread, as part of its VisionPoseData input.
+//  Frames are kept in time order, so lookups by timestamp are binary searches.
 //
 class ImuHistory
 {
@@ -42,6 +44,22 @@ public:
   // process a gyro frame and add it to history
   void AddData(IMUDataFrame&& frame);
   
+  // Gyro rates (robot frame) at time t, linearly interpolated between the frames on either side of it. If t is
+  // newer than all of history, the newest frame is used as long as it is no more than maxExtrapolation_ms older
+  // than t. Returns false if history has nothing usable for t
+  bool GetGyroAt(RobotTimeStamp_t t, Vec3f& gyro, const TimeStamp_t maxExtrapolation_ms = 0) const;
+  
+  // Min, max and mean gyro rates (robot frame) of the frames with timestamps in (fromTime, toTime]
+  struct GyroStats {
+    u32   numFrames = 0;
+    Vec3f min;
+    Vec3f max;
+    Vec3f mean;
+  };
+  
+  // Returns false if no frames fall in the window
+  bool GetGyroStats(RobotTimeStamp_t fromTime, RobotTimeStamp_t toTime, GyroStats& stats) const;
+  
   // Checks if IMU data at or near timestamp t indicates the head was rotating
   // faster than the given limit
   bool WasHeadRotatingTooFast(RobotTimeStamp_t t,
@@ -73,6 +91,9 @@ private:
   
   std::deque<IMUDataFrame> _history;
   
+  // First frame at or after timestamp t, or end() if there is none
+  const_iterator FindFirstAtOrAfter(RobotTimeStamp_t t) const;
+  
   // Gets the imu data before and after the timestamp
   bool GetImuDataBeforeAndAfter(RobotTimeStamp_t t,
                                 IMUDataFrame& before,
@@ -227,11 +227,13 @@ bool ProxSensorComponent::CheckLiftOcclusion()
       _numTicsLiftOutOfFOV = 0;
     }
 
-  } else {
-    // Lift might not be calibrated if bracing while falling
+  } else if (_wasLiftCalibrated) {
+    // Lift might not be calibrated if bracing while falling. This is checked on every RobotState, so
+    // only report it when the lift first becomes uncalibrated.
     LOG_INFO("ProxSensorComponent.ProcessRawSensorData.LiftNotCalibrated",
              "Lift is not calibrated! Considering it not in FOV.");
   }
+  _wasLiftCalibrated = _robot->IsLiftCalibrated();
   return isInFOV;
 }
 
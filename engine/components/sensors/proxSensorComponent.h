@@ -88,6 +88,7 @@ private:
   Pose3d            _currentRobotPose;        // robot pose at current sensor reading
   uint32_t          _measurementsAtPose = 0;  // counter to limit number of map updates while not moving
   uint32_t          _numTicsLiftOutOfFOV = 0; // counter for lift FOV checks to account for sensor delay
+  bool              _wasLiftCalibrated = true; // lift calibration at the last FOV check, to log when it is lost
   bool              _mapEnabled = true;       // disable map updates entirely (currently for low-power mode)
   
 };
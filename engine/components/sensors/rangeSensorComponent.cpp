@@ -22,12 +22,77 @@
 
 #include "anki/cozmo/shared/cozmoConfig.h"
 
+#include "coretech/common/engine/math/fastPolygon2d.h"
+
 #include "clad/robotInterface/messageEngineToRobot.h"
 
+#include "util/console/consoleInterface.h"
+
 #include "whiskeyToF/tof.h"
 
+#include <chrono>
+
+#define LOG_CHANNEL "RangeSensor"
+
 namespace Anki {
 namespace Vector {
+
+// Whether or not readings update the nav map
+CONSOLE_VAR(bool, kRangeSensorUpdateNavMap, "RangeSensorComponent", true);
+
+// Readings at or beyond this distance didn't hit anything
+CONSOLE_VAR(f32, kRangeSensorMaxRange_mm, "RangeSensorComponent", 1000.f);
+
+// Points hit between these heights above the ground are obstacles. Points below are the ground
+// so the path to them is clear. Nothing is known about the ground under points above
+CONSOLE_VAR(f32, kRangeSensorMinObstacleHeight_mm, "RangeSensorComponent", 10.f);
+CONSOLE_VAR(f32, kRangeSensorMaxObstacleHeight_mm, "RangeSensorComponent", 100.f);
+
+// Depth of an obstacle behind the point that was hit
+CONSOLE_VAR(f32, kRangeSensorObstacleDepth_mm, "RangeSensorComponent", 10.f);
+
+// Frames older than this by the time they are processed are not put in the map, since the robot's pose
+// and head angle are only known for now
+CONSOLE_VAR(u32, kRangeSensorMaxFrameAge_ms, "RangeSensorComponent", 100);
+
+// Whether or not to only range the ROIs that point where the map needs refreshing
+CONSOLE_VAR(bool, kRangeSensorScheduleRois, "RangeSensorComponent", true);
+
+// How often to pick the ROIs to range. Changing them means stopping and starting ranging, so not too often
+CONSOLE_VAR(u32, kRangeSensorRoiSchedulePeriod_ms, "RangeSensorComponent", 1000);
+
+// ROIs that haven't been read for this long are always ranged
+CONSOLE_VAR(u32, kRangeSensorMaxRoiAge_ms, "RangeSensorComponent", 2000);
+
+// Map content last observed longer ago than this needs refreshing
+CONSOLE_VAR(u32, kRangeSensorMapRefreshAge_ms, "RangeSensorComponent", 500);
+
+// Always range at least this many ROIs, picking the ones read longest ago if needed
+CONSOLE_VAR(u32, kRangeSensorMinActiveRois, "RangeSensorComponent", 4);
+
+namespace {
+  // Angle of the center of each row or column of ROIs from the center of the sensor's field of view
+  const f32 kInnerRoiAngle_rad = TOF_FOV_RAD / 8.f;
+  const f32 kOuterRoiAngle_rad = kInnerRoiAngle_rad * 3.f;
+  const f32 kRoiAngle_rad[TOF_RESOLUTION] = {kOuterRoiAngle_rad,
+                                             kInnerRoiAngle_rad,
+                                             -kInnerRoiAngle_rad,
+                                             -kOuterRoiAngle_rad};
+  const f32 kRoiAngleSin[TOF_RESOLUTION] = {sinf(kRoiAngle_rad[0]),
+                                            sinf(kRoiAngle_rad[1]),
+                                            sinf(kRoiAngle_rad[2]),
+                                            sinf(kRoiAngle_rad[3])};
+
+  // Width of each ROI's beam per mm of range
+  const f32 kRoiWidthPerRange = tanf(TOF_FOV_RAD / TOF_RESOLUTION);
+
+  // Same clock as ToFSensor::RangeFrame::timestamp_ms
+  uint64_t GetSteadyTime_ms()
+  {
+    const auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+  }
+}
   
 RangeSensorComponent::RangeSensorComponent() 
 : IDependencyManagedComponent<RobotComponentID>(this, RobotComponentID::RangeSensor)
@@ -111,7 +176,22 @@ void RangeSensorComponent::UpdateDependent(const RobotCompMap& dependentComps)
 
     _robot->SendRobotMessage<RangeDataToDisplay>(msg);
   }
-  
+
+  // Only the ROIs read since the last update need converting
+  tof->GetNewFrames(_newFrames);
+  if(!_newFrames.empty())
+  {
+    ProcessNewFrames(*tof);
+  }
+
+  if(kRangeSensorScheduleRois && tof->IsRanging())
+  {
+    UpdateActiveRois(*tof);
+  }
+}
+
+void RangeSensorComponent::ProcessNewFrames(const ToFSensor& tof)
+{
   Pose3d co = _robot->GetCameraPose(_robot->GetComponent<FullRobotPose>().GetHeadAngle());
   // Parent a pose to the camera so we can rotate our current camera axis (Z out of camera) to match world axis (Z up)
   // also account for angle tof sensor is relative to camera
@@ -121,15 +201,13 @@ void RangeSensorComponent::UpdateDependent(const RobotCompMap& dependentComps)
 
 #if TOF_CONFIGURATION ==TOF_SIDE_BY_SIDE
   const auto leftAngle = TOF_LEFT_ROT_Z_REL_CAMERA_RAD;
-  const auto rightAngle = TOF_RIGHT_ROT_Z_REL_CAMERA_RAD;
   const auto axis = Z_AXIS_3D();  
 #elif TOF_CONFIGURATION == TOF_ABOVE_BELOW || TOF_CONFIGURATION == TOF_CENTER_OF_FACE
   const auto leftAngle = TOF_LEFT_ROT_Y_REL_CAMERA_RAD;
-  const auto rightAngle = TOF_RIGHT_ROT_Y_REL_CAMERA_RAD;
   const auto axis = Y_AXIS_3D();
 #endif
 
-  // Construct left and right sensor poses parented to the rotated camera pose
+  // Construct the sensor pose parented to the rotated camera pose. Only the left sensor is driven
   Pose3d lp(leftAngle,
             axis,
             {TOF_LEFT_TRANS_REL_CAMERA_MM[0],
@@ -137,50 +215,143 @@ void RangeSensorComponent::UpdateDependent(const RobotCompMap& dependentComps)
              TOF_LEFT_TRANS_REL_CAMERA_MM[2]},
             c,
             "leftProx");
-  Pose3d rp(rightAngle,
-            axis,
-            {TOF_RIGHT_TRANS_REL_CAMERA_MM[0],
-             TOF_RIGHT_TRANS_REL_CAMERA_MM[1],
-             TOF_RIGHT_TRANS_REL_CAMERA_MM[2]},
-            c,
-            "rightProx");
 
-  #ifndef SIMULATOR
-  //rp.RotateBy(Rotation3d(DEG_TO_RAD(180), X_AXIS_3D()));
-  //lp.RotateBy(Rotation3d(DEG_TO_RAD(180), X_AXIS_3D()));
-  #endif
-  
-  // 
-  // const f32 kInnerAngle_rad = TOF_FOV_RAD / 8.f;
-  // const f32 kOuterAngle_rad = kInnerAngle_rad * 3.f;
-  // const f32 kPixToAngle[] = {kOuterAngle_rad,
-  //                            kInnerAngle_rad,
-  //                            -kInnerAngle_rad,
-  //                            -kOuterAngle_rad};
-
-  // std::vector<RangeData> navMapData;
-  
-  // for(int r = 0; r < TOF_RESOLUTION; r++)
-  // {
-  //   const f32 pitch = sin(kPixToAngle[r]);
-
-  //   for(int c = 0; c < TOF_RESOLUTION; c++)
-  //   {
-  //     const f32 yaw = sin(kPixToAngle[c]);
-
-  //     const f32 leftDist_mm = _latestRawRangeData.data[c + (r*8)].processedRange_mm; 
-
-  //     const f32 yl = yaw * leftDist_mm;
-  //     const f32 zl = pitch * leftDist_mm;
-
-  //     Pose3d pl(0, Z_AXIS_3D(), {leftDist_mm, yl, zl}, lp, "point");
-  //     Pose3d rootl = pl.GetWithRespectToRoot();
-  //     _robot->GetContext()->GetVizManager()->DrawCuboid(r*8 + c + 1,
-  //                                                       {3, 3, 3},
-  //                                                       rootl);
-  //     _latestRangeData[r*8 + c] = pl.GetTranslation();      
-  //   }
-  // }
+  // Walk up the pose tree once, rather than once per point
+  const Pose3d sensorWrtRoot = lp.GetWithRespectToRoot();
+  const Point2f sensorPos(sensorWrtRoot.GetTranslation().x(), sensorWrtRoot.GetTranslation().y());
+
+  const uint64_t now_ms = GetSteadyTime_ms();
+  const TimeStamp_t robotTime_ms = (TimeStamp_t) _robot->GetLastMsgTimestamp();
+
+  // Regions are referred to by the insert list, so they must not move once added
+  std::vector<FastPolygon> regions;
+  regions.reserve(2 * _newFrames.size());
+  MemoryMapTypes::MemoryMapInsertList mapUpdates;
+  mapUpdates.reserve(2 * _newFrames.size());
+
+  for(const auto& frame : _newFrames)
+  {
+    const RangingData& roiData = frame.data;
+    if(roiData.roi >= ToFSensor::kNumRois)
+    {
+      continue;
+    }
+
+    const int row = roiData.roi / TOF_RESOLUTION;
+    const int col = roiData.roi % TOF_RESOLUTION;
+
+    const bool isValid = (tof.IsValidRoiStatus(roiData.roiStatus) &&
+                          (roiData.numObjects > 0) &&
+                          (roiData.processedRange_mm > 0) &&
+                          (roiData.processedRange_mm < kRangeSensorMaxRange_mm));
+    const f32 dist_mm = (isValid ? roiData.processedRange_mm : kRangeSensorMaxRange_mm);
+
+    const Point3f pointWrtSensor(dist_mm, kRoiAngleSin[col] * dist_mm, kRoiAngleSin[row] * dist_mm);
+    _latestRangeData[roiData.roi] = pointWrtSensor;
+
+    const Point3f pointWrtRoot = sensorWrtRoot * pointWrtSensor;
+    const Point2f target(pointWrtRoot.x(), pointWrtRoot.y());
+
+    RoiHistory& history = _roiHistory[roiData.roi];
+    history.target = target;
+    history.hasTarget = true;
+    history.lastRead_ms = frame.timestamp_ms;
+
+    const uint64_t age_ms = now_ms - frame.timestamp_ms;
+    const bool isBelowObstacles = (pointWrtRoot.z() < kRangeSensorMinObstacleHeight_mm);
+    const bool isObstacle = !isBelowObstacles && (pointWrtRoot.z() <= kRangeSensorMaxObstacleHeight_mm);
+    if(!kRangeSensorUpdateNavMap || !isValid || (age_ms > kRangeSensorMaxFrameAge_ms) ||
+       !(isBelowObstacles || isObstacle))
+    {
+      continue;
+    }
+
+    Vec2f dir = target - sensorPos;
+    if(dir.MakeUnitLength() < kRangeSensorObstacleDepth_mm)
+    {
+      continue;
+    }
+    const Vec2f halfWidth = Vec2f(-dir.y(), dir.x()) * (0.5f * kRoiWidthPerRange * dist_mm);
+    const RobotTimeStamp_t frameTime_ms(robotTime_ms - std::min((TimeStamp_t) age_ms, robotTime_ms));
+
+    // Nothing is in the way up to what was hit, whether that's the ground or an obstacle
+    regions.push_back(FastPolygon{{sensorPos, target - halfWidth, target + halfWidth}});
+    mapUpdates.emplace_back(regions.back(), MemoryMapData(MemoryMapTypes::EContentType::ClearOfObstacle, frameTime_ms).Clone());
+
+    if(isObstacle)
+    {
+      const Point2f back = target + (dir * kRangeSensorObstacleDepth_mm);
+      regions.push_back(FastPolygon{{target - halfWidth, target + halfWidth, back + halfWidth, back - halfWidth}});
+      const Pose2d obstaclePose(atan2f(dir.y(), dir.x()), target);
+      mapUpdates.emplace_back(regions.back(),
+                              MemoryMapData_ProxObstacle(MemoryMapData_ProxObstacle::NOT_EXPLORED, obstaclePose, frameTime_ms).Clone());
+    }
+  }
+
+  // Every region from this batch of frames goes in together, since they are all in front of the robot
+  _robot->GetMapComponent().AddProxData(mapUpdates);
+}
+
+void RangeSensorComponent::UpdateActiveRois(ToFSensor& tof)
+{
+  const uint64_t now_ms = GetSteadyTime_ms();
+  if(now_ms - _lastRoiSchedule_ms < kRangeSensorRoiSchedulePeriod_ms)
+  {
+    return;
+  }
+  _lastRoiSchedule_ms = now_ms;
+
+  const TimeStamp_t robotTime_ms = (TimeStamp_t) _robot->GetLastMsgTimestamp();
+  const RobotTimeStamp_t staleBefore_ms(robotTime_ms - std::min((TimeStamp_t) kRangeSensorMapRefreshAge_ms, robotTime_ms));
+  const MemoryMapTypes::NodePredicate needsRefresh = [staleBefore_ms](MemoryMapTypes::MemoryMapDataConstPtr data) {
+    return (data->type == MemoryMapTypes::EContentType::Unknown) || (data->GetLastObservedTime() < staleBefore_ms);
+  };
+
+  // Range the ROIs that haven't been read in a while, or that last pointed where the map is stale
+  uint16_t roiMask = 0;
+  u32 numActive = 0;
+  for(int roi = 0; roi < ToFSensor::kNumRois; roi++)
+  {
+    const RoiHistory& history = _roiHistory[roi];
+    bool shouldRange = !history.hasTarget || (now_ms - history.lastRead_ms > kRangeSensorMaxRoiAge_ms);
+    if(!shouldRange)
+    {
+      const f32 halfSize_mm = kRangeSensorObstacleDepth_mm;
+      const FastPolygon targetRegion{{history.target + Point2f(-halfSize_mm, -halfSize_mm),
+                                      history.target + Point2f( halfSize_mm, -halfSize_mm),
+                                      history.target + Point2f( halfSize_mm,  halfSize_mm),
+                                      history.target + Point2f(-halfSize_mm,  halfSize_mm)}};
+      shouldRange = _robot->GetMapComponent().CheckForCollisions(targetRegion, needsRefresh);
+    }
+
+    if(shouldRange)
+    {
+      roiMask |= (1 << roi);
+      numActive++;
+    }
+  }
+
+  // Top up with the ROIs read longest ago
+  while(numActive < kRangeSensorMinActiveRois && numActive < ToFSensor::kNumRois)
+  {
+    int oldestRoi = -1;
+    for(int roi = 0; roi < ToFSensor::kNumRois; roi++)
+    {
+      if(!(roiMask & (1 << roi)) &&
+         (oldestRoi < 0 || _roiHistory[roi].lastRead_ms < _roiHistory[oldestRoi].lastRead_ms))
+      {
+        oldestRoi = roi;
+      }
+    }
+    roiMask |= (1 << oldestRoi);
+    numActive++;
+  }
+
+  if(roiMask != tof.GetActiveRois())
+  {
+    LOG_DEBUG("RangeSensorComponent.UpdateActiveRois", "Ranging %u ROIs (0x%04x)", numActive, roiMask);
+    tof.SetActiveRois(roiMask, nullptr);
+  }
 }
 
 } // Cozmo namespace
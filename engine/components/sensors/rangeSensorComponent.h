@@ -23,6 +23,9 @@
 
 #include "util/signals/simpleSignal_fwd.h"
 
+#include "whiskeyToF/tof.h"
+
+#include <array>
 #include <vector>
 
 namespace Anki {
@@ -56,6 +59,14 @@ public:
   
 private:
 
+  // Converts the frames read since the last update into points, and clears and adds obstacles
+  // in the nav map for them
+  void ProcessNewFrames(const ToFSensor& tof);
+
+  // Picks the ROIs for the sensor to range: those that haven't been read in a while and those
+  // that last pointed where the map hasn't been observed recently
+  void UpdateActiveRois(ToFSensor& tof);
+
   Robot* _robot = nullptr;
 
   Signal::SmartHandle _signalHandle;
@@ -65,6 +76,19 @@ private:
   bool _rawDataIsNew = false;
 
   bool _sendRangeData = false;
+
+  std::vector<ToFSensor::RangeFrame> _newFrames;
+
+  // Where each ROI last pointed at on the ground (wrt the origin at the time) and when it was read
+  struct RoiHistory
+  {
+    Point2f  target;
+    bool     hasTarget = false;
+    uint64_t lastRead_ms = 0;
+  };
+  std::array<RoiHistory, ToFSensor::kNumRois> _roiHistory;
+
+  uint64_t _lastRoiSchedule_ms = 0;
 };
 
 
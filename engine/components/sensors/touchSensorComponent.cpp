@@ -105,8 +105,6 @@ namespace {
   CONSOLE_VAR(bool, kTestOnlyLoggingEnabled, "Touch", false);
   #endif
   
-  const int kMaxPreTouchSamples = 100; // 100 ticks * 30ms = 3 seconds
-  
   const int kMinPostTouchSamples = 100; // 100 * 30ms = 3 sec
   
   const int kMaxDevLogBufferSize = 2000;// 60 seconds / 30ms = 2000 samples
@@ -552,7 +550,7 @@ void TouchSensorComponent::NotifyOfRobotStateInternal(const RobotState& msg)
   //    N samples (post-touch), then we keep collecting
   //    until we can get N consecutive samples
   //
-  // M = kMaxPreTouchSamples
+  // M = kDevLogMaxPreTouchSamples
   // N = kMinPostTouchSamples
   if(ANKI_DEV_CHEATS)
   {
@@ -567,10 +565,8 @@ void TouchSensorComponent::NotifyOfRobotStateInternal(const RobotState& msg)
     };
     
     // always logging pretouch event, only copied when touch event occurs
+    // note: once full, pushing overwrites the oldest sample
     _devLogBufferPreTouch.push_back(entry);
-    if(_devLogBufferPreTouch.size() > kMaxPreTouchSamples) {
-      _devLogBufferPreTouch.pop_front();
-    }
 
     const bool isTouchEvent = !lastPressed && _isPressed;
     if(isTouchEvent) {
@@ -578,7 +574,10 @@ void TouchSensorComponent::NotifyOfRobotStateInternal(const RobotState& msg)
         // seed the staging buffer with the pretouch data
         // if we are in PostTouch, then no copy is made since
         // we are already logging to the staging buffer
-        _devLogBuffer = _devLogBufferPreTouch;
+        _devLogBuffer.clear();
+        for(size_t i = 0; i < _devLogBufferPreTouch.size(); ++i) {
+          _devLogBuffer.push_back(_devLogBufferPreTouch[i]);
+        }
       }
       _devLogMode = PostTouch;
       // if we receive a TouchEvent while we are already
@@ -19,9 +19,12 @@
 #include "clad/types/factoryTestTypes.h"
 
 #include "util/signals/simpleSignal_fwd.h"
+#include "util/container/fixedCircularBuffer.h"
 #include "util/math/math.h"
 
+#include <algorithm>
 #include <deque>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
@@ -29,35 +32,46 @@ namespace Vector {
 class IBehaviorPlaypen;
 struct FilterParameters;
 
+// Running mean over the last windowSize inputs. Inputs are kept in a ring allocated once up front, so
+// filtering a reading is a constant amount of work with no allocation.
 class BoxFilter
 {
 public:
   BoxFilter(int windowSize)
-  : _buffer()
+  : _buffer(std::max(windowSize, 1), 0)
   , _winSize(windowSize)
   , _sum(0)
+  , _nextIndex(0)
+  , _numInputs(0)
   {
   }
   
   float ApplyFilter(int input)
   {
-    if(_winSize == 1) {
+    if(_winSize <= 1) {
       return input;
     }
     
-    _buffer.push_back(input);
-    _sum += _buffer.back();
-    if(_buffer.size()==(_winSize+1)) {
-      _sum -= _buffer.front();
-      _buffer.pop_front();
+    // replace the oldest input once the window is full
+    int& slot = _buffer[_nextIndex];
+    if(_numInputs == _winSize) {
+      _sum -= slot;
+    } else {
+      ++_numInputs;
     }
-    return float(_sum)/float(_buffer.size());
+    slot = input;
+    _sum += input;
+    
+    _nextIndex = (_nextIndex + 1 == _winSize) ? 0 : (_nextIndex + 1);
+    return float(_sum)/float(_numInputs);
   }
   
 private:
-  std::deque<int> _buffer;
+  std::vector<int> _buffer;
   int _winSize;
   int _sum;
+  int _nextIndex;
+  int _numInputs;
 };
 
 
@@ -368,8 +382,11 @@ private:
   // staging buffer for holding the pre-touch and post-touch samples
   std::deque<DevLogTouchRow> _devLogBuffer;
   
-  // buffer that only accumulates non-press touch samples
-  std::deque<DevLogTouchRow> _devLogBufferPreTouch;
+  // number of samples kept from before a touch event
+  static constexpr size_t kDevLogMaxPreTouchSamples = 100; // 100 ticks * 30ms = 3 seconds
+
+  // the most recent samples, seeding _devLogBuffer when a touch event occurs
+  Util::FixedCircularBuffer<DevLogTouchRow, kDevLogMaxPreTouchSamples> _devLogBufferPreTouch;
 
   // last complete buffer that is saved for writing to disk
   std::deque<DevLogTouchRow> _devLogBufferSaved;
@@ -14,6 +14,9 @@
 
 #include "coretech/common/engine/jsonTools.h"
 #include "coretech/common/engine/utils/timer.h"
+#include "engine/actions/actionContainers.h"
+#include "engine/actions/compoundActions.h"
+#include "engine/actions/sayTextAction.h"
 #include "engine/components/dataAccessorComponent.h"
 #include "engine/robotComponents_fwd.h"
 #include "engine/robot.h"
@@ -22,10 +25,13 @@
 #include "clad/robotInterface/messageEngineToRobot.h"
 #include "clad/robotInterface/messageRobotToEngine.h"
 
+#include "util/console/consoleInterface.h"
 #include "util/entityComponent/dependencyManagedEntity.h"
 #include "util/math/math.h"
 
+#include <algorithm>
 #include <cstring>
+#include <vector>
 
 #define LOG_CHANNEL "TextToSpeech"
 
@@ -50,6 +56,36 @@ namespace {
 
   // Utterances should not take longer than this to generate
   constexpr float kGenerationTimeout_s = 20.0f; // making this high until we figure out accurate generation times
+
+  // How many upcoming SayTextActions may have their utterances generated ahead of time. Each one holds its audio in
+  // the anim process until it plays, so this bounds the memory prefetching uses. 0 disables prefetching.
+  CONSOLE_VAR_RANGED(u32, kMaxPrefetchedUtterances, "TextToSpeech", 2, 0, 8);
+
+  // Appends the SayTextActions in action (itself or its constituents, in order) that haven't requested their
+  // utterance yet, stopping once pending holds maxPending
+  void GetPendingSayTextActions(const IActionRunner* action,
+                                std::vector<const SayTextAction*>& pending,
+                                const size_t maxPending)
+  {
+    if ((nullptr == action) || (pending.size() >= maxPending)) {
+      return;
+    }
+
+    if (RobotActionType::SAY_TEXT == action->GetType()) {
+      const auto* sayTextAction = dynamic_cast<const SayTextAction*>(action);
+      if ((nullptr != sayTextAction) && sayTextAction->IsAwaitingUtterance()) {
+        pending.push_back(sayTextAction);
+      }
+      return;
+    }
+
+    const auto* compoundAction = dynamic_cast<const ICompoundAction*>(action);
+    if (nullptr != compoundAction) {
+      for (const auto& childAction : compoundAction->GetActionList()) {
+        GetPendingSayTextActions(childAction.get(), pending, maxPending);
+      }
+    }
+  }
 }
 
 // Helper to map trigger types
@@ -135,6 +171,56 @@ void TextToSpeechCoordinator::UpdateDependent(const RobotCompMap& dependentComps
       ++it;
     }
   }
+
+  UpdatePrefetch();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void TextToSpeechCoordinator::UpdatePrefetch()
+{
+  const size_t maxPrefetched = kMaxPrefetchedUtterances;
+
+  // Upcoming SayTextActions, in the order each queue will run them
+  std::vector<const SayTextAction*> pending;
+  if (maxPrefetched > 0) {
+    pending.reserve(maxPrefetched);
+    for (const auto& slot : _robot->GetActionList()) {
+      const ActionQueue& queue = slot.second;
+      GetPendingSayTextActions(queue.GetCurrentRunningAction(), pending, maxPrefetched);
+      for (const IActionRunner* queuedAction : queue) {
+        GetPendingSayTextActions(queuedAction, pending, maxPrefetched);
+      }
+    }
+  }
+
+  // Drop prefetches for actions that were cancelled, or were pushed back by actions queued ahead of them
+  for (auto it = _prefetchedUtterances.begin(); it != _prefetchedUtterances.end(); ) {
+    const u32 actionTag = it->first;
+    const bool isPending = std::any_of(pending.begin(), pending.end(), [actionTag](const SayTextAction* action) {
+      return action->GetTag() == actionTag;
+    });
+    if (isPending) {
+      ++it;
+      continue;
+    }
+
+    const uint8_t utteranceID = it->second;
+    it = _prefetchedUtterances.erase(it);
+    const auto recordIt = _utteranceMap.find(utteranceID);
+    if ((recordIt != _utteranceMap.end()) && recordIt->second.isPrefetched) {
+      LOG_DEBUG("TextToSpeechCoordinator.UpdatePrefetch.Cancel",
+                "Utterance %d is no longer needed by action %u",
+                utteranceID,
+                actionTag);
+      CancelUtterance(utteranceID);
+    }
+  }
+
+  for (const SayTextAction* action : pending) {
+    if (_prefetchedUtterances.find(action->GetTag()) == _prefetchedUtterances.end()) {
+      action->PrefetchUtterance(*this);
+    }
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -291,6 +377,80 @@ const bool TextToSpeechCoordinator::CancelUtterance(const uint8_t utteranceID)
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const bool TextToSpeechCoordinator::PrefetchUtterance(const u32 actionTag,
+                                                      const std::string& utteranceString,
+                                                      const UtteranceTriggerType& triggerType,
+                                                      const AudioTtsProcessingStyle& style,
+                                                      const float durationScalar)
+{
+  // Immediate utterances play as soon as they're ready, which is exactly what prefetching must not do
+  if (UtteranceTriggerType::Immediate == triggerType) {
+    LOG_ERROR("TextToSpeechCoordinator.PrefetchUtterance.Immediate",
+              "Cannot prefetch an immediately triggered utterance for action %u",
+              actionTag);
+    return false;
+  }
+
+  if ((_prefetchedUtterances.size() >= kMaxPrefetchedUtterances) ||
+      (_prefetchedUtterances.find(actionTag) != _prefetchedUtterances.end())) {
+    return false;
+  }
+
+  const uint8_t utteranceID = CreateUtterance(utteranceString, triggerType, style, durationScalar);
+  // Remember failures too, so that the action isn't retried every tick. It will create its own utterance.
+  _prefetchedUtterances[actionTag] = utteranceID;
+  if (kInvalidUtteranceID == utteranceID) {
+    return false;
+  }
+
+  _utteranceMap[utteranceID].isPrefetched = true;
+
+  LOG_INFO("TextToSpeechCoordinator.PrefetchUtterance",
+           "Utterance %d prefetched for action %u",
+           utteranceID,
+           actionTag);
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const uint8_t TextToSpeechCoordinator::ClaimPrefetchedUtterance(const u32 actionTag, UtteranceUpdatedCallback callback)
+{
+  const auto prefetchIt = _prefetchedUtterances.find(actionTag);
+  if (prefetchIt == _prefetchedUtterances.end()) {
+    return kInvalidUtteranceID;
+  }
+
+  const uint8_t utteranceID = prefetchIt->second;
+  _prefetchedUtterances.erase(prefetchIt);
+
+  // The record may already be gone if generation failed or timed out
+  const auto recordIt = _utteranceMap.find(utteranceID);
+  if ((recordIt == _utteranceMap.end()) || !recordIt->second.isPrefetched) {
+    return kInvalidUtteranceID;
+  }
+
+  UtteranceRecord& utterance = recordIt->second;
+  utterance.isPrefetched = false;
+  if ((UtteranceState::Invalid == utterance.state) || (UtteranceState::Finished == utterance.state)) {
+    return kInvalidUtteranceID;
+  }
+
+  LOG_INFO("TextToSpeechCoordinator.ClaimPrefetchedUtterance",
+           "Action %u claimed utterance %d (%s)",
+           actionTag,
+           utteranceID,
+           EnumToString(utterance.state));
+
+  // As in CreateUtterance, run the callback once so the caller starts out knowing the state
+  utterance.callback = callback;
+  if (nullptr != utterance.callback) {
+    utterance.callback(utterance.state);
+  }
+
+  return utteranceID;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // Private methods
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -47,7 +47,9 @@ public:
     dependencies.insert(RobotComponentID::DataAccessor);
   };
   virtual void GetUpdateDependencies(RobotCompIDSet& dependencies) const override {}
-  virtual void AdditionalUpdateAccessibleComponents(RobotCompIDSet& dependencies) const override {}
+  virtual void AdditionalUpdateAccessibleComponents(RobotCompIDSet& dependencies) const override {
+    dependencies.insert(RobotComponentID::ActionList);
+  };
   virtual void UpdateDependent(const RobotCompMap& dependentComps) override;
   // IDependencyManagedComponent
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -70,7 +72,24 @@ public:
   //  + cancelling will clear the wav data in AnkiPluginInterface, regardless of which utteranceID was last delivered
   const bool           CancelUtterance(const uint8_t utteranceID);
 
+  // Starts generating the utterance for the action tagged actionTag before that action runs, so that it is ready
+  // to play as soon as the action claims it. Each tick the coordinator looks ahead through the action queues and
+  // prefetches for the next few SayTextActions that haven't started, cancelling prefetches whose action is no longer
+  // among them. Returns false if nothing was prefetched.
+  const bool           PrefetchUtterance(const u32 actionTag,
+                                         const std::string& utteranceString,
+                                         const UtteranceTriggerType& triggerType,
+                                         const AudioTtsProcessingStyle& style,
+                                         const float durationScalar);
+
+  // Hands the utterance prefetched for actionTag over to the caller, running callback with its current state.
+  // Returns kInvalidUtteranceID if there is none (or it failed), in which case the caller should create its own.
+  const uint8_t        ClaimPrefetchedUtterance(const u32 actionTag, UtteranceUpdatedCallback callback);
+
 private:
+  // Look ahead in the action queues for SayTextActions to prefetch for
+  void UpdatePrefetch();
+
   void UpdateUtteranceState(const uint8_t& ttsID,
                             const TextToSpeechState& ttsState,
                             const float& expectedDuration_ms = 0.0f);
@@ -83,10 +102,14 @@ private:
     float                     expectedDuration_s          = 0.0f;
     size_t                    tickReadyForCleanup         = 0;
     UtteranceUpdatedCallback  callback                    = nullptr;
+    bool                      isPrefetched                = false; // Not yet claimed by the action it was made for
   };
   
   std::unordered_map<uint8_t, UtteranceRecord> _utteranceMap;
 
+  // Utterances generated ahead of time, keyed by the tag of the action they are for
+  std::unordered_map<u32, uint8_t> _prefetchedUtterances;
+
   Signal::SmartHandle            _signalHandle;
 
   Robot* _robot = nullptr;
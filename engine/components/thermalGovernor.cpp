@@ -0,0 +1,143 @@
+/**
+ * File: thermalGovernor.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Picks a CPU frequency cap and vision quality for the current CPU temperature
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "engine/components/thermalGovernor.h"
+
+#include "util/console/consoleInterface.h"
+#include "util/helpers/templateHelpers.h"
+#include "util/logging/logging.h"
+
+#define LOG_CHANNEL "PowerStates"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+
+#define CONSOLE_GROUP "PowerSave.Thermal"
+
+// The animation streamer shows its thermal alert at 90C, and the kernel starts throttling not far above that
+CONSOLE_VAR_RANGED( u32, kThermal_WarmAbove_C, CONSOLE_GROUP, 75, 40, 100);
+CONSOLE_VAR_RANGED( u32, kThermal_HotAbove_C, CONSOLE_GROUP, 85, 40, 100);
+CONSOLE_VAR_RANGED( u32, kThermal_Hysteresis_C, CONSOLE_GROUP, 3, 0, 20);
+
+// The temperature takes a while to follow the frequency, so hold each level at least this long before stepping down
+CONSOLE_VAR_RANGED( f32, kThermal_MinLevelDuration_s, CONSOLE_GROUP, 20.f, 0.f, 300.f);
+
+// Demand which buys back a CPU step, with separate marks for raising and dropping it so it doesn't flicker
+static constexpr const float kMicBufferHighMark = 0.6f;
+static constexpr const float kMicBufferLowMark = 0.1f;
+static constexpr const float kVisionDropHighMark = 0.25f;
+static constexpr const float kVisionDropLowMark = 0.05f;
+
+}
+
+const char* ThermalLevelToString(ThermalLevel level)
+{
+  switch(level) {
+    case ThermalLevel::Normal: return "Normal";
+    case ThermalLevel::Warm:   return "Warm";
+    case ThermalLevel::Hot:    return "Hot";
+  }
+  return "Invalid";
+}
+
+ThermalLevel ThermalGovernor::GetLevelForTemperature(uint32_t temperature_C) const
+{
+  // Levels go up at their thresholds, but only come back down once below them by the hysteresis
+  const uint32_t hysteresis_C = kThermal_Hysteresis_C;
+  const bool isHot = (temperature_C >= kThermal_HotAbove_C) ||
+                     ((_level == ThermalLevel::Hot) && (temperature_C + hysteresis_C >= kThermal_HotAbove_C));
+  if( isHot ) {
+    return ThermalLevel::Hot;
+  }
+  const bool isWarm = (temperature_C >= kThermal_WarmAbove_C) ||
+                      ((_level != ThermalLevel::Normal) && (temperature_C + hysteresis_C >= kThermal_WarmAbove_C));
+  return isWarm ? ThermalLevel::Warm : ThermalLevel::Normal;
+}
+
+bool ThermalGovernor::Update(float currTime_s, const Inputs& inputs)
+{
+  const DesiredCPUFrequency oldFreq = GetDesiredCPUFrequency();
+  const uint8_t oldVisionStretch = GetVisionStretch();
+  const uint8_t oldNeuralNetStretch = GetNeuralNetStretch();
+
+  ThermalLevel newLevel = GetLevelForTemperature(inputs.temperature_C);
+
+  // Throttling means we're already past the limit, whatever the temperature reading says
+  if( inputs.isCPUThrottling ) {
+    newLevel = ThermalLevel::Hot;
+  }
+
+  if( newLevel < _level ) {
+    const bool heldLongEnough = (currTime_s - _timeLevelChanged_s >= kThermal_MinLevelDuration_s);
+    newLevel = heldLongEnough ? static_cast<ThermalLevel>(Util::EnumToUnderlying(_level) - 1) : _level;
+  }
+
+  if( newLevel != _level ) {
+    LOG_INFO("ThermalGovernor.Update.LevelChanged", "%s -> %s at %uC%s",
+             ThermalLevelToString(_level), ThermalLevelToString(newLevel), inputs.temperature_C,
+             inputs.isCPUThrottling ? " (throttling)" : "");
+    _level = newLevel;
+    _timeLevelChanged_s = currTime_s;
+  }
+
+  const bool demandAboveHighMark = (inputs.micBufferFullness >= kMicBufferHighMark) ||
+                                   (inputs.visionDropFraction >= kVisionDropHighMark);
+  const bool demandBelowLowMark = (inputs.micBufferFullness <= kMicBufferLowMark) &&
+                                  (inputs.visionDropFraction <= kVisionDropLowMark);
+  const bool highDemand = _highDemand ? !demandBelowLowMark : demandAboveHighMark;
+  if( highDemand != _highDemand ) {
+    LOG_DEBUG("ThermalGovernor.Update.DemandChanged", "%s demand. Mic buffer %.2f, vision drops %.2f",
+              highDemand ? "High" : "Normal", inputs.micBufferFullness, inputs.visionDropFraction);
+    _highDemand = highDemand;
+  }
+  _wasThrottling = inputs.isCPUThrottling;
+
+  return (oldFreq != GetDesiredCPUFrequency()) ||
+         (oldVisionStretch != GetVisionStretch()) ||
+         (oldNeuralNetStretch != GetNeuralNetStretch());
+}
+
+DesiredCPUFrequency ThermalGovernor::GetDesiredCPUFrequency() const
+{
+  // Demand can buy back one step, but not once the kernel has stepped in
+  const bool boost = _highDemand && !_wasThrottling;
+  switch( _level ) {
+    case ThermalLevel::Normal:
+      return DesiredCPUFrequency::Automatic;
+    case ThermalLevel::Warm:
+      return boost ? DesiredCPUFrequency::Automatic : DesiredCPUFrequency::Manual533Mhz;
+    case ThermalLevel::Hot:
+      return boost ? DesiredCPUFrequency::Manual533Mhz : DesiredCPUFrequency::Manual400Mhz;
+  }
+  return DesiredCPUFrequency::Automatic;
+}
+
+uint8_t ThermalGovernor::GetVisionStretch() const
+{
+  switch( _level ) {
+    case ThermalLevel::Normal: return 1;
+    case ThermalLevel::Warm:   return 2;
+    case ThermalLevel::Hot:    return 4;
+  }
+  return 1;
+}
+
+uint8_t ThermalGovernor::GetNeuralNetStretch() const
+{
+  // Detections are what behaviors react to, so neural nets are only slowed once hot
+  return (_level == ThermalLevel::Hot) ? 2 : 1;
+}
+
+}
+}
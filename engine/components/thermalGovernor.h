@@ -0,0 +1,71 @@
+/**
+ * File: thermalGovernor.h
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Picks a CPU frequency cap and vision quality for the current CPU temperature, so that long play
+ *              sessions level off below the point where the kernel throttles the CPU (and everything stutters at
+ *              once). Each level up from Normal lowers the CPU cap one step and runs low priority and neural net
+ *              vision modes less often. Demand (mic data backing up, vision dropping camera frames) buys back one
+ *              CPU step, unless the kernel is already throttling. Owned and applied by the PowerStateManager.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Engine_Components_ThermalGovernor_H__
+#define __Engine_Components_ThermalGovernor_H__
+
+#include "osState/osState.h"
+
+#include <cstdint>
+
+namespace Anki {
+namespace Vector {
+
+enum class ThermalLevel : uint8_t {
+  Normal,
+  Warm,
+  Hot,
+};
+
+const char* ThermalLevelToString(ThermalLevel level);
+
+class ThermalGovernor
+{
+public:
+
+  struct Inputs {
+    uint32_t temperature_C = 0;
+    bool     isCPUThrottling = false;
+    float    micBufferFullness = 0.f;   // 0 to 1
+    float    visionDropFraction = 0.f;  // fraction of camera frames the vision thread didn't keep up with
+  };
+
+  // Re-evaluate with fresh inputs. Returns true if any of the outputs below changed
+  bool Update(float currTime_s, const Inputs& inputs);
+
+  ThermalLevel GetLevel() const { return _level; }
+  bool HasHighDemand() const { return _highDemand; }
+  bool WasThrottling() const { return _wasThrottling; }
+
+  // Outputs, to be used whenever the CPU isn't being held low for power save
+  DesiredCPUFrequency GetDesiredCPUFrequency() const;
+  uint8_t GetVisionStretch() const;
+  uint8_t GetNeuralNetStretch() const;
+
+private:
+
+  ThermalLevel GetLevelForTemperature(uint32_t temperature_C) const;
+
+  ThermalLevel _level = ThermalLevel::Normal;
+  bool _highDemand = false;
+  bool _wasThrottling = false;
+  float _timeLevelChanged_s = 0.f;
+};
+
+}
+}
+
+#endif
@@ -12,6 +12,11 @@
  */
 
 #include "engine/components/variableSnapshot/variableSnapshotComponent.h"
+#include "engine/components/variableSnapshot/variableSnapshotJournal.h"
+
+#include "coretech/common/engine/utils/timer.h"
+#include "util/console/consoleInterface.h"
+#include "util/jsonWriter/jsonStreamWriter.h"
 
 #include "clad/types/variableSnapshotIds.h"
 
@@ -26,6 +31,28 @@ namespace Vector {
 const char* VariableSnapshotComponent::kVariableSnapshotFolder = "variableSnapshotStorage";
 const char* VariableSnapshotComponent::kVariableSnapshotFilename = "variableSnapshot";
 
+namespace {
+  // how often changed variables are appended to the journal
+  CONSOLE_VAR(f32, kVariableSnapshotJournalInterval_s, "VariableSnapshot", 10.f);
+
+  // once the journal is larger than this it is folded into the snapshot
+  CONSOLE_VAR(u32, kVariableSnapshotMaxJournalSize_bytes, "VariableSnapshot", 16 * 1024);
+
+  std::string GetSaveFolder(const Util::Data::DataPlatform* platform, const std::string& folderName)
+  {
+    // cache the name of our save directory
+    std::string saveFolder = platform->pathToResource( Util::Data::Scope::Persistent, folderName );
+    saveFolder = Util::FileUtils::AddTrailingFileSeparator( saveFolder );
+
+    // make sure our folder structure exists
+    if(Util::FileUtils::DirectoryDoesNotExist( saveFolder )) {
+      Util::FileUtils::CreateDirectory( saveFolder, false, true );
+      PRINT_CH_DEBUG( "DataLoader", "VariableSnapshot", "Creating variable snapshot directory: %s", saveFolder.c_str() );
+    }
+    return saveFolder;
+  }
+}
+
 
 VariableSnapshotComponent::VariableSnapshotComponent():
   IDependencyManagedComponent<RobotComponentID>(this, RobotComponentID::VariableSnapshotComponent),
@@ -47,22 +74,24 @@ void VariableSnapshotComponent::InitDependent(Vector::Robot* robot, const RobotC
 }
 
 
+void VariableSnapshotComponent::UpdateDependent(const RobotCompMap& dependentComponents)
+{
+  const float currTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+  if(currTime_s < _nextJournalTime_s) {
+    return;
+  }
+  _nextJournalTime_s = currTime_s + kVariableSnapshotJournalInterval_s;
+
+  JournalChangedVariables();
+}
+
+
 std::string VariableSnapshotComponent::GetSavePath(const Util::Data::DataPlatform* platform, 
                                                    std::string folderName, 
                                                    std::string filename) 
 {
-  // cache the name of our save directory
-  std::string saveFolder = platform->pathToResource( Util::Data::Scope::Persistent, folderName );
-  saveFolder = Util::FileUtils::AddTrailingFileSeparator( saveFolder );
-
-  // make sure our folder structure exists
-  if(Util::FileUtils::DirectoryDoesNotExist( saveFolder )) {
-    Util::FileUtils::CreateDirectory( saveFolder, false, true );
-    PRINT_CH_DEBUG( "DataLoader", "VariableSnapshot", "Creating variable snapshot directory: %s", saveFolder.c_str() );
-  }
-  
   // read in our data
-  std::string variableSnapshotSavePath = ( saveFolder + filename + ".json" );
+  std::string variableSnapshotSavePath = ( GetSaveFolder(platform, folderName) + filename + ".json" );
 
   if(!Util::FileUtils::FileExists( variableSnapshotSavePath )) {
     PRINT_CH_DEBUG( "DataLoader", "VariableSnapshot", "Creating variable snapshot file: %s", variableSnapshotSavePath.c_str() );
@@ -74,6 +103,39 @@ std::string VariableSnapshotComponent::GetSavePath(const Util::Data::DataPlatfor
 }
 
 
+std::string VariableSnapshotComponent::GetJournalPath(const Util::Data::DataPlatform* platform,
+                                                      std::string folderName,
+                                                      std::string filename)
+{
+  return ( GetSaveFolder(platform, folderName) + filename + ".journal" );
+}
+
+
+bool VariableSnapshotComponent::WriteSnapshot(const Util::Data::DataPlatform* platform,
+                                              const RobotDataLoader::VariableSnapshotJsonMap& jsonMap)
+{
+  // create a json list that will be stored
+  Json::Value saveJson;
+  for(const auto& subscriber : jsonMap) {
+    saveJson.append(subscriber.second);
+  }
+
+  std::string body;
+  Util::JsonStreamWriter::Write(saveJson, body, Util::JsonStreamWriter::Style::Pretty);
+
+  // written to a temporary file and renamed over the old snapshot, so that a crash mid write leaves the
+  // old snapshot (plus its journal) rather than a truncated one
+  const std::string path = GetSavePath(platform, kVariableSnapshotFolder, kVariableSnapshotFilename);
+  const bool success = Util::FileUtils::WriteFileAtomic(path, body);
+  if(success) {
+    Util::FileUtils::DeleteFile(GetJournalPath(platform, kVariableSnapshotFolder, kVariableSnapshotFilename));
+  } else {
+    PRINT_NAMED_WARNING("VariableSnapshotComponent.WriteSnapshot.Failed", "Could not write %s", path.c_str());
+  }
+  return success;
+}
+
+
 bool VariableSnapshotComponent::SaveVariableSnapshots()
 {
   auto platform = _robot->GetContextDataPlatform();
@@ -89,15 +151,40 @@ bool VariableSnapshotComponent::SaveVariableSnapshots()
     (*_variableSnapshotJsonMap)[variableSnapshotId] = std::move(outJson);
   }
 
-  // create a json list that will be stored
-  Json::Value saveJson;
-  for(const auto& subscriber : *_variableSnapshotJsonMap) {
-    saveJson.append(subscriber.second);
+  return WriteSnapshot(platform, *_variableSnapshotJsonMap);
+}
+
+
+size_t VariableSnapshotComponent::JournalChangedVariables()
+{
+  std::vector<Json::Value> changedEntries;
+  for(const auto& dataMapIter : _variableSnapshotDataMap) {
+    Json::Value outJson;
+    VariableSnapshotId variableSnapshotId = dataMapIter.first;
+    dataMapIter.second(outJson);
+    outJson[VariableSnapshotEncoder::kVariableSnapshotIdKey] = VariableSnapshotIdToString(variableSnapshotId);
+
+    // the json map holds what was last saved for each variable, so only differences need writing
+    auto& savedJson = (*_variableSnapshotJsonMap)[variableSnapshotId];
+    if(savedJson != outJson) {
+      changedEntries.push_back(outJson);
+      savedJson = std::move(outJson);
+    }
   }
-  
-  std::string path = VariableSnapshotComponent::GetSavePath(platform, kVariableSnapshotFolder, kVariableSnapshotFilename);
-  const bool success = platform->writeAsJson(path, saveJson);
-  return success;
+
+  if(changedEntries.empty()) {
+    return 0;
+  }
+
+  auto platform = _robot->GetContextDataPlatform();
+  const std::string journalPath = GetJournalPath(platform, kVariableSnapshotFolder, kVariableSnapshotFilename);
+  VariableSnapshotJournal::Append(journalPath, changedEntries);
+
+  if(Util::FileUtils::GetFileSize(journalPath) > static_cast<ssize_t>(kVariableSnapshotMaxJournalSize_bytes)) {
+    WriteSnapshot(platform, *_variableSnapshotJsonMap);
+  }
+
+  return changedEntries.size();
 }
 
 
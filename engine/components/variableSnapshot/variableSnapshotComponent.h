@@ -49,7 +49,8 @@ public:
     dependencies.insert(RobotComponentID::CozmoContextWrapper);
   };
 
-  virtual void UpdateDependent(const RobotCompMap& dependentComponents) override {};
+  // periodically journals the variables that changed since they were last saved
+  virtual void UpdateDependent(const RobotCompMap& dependentComponents) override;
 
 
   //////
@@ -75,12 +76,23 @@ public:
   // creates the path to the desired save location
   static std::string GetSavePath(const Util::Data::DataPlatform*, std::string, std::string);
 
+  // path to the journal of changes made since the snapshot at GetSavePath was written
+  static std::string GetJournalPath(const Util::Data::DataPlatform*, std::string, std::string);
+
+  // atomically replaces the snapshot with the contents of the json map, then removes the journal since
+  // everything in it is now in the snapshot. Returns true if the snapshot was written
+  static bool WriteSnapshot(const Util::Data::DataPlatform*, const RobotDataLoader::VariableSnapshotJsonMap&);
+
 private:
   
   // SaveVariableSnapshots saves the existing variable snapshots into the component or the subset 
   // specified by a vector of keys, and returns true if the save succeeded.
   bool SaveVariableSnapshots();
 
+  // serializes every variable and appends the ones that differ from their last saved value to the journal,
+  // compacting it into the snapshot once it grows too large. Returns the number of variables journaled
+  size_t JournalChangedVariables();
+
   using SerializationFnType = std::function<bool(Json::Value&)>;
 
   // this data structure stores the function required to serialize data
@@ -90,6 +102,8 @@ private:
   RobotDataLoader::VariableSnapshotJsonMap* _variableSnapshotJsonMap;
 
   Vector::Robot* _robot;
+
+  float _nextJournalTime_s = 0.f;
 };
 
 
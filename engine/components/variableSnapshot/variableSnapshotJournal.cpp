@@ -0,0 +1,141 @@
+/*
+ * File: variableSnapshotJournal.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Append-only journal of variable snapshot changes, kept next to the full snapshot file.
+ *
+ * Copyright: Victor Rebuild 2026
+ */
+
+#include "engine/components/variableSnapshot/variableSnapshotJournal.h"
+
+#include "util/crc/crc.h"
+#include "util/fileUtils/fileUtils.h"
+#include "util/jsonWriter/jsonStreamWriter.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+
+#define LOG_CHANNEL "VariableSnapshot"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  // the journal starts with this, so that a file of some other format is never replayed
+  const uint8_t kJournalMagic[] = {'V', 'S', 'J', '1'};
+
+  // each record is a little endian u32 payload length and u16 crc of the payload, then the payload
+  // (the entry as compact json)
+  const size_t kRecordHeaderSize = sizeof(uint32_t) + sizeof(uint16_t);
+
+  // nothing we journal is anywhere near this, so a larger length means the header itself is garbage
+  const uint32_t kMaxPayloadSize = 1 << 20;
+
+  const uint16_t kCrcSeed = 0xFFFF;
+
+  void AppendLittleEndian(std::vector<uint8_t>& bytes, uint32_t value, size_t numBytes)
+  {
+    for(size_t i = 0; i < numBytes; ++i) {
+      bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+    }
+  }
+
+  uint32_t ReadLittleEndian(const uint8_t* bytes, size_t numBytes)
+  {
+    uint32_t value = 0;
+    for(size_t i = 0; i < numBytes; ++i) {
+      value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    }
+    return value;
+  }
+}
+
+
+bool VariableSnapshotJournal::Append(const std::string& path, const std::vector<Json::Value>& entries)
+{
+  if(entries.empty()) {
+    return true;
+  }
+
+  std::vector<uint8_t> bytes;
+  if(Util::FileUtils::GetFileSize(path) <= 0) {
+    bytes.insert(bytes.end(), std::begin(kJournalMagic), std::end(kJournalMagic));
+  }
+
+  std::string payload;
+  for(const auto& entry : entries) {
+    Util::JsonStreamWriter::Write(entry, payload);
+    const uint8_t* payloadBytes = reinterpret_cast<const uint8_t*>(payload.data());
+    const uint32_t payloadSize = static_cast<uint32_t>(payload.size());
+    AppendLittleEndian(bytes, payloadSize, sizeof(uint32_t));
+    AppendLittleEndian(bytes, calculate_crc_ccitt(kCrcSeed, payloadBytes, payloadSize), sizeof(uint16_t));
+    bytes.insert(bytes.end(), payloadBytes, payloadBytes + payloadSize);
+  }
+
+  // the whole batch goes out in one write, so a crash tears at most the last record
+  const bool success = Util::FileUtils::WriteFile(path, bytes, true);
+  if(!success) {
+    LOG_WARNING("VariableSnapshotJournal.Append.WriteFailed", "Could not append %zu records to %s",
+                entries.size(), path.c_str());
+  }
+  return success;
+}
+
+
+size_t VariableSnapshotJournal::Replay(const std::string& path, const std::function<void(Json::Value&&)>& onEntry)
+{
+  if(!Util::FileUtils::FileExists(path)) {
+    return 0;
+  }
+
+  const std::vector<uint8_t> bytes = Util::FileUtils::ReadFileAsBinary(path);
+  if((bytes.size() < sizeof(kJournalMagic)) ||
+     !std::equal(std::begin(kJournalMagic), std::end(kJournalMagic), bytes.begin())) {
+    if(!bytes.empty()) {
+      LOG_WARNING("VariableSnapshotJournal.Replay.BadHeader", "Ignoring %s, it is not a snapshot journal",
+                  path.c_str());
+    }
+    return 0;
+  }
+
+  size_t numReplayed = 0;
+  size_t offset = sizeof(kJournalMagic);
+  Json::Reader reader;
+  while(offset < bytes.size()) {
+    if(bytes.size() - offset < kRecordHeaderSize) {
+      break;
+    }
+    const uint32_t payloadSize = ReadLittleEndian(bytes.data() + offset, sizeof(uint32_t));
+    const uint16_t crc = static_cast<uint16_t>(ReadLittleEndian(bytes.data() + offset + sizeof(uint32_t), sizeof(uint16_t)));
+    const size_t payloadOffset = offset + kRecordHeaderSize;
+    if((payloadSize > kMaxPayloadSize) || (bytes.size() - payloadOffset < payloadSize)) {
+      break;
+    }
+    const uint8_t* payloadBytes = bytes.data() + payloadOffset;
+    if(calculate_crc_ccitt(kCrcSeed, payloadBytes, payloadSize) != crc) {
+      break;
+    }
+
+    Json::Value entry;
+    const char* payloadChars = reinterpret_cast<const char*>(payloadBytes);
+    if(!reader.parse(payloadChars, payloadChars + payloadSize, entry, false)) {
+      break;
+    }
+    onEntry(std::move(entry));
+    ++numReplayed;
+    offset = payloadOffset + payloadSize;
+  }
+
+  if(offset < bytes.size()) {
+    LOG_WARNING("VariableSnapshotJournal.Replay.TornRecord",
+                "Dropping the last %zu bytes of %s after %zu intact records",
+                bytes.size() - offset, path.c_str(), numReplayed);
+  }
+  return numReplayed;
+}
+
+}
+}
@@ -0,0 +1,42 @@
+/*
+ * File: variableSnapshotJournal.h
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Append-only journal of variable snapshot changes, kept next to the full snapshot file.
+ *              Each record is one snapshot entry (the same json object that goes into the snapshot array),
+ *              framed by its length and a checksum so that a record torn by a crash or power loss is
+ *              detected and dropped on replay. Replaying the journal over the snapshot at load gives the
+ *              latest saved value of every variable.
+ *
+ * Copyright: Victor Rebuild 2026
+ */
+
+#ifndef __Engine_Component_VariableSnapshot_VariableSnapshotJournal_H__
+#define __Engine_Component_VariableSnapshot_VariableSnapshotJournal_H__
+
+#include "json/json.h"
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+
+namespace VariableSnapshotJournal {
+  // appends one record per entry to the journal at path, creating it if needed. Returns true if the records
+  // were written
+  bool Append(const std::string& path, const std::vector<Json::Value>& entries);
+
+  // calls onEntry with every intact record in the journal at path, oldest first, stopping at the first
+  // record that is truncated or fails its checksum. Returns the number of records replayed
+  size_t Replay(const std::string& path, const std::function<void(Json::Value&&)>& onEntry);
+}
+
+}
+}
+
+#endif
@@ -25,6 +25,7 @@
 #include "engine/components/powerStateManager.h"
 #include "engine/components/visionComponent.h"
 #include "engine/components/visionScheduleMediator/visionScheduleMediator.h"
+#include "engine/cozmoContext.h"
 #include "engine/namedColors/namedColors.h"
 #include "engine/navMap/mapComponent.h"
 #include "engine/externalInterface/gatewayInterface.h"
@@ -49,6 +50,7 @@
 #include "util/logging/DAS.h"
 #include "util/string/stringUtils.h"
 #include "util/threading/threadPriority.h"
+#include "webServerProcess/src/webService.h"
 
 #include "anki/cozmo/shared/factory/faultCodes.h"
 
@@ -59,6 +61,8 @@
 
 #include "aiComponent/beiConditions/conditions/conditionEyeContact.h"
 
+#include "platform/anki-trace/tracing.h"
+
 #include "opencv2/highgui/highgui.hpp"
 
 #define LOG_CHANNEL "VisionComponent"
@@ -100,6 +104,14 @@ namespace Vector {
   // This is dependent on how fast we can process an image
   CONSOLE_VAR(u32, kMaxExpectedTimeBetweenCapturedFrames_ms, "Vision.General", 500);
 
+  // Number of processed images over which per-stage latency and per-mode duration histograms are accumulated
+  // before being logged (and sent to webViz, if subscribed) and cleared. 0 disables.
+  CONSOLE_VAR(u32, kFrameTraceReportPeriod_frames, "Vision.General", 300);
+
+  // Whether to tell VisionSystem where known objects' markers should appear, so it can search just there between
+  // full sweeps
+  CONSOLE_VAR(bool, kPredictMarkerROIs, "Vision.MarkerDetection", true);
+
   void DebugEraseAllEnrolledFaces(ConsoleFunctionContextRef context)
   {
     LOG_INFO("VisionComponent.ConsoleFunc","DebugEraseAllEnrolledFaces function called");
@@ -455,6 +467,19 @@ namespace Vector {
     // Check and update any results from VisionSystem
     UpdateAllResults();
 
+    // Let whoever asked for images to be saved know they were written
+    {
+      std::vector<std::function<void()>> completedSaves;
+      {
+        std::lock_guard<std::mutex> lock(_completedSavesMutex);
+        std::swap(completedSaves, _completedSaves);
+      }
+      for(const auto& completedSave : completedSaves)
+      {
+        completedSave();
+      }
+    }
+
     UpdateCaptureFormatChange();
 
     // If we don't yet have an image to process, we need to capture one
@@ -498,6 +523,7 @@ namespace Vector {
           // we get an image
           _lastReceivedImageTimeStamp_ms = 0;
           _lastProcessedImageTimeStamp_ms = 0;
+          _lastReceivedImageId = 0;
           ReleaseImage(buffer);
           return;
         }
@@ -505,6 +531,21 @@ namespace Vector {
       }
       _lastReceivedImageTimeStamp_ms = buffer.GetTimestamp();
 
+      // The camera numbers every frame it captures, so a gap in IDs means frames arrived (and were replaced) while
+      // we were still busy with an earlier one. Feed that back to the schedule so it can shed load.
+      {
+        const u32 imageId = buffer.GetImageId();
+        const u32 numDroppedFrames = ((_lastReceivedImageId > 0) && (imageId > _lastReceivedImageId) ?
+                                      imageId - _lastReceivedImageId - 1 : 0);
+        _lastReceivedImageId = imageId;
+        for(u32 i=0; i<numDroppedFrames; ++i)
+        {
+          _droppedFrameStats.Update(true);
+        }
+        _droppedFrameStats.Update(false);
+        _robot->GetVisionScheduleMediator().ReportCapturedFrame(numDroppedFrames);
+      }
+
       // Try to get the corresponding historical state
       const bool imageOlderThanOldestState = (buffer.GetTimestamp() < _robot->GetStateHistory()->GetOldestTimeStamp());
       if(imageOlderThanOldestState)
@@ -532,6 +573,19 @@ namespace Vector {
         return;
       }
 
+      // Start this image's latency trace. The buffer timestamp comes from CameraService's clock, so use that to
+      // backdate the capture time onto the trace's clock.
+      {
+        VisionFrameTrace& frameTrace = _visionSystemInput.frameTrace;
+        frameTrace = VisionFrameTrace();
+        const s64 now_us = VisionFrameTrace::GetCurrentTime_us();
+        const TimeStamp_t cameraNow_ms = CameraService::getInstance()->GetTimeStamp();
+        const s64 sinceCapture_us = (cameraNow_ms > buffer.GetTimestamp() ?
+                                     1000 * static_cast<s64>(cameraNow_ms - buffer.GetTimestamp()) : 0);
+        frameTrace.Stamp(VisionFrameStage::Captured, now_us - sinceCapture_us);
+        frameTrace.Stamp(VisionFrameStage::Dequeued, now_us);
+      }
+
       const Result res = SetNextImage(buffer);
       if(res != RESULT_OK)
       {
@@ -589,6 +643,7 @@ namespace Vector {
                                     groundPlaneHomography,
                                     _robot->GetImuComponent().GetImuHistory());
 
+    PredictMarkerROIs(_visionSystemInput.poseData, _visionSystemInput.predictedMarkerROIs);
 
     // Experimental:
     //UpdateOverheadMap(image, _visionSystemInput.poseData);
@@ -732,6 +787,103 @@ namespace Vector {
 
   } // LookupGroundPlaneHomography()
 
+  void VisionComponent::PredictMarkerROIs(const VisionPoseData& poseData, std::vector<Rectangle<s32>>& rois) const
+  {
+    rois.clear();
+
+    if(!kPredictMarkerROIs || !_camera->IsCalibrated())
+    {
+      return;
+    }
+
+    const s32 nrows = _camera->GetCalibration()->GetNrows();
+    const s32 ncols = _camera->GetCalibration()->GetNcols();
+
+    struct Prediction
+    {
+      Rectangle<s32> rect;
+      bool isDockObject;
+      TimeStamp_t lastObservedTime;
+    };
+    std::vector<Prediction> predictions;
+
+    std::vector<const ObservableObject*> objects;
+    _robot->GetBlockWorld().FindLocatedMatchingObjects(BlockWorldFilter(), objects);
+    const ObjectID& dockObjectID = _robot->GetDockingComponent().GetDockObject();
+
+    for(const ObservableObject* object : objects)
+    {
+      if(nullptr == object || !object->HasValidPose())
+      {
+        continue;
+      }
+
+      for(const auto& marker : object->GetMarkers())
+      {
+        Pose3d markerPoseWrtCamera;
+        if(!marker.GetPose().GetWithRespectTo(poseData.cameraPose, markerPoseWrtCamera))
+        {
+          continue;
+        }
+
+        // Skip markers facing away from the camera (same face normal as KnownMarker::IsVisibleFrom)
+        const Quad3f corners = marker.Get3dCorners(markerPoseWrtCamera);
+        Vec3f topLine(corners[Quad::CornerName::TopRight]);
+        topLine -= corners[Quad::CornerName::TopLeft];
+        Vec3f sideLine(corners[Quad::CornerName::BottomLeft]);
+        sideLine -= corners[Quad::CornerName::TopLeft];
+        if(DotProduct(CrossProduct(sideLine, topLine), corners.ComputeCentroid()) >= 0.f)
+        {
+          continue;
+        }
+
+        f32 xmin = std::numeric_limits<f32>::max(), xmax = std::numeric_limits<f32>::lowest();
+        f32 ymin = std::numeric_limits<f32>::max(), ymax = std::numeric_limits<f32>::lowest();
+        bool allInFront = true;
+        for(const auto& corner : corners)
+        {
+          Point2f imgPoint;
+          if(!_camera->Project3dPoint(corner, imgPoint))
+          {
+            allInFront = false;
+            break;
+          }
+          xmin = std::min(xmin, imgPoint.x());
+          xmax = std::max(xmax, imgPoint.x());
+          ymin = std::min(ymin, imgPoint.y());
+          ymax = std::max(ymax, imgPoint.y());
+        }
+
+        // Markers that are only partly in view can't be detected anyway
+        if(!allInFront || xmin < 0.f || ymin < 0.f || xmax > (f32)ncols || ymax > (f32)nrows)
+        {
+          continue;
+        }
+
+        const s32 x = std::floor(xmin);
+        const s32 y = std::floor(ymin);
+        const Rectangle<s32> rect(x, y, (s32)std::ceil(xmax) - x, (s32)std::ceil(ymax) - y);
+        if(rect.Area() > 0)
+        {
+          predictions.push_back({rect, (object->GetID() == dockObjectID), object->GetLastObservedTime()});
+        }
+      }
+    }
+
+    std::stable_sort(predictions.begin(), predictions.end(), [](const Prediction& a, const Prediction& b) {
+      if(a.isDockObject != b.isDockObject) {
+        return a.isDockObject;
+      }
+      return a.lastObservedTime > b.lastObservedTime;
+    });
+
+    rois.reserve(predictions.size());
+    for(const auto& prediction : predictions)
+    {
+      rois.push_back(prediction.rect);
+    }
+  } // PredictMarkerROIs()
+
   void VisionComponent::UpdateVisionSystem(const VisionSystemInput& input)
   {
     ANKI_CPU_PROFILE("VC::UpdateVisionSystem");
@@ -860,6 +1012,63 @@ namespace Vector {
   } // VisualizeObservedMarkerIn3D()
 
 
+  void VisionComponent::ReportFrameTrace(const VisionFrameTrace& trace)
+  {
+    for(size_t i=0; i<VisionFrameTrace::kNumStages; ++i)
+    {
+      const s64 latency_us = trace.GetLatencyFromCapture_us(static_cast<VisionFrameStage>(i));
+      if(latency_us > 0)
+      {
+        tracepoint(anki_ust, vic_engine_vision_stage_latency, static_cast<int>(i), latency_us);
+      }
+    }
+
+    for(const auto& modeDuration : trace.modeDuration_us)
+    {
+      tracepoint(anki_ust, vic_engine_vision_mode_duration,
+                 static_cast<int>(modeDuration.first), modeDuration.second);
+    }
+
+    _robot->GetVisionScheduleMediator().ReportModeDurations(trace.modeDuration_us);
+
+    const s64 worldLatency_us = trace.GetLatencyFromCapture_us(VisionFrameStage::WorldUpdated);
+    if(worldLatency_us >= 0)
+    {
+      _lastCaptureToWorldLatency_ms = static_cast<f32>(worldLatency_us) * 0.001f;
+    }
+
+    if(0 == kFrameTraceReportPeriod_frames)
+    {
+      return;
+    }
+
+    _frameTraceStats.Add(trace);
+    if(_frameTraceStats.GetNumFrames() < kFrameTraceReportPeriod_frames)
+    {
+      return;
+    }
+
+    const Json::Value json = _frameTraceStats.GetJson();
+    const Json::Value& worldLatency = json["latencyFromCapture"][VisionFrameStageToString(VisionFrameStage::WorldUpdated)];
+    LOG_INFO("VisionComponent.ReportFrameTrace.CaptureToWorldLatency",
+             "NumFrames:%u Mean:%.1fms Min:%.1fms Max:%.1fms",
+             _frameTraceStats.GetNumFrames(),
+             worldLatency["mean_ms"].asFloat(), worldLatency["min_ms"].asFloat(), worldLatency["max_ms"].asFloat());
+
+    if(ANKI_DEV_CHEATS && (_context != nullptr))
+    {
+      static const std::string kWebVizModuleName = "visionlatency";
+      auto* webService = _context->GetWebService();
+      if((webService != nullptr) && webService->IsWebVizClientSubscribed(kWebVizModuleName))
+      {
+        webService->SendToWebViz(kWebVizModuleName, json);
+      }
+    }
+
+    _frameTraceStats.Clear();
+  }
+
+
   Result VisionComponent::UpdateAllResults()
   {
     ANKI_CPU_PROFILE("VC::UpdateAllResults");
@@ -872,6 +1081,8 @@ namespace Vector {
 
       while(true == _visionSystem->CheckMailbox(result))
       {
+        result.frameTrace.Stamp(VisionFrameStage::ResultReceived);
+
         if((_vizManager != nullptr) &&
            _vizManager->IsConnected())
         {
@@ -919,6 +1130,9 @@ namespace Vector {
         //  and should be done before sending RobotProcessedImage below!)
         tryAndReport(&VisionComponent::UpdatePets,                 {VisionMode::Pets});
 
+        result.frameTrace.Stamp(VisionFrameStage::WorldUpdated);
+        ReportFrameTrace(result.frameTrace);
+
         tryAndReport(&VisionComponent::UpdateMotionCentroid,       {VisionMode::Motion});
         tryAndReport(&VisionComponent::UpdateOverheadEdges,        {VisionMode::OverheadEdges});
         tryAndReport(&VisionComponent::UpdateComputedCalibration,  {VisionMode::Calibration});
@@ -929,7 +1143,6 @@ namespace Vector {
         tryAndReport(&VisionComponent::UpdateLaserPoints,          {VisionMode::Lasers});
         tryAndReport(&VisionComponent::UpdateSalientPoints,        {}); // Use empty set here to always call UpdateSalientPoints
         tryAndReport(&VisionComponent::UpdateVisualObstacles,      {VisionMode::Obstacles});
-        tryAndReport(&VisionComponent::UpdatePhotoManager,         {VisionMode::SaveImages});
         tryAndReport(&VisionComponent::UpdateDetectedIllumination, {VisionMode::Illumination});
 
         // Note: we always run this because it handles switching to the mirror mode debug screen
@@ -978,7 +1191,7 @@ namespace Vector {
   {
     Result lastResult = RESULT_OK;
 
-    std::list<Vision::ObservedMarker> observedMarkers;
+    std::vector<Vision::ObservedMarker> observedMarkers;
 
     if(!procResult.observedMarkers.empty())
     {
@@ -1021,6 +1234,8 @@ namespace Vector {
 
       Vision::Camera histCamera = _robot->GetHistoricalCamera(*histStatePtr, procResult.timestamp);
 
+      observedMarkers.reserve(procResult.observedMarkers.size());
+
       // Note: we deliberately make a copy of the vision markers in observedMarkers
       // as we loop over them here, because procResult is const but we want to modify
       // each marker to hook up its camera to pose history
@@ -1405,15 +1620,6 @@ namespace Vector {
     return RESULT_OK;
   }
 
-  Result VisionComponent::UpdatePhotoManager(const VisionProcessingResult& procResult)
-  {
-    if(_robot->GetPhotographyManager().IsWaitingForPhoto())
-    {
-      _robot->GetPhotographyManager().SetLastPhotoTimeStamp(procResult.timestamp);
-    }
-    return RESULT_OK;
-  }
-
   Result VisionComponent::UpdateDetectedIllumination(const VisionProcessingResult& procResult)
   {
     ExternalInterface::RobotObservedIllumination msg( procResult.illumination );
@@ -1549,7 +1755,20 @@ namespace Vector {
 
     ImageChunk m;
     const bool vizConnected = _robot->GetContext()->GetVizManager()->IsConnected();
-    if(!vizConnected && !_sendProtoImageChunks)
+
+    // Latest frame wins: while the gateway is behind (e.g. a slow phone), skip whole frames for the SDK rather
+    // than queueing them up, so the client gets the newest frame as soon as it catches up
+    IGatewayInterface* gatewayInterface = _robot->GetGatewayInterface();
+    bool sendProtoImageChunks = _sendProtoImageChunks;
+    if(sendProtoImageChunks && gatewayInterface->IsBackedUp())
+    {
+      sendProtoImageChunks = false;
+      ++_numSDKImagesSkipped;
+      LOG_PERIODIC_INFO(30, "VisionComponent.SendCompressedImage.SkippingSDKImage",
+                        "Gateway backed up, skipped %u images so far", _numSDKImagesSkipped);
+    }
+
+    if(!vizConnected && !sendProtoImageChunks)
     {
       return RESULT_OK;
     }
@@ -1605,7 +1824,7 @@ namespace Vector {
     }
 
     // Construct a proto ImageChunk
-    if(_sendProtoImageChunks)
+    if(sendProtoImageChunks)
     {
       imageChunk = new external_interface::ImageChunk();
       imageChunk->set_height((u32)img.GetNumRows());
@@ -1633,15 +1852,26 @@ namespace Vector {
       auto startIt = compressedBuffer.begin() + (compressedBuffer.size() - bytesRemainingToSend);
       auto endIt = startIt + chunkSize;
 
-      if(_sendProtoImageChunks)
+      if(sendProtoImageChunks)
       {
         imageChunk->set_chunk_id((u32)chunkId);
         data.assign(startIt, endIt);
         imageChunk->set_data(std::move(data));
 
         wrapper.set_allocated_image_chunk(imageChunk);
-        _robot->GetGatewayInterface()->Broadcast(wrapper);
+        gatewayInterface->Broadcast(wrapper);
         imageChunk = wrapper.release_image_chunk();
+
+        // The client can't assemble a frame missing chunks, so don't spend time on the rest of this one
+        if(gatewayInterface->IsBackedUp())
+        {
+          sendProtoImageChunks = false;
+          ++_numSDKImagesSkipped;
+          if(!vizConnected)
+          {
+            break;
+          }
+        }
       }
 
       if(vizConnected)
@@ -2251,16 +2481,10 @@ namespace Vector {
 
   bool VisionComponent::ReleaseImage(Vision::ImageBuffer& buffer)
   {
-    bool r = true;
-    if (buffer.HasValidData()) {
-      auto cameraService = CameraService::getInstance();
-      r = cameraService->CameraReleaseFrame(buffer.GetImageId());
-      if (r) {
-        buffer.Invalidate();
-      }
-    }
-    return r;
-
+    // Captured buffers own their camera frame (see CaptureImage), so this just drops our reference. The frame goes
+    // back to the camera once the VisionSystem's ImageCache is also done with it.
+    buffer.Invalidate();
+    return true;
   }
 
   bool VisionComponent::IsProcessingImages()
@@ -2307,7 +2531,7 @@ namespace Vector {
     if (!imuHistory.empty()) {
       newestStateHistoryTimeStamp = std::min(newestStateHistoryTimeStamp, (u32) imuHistory.back().timestamp);
     }
-    const bool gotImage = cameraService->CameraGetFrame(newestStateHistoryTimeStamp, buffer);
+    const bool gotImage = cameraService->CameraGetSharedFrame(newestStateHistoryTimeStamp, buffer);
     const EngineTimeStamp_t currTime_ms = BaseStationTimer::getInstance()->GetCurrentTimeStamp();
     if(gotImage)
     {
@@ -2593,7 +2817,20 @@ namespace Vector {
         fullPath = Util::FileUtils::FullFilePath({cachePath, "images"});
       }
 
-      _visionSystem->SetSaveParameters(params);
+      if(params.onSaveComplete)
+      {
+        // The callback would be called on the ImageSaver's encoder thread, so hand it over to the main thread
+        ImageSaverParams mainThreadParams(params);
+        mainThreadParams.onSaveComplete = [this, callback = params.onSaveComplete](const ImageSaverResult& result) {
+          std::lock_guard<std::mutex> lock(_completedSavesMutex);
+          _completedSaves.emplace_back([callback, result]() { callback(result); });
+        };
+        _visionSystem->SetSaveParameters(mainThreadParams);
+      }
+      else
+      {
+        _visionSystem->SetSaveParameters(params);
+      }
 
       if(params.mode != ImageSendMode::Off)
       {
@@ -15,6 +15,7 @@
 #define ANKI_VECTOR_BASESTATION_VISION_PROC_THREAD_H
 
 #include "coretech/vision/engine/cameraCalibration.h"
+#include "coretech/vision/engine/droppedFrameStats.h"
 #include "coretech/common/engine/robotTimeStamp.h"
 #include "coretech/vision/engine/visionMarker.h"
 #include "coretech/vision/engine/faceTracker.h"
@@ -33,6 +34,7 @@
 #include "util/helpers/noncopyable.h"
 #include "util/signals/simpleSignal.hpp"
 
+#include <functional>
 #include <thread>
 #include <mutex>
 #include <list>
@@ -156,7 +158,6 @@ struct DockingErrorSignal;
     Result UpdateCameraParams(const VisionProcessingResult& procResult);
     Result UpdateVisualObstacles(const VisionProcessingResult& procResult);
     Result UpdateSalientPoints(const VisionProcessingResult& result);
-    Result UpdatePhotoManager(const VisionProcessingResult& procResult);
     Result UpdateDetectedIllumination(const VisionProcessingResult& procResult);
     Result UpdateMirrorMode(const VisionProcessingResult& procResult);
 
@@ -171,6 +172,9 @@ struct DockingErrorSignal;
     
     TimeStamp_t GetProcessingPeriod_ms() const;
     TimeStamp_t GetFramePeriod_ms() const;
+
+    // Time from capture of the most recently processed image until BlockWorld/FaceWorld were updated with it
+    f32 GetLastCaptureToWorldLatency_ms() const { return _lastCaptureToWorldLatency_ms; }
     
     Result SendCompressedImage(const Vision::CompressedImage& img, const std::string& identifier);
     
@@ -294,10 +298,14 @@ struct DockingErrorSignal;
     // Returns true if image was captured, false if not
     bool CaptureImage(Vision::ImageBuffer& buffer);
 
-    // Releases captured image back to CameraService
+    // Drops our reference to a captured image. Its frame goes back to CameraService once nothing else holds it.
     bool ReleaseImage(Vision::ImageBuffer& buffer);
     
     bool LookupGroundPlaneHomography(f32 atHeadAngle, Matrix_3x3f& H) const;
+    
+    // Projects the markers of located objects into the image seen from poseData's camera pose, returning their
+    // bounding boxes (in calibration resolution) with the dock object's first, then the most recently observed
+    void PredictMarkerROIs(const VisionPoseData& poseData, std::vector<Rectangle<s32>>& rois) const;
 
     bool HasStartedCapturingImages() const { return _hasStartedCapturingImages; }
 
@@ -363,6 +371,10 @@ struct DockingErrorSignal;
 
     std::mutex _lock;
     
+    // ImageSaver completion callbacks, queued from its encoder thread and run on the main thread in UpdateDependent
+    std::mutex _completedSavesMutex;
+    std::vector<std::function<void()>> _completedSaves;
+    
     // Input for VisionSystem
     // While _visionSystemInput.locked is true this is being processed by VisionSystem
     // and can not be modified by VisionComponent
@@ -382,9 +394,14 @@ struct DockingErrorSignal;
     f32 _markerDetectionHeadTurnSpeedThreshold_radPerSec = kDefaultHeadSpeedThresh;
     
     RobotTimeStamp_t _lastReceivedImageTimeStamp_ms = 0;
+    u32 _lastReceivedImageId = 0;
+    Vision::DroppedFrameStats _droppedFrameStats;
     RobotTimeStamp_t _lastProcessedImageTimeStamp_ms = 0;
     TimeStamp_t _processingPeriod_ms = 0;  // How fast we are processing frames
     TimeStamp_t _framePeriod_ms = 0;       // How fast we are receiving frames
+
+    VisionFrameTraceStats _frameTraceStats;
+    f32 _lastCaptureToWorldLatency_ms = 0.f;
     
     Vision::ImageQuality _lastImageQuality = Vision::ImageQuality::Good;
     Vision::ImageQuality _lastBroadcastImageQuality = Vision::ImageQuality::Unchecked;
@@ -436,6 +453,9 @@ struct DockingErrorSignal;
 
     bool _sendProtoImageChunks = false;
 
+    // SDK camera frames dropped because the gateway was not keeping up
+    u32 _numSDKImagesSkipped = 0;
+
     // Time at which we attempted to restart the camera as we had not received a valid image for
     // some amount of time
     EngineTimeStamp_t _restartingCameraTime_ms = 0;
@@ -477,6 +497,10 @@ struct DockingErrorSignal;
     // Send images from result's displayImg and debug image lists to Viz/SDK
     void SendImages(VisionProcessingResult& result);
 
+    // Emits tracepoints for and accumulates the stage latencies and mode durations of one processed image,
+    // periodically logging and sending them to webViz
+    void ReportFrameTrace(const VisionFrameTrace& trace);
+
     void SetLiftCrossBar();
 
     Vision::ImageEncoding GetCurrentImageFormat() const;
@@ -20,6 +20,7 @@
 #include "engine/robotDataLoader.h"
 #include "engine/vision/visionModeSet.h"
 #include "engine/vision/visionModesHelpers.h"
+#include "util/console/consoleInterface.h"
 #include "webServerProcess/src/webService.h"
 
 #define LOG_CHANNEL "VisionScheduleMediator"
@@ -39,6 +40,23 @@ const uint8_t kMaxRelCost = 50;
 
 const std::string kWebVizModuleName = "visionschedulemediator";
 
+// Low priority modes which may be stretched under load, unless overridden by "stretchable" in the config
+const std::set<VisionMode> kDefaultStretchableModes = {
+  VisionMode::Illumination,
+  VisionMode::BrightColors,
+  VisionMode::OverheadMap,
+};
+
+// Load adaptation: after each window of captured frames, stretch one mode if more than the upper fraction of
+// camera frames were dropped, or restore one if fewer than the lower fraction were
+CONSOLE_VAR(bool,            kVSM_AdaptToLoad,                "Vision.ScheduleMediator", true);
+CONSOLE_VAR_RANGED(u32,      kVSM_LoadWindow_frames,          "Vision.ScheduleMediator", 30, 5, 300);
+CONSOLE_VAR_RANGED(f32,      kVSM_StretchAboveDropFraction,   "Vision.ScheduleMediator", 0.25f, 0.f, 1.f);
+CONSOLE_VAR_RANGED(f32,      kVSM_RestoreBelowDropFraction,   "Vision.ScheduleMediator", 0.05f, 0.f, 1.f);
+
+// Weight of each new measurement in a mode's running average cost
+const float kModeCostFilterCoeff = 0.1f;
+
 VisionScheduleMediator::VisionScheduleMediator()
 : IDependencyManagedComponent<RobotComponentID>(this, RobotComponentID::VisionScheduleMediator)
 {
@@ -89,6 +107,10 @@ void VisionScheduleMediator::Init(const Json::Value& config)
                ((newModeData.standard & (newModeData.standard  - 1)) == 0),
                "VisionScheduleMediator.NonPOTVisionModeFrequency");
 
+    newModeData.stretchable = (kDefaultStretchableModes.count(visionMode) > 0);
+    GetValueOptional(modeSettings, "stretchable", newModeData.stretchable);
+    newModeData.usesNeuralNet = (GetVisionModesUsingNeuralNets().count(visionMode) > 0);
+
     _modeDataMap.insert(std::pair<VisionMode, VisionModeData>(visionMode, newModeData));
 
     _schedule = AllVisionModesSchedule({}, true);
@@ -102,8 +124,12 @@ void VisionScheduleMediator::Init(const Json::Value& config)
 
 void VisionScheduleMediator::UpdateDependent(const RobotCompMap& dependentComps)
 {
+  if(AdaptToLoad()){
+    _stretchIsDirty = true;
+  }
+
   // Update the VisionSchedule, if necessary
-  if(_subscriptionRecordIsDirty){
+  if(_subscriptionRecordIsDirty || _stretchIsDirty){
     UpdateVisionSchedule(dependentComps.GetComponent<VisionComponent>(),
                          dependentComps.GetComponent<ContextWrapper>().context);
   }
@@ -283,8 +309,8 @@ void VisionScheduleMediator::ReleaseAllVisionModeSubscriptions(IVisionModeSubscr
 
 void VisionScheduleMediator::UpdateVisionSchedule(VisionComponent& visionComponent, const CozmoContext* context)
 {
-  // Construct a new schedule
-  bool scheduleDirty = false;
+  // Construct a new schedule, which is also needed if any mode has been stretched or restored
+  bool scheduleDirty = _stretchIsDirty;
   bool activeModesDirty = false;
 
   for(auto& modeDataPair : _modeDataMap)
@@ -300,6 +326,11 @@ void VisionScheduleMediator::UpdateVisionSchedule(VisionComponent& visionCompone
         modeData.enabled = !modeData.requestMap.empty();
         modeEnabledChanged = true;
         activeModesDirty = true;
+
+        // Start over at the requested rate the next time the mode is enabled
+        if(!modeData.enabled){
+          modeData.stretch = 1;
+        }
       }
 
       // Compute the update period for active modes and add to the schedule
@@ -344,6 +375,7 @@ void VisionScheduleMediator::UpdateVisionSchedule(VisionComponent& visionCompone
   }
   
   _subscriptionRecordIsDirty = false;
+  _stretchIsDirty = false;
 }
   
 void VisionScheduleMediator::AddSingleShotModesToSet(VisionModeSet& modeSet, bool andReset)
@@ -373,7 +405,7 @@ const AllVisionModesSchedule::ModeScheduleList VisionScheduleMediator::GenerateB
     }
 
     const VisionMode mode = modeData.first;
-    const uint8_t updatePeriod = modeData.second.updatePeriod;
+    const uint8_t updatePeriod = GetEffectiveUpdatePeriod(modeData.second);
     const uint8_t relativeCost = modeData.second.relativeCost;
 
     // Keep track of our longest requested UpdatePeriod to search the full schedule minimally
@@ -431,6 +463,160 @@ bool VisionScheduleMediator::UpdateModePeriodIfNecessary(VisionModeData& modeDat
   return false;
 }
 
+uint8_t VisionScheduleMediator::GetMaxStretchedUpdatePeriod(const VisionModeData& modeData) const
+{
+  // Never stretch past the slowest rate a subscriber could have requested (or past what the schedule can hold),
+  // but never shorten a period which was already requested to be longer than that
+  return std::max(modeData.updatePeriod, std::min(modeData.low, kMaxUpdatePeriod));
+}
+
+uint8_t VisionScheduleMediator::GetStretch(const VisionModeData& modeData) const
+{
+  uint8_t stretch = modeData.stretch;
+  if(modeData.stretchable){
+    stretch = std::max(stretch, _thermalStretch);
+  }
+  if(modeData.usesNeuralNet){
+    stretch = std::max(stretch, _thermalNeuralNetStretch);
+  }
+  return stretch;
+}
+
+uint8_t VisionScheduleMediator::GetEffectiveUpdatePeriod(const VisionModeData& modeData) const
+{
+  const int stretchedPeriod = modeData.updatePeriod * GetStretch(modeData);
+  return static_cast<uint8_t>(std::min<int>(stretchedPeriod, GetMaxStretchedUpdatePeriod(modeData)));
+}
+
+int VisionScheduleMediator::GetEffectiveUpdatePeriod(VisionMode mode) const
+{
+  auto modeDataIterator = _modeDataMap.find(mode);
+  if((modeDataIterator == _modeDataMap.end()) || !modeDataIterator->second.enabled){
+    return 0;
+  }
+  return GetEffectiveUpdatePeriod(modeDataIterator->second);
+}
+
+void VisionScheduleMediator::SetThermalStretch(uint8_t stretchableModes, uint8_t neuralNetModes)
+{
+  // Schedules must stay power of two
+  DEV_ASSERT((stretchableModes > 0) && ((stretchableModes & (stretchableModes - 1)) == 0) &&
+             (neuralNetModes > 0) && ((neuralNetModes & (neuralNetModes - 1)) == 0),
+             "VisionScheduleMediator.SetThermalStretch.NonPOTStretch");
+  if((stretchableModes == _thermalStretch) && (neuralNetModes == _thermalNeuralNetStretch)){
+    return;
+  }
+
+  LOG_INFO("VisionScheduleMediator.SetThermalStretch",
+           "Stretchable modes x%u (was x%u), neural net modes x%u (was x%u)",
+           stretchableModes, _thermalStretch, neuralNetModes, _thermalNeuralNetStretch);
+  _thermalStretch = stretchableModes;
+  _thermalNeuralNetStretch = neuralNetModes;
+  _stretchIsDirty = true;
+}
+
+void VisionScheduleMediator::ReportCapturedFrame(u32 numDroppedFrames)
+{
+  ++_numFramesInLoadWindow;
+  _numDroppedInLoadWindow += numDroppedFrames;
+}
+
+void VisionScheduleMediator::ReportModeDurations(const std::vector<std::pair<VisionMode, s64>>& modeDuration_us)
+{
+  for(const auto& modeDuration : modeDuration_us)
+  {
+    auto modeDataIterator = _modeDataMap.find(modeDuration.first);
+    if(modeDataIterator != _modeDataMap.end())
+    {
+      float& avgCost_ms = modeDataIterator->second.avgCost_ms;
+      const float cost_ms = static_cast<float>(modeDuration.second) * 0.001f;
+      avgCost_ms = (avgCost_ms > 0.f ?
+                    (1.f - kModeCostFilterCoeff) * avgCost_ms + kModeCostFilterCoeff * cost_ms :
+                    cost_ms);
+    }
+  }
+}
+
+bool VisionScheduleMediator::AdaptToLoad()
+{
+  if(_numFramesInLoadWindow < kVSM_LoadWindow_frames){
+    return false;
+  }
+
+  const u32 numCameraFrames = _numFramesInLoadWindow + _numDroppedInLoadWindow;
+  _lastDropFraction = static_cast<f32>(_numDroppedInLoadWindow) / static_cast<f32>(numCameraFrames);
+  _numFramesInLoadWindow = 0;
+  _numDroppedInLoadWindow = 0;
+
+  if(!kVSM_AdaptToLoad){
+    // Put everything back at the requested rates if adaptation gets turned off
+    bool anyRestored = false;
+    for(auto& modeDataPair : _modeDataMap){
+      if(modeDataPair.second.stretch > 1){
+        modeDataPair.second.stretch = 1;
+        anyRestored = true;
+      }
+    }
+    return anyRestored;
+  }
+
+  const bool shouldStretch = (_lastDropFraction > kVSM_StretchAboveDropFraction);
+  const bool shouldRestore = (_lastDropFraction < kVSM_RestoreBelowDropFraction);
+  if(!shouldStretch && !shouldRestore){
+    return false;
+  }
+
+  // Stretch the mode which costs the most per frame, since that sheds the most load, and restore the one which
+  // costs the least, since that adds the least back. Fall back on relative cost for modes not yet measured.
+  VisionMode      chosenMode = VisionMode::Count;
+  VisionModeData* chosenData = nullptr;
+  float           chosenCostPerFrame = 0.f;
+  for(auto& modeDataPair : _modeDataMap){
+    VisionModeData& modeData = modeDataPair.second;
+    if(!modeData.enabled || !modeData.stretchable){
+      continue;
+    }
+
+    const uint8_t effectivePeriod = GetEffectiveUpdatePeriod(modeData);
+    const bool canChange = (shouldStretch ?
+                            (effectivePeriod < GetMaxStretchedUpdatePeriod(modeData)) :
+                            (modeData.stretch > 1));
+    if(!canChange){
+      continue;
+    }
+
+    const float cost = (modeData.avgCost_ms > 0.f ? modeData.avgCost_ms : 0.001f * modeData.relativeCost);
+    const float costPerFrame = cost / static_cast<float>(effectivePeriod);
+    const bool isBetter = (nullptr == chosenData) ||
+                          (shouldStretch ? (costPerFrame > chosenCostPerFrame) : (costPerFrame < chosenCostPerFrame));
+    if(isBetter){
+      chosenMode = modeDataPair.first;
+      chosenData = &modeData;
+      chosenCostPerFrame = costPerFrame;
+    }
+  }
+
+  if(nullptr == chosenData){
+    return false;
+  }
+
+  const uint8_t oldPeriod = GetEffectiveUpdatePeriod(*chosenData);
+  if(shouldStretch){
+    // Start from any thermal stretch, so that every step actually slows the mode down
+    chosenData->stretch = GetStretch(*chosenData) * 2;
+  } else {
+    chosenData->stretch /= 2;
+  }
+  const uint8_t newPeriod = GetEffectiveUpdatePeriod(*chosenData);
+
+  LOG_INFO("VisionScheduleMediator.AdaptToLoad.ChangedModePeriod",
+           "%s %s from every %u to every %u frame(s). DropFraction:%.2f AvgCost:%.1fms",
+           (shouldStretch ? "Stretching" : "Restoring"), EnumToString(chosenMode),
+           oldPeriod, newPeriod, _lastDropFraction, chosenData->avgCost_ms);
+
+  return true;
+}
+
 int VisionScheduleMediator::GetUpdatePeriodFromEnum(const VisionMode& mode, 
                                                     const EVisionUpdateFrequency& frequencySetting) const
 {
@@ -488,6 +674,8 @@ void VisionScheduleMediator::SendDebugVizMessages(const CozmoContext* context)
       Json::Value modeSchedule;
       modeSchedule["visionMode"] = EnumToString(modeDataPair.first);
       modeSchedule["updatePeriod"] = modeDataPair.second.updatePeriod;
+      modeSchedule["effectiveUpdatePeriod"] = GetEffectiveUpdatePeriod(modeDataPair.second);
+      modeSchedule["avgCost_ms"] = modeDataPair.second.avgCost_ms;
       modeSchedule["offset"] = modeDataPair.second.offset;
       fullSchedule.append(modeSchedule);
     }
@@ -504,6 +692,9 @@ void VisionScheduleMediator::SendDebugVizMessages(const CozmoContext* context)
     const auto* webService = context->GetWebService();
     if( webService != nullptr ){
       webVizData["numActiveModes"] = numActiveModes; 
+      webVizData["dropFraction"] = _lastDropFraction;
+      webVizData["thermalStretch"] = _thermalStretch;
+      webVizData["thermalNeuralNetStretch"] = _thermalNeuralNetStretch;
       webService->SendToWebViz( kWebVizModuleName, webVizData );
     }
   }
@@ -91,6 +91,26 @@ public:
   void ReleaseAllVisionModeSubscriptions(IVisionModeSubscriber* subscriber);
 
   const AllVisionModesSchedule& GetSchedule() const { return _schedule; }
+
+  // The period (in frames) at which a mode is actually being run, which may be longer than its subscribers requested
+  // if it has been stretched to shed load. Returns 0 for modes which are not enabled.
+  int GetEffectiveUpdatePeriod(VisionMode mode) const;
+
+  // Load feedback from the VisionComponent, used to stretch low priority ("stretchable") modes while the vision
+  // thread is falling behind the camera, and to restore them once it catches up. Stretched modes are never run less
+  // often than their "low" frequency, which is the slowest rate any subscriber can ask for.
+  //  ReportCapturedFrame: call once per captured image, with the number of camera frames skipped since the last one
+  //  ReportModeDurations: call once per processed image, with how long each mode took on it
+  void ReportCapturedFrame(u32 numDroppedFrames);
+  void ReportModeDurations(const std::vector<std::pair<VisionMode, s64>>& modeDuration_us);
+
+  // Fraction of camera frames dropped over the last full window of captured frames
+  f32 GetLastDropFraction() const { return _lastDropFraction; }
+
+  // Minimum stretch (power of two) for stretchable modes and for modes running a neural net, set by the
+  // PowerStateManager to cut vision work while the robot is hot. Applies on top of the load adaptation and is
+  // bounded by the same "low" frequency cap.
+  void SetThermalStretch(uint8_t stretchableModes, uint8_t neuralNetModes);
   
   // If andReset=true, also counts the single shot modes as "processed" so they won't be returned anymore after this
   // VisionComponent (the actual user of the schedule) is expected to be the only caller to use andReset=true
@@ -121,6 +141,10 @@ private:
     bool    dirty = false;
     uint8_t updatePeriod = 0;
     uint8_t offset = 0;
+    bool    stretchable = false;  // may be run less often than requested when under load
+    uint8_t stretch = 1;          // power-of-two multiplier on updatePeriod, while shedding load
+    bool    usesNeuralNet = false;
+    float   avgCost_ms = 0.f;     // running average of measured processing time, when it runs
     std::unordered_map<IVisionModeSubscriber*, int> requestMap;
     using Record = std::pair<IVisionModeSubscriber*, int>;
     static bool CompareRecords(Record i, Record j) { return i.second < j.second; }
@@ -140,6 +164,15 @@ private:
   // Returns true if the update period for this mode changed as a result of subscription changes
   bool UpdateModePeriodIfNecessary(VisionModeData& mode) const;
 
+  // updatePeriod with any stretch applied, capped at GetMaxStretchedUpdatePeriod
+  uint8_t GetEffectiveUpdatePeriod(const VisionModeData& modeData) const;
+  uint8_t GetStretch(const VisionModeData& modeData) const;
+  uint8_t GetMaxStretchedUpdatePeriod(const VisionModeData& modeData) const;
+
+  // Once a full window of frames has been reported, stretches or restores one stretchable mode depending on the
+  // fraction of camera frames dropped in that window. Returns true if a mode's effective period changed.
+  bool AdaptToLoad();
+
   // Helper method to convert between enums and settings in (frames between updates)
   int GetUpdatePeriodFromEnum(const VisionMode& mode, const EVisionUpdateFrequency& frequencySetting) const;
 
@@ -152,6 +185,15 @@ private:
   bool _subscriptionRecordIsDirty = false;
   uint8_t _framesSinceSendingDebugViz = 0;
   std::unordered_set<VisionMode> _singleShotModes;
+
+  // Load adaptation state, for the current window of captured frames
+  u32  _numFramesInLoadWindow = 0;
+  u32  _numDroppedInLoadWindow = 0;
+  f32  _lastDropFraction = 0.f;
+  bool _stretchIsDirty = false;
+
+  uint8_t _thermalStretch = 1;
+  uint8_t _thermalNeuralNetStretch = 1;
   
   // Final fully balanced schedule that VisionComponent will use
   AllVisionModesSchedule _schedule;
@@ -65,6 +65,9 @@ public:
   bool SendMessage(const Comms::MsgPacket& msgPacket) { return SendMessageInternal(msgPacket); }
   bool RecvMessage(std::vector<uint8_t>& outBuffer)   { return RecvMessageInternal(outBuffer); }
 
+  // True if the last SendMessage failed only because the peer is not reading fast enough to keep up
+  virtual bool IsSendBlocked() const { return false; }
+
   virtual bool ConnectToDeviceByID(DeviceId deviceId) = 0;
   virtual bool DisconnectDeviceByID(DeviceId deviceId) = 0;
   virtual bool DisconnectAllDevices() = 0;
@@ -11,6 +11,7 @@
  **/
 
 #include "engine/cozmoAPI/comms/localUdpSocketComms.h"
+#include "coretech/messaging/shared/LocalUdpFrame.h"
 #include "coretech/messaging/shared/LocalUdpServer.h"
 #include "engine/utils/parsingConstants/parsingConstants.h"
 #include "coretech/messaging/engine/IComms.h"
@@ -19,6 +20,8 @@
 #include "util/helpers/templateHelpers.h"
 #include "util/logging/logging.h"
 
+#include <errno.h>
+
 namespace Anki {
 namespace Vector {
 
@@ -113,7 +116,12 @@ bool LocalUdpSocketComms::SendMessageInternal(const Comms::MsgPacket& msgPacket)
   ANKI_CPU_PROFILE("LocalUdpSocketComms::SendMessage");
 
   if (IsConnected()) {
-    const ssize_t res = _udpServer->Send((const char*)&msgPacket.dataLen, sizeof(msgPacket.dataLen) + msgPacket.dataLen);
+    const ssize_t res = _udpServer->SendFrame(msgPacket.data, msgPacket.dataLen);
+    _isSendBlocked = (res < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK) || (errno == ENOBUFS));
+    if (_isSendBlocked) {
+      // The peer is still there, just behind. Drop this message rather than the connection.
+      return false;
+    }
     if (res < 0) {
       LOG_WARNING("LocalUdpSocketComms.SendMessageInternal.FailedSend", "Failed to send message from %d to %d",
         msgPacket.sourceId, msgPacket.destId);
@@ -126,15 +134,16 @@ bool LocalUdpSocketComms::SendMessageInternal(const Comms::MsgPacket& msgPacket)
 }
 
 bool LocalUdpSocketComms::RecvMessageInternal(std::vector<uint8_t>& outBuffer) {
-  // Reserve memory
-  outBuffer.clear();
-  outBuffer.reserve(MAX_PACKET_BUFFER_SIZE);
+  // Read straight into the caller's buffer. Callers keep it between reads, so once it
+  // has grown this doesn't allocate.
+  outBuffer.resize(Anki::Messaging::kLocalUdpMaxFrameSize);
 
   // Read available datagram
-  const ssize_t dataLen = _udpServer->Recv((char*)outBuffer.data(), MAX_PACKET_BUFFER_SIZE);
+  const ssize_t dataLen = _udpServer->Recv((char*)outBuffer.data(), outBuffer.size());
 
   if (dataLen == 0) {
     // No data to receive
+    outBuffer.clear();
     return false;
   }
 
@@ -143,15 +152,22 @@ bool LocalUdpSocketComms::RecvMessageInternal(std::vector<uint8_t>& outBuffer) {
     PRINT_NAMED_WARNING("LocalUdpSocketComms", "Shutting down server. Received dataLen < 0");
     _udpServer->Disconnect();
     _udpServer->StopListening();
+    outBuffer.clear();
     return false;
   }
 
-  // Remove header from data
-  uint16_t msgSize;
-  memcpy(&msgSize, outBuffer.data(), kMessageHeaderSize);
-
-  const uint8_t* sourceBuffer = outBuffer.data() + sizeof(kMessageHeaderSize);
-  outBuffer = { sourceBuffer, sourceBuffer + msgSize };
+  // Remove header from data, in place
+  const uint8_t* payload = nullptr;
+  size_t payloadSize = 0;
+  if (!Anki::Messaging::GetLocalUdpFramePayload(outBuffer.data(), dataLen, payload, payloadSize)) {
+    LOG_WARNING("LocalUdpSocketComms.RecvMessageInternal.BadFrame", "Dropping %zd byte datagram shorter than its size",
+                dataLen);
+    payloadSize = 0;
+  }
+  else {
+    memmove(outBuffer.data(), payload, payloadSize);
+  }
+  outBuffer.resize(payloadSize);
 
   return true;
 }
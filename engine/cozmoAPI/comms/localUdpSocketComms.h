@@ -39,6 +39,8 @@ public:
 
   virtual uint32_t GetNumConnectedDevices() const override;
 
+  virtual bool IsSendBlocked() const override { return _isSendBlocked; }
+
 protected:
   virtual void UpdateInternal() override;
 
@@ -55,11 +57,10 @@ private:
 
   // ============================== Private Member Vars ==============================
 
-  const uint32_t        MAX_PACKET_BUFFER_SIZE = 2048;
-  const uint16_t        kMessageHeaderSize = 2;
   std::unique_ptr<LocalUdpServer>       _udpServer;
   DeviceId              _connectedId;
   bool                  _hasClient;
+  bool                  _isSendBlocked = false;
   std::string           _socket;
 };
 
@@ -26,7 +26,9 @@
 
 #include "proto/external_interface/shared.pb.h"
 
+#include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
+#include "util/messageProfiler/messageProfiler.h"
 
 #ifdef SIMULATOR
 #include "osState/osState.h"
@@ -35,6 +37,35 @@
 namespace Anki {
 namespace Vector {
 
+// Robot state is generated every tick, but SDK clients rarely need it that often
+CONSOLE_VAR(float, kGatewayRobotStatePeriod_s, "GatewayComms", 0.1f);
+
+// How long after a send blocks to keep reporting the gateway as backed up
+CONSOLE_VAR(float, kGatewayBackedUpHoldoff_s, "GatewayComms", 0.2f);
+
+namespace {
+  // GatewayWrapper tags are oneof field numbers; any above this are profiled together as "other"
+  constexpr int kMaxProfiledGatewayTags = 1024;
+
+  Util::MessageProfiler& GetEngineToGatewayProfiler()
+  {
+    static Util::MessageProfiler sProfiler("ProtoMessageHandler::EngineToGateway", nullptr, kMaxProfiledGatewayTags);
+    return sProfiler;
+  }
+
+  Util::MessageProfiler& GetGatewayToEngineProfiler()
+  {
+    static Util::MessageProfiler sProfiler("ProtoMessageHandler::GatewayToEngine", nullptr, kMaxProfiledGatewayTags);
+    return sProfiler;
+  }
+
+  int64_t MicrosecondsSince(const std::chrono::steady_clock::time_point& start)
+  {
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count();
+  }
+}
+
 
 ProtoMessageHandler::ProtoMessageHandler()
   : _socketComms(new LocalUdpSocketComms(true, ENGINE_GATEWAY_PROTO_SERVER_PATH))
@@ -62,6 +93,8 @@ Result ProtoMessageHandler::Init(CozmoContext* context, const Json::Value& confi
 
   _socketComms->ConnectToDeviceByID(1);
 
+  SetStreamPeriod(GatewayCoalescedStream::RobotState, kGatewayRobotStatePeriod_s);
+
   _isInitialized = true;
   _context = context;
 
@@ -87,17 +120,39 @@ void ProtoMessageHandler::DeliverToExternal(const external_interface::GatewayWra
   ++_messageCountOutgoing;
 
   Comms::MsgPacket p;
+  const auto serializeStart = std::chrono::steady_clock::now();
   message.SerializeToArray(p.data, Comms::MsgPacket::MAX_SIZE);
 
   p.dataLen = message.ByteSizeLong();
   p.destId = 1;
+  GetEngineToGatewayProfiler().Update((int)message.GetTag(), p.dataLen, MicrosecondsSince(serializeStart));
 
   if (_socketComms)
   {
-    _socketComms->SendMessage(p);
+    const bool sent = _socketComms->SendMessage(p);
+    if (!sent && _socketComms->IsSendBlocked())
+    {
+      if (!IsBackedUp())
+      {
+        LOG_INFO("ProtoMessageHandler.DeliverToExternal.BackedUp",
+                 "Gateway is not keeping up, dropping messages (%u dropped so far)", _numBlockedSends);
+      }
+      ++_numBlockedSends;
+      _lastBlockedSendTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+    }
   }
 }
 
+bool ProtoMessageHandler::IsBackedUp() const
+{
+  if (_lastBlockedSendTime_s < 0.0)
+  {
+    return false;
+  }
+  const double currTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+  return (currTime_s - _lastBlockedSendTime_s) < kGatewayBackedUpHoldoff_s;
+}
+
 Result ProtoMessageHandler::ProcessMessageBytes(const uint8_t* const packetBytes, const size_t packetSize, bool isSingleMessage)
 {
   ANKI_CPU_PROFILE("ProtoMH::ProcessMessageBytes");
@@ -110,6 +165,7 @@ Result ProtoMessageHandler::ProcessMessageBytes(const uint8_t* const packetBytes
 
   if (packetSize > 0)
   {
+    const auto parseStart = std::chrono::steady_clock::now();
     const bool success = message.ParseFromArray(packetBytes, static_cast<int>(packetSize));
     if (isSingleMessage && !success)
     {
@@ -118,6 +174,11 @@ Result ProtoMessageHandler::ProcessMessageBytes(const uint8_t* const packetBytes
       return RESULT_FAIL;
     }
 
+    const int tag = (int)message.GetTag();
+    Util::MessageProfiler& profiler = GetGatewayToEngineProfiler();
+    profiler.Update(tag, packetSize, MicrosecondsSince(parseStart));
+    Util::MessageProfiler::ScopedHandlerTimer handlerTimer(profiler, tag);
+
     // Is there a potential, in adding the redirect and not returning (on success), for these messages
     // to arrive at their destination twice?
     (void) ProtoCladInterpreter::Redirect(message, _context);
@@ -156,6 +217,67 @@ void ProtoMessageHandler::Broadcast(external_interface::GatewayWrapper&& message
 } // Broadcast(MessageGameToEngine &&)
 
 
+bool ProtoMessageHandler::IsStreamDue(GatewayCoalescedStream stream) const
+{
+  const CoalescedStreamState& state = _coalescedStreams[(size_t)stream];
+  if (state.period_s < 0.f) {
+    return false;
+  }
+  if (!state.hasSent) {
+    return true;
+  }
+  const double currTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+  return (currTime_s - state.lastSendTime_s) >= state.period_s;
+}
+
+
+void ProtoMessageHandler::BroadcastCoalesced(GatewayCoalescedStream stream, external_interface::GatewayWrapper&& message)
+{
+  ANKI_CPU_PROFILE("ProtoMH::BroadcastCoalesced");
+
+  CoalescedStreamState& state = _coalescedStreams[(size_t)stream];
+  if (state.period_s < 0.f) {
+    return;
+  }
+
+  if (IsStreamDue(stream)) {
+    state.hasPending = false;
+    state.hasSent = true;
+    state.lastSendTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+    Broadcast(std::move(message));
+    return;
+  }
+
+  // Newest value wins
+  state.pending = std::move(message);
+  state.hasPending = true;
+}
+
+
+void ProtoMessageHandler::SetStreamPeriod(GatewayCoalescedStream stream, float period_s)
+{
+  CoalescedStreamState& state = _coalescedStreams[(size_t)stream];
+  state.period_s = period_s;
+  if (period_s < 0.f) {
+    state.hasPending = false;
+    state.pending.Clear();
+  }
+}
+
+
+void ProtoMessageHandler::SendDueCoalescedMessages()
+{
+  for (size_t i=0; i<_coalescedStreams.size(); ++i) {
+    CoalescedStreamState& state = _coalescedStreams[i];
+    const auto stream = (GatewayCoalescedStream)i;
+    if (state.hasPending && IsStreamDue(stream)) {
+      state.hasPending = false;
+      BroadcastCoalesced(stream, std::move(state.pending));
+    }
+  }
+}
+
+
 // Provides a way to subscribe to message types using the AnkiEventMgrs
 Signal::SmartHandle ProtoMessageHandler::Subscribe(const external_interface::GatewayWrapperTag& tagType,
                                                 std::function<void(const AnkiEvent<external_interface::GatewayWrapper>&)> messageHandler)
@@ -180,12 +302,11 @@ Result ProtoMessageHandler::ProcessMessages()
       const bool isSingleMessage = !_socketComms->AreMessagesGrouped();
       while(keepReadingMessages)
       {
-        std::vector<uint8_t> buffer;
-        keepReadingMessages = _socketComms->RecvMessage(buffer);
+        keepReadingMessages = _socketComms->RecvMessage(_recvBuffer);
 
         if (keepReadingMessages)
         {
-          Result res = ProcessMessageBytes(buffer.data(), buffer.size(), isSingleMessage);
+          Result res = ProcessMessageBytes(_recvBuffer.data(), _recvBuffer.size(), isSingleMessage);
           if (res != RESULT_OK)
           {
             retVal = RESULT_FAIL;
@@ -230,6 +351,8 @@ Result ProtoMessageHandler::Update()
     }
   }
 
+  SendDueCoalescedMessages();
+
   return lastResult;
 } // Update()
 
@@ -19,6 +19,7 @@
 #include "proto/external_interface/shared.pb.h"
 #include "util/signals/simpleSignal_fwd.h"
 
+#include <array>
 #include <memory>
 
 // Forward declarations
@@ -51,6 +52,11 @@ public:
   virtual void Broadcast(const external_interface::GatewayWrapper& message) override;
   virtual void Broadcast(external_interface::GatewayWrapper&& message) override;
 
+  virtual void BroadcastCoalesced(GatewayCoalescedStream stream, external_interface::GatewayWrapper&& message) override;
+  virtual bool IsStreamDue(GatewayCoalescedStream stream) const override;
+  virtual void SetStreamPeriod(GatewayCoalescedStream stream, float period_s) override;
+  virtual bool IsBackedUp() const override;
+
   virtual Signal::SmartHandle Subscribe(const external_interface::GatewayWrapperTag& tagType, std::function<void(const AnkiEvent<external_interface::GatewayWrapper>&)> messageHandler) override;
 
   AnkiEventMgr<external_interface::GatewayWrapper>& GetEventMgr() { return _eventMgr; }
@@ -76,6 +82,20 @@ private:
 
   bool ConnectToProtoDevice(ISocketComms::DeviceId deviceId);
 
+  // Sends held coalesced messages whose stream period is up
+  void SendDueCoalescedMessages();
+
+  // ============================== Private Types ==============================
+
+  struct CoalescedStreamState
+  {
+    float period_s = 0.f;
+    double lastSendTime_s = 0.0;
+    bool hasSent = false;
+    bool hasPending = false;
+    external_interface::GatewayWrapper pending;
+  };
+
   // ============================== Private Member Vars ==============================
 
   std::unique_ptr<RobotExternalRequestComponent>          _externalRequestComponent;
@@ -87,6 +107,11 @@ private:
   AnkiEventMgr<external_interface::GatewayWrapper>        _eventMgr;
 
   std::vector<external_interface::GatewayWrapper>         _threadedMsgs;
+
+  // Reused for every received message, so reading doesn't allocate
+  std::vector<uint8_t>                                    _recvBuffer;
+
+  std::array<CoalescedStreamState, (size_t)GatewayCoalescedStream::Count> _coalescedStreams;
   std::mutex                                              _mutex;
 
   uint32_t                                                _hostProtoDeviceID = 0;
@@ -95,6 +120,9 @@ private:
 
   double                                                  _lastPingTime_ms = 0.f;
 
+  double                                                  _lastBlockedSendTime_s = -1.0;
+  uint32_t                                                _numBlockedSends = 0;
+
   bool                                                    _isInitialized = false;
 
   CozmoContext*                                           _context = nullptr;
@@ -403,8 +403,13 @@ namespace Anki {
       DEV_ASSERT(nullptr == _context || _context->IsEngineThread(),
                  "UiMessageHandler.GameToEngineRef.BroadcastOffEngineThread");
 
+      // Don't copy the message into an event if nobody is listening for it
+      const u32 type = static_cast<u32>(message.GetTag());
+      if (!_eventMgrToEngine.HasSubscribers(type)) {
+        return;
+      }
       _eventMgrToEngine.Broadcast(AnkiEvent<ExternalInterface::MessageGameToEngine>(
-        BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), static_cast<u32>(message.GetTag()), message));
+        BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message));
     } // Broadcast(MessageGameToEngine)
 
 
@@ -415,7 +420,10 @@ namespace Anki {
       DEV_ASSERT(nullptr == _context || _context->IsEngineThread(),
                  "UiMessageHandler.GameToEngineRval.BroadcastOffEngineThread");
 
-      u32 type = static_cast<u32>(message.GetTag());
+      const u32 type = static_cast<u32>(message.GetTag());
+      if (!_eventMgrToEngine.HasSubscribers(type)) {
+        return;
+      }
       _eventMgrToEngine.Broadcast(AnkiEvent<ExternalInterface::MessageGameToEngine>(
         BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, std::move(message)));
     } // Broadcast(MessageGameToEngine &&)
@@ -449,8 +457,12 @@ namespace Anki {
                  "UiMessageHandler.EngineToGameRef.BroadcastOffEngineThread");
 
       DeliverToGame(message);
+      const u32 type = static_cast<u32>(message.GetTag());
+      if (!_eventMgrToGame.HasSubscribers(type)) {
+        return;
+      }
       _eventMgrToGame.Broadcast(AnkiEvent<ExternalInterface::MessageEngineToGame>(
-        BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), static_cast<u32>(message.GetTag()), message));
+        BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message));
     } // Broadcast(MessageEngineToGame)
 
 
@@ -462,7 +474,10 @@ namespace Anki {
                  "UiMessageHandler.EngineToGameRval.BroadcastOffEngineThread");
 
       DeliverToGame(message);
-      u32 type = static_cast<u32>(message.GetTag());
+      const u32 type = static_cast<u32>(message.GetTag());
+      if (!_eventMgrToGame.HasSubscribers(type)) {
+        return;
+      }
       _eventMgrToGame.Broadcast(AnkiEvent<ExternalInterface::MessageEngineToGame>(
         BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, std::move(message)));
     } // Broadcast(MessageEngineToGame &&)
@@ -522,12 +537,11 @@ namespace Anki {
             const bool handleMessagesFromConnection = ShouldHandleMessagesFromConnection(i);
             while(keepReadingMessages)
             {
-              std::vector<uint8_t> buffer;
-              keepReadingMessages = socketComms->RecvMessage(buffer);
+              keepReadingMessages = socketComms->RecvMessage(_recvBuffer);
 
               if (keepReadingMessages)
               {
-                Result res = ProcessMessageBytes(buffer.data(), buffer.size(), i, isSingleMessage, handleMessagesFromConnection);
+                Result res = ProcessMessageBytes(_recvBuffer.data(), _recvBuffer.size(), i, isSingleMessage, handleMessagesFromConnection);
                 if (res != RESULT_OK)
                 {
                   retVal = RESULT_FAIL;
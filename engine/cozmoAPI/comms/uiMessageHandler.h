@@ -68,10 +68,12 @@ namespace Anki {
       
       virtual Signal::SmartHandle Subscribe(const ExternalInterface::MessageGameToEngineTag& tagType, std::function<void(const AnkiEvent<ExternalInterface::MessageGameToEngine>&)> messageHandler) override;
       
+      using IExternalInterface::Subscribe;
+      
       inline u32 GetHostUiDeviceID() const { return _hostUiDeviceID; }
       
-      AnkiEventMgr<ExternalInterface::MessageEngineToGame>& GetEventMgrToGame() { return _eventMgrToGame; }
-      AnkiEventMgr<ExternalInterface::MessageGameToEngine>& GetEventMgrToEngine() { return _eventMgrToEngine; }
+      AnkiDenseEventMgr<ExternalInterface::MessageEngineToGame>& GetEventMgrToGame() { return _eventMgrToGame; }
+      AnkiDenseEventMgr<ExternalInterface::MessageGameToEngine>& GetEventMgrToEngine() { return _eventMgrToEngine; }
       
       const Util::Stats::StatsAccumulator& GetLatencyStats(UiConnectionType type) const;
       
@@ -136,13 +138,17 @@ namespace Anki {
       
       std::vector<Signal::SmartHandle>    _signalHandles;
       
-      AnkiEventMgr<MessageEngineToGame>   _eventMgrToGame;
-      AnkiEventMgr<MessageGameToEngine>   _eventMgrToEngine;
+      // Indexed by message tag
+      AnkiDenseEventMgr<MessageEngineToGame>   _eventMgrToGame;
+      AnkiDenseEventMgr<MessageGameToEngine>   _eventMgrToEngine;
       
       std::vector<MessageGameToEngine>    _threadedMsgsToEngine;
       std::vector<MessageEngineToGame>    _threadedMsgsToGame;
       std::mutex                          _mutex;
       
+      // Reused for every received message, so reading doesn't allocate
+      std::vector<uint8_t>                _recvBuffer;
+      
       SdkStatus                           _sdkStatus;
       
       uint32_t                            _hostUiDeviceID = 0;
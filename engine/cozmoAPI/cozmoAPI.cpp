@@ -13,11 +13,15 @@
 
 #include "engine/cozmoAPI/cozmoAPI.h"
 #include "engine/cozmoEngine.h"
+#include "engine/engineTickScheduler.h"
 #include "platform/robotLogUploader/robotLogUploader.h"
 #include "util/ankiLab/ankiLabDef.h"
 #include "util/console/consoleInterface.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/logging/logging.h"
+#include "util/string/stringUtils.h"
+
+#include <thread>
 
 #define LOG_CHANNEL "CozmoAPI"
 
@@ -34,7 +38,12 @@ namespace {
     auto * channel = context->channel;
 
     if (result == RESULT_OK) {
-      channel->WriteLog("<a href=%s>%s</a>\n", status.c_str(), status.c_str());
+      if (status.empty()) {
+        channel->WriteLog("No new logs to upload\n");
+      }
+      for (const auto & url : Util::StringSplit(status)) {
+        channel->WriteLog("<a href=%s>%s</a>\n", url.c_str(), url.c_str());
+      }
     } else {
       channel->WriteLog("Unable to upload debug logs (error %d)\n", result);
       if (!status.empty()) {
@@ -74,7 +83,7 @@ bool CozmoAPI::Start(Util::Data::DataPlatform* dataPlatform, const Json::Value&
 }
 
 
-ANKI_CPU_PROFILER_ENABLED_ONLY(const float kMaxDesiredEngineDuration = 60.0f); // Above this warn etc.
+const float kMaxDesiredEngineDuration = 60.0f; // Above this warn etc.
 
 
 bool CozmoAPI::Update(const BaseStationTime_t currentTime_nanosec)
@@ -92,6 +101,18 @@ bool CozmoAPI::Update(const BaseStationTime_t currentTime_nanosec)
   return _engineRunner->Update(currentTime_nanosec);
 }
 
+bool CozmoAPI::WaitForNextTick(const std::chrono::steady_clock::time_point& earliest,
+                               const std::chrono::steady_clock::time_point& deadline)
+{
+  if (!_engineRunner)
+  {
+    std::this_thread::sleep_until(deadline);
+    return false;
+  }
+
+  return _engineRunner->WaitForNextTick(earliest, deadline);
+}
+
 uint32_t CozmoAPI::ActivateExperiment(const uint8_t* requestBuffer, size_t requestLen,
                                       uint8_t* responseBuffer, size_t responseLen)
 {
@@ -176,12 +197,23 @@ bool CozmoAPI::EngineInstanceRunner::Update(const BaseStationTime_t currentTime_
     std::lock_guard<std::mutex> lock{_updateMutex};
     updateResult = _engineInstance->Update(currentTime_nanosec);
   }
-  if (updateResult != RESULT_OK) {
+  // RESULT_SHUTDOWN is the engine asking to stop, e.g. at the end of a replay
+  if ((updateResult != RESULT_OK) && (updateResult != RESULT_SHUTDOWN)) {
     LOG_ERROR("CozmoAPI.EngineInstanceRunner.Update", "Cozmo update failed with error %d", updateResult);
   }
   return updateResult == RESULT_OK;
 }
 
+bool CozmoAPI::EngineInstanceRunner::WaitForNextTick(const std::chrono::steady_clock::time_point& earliest,
+                                                     const std::chrono::steady_clock::time_point& deadline)
+{
+  // Only receiving happens while waiting, handling what arrived is left to the next Update()
+  return _engineInstance->GetTickScheduler()->WaitForNextTick(earliest, deadline, [this]() {
+    std::lock_guard<std::mutex> lock{_updateMutex};
+    return _engineInstance->ReceiveRobotMessages();
+  });
+}
+
 void CozmoAPI::EngineInstanceRunner::SyncWithEngineUpdate(const std::function<void ()>& func) const
 {
   std::lock_guard<std::mutex> lock{_updateMutex};
@@ -18,6 +18,7 @@
 #include "util/helpers/noncopyable.h"
 #include "json/json.h"
 
+#include <chrono>
 #include <mutex>
 
 namespace Anki {
@@ -40,6 +41,11 @@ public:
 
   ANKI_VISIBLE bool Update(const BaseStationTime_t currentTime_nanosec);
 
+  // Waits between ticks until deadline, or returns true once earliest has passed if the robot sends something the
+  // engine should react to right away (e.g. a cliff)
+  ANKI_VISIBLE bool WaitForNextTick(const std::chrono::steady_clock::time_point& earliest,
+                                    const std::chrono::steady_clock::time_point& deadline);
+
   // Activate A/B experiment
   ANKI_VISIBLE uint32_t ActivateExperiment(const uint8_t* requestBuffer, size_t requestLen,
                                            uint8_t* responseBuffer, size_t responseLen);
@@ -61,6 +67,8 @@ private:
     virtual ~EngineInstanceRunner();
 
     bool Update(const BaseStationTime_t currentTime_nanosec);
+    bool WaitForNextTick(const std::chrono::steady_clock::time_point& earliest,
+                         const std::chrono::steady_clock::time_point& deadline);
     CozmoEngine* GetEngine() const { return _engineInstance.get(); }
     void SyncWithEngineUpdate(const std::function<void()>& func) const;
 
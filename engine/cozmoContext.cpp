@@ -1,7 +1,9 @@
 
 #include "engine/cozmoContext.h"
 
+#include "anki/cozmo/shared/cozmoEngineConfig.h"
 #include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "engine/engineTickScheduler.h"
 #include "engine/externalInterface/externalInterface.h"
 #include "engine/perfMetricEngine.h"
 #include "engine/robotDataLoader.h"
@@ -45,6 +47,7 @@ CozmoContext::CozmoContext(Util::Data::DataPlatform* dataPlatform, IExternalInte
   , _cozmoExperiments(new CozmoExperiments(this))
   , _perfMetric(new PerfMetricEngine(this))
   , _webService(new WebService::WebService())
+  , _tickScheduler(new EngineTickScheduler(BS_TIME_STEP_MS))
 {
   //_gameLogTransferTask->Init(_transferQueueMgr.get());
 }
@@ -50,6 +50,7 @@ class RobotDataLoader;
 class RobotManager;
 class VizManager;
 class PerfMetricEngine;
+class EngineTickScheduler;
 
 namespace WebService {
   class WebService;
@@ -96,6 +97,7 @@ public:
   CozmoExperiments*                     GetExperiments() const { return _cozmoExperiments.get(); }
   PerfMetricEngine*                     GetPerfMetric() const { return _perfMetric.get(); }
   WebService::WebService*               GetWebService() const { return _webService.get(); }
+  EngineTickScheduler*                  GetTickScheduler() const { return _tickScheduler.get(); }
 
   void  SetSdkStatus(SdkStatusType statusType, std::string&& statusText) const;
 
@@ -135,6 +137,7 @@ private:
   std::unique_ptr<CozmoExperiments>                     _cozmoExperiments;
   std::unique_ptr<PerfMetricEngine>                     _perfMetric;
   std::unique_ptr<WebService::WebService>               _webService;
+  std::unique_ptr<EngineTickScheduler>                  _tickScheduler;
 };
 
 
@@ -12,8 +12,10 @@
 #include "coretech/common/engine/opencvThreading.h"
 #include "coretech/common/engine/utils/data/dataPlatform.h"
 #include "coretech/common/engine/utils/timer.h"
+#include "coretech/messaging/shared/bootStatus.h"
 #include "engine/ankiEventUtil.h"
 #include "engine/components/battery/batteryComponent.h"
+#include "engine/components/cubes/cubeCommsComponent.h"
 #include "engine/components/mics/micComponent.h"
 #include "engine/components/mics/micDirectionHistory.h"
 #include "engine/components/movementComponent.h"
@@ -25,6 +27,8 @@
 #include "engine/cozmoContext.h"
 #include "engine/cozmoEngine.h"
 #include "engine/debug/cladLoggerProvider.h"
+#include "engine/debug/engineReplay.h"
+#include "engine/engineTickScheduler.h"
 #include "engine/events/ankiEvent.h"
 #include "engine/externalInterface/externalInterface.h"
 #include "engine/factory/factoryTestLogger.h"
@@ -57,6 +61,7 @@
 #include "util/logging/DAS.h"
 #include "util/logging/printfLoggerProvider.h"
 #include "util/logging/multiLoggerProvider.h"
+#include "util/messageProfiler/messageProfiler.h"
 #include "util/time/universalTime.h"
 #include "util/environment/locale.h"
 #include "util/transport/connectionStats.h"
@@ -88,6 +93,21 @@ namespace {
   // When did we last try connecting?
   auto lastConnectAttempt = std::chrono::steady_clock::time_point();
 
+  // Whether we've tried connecting since vic-anim said it was listening
+  bool hasTriedConnectSinceAnimReady = false;
+
+  // How long each tick waits for vic-anim to say it's listening
+  constexpr s32 kAnimReadyWaitPerTick_ms = 30;
+
+  // Deferred init runs this long after connecting if nobody has interacted with the robot yet
+  constexpr auto kDeferredInitTimeout = std::chrono::seconds(60);
+
+  // When did we connect to the robot?
+  auto connectedTime = std::chrono::steady_clock::time_point();
+
+  // How often latency info is sent, when enabled
+  constexpr float kLatencyInfoRate_hz = 1.5f;
+
 }
 
 namespace Anki {
@@ -200,6 +220,13 @@ CozmoEngine::CozmoEngine(Util::Data::DataPlatform* dataPlatform)
       dataPlatform->pathToResource(Util::Data::Scope::Cache, "vic-engine-tracing.json").c_str());
   Anki::Util::CpuThreadProfiler::SendToWebVizCallback([&](const Json::Value& json) { _context->GetWebService()->SendToWebViz("cpuprofile", json); });
 #endif
+#if ANKI_CPU_HITCH_RECORDER_ENABLED
+  Anki::Util::CpuHitchRecorder::SetDumpDirectory(
+      dataPlatform->pathToResource(Util::Data::Scope::Cache, "cpuHitches"), "vic-engine");
+#endif
+#if ANKI_MESSAGE_PROFILER_ENABLED
+  Anki::Util::MessageProfiler::SendToWebVizCallback([&](const Json::Value& json) { _context->GetWebService()->SendToWebViz("messageprofile", json); });
+#endif
 
   DEV_ASSERT(_context->GetExternalInterface() != nullptr, "Cozmo.Engine.ExternalInterface.nullptr");
   if (Anki::Util::gTickTimeProvider == nullptr) {
@@ -302,6 +329,11 @@ Result CozmoEngine::Init(const Json::Value& config) {
     }
   }
 
+  // Anything published by a previous engine instance no longer holds
+  BootStatus::Clear(BootMilestone::EngineDataLoaded);
+  BootStatus::Clear(BootMilestone::EngineConnected);
+  BootStatus::Clear(BootMilestone::FirstInteraction);
+
   lastResult = InitInternal();
   if(lastResult != RESULT_OK) {
     PRINT_NAMED_ERROR("CozmoEngine.Init", "Failed calling internal init.");
@@ -321,6 +353,16 @@ Result CozmoEngine::Init(const Json::Value& config) {
     seed = 1; // Setting to non-zero value for now for repeatable testing.
   }
 # endif
+
+  // A replay stands in for the robot connection
+  if (EngineReplay::IsReplayConfig(_config)) {
+    _replay = std::make_unique<EngineReplay>(_context.get(), _config);
+    if (!_replay->IsValid()) {
+      PRINT_NAMED_ERROR("CozmoEngine.Init", "Nothing to replay");
+      return RESULT_FAIL;
+    }
+    seed = EngineReplay::GetRandomSeed(_config);
+  }
   _context->SetRandomSeed(seed);
 
   const auto& webService = _context->GetWebService();
@@ -330,6 +372,8 @@ Result CozmoEngine::Init(const Json::Value& config) {
 
   _context->GetPerfMetric()->Init(_context->GetDataPlatform(), _context->GetWebService());
 
+  _context->GetTickScheduler()->RegisterTask("LatencyInfo", kLatencyInfoRate_hz, [this]() { UpdateLatencyInfo(); });
+
   LOG_INFO("CozmoEngine.Init.Version", "2");
 
   SetEngineState(EngineState::LoadingData);
@@ -358,6 +402,10 @@ Result CozmoEngine::Update(const BaseStationTime_t currTime_nanosec)
     return RESULT_FAIL;
   }
 
+  if ((_replay != nullptr) && (_engineState == EngineState::Running)) {
+    _replay->BeginTick();
+  }
+
   if (!_hasRunFirstUpdate) {
     _hasRunFirstUpdate = true;
 
@@ -428,16 +476,23 @@ Result CozmoEngine::Update(const BaseStationTime_t currTime_nanosec)
       float currentLoadingDone = 0.0f;
       if (_context->GetDataLoader()->DoNonConfigDataLoading(currentLoadingDone))
       {
+        BootStatus::Publish(BootMilestone::EngineDataLoaded);
         SetEngineState(EngineState::ConnectingToRobot);
       }
       break;
     }
     case EngineState::ConnectingToRobot:
     {
+      // vic-anim says when it's listening, so connect as soon as it does. If it hasn't said (or there's no boot
+      // status page, or connecting failed anyway), fall back on retrying every connectInterval
+      const bool isAnimReady = BootStatus::WaitFor(BootMilestone::AnimEngineCommsReady, kAnimReadyWaitPerTick_ms);
+      const bool connectNow = (isAnimReady && !hasTriedConnectSinceAnimReady);
+      hasTriedConnectSinceAnimReady = isAnimReady;
+
       // Is is time to try connecting?
       const auto now = std::chrono::steady_clock::now();
       const auto elapsed = (now - lastConnectAttempt);
-      if (elapsed < connectInterval) {
+      if (!connectNow && (elapsed < connectInterval)) {
         // Too soon to try connecting
         break;
       }
@@ -452,16 +507,34 @@ Result CozmoEngine::Update(const BaseStationTime_t currTime_nanosec)
 
       // Now connected
       LOG_INFO("CozmoEngine.Update.ConnectingToRobot", "Now connected to robot");
+      if (_replay != nullptr) {
+        _replay->Start();
+      }
+      BootStatus::Publish(BootMilestone::EngineConnected);
+      ReportBootTimeline();
+      connectedTime = now;
       SetEngineState(EngineState::Running);
       break;
     }
     case EngineState::Running:
     {
+      // On a replay the engine runs on the recording's clock rather than the caller's
+      BaseStationTime_t tickTime_nanosec = currTime_nanosec;
+      if (_replay != nullptr) {
+        if (!_replay->FeedNextTick()) {
+          LOG_INFO("CozmoEngine.Update.ReplayFinished", "Nothing left to replay");
+          _replay->Finish();
+          SetEngineState(EngineState::Stopped);
+          return RESULT_SHUTDOWN;
+        }
+        tickTime_nanosec = _replay->GetVirtualTime_nanosec();
+      }
+
       // Update time
-      BaseStationTimer::getInstance()->UpdateTime(currTime_nanosec);
+      BaseStationTimer::getInstance()->UpdateTime(tickTime_nanosec);
 
       // Update OSState
-      OSState::getInstance()->Update(currTime_nanosec);
+      OSState::getInstance()->Update(tickTime_nanosec);
 
       Result result = _context->GetRobotManager()->UpdateRobotConnection();
       if (RESULT_OK != result) {
@@ -469,6 +542,9 @@ Result CozmoEngine::Update(const BaseStationTime_t currTime_nanosec)
         return result;
       }
 
+      // The socket changes if the connection is remade, so pick it up every tick
+      _context->GetTickScheduler()->SetWakeSocket(_context->GetRobotManager()->GetMsgHandler()->GetRobotSocket());
+
       // Let the robot manager do whatever it's gotta do to update the
       // robots in the world.
       result = _context->GetRobotManager()->UpdateRobot();
@@ -478,7 +554,24 @@ Result CozmoEngine::Update(const BaseStationTime_t currTime_nanosec)
         return result;
       }
 
-      UpdateLatencyInfo();
+      // Everything sent to the robot this tick goes out together
+      _context->GetRobotManager()->GetMsgHandler()->FlushMessages();
+
+      // Likewise for the cube
+      Robot* robot = GetRobot();
+      if (robot != nullptr) {
+        robot->GetCubeCommsComponent().FlushCubeMessages();
+      }
+
+      _context->GetTickScheduler()->RunDueTasks();
+
+      if (!_hasRunDeferredInit) {
+        UpdateDeferredInit();
+      }
+
+      if (_replay != nullptr) {
+        _replay->EndTick();
+      }
       break;
     }
     default:
@@ -489,6 +582,19 @@ Result CozmoEngine::Update(const BaseStationTime_t currTime_nanosec)
   return RESULT_OK;
 }
 
+EngineTickScheduler* CozmoEngine::GetTickScheduler() const
+{
+  return _context->GetTickScheduler();
+}
+
+bool CozmoEngine::ReceiveRobotMessages()
+{
+  if (_engineState != EngineState::Running) {
+    return false;
+  }
+  return _context->GetRobotManager()->GetMsgHandler()->ReceiveArrivedMessages();
+}
+
 #if REMOTE_CONSOLE_ENABLED
 void PrintTimingInfoStats(const ExternalInterface::TimingInfo& timingInfo, const char* name)
 {
@@ -508,16 +614,6 @@ void CozmoEngine::UpdateLatencyInfo()
 #if REMOTE_CONSOLE_ENABLED
   if (Util::kNetConnStatsUpdate)
   {
-    // We only want to send latency info every N ticks
-    constexpr int kTickSendFrequency = 10;
-    static int currentTickCount = kTickSendFrequency;
-    if (0 != currentTickCount)
-    {
-      currentTickCount--;
-      return;
-    }
-    currentTickCount = kTickSendFrequency;
-    
     if (kLogMessageLatencyOnce)
     {
       ExternalInterface::TimingInfo wifiLatency(Util::gNetStat2LatencyAvg, Util::gNetStat4LatencyMin, Util::gNetStat5LatencyMax);
@@ -562,21 +658,64 @@ void CozmoEngine::SetEngineState(EngineState newState)
 
 Result CozmoEngine::InitInternal()
 {
+  // clear the first update flag
+  _hasRunFirstUpdate = false;
+  _hasRunDeferredInit = false;
+
+  return RESULT_OK;
+}
+
+void CozmoEngine::UpdateDeferredInit()
+{
+  // Voice and the app publish their own interactions (see UserIntentComponent and switchboard), touch is ours
+  Robot* robot = GetRobot();
+  if ((robot != nullptr) && robot->GetTouchSensorComponent().GetIsPressed()) {
+    BootStatus::Publish(BootMilestone::FirstInteraction);
+  }
+
+  const bool hasTimedOut = ((std::chrono::steady_clock::now() - connectedTime) >= kDeferredInitTimeout);
+  if (BootStatus::IsReached(BootMilestone::FirstInteraction) || hasTimedOut) {
+    RunDeferredInit();
+  }
+}
+
+void CozmoEngine::RunDeferredInit()
+{
+  _hasRunDeferredInit = true;
+
   // Archive factory test logs
   FactoryTestLogger factoryTestLogger;
   u32 numLogs = factoryTestLogger.GetNumLogs(_context->GetDataPlatform());
   if (numLogs >= MIN_NUM_FACTORY_TEST_LOGS_FOR_ARCHIVING) {
     if (factoryTestLogger.ArchiveLogs(_context->GetDataPlatform())) {
-      LOG_INFO("CozmoEngine.InitInternal.ArchivedFactoryLogs", "%d logs archived", numLogs);
+      LOG_INFO("CozmoEngine.RunDeferredInit.ArchivedFactoryLogs", "%d logs archived", numLogs);
     } else {
-      PRINT_NAMED_WARNING("CozmoEngine.InitInternal.ArchivedFactoryLogsFailed", "");
+      PRINT_NAMED_WARNING("CozmoEngine.RunDeferredInit.ArchivedFactoryLogsFailed", "");
     }
   }
+}
 
-  // clear the first update flag
-  _hasRunFirstUpdate = false;
+void CozmoEngine::ReportBootTimeline()
+{
+  if (!BootStatus::IsAvailable()) {
+    return;
+  }
 
-  return RESULT_OK;
+  const u32 robotCommsReady_ms = BootStatus::GetReachedTime_ms(BootMilestone::RobotCommsReady);
+  const u32 animFaceReady_ms = BootStatus::GetReachedTime_ms(BootMilestone::AnimFaceReady);
+  const u32 dataLoaded_ms = BootStatus::GetReachedTime_ms(BootMilestone::EngineDataLoaded);
+  const u32 connected_ms = BootStatus::GetReachedTime_ms(BootMilestone::EngineConnected);
+
+  LOG_INFO("CozmoEngine.ReportBootTimeline",
+           "ms since boot: RobotCommsReady %u, AnimFaceReady %u, EngineDataLoaded %u, EngineConnected %u",
+           robotCommsReady_ms, animFaceReady_ms, dataLoaded_ms, connected_ms);
+
+  DASMSG(engine_boot_timeline, "engine.boot_timeline", "When each startup milestone was reached, in ms since boot");
+  DASMSG_SET(i1, animFaceReady_ms, "vic-anim drew its first face");
+  DASMSG_SET(i2, dataLoaded_ms, "vic-engine finished loading data");
+  DASMSG_SET(i3, connected_ms, "vic-engine connected to vic-anim");
+  DASMSG_SET(i4, robotCommsReady_ms, "vic-robot started listening for vic-anim");
+  DASMSG_SEND();
 }
 
 Result CozmoEngine::ConnectToRobotProcess()
@@ -588,6 +727,10 @@ Result CozmoEngine::ConnectToRobotProcess()
     robotManager->AddRobot(robotID);
   }
 
+  if (_replay != nullptr) {
+    return RESULT_OK;
+  }
+
   auto * msgHandler = robotManager->GetMsgHandler();
   if (!msgHandler->IsConnected(robotID)) {
     Result result = msgHandler->AddRobotConnection(robotID);
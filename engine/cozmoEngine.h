@@ -65,6 +65,8 @@ class CozmoContext;
 class UiMessageHandler;
 class ProtoMessageHandler;
 class AnimationTransfer;
+class EngineReplay;
+class EngineTickScheduler;
 
 template <typename Type>
 class AnkiEvent;
@@ -86,6 +88,13 @@ public:
   // Hook this up to whatever is ticking the game "heartbeat"
   Result Update(const BaseStationTime_t currTime_nanosec);
 
+  // Paces Update() and runs the low-rate work components register with it
+  EngineTickScheduler* GetTickScheduler() const;
+
+  // Receives what the robot has sent since the last tick, for the next Update() to handle. Returns true if any of it
+  // should be handled right away rather than at the next regular tick
+  bool ReceiveRobotMessages();
+
   void ListenForRobotConnections(bool listen);
 
   Robot* GetRobot();
@@ -122,6 +131,7 @@ protected:
   Anki::Vector::DebugConsoleManager                          _debugConsoleManager;
   Anki::Vector::DasToSdkHandler                              _dasToSdkHandler;
   bool                                                      _hasRunFirstUpdate = false;
+  bool                                                      _hasRunDeferredInit = false;
   bool                                                      _uiWasConnected = false;
   bool                                                      _updateMoveComponent = false;
 
@@ -130,6 +140,13 @@ protected:
   void SetEngineState(EngineState newState);
 
   Result ConnectToRobotProcess();
+
+  // Startup work nobody needs right away, held back until the user first interacts or the robot has been up a while
+  void UpdateDeferredInit();
+  void RunDeferredInit();
+
+  // Logs and reports when each startup milestone was reached
+  void ReportBootTimeline();
   Result AddRobot(RobotID_t robotID);
 
   void UpdateLatencyInfo();
@@ -139,6 +156,9 @@ protected:
 
   std::unique_ptr<AnimationTransfer>                        _animationTransferHandler;
 
+  // Set when the config asks for a dev log to be replayed instead of connecting to the robot
+  std::unique_ptr<EngineReplay>                             _replay;
+
 }; // class CozmoEngine
 
 
@@ -0,0 +1,148 @@
+/**
+* File: devLogChunk
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Layout of chunked dev logs
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#include "engine/debug/devLogChunk.h"
+
+#include "util/logging/logging.h"
+
+#include <algorithm>
+#include <zlib.h>
+
+namespace Anki {
+namespace Vector {
+
+namespace DevLogChunk {
+
+namespace {
+  // "DLC1"
+  constexpr uint32_t kMagic = 0x31434c44;
+
+  constexpr uint32_t kFlagCompressed = 1 << 0;
+
+  void AppendU32(std::string& bytes, uint32_t value)
+  {
+    for (std::size_t i = 0; i < sizeof(value); ++i)
+    {
+      bytes.push_back(static_cast<char>(value >> (8 * i)));
+    }
+  }
+
+  uint32_t ReadU32(const uint8_t*& bytes)
+  {
+    uint32_t value = 0;
+    for (std::size_t i = 0; i < sizeof(value); ++i)
+    {
+      value |= static_cast<uint32_t>(bytes[i]) << (8 * i);
+    }
+    bytes += sizeof(value);
+    return value;
+  }
+}
+
+bool HasAnyTag(const TagSet& tags, const TagSet& wantedTags)
+{
+  for (std::size_t i = 0; i < tags.size(); ++i)
+  {
+    if (tags[i] & wantedTags[i])
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool Header::IsCompressed() const
+{
+  return (flags & kFlagCompressed) != 0;
+}
+
+bool ReadHeader(const uint8_t* bytes, Header& header_out)
+{
+  if (ReadU32(bytes) != kMagic)
+  {
+    return false;
+  }
+  header_out.storedSize = ReadU32(bytes);
+  header_out.rawSize = ReadU32(bytes);
+  header_out.flags = ReadU32(bytes);
+  header_out.numRecords = ReadU32(bytes);
+  header_out.firstTimestamp_ms = ReadU32(bytes);
+  header_out.lastTimestamp_ms = ReadU32(bytes);
+  std::copy(bytes, bytes + header_out.tags.size(), header_out.tags.begin());
+  return true;
+}
+
+std::string MakeChunk(Header header, const std::string& records, bool compress)
+{
+  std::string payload;
+  if (compress)
+  {
+    // Fastest level, this runs for every chunk of every log on the robot
+    uLongf compressedSize = compressBound(records.size());
+    payload.resize(compressedSize);
+    const int result = compress2(reinterpret_cast<Bytef*>(&payload[0]), &compressedSize,
+                                 reinterpret_cast<const Bytef*>(records.data()), records.size(), Z_BEST_SPEED);
+    if (result == Z_OK && compressedSize < records.size())
+    {
+      payload.resize(compressedSize);
+      header.flags |= kFlagCompressed;
+    }
+    else
+    {
+      payload.clear();
+    }
+  }
+  if (!header.IsCompressed())
+  {
+    payload = records;
+  }
+  header.rawSize = static_cast<uint32_t>(records.size());
+  header.storedSize = static_cast<uint32_t>(payload.size());
+
+  std::string chunk;
+  chunk.reserve(kHeaderSize + payload.size());
+  AppendU32(chunk, kMagic);
+  AppendU32(chunk, header.storedSize);
+  AppendU32(chunk, header.rawSize);
+  AppendU32(chunk, header.flags);
+  AppendU32(chunk, header.numRecords);
+  AppendU32(chunk, header.firstTimestamp_ms);
+  AppendU32(chunk, header.lastTimestamp_ms);
+  chunk.append(reinterpret_cast<const char*>(header.tags.data()), header.tags.size());
+  chunk.append(payload);
+  return chunk;
+}
+
+bool ReadPayload(const Header& header, const uint8_t* payload, std::vector<uint8_t>& records_out)
+{
+  if (!header.IsCompressed())
+  {
+    records_out.assign(payload, payload + header.storedSize);
+    return true;
+  }
+
+  records_out.resize(header.rawSize);
+  uLongf rawSize = header.rawSize;
+  const int result = uncompress(records_out.data(), &rawSize, payload, header.storedSize);
+  if (result != Z_OK || rawSize != header.rawSize)
+  {
+    PRINT_NAMED_WARNING("DevLogChunk.ReadPayload.DecompressFailed", "zlib result %d, %lu of %u bytes",
+                        result, static_cast<unsigned long>(rawSize), header.rawSize);
+    records_out.clear();
+    return false;
+  }
+  return true;
+}
+
+} // namespace DevLogChunk
+
+} // end namespace Vector
+} // end namespace Anki
@@ -0,0 +1,68 @@
+/**
+* File: devLogChunk
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Layout of chunked dev logs. Records (in the same size, timestamp, packed message layout as the raw
+*              logs) are grouped into chunks, each with a header giving its time range, the message tags in it
+*              and how it is stored, so a reader can find a point in time or a kind of message by reading headers
+*              alone. Payloads may be compressed.
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#ifndef __Cozmo_Basestation_Debug_DevLogChunk_H_
+#define __Cozmo_Basestation_Debug_DevLogChunk_H_
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+namespace DevLogChunk {
+
+// One bit for each possible message tag (the first byte of a packed message)
+using TagSet = std::array<uint8_t, 32>;
+
+inline void AddTag(TagSet& tags, uint8_t tag) { tags[tag / 8] |= (1 << (tag % 8)); }
+inline bool HasTag(const TagSet& tags, uint8_t tag) { return (tags[tag / 8] & (1 << (tag % 8))) != 0; }
+bool HasAnyTag(const TagSet& tags, const TagSet& wantedTags);
+
+struct Header
+{
+  uint32_t storedSize        = 0; // payload bytes following the header
+  uint32_t rawSize           = 0; // payload bytes once decompressed
+  uint32_t flags             = 0;
+  uint32_t numRecords        = 0;
+  uint32_t firstTimestamp_ms = 0;
+  uint32_t lastTimestamp_ms  = 0;
+  TagSet   tags{};
+
+  bool IsCompressed() const;
+};
+
+// Bytes taken by a header in the file: magic, six u32 fields (little endian) and the tag set
+static constexpr std::size_t kHeaderSize = sizeof(uint32_t) * 7 + sizeof(TagSet);
+
+// Reads a header from kHeaderSize bytes. Returns false if they don't start with the chunk magic, e.g. the zeroed
+// tail of a file the logger didn't get to close
+bool ReadHeader(const uint8_t* bytes, Header& header_out);
+
+// Returns header (with its size fields filled in) followed by records, compressed if requested and if that makes
+// them smaller
+std::string MakeChunk(Header header, const std::string& records, bool compress);
+
+// Fills records_out with the payload of a chunk, decompressing it if needed. Returns success
+bool ReadPayload(const Header& header, const uint8_t* payload, std::vector<uint8_t>& records_out);
+
+} // namespace DevLogChunk
+
+} // end namespace Vector
+} // end namespace Anki
+
+
+#endif //__Cozmo_Basestation_Debug_DevLogChunk_H_
@@ -0,0 +1,160 @@
+/**
+* File: devLogChunkWriter
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Writes dev log records to rolling files as chunks
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#include "engine/debug/devLogChunkWriter.h"
+
+#include "engine/debug/devLogChunk.h"
+#include "util/dispatchQueue/dispatchQueue.h"
+#include "util/logging/rollingFileLogger.h"
+
+#include <chrono>
+#include <mutex>
+
+namespace Anki {
+namespace Vector {
+
+const char * const DevLogChunkWriter::kFileExtension = ".dlc";
+
+constexpr std::size_t DevLogChunkWriter::kChunkSize;
+constexpr uint32_t DevLogChunkWriter::kMaxChunkAge_ms;
+
+struct DevLogChunkWriter::State
+{
+  State(const std::string& baseDirectory, bool compress)
+  : fileLogger(nullptr, baseDirectory, kFileExtension)
+  , compress(compress)
+  {
+  }
+
+  // The file logger commits by itself, so it doesn't need our queue
+  Util::RollingFileLogger fileLogger;
+  const bool              compress;
+
+  // The chunk being built, guarded by mutex. generation tells a timed seal whether its chunk is still this one
+  std::mutex              mutex;
+  std::string             records;
+  DevLogChunk::Header     header;
+  uint32_t                generation = 0;
+  bool                    closed = false;
+
+  // Must hold mutex. Leaves an empty chunk behind and returns what it had
+  std::pair<DevLogChunk::Header, std::string> TakeChunk()
+  {
+    std::pair<DevLogChunk::Header, std::string> chunk{header, std::move(records)};
+    header = {};
+    records.clear();
+    ++generation;
+    return chunk;
+  }
+
+  void WriteChunk(const DevLogChunk::Header& chunkHeader, const std::string& chunkRecords)
+  {
+    fileLogger.Write(DevLogChunk::MakeChunk(chunkHeader, chunkRecords, compress));
+  }
+};
+
+DevLogChunkWriter::DevLogChunkWriter(Util::Dispatch::Queue* queue, const std::string& baseDirectory, bool compress)
+: _queue(queue)
+, _state(std::make_shared<State>(baseDirectory, compress))
+{
+}
+
+DevLogChunkWriter::~DevLogChunkWriter()
+{
+  std::pair<DevLogChunk::Header, std::string> chunk;
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->closed = true;
+    chunk = _state->TakeChunk();
+  }
+
+  auto writeLast = [this, &chunk] {
+    if (!chunk.second.empty())
+    {
+      _state->WriteChunk(chunk.first, chunk.second);
+    }
+  };
+
+  // Going through the queue puts the last chunk after any that are still waiting there
+  if (_queue != nullptr)
+  {
+    Util::Dispatch::Sync(_queue, writeLast);
+  }
+  else
+  {
+    writeLast();
+  }
+}
+
+void DevLogChunkWriter::Write(uint8_t tag, uint32_t timestamp_ms, std::string record)
+{
+  std::pair<DevLogChunk::Header, std::string> fullChunk;
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (_state->closed)
+    {
+      return;
+    }
+
+    auto& header = _state->header;
+    if (_state->records.empty())
+    {
+      header.firstTimestamp_ms = timestamp_ms;
+      if (_queue != nullptr)
+      {
+        std::weak_ptr<State> weakState = _state;
+        const uint32_t generation = _state->generation;
+        Util::Dispatch::After(_queue, std::chrono::milliseconds(kMaxChunkAge_ms), [weakState, generation] {
+          auto state = weakState.lock();
+          if (state == nullptr)
+          {
+            return;
+          }
+          std::pair<DevLogChunk::Header, std::string> agedChunk;
+          {
+            std::lock_guard<std::mutex> lock(state->mutex);
+            if (state->closed || (state->generation != generation))
+            {
+              return;
+            }
+            agedChunk = state->TakeChunk();
+          }
+          state->WriteChunk(agedChunk.first, agedChunk.second);
+        }, "DevLogChunkAge");
+      }
+    }
+    header.lastTimestamp_ms = timestamp_ms;
+    ++header.numRecords;
+    DevLogChunk::AddTag(header.tags, tag);
+    _state->records.append(record);
+
+    if (_state->records.size() < kChunkSize)
+    {
+      return;
+    }
+    fullChunk = _state->TakeChunk();
+  }
+
+  if (_queue == nullptr)
+  {
+    _state->WriteChunk(fullChunk.first, fullChunk.second);
+    return;
+  }
+
+  auto state = _state;
+  auto chunk = std::make_shared<std::pair<DevLogChunk::Header, std::string>>(std::move(fullChunk));
+  Util::Dispatch::Async(_queue, [state, chunk] {
+    state->WriteChunk(chunk->first, chunk->second);
+  }, "DevLogChunkWrite");
+}
+
+} // end namespace Vector
+} // end namespace Anki
@@ -0,0 +1,61 @@
+/**
+* File: devLogChunkWriter
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Writes dev log records to rolling files as chunks (see devLogChunk.h). Write only appends to an
+*              in-memory chunk; sealing it (compressing and handing it to the file logger) happens on the
+*              dispatch queue, once the chunk is big enough or some time after its first record.
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#ifndef __Cozmo_Basestation_Debug_DevLogChunkWriter_H_
+#define __Cozmo_Basestation_Debug_DevLogChunkWriter_H_
+
+#include "util/helpers/noncopyable.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace Anki {
+namespace Util {
+  namespace Dispatch {
+    class Queue;
+  }
+}
+
+namespace Vector {
+
+class DevLogChunkWriter : Util::noncopyable {
+public:
+  static const char * const     kFileExtension;
+
+  // Records that trigger sealing the chunk right away, and how long after its first record it's sealed otherwise
+  static constexpr std::size_t  kChunkSize = 64 * 1024;
+  static constexpr uint32_t     kMaxChunkAge_ms = 2000;
+
+  // With a null queue, chunks are sealed on the writing thread and only by size
+  DevLogChunkWriter(Util::Dispatch::Queue* queue, const std::string& baseDirectory, bool compress = true);
+
+  // Seals what's left and waits for queued chunks to be written, so the queue must still be running
+  ~DevLogChunkWriter();
+
+  // Thread safe. tag is the message tag the record is indexed under, the record itself is in the raw log layout
+  void Write(uint8_t tag, uint32_t timestamp_ms, std::string record);
+
+private:
+  // Shared with the tasks this queues, which may outlive the writer if the queue is stopped under them
+  struct State;
+
+  Util::Dispatch::Queue*  _queue;
+  std::shared_ptr<State>  _state;
+};
+
+} // end namespace Vector
+} // end namespace Anki
+
+
+#endif //__Cozmo_Basestation_Debug_DevLogChunkWriter_H_
@@ -12,6 +12,7 @@
 #include "engine/debug/devLogProcessor.h"
 
 #include "engine/debug/devLoggingSystem.h"
+#include "engine/debug/devLogReaderChunked.h"
 #include "engine/debug/devLogReaderPrint.h"
 #include "engine/debug/devLogReaderRaw.h"
 #include "util/fileUtils/fileUtils.h"
@@ -31,7 +32,16 @@ DevLogProcessor::DevLogProcessor(const std::string& directory)
     return;
   }
   
-  _vizMessageReader.reset(new DevLogReaderRaw(Util::FileUtils::FullFilePath( {_directoryName, DevLoggingSystem::kEngineToVizName} )));
+  // Logs made before chunking are still raw
+  const std::string vizDirectory = Util::FileUtils::FullFilePath( {_directoryName, DevLoggingSystem::kEngineToVizName} );
+  if (DevLogReaderChunked::HasChunkedLogs(vizDirectory))
+  {
+    _vizMessageReader.reset(new DevLogReaderChunked(vizDirectory));
+  }
+  else
+  {
+    _vizMessageReader.reset(new DevLogReaderRaw(vizDirectory));
+  }
   _printReader.reset(new DevLogReaderPrint(Util::FileUtils::FullFilePath( {_directoryName, DevLoggingSystem::kPrintName} )));
 
   _vizMessageReader->Init();
@@ -56,6 +66,19 @@ bool DevLogProcessor::AdvanceTime(uint32_t time_ms)
   return anyMoreMessages;
 }
 
+void DevLogProcessor::SeekToTime(uint32_t time_ms)
+{
+  if (_vizMessageReader)
+  {
+    _vizMessageReader->SeekToTime(time_ms);
+  }
+  
+  if (_printReader)
+  {
+    _printReader->SeekToTime(time_ms);
+  }
+}
+
 uint32_t DevLogProcessor::GetCurrPlaybackTime() const
 {
   if( _vizMessageReader ) {
@@ -24,7 +24,6 @@
 namespace Anki {
 namespace Vector {
   
-class DevLogReaderRaw;
 class DevLogReaderPrint;
 
 class DevLogProcessor : Util::noncopyable {
@@ -38,6 +37,9 @@ public:
   // Returns whether there is more data in the logs to process
   bool AdvanceTime(uint32_t time_ms);
 
+  // Jump to the given playback time (forward or back) without calling back for anything before it
+  void SeekToTime(uint32_t time_ms);
+
   // return the current playback time
   uint32_t GetCurrPlaybackTime() const;
 
@@ -55,7 +57,7 @@ public:
   
 private:
   std::string                         _directoryName;
-  std::unique_ptr<DevLogReaderRaw>    _vizMessageReader;
+  std::unique_ptr<DevLogReader>       _vizMessageReader;
   std::unique_ptr<DevLogReaderPrint>  _printReader;
 };
 
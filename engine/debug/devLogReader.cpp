@@ -14,11 +14,14 @@
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+
 namespace Anki {
 namespace Vector {
   
-DevLogReader::DevLogReader(const std::string& directory)
+DevLogReader::DevLogReader(const std::string& directory, const std::string& extension)
 : _directory(directory)
+, _extension(extension)
 {
   // The directory we've been given isn't valid so we're done
   if (!Util::FileUtils::DirectoryExists(_directory))
@@ -37,18 +40,68 @@ bool DevLogReader::AdvanceTime(uint32_t timestep_ms)
 
 void DevLogReader::DiscoverLogFiles()
 {
-  _files.clear();
+  _allFiles.clear();
   if (Util::FileUtils::DirectoryExists(_directory))
   {
-    auto fileList = Util::FileUtils::FilesInDirectory(_directory, true, "log" );
-    for (const auto& file : fileList)
-    {
-      _files.push_back(file);
-    }
+    _allFiles = Util::FileUtils::FilesInDirectory(_directory, true, _extension.c_str() );
     
     // Even though files *might* be sorted alphabetically by the readdir call inside FilesInDirectory,
     // we can't rely on it so do it ourselves
-    std::sort(_files.begin(), _files.end());
+    std::sort(_allFiles.begin(), _allFiles.end());
+  }
+  _files.assign(_allFiles.begin(), _allFiles.end());
+}
+
+bool DevLogReader::OpenFrontFile()
+{
+  if (_files.empty())
+  {
+    return false;
+  }
+  
+  _currentLogFileHandle.open(_files.front());
+  if (!_currentLogFileHandle.good())
+  {
+    PRINT_NAMED_ERROR("DevLogReader.OpenFrontFile.FailBitSet",
+                      "Fail bit set on opening file %s",
+                      _files.front().c_str());
+  }
+  OnLogFileOpened();
+  return true;
+}
+
+void DevLogReader::SeekToTime(uint32_t time_ms)
+{
+  if (time_ms < _currTime_ms)
+  {
+    _currentLogFileHandle.close();
+    _files.assign(_allFiles.begin(), _allFiles.end());
+    _currentLogData = {};
+  }
+  _currTime_ms = time_ms;
+  
+  // Whatever we're holding on to is still to come
+  if (_currentLogData.IsValid() && _currentLogData._timestamp_ms >= time_ms)
+  {
+    return;
+  }
+  _currentLogData = {};
+  
+  while (_currentLogFileHandle.is_open() || OpenFrontFile())
+  {
+    SkipToTime(_currentLogFileHandle, time_ms);
+    while (FillLogData(_currentLogFileHandle, _currentLogData))
+    {
+      if (_currentLogData._timestamp_ms >= time_ms)
+      {
+        return;
+      }
+    }
+    
+    // Everything in this file was earlier, move on to the next
+    _currentLogData = {};
+    _currentLogFileHandle.close();
+    _files.pop_front();
   }
 }
 
@@ -75,20 +128,9 @@ void DevLogReader::Init()
 
 bool DevLogReader::UpdateForCurrentTime(uint32_t time_ms)
 {
-  if (!_currentLogFileHandle.is_open())
+  if (!_currentLogFileHandle.is_open() && !OpenFrontFile())
   {
-    if (_files.empty())
-    {
-      return false;
-    }
-    
-    _currentLogFileHandle.open(_files.front());
-    if (!_currentLogFileHandle.good())
-    {
-      PRINT_NAMED_ERROR("DevLogReader.UpdateForCurrentTime.FailBitSet",
-                        "Fail bit set on opening file %s",
-                        _files.front().c_str());
-    }
+    return false;
   }
   
   while (_currentLogFileHandle.good())
@@ -115,6 +157,7 @@ bool DevLogReader::UpdateForCurrentTime(uint32_t time_ms)
       }
       
       _currentLogFileHandle.open(_files.front());
+      OnLogFileOpened();
     }
     
     if (!_currentLogFileHandle.good())
@@ -26,7 +26,8 @@ namespace Vector {
 
 class DevLogReader: Util::noncopyable {
 public:
-  DevLogReader(const std::string& directory);
+  // reads the files in directory with the given extension, in name order
+  DevLogReader(const std::string& directory, const std::string& extension = "log");
   virtual ~DevLogReader() { }
   
   const std::string& GetDirectoryName() const { return _directory; }
@@ -36,6 +37,10 @@ public:
   // Move forward in time by number of milliseconds specified. Can trigger callbacks if they have been set
   // Returns whether there is more data in the logs to process
   bool AdvanceTime(uint32_t timestep_ms);
+
+  // Jump to the given playback time without calling back for anything before it. Going back in time starts over
+  // from the first file
+  void SeekToTime(uint32_t time_ms);
   
   struct LogData
   {
@@ -67,11 +72,20 @@ protected:
   // but must leave the stream in the same state it found it. Should return the final timestamp contained in
   // the log, or 0 if it can't process.
   virtual uint32_t GetFinalTimestamp_ms(std::ifstream& fileHandle) const { return 0; }
+
+  // called when seeking, before records older than time_ms are read out and dropped one by one. Readers that can
+  // tell where later data starts without reading everything in between can move the stream there
+  virtual void SkipToTime(std::ifstream& fileHandle, uint32_t time_ms) const { }
+
+  // called when a log file is (re)opened for reading, so readers can drop anything they kept from the last one
+  virtual void OnLogFileOpened() const { }
   
 
 private:
   std::string             _directory;
+  std::string             _extension;
   DataCallback            _dataCallback;
+  std::vector<std::string> _allFiles;
   std::deque<std::string> _files;
   uint32_t                _currTime_ms = 0;
   uint32_t                _finalTime_ms = 0;
@@ -79,6 +93,7 @@ private:
   LogData                 _currentLogData;
   
   void DiscoverLogFiles();
+  bool OpenFrontFile();
   bool UpdateForCurrentTime(uint32_t time_ms);
   bool ExtractAndCallback(uint32_t time_ms);
   bool CheckTimeAndCallback(uint32_t time_ms);
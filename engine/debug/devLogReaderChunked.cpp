@@ -0,0 +1,196 @@
+/**
+* File: devLogReaderChunked
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Functionality for pulling Raw data out of chunked log files
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#include "engine/debug/devLogReaderChunked.h"
+
+#include "engine/debug/devLogChunkWriter.h"
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+
+#include <cstring>
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  // Each record starts with its total size and timestamp, as in the raw logs
+  constexpr std::size_t kRecordMetaDataSize = sizeof(uint32_t) * 2;
+
+  // Chunks are sealed at DevLogChunkWriter::kChunkSize of records, so a payload claiming to be far bigger than that
+  // means the header is garbage
+  constexpr uint32_t kLargestReasonableChunkSize = 64 * DevLogChunkWriter::kChunkSize;
+}
+
+DevLogReaderChunked::DevLogReaderChunked(const std::string& directory)
+: DevLogReader(directory, DevLogChunkWriter::kFileExtension)
+{
+}
+
+bool DevLogReaderChunked::HasChunkedLogs(const std::string& directory)
+{
+  return !Util::FileUtils::FilesInDirectory(directory, false, DevLogChunkWriter::kFileExtension).empty();
+}
+
+void DevLogReaderChunked::SetTagFilter(const std::vector<uint8_t>& tags)
+{
+  _tagFilter = {};
+  for (const auto tag : tags)
+  {
+    DevLogChunk::AddTag(_tagFilter, tag);
+  }
+  _hasTagFilter = !tags.empty();
+}
+
+bool DevLogReaderChunked::IsWanted(const DevLogChunk::Header& header) const
+{
+  return !_hasTagFilter || DevLogChunk::HasAnyTag(header.tags, _tagFilter);
+}
+
+bool DevLogReaderChunked::ReadChunkHeader(std::ifstream& fileHandle, DevLogChunk::Header& header_out) const
+{
+  uint8_t headerBytes[DevLogChunk::kHeaderSize];
+  fileHandle.read(reinterpret_cast<char*>(headerBytes), sizeof(headerBytes));
+  if (!fileHandle.good())
+  {
+    return false;
+  }
+
+  // Anything that isn't a chunk is the unused tail of a file the logger didn't get to close, so treat it as the end
+  if (!DevLogChunk::ReadHeader(headerBytes, header_out) ||
+      (header_out.storedSize > kLargestReasonableChunkSize) ||
+      (header_out.rawSize > kLargestReasonableChunkSize))
+  {
+    fileHandle.setstate(std::ios::eofbit);
+    return false;
+  }
+  return true;
+}
+
+bool DevLogReaderChunked::LoadChunk(std::ifstream& fileHandle, const DevLogChunk::Header& header) const
+{
+  std::vector<uint8_t> payload(header.storedSize);
+  fileHandle.read(reinterpret_cast<char*>(payload.data()), payload.size());
+  if (!fileHandle.good() || !DevLogChunk::ReadPayload(header, payload.data(), _records))
+  {
+    _records.clear();
+    _recordsOffset = 0;
+    return false;
+  }
+  _recordsOffset = 0;
+  _chunkLastTimestamp_ms = header.lastTimestamp_ms;
+  return true;
+}
+
+bool DevLogReaderChunked::FillLogData(std::ifstream& fileHandle, LogData& logData_out) const
+{
+  while (true)
+  {
+    if (_recordsOffset >= _records.size())
+    {
+      DevLogChunk::Header header;
+      if (!ReadChunkHeader(fileHandle, header))
+      {
+        return false;
+      }
+      if (!IsWanted(header))
+      {
+        fileHandle.seekg(header.storedSize, std::ios::cur);
+        continue;
+      }
+      if (!LoadChunk(fileHandle, header))
+      {
+        return false;
+      }
+      continue;
+    }
+
+    const uint8_t* record = _records.data() + _recordsOffset;
+    const std::size_t remaining = _records.size() - _recordsOffset;
+    uint32_t sizeInBytes = 0;
+    if (remaining >= kRecordMetaDataSize)
+    {
+      std::memcpy(&sizeInBytes, record, sizeof(sizeInBytes));
+    }
+
+    // The chunk checked out, so a record that doesn't fit in it means the data is bad. Bail on this file
+    const bool sizeMakesSense = (sizeInBytes > kRecordMetaDataSize) && (sizeInBytes <= remaining);
+    DEV_ASSERT(sizeMakesSense, "DevLogReaderChunked.FillLogData.InvalidSize");
+    if (!sizeMakesSense)
+    {
+      _records.clear();
+      _recordsOffset = 0;
+      return false;
+    }
+    _recordsOffset += sizeInBytes;
+
+    const uint8_t* data = record + kRecordMetaDataSize;
+    if (_hasTagFilter && !DevLogChunk::HasTag(_tagFilter, data[0]))
+    {
+      continue;
+    }
+
+    std::memcpy(&logData_out._timestamp_ms, record + sizeof(sizeInBytes), sizeof(logData_out._timestamp_ms));
+    logData_out._data.assign(data, record + sizeInBytes);
+    return true;
+  }
+}
+
+void DevLogReaderChunked::OnLogFileOpened() const
+{
+  _records.clear();
+  _recordsOffset = 0;
+}
+
+void DevLogReaderChunked::SkipToTime(std::ifstream& fileHandle, uint32_t time_ms) const
+{
+  // What's left of the current chunk may still be to come
+  if ((_recordsOffset < _records.size()) && (_chunkLastTimestamp_ms >= time_ms))
+  {
+    return;
+  }
+  _records.clear();
+  _recordsOffset = 0;
+
+  DevLogChunk::Header header;
+  while (ReadChunkHeader(fileHandle, header))
+  {
+    if ((header.lastTimestamp_ms >= time_ms) && IsWanted(header))
+    {
+      LoadChunk(fileHandle, header);
+      return;
+    }
+    fileHandle.seekg(header.storedSize, std::ios::cur);
+  }
+}
+
+uint32_t DevLogReaderChunked::GetFinalTimestamp_ms(std::ifstream& fileHandle) const
+{
+  if (!fileHandle.good())
+  {
+    return 0;
+  }
+
+  // Hop from header to header, then put the stream back where it was
+  const auto startPosition = fileHandle.tellg();
+  uint32_t finalTimestamp_ms = 0;
+  DevLogChunk::Header header;
+  while (ReadChunkHeader(fileHandle, header))
+  {
+    finalTimestamp_ms = header.lastTimestamp_ms;
+    fileHandle.seekg(header.storedSize, std::ios::cur);
+  }
+  fileHandle.clear();
+  fileHandle.seekg(startPosition);
+  return finalTimestamp_ms;
+}
+
+} // end namespace Vector
+} // end namespace Anki
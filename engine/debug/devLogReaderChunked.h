@@ -0,0 +1,63 @@
+/**
+* File: devLogReaderChunked
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Functionality for pulling Raw data out of chunked log files (see devLogChunk.h). Seeking and
+*              filtering by message tag skip whole chunks by their headers, without decompressing them
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#ifndef __Cozmo_Basestation_Debug_DevLogReaderChunked_H_
+#define __Cozmo_Basestation_Debug_DevLogReaderChunked_H_
+
+#include "engine/debug/devLogChunk.h"
+#include "engine/debug/devLogReader.h"
+
+namespace Anki {
+namespace Vector {
+
+class DevLogReaderChunked: public DevLogReader {
+public:
+  DevLogReaderChunked(const std::string& directory);
+
+  // Returns true if directory holds chunked logs, rather than raw ones
+  static bool HasChunkedLogs(const std::string& directory);
+
+  // Only call back with messages whose tag (first byte) is one of these. Empty means all of them
+  void SetTagFilter(const std::vector<uint8_t>& tags);
+
+protected:
+  // Extract next record out of the current chunk, reading the next chunk from the file handle if needed
+  // Returns success
+  virtual bool FillLogData(std::ifstream& fileHandle, LogData& logData_out) const override;
+
+  virtual uint32_t GetFinalTimestamp_ms(std::ifstream& fileHandle) const override;
+
+  virtual void SkipToTime(std::ifstream& fileHandle, uint32_t time_ms) const override;
+
+  virtual void OnLogFileOpened() const override;
+
+private:
+  // Reads the next header, returns false at the end of the file
+  bool ReadChunkHeader(std::ifstream& fileHandle, DevLogChunk::Header& header_out) const;
+  // Reads the payload of the chunk whose header was just read into the record buffer
+  bool LoadChunk(std::ifstream& fileHandle, const DevLogChunk::Header& header) const;
+  bool IsWanted(const DevLogChunk::Header& header) const;
+
+  DevLogChunk::TagSet           _tagFilter{};
+  bool                          _hasTagFilter = false;
+
+  // The records of the current chunk, and where the next one starts
+  mutable std::vector<uint8_t>  _records;
+  mutable std::size_t           _recordsOffset = 0;
+  mutable uint32_t              _chunkLastTimestamp_ms = 0;
+};
+
+} // end namespace Vector
+} // end namespace Anki
+
+
+#endif //__Cozmo_Basestation_Debug_DevLogReaderChunked_H_
@@ -11,6 +11,7 @@
 */
 #include "engine/debug/devLoggingSystem.h"
 #include "engine/debug/devLoggerProvider.h"
+#include "engine/debug/devLogChunkWriter.h"
 #include "engine/util/file/archiveUtil.h"
 #include "coretech/common/engine/jsonTools.h"
 #include "clad/externalInterface/messageEngineToGame.h"
@@ -103,11 +104,11 @@ DevLoggingSystem::DevLoggingSystem(const std::string& baseDirectory, const std::
   ArchiveDirectories(_allLogsBaseDirectory, {appRunTimeString} );
   
   _devLoggingBaseDirectory = Util::FileUtils::FullFilePath({_allLogsBaseDirectory, appRunTimeString});
-  _gameToEngineLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kGameToEngineName})));
-  _engineToGameLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToGameName})));
-  _robotToEngineLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kRobotToEngineName})));
-  _engineToRobotLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToRobogName})));
-  _engineToVizLog.reset(new Util::RollingFileLogger(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToVizName})));
+  _gameToEngineLog.reset(new DevLogChunkWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kGameToEngineName})));
+  _engineToGameLog.reset(new DevLogChunkWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToGameName})));
+  _robotToEngineLog.reset(new DevLogChunkWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kRobotToEngineName})));
+  _engineToRobotLog.reset(new DevLogChunkWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToRobogName})));
+  _engineToVizLog.reset(new DevLogChunkWriter(_queue, Util::FileUtils::FullFilePath({_devLoggingBaseDirectory, kEngineToVizName})));
 
   // write apprun file
   CreateAppRunFile(appRunTimeString, appRunId);
@@ -181,7 +182,7 @@ void DevLoggingSystem::ArchiveDirectories(const std::string& baseDirectory, cons
 
 void DevLoggingSystem::ArchiveOneDirectory(const std::string& baseDirectory)
 {
-  auto filePaths = Util::FileUtils::FilesInDirectory(baseDirectory, true, {Util::RollingFileLogger::kDefaultFileExtension, kAppRunExtension.c_str(), kWavFileExtension.c_str(), kLogFileExtension.c_str()}, true);
+  auto filePaths = Util::FileUtils::FilesInDirectory(baseDirectory, true, {Util::RollingFileLogger::kDefaultFileExtension, DevLogChunkWriter::kFileExtension, kAppRunExtension.c_str(), kWavFileExtension.c_str(), kLogFileExtension.c_str()}, true);
   ArchiveUtil::CreateArchiveFromFiles(baseDirectory + kArchiveExtensionString, baseDirectory, filePaths);
 }
 
@@ -269,12 +270,19 @@ void DevLoggingSystem::DeleteLog(const std::string& archiveFilename) const
 
 DevLoggingSystem::~DevLoggingSystem()
 {
+  // The logs write out their last chunks on the queue, so they go first
+  _gameToEngineLog.reset();
+  _engineToGameLog.reset();
+  _robotToEngineLog.reset();
+  _engineToRobotLog.reset();
+  _engineToVizLog.reset();
+
   Util::Dispatch::Stop(_queue);
   Util::Dispatch::Release(_queue);
 }
 
 template<typename MsgType>
-std::string DevLoggingSystem::PrepareMessage(const MsgType& message) const
+std::string DevLoggingSystem::PrepareMessage(const MsgType& message, uint32_t timestamp_ms) const
 {
   // We want to repackage the clad messages with some extra information at the start
   // We'll add 4 bytes to hold the size and another 4 for the timestamp
@@ -290,13 +298,21 @@ std::string DevLoggingSystem::PrepareMessage(const MsgType& message) const
   data += sizeof(uint32_t);
   
   // Then write in the timestamp as a millisecond count since the app started running
-  *((uint32_t*)data) = GetAppRunMilliseconds();
+  *((uint32_t*)data) = timestamp_ms;
   data += sizeof(uint32_t);
   
   message.Pack(data, messageSize);
   
   return std::string(reinterpret_cast<char*>(messageVector.data()), totalSize);
 }
+
+template<typename MsgType>
+void DevLoggingSystem::WriteMessage(DevLogChunkWriter& log, const MsgType& message) const
+{
+  // Chunks are indexed by the message tags in them, so replay can go straight to the ones it wants
+  const uint32_t timestamp_ms = GetAppRunMilliseconds();
+  log.Write(static_cast<uint8_t>(message.GetTag()), timestamp_ms, PrepareMessage(message, timestamp_ms));
+}
   
 uint32_t DevLoggingSystem::GetAppRunMilliseconds()
 {
@@ -315,7 +331,7 @@ void DevLoggingSystem::LogMessage(const ExternalInterface::MessageEngineToGame&
   }
 
   ANKI_CPU_PROFILE("LogMessage_EToG");
-  _engineToGameLog->Write(PrepareMessage(message));
+  WriteMessage(*_engineToGameLog, message);
 }
   
 template<>
@@ -328,14 +344,14 @@ void DevLoggingSystem::LogMessage(const ExternalInterface::MessageGameToEngine&
   }
   
   ANKI_CPU_PROFILE("LogMessage_GToE");
-  _gameToEngineLog->Write(PrepareMessage(message));
+  WriteMessage(*_gameToEngineLog, message);
 }
 
 template<>
 void DevLoggingSystem::LogMessage(const RobotInterface::EngineToRobot& message)
 {
   ANKI_CPU_PROFILE("LogMessage_EToR");
-  _engineToRobotLog->Write(PrepareMessage(message));
+  WriteMessage(*_engineToRobotLog, message);
 }
 
 template<>
@@ -348,7 +364,7 @@ void DevLoggingSystem::LogMessage(const RobotInterface::RobotToEngine& message)
   }
   
   ANKI_CPU_PROFILE("LogMessage_RToE");
-  _robotToEngineLog->Write(PrepareMessage(message));
+  WriteMessage(*_robotToEngineLog, message);
 }
     
 template<>
@@ -364,7 +380,7 @@ void DevLoggingSystem::LogMessage(const VizInterface::MessageViz& message)
   }
     
   ANKI_CPU_PROFILE("LogMessage_Viz");
-  _engineToVizLog->Write(PrepareMessage(message));
+  WriteMessage(*_engineToVizLog, message);
 }
 
 } // end namespace Vector
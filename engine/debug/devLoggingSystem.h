@@ -27,6 +27,9 @@ namespace Anki {
   namespace Util {
     class ILoggerProvider;
   }
+  namespace Vector {
+    class DevLogChunkWriter;
+  }
 }
 
 namespace Anki {
@@ -84,11 +87,11 @@ private:
   static const std::string kLogFileExtension;
 
   Util::Dispatch::Queue*                      _queue;
-  std::unique_ptr<Util::RollingFileLogger>    _gameToEngineLog;
-  std::unique_ptr<Util::RollingFileLogger>    _engineToGameLog;
-  std::unique_ptr<Util::RollingFileLogger>    _robotToEngineLog;
-  std::unique_ptr<Util::RollingFileLogger>    _engineToRobotLog;
-  std::unique_ptr<Util::RollingFileLogger>    _engineToVizLog;
+  std::unique_ptr<DevLogChunkWriter>          _gameToEngineLog;
+  std::unique_ptr<DevLogChunkWriter>          _engineToGameLog;
+  std::unique_ptr<DevLogChunkWriter>          _robotToEngineLog;
+  std::unique_ptr<DevLogChunkWriter>          _engineToRobotLog;
+  std::unique_ptr<DevLogChunkWriter>          _engineToVizLog;
 
   std::string _allLogsBaseDirectory;
   std::string _devLoggingBaseDirectory;
@@ -102,7 +105,10 @@ private:
   static void ArchiveOneDirectory(const std::string& baseDirectory);
 
   template<typename MsgType>
-  std::string PrepareMessage(const MsgType& message) const;
+  std::string PrepareMessage(const MsgType& message, uint32_t timestamp_ms) const;
+
+  template<typename MsgType>
+  void WriteMessage(DevLogChunkWriter& log, const MsgType& message) const;
   
   void CreateAppRunFile(const std::string& appRunTimeString, const std::string& appRunId);
 };
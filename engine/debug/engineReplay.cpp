@@ -0,0 +1,294 @@
+/**
+* File: engineReplay
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Headless replay of a recorded dev log through the engine
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#include "engine/debug/engineReplay.h"
+
+#include "engine/cozmoContext.h"
+#include "engine/debug/devLoggingSystem.h"
+#include "engine/debug/devLogReaderChunked.h"
+#include "engine/debug/devLogReaderRaw.h"
+#include "engine/externalInterface/externalInterface.h"
+#include "engine/robot.h"
+#include "engine/robotInterface/messageHandler.h"
+#include "engine/robotManager.h"
+
+#include "anki/cozmo/shared/cozmoEngineConfig.h"
+#include "clad/externalInterface/messageGameToEngine.h"
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "json/json.h"
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+
+#include <algorithm>
+
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+#define LOG_CHANNEL "EngineReplay"
+
+namespace Anki {
+namespace Vector {
+
+const char* const EngineReplay::kConfigKey = "replay";
+
+namespace {
+  const char* const kDefaultReportFile = "replayReport.json";
+
+  // Logs made before chunking are still raw
+  std::unique_ptr<DevLogReader> MakeReader(const std::string& directory)
+  {
+    std::unique_ptr<DevLogReader> reader;
+    if (DevLogReaderChunked::HasChunkedLogs(directory))
+    {
+      reader.reset(new DevLogReaderChunked(directory));
+    }
+    else
+    {
+      reader.reset(new DevLogReaderRaw(directory));
+    }
+    reader->Init();
+    return reader;
+  }
+
+  size_t GetHeapBytesInUse()
+  {
+#if defined(__GLIBC__)
+  #if __GLIBC_PREREQ(2, 33)
+    const struct mallinfo2 info = mallinfo2();
+  #else
+    const struct mallinfo info = mallinfo();
+  #endif
+    // small allocations from the arenas plus the big ones mmapped on their own
+    return static_cast<size_t>(info.uordblks) + static_cast<size_t>(info.hblkhd);
+#else
+    return 0;
+#endif
+  }
+
+  float Percentile(const std::vector<float>& sortedValues, float fraction)
+  {
+    if (sortedValues.empty())
+    {
+      return 0.f;
+    }
+    const size_t index = std::min(sortedValues.size() - 1, static_cast<size_t>(fraction * sortedValues.size()));
+    return sortedValues[index];
+  }
+
+  double ToMilliseconds(std::chrono::steady_clock::duration duration)
+  {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  }
+}
+
+bool EngineReplay::IsReplayConfig(const Json::Value& engineConfig)
+{
+  return engineConfig.isObject() && engineConfig.isMember(kConfigKey);
+}
+
+bool EngineReplay::RunsAtMaxSpeed(const Json::Value& engineConfig)
+{
+  return IsReplayConfig(engineConfig) && (engineConfig[kConfigKey].get("speed", "recorded").asString() == "max");
+}
+
+uint32_t EngineReplay::GetRandomSeed(const Json::Value& engineConfig)
+{
+  return IsReplayConfig(engineConfig) ? engineConfig[kConfigKey].get("seed", 1).asUInt() : 0;
+}
+
+EngineReplay::EngineReplay(const CozmoContext* context, const Json::Value& engineConfig)
+: _context(context)
+{
+  const Json::Value& config = engineConfig[kConfigKey];
+  _directory = config.get("directory", "").asString();
+  _reportFile = config.get("reportFile", "").asString();
+
+  if (!Util::FileUtils::DirectoryExists(_directory))
+  {
+    LOG_ERROR("EngineReplay.Constructor.InvalidDirectory", "Directory '%s' not found", _directory.c_str());
+    return;
+  }
+
+  _robotToEngineReader = MakeReader(Util::FileUtils::FullFilePath({_directory, DevLoggingSystem::kRobotToEngineName}));
+  _robotToEngineReader->SetDataCallback([this](const DevLogReader::LogData& logData) {
+    ++_numRobotToEngine;
+    _context->GetRobotManager()->GetMsgHandler()->QueueReplayedMessage(logData._data);
+  });
+
+  // Most logs have app messages too, but a replay of just the robot is still worth having
+  const std::string gameToEngineDirectory = Util::FileUtils::FullFilePath({_directory, DevLoggingSystem::kGameToEngineName});
+  if (Util::FileUtils::DirectoryExists(gameToEngineDirectory))
+  {
+    _gameToEngineReader = MakeReader(gameToEngineDirectory);
+    _gameToEngineReader->SetDataCallback([this](const DevLogReader::LogData& logData) {
+      HandleGameToEngine(logData._data);
+    });
+  }
+
+  LOG_INFO("EngineReplay.Constructor", "Replaying '%s' (%u ms) at %s speed",
+           _directory.c_str(), _robotToEngineReader->GetFinalTime(), RunsAtMaxSpeed(engineConfig) ? "max" : "recorded");
+}
+
+EngineReplay::~EngineReplay() = default;
+
+void EngineReplay::Start()
+{
+  _context->GetRobotManager()->GetMsgHandler()->StartReplay();
+  _replayStart = Clock::now();
+  _startHeapBytes = GetHeapBytesInUse();
+  _peakHeapBytes = _startHeapBytes;
+  _startUnpackAllocations = _context->GetRobotManager()->GetMsgHandler()->GetNumUnpackedMessageAllocations();
+}
+
+bool EngineReplay::FeedNextTick()
+{
+  _virtualTime_ms += BS_TIME_STEP_MS;
+
+  bool anyMoreMessages = _robotToEngineReader->AdvanceTime(BS_TIME_STEP_MS);
+  if (_gameToEngineReader != nullptr)
+  {
+    anyMoreMessages |= _gameToEngineReader->AdvanceTime(BS_TIME_STEP_MS);
+  }
+  return anyMoreMessages;
+}
+
+BaseStationTime_t EngineReplay::GetVirtualTime_nanosec() const
+{
+  return static_cast<BaseStationTime_t>(_virtualTime_ms) * 1000 * 1000;
+}
+
+void EngineReplay::HandleGameToEngine(const std::vector<uint8_t>& data)
+{
+  ExternalInterface::MessageGameToEngine message;
+  if (data.empty() || (message.Unpack(data.data(), data.size()) != data.size()))
+  {
+    ++_numBadGameToEngine;
+    return;
+  }
+  ++_numGameToEngine;
+  _context->GetExternalInterface()->Broadcast(std::move(message));
+}
+
+void EngineReplay::BeginTick()
+{
+  _tickStart = Clock::now();
+  _tickStartHeapBytes = GetHeapBytesInUse();
+}
+
+void EngineReplay::EndTick()
+{
+  _tickDurations_ms.push_back(static_cast<float>(ToMilliseconds(Clock::now() - _tickStart)));
+
+  const size_t heapBytes = GetHeapBytesInUse();
+  _peakHeapBytes = std::max(_peakHeapBytes, heapBytes);
+  _maxTickHeapGrowth = std::max(_maxTickHeapGrowth,
+                                static_cast<int64_t>(heapBytes) - static_cast<int64_t>(_tickStartHeapBytes));
+
+  // Components are timed from the second tick on, so the first one (the costliest, as everything warms up) is left out
+  if (!_componentTimingEnabled)
+  {
+    Robot* robot = _context->GetRobotManager()->GetRobot();
+    if (robot != nullptr)
+    {
+      robot->SetComponentUpdateTimingEnabled(true);
+      _componentTimingEnabled = true;
+    }
+  }
+}
+
+Json::Value EngineReplay::BuildReport() const
+{
+  Json::Value report;
+  report["directory"] = _directory;
+  report["numTicks"] = static_cast<Json::UInt64>(_tickDurations_ms.size());
+  report["virtualTime_ms"] = _virtualTime_ms;
+  report["wallTime_ms"] = ToMilliseconds(Clock::now() - _replayStart);
+
+  std::vector<float> sortedTicks_ms = _tickDurations_ms;
+  std::sort(sortedTicks_ms.begin(), sortedTicks_ms.end());
+  double totalTicks_ms = 0.0;
+  for (const float tick_ms : sortedTicks_ms)
+  {
+    totalTicks_ms += tick_ms;
+  }
+  Json::Value& ticks = report["tick_ms"];
+  ticks["mean"] = sortedTicks_ms.empty() ? 0.0 : (totalTicks_ms / sortedTicks_ms.size());
+  ticks["p50"] = Percentile(sortedTicks_ms, 0.5f);
+  ticks["p90"] = Percentile(sortedTicks_ms, 0.9f);
+  ticks["p99"] = Percentile(sortedTicks_ms, 0.99f);
+  ticks["max"] = sortedTicks_ms.empty() ? 0.f : sortedTicks_ms.back();
+  ticks["numOverBudget"] = static_cast<Json::UInt64>(
+    sortedTicks_ms.end() - std::upper_bound(sortedTicks_ms.begin(), sortedTicks_ms.end(), (float)BS_TIME_STEP_MS));
+
+  // Costliest first
+  Robot* robot = _context->GetRobotManager()->GetRobot();
+  if (robot != nullptr)
+  {
+    const auto times = robot->GetComponentUpdateTimes();
+    std::vector<std::pair<RobotComponentID, std::chrono::steady_clock::duration>> sortedTimes(times.begin(), times.end());
+    std::sort(sortedTimes.begin(), sortedTimes.end(), [](const auto& lhs, const auto& rhs) {
+      return lhs.second > rhs.second;
+    });
+    const size_t numTimedTicks = (_tickDurations_ms.size() > 1) ? (_tickDurations_ms.size() - 1) : 1;
+    Json::Value& components = report["components"];
+    for (const auto& entry : sortedTimes)
+    {
+      Json::Value component;
+      component["name"] = GetComponentStringForID<RobotComponentID>(entry.first);
+      component["total_ms"] = ToMilliseconds(entry.second);
+      component["perTick_ms"] = ToMilliseconds(entry.second) / numTimedTicks;
+      components.append(component);
+    }
+  }
+
+  Json::Value& heap = report["heap"];
+  const size_t endHeapBytes = GetHeapBytesInUse();
+  heap["startBytes"] = static_cast<Json::UInt64>(_startHeapBytes);
+  heap["endBytes"] = static_cast<Json::UInt64>(endHeapBytes);
+  heap["peakBytes"] = static_cast<Json::UInt64>(_peakHeapBytes);
+  heap["maxTickGrowthBytes"] = static_cast<Json::Int64>(_maxTickHeapGrowth);
+  heap["unpackedMessageAllocations"] = _context->GetRobotManager()->GetMsgHandler()->GetNumUnpackedMessageAllocations() -
+                                       _startUnpackAllocations;
+
+  Json::Value& messages = report["messages"];
+  messages["robotToEngine"] = _numRobotToEngine;
+  messages["gameToEngine"] = _numGameToEngine;
+  messages["badGameToEngine"] = _numBadGameToEngine;
+
+  return report;
+}
+
+void EngineReplay::Finish()
+{
+  const Json::Value report = BuildReport();
+
+  const auto* dataPlatform = _context->GetDataPlatform();
+  const bool written = _reportFile.empty() ?
+                       dataPlatform->writeAsJson(Util::Data::Scope::Cache, kDefaultReportFile, report) :
+                       dataPlatform->writeAsJson(_reportFile, report);
+  if (!written)
+  {
+    LOG_ERROR("EngineReplay.Finish.WriteFailed", "Could not write the replay report");
+  }
+
+  const Json::Value& ticks = report["tick_ms"];
+  LOG_INFO("EngineReplay.Finish", "%u ticks in %.0f ms: mean %.2f, p50 %.2f, p90 %.2f, p99 %.2f, max %.2f ms. "
+           "Heap %llu -> %llu bytes (peak %llu)",
+           report["numTicks"].asUInt(), report["wallTime_ms"].asDouble(), ticks["mean"].asDouble(),
+           ticks["p50"].asDouble(), ticks["p90"].asDouble(), ticks["p99"].asDouble(), ticks["max"].asDouble(),
+           (unsigned long long)report["heap"]["startBytes"].asUInt64(),
+           (unsigned long long)report["heap"]["endBytes"].asUInt64(),
+           (unsigned long long)report["heap"]["peakBytes"].asUInt64());
+}
+
+} // end namespace Vector
+} // end namespace Anki
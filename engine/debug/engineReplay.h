@@ -0,0 +1,106 @@
+/**
+* File: engineReplay
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Headless replay of a recorded dev log through the engine, for comparing performance between builds.
+*              Recorded messages from the robot and the app are fed in on a virtual clock that moves by exactly one
+*              tick per engine update, so every run sees the same input on the same ticks whatever the hardware.
+*              Times each tick, each robot component and heap use, and writes a report when the log runs out.
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+#ifndef __Cozmo_Basestation_Debug_EngineReplay_H_
+#define __Cozmo_Basestation_Debug_EngineReplay_H_
+
+#include "coretech/common/shared/types.h"
+#include "engine/robotComponents_fwd.h"
+#include "util/helpers/noncopyable.h"
+
+#include "json/json-forwards.h"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class CozmoContext;
+class DevLogReader;
+
+class EngineReplay : Util::noncopyable {
+public:
+  // Member of the engine config that turns on replay. It holds:
+  //  "directory":  the dev log to replay (the directory holding robotToEngine, gameToEngine and so on)
+  //  "speed":      "recorded" (default) ticks the engine at its usual rate, "max" ticks it back to back. The engine
+  //                clock is virtual either way, so this only changes how long the replay takes
+  //  "seed":       random seed, so behaviors make the same choices on every run (default 1)
+  //  "reportFile": where the report goes, defaults to replayReport.json in the cache
+  static const char* const kConfigKey;
+
+  static bool IsReplayConfig(const Json::Value& engineConfig);
+  static bool RunsAtMaxSpeed(const Json::Value& engineConfig);
+  static uint32_t GetRandomSeed(const Json::Value& engineConfig);
+
+  EngineReplay(const CozmoContext* context, const Json::Value& engineConfig);
+  ~EngineReplay();
+
+  // False if there's nothing to replay
+  bool IsValid() const { return _robotToEngineReader != nullptr; }
+
+  // Called once the robot exists. Switches the robot message handler over to the recording
+  void Start();
+
+  // Moves the virtual clock on by one tick and hands the engine everything recorded up to then. Returns false once
+  // the recording has run out
+  bool FeedNextTick();
+  BaseStationTime_t GetVirtualTime_nanosec() const;
+
+  // Bracket each replayed engine update
+  void BeginTick();
+  void EndTick();
+
+  // Writes the report and logs a summary of it
+  void Finish();
+
+private:
+  void HandleGameToEngine(const std::vector<uint8_t>& data);
+  Json::Value BuildReport() const;
+
+  const CozmoContext*           _context;
+  std::string                   _directory;
+  std::string                   _reportFile;
+
+  std::unique_ptr<DevLogReader> _robotToEngineReader;
+  std::unique_ptr<DevLogReader> _gameToEngineReader;
+
+  uint32_t                      _virtualTime_ms = 0;
+  uint32_t                      _numRobotToEngine = 0;
+  uint32_t                      _numGameToEngine = 0;
+  uint32_t                      _numBadGameToEngine = 0;
+
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point             _replayStart;
+  Clock::time_point             _tickStart;
+  std::vector<float>            _tickDurations_ms;
+  bool                          _componentTimingEnabled = false;
+
+  // Heap bytes in use, from the C library's allocator statistics
+  size_t                        _tickStartHeapBytes = 0;
+  size_t                        _startHeapBytes = 0;
+  size_t                        _peakHeapBytes = 0;
+  int64_t                       _maxTickHeapGrowth = 0;
+  uint32_t                      _startUnpackAllocations = 0;
+};
+
+} // end namespace Vector
+} // end namespace Anki
+
+
+#endif //__Cozmo_Basestation_Debug_EngineReplay_H_
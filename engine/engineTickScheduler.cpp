@@ -0,0 +1,200 @@
+/**
+ * File: engineTickScheduler.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-15
+ *
+ * Description: Paces the engine tick and spreads low-rate work across ticks.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "engine/engineTickScheduler.h"
+
+#include "util/cpuProfiler/cpuProfiler.h"
+#include "util/logging/logging.h"
+
+#include <poll.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+#define LOG_CHANNEL "EngineTickScheduler"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  uint32_t GreatestCommonDivisor(uint32_t a, uint32_t b)
+  {
+    while (b != 0) {
+      const uint32_t r = a % b;
+      a = b;
+      b = r;
+    }
+    return a;
+  }
+}
+
+EngineTickScheduler::EngineTickScheduler(uint32_t tickPeriod_ms)
+: _tickPeriod_ms(std::max(tickPeriod_ms, 1u))
+{
+}
+
+EngineTickScheduler::TaskHandle EngineTickScheduler::RegisterTask(const std::string& name, float rate_hz, TaskFunc&& func)
+{
+  DEV_ASSERT(!_isRunningTasks, "EngineTickScheduler.RegisterTask.CalledFromTask");
+  DEV_ASSERT(func != nullptr, "EngineTickScheduler.RegisterTask.NullFunc");
+
+  uint32_t period_ticks = 1;
+  if (rate_hz > 0.f) {
+    const float period_ms = 1000.f / rate_hz;
+    period_ticks = static_cast<uint32_t>(std::max(1.f, std::round(period_ms / _tickPeriod_ms)));
+  }
+
+  Task task;
+  task.name = name;
+  task.func = std::move(func);
+  task.handle = _nextHandle++;
+  task.period_ticks = period_ticks;
+  // Counted from the next tick, so that a new task does not wait a whole period for its first run
+  task.phase = (period_ticks > 1) ? static_cast<uint32_t>((PickPhase(period_ticks) + _tickCount) % period_ticks) : 0;
+  _tasks.push_back(std::move(task));
+
+  LOG_DEBUG("EngineTickScheduler.RegisterTask", "%s every %u ticks at phase %u",
+            name.c_str(), period_ticks, _tasks.back().phase);
+
+  return _tasks.back().handle;
+}
+
+void EngineTickScheduler::UnregisterTask(TaskHandle handle)
+{
+  auto it = std::find_if(_tasks.begin(), _tasks.end(), [handle](const Task& task) { return task.handle == handle; });
+  if (it == _tasks.end()) {
+    return;
+  }
+  if (_isRunningTasks) {
+    // Erased once RunDueTasks() is done with the list, since the task may be the one running
+    it->isRemoved = true;
+  } else {
+    _tasks.erase(it);
+  }
+}
+
+void EngineTickScheduler::RunDueTasks()
+{
+  ANKI_CPU_PROFILE("EngineTickScheduler::RunDueTasks");
+
+  _isRunningTasks = true;
+  for (const auto& task : _tasks) {
+    if (!task.isRemoved && ((_tickCount % task.period_ticks) == task.phase)) {
+      task.func();
+    }
+  }
+  _isRunningTasks = false;
+
+  _tasks.erase(std::remove_if(_tasks.begin(), _tasks.end(), [](const Task& task) { return task.isRemoved; }),
+               _tasks.end());
+  ++_tickCount;
+}
+
+uint32_t EngineTickScheduler::GetTaskPeriod_ticks(TaskHandle handle) const
+{
+  const Task* task = FindTask(handle);
+  return (task != nullptr) ? task->period_ticks : 0;
+}
+
+uint32_t EngineTickScheduler::GetTaskPhase(TaskHandle handle) const
+{
+  const Task* task = FindTask(handle);
+  return (task != nullptr) ? task->phase : 0;
+}
+
+uint32_t EngineTickScheduler::PickPhase(uint32_t period_ticks) const
+{
+  // Phases are relative to the next tick. Two tasks with periods P and Q run on the same tick every so often iff
+  // their phases are equal modulo gcd(P, Q), so count those collisions for each candidate phase
+  const uint64_t nextTick = _tickCount;
+  uint32_t bestPhase = 0;
+  size_t bestCollisions = std::numeric_limits<size_t>::max();
+  for (uint32_t phase = 0; phase < period_ticks; ++phase) {
+    size_t collisions = 0;
+    for (const auto& task : _tasks) {
+      if (task.isRemoved || (task.period_ticks == 1)) {
+        continue;
+      }
+      const uint32_t gcd = GreatestCommonDivisor(period_ticks, task.period_ticks);
+      const uint32_t taskPhase = static_cast<uint32_t>((task.phase + task.period_ticks - (nextTick % task.period_ticks)) % task.period_ticks);
+      if ((phase % gcd) == (taskPhase % gcd)) {
+        ++collisions;
+      }
+    }
+    if (collisions < bestCollisions) {
+      bestCollisions = collisions;
+      bestPhase = phase;
+    }
+  }
+  return bestPhase;
+}
+
+const EngineTickScheduler::Task* EngineTickScheduler::FindTask(TaskHandle handle) const
+{
+  auto it = std::find_if(_tasks.begin(), _tasks.end(), [handle](const Task& task) { return task.handle == handle; });
+  return (it != _tasks.end()) ? &(*it) : nullptr;
+}
+
+bool EngineTickScheduler::WaitForNextTick(const Clock::time_point& earliest,
+                                          const Clock::time_point& deadline,
+                                          const std::function<bool()>& onReadable)
+{
+  using namespace std::chrono;
+
+  bool isUrgent = false;
+  bool isWatching = (_wakeSocket >= 0) && (onReadable != nullptr);
+  while (true) {
+    const auto now = Clock::now();
+    if (isUrgent && (now >= earliest)) {
+      ++_numEarlyTicks;
+      return true;
+    }
+    if (now >= deadline) {
+      return false;
+    }
+
+    const auto until = isUrgent ? std::min(earliest, deadline) : deadline;
+    if (!isWatching || isUrgent) {
+      std::this_thread::sleep_for(until - now);
+      continue;
+    }
+
+    // poll() only takes whole milliseconds, so round up rather than spin on the last partial one
+    const auto remaining_us = duration_cast<microseconds>(until - now).count();
+    const int timeout_ms = static_cast<int>((remaining_us + 999) / 1000);
+
+    struct pollfd pfd;
+    pfd.fd = _wakeSocket;
+    pfd.events = POLLIN;
+    pfd.revents = 0;
+    const int ret = poll(&pfd, 1, timeout_ms);
+    if (ret < 0) {
+      if (errno != EINTR) {
+        LOG_WARNING("EngineTickScheduler.WaitForNextTick.PollFailed", "errno %d, sleeping out the tick", errno);
+        isWatching = false;
+      }
+    } else if (ret > 0) {
+      if (pfd.revents & POLLIN) {
+        isUrgent = onReadable();
+      } else {
+        // Hung up or errored. The next tick will notice; until then just sleep
+        isWatching = false;
+      }
+    }
+  }
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,103 @@
+/**
+ * File: engineTickScheduler.h
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-15
+ *
+ * Description: Paces the engine tick and spreads low-rate work across ticks.
+ *
+ *              Components register tasks with the rate they actually need. Tasks at or above the tick rate run
+ *              every tick. Slower tasks run every N ticks, on the phase that shares ticks with the fewest other
+ *              slow tasks, so a handful of 1-5Hz tasks do not all land on the same tick.
+ *
+ *              Between ticks the engine waits in WaitForNextTick(). If a wake socket is set (the robot connection)
+ *              the wait also watches it, hands whatever arrives to a callback to receive, and starts the next tick
+ *              right away if the callback saw something urgent, such as a cliff, instead of sleeping out the tick.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Engine_EngineTickScheduler_H__
+#define __Engine_EngineTickScheduler_H__
+
+#include "util/helpers/noncopyable.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class EngineTickScheduler : private Util::noncopyable
+{
+public:
+  using Clock = std::chrono::steady_clock;
+  using TaskHandle = uint32_t;
+  using TaskFunc = std::function<void()>;
+
+  static constexpr TaskHandle kInvalidTaskHandle = 0;
+
+  // Pass to RegisterTask to run a task on every tick
+  static constexpr float kEveryTick = 0.f;
+
+  explicit EngineTickScheduler(uint32_t tickPeriod_ms);
+
+  // Runs func at about rate_hz from RunDueTasks(). Must not be called from within a task
+  TaskHandle RegisterTask(const std::string& name, float rate_hz, TaskFunc&& func);
+  void UnregisterTask(TaskHandle handle);
+
+  // Runs the tasks due this tick. Called once per engine tick
+  void RunDueTasks();
+
+  // Number of ticks between runs of the task, and which of those ticks it runs on
+  uint32_t GetTaskPeriod_ticks(TaskHandle handle) const;
+  uint32_t GetTaskPhase(TaskHandle handle) const;
+
+  // The socket to watch between ticks, or -1 for none. Only used from the engine thread
+  void SetWakeSocket(int socket) { _wakeSocket = socket; }
+
+  // Blocks until deadline. While waiting, each time the wake socket becomes readable onReadable is called (to
+  // receive what arrived, so the socket does not stay readable) and returns whether any of it was urgent. If it
+  // was, returns true once earliest has passed instead of waiting for the deadline.
+  bool WaitForNextTick(const Clock::time_point& earliest,
+                       const Clock::time_point& deadline,
+                       const std::function<bool()>& onReadable);
+
+  // Number of ticks WaitForNextTick() cut short
+  uint32_t GetNumEarlyTicks() const { return _numEarlyTicks; }
+
+private:
+
+  struct Task
+  {
+    std::string name;
+    TaskFunc    func;
+    TaskHandle  handle;
+    uint32_t    period_ticks;
+    uint32_t    phase;
+    bool        isRemoved = false;
+  };
+
+  // The phase for a new task with the given period that collides with the fewest registered tasks
+  uint32_t PickPhase(uint32_t period_ticks) const;
+
+  const Task* FindTask(TaskHandle handle) const;
+
+  const uint32_t    _tickPeriod_ms;
+  std::vector<Task> _tasks;
+  TaskHandle        _nextHandle = kInvalidTaskHandle + 1;
+  uint64_t          _tickCount = 0;
+  bool              _isRunningTasks = false;
+
+  int      _wakeSocket = -1;
+  uint32_t _numEarlyTicks = 0;
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Engine_EngineTickScheduler_H__
@@ -43,6 +43,13 @@ public:
   , _data( std::make_shared<DataType>(std::forward<FwdType>(newData)) )
   { }
 
+  // Shares data the caller already holds, instead of making a copy of it
+  AnkiEvent(double time, uint32_t type, std::shared_ptr<DataType> sharedData)
+  : _currentTime(time)
+  , _myType(type)
+  , _data( std::move(sharedData) )
+  { }
+
   double GetCurrentTime() const { return _currentTime; }
   uint32_t GetType() const { return _myType; }
   const DataType& GetData() const { return *_data; }
@@ -22,7 +22,10 @@
 #include "util/helpers/noncopyable.h"
 #include <stdint.h>
 #include <unordered_map>
+#include <utility>
 #include <functional>
+#include <memory>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
@@ -73,16 +76,77 @@ public:
   // Allows subscribing to events by type with the passed in function
   Signal::SmartHandle Subscribe(const uint32_t type, SubscriberFunction<DataType> function)
   {
-    return this->_eventHandlerMap[type].ScopedSubscribe(function);
+    return this->_eventHandlerMap[type].ScopedSubscribe(std::move(function));
   }
   
   void SubscribeForever(const uint32_t type, SubscriberFunction<DataType> function)
   {
-    this->_eventHandlerMap[type].SubscribeForever(function);
+    this->_eventHandlerMap[type].SubscribeForever(std::move(function));
   }
 }; // class AnkiEventMgr
 
 
+/**
+ *      Variation for events whose types are a small, dense range starting at zero, like CLAD union tags. Broadcast
+ *      indexes a flat table by type instead of hashing it, and HasSubscribers lets callers skip building an event
+ *      nobody is listening for. Signals are held by pointer because subscription handles keep the signal's address.
+ *
+*/
+template<typename DataType>
+class AnkiDenseEventMgr : private Util::noncopyable
+{
+public:
+  using EventDataType = AnkiEvent<DataType>;
+
+  // Broadcasts a given event to everyone that has subscribed to that event type
+  void Broadcast(const EventDataType& event)
+  {
+    const uint32_t type = event.GetType();
+    if (type < _eventHandlers.size() && _eventHandlers[type] != nullptr)
+    {
+      _eventHandlers[type]->emit(event);
+    }
+  }
+
+  bool HasSubscribers(const uint32_t type) const
+  {
+    return (type < _eventHandlers.size()) && (_eventHandlers[type] != nullptr) && _eventHandlers[type]->HasSubscribers();
+  }
+
+  // Allows subscribing to events by type with the passed in function
+  Signal::SmartHandle Subscribe(const uint32_t type, SubscriberFunction<DataType> function)
+  {
+    return GetSignal(type).ScopedSubscribe(std::move(function));
+  }
+
+  void SubscribeForever(const uint32_t type, SubscriberFunction<DataType> function)
+  {
+    GetSignal(type).SubscribeForever(std::move(function));
+  }
+
+  void UnsubscribeAll()
+  {
+    _eventHandlers.clear();
+  }
+
+private:
+  std::vector<std::unique_ptr<EventHandlerSignal<DataType>>> _eventHandlers;
+
+  EventHandlerSignal<DataType>& GetSignal(const uint32_t type)
+  {
+    if (type >= _eventHandlers.size())
+    {
+      _eventHandlers.resize(type + 1);
+    }
+    if (_eventHandlers[type] == nullptr)
+    {
+      _eventHandlers[type].reset(new EventHandlerSignal<DataType>());
+    }
+    return *_eventHandlers[type];
+  }
+}; // class AnkiDenseEventMgr
+
+
 
 /**
  *      Specialization takes in another param: mailbox id. Mailbox allows us to listen for events coming from specific
@@ -134,12 +198,12 @@ public:
   // Allows subscribing to events by type with the passed in function
   Signal::SmartHandle Subscribe(const uint32_t mailbox, const uint32_t type, SubscriberFunction<DataType> function)
   {
-    return this->_eventHandlerMap[type][mailbox].ScopedSubscribe(function);
+    return this->_eventHandlerMap[type][mailbox].ScopedSubscribe(std::move(function));
   }
   
   void SubscribeForever(const uint32_t mailbox, const uint32_t type, SubscriberFunction<DataType> function)
   {
-    this->_eventHandlerMap[type][mailbox].SubscribeForever(function);
+    this->_eventHandlerMap[type][mailbox].SubscribeForever(std::move(function));
   }
 }; // class AnkiEventMgr (Mailbox specialization)
 
@@ -15,6 +15,7 @@
 
 #include "engine/events/ankiEvent.h"
 #include "util/signals/simpleSignal.hpp"
+#include <functional>
 #include <vector>
 #include <utility>
 
@@ -61,6 +62,25 @@ public:
   
   virtual Signal::SmartHandle Subscribe(const ExternalInterface::MessageGameToEngineTag& tagType, std::function<void(const AnkiEvent<ExternalInterface::MessageGameToEngine>&)> messageHandler) = 0;
   
+  // Typed subscriptions, for handlers that only care about one message. The handler is called with the unpacked
+  // union member by reference, e.g.
+  //   Subscribe<MessageGameToEngineTag::ConnectToCube>([this](const ConnectToCube& msg) { ... });
+  template<ExternalInterface::MessageEngineToGameTag Tag, typename Handler>
+  Signal::SmartHandle Subscribe(Handler handler)
+  {
+    return Subscribe(Tag, [handler = std::move(handler)](const auto& event) -> void {
+      handler(event.GetData().template Get_<Tag>());
+    });
+  }
+  
+  template<ExternalInterface::MessageGameToEngineTag Tag, typename Handler>
+  Signal::SmartHandle Subscribe(Handler handler)
+  {
+    return Subscribe(Tag, [handler = std::move(handler)](const auto& event) -> void {
+      handler(event.GetData().template Get_<Tag>());
+    });
+  }
+  
   virtual void SetSdkStatus(SdkStatusType statusType, std::string&& statusText) = 0;
   
   virtual uint32_t GetMessageCountGtE() const = 0;
@@ -25,6 +25,12 @@ namespace external_interface {
   enum class GatewayWrapperTag : uint16_t;
 }
 
+// State-like event streams, where a newer message replaces one not yet sent
+enum class GatewayCoalescedStream : uint8_t {
+  RobotState,
+  Count
+};
+
 class IGatewayInterface {
 public:
   virtual ~IGatewayInterface() {};
@@ -32,6 +38,18 @@ public:
   virtual void Broadcast(const external_interface::GatewayWrapper& message) = 0;
   virtual void Broadcast(external_interface::GatewayWrapper&& message) = 0;
   
+  // Sends at most one message per period of the stream. A message broadcast before the period is up is held, and
+  // replaced by any newer one, until it is. Check IsStreamDue first to skip building messages that would be replaced.
+  virtual void BroadcastCoalesced(GatewayCoalescedStream stream, external_interface::GatewayWrapper&& message) = 0;
+  virtual bool IsStreamDue(GatewayCoalescedStream stream) const = 0;
+  
+  // A negative period turns the stream off entirely
+  virtual void SetStreamPeriod(GatewayCoalescedStream stream, float period_s) = 0;
+  
+  // True while sends are being dropped because the gateway is not keeping up, e.g. behind a slow client.
+  // Bulk senders like the camera stream should skip their data until it clears.
+  virtual bool IsBackedUp() const = 0;
+  
   virtual Signal::SmartHandle Subscribe(const external_interface::GatewayWrapperTag& tagType, std::function<void(const AnkiEvent<external_interface::GatewayWrapper>&)> messageHandler) = 0;
 
   virtual uint32_t GetMessageCountOutgoing() const = 0;
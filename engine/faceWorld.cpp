@@ -38,6 +38,8 @@
 #include "clad/types/featureGateTypes.h"
 #include "engine/utils/cozmoFeatureGate.h"
 
+#include <algorithm>
+
 
 
 namespace Anki {
@@ -94,6 +96,44 @@ namespace Vector {
     return face.GetID() > 0 && (IsNamed() || numTimesObservedFacingCamera >= kNumTimesToSeeFrontalToBeStable);
   }
 
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  namespace {
+    template<class Entry>
+    bool IsEntryIDLess(const Entry& entry, Vision::FaceID_t faceID) { return entry.face.GetID() < faceID; }
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  FaceWorld::FaceEntryIter FaceWorld::FindFace(Vision::FaceID_t faceID)
+  {
+    auto iter = std::lower_bound(_faceEntries.begin(), _faceEntries.end(), faceID, IsEntryIDLess<FaceEntry>);
+    if(iter != _faceEntries.end() && iter->face.GetID() == faceID) {
+      return iter;
+    }
+    return _faceEntries.end();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  FaceWorld::FaceContainer::const_iterator FaceWorld::FindFace(Vision::FaceID_t faceID) const
+  {
+    auto iter = std::lower_bound(_faceEntries.begin(), _faceEntries.end(), faceID, IsEntryIDLess<FaceEntry>);
+    if(iter != _faceEntries.end() && iter->face.GetID() == faceID) {
+      return iter;
+    }
+    return _faceEntries.end();
+  }
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  std::pair<FaceWorld::FaceEntryIter, bool> FaceWorld::InsertFace(FaceEntry&& faceEntry)
+  {
+    const Vision::FaceID_t faceID = faceEntry.face.GetID();
+    auto iter = std::lower_bound(_faceEntries.begin(), _faceEntries.end(), faceID, IsEntryIDLess<FaceEntry>);
+    if(iter != _faceEntries.end() && iter->face.GetID() == faceID) {
+      return {iter, false};
+    }
+    ++_facesGeneration;
+    return {_faceEntries.insert(iter, std::move(faceEntry)), true};
+  }
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   FaceWorld::FaceWorld()
   : UnreliableComponent<BCComponentID>(this, BCComponentID::FaceWorld)
@@ -137,7 +177,7 @@ namespace Vector {
     {
       using namespace ExternalInterface;
 
-      RobotDeletedFace msg(faceEntryIter->first);
+      RobotDeletedFace msg(faceEntryIter->face.GetID());
 
       if( ANKI_DEV_CHEATS ) {
         SendObjectUpdateToWebViz( msg );
@@ -146,9 +186,10 @@ namespace Vector {
       _robot->Broadcast(MessageEngineToGame(std::move(msg)));
     }
 
-    EraseFaceViz(faceEntryIter->second);
+    EraseFaceViz(*faceEntryIter);
 
     faceEntryIter = _faceEntries.erase(faceEntryIter);
+    ++_facesGeneration;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -161,12 +202,13 @@ namespace Vector {
     }
 
     _lastObservedFaceTimeStamp = 0;
+    ++_facesGeneration;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   void FaceWorld::RemoveFaceByID(Vision::FaceID_t faceID)
   {
-    auto faceEntryIter = _faceEntries.find(faceID);
+    auto faceEntryIter = FindFace(faceID);
 
     if(faceEntryIter != _faceEntries.end())
     {
@@ -184,10 +226,10 @@ namespace Vector {
     const Vision::FaceID_t newID   = update.newID;
     const std::string&     newName = update.newName;
 
-    auto faceEntryIter = _faceEntries.find(oldID);
+    auto faceEntryIter = FindFace(oldID);
     if(faceEntryIter != _faceEntries.end())
     {
-      Vision::TrackedFace& face = faceEntryIter->second.face;
+      Vision::TrackedFace& face = faceEntryIter->face;
 
       PRINT_CH_INFO(kLoggingChannelName, "FaceWorld.ChangeFaceID.Success",
                     "Updating old face %d (%s) to new ID %d (%s)",
@@ -206,17 +248,18 @@ namespace Vector {
       face.SetID(newID);
       face.SetName(newName);
 
-      // TODO: Is there a more efficient move operation I could do here?
-      auto result = _faceEntries.insert({newID, face});
+      // Move the entry to its place for the new ID
+      FaceEntry movedFaceEntry(std::move(*faceEntryIter));
       RemoveFace(faceEntryIter, false); // NOTE: don't broadcast the deletion
+      auto result = InsertFace(std::move(movedFaceEntry));
 
       // Re-draw the face and update the viz handle
-      DrawFace(result.first->second);
+      DrawFace(*result.first);
 
       // Log ID changes to DAS when they are not tracking IDs and the new face is
       // either named or a "stable" session-only face.
       // Store old ID in DDATA and new ID in s_val.
-      const FaceEntry& newFaceEntry = result.first->second;
+      const FaceEntry& newFaceEntry = *result.first;
       if(oldID > 0 && newID > 0 && newFaceEntry.HasStableID())
       {
         DASMSG(robot.vision.update_face_id,
@@ -297,6 +340,8 @@ namespace Vector {
                      face.GetHeadPose().GetTranslation().z());
     */
 
+    ++_facesGeneration;
+
     FaceEntry* faceEntry = nullptr;
     TimeStamp_t timeSinceLastSeen_ms = 0;
 
@@ -305,50 +350,49 @@ namespace Vector {
       // Can't get an ID from face recognition, so use pose instead
       bool foundMatch = false;
 
-      // Look through all faces and compare pose and image rectangles:
+      // Look through all faces and compare pose and image rectangles.
+      // NOTE: the match is tracked by index, since removing an earlier match moves the entries after it.
       f32 IOU_threshold = 0.5f;
-      for(auto faceEntryIter = _faceEntries.begin(); faceEntryIter != _faceEntries.end(); ++faceEntryIter)
+      size_t matchIndex = 0;
+      for(size_t index = 0; index < _faceEntries.size(); ++index)
       {
 
         // Note we're using really loose thresholds for checking pose sameness
         // since our ability to accurately localize face's 3D pose is limited.
-        Radians angleDiff;
+        bool isMatch = false;
 
-        const auto & entryRect = faceEntryIter->second.face.GetRect();
+        const auto & entryRect = _faceEntries[index].face.GetRect();
         const f32 currentIOU = face.GetRect().ComputeOverlapScore(entryRect);
         if(currentIOU > IOU_threshold)
         {
-          if(foundMatch) {
-            // If we had already found a match, delete the last one, because this
-            // new face matches multiple existing faces
-            assert(nullptr != faceEntry);
-            RemoveFaceByID(faceEntry->face.GetID());
-          }
-
           IOU_threshold = currentIOU;
-          foundMatch = true;
-          faceEntry = &faceEntryIter->second;
+          isMatch = true;
         }
         else
         {
-          auto posDiffVec = (faceEntryIter->second.face.GetHeadPose().GetTranslation() -
+          auto posDiffVec = (_faceEntries[index].face.GetHeadPose().GetTranslation() -
                              headPoseWrtWorldOrigin.GetTranslation());
           float posDiffSq = posDiffVec.LengthSq();
-          if(posDiffSq <= kHeadCenterPointThreshold_mm * kHeadCenterPointThreshold_mm) {
-            if(foundMatch) {
-              // If we had already found a match, delete the last one, because this
-              // new face matches multiple existing faces
-              assert(nullptr != faceEntry);
-              RemoveFaceByID(faceEntry->face.GetID());
-            }
+          isMatch = (posDiffSq <= kHeadCenterPointThreshold_mm * kHeadCenterPointThreshold_mm);
+        }
 
-            faceEntry = &faceEntryIter->second;
-            foundMatch = true;
+        if(isMatch)
+        {
+          if(foundMatch) {
+            // If we had already found a match, delete the last one, because this
+            // new face matches multiple existing faces
+            assert(matchIndex < index);
+            RemoveFaceByID(_faceEntries[matchIndex].face.GetID());
+            --index;
           }
+
+          matchIndex = index;
+          foundMatch = true;
         }
       } // for each face entry
 
       if(foundMatch) {
+        faceEntry = &_faceEntries[matchIndex];
         const Vision::FaceID_t matchedID = faceEntry->face.GetID();
 
         // Verbose! Useful for debugging
@@ -366,15 +410,16 @@ namespace Vector {
         PRINT_CH_INFO(kLoggingChannelName, "FaceWorld.UpdateFace.NewFace",
                       "Added new face with ID=%d at t=%d.", _idCtr, face.GetTimeStamp());
 
-        auto insertResult = _faceEntries.insert({_idCtr, face});
+        FaceEntry newFaceEntry(face);
+        newFaceEntry.face.SetID(_idCtr); // Use our own ID here for the new face
+        auto insertResult = InsertFace(std::move(newFaceEntry));
         if(insertResult.second == false) {
           PRINT_NAMED_ERROR("FaceWorld.UpdateFace.ExistingID",
                             "Did not find a match by pose, but ID %d already in use.",
                             _idCtr);
           return RESULT_FAIL;
         }
-        faceEntry = &insertResult.first->second;
-        faceEntry->face.SetID(_idCtr); // Use our own ID here for the new face
+        faceEntry = &(*insertResult.first);
 
         ++_idCtr;
       }
@@ -383,7 +428,7 @@ namespace Vector {
     else
     {
       // Use face recognition to get ID
-      auto existingIter = _faceEntries.find(face.GetID());
+      auto existingIter = FindFace(face.GetID());
 
       const bool isNewFace = (existingIter == _faceEntries.end());
       if(isNewFace)
@@ -410,14 +455,14 @@ namespace Vector {
                         "Added new face with ID=%d at t=%d.",
                         face.GetID(), face.GetTimeStamp());
 
-          auto result = _faceEntries.emplace(face.GetID(), face);
-          faceEntry = &result.first->second;
+          auto result = InsertFace(FaceEntry(face));
+          faceEntry = &(*result.first);
         }
       }
       else
       {
         // Update the existing face:
-        faceEntry = &existingIter->second;
+        faceEntry = &(*existingIter);
 
         if(face.GetTimeStamp() > faceEntry->face.GetTimeStamp())
         {
@@ -481,7 +526,7 @@ namespace Vector {
 
     const auto* featureGate = _robot->GetContext()->GetFeatureGate();
     if (featureGate->IsFeatureEnabled(FeatureType::GazeDirection)) {
-      AddOrUpdateGazeDirection(faceEntry->face);
+      AddOrUpdateGazeDirection(*faceEntry);
     }
 
     // Keep up with how many times non-tracking-only faces have been seen facing
@@ -642,20 +687,24 @@ namespace Vector {
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-  Result FaceWorld::AddOrUpdateGazeDirection(Vision::TrackedFace& face)
+  void FaceWorld::AddOrUpdateGazeDirection(FaceEntry& faceEntry)
   {
     // Only update the gaze direction for the given face if
     // we have succesfully found parts for this face which are
     // needed to determine the rotation of the head pose. The
     // HasEyes method is proxy for this.
+    Vision::TrackedFace& face = faceEntry.face;
     if (face.HasEyes())
     {
-      auto& entry = _gazeDirection[face.GetID()];
+      auto& entry = faceEntry.gazeDirection;
       entry.Update(face);
+      faceEntry.hasGazeDirection = true;
 
       if (entry.GetExpired(face.GetTimeStamp()))
       {
-        _gazeDirection.erase(face.GetID());
+        // Start over with an empty history next time
+        faceEntry.gazeDirection = Vision::GazeDirection();
+        faceEntry.hasGazeDirection = false;
       }
       else
       {
@@ -669,11 +718,10 @@ namespace Vector {
         }
       }
     }
-    return RESULT_OK;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-  Result FaceWorld::Update(const std::list<Vision::TrackedFace>& observedFaces)
+  Result FaceWorld::Update(const std::vector<Vision::TrackedFace>& observedFaces)
   {
     ANKI_CPU_PROFILE("FaceWorld::Update");
 
@@ -692,20 +740,20 @@ namespace Vector {
     // Delete any unnamed faces we haven't seen in awhile
     for(auto faceIter = _faceEntries.begin(); faceIter != _faceEntries.end(); )
     {
-      Vision::TrackedFace& face = faceIter->second.face;
+      Vision::TrackedFace& face = faceIter->face;
 
       if(face.GetName().empty() && (lastProcImageTime > kDeletionTimeout_ms + face.GetTimeStamp()))
       {
         PRINT_CH_INFO(kLoggingChannelName, "FaceWorld.Update.DeletingOldFace",
                       "Removing unnamed face %d at t=%d, because it hasn't been seen since t=%d.",
-                      faceIter->first, (TimeStamp_t)lastProcImageTime, face.GetTimeStamp());
+                      face.GetID(), (TimeStamp_t)lastProcImageTime, face.GetTimeStamp());
 
-        if(faceIter->second.HasStableID())
+        if(faceIter->HasStableID())
         {
           DASMSG(robot.vision.remove_unobserved_session_only_face,
                  "robot.vision.remove_unobserved_session_only_face",
                  "Removing a 'stable' face because we have not seen it in awhile");
-          DASMSG_SET(i1, faceIter->first, "Face ID");
+          DASMSG_SET(i1, face.GetID(), "Face ID");
           DASMSG_SET(i2, face.GetTimeStamp(), "Face time stamp");
           DASMSG_SEND();
         }
@@ -767,10 +815,13 @@ namespace Vector {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   void FaceWorld::OnRobotDelocalized(PoseOriginID_t worldOriginID)
   {
+    // Faces in the old origin are no longer returned by queries
+    ++_facesGeneration;
+
     // Erase all face visualizations
-    for(auto & pair : _faceEntries)
+    for(auto & faceEntry : _faceEntries)
     {
-      EraseFaceViz(pair.second);
+      EraseFaceViz(faceEntry);
     }
 
     // Note that we deliberately do not clear the last observed face pose! Sometimes
@@ -790,11 +841,12 @@ namespace Vector {
     const Pose3d& newOrigin = _robot->GetPoseOriginList().GetOriginByID(newOriginID);
 
     s32 updateCount = 0;
+    ++_facesGeneration;
 
     // Update all regular face entries
-    for(auto & pair : _faceEntries)
+    for(auto & faceEntry : _faceEntries)
     {
-      Vision::TrackedFace& face = pair.second.face;
+      Vision::TrackedFace& face = faceEntry.face;
 
       // If this entry's face is directly w.r.t. the old origin, flatten it to the new origin
       if(oldOrigin.IsParentOf(face.GetHeadPose()))
@@ -804,7 +856,7 @@ namespace Vector {
         if(success)
         {
           PRINT_CH_DEBUG(kLoggingChannelName, "FaceWorld.UpdateFaceOrigins.FlatteningFace",
-                         "Flattened FaceID:%d w.r.t. %s", pair.first, newOrigin.GetName().c_str());
+                         "Flattened FaceID:%d w.r.t. %s", face.GetID(), newOrigin.GetName().c_str());
 
           face.SetHeadPose(poseWrtNewOrigin);
           ++updateCount;
@@ -814,7 +866,7 @@ namespace Vector {
           PRINT_NAMED_WARNING("FaceWorld.UpdateFaceOrigins.HeadPoseUpdateFailed",
                               "Head pose of FaceID:%d is w.r.t. to old origin %s but "
                               "failed to flatten to be w.r.t new origin %s",
-                              pair.first, oldOrigin.GetName().c_str(), newOrigin.GetName().c_str());
+                              face.GetID(), oldOrigin.GetName().c_str(), newOrigin.GetName().c_str());
         }
       }
 
@@ -822,7 +874,7 @@ namespace Vector {
       {
         // Draw everything in the new origin (but don't draw in the image since we're not actually observing it)
         const bool kDrawInImage = false;
-        DrawFace(pair.second, kDrawInImage);
+        DrawFace(faceEntry, kDrawInImage);
       }
     }
 
@@ -860,9 +912,9 @@ namespace Vector {
   const Vision::TrackedFace* FaceWorld::GetFace(Vision::FaceID_t faceID) const
   {
     const bool kIncludeRecognizableOnly = false; // FaceID directly specified, search everything
-    auto faceIter = _faceEntries.find(faceID);
-    if(faceIter != _faceEntries.end() && ShouldReturnFace(faceIter->second, 0, kIncludeRecognizableOnly)) {
-      return &faceIter->second.face;
+    auto faceIter = FindFace(faceID);
+    if(faceIter != _faceEntries.end() && ShouldReturnFace(*faceIter, 0, kIncludeRecognizableOnly)) {
+      return &faceIter->face;
     } else {
       return nullptr;
     }
@@ -881,24 +933,17 @@ namespace Vector {
                                                    const Radians& angleRelativeRobot_rad) const
   {
     std::set<Vision::FaceID_t> faceIDs;
-    auto faceEntryIter = _faceEntries.begin();
-    while(faceEntryIter != _faceEntries.end())
+    for(const auto& faceEntry : _faceEntries)
     {
-      DEV_ASSERT_MSG(faceEntryIter->first == faceEntryIter->second.face.GetID(),
-                     "FaceWorld.GetFaceIDs.MismatchedIDs",
-                     "Entry keyed with ID:%d but face has ID:%d",
-                     faceEntryIter->first, faceEntryIter->second.face.GetID());
-
-      if(ShouldReturnFace(faceEntryIter->second,
+      if(ShouldReturnFace(faceEntry,
                           seenSinceTime_ms,
                           includeRecognizableOnly,
                           relativeRobotAngleTolerance_rad,
                           angleRelativeRobot_rad))
       {
-        faceIDs.insert(faceEntryIter->first);
+        // Entries are sorted by ID, so each insert goes at the end
+        faceIDs.insert(faceIDs.end(), faceEntry.face.GetID());
       }
-
-      ++faceEntryIter;
     }
 
     return faceIDs;
@@ -925,16 +970,13 @@ namespace Vector {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   bool FaceWorld::HasAnyFaces(RobotTimeStamp_t seenSinceTime_ms, bool includeRecognizableOnly) const
   {
-    auto faceEntryIter = _faceEntries.begin();
-    while(faceEntryIter != _faceEntries.end())
+    for(const auto& faceEntry : _faceEntries)
     {
-      if (ShouldReturnFace(faceEntryIter->second, seenSinceTime_ms, includeRecognizableOnly) )
+      if (ShouldReturnFace(faceEntry, seenSinceTime_ms, includeRecognizableOnly) )
       {
         // As soon as we find any face that matches the criteria, we're done
         return true;
       }
-
-      ++faceEntryIter;
     }
 
     return false;
@@ -972,14 +1014,14 @@ namespace Vector {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   bool FaceWorld::HasTurnedTowardsFace(Vision::FaceID_t faceID) const
   {
-    const auto& it = _faceEntries.find(faceID);
+    const auto it = FindFace(faceID);
     if( it == _faceEntries.end() ) {
       // either this is a bad ID, or the face was deleted, so assume we haven't animated at it. Note that (as
       // of this comment writing...) named faces are not deleted
       return false;
     }
 
-    return it->second.hasTurnedTowards;
+    return it->hasTurnedTowards;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -991,7 +1033,7 @@ namespace Vector {
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   void FaceWorld::SetTurnedTowardsFace(Vision::FaceID_t faceID, bool val)
   {
-    auto it = _faceEntries.find(faceID);
+    auto it = FindFace(faceID);
     if( it == _faceEntries.end() ) {
       PRINT_NAMED_WARNING("FaceWorld.SetTurnedTowardsFaceAndAnimation.InvalidFace",
                           "Claiming that we animated at face %d, but that face doesn't exist in FaceWorld",
@@ -999,7 +1041,8 @@ namespace Vector {
       return;
     }
 
-    it->second.hasTurnedTowards = val;
+    it->hasTurnedTowards = val;
+    ++_facesGeneration;
   }
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -1028,9 +1071,8 @@ namespace Vector {
 
     const auto* featureGate = _robot->GetContext()->GetFeatureGate();
     if (kRenderGazeDirectionPoints && featureGate->IsFeatureEnabled(FeatureType::GazeDirection)) {
-      const auto& entry = _gazeDirection.find(trackedFace.GetID());
-      if (entry != _gazeDirection.end()) {
-        const auto& gazeDirection = entry->second;
+      if (faceEntry.hasGazeDirection) {
+        const auto& gazeDirection = faceEntry.gazeDirection;
         const s32 startingObjectId = 2345;
 
         const auto currentGazeDirection = gazeDirection.GetCurrentGazeDirection();
@@ -1166,9 +1208,9 @@ namespace Vector {
     // Loop over all the faces and see if any of them are making eye contact
     for (const auto& entry: _faceEntries)
     {
-      if (ShouldReturnFace(entry.second, recentTime, false))
+      if (ShouldReturnFace(entry, recentTime, false))
       {
-        if (entry.second.face.IsMakingEyeContact())
+        if (entry.face.IsMakingEyeContact())
         {
           return true;
         }
@@ -1188,12 +1230,12 @@ namespace Vector {
 
     for (const auto& entry: _faceEntries)
     {
-      if (ShouldReturnFace(entry.second, recentTime, false))
+      if (ShouldReturnFace(entry, recentTime, false))
       {
-        if (entry.second.face.IsGazeDirectionStable())
+        if (entry.face.IsGazeDirectionStable())
         {
-          gazeDirectionPose = entry.second.face.GetGazeDirectionPose();
-          faceID.Reset(*_robot, entry.second.face.GetID());
+          gazeDirectionPose = entry.face.GetGazeDirectionPose();
+          faceID.Reset(*_robot, entry.face.GetID());
           return true;
         }
       }
@@ -1213,13 +1255,12 @@ namespace Vector {
   bool FaceWorld::ClearGazeDirectionHistory(const SmartFaceID& faceID)
   {
     // Loop over all the faces and see if any of them are making eye contact
-    for (const auto& entry: _faceEntries)
+    for (auto& entry: _faceEntries)
     {
-      if (faceID.MatchesFaceID(entry.second.face.GetID()))
+      if (faceID.MatchesFaceID(entry.face.GetID()))
       {
-        const auto& gazeDirectionEntry = _gazeDirection.find(entry.second.face.GetID());
-        if (gazeDirectionEntry != _gazeDirection.end()) {
-          gazeDirectionEntry->second.ClearHistory();
+        if (entry.hasGazeDirection) {
+          entry.gazeDirection.ClearHistory();
           return true;
         }
       }
@@ -1233,16 +1274,16 @@ namespace Vector {
   {
     for (const auto& entry: _faceEntries)
     {
-      const auto& headPose = entry.second.face.GetHeadPose();
+      const auto& headPose = entry.face.GetHeadPose();
       Pose3d headPoseWRTRobot;
       if (headPose.GetWithRespectTo(robotPose, headPoseWRTRobot))
       {
         const Radians& horizontalFOV = _robot->GetVisionComponent().GetCamera().GetCalibration()->ComputeHorizontalFOV();
         const Radians faceTurnAngle = TurnTowardsPoseAction::GetRelativeBodyAngleToLookAtPose(headPoseWRTRobot.GetTranslation());
         if (Util::InRange( turnAngle - faceTurnAngle, -horizontalFOV/2.f, horizontalFOV/2.f) &&
-            !smartFaceIDToIgnore.MatchesFaceID(entry.second.face.GetID()))
+            !smartFaceIDToIgnore.MatchesFaceID(entry.face.GetID()))
         {
-          faceIDToTurnTowards.Reset(*_robot, entry.second.face.GetID());
+          faceIDToTurnTowards.Reset(*_robot, entry.face.GetID());
           return true;
         }
       }
@@ -84,9 +84,8 @@ namespace Vector {
     // end IDependencyManagedComponent functions
     //////
     
-    Result Update(const std::list<Vision::TrackedFace>& observedFaces);
+    Result Update(const std::vector<Vision::TrackedFace>& observedFaces);
     Result AddOrUpdateFace(const Vision::TrackedFace& face);
-    Result AddOrUpdateGazeDirection(Vision::TrackedFace& face);
   
     Result ChangeFaceID(const Vision::UpdatedFaceID& update);
     
@@ -122,6 +121,9 @@ namespace Vector {
                                              float relativeRobotAngleTolerence_rad = kDontCheckRelativeAngle,
                                              const Radians& angleRelativeRobot_rad = 0) const;
 
+    // Incremented whenever a face is added, updated, renamed or removed, or their origins change
+    size_t GetFacesGeneration() const { return _facesGeneration; }
+
     // Returns true if any faces are in the world
     bool HasAnyFaces(RobotTimeStamp_t seenSinceTime_ms = 0, bool includeRecognizableOnly = false) const;
 
@@ -220,19 +222,34 @@ namespace Vector {
       s32                      numTimesObserved = 0;
       s32                      numTimesObservedFacingCamera = 0;
       bool                     hasTurnedTowards = false;
+      bool                     hasGazeDirection = false;
+      Vision::GazeDirection    gazeDirection;
 
       FaceEntry(const Vision::TrackedFace& faceIn);
       bool IsNamed() const { return !face.GetName().empty(); }
       bool HasStableID() const;
     };
     
-    using FaceContainer = std::map<Vision::FaceID_t, FaceEntry>;
+    // Entries are kept in one vector, sorted by face ID. There are rarely more than a handful of faces at once, and
+    // most queries (which BEI conditions make every tick) walk all of them, so this beats a node-based map both for
+    // the walks and for finding a single ID.
+    using FaceContainer = std::vector<FaceEntry>;
     using FaceEntryIter = FaceContainer::iterator;
     
     FaceContainer _faceEntries;
     
+    // Returns _faceEntries.end() if there is no entry with the given ID
+    FaceEntryIter FindFace(Vision::FaceID_t faceID);
+    FaceContainer::const_iterator FindFace(Vision::FaceID_t faceID) const;
+    
+    // Adds the entry in order of its face's ID. If there already is an entry with that ID, returns it instead and
+    // returns false in the second member (like std::map::insert).
+    std::pair<FaceEntryIter, bool> InsertFace(FaceEntry&& faceEntry);
+    
     Vision::FaceID_t _idCtr = 0;
     
+    size_t _facesGeneration = 0;
+    
     Pose3d      _lastObservedFacePose;
     RobotTimeStamp_t _lastObservedFaceTimeStamp = 0;
 
@@ -249,6 +266,10 @@ namespace Vector {
     void RemoveFace(FaceEntryIter& faceIter, bool broadcast = true);
     
     void RemoveFaceByID(Vision::FaceID_t faceID);
+    
+    // Adds the face's current observation to its entry's gaze direction history and sets whether the gaze is stable
+    // (and the gaze pose, if so) on the entry's face
+    void AddOrUpdateGazeDirection(FaceEntry& faceEntry);
 
     void SetupEventHandlers(IExternalInterface& externalInterface);
     
@@ -265,8 +286,6 @@ namespace Vector {
     // faces saved album data for the initial entry so it can work across boots
     using ObservationHistoryMap = std::map<Vision::FaceID_t, ObservationTimeHistory>;
     ObservationHistoryMap _wallTimesObserved;
-
-    std::map<Vision::FaceID_t, Vision::GazeDirection> _gazeDirection;
     
   }; // class FaceWorld
   
@@ -41,7 +41,10 @@
 #include "util/logging/logging.h"
 #include "util/math/math.h"
 #include "webServerProcess/src/webService.h"
+#include <algorithm>
 #include <assert.h>
+#include <cmath>
+#include <limits>
 
 namespace Anki {
 namespace Vector {
@@ -64,6 +67,17 @@ static const char* kSimpleMoodAudioKey = "simpleMoodAudioParameters";
 CONSOLE_VAR(float, kMoodManager_AudioSendPeriod_s, "MoodManager", 0.5f);
 CONSOLE_VAR(float, kMoodManager_WebVizPeriod_s, "MoodManager", 1.0f);
 CONSOLE_VAR(float, kMoodManager_AppPeriod_s, "MoodManager", 1.0f);
+
+// Emotions are only broadcast to the game and audio when one has changed by more than this since it was last sent,
+// or at least once per keepalive period
+CONSOLE_VAR(float, kMoodManager_BroadcastThreshold, "MoodManager", 0.001f);
+CONSOLE_VAR(float, kMoodManager_BroadcastKeepAlive_s, "MoodManager", 2.0f);
+
+bool HasChangedSinceSent(float value, float sentValue)
+{
+  // never sent (NaN) counts as changed
+  return !(std::abs(value - sentValue) <= kMoodManager_BroadcastThreshold);
+}
 }
 
 
@@ -88,6 +102,7 @@ MoodManager::MoodManager()
 , _simpleMoodAudioParameter(AudioParameterType::Invalid)
 {
   _pendingAppEvents.reserve(3); // ~max expected events in a single Update() tick
+  InvalidateSentEmotions();
 }
 
 MoodManager::~MoodManager()
@@ -300,6 +315,15 @@ void MoodManager::Reset()
     GetEmotionByIndex(i).Reset();
   }
   _lastUpdateTime = 0.0f;
+  InvalidateSentEmotions();
+}
+
+
+void MoodManager::InvalidateSentEmotions()
+{
+  _lastAudioEmotionValues.fill(std::numeric_limits<float>::quiet_NaN());
+  _lastGameEmotionValues.fill(std::numeric_limits<float>::quiet_NaN());
+  _lastAudioSimpleMood = SimpleMoodType::Count;
 }
 
 
@@ -346,7 +370,7 @@ void MoodManager::UpdateDependent(const RobotCompMap& dependentComps)
   }
 
   const bool hasAudioComp = dependentComps.HasComponent<Audio::EngineRobotAudioClient>();
-  if( hasAudioComp && ( (currentTime - _lastAudioSendTime_s) > kMoodManager_AudioSendPeriod_s ) ) {
+  if( hasAudioComp && ( _audioSendPending || ((currentTime - _lastAudioSendTime_s) > kMoodManager_AudioSendPeriod_s) ) ) {
     SendEmotionsToAudio(dependentComps.GetComponent<Audio::EngineRobotAudioClient>());
   }
 
@@ -371,7 +395,7 @@ void MoodManager::UpdateDependent(const RobotCompMap& dependentComps)
     }
   }
 
-  SendEmotionsToGame();
+  SendEmotionsToGameIfChanged(currentTime);
 
   if( !_pendingAppEvents.empty() || (currentTime - _lastAppSentStimTime_s >= kMoodManager_AppPeriod_s) ) {
     // this won't send a new stim rate/accel the moment it changes, but since this is currently the only
@@ -513,14 +537,36 @@ void MoodManager::SendEmotionsToGame()
       emotionValues.push_back(emotion.GetValue());
     }
 
+    std::copy(emotionValues.begin(), emotionValues.end(), _lastGameEmotionValues.begin());
     ExternalInterface::MoodState message(std::move(emotionValues));
     _robot->Broadcast(ExternalInterface::MessageEngineToGame(std::move(message)));
   }
+  _lastGameSendTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+}
+
+void MoodManager::SendEmotionsToGameIfChanged(float currentTime_s)
+{
+  bool changed = (currentTime_s - _lastGameSendTime_s) >= kMoodManager_BroadcastKeepAlive_s;
+  for (size_t i = 0; !changed && (i < (size_t)EmotionType::Count); ++i)
+  {
+    changed = HasChangedSinceSent(GetEmotionByIndex(i).GetValue(), _lastGameEmotionValues[i]);
+  }
+
+  if( changed ) {
+    SendEmotionsToGame();
+  }
 }
 
 void MoodManager::SendEmotionsToAudio(Audio::EngineRobotAudioClient& audioClient)
 {
   _lastAudioSendTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
+  _audioSendPending = false;
+
+  if( (_lastAudioSendTime_s - _lastAudioKeepAliveTime_s) >= kMoodManager_BroadcastKeepAlive_s ) {
+    _lastAudioKeepAliveTime_s = _lastAudioSendTime_s;
+    _lastAudioEmotionValues.fill(std::numeric_limits<float>::quiet_NaN());
+    _lastAudioSimpleMood = SimpleMoodType::Count;
+  }
 
   // disabled for PR demo (let audio use it's own custom settings here)
   if( nullptr != _robot ) {
@@ -537,20 +583,27 @@ void MoodManager::SendEmotionsToAudio(Audio::EngineRobotAudioClient& audioClient
       const EmotionType emotionType = (EmotionType)i;
       Emotion& emotion = GetEmotionByIndex(i);
 
+      const float val = emotion.GetValue();
+      if( !HasChangedSinceSent(val, _lastAudioEmotionValues[i]) ) {
+        continue;
+      }
+
       auto audioParamIt = _audioParameterMap.find(emotionType);
       if( audioParamIt != _audioParameterMap.end() ) {
-        const float val = emotion.GetValue();
         audioClient.PostParameter( audioParamIt->second, val );
       }
+      _lastAudioEmotionValues[i] = val;
     }
   }
 
-  if( !_simpleMoodAudioEventMap.empty() ) {
-    auto simpleMoodIt = _simpleMoodAudioEventMap.find( GetSimpleMood() );
+  const SimpleMoodType simpleMood = GetSimpleMood();
+  if( !_simpleMoodAudioEventMap.empty() && (simpleMood != _lastAudioSimpleMood) ) {
+    auto simpleMoodIt = _simpleMoodAudioEventMap.find( simpleMood );
     if( simpleMoodIt != _simpleMoodAudioEventMap.end() ) {
       const float val = simpleMoodIt->second;
       audioClient.PostParameter( _simpleMoodAudioParameter, val );
     }
+    _lastAudioSimpleMood = simpleMood;
   }
 }
 
@@ -582,18 +635,20 @@ void MoodManager::SendStimToApp(float velocity, float accel)
 // returns FLT_MAX if this is the first time the event has been seen
 float MoodManager::UpdateLatestEventTimeAndGetTimeElapsedInSeconds(const std::string& eventName, float currentTimeInSeconds)
 {
-  auto newEntry = _moodEventTimes.insert( MoodEventTimes::value_type(eventName, currentTimeInSeconds) );
+  // look up first, so events that have been seen before don't copy their name
+  auto entryIt = _moodEventTimes.find( eventName );
 
-  if (newEntry.second)
+  if (entryIt == _moodEventTimes.end())
   {
-    // first time event has occurred, map insert has successfully updated the time seen
+    // first time event has occurred
+    _moodEventTimes.emplace( eventName, currentTimeInSeconds );
     return FLT_MAX;
   }
   else
   {
     // event has happened before - calculate time since it last occurred and the matching penalty, then update the time
 
-    float& timeEventLastOccurred = newEntry.first->second;
+    float& timeEventLastOccurred = entryIt->second;
     const float timeSinceLastOccurrence = Util::numeric_cast<float>(currentTimeInSeconds - timeEventLastOccurred);
 
     timeEventLastOccurred = currentTimeInSeconds;
@@ -658,7 +713,9 @@ void MoodManager::TriggerEmotionEvent(const std::string& eventName, float curren
 
     bool modified = false;
 
-    std::map<EmotionType, int> eventEmotionDeltas;
+    // use 1000x fixed point
+    std::array<int, (size_t)EmotionType::Count> eventEmotionDeltas;
+    std::array<bool, (size_t)EmotionType::Count> hasEventEmotionDelta{};
 
     const std::vector<EmotionAffector>& emotionAffectors = emotionEvent->GetAffectors();
     for (const EmotionAffector& emotionAffector : emotionAffectors)
@@ -673,8 +730,9 @@ void MoodManager::TriggerEmotionEvent(const std::string& eventName, float curren
         emotion.Add(penalizedDeltaValue);
         const float after = emotion.GetValue();
 
-        // use 1000x fixed point
-        eventEmotionDeltas[ emotionAffector.GetType() ] = std::round( (after - before) * 1000 );
+        const size_t index = (size_t)emotionAffector.GetType();
+        eventEmotionDeltas[ index ] = std::round( (after - before) * 1000 );
+        hasEventEmotionDelta[ index ] = true;
 
         if( emotionAffector.GetType() == EmotionType::Stimulated ) {
           // for stats tracking in the update loop
@@ -690,24 +748,22 @@ void MoodManager::TriggerEmotionEvent(const std::string& eventName, float curren
     }
 
     if( modified ) {
-      if( _robot ) {
-        // update audio now instead of waiting for the next natural update
-        SendEmotionsToAudio(_robot->GetComponent<Audio::EngineRobotAudioClient>());
-      }
+      // update audio at the next update instead of waiting for the next period, once for all of this tick's events
+      _audioSendPending = true;
 
       DASMSG(mood_event, "mood.event", "An emotion event triggered");
       DASMSG_SET(s1, eventName, "name of the emotion event (json defined)");
-      if( eventEmotionDeltas.find( EmotionType::Stimulated ) != eventEmotionDeltas.end() ) {
-        DASMSG_SET(i1, eventEmotionDeltas[EmotionType::Stimulated], "Stimulated delta * 1000");
+      if( hasEventEmotionDelta[ (size_t)EmotionType::Stimulated ] ) {
+        DASMSG_SET(i1, eventEmotionDeltas[(size_t)EmotionType::Stimulated], "Stimulated delta * 1000");
       }
-      if( eventEmotionDeltas.find( EmotionType::Confident ) != eventEmotionDeltas.end() ) {
-        DASMSG_SET(i2, eventEmotionDeltas[EmotionType::Confident], "Confident delta * 1000");
+      if( hasEventEmotionDelta[ (size_t)EmotionType::Confident ] ) {
+        DASMSG_SET(i2, eventEmotionDeltas[(size_t)EmotionType::Confident], "Confident delta * 1000");
       }
-      if( eventEmotionDeltas.find( EmotionType::Social ) != eventEmotionDeltas.end() ) {
-        DASMSG_SET(i3, eventEmotionDeltas[EmotionType::Social], "Social delta * 1000");
+      if( hasEventEmotionDelta[ (size_t)EmotionType::Social ] ) {
+        DASMSG_SET(i3, eventEmotionDeltas[(size_t)EmotionType::Social], "Social delta * 1000");
       }
-      if( eventEmotionDeltas.find( EmotionType::Happy ) != eventEmotionDeltas.end() ) {
-        DASMSG_SET(i4, eventEmotionDeltas[EmotionType::Happy], "Happy delta * 1000");
+      if( hasEventEmotionDelta[ (size_t)EmotionType::Happy ] ) {
+        DASMSG_SET(i4, eventEmotionDeltas[(size_t)EmotionType::Happy], "Happy delta * 1000");
       }
       DASMSG_SEND();
 
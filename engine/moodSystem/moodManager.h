@@ -33,6 +33,7 @@
 #include "util/helpers/noncopyable.h"
 #include "util/signals/simpleSignal_fwd.h"
 
+#include <array>
 #include <assert.h>
 #include <map>
 #include <set>
@@ -177,6 +178,7 @@ public:
 
   void HandleActionEnded(const ExternalInterface::RobotCompletedAction& completion);
   
+  // Sends the current emotions to the game right away
   void SendEmotionsToGame();
 
   // ============================== Public Static Member Funcs ==============================
@@ -224,7 +226,16 @@ private:
   void LoadActionCompletedEventMap(const Json::Value& inJson);
   void PrintActionCompletedEventMap() const;
 
+  // Only posts the parameters that changed by more than kMoodManager_BroadcastThreshold since they were last posted,
+  // unless the keepalive period has passed
   void SendEmotionsToAudio(Audio::EngineRobotAudioClient& audioClient);
+
+  // Sends to the game if any emotion changed by more than kMoodManager_BroadcastThreshold, or the keepalive period
+  // has passed
+  void SendEmotionsToGameIfChanged(float currentTime_s);
+
+  // Forget what was last sent, so the next send includes everything
+  void InvalidateSentEmotions();
   
   void SendStimToApp(float velocity, float accel);
 
@@ -258,7 +269,18 @@ private:
 
   int _actionCallbackID = 0;
 
+  using EmotionValues = std::array<float, (size_t)EmotionType::Count>;
+
   float _lastAudioSendTime_s = 0.0f;
+  float _lastAudioKeepAliveTime_s = 0.0f;
+  EmotionValues  _lastAudioEmotionValues;
+  SimpleMoodType _lastAudioSimpleMood = SimpleMoodType::Count;
+  // set by emotion events, so several in one tick only post to audio once, at the next update
+  bool  _audioSendPending = false;
+
+  float _lastGameSendTime_s = 0.0f;
+  EmotionValues _lastGameEmotionValues;
+
   float _lastWebVizSendTime_s = 0.0f;
   
   float _lastAppSentStimTime_s = 0.0f;
@@ -526,7 +526,7 @@ namespace Vector {
     if (!recvdMsgPackets_.empty()) {
     #endif
       const auto& packet = recvdMsgPackets_.begin()->second;
-      buf = {packet.data, packet.data+packet.dataLen};
+      buf.assign(packet.data, packet.data+packet.dataLen);
       recvdMsgPackets_.pop_front();
       return true;
     }
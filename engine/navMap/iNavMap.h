@@ -36,9 +36,12 @@ public:
   using EContentType          = MemoryMapTypes::EContentType;
   using FullContentArray      = MemoryMapTypes::FullContentArray;
   using NodeTransformFunction = MemoryMapTypes::NodeTransformFunction;
+  using MemoryMapInsertList   = MemoryMapTypes::MemoryMapInsertList;
+  using MemoryMapTransformList = MemoryMapTypes::MemoryMapTransformList;
   using NodePredicate         = MemoryMapTypes::NodePredicate;
   using MemoryMapDataPtr      = MemoryMapTypes::MemoryMapDataPtr;
   using MemoryMapRegion       = MemoryMapTypes::MemoryMapRegion;
+  using LeafFunction          = std::function<void (const AxisAlignedQuad& bounds, const MemoryMapDataPtr& data)>;
   
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Construction/Destruction
@@ -64,8 +67,23 @@ public:
   // Pack map data to broadcast
   virtual void GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const = 0;
 
+  // Pack only the leaves that intersect any of the given regions, for a delta of a previous broadcast. Only
+  // mapInfo and quadInfoFull are filled, since quadInfo encodes the tree in depth-first order and can only be sent whole
+  virtual void GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info, const std::vector<AxisAlignedQuad>& regions) const = 0;
+
   // populate a list of all data that matches the predicate inside region
   virtual void FindContentIf(const NodePredicate& pred, MemoryMapTypes::MemoryMapDataConstList& output, const MemoryMapRegion& region = RealNumbers2f()) const = 0;
+
+  // appends to regions the areas where content type or collision state changed since stamp (0 means since the map
+  // was created), then updates stamp. Returns false if the changes could not be tracked, and the whole map should be
+  // considered changed
+  virtual bool GetChangedRegions(u32& stamp, std::vector<AxisAlignedQuad>& regions) const = 0;
+
+  // calls func with the bounds and data of every leaf node that intersects region
+  virtual void ForEachLeaf(const LeafFunction& func, const MemoryMapRegion& region = RealNumbers2f()) const = 0;
+
+  // write the whole map to the given file, so that Load can restore it later. Returns false on failure
+  virtual bool Save(const std::string& path) const = 0;
   
 protected:
   
@@ -79,12 +97,21 @@ protected:
   // add an object with the specified content. 
   virtual bool Insert(const MemoryMapRegion& r, const MemoryMapData& data) = 0;
   virtual bool Insert(const MemoryMapRegion& r, NodeTransformFunction transform) = 0;
+
+  // add several objects at once, in order. Same result as inserting them one at a time, but cheaper when they are
+  // close to each other, since the map is only traversed and cleaned up once
+  virtual bool Insert(const MemoryMapInsertList& regions) = 0;
+  virtual bool Insert(const MemoryMapTransformList& regions) = 0;
   
   // merge the given map into this map by applying to the other's information the given transform
   // although this methods allows merging any INavMap into any INavMap, subclasses are not
   // expected to provide support for merging other subclasses, but only other instances from the same
   // subclass
   virtual bool Merge(const INavMap& other, const Pose3d& transform) = 0;
+
+  // replace the whole map with one written by Save. Poses stored in the map are restored relative to origin.
+  // Returns false if the file could not be read, leaving the map empty
+  virtual bool Load(const std::string& path, const Pose3d& origin) = 0;
  
   
   // attempt to apply a transformation function to all nodes in the tree constrained by region
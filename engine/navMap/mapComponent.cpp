@@ -16,11 +16,13 @@
 #include "coretech/vision/engine/observableObjectLibrary.h"
 #include "coretech/common/engine/math/poseOriginList.h"
 #include "coretech/common/engine/math/polygon_impl.h"
+#include "coretech/common/engine/utils/data/dataPlatform.h"
 #include "coretech/common/engine/utils/timer.h"
 #include "coretech/messaging/engine/IComms.h"
 
 #include "engine/navMap/iNavMap.h"
 #include "engine/navMap/navMapFactory.h"
+#include "engine/navMap/occupancySnapshot.h"
 #include "engine/navMap/memoryMap/data/memoryMapData_Cliff.h"
 #include "engine/navMap/memoryMap/data/memoryMapData_ProxObstacle.h"
 #include "engine/navMap/memoryMap/data/memoryMapData_ObservableObject.h"
@@ -41,6 +43,7 @@
 #include "engine/vision/groundPlaneROI.h"
 
 #include "util/cpuProfiler/cpuProfiler.h"
+#include "util/fileUtils/fileUtils.h"
 #include "util/console/consoleInterface.h"
 #include "util/logging/DAS.h"
 
@@ -48,6 +51,8 @@
 
 #include "opencv2/imgproc/imgproc.hpp"
 
+#include <algorithm>
+#include <limits>
 #include <numeric>
 
 #define LOG_CHANNEL "MapComponent"
@@ -91,8 +96,21 @@ CONSOLE_VAR(float, kHoughMaxLineGap_mm,       "MapComponent.VisualEdgeDetection"
 CONSOLE_VAR(float, kEdgeLineLengthToInsert_mm,"MapComponent.VisualEdgeDetection", 200.f);
 CONSOLE_VAR(float, kVisionCliffPadding_mm,    "MapComponent.VisualEdgeDetection", 20.f);
 
+// kCliffMergeDist_mm / kCliffMergeAngle_deg: a cliff queued within this distance and angle of one already queued
+// this tick, from the same source, replaces it instead of being written as well
+CONSOLE_VAR(float, kCliffMergeDist_mm,   "MapComponent", 10.0f);
+CONSOLE_VAR(float, kCliffMergeAngle_deg, "MapComponent", 15.0f);
+
 CONSOLE_VAR(int,   kMaxPixelsUsedForHoughTransform, "MapComponent.VisualEdgeDetection", 160000); // 400 x 400 max size
 
+// kMaxResidentNavMaps: maps kept in memory, counting the current one. Maps of older origins are saved to disk and
+// loaded back when the robot relocalizes to them
+CONSOLE_VAR(int,   kMaxResidentNavMaps, "MapComponent", 2);
+
+// kWebVizMapMaxRate_hz: how often the map (or a delta of it) can be sent to webViz. Changes made in between go out
+// with the next send. Read when the component is initialized
+CONSOLE_VAR(float, kWebVizMapMaxRate_hz, "MapComponent", 2.0f);
+
 namespace {
 
 // return the content type we would set in the memory type for each object type
@@ -111,6 +129,34 @@ MemoryMapTypes::EContentType ObjectTypeToMemoryMapContentType(ObjectType type, b
 
 const char* const kWebVizModuleName = "navmap";
 
+// cache folder for evicted maps. Origins do not survive a restart, so neither do these files
+const char* const kEvictedMapsFolder = "navMaps";
+
+// Change regions come in as equal, grid aligned cells. Merge horizontal runs of them into single rectangles, which
+// makes for fewer map queries and a shorter list to send
+void MergeChangedRegions(std::vector<AxisAlignedQuad>& regions)
+{
+  std::sort(regions.begin(), regions.end(), [](const AxisAlignedQuad& a, const AxisAlignedQuad& b) {
+    return (a.GetMinVertex().y() < b.GetMinVertex().y()) ||
+           ((a.GetMinVertex().y() == b.GetMinVertex().y()) && (a.GetMinVertex().x() < b.GetMinVertex().x()));
+  });
+
+  std::vector<AxisAlignedQuad> merged;
+  for ( const auto& region : regions ) {
+    if ( !merged.empty() &&
+         (merged.back().GetMinVertex().y() == region.GetMinVertex().y()) &&
+         (merged.back().GetMaxVertex().y() == region.GetMaxVertex().y()) &&
+         FLT_GE(merged.back().GetMaxVertex().x(), region.GetMinVertex().x()) ) {
+      merged.back() = AxisAlignedQuad( merged.back().GetMinVertex(),
+                                       Point2f( std::max(merged.back().GetMaxVertex().x(), region.GetMaxVertex().x()),
+                                                region.GetMaxVertex().y() ) );
+    } else {
+      merged.push_back(region);
+    }
+  }
+  regions.swap(merged);
+}
+
 decltype(auto) GetChargerRegion(const Pose3d& poseWRTRoot) 
 {
   // grab the cannonical corners and then apply the transformation. If we use `GetBoundingQuadXY`, 
@@ -288,6 +334,7 @@ MapComponent::MapComponent()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 MapComponent::~MapComponent()
 {
+  DeleteEvictedMaps();
 }
 
 
@@ -296,6 +343,9 @@ void MapComponent::InitDependent(Vector::Robot* robot, const RobotCompMap& depen
 {
   _robot = robot;
   consoleRobot = robot;
+
+  // maps evicted by a previous run belong to origins that are gone
+  DeleteEvictedMaps();
   if(_robot->HasExternalInterface())
   {
     using namespace ExternalInterface;
@@ -309,9 +359,13 @@ void MapComponent::InitDependent(Vector::Robot* robot, const RobotCompMap& depen
     auto* webService = _robot->GetContext()->GetWebService();
     if( webService != nullptr ) {
       auto onData = [this](const Json::Value& data, const std::function<void(const Json::Value&)>& sendFunc) {
+        // clients that keep the map around can ask for only what changed since the last one they got
         _webMessageDirty = true;
+        _webDeltaRequested = data.isObject() && data.get("delta", false).asBool();
+        _webBinaryRequested = data.isObject() && data.get("binary", false).asBool();
       };
       _eventHandles.emplace_back( webService->OnWebVizData( kWebVizModuleName ).ScopedSubscribe( onData ) );
+      webService->SetWebVizMaxRate( kWebVizModuleName, kWebVizMapMaxRate_hz );
     }
   }
 }
@@ -334,6 +388,8 @@ void MapComponent::HandleMessage(const ExternalInterface::SetMemoryMapBroadcastF
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MapComponent::UpdateDependent(const RobotCompMap& dependentComps)
 {
+  FlushPendingCliffs();
+
   auto currentNavMemoryMap = GetCurrentMemoryMap();
   if (currentNavMemoryMap)
   {
@@ -343,49 +399,99 @@ void MapComponent::UpdateDependent(const RobotCompMap& dependentComps)
     // Check if we should broadcast changes to navMap to different channels
     const f32 currentTime_s = BaseStationTimer::getInstance()->GetCurrentTimeInSeconds();
 
-    const bool shouldSendViz = (ENABLE_DRAWING && _vizMessageDirty && _isRenderEnabled) || _webMessageDirty;
-    const bool shouldSendSDK = _gameMessageDirty && (_broadcastRate_sec >= 0.0f);
-    
+    static f32 nextDrawTime_s = currentTime_s;
+    static f32 nextBroadcastTime_s = currentTime_s;
+    const bool shouldSendViz = ENABLE_DRAWING && _vizMessageDirty && _isRenderEnabled && FLT_LE(nextDrawTime_s, currentTime_s);
+    const bool shouldSendSDK = _gameMessageDirty && (_broadcastRate_sec >= 0.0f) && FLT_LE(nextBroadcastTime_s, currentTime_s);
+
+    // a web client that asked for a delta only gets the leaves in the areas that changed since its last update, if
+    // those are known. Anything else gets the whole map. Nothing is looked at unless a client is subscribed and the
+    // rate cap allows a send, otherwise the map stays dirty for later
+    auto* webService = (_robot->GetContext() != nullptr) ? _robot->GetContext()->GetWebService() : nullptr;
+    const bool shouldSendWeb = _webMessageDirty && (webService != nullptr) &&
+                               webService->ShouldSendToWebViz(kWebVizModuleName);
+    std::vector<AxisAlignedQuad> webChangedRegions;
+    bool shouldSendWebDelta = false;
+    if ( shouldSendWeb ) {
+      const bool changesKnown = GetChangedRegions(_webBroadcastStamp, webChangedRegions);
+      shouldSendWebDelta = _webDeltaRequested && changesKnown;
+    }
+    const bool shouldSendWebFull = shouldSendWeb && !shouldSendWebDelta;
+
+    // only pack the map when some channel will send it this tick
     MemoryMapTypes::MapBroadcastData data;
-    if( shouldSendViz || shouldSendSDK ) {
+    if( shouldSendViz || shouldSendSDK || shouldSendWebFull ) {
       currentNavMemoryMap->GetBroadcastInfo(data);
     }
 
     // send viz Messages
     if ( shouldSendViz )
     {
-      static f32 nextDrawTime_s = currentTime_s;
-      const bool doViz = FLT_LE(nextDrawTime_s, currentTime_s);
-      if( doViz ) {
-        BroadcastMapToViz(data);
+      BroadcastMapToViz(data);
 
+      // Reset the timer but don't accumulate error
+      nextDrawTime_s += ((int) (currentTime_s - nextDrawTime_s) / kMapRenderRate_sec + 1) * kMapRenderRate_sec;
+      _vizMessageDirty = false;
+    }
 
-        // Reset the timer but don't accumulate error
-        nextDrawTime_s += ((int) (currentTime_s - nextDrawTime_s) / kMapRenderRate_sec + 1) * kMapRenderRate_sec;
-        _vizMessageDirty = false;
-      }
-
-      if( _webMessageDirty ) {
-        BroadcastMapToWeb(data);
-        _webMessageDirty = false;
-      }
+    // send web Messages
+    if ( shouldSendWebFull ) {
+      BroadcastMapToWeb(data);
+    } else if ( shouldSendWebDelta ) {
+      MergeChangedRegions(webChangedRegions);
+      MemoryMapTypes::MapBroadcastData delta;
+      currentNavMemoryMap->GetBroadcastInfo(delta, webChangedRegions);
+      BroadcastMapDeltaToWeb(delta, webChangedRegions);
+    }
+    if ( shouldSendWeb ) {
+      _webMessageDirty = false;
     }
 
     // send SDK messages
     if ( shouldSendSDK )
     {
-      static f32 nextBroadcastTime_s = currentTime_s;
-      if (FLT_LE(nextBroadcastTime_s, currentTime_s)) {
-        BroadcastMapToSDK(data);
+      BroadcastMapToSDK(data);
 
-        // Reset the timer but don't accumulate error
-        nextBroadcastTime_s += ((int) (currentTime_s - nextBroadcastTime_s) / _broadcastRate_sec + 1) * _broadcastRate_sec;
-        _gameMessageDirty = false;
-      }
+      // Reset the timer but don't accumulate error
+      nextBroadcastTime_s += ((int) (currentTime_s - nextBroadcastTime_s) / _broadcastRate_sec + 1) * _broadcastRate_sec;
+      _gameMessageDirty = false;
     }
   }
 
   UpdateRobotPose();
+
+  UpdateOccupancySnapshot();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MapComponent::UpdateOccupancySnapshot()
+{
+  const auto currentMap = GetCurrentMemoryMap();
+  const auto previous = GetOccupancySnapshot();
+
+  std::vector<AxisAlignedQuad> changedRegions;
+  const bool changesKnown = GetChangedRegions(_occupancySnapshotStamp, changedRegions);
+  if ( changesKnown && previous && changedRegions.empty() ) {
+    // nothing to publish
+    return;
+  }
+
+  std::shared_ptr<const OccupancySnapshot> next;
+  if ( currentMap ) {
+    const u32 version = previous ? previous->GetVersion() + 1 : 1;
+    next = (changesKnown && previous) ? OccupancySnapshot::Update(*previous, *currentMap, changedRegions, version)
+                                      : OccupancySnapshot::Build(*currentMap, version);
+  }
+
+  std::lock_guard<std::mutex> lock(_occupancySnapshotMutex);
+  _occupancySnapshot = next;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::shared_ptr<const OccupancySnapshot> MapComponent::GetOccupancySnapshot() const
+{
+  std::lock_guard<std::mutex> lock(_occupancySnapshotMutex);
+  return _occupancySnapshot;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -400,6 +506,8 @@ void MapComponent::UpdateMapOrigins(PoseOriginID_t oldOriginID, PoseOriginID_t n
 {
   // oldOrigin is the pointer/id of the map we were just building, and it's going away. It's the current map
   // newOrigin is the pointer/id of the map that is staying, it's the one we rejiggered to, and we haven't changed in a while
+  FlushPendingCliffs();
+
   auto oldMapIter = _navMaps.find(oldOriginID);
   auto newMapIter = _navMaps.find(newOriginID);
 
@@ -422,7 +530,10 @@ void MapComponent::UpdateMapOrigins(PoseOriginID_t oldOriginID, PoseOriginID_t n
   // before we merge the object information from the memory maps, apply rejiggering also to their reported poses
   UpdateOriginsOfObjects(oldOriginID, newOriginID);
   
-  // reset newMap if we somehow lost it
+  // bring newMap back if it was evicted, or reset it if we somehow lost it
+  if (newMapIter != _navMaps.end()) {
+    RestoreEvictedMap(newOriginID, newMapIter->second);
+  }
   if (newMapIter == _navMaps.end() || nullptr == newMapIter->second.map) {
     _navMaps[newOriginID].map.reset(NavMapFactory::CreateMemoryMap());
     newMapIter = _navMaps.find(newOriginID);
@@ -474,13 +585,17 @@ void MapComponent::UpdateRobotPose()
       {kCliffSensorXOffsetRear_mm,  +kCliffSensorYOffset_mm}}; // lo L
 
     ((Pose2d) robotPoseWrtOrigin).ApplyTo(robotSensorQuad, robotSensorQuad);
-    InsertData(Poly2f(robotSensorQuad), MemoryMapData(EContentType::ClearOfCliff, currentTimestamp));
-
+    const FastPolygon robotSensorRegion( (Poly2f(robotSensorQuad)) );
 
     const Quad2f& robotQuad = _robot->GetBoundingQuadXY(robotPoseWrtOrigin);
+    const FastPolygon robotRegion( (Poly2f(robotQuad)) );
 
-    // regular clear of obstacle
-    InsertData(Poly2f(robotQuad), MemoryMapData(EContentType::ClearOfObstacle, currentTimestamp));
+    // clear of cliff under the sensors, then regular clear of obstacle. Both overlap almost entirely, so insert
+    // them together
+    InsertData({
+      {robotSensorRegion, MemoryMapData(EContentType::ClearOfCliff,    currentTimestamp).Clone()},
+      {robotRegion,       MemoryMapData(EContentType::ClearOfObstacle, currentTimestamp).Clone()}
+    });
 
     _robot->GetAIComponent().GetComponent<AIWhiteboard>().ProcessClearQuad(robotQuad);
     // update las reported pose
@@ -661,6 +776,9 @@ void MapComponent::CreateLocalizedMemoryMap(PoseOriginID_t worldOriginID)
                  "MapComponent.CreateLocalizedMemoryMap.BadWorldOriginID",
                  "ID:%d", worldOriginID);
 
+  // cliffs seen so far belong in the map we are leaving
+  FlushPendingCliffs();
+
   // clear all memory map rendering since we are building a new map
   ClearRender();
 
@@ -680,6 +798,9 @@ void MapComponent::CreateLocalizedMemoryMap(PoseOriginID_t worldOriginID)
         const PoseOriginID_t zombieOriginID = iter->first;
         posesPerOriginForObject.erase( zombieOriginID );
       }
+      if ( !iter->second.evictedPath.empty() ) {
+        Util::FileUtils::DeleteFile( iter->second.evictedPath );
+      }
       iter = _navMaps.erase(iter);
     } else {
       LOG_INFO("MapComponent.memory_map.keeping_alive_map", "%d", worldOriginID );
@@ -714,6 +835,91 @@ void MapComponent::CreateLocalizedMemoryMap(PoseOriginID_t worldOriginID)
     
     _navMaps.emplace( worldOriginID, std::move(mapInfo) );
     _currentMapOriginID = worldOriginID;
+
+    EvictColdMaps();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MapComponent::EvictColdMaps()
+{
+  size_t numResident = 0;
+  for ( const auto& entry : _navMaps ) {
+    numResident += (entry.second.map != nullptr) ? 1 : 0;
+  }
+
+  while ( numResident > (size_t) std::max(kMaxResidentNavMaps, 1) )
+  {
+    // the least recently activated map other than the current one
+    auto coldest = _navMaps.end();
+    for ( auto it = _navMaps.begin(); it != _navMaps.end(); ++it ) {
+      if ( (it->first != _currentMapOriginID) && (it->second.map != nullptr) &&
+           ((coldest == _navMaps.end()) || (it->second.activationTime_ms < coldest->second.activationTime_ms)) ) {
+        coldest = it;
+      }
+    }
+    if ( coldest == _navMaps.end() ) {
+      break;
+    }
+
+    const std::string path = GetEvictedMapPath(coldest->first);
+    if ( path.empty() || !coldest->second.map->Save(path) ) {
+      // keep it in memory rather than lose it
+      LOG_WARNING("MapComponent.EvictColdMaps.SaveFailed", "Could not evict map of origin %d", coldest->first);
+      break;
+    }
+
+    LOG_INFO("MapComponent.EvictColdMaps", "Evicted map of origin %d to '%s'", coldest->first, path.c_str());
+    coldest->second.map.reset();
+    coldest->second.evictedPath = path;
+    --numResident;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MapComponent::RestoreEvictedMap(PoseOriginID_t originID, MapInfo& info)
+{
+  if ( info.map != nullptr ) {
+    return true;
+  }
+
+  info.map.reset( NavMapFactory::CreateMemoryMap() );
+  if ( info.evictedPath.empty() ) {
+    return false;
+  }
+
+  const Pose3d& origin = _robot->GetPoseOriginList().GetOriginByID(originID);
+  const bool loaded = info.map->Load(info.evictedPath, origin);
+  if ( !loaded ) {
+    LOG_WARNING("MapComponent.RestoreEvictedMap.LoadFailed", "Lost the evicted map of origin %d", originID);
+  }
+
+  Util::FileUtils::DeleteFile( info.evictedPath );
+  info.evictedPath.clear();
+  return loaded;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::string MapComponent::GetEvictedMapPath(PoseOriginID_t originID) const
+{
+  const auto* platform = (_robot != nullptr) ? _robot->GetContextDataPlatform() : nullptr;
+  if ( platform == nullptr ) {
+    return "";
+  }
+  const std::string folder = platform->pathToResource( Util::Data::Scope::Cache, kEvictedMapsFolder );
+  return Util::FileUtils::FullFilePath( {folder, "origin_" + std::to_string(originID) + ".nmap"} );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MapComponent::DeleteEvictedMaps()
+{
+  for ( auto& entry : _navMaps ) {
+    entry.second.evictedPath.clear();
+  }
+
+  const auto* platform = (_robot != nullptr) ? _robot->GetContextDataPlatform() : nullptr;
+  if ( platform != nullptr ) {
+    Util::FileUtils::RemoveDirectory( platform->pathToResource(Util::Data::Scope::Cache, kEvictedMapsFolder) );
   }
 }
 
@@ -729,6 +935,29 @@ namespace {
 
   static_assert(kQuadsPerMessage > 0,     "MapComponent.Broadcast.InvalidQuadsPerMessage");
   static_assert(kFullQuadsPerMessage > 0, "MapComponent.Broadcast.InvalidFullQuadsPerMessage");
+
+  void AppendLittleEndian(std::vector<uint8_t>& bytes, u32 value)
+  {
+    for ( size_t i = 0; i < sizeof(value); ++i ) {
+      bytes.push_back( static_cast<uint8_t>(value >> (8 * i)) );
+    }
+  }
+
+  // binary form of one chunk of quads, for web clients that asked for it: little endian u32 origin id and sequence
+  // number, then every quad packed the same way as its clad message. A fraction of the size of the json version
+  template <typename QuadIt>
+  std::vector<uint8_t> PackQuadsForWeb(u32 originId, u32 seqNum, QuadIt begin, QuadIt end)
+  {
+    std::vector<uint8_t> bytes;
+    AppendLittleEndian(bytes, originId);
+    AppendLittleEndian(bytes, seqNum);
+    for ( auto it = begin; it != end; ++it ) {
+      const size_t offset = bytes.size();
+      bytes.resize( offset + it->Size() );
+      it->Pack( bytes.data() + offset, it->Size() );
+    }
+    return bytes;
+  }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -755,7 +984,7 @@ void MapComponent::BroadcastMapToViz(const MapBroadcastData& mapData) const
 void MapComponent::BroadcastMapToWeb(const MapBroadcastData& mapData) const
 {
   auto* webService = _robot->GetContext()->GetWebService();
-  if( webService == nullptr || !webService->IsWebVizClientSubscribed(kWebVizModuleName)) {
+  if( webService == nullptr ) {
     return;
   }
 
@@ -765,6 +994,7 @@ void MapComponent::BroadcastMapToWeb(const MapBroadcastData& mapData) const
     toWeb["type"] = "MemoryMapMessageVizBegin";
     toWeb["originId"] = _currentMapOriginID;
     toWeb["mapInfo"] = mapData.mapInfo.GetJSON();
+    toWeb["binary"] = _webBinaryRequested;
     webService->SendToWebViz(kWebVizModuleName, toWeb);
   }
 
@@ -773,6 +1003,12 @@ void MapComponent::BroadcastMapToWeb(const MapBroadcastData& mapData) const
   {
     auto start = seqNum * kQuadsPerMessage;
     auto end   = std::min(mapData.quadInfo.size(), start + kQuadsPerMessage);
+    if( _webBinaryRequested ) {
+      webService->SendBinaryToWebViz(kWebVizModuleName,
+                                     PackQuadsForWeb(_currentMapOriginID, seqNum,
+                                                     mapData.quadInfo.begin() + start, mapData.quadInfo.begin() + end));
+      continue;
+    }
     Json::Value toWeb;
     toWeb["type"] = "MemoryMapMessageViz";
     toWeb["originId"] = _currentMapOriginID;
@@ -802,6 +1038,70 @@ void MapComponent::BroadcastMapToWeb(const MapBroadcastData& mapData) const
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MapComponent::BroadcastMapDeltaToWeb(const MapBroadcastData& delta, const std::vector<AxisAlignedQuad>& regions) const
+{
+  auto* webService = _robot->GetContext()->GetWebService();
+  if( webService == nullptr ) {
+    return;
+  }
+
+  // Send the begin message, with the areas to clear before drawing the quads that follow. Every leaf that touches
+  // them is sent, so the client can redraw them completely. Changes that only affect a color (e.g. prox confidence)
+  // are not tracked, and show up with the next full map
+  {
+    Json::Value toWeb;
+    toWeb["type"] = "MemoryMapMessageVizBegin";
+    toWeb["originId"] = _currentMapOriginID;
+    toWeb["mapInfo"] = delta.mapInfo.GetJSON();
+    toWeb["delta"] = true;
+    toWeb["binary"] = _webBinaryRequested;
+    auto& regionsJson = toWeb["changedRegions"];
+    regionsJson = Json::arrayValue;
+    for( const auto& region : regions ) {
+      Json::Value regionJson;
+      regionJson["minX"] = region.GetMinVertex().x();
+      regionJson["minY"] = region.GetMinVertex().y();
+      regionJson["maxX"] = region.GetMaxVertex().x();
+      regionJson["maxY"] = region.GetMaxVertex().y();
+      regionsJson.append( regionJson );
+    }
+    webService->SendToWebViz(kWebVizModuleName, toWeb);
+  }
+
+  // chunk the quad messages
+  for(u32 seqNum = 0; seqNum * kFullQuadsPerMessage < delta.quadInfoFull.size(); seqNum++)
+  {
+    auto start = seqNum * kFullQuadsPerMessage;
+    auto end   = std::min(delta.quadInfoFull.size(), start + kFullQuadsPerMessage);
+    if( _webBinaryRequested ) {
+      webService->SendBinaryToWebViz(kWebVizModuleName,
+                                     PackQuadsForWeb(_currentMapOriginID, seqNum,
+                                                     delta.quadInfoFull.begin() + start, delta.quadInfoFull.begin() + end));
+      continue;
+    }
+    Json::Value toWeb;
+    toWeb["type"] = "MemoryMapMessageViz";
+    toWeb["originId"] = _currentMapOriginID;
+    toWeb["seqNum"] = seqNum;
+    toWeb["quadInfosFull"] = Json::arrayValue;
+    auto& quadInfo = toWeb["quadInfosFull"];
+    for( auto it = delta.quadInfoFull.begin() + start; it != delta.quadInfoFull.begin() + end; ++it ) {
+      quadInfo.append( it->GetJSON() );
+    }
+    webService->SendToWebViz(kWebVizModuleName, toWeb);
+  }
+
+  // Send the end message
+  {
+    Json::Value toWeb;
+    toWeb["type"] = "MemoryMapMessageVizEnd";
+    toWeb["originId"] = _currentMapOriginID;
+    toWeb["delta"] = true;
+    webService->SendToWebViz(kWebVizModuleName, toWeb);
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MapComponent::BroadcastMapToSDK(const MemoryMapTypes::MapBroadcastData& mapData) const
 {
@@ -1093,6 +1393,7 @@ void MapComponent::RemoveObservableObject(const ObservableObject& object, PoseOr
   auto matchPair = _navMaps.find(originID);
   if ( matchPair != _navMaps.end() )
   {
+    RestoreEvictedMap(originID, matchPair->second);
     RobotTimeStamp_t timeStamp = _robot->GetLastImageTimeStamp();
 
     // for Cubes, we can lookup by ID
@@ -1260,13 +1561,11 @@ void MapComponent::ClearRobotToEdge(const Point2f& p, const Point2f& q, const Ro
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void MapComponent::ClearRegion(const BoundedConvexSet2f& region, const RobotTimeStamp_t t)
-{
-  auto currentMap = GetCurrentMemoryMap();
-  if (currentMap)
+namespace {
+  // prox obstacles are only cleared once they have been seen as clear enough times
+  NodeTransformFunction MakeClearRegionTransform(MemoryMapDataPtr clearData)
   {
-    MemoryMapDataPtr clearData = MemoryMapData(INavMap::EContentType::ClearOfObstacle, t).Clone();
-    NodeTransformFunction trfm = [&clearData] (MemoryMapDataPtr currentData) {
+    return [clearData] (MemoryMapDataPtr currentData) {
       if (currentData->type == EContentType::ObstacleProx) {
         auto castPtr = MemoryMapData::MemoryMapDataCast<MemoryMapData_ProxObstacle>( currentData );
         castPtr->MarkClear();
@@ -1277,21 +1576,12 @@ void MapComponent::ClearRegion(const BoundedConvexSet2f& region, const RobotTime
         return currentData;
       }
     };
-    UpdateBroadcastFlags(currentMap->Insert(region, trfm));
   }
-}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void MapComponent::AddProxData(const BoundedConvexSet2f& region, const MemoryMapData& data)
-{
-  auto currentMap = GetCurrentMemoryMap();
-  if (currentMap)
+  // existing prox obstacles are only marked as observed again, and pass on whether they were explored
+  NodeTransformFunction MakeProxDataTransform(MemoryMapDataWrapper<MemoryMapData_ProxObstacle> newData)
   {
-    // Make sure we enable collision types before inserting
-    auto newData = MemoryMapData::MemoryMapDataCast<MemoryMapData_ProxObstacle>(data.Clone());
-    newData->SetCollidable(_enableProxCollisions);
-
-    NodeTransformFunction trfm = [&newData] (MemoryMapDataPtr currentData) -> MemoryMapDataPtr {
+    return [newData] (MemoryMapDataPtr currentData) -> MemoryMapDataPtr {
 
       if (currentData->type == EContentType::ObstacleProx) {
         auto castPtr = MemoryMapData::MemoryMapDataCast<MemoryMapData_ProxObstacle>( currentData );
@@ -1306,7 +1596,52 @@ void MapComponent::AddProxData(const BoundedConvexSet2f& region, const MemoryMap
         return currentData;
       }
     };
-    UpdateBroadcastFlags(currentMap->Insert(region, trfm));
+  }
+}
+
+void MapComponent::ClearRegion(const BoundedConvexSet2f& region, const RobotTimeStamp_t t)
+{
+  auto currentMap = GetCurrentMemoryMap();
+  if (currentMap)
+  {
+    MemoryMapDataPtr clearData = MemoryMapData(INavMap::EContentType::ClearOfObstacle, t).Clone();
+    UpdateBroadcastFlags(currentMap->Insert(region, MakeClearRegionTransform(clearData)));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MapComponent::AddProxData(const BoundedConvexSet2f& region, const MemoryMapData& data)
+{
+  auto currentMap = GetCurrentMemoryMap();
+  if (currentMap)
+  {
+    // Make sure we enable collision types before inserting
+    auto newData = MemoryMapData::MemoryMapDataCast<MemoryMapData_ProxObstacle>(data.Clone());
+    newData->SetCollidable(_enableProxCollisions);
+
+    UpdateBroadcastFlags(currentMap->Insert(region, MakeProxDataTransform(newData)));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MapComponent::AddProxData(const MemoryMapTypes::MemoryMapInsertList& regions)
+{
+  auto currentMap = GetCurrentMemoryMap();
+  if (currentMap && !regions.empty())
+  {
+    MemoryMapTypes::MemoryMapTransformList transforms;
+    transforms.reserve(regions.size());
+    for (const auto& entry : regions) {
+      if (entry.second->type == EContentType::ObstacleProx) {
+        auto newData = MemoryMapData::MemoryMapDataCast<MemoryMapData_ProxObstacle>(entry.second->Clone());
+        newData->SetCollidable(_enableProxCollisions);
+        transforms.emplace_back(entry.first, MakeProxDataTransform(newData));
+      } else {
+        DEV_ASSERT(entry.second->type == EContentType::ClearOfObstacle, "MapComponent.AddProxData.UnexpectedContentType");
+        transforms.emplace_back(entry.first, MakeClearRegionTransform(entry.second));
+      }
+    }
+    UpdateBroadcastFlags(currentMap->Insert(transforms));
   }
 }
   
@@ -1364,6 +1699,95 @@ void MapComponent::InsertData(const MemoryMapTypes::MemoryMapRegion& region, con
   }
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MapComponent::InsertData(const MemoryMapTypes::MemoryMapInsertList& regions)
+{
+  auto currentMap = GetCurrentMemoryMap();
+  if (currentMap)
+  {
+    UpdateBroadcastFlags(currentMap->Insert(regions));
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace {
+  // sensor cliffs go in like any other data
+  NodeTransformFunction MakeSensorCliffTransform(MemoryMapDataPtr cliffData)
+  {
+    return [cliffData] (MemoryMapDataPtr currentData) {
+      currentData->SetLastObservedTime(cliffData->GetLastObservedTime());
+      return currentData->CanOverrideSelfWithContent(cliffData) ? cliffData : currentData;
+    };
+  }
+
+  // visual cliffs are inserted without overwriting sensor-detected cliffs (merges both sources of info in the same
+  // node)
+  NodeTransformFunction MakeVisionCliffTransform(MemoryMapDataPtr cliffData)
+  {
+    return [cliffData] (MemoryMapDataPtr currentData) -> MemoryMapDataPtr {
+      if(currentData->type == EContentType::Cliff) {
+        // a node can be from the cliff sensor AND from vision
+        auto currCliff = MemoryMapData::MemoryMapDataCast<MemoryMapData_Cliff>(currentData);
+        if(currCliff->isFromCliffSensor && !currCliff->isFromVision) {
+          currCliff->isFromVision = true;
+          // already modified the current node, no need to clone it
+          return currentData;
+        }
+      } else if(currentData->CanOverrideSelfWithContent(cliffData)) {
+        // every other type of node is handled here
+        return cliffData;
+      }
+      return currentData;
+    };
+  }
+}
+
+void MapComponent::AddCliff(const Poly2f& polyWRTOrigin, const MemoryMapData_Cliff& data)
+{
+  const Point3f distThreshold(kCliffMergeDist_mm, kCliffMergeDist_mm, kCliffMergeDist_mm);
+  const Radians angleThreshold( DEG_TO_RAD(kCliffMergeAngle_deg) );
+
+  // driving along a habitat line reports nearly the same cliff over and over. Keep only the newest of those
+  for (auto& pending : _pendingCliffs) {
+    const auto pendingCliff = MemoryMapData::MemoryMapDataCast<MemoryMapData_Cliff>(pending.data);
+    if ((pendingCliff->isFromVision == data.isFromVision) &&
+        (pendingCliff->isFromCliffSensor == data.isFromCliffSensor) &&
+        pendingCliff->pose.IsSameAs(data.pose, distThreshold, angleThreshold))
+    {
+      pending.region = MemoryMapTypes::MemoryMapRegion( FastPolygon(polyWRTOrigin) );
+      pending.data = data.Clone();
+      return;
+    }
+  }
+
+  _pendingCliffs.push_back({MemoryMapTypes::MemoryMapRegion( FastPolygon(polyWRTOrigin) ), data.Clone()});
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MapComponent::FlushPendingCliffs()
+{
+  if (_pendingCliffs.empty()) {
+    return;
+  }
+
+  auto currentMap = GetCurrentMemoryMap();
+  if (currentMap)
+  {
+    MemoryMapTypes::MemoryMapTransformList transforms;
+    transforms.reserve(_pendingCliffs.size());
+    for (const auto& pending : _pendingCliffs) {
+      const auto cliff = MemoryMapData::MemoryMapDataCast<MemoryMapData_Cliff>(pending.data);
+      if (cliff->isFromVision) {
+        transforms.emplace_back(pending.region, MakeVisionCliffTransform(pending.data));
+      } else {
+        transforms.emplace_back(pending.region, MakeSensorCliffTransform(pending.data));
+      }
+    }
+    UpdateBroadcastFlags(currentMap->Insert(transforms));
+  }
+  _pendingCliffs.clear();
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool MapComponent::CheckForCollisions(const BoundedConvexSet2f& region) const
 {
@@ -1394,6 +1818,30 @@ float MapComponent::GetCollisionArea(const BoundedConvexSet2f& region) const
   return 0.f;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MapComponent::GetChangedRegions(MapChangeStamp& stamp, std::vector<AxisAlignedQuad>& regions) const
+{
+  regions.clear();
+
+  const auto currentMap = GetCurrentMemoryMap();
+  const bool sameMap = (currentMap.get() == stamp.map) && (stamp.proxEnabled == _enableProxCollisions);
+  stamp.map = currentMap.get();
+  stamp.proxEnabled = _enableProxCollisions;
+
+  if (!currentMap) {
+    stamp.count = 0;
+    return false;
+  }
+
+  if (!sameMap) {
+    // counts from another map mean nothing here, so only catch up to the current one
+    stamp.count = std::numeric_limits<u32>::max();
+  }
+
+  const bool tracked = currentMap->GetChangedRegions(stamp.count, regions);
+  return sameMap && tracked;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result MapComponent::ProcessVisionOverheadEdges(const OverheadEdgeFrame& frameInfo)
 {
@@ -1479,6 +1927,9 @@ Result MapComponent::AddVisionOverheadEdges(const OverheadEdgeFrame& frameInfo)
   }
   const Pose2d& robotPose = histState.GetPose();
 
+  // the cliff this frame is refining may still be queued
+  FlushPendingCliffs();
+
   std::vector<MemoryMapDataConstPtr> cliffNodes;
   auto result = FindSensorDetectedCliffs(cliffNodes);
   if(result != RESULT_OK) {
@@ -1575,33 +2026,14 @@ Result MapComponent::AddVisionOverheadEdges(const OverheadEdgeFrame& frameInfo)
         // data node contain visually-seen cliff information
         MemoryMapData_Cliff cliffDataVis(refinedCliffPose, frameInfo.timestamp);
         cliffDataVis.isFromVision = true;
-        const auto& cliffDataVisPtr = cliffDataVis.Clone();
-
-        // special transform function to insert visual cliffs, without overwriting
-        // sensor-detected cliffs (merges both sources of info the same node)
-        NodeTransformFunction transformVisionCliffs = [&cliffDataVisPtr] (MemoryMapDataPtr currNode) -> MemoryMapDataPtr {
-          if(currNode->type == EContentType::Cliff) {
-            // a node can be from the cliff sensor AND from vision
-            auto currCliff = MemoryMapData::MemoryMapDataCast<MemoryMapData_Cliff>(currNode);
-            if(currCliff->isFromCliffSensor && !currCliff->isFromVision) {
-              currCliff->isFromVision = true;
-              // already modified the current node, no need to clone it
-              return currNode;
-            }
-          } else if(currNode->CanOverrideSelfWithContent(cliffDataVisPtr)) {
-            // every other type of node is handled here
-            return cliffDataVisPtr;
-          }
-          return currNode;
-        };
 
         const Pose2d& refinedCliffPose2d = refinedCliffPose;
-        currentMap->Insert(FastPolygon({
+        AddCliff(Poly2f({
           refinedCliffPose2d * Point2f(-kVisionCliffPadding_mm,  kEdgeLineLengthToInsert_mm),
           refinedCliffPose2d * Point2f(-kVisionCliffPadding_mm, -kEdgeLineLengthToInsert_mm),
           refinedCliffPose2d * Point2f(0.f, -kEdgeLineLengthToInsert_mm),
           refinedCliffPose2d * Point2f(0.f,  kEdgeLineLengthToInsert_mm),
-        }), transformVisionCliffs); 
+        }), cliffDataVis);
       }
     }
   } else {
@@ -31,6 +31,7 @@
 #include <string>
 #include <list>
 #include <map>
+#include <mutex>
 
 namespace Anki {
 namespace Vector {
@@ -38,6 +39,8 @@ namespace Vector {
 // Forward declarations
 class Robot;
 class ObservableObject;
+class OccupancySnapshot;
+struct MemoryMapData_Cliff;
   
 class MapComponent : public IDependencyManagedComponent<RobotComponentID>, private Util::noncopyable
 {
@@ -92,6 +95,13 @@ public:
   // set the region defined by the given poly with the provided data.
   void InsertData(const Poly2f& polyWRTOrigin, const MemoryMapData& data);
   void InsertData(const MemoryMapTypes::MemoryMapRegion& region, const MemoryMapData& data);
+
+  // set several regions with their provided data in one pass over the map, in order
+  void InsertData(const MemoryMapTypes::MemoryMapInsertList& regions);
+
+  // queue a cliff, from the cliff sensors or from vision, to be added to the map. Cliffs queued during a tick are
+  // written in one pass at the end of it, and a cliff that lands on a queued one from the same source replaces it
+  void AddCliff(const Poly2f& polyWRTOrigin, const MemoryMapData_Cliff& data);
   
   // flags all current interesting edges as too small to give useful information
   void FlagInterestingEdgesAsUseless();
@@ -108,6 +118,7 @@ public:
   // Publish navMap to the Viz channel / Web / SDK
   void BroadcastMapToViz(const MemoryMapTypes::MapBroadcastData& mapData) const;
   void BroadcastMapToWeb(const MemoryMapTypes::MapBroadcastData& mapData) const;
+  void BroadcastMapDeltaToWeb(const MemoryMapTypes::MapBroadcastData& delta, const std::vector<AxisAlignedQuad>& regions) const;
   void BroadcastMapToSDK(const MemoryMapTypes::MapBroadcastData& mapData) const;
   
   // clear the space in the memory map between the robot and observed markers for the given object,
@@ -125,6 +136,10 @@ public:
   // flag the region as a prox obstacle
   void AddProxData(const BoundedConvexSet2f& region, const MemoryMapData& data);
 
+  // clear regions and add prox obstacles in one pass over the map, in order, the same way ClearRegion and the
+  // AddProxData above do. Data must be either ClearOfObstacle or MemoryMapData_ProxObstacle
+  void AddProxData(const MemoryMapTypes::MemoryMapInsertList& regions);
+
   // return true of the specified region contains any objects of known collision types
   bool CheckForCollisions(const BoundedConvexSet2f& region) const;
   bool CheckForCollisions(const BoundedConvexSet2f& region, const MemoryMapTypes::NodePredicate& pred) const;
@@ -132,6 +147,23 @@ public:
   // returns the accumulated area of cells in mm^2 in the current map that satisfy the predicate (and region, if supplied)
   float GetCollisionArea(const BoundedConvexSet2f& region) const;
 
+  // what a caller of GetChangedRegions has already seen
+  struct MapChangeStamp {
+    const INavMap* map         = nullptr;
+    u32            count       = 0;
+    bool           proxEnabled = false;
+  };
+
+  // clears and fills regions with the areas of the current map where collisions may have changed since stamp, then
+  // updates stamp. Returns false if the changes since then are unknown (the current map was replaced, prox settings
+  // changed, or a change was too big to track), in which case the whole map should be considered changed
+  bool GetChangedRegions(MapChangeStamp& stamp, std::vector<AxisAlignedQuad>& regions) const;
+
+  // Collision raster of the current map as of the end of the last update, or nullptr if there is no map. Snapshots
+  // never change, so they can be held on to and queried from any thread without locking the map. Anything that has
+  // to be exact should still confirm with the map what the snapshot cannot rule out
+  std::shared_ptr<const OccupancySnapshot> GetOccupancySnapshot() const;
+
   // Remove all prox obstacles from the map.
   // CAUTION: This will entirely remove _all_ information about prox
   // obstacles. This should almost never be necessary. Is this really
@@ -167,6 +199,27 @@ private:
   // update broadcast dirty flags with new changes
   void UpdateBroadcastFlags(bool wasChanged);
 
+  // writes the cliffs queued by AddCliff to the current map. Called every tick, and before anything reads cliffs
+  // from the map or the current map changes
+  void FlushPendingCliffs();
+
+  // publish a new occupancy snapshot if the map changed since the last one
+  void UpdateOccupancySnapshot();
+
+  // saves to disk and releases the maps of the least recently active origins (never the current one) while more
+  // than kMaxResidentNavMaps maps are in memory
+  void EvictColdMaps();
+
+  // loads the map of the given origin back from disk if it was evicted. Returns false if the map is not resident
+  // and could not be restored, in which case it is replaced by an empty one
+  bool RestoreEvictedMap(PoseOriginID_t originID, MapInfo& info);
+
+  // file a map of the given origin is evicted to, or empty if there is nowhere to write it
+  std::string GetEvictedMapPath(PoseOriginID_t originID) const;
+
+  // deletes every evicted map from disk
+  void DeleteEvictedMaps();
+
   // enable/disable rendering of the memory maps
   void SetRenderEnabled(bool enabled);
 
@@ -215,6 +268,7 @@ private:
     std::shared_ptr<INavMap> map;
     EngineTimeStamp_t activationTime_ms;
     TimeStamp_t activeDuration_ms;
+    std::string evictedPath; // file holding the map while it is evicted (map is null then)
   };
   
   using MapTable                  = std::map<PoseOriginID_t, MapInfo>;
@@ -234,12 +288,30 @@ private:
   bool                            _vizMessageDirty;
   bool                            _gameMessageDirty;
   bool                            _webMessageDirty;
+
+  // web clients can ask for deltas, relative to the last map they were sent
+  bool                            _webDeltaRequested = false;
+  // and for the quads as binary frames rather than json
+  bool                            _webBinaryRequested = false;
+  MapChangeStamp                  _webBroadcastStamp;
   
   bool                            _isRenderEnabled;
   float                           _broadcastRate_sec = -1.0f;      // (Negative means don't send)
 
   // config variable for conditionally enabling/disabling prox obstacles in planning
   bool                            _enableProxCollisions;
+
+  // cliffs queued by AddCliff, in the order they came in
+  struct PendingCliff {
+    MemoryMapTypes::MemoryMapRegion region;
+    MemoryMapTypes::MemoryMapDataPtr data;
+  };
+  std::vector<PendingCliff>       _pendingCliffs;
+
+  // latest occupancy snapshot, and the map changes it includes. The pointer is read from planner threads
+  mutable std::mutex                       _occupancySnapshotMutex;
+  std::shared_ptr<const OccupancySnapshot> _occupancySnapshot;
+  MapChangeStamp                           _occupancySnapshotStamp;
 };
 
 }
@@ -28,6 +28,19 @@ MemoryMapData_ObservableObject::MemoryMapData_ObservableObject(const ObservableO
 
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+MemoryMapData_ObservableObject::MemoryMapData_ObservableObject(const ObjectID& id,
+                                                               const Poly2f& p,
+                                                               RobotTimeStamp_t t,
+                                                               bool poseIsVerified)
+: MemoryMapData(MemoryMapTypes::EContentType::ObstacleObservable, t, true)
+, id(id)
+, boundingPoly(p)
+, _poseIsVerified(poseIsVerified)
+{
+
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 MemoryMapTypes::MemoryMapDataPtr MemoryMapData_ObservableObject::Clone() const
 {
@@ -56,6 +56,10 @@ public:
   }
 
 private: 
+  friend class MemoryMapFile; // restores saved maps
+
+  MemoryMapData_ObservableObject(const ObjectID& id, const Poly2f& p, RobotTimeStamp_t t, bool poseIsVerified);
+
   bool _poseIsVerified;
 };
  
@@ -75,6 +75,7 @@ public:
   // Important: this is available in all NOT_EXPLORED obstacles and only some EXPLORED. We lose
   // these params when flood filling from EXPLORED to NOT_EXPLORED, although that's not ideal. todo: fix this (FillBorder)
 private:
+  friend class MemoryMapFile; // saves and restores the belief of saved maps
 
   Pose2d       _pose;       // assumed obstacle pose (based off robot pose when detected)
   ExploredType _explored;   // has Victor visited this node?
@@ -10,6 +10,7 @@
  **/
 #include "memoryMap.h"
 
+#include "memoryMapFile.h"
 #include "memoryMapTypes.h"
 #include "data/memoryMapData_ProxObstacle.h"
 #include "data/memoryMapData_Cliff.h"
@@ -24,6 +25,7 @@
 #include <chrono>
 #include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
  
 
@@ -170,6 +172,20 @@ bool MemoryMap::Merge(const INavMap& other, const Pose3d& transform)
   return MONITOR_PERFORMANCE( _quadTree.Merge( otherMap._quadTree, transform ) );
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMap::Load(const std::string& path, const Pose3d& origin)
+{
+  std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
+  return MONITOR_PERFORMANCE( MemoryMapFile::Load(_quadTree, path, origin) );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMap::Save(const std::string& path) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  return MONITOR_PERFORMANCE( MemoryMapFile::Save(_quadTree, path) );
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool MemoryMap::FillBorder(const NodePredicate& innerPred, const NodePredicate& outerPred, const MemoryMapDataPtr& newData)
 {
@@ -194,6 +210,25 @@ double MemoryMap::GetExploredRegionAreaM2() const
   return area;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMap::GetChangedRegions(u32& stamp, std::vector<AxisAlignedQuad>& regions) const
+{
+  // delegate on processor
+  std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  return _processor.GetChangedRegions(stamp, regions);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MemoryMap::ForEachLeaf(const LeafFunction& func, const MemoryMapRegion& region) const
+{
+  std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  _quadTree.Fold( [&](const auto& node) {
+    if ( !node.IsSubdivided() ) {
+      func( node.GetBoundingBox(), static_cast<const MemoryMapDataPtr&>(node.GetData()) );
+    }
+  }, region);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool MemoryMap::AnyOf(const MemoryMapRegion& r, const NodePredicate& f) const
 {
@@ -244,26 +279,53 @@ bool MemoryMap::Insert(const MemoryMapRegion& r, NodeTransformFunction transform
   return MONITOR_PERFORMANCE( _quadTree.Insert(r, transform) );
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMap::Insert(const MemoryMapInsertList& regions)
+{
+  // same transform as inserting a single region with data, for each entry in the batch
+  QuadTreeTypes::RegionTransformList transforms;
+  transforms.reserve( regions.size() );
+  for ( const auto& entry : regions ) {
+    const MemoryMapDataPtr& dataPtr = entry.second;
+    NodeTransformFunction trfm = [&dataPtr] (const MemoryMapDataPtr& currentData) { 
+      currentData->SetLastObservedTime(dataPtr->GetLastObservedTime());
+      return currentData->CanOverrideSelfWithContent(dataPtr) ? dataPtr : currentData; 
+    };
+    transforms.emplace_back( entry.first, std::move(trfm) );
+  }
+
+  std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
+  return MONITOR_PERFORMANCE( _quadTree.Insert(transforms) );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMap::Insert(const MemoryMapTransformList& regions)
+{
+  std::unique_lock<std::shared_timed_mutex> lock(_writeAccess);
+  return MONITOR_PERFORMANCE( _quadTree.Insert(regions) );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ExternalInterface::MemoryMapInfo MemoryMap::GetBroadcastHeader() const
+{
+  std::stringstream instanceId;
+  instanceId << "QuadTree_" << this;
+
+  return ExternalInterface::MemoryMapInfo(
+    _quadTree.GetMaxHeight(),
+    _quadTree.GetSideLen(),
+    _quadTree.GetCenter().x(),
+    _quadTree.GetCenter().y(),
+    1.f,
+    instanceId.str());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MemoryMap::GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const 
 { 
   // get data for each node
   QuadTreeTypes::FoldFunctorConst accumulator = 
-    [&info, this] (const QuadTreeNode& node) {
-      // if the root done, populate header info
-      if ( node.IsRootNode() ){
-        std::stringstream instanceId;
-        instanceId << "QuadTree_" << this;
-
-        info.mapInfo = ExternalInterface::MemoryMapInfo(
-          node.GetMaxHeight(),
-          node.GetSideLen(),
-          node.GetCenter().x(),
-          node.GetCenter().y(),
-          1.f,
-          instanceId.str());
-      }
-
+    [&info] (const QuadTreeNode& node) {
       // leaf node
       if ( !node.IsSubdivided() )
       {
@@ -283,8 +345,34 @@ void MemoryMap::GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const
     };
 
   std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  info.mapInfo = GetBroadcastHeader();
   _quadTree.Fold(accumulator);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void MemoryMap::GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info, const std::vector<AxisAlignedQuad>& regions) const
+{
+  // regions may share leaves, so each one is only packed the first time it is found
+  std::unordered_set<const QuadTreeNode*> packed;
+  QuadTreeTypes::FoldFunctorConst accumulator =
+    [&info, &packed] (const QuadTreeNode& node) {
+      if ( !node.IsSubdivided() && packed.insert(&node).second ) {
+        info.quadInfoFull.emplace_back(GetNodeVizColor(node.GetData()).AsRGBA(),
+                                       node.GetCenter().x(),
+                                       node.GetCenter().y(),
+                                       node.GetSideLen());
+      }
+    };
+
+  std::shared_lock<std::shared_timed_mutex> lock(_writeAccess);
+  info.mapInfo = GetBroadcastHeader();
+  for ( const auto& region : regions ) {
+    const Point2f& minCorner = region.GetMinVertex();
+    const Point2f& maxCorner = region.GetMaxVertex();
+    const FastPolygon area({ minCorner, {maxCorner.x(), minCorner.y()}, maxCorner, {minCorner.x(), maxCorner.y()} });
+    _quadTree.Fold(accumulator, area);
+  }
+}
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void MemoryMap::FindContentIf(const NodePredicate& pred, MemoryMapDataConstList& output, const MemoryMapRegion& region) const
@@ -46,12 +46,17 @@ public:
   // add data to the memory map defined by poly
   virtual bool Insert(const MemoryMapRegion& r, const MemoryMapData& data) override;
   virtual bool Insert(const MemoryMapRegion& r, NodeTransformFunction transform) override;
+  virtual bool Insert(const MemoryMapInsertList& regions) override;
+  virtual bool Insert(const MemoryMapTransformList& regions) override;
   
   // merge the given map into this map by applying to the other's information the given transform
   // although this methods allows merging any INavMemoryMap into any INavMemoryMap, subclasses are not
   // expected to provide support for merging other subclasses, but only other instances from the same
   // subclass
   virtual bool Merge(const INavMap& other, const Pose3d& transform) override;
+
+  // replace the map with one written by Save
+  virtual bool Load(const std::string& path, const Pose3d& origin) override;
   
   // fills inner regions satisfying innerPred( inner node ) && outerPred(neighboring node), converting
   // the inner region to the given data
@@ -78,8 +83,22 @@ public:
 
   // Broadcast the memory map
   virtual void GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info) const override;
+  virtual void GetBroadcastInfo(MemoryMapTypes::MapBroadcastData& info, const std::vector<AxisAlignedQuad>& regions) const override;
+
+  // list the areas that changed since stamp
+  virtual bool GetChangedRegions(u32& stamp, std::vector<AxisAlignedQuad>& regions) const override;
+
+  // visit the leaves that intersect region
+  virtual void ForEachLeaf(const LeafFunction& func, const MemoryMapRegion& region = RealNumbers2f()) const override;
+
+  // write the map to a file
+  virtual bool Save(const std::string& path) const override;
 
 private:
+
+  // broadcast header describing the root. Requires _writeAccess to be held
+  ExternalInterface::MemoryMapInfo GetBroadcastHeader() const;
+
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Attributes
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
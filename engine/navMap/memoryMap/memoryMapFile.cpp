@@ -0,0 +1,321 @@
+/**
+ * File: memoryMapFile.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "engine/navMap/memoryMap/memoryMapFile.h"
+
+#include "engine/navMap/memoryMap/data/memoryMapData.h"
+#include "engine/navMap/memoryMap/data/memoryMapData_Cliff.h"
+#include "engine/navMap/memoryMap/data/memoryMapData_ObservableObject.h"
+#include "engine/navMap/memoryMap/data/memoryMapData_ProxObstacle.h"
+#include "engine/navMap/quadTree/quadTree.h"
+#include "engine/utils/mappedFile.h"
+
+#include "coretech/common/engine/math/pose.h"
+#include "coretech/common/engine/math/polygon_impl.h"
+
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#define LOG_CHANNEL "MemoryMap"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+
+  using namespace MemoryMapTypes;
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // File layout: FileHeader, then numNodes FlatNode, numContents FlatContent and numPoints FlatPoint. Every record is
+  // 4 byte aligned, so the arrays can be read in place from the mapped file
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  constexpr uint32_t kFileMagic   = 0x50414D4E; // "NMAP"
+  constexpr uint32_t kFileVersion = 1;
+
+  struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    float    centerX;
+    float    centerY;
+    float    sideLen;
+    uint32_t maxHeight;
+    uint32_t numNodes;
+    uint32_t numContents;
+    uint32_t numPoints;
+  };
+
+  // index into the content table, or kSubdivided for nodes with children
+  using FlatNode = uint32_t;
+  constexpr FlatNode kSubdivided = 0xFFFFFFFF;
+
+  enum FlatContentFlags : uint8_t {
+    kFromCliffSensor = 1 << 0,
+    kFromVision      = 1 << 1,
+    kExplored        = 1 << 2,
+    kCollidable      = 1 << 3,
+    kPoseIsVerified  = 1 << 4,
+  };
+
+  struct FlatContent {
+    uint8_t  type;
+    uint8_t  flags;
+    uint8_t  belief;
+    uint8_t  unused;
+    uint32_t firstObserved_ms;
+    uint32_t lastObserved_ms;
+    int32_t  objectID;
+    uint32_t firstPoint;         // bounding polygon of observable objects
+    uint32_t numPoints;
+    float    translation[3];     // cliff and prox obstacle poses, with respect to the origin
+    float    rotation[4];        // quaternion (w, x, y, z) for cliffs, angle in rotation[0] for prox obstacles
+  };
+
+  struct FlatPoint {
+    float x;
+    float y;
+  };
+
+  static_assert(sizeof(FileHeader)  % 4 == 0, "MemoryMapFile.UnalignedHeader");
+  static_assert(sizeof(FlatContent) % 4 == 0, "MemoryMapFile.UnalignedContent");
+
+  template <class T>
+  void Append(std::vector<uint8_t>& buffer, const T* data, size_t count)
+  {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T) * count);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMapFile::Save(const QuadTree& tree, const std::string& path)
+{
+  std::vector<FlatNode>    nodes;
+  std::vector<FlatContent> contents;
+  std::vector<FlatPoint>   points;
+
+  // nodes share their content instances, so store each of them once
+  std::unordered_map<const MemoryMapData*, uint32_t> contentIndices;
+
+  const FoldFunctorConst flatten = [&] (const QuadTreeNode& node) {
+    if ( node.IsSubdivided() ) {
+      nodes.push_back(kSubdivided);
+      return;
+    }
+
+    const MemoryMapDataPtr& data = node.GetData();
+    const auto inserted = contentIndices.emplace( data.GetSharedPtr().get(), (uint32_t) contents.size() );
+    nodes.push_back(inserted.first->second);
+    if ( !inserted.second ) {
+      return;
+    }
+
+    FlatContent flat;
+    memset(&flat, 0, sizeof(flat));
+    flat.type             = (uint8_t) data->type;
+    flat.firstObserved_ms = (TimeStamp_t) data->GetFirstObservedTime();
+    flat.lastObserved_ms  = (TimeStamp_t) data->GetLastObservedTime();
+
+    switch ( data->type ) {
+      case EContentType::Cliff:
+      {
+        const auto cliff = MemoryMapData::MemoryMapDataCast<MemoryMapData_Cliff>(data);
+        const Pose3d poseWrtOrigin = cliff->pose.GetWithRespectToRoot();
+        const Vec3f& t = poseWrtOrigin.GetTranslation();
+        const UnitQuaternion& q = poseWrtOrigin.GetRotation().GetQuaternion();
+        flat.flags = (cliff->isFromCliffSensor ? kFromCliffSensor : 0) | (cliff->isFromVision ? kFromVision : 0);
+        flat.translation[0] = t.x();
+        flat.translation[1] = t.y();
+        flat.translation[2] = t.z();
+        flat.rotation[0] = (float) q.w();
+        flat.rotation[1] = (float) q.x();
+        flat.rotation[2] = (float) q.y();
+        flat.rotation[3] = (float) q.z();
+        break;
+      }
+      case EContentType::ObstacleProx:
+      {
+        const auto prox = MemoryMapData::MemoryMapDataCast<MemoryMapData_ProxObstacle>(data);
+        const Pose2d& pose = prox->_pose;
+        flat.flags  = (prox->IsExplored() ? kExplored : 0) | (prox->_collidable ? kCollidable : 0);
+        flat.belief = prox->_belief;
+        flat.translation[0] = pose.GetX();
+        flat.translation[1] = pose.GetY();
+        flat.rotation[0] = pose.GetAngle().ToFloat();
+        break;
+      }
+      case EContentType::ObstacleObservable:
+      {
+        const auto object = MemoryMapData::MemoryMapDataCast<MemoryMapData_ObservableObject>(data);
+        flat.flags      = object->IsCollisionType() ? kPoseIsVerified : 0;
+        flat.objectID   = object->id.GetValue();
+        flat.firstPoint = (uint32_t) points.size();
+        flat.numPoints  = (uint32_t) object->boundingPoly.size();
+        for ( const auto& p : object->boundingPoly ) {
+          points.push_back( {p.x(), p.y()} );
+        }
+        break;
+      }
+      default:
+        break;
+    }
+
+    contents.push_back(flat);
+  };
+  tree.Fold(flatten);
+
+  FileHeader header;
+  header.magic       = kFileMagic;
+  header.version     = kFileVersion;
+  header.centerX     = tree.GetCenter().x();
+  header.centerY     = tree.GetCenter().y();
+  header.sideLen     = tree.GetSideLen();
+  header.maxHeight   = tree.GetMaxHeight();
+  header.numNodes    = (uint32_t) nodes.size();
+  header.numContents = (uint32_t) contents.size();
+  header.numPoints   = (uint32_t) points.size();
+
+  std::vector<uint8_t> buffer;
+  buffer.reserve( sizeof(header) + sizeof(FlatNode) * nodes.size() + sizeof(FlatContent) * contents.size() +
+                  sizeof(FlatPoint) * points.size() );
+  Append(buffer, &header, 1);
+  Append(buffer, nodes.data(), nodes.size());
+  Append(buffer, contents.data(), contents.size());
+  Append(buffer, points.data(), points.size());
+
+  if ( !Util::FileUtils::CreateDirectory(path, true, true) ||
+       !Util::FileUtils::WriteFileAtomic(path, buffer) ) {
+    LOG_WARNING("MemoryMapFile.Save.WriteFailed", "Could not write '%s'", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool MemoryMapFile::Load(QuadTree& tree, const std::string& path, const Pose3d& origin)
+{
+  const MappedFile file(path);
+  if ( (file.GetData() == nullptr) || (file.GetSize() < sizeof(FileHeader)) ) {
+    LOG_WARNING("MemoryMapFile.Load.ReadFailed", "Could not read '%s'", path.c_str());
+    return false;
+  }
+
+  const FileHeader& header = *reinterpret_cast<const FileHeader*>(file.GetData());
+  const size_t expectedSize = sizeof(FileHeader) + sizeof(FlatNode) * (size_t) header.numNodes +
+                              sizeof(FlatContent) * (size_t) header.numContents +
+                              sizeof(FlatPoint) * (size_t) header.numPoints;
+  if ( (header.magic != kFileMagic) || (header.version != kFileVersion) || (file.GetSize() != expectedSize) ) {
+    LOG_WARNING("MemoryMapFile.Load.BadFile", "'%s' is not a version %u map file", path.c_str(), kFileVersion);
+    return false;
+  }
+
+  const FlatNode*    nodes    = reinterpret_cast<const FlatNode*>(file.GetData() + sizeof(FileHeader));
+  const FlatContent* contents = reinterpret_cast<const FlatContent*>(nodes + header.numNodes);
+  const FlatPoint*   points   = reinterpret_cast<const FlatPoint*>(contents + header.numContents);
+
+  // build every content once, so nodes share them as they did when saved
+  std::vector<MemoryMapDataPtr> table;
+  table.reserve(header.numContents);
+  for ( uint32_t i = 0; i < header.numContents; ++i ) {
+    const FlatContent& flat = contents[i];
+    const RobotTimeStamp_t firstObserved(flat.firstObserved_ms);
+    const RobotTimeStamp_t lastObserved(flat.lastObserved_ms);
+
+    if ( flat.type >= (uint8_t) EContentType::_Count ) {
+      LOG_WARNING("MemoryMapFile.Load.BadContentType", "'%s' has content type %u", path.c_str(), flat.type);
+      return false;
+    }
+
+    MemoryMapDataPtr data;
+    const EContentType type = (EContentType) flat.type;
+    switch ( type ) {
+      case EContentType::Cliff:
+      {
+        const Rotation3d rotation( UnitQuaternion(flat.rotation[0], flat.rotation[1], flat.rotation[2], flat.rotation[3]) );
+        const Vec3f translation( flat.translation[0], flat.translation[1], flat.translation[2] );
+        MemoryMapData_Cliff cliff( Pose3d(rotation, translation, origin), firstObserved );
+        cliff.isFromCliffSensor = (flat.flags & kFromCliffSensor) != 0;
+        cliff.isFromVision      = (flat.flags & kFromVision) != 0;
+        data = cliff.Clone();
+        break;
+      }
+      case EContentType::ObstacleProx:
+      {
+        const auto explored = (flat.flags & kExplored) ? MemoryMapData_ProxObstacle::EXPLORED
+                                                       : MemoryMapData_ProxObstacle::NOT_EXPLORED;
+        MemoryMapData_ProxObstacle prox( explored, Pose2d(flat.rotation[0], flat.translation[0], flat.translation[1]),
+                                         firstObserved );
+        prox._belief     = flat.belief;
+        prox._collidable = (flat.flags & kCollidable) != 0;
+        data = prox.Clone();
+        break;
+      }
+      case EContentType::ObstacleObservable:
+      {
+        if ( (size_t) flat.firstPoint + flat.numPoints > header.numPoints ) {
+          LOG_WARNING("MemoryMapFile.Load.BadPolygon", "'%s' has a polygon out of range", path.c_str());
+          return false;
+        }
+        Poly2f poly;
+        poly.reserve(flat.numPoints);
+        for ( uint32_t p = 0; p < flat.numPoints; ++p ) {
+          poly.push_back( Point2f(points[flat.firstPoint + p].x, points[flat.firstPoint + p].y) );
+        }
+        data = MemoryMapData_ObservableObject( ObjectID(flat.objectID), poly, firstObserved,
+                                               (flat.flags & kPoseIsVerified) != 0 ).Clone();
+        break;
+      }
+      default:
+        data = MemoryMapData(type, firstObserved).Clone();
+        break;
+    }
+
+    data->SetLastObservedTime(lastObserved);
+    table.push_back(data);
+  }
+
+  uint32_t nextNode = 0;
+  bool badIndex = false;
+  const QuadTree::NodeSource source = [&] (NodeContent& content, bool& isSubdivided) {
+    if ( nextNode >= header.numNodes ) { return false; }
+
+    const FlatNode node = nodes[nextNode++];
+    isSubdivided = (node == kSubdivided);
+    if ( !isSubdivided ) {
+      if ( node >= table.size() ) {
+        badIndex = true;
+        return false;
+      }
+      content = table[node];
+    }
+    return true;
+  };
+
+  const Point2f center(header.centerX, header.centerY);
+  const uint8_t maxHeight = (uint8_t) header.maxHeight;
+  const bool rebuilt = tree.Rebuild( center, header.sideLen, maxHeight, source );
+  if ( !rebuilt || badIndex || (nextNode != header.numNodes) ) {
+    LOG_WARNING("MemoryMapFile.Load.BadTree", "'%s' does not describe a valid tree", path.c_str());
+    if ( rebuilt ) {
+      // nodes were left over, so none of it can be trusted. An empty source leaves an empty tree
+      tree.Rebuild( center, header.sideLen, maxHeight, [] (NodeContent&, bool&) { return false; } );
+    }
+    return false;
+  }
+  return true;
+}
+
+} // namespace Vector
+} // namespace Anki
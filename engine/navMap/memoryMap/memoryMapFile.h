@@ -0,0 +1,46 @@
+/**
+ * File: memoryMapFile.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: On-disk format for memory maps. The tree is stored as a flat array of nodes in depth-first order,
+ *              next to a table with the distinct contents the nodes point to, so a saved map can be mapped into
+ *              memory and rebuilt in a single pass without any region queries.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef ANKI_COZMO_MEMORY_MAP_FILE_H
+#define ANKI_COZMO_MEMORY_MAP_FILE_H
+
+#include <string>
+
+namespace Anki {
+
+class Pose3d;
+
+namespace Vector {
+
+class QuadTree;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// MemoryMapFile
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class MemoryMapFile
+{
+public:
+
+  // write the tree to the given file, replacing it. Poses stored in the contents are saved with respect to their
+  // root, which should be the origin of the map. Returns false if the file could not be written
+  static bool Save(const QuadTree& tree, const std::string& path);
+
+  // replace the tree with the one saved in the given file. Poses stored in the contents are restored as children of
+  // origin. Returns false (leaving the tree empty) if the file is missing, from another version, or corrupt
+  static bool Load(QuadTree& tree, const std::string& path, const Pose3d& origin);
+};
+
+} // namespace
+} // namespace
+
+#endif //
@@ -76,6 +76,8 @@ using MemoryMapDataList      = std::unordered_set<MemoryMapDataPtr, MemoryMapDat
 using MemoryMapDataConstList = std::unordered_set<MemoryMapDataConstPtr, MemoryMapDataHasher<const MemoryMapData>>;
 
 using NodeTransformFunction  = QuadTreeTypes::NodeTransformFunction;
+using MemoryMapInsertList    = std::vector<std::pair<MemoryMapRegion, MemoryMapDataPtr>>;
+using MemoryMapTransformList = QuadTreeTypes::RegionTransformList;
 using NodePredicate          = std::function<bool (MemoryMapDataConstPtr)>;
 
 using QuadInfoVector         = std::vector<ExternalInterface::MemoryMapQuadInfo>;
@@ -0,0 +1,269 @@
+/**
+ * File: occupancySnapshot.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "occupancySnapshot.h"
+
+#include "engine/navMap/iNavMap.h"
+
+#include "coretech/common/engine/math/fastPolygon2d.h"
+#include "coretech/common/engine/math/polygon_impl.h"
+
+#include "util/math/math.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+namespace Anki {
+namespace Vector {
+
+constexpr float  OccupancySnapshot::kCellSize_mm;
+constexpr int    OccupancySnapshot::kCoarseCellFactor;
+constexpr float  OccupancySnapshot::kCoarseCellSize_mm;
+
+namespace {
+  // map queries treat touching as intersecting, so widen query boxes by a bit more than float noise
+  const float kQueryTolerance_mm = 0.5f;
+
+  // leaves line up with cell edges, so shrink them by a fraction of a cell to not mark the neighbors they touch
+  const float kCellTolerance     = 0.01f;
+
+  // octile distance (the clearance layer's metric) is at most this much longer than the euclidean distance
+  const float kMaxOctileRatio    = 1.0824f;
+  const float kSqrt2             = 1.41421356f;
+
+  inline FastPolygon GetBoxPolygon(const Point2f& minCorner, const Point2f& maxCorner)
+  {
+    return FastPolygon({ minCorner, {maxCorner.x(), minCorner.y()}, maxCorner, {minCorner.x(), maxCorner.y()} });
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+OccupancySnapshot::OccupancySnapshot(const AxisAlignedQuad& bounds, u32 version)
+: _bounds(bounds)
+, _version(version)
+{
+  const Point2f size = bounds.GetMaxVertex() - bounds.GetMinVertex();
+  _width  = std::max(1, (int) std::ceil(size.x() / kCellSize_mm - kCellTolerance));
+  _height = std::max(1, (int) std::ceil(size.y() / kCellSize_mm - kCellTolerance));
+  _cells.assign(_width * _height, 0);
+
+  _coarseWidth  = (_width  + kCoarseCellFactor - 1) / kCoarseCellFactor;
+  _coarseHeight = (_height + kCoarseCellFactor - 1) / kCoarseCellFactor;
+  _coarseOccupied.assign(_coarseWidth * _coarseHeight, 0);
+  _coarseClearance_mm.assign(_coarseWidth * _coarseHeight, FLT_MAX);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::shared_ptr<const OccupancySnapshot> OccupancySnapshot::Build(const INavMap& map, u32 version)
+{
+  // the leaves tile the whole map, so together they give its bounds
+  Point2f minCorner( FLT_MAX,  FLT_MAX);
+  Point2f maxCorner(-FLT_MAX, -FLT_MAX);
+  map.ForEachLeaf( [&](const AxisAlignedQuad& leaf, const INavMap::MemoryMapDataPtr&) {
+    minCorner.x() = std::min(minCorner.x(), leaf.GetMinVertex().x());
+    minCorner.y() = std::min(minCorner.y(), leaf.GetMinVertex().y());
+    maxCorner.x() = std::max(maxCorner.x(), leaf.GetMaxVertex().x());
+    maxCorner.y() = std::max(maxCorner.y(), leaf.GetMaxVertex().y());
+  });
+  if ( minCorner.x() > maxCorner.x() ) {
+    minCorner = maxCorner = Point2f(0.f, 0.f);
+  }
+
+  std::shared_ptr<OccupancySnapshot> snapshot( new OccupancySnapshot(AxisAlignedQuad(minCorner, maxCorner), version) );
+  snapshot->Rasterize(map, 0, 0, snapshot->_width - 1, snapshot->_height - 1);
+  snapshot->UpdateCoarseOccupancy(0, 0, snapshot->_width - 1, snapshot->_height - 1);
+  snapshot->UpdateClearance();
+  return snapshot;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::shared_ptr<const OccupancySnapshot> OccupancySnapshot::Update(const OccupancySnapshot& previous, const INavMap& map,
+                                                                   const std::vector<AxisAlignedQuad>& changedRegions, u32 version)
+{
+  // if the map expanded, the raster has to move and grow
+  for ( const auto& region : changedRegions ) {
+    if ( !previous._bounds.Contains(region) ) {
+      return Build(map, version);
+    }
+  }
+
+  std::shared_ptr<OccupancySnapshot> snapshot( new OccupancySnapshot(previous) );
+  snapshot->_version = version;
+  for ( const auto& region : changedRegions ) {
+    int x0, y0, x1, y1;
+    if ( snapshot->GetCellRange(region, kQueryTolerance_mm, x0, y0, x1, y1) ) {
+      snapshot->Rasterize(map, x0, y0, x1, y1);
+      snapshot->UpdateCoarseOccupancy(x0, y0, x1, y1);
+    }
+  }
+  snapshot->UpdateClearance();
+  return snapshot;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool OccupancySnapshot::GetCellRange(const AxisAlignedQuad& box, float tolerance, int& x0, int& y0, int& x1, int& y1) const
+{
+  const Point2f minCell = (box.GetMinVertex() - _bounds.GetMinVertex() - Point2f(tolerance, tolerance)) * (1.f / kCellSize_mm);
+  const Point2f maxCell = (box.GetMaxVertex() - _bounds.GetMinVertex() + Point2f(tolerance, tolerance)) * (1.f / kCellSize_mm);
+  if ( (maxCell.x() < 0.f) || (maxCell.y() < 0.f) || (minCell.x() >= _width) || (minCell.y() >= _height) ) {
+    return false;
+  }
+
+  x0 = std::max(0, (int) std::floor(minCell.x()));
+  y0 = std::max(0, (int) std::floor(minCell.y()));
+  x1 = std::min(_width  - 1, (int) std::floor(maxCell.x()));
+  y1 = std::min(_height - 1, (int) std::floor(maxCell.y()));
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OccupancySnapshot::Rasterize(const INavMap& map, int x0, int y0, int x1, int y1)
+{
+  for ( int y = y0; y <= y1; ++y ) {
+    std::fill(_cells.begin() + y * _width + x0, _cells.begin() + y * _width + x1 + 1, 0);
+  }
+
+  const Point2f& origin = _bounds.GetMinVertex();
+  const FastPolygon area = GetBoxPolygon( origin + Point2f(x0, y0) * kCellSize_mm, origin + Point2f(x1 + 1, y1 + 1) * kCellSize_mm );
+  map.ForEachLeaf( [&](const AxisAlignedQuad& leaf, const INavMap::MemoryMapDataPtr& data) {
+    if ( !data->IsCollisionType() ) { return; }
+
+    // cells overlapping the inside of the leaf, within the area being rasterized
+    const Point2f minCell = (leaf.GetMinVertex() - origin) * (1.f / kCellSize_mm);
+    const Point2f maxCell = (leaf.GetMaxVertex() - origin) * (1.f / kCellSize_mm);
+    const int lx0 = std::max(x0, (int) std::floor(minCell.x() + kCellTolerance));
+    const int ly0 = std::max(y0, (int) std::floor(minCell.y() + kCellTolerance));
+    const int lx1 = std::min(x1, (int) std::ceil(maxCell.x() - kCellTolerance) - 1);
+    const int ly1 = std::min(y1, (int) std::ceil(maxCell.y() - kCellTolerance) - 1);
+    for ( int y = ly0; y <= ly1; ++y ) {
+      for ( int x = lx0; x <= lx1; ++x ) {
+        _cells[y * _width + x] = 1;
+      }
+    }
+  }, area);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OccupancySnapshot::UpdateCoarseOccupancy(int x0, int y0, int x1, int y1)
+{
+  const int cx0 = x0 / kCoarseCellFactor;
+  const int cy0 = y0 / kCoarseCellFactor;
+  const int cx1 = x1 / kCoarseCellFactor;
+  const int cy1 = y1 / kCoarseCellFactor;
+  for ( int cy = cy0; cy <= cy1; ++cy ) {
+    for ( int cx = cx0; cx <= cx1; ++cx ) {
+      uint8_t occupied = 0;
+      const int yEnd = std::min(_height, (cy + 1) * kCoarseCellFactor);
+      const int xEnd = std::min(_width,  (cx + 1) * kCoarseCellFactor);
+      for ( int y = cy * kCoarseCellFactor; y < yEnd; ++y ) {
+        for ( int x = cx * kCoarseCellFactor; x < xEnd; ++x ) {
+          occupied |= _cells[y * _width + x];
+        }
+      }
+      _coarseOccupied[cy * _coarseWidth + cx] = occupied;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void OccupancySnapshot::UpdateClearance()
+{
+  // two pass chamfer transform, which gives the octile distance (in coarse cells) to the nearest occupied cell
+  std::vector<float>& dist = _coarseClearance_mm;
+  const int w = _coarseWidth;
+  const int h = _coarseHeight;
+  for ( int i = 0; i < w * h; ++i ) {
+    dist[i] = _coarseOccupied[i] ? 0.f : FLT_MAX;
+  }
+
+  const auto relax = [&dist](int i, int j, float cost) {
+    if ( dist[j] != FLT_MAX ) { dist[i] = std::min(dist[i], dist[j] + cost); }
+  };
+
+  for ( int y = 0; y < h; ++y ) {
+    for ( int x = 0; x < w; ++x ) {
+      const int i = y * w + x;
+      if ( x > 0 )                { relax(i, i - 1, 1.f); }
+      if ( y > 0 )                { relax(i, i - w, 1.f); }
+      if ( (x > 0) && (y > 0) )   { relax(i, i - w - 1, kSqrt2); }
+      if ( (x < w-1) && (y > 0) ) { relax(i, i - w + 1, kSqrt2); }
+    }
+  }
+  for ( int y = h - 1; y >= 0; --y ) {
+    for ( int x = w - 1; x >= 0; --x ) {
+      const int i = y * w + x;
+      if ( x < w-1 )                { relax(i, i + 1, 1.f); }
+      if ( y < h-1 )                { relax(i, i + w, 1.f); }
+      if ( (x < w-1) && (y < h-1) ) { relax(i, i + w + 1, kSqrt2); }
+      if ( (x > 0) && (y < h-1) )   { relax(i, i + w - 1, kSqrt2); }
+    }
+  }
+
+  // Convert to a lower bound in mm on the distance from any point in a cell to any collision in the nearest occupied
+  // cell: both can be anywhere in their cells, so take off a cell diagonal
+  for ( int i = 0; i < w * h; ++i ) {
+    if ( dist[i] != FLT_MAX ) {
+      dist[i] = std::max(0.f, dist[i] * kCoarseCellSize_mm / kMaxOctileRatio - kCoarseCellSize_mm * kSqrt2);
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool OccupancySnapshot::IsCollision(const Point2f& p) const
+{
+  const Point2f cell = (p - _bounds.GetMinVertex()) * (1.f / kCellSize_mm);
+  const int x = (int) std::floor(cell.x());
+  const int y = (int) std::floor(cell.y());
+  if ( (x < 0) || (y < 0) || (x >= _width) || (y >= _height) ) {
+    return false;
+  }
+  return _cells[y * _width + x] != 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+float OccupancySnapshot::GetClearance_mm(const Point2f& p) const
+{
+  // everything is inside the raster, so the nearest point of the raster is at least as close to it as p is
+  const Point2f cell = (p - _bounds.GetMinVertex()) * (1.f / kCoarseCellSize_mm);
+  const int x = Util::Clamp( (int) std::floor(cell.x()), 0, _coarseWidth - 1 );
+  const int y = Util::Clamp( (int) std::floor(cell.y()), 0, _coarseHeight - 1 );
+  return _coarseClearance_mm[y * _coarseWidth + x];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool OccupancySnapshot::MayCollide(const Ball2f& ball) const
+{
+  if ( GetClearance_mm(ball.GetCentroid()) > ball.GetRadius() + kQueryTolerance_mm ) {
+    return false;
+  }
+  return MayCollide( ball.GetAxisAlignedBoundingBox() );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool OccupancySnapshot::MayCollide(const AxisAlignedQuad& box) const
+{
+  int x0, y0, x1, y1;
+  if ( !GetCellRange(box, kQueryTolerance_mm, x0, y0, x1, y1) ) {
+    return false;
+  }
+
+  for ( int y = y0; y <= y1; ++y ) {
+    const auto row = _cells.begin() + y * _width;
+    if ( std::any_of(row + x0, row + x1 + 1, [](uint8_t c) { return c != 0; }) ) {
+      return true;
+    }
+  }
+  return false;
+}
+
+} // namespace Vector
+} // namespace Anki
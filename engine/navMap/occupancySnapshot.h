@@ -0,0 +1,108 @@
+/**
+ * File: occupancySnapshot.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Immutable, flat raster of the collision state of a nav map, with a coarse clearance layer. It is
+ *              cheap to query from any thread without touching the map, so planners can use it to skip the map
+ *              entirely wherever it is clearly free of obstacles.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef ANKI_COZMO_OCCUPANCY_SNAPSHOT_H
+#define ANKI_COZMO_OCCUPANCY_SNAPSHOT_H
+
+#include "coretech/common/engine/math/axisAlignedHyperCube.h"
+#include "coretech/common/engine/math/ball.h"
+#include "coretech/common/shared/types.h"
+
+#include <memory>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class INavMap;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Class OccupancySnapshot
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class OccupancySnapshot
+{
+public:
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Construction
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // rasterize the whole map
+  static std::shared_ptr<const OccupancySnapshot> Build(const INavMap& map, u32 version);
+
+  // copy of previous where only the given regions of the map are rasterized again. Falls back to a full build if
+  // the map grew past the previous bounds
+  static std::shared_ptr<const OccupancySnapshot> Update(const OccupancySnapshot& previous, const INavMap& map,
+                                                         const std::vector<AxisAlignedQuad>& changedRegions, u32 version);
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Query
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // increases with every snapshot MapComponent publishes while it has a map
+  u32 GetVersion() const { return _version; }
+
+  // area covered by the raster. Everything outside of it is free, as in the map
+  const AxisAlignedQuad& GetBounds() const { return _bounds; }
+
+  // true if the fine cell containing p overlaps any collision node
+  bool IsCollision(const Point2f& p) const;
+
+  // lower bound on the distance from p to the nearest collision node, from the coarse layer
+  float GetClearance_mm(const Point2f& p) const;
+
+  // Returns false if no collision node can intersect the given area, in which case a map query would find nothing.
+  // True means the area is near something, and only the map can tell
+  bool MayCollide(const Ball2f& ball) const;
+  bool MayCollide(const AxisAlignedQuad& box) const;
+
+  // resolution of both layers
+  static constexpr float  kCellSize_mm       = 16.f;
+  static constexpr int    kCoarseCellFactor  = 4;
+  static constexpr float  kCoarseCellSize_mm = kCellSize_mm * kCoarseCellFactor;
+
+private:
+
+  OccupancySnapshot(const AxisAlignedQuad& bounds, u32 version);
+
+  // fine cell index range covering the box, clamped to the raster. Returns false if the box is fully outside
+  bool GetCellRange(const AxisAlignedQuad& box, float tolerance, int& x0, int& y0, int& x1, int& y1) const;
+
+  // mark the cells overlapping the collision leaves of the map within the given cells
+  void Rasterize(const INavMap& map, int x0, int y0, int x1, int y1);
+
+  // recompute the coarse occupancy of the coarse cells covering the given fine cells
+  void UpdateCoarseOccupancy(int x0, int y0, int x1, int y1);
+
+  // recompute the clearance layer from the coarse occupancy
+  void UpdateClearance();
+
+  AxisAlignedQuad        _bounds;
+  u32                    _version;
+
+  // fine layer, 1 for cells that overlap a collision node
+  int                    _width;
+  int                    _height;
+  std::vector<uint8_t>   _cells;
+
+  // coarse layer
+  int                    _coarseWidth;
+  int                    _coarseHeight;
+  std::vector<uint8_t>   _coarseOccupied;
+  std::vector<float>     _coarseClearance_mm;
+};
+
+} // namespace
+} // namespace
+
+#endif //
@@ -32,6 +32,7 @@ namespace {
 constexpr float kQuadTreeInitialRootSideLength = 128.0f;
 constexpr uint8_t kQuadTreeInitialMaxDepth = 4;
 constexpr uint8_t kQuadTreeMaxRootDepth = 8;
+constexpr size_t kQuadTreeChildBlocksPerSlab = 64;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -39,15 +40,25 @@ QuadTree::QuadTree(
   std::function<void (const QuadTreeNode*)> destructorCallback,
   std::function<void (const QuadTreeNode*, const NodeContent&)> modifiedCallback
 )
+: _nodePool(kNumChildren * sizeof(QuadTreeNode), kQuadTreeChildBlocksPerSlab)
+, _destructorCallback(destructorCallback)
+, _modifiedCallback(modifiedCallback)
 {
   _sideLen            = kQuadTreeInitialRootSideLength;
   _maxHeight          = kQuadTreeInitialMaxDepth;
   _quadrant           = EQuadrant::Root;
-  _address            = {};
   _boundingBox        = AxisAlignedQuad(_center - Point2f(_sideLen*.5f), _center + Point2f(_sideLen*.5));
+  _tree               = this;
+}
 
-  _destructorCallback = destructorCallback;
-  _modifiedCallback   = modifiedCallback;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTree::~QuadTree()
+{
+  // notify and release all nodes now, since the pool and callbacks are gone by the time the base class is destroyed
+  _destructorCallback(this);
+  QuadTreeNode* children = _children;
+  _children = nullptr;
+  ReleaseChildren(children);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -96,6 +107,90 @@ bool QuadTree::Insert(const FoldableRegion& region, NodeTransformFunction transf
   return contentChanged;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTree::Insert(const RegionTransformList& regions)
+{
+  // expand up front for the whole batch, so that the descent below sees the final root
+  for ( const auto& entry : regions )
+  {
+    const AxisAlignedQuad aabb = entry.first.GetBoundingBox();
+    if ( !_boundingBox.Contains( aabb ) )
+    {
+      ExpandToFit( aabb );
+    }
+  }
+
+  std::vector<BatchEntry> active;
+  active.reserve( regions.size() * (kQuadTreeMaxRootDepth + 2) );
+  for ( size_t i = 0; i < regions.size(); ++i ) {
+    active.push_back( {i, false} );
+  }
+
+  return InsertBatch(*this, regions, active, 0, regions.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTree::InsertBatch(QuadTreeNode& node, const RegionTransformList& regions, std::vector<BatchEntry>& active, size_t begin, size_t end)
+{
+  // narrow the parent's entries down to the ones that reach this node, keeping them in insertion order
+  const size_t nodeBegin = active.size();
+  for ( size_t i = begin; i < end; ++i )
+  {
+    const BatchEntry entry = active[i]; // copy, since push_back may reallocate
+    if ( entry.containsNode ) {
+      active.push_back( entry );
+    } else {
+      const FoldableRegion& region = regions[entry.index].first;
+      if ( region.IntersectsQuad(node._boundingBox) ) {
+        active.push_back( {entry.index, region.ContainsQuad(node._boundingBox)} );
+      }
+    }
+  }
+  const size_t nodeEnd = active.size();
+
+  bool contentChanged = false;
+  size_t childBegin = nodeBegin;
+  if ( !node.IsSubdivided() )
+  {
+    // apply the entries in order until one of them needs to split the node, in which case that one and the rest
+    // carry on in the children (the ones before it did not change anything). Nodes at max depth can't split, so
+    // they apply every entry and are only set once with the final content
+    NodeContent content = node.GetData();
+    bool leafChanged = false;
+    for ( ; childBegin < nodeEnd; ++childBegin )
+    {
+      auto newData = regions[active[childBegin].index].second(content);
+      if ( content != newData ) {
+        if ( node.Subdivide() ) {
+          break;
+        }
+        content = std::move(newData);
+        leafChanged = true;
+      }
+    }
+
+    if ( leafChanged ) {
+      node.ForceSetContent( std::move(content) );
+      contentChanged = true;
+    }
+  }
+
+  if ( node.IsSubdivided() && (childBegin < nodeEnd) )
+  {
+    for ( auto& child : node.GetChildren() ) {
+      contentChanged |= InsertBatch(child, regions, active, childBegin, nodeEnd);
+    }
+
+    // try to cleanup tree, now that the children have seen the whole batch
+    if ( contentChanged ) {
+      node.TryAutoMerge();
+    }
+  }
+
+  active.resize( nodeBegin );
+  return contentChanged;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool QuadTree::Transform(const FoldableRegion& region, NodeTransformFunction transform)
 {
@@ -198,6 +293,58 @@ bool QuadTree::Merge(const QuadTree& other, const Pose3d& transform)
   return changed;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTree::Rebuild(const Point2f& center, float sideLen, uint8_t maxHeight, const NodeSource& source)
+{
+  Clear();
+
+  _center      = center;
+  _sideLen     = sideLen;
+  _maxHeight   = maxHeight;
+  _boundingBox = AxisAlignedQuad(_center - Point2f(_sideLen*.5f), _center + Point2f(_sideLen*.5f));
+
+  if ( !RebuildNode(*this, source) ) {
+    Clear();
+    return false;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTree::RebuildNode(QuadTreeNode& node, const NodeSource& source)
+{
+  NodeContent content;
+  bool isSubdivided = false;
+  if ( !source(content, isSubdivided) ) {
+    return false;
+  }
+
+  if ( !isSubdivided ) {
+    node.ForceSetContent( std::move(content) );
+    return true;
+  }
+
+  if ( !node.Subdivide() ) {
+    return false;
+  }
+
+  for ( auto& child : node.GetChildren() ) {
+    if ( !RebuildNode(child, source) ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTree::Clear()
+{
+  QuadTreeNode* children = _children;
+  _children = nullptr;
+  ReleaseChildren(children);
+  ForceSetContent(NodeContent());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool QuadTree::ExpandToFit(const AxisAlignedQuad& region)
 {  
@@ -288,8 +435,8 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
   
     if ( xShift )
     {
-      std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-      std::swap(oldChildren, _childrenPtr);
+      QuadTreeNode* oldChildren = nullptr;
+      std::swap(oldChildren, _children);
       Subdivide();
 
       // make two pairs, (a1->a2) and (b1->b2) that will be swapped depending on the direction of the shift.
@@ -298,14 +445,17 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
       const size_t b1 = (Q2N) ( xPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::PlusXMinusY);
       const size_t b2 = (Q2N) (!xPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::PlusXMinusY);
 
-      _childrenPtr[a1]->SwapChildrenAndContent(oldChildren[a2].get() );
-      _childrenPtr[b1]->SwapChildrenAndContent(oldChildren[b2].get() );
+      _children[a1].SwapChildrenAndContent( &oldChildren[a2] );
+      _children[b1].SwapChildrenAndContent( &oldChildren[b2] );
+
+      // delete everything in oldChildren since we put the nodes we are keeping back into their new position
+      ReleaseChildren( oldChildren );
     }
 
     if ( yShift )
     {
-      std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-      std::swap(oldChildren, _childrenPtr);
+      QuadTreeNode* oldChildren = nullptr;
+      std::swap(oldChildren, _children);
       Subdivide();
       
       // make two pairs, (a1->a2) and (b1->b2) that will be swapped depending on the direction of the shift.
@@ -314,9 +464,11 @@ bool QuadTree::ShiftRoot(const AxisAlignedQuad& region)
       const size_t b1 = (Q2N) ( yPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::MinusXPlusY);
       const size_t b2 = (Q2N) (!yPlusAxisReq ? EQuadrant::MinusXMinusY : EQuadrant::MinusXPlusY);
 
+      _children[a1].SwapChildrenAndContent( &oldChildren[a2] );
+      _children[b1].SwapChildrenAndContent( &oldChildren[b2] );
+
       // delete everything in oldChildren since we put the nodes we are keeping back into their new position
-      _childrenPtr[a1]->SwapChildrenAndContent(oldChildren[a2].get() );
-      _childrenPtr[b1]->SwapChildrenAndContent(oldChildren[b2].get() );
+      ReleaseChildren( oldChildren );
     }
   }
 
@@ -361,20 +513,20 @@ bool QuadTree::UpgradeRootLevel(const Point2f& direction, uint8_t maxRootLevel)
   ++_maxHeight;
   
   // temporary take its children, then subdivide this node again
-  std::vector< std::unique_ptr<QuadTreeNode> > oldChildren;
-  std::swap(oldChildren, _childrenPtr);
+  QuadTreeNode* oldChildren = nullptr;
+  std::swap(oldChildren, _children);
   Subdivide();
 
   // calculate the child that takes my place by using the opposite direction to expansion
   QuadTreeNode* childTakingMyPlace = GetChild( Vec2Quadrant(-direction) );
   
   // set the new parent in my old children
-  for ( auto& childPtr : oldChildren ) {
-    childPtr->ChangeParent( childTakingMyPlace );
+  for ( size_t i = 0; (nullptr != oldChildren) && (i < kNumChildren); ++i ) {
+    oldChildren[i].ChangeParent( childTakingMyPlace );
   }
   
-  // swap children with the temp
-  std::swap(childTakingMyPlace->_childrenPtr, oldChildren);
+  // hand the old children over to the new child, which was just created and has none
+  std::swap(childTakingMyPlace->_children, oldChildren);
 
   // set the content type I had in the child that takes my place, then reset my content
   childTakingMyPlace->ForceSetContent( NodeContent(_content) );
@@ -13,6 +13,7 @@
 #define ANKI_COZMO_QUAD_TREE_H
 
 #include "quadTreeNode.h"
+#include "quadTreeNodePool.h"
 
 namespace Anki {
 
@@ -23,6 +24,7 @@ namespace Vector {
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class QuadTree : public QuadTreeNode
 {
+  friend class QuadTreeNode;
 public:
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -34,6 +36,7 @@ public:
     std::function<void (const QuadTreeNode*)> destructorCallback,
     std::function<void (const QuadTreeNode*, const NodeContent&)> modifiedCallback
   );
+  ~QuadTree();
   
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Accessors
@@ -50,6 +53,11 @@ public:
   // notify the QT that the given region has the specified content. If a NodeTransformFunction is specified instead of 
   // data, that node will subdivide as necessary and then apply the transform to the default leaf data
   bool Insert(const FoldableRegion& region, NodeTransformFunction transform);
+
+  // insert several regions, each with its own transform, in a single descent of the tree. The resulting content is
+  // the same as calling Insert for each of them in order, but every node is visited once for the whole batch, leaves
+  // touched by several regions are only set (and notified) once, and merging is deferred until the end
+  bool Insert(const RegionTransformList& regions);
   
   // modify content bounded by region. Note that if the region extends outside the current size of the root node,
   // it will not expand the root node
@@ -59,6 +67,14 @@ public:
   // merge the given quadtree into this quad tree, applying to the quads from other the given transform
   bool Merge(const QuadTree& other, const Pose3d& transform);
 
+  // source of nodes for Rebuild, in depth-first order (a node, then its children by quadrant). Fills in the content of
+  // the next node (ignored for subdivided ones) and if it is subdivided. Returns false if there are no nodes left
+  using NodeSource = std::function<bool (NodeContent& content, bool& isSubdivided)>;
+
+  // replace the whole tree with a root of the given size and the nodes from source, without any of the intersection
+  // checks an Insert needs. Returns false if source ends early or goes deeper than maxHeight, leaving an empty tree
+  bool Rebuild(const Point2f& center, float sideLen, uint8_t maxHeight, const NodeSource& source);
+
 
 private:
 
@@ -85,6 +101,35 @@ private:
   // maxRootLevel: it won't upgrade if the root is already higher level than the specified
   bool UpgradeRootLevel(const Point2f& direction, uint8_t maxRootLevel);
 
+  // entry of a batch insert that reaches the node being visited. A region that contains a node also contains all of
+  // its descendants, so they don't need to be checked against it again
+  struct BatchEntry {
+    size_t index;
+    bool   containsNode;
+  };
+
+  // applies to node and its descendants the entries in active[begin, end) whose region reaches them, then merges node
+  // back if possible. Entries for the children are pushed to (and popped from) the back of active as it recurses.
+  // Returns true if any content changed
+  bool InsertBatch(QuadTreeNode& node, const RegionTransformList& regions, std::vector<BatchEntry>& active, size_t begin, size_t end);
+
+  // sets node and its descendants from source. Returns false if source is not a valid tree under node
+  bool RebuildNode(QuadTreeNode& node, const NodeSource& source);
+
+  // releases every child of the root and resets its content
+  void Clear();
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // Attributes
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  // storage for the children of every node in the tree
+  QuadTreeNodePool _nodePool;
+
+  // callbacks to notify external system if an element has changed or been destroyed, shared by all nodes
+  std::function<void (const QuadTreeNode*)> _destructorCallback;
+  std::function<void (const QuadTreeNode*, const NodeContent&)> _modifiedCallback;
+
 }; // class
   
 } // namespace
@@ -12,10 +12,15 @@
  * Copyright: Anki, Inc. 2015
 **/
 #include "quadTreeNode.h"
+#include "quadTree.h"
 #include "engine/navMap/memoryMap/data/memoryMapData.h"
 
+#include "util/logging/logging.h"
 #include "util/math/math.h"
 
+#include <algorithm>
+#include <new>
+
 namespace Anki {
 namespace Vector {
 
@@ -31,7 +36,9 @@ namespace {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QuadTreeNode::QuadTreeNode(const QuadTreeNode* parent, EQuadrant quadrant)
-: _boundingBox({0,0}, {0,0})
+: _children(nullptr)
+, _tree(nullptr)
+, _boundingBox({0,0}, {0,0})
 , _parent(parent)
 , _quadrant(quadrant)
 {
@@ -41,28 +48,36 @@ QuadTreeNode::QuadTreeNode(const QuadTreeNode* parent, EQuadrant quadrant)
     _center       = _parent->GetCenter() + Quadrant2Vec(_quadrant) * halfLen;
     _maxHeight    = _parent->GetMaxHeight() - 1;
     _boundingBox  = AxisAlignedQuad(_center - Point2f(halfLen), _center + Point2f(halfLen));
-
-    _destructorCallback = _parent->_destructorCallback;
-    _modifiedCallback   = _parent->_modifiedCallback;
+    _tree         = _parent->_tree;
   }
-  
-  ResetAddress();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 QuadTreeNode::~QuadTreeNode()
 {
-  _destructorCallback(this);
+  // children are released (and the tree notified) by whoever destroys us, while the tree is still valid
+  DEV_ASSERT(!IsSubdivided(), "QuadTreeNode.Destructor.ChildrenNotReleased");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+NodeAddress QuadTreeNode::GetAddress() const
+{
+  NodeAddress address;
+  for (const QuadTreeNode* node = this; !node->IsRootNode(); node = node->_parent) {
+    address.push_back(node->_quadrant);
+  }
+  std::reverse(address.begin(), address.end());
+  return address;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void QuadTreeNode::ResetAddress()
+size_t QuadTreeNode::GetDepth() const
 {
-  _address.clear();
-  if(_parent) { 
-    _address = NodeAddress(_parent->GetAddress()); 
-    _address.push_back(_quadrant);
+  size_t depth = 0;
+  for (const QuadTreeNode* node = this; !node->IsRootNode(); node = node->_parent) {
+    ++depth;
   }
+  return depth;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -70,14 +85,15 @@ bool QuadTreeNode::Subdivide()
 {
   if ( (_maxHeight == 0) || IsSubdivided() ) { return false; }
   
-  // create new children, push our data to them, then clear our own data
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::PlusXPlusY) );   // up L
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::PlusXMinusY) );  // up R
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::MinusXPlusY) );  // lo L
-  _childrenPtr.emplace_back( new QuadTreeNode(this, EQuadrant::MinusXMinusY) ); // lo R
-
-  for ( auto& childPtr : _childrenPtr ) {
-    childPtr->ForceSetContent( NodeContent(_content) );
+  // create new children next to each other in one block from the pool, push our data to them, then clear our own data
+  QuadTreeNode* children = static_cast<QuadTreeNode*>( _tree->_nodePool.Allocate() );
+  for ( size_t i = 0; i < kNumChildren; ++i ) {
+    new (&children[i]) QuadTreeNode(this, (EQuadrant) i); // up L, up R, lo L, lo R
+  }
+  _children = children;
+
+  for ( auto& child : GetChildren() ) {
+    child.ForceSetContent( NodeContent(_content) );
   }
 
   ForceSetContent(NodeContent());
@@ -85,6 +101,25 @@ bool QuadTreeNode::Subdivide()
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNode::ReleaseChildren(QuadTreeNode* children)
+{
+  if ( nullptr == children ) {
+    return;
+  }
+
+  // same order as destroying a tree top down: each node is notified before its own children
+  for ( size_t i = 0; i < kNumChildren; ++i ) {
+    QuadTreeNode& child = children[i];
+    _tree->_destructorCallback(&child);
+    child.ReleaseChildren(child._children);
+    child._children = nullptr;
+    child.~QuadTreeNode();
+  }
+
+  _tree->_nodePool.Free(children);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void QuadTreeNode::TryAutoMerge()
 {
@@ -93,8 +128,8 @@ void QuadTreeNode::TryAutoMerge()
   }
 
   // can't merge if any children are subdivided
-  for (const auto& child : _childrenPtr) {
-    if ( child->IsSubdivided() ) {
+  for (const auto& child : GetChildren()) {
+    if ( child.IsSubdivided() ) {
       return;
     }
   }
@@ -102,19 +137,21 @@ void QuadTreeNode::TryAutoMerge()
   bool allChildrenEqual = true;
   
   // check if all children classified the same content (assumes node content equality is transitive)
-  for(size_t i=0; i<_childrenPtr.size()-1; ++i)
+  for(size_t i=0; i<kNumChildren-1; ++i)
   {
-    allChildrenEqual &= (_childrenPtr[i]->GetData() == _childrenPtr[i+1]->GetData());
+    allChildrenEqual &= (_children[i].GetData() == _children[i+1].GetData());
   }
   
   // we can merge and set that type on this parent
   if ( allChildrenEqual )
   {
     // do a copy since merging will destroy children
-    auto content = _childrenPtr[0]->GetData();
+    auto content = _children[0].GetData();
     ForceSetContent(std::move(content));
 
-    _childrenPtr.clear();    
+    QuadTreeNode* children = _children;
+    _children = nullptr;
+    ReleaseChildren(children);
   }
 }
 
@@ -122,31 +159,23 @@ void QuadTreeNode::TryAutoMerge()
 void QuadTreeNode::ForceSetContent(NodeContent&& newContent)
 {
   std::swap(_content, newContent);
-  _modifiedCallback(this, newContent);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void QuadTreeNode::ChangeParent(const QuadTreeNode* newParent) 
-{ 
-  _parent = newParent; 
-  FoldFunctor reset = [] (QuadTreeNode& node) { node.ResetAddress(); };
-  Fold(reset);
+  _tree->_modifiedCallback(this, newContent);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void QuadTreeNode::SwapChildrenAndContent(QuadTreeNode* otherNode)
 {
   // swap children
-  std::swap(_childrenPtr, otherNode->_childrenPtr);
+  std::swap(_children, otherNode->_children);
 
   // notify the children of the parent change
-  for ( auto& childPtr : _childrenPtr ) {
-    childPtr->ChangeParent( this );
+  for ( auto& child : GetChildren() ) {
+    child.ChangeParent( this );
   }
 
   // notify the children of the parent change
-  for ( auto& childPtr : otherNode->_childrenPtr ) {
-    childPtr->ChangeParent( otherNode );
+  for ( auto& child : otherNode->GetChildren() ) {
+    child.ChangeParent( otherNode );
   }
 
   // swap contents by use of copy, since changes have to be notified to the processor
@@ -159,9 +188,9 @@ void QuadTreeNode::SwapChildrenAndContent(QuadTreeNode* otherNode)
 const QuadTreeNode* QuadTreeNode::GetChild(EQuadrant quadrant) const
 {
   const QuadTreeNode* ret =
-    ( _childrenPtr.empty() ) ?
+    ( nullptr == _children ) ?
     ( nullptr ) :
-    ( _childrenPtr[(std::underlying_type<EQuadrant>::type)quadrant].get() );
+    ( &_children[(std::underlying_type<EQuadrant>::type)quadrant] );
   return ret;
 }
 
@@ -169,9 +198,9 @@ const QuadTreeNode* QuadTreeNode::GetChild(EQuadrant quadrant) const
 QuadTreeNode* QuadTreeNode::GetChild(EQuadrant quadrant)
 {
   QuadTreeNode* ret =
-    ( _childrenPtr.empty() ) ?
+    ( nullptr == _children ) ?
     ( nullptr ) :
-    ( _childrenPtr[(std::underlying_type<EQuadrant>::type)quadrant].get() );
+    ( &_children[(std::underlying_type<EQuadrant>::type)quadrant] );
   return ret;
 }
 
@@ -181,9 +210,9 @@ void QuadTreeNode::AddSmallestDescendants(EDirection direction, std::vector<cons
   if ( !IsSubdivided() ) {
     descendants.emplace_back( this );
   } else {
-    for (const auto& child : _childrenPtr) {
-      if(!IsSibling(child->_quadrant, direction)) { 
-        child->AddSmallestDescendants(direction, descendants); 
+    for (const auto& child : GetChildren()) {
+      if(!IsSibling(child._quadrant, direction)) { 
+        child.AddSmallestDescendants(direction, descendants); 
       };
     }
   }
@@ -236,23 +265,35 @@ std::vector<const QuadTreeNode*> QuadTreeNode::GetNeighbors() const
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void QuadTreeNode::Fold(FoldFunctor& accumulator, const NodeAddress& addr, FoldDirection dir)
+{
+  FoldAddress(accumulator, addr, GetDepth(), dir);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNode::Fold(const FoldFunctorConst& accumulator, const NodeAddress& addr, FoldDirection dir) const
+{
+  FoldAddress(accumulator, addr, GetDepth(), dir);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNode::FoldAddress(FoldFunctor& accumulator, const NodeAddress& addr, size_t depth, FoldDirection dir)
 {
   if (FoldDirection::BreadthFirst == dir) { accumulator(*this); }
 
-  if (IsSubdivided() && (addr.size() > _address.size())) { 
-    GetChild(addr[_address.size()])->Fold(accumulator, addr, dir); 
+  if (IsSubdivided() && (addr.size() > depth)) { 
+    GetChild(addr[depth])->FoldAddress(accumulator, addr, depth+1, dir); 
   }
 
   if (FoldDirection::DepthFirst == dir) { accumulator(*this); }
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void QuadTreeNode::Fold(const FoldFunctorConst& accumulator, const NodeAddress& addr, FoldDirection dir) const
+void QuadTreeNode::FoldAddress(const FoldFunctorConst& accumulator, const NodeAddress& addr, size_t depth, FoldDirection dir) const
 {
   if (FoldDirection::BreadthFirst == dir) { accumulator(*this); }
 
-  if (IsSubdivided() && (addr.size() > _address.size())) { 
-    GetChild(addr[_address.size()])->Fold(accumulator, addr, dir); 
+  if (IsSubdivided() && (addr.size() > depth)) { 
+    GetChild(addr[depth])->FoldAddress(accumulator, addr, depth+1, dir); 
   }
 
   if (FoldDirection::DepthFirst == dir) { accumulator(*this); }
@@ -305,13 +346,13 @@ void QuadTreeNode::Fold(FoldFunctor& accumulator, const FoldableRegion& region,
   if (FoldDirection::BreadthFirst == dir) { accumulator(*this); } 
 
   if ( region.ContainsQuad(_boundingBox) ) { 
-    for ( const auto& cPtr : _childrenPtr ) {
-      cPtr->Fold(accumulator, kNodeRegion, dir); 
+    for ( auto& child : GetChildren() ) {
+      child.Fold(accumulator, kNodeRegion, dir); 
     }
   } else {
     u8 childFilter = IsSubdivided() ? GetChildFilterMask(_center, region.GetBoundingBox()) : 0;        
-    for ( const auto& cPtr : _childrenPtr ) { 
-      if (childFilter & 0x1) { cPtr->Fold(accumulator, region, dir); }
+    for ( auto& child : GetChildren() ) { 
+      if (childFilter & 0x1) { child.Fold(accumulator, region, dir); }
       if ((childFilter >>= 1) == 0) { break; };
     }
   }
@@ -327,13 +368,13 @@ void QuadTreeNode::Fold(const FoldFunctorConst& accumulator, const FoldableRegio
   if (FoldDirection::BreadthFirst == dir) { accumulator(*this); } 
 
   if ( region.ContainsQuad(_boundingBox) ) { 
-    for ( const auto& cPtr : _childrenPtr ) {
-      cPtr->Fold(accumulator, kNodeRegion, dir); 
+    for ( auto& child : GetChildren() ) {
+      child.Fold(accumulator, kNodeRegion, dir); 
     }
   } else {
     u8 childFilter = IsSubdivided() ? GetChildFilterMask(_center, region.GetBoundingBox()) : 0;        
-    for ( const auto& cPtr : _childrenPtr ) { 
-      if (childFilter & 0x1) { cPtr->Fold(accumulator, region, dir); }
+    for ( auto& child : GetChildren() ) { 
+      if (childFilter & 0x1) { child.Fold(accumulator, region, dir); }
       if ((childFilter >>= 1) == 0) { break; };
     }
   }
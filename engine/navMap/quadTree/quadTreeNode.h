@@ -22,6 +22,8 @@
 namespace Anki {
 namespace Vector {
 
+class QuadTree;
+
 using namespace QuadTreeTypes;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -35,14 +37,16 @@ public:
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
   bool                   IsRootNode()     const { return _parent == nullptr; }
-  bool                   IsSubdivided()   const { return !_childrenPtr.empty(); }
+  bool                   IsSubdivided()   const { return _children != nullptr; }
   uint8_t                GetMaxHeight()   const { return _maxHeight; }
   float                  GetSideLen()     const { return _sideLen; }
   const Point2f&         GetCenter()      const { return _center; }
   const NodeContent&     GetData()        const { return _content; }
-  const NodeAddress&     GetAddress()     const { return _address; }
   const AxisAlignedQuad& GetBoundingBox() const { return _boundingBox; }
 
+  // quadrants from the root down to this node. Not stored but rebuilt from the parents, so prefer Fold when possible
+  NodeAddress            GetAddress()     const;
+
   // run the provided accumulator function recursively over the tree for all nodes intersecting with region (if provided).
   // NOTE: any recursive call through the QTN should be implemented by fold so all collision checks happen in a consistant manner
   void Fold(const FoldFunctorConst& accumulator, const FoldableRegion& region = RealNumbers2f(), FoldDirection dir = FoldDirection::BreadthFirst) const;
@@ -60,17 +64,33 @@ protected:
   // Leave the constructor as a protected member so only the root node or other Quad tree nodes can create new nodes
   // it will allow subdivision as long as level is greater than 0
   QuadTreeNode(const QuadTreeNode* parent = nullptr, EQuadrant quadrant = EQuadrant::Root);
+
+  // children are always allocated together, in one block from the tree's pool, indexed by EQuadrant
+  static constexpr size_t kNumChildren = 4;
+
+  // range over the children of a node, empty if the node is not subdivided
+  template <typename T>
+  struct ChildRange {
+    T* first;
+    T* last;
+    T* begin() const { return first; }
+    T* end()   const { return last; }
+  };
+
+  ChildRange<QuadTreeNode>       GetChildren()       { return {_children, _children + (_children ? kNumChildren : 0)}; }
+  ChildRange<const QuadTreeNode> GetChildren() const { return {_children, _children + (_children ? kNumChildren : 0)}; }
     
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Modification
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   
-  // updates the address incase tree structure changes (expands and shifts)
-  void ResetAddress();
-  
   // split the current node
   bool Subdivide();
 
+  // notifies the tree of the destruction of the given block of children (and all their descendants), then returns it
+  // to the pool. Does nothing for null
+  void ReleaseChildren(QuadTreeNode* children);
+
   // checks if all children are the same type, if so it removes the children and merges back to a single parent
   void TryAutoMerge();
   
@@ -78,7 +98,7 @@ protected:
   void ForceSetContent(NodeContent&& newContent);
   
   // sets a new parent to this node. Used on expansions
-  void ChangeParent(const QuadTreeNode* newParent);
+  void ChangeParent(const QuadTreeNode* newParent) { _parent = newParent; }
   
   // swaps children and content with 'otherNode', updating the children's parent pointer
   void SwapChildrenAndContent(QuadTreeNode* otherNode);
@@ -87,6 +107,13 @@ protected:
   // NOTE: mutable recursive calls should remain private to ensure tree invariants are held
   void Fold(FoldFunctor& accumulator, const FoldableRegion& region = RealNumbers2f(), FoldDirection dir = FoldDirection::BreadthFirst);
   void Fold(FoldFunctor& accumulator, const NodeAddress& addr, FoldDirection dir = FoldDirection::BreadthFirst);
+
+  // address folds, for a node at the given depth in the tree
+  void FoldAddress(FoldFunctor& accumulator, const NodeAddress& addr, size_t depth, FoldDirection dir);
+  void FoldAddress(const FoldFunctorConst& accumulator, const NodeAddress& addr, size_t depth, FoldDirection dir) const;
+
+  // number of parents up to the root
+  size_t GetDepth() const;
   
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Exploration
@@ -110,8 +137,11 @@ protected:
   
   // NOTE: try to minimize padding in these attributes
 
-  // children when subdivided. Can be empty or have 4 nodes
-  std::vector< std::unique_ptr<QuadTreeNode> > _childrenPtr;
+  // first of the kNumChildren contiguous children when subdivided, null otherwise
+  QuadTreeNode* _children;
+
+  // tree this node belongs to, which holds the node pool and the callbacks
+  QuadTree* _tree;
 
   // coordinates of this quad
   Point2f _center;
@@ -125,16 +155,11 @@ protected:
   // our level
   uint8_t _maxHeight;
 
-  // quadrant within the parent
+  // quadrant within the parent. Together with the parents' this is the node's address
   EQuadrant _quadrant;
-  NodeAddress _address;
   
   // information about what's in this quad
   NodeContent _content;
-
-  // callbacks to notify external system if an element has changed or been destroyed
-  std::function<void (const QuadTreeNode*)> _destructorCallback;
-  std::function<void (const QuadTreeNode*, const NodeContent&)> _modifiedCallback;
     
 }; // class
   
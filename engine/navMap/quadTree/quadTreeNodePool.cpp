@@ -0,0 +1,70 @@
+/**
+ * File: quadTreeNodePool.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "quadTreeNodePool.h"
+
+#include "util/logging/logging.h"
+
+#include <new>
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+QuadTreeNodePool::QuadTreeNodePool(size_t blockSize_bytes, size_t blocksPerSlab)
+: _blockSize_words( (blockSize_bytes + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t) )
+, _blocksPerSlab( blocksPerSlab )
+, _freeList( nullptr )
+, _numBlocksInUse( 0 )
+{
+  static_assert( sizeof(FreeBlock) <= sizeof(std::max_align_t), "Free list link must fit in a block" );
+  DEV_ASSERT( (_blockSize_words > 0) && (_blocksPerSlab > 0), "QuadTreeNodePool.InvalidSize" );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void* QuadTreeNodePool::Allocate()
+{
+  if ( nullptr == _freeList ) {
+    AddSlab();
+  }
+
+  FreeBlock* block = _freeList;
+  _freeList = block->next;
+  ++_numBlocksInUse;
+  return block;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNodePool::Free(void* block)
+{
+  DEV_ASSERT( _numBlocksInUse > 0, "QuadTreeNodePool.Free.NothingInUse" );
+
+  FreeBlock* freed = new (block) FreeBlock{ _freeList };
+  _freeList = freed;
+  --_numBlocksInUse;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeNodePool::AddSlab()
+{
+  std::unique_ptr<std::max_align_t[]> slab( new std::max_align_t[_blockSize_words * _blocksPerSlab] );
+
+  // link the new blocks so that they are handed out in address order
+  for ( size_t i = _blocksPerSlab; i > 0; --i ) {
+    _freeList = new (&slab[(i-1) * _blockSize_words]) FreeBlock{ _freeList };
+  }
+
+  _slabs.emplace_back( std::move(slab) );
+  _memoryAccount.Add( _blockSize_words * _blocksPerSlab * sizeof(std::max_align_t) );
+}
+
+} // namespace Vector
+} // namespace Anki
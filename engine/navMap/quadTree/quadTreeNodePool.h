@@ -0,0 +1,67 @@
+/**
+ * File: quadTreeNodePool.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Slab allocator for quad tree nodes. Every allocation is one fixed size block, big enough for the four
+ *              children of a node, so that siblings sit next to each other in memory. Blocks are carved out of
+ *              larger slabs, and freed blocks are kept in a free list to be reused by the next subdivision, instead
+ *              of going back to the heap every time the map merges or splits nodes.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef ANKI_COZMO_QUAD_TREE_NODE_POOL_H
+#define ANKI_COZMO_QUAD_TREE_NODE_POOL_H
+
+#include "util/helpers/noncopyable.h"
+#include "util/memoryAccounting/memoryAccounting.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class QuadTreeNodePool : private Util::noncopyable
+{
+public:
+
+  // blockSize_bytes: size of every block handed out, rounded up to keep blocks maximally aligned
+  // blocksPerSlab: how many blocks to get from the heap at once when the free list runs out
+  QuadTreeNodePool(size_t blockSize_bytes, size_t blocksPerSlab);
+
+  // returns uninitialized storage for one block. Never fails, grows by a slab if needed
+  void* Allocate();
+
+  // returns a block obtained from Allocate to the pool. The caller must have destroyed whatever it constructed in it
+  void Free(void* block);
+
+  size_t GetNumBlocksInUse()    const { return _numBlocksInUse; }
+  size_t GetNumBlocksReserved() const { return _slabs.size() * _blocksPerSlab; }
+
+private:
+
+  // freed blocks are linked through their own storage
+  struct FreeBlock { FreeBlock* next; };
+
+  void AddSlab();
+
+  const size_t _blockSize_words;
+  const size_t _blocksPerSlab;
+
+  std::vector<std::unique_ptr<std::max_align_t[]>> _slabs;
+  FreeBlock* _freeList;
+  size_t     _numBlocksInUse;
+
+  // slabs are only given back to the heap when the pool is destroyed, so this counts the reserved blocks
+  Util::MemoryAccount _memoryAccount{Util::MemoryTag::MemoryMap};
+};
+
+} // namespace
+} // namespace
+
+#endif //
@@ -12,11 +12,12 @@
 #include "quadTreeProcessor.h"
 #include "quadTree.h"
 
-#include "coretech/common/engine/math/bresenhamLine2d.h"
-
 #include "util/console/consoleInterface.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+#include <cmath>
+
 #define LOG_CHANNEL "quadTreeProcessor"
 
 namespace Anki {
@@ -30,6 +31,15 @@ CONSOLE_VAR(bool , kRenderBorder3DLines, "QuadTreeProcessor", false); // renders
 CONSOLE_VAR(float, kRenderZOffset      , "QuadTreeProcessor", 20.0f); // adds Z offset to all quads
 CONSOLE_VAR(bool , kDebugFindBorders   , "QuadTreeProcessor", false); // prints debug information in console
 
+namespace {
+  // resolution of the regions reported by GetChangedRegions
+  const float  kChangeCellSize_mm     = 64.0f;
+  // changes covering more cells than this are not tracked per cell (e.g. merging in a whole map)
+  const size_t kMaxChangeCellsPerNode = 256;
+
+  inline u64 GetChangeCellKey(s32 x, s32 y) { return (((u64)(u32)x) << 32) | (u64)(u32)y; }
+}
+
 #define DEBUG_FIND_BORDER(format, ...)                                                                          \
 if ( kDebugFindBorders ) {                                                                                      \
   do{::Anki::Util::sChanneledInfoF(LOG_CHANNEL, "NMQTProcessor", {}, format, ##__VA_ARGS__);}while(0); \
@@ -40,6 +50,8 @@ QuadTreeProcessor::QuadTreeProcessor()
 : _quadTree(nullptr)
 , _totalExploredArea_m2(0.0)
 , _totalInterestingEdgeArea_m2(0.0)
+, _contentChangeCount(0)
+, _untrackedChangeCount(0)
 {
 
 }
@@ -52,6 +64,13 @@ void QuadTreeProcessor::OnNodeContentChanged(const QuadTreeNode* node, const Nod
   const EContentType oldType = static_cast<const MemoryMapDataPtr&>(oldContent)->type;
   const EContentType newType = static_cast<const MemoryMapDataPtr&>(node->GetData())->type;
 
+  // the planner cares about collision state even if the type stays the same (e.g. prox obstacles getting confirmed)
+  if ( (oldType != newType) ||
+       (static_cast<const MemoryMapDataPtr&>(oldContent)->IsCollisionType() !=
+        static_cast<const MemoryMapDataPtr&>(node->GetData())->IsCollisionType()) ) {
+    RecordContentChange(node);
+  }
+
   // type hasn't changed, so we don't need to update any of our caching
   if (oldType == newType) { return; }
 
@@ -151,6 +170,78 @@ void QuadTreeProcessor::OnNodeDestroyed(const QuadTreeNode* node)
   }
 }
 
+namespace {
+  // rays sharing a start point, stored as arrays of floats so that the slab tests run over contiguous memory
+  struct RayBatch {
+    std::vector<float> invDx;
+    std::vector<float> invDy;
+    std::vector<u32>   idx;   // index into the caller's ray list
+
+    void clear() { invDx.clear(); invDy.clear(); idx.clear(); }
+    void push_back(float ix, float iy, u32 i) { invDx.push_back(ix); invDy.push_back(iy); idx.push_back(i); }
+    size_t size() const { return idx.size(); }
+  };
+
+  // keep the rays from `rays` that cross box and have not hit anything yet
+  void FilterRays(const AxisAlignedQuad& box, const Point2f& start, const RayBatch& rays,
+                  const std::vector<bool>& results, std::vector<uint8_t>& mask, RayBatch& out)
+  {
+    // positions of the box sides relative to the start, shared by all rays
+    const float minX = box.GetMinVertex().x() - start.x();
+    const float minY = box.GetMinVertex().y() - start.y();
+    const float maxX = box.GetMaxVertex().x() - start.x();
+    const float maxY = box.GetMaxVertex().y() - start.y();
+
+    // branch free segment/box slab test, so the compiler can vectorize this loop
+    const size_t n = rays.size();
+    mask.resize(n);
+    const float* invDx = rays.invDx.data();
+    const float* invDy = rays.invDy.data();
+    for ( size_t i = 0; i < n; ++i ) {
+      const float tx1 = minX * invDx[i];
+      const float tx2 = maxX * invDx[i];
+      const float ty1 = minY * invDy[i];
+      const float ty2 = maxY * invDy[i];
+      const float tEnter = std::max( std::max( std::min(tx1, tx2), std::min(ty1, ty2) ), 0.f );
+      const float tExit  = std::min( std::min( std::max(tx1, tx2), std::max(ty1, ty2) ), 1.f );
+      mask[i] = (tEnter <= tExit);
+    }
+
+    out.clear();
+    for ( size_t i = 0; i < n; ++i ) {
+      if ( mask[i] && !results[rays.idx[i]] ) {
+        out.push_back( rays.invDx[i], rays.invDy[i], rays.idx[i] );
+      }
+    }
+  }
+
+  // evaluates pred once per leaf for all the rays that cross it. raysPerDepth[depth] holds the rays crossing node
+  void CastRays(const QuadTreeNode& node, size_t depth, const Point2f& start, std::vector<RayBatch>& raysPerDepth,
+                std::vector<uint8_t>& mask, const NodePredicate& pred, std::vector<bool>& results)
+  {
+    if ( !node.IsSubdivided() ) {
+      if ( pred( static_cast<const MemoryMapDataPtr&>(node.GetData()) ) ) {
+        for ( const u32 i : raysPerDepth[depth].idx ) {
+          results[i] = true;
+        }
+      }
+      return;
+    }
+
+    if ( raysPerDepth.size() <= depth + 1 ) {
+      raysPerDepth.resize( depth + 2 );
+    }
+
+    for ( const auto& child : node.GetChildren() ) {
+      // filter against this node's rays again for every child, since a sibling may have finished some of them
+      FilterRays( child.GetBoundingBox(), start, raysPerDepth[depth], results, mask, raysPerDepth[depth+1] );
+      if ( raysPerDepth[depth+1].size() > 0 ) {
+        CastRays( child, depth + 1, start, raysPerDepth, mask, pred, results );
+      }
+    }
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 std::vector<bool>
 QuadTreeProcessor::AnyOfRays( const Point2f& start, 
@@ -158,38 +249,30 @@ QuadTreeProcessor::AnyOfRays( const Point2f& start,
                               const NodePredicate& pred) const
 {
   std::vector<bool> results(ends.size(), false);
-  std::unordered_map<Point2i ,bool> localCache;
-
-  // start by rasterizing the line described by [start,end]
-  const auto startBres = QuadTreeTypes::GetIntegralCoordinateOfNode(start, 
-    _quadTree->GetCenter(), 
-    _quadTree->GetContentPrecisionMM(), 
-    _quadTree->GetMaxHeight());
-  const auto maxTreeHeight = _quadTree->GetMaxHeight();
-
-  for(int rayIdx = 0; rayIdx<ends.size(); ++rayIdx) {
-    BresenhamLinePixelIterator bresIter(startBres, 
-      QuadTreeTypes::GetIntegralCoordinateOfNode(ends[rayIdx], 
-        _quadTree->GetCenter(), 
-        _quadTree->GetContentPrecisionMM(), 
-        _quadTree->GetMaxHeight()));
-    while(!bresIter.Done()) {
-      const Point2i& rasterPoint = bresIter.Get();
-      auto got = localCache.find(rasterPoint);
-      if(got == localCache.end()) {
-        // compute new result and insert into the cache
-        const QuadTreeNode* qnode = nullptr;
-        auto getNode = [&qnode] (const QuadTreeNode& n) { qnode = &n; };
-        ((const QuadTree*)_quadTree)->Fold(getNode, GetAddressForNodeCenter(rasterPoint, maxTreeHeight));
-        const bool result = qnode && pred( static_cast<const MemoryMapDataPtr&>(qnode->GetData()) );
-        got = localCache.insert({rasterPoint, result}).first;
-      }
-      if(got->second) {
-        results[rayIdx] = true;
-        break; // skip computing the rest of the ray
-      }
-      bresIter.Next();
-    }
+  if ( ends.empty() ) {
+    return results;
+  }
+
+  // Rays are walked down the tree together, so every node is visited once for all rays that cross it, and pred is
+  // evaluated once per leaf. Axis aligned rays get a tiny direction instead of 0, which keeps the slab test free of NaNs
+  const float kMinRayDelta_mm = 1e-6f;
+  RayBatch allRays;
+  allRays.invDx.reserve(ends.size());
+  allRays.invDy.reserve(ends.size());
+  allRays.idx.reserve(ends.size());
+  for ( u32 i = 0; i < ends.size(); ++i ) {
+    const float dx = ends[i].x() - start.x();
+    const float dy = ends[i].y() - start.y();
+    allRays.push_back( 1.f / (std::abs(dx) < kMinRayDelta_mm ? kMinRayDelta_mm : dx),
+                       1.f / (std::abs(dy) < kMinRayDelta_mm ? kMinRayDelta_mm : dy),
+                       i );
+  }
+
+  std::vector<RayBatch> raysPerDepth( _quadTree->GetMaxHeight() + 2 );
+  std::vector<uint8_t> mask;
+  FilterRays( _quadTree->GetBoundingBox(), start, allRays, results, mask, raysPerDepth[0] );
+  if ( raysPerDepth[0].size() > 0 ) {
+    CastRays( *_quadTree, 0, start, raysPerDepth, mask, pred, results );
   }
   return results;
 }
@@ -259,6 +342,49 @@ bool QuadTreeProcessor::HasContentType(EContentType nodeType) const
   return hasAny;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void QuadTreeProcessor::RecordContentChange(const QuadTreeNode* node)
+{
+  ++_contentChangeCount;
+
+  const float halfSide = node->GetSideLen() * 0.5f;
+  const s32 minX = (s32) std::floor( (node->GetCenter().x() - halfSide) / kChangeCellSize_mm );
+  const s32 maxX = (s32) std::floor( (node->GetCenter().x() + halfSide) / kChangeCellSize_mm );
+  const s32 minY = (s32) std::floor( (node->GetCenter().y() - halfSide) / kChangeCellSize_mm );
+  const s32 maxY = (s32) std::floor( (node->GetCenter().y() + halfSide) / kChangeCellSize_mm );
+
+  const size_t numCells = (size_t)(maxX - minX + 1) * (size_t)(maxY - minY + 1);
+  if ( numCells > kMaxChangeCellsPerNode ) {
+    _untrackedChangeCount = _contentChangeCount;
+    return;
+  }
+
+  for ( s32 x = minX; x <= maxX; ++x ) {
+    for ( s32 y = minY; y <= maxY; ++y ) {
+      _changedCells[GetChangeCellKey(x, y)] = _contentChangeCount;
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool QuadTreeProcessor::GetChangedRegions(u32& stamp, std::vector<AxisAlignedQuad>& regions) const
+{
+  const bool tracked = (stamp >= _untrackedChangeCount);
+  if ( tracked && (stamp < _contentChangeCount) ) {
+    for ( const auto& cell : _changedCells ) {
+      if ( cell.second > stamp ) {
+        const s32 x = (s32)(u32)(cell.first >> 32);
+        const s32 y = (s32)(u32)(cell.first);
+        const Point2f minCorner( x * kChangeCellSize_mm, y * kChangeCellSize_mm );
+        regions.emplace_back( minCorner, minCorner + Point2f(kChangeCellSize_mm, kChangeCellSize_mm) );
+      }
+    }
+  }
+
+  stamp = _contentChangeCount;
+  return tracked;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool QuadTreeProcessor::IsCached(EContentType contentType)
 {
@@ -75,8 +75,14 @@ public:
   // returns true if there are any nodes of the given type, false otherwise
   bool HasContentType(EContentType type) const;
 
-  // multi-ray based collision checking optimization with memoization of result point info
+  // multi-ray collision checking: true for every ray [start, ends[i]] that crosses a node satisfying pred. All rays
+  // walk the tree together, so each node is visited once per call rather than once per ray
   std::vector<bool> AnyOfRays(const Point2f& start, const std::vector<Point2f>& ends, const NodePredicate& pred) const;
+
+  // appends to regions the (coarse) areas where content type or collision state changed since the given stamp, and
+  // updates the stamp. A stamp of 0 means since the map was created. Returns false if some of those changes covered
+  // too much of the map to be tracked, in which case the whole map should be considered changed
+  bool GetChangedRegions(u32& stamp, std::vector<AxisAlignedQuad>& regions) const;
  
 private:
 
@@ -95,6 +101,9 @@ private:
   
   // true if we have a need to cache the given content type, false otherwise
   static bool IsCached(EContentType contentType);
+
+  // marks the area covered by the node as changed for GetChangedRegions
+  void RecordContentChange(const QuadTreeNode* node);
   
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Attributes
@@ -113,6 +122,13 @@ private:
   
   // area of all quads that are currently interesting edges
   double _totalInterestingEdgeArea_m2;
+
+  // coarse cells where content changed, with the value of _contentChangeCount when they last did
+  std::unordered_map<u64, u32> _changedCells;
+
+  // number of changes recorded so far, and the last one that was too big to track per cell
+  u32 _contentChangeCount;
+  u32 _untrackedChangeCount;
 }; // class
   
 } // namespace
@@ -13,10 +13,13 @@
 #define ANKI_COZMO_NAV_MESH_QUAD_TREE_TYPES_H
 
 #include "engine/navMap/memoryMap/data/memoryMapDataWrapper.h"
+#include "coretech/common/engine/math/fastPolygon2d.h"
 #include "coretech/common/engine/math/pointSetUnion.h"
 
 #include <cstdint>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
@@ -90,6 +93,18 @@ public:
                 // ~ [&set](const AxisAlignedQuad& q) { return set.Intersects(q); };
   }
 
+  // most regions are FastPolygons, whose quad checks can be bound directly instead of going through a virtual
+  // Contains call per corner
+  FoldableRegion(const FastPolygon& set) 
+  : _aabb(set.GetAxisAlignedBoundingBox())
+  {
+    using std::placeholders::_1;
+
+    Contains       = std::bind( &BoundedConvexSet2f::Contains, &set, _1 );
+    ContainsQuad   = std::bind( &FastPolygon::ContainsQuad, &set, _1 );
+    IntersectsQuad = std::bind( &FastPolygon::IntersectsQuad, &set, _1 );
+  }
+
   // allow Union types
   template <typename T, typename U>
   FoldableRegion(const PointSetUnion2f<T,U>& set) 
@@ -133,6 +148,7 @@ enum class EDirection { PlusX, PlusY, MinusX, MinusY };
 using MemoryMapDataPtr      = MemoryMapDataWrapper<MemoryMapData>;
 using NodeContent           = SmartTuple<MemoryMapDataPtr>;
 using NodeTransformFunction = std::function<NodeContent (const NodeContent&)>;
+using RegionTransformList   = std::vector<std::pair<FoldableRegion, NodeTransformFunction>>;
 using NodeAddress           = std::vector<EQuadrant>;
 using FoldFunctor           = std::function<void (QuadTreeNode& node)>;
 using FoldFunctorConst      = std::function<void (const QuadTreeNode& node)>;
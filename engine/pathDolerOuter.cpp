@@ -25,6 +25,7 @@ namespace Vector {
 
 PathDolerOuter::PathDolerOuter(RobotInterface::MessageHandler* msgHandler)
   : pathSizeOnBasestation_(0)
+  , numSafeSegments_(0)
   , lastDoledSegmentIdx_(-1)
   , msgHandler_(msgHandler)
 {
@@ -35,7 +36,12 @@ void PathDolerOuter::SetPath(const Planning::Path& path)
   path_ = path;
   lastDoledSegmentIdx_ = -1;
   pathSizeOnBasestation_ = path.GetNumSegments();
+  numSafeSegments_ = pathSizeOnBasestation_;
 
+  // Everything that fits goes out now, in this tick's batch of messages to the robot, so that the robot
+  // isn't left near the end of what it has (and slowing down for it) while waiting on a refill
+  static_assert(MAX_NUM_PATH_SEGMENTS_ROBOT >= MAX_NUM_PATH_SEGMENTS_BASESTATION,
+                "Robot should be able to hold any path the basestation can plan without refills");
   Dole(MAX_NUM_PATH_SEGMENTS_ROBOT);
 }
 
@@ -50,6 +56,7 @@ void PathDolerOuter::ClearPath()
 {
   path_.Clear();
   pathSizeOnBasestation_ = 0;
+  numSafeSegments_ = 0;
   lastDoledSegmentIdx_ = -1;
 }
 
@@ -57,9 +64,14 @@ void PathDolerOuter::Dole(size_t numToDole)
 {
   DEV_ASSERT(msgHandler_ != nullptr, "PathDolerOuter.Dole.InvalidMessageHandler");
 
+  const size_t numDolable = GetNumDolableSegments();
+  if (numDolable == 0) {
+    return;
+  }
+
   size_t endIdx = lastDoledSegmentIdx_ + numToDole;
-  if (endIdx >= pathSizeOnBasestation_) {
-    endIdx = pathSizeOnBasestation_ - 1;
+  if (endIdx >= numDolable) {
+    endIdx = numDolable - 1;
   }
 
   LOG_DEBUG("PathDolerOuter.Dole", "Should dole from %d to %zu (totalSegments = %zu)",
@@ -145,10 +157,12 @@ void PathDolerOuter::Dole(size_t numToDole)
 
 void PathDolerOuter::Update(const s8 currPathIdx)
 {
-  // If there is a free slot on the robot and there are segments left to dole, then dole
+  // If there is a free slot on the robot and there are segments left to dole, then dole.
+  // Segments only remain to be doled here once they become safe (see SetNumSafeSegments)
   const int numFreeSlots = MAX_NUM_PATH_SEGMENTS_ROBOT - (lastDoledSegmentIdx_ - currPathIdx) - 1;
 
-  if ((numFreeSlots > 0) && (pathSizeOnBasestation_ > 0) && (lastDoledSegmentIdx_ < pathSizeOnBasestation_-1)) {
+  const int numDolable = (int) GetNumDolableSegments();
+  if ((numFreeSlots > 0) && (numDolable > 0) && (lastDoledSegmentIdx_ < numDolable-1)) {
     Dole(numFreeSlots);
   }
 }
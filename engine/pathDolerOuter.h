@@ -17,6 +17,8 @@
 
 #include "coretech/planning/shared/path.h"
 
+#include <algorithm>
+
 namespace Anki {
 namespace Vector {
 namespace RobotInterface {
@@ -39,6 +41,10 @@ public:
 
   void ClearPath();
 
+  // only the first numSafe segments of the path are known to be collision free, so never dole out any segment
+  // past those. Reset to the whole path by SetPath
+  void SetNumSafeSegments(size_t numSafe) { numSafeSegments_ = numSafe; }
+
   // Doles out the path bit by bit to the robot. The argument is the
   // currPathIdx: The current (absolute) segment index that the robot is traversing.
   void Update(const s8 currPathIdx);
@@ -50,10 +56,15 @@ protected:
 
   void Dole(size_t numToDole);
 
+  // number of segments from the start of the path that may be sent to the robot
+  size_t GetNumDolableSegments() const { return std::min(pathSizeOnBasestation_, numSafeSegments_); }
+
   Planning::Path path_;
 
   size_t pathSizeOnBasestation_;
 
+  size_t numSafeSegments_;
+
   s16 lastDoledSegmentIdx_;
   
   // A reference to the MessageHandler that the robot uses for outgoing comms
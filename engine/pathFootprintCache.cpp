@@ -0,0 +1,146 @@
+/**
+ * File: pathFootprintCache.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "engine/pathFootprintCache.h"
+
+#include "anki/cozmo/shared/cozmoEngineConfig.h"
+#include "coretech/common/engine/math/polygon_impl.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  // same footprint the planner checks its paths with
+  const float kRobotRadius_mm = ROBOT_BOUNDING_Y / 2.f;
+
+  inline bool Overlap(const AxisAlignedQuad& a, const AxisAlignedQuad& b) {
+    return (a.GetMinVertex().x() <= b.GetMaxVertex().x()) && (b.GetMinVertex().x() <= a.GetMaxVertex().x()) &&
+           (a.GetMinVertex().y() <= b.GetMaxVertex().y()) && (b.GetMinVertex().y() <= a.GetMaxVertex().y());
+  }
+
+  inline AxisAlignedQuad Merge(const AxisAlignedQuad& a, const AxisAlignedQuad& b) {
+    return AxisAlignedQuad( {std::fmin(a.GetMinVertex().x(), b.GetMinVertex().x()), std::fmin(a.GetMinVertex().y(), b.GetMinVertex().y())},
+                            {std::fmax(a.GetMaxVertex().x(), b.GetMaxVertex().x()), std::fmax(a.GetMaxVertex().y(), b.GetMaxVertex().y())} );
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PathFootprintCache::SetPath(const Planning::Path& path)
+{
+  _segments.clear();
+  _segments.reserve(path.GetNumSegments());
+  for (u8 i = 0; i < path.GetNumSegments(); ++i) {
+    _segments.push_back( ComputeFootprint(path.GetSegmentConstRef(i)) );
+  }
+
+  // a path is safe when it gets planned
+  _numSafeSegments = _segments.size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PathFootprintCache::Truncate(size_t numSegments)
+{
+  if (numSegments < _segments.size()) {
+    _segments.resize(numSegments);
+  }
+  _numSafeSegments = std::min(_numSafeSegments, _segments.size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t PathFootprintCache::Update(const MapComponent& map)
+{
+  std::vector<AxisAlignedQuad> regions;
+  const bool changesKnown = map.GetChangedRegions(_mapStamp, regions);
+
+  for (auto& segment : _segments) {
+    if (!segment.needsCheck) {
+      segment.needsCheck = !changesKnown ||
+                           std::any_of(regions.begin(), regions.end(),
+                                       [&segment](const AxisAlignedQuad& r) { return Overlap(r, segment.bounds); });
+    }
+  }
+
+  // only the first unsafe segment matters, so nothing after it needs to be checked yet
+  _numSafeSegments = 0;
+  for (auto& segment : _segments) {
+    if (segment.needsCheck) {
+      segment.isSafe = std::none_of(segment.disks.begin(), segment.disks.end(),
+                                    [&map](const Ball2f& d) { return map.CheckForCollisions(d); }) &&
+                       std::none_of(segment.polygons.begin(), segment.polygons.end(),
+                                    [&map](const FastPolygon& p) { return map.CheckForCollisions(p); });
+      segment.needsCheck = false;
+    }
+    if (!segment.isSafe) { break; }
+    ++_numSafeSegments;
+  }
+
+  return _numSafeSegments;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PathFootprintCache::SegmentFootprint PathFootprintCache::ComputeFootprint(const Planning::PathSegment& segment)
+{
+  SegmentFootprint out;
+  const auto& def = segment.GetDef();
+  switch (segment.GetType()) {
+    case Planning::PST_POINT_TURN:
+    {
+      out.disks.emplace_back( Point2f(def.turn.x, def.turn.y), kRobotRadius_mm );
+      break;
+    }
+    case Planning::PST_LINE:
+    {
+      // a rectangle as wide as the robot. Point turns at either end cover the rest
+      const Point2f from(def.line.startPt_x, def.line.startPt_y);
+      const Point2f to(def.line.endPt_x, def.line.endPt_y);
+      Point2f normal(from.y() - to.y(), to.x() - from.x());
+      if (normal.MakeUnitLength() > 0.f) {
+        out.polygons.emplace_back( Poly2f({ from + normal * kRobotRadius_mm,
+                                            to   + normal * kRobotRadius_mm,
+                                            to   - normal * kRobotRadius_mm,
+                                            from - normal * kRobotRadius_mm }) );
+      } else {
+        out.disks.emplace_back( from, kRobotRadius_mm );
+      }
+      break;
+    }
+    case Planning::PST_ARC:
+    {
+      // disks along the arc, no further apart than the robot radius
+      const Point2f center(def.arc.centerPt_x, def.arc.centerPt_y);
+      const float radius = std::fabs(def.arc.radius);
+      const int nDisks = std::max(1, (int) std::ceil(std::fabs(def.arc.sweepRad) * radius / kRobotRadius_mm));
+      for (int i = 0; i <= nDisks; ++i) {
+        const float rad = def.arc.startRad + def.arc.sweepRad * i / nDisks;
+        out.disks.emplace_back( center + Point2f(std::cos(rad), std::sin(rad)) * radius, kRobotRadius_mm );
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  bool hasBounds = false;
+  const auto addBounds = [&](const AxisAlignedQuad& b) {
+    out.bounds = hasBounds ? Merge(out.bounds, b) : b;
+    hasBounds = true;
+  };
+  for (const auto& d : out.disks)    { addBounds( d.GetAxisAlignedBoundingBox() ); }
+  for (const auto& p : out.polygons) { addBounds( p.GetAxisAlignedBoundingBox() ); }
+
+  return out;
+}
+
+} // namespace
+} // namespace
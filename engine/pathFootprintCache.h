@@ -0,0 +1,73 @@
+/**
+ * File: pathFootprintCache.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Keeps the swept footprint of the robot along each segment of the path being followed, and which of
+ *              them are safe. Checking the path again only looks at the segments that overlap parts of the map that
+ *              changed since the last check, so following a long path does not re-sample all of it every tick.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef ANKI_COZMO_PATH_FOOTPRINT_CACHE_H
+#define ANKI_COZMO_PATH_FOOTPRINT_CACHE_H
+
+#include "engine/navMap/mapComponent.h"
+
+#include "coretech/common/engine/math/axisAlignedHyperCube.h"
+#include "coretech/common/engine/math/ball.h"
+#include "coretech/common/engine/math/fastPolygon2d.h"
+#include "coretech/planning/shared/path.h"
+
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// PathFootprintCache
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class PathFootprintCache
+{
+public:
+
+  // build the footprints of every segment of path. All of them are checked on the next Update
+  void SetPath(const Planning::Path& path);
+
+  // drop everything after the first numSegments segments (e.g. after the path was trimmed)
+  void Truncate(size_t numSegments);
+
+  void Clear() { SetPath(Planning::Path()); }
+
+  // Check again the segments that overlap regions of the map that changed since the last update (all of them if the
+  // map does not know what changed). Returns the number of segments from the start of the path that are safe
+  size_t Update(const MapComponent& map);
+
+  // result of the last Update (or the whole path, if it was not checked yet)
+  size_t GetNumSafeSegments() const { return _numSafeSegments; }
+  size_t GetNumSegments()     const { return _segments.size(); }
+
+private:
+
+  // shapes covering the robot while it drives one segment
+  struct SegmentFootprint {
+    std::vector<FastPolygon> polygons;
+    std::vector<Ball2f>      disks;
+    AxisAlignedQuad          bounds     = AxisAlignedQuad({0.f, 0.f}, {0.f, 0.f});
+    bool                     needsCheck = true;
+    bool                     isSafe     = true;
+  };
+
+  static SegmentFootprint ComputeFootprint(const Planning::PathSegment& segment);
+
+  std::vector<SegmentFootprint>  _segments;
+  MapComponent::MapChangeStamp   _mapStamp;
+  size_t                         _numSafeSegments = 0;
+};
+
+} // namespace
+} // namespace
+
+#endif //
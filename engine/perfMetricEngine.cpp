@@ -17,6 +17,7 @@
 #include "engine/aiComponent/behaviorComponent/behaviorSystemManager.h"
 #include "engine/cozmoContext.h"
 #include "engine/components/battery/batteryComponent.h"
+#include "engine/components/visionComponent.h"
 #include "engine/externalInterface/gatewayInterface.h"
 #include "engine/perfMetricEngine.h"
 #include "engine/robot.h"
@@ -41,11 +42,11 @@ PerfMetricEngine::PerfMetricEngine(const CozmoContext* context)
   , _context(context)
 #endif
 {
-  _headingLine1 = "                     Engine   Engine    Sleep    Sleep     Over      RtE   EtR   GtE   EtG  GWtE  EtGW   Viz  Battery    CPU";
-  _headingLine2 = "                   Duration     Freq Intended   Actual    Sleep    Count Count Count Count Count Count Count  Voltage   Freq";
+  _headingLine1 = "                     Engine   Engine    Sleep    Sleep     Over      RtE   EtR   GtE   EtG  GWtE  EtGW   Viz  Battery    CPU   Vision";
+  _headingLine2 = "                   Duration     Freq Intended   Actual    Sleep    Count Count Count Count Count Count Count  Voltage   Freq  Latency";
   _headingLine2Extra = "  Active Feature/Behavior";
-  _headingLine1CSV = ",,Engine,Engine,Sleep,Sleep,Over,RtE,EtR,GtE,EtG,GWtE,EtGW,Viz,Battery,CPU";
-  _headingLine2CSV = ",,Duration,Freq,Intended,Actual,Sleep,Count,Count,Count,Count,Count,Count,Count,Voltage,Freq";
+  _headingLine1CSV = ",,Engine,Engine,Sleep,Sleep,Over,RtE,EtR,GtE,EtG,GWtE,EtGW,Viz,Battery,CPU,Vision";
+  _headingLine2CSV = ",,Duration,Freq,Intended,Actual,Sleep,Count,Count,Count,Count,Count,Count,Count,Voltage,Freq,Latency";
   _headingLine2ExtraCSV = ",Active Feature,Behavior";
 }
 
@@ -118,6 +119,8 @@ void PerfMetricEngine::Update(const float tickDuration_ms,
     const auto& osState = OSState::getInstance();
     frame._cpuFreq_kHz = osState->GetCPUFreq_kHz();
 
+    frame._visionLatency_ms = robot == nullptr ? 0.0f : robot->GetVisionComponent().GetLastCaptureToWorldLatency_ms();
+
     if (robot != nullptr)
     {
       const auto& bc = robot->GetAIComponent().GetComponent<BehaviorComponent>();
@@ -156,6 +159,7 @@ void PerfMetricEngine::InitDumpAccumulators()
   _accMessageCountViz.Clear();
   _accBatteryVoltage.Clear();
   _accCPUFreq.Clear();
+  _accVisionLatency.Clear();
 }
 
 
@@ -171,6 +175,7 @@ const PerfMetric::FrameMetric& PerfMetricEngine::UpdateDumpAccumulators(const in
   _accMessageCountViz        += frame._messageCountViz;
   _accBatteryVoltage         += frame._batteryVoltage;
   _accCPUFreq                += frame._cpuFreq_kHz;
+  _accVisionLatency          += frame._visionLatency_ms;
 
   return _frameBuffer[frameBufferIndex];  // Return the base class data
 }
@@ -191,10 +196,10 @@ int PerfMetricEngine::AppendFrameData(const DumpType dumpType,
     frame._messageCountGameToEngine, frame._messageCountEngineToGame,\
     frame._messageCountGatewayToEngine, frame._messageCountEngineToGateway,\
     frame._messageCountViz,\
-    frame._batteryVoltage, frame._cpuFreq_kHz
+    frame._batteryVoltage, frame._cpuFreq_kHz, frame._visionLatency_ms
 
-    static const char* kFormatLine = "    %5i %5i %5i %5i %5i %5i %5i %8.3f %6i\n";
-    static const char* kFormatLineCSV = ",%i,%i,%i,%i,%i,%i,%i,%.3f,%i\n";
+    static const char* kFormatLine = "    %5i %5i %5i %5i %5i %5i %5i %8.3f %6i %8.1f\n";
+    static const char* kFormatLineCSV = ",%i,%i,%i,%i,%i,%i,%i,%.3f,%i,%.1f\n";
 
     return snprintf(&_dumpBuffer[dumpBufferOffset], kSizeDumpBuffer - dumpBufferOffset,
                     dumpType == DT_FILE_CSV ? kFormatLineCSV : kFormatLine,
@@ -207,11 +212,11 @@ int PerfMetricEngine::AppendFrameData(const DumpType dumpType,
     frame._messageCountGameToEngine, frame._messageCountEngineToGame,\
     frame._messageCountGatewayToEngine, frame._messageCountEngineToGateway,\
     frame._messageCountViz,\
-    frame._batteryVoltage, frame._cpuFreq_kHz, EnumToString(frame._activeFeature),\
-    frame._behavior
+    frame._batteryVoltage, frame._cpuFreq_kHz, frame._visionLatency_ms,\
+    EnumToString(frame._activeFeature), frame._behavior
 
-    static const char* kFormatLine = "    %5i %5i %5i %5i %5i %5i %5i %8.3f %6i  %s  %s\n";
-    static const char* kFormatLineCSV = ",%i,%i,%i,%i,%i,%i,%i,%.3f,%i,%s,%s\n";
+    static const char* kFormatLine = "    %5i %5i %5i %5i %5i %5i %5i %8.3f %6i %8.1f  %s  %s\n";
+    static const char* kFormatLineCSV = ",%i,%i,%i,%i,%i,%i,%i,%.3f,%i,%.1f,%s,%s\n";
     
     return snprintf(&_dumpBuffer[dumpBufferOffset], kSizeDumpBuffer - dumpBufferOffset,
                     dumpType == DT_FILE_CSV ? kFormatLineCSV : kFormatLine,
@@ -232,10 +237,11 @@ int PerfMetricEngine::AppendSummaryData(const DumpType dumpType,
   _accMessageCountGtE.StatCall(), _accMessageCountEtG.StatCall(),\
   _accMessageCountGatewayToE.StatCall(), _accMessageCountEToGateway.StatCall(),\
   _accMessageCountViz.StatCall(),\
-  _accBatteryVoltage.StatCall(), _accCPUFreq.StatCall()
+  _accBatteryVoltage.StatCall(), _accCPUFreq.StatCall(),\
+  _accVisionLatency.StatCall()
 
-  static const char* kFormatLine = "    %5.1f %5.1f %5.1f %5.1f %5.1f %5.1f %5.1f %8.3f %6.0f\n";
-  static const char* kFormatLineCSV = ",%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.3f,%.0f\n";
+  static const char* kFormatLine = "    %5.1f %5.1f %5.1f %5.1f %5.1f %5.1f %5.1f %8.3f %6.0f %8.1f\n";
+  static const char* kFormatLineCSV = ",%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.3f,%.0f,%.1f\n";
 
 #define APPEND_SUMMARY_LINE(StatCall)\
   lenOut = snprintf(&_dumpBuffer[dumpBufferOffset], kSizeDumpBuffer - dumpBufferOffset,\
@@ -64,6 +64,7 @@ private:
 
     float _batteryVoltage;
     uint32_t _cpuFreq_kHz;
+    float _visionLatency_ms; // Capture to BlockWorld/FaceWorld update, for the last image processed
 
     ActiveFeature    _activeFeature;
     static const int kBehaviorStringMaxSize = 32;
@@ -84,6 +85,7 @@ private:
   Util::Stats::StatsAccumulator _accMessageCountViz;
   Util::Stats::StatsAccumulator _accBatteryVoltage;
   Util::Stats::StatsAccumulator _accCPUFreq;
+  Util::Stats::StatsAccumulator _accVisionLatency;
 };
 
 static const int kNumFramesInBuffer = 1000;
@@ -22,6 +22,8 @@
 #include "util/console/consoleInterface.h"
 #include "util/logging/DAS.h"
 
+#include <algorithm>
+
 namespace  Anki {
 namespace Vector {
 
@@ -29,6 +31,10 @@ CONSOLE_VAR(f32, kHeadTurnSpeedThreshPet_degs, "WasRotatingTooFast.Pet.Head_deg/
 CONSOLE_VAR(f32, kBodyTurnSpeedThreshPet_degs, "WasRotatingTooFast.Pet.Body_deg/s", 30.f);
 CONSOLE_VAR(u8,  kNumImuDataToLookBackPet,     "WasRotatingTooFast.Pet.NumToLookBack", 5);
 
+namespace {
+  bool IsPetIDLess(const Vision::TrackedPet& pet, Vision::FaceID_t petID) { return pet.GetID() < petID; }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 PetWorld::PetWorld()
 : IDependencyManagedComponent(this, RobotComponentID::PetWorld)
@@ -45,12 +51,13 @@ void PetWorld::InitDependent(Vector::Robot* robot, const RobotCompMap& dependent
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result PetWorld::Update(const std::list<Vision::TrackedPet>& pets)
+Result PetWorld::Update(const std::vector<Vision::TrackedPet>& pets)
 {
   // For now, we just keep up with what was seen in the most recent image,
   // while maintaining numTimesObserved
   {
-    PetContainer newKnownPets;
+    PetContainer& newKnownPets = _newKnownPets;
+    newKnownPets.clear();
 
     for(auto & petDetection : pets)
     {
@@ -59,14 +66,12 @@ Result PetWorld::Update(const std::list<Vision::TrackedPet>& pets)
       // (b) it's an existing pet and we want to keep it (even if we were moving too fast)
 
       // See if it was already in the old map
-      auto existingIter = _knownPets.find(petDetection.GetID());
-      if(existingIter != _knownPets.end())
+      const Vision::TrackedPet* oldKnownPet = GetPetByID(petDetection.GetID());
+      if(nullptr != oldKnownPet)
       {
         // If we already knew about this ID, increment its num times seen
-        const Vision::TrackedPet& oldKnownPet = existingIter->second;
-        Vision::TrackedPet newKnownPet(petDetection);
-        newKnownPet.SetNumTimesObserved(oldKnownPet.GetNumTimesObserved() + 1);
-        newKnownPets.emplace(petDetection.GetID(), std::move(newKnownPet));
+        newKnownPets.push_back(petDetection);
+        newKnownPets.back().SetNumTimesObserved(oldKnownPet->GetNumTimesObserved() + 1);
       }
       else
       {
@@ -81,20 +86,27 @@ Result PetWorld::Update(const std::list<Vision::TrackedPet>& pets)
                                                                                         (petDetection.IsBeingTracked() ? kNumImuDataToLookBackPet : 0)));
         if(!wasRotatingTooFast)
         {
-          Vision::TrackedPet newKnownPet(petDetection);
-          newKnownPet.SetNumTimesObserved(1);
-          newKnownPets.emplace(petDetection.GetID(), std::move(newKnownPet));
+          newKnownPets.push_back(petDetection);
+          newKnownPets.back().SetNumTimesObserved(1);
         }
       }
     }
 
+    // Sort by ID, keeping only the first detection of any ID seen more than once
+    std::stable_sort(newKnownPets.begin(), newKnownPets.end(),
+                     [](const Vision::TrackedPet& a, const Vision::TrackedPet& b) { return a.GetID() < b.GetID(); });
+    newKnownPets.erase(std::unique(newKnownPets.begin(), newKnownPets.end(),
+                                   [](const Vision::TrackedPet& a, const Vision::TrackedPet& b) {
+                                     return a.GetID() == b.GetID();
+                                   }),
+                       newKnownPets.end());
+
     std::swap(newKnownPets, _knownPets);
   }
 
   // Now that knownPets is updated, Broadcast and Visualize
-  for(auto const& knownPetEntry : _knownPets)
+  for(auto const& knownPet : _knownPets)
   {
-    const Vision::TrackedPet& knownPet = knownPetEntry.second;
 
     // Log to DAS if this is the first detection for this pet:
     if(!knownPet.IsBeingTracked()) // The very first time we see a pet, it is not being "tracked" yet
@@ -179,9 +191,9 @@ std::set<Vision::FaceID_t> PetWorld::GetKnownPetsWithType(Vision::PetType type)
   std::set<Vision::FaceID_t> matchingPets;
   for(auto & pet : _knownPets)
   {
-    if(Vision::PetType::Unknown == type || pet.second.GetType() == type)
+    if(Vision::PetType::Unknown == type || pet.GetType() == type)
     {
-      matchingPets.insert(pet.first);
+      matchingPets.insert(matchingPets.end(), pet.GetID());
     }
   }
 
@@ -191,14 +203,14 @@ std::set<Vision::FaceID_t> PetWorld::GetKnownPetsWithType(Vision::PetType type)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 const Vision::TrackedPet* PetWorld::GetPetByID(Vision::FaceID_t faceID) const
 {
-  auto iter = _knownPets.find(faceID);
-  if(iter == _knownPets.end())
+  auto iter = std::lower_bound(_knownPets.begin(), _knownPets.end(), faceID, IsPetIDLess);
+  if(iter == _knownPets.end() || iter->GetID() != faceID)
   {
     return nullptr;
   }
   else
   {
-    return &iter->second;
+    return &(*iter);
   }
 }
 
@@ -20,9 +20,8 @@
 #include "engine/aiComponent/behaviorComponent/behaviors/iCozmoBehavior_fwd.h"
 #include "util/entityComponent/entity.h"
 
-#include <list>
-#include <map>
 #include <set>
+#include <vector>
 
 namespace  Anki {
 namespace Vector {
@@ -33,7 +32,8 @@ class Robot;
 class PetWorld : public IDependencyManagedComponent<RobotComponentID>
 {
 public: 
-  using PetContainer = std::map<Vision::FaceID_t, Vision::TrackedPet>;
+  // Sorted by pet ID. Only the pets seen in the most recent image are kept, so this is always small.
+  using PetContainer = std::vector<Vision::TrackedPet>;
   
   PetWorld();
 
@@ -51,9 +51,9 @@ public:
   
   // Pass in observed faces (e.g. from Vision thread to keep this class in sync)
   // Also takes care of Broadcasting RobotObservedPet messages and updating Viz.
-  Result Update(const std::list<Vision::TrackedPet>& observedPetFaces);
+  Result Update(const std::vector<Vision::TrackedPet>& observedPetFaces);
   
-  // Return a container with all currently known pets in it
+  // Return a container with all currently known pets in it, in order of ID
   const PetContainer& GetAllKnownPets() const { return _knownPets; }
   
   // Return the IDs of the pets with the given type. If PetType::UnknownType is
@@ -70,6 +70,9 @@ private:
   
   PetContainer _knownPets;
   
+  // Swapped with _knownPets on each Update, so that neither reallocates once it has grown to the number of pets seen
+  PetContainer _newKnownPets;
+  
 }; // class PetWorld
   
 } // namespace Vector
@@ -103,6 +103,9 @@ CONSOLE_VAR(bool, kUseVisionOnlyWhileOnTreads,    "Robot", false);
 // Enable to enable example code of face image drawing
 CONSOLE_VAR(bool, kEnableTestFaceImageRGBDrawing,  "Robot", false);
 
+// Worker threads for updating robot components that can update in parallel (0 to update them all on the engine thread)
+CONSOLE_VAR_RANGED(u32, kNumComponentUpdateWorkers, "Robot", 2, 0, 8);
+
 #if REMOTE_CONSOLE_ENABLED
 
 // Robot singleton
@@ -1309,6 +1312,7 @@ Result Robot::Update()
   return RESULT_OK;
 #endif
 
+  _components->SetNumUpdateWorkers(kNumComponentUpdateWorkers);
   _components->UpdateComponents();
 
   // If anything in updating block world caused a localization update, notify
@@ -1861,11 +1865,15 @@ Result Robot::SetPosePostRollOffCharger()
 
 Result Robot::SendMessage(const RobotInterface::EngineToRobot& msg, bool reliable, bool hot) const
 {
-  static Util::MessageProfiler msgProfiler("Robot::SendMessage");
+  static Util::MessageProfiler msgProfiler("Robot::SendMessage", [](int tag) {
+    return EngineToRobotTagToString((RobotInterface::EngineToRobotTag)tag);
+  });
 
+  const auto sendStart = std::chrono::steady_clock::now();
   Result sendResult = GetContext()->GetRobotManager()->GetMsgHandler()->SendMessage(msg, reliable, hot);
   if (sendResult == RESULT_OK) {
-    msgProfiler.Update((int)msg.GetTag(), msg.Size());
+    const auto sendTime = std::chrono::steady_clock::now() - sendStart;
+    msgProfiler.Update((int)msg.GetTag(), msg.Size(), std::chrono::duration_cast<std::chrono::microseconds>(sendTime).count());
   } else {
     const char* msgTypeName = EngineToRobotTagToString(msg.GetTag());
     LOG_WARNING("Robot.SendMessage", "Robot %d failed to send a message type %s", _ID, msgTypeName);
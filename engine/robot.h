@@ -197,6 +197,10 @@ public:
   template<typename T>
   T* GetComponentPtr() {return _components->GetComponentPtr<T>();}
 
+  // Per-component update costs, see DependencyManagedEntity::SetUpdateTimingEnabled
+  void SetComponentUpdateTimingEnabled(bool enabled) { _components->SetUpdateTimingEnabled(enabled); }
+  RobotCompMap::UpdateTimes GetComponentUpdateTimes() const { return _components->GetUpdateTimes(); }
+
   //
   // Most components declare both const and non-const accessors.
   // If your component does not fit this pattern, add custom code below.
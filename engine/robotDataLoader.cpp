@@ -28,9 +28,11 @@
 #include "engine/components/cubes/cubeLights/cubeLightComponent.h"
 #include "engine/components/variableSnapshot/variableSnapshotComponent.h"
 #include "engine/components/variableSnapshot/variableSnapshotEncoder.h"
+#include "engine/components/variableSnapshot/variableSnapshotJournal.h"
 #include "engine/cozmoContext.h"
 #include "engine/utils/cozmoExperiments.h"
 #include "engine/utils/cozmoFeatureGate.h"
+#include "engine/utils/jsonConfigCache.h"
 #include "threadedPrintStressTester.h"
 #include "util/ankiLab/ankiLab.h"
 #include "util/cladHelpers/cladEnumToStringMap.h"
@@ -44,6 +46,9 @@
 #include "util/threading/threadPriority.h"
 #include "util/time/universalTime.h"
 #include <json/json.h>
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <string>
 #include <sys/stat.h>
 
@@ -53,6 +58,15 @@ namespace {
 
 CONSOLE_VAR(bool, kStressTestThreadedPrintsDuringLoad, "RobotDataLoader", false);
 
+// Serve behavior, animation group and cube light configs from binary caches instead of parsing their json each boot
+CONSOLE_VAR(bool, kUseJsonConfigCache, "RobotDataLoader", true);
+
+const char* kJsonConfigCacheDir = "jsonConfigCache/";
+
+// Threads the data categories are loaded on, including the loading thread itself. Some categories parse their files
+// with their own workers on top of these
+CONSOLE_VAR(u32, kNumDataLoadingThreads, "RobotDataLoader", 3);
+
 #if REMOTE_CONSOLE_ENABLED
 static Anki::Vector::ThreadedPrintStressTester stressTester;
 #endif // REMOTE_CONSOLE_ENABLED
@@ -93,6 +107,114 @@ const std::vector<std::string> kPathsToEngineAccessibleAnimations = {
   "assets/animations/anim_power_onoff_01.bin",
 
 };
+
+// Runs load tasks on a few threads, each one as soon as the tasks it depends on have finished, and logs how long
+// each took and when it started relative to the whole load
+class LoadTaskGraph
+{
+public:
+  // dependencies must have been added already
+  void AddTask(const char* name, const std::vector<const char*>& dependencies, std::function<void()>&& func)
+  {
+    const size_t index = _tasks.size();
+    _tasks.emplace_back();
+    Task& task = _tasks.back();
+    task.name = name;
+    task.func = std::move(func);
+    for (const char* dependency : dependencies) {
+      auto it = std::find_if(_tasks.begin(), _tasks.end(), [dependency](const Task& other) {
+        return other.name == dependency;
+      });
+      if (ANKI_VERIFY(it != _tasks.end() && &(*it) != &task,
+                      "RobotDataLoader.LoadTaskGraph.UnknownDependency",
+                      "Task %s depends on %s, which hasn't been added",
+                      name, dependency)) {
+        it->dependents.push_back(index);
+        ++task.numBlockers;
+      }
+    }
+  }
+
+  // numThreads includes the calling thread
+  void Run(uint32_t numThreads)
+  {
+    _startTime_ms = Anki::Util::Time::UniversalTime::GetCurrentTimeInMilliseconds();
+    for (size_t i = 0; i < _tasks.size(); ++i) {
+      if (_tasks[i].numBlockers == 0) {
+        _ready.push_back(i);
+      }
+    }
+
+    std::vector<std::thread> threads;
+    for (uint32_t i = 1; i < numThreads; ++i) {
+      threads.emplace_back([this, i] {
+        Anki::Util::SetThreadName(pthread_self(), "RbtDataLoad" + std::to_string(i));
+        RunTasks();
+      });
+    }
+    RunTasks();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    const double totalTime_ms = Anki::Util::Time::UniversalTime::GetCurrentTimeInMilliseconds() - _startTime_ms;
+    for (const auto& task : _tasks) {
+      LOG_INFO("RobotDataLoader.LoadTaskGraph.TaskTime", "%s took %.1f ms, starting at %.1f ms",
+               task.name.c_str(), task.duration_ms, task.start_ms);
+    }
+    LOG_INFO("RobotDataLoader.LoadTaskGraph.TotalTime", "Loaded %zu categories on %u threads in %.1f ms",
+             _tasks.size(), numThreads, totalTime_ms);
+  }
+
+private:
+
+  struct Task {
+    std::string           name;
+    std::function<void()> func;
+    std::vector<size_t>   dependents;
+    size_t                numBlockers = 0; // unfinished dependencies
+    double                start_ms = 0.0;
+    double                duration_ms = 0.0;
+  };
+
+  void RunTasks()
+  {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+      _cv.wait(lock, [this] { return !_ready.empty() || (_numFinished == _tasks.size()); });
+      if (_ready.empty()) {
+        return;
+      }
+
+      Task& task = _tasks[_ready.front()];
+      _ready.pop_front();
+      lock.unlock();
+
+      const double start_ms = Anki::Util::Time::UniversalTime::GetCurrentTimeInMilliseconds();
+      task.func();
+      const double end_ms = Anki::Util::Time::UniversalTime::GetCurrentTimeInMilliseconds();
+
+      lock.lock();
+      task.start_ms = start_ms - _startTime_ms;
+      task.duration_ms = end_ms - start_ms;
+      for (const size_t dependent : task.dependents) {
+        if (--_tasks[dependent].numBlockers == 0) {
+          _ready.push_back(dependent);
+        }
+      }
+      ++_numFinished;
+      _cv.notify_all();
+    }
+  }
+
+  std::vector<Task>       _tasks;
+  std::deque<size_t>      _ready;
+  size_t                  _numFinished = 0;
+  std::mutex              _mutex;
+  std::condition_variable _cv;
+  double                  _startTime_ms = 0.0;
+};
+
 }
 
 
@@ -135,54 +257,21 @@ void RobotDataLoader::LoadNonConfigData()
     REMOTE_CONSOLE_ENABLED_ONLY( stressTester.Start() );
   }
 
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::CollectFiles");
-    CollectAnimFiles();
-  }
-
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadBehaviors");
-    LoadBehaviors();
-  }
-
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadWeatherResponseMaps");
-    LoadWeatherResponseMaps();
-  }
-
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadWeatherRemaps");
-    LoadWeatherRemaps();
-  }
-
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadWeatherConditionTTSMap");
-    LoadWeatherConditionTTSMap();
-  }
-
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadVariableSnapshotJsonMap");
-    LoadVariableSnapshotJsonMap();
-  }
-  
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadCubeSpinnerConfig");
-    LoadCubeSpinnerConfig();
-  }
-
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadUserDefinedBehaviorTreeConfig");
-    LoadUserDefinedBehaviorTreeConfig();
-  }
-
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadSpritePaths");
+  // Categories only wait for the ones they read from, so independent ones load side by side
+  LoadTaskGraph tasks;
+  tasks.AddTask("CollectFiles", {}, [this] { CollectAnimFiles(); });
+  tasks.AddTask("Behaviors", {}, [this] { LoadBehaviors(); });
+  tasks.AddTask("WeatherResponseMaps", {}, [this] { LoadWeatherResponseMaps(); });
+  tasks.AddTask("WeatherRemaps", {}, [this] { LoadWeatherRemaps(); });
+  tasks.AddTask("WeatherConditionTTSMap", {}, [this] { LoadWeatherConditionTTSMap(); });
+  tasks.AddTask("VariableSnapshotJsonMap", {}, [this] { LoadVariableSnapshotJsonMap(); });
+  tasks.AddTask("CubeSpinnerConfig", {}, [this] { LoadCubeSpinnerConfig(); });
+  tasks.AddTask("UserDefinedBehaviorTreeConfig", {}, [this] { LoadUserDefinedBehaviorTreeConfig(); });
+  tasks.AddTask("SpritePaths", {}, [this] {
     LoadSpritePaths();
     _spriteCache = std::make_unique<Vision::SpriteCache>(_spritePaths.get());
-  }
-
-  {
-    ANKI_CPU_PROFILE("RobotDataLoader::LoadSpriteSequences");
+  });
+  tasks.AddTask("SpriteSequences", {"SpritePaths"}, [this] {
     std::vector<std::string> spriteSequenceDirs = {kPathToExternalSpriteSequences, kPathToEngineSpriteSequences};
     SpriteSequenceLoader seqLoader;
     auto* sContainer = seqLoader.LoadSpriteSequences(_platform,
@@ -190,52 +279,21 @@ void RobotDataLoader::LoadNonConfigData()
                                                      _spriteCache.get(),
                                                      spriteSequenceDirs);
     _spriteSequenceContainer.reset(sContainer);
-  }
+  });
 
   if(!FACTORY_TEST)
   {
-    {
-      ANKI_CPU_PROFILE("RobotDataLoader::LoadAnimationGroups");
-      LoadAnimationGroups();
-    }
-
-    {
-      ANKI_CPU_PROFILE("RobotDataLoader::LoadCubeLightAnimations");
-      LoadCubeLightAnimations();
-    }
-
-    {
-      ANKI_CPU_PROFILE("RobotDataLoader::LoadCubeAnimationTriggerMap");
-      LoadCubeAnimationTriggerMap();
-    }
-    {
-      ANKI_CPU_PROFILE("RobotDataLoader::LoadEmotionEvents");
-      LoadEmotionEvents();
-    }
-
-    {
-      ANKI_CPU_PROFILE("RobotDataLoader::LoadDasBlacklistedAnimations");
-      LoadDasBlacklistedAnimations();
-    }
-
-    {
-      ANKI_CPU_PROFILE("RobotDataLoader::LoadAnimationTriggerMap");
-      LoadAnimationTriggerMap();
-    }
-
-    {
-      ANKI_CPU_PROFILE("RobotDataLoader::LoadCompositeImageMaps");
-      LoadCompositeImageMaps();
-    }
-
-    {
-      ANKI_CPU_PROFILE("RobotDataLoader::LoadAnimationWhitelist");
-      LoadAnimationWhitelist();
-    }
-
+    tasks.AddTask("AnimationGroups", {"CollectFiles"}, [this] { LoadAnimationGroups(); });
+    tasks.AddTask("CubeLightAnimations", {"CollectFiles"}, [this] { LoadCubeLightAnimations(); });
+    tasks.AddTask("CubeAnimationTriggerMap", {}, [this] { LoadCubeAnimationTriggerMap(); });
+    tasks.AddTask("EmotionEvents", {}, [this] { LoadEmotionEvents(); });
+    tasks.AddTask("DasBlacklistedAnimations", {}, [this] { LoadDasBlacklistedAnimations(); });
+    tasks.AddTask("AnimationTriggerMap", {}, [this] { LoadAnimationTriggerMap(); });
+    tasks.AddTask("CompositeImageMaps", {"SpriteSequences"}, [this] { LoadCompositeImageMaps(); });
+    tasks.AddTask("AnimationWhitelist", {}, [this] { LoadAnimationWhitelist(); });
   }
   
-  {
+  tasks.AddTask("CannedAnimations", {"SpriteSequences"}, [this] {
     CannedAnimationLoader animLoader(_platform,
                                      _spriteSequenceContainer.get(),
                                      _loadingCompleteRatio, _abortLoad);
@@ -247,6 +305,11 @@ void RobotDataLoader::LoadNonConfigData()
       const auto fullPath =  _platform->pathToResource(Util::Data::Scope::Resources, path);
       animLoader.LoadAnimationIntoContainer(fullPath, _cannedAnimations.get());
     }
+  });
+
+  {
+    ANKI_CPU_PROFILE("RobotDataLoader::LoadTasks");
+    tasks.Run(std::max(kNumDataLoadingThreads, 1u));
   }
 
   // this map doesn't need to be persistent
@@ -269,6 +332,10 @@ void RobotDataLoader::AddToLoadingRatio(float delta)
 
 void RobotDataLoader::CollectAnimFiles()
 {
+  // the categories that read these lists load in parallel, so they must not be adding their entries on first access
+  _jsonFiles[FileType::AnimationGroup];
+  _jsonFiles[FileType::CubeLightAnimation];
+
   // animations
   {
     std::vector<std::string> paths;
@@ -328,8 +395,9 @@ void RobotDataLoader::LoadCubeLightAnimations()
   const double startTime = Util::Time::UniversalTime::GetCurrentTimeInMilliseconds();
 
   using MyDispatchWorker = Util::DispatchWorker<3, const std::string&>;
+  const auto cache = OpenJsonConfigCache("cubeLightAnimations.bin", fileList);
   MyDispatchWorker::FunctionType loadFileFunc = std::bind(&RobotDataLoader::LoadCubeLightAnimationFile, 
-                                                          this, std::placeholders::_1);
+                                                          this, cache.get(), std::placeholders::_1);
   MyDispatchWorker myWorker(loadFileFunc);
 
   for (int i = 0; i < size; i++) {
@@ -337,6 +405,7 @@ void RobotDataLoader::LoadCubeLightAnimations()
   }
   
   myWorker.Process();
+  SaveJsonConfigCache(cache.get());
 
   const double endTime = Util::Time::UniversalTime::GetCurrentTimeInMilliseconds();
   double loadTime = endTime - startTime;
@@ -345,10 +414,10 @@ void RobotDataLoader::LoadCubeLightAnimations()
 
 }
 
-void RobotDataLoader::LoadCubeLightAnimationFile(const std::string& path)
+void RobotDataLoader::LoadCubeLightAnimationFile(JsonConfigCache* cache, const std::string& path)
 {
   Json::Value animDefs;
-  const bool success = _platform->readAsJson(path.c_str(), animDefs);
+  const bool success = ReadConfigJson(cache, path, animDefs);
   if (success && !animDefs.empty()) {
     std::lock_guard<std::mutex> guard(_parallelLoadingMutex);
     _cubeLightAnimations.emplace(path, animDefs);
@@ -357,16 +426,19 @@ void RobotDataLoader::LoadCubeLightAnimationFile(const std::string& path)
 
 void RobotDataLoader::LoadAnimationGroups()
 {
-  using MyDispatchWorker = Util::DispatchWorker<3, const std::string&>;
-  MyDispatchWorker::FunctionType loadFileFunc = std::bind(&RobotDataLoader::LoadAnimationGroupFile, this, std::placeholders::_1);
-  MyDispatchWorker myWorker(loadFileFunc);
   const auto& fileList = _jsonFiles[FileType::AnimationGroup];
   const auto size = fileList.size();
+  const auto cache = OpenJsonConfigCache("animationGroups.bin", fileList);
+  using MyDispatchWorker = Util::DispatchWorker<3, const std::string&>;
+  MyDispatchWorker::FunctionType loadFileFunc = std::bind(&RobotDataLoader::LoadAnimationGroupFile,
+                                                          this, cache.get(), std::placeholders::_1);
+  MyDispatchWorker myWorker(loadFileFunc);
   for (int i = 0; i < size; i++) {
     myWorker.PushJob(fileList[i]);
     //LOG_DEBUG("RobotDataLoader.LoadAnimationGroups", "loaded anim group %d of %zu", i, size);
   }
   myWorker.Process();
+  SaveJsonConfigCache(cache.get());
 }
 
 void RobotDataLoader::WalkAnimationDir(const std::string& animationDir, TimestampMap& timestamps, const std::function<void(const std::string&)>& walkFunc)
@@ -404,13 +476,13 @@ void RobotDataLoader::WalkAnimationDir(const std::string& animationDir, Timestam
   }
 }
 
-void RobotDataLoader::LoadAnimationGroupFile(const std::string& path)
+void RobotDataLoader::LoadAnimationGroupFile(JsonConfigCache* cache, const std::string& path)
 {
   if (_abortLoad.load(std::memory_order_relaxed)) {
     return;
   }
   Json::Value animGroupDef;
-  const bool success = _platform->readAsJson(path, animGroupDef);
+  const bool success = ReadConfigJson(cache, path, animGroupDef);
   if (success && !animGroupDef.empty()) {
     std::string animationGroupName = Util::FileUtils::GetFileName(path, true, true);
 
@@ -447,31 +519,78 @@ void RobotDataLoader::LoadBehaviors()
 
   const std::string behaviorFolder = _platform->pathToResource(Util::Data::Scope::Resources, path);
   auto behaviorJsonFiles = Util::FileUtils::FilesInDirectory(behaviorFolder, true, ".json", true);
-  for (const auto& filename : behaviorJsonFiles)
+
+  // Same as the animation loading: files are parsed in parallel and only adding them is serialized
+  const auto cache = OpenJsonConfigCache("behaviors.bin", behaviorJsonFiles);
+  using MyDispatchWorker = Util::DispatchWorker<3, const std::string&>;
+  MyDispatchWorker::FunctionType loadFileFunc = std::bind(&RobotDataLoader::LoadBehaviorFile,
+                                                          this, cache.get(), std::placeholders::_1);
+  MyDispatchWorker myWorker(loadFileFunc);
+  for (const auto& filename : behaviorJsonFiles) {
+    myWorker.PushJob(filename);
+  }
+  myWorker.Process();
+  SaveJsonConfigCache(cache.get());
+}
+
+void RobotDataLoader::LoadBehaviorFile(JsonConfigCache* cache, const std::string& filename)
+{
+  if (_abortLoad.load(std::memory_order_relaxed)) {
+    return;
+  }
+  Json::Value behaviorJson;
+  const bool success = ReadConfigJson(cache, filename, behaviorJson);
+  if (success && !behaviorJson.empty())
   {
-    Json::Value behaviorJson;
-    const bool success = _platform->readAsJson(filename, behaviorJson);
-    if (success && !behaviorJson.empty())
-    {
-      BehaviorID behaviorID = ICozmoBehavior::ExtractBehaviorIDFromConfig(behaviorJson, filename);
-      auto result = _behaviors.emplace(std::piecewise_construct,
-                                       std::forward_as_tuple(behaviorID),
-                                       std::forward_as_tuple(std::move(behaviorJson)));
+    std::lock_guard<std::mutex> guard(_parallelLoadingMutex);
+    BehaviorID behaviorID = ICozmoBehavior::ExtractBehaviorIDFromConfig(behaviorJson, filename);
+    auto result = _behaviors.emplace(std::piecewise_construct,
+                                     std::forward_as_tuple(behaviorID),
+                                     std::forward_as_tuple(std::move(behaviorJson)));
 
-      DEV_ASSERT_MSG(result.second,
-                     "RobotDataLoader.LoadBehaviors.FailedEmplace",
-                     "Failed to insert BehaviorID %s - make sure all behaviors have unique IDs",
-                     BehaviorTypesWrapper::BehaviorIDToString(behaviorID));
+    DEV_ASSERT_MSG(result.second,
+                   "RobotDataLoader.LoadBehaviors.FailedEmplace",
+                   "Failed to insert BehaviorID %s - make sure all behaviors have unique IDs",
+                   BehaviorTypesWrapper::BehaviorIDToString(behaviorID));
 
-    }
-    else if (!success)
-    {
-      LOG_WARNING("RobotDataLoader.Behavior", "Failed to read '%s'", filename.c_str());
-    }
+  }
+  else if (!success)
+  {
+    LOG_WARNING("RobotDataLoader.Behavior", "Failed to read '%s'", filename.c_str());
   }
 }
 
 
+std::unique_ptr<JsonConfigCache> RobotDataLoader::OpenJsonConfigCache(const std::string& cacheName,
+                                                                      const std::vector<std::string>& sourcePaths) const
+{
+  if (!kUseJsonConfigCache) {
+    return nullptr;
+  }
+  const std::string cachePath = _platform->GetCachePath(kJsonConfigCacheDir + cacheName);
+  return std::make_unique<JsonConfigCache>(cachePath, sourcePaths);
+}
+
+void RobotDataLoader::SaveJsonConfigCache(JsonConfigCache* cache) const
+{
+  // a partial load would only make a cache that's rebuilt on the next boot anyway
+  if (cache != nullptr && !_abortLoad.load(std::memory_order_relaxed)) {
+    cache->Save();
+  }
+}
+
+bool RobotDataLoader::ReadConfigJson(JsonConfigCache* cache, const std::string& path, Json::Value& outJson) const
+{
+  if (cache != nullptr && cache->Get(path, outJson)) {
+    return true;
+  }
+  const bool success = _platform->readAsJson(path, outJson);
+  if (success && cache != nullptr) {
+    cache->Add(path, outJson);
+  }
+  return success;
+}
+
 void RobotDataLoader::LoadSpritePaths()
 {
     // Get all independent sprites
@@ -780,6 +899,26 @@ void RobotDataLoader::LoadVariableSnapshotJsonMap()
       }
     }
   }
+
+  // changes journaled after the snapshot was written are newer than what it holds
+  const std::string journalPath = VariableSnapshotComponent::GetJournalPath(_platform,
+                                                                            VariableSnapshotComponent::kVariableSnapshotFolder,
+                                                                            VariableSnapshotComponent::kVariableSnapshotFilename);
+  const size_t numJournaled = VariableSnapshotJournal::Replay(journalPath, [this](Json::Value&& entry) {
+    const auto key = entry[VariableSnapshotEncoder::kVariableSnapshotIdKey].asString();
+    VariableSnapshotId variableSnapshotId = VariableSnapshotId::Count;
+    if(VariableSnapshotIdFromString(key, variableSnapshotId)){
+      (*_variableSnapshotJsonMap)[variableSnapshotId] = std::move(entry);
+    }
+  });
+
+  // fold the journal into the snapshot so that this boot starts a fresh one (appending after a torn record
+  // would leave everything after it unreadable)
+  if(Util::FileUtils::FileExists(journalPath)) {
+    PRINT_CH_INFO("DataLoader", "RobotDataLoader.LoadVariableSnapshotJsonMap.CompactJournal",
+                  "Folding %zu journaled snapshot changes into %s", numJournaled, path.c_str());
+    VariableSnapshotComponent::WriteSnapshot(_platform, *_variableSnapshotJsonMap);
+  }
 }
 
 
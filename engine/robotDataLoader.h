@@ -61,6 +61,7 @@ enum class AnimationTrigger : int32_t;
 class CannedAnimationContainer;
 class CubeLightAnimationContainer;
 class CozmoContext;
+class JsonConfigCache;
 
 class RobotDataLoader : private Util::noncopyable
 {
@@ -170,11 +171,11 @@ private:
   void CollectAnimFiles();
   
   void LoadCubeLightAnimations();
-  void LoadCubeLightAnimationFile(const std::string& path);
+  void LoadCubeLightAnimationFile(JsonConfigCache* cache, const std::string& path);
 
   
   void LoadAnimationGroups();
-  void LoadAnimationGroupFile(const std::string& path);
+  void LoadAnimationGroupFile(JsonConfigCache* cache, const std::string& path);
   
   void LoadAnimationTriggerMap();
   void LoadCubeAnimationTriggerMap();
@@ -187,6 +188,7 @@ private:
 
   void LoadEmotionEvents();
   void LoadBehaviors();
+  void LoadBehaviorFile(JsonConfigCache* cache, const std::string& path);
 
   void LoadDasBlacklistedAnimations();
   
@@ -206,6 +208,13 @@ private:
 
   void LoadAnimationWhitelist();
 
+  // ReadConfigJson serves a category's files from its cache, or reads them and records them in it if the cache is
+  // missing or stale. SaveJsonConfigCache writes a new one in the latter case. The cache is null if caching is off
+  std::unique_ptr<JsonConfigCache> OpenJsonConfigCache(const std::string& cacheName,
+                                                       const std::vector<std::string>& sourcePaths) const;
+  void SaveJsonConfigCache(JsonConfigCache* cache) const;
+  bool ReadConfigJson(JsonConfigCache* cache, const std::string& path, Json::Value& outJson) const;
+
   // Outputs a map of file name (no path or extensions) to the full file path
   // Useful for clad mappings/lookups
   std::map<std::string, std::string> CreateFileNameToFullPathMap(const std::vector<const char*> & srcDirs, const std::string& fileExtensions) const;
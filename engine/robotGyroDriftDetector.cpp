@@ -8,11 +8,13 @@
 #include "engine/robotGyroDriftDetector.h"
 
 #include "engine/components/sensors/cliffSensorComponent.h"
+#include "engine/components/sensors/imuComponent.h"
 #include "engine/components/movementComponent.h"
 #include "engine/robot.h"
 
 #include "util/logging/DAS.h"
 
+#include <algorithm>
 #include <limits> // std::numeric_limits<>
 
 namespace Anki {
@@ -76,10 +78,6 @@ void RobotGyroDriftDetector::DetectGyroDrift(const RobotState& msg)
       _startAngle_rad          = _robot->GetPose().GetRotation().GetAngleAroundZaxis();
       _startGyroZ_rad_per_sec  = gyroZ;
       _startTime_ms            = msg.timestamp;
-      _cumSumGyroZ_rad_per_sec = gyroZ;
-      _minGyroZ_rad_per_sec    = gyroZ;
-      _maxGyroZ_rad_per_sec    = gyroZ;
-      _numReadings             = 1;
     }
 
     // If gyro readings have been accumulating for long enough...
@@ -89,11 +87,13 @@ void RobotGyroDriftDetector::DetectGyroDrift(const RobotState& msg)
       const f32 headingAngleChange = std::fabsf((_startAngle_rad - _robot->GetPose().GetRotation().GetAngleAroundZaxis()).ToFloat());
       const f32 angleChangeThresh = kDriftCheckMaxAngleChangeRate_rad_per_sec * Util::MilliSecToSec(kDriftCheckPeriod_ms);
 
-      if (headingAngleChange > angleChangeThresh) {
+      // The IMU history does not reach back a whole check period, so the gyro stats over it are folded in as the
+      // frames arrive, below
+      if ((headingAngleChange > angleChangeThresh) && (_gyroZStats.numFrames > 0)) {
         // Report drift detected just one time during a session
-        const int min_mdeg_per_sec = std::round(RAD_TO_DEG(1000.f * _minGyroZ_rad_per_sec));
-        const int max_mdeg_per_sec = std::round(RAD_TO_DEG(1000.f * _maxGyroZ_rad_per_sec));
-        const int mean_mdeg_per_sec = std::round(RAD_TO_DEG(1000.f * _cumSumGyroZ_rad_per_sec) / _numReadings);
+        const int min_mdeg_per_sec = std::round(RAD_TO_DEG(1000.f * _gyroZStats.min_rad_per_sec));
+        const int max_mdeg_per_sec = std::round(RAD_TO_DEG(1000.f * _gyroZStats.max_rad_per_sec));
+        const int mean_mdeg_per_sec = std::round(RAD_TO_DEG(1000.f * _gyroZStats.sum_rad_per_sec) / _gyroZStats.numFrames);
         const int headingAngleChange_mdeg_per_sec = std::round(RAD_TO_DEG(1000.f * headingAngleChange));
         
         DASMSG(gyro_bias_detected, "gyro.drift_detected", "We have detected gyro bias drift ('legacy' detection method)");
@@ -108,17 +108,27 @@ void RobotGyroDriftDetector::DetectGyroDrift(const RobotState& msg)
       _startTime_ms = 0;
     }
 
-    // Record min and max observed gyro readings and cumulative sum for later mean computation
+    // Record min and max observed gyro readings and cumulative sum for later mean computation, from the IMU
+    // frames that arrived since the last state message
     else {
-      if (gyroZ > _maxGyroZ_rad_per_sec) {
-        _maxGyroZ_rad_per_sec = gyroZ;
-      }
-      if (gyroZ < _minGyroZ_rad_per_sec) {
-        _minGyroZ_rad_per_sec = gyroZ;
+      ImuHistory::GyroStats stats;
+      if (_robot->GetImuComponent().GetImuHistory().GetGyroStats(_lastGyroStatsTime_ms, msg.timestamp, stats)) {
+        if (_gyroZStats.numFrames == 0) {
+          _gyroZStats.min_rad_per_sec = stats.min.z();
+          _gyroZStats.max_rad_per_sec = stats.max.z();
+        } else {
+          _gyroZStats.min_rad_per_sec = std::min(_gyroZStats.min_rad_per_sec, stats.min.z());
+          _gyroZStats.max_rad_per_sec = std::max(_gyroZStats.max_rad_per_sec, stats.max.z());
+        }
+        _gyroZStats.sum_rad_per_sec += stats.mean.z() * stats.numFrames;
+        _gyroZStats.numFrames += stats.numFrames;
       }
-      _cumSumGyroZ_rad_per_sec += gyroZ;
-      ++_numReadings;
     }
+
+    if (_startTime_ms == 0) {
+      _gyroZStats = GyroZStats();
+    }
+    _lastGyroStatsTime_ms = msg.timestamp;
   }
 }
 
@@ -60,10 +60,16 @@ private:
   Radians       _startAngle_rad;
   f32           _startGyroZ_rad_per_sec = 0.f;
   RobotTimeStamp_t _startTime_ms = 0;
-  f32           _cumSumGyroZ_rad_per_sec = 0.f;
-  f32           _minGyroZ_rad_per_sec = 0.f;
-  f32           _maxGyroZ_rad_per_sec = 0.f;
-  u32           _numReadings = 0;
+  
+  // gyro z readings since _startTime_ms, taken from the IMU history up to _lastGyroStatsTime_ms
+  struct GyroZStats {
+    f32 min_rad_per_sec = 0.f;
+    f32 max_rad_per_sec = 0.f;
+    f32 sum_rad_per_sec = 0.f;
+    u32 numFrames = 0;
+  };
+  GyroZStats       _gyroZStats;
+  RobotTimeStamp_t _lastGyroStatsTime_ms = 0;
   
   
   // For DetectBias:
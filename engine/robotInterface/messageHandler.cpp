@@ -21,6 +21,8 @@
 #include "engine/robotManager.h"
 #include "engine/utils/parsingConstants/parsingConstants.h"
 #include "anki/cozmo/shared/cozmoConfig.h"
+#include "anki/cozmo/shared/engineAnimMessageBatch.h"
+#include "anki/cozmo/shared/robotStateDelta.h"
 #include "coretech/common/engine/utils/timer.h"
 #include "coretech/messaging/engine/IComms.h"
 #include "clad/externalInterface/messageGameToEngine.h"
@@ -29,6 +31,7 @@
 #include "json/json.h"
 #include "util/cpuProfiler/cpuProfiler.h"
 #include "util/global/globalDefinitions.h"
+#include "util/messageProfiler/messageProfiler.h"
 #include "util/transport/transportAddress.h"
 
 namespace Anki {
@@ -40,6 +43,7 @@ MessageHandler::MessageHandler()
 , _isInitialized(false)
 , _messageCountRobotToEngine(0)
 , _messageCountEngineToRobot(0)
+, _robotStateDecoder(std::make_unique<RobotStateDeltaDecoder>())
 {
 }
 
@@ -65,14 +69,55 @@ void MessageHandler::Init(const Json::Value& config, RobotManager* robotMgr, con
   _isInitialized = true;
 }
 
+namespace {
+  Util::MessageProfiler& GetRobotToEngineProfiler()
+  {
+    static Util::MessageProfiler msgProfiler("MessageHandler::RobotToEngine", [](int tag) {
+      return RobotToEngineTagToString((RobotInterface::RobotToEngineTag)tag);
+    });
+    return msgProfiler;
+  }
+
+  // Messages that start the next engine tick as soon as they arrive. Robot state (including pickup, which is a
+  // status flag) arrives every few ms, so it just waits for the tick
+  bool IsUrgentRobotData(const uint8_t* data, uint32_t size)
+  {
+    if ((size == 0) || IsRobotStateDelta(data, size)) {
+      return false;
+    }
+    switch (static_cast<RobotInterface::RobotToEngineTag>(data[0])) {
+      case RobotInterface::RobotToEngineTag::cliffEvent:
+      case RobotInterface::RobotToEngineTag::potentialCliff:
+      case RobotInterface::RobotToEngineTag::robotStopped:
+      case RobotInterface::RobotToEngineTag::fallingEvent:
+        return true;
+      default:
+        return false;
+    }
+  }
+}
+
 Result MessageHandler::ProcessMessages()
 {
   ANKI_CPU_PROFILE("MessageHandler::ProcessMessages");
 
+  static_assert(static_cast<uint8_t>(RobotInterface::RobotToEngineTag::INVALID) == kRobotStateDeltaMarker,
+                "A compact robot state must not be mistaken for a single message");
+
   if (_isInitialized)
   {
     DEV_ASSERT(_robotConnectionManager, "MessageHander.ProcessMessages.InvalidRobotConnectionManager");
 
+    if (_isReplaying)
+    {
+      for (const auto& data : _replayedMessages)
+      {
+        HandleRobotData(data.data(), Util::numeric_cast<uint32_t>(data.size()));
+      }
+      _replayedMessages.clear();
+      return RESULT_OK;
+    }
+
     #if ANKI_PROFILE_ENGINE_SOCKET_BUFFER_STATS
     _robotConnectionManager->UpdateSocketBufferStats();
     #endif
@@ -83,61 +128,132 @@ Result MessageHandler::ProcessMessages()
       return result;
     }
 
-    std::vector<uint8_t> nextData;
-    while (_robotConnectionManager->PopData(nextData))
+    const uint8_t* nextData = nullptr;
+    uint32_t dataSize = 0;
+    while (_robotConnectionManager->PopData(nextData, dataSize))
     {
-      ++_messageCountRobotToEngine;
+      HandleRobotData(nextData, dataSize);
+    }
 
-      // If we don't have a robot to care about this message, throw it away
-      Robot* destRobot = _robotManager->GetRobot();
-      if (nullptr == destRobot)
-      {
-        continue;
-      }
+    #if ANKI_PROFILE_ENGINE_SOCKET_BUFFER_STATS
+    _robotConnectionManager->UpdateSocketBufferStats();
+    #endif
 
-      const size_t dataSize = nextData.size();
-      if (dataSize <= 0)
-      {
-        PRINT_NAMED_ERROR("MessageHandler.ProcessMessages","Tried to process message of invalid size");
-        continue;
-      }
+  }
 
-      // see if message type should be filtered out based on potential firmware mismatch
-      const RobotInterface::RobotToEngineTag msgType = static_cast<RobotInterface::RobotToEngineTag>(nextData.data()[0]);
-      if (_robotManager->ShouldFilterMessage(msgType)) {
-        continue;
-      }
+  return RESULT_OK;
+}
 
-      RobotInterface::RobotToEngine message;
-      const size_t unpackSize = message.Unpack(nextData.data(), dataSize);
-      if (unpackSize != nextData.size()) {
-        PRINT_NAMED_ERROR("RobotMessageHandler.MessageUnpack", "Message unpack error, tag %s expecting %zu but have %zu",
-                          RobotToEngineTagToString(msgType), unpackSize, dataSize);
-        continue;
-      }
+bool MessageHandler::ReceiveArrivedMessages()
+{
+  if (!_isInitialized || _isReplaying) {
+    return false;
+  }
+  return _robotConnectionManager->ReceiveArrivedMessages(&IsUrgentRobotData);
+}
 
-      #if ANKI_DEV_CHEATS
-      if (nullptr != DevLoggingSystem::GetInstance())
+int MessageHandler::GetRobotSocket() const
+{
+  if (!_isInitialized || _isReplaying) {
+    return -1;
+  }
+  return _robotConnectionManager->GetSocket();
+}
+
+void MessageHandler::HandleRobotData(const uint8_t* nextData, uint32_t dataSize)
+{
+  ++_messageCountRobotToEngine;
+
+  // If we don't have a robot to care about this message, throw it away
+  Robot* destRobot = _robotManager->GetRobot();
+  if (nullptr == destRobot)
+  {
+    return;
+  }
+
+  if (dataSize == 0)
+  {
+    PRINT_NAMED_ERROR("MessageHandler.ProcessMessages","Tried to process message of invalid size");
+    return;
+  }
+
+  // A compact robot state stands in for a packed RobotState message. Profiled at its size on the wire
+  const uint32_t wireSize = dataSize;
+  if (IsRobotStateDelta(nextData, dataSize))
+  {
+    if (!_robotStateDecoder->Decode(nextData, dataSize))
+    {
+      ++_numRobotStateDeltasDropped;
+      if (_robotStateDecoderInSync)
       {
-        DevLoggingSystem::GetInstance()->LogMessage(message);
+        LOG_WARNING("MessageHandler.ProcessMessages.RobotStateDeltaOutOfSync",
+                    "Dropping robot state deltas until the next keyframe (%u dropped so far)",
+                    _numRobotStateDeltasDropped);
+        _robotStateDecoderInSync = false;
       }
-      #endif
-      Broadcast(std::move(message));
+      return;
     }
+    _robotStateDecoderInSync = true;
+    nextData = _robotStateDecoder->GetMessage();
+    dataSize = _robotStateDecoder->GetMessageSize();
+  }
 
-    #if ANKI_PROFILE_ENGINE_SOCKET_BUFFER_STATS
-    _robotConnectionManager->UpdateSocketBufferStats();
-    #endif
+  // see if message type should be filtered out based on potential firmware mismatch
+  const RobotInterface::RobotToEngineTag msgType = static_cast<RobotInterface::RobotToEngineTag>(nextData[0]);
+  if (_robotManager->ShouldFilterMessage(msgType)) {
+    return;
+  }
+
+  // Unpacked straight into the object the event hands to subscribers. Subscribers may keep the event (and with
+  // it the message) past the broadcast, so the object is only reused if none did
+  if (!_unpackedMessage || (_unpackedMessage.use_count() > 1)) {
+    _unpackedMessage = std::make_shared<RobotInterface::RobotToEngine>();
+    ++_numUnpackedMessageAllocations;
+  }
+  RobotInterface::RobotToEngine& message = *_unpackedMessage;
+  const auto unpackStart = std::chrono::steady_clock::now();
+  const size_t unpackSize = message.Unpack(nextData, dataSize);
+  const auto unpackTime = std::chrono::steady_clock::now() - unpackStart;
+  if (unpackSize != dataSize) {
+    PRINT_NAMED_ERROR("RobotMessageHandler.MessageUnpack", "Message unpack error, tag %s expecting %zu but have %u",
+                      RobotToEngineTagToString(msgType), unpackSize, dataSize);
+    return;
+  }
 
+  #if ANKI_DEV_CHEATS
+  if (nullptr != DevLoggingSystem::GetInstance())
+  {
+    DevLoggingSystem::GetInstance()->LogMessage(message);
   }
+  #endif
+  auto& msgProfiler = GetRobotToEngineProfiler();
+  msgProfiler.Update((int)msgType, wireSize, std::chrono::duration_cast<std::chrono::microseconds>(unpackTime).count());
+  Util::MessageProfiler::ScopedHandlerTimer handlerTimer(msgProfiler, (int)msgType);
+  Broadcast(_unpackedMessage);
+}
 
-  return RESULT_OK;
+void MessageHandler::StartReplay()
+{
+  _isReplaying = true;
+  _replayedMessages.clear();
+}
+
+void MessageHandler::QueueReplayedMessage(const std::vector<uint8_t>& data)
+{
+  DEV_ASSERT(_isReplaying, "MessageHandler.QueueReplayedMessage.NotReplaying");
+  _replayedMessages.push_back(data);
 }
 
 Result MessageHandler::SendMessage(const RobotInterface::EngineToRobot& msg, bool reliable, bool hot)
 {
   ++_messageCountEngineToRobot;
 
+  // Nothing is listening on a replay, but the robot code should carry on as if it was
+  if (_isReplaying)
+  {
+    return RESULT_OK;
+  }
+
   if (!_isInitialized || !_robotConnectionManager->IsValidConnection())
   {
     return RESULT_FAIL;
@@ -173,6 +289,19 @@ Result MessageHandler::SendMessage(const RobotInterface::EngineToRobot& msg, boo
   return RESULT_OK;
 }
 
+Result MessageHandler::FlushMessages()
+{
+  static_assert(static_cast<uint8_t>(RobotInterface::EngineToRobotTag::INVALID) == kEngineAnimBatchMarker,
+                "A batch of messages must not be mistaken for a single message");
+
+  if (!_isInitialized || _isReplaying)
+  {
+    return RESULT_OK;
+  }
+
+  return _robotConnectionManager->FlushSendBatch() ? RESULT_OK : RESULT_FAIL;
+}
+
 void MessageHandler::Broadcast(const RobotInterface::RobotToEngine& message)
 {
   ANKI_CPU_PROFILE("Broadcast_R2E");
@@ -181,6 +310,14 @@ void MessageHandler::Broadcast(const RobotInterface::RobotToEngine& message)
   _eventMgr.Broadcast(AnkiEvent<RobotInterface::RobotToEngine>(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message));
 }
 
+void MessageHandler::Broadcast(const std::shared_ptr<RobotInterface::RobotToEngine>& message)
+{
+  ANKI_CPU_PROFILE("Broadcast_R2E");
+
+  u32 type = static_cast<u32>(message->GetTag());
+  _eventMgr.Broadcast(AnkiEvent<RobotInterface::RobotToEngine>(BaseStationTimer::getInstance()->GetCurrentTimeInSeconds(), type, message));
+}
+
 void MessageHandler::Broadcast(RobotInterface::RobotToEngine&& message)
 {
   ANKI_CPU_PROFILE("Broadcast_R2E");
@@ -209,6 +346,11 @@ const Util::Stats::StatsAccumulator& MessageHandler::GetQueuedTimes_ms() const
   return _robotConnectionManager->GetQueuedTimes_ms();
 }
 
+const RobotMessageBufferPool* MessageHandler::GetMessageBufferPool() const
+{
+  return _robotConnectionManager ? &_robotConnectionManager->GetMessageBufferPool() : nullptr;
+}
+
 } // end namespace RobotInterface
 } // end namespace Vector
 } // end namespace Anki
@@ -19,6 +19,7 @@
 #include "clad/robotInterface/messageRobotToEngine.h"
 #include "util/signals/simpleSignal_fwd.h"
 #include <memory>
+#include <vector>
 
 namespace Json {
   class Value;
@@ -43,6 +44,8 @@ namespace Vector {
 class RobotManager;
 class CozmoContext;
 class RobotConnectionManager;
+class RobotMessageBufferPool;
+class RobotStateDeltaDecoder;
 
 namespace RobotInterface {
 
@@ -56,8 +59,18 @@ public:
 
   virtual Result ProcessMessages();
 
+  // Receives whatever has arrived from the robot so far, to be handled by the next ProcessMessages(). Returns true if
+  // any of it is an event the engine should react to without waiting out the tick, such as a cliff
+  bool ReceiveArrivedMessages();
+
+  // The socket messages from the robot arrive on, or -1 if there is none (or messages are being replayed)
+  int GetRobotSocket() const;
+
   virtual Result SendMessage(const RobotInterface::EngineToRobot& msg, bool reliable = true, bool hot = false);
 
+  // Sends the messages batched up by SendMessage() since the last call. Called at the end of each engine tick
+  virtual Result FlushMessages();
+
   Signal::SmartHandle Subscribe(const RobotInterface::RobotToEngineTag& tagType, std::function<void(const AnkiEvent<RobotInterface::RobotToEngine>&)> messageHandler) {
     return _eventMgr.Subscribe(static_cast<uint32_t>(tagType), messageHandler);
   }
@@ -66,6 +79,14 @@ public:
   template<typename T>
   void HandleMessage(const T& msg);
 
+  // From here on messages from the robot are the ones handed to QueueReplayedMessage() rather than the ones arriving
+  // over the robot connection, and messages to the robot are dropped. Used by the engine replay harness
+  void StartReplay();
+  bool IsReplaying() const { return _isReplaying; }
+
+  // Queues a packed RobotToEngine message (or compact robot state) to be handled on the next ProcessMessages()
+  void QueueReplayedMessage(const std::vector<uint8_t>& data);
+
   // Are we connected to this robot?
   bool IsConnected(RobotID_t robotID);
 
@@ -75,6 +96,11 @@ public:
   
   const Util::Stats::StatsAccumulator& GetQueuedTimes_ms() const;
 
+  // Receive path counters: buffers used for messages from the robot, and how many times a message had to be unpacked
+  // into a newly allocated object because a subscriber kept the previous one. Null before Init()
+  const RobotMessageBufferPool* GetMessageBufferPool() const;
+  uint32_t GetNumUnpackedMessageAllocations() const { return _numUnpackedMessageAllocations; }
+
   uint32_t GetMessageCountRtE() const { return _messageCountRobotToEngine; }
   uint32_t GetMessageCountEtR() const { return _messageCountEngineToRobot; }
   void     ResetMessageCounts() { _messageCountRobotToEngine = 0; _messageCountEngineToRobot = 0; }
@@ -82,8 +108,12 @@ public:
 protected:
   void Broadcast(const RobotInterface::RobotToEngine& message);
   void Broadcast(RobotInterface::RobotToEngine&& message);
+  void Broadcast(const std::shared_ptr<RobotInterface::RobotToEngine>& message);
   
 private:
+  // Turns one datagram from the robot into a message and broadcasts it
+  void HandleRobotData(const uint8_t* data, uint32_t dataSize);
+
   AnkiEventMgr<RobotInterface::RobotToEngine> _eventMgr;
   RobotManager* _robotManager;
   std::unique_ptr<RobotConnectionManager> _robotConnectionManager;
@@ -91,6 +121,18 @@ private:
   std::vector<Signal::SmartHandle> _signalHandles;
   uint32_t _messageCountRobotToEngine = 0;
   uint32_t _messageCountEngineToRobot = 0;
+
+  // Reused for every message from the robot that no subscriber holds on to
+  std::shared_ptr<RobotInterface::RobotToEngine> _unpackedMessage;
+  uint32_t _numUnpackedMessageAllocations = 0;
+
+  // Turns compact RobotState datagrams from the robot back into packed RobotState messages
+  std::unique_ptr<RobotStateDeltaDecoder> _robotStateDecoder;
+  bool _robotStateDecoderInSync = true;
+  uint32_t _numRobotStateDeltasDropped = 0;
+
+  bool _isReplaying = false;
+  std::vector<std::vector<uint8_t>> _replayedMessages;
 };
 
 
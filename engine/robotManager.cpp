@@ -191,7 +191,11 @@ Result RobotManager::UpdateRobot()
 
     if (_robot->HasReceivedRobotState()) {
       _context->GetExternalInterface()->Broadcast(ExternalInterface::MessageEngineToGame(_robot->GetRobotState()));
-      _context->GetGatewayInterface()->Broadcast(ExternalMessageRouter::Wrap(_robot->GenerateRobotStateProto()));
+      auto* gatewayInterface = _context->GetGatewayInterface();
+      if (gatewayInterface->IsStreamDue(GatewayCoalescedStream::RobotState)) {
+        gatewayInterface->BroadcastCoalesced(GatewayCoalescedStream::RobotState,
+                                             ExternalMessageRouter::Wrap(_robot->GenerateRobotStateProto()));
+      }
     }
     else {
       LOG_PERIODIC_INFO(10, "RobotManager.UpdateRobot",
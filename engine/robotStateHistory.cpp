@@ -15,6 +15,8 @@
 #include "util/logging/logging.h"
 #include "util/math/math.h"
 
+#include <algorithm>
+
 #define LOG_CHANNEL "RobotStateHistory"
 
 #define DEBUG_ROBOT_POSE_HISTORY 0
@@ -22,56 +24,34 @@
 namespace Anki {
   namespace Vector {
 
-    //////////////////////// HistRobotState /////////////////////////
+    //////////////////////// HistRobotStateBase /////////////////////////
     
-    HistRobotState::HistRobotState()
+    HistRobotStateBase::HistRobotStateBase()
     : _state(Robot::GetDefaultRobotState())
     {
 
     }
     
-
-    HistRobotState::HistRobotState(const Pose3d& pose,
-                                   const RobotState& state,
-                                   const ProxSensorData& proxData)
+    HistRobotStateBase::HistRobotStateBase(const RobotState& state,
+                                           const ProxSensorData& proxData)
     {
-      _pose  = pose;
       _state = state;
       _proxData = proxData;
       _cliffDetectedFlags.SetFlags(state.cliffDetectedFlags);
     }
     
-    void HistRobotState::SetPose(const PoseFrameID_t frameID, const Pose3d& pose,
-                                 const f32 headAngle_rad, const f32 liftAngle_rad)
-    {
-      _pose = pose;
-      _state.pose_frame_id = frameID;
-      _state.headAngle = headAngle_rad;
-      _state.liftAngle = liftAngle_rad;
-    }
-    
-    void HistRobotState::SetPoseParent(const Pose3d& newParent)
-    {
-      _pose.SetParent(newParent);
-    }
-    
-    void HistRobotState::ClearPoseParent()
-    {
-      _pose.ClearParent();
-    }
-    
-    const f32 HistRobotState::GetLiftHeight_mm() const
+    const f32 HistRobotStateBase::GetLiftHeight_mm() const
     {
       return ConvertLiftAngleToLiftHeightMM(_state.liftAngle);
     }
     
-    const u16 HistRobotState::GetCliffData(CliffSensor sensor) const
+    const u16 HistRobotStateBase::GetCliffData(CliffSensor sensor) const
     {
       DEV_ASSERT(sensor < CliffSensor::CLIFF_COUNT, "HistRobotState.GetCliffData.InvalidIndex");
       return _state.cliffDataRaw[Util::EnumToUnderlying(sensor)];
     }
     
-    void HistRobotState::Print() const
+    void HistRobotStateBase::PrintState() const
     {
       printf("Frame %d, headAng %f, cliff %d %d %d %d, carrying %s, moving %s, whichMoving [%s%s%s]",
              GetFrameId(), GetHeadAngle_rad(),
@@ -84,15 +64,61 @@ namespace Anki {
              WasHeadMoving()     ? "H" : "",
              WasLiftMoving()     ? "L" : "",            
              WereWheelsMoving()  ? "B" : "");
-      _pose.Print();
     }
     
-    bool HistRobotState::WasCliffDetected(CliffSensor sensor) const
+    bool HistRobotStateBase::WasCliffDetected(CliffSensor sensor) const
     {
       DEV_ASSERT(sensor < CliffSensor::CLIFF_COUNT, "HistRobotState.WasCliffDetected.InvalidIndex");
       return _cliffDetectedFlags.IsBitFlagSet(sensor);
     }
     
+    //////////////////////// HistRobotState /////////////////////////
+    
+    HistRobotState::HistRobotState()
+    {
+
+    }
+    
+
+    HistRobotState::HistRobotState(const Pose3d& pose,
+                                   const RobotState& state,
+                                   const ProxSensorData& proxData)
+    : HistRobotStateBase(state, proxData)
+    {
+      _pose  = pose;
+    }
+    
+    HistRobotState::HistRobotState(const HistRobotStateBase& other, const Pose3d& pose)
+    : HistRobotStateBase(other)
+    {
+      _pose = pose;
+    }
+    
+    void HistRobotState::SetPose(const PoseFrameID_t frameID, const Pose3d& pose,
+                                 const f32 headAngle_rad, const f32 liftAngle_rad)
+    {
+      _pose = pose;
+      _state.pose_frame_id = frameID;
+      _state.headAngle = headAngle_rad;
+      _state.liftAngle = liftAngle_rad;
+    }
+    
+    void HistRobotState::SetPoseParent(const Pose3d& newParent)
+    {
+      _pose.SetParent(newParent);
+    }
+    
+    void HistRobotState::ClearPoseParent()
+    {
+      _pose.ClearParent();
+    }
+    
+    void HistRobotState::Print() const
+    {
+      PrintState();
+      _pose.Print();
+    }
+    
     HistRobotState HistRobotState::Interpolate(const HistRobotState& histState1, const HistRobotState& histState2,
                                                const Pose3d& pose2wrtPose1, f32 fraction)
     {
@@ -168,12 +194,111 @@ namespace Anki {
       return interpHistState;
     }
     
+    //////////////////////// StoredHistRobotState /////////////////////////
+    
+    StoredHistRobotState::StoredHistRobotState(const HistRobotState& state, const u8 anchorIndex)
+    : HistRobotStateBase(state)
+    , _pose(PoseSnapshot::FromFlattenedPose(state.GetPose()))
+    , _anchorIndex(anchorIndex)
+    {
+      
+    }
+    
+    /////////////////////// HistStateBuffer /////////////////////////////
+    
+    void HistStateBuffer::SetCapacity(size_t capacity)
+    {
+      if (capacity == _buffer.capacity()) {
+        return;
+      }
+      
+      Container_t newBuffer(capacity);
+      const size_t numToKeep = std::min(capacity, _buffer.size());
+      for (size_t i = _buffer.size() - numToKeep; i < _buffer.size(); ++i) {
+        newBuffer.push_back(_buffer[i]);
+      }
+      _buffer = std::move(newBuffer);
+    }
+    
+    HistStateBuffer::iterator HistStateBuffer::lower_bound(const RobotTimeStamp_t t)
+    {
+      return std::lower_bound(begin(), end(), t, [](const value_type& entry, const RobotTimeStamp_t time) {
+        return entry.first < time;
+      });
+    }
+    
+    HistStateBuffer::const_iterator HistStateBuffer::lower_bound(const RobotTimeStamp_t t) const
+    {
+      return std::lower_bound(begin(), end(), t, [](const value_type& entry, const RobotTimeStamp_t time) {
+        return entry.first < time;
+      });
+    }
+    
+    HistStateBuffer::iterator HistStateBuffer::find(const RobotTimeStamp_t t)
+    {
+      const iterator it = lower_bound(t);
+      return ((it != end()) && (it->first == t)) ? it : end();
+    }
+    
+    HistStateBuffer::const_iterator HistStateBuffer::find(const RobotTimeStamp_t t) const
+    {
+      const const_iterator it = lower_bound(t);
+      return ((it != end()) && (it->first == t)) ? it : end();
+    }
+    
+    std::pair<HistStateBuffer::iterator, bool> HistStateBuffer::emplace(const RobotTimeStamp_t t,
+                                                                        const StoredHistRobotState& state)
+    {
+      const iterator it = lower_bound(t);
+      if ((it != end()) && (it->first == t)) {
+        return {end(), false};
+      }
+      
+      size_t index = it.GetIndex();
+      if (_buffer.size() == _buffer.capacity()) {
+        if (index == 0) {
+          // Older than everything there is room for
+          return {end(), false};
+        }
+        _buffer.pop_front();
+        --index;
+      }
+      
+      // States nearly always arrive in order, so this usually moves nothing
+      _buffer.push_back();
+      for (size_t i = _buffer.size() - 1; i > index; --i) {
+        _buffer[i] = _buffer[i-1];
+      }
+      _buffer[index].first = t;
+      _buffer[index].second = state;
+      
+      return {iterator(&_buffer, index), true};
+    }
+    
+    void HistStateBuffer::EraseBefore(const RobotTimeStamp_t t)
+    {
+      const size_t numToErase = lower_bound(t).GetIndex();
+      if (numToErase > 0) {
+        _buffer.pop_front(numToErase);
+      }
+    }
+    
     /////////////////////// RobotStateHistory /////////////////////////////
     
     HistStateKey RobotStateHistory::currHistStateKey_ = 0;
     
+    namespace {
+      // Raw and vision-based states held for a window: no more than one per robot tick
+      size_t GetStateCapacity(const u32 windowSize_ms)
+      {
+        return (windowSize_ms / ROBOT_TIME_STEP_MS) + 1;
+      }
+    }
+    
     RobotStateHistory::RobotStateHistory()
     : IDependencyManagedComponent(this, RobotComponentID::StateHistory)
+    , _states(GetStateCapacity(3000))
+    , _visStates(GetStateCapacity(3000))
     , _windowSize_ms(3000)
     {
 
@@ -185,18 +310,119 @@ namespace Anki {
     
       _states.clear();
       _visStates.clear();
-      _computedStates.clear();
-      
-      _tsByKeyMap.clear();
-      _keyByTsMap.clear();
+      for (auto& computedState : _computedStates) {
+        computedState.key = 0;
+      }
+      for (auto& anchor : _anchors) {
+        anchor.ClearParent();
+      }
     }
     
     void RobotStateHistory::SetTimeWindow(const u32 _windowSize_msms)
     {
       _windowSize_ms = _windowSize_msms;
+      _states.SetCapacity(GetStateCapacity(_windowSize_ms));
+      _visStates.SetCapacity(GetStateCapacity(_windowSize_ms));
       CullToWindowSize();
     }
     
+    size_t RobotStateHistory::GetNumComputedStates() const
+    {
+      return std::count_if(_computedStates.begin(), _computedStates.end(),
+                           [](const ComputedState& computedState) { return computedState.key != 0; });
+    }
+    
+    const RobotStateHistory::ComputedState* RobotStateHistory::FindComputedState(const RobotTimeStamp_t t) const
+    {
+      for (const auto& computedState : _computedStates) {
+        if ((computedState.key != 0) && (computedState.t == t)) {
+          return &computedState;
+        }
+      }
+      return nullptr;
+    }
+    
+    RobotStateHistory::ComputedState* RobotStateHistory::FindComputedState(const RobotTimeStamp_t t)
+    {
+      return const_cast<ComputedState*>(static_cast<const RobotStateHistory*>(this)->FindComputedState(t));
+    }
+    
+    
+    Result RobotStateHistory::Store(const HistRobotState& state, StoredHistRobotState& stored)
+    {
+      const u8 anchorIndex = GetAnchorIndex(state.GetPose());
+      if (state.GetPose().HasParent() && (anchorIndex == StoredHistRobotState::kNoAnchor)) {
+        LOG_ERROR("RobotStateHistory.Store.NoFreeAnchor",
+                  "All %zu origin anchors are in use, cannot store pose w.r.t. %s",
+                  kMaxAnchors, state.GetPose().FindRoot().GetName().c_str());
+        return RESULT_FAIL;
+      }
+      
+      stored = StoredHistRobotState(state, anchorIndex);
+      return RESULT_OK;
+    }
+    
+    HistRobotState RobotStateHistory::Restore(const StoredHistRobotState& stored) const
+    {
+      return HistRobotState(stored, GetPose(stored));
+    }
+    
+    Pose3d RobotStateHistory::GetPose(const StoredHistRobotState& state) const
+    {
+      const u8 anchorIndex = state.GetAnchorIndex();
+      if (anchorIndex == StoredHistRobotState::kNoAnchor) {
+        return state.GetPoseSnapshot().ToPose3d();
+      }
+      
+      DEV_ASSERT(anchorIndex < kMaxAnchors, "RobotStateHistory.GetPose.InvalidAnchor");
+      return state.GetPoseSnapshot().ToPose3d(_anchors[anchorIndex].GetParent());
+    }
+    
+    u8 RobotStateHistory::GetAnchorIndex(const Pose3d& pose)
+    {
+      if (!pose.HasParent()) {
+        return StoredHistRobotState::kNoAnchor;
+      }
+      
+      for (u8 i = 0; i < kMaxAnchors; ++i) {
+        if (_anchors[i].HasParent() && _anchors[i].HasSameParentAs(pose)) {
+          return i;
+        }
+      }
+      
+      // A new origin: use a free anchor for it
+      auto isFree = [](const Pose3d& anchor) { return !anchor.HasParent(); };
+      auto anchorIter = std::find_if(_anchors.begin(), _anchors.end(), isFree);
+      if (anchorIter == _anchors.end()) {
+        ReleaseUnusedAnchors();
+        anchorIter = std::find_if(_anchors.begin(), _anchors.end(), isFree);
+        if (anchorIter == _anchors.end()) {
+          return StoredHistRobotState::kNoAnchor;
+        }
+      }
+      
+      anchorIter->SetParent(pose.GetParent());
+      return static_cast<u8>(anchorIter - _anchors.begin());
+    }
+    
+    void RobotStateHistory::ReleaseUnusedAnchors()
+    {
+      std::array<bool, kMaxAnchors> isUsed{};
+      for (const StateBuffer_t* buffer : {&_states, &_visStates}) {
+        for (const auto& entry : *buffer) {
+          const u8 anchorIndex = entry.second.GetAnchorIndex();
+          if (anchorIndex != StoredHistRobotState::kNoAnchor) {
+            isUsed[anchorIndex] = true;
+          }
+        }
+      }
+      
+      for (size_t i = 0; i < kMaxAnchors; ++i) {
+        if (!isUsed[i] && _anchors[i].HasParent()) {
+          _anchors[i].ClearParent();
+        }
+      }
+    }
     
     Result RobotStateHistory::AddRawOdomState(const RobotTimeStamp_t t,
                                               const HistRobotState& state)
@@ -218,8 +444,13 @@ namespace Anki {
         return RESULT_FAIL;
       }
       
+      StoredHistRobotState stored;
+      if (RESULT_OK != Store(state, stored)) {
+        return RESULT_FAIL;
+      }
+      
       std::pair<StateMapIter_t, bool> res;
-      res = _states.emplace(t, state);
+      res = _states.emplace(t, stored);
 
       if (!res.second) {
         LOG_WARNING("RobotStateHistory.AddRawOdomState.AddFailed", "Time: %u", (TimeStamp_t)t);
@@ -252,12 +483,17 @@ namespace Anki {
         }
       }
       
+      StoredHistRobotState stored;
+      if (RESULT_OK != Store(state, stored)) {
+        return RESULT_FAIL;
+      }
+      
       // If visPose entry exist at t, then overwrite it
       StateMapIter_t it = _visStates.find(t);
       if (it != _visStates.end()) {
         const u32 oldFrameId = it->second.GetFrameId();
         
-        it->second = state;
+        it->second = stored;
         
         if (ANKI_DEV_CHEATS)
         {
@@ -297,7 +533,7 @@ namespace Anki {
       } else {
       
         std::pair<StateMapIter_t, bool> res;
-        res = _visStates.emplace(t, state);
+        res = _visStates.emplace(t, stored);
       
         if (!res.second) {
           LOG_ERROR("RobotStateHistory.AddVisionOnlyState.EmplaceFailed",
@@ -331,7 +567,7 @@ namespace Anki {
       --prev_it;
       
       t_before = prev_it->first;
-      state_before = prev_it->second;
+      state_before = Restore(prev_it->second);
       
       // Get iterator to pose just after t
       const_StateMapIter_t next_it = it;
@@ -342,7 +578,7 @@ namespace Anki {
       }
       
       t_after = next_it->first;
-      state_after = next_it->second;
+      state_after = Restore(next_it->second);
       
       return RESULT_OK;
     }
@@ -366,7 +602,7 @@ namespace Anki {
       if (t_request == it->first) {
         // If the exact timestamp was found, return the corresponding pose.
         t = it->first;
-        state = it->second;
+        state = Restore(it->second);
       } else {
 
         // Get iterator to the pose just before t_request
@@ -394,32 +630,34 @@ namespace Anki {
           // Get the pose transform between the two poses.
           // We don't need to check return value (bool) here because we've effectively
           // checked it already in the call to HasSameRootAs above
+          const HistRobotState prevState = Restore(prev_it->second);
+          const HistRobotState nextState = Restore(it->second);
           Pose3d pTransform;
-          inSameOrigin = it->second.GetPose().GetWithRespectTo(prev_it->second.GetPose(), pTransform);
+          inSameOrigin = nextState.GetPose().GetWithRespectTo(prevState.GetPose(), pTransform);
 
           if (inSameOrigin)
           {
             // Compute scale factor between time to previous pose and time between previous pose and next pose.
             const f32 timeScale = (f32)(t_request - prev_it->first) / TimeStamp_t(it->first - prev_it->first);
 
-            state = HistRobotState::Interpolate(prev_it->second, it->second, pTransform, timeScale);
+            state = HistRobotState::Interpolate(prevState, nextState, pTransform, timeScale);
 
             t = t_request;
           }
         }
         else
         {
-          inSameOrigin = it->second.GetPose().HasSameRootAs(prev_it->second.GetPose());
+          inSameOrigin = it->second.HasSameOriginAs(prev_it->second);
           
           if (inSameOrigin)
           {
             // Return the pose closest to the requested time
             if (it->first - t_request < t_request - prev_it->first) {
               t = it->first;
-              state = it->second;
+              state = Restore(it->second);
             } else {
               t = prev_it->first;
-              state = prev_it->second;
+              state = Restore(prev_it->second);
             }
           }
         }
@@ -429,8 +667,8 @@ namespace Anki {
           LOG_INFO("RobotStateHistory.GetRawStateAt.MisMatchedOrigins",
                    "Cannot interpolate at t=%u as requested because the two poses don't share the same origin: prev=%s vs next=%s",
                    (TimeStamp_t)t_request,
-                   prev_it->second.GetPose().FindRoot().GetName().c_str(),
-                   it->second.GetPose().FindRoot().GetName().c_str());
+                   GetPose(prev_it->second).FindRoot().GetName().c_str(),
+                   GetPose(it->second).FindRoot().GetName().c_str());
 
           // they asked us for a t_request that is between two origins. We can't interpolate or decide which origin is
           // "right" for you, so, we are going to fail
@@ -448,17 +686,17 @@ namespace Anki {
         return RESULT_FAIL;
       }
       
-      HistRobotState& state = it->second;
+      StoredHistRobotState& state = it->second;
       state.SetProxSensorData(data);
 
       return RESULT_OK;
     }
 
-    Result RobotStateHistory::GetVisionOnlyStateAt(const RobotTimeStamp_t t_request, HistRobotState** state)
+    Result RobotStateHistory::GetVisionOnlyStateAt(const RobotTimeStamp_t t_request, HistRobotState& state) const
     {
-      StateMapIter_t it = _visStates.find(t_request);
+      const_StateMapIter_t it = _visStates.find(t_request);
       if (it != _visStates.end()) {
-        *state = &(it->second);
+        state = Restore(it->second);
         return RESULT_OK;
       }
       return RESULT_FAIL;
@@ -473,7 +711,7 @@ namespace Anki {
       const_StateMapIter_t it = _visStates.find(t_request);
       if (it != _visStates.end()) {
         t = t_request;
-        state = it->second;
+        state = Restore(it->second);
         return RESULT_OK;
       }
       
@@ -521,7 +759,7 @@ namespace Anki {
       static bool printDbg = false;
       if(printDbg) {
         printf("gt: %d\n", git->first);
-        git->second.GetPose().Print();
+        GetPose(git->second).Print();
       }
       #endif
       
@@ -532,7 +770,7 @@ namespace Anki {
       #if (DEBUG_ROBOT_POSE_HISTORY)
       if (printDbg) {
         printf("p0_it: t: %d  frame: %d\n", p0_it->first, p0_it->second.GetFrameId());
-        p0_it->second.GetPose().Print();
+        GetPose(p0_it->second).Print();
       
         printf("p1: t: %d  frame: %d\n", t, p1.GetFrameId());
         p1.GetPose().Print();
@@ -547,10 +785,10 @@ namespace Anki {
       {
         // Special case: no intermediate frames to chain through. The total transformation
         // is just going from p0 to p1.
-        Pose3d p1_wrt_p0_parent;
-        const bool inSameOrigin = state1.GetPose().GetWithRespectTo(p0_it->second.GetPose().GetParent(), pTransform);
+        const Pose3d p0 = GetPose(p0_it->second);
+        const bool inSameOrigin = state1.GetPose().GetWithRespectTo(p0.GetParent(), pTransform);
         DEV_ASSERT(inSameOrigin, "RobotStateHistory.ComputeStateAt.FailedGetWRT1");
-        pTransform *= p0_it->second.GetPose().GetInverse();
+        pTransform *= p0.GetInverse();
       }
       else
       {
@@ -571,18 +809,19 @@ namespace Anki {
             --pMid1; // (temporarily) move back to last pose in same frame as pMid0
             DEV_ASSERT(pMid0->second.GetFrameId() == pMid1->second.GetFrameId(),
                        "RobotStateHistory.ComputeStateAt.MismatchedIntermediateFrameIDs");
-            DEV_ASSERT(pMid0->second.GetPose().HasSameRootAs(pMid1->second.GetPose()),
+            DEV_ASSERT(pMid0->second.HasSameOriginAs(pMid1->second),
                        "RobotStateHistory.ComputeStateAt.MismatchedIntermediateOrigins");
 
             // Get pMid0 and pMid1 w.r.t. the same parent and store in the intermediate
             // transformation pMidTransform, which is going to hold the transformation
             // from pMid0 to pMid1
+            const Pose3d pMid0Pose = GetPose(pMid0->second);
             Pose3d pMidTransform;
-            const bool inSameOrigin = pMid1->second.GetPose().GetWithRespectTo(pMid0->second.GetPose().GetParent(), pMidTransform);
+            const bool inSameOrigin = GetPose(pMid1->second).GetWithRespectTo(pMid0Pose.GetParent(), pMidTransform);
             DEV_ASSERT(inSameOrigin, "RobotStateHistory.ComputeStateAt.FailedGetWRT2");
             
             // pMidTransform = pMid1 * pMid0^(-1)
-            pMidTransform *= pMid0->second.GetPose().GetInverse();
+            pMidTransform *= pMid0Pose.GetInverse();
             
             // Fold the transformation from pMid0 to pMid1 into the total transformation thus far
             //  pTranform = pMidTransform * pTransform
@@ -610,8 +849,9 @@ namespace Anki {
       
       // NOTE: We are about to return p, which is a transformed version of the vision-only
       // pose in "git", so it should still be relative to whatever "git" was relative to.
-      pTransform *= git->second.GetPose(); // Apply pTransform to git and store in pTransform
-      pTransform.SetParent(git->second.GetPose().GetParent()); // Keep git's parent
+      const Pose3d visPose = GetPose(git->second);
+      pTransform *= visPose; // Apply pTransform to git and store in pTransform
+      pTransform.SetParent(visPose.GetParent()); // Keep git's parent
       state.SetPose(state1.GetFrameId(), pTransform, state1.GetHeadAngle_rad(), state1.GetLiftAngle_rad());
       
       return RESULT_OK;
@@ -631,39 +871,40 @@ namespace Anki {
       }
       
       // If computedPose entry exist at t, then overwrite it
-      StateMapIter_t it = _computedStates.find(t);
-      if (it != _computedStates.end()) {
-        it->second = state_computed;
-        *state = &(it->second);
-        
-        if (key) {
-          *key = _keyByTsMap[t];
+      ComputedState* computedState = FindComputedState(t);
+      if (computedState == nullptr) {
+        // Take an unused slot, or else the oldest one
+        computedState = &_computedStates[0];
+        for (auto& slot : _computedStates) {
+          if (slot.key == 0) {
+            computedState = &slot;
+            break;
+          }
+          if (slot.t < computedState->t) {
+            computedState = &slot;
+          }
         }
-      } else {
-        
-        std::pair<StateMapIter_t, bool> res;
-        res = _computedStates.emplace(t, state_computed);
-        
-        if (!res.second) {
-          return RESULT_FAIL;
+        if (computedState->key != 0) {
+          LOG_DEBUG("RobotStateHistory.ComputeAndInsertStateAt.DroppingOldest",
+                    "All %zu computed states in use, dropping t=%u",
+                    kMaxComputedStates, (TimeStamp_t)computedState->t);
         }
         
-        *state = &(res.first->second);
-        
-        
         // Create key associated with computed pose
         ++currHistStateKey_;
-        _tsByKeyMap.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(currHistStateKey_),
-                            std::forward_as_tuple(t));
-        _keyByTsMap.emplace(std::piecewise_construct,
-                                  std::forward_as_tuple(t),
-                                  std::forward_as_tuple(currHistStateKey_));
-        
-        if (key) {
-          *key = currHistStateKey_;
+        if (currHistStateKey_ == 0) {
+          // 0 marks an unused slot
+          ++currHistStateKey_;
         }
-
+        computedState->t = t;
+        computedState->key = currHistStateKey_;
+      }
+      
+      computedState->state = state_computed;
+      *state = &computedState->state;
+      
+      if (key) {
+        *key = computedState->key;
       }
       
       return RESULT_OK;
@@ -673,18 +914,13 @@ namespace Anki {
                                                  const HistRobotState ** state,
                                                  HistStateKey* key) const
     {
-      const_StateMapIter_t it = _computedStates.find(t_request);
-      if (it != _computedStates.end()) {
-        *state = &(it->second);
+      const ComputedState* computedState = FindComputedState(t_request);
+      if (computedState != nullptr) {
+        *state = &computedState->state;
         
         // Get key for the computed pose
         if (key){
-          const_KeyByTimestampMapIter_t kIt = _keyByTsMap.find(it->first);
-          if (kIt == _keyByTsMap.end()) {
-            LOG_WARNING("RobotStateHistory.GetComputedStateAt.KeyNotFound","");
-            return RESULT_FAIL;
-          }
-          *key = kIt->second;
+          *key = computedState->key;
         }
         
         return RESULT_OK;
@@ -709,7 +945,7 @@ namespace Anki {
     {
       if (!_visStates.empty()) {
         t = _visStates.rbegin()->first;
-        state = _visStates.rbegin()->second;
+        state = Restore(_visStates.rbegin()->second);
         return RESULT_OK;
       }
       
@@ -757,7 +993,7 @@ namespace Anki {
         // Success!
         DEV_ASSERT(poseIter != _states.rend(),
                    "RobotStateHistory.GetLastStateWithFrameID.InvalidIter");
-        state = poseIter->second;
+        state = Restore(poseIter->second);
         return RESULT_OK;
         
       } else {
@@ -813,14 +1049,10 @@ namespace Anki {
         
         // Get pointer to the oldest timestamp that may remain in the map
         RobotTimeStamp_t oldestAllowedTime = mostRecentTime - _windowSize_ms;
-        const auto it = _states.lower_bound(oldestAllowedTime);
-        const auto git = _visStates.lower_bound(oldestAllowedTime);
-        const auto cit = _computedStates.lower_bound(oldestAllowedTime);
-        const auto keyByTs_it = _keyByTsMap.lower_bound(oldestAllowedTime);
         
         // Delete everything before the oldest allowed timestamp
-        if (!_states.empty() && it != _states.begin()) {
-          _states.erase(_states.begin(), it);
+        if (!_states.empty()) {
+          _states.EraseBefore(oldestAllowedTime);
           
           if (_states.empty())
           {
@@ -829,8 +1061,8 @@ namespace Anki {
                       _windowSize_ms);
           }
         }
-        if (!_visStates.empty() &&  git != _visStates.begin()) {
-          _visStates.erase(_visStates.begin(), git);
+        if (!_visStates.empty()) {
+          _visStates.EraseBefore(oldestAllowedTime);
           
           if (_visStates.empty())
           {
@@ -839,22 +1071,17 @@ namespace Anki {
                       _windowSize_ms);
           }
         }
-        if (!_computedStates.empty() && cit != _computedStates.begin()) {
-          _computedStates.erase(_computedStates.begin(), cit);
-        }
-
-        if (!_keyByTsMap.empty() && keyByTs_it != _keyByTsMap.begin()) {
-          if (keyByTs_it != _keyByTsMap.end()) {
-            const auto tsByKey_it = _tsByKeyMap.find(keyByTs_it->second);
-            if (tsByKey_it != _tsByKeyMap.end()) {
-              _tsByKeyMap.erase(_tsByKeyMap.begin(), tsByKey_it);
-            } else {
-              LOG_ERROR("RobotStateHistory.CullToWindowSize.MapsOutOfSync",
-                        "keyByTsMap size: %zu, tsByKeyMap size: %zu",
-                        _keyByTsMap.size(), _tsByKeyMap.size());
-            }
+        for (auto& computedState : _computedStates) {
+          if (computedState.t < oldestAllowedTime) {
+            computedState.key = 0;
           }
-          _keyByTsMap.erase(_keyByTsMap.begin(), keyByTs_it);
+        }
+        
+        // Origins rarely change, so usually the one anchor in use is the newest state's and there is nothing to free
+        const size_t numAnchorsInUse = std::count_if(_anchors.begin(), _anchors.end(),
+                                                     [](const Pose3d& anchor) { return anchor.HasParent(); });
+        if (numAnchorsInUse > 1) {
+          ReleaseUnusedAnchors();
         }
 
       }
@@ -862,7 +1089,15 @@ namespace Anki {
     
     bool RobotStateHistory::IsValidKey(const HistStateKey key) const
     {
-      return (_tsByKeyMap.find(key) != _tsByKeyMap.end());
+      if (key == 0) {
+        return false;
+      }
+      for (const auto& computedState : _computedStates) {
+        if (computedState.key == key) {
+          return true;
+        }
+      }
+      return false;
     }
     
     RobotTimeStamp_t RobotStateHistory::GetOldestTimeStamp() const
@@ -888,34 +1123,34 @@ namespace Anki {
     void RobotStateHistory::Print() const
     {
       // Create merged map of all poses
-      std::multimap<TimeStamp_t, std::pair<std::string, const_StateMapIter_t> > mergedPoses;
-      std::multimap<TimeStamp_t, std::pair<std::string, const_StateMapIter_t> >::iterator mergedIt;
-      const_StateMapIter_t pit;
+      std::multimap<TimeStamp_t, std::pair<std::string, HistRobotState> > mergedPoses;
       
-      for (pit = _states.begin(); pit != _states.end(); ++pit) {
+      for (const auto& entry : _states) {
         mergedPoses.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("  ", pit));
+                            std::forward_as_tuple(entry.first),
+                            std::forward_as_tuple("  ", Restore(entry.second)));
       }
 
-      for (pit = _visStates.begin(); pit != _visStates.end(); ++pit) {
+      for (const auto& entry : _visStates) {
         mergedPoses.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("v ", pit));
+                            std::forward_as_tuple(entry.first),
+                            std::forward_as_tuple("v ", Restore(entry.second)));
       }
 
-      for (pit = _computedStates.begin(); pit != _computedStates.end(); ++pit) {
-        mergedPoses.emplace(std::piecewise_construct,
-                            std::forward_as_tuple(pit->first),
-                            std::forward_as_tuple("c ", pit));
+      for (const auto& computedState : _computedStates) {
+        if (computedState.key != 0) {
+          mergedPoses.emplace(std::piecewise_construct,
+                              std::forward_as_tuple(computedState.t),
+                              std::forward_as_tuple("c ", computedState.state));
+        }
       }
       
       
       printf("\nRobotStateHistory\n");
       printf("================\n");
-      for (mergedIt = mergedPoses.begin(); mergedIt != mergedPoses.end(); ++mergedIt) {
-        printf("%s%d: ", mergedIt->second.first.c_str(), mergedIt->first);
-        mergedIt->second.second->second.Print();
+      for (const auto& mergedPose : mergedPoses) {
+        printf("%s%d: ", mergedPose.second.first.c_str(), mergedPose.first);
+        mergedPose.second.second.Print();
       }
     }
     
@@ -11,44 +11,40 @@
 
 #include "coretech/common/shared/types.h"
 #include "coretech/common/engine/math/pose.h"
+#include "coretech/common/engine/math/poseSnapshot.h"
 #include "coretech/common/engine/robotTimeStamp.h"
 #include "coretech/vision/engine/camera.h"
 #include "clad/types/robotStatusAndActions.h"
 
 #include "util/bitFlags/bitFlags.h"
+#include "util/container/circularBuffer.h"
 #include "util/entityComponent/iDependencyManagedComponent.h"
 #include "engine/components/sensors/proxSensorComponent.h"
 #include "engine/robotComponents_fwd.h"
 #include "util/helpers/templateHelpers.h"
 
+#include <array>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
 namespace Anki {
   namespace Vector {
     
     /*
-     * HistRobotState
+     * HistRobotStateBase
      *
-     * Snapshot of robot pose/state, stored in RobotStateHistory
+     * Everything in a snapshot of robot state except the robot's pose, which HistRobotState keeps as a full Pose3d
+     * and StoredHistRobotState as a PoseSnapshot
      */
-    class HistRobotState
+    class HistRobotStateBase
     {
     public:
-      HistRobotState();
-      
-      HistRobotState(const Pose3d& pose,
-                     const RobotState& state,
-                     const ProxSensorData& proxData);
-      
-      HistRobotState(const HistRobotState& other) = default;
-      
-      HistRobotState& operator=(const HistRobotState& other) = default;
-
-      // Only update pose-related information: includes pose frame ID, body pose in the world, and head/lift angles
-      void SetPose(const PoseFrameID_t frameID, const Pose3d& pose, const f32 headAngle_rad, const f32 liftAngle_rad);
+      HistRobotStateBase();
       
-      void SetPoseParent(const Pose3d& newParent);
-      void ClearPoseParent();
+      HistRobotStateBase(const RobotState& state,
+                         const ProxSensorData& proxData);
       
-      const Pose3d&       GetPose()                        const {return _pose;               }
       const f32           GetHeadAngle_rad()               const {return _state.headAngle;    }
       const f32           GetLiftAngle_rad()               const {return _state.liftAngle;    }
       const f32           GetLiftHeight_mm()               const;
@@ -77,7 +73,47 @@ namespace Anki {
       bool WasPickedUp()       const { return  (_state.status & Util::EnumToUnderlying(RobotStatusFlag::IS_PICKED_UP)); }
       bool WasCameraMoving()   const { return  (WasHeadMoving() || WereWheelsMoving()); }
       bool WasCliffDetected(CliffSensor sensor) const;
+      
+    protected:
+      
+      // Prints everything but the pose
+      void PrintState() const;
+      
+      // Note that the _state.pose is not guaranteed to match the robot pose kept by derived classes (COZMO-10225)
+      RobotState                   _state;
+      
+      ProxSensorData               _proxData;
+      Util::BitFlags8<CliffSensor> _cliffDetectedFlags;
+    };
+    
+    /*
+     * HistRobotState
+     *
+     * Snapshot of robot pose/state, as added to and retrieved from RobotStateHistory
+     */
+    class HistRobotState : public HistRobotStateBase
+    {
+    public:
+      HistRobotState();
+      
+      HistRobotState(const Pose3d& pose,
+                     const RobotState& state,
+                     const ProxSensorData& proxData);
+      
+      // The given pose with everything else from other
+      HistRobotState(const HistRobotStateBase& other, const Pose3d& pose);
+      
+      HistRobotState(const HistRobotState& other) = default;
+      
+      HistRobotState& operator=(const HistRobotState& other) = default;
 
+      // Only update pose-related information: includes pose frame ID, body pose in the world, and head/lift angles
+      void SetPose(const PoseFrameID_t frameID, const Pose3d& pose, const f32 headAngle_rad, const f32 liftAngle_rad);
+      
+      void SetPoseParent(const Pose3d& newParent);
+      void ClearPoseParent();
+      
+      const Pose3d&       GetPose()                        const {return _pose;               }
       
       // Returns a new HistRobotState the given fraction between 1 and 2, where fraction is [0,1].
       // Note: always uses histState1's PoseFrameID
@@ -88,18 +124,147 @@ namespace Anki {
       
     private:
       
-      // Note that the _state.pose is not guaranteed to match what's in _pose (COZMO-10225)
       Pose3d                       _pose;  // robot pose
-      RobotState                   _state;
+    };
+    
+    /*
+     * StoredHistRobotState
+     *
+     * How RobotStateHistory holds raw and vision-based states: the same as a HistRobotState, but with the (flattened)
+     * pose as a PoseSnapshot, so holding and copying one allocates nothing. The snapshot's parent is one of
+     * RobotStateHistory's origin anchors, identified by index.
+     */
+    class StoredHistRobotState : public HistRobotStateBase
+    {
+    public:
+      static constexpr u8 kNoAnchor = 0xFF; // the pose had no parent
       
-      ProxSensorData               _proxData;
-      Util::BitFlags8<CliffSensor> _cliffDetectedFlags;
+      StoredHistRobotState() = default;
+      
+      // state's pose must be flattened
+      StoredHistRobotState(const HistRobotState& state, const u8 anchorIndex);
+      
+      const PoseSnapshot& GetPoseSnapshot() const { return _pose; }
+      u8                  GetAnchorIndex()  const { return _anchorIndex; }
+      
+      // True if both poses are w.r.t. the same origin. Like Pose3d::HasSameRootAs, false for two poses with no parent.
+      bool HasSameOriginAs(const StoredHistRobotState& other) const {
+        return (_anchorIndex != kNoAnchor) && (_anchorIndex == other._anchorIndex);
+      }
+      
+    private:
+      
+      PoseSnapshot _pose{};
+      u8           _anchorIndex = kNoAnchor;
     };
     
     // A key associated with each computed pose retrieved from history
     // to be used to check its validity at a later time.
     using HistStateKey = uint32_t;
     
+    /*
+     * HistStateBuffer
+     *
+     * Timestamped StoredHistRobotStates sorted by time in a fixed-capacity circular buffer. Lookups are binary searches,
+     * adding a state newer than all the others and dropping the oldest ones don't move anything, and no memory is
+     * allocated except by SetCapacity(). When full, adding a state drops the oldest one.
+     *
+     * Has the parts of the std::map interface that RobotStateHistory and readers of its raw states use.
+     */
+    class HistStateBuffer
+    {
+    public:
+      
+      using value_type = std::pair<RobotTimeStamp_t, StoredHistRobotState>;
+      
+      template<class ContainerT, class ValueT>
+      class Iterator
+      {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = typename std::remove_const<ValueT>::type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = ValueT*;
+        using reference         = ValueT&;
+        
+        Iterator() = default;
+        Iterator(ContainerT* container, size_t index) : _container(container), _index(index) { }
+        
+        // iterator converts to const_iterator
+        template<class OtherContainerT, class OtherValueT>
+        Iterator(const Iterator<OtherContainerT, OtherValueT>& other)
+        : _container(other.GetContainer()), _index(other.GetIndex()) { }
+        
+        reference operator*()  const { return (*_container)[_index]; }
+        pointer   operator->() const { return &(*_container)[_index]; }
+        
+        Iterator& operator++() { ++_index; return *this; }
+        Iterator& operator--() { --_index; return *this; }
+        Iterator  operator++(int) { Iterator it(*this); ++_index; return it; }
+        Iterator  operator--(int) { Iterator it(*this); --_index; return it; }
+        Iterator& operator+=(difference_type n) { _index += n; return *this; }
+        Iterator& operator-=(difference_type n) { _index -= n; return *this; }
+        Iterator  operator+(difference_type n) const { return Iterator(_container, _index + n); }
+        Iterator  operator-(difference_type n) const { return Iterator(_container, _index - n); }
+        difference_type operator-(const Iterator& other) const { return (difference_type)_index - (difference_type)other._index; }
+        
+        bool operator==(const Iterator& other) const { return (_container == other._container) && (_index == other._index); }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+        bool operator<(const Iterator& other)  const { return _index < other._index; }
+        
+        ContainerT* GetContainer() const { return _container; }
+        size_t      GetIndex()     const { return _index; }
+        
+      private:
+        ContainerT* _container = nullptr;
+        size_t      _index = 0;
+      };
+      
+      using Container_t            = Util::CircularBuffer<value_type>;
+      using iterator               = Iterator<Container_t, value_type>;
+      using const_iterator         = Iterator<const Container_t, const value_type>;
+      using reverse_iterator       = std::reverse_iterator<iterator>;
+      using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+      
+      explicit HistStateBuffer(size_t capacity) : _buffer(capacity) { }
+      
+      // Keeps the newest states that fit
+      void SetCapacity(size_t capacity);
+      
+      size_t size()     const { return _buffer.size();     }
+      size_t capacity() const { return _buffer.capacity(); }
+      bool   empty()    const { return _buffer.empty();    }
+      void   clear()          { _buffer.clear();           }
+      
+      iterator       begin()       { return iterator(&_buffer, 0);                    }
+      iterator       end()         { return iterator(&_buffer, _buffer.size());       }
+      const_iterator begin() const { return const_iterator(&_buffer, 0);              }
+      const_iterator end()   const { return const_iterator(&_buffer, _buffer.size()); }
+      
+      reverse_iterator       rbegin()       { return reverse_iterator(end());         }
+      reverse_iterator       rend()         { return reverse_iterator(begin());       }
+      const_reverse_iterator rbegin() const { return const_reverse_iterator(end());   }
+      const_reverse_iterator rend()   const { return const_reverse_iterator(begin()); }
+      
+      // First state at or after t
+      iterator       lower_bound(const RobotTimeStamp_t t);
+      const_iterator lower_bound(const RobotTimeStamp_t t) const;
+      
+      iterator       find(const RobotTimeStamp_t t);
+      const_iterator find(const RobotTimeStamp_t t) const;
+      
+      // Returns false (and end()) if a state at t already exists, or if the buffer is full and t is older than
+      // everything in it
+      std::pair<iterator, bool> emplace(const RobotTimeStamp_t t, const StoredHistRobotState& state);
+      
+      // Drops every state older than t
+      void EraseBefore(const RobotTimeStamp_t t);
+      
+    private:
+      
+      Container_t _buffer;
+    };
+    
     /*
      * RobotStateHistory
      *
@@ -134,9 +299,14 @@ namespace Anki {
       // Returns the number of states that were added via AddVisionOnlyState() that still remain in history
       size_t GetNumVisionStates() const {return _visStates.size();}
       
+      // Returns the number of states that were added via ComputeAndInsertStateAt() that still remain in history
+      size_t GetNumComputedStates() const;
+      
       // Specify the maximum time span of states that can be held.
       // States that are older than the newest/largest timestamp stored
-      // minus windowSize_ms are automatically removed.
+      // minus windowSize_ms are automatically removed. Sizes the raw and
+      // vision-based buffers to hold a state every ROBOT_TIME_STEP_MS over
+      // the window, so this allocates if the window changes.
       void SetTimeWindow(const u32 windowSize_ms);
       
       // Adds a timestamped state received from the robot to the history.
@@ -176,10 +346,8 @@ namespace Anki {
       //            raw unprocessed states (i.e. RobotState) only.
       Result UpdateProxSensorData(const RobotTimeStamp_t t, const ProxSensorData& data);
       
-      // Returns OK and points statePtr to a vision-based state at the specified time if such a state exists.
-      // Note: The state that statePtr points to may be invalidated by subsequent calls to
-      //       the history like Clear() or Add...(). Use carefully!
-      Result GetVisionOnlyStateAt(const RobotTimeStamp_t t_request, HistRobotState** statePtr);
+      // Returns OK and sets state to the vision-based state at the specified time if such a state exists.
+      Result GetVisionOnlyStateAt(const RobotTimeStamp_t t_request, HistRobotState& state) const;
       
       // Same as above except that it uses the last vision-based
       // state that exists at or before t_request to compute a
@@ -228,38 +396,64 @@ namespace Anki {
       // Prints the entire history
       void Print() const;
       
-      typedef std::map<RobotTimeStamp_t, HistRobotState> StateMap_t;
+      using StateBuffer_t = HistStateBuffer;
+      
+      // Poses of these are PoseSnapshots: use GetPose() below for a Pose3d
+      const StateBuffer_t& GetRawStates() const { return _states; }
       
-      const StateMap_t& GetRawStates() const { return _states; }
+      // The pose of a state from GetRawStates(), w.r.t. its origin
+      Pose3d GetPose(const StoredHistRobotState& state) const;
+      
+      // Computed states held at once. Vision results come in no faster than images, so this
+      // covers every image in the default window; past it, the oldest computed state is dropped
+      static constexpr size_t kMaxComputedStates = 64;
       
     private:
       
       void CullToWindowSize();
       
+      // Converts between the states callers add and get and the ones in _states and _visStates. Storing fails if the
+      // state's pose is w.r.t. a new origin and every anchor is in use.
+      Result         Store(const HistRobotState& state, StoredHistRobotState& stored);
+      HistRobotState Restore(const StoredHistRobotState& stored) const;
+      
+      // Index of the anchor for the pose's origin, assigning a free one if it has none yet. Returns kNoAnchor if the
+      // pose has no parent, or if no anchor is free.
+      u8 GetAnchorIndex(const Pose3d& pose);
+      
+      // Frees the anchors for origins no stored state is w.r.t. anymore
+      void ReleaseUnusedAnchors();
+      
       // Pose history as reported by robot
-      using StateMapIter_t = StateMap_t::iterator;
-      using const_StateMapIter_t = StateMap_t::const_iterator;
-      StateMap_t _states;
+      using StateMapIter_t = StateBuffer_t::iterator;
+      using const_StateMapIter_t = StateBuffer_t::const_iterator;
+      StateBuffer_t _states;
 
-      // Map of timestamps of vision-based poses as computed from mat markers
-      StateMap_t _visStates;
+      // Timestamps of vision-based poses as computed from mat markers
+      StateBuffer_t _visStates;
+      
+      // One identity pose under each origin the poses in _states and _visStates are w.r.t. (an unused anchor has no
+      // parent), so that poses restored from their snapshots can share the actual origin. There are only ever a few
+      // origins in a time window, if more than one.
+      static constexpr size_t kMaxAnchors = 8;
+      std::array<Pose3d, kMaxAnchors> _anchors;
 
-      // Map of poses that were computed with ComputeAt
-      StateMap_t _computedStates;
+      // Poses that were computed with ComputeAndInsertStateAt, in slots that don't move so that pointers to them stay
+      // valid until they are culled. A slot with key 0 is unused
+      struct ComputedState
+      {
+        RobotTimeStamp_t t;
+        HistStateKey     key = 0;
+        HistRobotState   state;
+      };
+      std::array<ComputedState, kMaxComputedStates> _computedStates;
+      
+      const ComputedState* FindComputedState(const RobotTimeStamp_t t) const;
+      ComputedState*       FindComputedState(const RobotTimeStamp_t t);
 
       // The last pose key assigned to a computed pose
       static HistStateKey currHistStateKey_;
       
-      // Map of HistStateKeys to timestamps and vice versa
-      using TimestampByKeyMap_t           = std::map<HistStateKey, RobotTimeStamp_t> ;
-      using TimestampByKeyMapIter_t       = TimestampByKeyMap_t::iterator;
-      using KeyByTimestampMap_t           = std::map<RobotTimeStamp_t, HistStateKey>;
-      using KeyByTimestampMapIter_t       = KeyByTimestampMap_t::iterator;
-      using const_KeyByTimestampMapIter_t = KeyByTimestampMap_t::const_iterator;
-      
-      TimestampByKeyMap_t _tsByKeyMap;
-      KeyByTimestampMap_t _keyByTsMap;
-      
       // Size of history time window (ms)
       u32 _windowSize_ms;
       
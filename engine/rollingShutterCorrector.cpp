@@ -18,14 +18,66 @@
 
 #include "anki/cozmo/shared/factory/emrHelper.h"
 
+#include <cmath>
+#include <cstring>
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
 namespace Anki {
   namespace Vector {
 
     namespace {
       const TimeStamp_t kMaxAllowedDelay_ms = 100; 
+
+      // Shifts one row right by shiftX pixels, interpolating between the two source pixels each output pixel falls
+      // between. Pixels with no source are zero
+      void ShiftRow(const u8* in, u8* out, const s32 numCols, const f32 shiftX)
+      {
+        // Output pixel x comes from source position x - shiftX = (x + offset) + weight/256
+        s32 offset = static_cast<s32>(std::floor(-shiftX));
+        s32 weight = static_cast<s32>(std::round((-shiftX - offset) * 256.f));
+        if(weight == 256)
+        {
+          ++offset;
+          weight = 0;
+        }
+        
+        const s32 lastSourceNeeded = (weight == 0 ? 0 : 1);
+        const s32 xBegin = Util::Clamp(-offset, 0, numCols);
+        const s32 xEnd   = Util::Clamp(numCols - offset - lastSourceNeeded, xBegin, numCols);
+        
+        std::memset(out, 0, xBegin);
+        std::memset(out + xEnd, 0, numCols - xEnd);
+        
+        if(weight == 0)
+        {
+          std::memcpy(out + xBegin, in + xBegin + offset, xEnd - xBegin);
+          return;
+        }
+        
+        s32 x = xBegin;
+#ifdef __ARM_NEON__
+        const uint8x8_t weightLeft  = vdup_n_u8(static_cast<u8>(256 - weight));
+        const uint8x8_t weightRight = vdup_n_u8(static_cast<u8>(weight));
+        for(; x <= xEnd - 8; x += 8)
+        {
+          const u8* src = in + x + offset;
+          uint16x8_t sum = vmull_u8(vld1_u8(src), weightLeft);
+          sum = vmlal_u8(sum, vld1_u8(src + 1), weightRight);
+          vst1_u8(out + x, vrshrn_n_u16(sum, 8));
+        }
+#endif
+        for(; x < xEnd; ++x)
+        {
+          const u8* src = in + x + offset;
+          out[x] = static_cast<u8>((src[0] * (256 - weight) + src[1] * weight + 128) >> 8);
+        }
+      }
     }
 
-    int RollingShutterCorrector::GetNumDivisions() {
+    int RollingShutterCorrector::GetNumDivisions() const {
       if (IsXray()) {
 	      return _rsNumDivisionsXray ;
       } else {
@@ -37,34 +89,53 @@ namespace Anki {
                                                      const VisionPoseData& prevPoseData,
                                                      const u32 numRows)
     {
+      const int numDivisions = GetNumDivisions();
       _pixelShifts.clear();
-      _pixelShifts.reserve(GetNumDivisions());
+      _pixelShifts.reserve(numDivisions);
 
       // Time difference between subdivided rows in the image
-      const f32 timeDif = timeBetweenFrames_ms/GetNumDivisions();
+      const f32 timeDif = timeBetweenFrames_ms/numDivisions;
       
-      // Whether or not a call to computePixelShiftsWithImageIMU returned false meaning it
-      // was unable to compute the pixelShifts from imageIMU data
+      // Whether or not interpolating the gyro rates failed for any division, meaning we were
+      // unable to compute the pixelShifts from imageIMU data
       bool didComputePixelShiftsFail = false;
       
       // Compounded pixelShifts across the image
       Vec2f shiftOffset = 0;
       
       // The fraction each subdivided row in the image will contribute to the total shifts for this image
-      const f32 frac = 1.f / GetNumDivisions();
+      const f32 frac = 1.f / numDivisions;
       
-      for(int i=1;i<=GetNumDivisions();i++)
+      for(int i=1;i<=numDivisions;i++)
       {
-        Vec2f pixelShifts;
         const RobotTimeStamp_t time = poseData.timeStamp - Anki::Util::numeric_cast<TimeStamp_t>(std::round(i*timeDif));
-        didComputePixelShiftsFail |= !ComputePixelShiftsWithImageIMU(time,
-                                                                     pixelShifts,
-                                                                     poseData,
-                                                                     prevPoseData,
-                                                                     frac);
         
-        _pixelShifts.insert(_pixelShifts.end(),
-                            Vec2f(pixelShifts.x() + shiftOffset.x(), pixelShifts.y() + shiftOffset.y()));
+        // Past the newest frame, its rates are assumed to hold for a short while
+        Vec3f gyro;
+        f32 rateY = 0.f;
+        f32 rateZ = 0.f;
+        Vec2f pixelShifts(0.f, 0.f);
+        if(poseData.imuDataHistory.GetGyroAt(time, gyro, kMaxAllowedDelay_ms))
+        {
+          rateY = gyro.y();
+          rateZ = gyro.z();
+          
+          // If we aren't doing vertical correction then setting rateY to zero will ensure no Y shift
+          if(!doVerticalCorrection)
+          {
+            rateY = 0;
+          }
+          
+          // The rates are in world coordinate frame but we want them in camera frame which is why Z and X are switched
+          pixelShifts = Vec2f(rateZ * rateToPixelProportionalityConst * frac,
+                              rateY * rateToPixelProportionalityConst * frac);
+        }
+        else
+        {
+          didComputePixelShiftsFail = true;
+        }
+        
+        _pixelShifts.emplace_back(pixelShifts.x() + shiftOffset.x(), pixelShifts.y() + shiftOffset.y());
         
         shiftOffset.x() += pixelShifts.x();
         shiftOffset.y() += pixelShifts.y();
@@ -89,116 +160,40 @@ namespace Anki {
       }
     }
     
-    Vision::Image RollingShutterCorrector::WarpImage(const Vision::Image& imgOrig)
+    const Vec2f& RollingShutterCorrector::GetPixelShiftForRow(const f32 row, const s32 numRows) const
     {
-      Vision::Image img(imgOrig.GetNumRows(), imgOrig.GetNumCols());
-      img.SetTimestamp(imgOrig.GetTimestamp());
-      
-      const int numRows = img.GetNumRows() - 1;
-      
-      const f32 rowsPerDivision = ((f32)numRows)/GetNumDivisions();
-      
-      for(int i=1;i<=GetNumDivisions();i++)
+      static const Vec2f kNoShift(0.f, 0.f);
+      if(_pixelShifts.empty() || (numRows <= 0))
       {
-        const Vec2f& pixelShifts = _pixelShifts[i-1];
-        
-        const int firstRow = numRows - (i * rowsPerDivision);
-        const int lastRow  = numRows - ((i-1) * rowsPerDivision);
-        
-        for(int y = firstRow; y < lastRow; y++)
-        {
-          const unsigned char* row = imgOrig.GetRow(y);
-          unsigned char* shiftRow = img.GetRow(y);
-          for(int x=0;x<img.GetNumCols();x++)
-          {
-            int xIdx = x - pixelShifts.x();
-            if(xIdx < 0 || xIdx >= img.GetNumCols())
-            {
-              shiftRow[x] = 0;
-            }
-            else
-            {
-              shiftRow[x] = row[xIdx];
-            }
-          }
-        }
+        return kNoShift;
       }
+      
+      // Division 0 is the bottom of the image
+      const f32 rowsPerDivision = ((f32)numRows) / _pixelShifts.size();
+      const s32 division = static_cast<s32>(std::floor((numRows - 1 - row) / rowsPerDivision));
+      return _pixelShifts[Util::Clamp(division, 0, (s32)_pixelShifts.size() - 1)];
+    }
+    
+    Vision::Image RollingShutterCorrector::WarpImage(const Vision::Image& imgOrig) const
+    {
+      Vision::Image img;
+      WarpImage(imgOrig, img);
       return img;
     }
     
-    bool RollingShutterCorrector::ComputePixelShiftsWithImageIMU(RobotTimeStamp_t t,
-                                                                 Vec2f& shift,
-                                                                 const VisionPoseData& poseData,
-                                                                 const VisionPoseData& prevPoseData,
-                                                                 const f32 frac)
+    void RollingShutterCorrector::WarpImage(const Vision::Image& imgOrig, Vision::Image& img) const
     {
-      if(poseData.imuDataHistory.empty())
-      {
-        shift = Vec2f(0,0);
-        return false;
-      }
+      DEV_ASSERT(imgOrig.GetDataPointer() != img.GetDataPointer(), "RollingShutterCorrector.WarpImage.InPlaceNotSupported");
       
-      ImuHistory::const_iterator ImuBeforeT;
-      ImuHistory::const_iterator ImuAfterT;
-
-      float rateY = 0;
-      float rateZ = 0;
-
-      bool beforeAfterSet = false;
-      // Find the ImuData before and after the timestamp if it exists
-      for(auto iter = poseData.imuDataHistory.begin(); iter != poseData.imuDataHistory.end(); ++iter)
-      {
-        if(iter->timestamp >= t)
-        {
-          // No imageIMU data before time t
-          if(iter == poseData.imuDataHistory.begin())
-          {
-            shift = Vec2f(0, 0);
-            return false;
-          }
-          else
-          {
-            ImuBeforeT = iter - 1;
-            ImuAfterT = iter;
-            beforeAfterSet = true;
-          }
-          
-          const TimeStamp_t tMinusBeforeTime     = (TimeStamp_t)(t - ImuBeforeT->timestamp);
-          const TimeStamp_t afterMinusBeforeTime = (TimeStamp_t)(ImuAfterT->timestamp - ImuBeforeT->timestamp);
-          
-          // Linearly interpolate the imu data using the timestamps before and after imu data was captured
-          rateY = (((tMinusBeforeTime)*(ImuAfterT->gyroRobotFrame.y - ImuBeforeT->gyroRobotFrame.y)) / (afterMinusBeforeTime)) + ImuBeforeT->gyroRobotFrame.y;
-          rateZ = (((tMinusBeforeTime)*(ImuAfterT->gyroRobotFrame.z - ImuBeforeT->gyroRobotFrame.z)) / (afterMinusBeforeTime)) + ImuBeforeT->gyroRobotFrame.z;
-          
-          break;
-        } 
-      }
-      
-      // If we don't have imu data for the timestamps before and after the timestamp we are looking for just
-      // use the latest data
-      if(!beforeAfterSet && !poseData.imuDataHistory.empty())
-      {
-        // if the IMU data is recent enough, just assume gyro data hasn't changed too much
-        if ( t - poseData.imuDataHistory.back().timestamp <= kMaxAllowedDelay_ms ) {
-          rateY = poseData.imuDataHistory.back().gyroRobotFrame.y;
-          rateZ = poseData.imuDataHistory.back().gyroRobotFrame.z;
-        } else {          
-          shift = Vec2f(0, 0);
-          return false;
-        }
-      }
+      const s32 numRows = imgOrig.GetNumRows();
+      const s32 numCols = imgOrig.GetNumCols();
+      img.Allocate(numRows, numCols);
+      img.SetTimestamp(imgOrig.GetTimestamp());
       
-      // If we aren't doing vertical correction then setting rateY to zero will ensure no Y shift
-      if(!doVerticalCorrection)
+      for(s32 y = 0; y < numRows; y++)
       {
-        rateY = 0;
+        ShiftRow(imgOrig.GetRow(y), img.GetRow(y), numCols, GetPixelShiftForRow(y, numRows).x());
       }
-      
-      // The rates are in world coordinate frame but we want them in camera frame which is why Z and X are switched
-      shift = Vec2f(rateZ * rateToPixelProportionalityConst * frac,
-                    rateY * rateToPixelProportionalityConst * frac);
-      
-      return true;
     }
   }
 }
@@ -42,22 +42,23 @@ namespace Anki {
                               const VisionPoseData& prevPoseData,
                               const u32 numRows);
       
-      // Shifts the image by the calculated pixel shifts
-      Vision::Image WarpImage(const Vision::Image& img);
+      // Shifts the image by the calculated pixel shifts, with bilinear interpolation between columns. Warping the
+      // whole image is much more expensive than correcting the points of interest with GetPixelShiftForRow()
+      Vision::Image WarpImage(const Vision::Image& img) const;
+      
+      // Same as above, into out (reusing its memory if it is already the right size). out must not be img
+      void WarpImage(const Vision::Image& img, Vision::Image& out) const;
+      
+      // The shift to subtract from a point in the given row of an image with numRows rows to correct it. Rows are
+      // read out top to bottom and the image timestamp is the bottom row, so the shifts grow towards the top
+      const Vec2f& GetPixelShiftForRow(const f32 row, const s32 numRows) const;
       
       const std::vector<Vec2f>& GetPixelShifts() const { return _pixelShifts; }
-      int GetNumDivisions();
+      int GetNumDivisions() const;
       
       static constexpr f32 timeBetweenFrames_ms = 65.0;
       
     private:
-      // Calculates pixel shifts based on gyro rates from ImageIMUData messages
-      // Returns false if unable to calculate shifts due to not having relevant gyro data
-      bool ComputePixelShiftsWithImageIMU(RobotTimeStamp_t t,
-                                          Vec2f& shift,
-                                          const VisionPoseData& poseData,
-                                          const VisionPoseData& prevPoseData,
-                                          const f32 frac);
     
       // Vector of vectors of varying pixel shift amounts based on gyro rates and vertical position in the image
       std::vector<Vec2f> _pixelShifts;
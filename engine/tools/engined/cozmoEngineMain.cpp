@@ -15,6 +15,7 @@
 #include "coretech/common/engine/utils/data/dataPlatform.h"
 
 #include "engine/cozmoAPI/cozmoAPI.h"
+#include "engine/debug/engineReplay.h"
 #include "engine/utils/parsingConstants/parsingConstants.h"
 
 #include "platform/common/diagnosticDefines.h"
@@ -24,6 +25,7 @@
 #include "util/fileUtils/fileUtils.h"
 #include "util/helpers/templateHelpers.h"
 
+#include "util/logging/asyncLoggerProvider.h"
 #include "util/logging/channelFilter.h"
 #include "util/logging/iEventProvider.h"
 #include "util/logging/iFormattedLoggerProvider.h"
@@ -81,6 +83,9 @@ namespace {
   std::unique_ptr<Anki::Util::MultiLoggerProvider> gMultiLogger;
   #endif
 
+  // Private singleton, wraps whichever of the above is in use. Declared last so it goes first
+  std::unique_ptr<Anki::Util::AsyncLoggerProvider> gAsyncLogger;
+
 }
 
 static void sigterm(int signum)
@@ -202,6 +207,10 @@ static bool cozmo_start(const Json::Value& configuration)
   }
 #endif
 
+  // From here on lines are written out by a low priority thread, so that e.g. the vision thread never waits on logd
+  gAsyncLogger = std::make_unique<Anki::Util::AsyncLoggerProvider>(Anki::Util::gLoggerProvider);
+  Anki::Util::gLoggerProvider = gAsyncLogger.get();
+
   LOG_INFO("cozmo_start",
             "Creating engine; Initialized data platform with persistentPath = %s, cachePath = %s, resourcesPath = %s",
             persistentPath.c_str(), cachePath.c_str(), resourcesPath.c_str());
@@ -231,6 +240,7 @@ static void cozmo_stop()
 
   Anki::Util::gEventProvider = nullptr;
   Anki::Util::gLoggerProvider = nullptr;
+  gAsyncLogger.reset();
 
 #if DEV_LOGGER_ENABLED
   Anki::Vector::DevLoggingSystem::DestroyInstance();
@@ -348,6 +358,9 @@ int main(int argc, char* argv[])
   using namespace std::chrono;
   using TimeClock = steady_clock;
 
+  // A replay at max speed ticks back to back, since the engine runs on the recording's clock anyway
+  const bool tickWithoutSleeping = Anki::Vector::EngineReplay::RunsAtMaxSpeed(config);
+
   const auto runStart = TimeClock::now();
   auto prevTickStart  = runStart;
   auto tickStart      = runStart;
@@ -377,18 +390,30 @@ int main(int argc, char* argv[])
 #endif
 
     // We ALWAYS sleep, but if we're overtime, we 'sleep zero' which still allows
-    // other threads to run
+    // other threads to run. While sleeping, an urgent message from the robot (e.g. a cliff) ends the sleep
+    // early, though never sooner than kMinTickSpacing after the tick started
     static const auto minimumSleepTime_us = microseconds((long)0);
-    const auto sleepTime_us = std::max(minimumSleepTime_us, remaining_us);
+    static const auto kMinTickSpacing = milliseconds(10);
+    const auto sleepTime_us = tickWithoutSleeping ? minimumSleepTime_us : std::max(minimumSleepTime_us, remaining_us);
+    bool wokeEarly = false;
     {
       using namespace Anki;
       ANKI_CPU_PROFILE("CozmoEngineMain.main.Sleep");
 
-      std::this_thread::sleep_for(sleepTime_us);
+      if (tickWithoutSleeping || (sleepTime_us == minimumSleepTime_us)) {
+        std::this_thread::sleep_for(minimumSleepTime_us);
+      } else {
+        wokeEarly = gEngineAPI->WaitForNextTick(tickStart + kMinTickSpacing, targetEndFrameTime);
+      }
     }
 
-    // Set the target end time for the next frame
-    targetEndFrameTime += (microseconds)(Anki::Vector::BS_TIME_STEP_MICROSECONDS);
+    // Set the target end time for the next frame. After an early tick, the next regular tick is a whole frame
+    // after it, so the early one doesn't leave the next one short
+    if (wokeEarly) {
+      targetEndFrameTime = TimeClock::now() + (microseconds)(Anki::Vector::BS_TIME_STEP_MICROSECONDS);
+    } else {
+      targetEndFrameTime += (microseconds)(Anki::Vector::BS_TIME_STEP_MICROSECONDS);
+    }
 
     // See if we've fallen quite far behind; if so, compensate by catching the target frame end time up somewhat.
     // This is so that we don't spend SEVERAL frames trying to catch up (by depriving sleep time).
@@ -22,6 +22,9 @@ class DasTransferTask : public TransferTask
 {
 private:
   virtual void OnTransferReady(Dispatch::Queue* queue, const TransferQueueMgr::TaskCompleteFunc& completionFunc) override;
+
+  // DAS events are small and most useful when fresh
+  virtual TransferQueueMgr::Priority GetPriority() const override { return TransferQueueMgr::Priority::High; }
 };
 
 }
@@ -16,6 +16,9 @@
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
 #include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
 
 #if USE_DAS
 #include <DAS/DAS.h>
@@ -25,7 +28,51 @@
 namespace Anki {
 namespace Util {
 
-static const size_t kMaxUploadSize = 10 * 1024 * 1024;
+// Logs are sent in pieces of this size, so a dropped connection only costs the piece in flight
+static const size_t kUploadChunkSize = 512 * 1024;
+
+// Most chunks of one file in flight at once
+static const size_t kMaxChunksPerFile = 4;
+
+// Apprun key recording how much of the archive the server has acknowledged, so an upload interrupted by
+// a bad connection resumes from there instead of starting over
+static const std::string kUploadedBytesKey = "uploadedBytes";
+
+namespace {
+
+// Tracks the chunks of one archive sent in this transfer. They can complete in any order; only the
+// contiguous run of acknowledged chunks from the start is recorded as uploaded
+struct ChunkedUpload
+{
+  std::string filename;
+  size_t fileSize = 0;
+  size_t uploadedBytes = 0;
+  std::map<size_t, size_t> chunkEnds;  // start offset -> end offset of each chunk in flight
+  std::set<size_t> acknowledgedChunks; // start offsets of chunks acknowledged out of order
+
+  void OnChunkAcknowledged(size_t chunkStart)
+  {
+    acknowledgedChunks.insert(chunkStart);
+    const size_t prevUploadedBytes = uploadedBytes;
+    while (acknowledgedChunks.erase(uploadedBytes) > 0) {
+      uploadedBytes = chunkEnds[uploadedBytes];
+    }
+    if (uploadedBytes == prevUploadedBytes) {
+      return;
+    }
+
+    std::string appRunFilename = Vector::DevLoggingSystem::GetAppRunFilename(filename);
+    Json::Value appRunData = Vector::DevLoggingSystem::GetAppRunData(appRunFilename);
+    appRunData[kUploadedBytesKey] = Json::UInt64(uploadedBytes);
+    if (uploadedBytes >= fileSize) {
+      appRunData[Vector::DevLoggingSystem::kHasBeenUploadedKey] = true;
+      PRINT_NAMED_INFO("GameLogTransferTask", "uploaded %s", filename.c_str());
+    }
+    Util::FileUtils::WriteFile(appRunFilename, appRunData.toStyledString());
+  }
+};
+
+}
 
 void GameLogTransferTask::OnReady(const StartRequestFunc& requestFunc)
 {
@@ -43,24 +90,28 @@ void GameLogTransferTask::OnReady(const StartRequestFunc& requestFunc)
   devLoggingSystem->PrepareForUpload(deviceId);
   auto filesToUpload = devLoggingSystem->GetLogFilenamesForUpload();
 
-  size_t bytesQueued = 0;
-
+  bool hasBandwidth = true;
   for (std::string& filename : filesToUpload) {
-    HttpRequest request;
+    HttpRequest baseRequest;
+    auto upload = std::make_shared<ChunkedUpload>();
     try {
-      request.storageFilePath = filename;
-      request.method = HttpMethodPut;
+      const ssize_t fileSize = FileUtils::GetFileSize(filename);
+      if (fileSize <= 0) {
+        continue;
+      }
+      upload->filename = filename;
+      upload->fileSize = static_cast<size_t>(fileSize);
 
-      bytesQueued += FileUtils::GetFileSize(filename);
+      baseRequest.method = HttpMethodPut;
 
       // get filename
       auto filenameStartIndex = filename.find_last_of('/');
       filenameStartIndex = (filenameStartIndex == std::string::npos) ? 0 : filenameStartIndex + 1;
       std::string baseFilename = filename.substr(filenameStartIndex);
-      request.uri = "https://blobstore-dev.api.anki.com/1/cozmo/blobs/" + baseFilename;
+      baseRequest.uri = "https://blobstore-dev.api.anki.com/1/cozmo/blobs/" + baseFilename;
 
       // add headers
-      request.headers.emplace("Anki-App-Key", "toh5awu3kee1ahfaikeeGh");
+      baseRequest.headers.emplace("Anki-App-Key", "toh5awu3kee1ahfaikeeGh");
       
       // get apprun data
       Json::Value appRunData = Vector::DevLoggingSystem::GetAppRunData(Vector::DevLoggingSystem::GetAppRunFilename(filename));
@@ -68,7 +119,7 @@ void GameLogTransferTask::OnReady(const StartRequestFunc& requestFunc)
         std::string fileAppRun;
         if (JsonTools::GetValueOptional(appRunData, Vector::DevLoggingSystem::kAppRunKey, fileAppRun))
         {
-          request.headers.emplace("Usr-apprun", std::move(fileAppRun));
+          baseRequest.headers.emplace("Usr-apprun", std::move(fileAppRun));
         }
         
         // This gets a little complicated in the interest of supporting uint64 on platforms that can:
@@ -76,13 +127,20 @@ void GameLogTransferTask::OnReady(const StartRequestFunc& requestFunc)
         if(!child.isNull())
         {
           const auto appStartTimeSinceEpoch_ms = child.asLargestUInt();
-          request.headers.emplace("Usr-Time-Since-Epoch", std::to_string(appStartTimeSinceEpoch_ms));
+          baseRequest.headers.emplace("Usr-Time-Since-Epoch", std::to_string(appStartTimeSinceEpoch_ms));
         }
         
         std::string fileDeviceID;
         if (JsonTools::GetValueOptional(appRunData, Vector::DevLoggingSystem::kDeviceIdKey, fileDeviceID))
         {
-          request.headers.emplace("Usr-Deviceid", fileDeviceID);
+          baseRequest.headers.emplace("Usr-Deviceid", fileDeviceID);
+        }
+
+        // resume where the last transfer of this file left off, unless the file no longer matches
+        const Json::Value& uploadedBytes(appRunData[kUploadedBytesKey]);
+        if (!uploadedBytes.isNull() && (uploadedBytes.asLargestUInt() < upload->fileSize))
+        {
+          upload->uploadedBytes = static_cast<size_t>(uploadedBytes.asLargestUInt());
         }
       }
     }
@@ -91,28 +149,44 @@ void GameLogTransferTask::OnReady(const StartRequestFunc& requestFunc)
       break;
     }
 
-    // submit request
-    requestFunc(request, [filename = std::move(filename)] (const HttpRequest& innerRequest,
-                                     const int responseCode,
-                                     const std::map<std::string, std::string>&,
-                                     const std::vector<uint8_t>&) {
-      if (isHttpSuccessCode(responseCode)) {
-        std::string appRunFilename = Vector::DevLoggingSystem::GetAppRunFilename(filename);
-        Json::Value appRunData = Vector::DevLoggingSystem::GetAppRunData(appRunFilename);
-        appRunData[Vector::DevLoggingSystem::kHasBeenUploadedKey] = true;
-        Util::FileUtils::WriteFile(appRunFilename, appRunData.toStyledString());
-
-        auto it = innerRequest.headers.find("Usr-apprun");
-        const char* appRunId = (it == innerRequest.headers.end()) ? "" : it->second.c_str();
-        PRINT_NAMED_INFO("GameLogTransferTask", "uploaded %s, apprun %s", innerRequest.uri.c_str(), appRunId);
+    size_t chunkStart = upload->uploadedBytes;
+    for (size_t i = 0; (i < kMaxChunksPerFile) && (chunkStart < upload->fileSize); ++i) {
+      const size_t chunkSize = ReserveBandwidth(std::min(kUploadChunkSize, upload->fileSize - chunkStart));
+      if (chunkSize == 0) {
+        // upload more later, the budget for this transfer is spent
+        hasBandwidth = false;
+        break;
       }
-      else {
-        PRINT_NAMED_WARNING("GameLogTransferTask", "could not upload %s", innerRequest.uri.c_str());
+
+      HttpRequest request = baseRequest;
+      request.body = FileUtils::ReadFileAsBinary(filename, chunkStart, chunkSize);
+      if (request.body.size() != chunkSize) {
+        PRINT_NAMED_WARNING("GameLogTransferTask.ReadFailed", "could not read %s", filename.c_str());
+        break;
       }
-    });
+      const size_t chunkEnd = chunkStart + chunkSize;
+      request.headers["Content-Range"] = "bytes " + std::to_string(chunkStart) + "-" + std::to_string(chunkEnd - 1) +
+                                         "/" + std::to_string(upload->fileSize);
+      upload->chunkEnds[chunkStart] = chunkEnd;
+
+      // submit request
+      requestFunc(request, [upload, chunkStart] (const HttpRequest& innerRequest,
+                                                 const int responseCode,
+                                                 const std::map<std::string, std::string>&,
+                                                 const std::vector<uint8_t>&) {
+        if (isHttpSuccessCode(responseCode)) {
+          upload->OnChunkAcknowledged(chunkStart);
+        }
+        else {
+          PRINT_NAMED_WARNING("GameLogTransferTask", "could not upload %s at offset %zu",
+                              innerRequest.uri.c_str(), chunkStart);
+        }
+      });
+
+      chunkStart = chunkEnd;
+    }
 
-    if (bytesQueued > kMaxUploadSize) {
-      // upload more later, don't do too much at once
+    if (!hasBandwidth) {
       break;
     }
   }
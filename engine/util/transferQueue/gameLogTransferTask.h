@@ -22,6 +22,9 @@ class GameLogTransferTask : public TransferTaskHttp
 {
 private:
   virtual void OnReady(const StartRequestFunc& requestFunc) override;
+
+  // Logs are the bulk of what gets uploaded and can wait for whatever bandwidth is left
+  virtual TransferQueueMgr::Priority GetPriority() const override { return TransferQueueMgr::Priority::Low; }
 };
 
 }
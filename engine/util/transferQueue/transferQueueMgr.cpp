@@ -18,6 +18,7 @@
 #include "util/dispatchQueue/dispatchQueue.h"
 #include "util/helpers/templateHelpers.h"
 #include "util/logging/logging.h"
+#include <algorithm>
 #include <string>
 
 namespace Anki {
@@ -27,6 +28,8 @@ namespace Anki {
     TransferQueueMgr::TransferQueueMgr()
     : _queue(Dispatch::Create("TrnsQueueMgr"))
     , _numRequests(0)
+    , _bandwidthBudget_bytes(kDefaultBandwidthBudget_bytes)
+    , _bandwidthRemaining_bytes(0)
     {
     }
 
@@ -41,17 +44,27 @@ namespace Anki {
       StartDataTransfer();
     }
 
-    Signal::SmartHandle TransferQueueMgr::RegisterTask(const OnTransferReadyFunc& userFunc)
+    Signal::SmartHandle TransferQueueMgr::RegisterTask(const OnTransferReadyFunc& userFunc, Priority priority)
     {
       std::lock_guard<std::mutex> lock{_mutex};
       auto funcWrapper = [this, userFunc] (Dispatch::Queue* queue, const TaskCompleteFunc& completionFunc) {
         this->_numRequests++;
         userFunc(queue, completionFunc);
       };
-      Signal::SmartHandle handle = _signal.ScopedSubscribe(funcWrapper);
+      Signal::SmartHandle handle = _signals[static_cast<size_t>(priority)].ScopedSubscribe(funcWrapper);
       return handle;
     }
 
+    size_t TransferQueueMgr::ReserveBandwidth(size_t numBytes)
+    {
+      size_t remaining = _bandwidthRemaining_bytes.load();
+      size_t granted = 0;
+      do {
+        granted = std::min(remaining, numBytes);
+      } while (!_bandwidthRemaining_bytes.compare_exchange_weak(remaining, remaining - granted));
+      return granted;
+    }
+
     void TransferQueueMgr::StartDataTransfer()
     {
       const bool noActiveRequests = _numRequests == 0;
@@ -62,6 +75,7 @@ namespace Anki {
       }
       std::unique_lock<std::mutex> lock{_mutex};
       _numRequests = 0;
+      _bandwidthRemaining_bytes = _bandwidthBudget_bytes;
 
       // set up completion func to notify this thread every time a task finishes
       auto completionFunc = [this] {
@@ -75,9 +89,11 @@ namespace Anki {
           _waitVar.notify_one();
         });
       };
-      // synchronously notify all tasks to begin on the queue
+      // synchronously notify all tasks to begin on the queue, highest priority first
       Dispatch::Sync(_queue, [this, &completionFunc] {
-        _signal.emit(_queue, completionFunc);
+        for (auto& signal : _signals) {
+          signal.emit(_queue, completionFunc);
+        }
       });
       // ...and then wait for them all to finish (if no tasks are started this will just instantly continue)
       _waitVar.wait(lock, [this] { return _numRequests == 0; });
@@ -27,6 +27,9 @@
 #include "util/helpers/noncopyable.h"
 #include "util/http/abstractHttpAdapter.h"
 #include "util/signals/simpleSignal.hpp"
+#include <array>
+#include <atomic>
+#include <condition_variable>
 #include <mutex>
 
 
@@ -39,6 +42,16 @@ namespace Anki {
     public:
       using TaskCompleteFunc = std::function<void()>;
       using OnTransferReadyFunc = std::function<void(Dispatch::Queue*, const TaskCompleteFunc&)>;
+
+      // Tasks are started in priority order, so higher priority tasks get first claim on the bandwidth budget
+      enum class Priority : uint8_t {
+        High,
+        Normal,
+        Low,
+        Count
+      };
+
+      static constexpr size_t kDefaultBandwidthBudget_bytes = 10 * 1024 * 1024;
       
       // ----------
       TransferQueueMgr();
@@ -46,13 +59,23 @@ namespace Anki {
       
       void ExecuteTransfers();
       
-      Signal::SmartHandle RegisterTask(const OnTransferReadyFunc& func);
+      Signal::SmartHandle RegisterTask(const OnTransferReadyFunc& func, Priority priority = Priority::Normal);
+
+      // Total bytes all tasks together may upload per ExecuteTransfers
+      void SetBandwidthBudget(size_t bytesPerTransfer) { _bandwidthBudget_bytes = bytesPerTransfer; }
+
+      // Takes up to numBytes from what is left of this transfer's budget and returns how many bytes were
+      // granted (possibly 0). Tasks should send no more than they were granted and pick up the rest next time
+      size_t ReserveBandwidth(size_t numBytes);
       
     protected:
       Dispatch::Queue* _queue;
       int _numRequests;
 
-      Signal::Signal<void(Dispatch::Queue*, const TaskCompleteFunc&)> _signal;
+      using TransferReadySignal = Signal::Signal<void(Dispatch::Queue*, const TaskCompleteFunc&)>;
+      std::array<TransferReadySignal, static_cast<size_t>(Priority::Count)> _signals;
+      size_t _bandwidthBudget_bytes;
+      std::atomic<size_t> _bandwidthRemaining_bytes;
       std::mutex _mutex;
       std::condition_variable _waitVar;
       
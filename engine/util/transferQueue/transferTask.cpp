@@ -18,8 +18,14 @@ namespace Util {
 
 void TransferTask::Init(TransferQueueMgr* transferQueueMgr)
 {
+  _transferQueueMgr = transferQueueMgr;
   auto callback = std::bind(&TransferTask::OnTransferReady, this, std::placeholders::_1, std::placeholders::_2);
-  AddSignalHandle(transferQueueMgr->RegisterTask(callback));
+  AddSignalHandle(transferQueueMgr->RegisterTask(callback, GetPriority()));
+}
+
+size_t TransferTask::ReserveBandwidth(size_t numBytes)
+{
+  return (_transferQueueMgr != nullptr) ? _transferQueueMgr->ReserveBandwidth(numBytes) : numBytes;
 }
 
 }
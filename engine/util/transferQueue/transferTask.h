@@ -31,6 +31,15 @@ public:
 protected:
   // Called by TransferQueueMgr after Init()
   virtual void OnTransferReady(Dispatch::Queue* queue, const TransferQueueMgr::TaskCompleteFunc& completionFunc) = 0;
+
+  // Where this task is started relative to the others when a transfer begins
+  virtual TransferQueueMgr::Priority GetPriority() const { return TransferQueueMgr::Priority::Normal; }
+
+  // See TransferQueueMgr::ReserveBandwidth
+  size_t ReserveBandwidth(size_t numBytes);
+
+private:
+  TransferQueueMgr* _transferQueueMgr = nullptr;
 };
 
 
@@ -13,20 +13,32 @@
 #include "engine/util/transferQueue/transferTaskHttp.h"
 #include "engine/util/http/createHttpAdapter.h"
 #include "util/logging/logging.h"
+#include <algorithm>
 
 namespace Anki {
 namespace Util {
 
+static constexpr std::chrono::seconds kInitialBackoff{30};
+static constexpr std::chrono::seconds kMaxBackoff{60 * 60};
+
 TransferTaskHttp::TransferTaskHttp()
 : _httpAdapter(CreateHttpAdapter())
 , _numTransfers(0)
+, _nextAttemptTime(Clock::now())
+, _backoff(0)
+, _anyRequestFailed(false)
 {
 }
 
 void TransferTaskHttp::OnTransferReady(Dispatch::Queue* queue, const TransferQueueMgr::TaskCompleteFunc& completionFunc)
 {
   DEV_ASSERT(_numTransfers == 0, "TransferTaskHttp.InvalidStartTransferCount");
+  if (Clock::now() < _nextAttemptTime) {
+    completionFunc();
+    return;
+  }
   _numTransfers = 0;
+  _anyRequestFailed = false;
   bool transfersStarted = false;
 
   auto startRequestFunc = [this, queue, completionFunc, &transfersStarted] (const HttpRequest& request, const HttpRequestCallback& userCallback) {
@@ -39,8 +51,19 @@ void TransferTaskHttp::OnTransferReady(Dispatch::Queue* queue, const TransferQue
       if (userCallback) {
         userCallback(innerRequest, responseCode, responseHeaders, responseBody);
       }
+      if (!isHttpSuccessCode(responseCode)) {
+        _anyRequestFailed = true;
+      }
       _numTransfers--;
       if (_numTransfers == 0) {
+        if (_anyRequestFailed) {
+          _backoff = (_backoff.count() == 0) ? kInitialBackoff : std::min(2 * _backoff, kMaxBackoff);
+          _nextAttemptTime = Clock::now() + _backoff;
+          PRINT_NAMED_INFO("TransferTaskHttp.Backoff", "retrying in %lld seconds", (long long)_backoff.count());
+        }
+        else {
+          _backoff = std::chrono::seconds(0);
+        }
         completionFunc();
       }
     };
@@ -16,6 +16,7 @@
 #include "engine/util/transferQueue/transferTask.h"
 #include "util/http/abstractHttpAdapter.h"
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -40,6 +41,13 @@ private:
 
   std::unique_ptr<IHttpAdapter> _httpAdapter;
   std::atomic<int> _numTransfers;
+
+  // After a transfer with a failed request this task sits out transfers for a while, doubling each time it
+  // fails again, instead of retrying (and holding up the other tasks) every time connectivity appears
+  using Clock = std::chrono::steady_clock;
+  Clock::time_point _nextAttemptTime;
+  std::chrono::seconds _backoff;
+  std::atomic<bool> _anyRequestFailed;
 };
 
 }
@@ -0,0 +1,420 @@
+/**
+ * File: jsonConfigCache.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Binary cache of parsed json config files (see header)
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "engine/utils/jsonConfigCache.h"
+
+#include "engine/utils/mappedFile.h"
+
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+
+#include "json/json.h"
+
+#include <algorithm>
+#include <cstring>
+
+#define LOG_CHANNEL "RobotDataLoader"
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+  // File layout: FileHeader, then numEntries FlatEntry, then the paths and encoded values they point to. The cache
+  // never leaves the robot that wrote it, so values are in native byte order
+  // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+  constexpr uint32_t kFileMagic   = 0x4746434A; // "JCFG"
+  constexpr uint32_t kFileVersion = 1;
+
+  struct FileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint64_t sourceHash;
+    uint32_t numEntries;
+    uint32_t unused;
+  };
+
+  struct FlatEntry {
+    uint32_t pathOffset;
+    uint32_t pathSize;
+    uint32_t valueOffset;
+    uint32_t valueSize;
+  };
+
+  enum ValueTag : uint8_t {
+    kNull = 0,
+    kFalse,
+    kTrue,
+    kInt,
+    kUInt,
+    kReal,
+    kString,
+    kArray,
+    kObject
+  };
+
+  // config files nest a handful of levels, so anything deeper than this is corrupt
+  constexpr uint32_t kMaxDepth = 64;
+
+  constexpr uint64_t kFnvOffset = 14695981039346656037ull;
+  constexpr uint64_t kFnvPrime  = 1099511628211ull;
+
+  uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+  {
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    for( size_t i = 0; i < size; ++i ) {
+      hash = (hash ^ bytes[i]) * kFnvPrime;
+    }
+    return hash;
+  }
+
+  template <class T>
+  void Append(std::vector<uint8_t>& buffer, const T& value)
+  {
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  void AppendString(std::vector<uint8_t>& buffer, const char* str, uint32_t size)
+  {
+    Append(buffer, size);
+    buffer.insert(buffer.end(), str, str + size);
+  }
+
+  // values in the file are not aligned, so they are always read by copying
+  template <class T>
+  bool Read(const uint8_t*& data, const uint8_t* end, T& outValue)
+  {
+    if( (size_t)(end - data) < sizeof(T) ) {
+      return false;
+    }
+    std::memcpy(&outValue, data, sizeof(T));
+    data += sizeof(T);
+    return true;
+  }
+
+  bool ReadString(const uint8_t*& data, const uint8_t* end, const char*& outStr, uint32_t& outSize)
+  {
+    if( !Read(data, end, outSize) || ((size_t)(end - data) < outSize) ) {
+      return false;
+    }
+    outStr = reinterpret_cast<const char*>(data);
+    data += outSize;
+    return true;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+JsonConfigCache::JsonConfigCache(const std::string& cachePath, const std::vector<std::string>& sourcePaths)
+: _cachePath(cachePath)
+, _sourceHash(HashSources(sourcePaths))
+{
+  if( !Open() ) {
+    _mappedFile.reset();
+    _entries.clear();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+JsonConfigCache::~JsonConfigCache() = default;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+uint64_t JsonConfigCache::HashSources(const std::vector<std::string>& sourcePaths)
+{
+  std::vector<std::string> sorted = sourcePaths;
+  std::sort(sorted.begin(), sorted.end());
+
+  uint64_t hash = HashBytes(kFnvOffset, &kFileVersion, sizeof(kFileVersion));
+  for( const auto& path : sorted ) {
+    const int64_t size = Util::FileUtils::GetFileSize(path);
+    const int64_t modTime = Util::FileUtils::GetFileLastModificationTime(path);
+    hash = HashBytes(hash, path.c_str(), path.size() + 1);
+    hash = HashBytes(hash, &size, sizeof(size));
+    hash = HashBytes(hash, &modTime, sizeof(modTime));
+  }
+  return hash;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool JsonConfigCache::Open()
+{
+  if( !Util::FileUtils::FileExists(_cachePath) ) {
+    return false;
+  }
+
+  _mappedFile = std::make_unique<MappedFile>(_cachePath);
+  const uint8_t* data = _mappedFile->GetData();
+  const size_t size = _mappedFile->GetSize();
+  if( (data == nullptr) || (size < sizeof(FileHeader)) ) {
+    LOG_WARNING("JsonConfigCache.Open.ReadFailed", "Could not read '%s'", _cachePath.c_str());
+    return false;
+  }
+
+  FileHeader header;
+  std::memcpy(&header, data, sizeof(header));
+  if( (header.magic != kFileMagic) || (header.version != kFileVersion) ) {
+    LOG_WARNING("JsonConfigCache.Open.BadFile", "'%s' is not a version %u config cache", _cachePath.c_str(), kFileVersion);
+    return false;
+  }
+  if( header.sourceHash != _sourceHash ) {
+    LOG_INFO("JsonConfigCache.Open.Stale", "'%s' was built from other files, rebuilding it", _cachePath.c_str());
+    return false;
+  }
+  if( (size - sizeof(FileHeader)) / sizeof(FlatEntry) < header.numEntries ) {
+    LOG_WARNING("JsonConfigCache.Open.BadEntries", "'%s' is too short for its entries", _cachePath.c_str());
+    return false;
+  }
+
+  // only the table is checked here. Values are checked as they are decoded
+  _entries.reserve(header.numEntries);
+  const uint8_t* flatEntries = data + sizeof(FileHeader);
+  for( uint32_t i = 0; i < header.numEntries; ++i ) {
+    FlatEntry flat;
+    std::memcpy(&flat, flatEntries + i * sizeof(FlatEntry), sizeof(flat));
+    if( ((size_t)flat.pathOffset + flat.pathSize > size) || ((size_t)flat.valueOffset + flat.valueSize > size) ) {
+      LOG_WARNING("JsonConfigCache.Open.BadEntry", "'%s' has entries out of range", _cachePath.c_str());
+      return false;
+    }
+    const std::string path(reinterpret_cast<const char*>(data + flat.pathOffset), flat.pathSize);
+    _entries.emplace(path, Entry{flat.valueOffset, flat.valueSize});
+  }
+
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool JsonConfigCache::Get(const std::string& sourcePath, Json::Value& outValue) const
+{
+  if( !IsValid() ) {
+    return false;
+  }
+
+  const auto it = _entries.find(sourcePath);
+  if( it == _entries.end() ) {
+    return false;
+  }
+
+  const uint8_t* data = _mappedFile->GetData() + it->second.valueOffset;
+  const uint8_t* end = data + it->second.valueSize;
+  if( !DecodeValue(data, end, outValue) || (data != end) ) {
+    LOG_WARNING("JsonConfigCache.Get.Corrupt",
+                "Entry for '%s' in '%s' is corrupt, removing the cache",
+                sourcePath.c_str(),
+                _cachePath.c_str());
+    Util::FileUtils::DeleteFile(_cachePath);
+    outValue = Json::Value();
+    return false;
+  }
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void JsonConfigCache::Add(const std::string& sourcePath, const Json::Value& value)
+{
+  if( IsValid() ) {
+    return;
+  }
+
+  std::vector<uint8_t> encoded;
+  EncodeValue(value, encoded);
+
+  std::lock_guard<std::mutex> guard(_addedMutex);
+  _added[sourcePath] = std::move(encoded);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool JsonConfigCache::Save()
+{
+  if( IsValid() ) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> guard(_addedMutex);
+
+  size_t totalSize = sizeof(FileHeader) + sizeof(FlatEntry) * _added.size();
+  for( const auto& added : _added ) {
+    totalSize += added.first.size() + added.second.size();
+  }
+  if( totalSize > UINT32_MAX ) {
+    LOG_WARNING("JsonConfigCache.Save.TooLarge", "Not writing '%s', it would be %zu bytes", _cachePath.c_str(), totalSize);
+    return false;
+  }
+
+  FileHeader header;
+  header.magic      = kFileMagic;
+  header.version    = kFileVersion;
+  header.sourceHash = _sourceHash;
+  header.numEntries = (uint32_t) _added.size();
+  header.unused     = 0;
+
+  std::vector<uint8_t> buffer;
+  buffer.reserve(totalSize);
+  Append(buffer, header);
+
+  uint32_t offset = (uint32_t) (sizeof(FileHeader) + sizeof(FlatEntry) * _added.size());
+  for( const auto& added : _added ) {
+    FlatEntry flat;
+    flat.pathOffset  = offset;
+    flat.pathSize    = (uint32_t) added.first.size();
+    flat.valueOffset = flat.pathOffset + flat.pathSize;
+    flat.valueSize   = (uint32_t) added.second.size();
+    Append(buffer, flat);
+    offset = flat.valueOffset + flat.valueSize;
+  }
+  for( const auto& added : _added ) {
+    buffer.insert(buffer.end(), added.first.begin(), added.first.end());
+    buffer.insert(buffer.end(), added.second.begin(), added.second.end());
+  }
+
+  if( !Util::FileUtils::CreateDirectory(_cachePath, true, true) ||
+      !Util::FileUtils::WriteFileAtomic(_cachePath, buffer) ) {
+    LOG_WARNING("JsonConfigCache.Save.WriteFailed", "Could not write '%s'", _cachePath.c_str());
+    return false;
+  }
+
+  LOG_INFO("JsonConfigCache.Save", "Wrote %zu configs (%zu bytes) to '%s'",
+           _added.size(), buffer.size(), _cachePath.c_str());
+  return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void JsonConfigCache::EncodeValue(const Json::Value& value, std::vector<uint8_t>& buffer)
+{
+  switch( value.type() ) {
+    case Json::nullValue:
+      buffer.push_back(kNull);
+      break;
+    case Json::booleanValue:
+      buffer.push_back(value.asBool() ? kTrue : kFalse);
+      break;
+    case Json::intValue:
+      buffer.push_back(kInt);
+      Append(buffer, (int64_t) value.asLargestInt());
+      break;
+    case Json::uintValue:
+      buffer.push_back(kUInt);
+      Append(buffer, (uint64_t) value.asLargestUInt());
+      break;
+    case Json::realValue:
+      buffer.push_back(kReal);
+      Append(buffer, value.asDouble());
+      break;
+    case Json::stringValue:
+    {
+      const char* begin = nullptr;
+      const char* end = nullptr;
+      value.getString(&begin, &end);
+      buffer.push_back(kString);
+      AppendString(buffer, begin, (uint32_t) (end - begin));
+      break;
+    }
+    case Json::arrayValue:
+      buffer.push_back(kArray);
+      Append(buffer, (uint32_t) value.size());
+      for( const auto& element : value ) {
+        EncodeValue(element, buffer);
+      }
+      break;
+    case Json::objectValue:
+      buffer.push_back(kObject);
+      Append(buffer, (uint32_t) value.size());
+      for( auto it = value.begin(); it != value.end(); ++it ) {
+        const std::string key = it.name();
+        AppendString(buffer, key.c_str(), (uint32_t) key.size());
+        EncodeValue(*it, buffer);
+      }
+      break;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool JsonConfigCache::DecodeValue(const uint8_t*& data, const uint8_t* end, Json::Value& outValue, uint32_t depth)
+{
+  uint8_t tag;
+  if( (depth > kMaxDepth) || !Read(data, end, tag) ) {
+    return false;
+  }
+
+  switch( tag ) {
+    case kNull:
+      outValue = Json::Value();
+      return true;
+    case kFalse:
+    case kTrue:
+      outValue = (tag == kTrue);
+      return true;
+    case kInt:
+    {
+      int64_t intValue;
+      if( !Read(data, end, intValue) ) { return false; }
+      outValue = Json::Value((Json::LargestInt) intValue);
+      return true;
+    }
+    case kUInt:
+    {
+      uint64_t uintValue;
+      if( !Read(data, end, uintValue) ) { return false; }
+      outValue = Json::Value((Json::LargestUInt) uintValue);
+      return true;
+    }
+    case kReal:
+    {
+      double realValue;
+      if( !Read(data, end, realValue) ) { return false; }
+      outValue = realValue;
+      return true;
+    }
+    case kString:
+    {
+      const char* str = nullptr;
+      uint32_t size = 0;
+      if( !ReadString(data, end, str, size) ) { return false; }
+      outValue = Json::Value(str, str + size);
+      return true;
+    }
+    case kArray:
+    {
+      uint32_t count;
+      if( !Read(data, end, count) ) { return false; }
+      outValue = Json::Value(Json::arrayValue);
+      // every element takes at least its tag, so a count larger than what's left is corrupt
+      if( (size_t)(end - data) < count ) { return false; }
+      if( count > 0 ) {
+        outValue.resize(count);
+      }
+      for( uint32_t i = 0; i < count; ++i ) {
+        if( !DecodeValue(data, end, outValue[i], depth + 1) ) { return false; }
+      }
+      return true;
+    }
+    case kObject:
+    {
+      uint32_t count;
+      if( !Read(data, end, count) ) { return false; }
+      outValue = Json::Value(Json::objectValue);
+      for( uint32_t i = 0; i < count; ++i ) {
+        const char* key = nullptr;
+        uint32_t keySize = 0;
+        if( !ReadString(data, end, key, keySize) ) { return false; }
+        if( !DecodeValue(data, end, outValue[std::string(key, keySize)], depth + 1) ) { return false; }
+      }
+      return true;
+    }
+    default:
+      return false;
+  }
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,87 @@
+/**
+ * File: jsonConfigCache.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Binary cache of parsed json config files, so they don't all have to go through Json::Reader at every
+ *              boot. A cache stands in for one set of source files and is keyed by a hash of their paths, sizes and
+ *              modification times, so adding, removing or changing any of them (e.g. an OTA) invalidates it.
+ *
+ *              The cache file is mapped into memory, and an entry is only decoded (and bounds checked) when it is
+ *              asked for. If the cache is missing or stale, every source file read while it is open is recorded,
+ *              and Save() writes a new one.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Engine_Utils_JsonConfigCache_H__
+#define __Engine_Utils_JsonConfigCache_H__
+
+#include "util/helpers/noncopyable.h"
+
+#include "json/json-forwards.h"
+
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class MappedFile;
+
+class JsonConfigCache : private Util::noncopyable
+{
+public:
+
+  // Opens the cache at cachePath if it was built from exactly these source files
+  JsonConfigCache(const std::string& cachePath, const std::vector<std::string>& sourcePaths);
+  ~JsonConfigCache();
+
+  // True if the cache file matched the source files
+  bool IsValid() const { return _mappedFile != nullptr; }
+
+  // Decodes the cached contents of sourcePath into outValue. Returns false if the cache isn't valid, doesn't have
+  // the file, or the entry is corrupt (in which case the cache file is removed so the next boot rebuilds it).
+  // Safe to call from several threads at once
+  bool Get(const std::string& sourcePath, Json::Value& outValue) const;
+
+  // Records the parsed contents of a source file for Save(). Only needed when the cache isn't valid. Thread safe
+  void Add(const std::string& sourcePath, const Json::Value& value);
+
+  // If the cache wasn't valid, writes a new one from everything passed to Add(). Returns true if a cache was written
+  bool Save();
+
+  // Exposed for tests
+  static void EncodeValue(const Json::Value& value, std::vector<uint8_t>& buffer);
+  static bool DecodeValue(const uint8_t*& data, const uint8_t* end, Json::Value& outValue, uint32_t depth = 0);
+
+private:
+
+  struct Entry {
+    uint32_t valueOffset;
+    uint32_t valueSize;
+  };
+
+  const std::string _cachePath;
+  const uint64_t    _sourceHash;
+
+  std::unique_ptr<MappedFile> _mappedFile;
+  std::unordered_map<std::string, Entry> _entries;
+
+  std::mutex _addedMutex;
+  std::unordered_map<std::string, std::vector<uint8_t>> _added;
+
+  static uint64_t HashSources(const std::vector<std::string>& sourcePaths);
+  bool Open();
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Engine_Utils_JsonConfigCache_H__
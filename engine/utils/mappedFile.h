@@ -0,0 +1,61 @@
+/**
+ * File: mappedFile.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Read only view of a whole file mapped into memory, unmapped when it goes out of scope
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Engine_Utils_MappedFile_H__
+#define __Engine_Utils_MappedFile_H__
+
+#include "util/helpers/noncopyable.h"
+
+#include <stdint.h>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Anki {
+namespace Vector {
+
+class MappedFile : private Util::noncopyable
+{
+public:
+  // leaves the view empty if the file is missing, empty or can't be mapped
+  explicit MappedFile(const std::string& path)
+  {
+    const int fd = open(path.c_str(), O_RDONLY);
+    if ( fd < 0 ) { return; }
+
+    struct stat info;
+    if ( (fstat(fd, &info) == 0) && (info.st_size > 0) ) {
+      void* ptr = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+      if ( ptr != MAP_FAILED ) {
+        _data = static_cast<const uint8_t*>(ptr);
+        _size = info.st_size;
+      }
+    }
+    close(fd);
+  }
+
+  ~MappedFile() { if ( _data != nullptr ) { munmap(const_cast<uint8_t*>(_data), _size); } }
+
+  const uint8_t* GetData() const { return _data; }
+  size_t         GetSize() const { return _size; }
+
+private:
+  const uint8_t* _data = nullptr;
+  size_t         _size = 0;
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Engine_Utils_MappedFile_H__
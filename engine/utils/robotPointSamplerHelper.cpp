@@ -86,18 +86,31 @@ void RejectIfWouldCrossCliff::SetRobotPosition(const Point2f& pos)
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void RejectIfWouldCrossCliff::UpdateCliffs( std::shared_ptr<const INavMap> memoryMap )
 {
-  _cliffs.clear();
+  _cliffEdges.clear();
   if( memoryMap == nullptr ) {
     return;
   }
+  // the same cliff data can be shared by many nodes
+  std::set<const Pose3d*> cliffs;
   MemoryMapTypes::MemoryMapDataConstList wasteList;
-  memoryMap->FindContentIf([this](MemoryMapTypes::MemoryMapDataConstPtr data){
+  memoryMap->FindContentIf([&cliffs](MemoryMapTypes::MemoryMapDataConstPtr data){
     if( data->type == MemoryMapTypes::EContentType::Cliff ) {
       const auto& cliffData = MemoryMapData::MemoryMapDataCast<MemoryMapData_Cliff>(data);
-      _cliffs.insert( &cliffData->pose );
+      cliffs.insert( &cliffData->pose );
     }
     return false; // don't actually gather any data
   }, wasteList);
+  
+  _cliffEdges.reserve( cliffs.size() );
+  for( const auto* cliffPose : cliffs ) {
+    const Vec3f cliffDirection = (cliffPose->GetRotation() * X_AXIS_3D());
+    // do this in 2d
+    const Vec2f cliffEdgeDirection = CrossProduct( Z_AXIS_3D(), cliffDirection ); // sign doesn't matter
+    const Point2f cliffPos = cliffPose->GetTranslation();
+    LineSegment cliffLine{ cliffPos + cliffEdgeDirection * kMaxCliffIntersectionDist_mm,
+                           cliffPos - cliffEdgeDirection * kMaxCliffIntersectionDist_mm };
+    _cliffEdges.push_back( CliffEdge{ cliffPos, cliffEdgeDirection, std::move(cliffLine) } );
+  }
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -106,16 +119,12 @@ bool RejectIfWouldCrossCliff::operator()( const Point2f& sampledPos )
   DEV_ASSERT( _setRobotPos, "RejectIfWouldCrossCliff.CallOperator.UninitializedRobotPos" );
   LineSegment lineRobotToSample{ sampledPos, _robotPos };
   float pAccept = 1.0f; // this may be decremented for multiple cliffs
-  for( const auto* cliffPose : _cliffs ) {
-    const Vec3f cliffDirection = (cliffPose->GetRotation() * X_AXIS_3D());
-    // do this in 2d
-    const Vec2f cliffEdgeDirection = CrossProduct( Z_AXIS_3D(), cliffDirection ); // sign doesn't matter
-    const Point2f cliffPos = cliffPose->GetTranslation();
+  for( const auto& cliffEdge : _cliffEdges ) {
+    const Point2f& cliffPos = cliffEdge.pos;
+    const Vec2f& cliffEdgeDirection = cliffEdge.direction;
     // find intersection of lineRobotToSample with cliffEdgeDirection
-    LineSegment cliffLine{ cliffPos + cliffEdgeDirection * kMaxCliffIntersectionDist_mm,
-                           cliffPos - cliffEdgeDirection * kMaxCliffIntersectionDist_mm };
     Point2f intersectionPoint;
-    const bool intersects = lineRobotToSample.IntersectsAt( cliffLine, intersectionPoint );
+    const bool intersects = lineRobotToSample.IntersectsAt( cliffEdge.line, intersectionPoint );
     if( intersects ) {
       // confirm intersection point lies on cliff edge
       if (!AreVectorsAligned( (intersectionPoint - cliffPos), cliffEdgeDirection, 0.001f )) {
@@ -13,12 +13,14 @@
 #ifndef __Engine_Utils_RobotPointSamplerHelper_H__
 #define __Engine_Utils_RobotPointSamplerHelper_H__
 
+#include "coretech/common/engine/math/lineSegment2d.h"
 #include "coretech/common/engine/math/polygon.h"
 #include "coretech/common/engine/math/pose.h"
 #include "engine/navMap/memoryMap/memoryMapTypes.h"
 #include "util/random/rejectionSamplerHelper.h"
 
 #include <set>
+#include <vector>
 
 namespace Anki{
   
@@ -59,14 +61,21 @@ public:
   // with probability linearly increasing from 0 to 1 over that range
   void SetAcceptanceInterpolant( float maxCliffDist_mm, Util::RandomGenerator& rng );
   
-  // This method caches cliff pointers, so must be called every time you want to use this condition
+  // This method caches the cliff edges, so must be called every time you want to use this condition
   // with the latest memory map data
   void UpdateCliffs( std::shared_ptr<const INavMap> memoryMap );
   
   virtual bool operator()( const Point2f& sampledPos ) override;
   
 private:
-  std::set<const Pose3d*> _cliffs;
+  // A cliff's position and its edge extended kMaxCliffIntersectionDist_mm either way, computed once in
+  // UpdateCliffs instead of for every sample
+  struct CliffEdge {
+    Point2f     pos;
+    Vec2f       direction;
+    LineSegment line;
+  };
+  std::vector<CliffEdge> _cliffEdges;
   Point2f _robotPos;
   bool _setRobotPos = false;
   float _minCliffDistSq;
@@ -24,6 +24,7 @@
 #include "util/console/consoleInterface.h"
 #include "util/helpers/cleanupHelper.h"
 
+#include <chrono>
 #include <set>
 
 #define BLEACHER_CALIB_MARKER_SIZE_MM 14.f
@@ -65,87 +66,50 @@ CameraCalibrator::~CameraCalibrator()
   
 }
 
-Result CameraCalibrator::ComputeCalibrationFromCheckerboard(std::list<Vision::CameraCalibration>& calibration_out,
-                                                            Vision::DebugImageList<Vision::CompressedImage>& debugImages_out)
+Result CameraCalibrator::StartCalibrationFromCheckerboard(Vision::DebugImageList<Vision::CompressedImage>& debugImages_out)
 {
-  std::unique_ptr<Vision::CameraCalibration> calibration;
-  _isCalibrating = true;
-  
-  // Guarantee Calibration mode gets disabled and computed calibration gets sent
-  // no matter how we return from this function
-  Util::CleanupHelper disableCalibration([this, &calibration_out, &calibration]() {
-    if(calibration == nullptr)
-    {
-      PRINT_NAMED_WARNING("CameraCalibrator.ComputeCalibrationFromCheckerboard.NullCalibration", "");
-    }
-    else
-    {
-      calibration_out.push_back(*calibration);
-    }
-    _isCalibrating = false;
-  });
+  if(IsComputingCalibration())
+  {
+    PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.StartCalibrationFromCheckerboard.AlreadyComputing", "");
+    return RESULT_FAIL;
+  }
   
   // Check that there are enough images
   if (_calibImages.size() < kMinNumCalibImages)
   {
-    PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.ComputeCalibrationFromCheckerboard.NotEnoughImages",
+    PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.StartCalibrationFromCheckerboard.NotEnoughImages",
                   "Got %u. Need %u.", (u32)_calibImages.size(), kMinNumCalibImages);
     
     return RESULT_FAIL;
   }
   
-  PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.ComputeCalibrationFromCheckerboard.NumImages",
+  PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.StartCalibrationFromCheckerboard.NumImages",
                 "%u.", (u32)_calibImages.size());
   
-  // Description of asymmetric circles calibration target
   const cv::Size boardSize(kCheckerboardHeight, kCheckerboardWidth);
   const Vision::Image& firstImg = _calibImages.front().img;
-  cv::Size imageSize(firstImg.GetNumCols(), firstImg.GetNumRows());
+  const cv::Size imageSize(firstImg.GetNumCols(), firstImg.GetNumRows());
   
   std::vector<std::vector<cv::Point2f> > imagePoints;
-  std::vector<std::vector<cv::Point3f> > objectPoints(1);
-  
-  // Parameters for circle grid search
-  cv::SimpleBlobDetector::Params params;
-  params.maxArea = kMaxCalibBlobPixelArea;
-  params.minArea = kMinCalibBlobPixelArea;
-  params.minDistBetweenBlobs = kMinCalibPixelDistBetweenBlobs;
-  cv::Ptr<cv::SimpleBlobDetector> blobDetector = cv::SimpleBlobDetector::create(params);
-  const int findCirclesFlags = cv::CALIB_CB_ASYMMETRIC_GRID | cv::CALIB_CB_CLUSTERING;
+  imagePoints.reserve(_numImagesWithDots);
   
   int imgCnt = 0;
-  Vision::Image img(firstImg.GetNumRows(), firstImg.GetNumCols());
-  for (auto & calibImage : _calibImages)
+  for (const auto & calibImage : _calibImages)
   {
-    // Extract the ROI (leaving the rest as zeros)
-    img.FillWith(0);
-    Vision::Image imgROI = img.GetROI(calibImage.roiRect);
-    calibImage.img.GetROI(calibImage.roiRect).CopyTo(imgROI);
-    
-    // Get image points
-    std::vector<cv::Point2f> pointBuf;
-    calibImage.dotsFound = cv::findCirclesGrid(img.get_CvMat_(), boardSize, pointBuf, findCirclesFlags, blobDetector);
-    
     if (calibImage.dotsFound)
     {
-      PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.ComputeCalibrationFromCheckerboard.FoundPoints", "");
-      imagePoints.push_back(pointBuf);
-    }
-    else
-    {
-      PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.ComputeCalibrationFromCheckerboard.NoPointsFound", "");
+      imagePoints.push_back(calibImage.dotPoints);
     }
     
-    
     // Draw image
     if(kDrawCalibImages)
     {
       Vision::ImageRGB dispImg;
-      cv::cvtColor(img.get_CvMat_(), dispImg.get_CvMat_(), cv::COLOR_GRAY2BGR);
+      cv::cvtColor(calibImage.img.get_CvMat_(), dispImg.get_CvMat_(), cv::COLOR_GRAY2BGR);
       
       if (calibImage.dotsFound)
       {
-        cv::drawChessboardCorners(dispImg.get_CvMat_(), boardSize, cv::Mat(pointBuf), calibImage.dotsFound);
+        cv::drawChessboardCorners(dispImg.get_CvMat_(), boardSize, cv::Mat(calibImage.dotPoints), calibImage.dotsFound);
       }
       
       debugImages_out.emplace_back(std::string("CalibImage") + std::to_string(imgCnt), dispImg);
@@ -158,7 +122,7 @@ Result CameraCalibrator::ComputeCalibrationFromCheckerboard(std::list<Vision::Ca
   if(imagePoints.size() < kMinNumCalibImages)
   {
     PRINT_CH_INFO(kLogChannelName,
-                  "CameraCalibrator.ComputeCalibrationFromCheckerboard.InsufficientImagesWithPoints",
+                  "CameraCalibrator.StartCalibrationFromCheckerboard.InsufficientImagesWithPoints",
                   "Points detected in only %u images. Need %u.",
                   (u32)imagePoints.size(), kMinNumCalibImages);
     
@@ -166,65 +130,114 @@ Result CameraCalibrator::ComputeCalibrationFromCheckerboard(std::list<Vision::Ca
   }
   
   // Get object points
+  std::vector<std::vector<cv::Point3f> > objectPoints(1);
   CalcBoardCornerPositions(boardSize, kCheckerboardSquareSize_mm, objectPoints[0]);
   objectPoints.resize(imagePoints.size(), objectPoints[0]);
   
-  // Compute calibration
-  std::vector<cv::Vec3d> rvecs, tvecs;
-  cv::Mat_<f64> cameraMatrix = cv::Mat_<f64>::eye(3, 3);
-  cv::Mat_<f64> distCoeffs   = cv::Mat_<f64>::zeros(1, NUM_RADIAL_DISTORTION_COEFFS);
+  _solveImageSize = imageSize;
+  _solveFuture = std::async(std::launch::async, &CameraCalibrator::SolveCheckerboard,
+                            std::move(objectPoints), std::move(imagePoints), imageSize);
+  
+  return RESULT_OK;
+}
+
+CameraCalibrator::CheckerboardSolution CameraCalibrator::SolveCheckerboard(std::vector<std::vector<cv::Point3f>> objectPoints,
+                                                                         std::vector<std::vector<cv::Point2f>> imagePoints,
+                                                                         cv::Size imageSize)
+{
+  CheckerboardSolution solution;
+  solution.cameraMatrix = cv::Mat_<f64>::eye(3, 3);
+  solution.distCoeffs   = cv::Mat_<f64>::zeros(1, NUM_RADIAL_DISTORTION_COEFFS);
   
-  const f64 rms = cv::calibrateCamera(objectPoints, imagePoints, imageSize, cameraMatrix, distCoeffs, rvecs, tvecs);
+  try
+  {
+    solution.rms = cv::calibrateCamera(objectPoints, imagePoints, imageSize,
+                                       solution.cameraMatrix, solution.distCoeffs,
+                                       solution.rvecs, solution.tvecs);
+    solution.result = RESULT_OK;
+  }
+  catch(cv::Exception& e)
+  {
+    PRINT_NAMED_WARNING("CameraCalibrator.SolveCheckerboard.OpenCVError", "%s", e.what());
+  }
+  
+  return solution;
+}
+
+bool CameraCalibrator::GetCheckerboardCalibration(std::list<Vision::CameraCalibration>& calibration_out,
+                                                  Result& result_out)
+{
+  if(!_solveFuture.valid() ||
+     (std::future_status::ready != _solveFuture.wait_for(std::chrono::seconds(0))))
+  {
+    return false;
+  }
+  
+  const CheckerboardSolution solution = _solveFuture.get();
+  result_out = solution.result;
+  if(RESULT_OK != solution.result)
+  {
+    return true;
+  }
   
   // Copy distortion coefficients into a f32 vector to set CameraCalibration
-  const f64* distCoeffs_data = distCoeffs[0];
+  const f64* distCoeffs_data = solution.distCoeffs[0];
   Vision::CameraCalibration::DistortionCoeffs distCoeffsVec;
   std::copy(distCoeffs_data, distCoeffs_data+NUM_RADIAL_DISTORTION_COEFFS, distCoeffsVec.begin());
   
-  calibration.reset(new Vision::CameraCalibration(imageSize.height, imageSize.width,
-                                                  cameraMatrix(0,0), cameraMatrix(1,1),
-                                                  cameraMatrix(0,2), cameraMatrix(1,2),
-                                                  0.f, // skew
-                                                  distCoeffsVec));
+  const cv::Mat_<f64>& cameraMatrix = solution.cameraMatrix;
+  calibration_out.emplace_back(_solveImageSize.height, _solveImageSize.width,
+                               cameraMatrix(0,0), cameraMatrix(1,1),
+                               cameraMatrix(0,2), cameraMatrix(1,2),
+                               0.f, // skew
+                               distCoeffsVec);
+  const Vision::CameraCalibration& calibration = calibration_out.back();
   
-  DEV_ASSERT_MSG(rvecs.size() == tvecs.size(),
-                 "CameraCalibrator.ComputeCalibrationFromCheckerboard.BadCalibPoseData",
+  DEV_ASSERT_MSG(solution.rvecs.size() == solution.tvecs.size(),
+                 "CameraCalibrator.GetCheckerboardCalibration.BadCalibPoseData",
                  "Got %zu rotations and %zu translations",
-                 rvecs.size(), tvecs.size());
-  
-  _calibPoses.reserve(rvecs.size());
+                 solution.rvecs.size(), solution.tvecs.size());
   
-  for(s32 iPose=0; iPose<rvecs.size(); ++iPose)
+  // There is one pose per image with dots, in order. Line them back up with the images
+  _calibPoses.assign(_calibImages.size(), Pose3d());
+  size_t iPose = 0;
+  for(size_t iImage=0; iImage<_calibImages.size() && iPose<solution.rvecs.size(); ++iImage)
   {
-    auto rvec = rvecs[iPose];
-    auto tvec = tvecs[iPose];
+    if(!_calibImages[iImage].dotsFound)
+    {
+      continue;
+    }
+    
+    const auto& rvec = solution.rvecs[iPose];
+    const auto& tvec = solution.tvecs[iPose];
     RotationVector3d R(Vec3f(rvec[0], rvec[1], rvec[2]));
     Vec3f T(tvec[0], tvec[1], tvec[2]);
     
-    _calibPoses.emplace_back(Pose3d(R, T));
+    _calibPoses[iImage] = Pose3d(R, T);
+    ++iPose;
   }
   
   PRINT_CH_INFO(kLogChannelName,
-                "CameraCalibrator.ComputeCalibrationFromCheckerboard.CalibValues",
+                "CameraCalibrator.GetCheckerboardCalibration.CalibValues",
                 "fx: %f, fy: %f, cx: %f, cy: %f (rms %f)",
-                calibration->GetFocalLength_x(), calibration->GetFocalLength_y(),
-                calibration->GetCenter_x(), calibration->GetCenter_y(), rms);
+                calibration.GetFocalLength_x(), calibration.GetFocalLength_y(),
+                calibration.GetCenter_x(), calibration.GetCenter_y(), solution.rms);
   
   // Check if average reprojection error is too high
   const f64 reprojErrThresh_pix = 0.5;
-  if (rms > reprojErrThresh_pix)
+  if (solution.rms > reprojErrThresh_pix)
   {
     PRINT_CH_INFO(kLogChannelName,
-                  "CameraCalibrator.ComputeCalibrationFromCheckerboard.ReprojectionErrorTooHigh",
-                  "%f > %f", rms, reprojErrThresh_pix);
-    return RESULT_FAIL;
+                  "CameraCalibrator.GetCheckerboardCalibration.ReprojectionErrorTooHigh",
+                  "%f > %f", solution.rms, reprojErrThresh_pix);
+    result_out = RESULT_FAIL;
   }
   
-  return RESULT_OK;
+  return true;
 }
 
 Result CameraCalibrator::ComputeCalibrationFromSingleTarget(CalibTargetType targetType,
-                                                            const std::list<Vision::ObservedMarker>& observedMarkers,
+                                                            const Vision::ObservedMarkerList& observedMarkers,
                                                             std::list<Vision::CameraCalibration>& calibration_out,
                                                             Vision::DebugImageList<Vision::CompressedImage>& debugImages_out)
 {
@@ -468,7 +481,7 @@ Result CameraCalibrator::ComputeCalibrationFromSingleTarget(CalibTargetType targ
 Result CameraCalibrator::AddCalibrationImage(const Vision::Image& calibImg,
                                              const Rectangle<s32>& targetROI)
 {
-  if(_isCalibrating)
+  if(IsCalibrating())
   {
     PRINT_CH_INFO(kLogChannelName,"CameraCalibrator.AddCalibrationImage.AlreadyCalibrating",
                   "Cannot add calibration image while already in the middle of doing calibration.");
@@ -486,16 +499,57 @@ Result CameraCalibrator::AddCalibrationImage(const Vision::Image& calibImg,
   {
     _calibImages.push_back({.img = calibImg, .roiRect = targetROI, .dotsFound = false});
   }
+  
+  // Look for the dots now, one image at a time, rather than in all of them at once when calibrating
+  CalibImage& calibImage = _calibImages.back();
+  FindDots(calibImage);
+  if(calibImage.dotsFound)
+  {
+    ++_numImagesWithDots;
+  }
 
   PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.AddCalibrationImage",
-                "Num images including this: %u", (u32)_calibImages.size());
+                "Num images including this: %u (%zu with dots)", (u32)_calibImages.size(), _numImagesWithDots);
 
   return RESULT_OK;
 }
 
+void CameraCalibrator::FindDots(CalibImage& calibImage) const
+{
+  // Description of asymmetric circles calibration target
+  const cv::Size boardSize(kCheckerboardHeight, kCheckerboardWidth);
+  
+  // Parameters for circle grid search
+  cv::SimpleBlobDetector::Params params;
+  params.maxArea = kMaxCalibBlobPixelArea;
+  params.minArea = kMinCalibBlobPixelArea;
+  params.minDistBetweenBlobs = kMinCalibPixelDistBetweenBlobs;
+  cv::Ptr<cv::SimpleBlobDetector> blobDetector = cv::SimpleBlobDetector::create(params);
+  const int findCirclesFlags = cv::CALIB_CB_ASYMMETRIC_GRID | cv::CALIB_CB_CLUSTERING;
+  
+  // Extract the ROI (leaving the rest as zeros)
+  Vision::Image img(calibImage.img.GetNumRows(), calibImage.img.GetNumCols());
+  img.FillWith(0);
+  Vision::Image imgROI = img.GetROI(calibImage.roiRect);
+  calibImage.img.GetROI(calibImage.roiRect).CopyTo(imgROI);
+  
+  calibImage.dotPoints.clear();
+  calibImage.dotsFound = cv::findCirclesGrid(img.get_CvMat_(), boardSize, calibImage.dotPoints,
+                                             findCirclesFlags, blobDetector);
+  
+  if (calibImage.dotsFound)
+  {
+    PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.FindDots.FoundPoints", "");
+  }
+  else
+  {
+    PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.FindDots.NoPointsFound", "");
+  }
+}
+
 Result CameraCalibrator::ClearCalibrationImages()
 {
-  if(_isCalibrating)
+  if(IsCalibrating())
   {
     PRINT_CH_INFO(kLogChannelName, "CameraCalibrator.ClearCalibrationImages.AlreadyCalibrating",
                   "Cannot clear calibration images while already in the middle of doing calibration.");
@@ -504,6 +558,8 @@ Result CameraCalibrator::ClearCalibrationImages()
   }
   
   _calibImages.clear();
+  _calibPoses.clear();
+  _numImagesWithDots = 0;
   
   return RESULT_OK;
 }
@@ -24,6 +24,9 @@
 
 #include "coretech/common/shared/types.h"
 
+#include "opencv2/core/core.hpp"
+
+#include <future>
 #include <set>
 
 namespace Anki {
@@ -43,19 +46,27 @@ public:
     QBERT,        // Target that looks like a QBert level
   };
   
-  // Computes camera calibration using stored images of checkerboard target
-  // Outputs calibrations and debugImages via reference and returns whether or not calibration succeeded
-  Result ComputeCalibrationFromCheckerboard(std::list<Vision::CameraCalibration>& calibration_out,
-                                            Vision::DebugImageList<Vision::CompressedImage>& debugImages_out);
+  // Starts computing camera calibration from the stored images of the checkerboard target. Dots are found in each
+  // image as it is added, so all that is left is the solve, which runs on a worker thread since it can take seconds.
+  // Outputs debugImages via reference and returns whether the solve was started.
+  Result StartCalibrationFromCheckerboard(Vision::DebugImageList<Vision::CompressedImage>& debugImages_out);
+  
+  // Returns true once the solve started by StartCalibrationFromCheckerboard is done, outputting the calibration
+  // via calibration_out and whether it succeeded via result_out. Call every frame until it returns true.
+  bool GetCheckerboardCalibration(std::list<Vision::CameraCalibration>& calibration_out, Result& result_out);
+  
+  // True while a checkerboard solve is running
+  bool IsComputingCalibration() const { return _solveFuture.valid(); }
   
   // Computes camera calibration using observed markers on either the INVERTED_BOX or QBERT target
   // Outputs calibrations and debugImages via reference and returns whether or not calibration succeeded
   Result ComputeCalibrationFromSingleTarget(CalibTargetType targetType,
-                                            const std::list<Vision::ObservedMarker>& observedMarkers,
+                                            const Vision::ObservedMarkerList& observedMarkers,
                                             std::list<Vision::CameraCalibration>& calibration_out,
                                             Vision::DebugImageList<Vision::CompressedImage>& debugImages_out);
   
-  // Add an image to be stored for calibration along with a region of interest
+  // Add an image to be stored for calibration along with a region of interest, and look for the checkerboard
+  // target's dots in it
   Result AddCalibrationImage(const Vision::Image& calibImg, const Anki::Rectangle<s32>& targetROI);
   
   // Clears all stored calibration images
@@ -64,6 +75,9 @@ public:
   // Returns the number of stored calibration images
   size_t GetNumStoredCalibrationImages() const { return _calibImages.size(); }
   
+  // Returns the number of stored calibration images the checkerboard target's dots were found in
+  size_t GetNumCalibrationImagesWithDots() const { return _numImagesWithDots; }
+  
   // Structure to hold information about each calibration image
   struct CalibImage {
     // Input provided by AddCalibrationImage
@@ -71,18 +85,39 @@ public:
     Rectangle<s32> roiRect;
     
     // Output
-    // Whether of not dots were found in the image (dot checkerboard calibration)
+    // Whether of not dots were found in the image (dot checkerboard calibration), and where
     bool           dotsFound;
+    std::vector<cv::Point2f> dotPoints;
   };
   
   // Returns a vector of all stored calibration images (may or may not have already been used for calibration)
   const std::vector<CalibImage>& GetCalibrationImages() const {return _calibImages;}
   
   // Returns a vector of Camera poses based on where the camera was when taking each CalibImage
-  // Each index matches the corresponding images in _calibImages
+  // Each index matches the corresponding images in _calibImages (poses for images without dots are not valid)
   const std::vector<Pose3d>& GetCalibrationPoses() const { return _calibPoses;}
 
 private:
+  
+  // What the checkerboard solve produces
+  struct CheckerboardSolution {
+    Result                 result = RESULT_FAIL;
+    f64                    rms = 0.0;
+    cv::Mat_<f64>          cameraMatrix;
+    cv::Mat_<f64>          distCoeffs;
+    std::vector<cv::Vec3d> rvecs;
+    std::vector<cv::Vec3d> tvecs;
+  };
+  
+  // Finds the checkerboard target's dots within calibImage's ROI
+  void FindDots(CalibImage& calibImage) const;
+  
+  // Runs cv::calibrateCamera on the given points. Runs on the worker thread, so only touches its arguments
+  static CheckerboardSolution SolveCheckerboard(std::vector<std::vector<cv::Point3f>> objectPoints,
+                                                std::vector<std::vector<cv::Point2f>> imagePoints,
+                                                cv::Size imageSize);
+  
+  bool IsCalibrating() const { return _isCalibrating || IsComputingCalibration(); }
 
   // Calculates expected corner positions of the CHECKERBOARD target with the given board and square
   // sizes
@@ -99,7 +134,11 @@ private:
 
   std::vector<CalibImage> _calibImages;
   std::vector<Pose3d>     _calibPoses;
+  size_t                  _numImagesWithDots = 0;
   bool                    _isCalibrating = false;
+  
+  std::future<CheckerboardSolution> _solveFuture;
+  cv::Size                          _solveImageSize;
 };
   
 }
@@ -4,7 +4,8 @@
  * Author: Andrew Stein
  * Date:   09/24/2018
  *
- * Description: Helper class to compute, cache, and cycle through cropping rectangles for marker detection.
+ * Description: Helper class to compute, cache, and cycle through cropping rectangles for marker detection,
+ *              or to restrict it to the regions where known objects are predicted to appear.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -32,6 +33,12 @@ namespace Vector {
 namespace {
   CONSOLE_VAR_RANGED(f32,  kCropScheduler_MaxMarkerDetectionDist_mm, "Vision.CropScheduler", 500.f, 1.f, 1000.f);
   
+  // Predicted ROIs: how often to look at the scheduled crop instead (1 disables ROIs altogether), how many ROIs to
+  // use at most, and how much to grow each one by (as a fraction of its size) to allow for prediction error
+  CONSOLE_VAR_RANGED(s32,  kCropScheduler_FullSweepPeriod,           "Vision.CropScheduler", 4, 1, 30);
+  CONSOLE_VAR_RANGED(s32,  kCropScheduler_MaxNumROIs,                "Vision.CropScheduler", 4, 1, 16);
+  CONSOLE_VAR_RANGED(f32,  kCropScheduler_ROIPaddingFraction,        "Vision.CropScheduler", 0.5f, 0.f, 2.f);
+  
   // These named constants don't really seem worth exposing as console vars
   const f32 kChargerHeightSlop_mm = 10.f; // Extra height to add to top of charger for vertical crop computation
   const f32 kHeadAngleDownThresh_deg = -10.f; // Head is "down" if angle below this
@@ -264,5 +271,99 @@ bool CropScheduler::GetCropRect(const s32 nrows, const s32 ncols,
   return true;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool CropScheduler::GetCropRects(const s32 nrows, const s32 ncols,
+                                 const bool useHorizontalCycling,
+                                 const bool useVariableHeight,
+                                 const VisionPoseData& poseData,
+                                 const std::vector<Rectangle<s32>>& predictedROIs,
+                                 std::vector<Rectangle<s32>>& cropRects)
+{
+  cropRects.clear();
+  
+  const bool isTimeToSweep = (++_numCallsSinceSweep >= kCropScheduler_FullSweepPeriod);
+  if(!isTimeToSweep && !predictedROIs.empty() && _camera.IsCalibrated())
+  {
+    const f32 scaleX = (f32)ncols / (f32)_camera.GetCalibration()->GetNcols();
+    const f32 scaleY = (f32)nrows / (f32)_camera.GetCalibration()->GetNrows();
+    
+    const size_t numROIs = std::min(predictedROIs.size(), (size_t)kCropScheduler_MaxNumROIs);
+    for(size_t i=0; i<numROIs; ++i)
+    {
+      const Rectangle<s32>& roi = predictedROIs[i];
+      const f32 padX = kCropScheduler_ROIPaddingFraction * (f32)roi.GetWidth();
+      const f32 padY = kCropScheduler_ROIPaddingFraction * (f32)roi.GetHeight();
+      const s32 xmin = std::max(0,     (s32)std::floor(scaleX * ((f32)roi.GetX()    - padX)));
+      const s32 ymin = std::max(0,     (s32)std::floor(scaleY * ((f32)roi.GetY()    - padY)));
+      const s32 xmax = std::min(ncols, (s32)std::ceil (scaleX * ((f32)roi.GetXmax() + padX)));
+      const s32 ymax = std::min(nrows, (s32)std::ceil (scaleY * ((f32)roi.GetYmax() + padY)));
+      if(xmax > xmin && ymax > ymin)
+      {
+        cropRects.emplace_back(xmin, ymin, xmax-xmin, ymax-ymin);
+      }
+    }
+    
+    // Merge overlapping regions, so nothing is searched twice and no marker is split between two of them. A merged
+    // region can overlap ones already checked, so start over after each merge.
+    bool merged = true;
+    while(merged)
+    {
+      merged = false;
+      for(size_t i=0; i<cropRects.size() && !merged; ++i)
+      {
+        for(size_t j=i+1; j<cropRects.size() && !merged; ++j)
+        {
+          const Rectangle<s32>& a = cropRects[i];
+          const Rectangle<s32>& b = cropRects[j];
+          const bool overlaps = (a.GetX() < b.GetXmax() && b.GetX() < a.GetXmax() &&
+                                 a.GetY() < b.GetYmax() && b.GetY() < a.GetYmax());
+          if(overlaps)
+          {
+            const s32 xmin = std::min(a.GetX(), b.GetX());
+            const s32 ymin = std::min(a.GetY(), b.GetY());
+            const s32 xmax = std::max(a.GetXmax(), b.GetXmax());
+            const s32 ymax = std::max(a.GetYmax(), b.GetYmax());
+            cropRects[i] = Rectangle<s32>(xmin, ymin, xmax-xmin, ymax-ymin);
+            cropRects.erase(cropRects.begin() + j);
+            merged = true;
+          }
+        }
+      }
+    }
+    
+    // Regions only pay off if they are smaller than the crop they replace, which is at least this big
+    s32 totalArea = 0;
+    for(const auto& cropRect : cropRects)
+    {
+      totalArea += cropRect.Area();
+    }
+    const s32 scheduledCropArea = std::round(_widthFraction * (f32)(nrows*ncols));
+    
+    if(!cropRects.empty() && totalArea < scheduledCropArea)
+    {
+      if(VERBOSE_DEBUG)
+      {
+        LOG_DEBUG("CropScheduler.GetCropRects.UsingPredictedROIs",
+                  "NumPredicted:%zu NumRects:%zu Frac:%.2f",
+                  predictedROIs.size(), cropRects.size(), (f32)totalArea / (f32)(nrows*ncols));
+      }
+      return true;
+    }
+    
+    cropRects.clear();
+  }
+  
+  _numCallsSinceSweep = 0;
+  
+  Rectangle<s32> cropRect;
+  if(!GetCropRect(nrows, ncols, useHorizontalCycling, useVariableHeight, poseData, cropRect))
+  {
+    return false;
+  }
+  
+  cropRects.push_back(cropRect);
+  return true;
+}
+
 } // namespace Vector
 } // namespace Anki
@@ -4,7 +4,8 @@
  * Author: Andrew Stein
  * Date:   09/24/2018
  *
- * Description: Helper class to compute, cache, and cycle through cropping rectangles for marker detection.
+ * Description: Helper class to compute, cache, and cycle through cropping rectangles for marker detection,
+ *              or to restrict it to the regions where known objects are predicted to appear.
  *
  * Copyright: Anki, Inc. 2018
  **/
@@ -54,6 +55,20 @@ public:
                    const VisionPoseData& poseData,                   
                    Rectangle<s32>& cropRect);
   
+  // Like GetCropRect(), but while there are predictedROIs, returns the regions around them instead of the next
+  // scheduled crop, so that detection cost scales with the number of targets instead of the image area. Every
+  // kCropScheduler_FullSweepPeriod calls, or whenever the regions would cover as much as the scheduled crop anyway,
+  // this falls back to GetCropRect() so that new targets can still be found.
+  // predictedROIs are in calibration resolution and ordered most important first. They are padded, clipped, merged
+  // where they overlap, and rescaled to nrows x ncols.
+  // Returns false if there is nothing to process.
+  bool GetCropRects(const s32 nrows, const s32 ncols,
+                    const bool useHorizontalCycling,
+                    const bool useVariableHeight,
+                    const VisionPoseData& poseData,
+                    const std::vector<Rectangle<s32>>& predictedROIs,
+                    std::vector<Rectangle<s32>>& cropRects);
+  
 private:
   
   enum class CropPosition : u8 {
@@ -69,6 +84,7 @@ private:
   f32 _widthFraction = 0.f;
   std::vector<CropPosition> _cropSchedule;
   s32 _cropIndex = 0;
+  s32 _numCallsSinceSweep = 0;
   
   f32 GetCurrentWidthFraction(const CropPosition cropPosition) const;
   s32 GetCurrentCropX(const CropPosition cropPosition, const s32 ncols, const s32 cropWidth) const;
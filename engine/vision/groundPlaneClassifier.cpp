@@ -16,6 +16,8 @@
 
 #include "coretech/common/engine/math/logisticRegression.h" // TODO this is temporary only for calculateError
 #include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/vision/engine/imageCache.h"
+#include "coretech/vision/engine/scratchArena.h"
 #include "engine/cozmoContext.h"
 #include "engine/overheadEdge.h"
 #include "engine/vision/groundPlaneROI.h"
@@ -56,8 +58,10 @@ void ClassifyImage(const RawPixelsClassifier& clf, const Anki::Vector::IFeatures
  *                    Ground Plane Classifier                   *
  ****************************************************************/
 
-GroundPlaneClassifier::GroundPlaneClassifier(const Json::Value& config, const CozmoContext *context)
+GroundPlaneClassifier::GroundPlaneClassifier(const Json::Value& config, const CozmoContext *context,
+                                             Vision::ScratchArena& scratchArena)
   : _context(context)
+  , _scratchArena(scratchArena)
   , _initialized(false)
   , _profiler("GroundPlaneClassifier")
 {
@@ -104,6 +108,21 @@ Result GroundPlaneClassifier::Update(const Vision::ImageRGB& image, const Vision
                                      Vision::DebugImageList<Vision::CompressedImage>& debugImages,
                                      std::list<OverheadEdgeFrame>& outEdges)
 {
+  return UpdateHelper(image, nullptr, poseData, debugImages, outEdges);
+}
+
+Result GroundPlaneClassifier::Update(Vision::ImageCache& imageCache, const VisionPoseData& poseData,
+                                     Vision::DebugImageList<Vision::CompressedImage>& debugImages,
+                                     std::list<OverheadEdgeFrame>& outEdges)
+{
+  return UpdateHelper(imageCache.GetRGB(), &imageCache, poseData, debugImages, outEdges);
+}
+
+Result GroundPlaneClassifier::UpdateHelper(const Vision::ImageRGB& image, Vision::ImageCache* imageCache,
+                                           const VisionPoseData& poseData,
+                                           Vision::DebugImageList<Vision::CompressedImage>& debugImages,
+                                           std::list<OverheadEdgeFrame>& outEdges)
+{
 
   auto tictoc = _profiler.TicToc("GroundPlaneClassifier.Update");
   // nothing to do here if there's no ground plane visible
@@ -121,10 +140,14 @@ Result GroundPlaneClassifier::Update(const Vision::ImageRGB& image, const Vision
   // STEP 1: Obtain the overhead ground plane image
   GroundPlaneROI groundPlaneROI;
   const Matrix_3x3f& H = poseData.groundPlaneHomography;
-  const Vision::ImageRGB groundPlaneImage = groundPlaneROI.GetOverheadImage(image, H);
+  const Vision::ImageRGB groundPlaneImage = (imageCache != nullptr ?
+                                              groundPlaneROI.GetOverheadImage(*imageCache, H) :
+                                              groundPlaneROI.GetOverheadImage(image, H));
 
   // STEP 2: Classify the overhead image
-  Vision::Image rawClassifiedImage(groundPlaneImage.GetNumRows(), groundPlaneImage.GetNumCols(), u8(0));
+  Vision::Image rawClassifiedImage = _scratchArena.GetImage(groundPlaneImage.GetNumRows(),
+                                                            groundPlaneImage.GetNumCols());
+  rawClassifiedImage.FillWith(0);
   _profiler.Tic("GroundPlaneClassifier.ClassifyImage");
   ClassifyImage(*_classifier.get(), *_extractor.get(), groundPlaneImage, rawClassifiedImage);
   _profiler.Toc("GroundPlaneClassifier.ClassifyImage");
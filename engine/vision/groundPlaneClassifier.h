@@ -23,6 +23,12 @@
 #include "engine/vision/visionPoseData.h"
 
 namespace Anki {
+
+namespace Vision {
+  class ImageCache;
+  class ScratchArena;
+}
+
 namespace Vector {
 
 // Forward declaration
@@ -152,12 +158,18 @@ void CVMatToVector(const cv::Mat& mat, std::vector<T2>& vec)
 class GroundPlaneClassifier
 {
 public:
-  GroundPlaneClassifier(const Json::Value& config, const CozmoContext *context);
+  // The classified image of each Update is taken from scratchArena
+  GroundPlaneClassifier(const Json::Value& config, const CozmoContext *context, Vision::ScratchArena& scratchArena);
 
   Result Update(const Vision::ImageRGB& image, const VisionPoseData& poseData,
                 Vision::DebugImageList<Vision::CompressedImage>& debugImages,
                 std::list<OverheadEdgeFrame>& outEdges);
 
+  // Same, for the cache's default size RGB image, sharing its overhead ground plane warp with other modes
+  Result Update(Vision::ImageCache& imageCache, const VisionPoseData& poseData,
+                Vision::DebugImageList<Vision::CompressedImage>& debugImages,
+                std::list<OverheadEdgeFrame>& outEdges);
+
   bool IsInitialized() const {
     return _initialized;
   }
@@ -173,12 +185,19 @@ protected:
   std::unique_ptr<RawPixelsClassifier> _classifier;
   std::unique_ptr<IFeaturesExtractor> _extractor;
   const CozmoContext* _context;
+  Vision::ScratchArena& _scratchArena;
   bool _initialized = false;
   Anki::Vision::Profiler _profiler;
 
   void TrainClassifier(const std::string& path);
   bool LoadClassifier(const std::string& filename);
 
+  // Warps image into the overhead ground plane image itself if imageCache is null, otherwise gets it from the
+  // cache (in which case image must be the cache's default size RGB image)
+  Result UpdateHelper(const Vision::ImageRGB& image, Vision::ImageCache* imageCache, const VisionPoseData& poseData,
+                      Vision::DebugImageList<Vision::CompressedImage>& debugImages,
+                      std::list<OverheadEdgeFrame>& outEdges);
+
 };
 
 } // namespace Anki
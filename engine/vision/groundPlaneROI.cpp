@@ -15,6 +15,7 @@
 
 #include "coretech/common/engine/math/quad_impl.h"
 #include "coretech/common/shared/math/matrix_impl.h"
+#include "coretech/vision/engine/imageCache.h"
 
 #include "opencv2/core/core.hpp"
 #include "opencv2/imgproc/imgproc.hpp"
@@ -164,39 +165,48 @@ bool GroundPlaneROI::GetImageQuad(const Matrix_3x3f& H, s32 imgWidth, s32 imgHei
   return intersectsImageBorder;
 } // GetImageQuad()
 
-template<class PixelType>
-void GroundPlaneROI::GetOverheadImageHelper(const Vision::ImageBase<PixelType>& image, const Matrix_3x3f& H,
-                                            Vision::ImageBase<PixelType>& overheadImg,
-                                            bool useMask) const
+Matrix_3x3f GroundPlaneROI::GetOverheadShift()
 {
   // Need to apply a shift after the homography to put things in image
   // coordinates with (0,0) at the upper left (since groundQuad's origin
   // is not upper left). Also mirror Y coordinates since we are looking
   // from above, not below
-  Matrix_3x3f InvShift{
+  return Matrix_3x3f{
     1.f, 0.f, _dist, // Negated b/c we're using inv(Shift)
     0.f,-1.f, _widthFar*0.5f,
     0.f, 0.f, 1.f};
+}
+
+template<class PixelType>
+void GroundPlaneROI::ApplyOverheadMask(Vision::ImageBase<PixelType>& overheadImg) const
+{
+  const Vision::Image& mask = GetOverheadMask();
+  
+  DEV_ASSERT(overheadImg.IsContinuous() && mask.IsContinuous(), "Overhead image and mask should be continuous");
   
+  // Zero out masked regions
+  PixelType* imgData = overheadImg.GetDataPointer();
+  const u8* maskData = mask.GetDataPointer();
+  for(s32 i=0; i<_overheadMask.GetNumElements(); ++i) {
+    if(maskData[i] == 0) {
+      imgData[i] = PixelType(0);
+    }
+  }
+}
+
+template<class PixelType>
+void GroundPlaneROI::GetOverheadImageHelper(const Vision::ImageBase<PixelType>& image, const Matrix_3x3f& H,
+                                            Vision::ImageBase<PixelType>& overheadImg,
+                                            bool useMask) const
+{
   // Note that we're applying the inverse homography, so we're doing
   //  inv(Shift * inv(H)), which is the same as  (H * inv(Shift))
-  cv::warpPerspective(image.get_CvMat_(), overheadImg.get_CvMat_(), (H*InvShift).get_CvMatx_(),
+  cv::warpPerspective(image.get_CvMat_(), overheadImg.get_CvMat_(), (H*GetOverheadShift()).get_CvMatx_(),
                       cv::Size(_length, _widthFar), cv::INTER_LINEAR | cv::WARP_INVERSE_MAP);
   
   if(useMask)
   {
-    const Vision::Image& mask = GetOverheadMask();
-    
-    DEV_ASSERT(overheadImg.IsContinuous() && mask.IsContinuous(), "Overhead image and mask should be continuous");
-    
-    // Zero out masked regions
-    PixelType* imgData = overheadImg.GetDataPointer();
-    const u8* maskData = mask.GetDataPointer();
-    for(s32 i=0; i<_overheadMask.GetNumElements(); ++i) {
-      if(maskData[i] == 0) {
-        imgData[i] = PixelType(0);
-      }
-    }
+    ApplyOverheadMask(overheadImg);
   }
 } // GetOverheadImage()
 
@@ -216,6 +226,21 @@ Vision::Image GroundPlaneROI::GetOverheadImage(const Vision::Image &image, const
   return overheadImg;
 }
 
+Vision::ImageRGB GroundPlaneROI::GetOverheadImage(Vision::ImageCache& imageCache, const Matrix_3x3f& H,
+                                                  bool useMask) const
+{
+  const Vision::ImageRGB& sharedImg = imageCache.GetWarpedRGB(H*GetOverheadShift(), _widthFar, _length);
+  if(!useMask)
+  {
+    return sharedImg;
+  }
+  
+  Vision::ImageRGB overheadImg;
+  sharedImg.CopyTo(overheadImg);
+  ApplyOverheadMask(overheadImg);
+  return overheadImg;
+}
+
 
 namespace {
   inline kmRay2 Point2fToRay(const Point2f& from, const Point2f& to ) {
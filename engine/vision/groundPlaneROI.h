@@ -18,6 +18,11 @@
 #include "coretech/common/shared/math/matrix.h"
 
 namespace Anki {
+
+namespace Vision {
+  class ImageCache;
+}
+
 namespace Vector {
 
 class GroundPlaneROI
@@ -66,6 +71,13 @@ public:
                                  const Matrix_3x3f& H,
                                  bool useMask = true) const;
   
+  // Same, for the cache's default size RGB image, but the warp itself is shared through the cache with anyone
+  // else asking for the overhead image of the same frame and homography. Without the mask, the returned image
+  // shares the cache's memory and must not be modified.
+  Vision::ImageRGB GetOverheadImage(Vision::ImageCache& imageCache,
+                                    const Matrix_3x3f& H,
+                                    bool useMask = true) const;
+  
   // Creates the mask on first request and then just returns that one from then on
   const Vision::Image& GetOverheadMask() const;
 
@@ -90,6 +102,12 @@ private:
   
   mutable Vision::Image _overheadMask;
   
+  // Maps overhead image pixels to ground plane coordinates, so that H * GetOverheadShift() maps them to the image
+  static Matrix_3x3f GetOverheadShift();
+  
+  template<class PixelType>
+  void ApplyOverheadMask(Vision::ImageBase<PixelType>& overheadImg) const;
+  
   template<class PixelType>
   void GetOverheadImageHelper(const Vision::ImageBase<PixelType>& image,
                               const Matrix_3x3f& H,
@@ -181,8 +181,7 @@ bool IlluminationDetector::CanRunDetection( const VisionPoseData& poseData ) con
 
 void IlluminationDetector::GenerateFeatures( Vision::ImageCache& cache )
 {
-  Vision::ImageBrightnessHistogram hist;
-  hist.FillFromImage( cache.GetGray(), _featPercSubsample );
+  const Vision::ImageBrightnessHistogram& hist = cache.GetStatistics( _featPercSubsample ).GetHistogram();
   const std::vector<u8> percentiles = hist.ComputePercentiles( _featPercentiles );
   
   if(kEnableExtraIlluminationDetectorDebug)
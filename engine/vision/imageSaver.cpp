@@ -17,18 +17,34 @@
 #include "coretech/vision/engine/undistorter.h"
 #include "engine/vision/imageSaver.h"
 #include "engine/vision/visionProcessingResult.h"
+#include "util/console/consoleInterface.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/math/math.h"
+#include "util/threading/threadPriority.h"
 
 #include "opencv2/imgproc/imgproc.hpp"
 
+#include <algorithm>
 #include <iomanip>
 #include <sstream>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
 
 static const char* kLogChannelName = "VisionSystem";
+
+namespace {
+# define CONSOLE_GROUP_NAME "Vision.ImageSaver"
+  
+  // Most saves that can be waiting for the encoder thread before streamed ones start getting dropped
+  CONSOLE_VAR_RANGED(u32, kImageSaver_MaxQueueLength, CONSOLE_GROUP_NAME, 4, 1, 32);
+  
+  // Off to encode and write on the saving thread, as it used to be
+  CONSOLE_VAR(bool, kImageSaver_SaveAsync, CONSOLE_GROUP_NAME, true);
+  
+# undef CONSOLE_GROUP_NAME
+}
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 ImageSaverParams::ImageSaverParams(const std::string&     pathIn,
@@ -75,16 +91,30 @@ bool ImageSaverParams::SaveConditionTypeFromString(const std::string& str, SaveC
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-// Required here in the .cpp b/c of use of unique_ptr and forward declaration of Undistorter
+// Required here in the .cpp b/c of use of shared_ptr and forward declaration of Undistorter
 ImageSaver::ImageSaver() = default;
-ImageSaver::~ImageSaver() = default;
+
+// Anything still queued is written before returning, since it may be a photo
+ImageSaver::~ImageSaver()
+{
+  {
+    std::lock_guard<std::mutex> lock(_queueMutex);
+    _shutdown = true;
+  }
+  _queueCondition.notify_all();
+  if(_encoderThread.joinable())
+  {
+    _encoderThread.join();
+  }
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void ImageSaver::SetCalibration(const std::shared_ptr<Vision::CameraCalibration>& camCalib)
+void ImageSaver::SetCalibration(const std::shared_ptr<Vision::CameraCalibration>& camCalib,
+                                const std::string& mapCacheDir)
 {
   if(ANKI_VERIFY(nullptr != camCalib, "ImageSaver.SetCalibration.NullCamCalib", ""))
   {
-    _undistorter = std::make_unique<Vision::Undistorter>(camCalib);
+    _undistorter = std::make_shared<Vision::Undistorter>(camCalib, mapCacheDir);
   }
 }
 
@@ -140,6 +170,7 @@ Result ImageSaver::SetParams(const ImageSaverParams& params)
   
   // Use 'em:
   _params = params;
+  _burst = BurstCandidate();
   return RESULT_OK;
 }
   
@@ -202,29 +233,209 @@ bool ImageSaver::ShouldSaveSensorData() const
 Result ImageSaver::Save(Vision::ImageCache& imageCache, const s32 frameNumber)
 {
   const Vision::ImageRGB& cachedImage = imageCache.GetRGB(_params.size);
-  return Save(cachedImage, frameNumber);
+  
+  const bool isBurst = ((ImageSendMode::SingleShot == _params.mode) && (_params.burstLength > 1));
+  if(!isBurst)
+  {
+    return Save(cachedImage, frameNumber);
+  }
+  
+  // Judge sharpness on the small gray image, which the rest of vision has usually already asked the cache for
+  const f32 sharpness = ComputeSharpness(imageCache.GetGray(Vision::ImageCacheSize::Quarter));
+  if(sharpness > _burst.sharpness)
+  {
+    // Only references the cached image's data, which the cache never writes into while it is referenced
+    _burst.image = cachedImage;
+    _burst.frameNumber = frameNumber;
+    _burst.sharpness = sharpness;
+  }
+  ++_burst.numFrames;
+  
+  PRINT_CH_DEBUG(kLogChannelName, "ImageSaver.Save.BurstFrame", "Frame %d of %d: sharpness %.1f (best %.1f)",
+                 _burst.numFrames, _params.burstLength, sharpness, _burst.sharpness);
+  
+  if(_burst.numFrames < _params.burstLength)
+  {
+    return RESULT_OK;
+  }
+  
+  const BurstCandidate best = std::move(_burst);
+  _burst = BurstCandidate();
+  return Save(best.image, best.frameNumber);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+f32 ImageSaver::ComputeSharpness(const Vision::Image& grayImg)
+{
+  if(grayImg.IsEmpty())
+  {
+    return 0.f;
+  }
+  
+  cv::Mat laplacian;
+  cv::Laplacian(grayImg.get_CvMat_(), laplacian, CV_16S);
+  
+  cv::Scalar mean, stddev;
+  cv::meanStdDev(laplacian, mean, stddev);
+  return static_cast<f32>(stddev[0] * stddev[0]);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result ImageSaver::Save(const Vision::ImageRGB& inputImg, const s32 frameNumber)
 {
-  const std::string fullFilename = GetFullFilename(frameNumber, GetExtension(_params.quality));
+  SaveRequest request;
+  request.params = _params;
+  request.result.fullFilename = GetFullFilename(frameNumber, GetExtension(_params.quality));
+  request.result.timestamp = inputImg.GetTimestamp();
+  request.result.frameNumber = frameNumber;
+  request.thumbnailFilename = GetFullFilename(frameNumber, GetThumbnailExtension(_params.quality));
+  request.undistorter = _undistorter;
   
   PRINT_CH_INFO(kLogChannelName, "ImageSaver.Save.SavingImage", "Saving image with timestamp %u to %s",
-                inputImg.GetTimestamp(), fullFilename.c_str());
+                inputImg.GetTimestamp(), request.result.fullFilename.c_str());
   
-  // Resize into a new image to avoid affecting downstream updates
-  Vision::ImageRGB sizedImage;
-  inputImg.CopyTo(sizedImage);
+  // Shares the input's data: the cache moves on to new memory rather than overwrite an image that is still
+  // referenced, and Process makes its own copy before changing anything in place
+  request.image = inputImg;
+  
+  const bool isSingleShot = ((ImageSendMode::SingleShot == _params.mode) ||
+                             (ImageSendMode::SingleShotWithSensorData == _params.mode));
+  if(isSingleShot)
+  {
+    _params.mode = ImageSendMode::Off;
+  }
+  
+  if(!kImageSaver_SaveAsync)
+  {
+    Process(request);
+    Complete(request);
+    return request.result.result;
+  }
   
-  if(_params.removeDistortion)
+  std::vector<SaveRequest> dropped;
+  bool dropNewRequest = false;
+  {
+    std::lock_guard<std::mutex> lock(_queueMutex);
+    
+    if(_queue.size() >= kImageSaver_MaxQueueLength)
+    {
+      // Make room by dropping the oldest streamed image. If there are only single shots queued, they all stay and a
+      // new single shot goes in over the limit, but a new streamed image is the one dropped.
+      auto isStreamed = [](const SaveRequest& queued) {
+        return ((ImageSendMode::SingleShot != queued.params.mode) &&
+                (ImageSendMode::SingleShotWithSensorData != queued.params.mode));
+      };
+      auto oldestStreamed = std::find_if(_queue.begin(), _queue.end(), isStreamed);
+      if(oldestStreamed != _queue.end())
+      {
+        dropped.emplace_back(std::move(*oldestStreamed));
+        _queue.erase(oldestStreamed);
+      }
+      else
+      {
+        dropNewRequest = !isSingleShot;
+      }
+    }
+    
+    if(dropNewRequest)
+    {
+      dropped.emplace_back(std::move(request));
+    }
+    else
+    {
+      _queue.emplace_back(std::move(request));
+    }
+    
+    if(!_encoderThread.joinable())
+    {
+      _encoderThread = std::thread(&ImageSaver::EncoderLoop, this);
+      Util::SetThreadPriority(_encoderThread, Util::ThreadPriority::Low);
+    }
+  }
+  _queueCondition.notify_one();
+  
+  for(auto& droppedRequest : dropped)
+  {
+    PRINT_NAMED_WARNING("ImageSaver.Save.QueueFullDroppingImage",
+                        "Dropping save of image with timestamp %u to %s",
+                        droppedRequest.result.timestamp, droppedRequest.result.fullFilename.c_str());
+    droppedRequest.result.result = RESULT_FAIL;
+    droppedRequest.result.wasDropped = true;
+    Complete(droppedRequest);
+  }
+  
+  return (dropNewRequest ? RESULT_FAIL : RESULT_OK);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageSaver::WaitUntilIdle()
+{
+  std::unique_lock<std::mutex> lock(_queueMutex);
+  _idleCondition.wait(lock, [this]() { return _queue.empty() && !_isProcessing; });
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t ImageSaver::GetNumPendingSaves() const
+{
+  std::lock_guard<std::mutex> lock(_queueMutex);
+  return _queue.size() + (_isProcessing ? 1 : 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageSaver::EncoderLoop()
+{
+  Util::SetThreadName(pthread_self(), "ImageSaver");
+  
+  std::unique_lock<std::mutex> lock(_queueMutex);
+  while(true)
+  {
+    _queueCondition.wait(lock, [this]() { return _shutdown || !_queue.empty(); });
+    if(_queue.empty())
+    {
+      // Only get here on shutdown, once everything queued has been written
+      return;
+    }
+    
+    SaveRequest request(std::move(_queue.front()));
+    _queue.pop_front();
+    _isProcessing = true;
+    lock.unlock();
+    
+    Process(request);
+    Complete(request);
+    
+    lock.lock();
+    _isProcessing = false;
+    if(_queue.empty())
+    {
+      _idleCondition.notify_all();
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageSaver::Complete(const SaveRequest& request)
+{
+  if(request.params.onSaveComplete)
+  {
+    request.params.onSaveComplete(request.result);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ImageSaver::Process(SaveRequest& request)
+{
+  const ImageSaverParams& params = request.params;
+  Vision::ImageRGB& sizedImage = request.image;
+  
+  if(params.removeDistortion)
   {
     // This should have already been checked during SetParams
-    DEV_ASSERT(nullptr != _undistorter, "ImageSaver.Save.NoUndistorter");
+    DEV_ASSERT(nullptr != request.undistorter, "ImageSaver.Save.NoUndistorter");
         
     ScopedTicToc timer("ImageSaver.RemoveDistortion", kLogChannelName);
     Vision::ImageRGB undistortedImage;
-    const Result undistortResult = _undistorter->UndistortImage(sizedImage, undistortedImage);
+    const Result undistortResult = request.undistorter->UndistortImage(sizedImage, undistortedImage);
     if(RESULT_OK != undistortResult)
     {
       PRINT_NAMED_ERROR("ImageSaver.Save.UndistortFailed", "");
@@ -233,17 +444,17 @@ Result ImageSaver::Save(const Vision::ImageRGB& inputImg, const s32 frameNumber)
     }
   }
   
-  if(_params.medianFilterSize > 0)
+  if(params.medianFilterSize > 0)
   {
     ScopedTicToc timer("ImageSaver.MedianFilter", kLogChannelName);
     
     Vision::ImageRGB smoothedImage;
     Result blurResult = RESULT_OK;
     try {
-      cv::medianBlur(sizedImage.get_CvMat_(), smoothedImage.get_CvMat_(), _params.medianFilterSize);
+      cv::medianBlur(sizedImage.get_CvMat_(), smoothedImage.get_CvMat_(), params.medianFilterSize);
     } catch (cv::Exception& e) {
       PRINT_NAMED_ERROR("ImageSaver.Save.OpenCvMedianBlurFailed",
-                        "%s (ksize=%d)", e.what(), (int)_params.medianFilterSize);
+                        "%s (ksize=%d)", e.what(), (int)params.medianFilterSize);
       blurResult = RESULT_FAIL;
     }
     if(RESULT_OK == blurResult) {
@@ -251,15 +462,17 @@ Result ImageSaver::Save(const Vision::ImageRGB& inputImg, const s32 frameNumber)
     }
   }
   
-  if(Util::IsFltGTZero(_params.sharpeningAmount))
+  if(Util::IsFltGTZero(params.sharpeningAmount))
   {
     ScopedTicToc timer("ImageSaver.Sharpening", kLogChannelName);
     
     Vision::ImageRGB imgBlur;
     try {
+      // Sharpened in place, so don't write into the shared input
+      sizedImage.MakeUnique();
       cv::GaussianBlur(sizedImage.get_CvMat_(), imgBlur.get_CvMat_(), cv::Size(3,3), 1.0);
-      cv::addWeighted(sizedImage.get_CvMat_(), 1.0 + _params.sharpeningAmount,
-                      imgBlur.get_CvMat_(), -_params.sharpeningAmount, 0.0,
+      cv::addWeighted(sizedImage.get_CvMat_(), 1.0 + params.sharpeningAmount,
+                      imgBlur.get_CvMat_(), -params.sharpeningAmount, 0.0,
                       sizedImage.get_CvMat_());
     } catch (cv::Exception& e) {
       PRINT_NAMED_ERROR("ImageSaver.Save.SharpenFailed",
@@ -267,34 +480,28 @@ Result ImageSaver::Save(const Vision::ImageRGB& inputImg, const s32 frameNumber)
     }
   }
   
-  if(!Util::IsFltNear(_params.saveScale, 1.f))
+  if(!Util::IsFltNear(params.saveScale, 1.f))
   {
-    sizedImage.Resize(_params.saveScale, Vision::ResizeMethod::Lanczos);
+    sizedImage.Resize(params.saveScale, Vision::ResizeMethod::Lanczos);
   }
   
-  const Result saveResult = sizedImage.Save(fullFilename, _params.quality);
+  const Result saveResult = sizedImage.Save(request.result.fullFilename, params.quality);
   
   Result thumbnailResult = RESULT_OK;
-  if((RESULT_OK == saveResult) && Util::IsFltGTZero(_params.thumbnailScale))
-  {
-    const std::string fullFilename = GetFullFilename(frameNumber, GetThumbnailExtension(_params.quality));
-    Vision::ImageRGB thumbnail;
-    sizedImage.Resize(_params.thumbnailScale);
-    thumbnailResult = sizedImage.Save(fullFilename);
-  }
-  
-  if((ImageSendMode::SingleShot == _params.mode) || (ImageSendMode::SingleShotWithSensorData == _params.mode))
+  if((RESULT_OK == saveResult) && Util::IsFltGTZero(params.thumbnailScale))
   {
-    _params.mode = ImageSendMode::Off;
+    sizedImage.Resize(params.thumbnailScale);
+    thumbnailResult = sizedImage.Save(request.thumbnailFilename);
   }
   
-  Result finalResult = RESULT_OK;
   if((RESULT_OK != saveResult) || (thumbnailResult != RESULT_OK))
   {
-    finalResult = RESULT_FAIL;
+    PRINT_NAMED_WARNING("ImageSaver.Save.WriteFailed", "Image:%s Thumbnail:%s (%s)",
+                        (RESULT_OK == saveResult ? "OK" : "FAIL"),
+                        (RESULT_OK == thumbnailResult ? "OK" : "FAIL"),
+                        request.result.fullFilename.c_str());
+    request.result.result = RESULT_FAIL;
   }
-  
-  return finalResult;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -16,6 +16,15 @@
 #include "clad/types/imageTypes.h"
 #include "clad/types/visionModes.h"
 #include "coretech/vision/engine/imageCache.h"
+#include "coretech/vision/engine/image.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
 
 namespace Anki {
   
@@ -31,9 +40,20 @@ namespace Vector {
 // Forward declaration
 struct VisionProcessingResult;
 
+// Outcome of one save request, reported through ImageSaverParams::onSaveComplete
+struct ImageSaverResult
+{
+  std::string fullFilename;
+  TimeStamp_t timestamp   = 0;
+  s32         frameNumber = 0;
+  Result      result      = RESULT_OK; // RESULT_FAIL if writing the image or its thumbnail failed, or it was dropped
+  bool        wasDropped  = false;     // true if the request never ran because the save queue was full
+};
+
 struct ImageSaverParams
 {
   using Mode = ImageSendMode;
+  using CompletionCallback = std::function<void(const ImageSaverResult&)>;
   
   enum class SaveConditionType : uint8_t {
     ModeProcessed = 0,  // Save when mode was run, whether or not it found anything
@@ -51,9 +71,14 @@ struct ImageSaverParams
   bool                   removeDistortion  = false;
   uint8_t                medianFilterSize  = 0; // 0 to disable
   float                  sharpeningAmount  = 0.f; // 0 to disable
+  uint8_t                burstLength       = 1; // SingleShot only: save the sharpest of this many frames
   
   std::map<VisionMode, SaveConditionType> saveConditions;
   
+  // Called once each requested image has been written (or has failed to be, or was dropped). This runs on the
+  // ImageSaver's encoder thread, so it must be thread safe and quick.
+  CompletionCallback     onSaveComplete;
+  
   ImageSaverParams() = default;
   
   explicit ImageSaverParams(const std::string&     path,
@@ -71,6 +96,9 @@ struct ImageSaverParams
   static bool SaveConditionTypeFromString(const std::string& str, SaveConditionType& saveCondType);
 };
   
+// Images are copied when Save is called and then undistorted, filtered, encoded and written on a low priority
+// encoder thread, so saving doesn't hold up the caller. The queue of pending saves is bounded: when it's full,
+// the oldest pending streamed image is dropped to make room. Single shots (e.g. photos) are never dropped.
 class ImageSaver
 {
 public:
@@ -80,7 +108,9 @@ public:
   virtual ~ImageSaver();
   
   // This must be called before calling SetParams with removeDistortion=true, and before CacheUndistortionMaps
-  void SetCalibration(const std::shared_ptr<Vision::CameraCalibration>& camCalib);
+  // If mapCacheDir is given, undistortion maps are saved there and reloaded for the same calibration
+  void SetCalibration(const std::shared_ptr<Vision::CameraCalibration>& camCalib,
+                      const std::string& mapCacheDir = "");
   
   // Pre-cache maps for undistortion, for a given image size. Will fail if SetCalibration not called yet.
   Result CacheUndistortionMaps(s32 nrows, s32 ncols);
@@ -103,12 +133,27 @@ public:
   // If no basename has been provided in params, will use frameNumber. Otherwise frameNumber is ignored.
   std::string GetFullFilename(const s32 frameNumber, const char* extension) const;
   
-  // Save the specified size image from the cache and a corresponding thumbnail if requested.
+  // Queue the specified size image from the cache to be saved, with a corresponding thumbnail if requested.
+  // Returns RESULT_FAIL if the request had to be dropped. Whether the image was actually written is reported
+  // through the params' onSaveComplete callback.
+  // For a SingleShot with burstLength > 1, each call only considers the frame, and the sharpest of the burst is
+  // queued on the last one. Calls before that return RESULT_OK without saving anything yet.
   Result Save(Vision::ImageCache& imageCache, const s32 frameNumber);
   
-  // Same as above, but uses specific image ("size" parameter will be ignored)
+  // Same as above, but uses specific image ("size" parameter will be ignored). The request only references img's
+  // data, so the caller must not write into img afterwards (images from ImageCache are never written into while
+  // referenced, so those are fine).
   Result Save(const Vision::ImageRGB& img, const s32 frameNumber);
   
+  // Variance of the Laplacian of the image: higher is sharper. Only meaningful for comparing images of the
+  // same scene and size
+  static f32 ComputeSharpness(const Vision::Image& grayImg);
+  
+  // Blocks until every queued save has been written
+  void WaitUntilIdle();
+  
+  size_t GetNumPendingSaves() const;
+  
   // Return the extension for the given quality
   static const char* GetExtension(int8_t forQuality);
   static const char* GetThumbnailExtension(int8_t forQuality);
@@ -117,9 +162,45 @@ private:
   
   using Mode = ImageSaverParams::Mode;
   
+  struct SaveRequest
+  {
+    Vision::ImageRGB image; // own copy, since the cache's and camera's buffers get reused for the next frame
+    ImageSaverParams params;
+    ImageSaverResult result;
+    std::string      thumbnailFilename;
+    std::shared_ptr<Vision::Undistorter> undistorter;
+  };
+  
+  // Post-processes, encodes and writes the image (and thumbnail) of the request, filling in its result
+  static void Process(SaveRequest& request);
+  
+  static void Complete(const SaveRequest& request);
+  
+  void EncoderLoop();
+  
   ImageSaverParams _params;
   
-  std::unique_ptr<Vision::Undistorter> _undistorter;
+  // Sharpest frame so far of the burst in progress
+  struct BurstCandidate
+  {
+    Vision::ImageRGB image;
+    s32              frameNumber = 0;
+    f32              sharpness   = -1.f;
+    u8               numFrames   = 0;
+  };
+  BurstCandidate _burst;
+  
+  // Shared with queued requests, so a new calibration doesn't pull it out from under the encoder thread
+  std::shared_ptr<Vision::Undistorter> _undistorter;
+  
+  // Started on the first Save
+  std::thread                 _encoderThread;
+  mutable std::mutex          _queueMutex;
+  std::condition_variable     _queueCondition;
+  std::condition_variable     _idleCondition;
+  std::deque<SaveRequest>     _queue;
+  bool                        _isProcessing = false;
+  bool                        _shutdown = false;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
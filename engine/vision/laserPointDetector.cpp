@@ -18,6 +18,7 @@
 
 #include "coretech/vision/engine/image_impl.h"
 #include "coretech/vision/engine/imageCache.h"
+#include "coretech/vision/engine/scratchArena.h"
 
 #include "engine/vision/visionSystem.h"
 #include "engine/viz/vizManager.h"
@@ -36,6 +37,18 @@ namespace Params
   // Set > 1 to process at lower resolution for speed
   CONSOLE_VAR_RANGED(s32, kLaser_scaleMultiplier, CONSOLE_GROUP_NAME, 2, 1, 8);
 
+  // Find candidate regions at the coarser kLaser_coarseScaleMultiplier resolution first, and only threshold and
+  // label their neighborhoods at kLaser_scaleMultiplier's resolution
+  CONSOLE_VAR(bool, kLaser_UseCoarseToFine, CONSOLE_GROUP_NAME, false);
+  CONSOLE_VAR_RANGED(s32, kLaser_coarseScaleMultiplier, CONSOLE_GROUP_NAME, 4, 1, 8);
+
+  // Downsampling averages a dot's brightness with its dark surround, so candidates only need to be above this
+  // fraction of the low threshold at coarse resolution
+  CONSOLE_VAR_RANGED(f32, kLaser_coarseThresholdFraction, CONSOLE_GROUP_NAME, 0.8f, 0.f, 1.f);
+
+  // Padding around each candidate's bounding box when searching it at full resolution
+  CONSOLE_VAR(s32, kLaser_coarsePadding_pix, CONSOLE_GROUP_NAME, 4);
+
   // NOTE: these are tuned for 320x240 resolution:
   static const Point2f kRadiusAtResolution{320.f, 240.f};
   CONSOLE_VAR(f32, kLaser_minRadius_pix, CONSOLE_GROUP_NAME, 2.f);
@@ -71,8 +84,27 @@ namespace Params
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-LaserPointDetector::LaserPointDetector(VizManager* vizManager)
+static inline bool UseCoarseToFine()
+{
+  return Params::kLaser_UseCoarseToFine && (Params::kLaser_coarseScaleMultiplier > Params::kLaser_scaleMultiplier);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void GetAreaLimits(const s32 numElements, size_t& minArea, size_t& maxArea)
+{
+  // Make the min/max area threshold resolution-independent
+  const f32 tuningArea = Params::kRadiusAtResolution.x() * Params::kRadiusAtResolution.y();
+  const f32 minAreaFraction = (f32)(Params::kLaser_minRadius_pix * Params::kLaser_minRadius_pix * M_PI_F)/tuningArea;
+  const f32 maxAreaFraction = (f32)(Params::kLaser_maxRadius_pix * Params::kLaser_maxRadius_pix * M_PI_F)/tuningArea;
+
+  minArea = minAreaFraction * (f32)numElements;
+  maxArea = maxAreaFraction * (f32)numElements;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+LaserPointDetector::LaserPointDetector(VizManager* vizManager, Vision::ScratchArena& scratchArena)
 : _vizManager(vizManager)
+, _scratchArena(scratchArena)
 {
 
 }
@@ -154,6 +186,135 @@ Result LaserPointDetector::FindConnectedComponents(const Vision::ImageRGB& imgCo
 {
   DEV_ASSERT(!imgGray.IsEmpty(), "LaserPointDetector.FindConnectedComponents.EmptyGrayImage");
 
+  size_t minArea = 0, maxArea = 0;
+  GetAreaLimits(imgGray.GetNumElements(), minArea, maxArea);
+
+  _connCompStats.clear();
+
+  if(Params::kLaserDetectionDebug > 1)
+  {
+    _debugImage.Allocate(imgGray.GetNumRows(), imgGray.GetNumCols());
+  }
+
+  AddConnectedComponents(imgColor, imgGray, lowThreshold, highThreshold, minArea, maxArea, Point2i(0,0));
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Result LaserPointDetector::FindConnectedComponentsCoarseToFine(Vision::ImageCache& imageCache,
+                                                               const Vision::ImageRGB& imgColor,
+                                                               const Vision::Image& imgGray,
+                                                               const u8 lowThreshold,
+                                                               const u8 highThreshold)
+{
+  DEV_ASSERT(!imgGray.IsEmpty(), "LaserPointDetector.FindConnectedComponentsCoarseToFine.EmptyGrayImage");
+
+  const s32 coarseToFine = Params::kLaser_coarseScaleMultiplier / Params::kLaser_scaleMultiplier;
+  const Vision::ImageCacheSize coarseSize = Vision::ImageCache::GetSize(Params::kLaser_coarseScaleMultiplier);
+
+  // Candidates are the regions above the (lowered) low threshold at coarse resolution
+  const u8 coarseThreshold = std::round(Params::kLaser_coarseThresholdFraction * (f32)lowThreshold);
+  Vision::Image aboveThreshImg;
+  if(!imgColor.IsEmpty())
+  {
+    const bool kAnyChannel = true;
+    aboveThreshImg = imageCache.GetRGB(coarseSize).Threshold(coarseThreshold, kAnyChannel);
+  }
+  else
+  {
+    aboveThreshImg = imageCache.GetGray(coarseSize).Threshold(coarseThreshold);
+  }
+
+  // Sized up front so that labeling fills in the scratch memory instead of allocating
+  Array2d<s32> coarseLabelImage = _scratchArena.GetArray2d<s32>(aboveThreshImg.GetNumRows(),
+                                                                aboveThreshImg.GetNumCols());
+  std::vector<Vision::Image::ConnectedComponentStats> coarseConnCompStats;
+  aboveThreshImg.GetConnectedComponents(coarseLabelImage, coarseConnCompStats);
+
+  size_t minArea = 0, maxArea = 0;
+  GetAreaLimits(imgGray.GetNumElements(), minArea, maxArea);
+
+  // Skip candidates far too big to become a laser point at full resolution (e.g. a window), which would
+  // otherwise cost a search of most of the image
+  const size_t maxCoarseArea = 2 * maxArea / (size_t)(coarseToFine * coarseToFine);
+
+  // Neighborhood of each candidate at full resolution, merging any that overlap so that no region is
+  // labeled twice
+  std::vector<Rectangle<s32>> candidateROIs;
+  const s32 padding = Params::kLaser_coarsePadding_pix;
+  for(s32 iStat=1; iStat < coarseConnCompStats.size(); ++iStat)
+  {
+    const auto& stat = coarseConnCompStats[iStat];
+    if(stat.area > maxCoarseArea)
+    {
+      continue;
+    }
+
+    s32 xmin = stat.boundingBox.GetX()*coarseToFine - padding;
+    s32 ymin = stat.boundingBox.GetY()*coarseToFine - padding;
+    s32 xmax = (stat.boundingBox.GetX() + stat.boundingBox.GetWidth())*coarseToFine + padding;
+    s32 ymax = (stat.boundingBox.GetY() + stat.boundingBox.GetHeight())*coarseToFine + padding;
+
+    bool merged = false;
+    do
+    {
+      merged = false;
+      for(auto iter = candidateROIs.begin(); iter != candidateROIs.end(); ++iter)
+      {
+        const s32 otherXmax = iter->GetX() + iter->GetWidth();
+        const s32 otherYmax = iter->GetY() + iter->GetHeight();
+        const bool overlaps = (iter->GetX() < xmax) && (xmin < otherXmax) && (iter->GetY() < ymax) && (ymin < otherYmax);
+        if(overlaps)
+        {
+          xmin = std::min(xmin, iter->GetX());
+          ymin = std::min(ymin, iter->GetY());
+          xmax = std::max(xmax, otherXmax);
+          ymax = std::max(ymax, otherYmax);
+          candidateROIs.erase(iter);
+          merged = true;
+          break;
+        }
+      }
+    } while(merged);
+
+    candidateROIs.emplace_back(xmin, ymin, xmax-xmin, ymax-ymin);
+  }
+
+  _connCompStats.clear();
+
+  if(Params::kLaserDetectionDebug > 1)
+  {
+    _debugImage.Allocate(imgGray.GetNumRows(), imgGray.GetNumCols());
+    _debugImage.FillWith(0);
+  }
+
+  for(auto& roi : candidateROIs)
+  {
+    // Note that GetROI crops roi to the image
+    const Vision::Image grayROI = imgGray.GetROI(roi);
+    if(grayROI.IsEmpty())
+    {
+      continue;
+    }
+    const Vision::ImageRGB colorROI = (imgColor.IsEmpty() ? Vision::ImageRGB() : imgColor.GetROI(roi));
+
+    AddConnectedComponents(colorROI, grayROI, lowThreshold, highThreshold, minArea, maxArea,
+                           Point2i(roi.GetX(), roi.GetY()));
+  }
+
+  return RESULT_OK;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void LaserPointDetector::AddConnectedComponents(const Vision::ImageRGB& imgColor,
+                                                const Vision::Image& imgGray,
+                                                const u8 lowThreshold,
+                                                const u8 highThreshold,
+                                                const size_t minArea,
+                                                const size_t maxArea,
+                                                const Point2i& origin)
+{
   // Find pixels above the low threshold
   Vision::Image aboveLowThreshImg;
 
@@ -172,21 +333,14 @@ Result LaserPointDetector::FindConnectedComponents(const Vision::ImageRGB& imgCo
 
   DEV_ASSERT(aboveLowThreshImg.GetNumRows() == imgGray.GetNumRows() &&
              aboveLowThreshImg.GetNumCols() == imgGray.GetNumCols(),
-             "LaserPointDetector.FindConnectedComponents.LowThreshImageSizeMismatch");
+             "LaserPointDetector.AddConnectedComponents.LowThreshImageSizeMismatch");
 
   // Get connected components of the regions above the low threshold
-  Array2d<s32> labelImage;
+  Array2d<s32> labelImage = _scratchArena.GetArray2d<s32>(aboveLowThreshImg.GetNumRows(),
+                                                          aboveLowThreshImg.GetNumCols());
   std::vector<Vision::Image::ConnectedComponentStats> allConnCompStats;
   size_t numRegions = aboveLowThreshImg.GetConnectedComponents(labelImage, allConnCompStats);
 
-  // Make the min/max area threshold resolution-independent
-  const f32 tuningArea = Params::kRadiusAtResolution.x() * Params::kRadiusAtResolution.y();
-  const f32 minAreaFraction = (f32)(Params::kLaser_minRadius_pix * Params::kLaser_minRadius_pix * M_PI_F)/tuningArea;
-  const f32 maxAreaFraction = (f32)(Params::kLaser_maxRadius_pix * Params::kLaser_maxRadius_pix * M_PI_F)/tuningArea;
-
-  const size_t minArea = minAreaFraction * (f32)imgGray.GetNumElements();
-  const size_t maxArea = maxAreaFraction * (f32)imgGray.GetNumElements();
-
   // If any pixel within a connected component is above the high threshold,
   // mark that connected component as one we want to keep
   std::vector<bool> isConnCompValid(numRegions,false);
@@ -199,16 +353,19 @@ Result LaserPointDetector::FindConnectedComponents(const Vision::ImageRGB& imgCo
     ConnCompValidityHelper(labelImage, allConnCompStats, imgGray, highThreshold, isConnCompValid);
   }
 
-  // Keep only connected components we selected above that are also within area limits
+  // Keep only connected components we selected above that are also within area limits, in the coordinates of
+  // the image imgGray is a part of
   // Note: start at iStat=1 because we don't care about the 0th connected component, which is "background"
-  _connCompStats.clear();
   for(s32 iStat=1; iStat < allConnCompStats.size(); ++iStat)
   {
     if(isConnCompValid[iStat])
     {
-      auto const& stat = allConnCompStats[iStat];
+      auto stat = allConnCompStats[iStat];
       if(stat.area >= minArea && stat.area <= maxArea)
       {
+        stat.centroid += Point2f(origin.x(), origin.y());
+        stat.boundingBox = Rectangle<s32>(stat.boundingBox.GetX() + origin.x(), stat.boundingBox.GetY() + origin.y(),
+                                          stat.boundingBox.GetWidth(), stat.boundingBox.GetHeight());
         _connCompStats.emplace_back(stat);
       }
     }
@@ -216,13 +373,13 @@ Result LaserPointDetector::FindConnectedComponents(const Vision::ImageRGB& imgCo
 
   if(Params::kLaserDetectionDebug > 1)
   {
-    _debugImage.Allocate(aboveLowThreshImg.GetNumRows(), aboveLowThreshImg.GetNumCols());
-
-    // Record only those connected components that we're keeping in the debug iamge
+    // Record only those connected components that we're keeping in the debug image
+    Rectangle<s32> debugRect(origin.x(), origin.y(), labelImage.GetNumCols(), labelImage.GetNumRows());
+    Vision::ImageRGB debugROI = _debugImage.GetROI(debugRect);
     for(s32 i=0; i<labelImage.GetNumRows(); ++i)
     {
       const s32* labelImage_i = labelImage.GetRow(i);
-      Vision::PixelRGB* debugImg_i = _debugImage.GetRow(i);
+      Vision::PixelRGB* debugImg_i = debugROI.GetRow(i);
 
       for(s32 j=0; j<labelImage.GetNumCols(); ++j)
       {
@@ -231,8 +388,6 @@ Result LaserPointDetector::FindConnectedComponents(const Vision::ImageRGB& imgCo
       }
     }
   }
-
-  return RESULT_OK;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -266,7 +421,9 @@ Result LaserPointDetector::Detect(Vision::ImageCache&   imageCache,
   const u8 lowThreshold  = (isDarkExposure ? Params::kLaser_lowThreshold_darkExposure  : Params::kLaser_lowThreshold_normalExposure );
   const u8 highThreshold = (isDarkExposure ? Params::kLaser_highThreshold_darkExposure : Params::kLaser_highThreshold_normalExposure);
 
-  Result result = FindConnectedComponents(imageColor, imageGray, lowThreshold, highThreshold);
+  Result result = (UseCoarseToFine() ?
+                   FindConnectedComponentsCoarseToFine(imageCache, imageColor, imageGray, lowThreshold, highThreshold) :
+                   FindConnectedComponents(imageColor, imageGray, lowThreshold, highThreshold));
 
   if(RESULT_OK != result)
   {
@@ -418,7 +575,9 @@ Result LaserPointDetector::Detect(Vision::ImageCache& imageCache,
   const u8 lowThreshold  = (isDarkExposure ? Params::kLaser_lowThreshold_darkExposure  : Params::kLaser_lowThreshold_normalExposure );
   const u8 highThreshold = (isDarkExposure ? Params::kLaser_highThreshold_darkExposure : Params::kLaser_highThreshold_normalExposure);
 
-  Result result = FindConnectedComponents(imageColor, imageGray, lowThreshold, highThreshold);
+  Result result = (UseCoarseToFine() ?
+                   FindConnectedComponentsCoarseToFine(imageCache, imageColor, imageGray, lowThreshold, highThreshold) :
+                   FindConnectedComponents(imageColor, imageGray, lowThreshold, highThreshold));
 
   if(RESULT_OK != result)
   {
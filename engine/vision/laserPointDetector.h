@@ -30,6 +30,7 @@ namespace Anki {
   // Forward declaration:
   namespace Vision {
     class ImageCache;
+    class ScratchArena;
   }
 
 namespace Vector {
@@ -42,7 +43,8 @@ class LaserPointDetector
 {
 public:
   
-  LaserPointDetector(VizManager* vizManager);
+  // Label images are taken from scratchArena, so Detect's results must not refer to them
+  LaserPointDetector(VizManager* vizManager, Vision::ScratchArena& scratchArena);
   
   // If imageInColor is not empty, extra checks are done to verify red/green color saturation.
   // Otherwise, imageInGray is used for detecting potential laser dots.
@@ -66,6 +68,24 @@ private:
                                  const u8 lowThreshold,
                                  const u8 highThreshold);
 
+  // Same result as above for all but marginal regions, but only labels the neighborhoods of candidate regions
+  // found in a coarser image from the cache. imgColor and imgGray are the full resolution images.
+  Result FindConnectedComponentsCoarseToFine(Vision::ImageCache&     imageCache,
+                                             const Vision::ImageRGB& imgColor,
+                                             const Vision::Image&    imgGray,
+                                             const u8 lowThreshold,
+                                             const u8 highThreshold);
+
+  // Labels the given images (or parts of images, whose top left corner is at origin) and adds the valid
+  // components to _connCompStats, in whole image coordinates
+  void AddConnectedComponents(const Vision::ImageRGB& imgColor,
+                              const Vision::Image&    imgGray,
+                              const u8 lowThreshold,
+                              const u8 highThreshold,
+                              const size_t minArea,
+                              const size_t maxArea,
+                              const Point2i& origin);
+
   size_t FindLargestRegionCentroid(const Vision::ImageRGB& imgColor,
                                    const Vision::Image&    imgGray,
                                    const Quad2f&           groundQuadInImage,
@@ -80,6 +100,7 @@ private:
                    const f32 redThreshold, const f32 greenThreshold);
 
   VizManager*   _vizManager    = nullptr;
+  Vision::ScratchArena& _scratchArena;
 
   std::vector<Vision::Image::ConnectedComponentStats> _connCompStats;
 
@@ -13,6 +13,7 @@
 #include "anki/cozmo/shared/cozmoConfig.h"
 #include "coretech/common/engine/math/polygon_impl.h"
 #include "coretech/common/engine/utils/timer.h"
+#include "coretech/vision/engine/imageBuffer/conversions/imageConversions.h"
 #include "coretech/vision/engine/image_impl.h"
 #include "engine/vision/mirrorModeManager.h"
 #include "engine/vision/visionModesHelpers.h"
@@ -39,6 +40,13 @@ namespace {
   f32 kXmax = (f32)DEFAULT_CAMERA_RESOLUTION_WIDTH;
   f32 kHeightScale = (f32)FACE_DISPLAY_HEIGHT / (f32)DEFAULT_CAMERA_RESOLUTION_HEIGHT;
   f32 kWidthScale  = (f32)FACE_DISPLAY_WIDTH / (f32)DEFAULT_CAMERA_RESOLUTION_WIDTH;
+  
+  // Detections are drawn after the camera image is already in the display's pixel format, so on displays which
+  // expect BGR565 their colors are swapped to match
+  inline ColorRGBA GetScreenColor(const ColorRGBA& color)
+  {
+    return (IsXray() ? ColorRGBA(color.b(), color.g(), color.r(), color.alpha()) : color);
+  }
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -95,12 +103,12 @@ static Polygon<2,T> DisplayMirroredPolyHelper(const Polygon<2,T>& poly)
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void MirrorModeManager::DrawVisionMarkers(const std::list<Vision::ObservedMarker>& visionMarkers)
+void MirrorModeManager::DrawVisionMarkers(const Vision::ObservedMarkerList& visionMarkers)
 {
   for(auto const& visionMarker : visionMarkers)
   {
-    const ColorRGBA& drawColor = (visionMarker.GetCode() == Vision::MARKER_UNKNOWN ?
-                                  NamedColors::BLUE : NamedColors::RED);
+    const ColorRGBA drawColor = GetScreenColor(visionMarker.GetCode() == Vision::MARKER_UNKNOWN ?
+                                               NamedColors::BLUE : NamedColors::RED);
     
     const auto& quad = visionMarker.GetImageCorners();
     const auto& name = std::string(visionMarker.GetCodeName());
@@ -115,7 +123,7 @@ void MirrorModeManager::DrawVisionMarkers(const std::list<Vision::ObservedMarker
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-void MirrorModeManager::DrawFaces(const std::list<Vision::TrackedFace>& faceDetections)
+void MirrorModeManager::DrawFaces(const std::vector<Vision::TrackedFace>& faceDetections)
 {
   for(auto const& faceDetection : faceDetections)
   {
@@ -131,7 +139,7 @@ void MirrorModeManager::DrawFaces(const std::list<Vision::TrackedFace>& faceDete
     }
 
     _screenImg.DrawRect(DisplayMirroredRectHelper(rect.GetX(), rect.GetY(), rect.GetWidth(), rect.GetHeight()),
-                        color, 3);
+                        GetScreenColor(color), 3);
     
     const auto& debugInfo = faceDetection.GetRecognitionDebugInfo();
     if(!debugInfo.empty())
@@ -144,7 +152,8 @@ void MirrorModeManager::DrawFaces(const std::list<Vision::TrackedFace>& faceDete
         std::string dispName(name.empty() ? "<unknown>" : name);
         dispName += "[" + std::to_string(info.matchedID) + "]: " + std::to_string(info.score);
         const Point2f position{1.f, _screenImg.GetNumRows()-1-(debugInfo.size()-line)*(fontSize.y()+1)};
-        _screenImg.DrawText(position, dispName, NamedColors::YELLOW, kMirrorModeFaceDebugFontScale, true);
+        _screenImg.DrawText(position, dispName, GetScreenColor(NamedColors::YELLOW),
+                            kMirrorModeFaceDebugFontScale, true);
         ++line;
       }
     }
@@ -153,7 +162,8 @@ void MirrorModeManager::DrawFaces(const std::list<Vision::TrackedFace>& faceDete
       const float kFontScale = 0.6f;
       std::string dispName(name.empty() ? "<unknown>" : name);
       dispName += "[" + std::to_string(faceID) + "]";
-      _screenImg.DrawText({1.f, _screenImg.GetNumRows()-1}, dispName, NamedColors::YELLOW, kFontScale, true);
+      _screenImg.DrawText({1.f, _screenImg.GetNumRows()-1}, dispName, GetScreenColor(NamedColors::YELLOW),
+                          kFontScale, true);
     }
   }
 }
@@ -175,7 +185,7 @@ void MirrorModeManager::DrawAutoExposure(const VisionProcessingResult& procResul
   const bool kUseDropShadow = true;
   Vec2f textSize = _screenImg.GetTextSize(exposureStr, kFontScale, 1);
   _screenImg.DrawText({_screenImg.GetNumCols() - textSize.x() - 1, _screenImg.GetNumRows()-1}, 
-                      exposureStr, NamedColors::RED, kFontScale, kUseDropShadow);
+                      exposureStr, GetScreenColor(NamedColors::RED), kFontScale, kUseDropShadow);
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -233,9 +243,9 @@ void MirrorModeManager::DrawSalientPoints(const VisionProcessingResult& procResu
     const Vision::SalientPoint& salientPoint = salientPointToDraw.second;
     
     const Poly2f poly(salientPoint.shape);
-    const ColorRGBA color = (salientPoint.description.empty() ?
-                             NamedColors::RED :
-                             ColorRGBA::CreateFromColorIndex(colorIndex++));
+    const ColorRGBA color = GetScreenColor(salientPoint.description.empty() ?
+                                           NamedColors::RED :
+                                           ColorRGBA::CreateFromColorIndex(colorIndex++));
     
     const std::string caption(salientPoint.description + "[" + std::to_string((s32)std::round(100.f*salientPoint.score))
                               + "] t:" + std::to_string(salientPoint.timestamp));
@@ -250,7 +260,7 @@ void MirrorModeManager::DrawSalientPoints(const VisionProcessingResult& procResu
     {
       const bool kDropShadow = true;
       const bool kCentered = true;
-      _screenImg.DrawText(mirroredCentroid, str, NamedColors::YELLOW, 0.6f, kDropShadow, 1, kCentered);
+      _screenImg.DrawText(mirroredCentroid, str, GetScreenColor(NamedColors::YELLOW), 0.6f, kDropShadow, 1, kCentered);
     }
     
     _screenImg.DrawFilledCircle(mirroredCentroid, color, 3);
@@ -262,10 +272,23 @@ void MirrorModeManager::DrawSalientPoints(const VisionProcessingResult& procResu
 Result MirrorModeManager::CreateMirrorModeImage(const Vision::ImageRGB& cameraImg,
                                                 VisionProcessingResult& visionProcResult)
 {
-  cameraImg.Resize(_screenImg, Vision::ResizeMethod::NearestNeighbor);
-
-  // Flip image around the y axis (before we draw anything on it)
-  cv::flip(_screenImg.get_CvMat_(), _screenImg.get_CvMat_(), 1);
+  // Use gamma to make it easier to see
+  if(!Util::IsFltNear(_currentGamma, kMirrorModeGamma)) {
+    _currentGamma = kMirrorModeGamma;
+    const f32 invGamma = 1.f / _currentGamma;
+    const f32 divisor = 1.f / 255.f;
+    for(s32 value=0; value<256; ++value)
+    {
+      _gammaLUT[value] = std::round(255.f * std::powf((f32)value * divisor, invGamma));
+    }
+  }
+  
+  // The last frame's image may still be on its way to the face
+  _screenPool.PrepareForWrite(_screenImg);
+  
+  // Resize, flip around the y axis (before we draw anything on it), apply gamma and convert to the display's
+  // format all at once, then draw straight onto the result
+  Vision::ImageConversions::ResizeMirroredToRGB565(cameraImg, _gammaLUT, IsXray(), _screenImg);
 
   if(kDisplayDetectionsInMirrorMode)
   {
@@ -279,22 +302,8 @@ Result MirrorModeManager::CreateMirrorModeImage(const Vision::ImageRGB& cameraIm
     DrawAutoExposure(visionProcResult);
   }
   
-  // Use gamma to make it easier to see
-  if(!Util::IsFltNear(_currentGamma, kMirrorModeGamma)) {
-    _currentGamma = kMirrorModeGamma;
-    const f32 invGamma = 1.f / _currentGamma;
-    const f32 divisor = 1.f / 255.f;
-    for(s32 value=0; value<256; ++value)
-    {
-      _gammaLUT[value] = std::round(255.f * std::powf((f32)value * divisor, invGamma));
-    }
-  }
-  
-  if (IsXray()) {
-    visionProcResult.mirrorModeImg.SetFromImageRGB2BGR(_screenImg, _gammaLUT);
-  } else {
-    visionProcResult.mirrorModeImg.SetFromImageRGB(_screenImg, _gammaLUT);
-  }
+  // Shared rather than copied: the next frame is drawn into another image if this one is still in use
+  visionProcResult.mirrorModeImg = _screenImg;
 
   return RESULT_OK;
 }
@@ -15,15 +15,17 @@
 
 #include "coretech/common/shared/types.h"
 #include "coretech/vision/engine/image.h"
+#include "coretech/vision/engine/imagePool.h"
+#include "coretech/vision/engine/visionMarker.h"
 #include "engine/engineTimeStamp.h"
 
 #include <list>
+#include <vector>
 
 namespace Anki {
 
 // Forward declarations
 namespace Vision {
-  class ObservedMarker;
   class TrackedFace;
   struct SalientPoint;
 }
@@ -44,13 +46,14 @@ public:
   
 private:
   
-  Vision::ImageRGB _screenImg;
+  Vision::ImageRGB565 _screenImg;
+  Vision::ImagePool<Vision::ImageRGB565> _screenPool;
   std::list<std::pair<EngineTimeStamp_t, Vision::SalientPoint>> _salientPointsToDraw;
   std::array<u8,256> _gammaLUT;
   f32 _currentGamma = 0.f;
   
-  void DrawVisionMarkers(const std::list<Vision::ObservedMarker>& visionMarkers);
-  void DrawFaces(const std::list<Vision::TrackedFace>& faceDetections);
+  void DrawVisionMarkers(const Vision::ObservedMarkerList& visionMarkers);
+  void DrawFaces(const std::vector<Vision::TrackedFace>& faceDetections);
   void DrawSalientPoints(const VisionProcessingResult& procResult);
   void DrawAutoExposure(const VisionProcessingResult& procResult);
   
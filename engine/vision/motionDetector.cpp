@@ -17,6 +17,7 @@
 #include "coretech/common/engine/math/quad_impl.h"
 #include "coretech/vision/engine/camera.h"
 #include "coretech/vision/engine/imageCache.h"
+#include "coretech/vision/engine/scratchArena.h"
 #include "coretech/common/engine/jsonTools.h"
 #include "engine/vision/visionPoseData.h"
 #include "engine/viz/vizManager.h"
@@ -24,6 +25,7 @@
 
 #include <opencv2/highgui/highgui.hpp>
 #include <iomanip>
+#include <utility>
 
 
 namespace Anki {
@@ -73,6 +75,9 @@ namespace {
   CONSOLE_VAR(u32,  kMotionDetection_BlurFilterSize_pix, CONSOLE_GROUP_NAME, 21);
   
   CONSOLE_VAR(bool, kMotionDetectionDebug, CONSOLE_GROUP_NAME, false);
+
+  // Use the NEON kernels where they were built in. Off runs the scalar versions, for comparing the two
+  CONSOLE_VAR(bool, kMotionDetection_UseNeon, CONSOLE_GROUP_NAME, true);
   
 # undef CONSOLE_GROUP_NAME
 }
@@ -359,12 +364,14 @@ private:
 static const char * const kLogChannelName = "VisionSystem";
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-MotionDetector::MotionDetector(const Vision::Camera &camera, VizManager *vizManager, const Json::Value &config)
+MotionDetector::MotionDetector(const Vision::Camera &camera, VizManager *vizManager, const Json::Value &config,
+                               Vision::ScratchArena &scratchArena)
 :
   _regionSelector(nullptr) //need image size information before we can build this
 , _camera(camera)
 , _vizManager(vizManager)
 , _config(config)
+, _scratchArena(scratchArena)
 {
   DEV_ASSERT(kMotionDetection_MinBrightness > 0, "MotionDetector.Constructor.MinBrightnessIsZero");
 
@@ -386,22 +393,78 @@ bool MotionDetector::HavePrevImage<Vision::Image>() const
   return !_prevImageGray.IsEmpty();
 }
 
-void MotionDetector::SetPrevImage(const Vision::Image &image, bool wasBlurred)
+template<>
+inline Vision::Image& MotionDetector::GetPrevImage()
+{
+  return _prevImageGray;
+}
+
+template<>
+inline Vision::ImageRGB& MotionDetector::GetPrevImage()
+{
+  return _prevImageRGB;
+}
+ 
+template<>
+inline bool MotionDetector::WasPrevImageBlurred<Vision::Image>() const {
+  return _wasPrevImageGrayBlurred;
+}
+
+template<>
+inline bool MotionDetector::WasPrevImageBlurred<Vision::ImageRGB>() const {
+  return _wasPrevImageRGBBlurred;
+}
+
+// Only (re)allocates when the size changes, so normally this hands back the buffer swapped out last time
+template<>
+inline Vision::Image& MotionDetector::GetNextImage(s32 numRows, s32 numCols)
+{
+  if(_nextImageGray.GetNumRows() != numRows || _nextImageGray.GetNumCols() != numCols) {
+    _nextImageGray.Allocate(numRows, numCols);
+  }
+  return _nextImageGray;
+}
+
+template<>
+inline Vision::ImageRGB& MotionDetector::GetNextImage(s32 numRows, s32 numCols)
+{
+  if(_nextImageRGB.GetNumRows() != numRows || _nextImageRGB.GetNumCols() != numCols) {
+    _nextImageRGB.Allocate(numRows, numCols);
+  }
+  return _nextImageRGB;
+}
+
+// Images are reference counted headers, so swapping them doesn't touch pixel data
+template<>
+void MotionDetector::SwapPrevImage<Vision::Image>(bool wasBlurred)
 {
-  image.CopyTo(_prevImageGray);
+  std::swap(_prevImageGray, _nextImageGray);
   _wasPrevImageGrayBlurred = wasBlurred;
   _wasPrevImageRGBBlurred = false;
   _prevImageRGB = Vision::ImageRGB();
 }
 
-void MotionDetector::SetPrevImage(const Vision::ImageRGB &image, bool wasBlurred)
+template<>
+void MotionDetector::SwapPrevImage<Vision::ImageRGB>(bool wasBlurred)
 {
-  image.CopyTo(_prevImageRGB);
+  std::swap(_prevImageRGB, _nextImageRGB);
   _wasPrevImageRGBBlurred = wasBlurred;
   _wasPrevImageGrayBlurred = false;
   _prevImageGray = Vision::Image();
 }
 
+void MotionDetector::SetPrevImage(const Vision::Image &image, bool wasBlurred)
+{
+  image.CopyTo(GetNextImage<Vision::Image>(image.GetNumRows(), image.GetNumCols()));
+  SwapPrevImage<Vision::Image>(wasBlurred);
+}
+
+void MotionDetector::SetPrevImage(const Vision::ImageRGB &image, bool wasBlurred)
+{
+  image.CopyTo(GetNextImage<Vision::ImageRGB>(image.GetNumRows(), image.GetNumCols()));
+  SwapPrevImage<Vision::ImageRGB>(wasBlurred);
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 s32 MotionDetector::RatioTest(const Vision::ImageRGB& image, Vision::Image& ratioImg)
 {
@@ -411,10 +474,11 @@ s32 MotionDetector::RatioTest(const Vision::ImageRGB& image, Vision::Image& rati
   u32 numAboveThresh = 0;
   
 #ifdef __ARM_NEON__
-
-  return RatioTestNeon(image, ratioImg);
-
-#else
+  if(kMotionDetection_UseNeon)
+  {
+    return RatioTestNeon(image, ratioImg);
+  }
+#endif
 
   // somehow auto doens't work here... the right type cannot be deduced. Bug in clang?
   std::function<u8(const Vision::PixelRGB& thisElem, const Vision::PixelRGB& otherElem)> ratioTest =
@@ -437,8 +501,6 @@ s32 MotionDetector::RatioTest(const Vision::ImageRGB& image, Vision::Image& rati
   };
   
   image.ApplyScalarFunction(ratioTest, _prevImageRGB, ratioImg);
-
-#endif
   
   return numAboveThresh;
 }
@@ -451,10 +513,11 @@ s32 MotionDetector::RatioTest(const Vision::Image& image, Vision::Image& ratioIm
   s32 numAboveThresh = 0;
 
 #ifdef __ARM_NEON__
-
-  return RatioTestNeon(image, ratioImg);
-
-#else
+  if(kMotionDetection_UseNeon)
+  {
+    return RatioTestNeon(image, ratioImg);
+  }
+#endif
   
   std::function<u8(const u8& thisElem, const u8& otherElem)> ratioTest = [&numAboveThresh](const u8& p1, const u8& p2)
   {
@@ -473,8 +536,6 @@ s32 MotionDetector::RatioTest(const Vision::Image& image, Vision::Image& ratioIm
   };
   
   image.ApplyScalarFunction(ratioTest, _prevImageGray, ratioImg);
-
-#endif
   
   return numAboveThresh;
 }
@@ -574,12 +635,13 @@ Result MotionDetector::DetectHelper(const ImageType &image,
     ExternalInterface::RobotObservedMotion msg;
     msg.timestamp = image.GetTimestamp();
 
-    // Remove noise here before motion detection
-    ImageType blurredImage(image.GetNumRows(), image.GetNumCols());
+    // Remove noise here before motion detection. The blurred image goes straight into the spare previous image
+    // buffer, so storing it for next time is just a swap
+    ImageType& blurredImage = GetNextImage<ImageType>(image.GetNumRows(), image.GetNumCols());
     FilterImageAndPrevImages<ImageType>(image, blurredImage);
 
     // Create the ratio test image
-    Vision::Image foregroundMotion(blurredImage.GetNumRows(), blurredImage.GetNumCols());
+    Vision::Image foregroundMotion = _scratchArena.GetImage(blurredImage.GetNumRows(), blurredImage.GetNumCols());
     s32 numAboveThresh = RatioTest(blurredImage, foregroundMotion);
 
     // Run the peripheral motion detection
@@ -600,9 +662,9 @@ Result MotionDetector::DetectHelper(const ImageType &image,
       observedMotions.emplace_back(std::move(msg));
     }
     
-    // Store a blurred copy of the current image for next time (at correct resolution!)
+    // Keep the blurred current image for next time (at correct resolution!)
     const bool kBlurHappened = true;
-    SetPrevImage(blurredImage, kBlurHappened);
+    SwapPrevImage<ImageType>(kBlurHappened);
     
   } // if(headSame && poseSame)
   else
@@ -743,14 +805,13 @@ void MotionDetector::ExtractGroundPlaneMotion(s32 origNumRows, s32 origNumCols,
   imgQuad *= 1.f / scaleMultiplier;
 
   Rectangle<s32> boundingRect(imgQuad);
-  Vision::Image groundPlaneForegroundMotion;
-  foregroundMotion.GetROI(boundingRect).CopyTo(groundPlaneForegroundMotion);
+  const Vision::Image foregroundMotionROI = foregroundMotion.GetROI(boundingRect);
 
   // Zero out everything in the ratio image that's not inside the ground plane quad
   imgQuad -= boundingRect.GetTopLeft().CastTo<float>();
 
-  Vision::Image mask(groundPlaneForegroundMotion.GetNumRows(),
-                     groundPlaneForegroundMotion.GetNumCols());
+  Vision::Image mask = _scratchArena.GetImage(foregroundMotionROI.GetNumRows(),
+                                              foregroundMotionROI.GetNumCols());
   mask.FillWith(0);
   fillConvexPoly(mask.get_CvMat_(), std::vector<cv::Point>{
         imgQuad[Quad::TopLeft].get_CvPoint_(),
@@ -759,13 +820,21 @@ void MotionDetector::ExtractGroundPlaneMotion(s32 origNumRows, s32 origNumCols,
         imgQuad[Quad::BottomLeft].get_CvPoint_(),
       }, 255);
 
+  // Masking is done while copying out of the ROI, rather than copying it first and masking in place
+  Vision::Image groundPlaneForegroundMotion = _scratchArena.GetImage(mask.GetNumRows(), mask.GetNumCols());
   for(s32 i=0; i<mask.GetNumRows(); ++i) {
+    const u8* roiData_i = foregroundMotionROI.GetRow(i);
     const u8* maskData_i = mask.GetRow(i);
     u8* fgMotionData_i = groundPlaneForegroundMotion.GetRow(i);
+#ifdef __ARM_NEON__
+    if(kMotionDetection_UseNeon)
+    {
+      ApplyMaskNeon(roiData_i, maskData_i, fgMotionData_i, mask.GetNumCols());
+      continue;
+    }
+#endif
     for(s32 j=0; j<mask.GetNumCols(); ++j) {
-      if(maskData_i[j] == 0) {
-        fgMotionData_i[j] = 0;
-      }
+      fgMotionData_i[j] = (maskData_i[j] == 0 ? 0 : roiData_i[j]);
     }
   }
 
@@ -847,28 +916,6 @@ void MotionDetector::ExtractGroundPlaneMotion(s32 origNumRows, s32 origNumCols,
   }
 }
 
-template<>
-inline Vision::Image& MotionDetector::GetPrevImage()
-{
-  return _prevImageGray;
-}
-
-template<>
-inline Vision::ImageRGB& MotionDetector::GetPrevImage()
-{
-  return _prevImageRGB;
-}
- 
-template<>
-inline bool MotionDetector::WasPrevImageBlurred<Vision::Image>() const {
-  return _wasPrevImageGrayBlurred;
-}
-
-template<>
-inline bool MotionDetector::WasPrevImageBlurred<Vision::ImageRGB>() const {
-  return _wasPrevImageRGBBlurred;
-}
-  
 template <class ImageType>
 void MotionDetector::FilterImageAndPrevImages(const ImageType& image, ImageType& blurredImage)
 {
@@ -899,7 +946,8 @@ bool MotionDetector::DetectPeripheralMotionHelper(Vision::Image &ratioImage,
   }
 
   // Get the connected components with stats
-  Array2d<s32> labelImage;
+  // Sized up front so that labeling fills in the scratch memory instead of allocating
+  Array2d<s32> labelImage = _scratchArena.GetArray2d<s32>(ratioImage.GetNumRows(), ratioImage.GetNumCols());
   std::vector<Vision::Image::ConnectedComponentStats> stats;
   ratioImage.GetConnectedComponents(labelImage, stats);
 
@@ -1124,6 +1172,13 @@ size_t MotionDetector::GetCentroid(const Vision::Image& motionImg, Point2f& cent
   for(s32 y=0; y<motionImg.GetNumRows(); ++y)
   {
     const u8* motionData_y = motionImg.GetRow(y);
+#ifdef __ARM_NEON__
+    if(kMotionDetection_UseNeon)
+    {
+      AppendNonZeroElementsNeon(motionData_y, motionImg.GetNumCols(), y, xValues, yValues);
+      continue;
+    }
+#endif
     for(s32 x=0; x<motionImg.GetNumCols(); ++x) {
       if(motionData_y[x] != 0) {
         xValues.push_back(x);
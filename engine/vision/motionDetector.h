@@ -31,6 +31,7 @@ namespace Vision {
 class Camera;
 
 class ImageCache;
+class ScratchArena;
 }
 
 namespace Vector {
@@ -65,7 +66,9 @@ class MotionDetector
 {
 public:
   
-  MotionDetector(const Vision::Camera &camera, VizManager *vizManager, const Json::Value &config);
+  // Per-frame intermediate images are taken from scratchArena
+  MotionDetector(const Vision::Camera &camera, VizManager *vizManager, const Json::Value &config,
+                 Vision::ScratchArena &scratchArena);
 
   // Will use Color data if available in ImageCache, otherwise grayscale only
   Result Detect(Vision::ImageCache& imageCache,
@@ -120,15 +123,23 @@ private:
   s32 RatioTest(const Vision::Image& image,    Vision::Image& ratio12);
   s32 RatioTest(const Vision::ImageRGB& image, Vision::Image& ratio12);
   
+  // Previous images are double buffered: the next one is written into the spare buffer (GetNextImage) and then
+  // swapped in, which only exchanges headers. SetPrevImage copies into the spare buffer first.
   void SetPrevImage(const Vision::Image &image, bool wasBlurred);
   void SetPrevImage(const Vision::ImageRGB &image, bool wasBlurred);
   
+  template<class ImageType>
+  void SwapPrevImage(bool wasBlurred);
+  
   template<class ImageType>
   bool HavePrevImage() const;
   
   template<class ImageType>
   ImageType& GetPrevImage();
   
+  template<class ImageType>
+  ImageType& GetNextImage(s32 numRows, s32 numCols);
+  
   template<class ImageType>
   bool WasPrevImageBlurred() const;
   
@@ -151,6 +162,8 @@ private:
 
   Vision::ImageRGB _prevImageRGB;
   Vision::Image    _prevImageGray;
+  Vision::ImageRGB _nextImageRGB;
+  Vision::Image    _nextImageGray;
   bool _wasPrevImageRGBBlurred = false;
   bool _wasPrevImageGrayBlurred = false;
   
@@ -159,6 +172,8 @@ private:
   VizManager*   _vizManager = nullptr;
 
   const Json::Value& _config;
+
+  Vision::ScratchArena& _scratchArena;
 };
 
 } // namespace Vector
@@ -16,6 +16,12 @@
 
 #include "coretech/common/shared/array2d_impl.h"
 
+#include <vector>
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
 namespace Anki {
 namespace Vector {
 
@@ -348,8 +354,10 @@ s32 MotionDetector::RatioTestNeon(const ImageType& image, Vision::Image& ratioIm
 
 #if defined(ANDROID) || defined(VICOS)
 
+  const ImageType& prevImage = GetPrevImage<ImageType>();
+
   const bool isImageContinuous = image.IsContinuous();
-  const bool isPrevImageContinuous = _prevImageRGB.IsContinuous();
+  const bool isPrevImageContinuous = prevImage.IsContinuous();
   const bool isRatioImgContinuous = ratioImg.IsContinuous();
 
   u32 numRows = image.GetNumRows();
@@ -364,7 +372,7 @@ s32 MotionDetector::RatioTestNeon(const ImageType& image, Vision::Image& ratioIm
   for(int i = 0; i < numRows; i++)
   {
     const u8* imagePtr     = reinterpret_cast<const u8*>(image.GetRow(i));
-    const u8* prevImagePtr = reinterpret_cast<const u8*>(_prevImageRGB.GetRow(i));
+    const u8* prevImagePtr = reinterpret_cast<const u8*>(prevImage.GetRow(i));
     u8*       ratioImgPtr  = reinterpret_cast<u8*>(ratioImg.GetRow(i));
 
     numAboveThresh += RatioTestNeonHelper<ImageType>(imagePtr, prevImagePtr, ratioImgPtr, numElementsToProcessAtATime);
@@ -379,6 +387,67 @@ s32 MotionDetector::RatioTestNeon(const ImageType& image, Vision::Image& ratioIm
 
 #endif
 
+#ifdef __ARM_NEON__
+
+// Writes src AND mask to dst. The mask is 0 or 255, so this zeroes everything outside it
+inline void ApplyMaskNeon(const u8* src, const u8* mask, u8* dst, s32 numElements)
+{
+  const s32 kNumElementsProcessedPerLoop = 16;
+  const s32 kNumIterations = numElements - (kNumElementsProcessedPerLoop - 1);
+
+  s32 i;
+  for(i = 0; i < kNumIterations; i += kNumElementsProcessedPerLoop)
+  {
+    const uint8x16_t s = vld1q_u8(src + i);
+    const uint8x16_t m = vld1q_u8(mask + i);
+    vst1q_u8(dst + i, vandq_u8(s, m));
+  }
+
+  for(; i < numElements; ++i)
+  {
+    dst[i] = src[i] & mask[i];
+  }
+}
+
+// Appends the coordinates of every non-zero element in a row. Motion images are mostly zero, so whole
+// blocks of zeros are skipped with one test and only blocks containing motion are walked element by element
+inline void AppendNonZeroElementsNeon(const u8* row, s32 numCols, s32 y,
+                                      std::vector<s32>& xValues, std::vector<s32>& yValues)
+{
+  const s32 kNumElementsProcessedPerLoop = 16;
+  const s32 kNumIterations = numCols - (kNumElementsProcessedPerLoop - 1);
+
+  s32 x;
+  for(x = 0; x < kNumIterations; x += kNumElementsProcessedPerLoop)
+  {
+    // OR the two halves together; the block is all zeros iff the resulting 64 bits are
+    const uint8x16_t block = vld1q_u8(row + x);
+    const uint8x8_t  halves = vorr_u8(vget_low_u8(block), vget_high_u8(block));
+    if(vget_lane_u64(vreinterpret_u64_u8(halves), 0) == 0)
+    {
+      continue;
+    }
+
+    for(s32 j = x; j < x + kNumElementsProcessedPerLoop; ++j)
+    {
+      if(row[j] != 0) {
+        xValues.push_back(j);
+        yValues.push_back(y);
+      }
+    }
+  }
+
+  for(; x < numCols; ++x)
+  {
+    if(row[x] != 0) {
+      xValues.push_back(x);
+      yValues.push_back(y);
+    }
+  }
+}
+
+#endif // __ARM_NEON__
+
 }
 }
 
@@ -12,6 +12,7 @@
 
 #include "overheadEdgesDetector.h"
 #include "coretech/vision/engine/imageCache.h"
+#include "coretech/vision/engine/scratchArena.h"
 #include "coretech/common/engine/math/quad_impl.h"
 #include "engine/robot.h"
 
@@ -52,10 +53,12 @@ struct ImageGrayTrait
 }
 
 OverheadEdgesDetector::OverheadEdgesDetector(const Vision::Camera &camera, VizManager *vizManager,
-                                             Vision::Profiler &profiler, f32 edgeThreshold, u32 minChainLength) :
+                                             Vision::Profiler &profiler, Vision::ScratchArena &scratchArena,
+                                             f32 edgeThreshold, u32 minChainLength) :
                                              _camera(camera),
                                              _vizManager(vizManager),
                                              _profiler(profiler),
+                                             _scratchArena(scratchArena),
                                              _kEdgeThreshold(edgeThreshold),
                                              _kMinChainLength(minChainLength)
 {
@@ -210,13 +213,14 @@ Result OverheadEdgesDetector::DetectHelper(const typename ImageTraitType::ImageT
    };
    */
 
-  Array2d<typename ImageTraitType::SPixelType> edgeImgX(image.GetNumRows(), image.GetNumCols());
+  Array2d<typename ImageTraitType::SPixelType> edgeImgX =
+    _scratchArena.GetArray2d<typename ImageTraitType::SPixelType>(image.GetNumRows(), image.GetNumCols());
   cv::filter2D(imageROI.get_CvMat_(), edgeImgX.GetROI(bbox).get_CvMat_(), CV_16S, kernel.get_CvMatx_());
   _profiler.Toc("EdgeDetection");
 
   _profiler.Tic("GroundQuadEdgeMasking");
   // Remove edges that aren't in the ground plane quad (as opposed to its bounding rectangle)
-  Vision::Image mask(edgeImgX.GetNumRows(), edgeImgX.GetNumCols());
+  Vision::Image mask = _scratchArena.GetImage(edgeImgX.GetNumRows(), edgeImgX.GetNumCols());
   mask.FillWith(255);
   cv::fillConvexPoly(mask.get_CvMat_(), std::vector<cv::Point>{
       groundInImage[Quad::CornerName::TopLeft].get_CvPoint_(),
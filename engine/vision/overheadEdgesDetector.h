@@ -24,6 +24,7 @@ namespace Vision {
 class Camera;
 class ImageCache;
 class Profiler;
+class ScratchArena;
 }
 
 namespace Vector {
@@ -37,6 +38,7 @@ public:
   OverheadEdgesDetector(const Vision::Camera &camera,
                         VizManager *vizManager,
                         Vision::Profiler &profiler,
+                        Vision::ScratchArena &scratchArena,
                         f32 edgeThreshold = 50.0f,
                         u32 minChainLength = 3);
 
@@ -52,6 +54,7 @@ private:
   const Vision::Camera&   _camera;
   VizManager*             _vizManager = nullptr;
   Vision::Profiler&       _profiler;
+  Vision::ScratchArena&   _scratchArena;
   const f32               _kEdgeThreshold = 50.0f;
   const u32               _kMinChainLength = 3;
 
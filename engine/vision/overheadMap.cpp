@@ -17,6 +17,7 @@
 #include "coretech/common/engine/jsonTools.h"
 #include "coretech/common/engine/math/quad_impl.h" // include this to avoid linking error in android
 #include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/vision/engine/imageCache.h"
 #include "engine/cozmoContext.h"
 #include "engine/robot.h"
 #include "util/fileUtils/fileUtils.h"
@@ -111,22 +112,49 @@ OverheadMap::OverheadMap(const Json::Value& config, const CozmoContext *context)
 Result OverheadMap::Update(const Vision::ImageRGB& image, const VisionPoseData& poseData,
                            Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
+  // nothing to do here if there's no ground plane visible
+  if (! poseData.groundPlaneVisible) {
+    PRINT_CH_DEBUG(kLogChannelName, "OverheadMap.Update.Groundplane", "Ground plane is not visible");
+    return RESULT_OK;
+  }
 
-  // TODO skip if robot hasn't moved
+  const bool kUseMask = false; // UpdateHelper only reads pixels inside the mask anyway
+  const Vision::ImageRGB overheadImage = poseData.groundPlaneROI.GetOverheadImage(image,
+                                                                                  poseData.groundPlaneHomography,
+                                                                                  kUseMask);
+  return UpdateHelper(overheadImage, image.GetNumRows(), image.GetNumCols(), poseData, debugImages);
+}
 
+Result OverheadMap::Update(Vision::ImageCache& imageCache, const VisionPoseData& poseData,
+                           Vision::DebugImageList<Vision::CompressedImage>& debugImages)
+{
   // nothing to do here if there's no ground plane visible
   if (! poseData.groundPlaneVisible) {
     PRINT_CH_DEBUG(kLogChannelName, "OverheadMap.Update.Groundplane", "Ground plane is not visible");
     return RESULT_OK;
   }
 
+  const bool kUseMask = false; // UpdateHelper only reads pixels inside the mask anyway
+  const Vision::ImageRGB overheadImage = poseData.groundPlaneROI.GetOverheadImage(imageCache,
+                                                                                  poseData.groundPlaneHomography,
+                                                                                  kUseMask);
+  const Vision::ImageCacheSize size = Vision::ImageCache::GetDefaultImageCacheSize();
+  return UpdateHelper(overheadImage, imageCache.GetNumRows(size), imageCache.GetNumCols(size), poseData, debugImages);
+}
+
+Result OverheadMap::UpdateHelper(const Vision::ImageRGB& overheadImage, s32 imgNumRows, s32 imgNumCols,
+                                 const VisionPoseData& poseData,
+                                 Vision::DebugImageList<Vision::CompressedImage>& debugImages)
+{
+  // TODO skip if robot hasn't moved
+
   const Matrix_3x3f& H = poseData.groundPlaneHomography;
 
   const GroundPlaneROI& roi = poseData.groundPlaneROI;
 
   Quad2f imgGroundQuad;
   try {
-    roi.GetImageQuad(H, image.GetNumCols(), image.GetNumRows(), imgGroundQuad);
+    roi.GetImageQuad(H, imgNumCols, imgNumRows, imgGroundQuad);
   }
   catch (const cv::Exception& e) {
     PRINT_NAMED_ERROR("OverheadMap.Update.ExceptionGetImageQuad", "Error while getting the image quad: %s",
@@ -137,49 +165,37 @@ Result OverheadMap::Update(const Vision::ImageRGB& image, const VisionPoseData&
   // TODO a map could have a resolution lower than 1mm per pixel. In that case we need a
   // different way to index elements here
 
-  // For each point on the ground plane, project it back into the image to get the color
-  // Then add it to the overhead image
+  // Each point on the ground plane inside the mask and in view of the camera already has its color, projected
+  // from the image, in the overhead image. Add it to the overhead map.
+  const Vision::Image visibleMask = roi.GetVisibleOverheadMask(H, imgNumCols, imgNumRows);
   s32 pointsInMap = 0;
-  for(s32 i=0; i<roi.GetWidthFar(); ++i) {
-    const u8* mask_i = roi.GetOverheadMask().GetRow(i);
-    // i is an index, but given that in the overhead mask 1 pixel = 1mm, i is also a distance
-    const f32 ground_y = static_cast<f32>(i) - 0.5f*roi.GetWidthFar(); // Zero is at the center
-    for(s32 j=0; j<roi.GetLength(); ++j) {
+  for(s32 i=0; i<overheadImage.GetNumRows(); ++i) {
+    const u8* mask_i = visibleMask.GetRow(i);
+    const Vision::PixelRGB* overhead_i = overheadImage.GetRow(i);
+    // i is an index, but given that in the overhead image 1 pixel = 1mm, i is also a distance.
+    // The overhead image's rows are mirrored, since it is looking down on the ground plane.
+    const f32 ground_y = 0.5f*roi.GetWidthFar() - static_cast<f32>(i); // Zero is at the center
+    for(s32 j=0; j<overheadImage.GetNumCols(); ++j) {
 
       if(mask_i[j] == 0) { // skip if not in the mask
         continue;
       }
 
-      // Project ground plane point in robot frame to image
       const f32 ground_x = static_cast<f32>(j) + roi.GetDist();
-      Point3f imgPoint = H * Point3f(ground_x,ground_y,1.f);
-      DEV_ASSERT(imgPoint.z() > 0.f, "OverheadMap.Update.NegativePointZ");
-      const f32 divisor = 1.f / imgPoint.z();
-      imgPoint.x() *= divisor;
-      imgPoint.y() *= divisor;
-      const s32 x_img = (s32)std::round(imgPoint.x());
-      const s32 y_img = (s32)std::round(imgPoint.y());
-
-      // if the ground point doesn't fall beyond the image plane
-      if(x_img >= 0 && y_img >= 0 &&
-         x_img < image.GetNumCols() && y_img < image.GetNumRows())
+
+      // Get corresponding map point in world coords
+      Point3f mapPoint = poseData.histState.GetPose() * Point3f(ground_x,ground_y,0.f);
+      // World map is assumed to have the origin of the world in the center, hence (rows/2, cols/2)
+      const s32 x_map = (s32)std::round( mapPoint.x() + static_cast<f32>(_overheadMap.GetNumCols())*0.5f);
+      const s32 y_map = (s32)std::round(-mapPoint.y() + static_cast<f32>(_overheadMap.GetNumRows())*0.5f);
+      if(x_map >= 0 && y_map >= 0 &&
+         x_map < _overheadMap.GetNumCols() && y_map < _overheadMap.GetNumRows())
       {
-        const Vision::PixelRGB value = image(y_img, x_img);
-
-        // Get corresponding map point in world coords
-        Point3f mapPoint = poseData.histState.GetPose() * Point3f(ground_x,ground_y,0.f);
-        // World map is assumed to have the origin of the world in the center, hence (rows/2, cols/2)
-        const s32 x_map = (s32)std::round( mapPoint.x() + static_cast<f32>(_overheadMap.GetNumCols())*0.5f);
-        const s32 y_map = (s32)std::round(-mapPoint.y() + static_cast<f32>(_overheadMap.GetNumRows())*0.5f);
-        if(x_map >= 0 && y_map >= 0 &&
-           x_map < _overheadMap.GetNumCols() && y_map < _overheadMap.GetNumRows())
-        {
-          pointsInMap++;
-
-          // Replace the old value here rather than blending,
-          // want to make sure the map is up-to-date and it doesn't have spurious values
-          _overheadMap(y_map, x_map) = value;
-        }
+        pointsInMap++;
+
+        // Replace the old value here rather than blending,
+        // want to make sure the map is up-to-date and it doesn't have spurious values
+        _overheadMap(y_map, x_map) = overhead_i[j];
       }
     }
   }
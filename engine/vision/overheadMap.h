@@ -23,6 +23,11 @@
 #include <unordered_set>
 
 namespace Anki {
+
+namespace Vision {
+  class ImageCache;
+}
+
 namespace Vector {
 
 class CozmoContext;
@@ -41,6 +46,10 @@ public:
   Result Update(const Vision::ImageRGB& image, const VisionPoseData& poseData,
                 Vision::DebugImageList<Vision::CompressedImage>& debugImages);
 
+  // Same, for the cache's default size RGB image, sharing its overhead ground plane warp with other modes
+  Result Update(Vision::ImageCache& imageCache, const VisionPoseData& poseData,
+                Vision::DebugImageList<Vision::CompressedImage>& debugImages);
+
   const Vision::ImageRGB& GetOverheadMap() const;
   const Vision::Image& GetFootprintMask() const;
 
@@ -81,6 +90,10 @@ private:
 
   // Set the overhead map to be all black
   void ResetMaps();
+  // Copy the visible, masked part of the overhead ground plane image, for an image of the given size, into the map
+  Result UpdateHelper(const Vision::ImageRGB& overheadImage, s32 imgNumRows, s32 imgNumCols,
+                      const VisionPoseData& poseData,
+                      Vision::DebugImageList<Vision::CompressedImage>& debugImages);
   // Paint all the _footprintMask pixels underneath the robot footprint with white
   void UpdateFootprintMask(const Pose3d& robotPose, Vision::DebugImageList<Vision::CompressedImage>& debugImages);
 
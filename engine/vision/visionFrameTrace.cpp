@@ -0,0 +1,144 @@
+/**
+ * File: visionFrameTrace.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "engine/vision/visionFrameTrace.h"
+
+#include <chrono>
+
+namespace Anki {
+namespace Vector {
+
+namespace {
+  constexpr f32 kBucketUpperBounds_ms[] = {5.f, 10.f, 20.f, 35.f, 50.f, 75.f, 100.f, 150.f, 200.f, 300.f, 500.f};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const char* VisionFrameStageToString(VisionFrameStage stage)
+{
+  switch(stage)
+  {
+    case VisionFrameStage::Captured:        return "Captured";
+    case VisionFrameStage::Dequeued:        return "Dequeued";
+    case VisionFrameStage::ProcessingStart: return "ProcessingStart";
+    case VisionFrameStage::CacheBuilt:      return "CacheBuilt";
+    case VisionFrameStage::ModesComplete:   return "ModesComplete";
+    case VisionFrameStage::ResultQueued:    return "ResultQueued";
+    case VisionFrameStage::ResultReceived:  return "ResultReceived";
+    case VisionFrameStage::WorldUpdated:    return "WorldUpdated";
+    case VisionFrameStage::Count:           break;
+  }
+  return "Invalid";
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+s64 VisionFrameTrace::GetCurrentTime_us()
+{
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  return std::chrono::duration_cast<std::chrono::microseconds>(now).count();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+s64 VisionFrameTrace::GetLatencyFromCapture_us(VisionFrameStage stage) const
+{
+  if(!HasStage(VisionFrameStage::Captured) || !HasStage(stage))
+  {
+    return -1;
+  }
+  return stageTime_us[static_cast<size_t>(stage)] - stageTime_us[static_cast<size_t>(VisionFrameStage::Captured)];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionFrameTraceStats::Histogram::Add(f32 value_ms)
+{
+  static_assert(sizeof(kBucketUpperBounds_ms)/sizeof(kBucketUpperBounds_ms[0]) == kNumBuckets-1,
+                "Expecting one upper bound per bucket, except the last");
+
+  size_t bucket = 0;
+  while(bucket < kNumBuckets-1 && value_ms > kBucketUpperBounds_ms[bucket])
+  {
+    ++bucket;
+  }
+  ++counts[bucket];
+  stats += value_ms;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Json::Value VisionFrameTraceStats::Histogram::GetJson() const
+{
+  Json::Value json;
+  json["num"]     = stats.GetNum();
+  json["min_ms"]  = stats.GetMinSafe();
+  json["max_ms"]  = stats.GetMaxSafe();
+  json["mean_ms"] = (stats.GetNum() > 0 ? stats.GetMean() : 0.0);
+
+  Json::Value& buckets = json["buckets"];
+  for(size_t i=0; i<kNumBuckets; ++i)
+  {
+    Json::Value bucket;
+    bucket["upTo_ms"] = (i < kNumBuckets-1 ? Json::Value(kBucketUpperBounds_ms[i]) : Json::Value("inf"));
+    bucket["count"]   = counts[i];
+    buckets.append(bucket);
+  }
+  return json;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionFrameTraceStats::Add(const VisionFrameTrace& trace)
+{
+  ++_numFrames;
+
+  for(size_t i=0; i<VisionFrameTrace::kNumStages; ++i)
+  {
+    const s64 latency_us = trace.GetLatencyFromCapture_us(static_cast<VisionFrameStage>(i));
+    if(latency_us >= 0)
+    {
+      _stageLatency[i].Add(latency_us * 0.001f);
+    }
+  }
+
+  for(const auto& modeDuration : trace.modeDuration_us)
+  {
+    _modeDuration[modeDuration.first].Add(modeDuration.second * 0.001f);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionFrameTraceStats::Clear()
+{
+  _numFrames = 0;
+  _stageLatency.fill(Histogram());
+  _modeDuration.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+Json::Value VisionFrameTraceStats::GetJson() const
+{
+  Json::Value json;
+  json["numFrames"] = _numFrames;
+
+  // Stage latencies are all measured from capture, so there is nothing to report for Captured itself
+  Json::Value& stages = json["latencyFromCapture"];
+  for(size_t i=1; i<VisionFrameTrace::kNumStages; ++i)
+  {
+    stages[VisionFrameStageToString(static_cast<VisionFrameStage>(i))] = _stageLatency[i].GetJson();
+  }
+
+  Json::Value& modes = json["modeDuration"];
+  for(const auto& entry : _modeDuration)
+  {
+    modes[EnumToString(entry.first)] = entry.second.GetJson();
+  }
+
+  return json;
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,108 @@
+/**
+ * File: visionFrameTrace.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Per-image record of when each stage of the vision pipeline was reached, from camera capture
+ *              through VisionSystem processing to BlockWorld/FaceWorld being updated with the results, plus how
+ *              long each VisionMode took on that image. Travels with the image in VisionSystemInput and then
+ *              VisionProcessingResult.
+ *
+ *              VisionFrameTraceStats accumulates traces into latency histograms, per stage and per mode.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Vector_Engine_VisionFrameTrace_H__
+#define __Anki_Vector_Engine_VisionFrameTrace_H__
+
+#include "coretech/common/shared/types.h"
+
+#include "clad/types/visionModes.h"
+
+#include "util/stats/statsAccumulator.h"
+
+#include "json/json.h"
+
+#include <array>
+#include <map>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+// Stages of one image's trip from the camera to the world models, in the order they happen
+enum class VisionFrameStage : u8
+{
+  Captured,         // Exposure time reported by the camera
+  Dequeued,         // VisionComponent got the frame from CameraService
+  ProcessingStart,  // VisionSystem started on it (on the vision thread)
+  CacheBuilt,       // ImageCache was reset with it, including any precomputed sizes
+  ModesComplete,    // All VisionModes run in parallel have finished and been merged
+  ResultQueued,     // The VisionProcessingResult was handed back to the main thread
+  ResultReceived,   // VisionComponent picked up the result
+  WorldUpdated,     // BlockWorld, FaceWorld and PetWorld were updated from it
+  Count
+};
+
+const char* VisionFrameStageToString(VisionFrameStage stage);
+
+struct VisionFrameTrace
+{
+  static constexpr size_t kNumStages = static_cast<size_t>(VisionFrameStage::Count);
+
+  // Microseconds on a monotonic clock (see GetCurrentTime_us) when each stage was reached. 0 until stamped.
+  std::array<s64, kNumStages> stageTime_us{};
+
+  // How long each VisionMode took on this image, in the order they were run
+  std::vector<std::pair<VisionMode, s64>> modeDuration_us;
+
+  static s64 GetCurrentTime_us();
+
+  void Stamp(VisionFrameStage stage) { Stamp(stage, GetCurrentTime_us()); }
+  void Stamp(VisionFrameStage stage, s64 time_us) { stageTime_us[static_cast<size_t>(stage)] = time_us; }
+
+  bool HasStage(VisionFrameStage stage) const { return (stageTime_us[static_cast<size_t>(stage)] > 0); }
+
+  // Time from Captured until the given stage, or -1 if either was never stamped
+  s64 GetLatencyFromCapture_us(VisionFrameStage stage) const;
+};
+
+class VisionFrameTraceStats
+{
+public:
+
+  // Adds the latency from capture to each stamped stage, and each mode's duration
+  void Add(const VisionFrameTrace& trace);
+
+  void Clear();
+
+  u32 GetNumFrames() const { return _numFrames; }
+
+  // Min/max/mean and histogram bucket counts (in ms) for each stage and mode, for sending to webViz
+  Json::Value GetJson() const;
+
+private:
+
+  // Bucket i holds values up to kBucketUpperBounds_ms[i], and the last bucket everything larger
+  static constexpr size_t kNumBuckets = 12;
+
+  struct Histogram
+  {
+    std::array<u32, kNumBuckets>  counts{};
+    Util::Stats::StatsAccumulator stats;
+
+    void Add(f32 value_ms);
+    Json::Value GetJson() const;
+  };
+
+  u32 _numFrames = 0;
+  std::array<Histogram, VisionFrameTrace::kNumStages> _stageLatency;
+  std::map<VisionMode, Histogram> _modeDuration;
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif /* __Anki_Vector_Engine_VisionFrameTrace_H__ */
@@ -0,0 +1,172 @@
+/**
+ * File: visionModeTaskGraph.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "engine/vision/visionModeTaskGraph.h"
+
+#include "util/logging/logging.h"
+#include "util/threading/threadPriority.h"
+
+#include <string>
+
+namespace Anki {
+namespace Vector {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+VisionModeTaskGraph::VisionModeTaskGraph(s32 numWorkerThreads)
+{
+  for(s32 i=0; i<numWorkerThreads; ++i)
+  {
+    _workers.emplace_back(&VisionModeTaskGraph::WorkerLoop, this, i);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+VisionModeTaskGraph::~VisionModeTaskGraph()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _shutdown = true;
+  }
+  _workAvailable.notify_all();
+  for(auto& worker : _workers)
+  {
+    if(worker.joinable())
+    {
+      worker.join();
+    }
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::AddTask(ResourceSet reads, ResourceSet writes, std::function<void()>&& func)
+{
+  DEV_ASSERT(0 == _numRemaining, "VisionModeTaskGraph.AddTask.AlreadyRunning");
+
+  Task task;
+  task.reads  = reads;
+  task.writes = writes;
+  task.func   = std::move(func);
+
+  // Wait on every earlier task this one conflicts with. Redundant edges (to tasks that are already transitively
+  // waited on) are harmless and the graph is small.
+  const size_t index = _tasks.size();
+  for(size_t i=0; i<index; ++i)
+  {
+    Task& earlier = _tasks[i];
+    const bool conflicts = ((earlier.writes & (reads | writes)) != 0) || ((earlier.reads & writes) != 0);
+    if(conflicts)
+    {
+      earlier.dependents.push_back(index);
+      ++task.numBlockers;
+    }
+  }
+
+  _tasks.emplace_back(std::move(task));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::Run()
+{
+  if(_tasks.empty())
+  {
+    return;
+  }
+
+  if(_workers.empty())
+  {
+    // Adding order always satisfies the dependencies
+    for(auto& task : _tasks)
+    {
+      task.func();
+    }
+    _tasks.clear();
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  _ready.clear();
+  for(size_t i=0; i<_tasks.size(); ++i)
+  {
+    if(0 == _tasks[i].numBlockers)
+    {
+      _ready.push_back(i);
+    }
+  }
+  _numRemaining = _tasks.size();
+  _workAvailable.notify_all();
+
+  while(_numRemaining > 0)
+  {
+    if(_ready.empty())
+    {
+      _taskComplete.wait(lock);
+    }
+    else
+    {
+      RunNextReadyTask(lock);
+    }
+  }
+
+  _tasks.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::RunNextReadyTask(std::unique_lock<std::mutex>& lock)
+{
+  const size_t index = _ready.front();
+  _ready.pop_front();
+
+  // _tasks is not modified while running, so this is safe to use unlocked
+  Task& task = _tasks[index];
+
+  lock.unlock();
+  task.func();
+  lock.lock();
+
+  bool anyNewlyReady = false;
+  for(const size_t dependent : task.dependents)
+  {
+    if(0 == --_tasks[dependent].numBlockers)
+    {
+      _ready.push_back(dependent);
+      anyNewlyReady = true;
+    }
+  }
+
+  if(anyNewlyReady)
+  {
+    _workAvailable.notify_all();
+  }
+
+  --_numRemaining;
+  _taskComplete.notify_one();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionModeTaskGraph::WorkerLoop(s32 index)
+{
+  Util::SetThreadName(pthread_self(), "VisionModeWork" + std::to_string(index));
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  while(true)
+  {
+    _workAvailable.wait(lock, [this]() { return _shutdown || !_ready.empty(); });
+    if(_shutdown)
+    {
+      return;
+    }
+
+    RunNextReadyTask(lock);
+  }
+}
+
+} // namespace Vector
+} // namespace Anki
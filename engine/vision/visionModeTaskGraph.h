@@ -0,0 +1,87 @@
+/**
+ * File: visionModeTaskGraph.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Runs a set of per-frame VisionMode tasks on a small pool of worker threads. Each task declares
+ *              which resources (detectors, parts of the result, etc) it reads and writes, and a task only starts
+ *              once every earlier-added task it conflicts with has finished. Tasks which don't conflict run in
+ *              parallel, while conflicting tasks still run in the order they were added.
+ *
+ *              With zero worker threads, tasks are simply run in order on the calling thread.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Vector_Engine_VisionModeTaskGraph_H__
+#define __Anki_Vector_Engine_VisionModeTaskGraph_H__
+
+#include "coretech/common/shared/types.h"
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class VisionModeTaskGraph
+{
+public:
+
+  // One bit per resource, defined by the user of the graph
+  using ResourceSet = u32;
+
+  explicit VisionModeTaskGraph(s32 numWorkerThreads);
+  ~VisionModeTaskGraph();
+
+  VisionModeTaskGraph(const VisionModeTaskGraph&) = delete;
+  VisionModeTaskGraph& operator=(const VisionModeTaskGraph&) = delete;
+
+  // Two tasks conflict if either writes something the other reads or writes
+  void AddTask(ResourceSet reads, ResourceSet writes, std::function<void()>&& func);
+
+  // Runs all added tasks, blocking until they are complete, and then removes them. The calling thread runs
+  // tasks too.
+  void Run();
+
+  s32 GetNumWorkerThreads() const { return static_cast<s32>(_workers.size()); }
+
+private:
+
+  struct Task
+  {
+    ResourceSet           reads  = 0;
+    ResourceSet           writes = 0;
+    std::function<void()> func;
+
+    std::vector<size_t>   dependents;   // later tasks waiting on this one
+    s32                   numBlockers = 0; // earlier tasks this one is still waiting on
+  };
+
+  void WorkerLoop(s32 index);
+
+  // Pops the next ready task, runs it with the lock released, and marks it complete
+  void RunNextReadyTask(std::unique_lock<std::mutex>& lock);
+
+  std::vector<Task>        _tasks;
+  std::vector<std::thread> _workers;
+
+  std::mutex               _mutex;
+  std::condition_variable  _workAvailable;
+  std::condition_variable  _taskComplete;
+
+  std::deque<size_t>       _ready;
+  size_t                   _numRemaining = 0;
+  bool                     _shutdown = false;
+
+}; // class VisionModeTaskGraph
+
+} // namespace Vector
+} // namespace Anki
+
+#endif /* __Anki_Vector_Engine_VisionModeTaskGraph_H__ */
@@ -25,9 +25,11 @@
 #include "clad/types/imageTypes.h"
 
 #include "engine/overheadEdge.h"
+#include "engine/vision/visionFrameTrace.h"
 #include "engine/vision/visionModeSet.h"
 
 #include <list>
+#include <vector>
 
 namespace Anki {
 namespace Vector {
@@ -42,9 +44,9 @@ struct VisionProcessingResult
   u8 imageMean;
   
   std::list<ExternalInterface::RobotObservedMotion>     observedMotions;
-  std::list<Vision::ObservedMarker>                     observedMarkers;
-  std::list<Vision::TrackedFace>                        faces;
-  std::list<Vision::TrackedPet>                         pets;
+  Vision::ObservedMarkerList                            observedMarkers;
+  std::vector<Vision::TrackedFace>                        faces;
+  std::vector<Vision::TrackedPet>                         pets;
   std::list<OverheadEdgeFrame>                          overheadEdges;
   std::list<Vision::UpdatedFaceID>                      updatedFaceIDs;
   std::list<ExternalInterface::RobotObservedLaserPoint> laserPoints;
@@ -59,6 +61,9 @@ struct VisionProcessingResult
   // Used to pass debug images back to main thread for display:
   Vision::DebugImageList<Vision::CompressedImage> debugImages;
   
+  // When this image reached each stage of processing, continued by VisionComponent once it is received
+  VisionFrameTrace frameTrace;
+  
   // Returns true if there is a detection for the corresponding mode present in this result.
   // The detection(s) must match the given timestamp as well (since in some cases, such as salientPoints,
   //  a detections' timestamp may not match the VisionProcessingResult's timestamp).
@@ -13,6 +13,7 @@
 #include "visionSystem.h"
 
 #include "coretech/common/engine/jsonTools.h"
+#include "coretech/common/engine/mailbox_impl.h"
 #include "coretech/common/engine/math/linearAlgebra_impl.h"
 #include "coretech/common/engine/math/linearClassifier.h"
 #include "coretech/common/engine/math/quad_impl.h"
@@ -31,6 +32,7 @@
 #include "engine/vision/motionDetector.h"
 #include "engine/vision/overheadEdgesDetector.h"
 #include "engine/vision/overheadMap.h"
+#include "engine/vision/visionModeTaskGraph.h"
 #include "engine/vision/visionModesHelpers.h"
 #include "engine/utils/cozmoFeatureGate.h"
 
@@ -44,6 +46,7 @@
 #include "coretech/vision/engine/markerDetector.h"
 #include "coretech/vision/engine/neuralNetRunner.h"
 #include "coretech/vision/engine/petTracker.h"
+#include "coretech/vision/engine/scratchArena.h"
 
 #include "clad/vizInterface/messageViz.h"
 #include "clad/robotInterface/messageEngineToRobot.h"
@@ -93,9 +96,15 @@ CONSOLE_VAR_RANGED(f32, kMarkerDetector_CropWidthFraction, "Vision.MarkerDetecti
   
 // Show the crops being used for MarkerDetection. Need to increase Viz debug windows if enabled.
 CONSOLE_VAR(bool, kMarkerDetector_VizCropScheduler, "Vision.MarkerDetection", false);
+
+// When detecting markers in full frames, track them between periodic full detections instead of detecting every frame
+CONSOLE_VAR(bool, kMarkerDetector_TrackBetweenDetections, "Vision.MarkerDetection", false);
   
 // How long to disable auto exposure after using detections to meter
 CONSOLE_VAR(u32, kMeteringHoldTime_ms,    "Vision.PreProcessing", 2000);
+
+// Score bright color regions on the Quarter size image first, and only rescore promising ones at the default size
+CONSOLE_VAR(bool, kBrightColors_CoarseToFine, "Vision.BrightColors", false);
   
 // Loose constraints on how fast Cozmo can move and still trust tracker (which has no
 // knowledge of or access to camera movement). Rough means of deciding these angles:
@@ -124,6 +133,16 @@ CONSOLE_VAR_RANGED(f32, kFakeCatDetectionProbability,  "Vision.NeuralNets", 0.f,
 CONSOLE_VAR_RANGED(f32, kFakeDogDetectionProbability,  "Vision.NeuralNets", 0.f, 0.f, 1.f);
 
 CONSOLE_VAR(bool, kDisplayUndistortedImages,"Vision.General", false);
+
+// Log which ImageCache sizes each vision mode requested every N frames (0 to disable)
+CONSOLE_VAR(u32, kImageCacheStatsLogPeriod_frames, "Vision.General", 0);
+
+// Compute the image sizes scheduled modes are expected to ask for in a single pass when each image arrives
+CONSOLE_VAR(bool, kImageCachePrecomputeExpectedSizes, "Vision.General", true);
+
+// Number of extra threads used to run independent VisionModes in parallel during Update (0 runs them all
+// sequentially on the vision thread). Only read at Init.
+CONSOLE_VAR_RANGED(s32, kVisionModeNumWorkerThreads, "Vision.General", 2, 0, 3);
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 namespace {
@@ -138,11 +157,40 @@ namespace {
 
 static const char * const kLogChannelName = "VisionSystem";
 
+namespace {
+  // What each VisionMode task in Update uses, so that the task graph only runs modes which share nothing
+  // at the same time. Each mode writes only its own members of the VisionProcessingResult.
+  enum ModeTaskResource : VisionModeTaskGraph::ResourceSet
+  {
+    kModeResource_Stats        = 1 << 0,
+    kModeResource_Markers      = 1 << 1, // marker detector, image compositor, rolling shutter corrector
+    kModeResource_Okao         = 1 << 2, // face and pet trackers share the OKAO library
+    kModeResource_Motion       = 1 << 3,
+    kModeResource_BrightColors = 1 << 4,
+    kModeResource_OverheadMap  = 1 << 5,
+    kModeResource_Obstacles    = 1 << 6,
+    kModeResource_Edges        = 1 << 7,
+    kModeResource_Lasers       = 1 << 8,
+    kModeResource_Illumination = 1 << 9,
+  };
+  
+  // Per-task outputs which can't be written into the shared result directly while other tasks are running
+  struct ModeTaskOutput
+  {
+    VisionMode    mode = VisionMode::Count;
+    Result        result = RESULT_OK;
+    s64           duration_us = 0;
+    VisionModeSet modesProcessed;
+    Vision::DebugImageList<Vision::CompressedImage> debugImages;
+  };
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 VisionSystem::VisionSystem(const CozmoContext* context)
 : _rollingShutterCorrector()
 , _lastRollingShutterCorrectionTime(0)
 , _imageCache(new Vision::ImageCache())
+, _scratchArena(new Vision::ScratchArena())
 , _context(context)
 , _currentCameraParams{31, 1.0, 2.0, 1.0, 2.0}
 , _nextCameraParams{false, _currentCameraParams}
@@ -155,8 +203,8 @@ VisionSystem::VisionSystem(const CozmoContext* context)
 , _vizManager(context == nullptr ? nullptr : context->GetVizManager())
 , _petTracker(new Vision::PetTracker())
 , _markerDetector(new Vision::MarkerDetector(_camera))
-, _laserPointDetector(new LaserPointDetector(_vizManager))
-, _overheadEdgeDetector(new OverheadEdgesDetector(_camera, _vizManager, *this))
+, _laserPointDetector(new LaserPointDetector(_vizManager, *_scratchArena))
+, _overheadEdgeDetector(new OverheadEdgesDetector(_camera, _vizManager, *this, *_scratchArena))
 , _cameraCalibrator(new CameraCalibrator())
 , _illuminationDetector(new IlluminationDetector())
 , _imageSaver(new ImageSaver())
@@ -178,6 +226,7 @@ Result VisionSystem::Init(const Json::Value& config)
     dataPath = _context->GetDataPlatform()->pathToResource(Util::Data::Scope::Resources,
                                                            Util::FileUtils::FullFilePath({"config", "engine", "vision"}));
     cachePath = _context->GetDataPlatform()->pathToResource(Util::Data::Scope::Cache, "vision");
+    _undistortionMapCachePath = Util::FileUtils::FullFilePath({cachePath, "undistortion"});
   } else {
     PRINT_NAMED_WARNING("VisionSystem.Init.NullDataPlatform",
                         "Initializing VisionSystem with no data platform.");
@@ -268,8 +317,10 @@ Result VisionSystem::Init(const Json::Value& config)
                 "With model path %s.", dataPath.c_str());
   _faceTracker.reset(new Vision::FaceTracker(_camera, dataPath, config));
   PRINT_CH_INFO(kLogChannelName, "VisionSystem.Init.DoneInstantiatingFaceTracker", "");
+  
+  _modeTaskGraph.reset(new VisionModeTaskGraph(kVisionModeNumWorkerThreads));
 
-  _motionDetector.reset(new MotionDetector(_camera, _vizManager, config));
+  _motionDetector.reset(new MotionDetector(_camera, _vizManager, config, *_scratchArena));
 
   if (!config.isMember("OverheadMap")) {
     PRINT_NAMED_ERROR("VisionSystem.Init.MissingJsonParameter", "OverheadMap");
@@ -292,7 +343,7 @@ Result VisionSystem::Init(const Json::Value& config)
   _imageCompositor.reset(new Vision::ImageCompositor(imageCompositeCfg));
 
   // TODO check config entry here
-  _groundPlaneClassifier.reset(new GroundPlaneClassifier(config["GroundPlaneClassifier"], _context));
+  _groundPlaneClassifier.reset(new GroundPlaneClassifier(config["GroundPlaneClassifier"], _context, *_scratchArena));
 
   const Result petTrackerInitResult = _petTracker->Init(config);
   if(RESULT_OK != petTrackerInitResult) {
@@ -397,8 +448,9 @@ Result VisionSystem::UpdateCameraCalibration(std::shared_ptr<Vision::CameraCalib
   _markerDetector->Init(camCalib->GetNrows(), camCalib->GetNcols());
 
   // Provide the ImageSaver with the camera calibration so that it can remove distortion if needed
-  // Also pre-cache distortion maps for Sensor resolution, since we use that for photos
-  _imageSaver->SetCalibration(camCalib);
+  // Also pre-cache distortion maps for Sensor resolution, since we use that for photos. These are
+  // loaded from the cache path when they've been computed for this calibration before.
+  _imageSaver->SetCalibration(camCalib, _undistortionMapCachePath);
   _imageSaver->CacheUndistortionMaps(CAMERA_SENSOR_RESOLUTION_HEIGHT, CAMERA_SENSOR_RESOLUTION_WIDTH);
   
   return result;
@@ -492,13 +544,19 @@ Radians VisionSystem::GetPreviousHeadAngle()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool VisionSystem::CheckMailbox(VisionProcessingResult& result)
 {
-  std::lock_guard<std::mutex> lock(_mutex);
-  if(_results.empty()) {
-    return false;
-  } else {
-    std::swap(result, _results.front());
-    _results.pop();
-    return true;
+  return _results.getMessage(result);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void VisionSystem::QueueCurrentResult()
+{
+  // Moved rather than copied: the next Update replaces _currentResult before using it again
+  const RobotTimeStamp_t timestamp = _currentResult.timestamp;
+  if(!_results.putMessage(std::move(_currentResult)))
+  {
+    PRINT_NAMED_WARNING("VisionSystem.QueueCurrentResult.MailboxFull",
+                        "Dropping result for t=%u since %d are already waiting",
+                        (TimeStamp_t)timestamp, kNumResultsMailboxes);
   }
 }
 
@@ -513,24 +571,8 @@ u8 VisionSystem::ComputeMean(Vision::ImageCache& imageCache, const s32 sampleInc
 {
   DEV_ASSERT(sampleInc >= 1, "VisionSystem.ComputeMean.BadIncrement");
   
-  const Vision::Image& inputImageGray = imageCache.GetGray();
-  s32 sum=0;
-  const s32 numRows = inputImageGray.GetNumRows();
-  const s32 numCols = inputImageGray.GetNumCols();
-  for(s32 i=0; i<numRows; i+=sampleInc)
-  {
-    const u8* image_i = inputImageGray.GetRow(i);
-    for(s32 j=0; j<numCols; j+=sampleInc)
-    {
-      sum += image_i[j];
-    }
-  }
-  // Consider that in the loop above, we always start at row 0, and we always start at column 0
-  const s32 count = ((numRows + sampleInc - 1) / sampleInc) *
-                    ((numCols + sampleInc - 1) / sampleInc);
-
-  const u8 mean = Util::numeric_cast_clamped<u8>(sum/count);
-  return mean;
+  // Shared with any other mode asking for statistics at the same subsampling
+  return imageCache.GetStatistics(sampleInc).GetMean();
 }
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -634,7 +676,9 @@ Result VisionSystem::UpdateCameraParams(Vision::ImageCache& imageCache)
   else
   {
     const Vision::Image& inputImage = imageCache.GetGray();
-    expResult = _cameraParamsController->ComputeNextCameraParams(inputImage, aeMode, useCycling, nextParams);
+    const Vision::ImageStatistics& stats = imageCache.GetStatistics(_cameraParamsController->GetSubSample());
+    expResult = _cameraParamsController->ComputeNextCameraParams(inputImage, aeMode, useCycling, nextParams,
+                                                                 &stats.GetHistogram());
   }
   
   if(RESULT_OK != expResult)
@@ -782,7 +826,8 @@ Vision::Image BlackOutRects(const Vision::Image& img, const std::vector<Anki::Re
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result VisionSystem::DetectFaces(Vision::ImageCache& imageCache, std::vector<Anki::Rectangle<s32>>& detectionRects,
-                                 const bool useCropping)
+                                 const bool useCropping,
+                                 Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   DEV_ASSERT(_faceTracker != nullptr, "VisionSystem.DetectFaces.NullFaceTracker");
  
@@ -830,12 +875,12 @@ Result VisionSystem::DetectFaces(Vision::ImageCache& imageCache, std::vector<Ank
 #     endif
     
     _faceTracker->Update(maskedImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs,
-                         _currentResult.debugImages);
+                         debugImages);
   }
   else
   {
     // Nothing already detected, so nothing to black out before looking for faces
-    _faceTracker->Update(grayImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs, _currentResult.debugImages);
+    _faceTracker->Update(grayImage, cropFactor, _currentResult.faces, _currentResult.updatedFaceIDs, debugImages);
   }
   
   for(auto faceIter = _currentResult.faces.begin(); faceIter != _currentResult.faces.end(); ++faceIter)
@@ -907,13 +952,13 @@ Result VisionSystem::DetectPets(Vision::ImageCache& imageCache,
 } // DetectPets()
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result VisionSystem::DetectMotion(Vision::ImageCache& imageCache)
+Result VisionSystem::DetectMotion(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
 
   Result result = RESULT_OK;
   
   _motionDetector->Detect(imageCache, _poseData, _prevPoseData,
-                          _currentResult.observedMotions, _currentResult.debugImages);
+                          _currentResult.observedMotions, debugImages);
   
   return result;
   
@@ -924,36 +969,40 @@ Result VisionSystem::DetectBrightColors(Vision::ImageCache& imageCache)
 {
   DEV_ASSERT(imageCache.HasColor(), "VisionSystem.DetectBrightColors.NoColor");
   const Vision::ImageRGB& image = imageCache.GetRGB();
+  if(kBrightColors_CoarseToFine)
+  {
+    const Vision::ImageRGB& coarseImage = imageCache.GetRGB(Vision::ImageCacheSize::Quarter);
+    return _brightColorDetector->Detect(image, coarseImage, _currentResult.salientPoints);
+  }
   Result result = _brightColorDetector->Detect(image, _currentResult.salientPoints);
   return result;
 } // DetectBrightColors()
 
-Result VisionSystem::UpdateOverheadMap(Vision::ImageCache& imageCache)
+Result VisionSystem::UpdateOverheadMap(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   DEV_ASSERT(imageCache.HasColor(), "VisionSystem.UpdateOverheadMap.NoColor");
-  const Vision::ImageRGB& image = imageCache.GetRGB();
-  Result result = _overheadMap->Update(image, _poseData, _currentResult.debugImages);
+  Result result = _overheadMap->Update(imageCache, _poseData, debugImages);
   return result;
 }
 
-Result VisionSystem::UpdateGroundPlaneClassifier(Vision::ImageCache& imageCache)
+Result VisionSystem::UpdateGroundPlaneClassifier(Vision::ImageCache& imageCache,
+                                                 Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   DEV_ASSERT(imageCache.HasColor(), "VisionSystem.UpdateGroundPlaneClassifier.NoColor");
-  const Vision::ImageRGB& image = imageCache.GetRGB();
-  Result result = _groundPlaneClassifier->Update(image, _poseData, _currentResult.debugImages,
+  Result result = _groundPlaneClassifier->Update(imageCache, _poseData, debugImages,
                                                  _currentResult.visualObstacles);
   return result;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Result VisionSystem::DetectLaserPoints(Vision::ImageCache& imageCache)
+Result VisionSystem::DetectLaserPoints(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   const bool isDarkExposure = (Util::IsNear(_currentCameraParams.exposureTime_ms, GetMinCameraExposureTime_ms()) &&
                                Util::IsNear(_currentCameraParams.gain, GetMinCameraGain()));
   
   Result result = _laserPointDetector->Detect(imageCache, _poseData, isDarkExposure,
                                               _currentResult.laserPoints,
-                                              _currentResult.debugImages);
+                                              debugImages);
   
   return result;
 }
@@ -1100,7 +1149,9 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
                                   const Vision::Image& claheImage,
                                   std::vector<Anki::Rectangle<s32>>& detectionRects,
                                   MarkerDetectionCLAHE useCLAHE,
-                                  const VisionPoseData& poseData)
+                                  const VisionPoseData& poseData,
+                                  VisionModeSet& modesProcessed,
+                                  Vision::DebugImageList<Vision::CompressedImage>& debugImages)
 {
   // Currently assuming we detect markers first, so we won't make use of anything already detected
   DEV_ASSERT(detectionRects.empty(), "VisionSystem.DetectMarkersWithCLAHE.ExpectingEmptyDetectionRects");
@@ -1199,13 +1250,13 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
       // NOTE: by definition of the Ready and Reset periods, we're guaranteed
       //  to have run MarkerDetection in the same frame we trigger a Reset
       DEV_ASSERT_MSG(shouldRunOnComposite, "VisionSystem.DetectMarkers.InvalidResetCallBeforeImageUsed","");
-      _currentResult.modesProcessed.Insert(VisionMode::Markers_Composite);
+      modesProcessed.Insert(VisionMode::Markers_Composite);
     }
   }
 
   #if(DEBUG_IMAGE_COMPOSITING)
   if(!dispCompositeImg.IsEmpty()) {
-    _currentResult.debugImages.emplace_back("ImageCompositing", dispCompositeImg);
+    debugImages.emplace_back("ImageCompositing", dispCompositeImg);
   }
   #endif
   
@@ -1217,21 +1268,27 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
     cropScheduler.Reset(kMarkerDetector_CropWidthFraction, CropScheduler::CyclingMode::Middle_Left_Middle_Right);
   }
   
-  Rectangle<s32> cropRect;
+  std::vector<Rectangle<s32>> cropRects;
   if(IsModeEnabled(VisionMode::Markers_FullFrame))
   {
-    cropRect = Rectangle<s32>(0,0,imagePtrs.front()->GetNumCols(), imagePtrs.front()->GetNumRows());
-    _currentResult.modesProcessed.Insert(VisionMode::Markers_FullFrame);
+    cropRects.emplace_back(0,0,imagePtrs.front()->GetNumCols(), imagePtrs.front()->GetNumRows());
+    modesProcessed.Insert(VisionMode::Markers_FullFrame);
   }
   else
   {
     const bool useHorizontalCycling = !IsModeEnabled(VisionMode::Markers_FullWidth);
     const bool useVariableHeight = !IsModeEnabled(VisionMode::Markers_FullHeight);
-    const bool cropInBounds = cropScheduler.GetCropRect(imagePtrs.front()->GetNumRows(),
-                                                        imagePtrs.front()->GetNumCols(),
-                                                        useHorizontalCycling,
-                                                        useVariableHeight,
-                                                        poseData, cropRect);
+    
+    // Predicted ROIs only stand in for the regular cycling crops, not for the full width/height ones modes ask for
+    static const std::vector<Rectangle<s32>> kNoPredictedROIs;
+    const bool usePredictedROIs = useHorizontalCycling && useVariableHeight;
+    const bool cropInBounds = cropScheduler.GetCropRects(imagePtrs.front()->GetNumRows(),
+                                                         imagePtrs.front()->GetNumCols(),
+                                                         useHorizontalCycling,
+                                                         useVariableHeight,
+                                                         poseData,
+                                                         (usePredictedROIs ? _predictedMarkerROIs : kNoPredictedROIs),
+                                                         cropRects);
 
     if(!cropInBounds)
     {
@@ -1239,12 +1296,18 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
       return RESULT_OK;
     }
     
-    DEV_ASSERT(cropRect.Area() > 0, "VisionSystem.DetectMarkersWithCLAHE.EmptyCrop");
+    DEV_ASSERT(!cropRects.empty() && cropRects.front().Area() > 0, "VisionSystem.DetectMarkersWithCLAHE.EmptyCrop");
     
-    _currentResult.modesProcessed.Enable(VisionMode::Markers_FullWidth, !useHorizontalCycling);
-    _currentResult.modesProcessed.Enable(VisionMode::Markers_FullHeight, !useVariableHeight);
+    modesProcessed.Enable(VisionMode::Markers_FullWidth, !useHorizontalCycling);
+    modesProcessed.Enable(VisionMode::Markers_FullHeight, !useVariableHeight);
   }
   
+  // Tracks need every frame in the same coordinates, so only use them on uncropped frames, and not when
+  // alternating between regular and CLAHE or composited images
+  const bool trackBetweenDetections = (kMarkerDetector_TrackBetweenDetections &&
+                                       IsModeEnabled(VisionMode::Markers_FullFrame) &&
+                                       imagePtrs.size() == 1);
+  
   Result lastResult = RESULT_OK;
   for(auto imgPtr : imagePtrs)
   {
@@ -1252,28 +1315,59 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
                imgPtr->GetNumCols() == imagePtrs.front()->GetNumCols(),
                "VisionSystem.DetectMarkersWithCLAHE.DifferingImageSizes");
     
-    const Vision::Image& imgROI = imgPtr->GetROI(cropRect);
-    lastResult = _markerDetector->Detect(imgROI, _currentResult.observedMarkers);
-    if(RESULT_OK != lastResult) {
-      break;
-    }
-    
-    // Debug crop windows
-    if(kMarkerDetector_VizCropScheduler)
+    for(const auto& cropRect : cropRects)
     {
-      Vision::ImageRGB dispImg;
-      dispImg.SetFromGray(imgROI);
-      for(auto const& marker : _currentResult.observedMarkers)
+      const size_t numMarkersBefore = _currentResult.observedMarkers.size();
+      
+      const Vision::Image& imgROI = imgPtr->GetROI(cropRect);
+      if(trackBetweenDetections) {
+        lastResult = _markerDetector->DetectOrTrack(imgROI, _currentResult.observedMarkers);
+      }
+      else {
+        lastResult = _markerDetector->Detect(imgROI, _currentResult.observedMarkers);
+      }
+      if(RESULT_OK != lastResult) {
+        break;
+      }
+      
+      // Debug crop windows
+      if(kMarkerDetector_VizCropScheduler)
       {
-        dispImg.DrawQuad(marker.GetImageCorners(), NamedColors::RED);
+        Vision::ImageRGB dispImg;
+        dispImg.SetFromGray(imgROI);
+        for(size_t i = numMarkersBefore; i < _currentResult.observedMarkers.size(); ++i)
+        {
+          dispImg.DrawQuad(_currentResult.observedMarkers[i].GetImageCorners(), NamedColors::RED);
+        }
+        dispImg.DrawRect(Rectangle<s32>{0,0,cropRect.GetWidth(),cropRect.GetHeight()}, NamedColors::RED);
+        debugImages.emplace_back("CroppedMarkers", dispImg);
       }
-      dispImg.DrawRect(Rectangle<s32>{0,0,cropRect.GetWidth(),cropRect.GetHeight()}, NamedColors::RED);
-      _currentResult.debugImages.emplace_back("CroppedMarkers", dispImg);
+      
+      // Adjust the markers found in this crop for its position, to put them back in (processing resolution)
+      // full image coordinates
+      if(cropRect.GetX() > 0 || cropRect.GetY() > 0)
+      {
+        for(size_t i = numMarkersBefore; i < _currentResult.observedMarkers.size(); ++i)
+        {
+          auto & marker = _currentResult.observedMarkers[i];
+          Quad2f shiftedCorners(marker.GetImageCorners());
+          for(auto & corner : shiftedCorners)
+          {
+            corner.x() += cropRect.GetX();
+            corner.y() += cropRect.GetY();
+          }
+          marker.SetImageCorners(shiftedCorners);
+        }
+      }
+    }
+    
+    if(RESULT_OK != lastResult) {
+      break;
     }
   }
 
   const bool meterFromChargerOnly = IsModeEnabled(VisionMode::Markers_ChargerOnly);
-  _currentResult.modesProcessed.Enable(VisionMode::Markers_ChargerOnly, meterFromChargerOnly);
+  modesProcessed.Enable(VisionMode::Markers_ChargerOnly, meterFromChargerOnly);
   
   auto markerIter = _currentResult.observedMarkers.begin();
   while(markerIter != _currentResult.observedMarkers.end())
@@ -1286,15 +1380,13 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
       continue;
     }
     
-    // Adjust the marker for the crop rectangle / processing resolution, to put it back in original image coordinates
+    // Adjust the marker for the processing resolution, to put it back in original image coordinates
+    // (it has already been adjusted for its crop rectangle above)
     Quad2f scaledCorners(marker.GetImageCorners());
-    if(cropRect.GetX() > 0 || cropRect.GetY() > 0 || kMarkerDetector_ScaleMultiplier != 1)
+    if(kMarkerDetector_ScaleMultiplier != 1)
     {
       for(auto & corner : scaledCorners)
       {
-        corner.x() += cropRect.GetX();
-        corner.y() += cropRect.GetY();
-
         // By default we display images at the default image cache size so we need to scale the marker
         // corners to that size
         const f32 scaleMultiplier = ImageCacheSizeToScaleFactor(Vision::ImageCache::GetSize(kMarkerDetector_ScaleMultiplier));
@@ -1322,12 +1414,7 @@ Result VisionSystem::DetectMarkers(Vision::ImageCache& imageCache,
       {
         const s32 fullNumRows = imageCache.GetNumRows(Vision::ImageCacheSize::Half);
         const s32 fullNumCols = imageCache.GetNumCols(Vision::ImageCacheSize::Half);
-        const int warpIndex = std::floor(corner.y() / (fullNumRows / _rollingShutterCorrector.GetNumDivisions()));
-        DEV_ASSERT_MSG(warpIndex >= 0 && warpIndex < _rollingShutterCorrector.GetPixelShifts().size(),
-                       "VisionSystem.DetectMarkersWithCLAHE.WarpIndexOOB", "Index:%d Corner y:%f",
-                       warpIndex, corner.y());
-        
-        const Vec2f& pixelShift = _rollingShutterCorrector.GetPixelShifts().at(warpIndex);
+        const Vec2f& pixelShift = _rollingShutterCorrector.GetPixelShiftForRow(corner.y(), fullNumRows);
         corner -= pixelShift;
 
         if(Util::IsFltLTZero(corner.x()) ||
@@ -1382,7 +1469,7 @@ void VisionSystem::CheckForNeuralNetResults()
         
         for(auto & mode : modes)
         {
-          _currentResult.modesProcessed.Insert(mode);
+          modesProcessed.Insert(mode);
         }
         
         if(IsModeEnabled(VisionMode::SaveImages) &&
@@ -1392,7 +1479,7 @@ void VisionSystem::CheckForNeuralNetResults()
           const Result saveResult = _imageSaver->Save(_neuralNetRunnerImage, _frameNumber);
           if(RESULT_OK == saveResult)
           {
-            _currentResult.modesProcessed.Insert(VisionMode::SaveImages);
+            modesProcessed.Insert(VisionMode::SaveImages);
           }
           
           const std::string jsonFilename = _imageSaver->GetFullFilename(_frameNumber, "json");
@@ -1428,7 +1515,7 @@ void VisionSystem::AddFakeDetections(const std::set<VisionMode>& modes)
     std::vector<Vision::SalientPointType> fakeDetectionsToAdd;
     for(auto & mode : modes)
     {
-      _currentResult.modesProcessed.Insert(mode);
+      modesProcessed.Insert(mode);
       
       static Util::RandomGenerator rng;
       if((VisionMode::Hands == mode) && (rng.RandDbl() < kFakeHandDetectionProbability))
@@ -1476,15 +1563,44 @@ void VisionSystem::UpdateRollingShutter(const VisionPoseData& poseData, const Vi
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Result VisionSystem::Update(const VisionSystemInput& input)
 {
-  _imageCache->Reset(input.imageBuffer);
+  // Expect each mode scheduled for this image to ask for the same sizes it did the last time it ran, so
+  // the cache can compute the ones it is able to together in one pass over the raw image
+  Vision::ImageCache::RequestSet expectedRequests;
+  if(kImageCachePrecomputeExpectedSizes)
+  {
+    for(const auto& mode : input.modesToProcess)
+    {
+      expectedRequests.Merge(_imageCache->GetLastRequests(EnumToString(mode)));
+    }
+  }
+  
+  _nextFrameTrace = input.frameTrace;
+  _nextFrameTrace.Stamp(VisionFrameStage::ProcessingStart);
+  _imageCache->Reset(input.imageBuffer, expectedRequests);
+  _nextFrameTrace.Stamp(VisionFrameStage::CacheBuilt);
 
   _modes = input.modesToProcess;
   _futureModes = input.futureModesToProcess;
   _imageCompressQuality = input.imageCompressQuality;
+  _predictedMarkerROIs = input.predictedMarkerROIs;
   
   return Update(input.poseData, *_imageCache);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+static void LogImageCacheRequestStats(const Vision::ImageCache& imageCache)
+{
+  for(const auto& entry : imageCache.GetRequestStats())
+  {
+    const auto& stats = entry.second;
+    PRINT_CH_INFO(kLogChannelName, "VisionSystem.ImageCacheRequestStats",
+                  "%s: Gray[F/H/Q/E]=%u/%u/%u/%u RGB[F/H/Q/E]=%u/%u/%u/%u Computed:%u FromLargerSize:%u",
+                  entry.first.c_str(),
+                  stats.numGrayRequests[0], stats.numGrayRequests[1], stats.numGrayRequests[2], stats.numGrayRequests[3],
+                  stats.numRGBRequests[0],  stats.numRGBRequests[1],  stats.numRGBRequests[2],  stats.numRGBRequests[3],
+                  stats.numComputed, stats.numFromLargerSize);
+  }
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // This is the regular Update() call
@@ -1499,6 +1615,9 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     return RESULT_FAIL;
   }
   
+  // Nothing from the last frame's scratch memory is used anymore: its results were all copied out
+  _scratchArena->Reset();
+  
   _frameNumber++;
   
   // Set up the results for this frame:
@@ -1508,6 +1627,9 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   result.cameraParams.exposureTime_ms = -1;
   std::swap(result, _currentResult);
   
+  _currentResult.frameTrace = std::move(_nextFrameTrace);
+  _nextFrameTrace = VisionFrameTrace();
+  
   auto& visionModesProcessed = _currentResult.modesProcessed;
   visionModesProcessed.Clear();
   
@@ -1526,9 +1648,8 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   if(_modes.IsEmpty())
   {
     // Push the empty result and bail
-    _mutex.lock();
-    _results.push(_currentResult);
-    _mutex.unlock();
+    _currentResult.frameTrace.Stamp(VisionFrameStage::ResultQueued);
+    QueueCurrentResult();
     return RESULT_OK;
   }
   
@@ -1546,21 +1667,52 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   
   // Note: this will do nothing and leave claheImage empty if CLAHE is disabled
   // entirely or for this frame.
+  imageCache.SetRequester("CLAHE");
   lastResult = ApplyCLAHE(imageCache, useCLAHE, claheImage);
   ANKI_VERIFY(RESULT_OK == lastResult, "VisionSystem.Update.FailedCLAHE", "ApplyCLAHE supposedly has no failure mode");
   
-  if(IsModeEnabled(VisionMode::Stats))
-  {
-    Tic("TotalStats");
-    _currentResult.imageMean = ComputeMean(imageCache, kImageMeanSampleInc);
-    visionModesProcessed.Insert(VisionMode::Stats);
-    Toc("TotalStats");
-  }
-
   DetectionRectsByMode detectionsByMode;
 
   bool anyModeFailures = false;
   
+  // The modes below run as tasks on _modeTaskGraph, in parallel wherever they don't share any resources. Each
+  // task gets its own output, which is merged into _currentResult in the order the tasks were added once all of
+  // them are done. Nothing here runs until _modeTaskGraph->Run(), so anything captured by reference must
+  // outlive that call.
+  std::list<ModeTaskOutput> taskOutputs;
+  auto addModeTask = [this,&taskOutputs,&imageCache](VisionMode mode,
+                                                     VisionModeTaskGraph::ResourceSet reads,
+                                                     VisionModeTaskGraph::ResourceSet writes,
+                                                     std::function<Result(ModeTaskOutput&)>&& func)
+  {
+    taskOutputs.emplace_back();
+    ModeTaskOutput& output = taskOutputs.back();
+    output.mode = mode;
+    _modeTaskGraph->AddTask(reads, writes, [&output,&imageCache,func = std::move(func)]() {
+      const s64 startTime_us = VisionFrameTrace::GetCurrentTime_us();
+      imageCache.SetRequester(EnumToString(output.mode));
+      output.result = func(output);
+      output.duration_us = VisionFrameTrace::GetCurrentTime_us() - startTime_us;
+    });
+  };
+  
+  if(IsModeEnabled(VisionMode::Stats))
+  {
+    addModeTask(VisionMode::Stats, 0, kModeResource_Stats, [this,&imageCache](ModeTaskOutput& output) {
+      Tic("TotalStats");
+      _currentResult.imageMean = ComputeMean(imageCache, kImageMeanSampleInc);
+      output.modesProcessed.Insert(VisionMode::Stats);
+      Toc("TotalStats");
+      return RESULT_OK;
+    });
+  }
+  
+  if(!IsModeEnabled(VisionMode::Markers_Composite) && 
+     _imageCompositor->GetNumImagesComposited() > 0) {
+    // Clears any leftover artifacts from prematurely cancelled ImageCompositing
+    // Check this here to avoid gating it on whether or not DetectMarkers
+    _imageCompositor->Reset();
+  }
   
   if(IsModeEnabled(VisionMode::Markers))
   {
@@ -1578,31 +1730,30 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
                                                                                   DEG_TO_RAD(kHeadTurnSpeedThreshBlock_degs)));
       if(!wasRotatingTooFast)
       {
-        // Marker detection uses rolling shutter compensation
-        UpdateRollingShutter(poseData, imageCache);
-        
-        Tic("TotalMarkers");
-        lastResult = DetectMarkers(imageCache, claheImage, detectionsByMode[VisionMode::Markers], useCLAHE, poseData);
-        
-        if(RESULT_OK != lastResult) {
-          PRINT_NAMED_ERROR("VisionSystem.Update.DetectMarkersFailed", "");
-          anyModeFailures = true;
-        } else {
-          visionModesProcessed.Insert(VisionMode::Markers);
-          visionModesProcessed.Enable(VisionMode::Markers_FastRotation, allowWhileRotatingFast);
-        }
-        Toc("TotalMarkers");
+        auto& markerDetectionRects = detectionsByMode[VisionMode::Markers];
+        addModeTask(VisionMode::Markers, 0, kModeResource_Markers,
+                    [this,&imageCache,&claheImage,&markerDetectionRects,&poseData,
+                     useCLAHE,allowWhileRotatingFast](ModeTaskOutput& output) {
+          // Marker detection uses rolling shutter compensation
+          UpdateRollingShutter(poseData, imageCache);
+          
+          Tic("TotalMarkers");
+          const Result result = DetectMarkers(imageCache, claheImage, markerDetectionRects, useCLAHE, poseData,
+                                              output.modesProcessed, output.debugImages);
+          
+          if(RESULT_OK != result) {
+            PRINT_NAMED_ERROR("VisionSystem.Update.DetectMarkersFailed", "");
+          } else {
+            output.modesProcessed.Insert(VisionMode::Markers);
+            output.modesProcessed.Enable(VisionMode::Markers_FastRotation, allowWhileRotatingFast);
+          }
+          Toc("TotalMarkers");
+          return result;
+        });
       }
     }
   }
   
-  if(!IsModeEnabled(VisionMode::Markers_Composite) && 
-     _imageCompositor->GetNumImagesComposited() > 0) {
-    // Clears any leftover artifacts from prematurely cancelled ImageCompositing
-    // Check this here to avoid gating it on whether or not DetectMarkers
-    _imageCompositor->Reset();
-  }
-  
   if(IsModeEnabled(VisionMode::Faces))
   {
     const bool estimatingFacialExpression = IsModeEnabled(VisionMode::Faces_Expression);
@@ -1617,61 +1768,76 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     const bool detectingBlink = IsModeEnabled(VisionMode::Faces_Blink);
     _faceTracker->EnableBlinkDetection(detectingBlink);
 
-    
-    Tic("TotalFaces");
-    // NOTE: To use rolling shutter in DetectFaces, call UpdateRollingShutterHere
-    // See: VIC-1417 
-    // UpdateRollingShutter(poseData, imageCache);
     const bool useCropping = IsModeEnabled(VisionMode::Faces_Crop);
-    if((lastResult = DetectFaces(imageCache, detectionsByMode[VisionMode::Faces], useCropping)) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectFacesFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Faces);
-      visionModesProcessed.Enable(VisionMode::Faces_Crop,          useCropping);
-      visionModesProcessed.Enable(VisionMode::Faces_Expression,    estimatingFacialExpression);
-      visionModesProcessed.Enable(VisionMode::Faces_Smile,         detectingSmile);
-      visionModesProcessed.Enable(VisionMode::Faces_Gaze,          detectingGaze);
-      visionModesProcessed.Enable(VisionMode::Faces_Blink,         detectingBlink);
-    }
-    Toc("TotalFaces");
+    
+    auto& faceDetectionRects = detectionsByMode[VisionMode::Faces];
+    addModeTask(VisionMode::Faces, 0, kModeResource_Okao,
+                [this,&imageCache,&faceDetectionRects,useCropping,estimatingFacialExpression,
+                 detectingSmile,detectingGaze,detectingBlink](ModeTaskOutput& output) {
+      Tic("TotalFaces");
+      // NOTE: To use rolling shutter in DetectFaces, call UpdateRollingShutterHere
+      // See: VIC-1417 
+      // UpdateRollingShutter(poseData, imageCache);
+      const Result result = DetectFaces(imageCache, faceDetectionRects, useCropping, output.debugImages);
+      if(RESULT_OK != result) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectFacesFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::Faces);
+        output.modesProcessed.Enable(VisionMode::Faces_Crop,          useCropping);
+        output.modesProcessed.Enable(VisionMode::Faces_Expression,    estimatingFacialExpression);
+        output.modesProcessed.Enable(VisionMode::Faces_Smile,         detectingSmile);
+        output.modesProcessed.Enable(VisionMode::Faces_Gaze,          detectingGaze);
+        output.modesProcessed.Enable(VisionMode::Faces_Blink,         detectingBlink);
+      }
+      Toc("TotalFaces");
+      return result;
+    });
   }
   
   if(IsModeEnabled(VisionMode::Pets))
   {
-    Tic("TotalPets");
-    if((lastResult = DetectPets(imageCache, detectionsByMode[VisionMode::Pets])) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectPetsFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Pets);
-    }
-    Toc("TotalPets");
+    auto& petDetectionRects = detectionsByMode[VisionMode::Pets];
+    addModeTask(VisionMode::Pets, 0, kModeResource_Okao, [this,&imageCache,&petDetectionRects](ModeTaskOutput& output) {
+      Tic("TotalPets");
+      const Result result = DetectPets(imageCache, petDetectionRects);
+      if(RESULT_OK != result) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectPetsFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::Pets);
+      }
+      Toc("TotalPets");
+      return result;
+    });
   }
   
   if(IsModeEnabled(VisionMode::Motion))
   {
-    Tic("TotalMotion");
-    if((lastResult = DetectMotion(imageCache)) != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectMotionFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Motion);
-    }
-    Toc("TotalMotion");
+    addModeTask(VisionMode::Motion, 0, kModeResource_Motion, [this,&imageCache](ModeTaskOutput& output) {
+      Tic("TotalMotion");
+      const Result result = DetectMotion(imageCache, output.debugImages);
+      if(RESULT_OK != result) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectMotionFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::Motion);
+      }
+      Toc("TotalMotion");
+      return result;
+    });
   }
 
   if(IsModeEnabled(VisionMode::BrightColors)){
     if (imageCache.HasColor()){
-      Tic("TotalBrightColors");
-      lastResult = DetectBrightColors(imageCache);
-      Toc("TotalBrightColors");
-      if (lastResult != RESULT_OK){
-        PRINT_NAMED_ERROR("VisionSystem.Update.DetectBrightColorsFailed","");
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::BrightColors);
-      }
+      addModeTask(VisionMode::BrightColors, 0, kModeResource_BrightColors, [this,&imageCache](ModeTaskOutput& output) {
+        Tic("TotalBrightColors");
+        const Result result = DetectBrightColors(imageCache);
+        Toc("TotalBrightColors");
+        if (result != RESULT_OK){
+          PRINT_NAMED_ERROR("VisionSystem.Update.DetectBrightColorsFailed","");
+        } else {
+          output.modesProcessed.Insert(VisionMode::BrightColors);
+        }
+        return result;
+      });
     } else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process bright colors. No color image!");
     }
@@ -1680,14 +1846,15 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   if (IsModeEnabled(VisionMode::OverheadMap))
   {
     if (imageCache.HasColor()) {
-      Tic("UpdateOverheadMap");
-      lastResult = UpdateOverheadMap(imageCache);
-      Toc("UpdateOverheadMap");
-      if (lastResult != RESULT_OK) {
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::OverheadMap);
-      }
+      addModeTask(VisionMode::OverheadMap, 0, kModeResource_OverheadMap, [this,&imageCache](ModeTaskOutput& output) {
+        Tic("UpdateOverheadMap");
+        const Result result = UpdateOverheadMap(imageCache, output.debugImages);
+        Toc("UpdateOverheadMap");
+        if (result == RESULT_OK) {
+          output.modesProcessed.Insert(VisionMode::OverheadMap);
+        }
+        return result;
+      });
     }
     else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process overhead map. No color image!");
@@ -1697,14 +1864,15 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   if (IsModeEnabled(VisionMode::Obstacles))
   {
     if (imageCache.HasColor()) {
-      Tic("DetectVisualObstacles");
-      lastResult = UpdateGroundPlaneClassifier(imageCache);
-      Toc("DetectVisualObstacles");
-      if (lastResult != RESULT_OK) {
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::Obstacles);
-      }
+      addModeTask(VisionMode::Obstacles, 0, kModeResource_Obstacles, [this,&imageCache](ModeTaskOutput& output) {
+        Tic("DetectVisualObstacles");
+        const Result result = UpdateGroundPlaneClassifier(imageCache, output.debugImages);
+        Toc("DetectVisualObstacles");
+        if (result == RESULT_OK) {
+          output.modesProcessed.Insert(VisionMode::Obstacles);
+        }
+        return result;
+      });
     }
     else {
       PRINT_NAMED_WARNING("VisionSystem.Update.NoColorImage", "Could not process visual obstacles. No color image!");
@@ -1713,27 +1881,85 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
 
   if(IsModeEnabled(VisionMode::OverheadEdges))
   {
-    Tic("TotalOverheadEdges");
+    // The edge detector only adds to _currentResult.overheadEdges
+    addModeTask(VisionMode::OverheadEdges, 0, kModeResource_Edges, [this,&imageCache](ModeTaskOutput& output) {
+      Tic("TotalOverheadEdges");
 
-    lastResult = _overheadEdgeDetector->Detect(imageCache, _poseData, _currentResult);
-    
-    if(lastResult != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectOverheadEdgesFailed", "");
+      const Result result = _overheadEdgeDetector->Detect(imageCache, _poseData, _currentResult);
+      
+      if(result != RESULT_OK) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectOverheadEdgesFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::OverheadEdges);
+      }
+      Toc("TotalOverheadEdges");
+      return result;
+    });
+  }
+  
+  if(IsModeEnabled(VisionMode::Lasers))
+  {
+    // Skip laser point detection if the Laser FeatureGate is disabled.
+    // TODO: Remove this once laser feature is enabled (COZMO-11185)
+    if(_context->GetFeatureGate()->IsFeatureEnabled(FeatureType::Laser))
+    {
+      addModeTask(VisionMode::Lasers, 0, kModeResource_Lasers, [this,&imageCache](ModeTaskOutput& output) {
+        Tic("TotalLasers");
+        const Result result = DetectLaserPoints(imageCache, output.debugImages);
+        if(result != RESULT_OK) {
+          PRINT_NAMED_ERROR("VisionSystem.Update.DetectlaserPointsFailed", "");
+        } else {
+          output.modesProcessed.Insert(VisionMode::Lasers);
+        }
+        Toc("TotalLasers");
+        return result;
+      });
+    }
+  }
+  
+  // Check for illumination state
+  if(IsModeEnabled(VisionMode::Illumination) &&
+     !IsModeEnabled(VisionMode::AutoExp_Cycling)) // don't check for illumination if cycling exposure
+  {
+    addModeTask(VisionMode::Illumination, 0, kModeResource_Illumination, [this,&imageCache](ModeTaskOutput& output) {
+      Tic("Illumination");
+      const Result result = DetectIllumination(imageCache);
+      Toc("Illumination");
+      if (result != RESULT_OK) {
+        PRINT_NAMED_ERROR("VisionSystem.Update.DetectIlluminationFailed", "");
+      } else {
+        output.modesProcessed.Insert(VisionMode::Illumination);
+      }
+      return result;
+    });
+  }
+  
+  Tic("TotalModeTasks");
+  _modeTaskGraph->Run();
+  Toc("TotalModeTasks");
+  
+  for(auto& output : taskOutputs)
+  {
+    if(RESULT_OK != output.result)
+    {
       anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::OverheadEdges);
     }
-    Toc("TotalOverheadEdges");
+    visionModesProcessed.Insert(output.modesProcessed.GetSet());
+    _currentResult.debugImages.splice(_currentResult.debugImages.end(), output.debugImages);
+    _currentResult.frameTrace.modeDuration_us.emplace_back(output.mode, output.duration_us);
   }
+  _currentResult.frameTrace.Stamp(VisionFrameStage::ModesComplete);
   
   if(IsModeEnabled(VisionMode::Calibration))
   {
+    bool isCalibrationDone = true;
     switch(kCalibTargetType)
     {
       case CameraCalibrator::CalibTargetType::CHECKERBOARD:
       {
-        lastResult = _cameraCalibrator->ComputeCalibrationFromCheckerboard(_currentResult.cameraCalibration,
-                                                                           _currentResult.debugImages);
+        // Solved on a worker thread, picked up below once done
+        lastResult = _cameraCalibrator->StartCalibrationFromCheckerboard(_currentResult.debugImages);
+        isCalibrationDone = false;
         break;
       }
       case CameraCalibrator::CalibTargetType::QBERT:
@@ -1754,28 +1980,24 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     if(lastResult != RESULT_OK) {
       PRINT_NAMED_ERROR("VisionSystem.Update.ComputeCalibrationFailed", "");
       anyModeFailures = true;
-    } else {
+    } else if(isCalibrationDone) {
       visionModesProcessed.Insert(VisionMode::Calibration);
     }
   }
   
-  if(IsModeEnabled(VisionMode::Lasers))
+  // The checkerboard solve can take seconds, so it runs on its own and is reported with whichever frame it
+  // finishes during
+  Result checkerboardResult = RESULT_OK;
+  if(_cameraCalibrator->GetCheckerboardCalibration(_currentResult.cameraCalibration, checkerboardResult))
   {
-    // Skip laser point detection if the Laser FeatureGate is disabled.
-    // TODO: Remove this once laser feature is enabled (COZMO-11185)
-    if(_context->GetFeatureGate()->IsFeatureEnabled(FeatureType::Laser))
-    {
-      Tic("TotalLasers");
-      if((lastResult = DetectLaserPoints(imageCache)) != RESULT_OK) {
-        PRINT_NAMED_ERROR("VisionSystem.Update.DetectlaserPointsFailed", "");
-        anyModeFailures = true;
-      } else {
-        visionModesProcessed.Insert(VisionMode::Lasers);
-      }
-      Toc("TotalLasers");
+    if(checkerboardResult != RESULT_OK) {
+      PRINT_NAMED_ERROR("VisionSystem.Update.ComputeCalibrationFailed", "");
+      anyModeFailures = true;
+    } else {
+      visionModesProcessed.Insert(VisionMode::Calibration);
     }
   }
-
+  
   // Check for any objects from the detector. It runs asynchronously, so these objects
   // will be from a different image than the one in the cache and will use their own
   // VisionProcessingResult.
@@ -1798,14 +2020,21 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     }
   }
   
-  // Run the set of required networks
+  // Run the set of required networks. While the camera is still, they may reuse their last results if the
+  // scene hasn't changed either.
+  const bool isRobotMoving = (!networksToRun.empty() &&
+                              (poseData.histState.WasCameraMoving() || poseData.histState.WasPickedUp() ||
+                               poseData.imuDataHistory.WasRotatingTooFast(imageCache.GetTimeStamp(),
+                                                                          DEG_TO_RAD(kBodyTurnSpeedThreshBlock_degs),
+                                                                          DEG_TO_RAD(kHeadTurnSpeedThreshBlock_degs))));
+  imageCache.SetRequester("NeuralNets");
   for(const auto& networkName : networksToRun)
   {
-    const bool started = _neuralNetRunners.at(networkName)->StartProcessingIfIdle(imageCache);
+    const bool started = _neuralNetRunners.at(networkName)->StartProcessingIfIdle(imageCache, isRobotMoving);
     if(started)
     {
       // Remember the timestamp of the image used to do object detection, or the entire image
-      // if saving is enabled
+      // if saving is enabled (by reference: the cache leaves it alone while it's held)
       if(IsModeEnabled(VisionMode::SaveImages))
       {
         _neuralNetRunnerImage = imageCache.GetRGB(_imageSaver->GetParams().size);
@@ -1820,21 +2049,6 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     }
   }
   
-  // Check for illumination state
-  if(IsModeEnabled(VisionMode::Illumination) &&
-     !IsModeEnabled(VisionMode::AutoExp_Cycling)) // don't check for illumination if cycling exposure
-  {
-    Tic("Illumination");
-    lastResult = DetectIllumination(imageCache);
-    Toc("Illumination");
-    if (lastResult != RESULT_OK) {
-      PRINT_NAMED_ERROR("VisionSystem.Update.DetectIlluminationFailed", "");
-      anyModeFailures = true;
-    } else {
-      visionModesProcessed.Insert(VisionMode::Illumination);
-    }
-  }
-
   UpdateMeteringRegions(imageCache.GetTimeStamp(), std::move(detectionsByMode));
   
   // NOTE: This should come after any detectors that add things to "detectionRects"
@@ -1843,6 +2057,7 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   const bool isAutoExposing   = IsModeEnabled(VisionMode::AutoExp);
   if(isAutoExposing || isWhiteBalancing)
   {
+    imageCache.SetRequester(EnumToString(VisionMode::AutoExp));
     Tic("UpdateCameraParams");
     lastResult = UpdateCameraParams(imageCache);
     Toc("UpdateCameraParams");
@@ -1858,6 +2073,7 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   
   if(IsModeEnabled(VisionMode::Benchmark))
   {
+    imageCache.SetRequester(EnumToString(VisionMode::Benchmark));
     Tic("Benchmarking");
     const Result benchMarkResult = _benchmark->Update(imageCache);
     Toc("BenchMarking");
@@ -1872,6 +2088,7 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   
   if(IsModeEnabled(VisionMode::SaveImages) && _imageSaver->WantsToSave(_currentResult, imageCache.GetTimeStamp()))
   {
+    imageCache.SetRequester(EnumToString(VisionMode::SaveImages));
     Tic("SaveImages");
     
     // Check this before calling Save(), since that can modify imageSaver's state
@@ -1897,6 +2114,7 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
 
   if(IsModeEnabled(VisionMode::Viz))
   {
+    imageCache.SetRequester(EnumToString(VisionMode::Viz));
     Tic("Viz");
 
     _currentResult.compressedDisplayImg.Compress(imageCache.GetRGB(), _imageCompressQuality);
@@ -1920,6 +2138,7 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
   if(IsModeEnabled(VisionMode::MirrorMode))
   {
     // TODO: Add an ImageCache::Size for MirrorMode directly
+    imageCache.SetRequester(EnumToString(VisionMode::MirrorMode));
     const Result result = _mirrorModeManager->CreateMirrorModeImage(imageCache.GetRGB(), _currentResult);
     if(RESULT_OK != result)
     {
@@ -1929,11 +2148,20 @@ Result VisionSystem::Update(const VisionPoseData& poseData, Vision::ImageCache&
     }
   }
   
+  if((kImageCacheStatsLogPeriod_frames > 0) && (0 == (_frameNumber % kImageCacheStatsLogPeriod_frames)))
+  {
+    LogImageCacheRequestStats(imageCache);
+    imageCache.ClearRequestStats();
+    
+    PRINT_CH_INFO(kLogChannelName, "VisionSystem.ScratchArenaStats",
+                  "Capacity:%zu Peak:%zu Overflows:%u",
+                  _scratchArena->GetCapacity(), _scratchArena->GetPeakUsage(), _scratchArena->GetNumOverflows());
+  }
+  
   // We've computed everything from this image that we're gonna compute.
   // Push it onto the queue of results all together.
-  _mutex.lock();
-  _results.push(_currentResult);
-  _mutex.unlock();
+  _currentResult.frameTrace.Stamp(VisionFrameStage::ResultQueued);
+  QueueCurrentResult();
   
   return (anyModeFailures ? RESULT_FAIL : RESULT_OK);
 } // Update()
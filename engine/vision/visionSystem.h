@@ -28,6 +28,7 @@
 #include "engine/vision/visionProcessingResult.h"
 #include "engine/vision/visionSystemInput.h"
 
+#include "coretech/common/engine/mailbox.h"
 #include "coretech/common/engine/matlabInterface.h"
 #include "coretech/common/engine/robotTimeStamp.h"
 #include "coretech/vision/engine/brightColorDetector.h"
@@ -52,8 +53,6 @@
 
 #include "util/bitFlags/bitFlags.h"
 
-#include <mutex>
-#include <queue>
 
 namespace Anki {
  
@@ -67,6 +66,7 @@ namespace Vision {
   class NeuralNetRunner;
   class PetTracker;
   class ImageCompositor;
+  class ScratchArena;
 }
   
 namespace Vector {
@@ -85,6 +85,7 @@ namespace Vector {
   class Robot;
   class VizManager;
   class GroundPlaneClassifier;
+  class VisionModeTaskGraph;
   
   class VisionSystem : public Vision::Profiler
   {
@@ -198,10 +199,16 @@ namespace Vector {
     RobotTimeStamp_t _lastRollingShutterCorrectionTime;
        
     std::unique_ptr<Vision::ImageCache> _imageCache;
+
+    // Temporary images for processing one frame, shared by all the modes and reset at the start of each Update
+    std::unique_ptr<Vision::ScratchArena> _scratchArena;
     
     bool _isInitialized = false;
     const CozmoContext* _context = nullptr;
     
+    // Where undistortion maps are saved, so they're only computed once per calibration
+    std::string _undistortionMapCachePath;
+    
     Vision::Camera _camera;
     
     Vision::CameraParams _currentCameraParams;
@@ -211,6 +218,9 @@ namespace Vector {
     VisionModeSet _modes;
     VisionModeSet _futureModes;
     
+    // Trace for the image being given to the next Update, moved into _currentResult once it starts
+    VisionFrameTrace _nextFrameTrace;
+    
     s32 _frameNumber = 0;
     
     // Snapshots of robot state
@@ -241,6 +251,7 @@ namespace Vector {
     std::unique_ptr<ImageSaver>                     _imageSaver;
     std::unique_ptr<MirrorModeManager>              _mirrorModeManager;
     std::unique_ptr<Vision::Benchmark>              _benchmark;
+    std::unique_ptr<VisionModeTaskGraph>            _modeTaskGraph;
     
     std::map<std::string, std::unique_ptr<Vision::NeuralNetRunner>> _neuralNetRunners;
     
@@ -249,6 +260,9 @@ namespace Vector {
     Vision::CompressedImage _compressedDisplayImg;
     s32 _imageCompressQuality = 0;
     
+    // Where known objects' markers should appear in the current image, see VisionSystemInput
+    std::vector<Rectangle<s32>> _predictedMarkerROIs;
+    
     Result UpdatePoseData(const VisionPoseData& newPoseData);
     Radians GetCurrentHeadAngle();
     Radians GetPreviousHeadAngle();
@@ -270,11 +284,15 @@ namespace Vector {
     // Uses grayscale
     Result ApplyCLAHE(Vision::ImageCache& imageCache, const MarkerDetectionCLAHE useCLAHE, Vision::Image& claheImage);
     
+    // Helpers which run as _modeTaskGraph tasks add debug images (and processed sub-modes) to the given lists
+    // instead of to _currentResult, so they can run in parallel. Update merges them back in a fixed order.
     Result DetectMarkers(Vision::ImageCache& imageCache,
                          const Vision::Image& claheImage,
                          std::vector<Anki::Rectangle<s32>>& detectionRects,
                          MarkerDetectionCLAHE useCLAHE,
-                         const VisionPoseData& poseData);
+                         const VisionPoseData& poseData,
+                         VisionModeSet& modesProcessed,
+                         Vision::DebugImageList<Vision::CompressedImage>& debugImages);
     
     // Uses grayscale
     static u8 ComputeMean(Vision::ImageCache& imageCache, const s32 sampleInc);
@@ -292,19 +310,20 @@ namespace Vector {
     Result UpdateCameraParams(Vision::ImageCache& imageCache);
     
     // Will use color if not empty, or gray otherwise
-    Result DetectLaserPoints(Vision::ImageCache& imageCache);
+    Result DetectLaserPoints(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages);
 
     // Uses grayscale
     Result DetectFaces(Vision::ImageCache& imageCache,
                        std::vector<Anki::Rectangle<s32>>& detectionRects,
-                       const bool useCropping);
+                       const bool useCropping,
+                       Vision::DebugImageList<Vision::CompressedImage>& debugImages);
     
     // Uses grayscale
     Result DetectPets(Vision::ImageCache& imageCache,
                       std::vector<Anki::Rectangle<s32>>& ignoreROIs);
     
     // Will use color if not empty, or gray otherwise
-    Result DetectMotion(Vision::ImageCache& imageCache);
+    Result DetectMotion(Vision::ImageCache& imageCache, Vision::DebugImageList<Vision::CompressedImage>& debugImages);
 
     // Uses color
     Result DetectBrightColors(Vision::ImageCache& imageCache);
@@ -313,25 +332,29 @@ namespace Vector {
     Result DetectIllumination(Vision::ImageCache& imageCache);
 
     // Uses color
-    Result UpdateOverheadMap(Vision::ImageCache& image);
+    Result UpdateOverheadMap(Vision::ImageCache& image, Vision::DebugImageList<Vision::CompressedImage>& debugImages);
 
     // Uses colors
-    Result UpdateGroundPlaneClassifier(Vision::ImageCache& image);
+    Result UpdateGroundPlaneClassifier(Vision::ImageCache& image, Vision::DebugImageList<Vision::CompressedImage>& debugImages);
     
     void CheckForNeuralNetResults();
     void AddFakeDetections(const std::set<VisionMode>& modes); // For debugging
     
     Result SaveSensorData() const;
 
+    // Hands _currentResult off to the main thread, leaving it moved-from until the next Update
+    void QueueCurrentResult();
+
     // Contrast-limited adaptive histogram equalization (CLAHE)
     cv::Ptr<cv::CLAHE> _clahe;
     s32 _lastClaheTileSize;
     s32 _lastClaheClipLimit;
     bool _currentUseCLAHE = true;
 
-    // "Mailbox" for passing things out to main thread
-    std::mutex _mutex;
-    std::queue<VisionProcessingResult> _results;
+    // Mailbox for passing results out to main thread. Roughly a second of frames can be waiting before new ones
+    // are dropped.
+    static constexpr u8 kNumResultsMailboxes = 16;
+    MultiMailbox<VisionProcessingResult, kNumResultsMailboxes> _results;
     VisionProcessingResult _currentResult;
 
     // Image compositor settings, 
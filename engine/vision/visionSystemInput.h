@@ -12,14 +12,18 @@
 #ifndef __Engine_Vision_VisionSystemInput_H__
 #define __Engine_Vision_VisionSystemInput_H__
 
+#include "engine/vision/visionFrameTrace.h"
 #include "engine/vision/visionModeSet.h"
 #include "engine/vision/visionPoseData.h"
 
+#include "coretech/common/shared/math/rect.h"
 #include "coretech/vision/engine/imageBuffer/imageBuffer.h"
 #include "coretech/vision/engine/imageCache.h"
 
 #include "clad/types/visionModes.h"
 
+#include <vector>
+
 namespace Anki {
 namespace Vector {
 
@@ -48,6 +52,13 @@ struct VisionSystemInput
 
   // Quality at which to jpg compress images for display
   s32 imageCompressQuality = 50;
+
+  // Capture and dequeue times of imageBuffer, to be continued by VisionSystem
+  VisionFrameTrace frameTrace;
+
+  // Bounding boxes, in calibration resolution, of where the markers of known objects should appear in imageBuffer,
+  // most important first. Marker detection searches just these regions between full sweeps (see CropScheduler).
+  std::vector<Rectangle<s32>> predictedMarkerROIs;
 };
 
 }
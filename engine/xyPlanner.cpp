@@ -4,7 +4,9 @@
  * Author: Michael Willett
  * Created: 2018-05-11
  *
- * Description: Simple 2d grid uniform planner with path smoothing step
+ * Description: Simple 2d grid uniform planner with path smoothing step. Can run as an anytime search that keeps
+ *              improving its plan in the background, and repairs its search tree when the map changes. New plans
+ *              with several goals search the nearest ones in parallel
  *
  * Copyright: Anki, Inc. 2018
  *
@@ -16,12 +18,14 @@
 #include "engine/cozmoContext.h"
 #include "engine/robot.h"
 
+#include "coretech/planning/engine/anytimeAStar.h"
 #include "coretech/planning/engine/geometryHelpers.h"
 
 #include "util/console/consoleInterface.h"
 #include "util/threading/threadPriority.h"
 
 #include <chrono>
+#include <mutex>
 
 #define LOG_CHANNEL "Planner"
 
@@ -34,10 +38,44 @@ namespace {
 
   // minimum precision for joining path segments
   const float kPathPrecisionTolerance = .1f;
+
+  // anytime search: suboptimality bound of the first plan, and how much each improvement tightens it
+  const float  kAnytimeInitialEpsilon    = 3.f;
+  const float  kAnytimeEpsilonStep       = .5f;
+
+  // expansions per background improvement step, so that a new plan request never waits long for the lock
+  const size_t kAnytimeSliceExpansions   = 2000;
+
+  // past this many changed map regions, regrowing the search is not worth it over starting again
+  const size_t kMaxRepairRegions         = 256;
+
+  // parallel goal search: a plan is accepted once it costs at most this much more than the lower bound of every goal
+  // still being searched
+  const float  kParallelGoalAcceptRatio  = 1.25f;
 }
 
 CONSOLE_VAR_RANGED( int, kArtificialPlanningDelay_ms, "XYPlanner", 0, 0, 3900 );
 
+// if false, every plan runs a fresh bidirectional search instead of the anytime search
+CONSOLE_VAR( bool, kXYPlannerUseAnytimeSearch, "XYPlanner", true );
+
+// number of nearest goals a new plan searches in parallel, one thread each. 1 searches all goals in a single search
+CONSOLE_VAR_RANGED( int, kXYPlannerParallelGoals, "XYPlanner", 3, 1, 8 );
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct XYPlanner::AnytimeSearch
+{
+  AnytimeSearch(const MapComponent& map, const volatile bool& stopPlanning)
+  : config(map, stopPlanning)
+  , search(config, kAnytimeInitialEpsilon, kAnytimeEpsilonStep) {}
+
+  AnytimePlannerConfig                             config;
+  AnytimeAStar<PlannerPoint, AnytimePlannerConfig> search;
+  std::vector<Point2f>                             goals;         // goals the search tree is rooted at
+  MapComponent::MapChangeStamp                     mapStamp;      // map changes already accounted for in the tree
+  float                                            planCost = 0.f; // cost of the plan the current path was built from
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 //  XYPlanner
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -48,6 +86,10 @@ XYPlanner::XYPlanner(Robot* robot, bool runSync)
 , _targets() 
 , _status(EPlannerStatus::CompleteNoPlan)
 , _collisionPenalty(0.f)
+, _lastNumExpansions(0)
+, _reuseSearch(false)
+, _anytime(new AnytimeSearch(_map, _stopPlanner))
+, _hasImprovedPlan(false)
 , _isSynchronous(runSync)
 {
   static_assert(std::is_const<std::remove_reference_t<decltype(_map)>>::value, 
@@ -85,6 +127,12 @@ void XYPlanner::Worker()
     std::unique_lock<std::recursive_mutex> lock(_contextMutex);
     if( _startPlanner ) {
       StartPlanner();
+    } else if( _improvingPlan ) {
+      // someone is waiting for the lock if the planner was asked to stop
+      if( !_stopPlanner ) {
+        ImprovePlan();
+      }
+      _threadRequest.wait_for(lock, std::chrono::milliseconds(1));
     } else {
       _threadRequest.wait(lock);
     }
@@ -96,34 +144,45 @@ EComputePathStatus XYPlanner::ComputePath(const Pose3d& startPose, const std::ve
 {
   std::vector<Pose2d> goalCopy;  
   for(const auto& t : targetPoses) { goalCopy.push_back(t); }
-  return InitializePlanner(startPose, goalCopy, true, true);
+  return InitializePlanner(startPose, goalCopy, true, true, true);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 EComputePathStatus XYPlanner::ComputeNewPathIfNeeded(const Pose3d& startPose, bool forceReplanFromScratch, bool allowGoalChange) 
 {
   std::vector<Pose2d> goalCopy = _targets;
-  return InitializePlanner(startPose, goalCopy, forceReplanFromScratch, allowGoalChange);
+  return InitializePlanner(startPose, goalCopy, forceReplanFromScratch, allowGoalChange, !forceReplanFromScratch);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-EComputePathStatus XYPlanner::InitializePlanner(const Pose2d& start, const std::vector<Pose2d>& targets, bool forceReplan, bool allowGoalChange)
+EComputePathStatus XYPlanner::InitializePlanner(const Pose2d& start, const std::vector<Pose2d>& targets, bool forceReplan,
+                                                bool allowGoalChange, bool reuseSearch)
 {
   // planner will start on next thread cycle
   if (!forceReplan && _startPlanner) { return EComputePathStatus::Running; }
   
-  // if the planner is running, flag an abort on the current instance so we can restart ASAP
-  if ( !_contextMutex.try_lock() && forceReplan ) {
+  // if the planner is busy, flag an abort on the current instance so we can restart ASAP. A plan that is still being
+  // computed is only cut off if we have to replan, but background improvement always makes way
+  if ( !_contextMutex.try_lock() ) {
+    if ( !forceReplan && (_status == EPlannerStatus::Running) ) { return EComputePathStatus::Running; }
     _stopPlanner = true; 
     _contextMutex.lock();
   }
 
   // we are going to generate a new path, so reset all control variables
   std::lock_guard<std::recursive_mutex> lg(_contextMutex, std::adopt_lock); 
-
+  _stopPlanner = false;
+
+  // the background search found a cheaper path, so replan from here to pick it up
+  const bool useImprovedPlan = !forceReplan && _hasImprovedPlan && allowGoalChange;
+  if (useImprovedPlan) {
+    LOG_INFO("XYPlanner.InitializePlanner.ImprovedPlan",
+             "Replanning. Cost=%.1f Improved=%.1f Epsilon=%.2f",
+             _anytime->planCost, _anytime->search.GetPlanCost(), _anytime->search.GetEpsilon());
+  }
 
   // make sure the collision cost is monotonically decreasing
-  if (!forceReplan) {
+  if (!forceReplan && !useImprovedPlan) {
     const float currentPenalty = GetPathCollisionPenalty( _path );
     if ( FLT_LE(currentPenalty, _collisionPenalty) ) {
       _collisionPenalty = currentPenalty;
@@ -138,6 +197,9 @@ EComputePathStatus XYPlanner::InitializePlanner(const Pose2d& start, const std::
   _start = start;
   _targets = targets;
   _allowGoalChange = allowGoalChange;
+  _reuseSearch = reuseSearch;
+  _improvingPlan = false;
+  _hasImprovedPlan = false;
   _collisionPenalty = 0.f;
   _stopPlanner  = false;
   _startPlanner = true;
@@ -182,6 +244,9 @@ void XYPlanner::StartPlanner()
     plannerGoals.emplace_back(x,y);
   }
 
+  // the searches check collisions against the latest occupancy snapshot first, and only query the map near obstacles
+  const auto snapshot = _map.GetOccupancySnapshot();
+
   // expand out of collision state if necessary
   // NOTE:  if no safe point exists, the A* search will timeout, but we probably have bigger problems to deal with.
   //        Why can we not find a single safe point anywhere within the searchable range of EscapeObstaclePlanner?
@@ -189,7 +254,7 @@ void XYPlanner::StartPlanner()
   // NOTE2: there seems to be a bug in the planner where using Point::IsNear is not a sufficient check for determining
   //        that the goal is safe, even if we use a known safe point for the goal. The work around, for now, is
   //        to find the nearest safe -grid- point, and then insert the true goal state after a plan has been made.
-  const Point2f plannerStart = FindNearestSafePoint( GetNearestGridPoint(_start.GetTranslation(), kPlanningResolution_mm) );
+  const Point2f plannerStart = FindNearestSafePoint( GetNearestGridPoint(_start.GetTranslation(), kPlanningResolution_mm), snapshot );
 
 #if !defined(NDEBUG)
   for (const auto& s : plannerGoals) {
@@ -202,10 +267,32 @@ void XYPlanner::StartPlanner()
   using namespace std::chrono;
   high_resolution_clock::time_point startTime = high_resolution_clock::now();
 
-  PlannerConfig config(plannerStart, plannerGoals, _map, _stopPlanner);
-  BidirectionalAStar<PlannerConfig> planner( config );
-  auto planS = planner.Search();
-  std::vector<Point2f> plan(planS.begin(), planS.end());
+  // A single search over many goals spends most of its time around the nearest one when that one is blocked, so
+  // new multi goal plans race the nearest goals against each other instead. Replans that can reuse the anytime
+  // search tree keep using it
+  std::vector<Point2f> plan;
+  size_t numExpansions = 0;
+  const bool canReuseAnytime = kXYPlannerUseAnytimeSearch && _reuseSearch && (plannerGoals == _anytime->goals);
+  const bool searchInParallel = (kXYPlannerParallelGoals > 1) && (plannerGoals.size() > 1) && !canReuseAnytime;
+  if (searchInParallel) {
+    plan = RunParallelGoalSearch(plannerStart, plannerGoals, snapshot, numExpansions);
+  }
+
+  // goals left out of the parallel search may still be reachable
+  const bool searchedAllGoals = searchInParallel && (plannerGoals.size() <= (size_t) kXYPlannerParallelGoals);
+  if (plan.empty() && !searchedAllGoals) {
+    if (kXYPlannerUseAnytimeSearch) {
+      _anytime->config.SetOccupancySnapshot(snapshot);
+      plan = RunAnytimeSearch(plannerStart, plannerGoals);
+      numExpansions += _anytime->config.GetNumExpansions();
+    } else {
+      PlannerConfig config(plannerStart, plannerGoals, _map, snapshot, _stopPlanner);
+      BidirectionalAStar<PlannerConfig> planner( config );
+      auto planS = planner.Search();
+      plan.assign(planS.begin(), planS.end());
+      numExpansions += config.GetNumExpansions();
+    }
+  }
 
   if(!plan.empty()) {
     // planner will only go to the nearest safe grid point, so add the real start and goal points
@@ -236,11 +323,191 @@ void XYPlanner::StartPlanner()
   }
 
   // grab performance metrics
+  _lastNumExpansions = numExpansions;
   auto planTime_ms = duration_cast<std::chrono::milliseconds>(high_resolution_clock::now() - startTime);
   LOG_INFO("XYPlanner.StartPlanner", "planning took %s ms (%zu expansions at %.2f exp/sec)",
            std::to_string(planTime_ms.count()).c_str(),
-           config.GetNumExpansions(),
-           ((float) config.GetNumExpansions() * 1000) / (planTime_ms.count()) );
+           numExpansions,
+           ((float) numExpansions * 1000) / (planTime_ms.count()) );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<Point2f> XYPlanner::RunAnytimeSearch(const Point2f& start, const std::vector<Point2f>& goals)
+{
+  AnytimePlannerConfig& config = _anytime->config;
+  auto& search = _anytime->search;
+
+  // the tree is rooted at the goals, so it can be kept if they did not move and we know what changed in the map
+  std::vector<AxisAlignedQuad> changedRegions;
+  const bool mapChangesKnown = _map.GetChangedRegions(_anytime->mapStamp, changedRegions);
+  const bool reuseTree = _reuseSearch && mapChangesKnown && (goals == _anytime->goals) &&
+                         (search.GetNumStates() > 0) && (changedRegions.size() <= kMaxRepairRegions);
+
+  config.SetStart(start);
+  config.SetExpansionBudget(kPlanPathMaxExpansions);
+  if (reuseTree && !changedRegions.empty()) {
+    // anything that could have touched a changed region with its collision checks, or by stepping into it
+    const float inflation = kPlanningResolution_mm + kRobotRadius_mm + kPlanningPadding_mm;
+    std::vector<AxisAlignedQuad> affected;
+    for (const auto& r : changedRegions) {
+      affected.emplace_back( r.GetMinVertex() - Point2f(inflation, inflation), r.GetMaxVertex() + Point2f(inflation, inflation) );
+    }
+    search.Repair( [&affected](const PlannerPoint& p) {
+      return std::any_of(affected.begin(), affected.end(), [&p](const AxisAlignedQuad& q) { return q.Contains(p); });
+    });
+  } else if (reuseTree) {
+    // only the start moved
+    search.OnGoalChanged();
+  } else {
+    _anytime->goals = goals;
+    search.Reset( std::vector<PlannerPoint>(goals.begin(), goals.end()) );
+  }
+  search.ImprovePath();
+
+  // map changes we could not see (e.g. content updated in place) would only show up as a plan through an obstacle
+  std::vector<PlannerPoint> planS = search.GetPlan();
+  const auto inCollision = [this](const PlannerPoint& p) {
+    return _map.CheckForCollisions( Ball2f(p, kRobotRadius_mm + kPlanningPadding_mm) );
+  };
+  if (reuseTree && std::any_of(planS.begin(), planS.end(), inCollision)) {
+    LOG_INFO("XYPlanner.RunAnytimeSearch.RepairedPlanInCollision", "Restarting search from scratch");
+    config.SetExpansionBudget(kPlanPathMaxExpansions);
+    search.Reset( std::vector<PlannerPoint>(goals.begin(), goals.end()) );
+    search.ImprovePath();
+    planS = search.GetPlan();
+  }
+
+  LOG_DEBUG("XYPlanner.RunAnytimeSearch", "%s search, epsilon=%.2f cost=%.1f states=%zu",
+            reuseTree ? "repaired" : "new", search.GetEpsilon(), search.GetPlanCost(), search.GetNumStates());
+
+  // keep improving in the background. There is no background in synchronous mode, so the first plan is final there
+  _anytime->planCost = search.GetPlanCost();
+  _improvingPlan = !_isSynchronous && search.HasPlan() && !search.IsOptimal();
+
+  // the search ran from the goals to the start
+  return std::vector<Point2f>(planS.rbegin(), planS.rend());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void XYPlanner::ImprovePlan()
+{
+  auto& search = _anytime->search;
+
+  _anytime->config.SetExpansionBudget(kAnytimeSliceExpansions);
+  if ( !search.ImprovePath() ) {
+    // ran out of expansions for this step, or was asked to stop
+    return;
+  }
+
+  if ( search.HasPlan() && FLT_LT(search.GetPlanCost(), _anytime->planCost) ) {
+    _hasImprovedPlan = true;
+  }
+
+  if ( !search.HasPlan() || search.IsOptimal() ) {
+    LOG_DEBUG("XYPlanner.ImprovePlan.Done", "epsilon=%.2f cost=%.1f states=%zu",
+              search.GetEpsilon(), search.GetPlanCost(), search.GetNumStates());
+    _improvingPlan = false;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<Point2f> XYPlanner::RunParallelGoalSearch(const Point2f& start, const std::vector<Point2f>& goals,
+                                                      const std::shared_ptr<const OccupancySnapshot>& snapshot,
+                                                      size_t& numExpansions)
+{
+  // one single goal search per candidate. The Manhattan distance to the goal is a lower bound on the cost of any
+  // path to it on the planning grid
+  struct Candidate {
+    Point2f              goal;
+    float                lowerBound    = 0.f;
+    volatile bool        stop          = false;
+    bool                 done          = false;
+    std::vector<Point2f> plan;
+    float                cost          = 0.f;
+    size_t               numExpansions = 0;
+  };
+
+  std::vector<size_t> order(goals.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    return ManhattanDistance(start, goals[a]) < ManhattanDistance(start, goals[b]);
+  });
+
+  std::vector<Candidate> candidates( std::min(goals.size(), (size_t) kXYPlannerParallelGoals) );
+  for (size_t i = 0; i < candidates.size(); ++i) {
+    candidates[i].goal = goals[order[i]];
+    candidates[i].lowerBound = ManhattanDistance(start, goals[order[i]]);
+  }
+
+  std::mutex              resultMutex;
+  std::condition_variable resultReady;
+  const auto search = [&](Candidate& c) {
+    PlannerConfig config(start, {c.goal}, _map, snapshot, c.stop);
+    BidirectionalAStar<PlannerConfig> planner( config );
+    auto planS = planner.Search();
+    std::vector<Point2f> plan(planS.begin(), planS.end());
+    float cost = 0.f;
+    for (size_t i = 1; i < plan.size(); ++i) {
+      cost += ManhattanDistance(plan[i-1], plan[i]);
+    }
+
+    std::lock_guard<std::mutex> lg(resultMutex);
+    c.plan = std::move(plan);
+    c.cost = cost;
+    c.numExpansions = config.GetNumExpansions();
+    c.done = true;
+    resultReady.notify_all();
+  };
+
+  std::vector<std::thread> workers;
+  for (auto& c : candidates) {
+    workers.emplace_back(search, std::ref(c));
+  }
+
+  const Candidate* accepted = nullptr;
+  {
+    std::unique_lock<std::mutex> lock(resultMutex);
+    while (true) {
+      const Candidate* best = nullptr;
+      for (const auto& c : candidates) {
+        if (c.done && !c.plan.empty() && ((best == nullptr) || (c.cost < best->cost))) { best = &c; }
+      }
+
+      // shared cost bound: cancel every search that can no longer beat the best plan so far
+      float bestPossible = std::numeric_limits<float>::max();
+      for (auto& c : candidates) {
+        if (c.done || c.stop) { continue; }
+        if ((best != nullptr) && (c.lowerBound >= best->cost)) {
+          c.stop = true;
+        } else {
+          bestPossible = std::min(bestPossible, c.lowerBound);
+        }
+      }
+
+      const bool nothingLeft = (bestPossible == std::numeric_limits<float>::max());
+      if ((best != nullptr) && (nothingLeft || (best->cost <= bestPossible * kParallelGoalAcceptRatio))) {
+        accepted = best;
+        break;
+      }
+      if (nothingLeft || _stopPlanner) { break; }
+
+      resultReady.wait_for(lock, std::chrono::milliseconds(1));
+    }
+
+    // cancel the rest
+    for (auto& c : candidates) { c.stop = true; }
+  }
+
+  numExpansions = 0;
+  for (size_t i = 0; i < workers.size(); ++i) {
+    workers[i].join();
+    numExpansions += candidates[i].numExpansions;
+  }
+
+  LOG_DEBUG("XYPlanner.RunParallelGoalSearch", "%zu of %zu goals searched, %s",
+            candidates.size(), goals.size(), (accepted != nullptr) ? "found a plan" : "no plan");
+
+  return (accepted != nullptr) ? accepted->plan : std::vector<Point2f>();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -386,9 +653,9 @@ float XYPlanner::GetPathCollisionPenalty(const Planning::Path& path) const
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-Point2f XYPlanner::FindNearestSafePoint(const Point2f& p) const
+Point2f XYPlanner::FindNearestSafePoint(const Point2f& p, const std::shared_ptr<const OccupancySnapshot>& snapshot) const
 {
-  EscapeObstaclePlanner config(_map, _stopPlanner);
+  EscapeObstaclePlanner config(_map, snapshot, _stopPlanner);
   AStar<Point2f, EscapeObstaclePlanner> planner( config );
   std::vector<Point2f> plan = planner.Search({p});
 
@@ -4,7 +4,9 @@
  * Author: Michael Willett
  * Created: 2018-05-11
  *
- * Description: Simple 2d grid uniform planner with path smoothing step
+ * Description: Simple 2d grid uniform planner with path smoothing step. Can run as an anytime search that keeps
+ *              improving its plan in the background, and repairs its search tree when the map changes. New plans
+ *              with several goals search the nearest ones in parallel
  *
  * Copyright: Anki, Inc. 2018
  *
@@ -22,6 +24,7 @@
 
 #include <thread>
 #include <condition_variable>
+#include <memory>
 
 namespace Anki {
 
@@ -33,6 +36,7 @@ namespace Vector {
 class Path;
 class Robot;
 class MapComponent;
+class OccupancySnapshot;
 
 class XYPlanner : public IPathPlanner, private Util::noncopyable
 {
@@ -53,7 +57,7 @@ public:
                                                     bool allowGoalChange = true) override;
 
   // exit the current planning routine
-  virtual void StopPlanning() override { _stopPlanner = true; }
+  virtual void StopPlanning() override { _stopPlanner = true; _improvingPlan = false; }
 
   virtual EPlannerStatus CheckPlanningStatus() const override { return _status; }
   
@@ -68,6 +72,9 @@ public:
   // return a test path
   virtual void GetTestPath(const Pose3d& startPose, Planning::Path &path, const PathMotionProfile* motionProfile = nullptr) override {}
 
+  // search expansions the last plan took, over all of its searches
+  size_t GetLastNumExpansions() const { return _lastNumExpansions; }
+
 protected:
   virtual EComputePathStatus ComputePath(const Pose3d& startPose, const Pose3d& targetPose) override { return ComputePath(startPose, std::vector<Pose3d>({targetPose})); }
 
@@ -76,7 +83,22 @@ private:
   void StartPlanner();
 
   // initialize all control states and notify the planner thread to get a plan
-  EComputePathStatus InitializePlanner(const Pose2d& start, const std::vector<Pose2d>& targets, bool forceReplan, bool allowGoalChange);
+  // if reuseSearch is FALSE, the anytime search tree is discarded and the plan is computed from scratch
+  EComputePathStatus InitializePlanner(const Pose2d& start, const std::vector<Pose2d>& targets, bool forceReplan,
+                                       bool allowGoalChange, bool reuseSearch);
+
+  // plan with the anytime search, reusing and repairing the previous search tree where possible. Returns the
+  // waypoints from start to one of the goals, or an empty plan if none was found
+  std::vector<Point2f> RunAnytimeSearch(const Point2f& start, const std::vector<Point2f>& goals);
+
+  // run a bounded amount of anytime search improvement on the current plan
+  void ImprovePlan();
+
+  // plan to the nearest kXYPlannerParallelGoals goals at once, one search thread per goal, and return the first plan
+  // that none of the searches still running could beat by much. Empty if none of those goals can be reached
+  std::vector<Point2f> RunParallelGoalSearch(const Point2f& start, const std::vector<Point2f>& goals,
+                                             const std::shared_ptr<const OccupancySnapshot>& snapshot,
+                                             size_t& numExpansions);
 
   // convert a set of way points to a smooth path
   Planning::Path BuildPath(const std::vector<Point2f>& plan) const;
@@ -91,7 +113,7 @@ private:
   Planning::GoalID FindGoalIndex(const Point2f& p) const;
 
   // Finds the nearest safe point to p. If no safe point exists, default to p
-  Point2f FindNearestSafePoint(const Point2f& p) const;
+  Point2f FindNearestSafePoint(const Point2f& p, const std::shared_ptr<const OccupancySnapshot>& snapshot) const;
 
   // get total cost of traversing the path in the current map
   float GetPathCollisionPenalty(const Planning::Path& path) const;
@@ -112,7 +134,14 @@ private:
   std::vector<Pose2d>  _targets;
   EPlannerStatus       _status;
   float                _collisionPenalty;
+  size_t               _lastNumExpansions;
   bool                 _allowGoalChange;
+  bool                 _reuseSearch;
+
+  // anytime search state kept between plans
+  struct AnytimeSearch;
+  std::unique_ptr<AnytimeSearch> _anytime;
+  bool                           _hasImprovedPlan;       // the search found a cheaper path than the current one
 
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Thread Handling
@@ -128,6 +157,7 @@ private:
   volatile bool               _stopThread     = false;     // clean up and stop the thread entirely
   volatile bool               _startPlanner   = false;     // start planning now if it isn't running
   volatile bool               _stopPlanner    = false;     // if the planner is currently running, force it to stop
+  volatile bool               _improvingPlan  = false;     // keep improving the plan while the thread is idle
 };
     
     
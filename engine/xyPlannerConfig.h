@@ -15,6 +15,7 @@
 
 #include "engine/robot.h"
 #include "engine/navMap/mapComponent.h"
+#include "engine/navMap/occupancySnapshot.h"
 
 #include "coretech/planning/engine/aStar.h"
 #include "coretech/planning/engine/bidirectionalAStar.h"
@@ -89,6 +90,13 @@ namespace {
     return d.x() + d.y(); 
   }
 
+  // true if the robot collides with anything at p. The snapshot (if any) rules out most of free space without
+  // touching the map
+  inline bool IsStateInCollision(const Point2f& p, const MapComponent& map, const OccupancySnapshot* snapshot) {
+    const Ball2f robot(p, kRobotRadius_mm + kPlanningPadding_mm);
+    return ( !snapshot || snapshot->MayCollide(robot) ) && map.CheckForCollisions(robot);
+  }
+
 }
 
 class PlannerPoint : public Point2f {
@@ -122,59 +130,68 @@ private:
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-//  Bidirectional A* Configuration through collision free space
+//  Collision free successors of a PlannerPoint, shared by the planner configurations below
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-class PlannerConfig : public BidirectionalAStarConfig<PlannerPoint, PlannerConfig> {
+// define a custom iterator class to avoid dynamic memory allocation
+template<class Successor>
+class PlannerSuccessorIter : private std::iterator<std::input_iterator_tag, Successor>{
 public:
-  // define a custom iterator class to avoid dynamic memory allocation
-  class SuccessorIter : private std::iterator<std::input_iterator_tag, Successor>{
-  public:
-    SuccessorIter(const PlannerPoint& p, const MapComponent& m, int idx = 0 ) 
-    : _idx(idx), _parent(p), _map(m) { UpdateState(); }
-
-    bool          operator!=(const SuccessorIter& rhs) { return this->_idx != rhs._idx; }
-    Successor     operator*()                          { return {_state, _state.GetStepSize()}; }
-    SuccessorIter operator++()                         { ++_idx; UpdateState(); return *this; }
-    SuccessorIter begin()                              { return SuccessorIter(_parent, _map); }
-    SuccessorIter end()                                { return SuccessorIter(_parent, _map, -1); }
-
-  private:
-    inline void UpdateState() {
-      if (_idx >= PlannerPoint::MaxSuccessors()) { 
-        if (_collisionFree || _substepping) {
-          _idx = -1; 
-          return; 
-        } else {
-          _idx = 0;
-          _substepping = true;
-          _collisionFree = true;
-        }
-      }
+  PlannerSuccessorIter(const PlannerPoint& p, const MapComponent& m, const OccupancySnapshot* snapshot, int idx = 0 ) 
+  : _idx(idx), _parent(p), _map(m), _snapshot(snapshot) { UpdateState(); }
 
-      _state = _substepping ? _parent.HalfStep(_idx) : _parent.FullStep(_idx);
-      if ( _map.CheckForCollisions( Ball2f(_state, kRobotRadius_mm + kPlanningPadding_mm) ) ) { 
-        _collisionFree = false;
-        ++(*this); 
+  bool                 operator!=(const PlannerSuccessorIter& rhs) { return this->_idx != rhs._idx; }
+  Successor            operator*()                                 { return {_state, _state.GetStepSize()}; }
+  PlannerSuccessorIter operator++()                                { ++_idx; UpdateState(); return *this; }
+  PlannerSuccessorIter begin()                                     { return PlannerSuccessorIter(_parent, _map, _snapshot); }
+  PlannerSuccessorIter end()                                       { return PlannerSuccessorIter(_parent, _map, _snapshot, -1); }
+
+private:
+  inline void UpdateState() {
+    if (_idx >= PlannerPoint::MaxSuccessors()) { 
+      if (_collisionFree || _substepping) {
+        _idx = -1; 
+        return; 
+      } else {
+        _idx = 0;
+        _substepping = true;
+        _collisionFree = true;
       }
     }
 
-    int                 _idx;
-    PlannerPoint        _state;
-    const PlannerPoint  _parent;
-    const MapComponent& _map;
-    bool                _collisionFree = true;
-    bool                _substepping = false;
-  };
+    _state = _substepping ? _parent.HalfStep(_idx) : _parent.FullStep(_idx);
+    if ( IsStateInCollision(_state, _map, _snapshot) ) { 
+      _collisionFree = false;
+      ++(*this); 
+    }
+  }
+
+  int                 _idx;
+  PlannerPoint        _state;
+  const PlannerPoint  _parent;
+  const MapComponent& _map;
+  const OccupancySnapshot* _snapshot;
+  bool                _collisionFree = true;
+  bool                _substepping = false;
+};
 
-  PlannerConfig(const Point2f& start, const std::vector<Point2f>& goals, const MapComponent& map, const volatile bool& stopPlanning) 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Bidirectional A* Configuration through collision free space
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+class PlannerConfig : public BidirectionalAStarConfig<PlannerPoint, PlannerConfig> {
+public:
+  using SuccessorIter = PlannerSuccessorIter<Successor>;
+
+  PlannerConfig(const Point2f& start, const std::vector<Point2f>& goals, const MapComponent& map,
+                std::shared_ptr<const OccupancySnapshot> snapshot, const volatile bool& stopPlanning) 
   : _start(start)
   , _goals(goals.begin(), goals.end())
   , _map(map)
+  , _snapshot(snapshot)
   , _abort(stopPlanning) {}
 
   inline bool   StopPlanning()                                    { return _abort || (++_numExpansions > kPlanPathMaxExpansions); }
   inline size_t GetNumExpansions() const                          { return _numExpansions; }
-  inline SuccessorIter GetSuccessors(const PlannerPoint& p) const { return SuccessorIter(p, _map); };
+  inline SuccessorIter GetSuccessors(const PlannerPoint& p) const { return SuccessorIter(p, _map, _snapshot.get()); };
   
   inline float ReverseHeuristic(const Point2f& p) const { return ManhattanDistance(p, _start); };
   inline float ForwardHeuristic(const Point2f& p) const { 
@@ -193,8 +210,41 @@ private:
   const std::vector<PlannerPoint>  _goals;
 
   const MapComponent&         _map;
+  std::shared_ptr<const OccupancySnapshot> _snapshot;
+  const volatile bool&        _abort;
+  size_t                      _numExpansions = 0;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//  Anytime A* Configuration, searching backwards from the goals to the start through collision free space
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// The search tree is rooted at the goals, so it stays valid while the robot (the start) moves along the path. Only
+// the heuristic and the goal test depend on the start
+class AnytimePlannerConfig : public IAStarConfig<PlannerPoint, AnytimePlannerConfig> {
+public:
+  using SuccessorIter = PlannerSuccessorIter<Successor>;
+
+  AnytimePlannerConfig(const MapComponent& map, const volatile bool& stopPlanning) 
+  : _map(map)
+  , _abort(stopPlanning) {}
+
+  inline float  Heuristic(const PlannerPoint& p) const  { return ManhattanDistance(p, _start); };
+  inline bool   IsGoal(const PlannerPoint& p) const     { return ManhattanDistance(p, _start) <= kPlanningResolution_mm * .5f; };
+  inline bool   StopPlanning()                          { return _abort || (++_numExpansions > _maxExpansions); }
+  inline size_t GetNumExpansions() const                { return _numExpansions; }
+  inline SuccessorIter GetSuccessors(const PlannerPoint& p) const { return SuccessorIter(p, _map, _snapshot.get()); };
+
+  void SetStart(const Point2f& start)      { _start = start; }
+  void SetOccupancySnapshot(std::shared_ptr<const OccupancySnapshot> snapshot) { _snapshot = snapshot; }
+  void SetExpansionBudget(size_t maxExp)   { _maxExpansions = maxExp; _numExpansions = 0; }
+
+private:
+  PlannerPoint                _start;
+  const MapComponent&         _map;
+  std::shared_ptr<const OccupancySnapshot> _snapshot;
   const volatile bool&        _abort;
   size_t                      _numExpansions = 0;
+  size_t                      _maxExpansions = kPlanPathMaxExpansions;
 };
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -202,13 +252,14 @@ private:
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class EscapeObstaclePlanner : public IAStarConfig<Point2f, EscapeObstaclePlanner> {
 public:
-  EscapeObstaclePlanner(const MapComponent& map, const volatile bool& stopPlanning) 
+  EscapeObstaclePlanner(const MapComponent& map, std::shared_ptr<const OccupancySnapshot> snapshot, const volatile bool& stopPlanning) 
   : _map(map)
+  , _snapshot(snapshot)
   , _abort(stopPlanning) {}
 
   inline float  Heuristic(const Point2f& p) const { return 0.f; };
   inline bool   StopPlanning()                    { return _abort || (++_numExpansions > kEscapeObstacleMaxExpansions); }
-  inline bool   IsGoal(const Point2f& p)    const { return !_map.CheckForCollisions( Ball2f(p, kRobotRadius_mm + kPlanningPadding_mm) ); }
+  inline bool   IsGoal(const Point2f& p)    const { return !IsStateInCollision(p, _map, _snapshot.get()); }
 
   inline std::array<Successor, 8> GetSuccessors(const Point2f& p) const { 
     std::array<Successor, 8> retv;
@@ -221,6 +272,7 @@ public:
 private:
 
   const MapComponent&  _map;
+  std::shared_ptr<const OccupancySnapshot> _snapshot;
   const volatile bool& _abort;
   size_t               _numExpansions = 0;
 };
@@ -200,17 +200,26 @@ void IPCClient::SendMessage(const int connection_id,
                             const std::string& characteristic_uuid,
                             const bool reliable,
                             const std::vector<uint8_t>& value)
+{
+  SendMessage(connection_id, characteristic_uuid, reliable, value.data(), value.size());
+}
+
+void IPCClient::SendMessage(const int connection_id,
+                            const std::string& characteristic_uuid,
+                            const bool reliable,
+                            const uint8_t* value,
+                            const size_t length)
 {
   SendMessageArgs* args;
-  uint32_t args_length = sizeof(*args) + value.size();
+  uint32_t args_length = sizeof(*args) + length;
   args = (SendMessageArgs *) malloc_zero(args_length);
   args->connection_id = connection_id;
   (void) strlcpy(args->characteristic_uuid,
                  characteristic_uuid.c_str(),
                  sizeof(args->characteristic_uuid));
   args->reliable = reliable;
-  args->length = (uint32_t) value.size();
-  memcpy(args->value, value.data(), value.size());
+  args->length = (uint32_t) length;
+  memcpy(args->value, value, length);
   SendIPCMessageToServer(IPCMessageType::SendMessage,
                          args_length,
                          (uint8_t *) args);
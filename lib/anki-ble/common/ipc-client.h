@@ -38,6 +38,11 @@ class IPCClient : public IPCEndpoint {
                    const std::string& characteristic_uuid,
                    const bool reliable,
                    const std::vector<uint8_t>& value);
+  void SendMessage(const int connection_id,
+                   const std::string& characteristic_uuid,
+                   const bool reliable,
+                   const uint8_t* value,
+                   const size_t length);
   void ReadCharacteristic(const int connection_id,
                           const std::string& characteristic_uuid);
   void ReadDescriptor(const int connection_id,
@@ -0,0 +1,83 @@
+/*
+ * File: pcmBufferPool.h
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Reference counted 16 bit PCM buffers that producers (TTS, SDK audio, Alexa media) fill in and hand to
+ *              the Streaming Wave Portal Plugin as they are, instead of converting each chunk into a newly allocated
+ *              float StandardWaveDataContainer. When the last reference to a buffer goes away, which is usually the
+ *              plugin popping it off its queue on the audio thread, it goes back to the pool it came from and keeps its
+ *              capacity, so a steady stream of same sized chunks stops allocating after the first few.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ */
+
+
+#ifndef __AnkiAudio_AudioTools_PcmBufferPool_H__
+#define __AnkiAudio_AudioTools_PcmBufferPool_H__
+
+#include "audioEngine/audioExport.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+namespace Anki {
+namespace AudioEngine {
+
+struct PcmBuffer
+{
+  uint32_t             sampleRate       = 0;
+  uint16_t             numberOfChannels = 0;
+  std::vector<int16_t> samples;
+
+  // Replace samples with little-endian 16 bit data
+  void CopyLittleEndianWaveData( const unsigned char* data, size_t sampleCount );
+};
+
+using PcmBufferPtr = std::shared_ptr<PcmBuffer>;
+
+
+class AUDIOENGINE_EXPORT PcmBufferPool : public std::enable_shared_from_this<PcmBufferPool>
+{
+public:
+
+  // Buffers returned beyond this many free ones are deleted instead of kept
+  static constexpr size_t kDefaultMaxFreeBuffers = 64;
+
+  // Pools must be owned by a shared_ptr, buffers only hold a weak reference back to it so they can outlive the pool
+  static std::shared_ptr<PcmBufferPool> Create( size_t maxFreeBuffers = kDefaultMaxFreeBuffers );
+
+  // Pool shared by all the Streaming Wave Portal producers
+  static const std::shared_ptr<PcmBufferPool>& GetSharedPool();
+
+  PcmBufferPool( const PcmBufferPool& ) = delete;
+  PcmBufferPool& operator=( const PcmBufferPool& ) = delete;
+
+  // Thread safe. Returns an empty buffer (sample rate and channels set, no samples) that may already have capacity
+  PcmBufferPtr Acquire( uint32_t sampleRate, uint16_t numberOfChannels );
+
+  size_t GetNumFreeBuffers() const;
+  // Number of buffers that had to be newly allocated by Acquire()
+  size_t GetNumAllocations() const;
+
+private:
+
+  explicit PcmBufferPool( size_t maxFreeBuffers );
+
+  void Recycle( PcmBuffer* buffer );
+
+  const size_t                             _maxFreeBuffers;
+  mutable std::mutex                       _lock;
+  std::vector<std::unique_ptr<PcmBuffer>>  _freeBuffers;
+  size_t                                   _numAllocations = 0;
+};
+
+} // AudioEngine
+} // Anki
+
+#endif // __AnkiAudio_AudioTools_PcmBufferPool_H__
@@ -5,9 +5,11 @@
  * Created: 07/17/18
  *
  * Description: This class is used to cache and pass audio PCM data from producer to a consumer (Streaming Wave Portal
- *              Plugin). The producer appends either a AudioDataStream or StandardWaveDataContainer to the back of the
- *              queue while the consumer uses the data and pops them off the queue.  When the producer is done appending
- *              data it must call DoneProducingData() to notify the consumer the stream is complete.
+ *              Plugin). The producer appends either a AudioDataStream, StandardWaveDataContainer or pooled PcmBuffer to
+ *              the back of the queue while the consumer uses the data and pops them off the queue.  When the producer is
+ *              done appending data it must call DoneProducingData() to notify the consumer the stream is complete.
+ *              PcmBuffers are queued by reference and only converted to float as they are written into the Wwise
+ *              buffer, so they cost no copy or allocation on the producer side.
  *
  * Note: This currently only supports single channel data
  *
@@ -19,6 +21,7 @@
 #ifndef __AnkiAudio_AudioTools_StandardWaveDataContainer_H__
 #define __AnkiAudio_AudioTools_StandardWaveDataContainer_H__
 
+#include "audioEngine/audioTools/pcmBufferPool.h"
 #include "audioEngine/plugins/wavePortalFxTypes.h"
 
 #include <mutex>
@@ -48,6 +51,11 @@ public:
   // Return False if audio stream config does not match the first audio stream
   bool AppendStandardWaveData( StandardWaveDataContainer&& audioData );
 
+  // Add pooled 16 bit audio to back of streaming buffer without copying it. The buffer is released (back to its pool)
+  // once it has been played or the data instance is destroyed, the producer must not modify it after appending.
+  // Return False if audio stream config does not match the first audio stream
+  bool AppendPcmBuffer( PcmBufferPtr&& pcmBuffer );
+
   // Provider needs to Notify plugin when all data has been added
   void DoneProducingData() { _isReceivingData = false; }
 
@@ -103,10 +111,21 @@ private:
   size_t      _playheadIdx      = 0;
   BufferState _bufferState      = BufferState::Waiting;
   // Data
+  // A queued chunk of the stream holds either float data or a pooled 16 bit buffer
+  struct StreamChunk {
+    PlugIns::AudioDataStream floatData;
+    PcmBufferPtr             pcmData;
+
+    size_t GetBufferSize() const { return ( pcmData ? pcmData->samples.size() : floatData.bufferSize ); }
+  };
   std::mutex _lock;
-  std::queue<PlugIns::AudioDataStream> _audioDataQueue;
-  const PlugIns::AudioDataStream* _currentStream = nullptr;
+  std::queue<StreamChunk> _audioDataQueue;
+  const StreamChunk* _currentStream = nullptr;
 
+  // Set the stream config from the first data, after that make sure it does not change
+  // Return False if it does not match
+  bool CheckStreamConfig( uint16_t numberOfChannels, uint32_t sampleRate );
+  void PushChunk( StreamChunk&& chunk );
   // Update buffer state and set current stream if data is available
   void UpdateCurrentStream();
   // Check current stream state. If all data from the _currentStream has been played clear the stream, pop data off
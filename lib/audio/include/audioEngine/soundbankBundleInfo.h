@@ -39,6 +39,9 @@ struct SoundbankBundleInfo {
   std::string Language;
   std::string Path;
   BankType Type = BankType::Normal;
+  // Optional, only used by LazyLoad banks: the bank's size in memory and the names of the events it holds
+  size_t Size_bytes = 0;
+  std::vector<std::string> Events;
   
   SoundbankBundleInfo( const Json::Value& jsonData );
   
@@ -9,6 +9,10 @@
  *              file “SoundbankBundleInfo.json” to search and load available sound banks
  *              (See anki-audio/build-scripts/bundle_soundbank_products.py).
  *
+ *              "LazyLoad" soundbanks are not loaded up front. Their bundle info lists the events they hold, and they
+ *              are loaded when something asks for one of those events (see LoadSoundbanksForEvents()). While the lazy
+ *              banks add up to more than the memory budget, the least recently requested ones are unloaded again.
+ *
  * TODO: Implement RAMS
  *
  * Copyright: Anki, Inc. 2017
@@ -20,7 +24,9 @@
 #define __AnkiAudio_SoundbankLoader_H__
 
 #include "audioEngine/audioExport.h"
+#include "audioEngine/audioTypes.h"
 #include "audioEngine/soundbankBundleInfo.h"
+#include "util/memoryAccounting/memoryAccounting.h"
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -47,6 +53,28 @@ public:
   // Load or unload all debug sound banks except those in optOutDevSoundbanks list
   void LoadDebugSoundbanks(const BankNameList& optOutDevSoundbanks, bool loadBanks = true);
   
+  // Load the "LazyLoad" soundbanks holding any of these events, if they aren't already, and mark them as just used
+  // Least recently used lazy banks that aren't needed by this call are unloaded to make room under the budget
+  // Events that aren't in a lazy bank are ignored (Normal banks are always loaded)
+  // Return false if a needed bank failed to load
+  bool LoadSoundbanksForEvents(const std::vector<AudioEventId>& eventIds);
+  
+  // Memory budget for loaded lazy banks, 0 is no limit
+  void SetLazyBankMemoryBudget(size_t budget_bytes) { _lazyBankBudget_bytes = budget_bytes; }
+  size_t GetLazyBankMemoryBudget() const { return _lazyBankBudget_bytes; }
+  // Memory used by the lazy banks that are currently loaded
+  size_t GetLazyBankMemoryUsed() const { return _lazyBankMemory_bytes; }
+  
+  struct LazyBankUsage {
+    size_t   size_bytes  = 0;
+    bool     isLoaded    = false;
+    uint64_t lastUsed    = 0;  // Larger is more recent
+    uint32_t numRequests = 0;  // LoadSoundbanksForEvents() calls that needed the bank
+    uint32_t numLoads    = 0;  // Times it actually had to be loaded
+  };
+  // Keyed by soundbank name
+  const std::unordered_map<std::string, LazyBankUsage>& GetLazyBankUsage() const { return _lazyBanks; }
+  
 
 private:
   
@@ -62,6 +90,16 @@ private:
   // { "bankName" : [ SoundbankBundleInfo, SoundbankBundleInfo ] }
   std::unordered_map<std::string, BankInfoList> _bankBundleInfoMap;
   
+  // Lazy loaded soundbanks and which of them holds each event
+  std::unordered_map<std::string, LazyBankUsage> _lazyBanks;
+  std::unordered_map<AudioEventId, std::string> _eventBankMap;
+  size_t _lazyBankBudget_bytes = 0;
+  size_t _lazyBankMemory_bytes = 0;
+  uint64_t _useCount = 0;
+  
+  // Bundle sizes of every loaded bank, lazy or not
+  Util::MemoryAccount _memoryAccount{ Util::MemoryTag::AudioBanks };
+  
   // Load soundbanks helper methods
   // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
   // Read Soundbank Bundle Info JSON file, update Zip paths and populate _bankBundleInfoMap with valid soundbanks
@@ -87,6 +125,16 @@ private:
   // NOTE: Parameter "updateList" vector order may be altered
   void DiffBankLists(const BankNameList& loadedBanks, BankNameList& updatedList,
                      BankNameList& out_addList, BankNameList& out_removeList) const;
+  
+  // Rebuild the lazy bank and event maps from _bankBundleInfoMap, keeping the usage of banks that are still available
+  void UpdateLazyBanks();
+  
+  // Unload least recently used lazy banks, except those used since keepUsedSince, until neededSize_bytes more fit in
+  // the budget
+  void UnloadLeastRecentlyUsedBanks(size_t neededSize_bytes, uint64_t keepUsedSince);
+  
+  // Recount _memoryAccount after loading or unloading banks
+  void UpdateMemoryAccount();
 
 };
   
@@ -0,0 +1,110 @@
+/*
+ * File: pcmBufferPool.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: See header file.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ */
+
+
+#include "audioEngine/audioTools/pcmBufferPool.h"
+
+
+namespace Anki {
+namespace AudioEngine {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PcmBuffer::CopyLittleEndianWaveData( const unsigned char* data, size_t sampleCount )
+{
+  samples.resize( sampleCount );
+  for ( size_t sampleIdx = 0; sampleIdx < sampleCount; ++sampleIdx ) {
+    samples[sampleIdx] = static_cast<int16_t>( (data[sampleIdx*2 + 1] << 8) | data[sampleIdx*2] );
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::shared_ptr<PcmBufferPool> PcmBufferPool::Create( size_t maxFreeBuffers )
+{
+  return std::shared_ptr<PcmBufferPool>( new PcmBufferPool( maxFreeBuffers ) );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const std::shared_ptr<PcmBufferPool>& PcmBufferPool::GetSharedPool()
+{
+  static const std::shared_ptr<PcmBufferPool> sPool = Create();
+  return sPool;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PcmBufferPool::PcmBufferPool( size_t maxFreeBuffers )
+: _maxFreeBuffers( maxFreeBuffers )
+{
+  _freeBuffers.reserve( _maxFreeBuffers );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+PcmBufferPtr PcmBufferPool::Acquire( uint32_t sampleRate, uint16_t numberOfChannels )
+{
+  std::unique_ptr<PcmBuffer> buffer;
+  {
+    std::lock_guard<std::mutex> lock( _lock );
+    if ( _freeBuffers.empty() ) {
+      ++_numAllocations;
+    }
+    else {
+      buffer = std::move( _freeBuffers.back() );
+      _freeBuffers.pop_back();
+    }
+  }
+  if ( !buffer ) {
+    buffer.reset( new PcmBuffer() );
+  }
+  buffer->sampleRate = sampleRate;
+  buffer->numberOfChannels = numberOfChannels;
+
+  // The buffer finds its way back here if the pool still exists when it is released
+  std::weak_ptr<PcmBufferPool> weakPool = shared_from_this();
+  return PcmBufferPtr( buffer.release(), [weakPool]( PcmBuffer* released ) {
+    const auto pool = weakPool.lock();
+    if ( pool ) {
+      pool->Recycle( released );
+    }
+    else {
+      delete released;
+    }
+  } );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void PcmBufferPool::Recycle( PcmBuffer* buffer )
+{
+  std::unique_ptr<PcmBuffer> recycled( buffer );
+  // Keep the capacity, only the contents go
+  recycled->samples.clear();
+
+  std::lock_guard<std::mutex> lock( _lock );
+  if ( _freeBuffers.size() < _maxFreeBuffers ) {
+    _freeBuffers.push_back( std::move( recycled ) );
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t PcmBufferPool::GetNumFreeBuffers() const
+{
+  std::lock_guard<std::mutex> lock( _lock );
+  return _freeBuffers.size();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+size_t PcmBufferPool::GetNumAllocations() const
+{
+  std::lock_guard<std::mutex> lock( _lock );
+  return _numAllocations;
+}
+
+} // AudioEngine
+} // Anki
@@ -5,9 +5,11 @@
  * Created: 07/17/18
  *
  * Description: This class is used to cache and pass audio PCM data from producer to a consumer (Streaming Wave Portal
- *              Plugin). The producer appends either a AudioDataStream or StandardWaveDataContainer to the back of the
- *              queue while the consumer uses the data and pops them off the queue.  When the producer is done appending
- *              data it must call DoneProducingData() to notify the consumer the stream is complete.
+ *              Plugin). The producer appends either a AudioDataStream, StandardWaveDataContainer or pooled PcmBuffer to
+ *              the back of the queue while the consumer uses the data and pops them off the queue.  When the producer is
+ *              done appending data it must call DoneProducingData() to notify the consumer the stream is complete.
+ *              PcmBuffers are queued by reference and only converted to float as they are written into the Wwise
+ *              buffer, so they cost no copy or allocation on the producer side.
  *
  * Note: This currently only supports single channel data
  *
@@ -40,28 +42,42 @@ StreamingWaveDataInstance::StreamingWaveDataInstance()
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-bool StreamingWaveDataInstance::AppendAudioDataStream( PlugIns::AudioDataStream&& audioDataStream )
+bool StreamingWaveDataInstance::CheckStreamConfig( uint16_t numberOfChannels, uint32_t sampleRate )
 {
   // If this is the first data, set channels and sample rate to match.
   // Otherwise, make sure channel and sample rate do not change.
   if (_numberOfFramesReceived == 0) {
-    _numberOfChannels = audioDataStream.numberOfChannels;
-    _sampleRate = audioDataStream.sampleRate;
-  } else if (audioDataStream.numberOfChannels != _numberOfChannels) {
-    LOG_ERROR("StreamingWaveDataInstance.AppendAudioDataStream.InvalidNumberOfChannels",
-      "Expected %d but got %d", _numberOfChannels, audioDataStream.numberOfChannels);
+    _numberOfChannels = numberOfChannels;
+    _sampleRate = sampleRate;
+  } else if (numberOfChannels != _numberOfChannels) {
+    LOG_ERROR("StreamingWaveDataInstance.CheckStreamConfig.InvalidNumberOfChannels",
+      "Expected %d but got %d", _numberOfChannels, numberOfChannels);
     return false;
-  } else if (audioDataStream.sampleRate != _sampleRate) {
-    LOG_ERROR("StreamingWaveDataInstance.AppendAudioDataStream.InvalidSampleRate",
-      "Expected %d but got %d", _sampleRate, audioDataStream.sampleRate);
+  } else if (sampleRate != _sampleRate) {
+    LOG_ERROR("StreamingWaveDataInstance.CheckStreamConfig.InvalidSampleRate",
+      "Expected %d but got %d", _sampleRate, sampleRate);
     return false;
   }
+  return true;
+}
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void StreamingWaveDataInstance::PushChunk( StreamChunk&& chunk )
+{
   // Track how many frames have been added to stream
-  _numberOfFramesReceived += (audioDataStream.bufferSize / _numberOfChannels);
+  _numberOfFramesReceived += (chunk.GetBufferSize() / _numberOfChannels);
 
   std::lock_guard<std::mutex> lock(_lock);
-  _audioDataQueue.push( std::move(audioDataStream) );
+  _audioDataQueue.push( std::move(chunk) );
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StreamingWaveDataInstance::AppendAudioDataStream( PlugIns::AudioDataStream&& audioDataStream )
+{
+  if ( !CheckStreamConfig( audioDataStream.numberOfChannels, audioDataStream.sampleRate ) ) {
+    return false;
+  }
+  PushChunk( StreamChunk{ std::move(audioDataStream), nullptr } );
   return true;
 }
 
@@ -82,6 +98,20 @@ bool StreamingWaveDataInstance::AppendStandardWaveData( StandardWaveDataContaine
   return success;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool StreamingWaveDataInstance::AppendPcmBuffer( PcmBufferPtr&& pcmBuffer )
+{
+  if ( !pcmBuffer || pcmBuffer->samples.empty() ) {
+    LOG_WARNING("StreamingWaveDataInstance.AppendPcmBuffer.NoData", "Ignoring empty buffer");
+    return false;
+  }
+  if ( !CheckStreamConfig( pcmBuffer->numberOfChannels, pcmBuffer->sampleRate ) ) {
+    return false;
+  }
+  PushChunk( StreamChunk{ PlugIns::AudioDataStream(), std::move(pcmBuffer) } );
+  return true;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StreamingWaveDataInstance::WriteToPluginBuffer( AkAudioBuffer* inOut_buffer )
 {
@@ -148,7 +178,7 @@ void StreamingWaveDataInstance::UpdateCurrentStream()
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 bool StreamingWaveDataInstance::CheckCurrentStreamState()
 {
-  if ( _currentStream->bufferSize <= _playheadIdx ) {
+  if ( _currentStream->GetBufferSize() <= _playheadIdx ) {
     // Pop current frame
     {
       std::lock_guard<std::mutex> lock(_lock);
@@ -173,7 +203,7 @@ size_t StreamingWaveDataInstance::WriteContinuousData( AkAudioBuffer* inOut_buff
 #if USE_AUDIO_ENGINE
   // Set Min Frame Count only using the current stream
   const size_t bufferSize = inOut_buffer->MaxFrames() - bufferPlayheadIdx;
-  size_t streamSize = _currentStream->bufferSize - _playheadIdx;
+  size_t streamSize = _currentStream->GetBufferSize() - _playheadIdx;
   frameCount = bufferSize < streamSize ? bufferSize : streamSize;
   inOut_buffer->uValidFrames = frameCount + bufferPlayheadIdx;
   ASSERT_NAMED(inOut_buffer->uValidFrames <= inOut_buffer->MaxFrames(),
@@ -182,8 +212,18 @@ size_t StreamingWaveDataInstance::WriteContinuousData( AkAudioBuffer* inOut_buff
   // Copy data into current wwise stream
   // TODO: This is only for mono sources
   AkSampleType* destination = inOut_buffer->GetChannel(0) + bufferPlayheadIdx;
-  AkSampleType* source = _currentStream->audioBuffer.get() + _playheadIdx;
-  memcpy( destination, source, sizeof(AkSampleType) * frameCount );
+  if ( _currentStream->pcmData ) {
+    // Convert straight from the producer's buffer, there is no intermediate float copy
+    const float kOneOverSHRT_MAX = 1.0f / float(SHRT_MAX);
+    const int16_t* source = _currentStream->pcmData->samples.data() + _playheadIdx;
+    for ( size_t sampleIdx = 0; sampleIdx < frameCount; ++sampleIdx ) {
+      destination[sampleIdx] = source[sampleIdx] * kOneOverSHRT_MAX;
+    }
+  }
+  else {
+    const AkSampleType* source = _currentStream->floatData.audioBuffer.get() + _playheadIdx;
+    memcpy( destination, source, sizeof(AkSampleType) * frameCount );
+  }
 
   _playheadIdx += frameCount;
   _numberOfFramesPlayed += frameCount;
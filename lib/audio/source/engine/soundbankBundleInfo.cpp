@@ -31,6 +31,8 @@ SoundbankBundleInfo::SoundbankBundleInfo( const Json::Value& jsonData )
   static const char* LANG_KEY = "language";
   static const char* PATH_KEY = "path";
   static const char* TYPE_KEY = "type";
+  static const char* SIZE_KEY = "size";
+  static const char* EVENTS_KEY = "events";
   
   // Set values from json data
   BundleName = jsonData[BUNDLE_NAME_KEY].asString();
@@ -47,6 +49,14 @@ SoundbankBundleInfo::SoundbankBundleInfo( const Json::Value& jsonData )
       Type = SoundbankBundleInfo::BankType::Debug;
     }
   }
+  if ( jsonData.isMember(SIZE_KEY) ) {
+    Size_bytes = jsonData[SIZE_KEY].asUInt();
+  }
+  if ( jsonData[EVENTS_KEY].isArray() ) {
+    for ( const auto& anEvent : jsonData[EVENTS_KEY] ) {
+      Events.push_back( anEvent.asString() );
+    }
+  }
 }
  
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
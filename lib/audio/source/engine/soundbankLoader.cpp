@@ -9,6 +9,10 @@
  *              file “SoundbankBundleInfo.json” to search and load available sound banks
  *              (See anki-audio/build-scripts/bundle_soundbank_products.py).
  *
+ *              "LazyLoad" soundbanks are not loaded up front. Their bundle info lists the events they hold, and they
+ *              are loaded when something asks for one of those events (see LoadSoundbanksForEvents()). While the lazy
+ *              banks add up to more than the memory budget, the least recently requested ones are unloaded again.
+ *
  * TODO: Implement RAMS
  *
  * Copyright: Anki, Inc. 2017
@@ -61,6 +65,8 @@ void SoundbankLoader::LoadDefaultSoundbanks()
   for ( const auto& aBank : addList ) {
     _audioEngineController.LoadSoundbank( aBank );
   }
+  
+  UpdateLazyBanks();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -87,6 +93,65 @@ void SoundbankLoader::LoadDebugSoundbanks(const BankNameList& optOutDevSoundbank
       _audioEngineController.UnloadSoundbank( filteredBanksIt );
     }
   }
+  
+  UpdateMemoryAccount();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+bool SoundbankLoader::LoadSoundbanksForEvents(const std::vector<AudioEventId>& eventIds)
+{
+  if ( _lazyBanks.empty() ) {
+    return true;
+  }
+  
+  // Every bank this call touches is marked with the same use count, so it can't be unloaded to make room below
+  const uint64_t useCount = ++_useCount;
+  BankNameList neededBanks;
+  size_t neededSize_bytes = 0;
+  for ( const auto eventId : eventIds ) {
+    const auto eventIt = _eventBankMap.find( eventId );
+    if ( eventIt == _eventBankMap.end() ) {
+      continue;
+    }
+    auto& bank = _lazyBanks[eventIt->second];
+    if ( bank.lastUsed == useCount ) {
+      continue;
+    }
+    bank.lastUsed = useCount;
+    ++bank.numRequests;
+    if ( !bank.isLoaded ) {
+      neededBanks.push_back( eventIt->second );
+      neededSize_bytes += bank.size_bytes;
+    }
+  }
+  
+  if ( neededBanks.empty() ) {
+    return true;
+  }
+  
+  // Make room first, the newly needed banks are what pushes us over the budget
+  UnloadLeastRecentlyUsedBanks( neededSize_bytes, useCount );
+  
+  bool success = true;
+  for ( const auto& aBank : neededBanks ) {
+    auto& bank = _lazyBanks[aBank];
+    if ( _audioEngineController.LoadSoundbank( aBank ) ) {
+      bank.isLoaded = true;
+      ++bank.numLoads;
+      _lazyBankMemory_bytes += bank.size_bytes;
+      PRINT_CH_INFO("Audio", "SoundbankLoader.LoadSoundbanksForEvents",
+                    "Loaded '%s' (%zu bytes), lazy banks use %zu of %zu bytes",
+                    aBank.c_str(), bank.size_bytes, _lazyBankMemory_bytes, _lazyBankBudget_bytes);
+    }
+    else {
+      PRINT_NAMED_WARNING("SoundbankLoader.LoadSoundbanksForEvents.LoadFailed",
+                          "Failed to load lazy soundbank '%s'", aBank.c_str());
+      success = false;
+    }
+  }
+  
+  UpdateMemoryAccount();
+  return success;
 }
 
 // Load soundbanks helper methods
@@ -257,5 +322,94 @@ void SoundbankLoader::DiffBankLists(const BankNameList& loadedBanks,
   std::sort(out_removeList.begin(), out_removeList.end(), specialSortFunc);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundbankLoader::UpdateLazyBanks()
+{
+  const auto& loadedBanks = _audioEngineController.GetLoadedBankNames();
+  std::unordered_map<std::string, LazyBankUsage> lazyBanks;
+  _eventBankMap.clear();
+  _lazyBankMemory_bytes = 0;
+  
+  for ( const auto& kvp : _bankBundleInfoMap ) {
+    // We can assume that all locales of the bank are the same type and hold the same events
+    const SoundbankBundleInfo& bundleInfo = kvp.second[0];
+    if ( bundleInfo.Type != SoundbankBundleInfo::BankType::LazyLoad ) {
+      continue;
+    }
+    
+    const auto prevIt = _lazyBanks.find( kvp.first );
+    LazyBankUsage& bank = lazyBanks[kvp.first];
+    if ( prevIt != _lazyBanks.end() ) {
+      bank = prevIt->second;
+    }
+    bank.size_bytes = bundleInfo.Size_bytes;
+    bank.isLoaded = ( std::find( loadedBanks.begin(), loadedBanks.end(), kvp.first ) != loadedBanks.end() );
+    if ( bank.isLoaded ) {
+      _lazyBankMemory_bytes += bank.size_bytes;
+    }
+    
+    if ( bundleInfo.Events.empty() ) {
+      PRINT_NAMED_WARNING("SoundbankLoader.UpdateLazyBanks.NoEvents",
+                          "Lazy soundbank '%s' lists no events, it will never be loaded", kvp.first.c_str());
+    }
+    for ( const auto& anEvent : bundleInfo.Events ) {
+      const AudioEventId eventId = AudioEngineController::GetAudioIdFromString( anEvent );
+      const bool inserted = _eventBankMap.emplace( eventId, kvp.first ).second;
+      if ( !inserted ) {
+        PRINT_NAMED_WARNING("SoundbankLoader.UpdateLazyBanks.DuplicateEvent",
+                            "Event '%s' is in more than one lazy soundbank, using '%s'",
+                            anEvent.c_str(), _eventBankMap[eventId].c_str());
+      }
+    }
+  }
+  
+  _lazyBanks = std::move( lazyBanks );
+  UpdateMemoryAccount();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundbankLoader::UnloadLeastRecentlyUsedBanks(size_t neededSize_bytes, uint64_t keepUsedSince)
+{
+  if ( _lazyBankBudget_bytes == 0 ) {
+    return;
+  }
+  
+  while ( _lazyBankMemory_bytes + neededSize_bytes > _lazyBankBudget_bytes ) {
+    auto oldestIt = _lazyBanks.end();
+    for ( auto it = _lazyBanks.begin(); it != _lazyBanks.end(); ++it ) {
+      if ( it->second.isLoaded && ( it->second.lastUsed < keepUsedSince ) &&
+           ( ( oldestIt == _lazyBanks.end() ) || ( it->second.lastUsed < oldestIt->second.lastUsed ) ) ) {
+        oldestIt = it;
+      }
+    }
+    if ( oldestIt == _lazyBanks.end() ) {
+      PRINT_NAMED_WARNING("SoundbankLoader.UnloadLeastRecentlyUsedBanks.OverBudget",
+                          "Banks in use need %zu bytes, budget is %zu bytes",
+                          _lazyBankMemory_bytes + neededSize_bytes, _lazyBankBudget_bytes);
+      return;
+    }
+    
+    _audioEngineController.UnloadSoundbank( oldestIt->first );
+    oldestIt->second.isLoaded = false;
+    _lazyBankMemory_bytes -= oldestIt->second.size_bytes;
+    PRINT_CH_INFO("Audio", "SoundbankLoader.UnloadLeastRecentlyUsedBanks",
+                  "Unloaded '%s' (%zu bytes)", oldestIt->first.c_str(), oldestIt->second.size_bytes);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void SoundbankLoader::UpdateMemoryAccount()
+{
+  size_t loadedSize_bytes = 0;
+  for ( const auto& aBank : _audioEngineController.GetLoadedBankNames() ) {
+    const auto findIt = _bankBundleInfoMap.find( aBank );
+    if ( findIt != _bankBundleInfoMap.end() ) {
+      // We can assume that all locales of the bank are about the same size
+      loadedSize_bytes += findIt->second[0].Size_bytes;
+    }
+  }
+  _memoryAccount.Set( loadedSize_bytes );
+}
+
 }
 }
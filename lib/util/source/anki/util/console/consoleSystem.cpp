@@ -66,6 +66,7 @@ ConsoleSystem::~ConsoleSystem()
 {
   editvars_.clear();
   varIds_.clear();
+  variableSlots_.clear();
 
   consolefunctions_.clear();
   functIds_.clear();
@@ -144,6 +145,19 @@ StringID ConsoleSystem::GetSearchKey( const string& key ) const
   return StringID( result );
 }
 
+//------------------------------------------------------------------------------------------------------------------------------
+// Same key as GetSearchKey, but a name that was never registered isn't interned, it just comes back as none
+StringID ConsoleSystem::FindSearchKey( const string& key ) const
+{
+  string result( key );
+  for ( char& c : result )
+  {
+    c = tolower( c );
+  }
+
+  return StringID::Find( result );
+}
+
 //------------------------------------------------------------------------------------------------------------------------------
 void ConsoleSystem::Register( const std::string& keystring, IConsoleVariable* variable )
 {
@@ -164,6 +178,8 @@ void ConsoleSystem::Register( const std::string& keystring, IConsoleVariable* va
   {
     // Keep track of the id as well.
     varIds_.push_back( key );
+    variable->slot_ = static_cast<uint32_t>( variableSlots_.size() );
+    variableSlots_.push_back( variable );
   }
 }
 
@@ -200,8 +216,18 @@ void ConsoleSystem::Register( const std::string& keystring, IConsoleFunction* fu
 //------------------------------------------------------------------------------------------------------------------------------
 void ConsoleSystem::Unregister( const std::string& keystring )
 {
-  const StringID key = GetSearchKey( keystring );
-  editvars_.erase( key );
+  const StringID key = FindSearchKey( keystring );
+  const VariableDatabase::iterator found = editvars_.find( key );
+  if ( found != editvars_.end() )
+  {
+    // Leave the slot empty rather than reusing it, so anyone holding it finds nothing instead of another variable
+    const uint32_t slot = found->second->GetSlot();
+    if ( slot < variableSlots_.size() )
+    {
+      variableSlots_[slot] = nullptr;
+    }
+    editvars_.erase( found );
+  }
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -209,8 +235,8 @@ IConsoleVariable* ConsoleSystem::FindVariable( const char* name )
 {
   IConsoleVariable* var = NULL;
 
-  const StringID key = GetSearchKey( name );
-  VariableDatabase::iterator found = editvars_.find( key );
+  const StringID key = FindSearchKey( name );
+  VariableDatabase::iterator found = key.IsNone() ? editvars_.end() : editvars_.find( key );
   if ( found != editvars_.end() )
   {
     var = (*found).second;
@@ -230,8 +256,8 @@ IConsoleFunction* ConsoleSystem::FindFunction( const char* name )
 {
   IConsoleFunction* func = NULL;
 
-  const StringID key = GetSearchKey( name );
-  FunctionDatabase::iterator found = consolefunctions_.find( key );
+  const StringID key = FindSearchKey( name );
+  FunctionDatabase::iterator found = key.IsNone() ? consolefunctions_.end() : consolefunctions_.find( key );
   if ( found != consolefunctions_.end() )
   {
     func = (*found).second;
@@ -75,8 +75,16 @@ public:
 public:
   size_t GetNumConsoleVariables() const { return editvars_.size(); }
   size_t GetNumConsoleFunctions() const { return consolefunctions_.size(); }
+  // Name lookups never add to the string table, so looking up names that aren't registered costs nothing lasting.
+  // Code that polls a variable should look it up once and keep its slot (or pointer) rather than its name.
   IConsoleVariable* FindVariable( const char* name );
   IConsoleFunction* FindFunction( const char* name );
+
+  // O(1), returns null for kInvalidSlot and for variables that have since been unregistered
+  IConsoleVariable* GetVariable( uint32_t slot ) const
+  {
+    return ( slot < variableSlots_.size() ) ? variableSlots_[slot] : nullptr;
+  }
   
   const IConsoleVariable* FindVariable( const char* name ) const
   {
@@ -119,9 +127,11 @@ public:
   
 private:
   StringID GetSearchKey( const std::string& key ) const;
+  StringID FindSearchKey( const std::string& key ) const;
   
   VariableIdList   varIds_;
   VariableDatabase editvars_;
+  std::vector<IConsoleVariable*> variableSlots_; // indexed by IConsoleVariable::GetSlot()
   
   FunctionIdList   functIds_;
   FunctionDatabase consolefunctions_;
@@ -15,6 +15,7 @@
 namespace Anki {
 namespace Util {
 
+constexpr uint32_t IConsoleVariable::kInvalidSlot;
 
 // Helper function - if a var is named with Hungarian notation - e.g. g_VarName or k_VarName - just use VarName for the console
 static const char* SkipHungarianNotation(const char* inVarName)
@@ -81,8 +82,9 @@ template<>
 bool ConsoleVar<signed char>::ParseText(const char* text)
 {
   const int desiredVal = atoi(text);
-  _value = numeric_cast_clamped<signed char>(desiredVal);
-  return (desiredVal == (int)_value);
+  const signed char value = numeric_cast_clamped<signed char>(desiredVal);
+  Store(value);
+  return (desiredVal == (int)value);
 }
   
 //------------------------------------------------------------------------------------------------------------------------------
@@ -90,8 +92,9 @@ template<>
 bool ConsoleVar<unsigned char>::ParseText(const char* text)
 {
   const int desiredVal = atoi(text);
-  _value = numeric_cast_clamped<unsigned char>(desiredVal);
-  return (desiredVal == (int)_value);
+  const unsigned char value = numeric_cast_clamped<unsigned char>(desiredVal);
+  Store(value);
+  return (desiredVal == (int)value);
 }
 
 //------------------------------------------------------------------------------------------------------------------------------
@@ -101,15 +104,15 @@ bool ConsoleVar<bool>::ParseText(const char* text)
   if ((nullptr == text) || (strlen(text) == 0))
   {
     // toggle on empty input
-    _value = !_value;
+    Store(!Load());
   }
   else if ((stricmp(text, "true") == 0) || (strcmp(text, "1") == 0))
   {
-    _value = true;
+    Store(true);
   }
   else if ((stricmp(text, "false") == 0) || (strcmp(text, "0") == 0))
   {
-    _value = false;
+    Store(false);
   }
   else
   {
@@ -10,6 +10,8 @@
  *  - A Console Variable is a variable the can be registered with the ConsoleInterface and be edited at runtime via a remote
  *    console/terminal.
  *  - Console Variables will be const in shipping builds (if desired)
+ *  - The variable itself stays a plain global that code reads directly. The console reads and writes it with atomic
+ *    loads/stores, so an edit arriving on another thread never tears a value that is being read.
  *
  *******************************************************************************************************************************/
 
@@ -19,24 +21,59 @@
 #include "util/helpers/includeSstream.h"
 #include "util/math/math.h"
 #include "util/math/numericCast.h"
+#include <stdint.h>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <assert.h>
 
 namespace Anki {
 namespace Util {
 
+class ConsoleSystem;
+
+//******************************************************************************************************************************
+// Loads and stores of a console variable's value. Values that fit in a lock free atomic use the compiler's atomic builtins
+// on the variable in place (there is no std::atomic_ref yet), anything else is accessed plainly.
+namespace ConsoleVarAccess {
+
+template <typename T,
+          bool kIsAtomic = (std::is_trivially_copyable<T>::value && __atomic_always_lock_free(sizeof(T), 0))>
+struct Access
+{
+  static T Load( const T& value )
+  {
+    T result;
+    __atomic_load( &value, &result, __ATOMIC_ACQUIRE );
+    return result;
+  }
+  static void Store( T& value, T newValue ) { __atomic_store( &value, &newValue, __ATOMIC_RELEASE ); }
+};
+
+template <typename T>
+struct Access<T, false>
+{
+  static T Load( const T& value ) { return value; }
+  static void Store( T& value, T newValue ) { value = newValue; }
+};
+
+} // namespace ConsoleVarAccess
+
 
 //******************************************************************************************************************************
 class IConsoleVariable
 {
 public:
+  // Slots are handed out at registration and never reused, so a slot stays valid (or null) for the life of the process
+  static constexpr uint32_t kInvalidSlot = UINT32_MAX;
+
   IConsoleVariable( const char* id, const char* category, bool unregisterInDestructor );
   virtual ~IConsoleVariable();
 
   const std::string& GetID() const { return id_; }
   const std::string& GetCategory() const { return category_; }
   const std::string GetFullPathString() const { return ( category_ + "." + id_ ); }
+  uint32_t GetSlot() const { return slot_; }
 
   virtual bool ParseText( const char* text ) = 0;
 
@@ -68,6 +105,9 @@ protected:
   std::string id_;
   std::string category_;
   bool unregisterInDestructor_;
+  uint32_t slot_ = kInvalidSlot;
+
+  friend class ConsoleSystem;
 
   IConsoleVariable();
   IConsoleVariable( const IConsoleVariable& );
@@ -118,12 +158,12 @@ public:
   //----------------------------------------------------------------------------------------------------------------------------
   // These should implemented by each specialization;
   virtual bool ParseText( const char* text ) override;
-  virtual std::string ToString() const override { return ToString( _value ); }
+  virtual std::string ToString() const override { return ToString( Load() ); }
   virtual std::string GetDefaultAsString() const override { return ToString( _defaultValue ); }
 
-  virtual double    GetAsDouble() const override { return numeric_cast_clamped<double>(_value);  }
-  virtual int64_t   GetAsInt64()  const override { return numeric_cast_clamped<int64_t>(_value); }
-  virtual uint64_t  GetAsUInt64() const override { return numeric_cast_clamped<uint64_t>(_value); }
+  virtual double    GetAsDouble() const override { return numeric_cast_clamped<double>(Load());  }
+  virtual int64_t   GetAsInt64()  const override { return numeric_cast_clamped<int64_t>(Load()); }
+  virtual uint64_t  GetAsUInt64() const override { return numeric_cast_clamped<uint64_t>(Load()); }
 
   virtual double    GetMinAsDouble()  const override { return numeric_cast_clamped<double>(_minValue);  }
   virtual double    GetMaxAsDouble()  const override { return numeric_cast_clamped<double>(_maxValue);  }
@@ -132,9 +172,9 @@ public:
   virtual uint64_t  GetMinAsUInt64()  const override { return numeric_cast_clamped<uint64_t>(_minValue);  }
   virtual uint64_t  GetMaxAsUInt64()  const override { return numeric_cast_clamped<uint64_t>(_maxValue);  }
 
-  virtual void ToggleValue() override { _value = !((bool)_value); }
-  virtual void ResetToDefault() override { _value = _defaultValue; }
-  virtual bool IsDefaultValue() const override { return (_value == _defaultValue); }
+  virtual void ToggleValue() override { Store( !((bool)Load()) ); }
+  virtual void ResetToDefault() override { Store( _defaultValue ); }
+  virtual bool IsDefaultValue() const override { return (Load() == _defaultValue); }
 
   virtual bool IsToggleable()  const override { return (std::numeric_limits<T>::digits == 1); }
   virtual bool IsIntegerType() const override { return (std::numeric_limits<T>::is_integer);  }
@@ -145,6 +185,9 @@ public:
 protected:
   std::string ToString( T value ) const;
 
+  T Load() const { return ConsoleVarAccess::Access<T>::Load( _value ); }
+  void Store( T value ) { ConsoleVarAccess::Access<T>::Store( _value, value ); }
+
   //----------------------------------------------------------------------------------------------------------------------------
 protected:
   T& _value;
@@ -177,7 +220,7 @@ inline bool ConsoleVar<T>::ParseText( const char* text )
 {
   const std::vector<std::string>::iterator found = std::find(_enumValues.begin(), _enumValues.end(), text);
   if(found != _enumValues.end()) {
-    _value = (T)(found - _enumValues.begin());
+    Store( (T)(found - _enumValues.begin()) );
     return true;
   }
 
@@ -190,7 +233,7 @@ inline bool ConsoleVar<T>::ParseText( const char* text )
 
   if (parsedOK)
   {
-    _value = temp;
+    Store( temp );
   }
 
   return parsedOK;
@@ -0,0 +1,183 @@
+/**
+ * File: flatMap
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Sorted associative container kept in one contiguous vector of key/value pairs.
+ *              Lookups are a binary search over adjacent memory instead of a walk over separately allocated
+ *              tree nodes, which makes it the better choice for small maps that are read far more than they're
+ *              changed. Inserting or erasing is O(n) and invalidates iterators and references, unlike std::map.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Util_FlatMap_H__
+#define __Util_FlatMap_H__
+
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace Anki {
+namespace Util {
+
+template <class Key, class Value, class Compare = std::less<Key>>
+class FlatMap
+{
+public:
+  using key_type       = Key;
+  using mapped_type    = Value;
+  // Unlike std::map the key isn't const, since elements are moved around as others are inserted
+  using value_type     = std::pair<Key, Value>;
+  using container_type = std::vector<value_type>;
+  using iterator       = typename container_type::iterator;
+  using const_iterator = typename container_type::const_iterator;
+  using size_type      = size_t;
+
+  FlatMap() = default;
+
+  explicit FlatMap(const Compare& compare)
+  : _compare(compare)
+  {
+  }
+
+  FlatMap(std::initializer_list<value_type> init, const Compare& compare = Compare())
+  : _compare(compare)
+  {
+    reserve(init.size());
+    for (const value_type& value : init) {
+      insert(value);
+    }
+  }
+
+  // iterators, in key order
+  iterator       begin()        { return _data.begin(); }
+  const_iterator begin()  const { return _data.begin(); }
+  const_iterator cbegin() const { return _data.cbegin(); }
+  iterator       end()          { return _data.end(); }
+  const_iterator end()    const { return _data.end(); }
+  const_iterator cend()   const { return _data.cend(); }
+
+  // capacity
+  bool   empty()    const { return _data.empty(); }
+  size_t size()     const { return _data.size(); }
+  size_t capacity() const { return _data.capacity(); }
+  void   reserve(size_t newCapacity) { _data.reserve(newCapacity); }
+  void   clear() { _data.clear(); }
+
+  // lookup
+  iterator lower_bound(const Key& key)
+  {
+    return std::lower_bound(_data.begin(), _data.end(), key, KeyCompare{_compare});
+  }
+
+  const_iterator lower_bound(const Key& key) const
+  {
+    return std::lower_bound(_data.begin(), _data.end(), key, KeyCompare{_compare});
+  }
+
+  iterator find(const Key& key)
+  {
+    const iterator it = lower_bound(key);
+    return ((it != _data.end()) && !_compare(key, it->first)) ? it : _data.end();
+  }
+
+  const_iterator find(const Key& key) const
+  {
+    const const_iterator it = lower_bound(key);
+    return ((it != _data.end()) && !_compare(key, it->first)) ? it : _data.end();
+  }
+
+  size_t count(const Key& key) const { return (find(key) != end()) ? 1 : 0; }
+
+  Value& at(const Key& key)
+  {
+    const iterator it = find(key);
+    if (it == _data.end()) {
+      throw std::out_of_range("FlatMap.at");
+    }
+    return it->second;
+  }
+
+  const Value& at(const Key& key) const
+  {
+    const const_iterator it = find(key);
+    if (it == _data.end()) {
+      throw std::out_of_range("FlatMap.at");
+    }
+    return it->second;
+  }
+
+  Value& operator[](const Key& key)
+  {
+    return try_emplace(key).first->second;
+  }
+
+  // modifiers, each returns the element with that key and whether it was added (an existing one is left alone)
+  template <class... Args>
+  std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+  {
+    const iterator it = lower_bound(key);
+    if ((it != _data.end()) && !_compare(key, it->first)) {
+      return {it, false};
+    }
+    const iterator inserted = _data.emplace(it, std::piecewise_construct,
+                                            std::forward_as_tuple(key),
+                                            std::forward_as_tuple(std::forward<Args>(args)...));
+    return {inserted, true};
+  }
+
+  std::pair<iterator, bool> insert(const value_type& value)
+  {
+    return try_emplace(value.first, value.second);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value)
+  {
+    return try_emplace(value.first, std::move(value.second));
+  }
+
+  template <class... Args>
+  std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+  {
+    return try_emplace(key, std::forward<Args>(args)...);
+  }
+
+  iterator erase(const_iterator pos) { return _data.erase(pos); }
+  iterator erase(const_iterator first, const_iterator last) { return _data.erase(first, last); }
+
+  size_t erase(const Key& key)
+  {
+    const iterator it = find(key);
+    if (it == _data.end()) {
+      return 0;
+    }
+    _data.erase(it);
+    return 1;
+  }
+
+  bool operator==(const FlatMap& other) const { return _data == other._data; }
+  bool operator!=(const FlatMap& other) const { return _data != other._data; }
+
+private:
+
+  struct KeyCompare
+  {
+    const Compare& compare;
+    bool operator()(const value_type& lhs, const Key& rhs) const { return compare(lhs.first, rhs); }
+  };
+
+  container_type _data;
+  Compare        _compare;
+};
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_FlatMap_H__
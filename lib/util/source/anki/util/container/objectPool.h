@@ -0,0 +1,145 @@
+/**
+ * File: objectPool
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Pool of same-typed objects backed by fixed size blocks, with freed slots linked through an intrusive
+ *              free list. Objects are constructed in place on Create and destroyed on Destroy, but their memory goes
+ *              back to the pool rather than the heap, so a steady churn of short lived objects allocates only
+ *              until the pool has grown to the high water mark. Addresses are stable for an object's lifetime.
+ *
+ *              Not thread safe; a pool belongs to the thread that uses it.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Util_ObjectPool_H__
+#define __Util_ObjectPool_H__
+
+#include <assert.h>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Anki {
+namespace Util {
+
+template <class T, size_t kObjectsPerBlock = 32>
+class ObjectPool
+{
+  static_assert(kObjectsPerBlock > 0, "ObjectPool blocks need room for at least one object");
+
+public:
+
+  // Deleter for std::unique_ptr, so pooled objects can be handed out with the usual ownership semantics
+  class Deleter
+  {
+  public:
+    Deleter() = default;
+    explicit Deleter(ObjectPool* pool) : _pool(pool) {}
+    void operator()(T* object) const { if (object != nullptr) { _pool->Destroy(object); } }
+  private:
+    ObjectPool* _pool = nullptr;
+  };
+  using UniquePtr = std::unique_ptr<T, Deleter>;
+
+  ObjectPool() = default;
+
+  // Allocates up front room for at least count objects
+  explicit ObjectPool(size_t count)
+  {
+    Reserve(count);
+  }
+
+  // Every object must have been destroyed by now, their destructors won't be run
+  ~ObjectPool()
+  {
+    assert((_numLive == 0) && "ObjectPool destroyed with live objects");
+  }
+
+  ObjectPool(const ObjectPool&) = delete;
+  ObjectPool& operator=(const ObjectPool&) = delete;
+
+  template <class... Args>
+  T* Create(Args&&... args)
+  {
+    if (_freeList == nullptr) {
+      AddBlock();
+    }
+    Node* node = _freeList;
+    _freeList = node->next;
+    T* object = nullptr;
+    try {
+      object = new (&node->storage) T(std::forward<Args>(args)...);
+    } catch (...) {
+      node->next = _freeList;
+      _freeList = node;
+      throw;
+    }
+    ++_numLive;
+    return object;
+  }
+
+  template <class... Args>
+  UniquePtr MakeUnique(Args&&... args)
+  {
+    return UniquePtr(Create(std::forward<Args>(args)...), Deleter(this));
+  }
+
+  void Destroy(T* object)
+  {
+    assert(object != nullptr);
+    assert(_numLive > 0);
+    object->~T();
+    // storage is the first member, so the object's address is its node's
+    Node* node = reinterpret_cast<Node*>(object);
+    node->next = _freeList;
+    _freeList = node;
+    --_numLive;
+  }
+
+  void Reserve(size_t count)
+  {
+    while (Capacity() < count) {
+      AddBlock();
+    }
+  }
+
+  size_t GetNumLive() const { return _numLive; }
+  size_t Capacity()   const { return _blocks.size() * kObjectsPerBlock; }
+
+private:
+
+  union Node
+  {
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    Node* next;
+  };
+
+  using Block = std::unique_ptr<Node[]>;
+
+  void AddBlock()
+  {
+    _blocks.emplace_back(new Node[kObjectsPerBlock]);
+    Node* nodes = _blocks.back().get();
+    // Link back to front so objects are handed out in address order
+    for (size_t i = kObjectsPerBlock; i-- > 0; ) {
+      nodes[i].next = _freeList;
+      _freeList = &nodes[i];
+    }
+  }
+
+  std::vector<Block> _blocks;
+  Node*              _freeList = nullptr;
+  size_t             _numLive  = 0;
+};
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_ObjectPool_H__
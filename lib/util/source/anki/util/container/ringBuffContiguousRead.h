@@ -17,6 +17,7 @@
 #define __Util_Container_RingBuffContiguousRead_H__
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <cassert>
 
@@ -32,13 +33,14 @@ public:
     : _capacity( size )
     , _maxReadSize( maxReadSize )
     , _actualSize( _capacity + _maxReadSize )
+    , _buffer( _actualSize, T{} )
   {
-    Reset();
+    assert( _maxReadSize <= _capacity );
   }
   
+  // Empties the buffer. The backing memory is kept, so this never allocates
   void Reset()
   {
-    _buffer = std::vector<T>(_actualSize, T{});
     _head = 0;
     _tail = 0;
     _full = false;
@@ -52,32 +54,39 @@ public:
       return 0;
     }
     
-    for( size_t i=0; i<len; ++i ) {
-      size_t idx = i + _head;
-      if( idx < _actualSize ) {
-        _buffer[ idx ] = data[ i ];
-      }
-      if( idx >= _capacity ) {
-        // also write at the beginning of the array
-        assert(  idx < 2*_capacity );
-        _buffer[ idx - _capacity ] = data[ i ];
-      }
-      if( idx < _maxReadSize ) {
-        // also write at the end of the array
-        _buffer[ (_actualSize + idx) - _maxReadSize ] = data[ i ];
-      }
+    // up to the end of the ring, then wrap around to the beginning
+    const size_t firstLen = std::min<size_t>( len, _capacity - _head );
+    std::copy( data, data + firstLen, _buffer.begin() + _head );
+    std::copy( data + firstLen, data + len, _buffer.begin() );
+    CommitWritten( firstLen, available );
+    if( len > firstLen ) {
+      // the first commit ended exactly at the end of the ring, so head is now 0
+      CommitWritten( len - firstLen, available - firstLen );
     }
-    _head += len;
-    if( _head >= _capacity ) {
-      _head = _head % _capacity;
-    }
-    
-    
-    _full = (len == available);
     
     return len;
   }
   
+  // For writing in place instead of through AddData(), e.g. when reading from a stream. Returns where the next
+  // element goes and sets out_len to how many can be written there contiguously (0 if full). Follow with
+  // CommitData() once they are written.
+  T* GetWriteData( size_t& out_len )
+  {
+    out_len = std::min( GetNumAvailable(), _capacity - _head );
+    return _buffer.data() + _head;
+  }
+  
+  // Adds len elements written at GetWriteData(). Returns elements added, which is 0 if len is more than fits there.
+  size_t CommitData( const unsigned int len )
+  {
+    const size_t available = GetNumAvailable();
+    if( len > std::min( available, _capacity - _head ) ) {
+      return 0;
+    }
+    CommitWritten( len, available );
+    return len;
+  }
+  
   // Returns null if can't read length len
   const T* ReadData( const unsigned int len ) const
   {
@@ -154,6 +163,31 @@ public:
   
 private:
   
+  // Copies [begin, end) of the ring to the extra space past its end, as far as that space reaches, so reads
+  // that wrap stay contiguous
+  void MirrorFront( size_t begin, size_t end )
+  {
+    end = std::min( end, _maxReadSize );
+    if( begin < end ) {
+      std::copy( _buffer.begin() + begin, _buffer.begin() + end, _buffer.begin() + _capacity + begin );
+    }
+  }
+  
+  // Marks len elements at the head as written. They must not wrap past the end of the ring
+  void CommitWritten( size_t len, size_t available )
+  {
+    assert( _head + len <= _capacity );
+    if( len == 0 ) {
+      return;
+    }
+    MirrorFront( _head, _head + len );
+    _head += len;
+    if( _head >= _capacity ) {
+      _head = _head % _capacity;
+    }
+    _full = (len == available);
+  }
+  
   bool IsFull() const { return _full; }
   
   inline size_t GetNumAvailable() const {
@@ -175,6 +209,10 @@ private:
     return used;
   }
   
+  const size_t _capacity;
+  const size_t _maxReadSize;
+  const size_t _actualSize;
+  
   std::vector<T> _buffer;
   
   size_t _head = 0;
@@ -182,10 +220,6 @@ private:
   
   bool _full = false;
   
-  const size_t _capacity;
-  const size_t _maxReadSize;
-  const size_t _actualSize;
-  
 };
 
 } // namespace
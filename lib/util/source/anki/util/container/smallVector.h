@@ -0,0 +1,266 @@
+/**
+ * File: smallVector
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Vector that keeps its first N elements inline and only allocates once it grows past them.
+ *              Meant for short per-frame lists (detections, observations) that are rebuilt every tick and would
+ *              otherwise cost a heap allocation per element (std::list) or per frame (std::vector).
+ *              Iterators are plain pointers and, as with std::vector, are invalidated by anything that grows it.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Util_SmallVector_H__
+#define __Util_SmallVector_H__
+
+#include <assert.h>
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Anki {
+namespace Util {
+
+template <class T, size_t N>
+class SmallVector
+{
+  static_assert(N > 0, "SmallVector needs room for at least one inline element");
+
+public:
+  using value_type      = T;
+  using size_type       = size_t;
+  using difference_type = ptrdiff_t;
+  using reference       = T&;
+  using const_reference = const T&;
+  using pointer         = T*;
+  using const_pointer   = const T*;
+  using iterator        = T*;
+  using const_iterator  = const T*;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+  static constexpr size_t kInlineCapacity = N;
+
+  SmallVector() = default;
+
+  SmallVector(std::initializer_list<T> init)
+  {
+    reserve(init.size());
+    for (const T& value : init) {
+      push_back(value);
+    }
+  }
+
+  ~SmallVector()
+  {
+    clear();
+    FreeHeap();
+  }
+
+  SmallVector(const SmallVector& other)
+  {
+    reserve(other._size);
+    std::uninitialized_copy(other.begin(), other.end(), _data);
+    _size = other._size;
+  }
+
+  // Steals the allocation when other has spilled to the heap, otherwise moves the inline elements one by one
+  SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    MoveFrom(std::move(other));
+  }
+
+  SmallVector& operator=(const SmallVector& other)
+  {
+    if (this != &other) {
+      clear();
+      reserve(other._size);
+      std::uninitialized_copy(other.begin(), other.end(), _data);
+      _size = other._size;
+    }
+    return *this;
+  }
+
+  SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value)
+  {
+    if (this != &other) {
+      clear();
+      FreeHeap();
+      MoveFrom(std::move(other));
+    }
+    return *this;
+  }
+
+  // element access
+  T&       operator[](size_t index)       { assert(index < _size); return _data[index]; }
+  const T& operator[](size_t index) const { assert(index < _size); return _data[index]; }
+  T&       front()       { assert(_size > 0); return _data[0]; }
+  const T& front() const { assert(_size > 0); return _data[0]; }
+  T&       back()        { assert(_size > 0); return _data[_size - 1]; }
+  const T& back()  const { assert(_size > 0); return _data[_size - 1]; }
+  T*       data()        { return _data; }
+  const T* data()  const { return _data; }
+
+  // iterators
+  iterator       begin()        { return _data; }
+  const_iterator begin()  const { return _data; }
+  const_iterator cbegin() const { return _data; }
+  iterator       end()          { return _data + _size; }
+  const_iterator end()    const { return _data + _size; }
+  const_iterator cend()   const { return _data + _size; }
+  reverse_iterator       rbegin()       { return reverse_iterator(end()); }
+  const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+  reverse_iterator       rend()         { return reverse_iterator(begin()); }
+  const_reverse_iterator rend()   const { return const_reverse_iterator(begin()); }
+
+  // capacity
+  bool   empty()    const { return _size == 0; }
+  size_t size()     const { return _size; }
+  size_t capacity() const { return _capacity; }
+  bool   IsInline() const { return _data == InlineData(); }
+
+  void reserve(size_t newCapacity)
+  {
+    if (newCapacity <= _capacity) {
+      return;
+    }
+    T* newData = static_cast<T*>(::operator new(newCapacity * sizeof(T)));
+    for (size_t i = 0; i < _size; ++i) {
+      new (newData + i) T(std::move_if_noexcept(_data[i]));
+      _data[i].~T();
+    }
+    FreeHeap();
+    _data = newData;
+    _capacity = newCapacity;
+  }
+
+  // modifiers
+  void clear()
+  {
+    DestroyRange(_data, _data + _size);
+    _size = 0;
+  }
+
+  void push_back(const T& value) { emplace_back(value); }
+  void push_back(T&& value)      { emplace_back(std::move(value)); }
+
+  template <class... Args>
+  T& emplace_back(Args&&... args)
+  {
+    if (_size == _capacity) {
+      // Construct first, args may refer to an element that growing would move
+      T value(std::forward<Args>(args)...);
+      reserve(_capacity * 2);
+      new (_data + _size) T(std::move(value));
+    } else {
+      new (_data + _size) T(std::forward<Args>(args)...);
+    }
+    return _data[_size++];
+  }
+
+  void pop_back()
+  {
+    assert(_size > 0);
+    _data[--_size].~T();
+  }
+
+  iterator erase(const_iterator pos)
+  {
+    return erase(pos, pos + 1);
+  }
+
+  iterator erase(const_iterator first, const_iterator last)
+  {
+    T* const dest = const_cast<T*>(first);
+    assert((dest >= begin()) && (last <= end()) && (first <= last));
+    T* const newEnd = std::move(const_cast<T*>(last), end(), dest);
+    DestroyRange(newEnd, end());
+    _size = static_cast<size_t>(newEnd - _data);
+    return dest;
+  }
+
+  void resize(size_t newSize)
+  {
+    if (newSize < _size) {
+      DestroyRange(_data + newSize, _data + _size);
+    } else {
+      reserve(newSize);
+      for (size_t i = _size; i < newSize; ++i) {
+        new (_data + i) T();
+      }
+    }
+    _size = newSize;
+  }
+
+private:
+
+  T*       InlineData()       { return reinterpret_cast<T*>(&_inline); }
+  const T* InlineData() const { return reinterpret_cast<const T*>(&_inline); }
+
+  static void DestroyRange(T* first, T* last)
+  {
+    for (; first != last; ++first) {
+      first->~T();
+    }
+  }
+
+  void FreeHeap()
+  {
+    if (!IsInline()) {
+      ::operator delete(_data);
+      _data = InlineData();
+      _capacity = N;
+    }
+  }
+
+  // Expects this to be empty and inline
+  void MoveFrom(SmallVector&& other)
+  {
+    if (other.IsInline()) {
+      for (size_t i = 0; i < other._size; ++i) {
+        new (_data + i) T(std::move(other._data[i]));
+      }
+      _size = other._size;
+      other.clear();
+    } else {
+      _data = other._data;
+      _size = other._size;
+      _capacity = other._capacity;
+      other._data = other.InlineData();
+      other._size = 0;
+      other._capacity = N;
+    }
+  }
+
+  typename std::aligned_storage<sizeof(T) * N, alignof(T)>::type _inline;
+  T*     _data = InlineData();
+  size_t _size = 0;
+  size_t _capacity = N;
+};
+
+template <class T, size_t N>
+constexpr size_t SmallVector<T, N>::kInlineCapacity;
+
+template <class T, size_t N>
+inline bool operator==(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+  return (lhs.size() == rhs.size()) && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <class T, size_t N>
+inline bool operator!=(const SmallVector<T, N>& lhs, const SmallVector<T, N>& rhs)
+{
+  return !(lhs == rhs);
+}
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_SmallVector_H__
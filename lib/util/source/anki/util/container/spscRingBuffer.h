@@ -0,0 +1,119 @@
+/**
+ * File: spscRingBuffer
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Fixed memory and storage size (no dynamic allocations) ring buffer for exactly one producer thread and
+ *              one consumer thread. Neither side ever takes a lock or waits on the other: the producer writes into a
+ *              free slot and publishes it, the consumer reads the oldest published slot in place and releases it.
+ *              When the buffer is full the producer's item is dropped and counted, since the consumer still owns
+ *              the oldest slot.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+
+#ifndef __Util_Container_SpscRingBuffer_H__
+#define __Util_Container_SpscRingBuffer_H__
+
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace Anki {
+namespace Util {
+
+
+template <class T, size_t kCapacity>
+class SpscRingBuffer
+{
+  static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0, "Capacity must be a power of 2");
+
+public:
+  SpscRingBuffer() = default;
+  SpscRingBuffer(const SpscRingBuffer&) = delete;
+  SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+  // Producer: the next free slot to fill in, or nullptr (counted as an overrun) if the buffer is full. The slot is
+  // only seen by the consumer once push_commit() is called
+  T* push_begin()
+  {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    if (head - _tail.load(std::memory_order_acquire) >= kCapacity)
+    {
+      _numOverruns.fetch_add(1, std::memory_order_relaxed);
+      return nullptr;
+    }
+    return &_items[head & kMask];
+  }
+
+  void push_commit()
+  {
+    _head.store(_head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  // Producer: returns false (counted as an overrun) if the buffer is full
+  bool push_back(const T& newEntry)
+  {
+    T* slot = push_begin();
+    if (nullptr == slot)
+    {
+      return false;
+    }
+    *slot = newEntry;
+    push_commit();
+    return true;
+  }
+
+  // Consumer: the oldest published entry, or nullptr if there is none. It stays valid until pop_front()
+  T* front()
+  {
+    const size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire))
+    {
+      return nullptr;
+    }
+    return &_items[tail & kMask];
+  }
+
+  // Consumer: releases the entry returned by front() back to the producer
+  void pop_front()
+  {
+    _tail.store(_tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+  }
+
+  // Either side. Only a snapshot, since the other side may be pushing or popping meanwhile. The tail is read first so
+  // that the head read after it can't be behind it
+  size_t size() const
+  {
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    return _head.load(std::memory_order_acquire) - tail;
+  }
+  bool empty() const { return size() == 0; }
+  constexpr size_t capacity() const { return kCapacity; }
+
+  // Number of push_begin()/push_back() calls that found the buffer full
+  uint32_t GetNumOverruns() const { return _numOverruns.load(std::memory_order_relaxed); }
+
+private:
+  static constexpr size_t kMask = kCapacity - 1;
+
+  std::array<T, kCapacity> _items;
+
+  // Free-running counts of pushed and popped entries. Each side only writes its own, and they are kept on separate
+  // cache lines so the two threads don't contend for one
+  alignas(64) std::atomic<size_t> _head{0};
+  alignas(64) std::atomic<size_t> _tail{0};
+  alignas(64) std::atomic<uint32_t> _numOverruns{0};
+};
+
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_Container_SpscRingBuffer_H__
@@ -0,0 +1,353 @@
+/**
+ * File: cpuHitchRecorder
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Always-on, production safe companion to CpuProfiler, see header
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+
+#include "util/cpuProfiler/cpuHitchRecorder.h"
+#include "util/dispatchQueue/taskExecutor.h"
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+
+#if ANKI_CPU_HITCH_RECORDER_ENABLED
+
+
+namespace Anki {
+namespace Util {
+
+
+constexpr const uint32_t CpuHitchRecorder::kMaxThreads;
+constexpr const uint32_t CpuHitchRecorder::kRecordsPerThread;
+constexpr const uint32_t CpuHitchRecorder::kWindow_ms;
+constexpr const uint32_t CpuHitchRecorder::kMinSampleDuration_ns;
+constexpr const uint32_t CpuHitchRecorder::kMinDumpInterval_ms;
+constexpr const uint32_t CpuHitchRecorder::kMaxDumpFiles;
+constexpr const uint32_t CpuHitchRecorder::kDumpFileMagic;
+constexpr const uint16_t CpuHitchRecorder::kDumpFileVersion;
+constexpr const char*    CpuHitchRecorder::kDumpFileExtension;
+
+std::atomic<CpuHitchRecorder::ThreadRing*> CpuHitchRecorder::sRings[kMaxThreads];
+
+thread_local CpuHitchRecorder::ThreadRing* CpuHitchRecorder::sCurrentRing = nullptr;
+thread_local uint32_t                      CpuHitchRecorder::sCurrentRingIndex = 0;
+
+
+namespace {
+
+std::mutex        sRegisterMutex;
+thread_local bool sRegisterFailed = false;
+
+std::mutex        sConfigMutex;
+std::string       sDumpDirectory;
+std::string       sFilePrefix;
+std::atomic<bool> sEnabled{false};
+
+std::atomic<int64_t> sLastDumpTime_ms{0};
+
+// Dumps are written at low priority, well away from the thread that just ran over.
+// Never destroyed, so a hitch while the process exits can't find it gone.
+TaskExecutor& GetDumpWriter()
+{
+  static TaskExecutor* sDumpWriter = new TaskExecutor("CpuHitchWriter", ThreadPriority::Low);
+  return *sDumpWriter;
+}
+
+template <typename T>
+void Append(std::vector<uint8_t>& buffer, T value)
+{
+  const size_t offset = buffer.size();
+  buffer.resize(offset + sizeof(T));
+  memcpy(&buffer[offset], &value, sizeof(T));
+}
+
+struct RecordCopy
+{
+  const char* name;
+  int64_t     start_ns;
+  uint64_t    info;
+};
+
+// Names are written once, and records refer to them by index
+class NameTable
+{
+public:
+  uint16_t GetIndex(const char* name)
+  {
+    const std::string key = (name != nullptr) ? name : "";
+    auto it = _indices.find(key);
+    if (it != _indices.end())
+    {
+      return it->second;
+    }
+    if (_names.size() >= UINT16_MAX)
+    {
+      return UINT16_MAX;
+    }
+    const uint16_t index = static_cast<uint16_t>(_names.size());
+    _indices.emplace(key, index);
+    _names.push_back(key);
+    return index;
+  }
+
+  size_t GetCount() const { return _names.size(); }
+
+  void Write(std::vector<uint8_t>& buffer) const
+  {
+    for (const std::string& name : _names)
+    {
+      const uint8_t length = static_cast<uint8_t>(std::min<size_t>(name.size(), UINT8_MAX));
+      Append(buffer, length);
+      buffer.insert(buffer.end(), name.begin(), name.begin() + length);
+    }
+  }
+
+private:
+  std::unordered_map<std::string, uint16_t> _indices;
+  std::vector<std::string>                  _names;
+};
+
+} // namespace
+
+
+void CpuHitchRecorder::SetDumpDirectory(const std::string& dumpDirectory, const std::string& filePrefix)
+{
+  std::lock_guard<std::mutex> lock(sConfigMutex);
+  sDumpDirectory = dumpDirectory;
+  sFilePrefix = filePrefix;
+  if (!dumpDirectory.empty())
+  {
+    FileUtils::CreateDirectory(dumpDirectory);
+  }
+  sEnabled = !dumpDirectory.empty();
+}
+
+
+void CpuHitchRecorder::BeginTick(const char* tickName)
+{
+  if ((sCurrentRing == nullptr) && !sRegisterFailed && sEnabled.load(std::memory_order_relaxed))
+  {
+    sCurrentRing = RegisterThread(tickName);
+    sRegisterFailed = (sCurrentRing == nullptr);
+  }
+}
+
+
+void CpuHitchRecorder::EndTick(const CpuProfileClock::time_point& start, const CpuProfileClock::time_point& end,
+                               double maxTickTime_ms)
+{
+  ThreadRing* ring = sCurrentRing;
+  if (ring == nullptr)
+  {
+    return;
+  }
+
+  const int64_t start_ns = ToNanoseconds(start);
+  ring->Push(ring->tickName.load(std::memory_order_relaxed), start_ns, ToNanoseconds(end) - start_ns, true);
+
+  // A max of 0 means the tick has no budget (e.g. one time ticks)
+  if ((maxTickTime_ms > 0.0) && (CalcDuration_ms(start, end) > maxTickTime_ms) && sEnabled.load(std::memory_order_relaxed))
+  {
+    RequestDump(end, sCurrentRingIndex);
+  }
+}
+
+
+CpuHitchRecorder::ThreadRing* CpuHitchRecorder::RegisterThread(const char* tickName)
+{
+  std::lock_guard<std::mutex> lock(sRegisterMutex);
+
+  for (uint32_t i = 0; i < kMaxThreads; ++i)
+  {
+    ThreadRing* ring = sRings[i].load(std::memory_order_relaxed);
+    if (ring == nullptr)
+    {
+      ring = new ThreadRing();
+      ring->tickName.store(tickName, std::memory_order_relaxed);
+      ring->inUse.store(true, std::memory_order_relaxed);
+      sRings[i].store(ring, std::memory_order_release);
+      sCurrentRingIndex = i;
+      return ring;
+    }
+
+    // A restarted thread carries on with its predecessor's ring, history included
+    if (!ring->inUse.load(std::memory_order_relaxed) && (strcmp(ring->tickName.load(std::memory_order_relaxed), tickName) == 0))
+    {
+      ring->inUse.store(true, std::memory_order_relaxed);
+      sCurrentRingIndex = i;
+      return ring;
+    }
+  }
+
+  PRINT_NAMED_WARNING("CpuHitchRecorder.RegisterThread.TooManyThreads", "Not recording '%s', all %u rings in use",
+                      tickName, kMaxThreads);
+  return nullptr;
+}
+
+
+void CpuHitchRecorder::RemoveCurrentThread()
+{
+  if (sCurrentRing != nullptr)
+  {
+    std::lock_guard<std::mutex> lock(sRegisterMutex);
+    sCurrentRing->inUse.store(false, std::memory_order_relaxed);
+    sCurrentRing = nullptr;
+  }
+  sRegisterFailed = false;
+}
+
+
+void CpuHitchRecorder::RequestDump(const CpuProfileClock::time_point& end, uint32_t triggerThreadIndex)
+{
+  const int64_t end_ms = ToNanoseconds(end) / 1000000;
+  int64_t lastDumpTime_ms = sLastDumpTime_ms.load(std::memory_order_relaxed);
+  if ((lastDumpTime_ms != 0) && ((end_ms - lastDumpTime_ms) < kMinDumpInterval_ms))
+  {
+    return;
+  }
+  if (!sLastDumpTime_ms.compare_exchange_strong(lastDumpTime_ms, end_ms))
+  {
+    return; // another thread's hitch got there first
+  }
+
+  std::string dumpDirectory;
+  std::string filePrefix;
+  {
+    std::lock_guard<std::mutex> lock(sConfigMutex);
+    dumpDirectory = sDumpDirectory;
+    filePrefix = sFilePrefix;
+  }
+
+  GetDumpWriter().Wake([dumpDirectory, filePrefix, end, triggerThreadIndex] {
+    const size_t numDumps = FileUtils::FilesInDirectory(dumpDirectory, false, kDumpFileExtension).size();
+    if (numDumps >= kMaxDumpFiles)
+    {
+      PRINT_NAMED_WARNING("CpuHitchRecorder.Dump.TooManyDumps", "%zu dumps waiting for upload in '%s'",
+                          numDumps, dumpDirectory.c_str());
+      return;
+    }
+
+    const int64_t wallTime_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+      std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::string fileName = filePrefix + "-" + std::to_string(wallTime_ms) + "." + kDumpFileExtension;
+    const std::string path = FileUtils::FullFilePath({dumpDirectory, fileName});
+    if (WriteDump(path, end, triggerThreadIndex))
+    {
+      PRINT_NAMED_INFO("CpuHitchRecorder.Dump", "Wrote %s", path.c_str());
+    }
+  }, "CpuHitchDump");
+}
+
+
+bool CpuHitchRecorder::WriteDump(const std::string& path, const CpuProfileClock::time_point& end,
+                                 uint32_t triggerThreadIndex)
+{
+  const int64_t end_ns = ToNanoseconds(end);
+  const int64_t windowStart_ns = end_ns - (static_cast<int64_t>(kWindow_ms) * 1000000);
+
+  struct ThreadCopy
+  {
+    const char*             tickName;
+    std::vector<RecordCopy> records;
+  };
+  std::vector<ThreadCopy> threads;
+  int64_t firstStart_ns = end_ns;
+
+  std::vector<RecordCopy> records;
+  records.reserve(kRecordsPerThread);
+  for (uint32_t i = 0; i < kMaxThreads; ++i)
+  {
+    const ThreadRing* ring = sRings[i].load(std::memory_order_acquire);
+    if (ring == nullptr)
+    {
+      break;
+    }
+
+    records.clear();
+    const uint64_t committed = ring->committed.load(std::memory_order_acquire);
+    const uint64_t first = (committed > kRecordsPerThread) ? (committed - kRecordsPerThread) : 0;
+    for (uint64_t index = first; index < committed; ++index)
+    {
+      const Record& record = ring->records[index % kRecordsPerThread];
+      records.push_back({record.name.load(std::memory_order_relaxed),
+                         record.start_ns.load(std::memory_order_relaxed),
+                         record.info.load(std::memory_order_relaxed)});
+    }
+
+    // Anything the writer may have started overwriting while we copied is dropped
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const uint64_t started = ring->started.load(std::memory_order_relaxed);
+    const uint64_t firstIntact = (started > kRecordsPerThread) ? (started - kRecordsPerThread) : 0;
+
+    ThreadCopy thread;
+    thread.tickName = ring->tickName.load(std::memory_order_relaxed);
+    for (uint64_t index = std::max(first, firstIntact); index < committed; ++index)
+    {
+      const RecordCopy& record = records[index - first];
+      const int64_t recordEnd_ns = record.start_ns + static_cast<int64_t>(record.info >> 1);
+      if ((recordEnd_ns >= windowStart_ns) && (record.start_ns <= end_ns))
+      {
+        thread.records.push_back(record);
+        firstStart_ns = std::min(firstStart_ns, record.start_ns);
+      }
+    }
+    threads.push_back(std::move(thread));
+  }
+
+  NameTable names;
+  std::vector<uint8_t> body;
+  for (const ThreadCopy& thread : threads)
+  {
+    Append(body, names.GetIndex(thread.tickName));
+    Append(body, static_cast<uint32_t>(thread.records.size()));
+    for (const RecordCopy& record : thread.records)
+    {
+      const uint64_t duration_us = (record.info >> 1) / 1000;
+      Append(body, names.GetIndex(record.name));
+      Append(body, static_cast<uint8_t>(record.info & 1));
+      Append(body, static_cast<uint32_t>((record.start_ns - firstStart_ns) / 1000));
+      Append(body, static_cast<uint32_t>(std::min<uint64_t>(duration_us, UINT32_MAX)));
+    }
+  }
+
+  // The trigger's wall clock time, from how long ago it was on the profiler clock
+  const int64_t wallTime_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+    std::chrono::system_clock::now().time_since_epoch() - (CpuProfileClock::now() - end)).count();
+
+  std::vector<uint8_t> buffer;
+  Append(buffer, kDumpFileMagic);
+  Append(buffer, kDumpFileVersion);
+  Append(buffer, static_cast<uint16_t>(names.GetCount()));
+  Append(buffer, static_cast<uint16_t>(threads.size()));
+  Append(buffer, static_cast<uint16_t>(triggerThreadIndex));
+  Append(buffer, wallTime_ms);
+  Append(buffer, static_cast<uint32_t>((end_ns - firstStart_ns) / 1000));
+  names.Write(buffer);
+  buffer.insert(buffer.end(), body.begin(), body.end());
+
+  if (!FileUtils::WriteFileAtomic(path, buffer))
+  {
+    PRINT_NAMED_WARNING("CpuHitchRecorder.WriteDump.Failed", "Unable to write %s", path.c_str());
+    return false;
+  }
+  return true;
+}
+
+
+} // end namespace Util
+} // end namespace Anki
+
+
+#endif // ANKI_CPU_HITCH_RECORDER_ENABLED
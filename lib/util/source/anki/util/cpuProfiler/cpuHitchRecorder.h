@@ -0,0 +1,213 @@
+/**
+ * File: cpuHitchRecorder
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Always-on, production safe companion to CpuProfiler. Every thread with an ANKI_CPU_TICK keeps a
+ *              fixed ring of its most recent ticks and ANKI_CPU_PROFILE samples, and when a tick runs over its
+ *              max tick time the last kWindow_ms of every thread is written to a compact dump file in the dump
+ *              directory, for the log uploader to pick up.
+ *
+ *              Dump file layout (little endian, no padding):
+ *                u32 magic 'CPUH', u16 version, u16 numNames, u16 numThreads, u16 triggerThread,
+ *                i64 wall clock ms at the trigger, u32 window length us, then
+ *                numNames   x { u8 len, char name[len] }
+ *                numThreads x { u16 tickName, u32 numRecords, numRecords x { u16 name, u8 isTick, u32 start_us, u32 dur_us } }
+ *              where start_us is relative to the start of the window, and names index the name table.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+
+#ifndef __Util_CpuProfiler_CpuHitchRecorder_H__
+#define __Util_CpuProfiler_CpuHitchRecorder_H__
+
+
+#include "util/cpuProfiler/cpuProfilerClock.h"
+#include "util/cpuProfiler/cpuProfilerSettings.h"
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+
+#if ANKI_CPU_HITCH_RECORDER_ENABLED
+
+
+namespace Anki {
+namespace Util {
+
+
+// ================================================================================
+// CpuHitchRecorder
+
+class CpuHitchRecorder
+{
+public:
+
+  static constexpr const uint32_t kMaxThreads           = 8;
+  static constexpr const uint32_t kRecordsPerThread     = 8192; // bounds the window on threads with many samples per tick
+  static constexpr const uint32_t kWindow_ms            = 5000;
+  static constexpr const uint32_t kMinSampleDuration_ns = 10000; // same cutoff as CpuThreadProfiler's min sample duration
+  static constexpr const uint32_t kMinDumpInterval_ms   = 60000;
+  static constexpr const uint32_t kMaxDumpFiles         = 8;     // left waiting for upload in the dump directory
+  static constexpr const uint32_t kDumpFileMagic        = 0x48555043; // "CPUH"
+  static constexpr const uint16_t kDumpFileVersion      = 1;
+  static constexpr const char*    kDumpFileExtension    = "cpuh";
+
+  // Nothing is recorded until a dump directory is set. Dumps are named <filePrefix>-<wall clock ms>.cpuh
+  static void SetDumpDirectory(const std::string& dumpDirectory, const std::string& filePrefix);
+
+  // Registers the calling thread (under tickName, which must be static) the first time it's called on it
+  static void BeginTick(const char* tickName);
+  static void EndTick(const CpuProfileClock::time_point& start, const CpuProfileClock::time_point& end,
+                      double maxTickTime_ms);
+
+  static bool IsRecordingThread() { return sCurrentRing != nullptr; }
+
+  // name must be static, only the pointer is kept
+  static void AddSample(const char* name, const CpuProfileClock::time_point& start, const CpuProfileClock::time_point& end)
+  {
+    ThreadRing* ring = sCurrentRing;
+    if (ring != nullptr)
+    {
+      const int64_t start_ns = ToNanoseconds(start);
+      const int64_t duration_ns = ToNanoseconds(end) - start_ns;
+      if (duration_ns >= kMinSampleDuration_ns)
+      {
+        ring->Push(name, start_ns, duration_ns, false);
+      }
+    }
+  }
+
+  // Stops recording on the calling thread. Its ring goes to the next thread that registers with the same tick name.
+  static void RemoveCurrentThread();
+
+  // Writes the last kWindow_ms (up to end) of every thread to path, regardless of rate limiting.
+  // Safe to call from any thread, while the recorded threads keep ticking.
+  static bool WriteDump(const std::string& path, const CpuProfileClock::time_point& end, uint32_t triggerThreadIndex);
+
+private:
+
+  struct Record
+  {
+    std::atomic<const char*> name;
+    std::atomic<int64_t>     start_ns;
+    std::atomic<uint64_t>    info; // duration_ns << 1 | isTick
+  };
+
+  // Written by its thread only. Readers copy it seqlock style: a record is only kept if the writer
+  // hadn't started overwriting its slot by the time the copy was done.
+  struct ThreadRing
+  {
+    void Push(const char* name, int64_t start_ns, int64_t duration_ns, bool isTick)
+    {
+      const uint64_t index = committed.load(std::memory_order_relaxed);
+      started.store(index + 1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+
+      Record& record = records[index % kRecordsPerThread];
+      record.name.store(name, std::memory_order_relaxed);
+      record.start_ns.store(start_ns, std::memory_order_relaxed);
+      record.info.store((static_cast<uint64_t>(duration_ns) << 1) | (isTick ? 1 : 0), std::memory_order_relaxed);
+
+      committed.store(index + 1, std::memory_order_release);
+    }
+
+    std::atomic<const char*> tickName{nullptr};
+    std::atomic<bool>        inUse{false};
+    std::atomic<uint64_t>    started{0};
+    std::atomic<uint64_t>    committed{0};
+    Record                   records[kRecordsPerThread];
+  };
+
+  static int64_t ToNanoseconds(const CpuProfileClock::time_point& timePoint)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(timePoint.time_since_epoch()).count();
+  }
+
+  static ThreadRing* RegisterThread(const char* tickName);
+  static void RequestDump(const CpuProfileClock::time_point& end, uint32_t triggerThreadIndex);
+
+  // Allocated in order as threads register, and never freed, so dumps can walk them without a lock
+  static std::atomic<ThreadRing*> sRings[kMaxThreads];
+
+  static thread_local ThreadRing* sCurrentRing;
+  static thread_local uint32_t    sCurrentRingIndex;
+};
+
+
+// ================================================================================
+// ScopedCpuHitchTick
+
+class ScopedCpuHitchTick
+{
+public:
+
+  ScopedCpuHitchTick(const char* tickName, double maxTickTime_ms)
+    : _maxTickTime_ms(maxTickTime_ms)
+  {
+    CpuHitchRecorder::BeginTick(tickName);
+    _startTime = CpuProfileClock::now();
+  }
+
+  ~ScopedCpuHitchTick()
+  {
+    CpuHitchRecorder::EndTick(_startTime, CpuProfileClock::now(), _maxTickTime_ms);
+  }
+
+private:
+
+  CpuProfileClock::time_point _startTime;
+  double                      _maxTickTime_ms;
+};
+
+
+// ================================================================================
+// ScopedCpuHitchSample
+
+class ScopedCpuHitchSample
+{
+public:
+
+  explicit ScopedCpuHitchSample(const char* name)
+    : _name(name)
+    , _active(CpuHitchRecorder::IsRecordingThread())
+  {
+    if (_active)
+    {
+      _startTime = CpuProfileClock::now();
+    }
+  }
+
+  ~ScopedCpuHitchSample()
+  {
+    Stop();
+  }
+
+  void Stop()
+  {
+    if (_active)
+    {
+      CpuHitchRecorder::AddSample(_name, _startTime, CpuProfileClock::now());
+      _active = false;
+    }
+  }
+
+private:
+
+  const char*                 _name;
+  CpuProfileClock::time_point _startTime;
+  bool                        _active; // only threads with a tick are recorded, so others skip reading the clock
+};
+
+
+} // end namespace Util
+} // end namespace Anki
+
+
+#endif // ANKI_CPU_HITCH_RECORDER_ENABLED
+
+
+#endif // __Util_CpuProfiler_CpuHitchRecorder_H__
@@ -15,6 +15,7 @@
 #define __Util_CpuProfiler_CpuProfiler_H__
 
 
+#include "util/cpuProfiler/cpuHitchRecorder.h"
 #include "util/cpuProfiler/cpuProfilerClock.h"
 #include "util/cpuProfiler/cpuProfilerSettings.h"
 #include "util/cpuProfiler/cpuProfileSampleShared.h"
@@ -24,9 +25,17 @@
 #include <assert.h>
 #include <vector>
 
-#if ANKI_CPU_PROFILER_ENABLED
 
-  #define ANKI_CPU_CONSOLEVARGROUP "CpuProfiler"
+#define ANKI_CPU_CONSOLEVARGROUP "CpuProfiler"
+
+// Macros for creating unique variable names using __LINE__ macro
+// Needs the multiple levels of indirection so that __LINE__ is expanded to the line number
+#define ANKI_CPU_UNIQUE_VAR_NAME3(varName, lineNum)   varName ## lineNum
+#define ANKI_CPU_UNIQUE_VAR_NAME2(varName, lineNum)   ANKI_CPU_UNIQUE_VAR_NAME3(varName, lineNum)
+#define ANKI_CPU_UNIQUE_VAR_NAME(varName)             ANKI_CPU_UNIQUE_VAR_NAME2(varName, __LINE__)
+
+
+#if ANKI_CPU_PROFILER_ENABLED
 
   #define ANKI_CPU_PROFILER_WARN_ON_NO_PROFILER     0   // Enable to track down calls on untracked threads
 
@@ -85,6 +94,7 @@
     
     static void RemoveCurrentThreadProfiler()
     {
+      ANKI_CPU_HITCH_RECORDER_ENABLED_ONLY( CpuHitchRecorder::RemoveCurrentThread() );
       return GetInstance().RemoveThreadProfiler( GetCurrentThreadId() );
     }
     
@@ -193,10 +203,12 @@
     {
       if (_active)
       {
+        const CpuProfileClock::time_point endTime = CpuProfileClock::now();
+        ANKI_CPU_HITCH_RECORDER_ENABLED_ONLY( CpuHitchRecorder::AddSample(_sharedData.GetName(), _startTime, endTime) );
+        
         CpuThreadProfiler* profiler = CpuProfiler::GetCurrentThreadProfiler();
         if (profiler)
         {
-          CpuProfileClock::time_point endTime = CpuProfileClock::now();
           profiler->AddSample(_startTime, endTime, _sharedData);
         }
         else
@@ -227,13 +239,6 @@
   } // end namespace Anki
 
 
-  // Macros for creating unique variable names using __LINE__ macro
-  // Needs the multiple levels of indirection so that __LINE__ is expanded to the line number
-  #define ANKI_CPU_UNIQUE_VAR_NAME3(varName, lineNum)   varName ## lineNum
-  #define ANKI_CPU_UNIQUE_VAR_NAME2(varName, lineNum)   ANKI_CPU_UNIQUE_VAR_NAME3(varName, lineNum)
-  #define ANKI_CPU_UNIQUE_VAR_NAME(varName)             ANKI_CPU_UNIQUE_VAR_NAME2(varName, __LINE__)
-
-
   // NOTE: Name must be static, we don't copy them!
   //       If we need dynamic strings we can add a ANKI_CPU_MAKE_DYNAMIC_STRING() function to allow a (semi?)permanent
   //       pool of names to be managed and later psudo-"garbage-collected" (cycle the list so the name lasts for e.g. 2 frames)
@@ -251,14 +256,38 @@
   #define ANKI_CPU_PROFILE_STOP(varName)        \
     varName.Stop()
 
+  // The hitch tick is inside the profiler's, so it doesn't count the profiler's logging
   #define ANKI_CPU_TICK(tickName, maxTickTime_ms, logFreq) \
-    Anki::Util::ScopedCpuTick                     ANKI_CPU_UNIQUE_VAR_NAME(scopedCpuTick)(tickName, maxTickTime_ms, logFreq)
+    Anki::Util::ScopedCpuTick                     ANKI_CPU_UNIQUE_VAR_NAME(scopedCpuTick)(tickName, maxTickTime_ms, logFreq); \
+    ANKI_CPU_HITCH_RECORDER_ENABLED_ONLY( \
+    Anki::Util::ScopedCpuHitchTick                ANKI_CPU_UNIQUE_VAR_NAME(scopedCpuHitchTick)(tickName, maxTickTime_ms) )
 
   #define ANKI_CPU_TICK_ONE_TIME(tickName) \
     Anki::Util::ScopedCpuTick                     ANKI_CPU_UNIQUE_VAR_NAME(scopedCpuTick)(tickName, 0, 0, true)
 
   #define ANKI_CPU_REMOVE_THIS_THREAD()         Anki::Util::CpuProfiler::RemoveCurrentThreadProfiler()
 
+#elif ANKI_CPU_HITCH_RECORDER_ENABLED
+
+
+// Without the profiler, still record for CpuHitchRecorder
+
+#define ANKI_CPU_PROFILE(name) \
+  Anki::Util::ScopedCpuHitchSample ANKI_CPU_UNIQUE_VAR_NAME(scopedCpuHitchSample)(name)
+
+#define ANKI_CPU_PROFILE_START(varName, name) \
+  Anki::Util::ScopedCpuHitchSample varName(name)
+
+#define ANKI_CPU_PROFILE_STOP(varName) \
+  varName.Stop()
+
+#define ANKI_CPU_TICK(tickName, maxTickTime_ms, logFreq) \
+  Anki::Util::ScopedCpuHitchTick   ANKI_CPU_UNIQUE_VAR_NAME(scopedCpuHitchTick)(tickName, maxTickTime_ms)
+
+#define ANKI_CPU_TICK_ONE_TIME(tickName) 
+
+#define ANKI_CPU_REMOVE_THIS_THREAD()         Anki::Util::CpuHitchRecorder::RemoveCurrentThread()
+
 #else  // ANKI_CPU_PROFILER_ENABLED
 
 
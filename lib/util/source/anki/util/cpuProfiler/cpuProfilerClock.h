@@ -19,9 +19,6 @@
 #include <chrono>
 
 
-#if ANKI_CPU_PROFILER_ENABLED
-
-
 namespace Anki {
 namespace Util {
 
@@ -40,7 +37,4 @@ inline double CalcDuration_ms(const CpuProfileClock::time_point& t1, const CpuPr
 } // end namespace Anki
 
 
-#endif // ANKI_CPU_PROFILER_ENABLED
-
-
 #endif // __Util_CpuProfiler_CpuProfilerClock_H__
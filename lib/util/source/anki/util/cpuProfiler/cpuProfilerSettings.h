@@ -33,6 +33,18 @@
 #endif
 
 
+// CpuHitchRecorder is cheap enough to leave on in shipping builds, define as 0 to compile it out
+#ifndef ANKI_CPU_HITCH_RECORDER_ENABLED
+  #define ANKI_CPU_HITCH_RECORDER_ENABLED 1
+#endif
+
+#if ANKI_CPU_HITCH_RECORDER_ENABLED
+  #define ANKI_CPU_HITCH_RECORDER_ENABLED_ONLY(expr)  expr
+#else
+  #define ANKI_CPU_HITCH_RECORDER_ENABLED_ONLY(expr)
+#endif
+
+
 // Max number of threads that can be simultaneously profiled by CpuProfiler
 // Beware raising this too high - we linear search for threadId (so OK for N <= ~16)
 const uint32_t kCpuProfilerMaxThreads = 4;
@@ -0,0 +1,148 @@
+/**
+ * File: task
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Move-only void() callable for queued work. Callables up to kInlineSize
+ * bytes (lambdas capturing a few pointers, a std::function) are stored in the object
+ * itself, so queueing one doesn't allocate.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+#ifndef __Util_DispatchQueue_Task_H__
+#define __Util_DispatchQueue_Task_H__
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Anki
+{
+namespace Util
+{
+
+class Task {
+public:
+  static constexpr size_t kInlineSize = 48;
+
+  Task() = default;
+
+  template <typename F,
+            typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, Task>::value>::type>
+  Task(F&& f)
+  {
+    using Callable = typename std::decay<F>::type;
+    Construct<Callable>(std::forward<F>(f), std::integral_constant<bool, FitsInline<Callable>()>());
+  }
+
+  Task(Task&& other) noexcept
+  {
+    MoveFrom(other);
+  }
+
+  Task& operator=(Task&& other) noexcept
+  {
+    if (this != &other) {
+      Reset();
+      MoveFrom(other);
+    }
+    return *this;
+  }
+
+  Task(const Task&) = delete;
+  Task& operator=(const Task&) = delete;
+
+  ~Task() { Reset(); }
+
+  // May be called more than once (repeating tasks)
+  void operator()() { _ops->invoke(&_storage); }
+
+  explicit operator bool() const { return _ops != nullptr; }
+
+  void Reset()
+  {
+    if (_ops != nullptr) {
+      _ops->destroy(&_storage);
+      _ops = nullptr;
+    }
+  }
+
+private:
+  using Storage = typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type;
+
+  struct Ops {
+    void (*invoke)(void* storage);
+    void (*move)(void* dest, void* src); // leaves src destroyed
+    void (*destroy)(void* storage);
+  };
+
+  template <typename Callable>
+  static constexpr bool FitsInline()
+  {
+    return (sizeof(Callable) <= kInlineSize) &&
+           (alignof(Callable) <= alignof(std::max_align_t)) &&
+           std::is_nothrow_move_constructible<Callable>::value;
+  }
+
+  template <typename Callable>
+  struct InlineOps {
+    static Callable* Get(void* storage) { return static_cast<Callable*>(storage); }
+    static void Invoke(void* storage) { (*Get(storage))(); }
+    static void Move(void* dest, void* src)
+    {
+      new (dest) Callable(std::move(*Get(src)));
+      Get(src)->~Callable();
+    }
+    static void Destroy(void* storage) { Get(storage)->~Callable(); }
+    static constexpr Ops kOps = {&Invoke, &Move, &Destroy};
+  };
+
+  template <typename Callable>
+  struct HeapOps {
+    static Callable*& Get(void* storage) { return *static_cast<Callable**>(storage); }
+    static void Invoke(void* storage) { (*Get(storage))(); }
+    static void Move(void* dest, void* src) { new (dest) Callable*(Get(src)); }
+    static void Destroy(void* storage) { delete Get(storage); }
+    static constexpr Ops kOps = {&Invoke, &Move, &Destroy};
+  };
+
+  template <typename Callable, typename F>
+  void Construct(F&& f, std::true_type /* inline */)
+  {
+    new (&_storage) Callable(std::forward<F>(f));
+    _ops = &InlineOps<Callable>::kOps;
+  }
+
+  template <typename Callable, typename F>
+  void Construct(F&& f, std::false_type /* inline */)
+  {
+    new (&_storage) Callable*(new Callable(std::forward<F>(f)));
+    _ops = &HeapOps<Callable>::kOps;
+  }
+
+  void MoveFrom(Task& other)
+  {
+    if (other._ops != nullptr) {
+      other._ops->move(&_storage, &other._storage);
+      _ops = other._ops;
+      other._ops = nullptr;
+    }
+  }
+
+  const Ops* _ops = nullptr;
+  Storage _storage;
+};
+
+template <typename Callable>
+constexpr Task::Ops Task::InlineOps<Callable>::kOps;
+
+template <typename Callable>
+constexpr Task::Ops Task::HeapOps<Callable>::kOps;
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_DispatchQueue_Task_H__
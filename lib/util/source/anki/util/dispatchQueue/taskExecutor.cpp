@@ -4,8 +4,8 @@
  * Author: seichert
  * Created: 07/15/14
  *
- * Description: Execute arbitrary tasks on
- * a background thread serially.
+ * Description: Execute arbitrary tasks serially,
+ * on threads shared with other executors.
  *
  * Based on original work from Michael Sung on May 30, 2014, 10:10 AM
  *
@@ -13,58 +13,178 @@
  *
  **/
 
+
 #include "util/dispatchQueue/taskExecutor.h"
+#include "util/dispatchQueue/taskPool.h"
+#include "util/dispatchQueue/taskTimer.h"
 #include "util/global/globalDefinitions.h"
 #include "util/logging/logging.h"
-#include "util/threading/threadPriority.h"
 
 #include <condition_variable>
-#include <cstring>
-#include <pthread.h>
+#include <deque>
+#include <mutex>
+#include <unordered_set>
 
 namespace Anki
 {
 namespace Util
 {
 
+namespace {
+
+// How many tasks one pass over a queue runs before giving other queues a turn at the pool
+constexpr const size_t kMaxTasksPerPass = 32;
+
+struct SyncCompletion {
+  std::mutex mutex;
+  std::condition_variable condition;
+  bool done = false;
+
+  void Signal()
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+    condition.notify_one();
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    condition.wait(lock, [this] { return done; });
+  }
+};
+
+} // namespace
+
+struct TaskExecutor::State {
+  struct Entry {
+    Task task;
+    std::string name;
+    bool repeat = false;
+    bool checkPulse = false;
+    std::weak_ptr<void> pulse;
+    SyncCompletion* sync = nullptr;
+  };
+
+  State(const char* name, ThreadPriority threadPriority)
+  : queueName(name != nullptr ? name : "")
+  , pool(TaskPool::GetShared(threadPriority))
+  {
+  }
+
+  const std::string queueName;
+  TaskPool& pool;
+
+  std::mutex mutex;
+  std::condition_variable idleCondition;
+  std::deque<Entry> tasks;
+  std::unordered_set<TaskTimer::TimerId> timers;
+  bool executing = true;
+  // A pass over tasks has been handed to the pool, or is running on drainThread
+  bool scheduled = false;
+  std::thread::id drainThread;
+
+  static void Enqueue(const std::shared_ptr<State>& state, Entry entry);
+  static void Drain(const std::shared_ptr<State>& state);
+};
+
+void TaskExecutor::State::Enqueue(const std::shared_ptr<State>& state, Entry entry)
+{
+  bool accepted = false;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (state->executing) {
+      state->tasks.push_back(std::move(entry));
+      accepted = true;
+      if (state->scheduled) {
+        return;
+      }
+      state->scheduled = true;
+    }
+  }
+
+  if (!accepted) {
+    // Never going to run, don't leave a WakeSync caller waiting for it
+    entry.task.Reset();
+    if (entry.sync != nullptr) {
+      entry.sync->Signal();
+    }
+    return;
+  }
+
+  state->pool.Submit([state] {
+    Drain(state);
+  });
+}
+
+void TaskExecutor::State::Drain(const std::shared_ptr<State>& state)
+{
+  std::unique_lock<std::mutex> lock(state->mutex);
+  for (size_t numRun = 0; state->executing && !state->tasks.empty() && numRun < kMaxTasksPerPass; ++numRun) {
+    Entry entry = std::move(state->tasks.front());
+    state->tasks.pop_front();
+    state->drainThread = std::this_thread::get_id();
+    lock.unlock();
+
+    #if ANKI_DEVELOPER_CODE
+    const bool printDebug = !entry.name.empty() && !entry.repeat;
+    if (printDebug) {
+      PRINT_NAMED_DEBUG("TaskExecutor.StartTask", "q:%s, task:%s", state->queueName.c_str(), entry.name.c_str());
+    }
+    #endif
+
+    const bool taskExpired = (entry.checkPulse && entry.pulse.expired());
+
+    // execute the task
+    if (!taskExpired) {
+      entry.task();
+    }
+
+    #if ANKI_DEVELOPER_CODE
+    if (printDebug) {
+      PRINT_NAMED_DEBUG("TaskExecutor.EndTask", "q:%s, task:%s", state->queueName.c_str(), entry.name.c_str());
+    }
+    #endif
+
+    entry.task.Reset();
+    if (entry.sync != nullptr) {
+      entry.sync->Signal();
+    }
+
+    lock.lock();
+    state->drainThread = std::thread::id();
+    state->idleCondition.notify_all();
+  }
+
+  // Go to the back of the pool's line if there's more to do
+  const bool more = state->executing && !state->tasks.empty();
+  state->scheduled = more;
+  lock.unlock();
+  if (more) {
+    state->pool.Submit([state] {
+      Drain(state);
+    });
+  }
+}
+
 class TaskExecutorHandle : public TaskHandleContainer::ITaskHandle
 {
 public:
-  TaskExecutorHandle(int taskId, TaskExecutor* taskExecutor);
+  TaskExecutorHandle(uint64_t taskId, TaskExecutor* taskExecutor);
   virtual ~TaskExecutorHandle() {}
   virtual void Invalidate() override;
-  TaskHolder::HandlePulse GetPulse();
+  std::weak_ptr<void> GetPulse();
 private:
-  int _taskId;
+  uint64_t _taskId;
   TaskExecutor* _executor;
   std::weak_ptr<void> _queuePulse;
   std::shared_ptr<void> _handleHeartbeat;
 };
 
 TaskExecutor::TaskExecutor(const char* name, ThreadPriority threadPriority)
-: _heartbeat( (void*)0x12345678, [] (void*) {} )
-, _executing(true)
-, _queueName(name != nullptr ? name : "")
-, _idCounter(0)
-, _cachedDeferredSize(0)
+: _state(std::make_shared<State>(name, threadPriority))
+, _heartbeat( (void*)0x12345678, [] (void*) {} )
 {
-  std::string baseThreadName = _queueName;
-  if (baseThreadName.empty()) {
-    baseThreadName = "taskQueue";
-  }
-
-  // pthread names restricted to 16 characters, including null terminator
-  std::string executeThreadName = baseThreadName.substr(0, 15);
-  std::string deferredThreadName = baseThreadName.substr(0, 11) + "_def";
-
-  _taskExecuteThread = std::thread(&TaskExecutor::Execute, this, std::move(executeThreadName));
-  _taskDeferredThread = std::thread(&TaskExecutor::ProcessDeferredQueue, this, std::move(deferredThreadName));
-  
-  if (threadPriority != ThreadPriority::Default)
-  {
-    SetThreadPriority(_taskExecuteThread, threadPriority);
-    SetThreadPriority(_taskDeferredThread, threadPriority);
-  }
 }
 
 TaskExecutor::~TaskExecutor()
@@ -74,235 +194,154 @@ TaskExecutor::~TaskExecutor()
 
 void TaskExecutor::StopExecution()
 {
-  // Cause Execute and ProcessDeferredQueue to break out of their while loops
-  _executing = false;
-
-  // Clear the _taskQueue.  Use a scope so that the mutex is only locked
-  // while clearing the queue and notifying the background thread.
+  std::deque<State::Entry> tasks;
+  std::unordered_set<TaskTimer::TimerId> timers;
   {
-    std::lock_guard<std::mutex> lock(_taskQueueMutex);
-    _taskQueue.clear();
-    _taskQueueCondition.notify_one();
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    _state->executing = false;
+    std::swap(tasks, _state->tasks);
+    std::swap(timers, _state->timers);
   }
 
-  // Clear the _deferredTaskQueue and also use a scope.
-  {
-    std::lock_guard<std::mutex> lock(_taskDeferredQueueMutex);
-    _deferredTaskQueue.clear();
-    _taskDeferredCondition.notify_one();
+  for (const auto timerId : timers) {
+    TaskTimer::GetShared().Cancel(timerId);
   }
 
-  // Join the background threads.  We created the threads in the constructor, so they
-  // should be cleaned up in our destructor.
-  try {
-    if (_taskExecuteThread.joinable()) {
-      _taskExecuteThread.join();
-    }
-    if (_taskDeferredThread.joinable()) {
-      _taskDeferredThread.join();
+  for (auto& entry : tasks) {
+    entry.task.Reset();
+    if (entry.sync != nullptr) {
+      entry.sync->Signal();
     }
-  } catch ( ... )
-  {
-    // Suppress exceptions
+  }
+
+  // Wait for the task that's running to finish, as joining the thread used to. Unless it's the one stopping us.
+  std::unique_lock<std::mutex> lock(_state->mutex);
+  if (_state->drainThread != std::this_thread::get_id()) {
+    _state->idleCondition.wait(lock, [this] {
+      return _state->drainThread == std::thread::id();
+    });
   }
 }
 
-void TaskExecutor::Wake(std::function<void()> task, const char* name)
+void TaskExecutor::Wake(Task task, const char* name)
 {
-  WakeAfter(std::move(task), std::chrono::time_point<std::chrono::steady_clock>::min(), name);
+  State::Entry entry;
+  entry.task = std::move(task);
+  entry.name = name != nullptr ? name : "";
+  State::Enqueue(_state, std::move(entry));
 }
 
-void TaskExecutor::WakeSync(std::function<void()> task, const char* name)
+void TaskExecutor::WakeSync(Task task, const char* name)
 {
-  if (std::this_thread::get_id() == _taskExecuteThread.get_id()) {
-    task();
-    return;
+  {
+    std::unique_lock<std::mutex> lock(_state->mutex);
+    if (_state->drainThread == std::this_thread::get_id()) {
+      lock.unlock();
+      task();
+      return;
+    }
   }
-  std::lock_guard<std::mutex> lock(_addSyncTaskMutex);
 
-  TaskHolder taskHolder;
-  taskHolder.sync = true;
-  taskHolder.repeat = false;
-  taskHolder.checkPulse = false;
-  taskHolder.task = std::move(task);
-  taskHolder.when = std::chrono::time_point<std::chrono::steady_clock>::min();
-  taskHolder.name = name != nullptr ? name : "";
-  taskHolder.id = _idCounter++;
-  _syncTaskDone = false;
-
-  AddTaskHolder(std::move(taskHolder));
-
-  std::unique_lock<std::mutex> lk(_syncTaskCompleteMutex);
-  _syncTaskCondition.wait(lk, [this]{return _syncTaskDone;});
+  SyncCompletion completion;
+  State::Entry entry;
+  entry.task = std::move(task);
+  entry.name = name != nullptr ? name : "";
+  entry.sync = &completion;
+  State::Enqueue(_state, std::move(entry));
 
+  completion.Wait();
 }
 
-void TaskExecutor::WakeAfter(std::function<void()> task, std::chrono::time_point<std::chrono::steady_clock> when, const char* name)
+void TaskExecutor::WakeAfter(Task task, std::chrono::time_point<std::chrono::steady_clock> when, const char* name)
 {
-  TaskHolder taskHolder;
-  taskHolder.sync = false;
-  taskHolder.repeat = false;
-  taskHolder.checkPulse = false;
-  taskHolder.task = std::move(task);
-  taskHolder.when = when;
-  taskHolder.name = name != nullptr ? name : "";
-  taskHolder.id = _idCounter++;
+  State::Entry entry;
+  entry.task = std::move(task);
+  entry.name = name != nullptr ? name : "";
 
   auto now = std::chrono::steady_clock::now();
   if (now >= when) {
-    AddTaskHolder(std::move(taskHolder));
-  } else {
-    AddTaskHolderToDeferredQueue(std::move(taskHolder));
+    State::Enqueue(_state, std::move(entry));
+    return;
   }
-}
-
-TaskHandle TaskExecutor::WakeAfterRepeat(std::function<void()> task, std::chrono::milliseconds period, const char* name)
-{
-  TaskHolder taskHolder;
-  taskHolder.sync = false;
-  taskHolder.repeat = true;
-  taskHolder.task = std::move(task);
-  taskHolder.period = period;
-  taskHolder.name = name != nullptr ? name : "";
-  taskHolder.id = _idCounter++;
-
-  auto now = std::chrono::steady_clock::now();
-  taskHolder.when = now + period;
-
-  // set up pulse from task holder to the handle so that this task
-  // won't execute if the handle is invalidated
-  TaskExecutorHandle* handle = new TaskExecutorHandle(taskHolder.id, this);
-  taskHolder.pulse = handle->GetPulse();
-  taskHolder.checkPulse = true;
-
-  AddTaskHolderToDeferredQueue(std::move(taskHolder));
-
-  return TaskHandle(new TaskHandleContainer(*(handle)));
-}
-
-void TaskExecutor::AddTaskHolder(TaskHolder taskHolder)
-{
-  std::lock_guard<std::mutex> lock(_taskQueueMutex);
-  _taskQueue.push_back(std::move(taskHolder));
-  _taskQueueCondition.notify_one();
-}
-
-void TaskExecutor::AddTaskHolderToDeferredQueue(TaskHolder taskHolder)
-{
-  std::lock_guard<std::mutex> lock(_taskDeferredQueueMutex);
-  _deferredTaskQueue.push_back(std::move(taskHolder));
-  // Sort the tasks so that the next one due is at the back of the queue
-  std::sort(_deferredTaskQueue.begin(), _deferredTaskQueue.end());
-  _taskDeferredCondition.notify_one();
-}
-
-
 
-void TaskExecutor::Wait(std::unique_lock<std::mutex> &lock,
-                        std::condition_variable &condition,
-                        const std::vector<TaskHolder>* tasks) const
-{
-  condition.wait(lock, [this, tasks] {
-      return tasks->size() > 0 || !_executing;
-  });
-}
+  TaskTimer& timer = TaskTimer::GetShared();
+  const TaskTimer::TimerId timerId = timer.CreateTimerId();
+  std::weak_ptr<State> weakState = _state;
 
-void TaskExecutor::Execute(std::string threadName)
-{
-  Anki::Util::SetThreadName(pthread_self(), threadName.c_str());
-  while (_executing) {
-    std::unique_lock<std::mutex> lock(_taskQueueMutex);
-    Wait(lock, _taskQueueCondition, &_taskQueue);
-    Run(lock);
+  // Hold the lock while scheduling, so the timer can't fire before it's been recorded
+  std::lock_guard<std::mutex> lock(_state->mutex);
+  if (!_state->executing) {
+    return;
   }
-}
-
-void TaskExecutor::ProcessDeferredQueue(std::string threadName)
-{
-  Anki::Util::SetThreadName(pthread_self(), threadName.c_str());
-  auto abs_time = std::chrono::time_point<std::chrono::steady_clock>::max();
-  while (_executing) {
-    std::unique_lock<std::mutex> lock(_taskDeferredQueueMutex);
-    _taskDeferredCondition.wait_until(lock, abs_time, [this] {
-        return (_deferredTaskQueue.size() > _cachedDeferredSize) || !_executing;
-      });
-
-    bool endLoop = false;
-    while (_executing && !_deferredTaskQueue.empty() && !endLoop) {
-      auto now = std::chrono::steady_clock::now();
-      auto& taskHolderRef = _deferredTaskQueue.back();
-      if (now >= taskHolderRef.when) {
-        AddTaskHolder(taskHolderRef);
-        auto taskHolder = std::move(taskHolderRef);
-        _deferredTaskQueue.pop_back();
-        if (taskHolder.repeat) {
-          lock.unlock();
-          taskHolder.when = now + taskHolder.period;
-          AddTaskHolderToDeferredQueue(std::move(taskHolder));
-          lock.lock();
-        }
-      } else {
-        endLoop = true;
-        abs_time = std::max(taskHolderRef.when, std::chrono::steady_clock::now());
-      }
+  _state->timers.insert(timerId);
+  timer.Schedule(timerId, [weakState, timerId, entry = std::move(entry)] () mutable {
+    const auto state = weakState.lock();
+    if (!state) {
+      return;
     }
-    if (_deferredTaskQueue.empty()) {
-      abs_time = std::chrono::time_point<std::chrono::steady_clock>::max();
+    {
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (state->timers.erase(timerId) == 0) {
+        return;
+      }
     }
-    _cachedDeferredSize = _deferredTaskQueue.size();
-  }
+    State::Enqueue(state, std::move(entry));
+  }, when);
 }
 
-void TaskExecutor::Run(std::unique_lock<std::mutex> &lock)
+TaskHandle TaskExecutor::WakeAfterRepeat(Task task, std::chrono::milliseconds period, const char* name)
 {
-  // copy
-  std::vector<TaskHolder> taskQueue = std::move(_taskQueue);
-  _taskQueue.clear();
-  // we only need the lock when we're reading from _taskQueue
-  lock.unlock();
-  for (auto const& taskHolder : taskQueue) {
-  
-    #if ANKI_DEVELOPER_CODE
-    const bool printDebug = !taskHolder.name.empty() && !taskHolder.repeat;
-    if (printDebug) {
-      PRINT_NAMED_DEBUG("TaskExecutor.StartTask", "q:%s, task:%s", _queueName.c_str(), taskHolder.name.c_str());
-    }
-    #endif
+  TaskTimer& timer = TaskTimer::GetShared();
+  const TaskTimer::TimerId timerId = timer.CreateTimerId();
 
-    const bool taskExpired = (taskHolder.checkPulse && taskHolder.pulse.expired());
+  // set up pulse from task holder to the handle so that this task
+  // won't execute if the handle is invalidated
+  TaskExecutorHandle* handle = new TaskExecutorHandle(timerId, this);
+  std::weak_ptr<void> pulse = handle->GetPulse();
 
-    // execute the task
-    if (!taskExpired) {
-      taskHolder.task();
-    }
+  // Each time it's due, the task is queued like any other, so it's shared by the queued copies
+  std::shared_ptr<Task> repeatedTask = std::make_shared<Task>(std::move(task));
+  std::weak_ptr<State> weakState = _state;
+  std::string taskName = name != nullptr ? name : "";
 
-    #if ANKI_DEVELOPER_CODE
-    if (printDebug) {
-      PRINT_NAMED_DEBUG("TaskExecutor.EndTask", "q:%s, task:%s", _queueName.c_str(), taskHolder.name.c_str());
-    }
-    #endif
-    if (taskHolder.sync) {
-      std::lock_guard<std::mutex> lk(_syncTaskCompleteMutex);
-      _syncTaskDone = true;
-      _syncTaskCondition.notify_one();
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (_state->executing) {
+      _state->timers.insert(timerId);
+      timer.Schedule(timerId, [weakState, repeatedTask, pulse, taskName] {
+        const auto state = weakState.lock();
+        if (!state) {
+          return;
+        }
+        State::Entry entry;
+        entry.task = [repeatedTask] {
+          (*repeatedTask)();
+        };
+        entry.name = taskName;
+        entry.repeat = true;
+        entry.checkPulse = true;
+        entry.pulse = pulse;
+        State::Enqueue(state, std::move(entry));
+      }, std::chrono::steady_clock::now() + period, period);
     }
   }
+
+  return TaskHandle(new TaskHandleContainer(*(handle)));
 }
 
-void TaskExecutor::RemoveTaskFromDeferredQueue(int taskId)
+void TaskExecutor::RemoveTaskFromDeferredQueue(uint64_t taskId)
 {
-  std::lock_guard<std::mutex> lock(_taskDeferredQueueMutex);
-  for (auto it = _deferredTaskQueue.begin(); it != _deferredTaskQueue.end(); ++it) {
-    if ((*it).id == taskId) {
-      _deferredTaskQueue.erase(it);
-      _cachedDeferredSize = _deferredTaskQueue.size();
-      break;
+  {
+    std::lock_guard<std::mutex> lock(_state->mutex);
+    if (_state->timers.erase(taskId) == 0) {
+      return;
     }
   }
+  TaskTimer::GetShared().Cancel(taskId);
 }
 
 
-TaskExecutorHandle::TaskExecutorHandle(int taskId, TaskExecutor* taskExecutor)
+TaskExecutorHandle::TaskExecutorHandle(uint64_t taskId, TaskExecutor* taskExecutor)
   : _taskId(taskId)
   , _executor(taskExecutor)
   , _queuePulse(taskExecutor->_heartbeat)
@@ -318,10 +357,10 @@ void TaskExecutorHandle::Invalidate()
   }
 }
 
-TaskHolder::HandlePulse TaskExecutorHandle::GetPulse()
+std::weak_ptr<void> TaskExecutorHandle::GetPulse()
 {
-  return TaskHolder::HandlePulse(_handleHeartbeat);
+  return std::weak_ptr<void>(_handleHeartbeat);
 }
 
-} // namespace Das
+} // namespace Util
 } // namespace Anki
@@ -4,8 +4,8 @@
  * Author: seichert
  * Created: 07/15/14
  *
- * Description: Execute arbitrary tasks on
- * a background thread serially.
+ * Description: Execute arbitrary tasks serially,
+ * on threads shared with other executors.
  *
  * Based on original work from Michael Sung on May 30, 2014, 10:10 AM
  *
@@ -16,9 +16,11 @@
 #define	__TaskExecutor_H__
 
 #include "util/dispatchQueue/iTaskHandle.h"
+#include "util/dispatchQueue/task.h"
 #include "util/threading/threadPriority.h"
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
 #include <thread>
@@ -29,68 +31,30 @@ namespace Anki
 namespace Util
 {
 
-typedef struct _TaskHolder {
-
-  using HandlePulse = std::weak_ptr<void>;
-
-  bool sync;
-  bool repeat;
-  std::function<void()> task;
-  bool checkPulse;
-  HandlePulse pulse;
-  std::chrono::time_point<std::chrono::steady_clock> when;
-  std::chrono::milliseconds period;
-  std::string name;
-  int id;
-
-
-  bool operator < (const _TaskHolder& th) const
-  {
-    return (when > th.when);
-  }
-} TaskHolder;
-
+// Tasks run in the order they were added, one at a time, on whichever thread of the shared TaskPool for
+// threadPriority picks them up. Deferred and repeating tasks wait on the shared TaskTimer.
 class TaskExecutor {
 public:
   explicit TaskExecutor(const char* name = nullptr, ThreadPriority threadPriority=ThreadPriority::Default);
   virtual ~TaskExecutor();
+  // Drops tasks that haven't run yet and waits for the one that's running, if any
   void StopExecution();
-  void Wake(std::function<void()> task, const char* name);
-  void WakeSync(std::function<void()> task, const char* name);
-  void WakeAfter(std::function<void()> task, std::chrono::time_point<std::chrono::steady_clock> when, const char* name);
-  TaskHandle WakeAfterRepeat(std::function<void()> task, std::chrono::milliseconds period, const char* name);
+  void Wake(Task task, const char* name);
+  void WakeSync(Task task, const char* name);
+  void WakeAfter(Task task, std::chrono::time_point<std::chrono::steady_clock> when, const char* name);
+  TaskHandle WakeAfterRepeat(Task task, std::chrono::milliseconds period, const char* name);
 protected:
   TaskExecutor(const TaskExecutor&) = delete;
   TaskExecutor& operator=(const TaskExecutor&) = delete;
-  virtual void Wait(std::unique_lock<std::mutex> &lock,
-                    std::condition_variable &condition,
-                    const std::vector<TaskHolder>* tasks) const;
 private:
-  void AddTaskHolder(TaskHolder taskHolder);
-  void AddTaskHolderToDeferredQueue(TaskHolder taskHolder);
-  void RemoveTaskFromDeferredQueue(int taskId);
-  void Execute(std::string threadName);
-  void ProcessDeferredQueue(std::string threadName);
-  void Run(std::unique_lock<std::mutex> &lock);
+  struct State;
+
+  void RemoveTaskFromDeferredQueue(uint64_t taskId);
 
 private:
-  std::thread _taskExecuteThread;
-  std::mutex _taskQueueMutex;
-  std::condition_variable _taskQueueCondition;
-  std::vector<TaskHolder> _taskQueue;
-  std::thread _taskDeferredThread;
-  std::mutex _taskDeferredQueueMutex;
-  std::condition_variable _taskDeferredCondition;
-  std::vector<TaskHolder> _deferredTaskQueue;
-  std::mutex _addSyncTaskMutex;
-  std::mutex _syncTaskCompleteMutex;
-  std::condition_variable _syncTaskCondition;
+  // Shared with the pool and the timer, which may still hold on to it for a moment after this is destroyed
+  std::shared_ptr<State> _state;
   std::shared_ptr<void> _heartbeat;
-  bool _syncTaskDone;
-  std::atomic<bool> _executing;
-  const std::string _queueName;
-  std::atomic_int _idCounter;
-  size_t _cachedDeferredSize;
 
   friend class TaskExecutorHandle;
 };
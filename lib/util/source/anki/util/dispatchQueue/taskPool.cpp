@@ -0,0 +1,175 @@
+/**
+ * File: taskPool
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Work-stealing pool of threads shared by every TaskExecutor
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "util/dispatchQueue/taskPool.h"
+
+#include <algorithm>
+#include <pthread.h>
+
+namespace Anki
+{
+namespace Util
+{
+
+namespace {
+
+// Worker running on this thread, if it's one of a pool's
+thread_local TaskPool* sCurrentPool = nullptr;
+thread_local size_t sCurrentWorker = 0;
+
+constexpr const size_t kNumThreadPriorities = (size_t) ThreadPriority::Max + 1;
+constexpr const char* kPoolNames[kNumThreadPriorities] = {"poolMin", "poolLow", "pool", "poolHigh", "poolMax"};
+
+// Enough to keep every core busy while a few workers are blocked on I/O
+size_t GetMaxNumSharedWorkers()
+{
+  return std::max<size_t>(4, 2 * std::thread::hardware_concurrency());
+}
+
+} // namespace
+
+TaskPool& TaskPool::GetShared(ThreadPriority threadPriority)
+{
+  static std::once_flag sOnce[kNumThreadPriorities];
+  static TaskPool* sPools[kNumThreadPriorities] = {};
+
+  const size_t index = (size_t) threadPriority;
+  std::call_once(sOnce[index], [index, threadPriority] {
+    sPools[index] = new TaskPool(kPoolNames[index], threadPriority, GetMaxNumSharedWorkers());
+  });
+  return *sPools[index];
+}
+
+TaskPool::TaskPool(const char* name, ThreadPriority threadPriority, size_t maxNumWorkers)
+: _name(name)
+, _threadPriority(threadPriority)
+{
+  _workers.reserve(maxNumWorkers);
+  for (size_t i = 0; i < std::max<size_t>(maxNumWorkers, 1); ++i) {
+    _workers.emplace_back(new Worker);
+  }
+}
+
+TaskPool::~TaskPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(_idleMutex);
+    _stopping = true;
+    _idleCondition.notify_all();
+  }
+
+  std::lock_guard<std::mutex> lock(_startMutex);
+  for (size_t i = 0; i < _numWorkers; ++i) {
+    if (_workers[i]->thread.joinable()) {
+      _workers[i]->thread.join();
+    }
+  }
+}
+
+void TaskPool::Submit(Task task)
+{
+  if (_numWorkers == 0) {
+    StartWorker();
+  }
+
+  const size_t index = (sCurrentPool == this) ? sCurrentWorker : (_nextWorker++ % _numWorkers);
+  {
+    Worker& worker = *_workers[index];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    worker.tasks.push_back(std::move(task));
+    ++_numPending;
+  }
+
+  bool startWorker = false;
+  {
+    std::lock_guard<std::mutex> lock(_idleMutex);
+    if (_numIdle > 0) {
+      _idleCondition.notify_one();
+    } else {
+      startWorker = (_numWorkers < _workers.size());
+    }
+  }
+  if (startWorker) {
+    StartWorker();
+  }
+}
+
+void TaskPool::StartWorker()
+{
+  std::lock_guard<std::mutex> lock(_startMutex);
+  const size_t index = _numWorkers;
+  if (index >= _workers.size()) {
+    return;
+  }
+
+  Worker& worker = *_workers[index];
+  worker.thread = std::thread(&TaskPool::WorkerLoop, this, index);
+  if (_threadPriority != ThreadPriority::Default) {
+    SetThreadPriority(worker.thread, _threadPriority);
+  }
+  _numWorkers = index + 1;
+}
+
+bool TaskPool::PopTask(size_t index, Task& task)
+{
+  // Own tasks in order first, then the newest of someone else's
+  const size_t numWorkers = _numWorkers;
+  for (size_t i = 0; i < numWorkers; ++i) {
+    Worker& worker = *_workers[(index + i) % numWorkers];
+    std::lock_guard<std::mutex> lock(worker.mutex);
+    if (!worker.tasks.empty()) {
+      if (i == 0) {
+        task = std::move(worker.tasks.front());
+        worker.tasks.pop_front();
+      } else {
+        task = std::move(worker.tasks.back());
+        worker.tasks.pop_back();
+      }
+      --_numPending;
+      return true;
+    }
+  }
+  return false;
+}
+
+void TaskPool::WorkerLoop(size_t index)
+{
+  sCurrentPool = this;
+  sCurrentWorker = index;
+  SetThreadName(pthread_self(), _name + std::to_string(index));
+
+  while (true) {
+    {
+      Task task;
+      if (PopTask(index, task)) {
+        task();
+        continue;
+      }
+    }
+
+    std::unique_lock<std::mutex> lock(_idleMutex);
+    if (_stopping) {
+      break;
+    }
+    ++_numIdle;
+    _idleCondition.wait(lock, [this] {
+      return (_numPending > 0) || _stopping;
+    });
+    --_numIdle;
+    if (_stopping) {
+      break;
+    }
+  }
+}
+
+} // namespace Util
+} // namespace Anki
@@ -0,0 +1,81 @@
+/**
+ * File: taskPool
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Work-stealing pool of threads shared by every TaskExecutor (and so every
+ * Dispatch::Queue) in the process. Each worker has its own deque; tasks submitted from a
+ * worker go on that worker's deque, others are spread across them, and idle workers
+ * steal from the rest. Threads are started as needed, up to a limit, when no worker is
+ * idle, so a task that blocks for a while only takes one of them out.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+#ifndef __Util_DispatchQueue_TaskPool_H__
+#define __Util_DispatchQueue_TaskPool_H__
+
+#include "util/dispatchQueue/task.h"
+#include "util/helpers/noncopyable.h"
+#include "util/threading/threadPriority.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Anki
+{
+namespace Util
+{
+
+class TaskPool : private noncopyable {
+public:
+  // Pool shared by everything that runs at threadPriority. Created on first use and never destroyed, so executors
+  // that are static objects can still use it while the process exits.
+  static TaskPool& GetShared(ThreadPriority threadPriority = ThreadPriority::Default);
+
+  TaskPool(const char* name, ThreadPriority threadPriority, size_t maxNumWorkers);
+  ~TaskPool();
+
+  void Submit(Task task);
+
+  size_t GetNumWorkers() const { return _numWorkers; }
+
+private:
+  struct Worker {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+    std::thread thread;
+  };
+
+  const std::string _name;
+  const ThreadPriority _threadPriority;
+
+  // Sized up front so stealing can walk it without a lock; threads are started in order as they're needed
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::atomic<size_t> _numWorkers{0};
+  std::mutex _startMutex;
+
+  std::atomic<size_t> _nextWorker{0};
+  std::atomic<int> _numPending{0};
+
+  std::mutex _idleMutex;
+  std::condition_variable _idleCondition;
+  size_t _numIdle = 0;
+  bool _stopping = false;
+
+  void StartWorker();
+  void WorkerLoop(size_t index);
+  bool PopTask(size_t index, Task& task);
+};
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_DispatchQueue_TaskPool_H__
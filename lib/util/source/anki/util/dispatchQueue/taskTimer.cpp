@@ -0,0 +1,172 @@
+/**
+ * File: taskTimer
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Timer wheel shared by every TaskExecutor
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "util/dispatchQueue/taskTimer.h"
+#include "util/threading/threadPriority.h"
+
+#include <algorithm>
+#include <pthread.h>
+
+namespace Anki
+{
+namespace Util
+{
+
+constexpr std::chrono::milliseconds TaskTimer::kTickDuration;
+constexpr size_t TaskTimer::kNumSlots;
+
+TaskTimer& TaskTimer::GetShared()
+{
+  static TaskTimer* sTimer = new TaskTimer();
+  return *sTimer;
+}
+
+TaskTimer::TaskTimer()
+: _startTime(Clock::now())
+, _slots(kNumSlots)
+{
+  _thread = std::thread(&TaskTimer::ThreadLoop, this);
+}
+
+TaskTimer::~TaskTimer()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+    _condition.notify_one();
+  }
+  if (_thread.joinable()) {
+    _thread.join();
+  }
+}
+
+uint64_t TaskTimer::GetTick(Clock::time_point when) const
+{
+  // Round up, and never schedule into a tick that's already been processed
+  const auto sinceStart = std::max(when - _startTime, Clock::duration::zero());
+  const auto tickDuration = std::chrono::duration_cast<Clock::duration>(kTickDuration);
+  const uint64_t tick = (uint64_t) ((sinceStart + tickDuration - Clock::duration(1)) / tickDuration);
+  return std::max(tick, _processedTick + 1);
+}
+
+void TaskTimer::AddTimer(Timer timer)
+{
+  _timerTicks[timer.id] = timer.tick;
+  if (timer.tick < _wakeTick) {
+    _condition.notify_one();
+  }
+  _slots[timer.tick % kNumSlots].push_back(std::move(timer));
+}
+
+void TaskTimer::Schedule(TimerId timerId, Task callback, Clock::time_point when, std::chrono::milliseconds period)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  AddTimer(Timer{timerId, GetTick(when), period, std::move(callback)});
+}
+
+void TaskTimer::Cancel(TimerId timerId)
+{
+  Task callback;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (timerId == _firingTimerId) {
+      _firingTimerCancelled = true;
+      return;
+    }
+
+    const auto it = _timerTicks.find(timerId);
+    if (it == _timerTicks.end()) {
+      return;
+    }
+    auto& slot = _slots[it->second % kNumSlots];
+    _timerTicks.erase(it);
+    for (auto& timer : slot) {
+      if (timer.id == timerId) {
+        callback = std::move(timer.callback);
+        timer = std::move(slot.back());
+        slot.pop_back();
+        break;
+      }
+    }
+  }
+  // (callback is destroyed here, without the lock)
+}
+
+void TaskTimer::ThreadLoop()
+{
+  SetThreadName(pthread_self(), "taskTimer");
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  while (!_stopping) {
+    const auto tickDuration = std::chrono::duration_cast<Clock::duration>(kTickDuration);
+    const uint64_t nowTick = (uint64_t) ((Clock::now() - _startTime) / tickDuration);
+
+    // Fire everything due in the slots since the last pass. If we're more than a turn of the wheel behind (e.g. the
+    // system was suspended), every slot gets one look.
+    if (nowTick > _processedTick + kNumSlots) {
+      _processedTick = nowTick - kNumSlots;
+    }
+    while (_processedTick < nowTick) {
+      // Timers scheduled by a callback land after this tick, so they're still seen in this pass if they're due
+      ++_processedTick;
+      auto& slot = _slots[_processedTick % kNumSlots];
+      for (size_t index = 0; index < slot.size(); ) {
+        if (slot[index].tick > nowTick) {
+          ++index;
+          continue;
+        }
+
+        Timer timer = std::move(slot[index]);
+        if (index + 1 < slot.size()) {
+          slot[index] = std::move(slot.back());
+        }
+        slot.pop_back();
+
+        _firingTimerId = timer.id;
+        _firingTimerCancelled = false;
+        lock.unlock();
+        timer.callback();
+        lock.lock();
+        _firingTimerId = 0;
+
+        if ((timer.period.count() > 0) && !_firingTimerCancelled && !_stopping) {
+          timer.tick = GetTick(Clock::now() + timer.period);
+          AddTimer(std::move(timer));
+        } else {
+          _timerTicks.erase(timer.id);
+          lock.unlock();
+          timer.callback.Reset();
+          lock.lock();
+        }
+      }
+    }
+
+    // Sleep until the next slot with something in it. A timer in it may be a turn or more away, in which case this
+    // wakes up for nothing once a turn.
+    _wakeTick = UINT64_MAX;
+    for (uint64_t i = 1; i <= kNumSlots; ++i) {
+      if (!_slots[(_processedTick + i) % kNumSlots].empty()) {
+        _wakeTick = _processedTick + i;
+        break;
+      }
+    }
+
+    if (_wakeTick == UINT64_MAX) {
+      _condition.wait(lock);
+    } else {
+      _condition.wait_until(lock, _startTime + tickDuration * _wakeTick);
+    }
+  }
+}
+
+} // namespace Util
+} // namespace Anki
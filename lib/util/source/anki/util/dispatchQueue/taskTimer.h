@@ -0,0 +1,91 @@
+/**
+ * File: taskTimer
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Timer wheel that runs callbacks at a given time, optionally repeating, from
+ * one thread shared by every TaskExecutor. Scheduling and cancelling a timer only touch
+ * its slot, and the thread sleeps until the next slot that has a timer in it.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+#ifndef __Util_DispatchQueue_TaskTimer_H__
+#define __Util_DispatchQueue_TaskTimer_H__
+
+#include "util/dispatchQueue/task.h"
+#include "util/helpers/noncopyable.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace Anki
+{
+namespace Util
+{
+
+class TaskTimer : private noncopyable {
+public:
+  using Clock = std::chrono::steady_clock;
+  using TimerId = uint64_t;
+
+  // Timers fire on the first tick at or after the time they were scheduled for
+  static constexpr std::chrono::milliseconds kTickDuration{2};
+  static constexpr size_t kNumSlots = 1024;
+
+  // Created on first use and never destroyed, like TaskPool::GetShared
+  static TaskTimer& GetShared();
+
+  TaskTimer();
+  ~TaskTimer();
+
+  TimerId CreateTimerId() { return _nextTimerId++; }
+
+  // Calls callback on the timer thread at when, then every period after it returns if period isn't zero. Callbacks
+  // run with no lock held, but hold up every other timer, so they should only hand work off.
+  void Schedule(TimerId timerId, Task callback, Clock::time_point when,
+                std::chrono::milliseconds period = std::chrono::milliseconds(0));
+
+  // The callback isn't called after this returns, unless it's being called right now
+  void Cancel(TimerId timerId);
+
+private:
+  struct Timer {
+    TimerId id;
+    uint64_t tick;
+    std::chrono::milliseconds period;
+    Task callback;
+  };
+
+  const Clock::time_point _startTime;
+  std::atomic<TimerId> _nextTimerId{1};
+
+  std::mutex _mutex;
+  std::condition_variable _condition;
+  std::vector<std::vector<Timer>> _slots;
+  std::unordered_map<TimerId, uint64_t> _timerTicks;
+  uint64_t _processedTick = 0;
+  uint64_t _wakeTick = UINT64_MAX;
+  TimerId _firingTimerId = 0;
+  bool _firingTimerCancelled = false;
+  bool _stopping = false;
+  std::thread _thread;
+
+  // Must hold _mutex
+  uint64_t GetTick(Clock::time_point when) const;
+  void AddTimer(Timer timer);
+
+  void ThreadLoop();
+};
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_DispatchQueue_TaskTimer_H__
@@ -23,6 +23,9 @@
 * }
 * myWorker.Process();
 *
+* Jobs are handed out to the threads one at a time, in the order they were pushed, so pushing the most
+* important jobs first gets them done first.
+*
 *
 * Copyright: Anki, inc. 2016
 *
@@ -31,6 +34,7 @@
 #define __Util_DispatchWorker_DispatchWorker_H_
 
 #include <array>
+#include <atomic>
 #include <functional>
 #include <mutex>
 #include <thread>
@@ -64,9 +68,10 @@ private:
   FunctionType                                    _function;
   ArgumentVector                                  _argumentList;
   std::mutex                                      _argsListMutex;
+  std::atomic<std::size_t>                        _nextJobIdx{0};
   
-  // Use the provided function to process the arguments specified by the input iterators
-  void DoThreadWork(typename ArgumentVector::iterator start, typename ArgumentVector::iterator end);
+  // Use the provided function to process arguments from the list until there are none left
+  void DoThreadWork();
 
   // Tuple unpacking - from http://stackoverflow.com/questions/7858817/unpacking-a-tuple-to-call-a-matching-function-pointer
   template<int ...>
@@ -106,32 +111,16 @@ void DispatchWorker<TCount, Args...>::Process()
 {
   std::lock_guard<std::mutex> lockGuard(_argsListMutex);
   const std::size_t size = _argumentList.size();
-  const std::size_t numTotalThreads = TCount + 1; // Reserve one slot for the calling thread
-  const std::size_t countPerThread = size / numTotalThreads;
-  std::size_t remainder = (size % numTotalThreads);
-  
-  typename ArgumentVector::iterator curIter = _argumentList.begin();
+  _nextJobIdx = 0;
   
-  // Hand out work to each of the threads we've allocated
-  for (std::size_t i = 0; i < TCount; i++)
+  // Start as many of the threads we've allocated as there are jobs for, reserving one job for the calling thread
+  for (std::size_t i = 0; (i < TCount) && (i + 1 < size); i++)
   {
-    if (0 == countPerThread && 0 == remainder)
-    {
-      break;
-    }
-    
-    std::size_t sizeForThread = countPerThread;
-    if (remainder > 0)
-    {
-      ++sizeForThread;
-      --remainder;
-    }
-    _workerThreads[i] = std::thread(&DispatchWorker::DoThreadWork, this, curIter, curIter + sizeForThread);
-    curIter += sizeForThread;
+    _workerThreads[i] = std::thread(&DispatchWorker::DoThreadWork, this);
   }
   
   // Now allow the calling thread to do some work too
-  DoThreadWork(curIter, _argumentList.end());
+  DoThreadWork();
   
   // Wait for all our threads to be done
   for (std::size_t i = 0; i < TCount; i++)
@@ -147,12 +136,15 @@ void DispatchWorker<TCount, Args...>::Process()
 }
   
 template<std::size_t TCount, typename... Args>
-void DispatchWorker<TCount, Args...>::DoThreadWork(typename ArgumentVector::iterator start, typename ArgumentVector::iterator end)
+void DispatchWorker<TCount, Args...>::DoThreadWork()
 {
   static const auto paramSeq = typename gens<sizeof...(Args)>::type{};
-  while (start != end)
+  const std::size_t size = _argumentList.size();
+  std::size_t jobIdx = _nextJobIdx++;
+  while (jobIdx < size)
   {
-    Invoke(*start++, paramSeq);
+    Invoke(_argumentList[jobIdx], paramSeq);
+    jobIdx = _nextJobIdx++;
   }
 }
 
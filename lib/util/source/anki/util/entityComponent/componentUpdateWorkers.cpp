@@ -0,0 +1,124 @@
+/**
+*  componentUpdateWorkers.cpp
+*
+*  Author: Victor Rebuild
+*  Date:   10/14/2026
+*
+*  Copyright: Victor Rebuild 2026
+*
+**/
+
+#include "util/entityComponent/componentUpdateWorkers.h"
+
+#include "util/threading/threadPriority.h"
+
+#include <string>
+
+namespace Anki {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ComponentUpdateWorkers::ComponentUpdateWorkers(size_t numThreads)
+: _numThreads(numThreads)
+{
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+ComponentUpdateWorkers::~ComponentUpdateWorkers()
+{
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _stopping = true;
+  }
+  _startCondition.notify_all();
+  for (auto& thread: _threads) {
+    thread.join();
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ComponentUpdateWorkers::Run(size_t count, const JobFunc& func)
+{
+  if ((_numThreads == 0) || (count <= 1)) {
+    for (size_t i = 0; i < count; ++i) {
+      func(i);
+    }
+    return;
+  }
+
+  if (_threads.empty()) {
+    StartThreads();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _func = &func;
+    _count = count;
+    _nextJobIdx = 0;
+    _numBusyThreads = _threads.size();
+    ++_generation;
+  }
+  _startCondition.notify_all();
+
+  // the calling thread takes jobs too, so a batch never waits on a thread waking up
+  DoJobs(func, count);
+
+  std::unique_lock<std::mutex> lock(_mutex);
+  _doneCondition.wait(lock, [this] { return _numBusyThreads == 0; });
+  _func = nullptr;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ComponentUpdateWorkers::StartThreads()
+{
+  _threads.reserve(_numThreads);
+  for (size_t i = 0; i < _numThreads; ++i) {
+    _threads.emplace_back(&ComponentUpdateWorkers::ThreadLoop, this);
+    Util::SetThreadName(_threads.back().native_handle(), "CompUpdate" + std::to_string(i));
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ComponentUpdateWorkers::ThreadLoop()
+{
+  uint32_t lastGeneration = 0;
+  while (true) {
+    const JobFunc* func = nullptr;
+    size_t count = 0;
+    {
+      std::unique_lock<std::mutex> lock(_mutex);
+      _startCondition.wait(lock, [this, lastGeneration] { return _stopping || (_generation != lastGeneration); });
+      if (_stopping) {
+        return;
+      }
+      lastGeneration = _generation;
+      func = _func;
+      count = _count;
+    }
+
+    DoJobs(*func, count);
+
+    bool lastOneDone = false;
+    {
+      std::lock_guard<std::mutex> lock(_mutex);
+      lastOneDone = (--_numBusyThreads == 0);
+    }
+    if (lastOneDone) {
+      _doneCondition.notify_one();
+    }
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ComponentUpdateWorkers::DoJobs(const JobFunc& func, size_t count)
+{
+  for (size_t jobIdx = _nextJobIdx++; jobIdx < count; jobIdx = _nextJobIdx++) {
+    func(jobIdx);
+  }
+}
+
+} // namespace Anki
@@ -0,0 +1,67 @@
+/**
+*  componentUpdateWorkers.h
+*
+*  Author: Victor Rebuild
+*  Date:   10/14/2026
+*
+*  Small persistent thread pool used by DependencyManagedEntity to update a batch of
+*  independent components at once. The threads are started the first time they're needed
+*  and then sleep between batches, so an entity that never has more than one component
+*  ready at a time costs nothing.
+*
+*  Copyright: Victor Rebuild 2026
+*
+**/
+
+#ifndef __Util_EntityComponent_ComponentUpdateWorkers_H__
+#define __Util_EntityComponent_ComponentUpdateWorkers_H__
+
+#include "util/helpers/noncopyable.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+
+class ComponentUpdateWorkers : private Util::noncopyable
+{
+public:
+  using JobFunc = std::function<void(size_t)>;
+
+  explicit ComponentUpdateWorkers(size_t numThreads);
+  ~ComponentUpdateWorkers();
+
+  size_t GetNumThreads() const { return _numThreads; }
+
+  // Calls func(i) for every i in [0, count), spread over the worker threads and the calling thread,
+  // and returns once all of them are done. Not reentrant
+  void Run(size_t count, const JobFunc& func);
+
+private:
+  const size_t _numThreads;
+  std::vector<std::thread> _threads;
+
+  std::mutex _mutex;
+  std::condition_variable _startCondition;
+  std::condition_variable _doneCondition;
+
+  // the current batch, guarded by _mutex except for the job index
+  const JobFunc* _func = nullptr;
+  size_t _count = 0;
+  std::atomic<size_t> _nextJobIdx{0};
+  uint32_t _generation = 0;
+  size_t _numBusyThreads = 0;
+  bool _stopping = false;
+
+  void StartThreads();
+  void ThreadLoop();
+  void DoJobs(const JobFunc& func, size_t count);
+};
+
+} // namespace Anki
+
+#endif // __Util_EntityComponent_ComponentUpdateWorkers_H__
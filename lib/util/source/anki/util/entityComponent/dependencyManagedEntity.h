@@ -15,11 +15,17 @@
 #include "util/entityComponent/iDependencyManagedComponent.h"
 
 #include "util/entityComponent/componentTypeEnumMap.h"
+#include "util/entityComponent/componentUpdateWorkers.h"
+#include "util/global/globalDefinitions.h"
 #include "util/helpers/fullEnumToValueArrayChecker.h"
 #include "util/logging/logging.h"
 
+#include <algorithm>
+#include <chrono>
 #include <map>
+#include <memory>
 #include <set>
+#include <vector>
 
 #if !defined(ANKI_PROFILE_DEPENDENCY_MANAGED_ENTITY)
 #define ANKI_PROFILE_DEPENDENCY_MANAGED_ENTITY 0
@@ -61,9 +67,23 @@ public:
   // Init all components in their declared dependency order
   void InitComponents(Vector::Robot* robot); //tmp for pass through
 
-  // Update all components in their declared dependency order
+  // Update all components in their declared dependency order. Components that CanUpdateInParallel are
+  // grouped into batches of components that don't depend on each other, and each batch is spread over
+  // the update workers
   void UpdateComponents();
 
+  // Number of worker threads (besides the calling thread) used for parallel batches - 0 updates everything
+  // on the calling thread, in the same order
+  void SetNumUpdateWorkers(size_t numWorkers);
+
+  // While enabled, UpdateComponents adds up how long each component's update takes. Off by default, since timing every
+  // component costs a couple of clock reads per component per tick
+  using UpdateTimes = std::map<EnumType, std::chrono::steady_clock::duration>;
+  void SetUpdateTimingEnabled(bool enabled) { _isUpdateTimingEnabled = enabled; }
+  // Total update time of each component since timing was first enabled or last reset
+  UpdateTimes GetUpdateTimes() const;
+  void ResetUpdateTimes() { _updateTimes.clear(); }
+
   template<typename T>
   bool HasComponent() const {
     EnumType enumID = EnumType::Count;
@@ -103,6 +123,30 @@ private:
 
   std::vector<std::pair<ComponentPtrWrapper,DependentComponents>> _cachedInitOrder;
   std::vector<std::pair<ComponentPtrWrapper,DependentComponents>> _cachedUpdateOrder;
+  // _cachedUpdateOrder is split into steps, each one either a single component or a batch of components that
+  // can be updated at the same time. Step i covers [_cachedUpdateStepEnds[i-1], _cachedUpdateStepEnds[i])
+  std::vector<size_t> _cachedUpdateStepEnds;
+
+  // shared so the entity stays copyable
+  std::shared_ptr<ComponentUpdateWorkers> _updateWorkers;
+
+  // Indexed like _cachedUpdateOrder. Each entry is only written by whoever updates that component, so parallel
+  // batches don't need a lock
+  bool _isUpdateTimingEnabled = false;
+  std::vector<std::chrono::steady_clock::duration> _updateTimes;
+
+  #if ANKI_DEVELOPER_CODE
+  // Set on whichever thread is updating a component as part of a parallel batch, so that the component reaching
+  // anything it didn't declare through this entity (e.g. through the robot) is caught instead of racing
+  struct ParallelUpdateInfo {
+    const void* entity = nullptr;
+    EnumType component = EnumType::Count;
+    const DependentComponents* declared = nullptr;
+  };
+  static thread_local ParallelUpdateInfo sParallelUpdateInfo;
+
+  void CheckParallelAccess(EnumType enumID) const;
+  #endif
 
   using OrderedDependentVector = std::vector<ComponentPtrWrapper>;
 
@@ -121,6 +165,15 @@ private:
   // Determine the order of component update
   OrderedDependentVector  GetUpdateDependentOrder();
 
+  // Build _cachedUpdateOrder and _cachedUpdateStepEnds from the update order
+  void BuildUpdateSteps();
+
+  // Update the components of one parallel batch
+  void UpdateBatch(size_t begin, size_t end);
+
+  // Update the component at index in _cachedUpdateOrder, timing it if enabled
+  void UpdateCachedComponent(size_t index);
+
   // Base function which uses a depth first search to topologically sort the order in which components
   // should be ticked based on the dependency map passed in
   OrderedDependentVector  GetDependentOrderBase(const std::map<EnumType, std::set<EnumType>>& dependencyMap);
@@ -210,6 +263,9 @@ void DependencyManagedEntity<EnumType>::ClearEntity()
 template <typename EnumType>
 auto DependencyManagedEntity<EnumType>::GetComponent(EnumType enumID) const -> const ComponentType&
 {
+  #if ANKI_DEVELOPER_CODE
+  CheckParallelAccess(enumID);
+  #endif
   auto iter = _components.find(enumID);
   ANKI_VERIFY(iter != _components.end(), "Entity.GetComponent.InvalidGet", "Enum not found");
   return *iter->second._ptr;
@@ -220,6 +276,9 @@ auto DependencyManagedEntity<EnumType>::GetComponent(EnumType enumID) const -> c
 template <typename EnumType>
 auto DependencyManagedEntity<EnumType>::GetComponent(EnumType enumID) -> ComponentType&
 {
+  #if ANKI_DEVELOPER_CODE
+  CheckParallelAccess(enumID);
+  #endif
   auto iter = _components.find(enumID);
   ANKI_VERIFY(iter != _components.end(), "Entity.GetComponent.InvalidGet", "Enum not found");
   return *iter->second._ptr;
@@ -230,6 +289,9 @@ auto DependencyManagedEntity<EnumType>::GetComponent(EnumType enumID) -> Compone
 template <typename EnumType>
 auto DependencyManagedEntity<EnumType>::GetComponentPtr(EnumType enumID) ->   ComponentType*
 {
+  #if ANKI_DEVELOPER_CODE
+  CheckParallelAccess(enumID);
+  #endif
   auto iter = _components.find(enumID);
   ANKI_VERIFY(iter != _components.end(), "Entity.GetComponent.InvalidGet", "Enum not found");
   return iter->second._ptr;
@@ -291,35 +353,185 @@ void DependencyManagedEntity<EnumType>::UpdateComponents()
 {
   // Build the cache if necessary
   if (_cachedUpdateOrder.empty()) {
-    OrderedDependentVector orderedComponents = GetUpdateDependentOrder();
-    #if ANKI_PROFILE_DEPENDENCY_MANAGED_ENTITY
-    for (size_t i = 0; i < orderedComponents.size(); ++i) {
-      const auto * component = orderedComponents[i]._ptr;
-      EnumType enumID = EnumType::Count;
-      component->GetTypeDependent(enumID);
-      LOG_CH_DEBUG("DependencyManagedEntity",
-                   "UpdateComponents",
-                   "Component %zu: %s %s",
-                   i,
-                   GetComponentStringForID<EnumType>(enumID).c_str(),
-                   component->IsUnreliableComponent() ? "(Unreliable)" : "");
+    BuildUpdateSteps();
+  }
+  if (_isUpdateTimingEnabled && (_updateTimes.size() != _cachedUpdateOrder.size())) {
+    _updateTimes.resize(_cachedUpdateOrder.size());
+  }
+  // Update components;
+  size_t begin = 0;
+  for (const size_t end: _cachedUpdateStepEnds) {
+    if ((end - begin == 1) || (_updateWorkers == nullptr)) {
+      for (size_t i = begin; i < end; ++i) {
+        UpdateCachedComponent(i);
+      }
+    } else {
+      UpdateBatch(begin, end);
     }
+    begin = end;
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+void DependencyManagedEntity<EnumType>::UpdateBatch(size_t begin, size_t end)
+{
+  _updateWorkers->Run(end - begin, [this, begin](size_t jobIdx) {
+    auto& entry = _cachedUpdateOrder[begin + jobIdx];
+    #if ANKI_DEVELOPER_CODE
+    entry.first._ptr->GetTypeDependent(sParallelUpdateInfo.component);
+    sParallelUpdateInfo.declared = &entry.second;
+    sParallelUpdateInfo.entity = this;
     #endif
-    for (const auto& ptrWrapper: orderedComponents) {
+    UpdateCachedComponent(begin + jobIdx);
+    #if ANKI_DEVELOPER_CODE
+    sParallelUpdateInfo = ParallelUpdateInfo();
+    #endif
+  });
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+void DependencyManagedEntity<EnumType>::UpdateCachedComponent(size_t index)
+{
+  auto& entry = _cachedUpdateOrder[index];
+  if (!_isUpdateTimingEnabled) {
+    entry.first._ptr->UpdateDependent(entry.second);
+    return;
+  }
+  const auto start = std::chrono::steady_clock::now();
+  entry.first._ptr->UpdateDependent(entry.second);
+  _updateTimes[index] += std::chrono::steady_clock::now() - start;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+typename DependencyManagedEntity<EnumType>::UpdateTimes DependencyManagedEntity<EnumType>::GetUpdateTimes() const
+{
+  UpdateTimes times;
+  for (size_t i = 0; i < _updateTimes.size(); ++i) {
+    EnumType enumID = EnumType::Count;
+    _cachedUpdateOrder[i].first._ptr->GetTypeDependent(enumID);
+    times[enumID] += _updateTimes[i];
+  }
+  return times;
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+void DependencyManagedEntity<EnumType>::SetNumUpdateWorkers(size_t numWorkers)
+{
+  const size_t currentNumWorkers = (_updateWorkers != nullptr) ? _updateWorkers->GetNumThreads() : 0;
+  if (numWorkers == currentNumWorkers) {
+    return;
+  }
+  _updateWorkers.reset();
+  if (numWorkers > 0) {
+    _updateWorkers = std::make_shared<ComponentUpdateWorkers>(numWorkers);
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+void DependencyManagedEntity<EnumType>::BuildUpdateSteps()
+{
+  OrderedDependentVector orderedComponents = GetUpdateDependentOrder();
+
+  // Walk the topological order, giving every component its own step unless it can update in parallel, in which
+  // case it joins the first batch after the steps of everything it depends on (or starts a new batch at the end).
+  // That only ever moves a component earlier than its dependents, so the declared order still holds
+  struct Step {
+    bool isBatch;
+    OrderedDependentVector components;
+  };
+  std::vector<Step> steps;
+  std::map<EnumType, size_t> typeToStep;
+  for (const auto& ptrWrapper: orderedComponents) {
+    auto compPtr = ptrWrapper._ptr;
+    EnumType type = EnumType::Count;
+    compPtr->GetTypeDependent(type);
+    std::set<EnumType> dependencies;
+    compPtr->GetUpdateDependencies(dependencies);
+
+    size_t firstAllowedStep = 0;
+    for (const auto& dependency: dependencies) {
+      const auto iter = typeToStep.find(dependency);
+      if (iter != typeToStep.end()) {
+        firstAllowedStep = std::max(firstAllowedStep, iter->second + 1);
+      }
+    }
+
+    size_t stepIdx = steps.size();
+    if (compPtr->CanUpdateInParallel()) {
+      for (size_t i = firstAllowedStep; i < steps.size(); ++i) {
+        if (steps[i].isBatch) {
+          stepIdx = i;
+          break;
+        }
+      }
+    }
+    if (stepIdx == steps.size()) {
+      steps.push_back(Step{compPtr->CanUpdateInParallel(), {}});
+    }
+    steps[stepIdx].components.push_back(ptrWrapper);
+    typeToStep[type] = stepIdx;
+  }
+
+  for (const auto& step: steps) {
+    for (const auto& ptrWrapper: step.components) {
       // Add component and all its dependencies to the cached map
       auto compPtr = ptrWrapper._ptr;
+      #if ANKI_PROFILE_DEPENDENCY_MANAGED_ENTITY
+      EnumType enumID = EnumType::Count;
+      compPtr->GetTypeDependent(enumID);
+      LOG_CH_DEBUG("DependencyManagedEntity",
+                   "UpdateComponents",
+                   "Component %zu (step %zu): %s %s%s",
+                   _cachedUpdateOrder.size(),
+                   _cachedUpdateStepEnds.size(),
+                   GetComponentStringForID<EnumType>(enumID).c_str(),
+                   compPtr->IsUnreliableComponent() ? "(Unreliable)" : "",
+                   (step.components.size() > 1) ? "(Parallel)" : "");
+      #endif
       std::set<EnumType> componentNames;
       compPtr->GetUpdateDependencies(componentNames);
       compPtr->AdditionalUpdateAccessibleComponents(componentNames);
       DependentComponents comps = BuildDependentComponentsMap(std::move(componentNames));
       _cachedUpdateOrder.push_back(std::make_pair(ptrWrapper, std::move(comps)));
     }
+    _cachedUpdateStepEnds.push_back(_cachedUpdateOrder.size());
   }
-  // Update components;
-  for (auto& entry: _cachedUpdateOrder) {
-    entry.first._ptr->UpdateDependent(entry.second);
+}
+
+
+#if ANKI_DEVELOPER_CODE
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+thread_local typename DependencyManagedEntity<EnumType>::ParallelUpdateInfo
+  DependencyManagedEntity<EnumType>::sParallelUpdateInfo;
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template<typename EnumType>
+void DependencyManagedEntity<EnumType>::CheckParallelAccess(EnumType enumID) const
+{
+  const auto& info = sParallelUpdateInfo;
+  if ((info.entity != this) || (enumID == info.component)) {
+    return;
   }
+  const bool isDeclared = (info.declared->_components.find(enumID) != info.declared->_components.end());
+  DEV_ASSERT_MSG(isDeclared,
+                 "DependencyManagedEntity.CheckParallelAccess.UndeclaredAccess",
+                 "%s is updated in parallel but accessed %s, which it didn't declare",
+                 GetComponentStringForID<EnumType>(info.component).c_str(),
+                 GetComponentStringForID<EnumType>(enumID).c_str());
 }
+#endif
 
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
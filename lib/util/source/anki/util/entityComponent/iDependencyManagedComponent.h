@@ -86,6 +86,11 @@ public:
 
   virtual void UpdateDependent(const DependencyManagedEntity<EnumType>& dependentComps) {};
 
+  // Only override if UpdateDependent touches nothing but the component's own state and the components
+  // passed into it (no messages, broadcasts, callbacks or robot access). Those components may be updated
+  // on a worker thread at the same time as other such components that don't depend on each other
+  virtual bool CanUpdateInParallel() const { return false; }
+
   template<typename T>
   T& GetComponent() const {
     EnumType enumID = EnumType::Count;
@@ -137,6 +142,7 @@ public:
   virtual void GetUpdateDependencies(std::set<EnumType>& dependencies) const override final {};
   virtual void AdditionalUpdateAccessibleComponents(std::set<EnumType>& components) const override final {};
   virtual void UpdateDependent(const DependencyManagedEntity<EnumType>& dependentComps) override final {};
+  virtual bool CanUpdateInParallel() const override final { return false; }
 };
 
 } // namespace Anki
@@ -290,8 +290,8 @@ std::vector<uint8_t> FileUtils::ReadFileAsBinary(const std::string& fileName,
                                                  size_t offset,
                                                  size_t length)
 {
-  if (offset >= length) {
-    // Reading past the end of the file is not allowed
+  if (length == 0) {
+    // Nothing to read (reading past the end of the file is caught below)
     return {};
   }
   int fd = TEMP_FAILURE_RETRY(open(fileName.c_str(), O_RDONLY));
@@ -15,13 +15,24 @@
 #include "util/logging/logging.h"
 #include "util/math/math.h"
 #include "json/json.h"
+#include <algorithm>
 #include <assert.h>
+#include <cmath>
 
 
 namespace Anki {
 namespace Util {
 
   
+namespace {
+  // Spans count as the same width if they are within this fraction of the first one
+  const float kEvenSpacingTolerance = 1e-5f;
+  
+  // Beyond this many spans, FindSpan binary searches instead of checking every one
+  const size_t kMaxSpansForLinearSearch = 16;
+}
+  
+  
 bool GraphEvaluator2d::Node::operator==(const GraphEvaluator2d::Node& rhs) const
 {
   const bool isEqual = FLT_NEAR(_x, rhs._x) && FLT_NEAR(_y, rhs._y);
@@ -44,6 +55,9 @@ GraphEvaluator2d::GraphEvaluator2d(const std::vector<Node>& inNodes, bool errorO
 void GraphEvaluator2d::Clear()
 {
   _nodes.clear();
+  _spans.clear();
+  _invSpacing = 0.0f;
+  _isEvenlySpaced = false;
 }
   
   
@@ -52,6 +66,7 @@ void GraphEvaluator2d::Reserve(size_t numNodesToReserve)
   if (numNodesToReserve > 0)
   {
     _nodes.reserve(numNodesToReserve);
+    _spans.reserve(numNodesToReserve - 1);
   }
 }
   
@@ -62,7 +77,7 @@ bool GraphEvaluator2d::AddNodes(const std::vector<Node>& inNodes, bool errorOnFa
   const size_t postNumNodesExpected = _nodes.size() + numNodesToAdd;
   if (numNodesToAdd > 0)
   {
-    _nodes.reserve(postNumNodesExpected);
+    Reserve(postNumNodesExpected);
     
     for (const Node& inNode : inNodes)
     {
@@ -118,6 +133,31 @@ bool GraphEvaluator2d::AddNode(float x, float y, bool errorOnFailure)
       }
       return false;
     }
+    
+    const Node& prevNode = _nodes[lastNodeIdx];
+    const float xRange = (x - prevNode._x);
+    const bool  canLerp = FLT_GT(xRange, 0.0f);
+    
+    Span span{prevNode._x, prevNode._y, xRange, (y - prevNode._y)};
+    if (!canLerp)
+    {
+      // x range is too small to lerp -> just use prevNode
+      span._xRange = 1.0f;
+      span._yRange = 0.0f;
+    }
+    
+    if (_spans.empty())
+    {
+      _isEvenlySpaced = canLerp;
+      _invSpacing = canLerp ? (1.0f / xRange) : 0.0f;
+    }
+    else if (_isEvenlySpaced)
+    {
+      const float spacing = _spans[0]._xRange;
+      _isEvenlySpaced = IsNear(xRange, spacing, spacing * kEvenSpacingTolerance);
+    }
+    
+    _spans.push_back(span);
   }
   
   _nodes.emplace_back(x, y);
@@ -126,53 +166,65 @@ bool GraphEvaluator2d::AddNode(float x, float y, bool errorOnFailure)
 }
   
   
-float GraphEvaluator2d::EvaluateY(float x) const
+size_t GraphEvaluator2d::FindSpan(float x) const
 {
-  const size_t numNodes = _nodes.size();
-  assert(numNodes > 0);
-  
-  const Node* prevNode = &_nodes[0];
+  // The span for x ends at the first node with x <= that node's x
+  const size_t lastSpanIdx = _spans.size() - 1;
   
-  if (x < prevNode->_x)
+  if (_isEvenlySpaced)
   {
-    // x is < than all nodes - clamp to 1st node
-    return prevNode->_y;
+    // Comparisons are false for NaN, which lands in the first span like any x that is too small
+    const float spanIdx = std::ceil((x - _nodes[0]._x) * _invSpacing) - 1.0f;
+    return (spanIdx > 0.0f) ? ((spanIdx < (float)lastSpanIdx) ? (size_t)spanIdx : lastSpanIdx) : 0;
   }
   
-  for (size_t i=1; i < numNodes; ++i)
+  if (_spans.size() <= kMaxSpansForLinearSearch)
   {
-    const Node* nextNode = &_nodes[i];
-    
-    if (x <= nextNode->_x)
+    // Count the spans x is past the end of, with nothing to mispredict
+    size_t spanIdx = 0;
+    for (size_t i = 1; i <= lastSpanIdx; ++i)
     {
-      // found the span - interpolate between prev and next nodes
-      const float xRange = (nextNode->_x - prevNode->_x);
-      if (FLT_GT(xRange, 0.0f))
-      {
-        assert(x >= prevNode->_x);
-        const float xRatio = (x - prevNode->_x) / xRange;
-        assert(xRatio >= 0.0f);
-        assert(xRatio <= 1.0f);
-        const float yRange = (nextNode->_y - prevNode->_y);
-        const float yVal   = prevNode->_y + (xRatio * yRange);
-        return yVal;
-      }
-      else
-      {
-        // x range is too small to lerp -> just use prevNode
-        return prevNode->_y;
-      }
-    }
-    else
-    {
-      // keep looking
-      prevNode = nextNode;
+      spanIdx += (x > _spans[i]._x0) ? 1 : 0;
     }
+    return spanIdx;
+  }
+  
+  const auto it = std::lower_bound(_spans.begin() + 1, _spans.end(), x,
+                                   [](const Span& span, float val) { return span._x0 < val; });
+  return (size_t)(it - (_spans.begin() + 1));
+}
+  
+  
+float GraphEvaluator2d::EvaluateY(float x) const
+{
+  const size_t numNodes = _nodes.size();
+  assert(numNodes > 0);
+  
+  const Node& lastNode = _nodes[numNodes - 1];
+  if (_spans.empty())
+  {
+    return lastNode._y;
   }
   
+  // x is < than all nodes - clamp to 1st node, which the 1st span evaluates to at its start
+  const float clampedX = std::max(x, _nodes[0]._x);
+  
+  const Span& span = _spans[FindSpan(clampedX)];
+  const float xRatio = (clampedX - span._x0) / span._xRange;
+  const float yVal   = span._y0 + (xRatio * span._yRange);
+  
   // x is > than all nodes - clamp to last node
+  return (x <= lastNode._x) ? yVal : lastNode._y;
+}
+  
   
-  return prevNode->_y;
+void GraphEvaluator2d::EvaluateY(const std::vector<float>& xs, std::vector<float>& outYs) const
+{
+  outYs.resize(xs.size());
+  for (size_t i = 0; i < xs.size(); ++i)
+  {
+    outYs[i] = EvaluateY(xs[i]);
+  }
 }
   
 float GraphEvaluator2d::GetSlopeAt(float x) const
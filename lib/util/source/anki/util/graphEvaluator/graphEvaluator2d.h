@@ -4,7 +4,10 @@
  * Author: Mark Wesley
  * Created: 10/13/15
  *
- * Description: A 2d graph of nodes, lerps values between nodes, clamps values at ends of the range
+ * Description: A 2d graph of nodes, lerps values between nodes, clamps values at ends of the range.
+ *              Evaluation uses a table of the spans between nodes that is kept up to date as nodes are added, so
+ *              finding the span for x is a direct index when the nodes are evenly spaced and a branchless count
+ *              (or, for large graphs, a binary search) otherwise.
  *
  * Copyright: Anki, Inc. 2015
  *
@@ -60,6 +63,9 @@ public:
   
   float EvaluateY(float x) const;
   
+  // Evaluates every x in xs, setting outYs to the results in the same order
+  void EvaluateY(const std::vector<float>& xs, std::vector<float>& outYs) const;
+  
   // Get slope at x. If x is within the range of data, the return value is the slope at x- (from the left)
   // to match the implementation of EvaluateY. If x is outside of the range, slope is defined to be 0.
   // (If there are only two nodes with the same x value, this returns FLT_MAX.)
@@ -84,7 +90,23 @@ public:
 
 private:
   
+  // The span from one node to the next, set up so that EvaluateY is the same lerp for every span: a span too
+  // narrow to lerp has an xRange of 1 and a yRange of 0, so it evaluates to its first node's y
+  struct Span
+  {
+    float _x0;
+    float _y0;
+    float _xRange;
+    float _yRange;
+  };
+  
+  // Index of the span EvaluateY uses for x, which must not be less than the first node's x
+  size_t FindSpan(float x) const;
+  
   std::vector<Node>    _nodes;
+  std::vector<Span>    _spans;          // _spans[i] goes from _nodes[i] to _nodes[i+1]
+  float                _invSpacing = 0.0f; // 1 / x distance between nodes, if all spans are the same width
+  bool                 _isEvenlySpaced = false;
 };
   
 
@@ -0,0 +1,418 @@
+/**
+ * File: jsonSaxReader.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Event based json reader
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "util/jsonWriter/jsonSaxReader.h"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace Anki {
+namespace Util {
+
+constexpr const uint32_t JsonSaxReader::kMaxDepth;
+
+bool JsonSaxReader::Parse(const char* data, size_t size, IJsonSaxHandler& handler)
+{
+  _begin = data;
+  _cur = data;
+  _end = data + size;
+  _error.clear();
+  _errorOffset = 0;
+
+  if (!SkipWhitespace() || !ParseValue(handler, 0) || !SkipWhitespace()) {
+    return false;
+  }
+  if (_cur != _end) {
+    return Fail("TrailingCharacters");
+  }
+  return true;
+}
+
+bool JsonSaxReader::ParseFile(const std::string& path, IJsonSaxHandler& handler)
+{
+  FILE* file = fopen(path.c_str(), "rb");
+  if (file == nullptr) {
+    _error = "CouldNotOpenFile";
+    _errorOffset = 0;
+    return false;
+  }
+
+  _fileBuffer.clear();
+  char chunk[16 * 1024];
+  size_t numRead = 0;
+  while ((numRead = fread(chunk, 1, sizeof(chunk), file)) > 0) {
+    _fileBuffer.append(chunk, numRead);
+  }
+  const bool readError = (ferror(file) != 0);
+  fclose(file);
+  if (readError) {
+    _error = "CouldNotReadFile";
+    _errorOffset = 0;
+    return false;
+  }
+
+  return Parse(_fileBuffer, handler);
+}
+
+bool JsonSaxReader::Fail(const char* error)
+{
+  // Keep the first error, callbacks unwinding after it fail too
+  if (_error.empty()) {
+    _error = error;
+    _errorOffset = _cur - _begin;
+  }
+  return false;
+}
+
+bool JsonSaxReader::Stopped()
+{
+  return Fail("StoppedByHandler");
+}
+
+bool JsonSaxReader::SkipWhitespace()
+{
+  while (_cur != _end) {
+    const char c = *_cur;
+    if ((c == ' ') || (c == '\t') || (c == '\n') || (c == '\r')) {
+      ++_cur;
+    }
+    else if ((c == '/') && ((_cur + 1) != _end) && (_cur[1] == '/')) {
+      while ((_cur != _end) && (*_cur != '\n')) {
+        ++_cur;
+      }
+    }
+    else if ((c == '/') && ((_cur + 1) != _end) && (_cur[1] == '*')) {
+      const char* commentEnd = nullptr;
+      for (const char* p = _cur + 2; (p + 1) < _end; ++p) {
+        if ((p[0] == '*') && (p[1] == '/')) {
+          commentEnd = p + 2;
+          break;
+        }
+      }
+      if (commentEnd == nullptr) {
+        return Fail("UnterminatedComment");
+      }
+      _cur = commentEnd;
+    }
+    else {
+      break;
+    }
+  }
+  return true;
+}
+
+bool JsonSaxReader::ParseValue(IJsonSaxHandler& handler, uint32_t depth)
+{
+  if (_cur == _end) {
+    return Fail("UnexpectedEnd");
+  }
+
+  switch (*_cur) {
+    case '{':
+      return ParseObject(handler, depth + 1);
+    case '[':
+      return ParseArray(handler, depth + 1);
+    case '"':
+      if (!ParseString(_stringBuffer)) {
+        return false;
+      }
+      return handler.String(_stringBuffer) || Stopped();
+    case 't':
+      return ParseLiteral("true", 4) && (handler.Bool(true) || Stopped());
+    case 'f':
+      return ParseLiteral("false", 5) && (handler.Bool(false) || Stopped());
+    case 'n':
+      return ParseLiteral("null", 4) && (handler.Null() || Stopped());
+    default:
+      return ParseNumber(handler);
+  }
+}
+
+bool JsonSaxReader::ParseObject(IJsonSaxHandler& handler, uint32_t depth)
+{
+  if (depth > kMaxDepth) {
+    return Fail("TooDeep");
+  }
+  ++_cur; // '{'
+  if (!handler.StartObject()) {
+    return Stopped();
+  }
+  if (!SkipWhitespace()) {
+    return false;
+  }
+  if ((_cur != _end) && (*_cur == '}')) {
+    ++_cur;
+    return handler.EndObject() || Stopped();
+  }
+
+  while (true) {
+    if ((_cur == _end) || (*_cur != '"')) {
+      return Fail("ExpectedKey");
+    }
+    if (!ParseString(_keyBuffer)) {
+      return false;
+    }
+    if (!handler.Key(_keyBuffer)) {
+      return Stopped();
+    }
+    if (!SkipWhitespace()) {
+      return false;
+    }
+    if ((_cur == _end) || (*_cur != ':')) {
+      return Fail("ExpectedColon");
+    }
+    ++_cur;
+    if (!SkipWhitespace() || !ParseValue(handler, depth) || !SkipWhitespace()) {
+      return false;
+    }
+    if (_cur == _end) {
+      return Fail("UnterminatedObject");
+    }
+    if (*_cur == '}') {
+      ++_cur;
+      return handler.EndObject() || Stopped();
+    }
+    if (*_cur != ',') {
+      return Fail("ExpectedCommaOrObjectEnd");
+    }
+    ++_cur;
+    if (!SkipWhitespace()) {
+      return false;
+    }
+  }
+}
+
+bool JsonSaxReader::ParseArray(IJsonSaxHandler& handler, uint32_t depth)
+{
+  if (depth > kMaxDepth) {
+    return Fail("TooDeep");
+  }
+  ++_cur; // '['
+  if (!handler.StartArray()) {
+    return Stopped();
+  }
+  if (!SkipWhitespace()) {
+    return false;
+  }
+  if ((_cur != _end) && (*_cur == ']')) {
+    ++_cur;
+    return handler.EndArray() || Stopped();
+  }
+
+  while (true) {
+    if (!ParseValue(handler, depth) || !SkipWhitespace()) {
+      return false;
+    }
+    if (_cur == _end) {
+      return Fail("UnterminatedArray");
+    }
+    if (*_cur == ']') {
+      ++_cur;
+      return handler.EndArray() || Stopped();
+    }
+    if (*_cur != ',') {
+      return Fail("ExpectedCommaOrArrayEnd");
+    }
+    ++_cur;
+    if (!SkipWhitespace()) {
+      return false;
+    }
+  }
+}
+
+bool JsonSaxReader::ParseHex4(uint32_t& out)
+{
+  if ((_end - _cur) < 4) {
+    return Fail("InvalidUnicodeEscape");
+  }
+  out = 0;
+  for (int i = 0; i < 4; ++i) {
+    const char c = *_cur++;
+    out <<= 4;
+    if ((c >= '0') && (c <= '9')) {
+      out |= (c - '0');
+    } else if ((c >= 'a') && (c <= 'f')) {
+      out |= (c - 'a' + 10);
+    } else if ((c >= 'A') && (c <= 'F')) {
+      out |= (c - 'A' + 10);
+    } else {
+      return Fail("InvalidUnicodeEscape");
+    }
+  }
+  return true;
+}
+
+bool JsonSaxReader::ParseString(std::string& out)
+{
+  ++_cur; // '"'
+  out.clear();
+  while (true) {
+    // Copy runs without escapes in one go
+    const char* runStart = _cur;
+    while ((_cur != _end) && (*_cur != '"') && (*_cur != '\\')) {
+      ++_cur;
+    }
+    out.append(runStart, _cur - runStart);
+    if (_cur == _end) {
+      return Fail("UnterminatedString");
+    }
+    if (*_cur == '"') {
+      ++_cur;
+      return true;
+    }
+
+    ++_cur; // '\\'
+    if (_cur == _end) {
+      return Fail("UnterminatedString");
+    }
+    const char escaped = *_cur++;
+    switch (escaped) {
+      case '"':  out += '"';  break;
+      case '\\': out += '\\'; break;
+      case '/':  out += '/';  break;
+      case 'b':  out += '\b'; break;
+      case 'f':  out += '\f'; break;
+      case 'n':  out += '\n'; break;
+      case 'r':  out += '\r'; break;
+      case 't':  out += '\t'; break;
+      case 'u':
+      {
+        uint32_t codePoint = 0;
+        if (!ParseHex4(codePoint)) {
+          return false;
+        }
+        if ((codePoint >= 0xD800) && (codePoint <= 0xDBFF)) {
+          // high surrogate, must be followed by an escaped low one
+          uint32_t low = 0;
+          if (((_end - _cur) < 2) || (_cur[0] != '\\') || (_cur[1] != 'u')) {
+            return Fail("InvalidSurrogatePair");
+          }
+          _cur += 2;
+          if (!ParseHex4(low)) {
+            return false;
+          }
+          if ((low < 0xDC00) || (low > 0xDFFF)) {
+            return Fail("InvalidSurrogatePair");
+          }
+          codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+        }
+        // UTF-8 encode
+        if (codePoint < 0x80) {
+          out += static_cast<char>(codePoint);
+        } else if (codePoint < 0x800) {
+          out += static_cast<char>(0xC0 | (codePoint >> 6));
+          out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else if (codePoint < 0x10000) {
+          out += static_cast<char>(0xE0 | (codePoint >> 12));
+          out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+          out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        } else {
+          out += static_cast<char>(0xF0 | (codePoint >> 18));
+          out += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+          out += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+          out += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        break;
+      }
+      default:
+        return Fail("InvalidEscape");
+    }
+  }
+}
+
+bool JsonSaxReader::ParseLiteral(const char* literal, size_t length)
+{
+  if ((static_cast<size_t>(_end - _cur) < length) || (strncmp(_cur, literal, length) != 0)) {
+    return Fail("InvalidLiteral");
+  }
+  _cur += length;
+  return true;
+}
+
+bool JsonSaxReader::ParseNumber(IJsonSaxHandler& handler)
+{
+  const char* start = _cur;
+  bool isNegative = false;
+  bool isInteger = true;
+
+  if ((_cur != _end) && (*_cur == '-')) {
+    isNegative = true;
+    ++_cur;
+  }
+  const char* digits = _cur;
+  while ((_cur != _end) && (*_cur >= '0') && (*_cur <= '9')) {
+    ++_cur;
+  }
+  if (_cur == digits) {
+    return Fail("InvalidValue");
+  }
+  if ((_cur != _end) && (*_cur == '.')) {
+    isInteger = false;
+    ++_cur;
+    const char* fraction = _cur;
+    while ((_cur != _end) && (*_cur >= '0') && (*_cur <= '9')) {
+      ++_cur;
+    }
+    if (_cur == fraction) {
+      return Fail("InvalidNumber");
+    }
+  }
+  if ((_cur != _end) && ((*_cur == 'e') || (*_cur == 'E'))) {
+    isInteger = false;
+    ++_cur;
+    if ((_cur != _end) && ((*_cur == '+') || (*_cur == '-'))) {
+      ++_cur;
+    }
+    const char* exponent = _cur;
+    while ((_cur != _end) && (*_cur >= '0') && (*_cur <= '9')) {
+      ++_cur;
+    }
+    if (_cur == exponent) {
+      return Fail("InvalidNumber");
+    }
+  }
+
+  // The strto* functions need a terminated string, and the data needn't be
+  char number[64];
+  const size_t length = _cur - start;
+  if (length >= sizeof(number)) {
+    return Fail("NumberTooLong");
+  }
+  memcpy(number, start, length);
+  number[length] = '\0';
+
+  if (isInteger) {
+    errno = 0;
+    if (isNegative) {
+      const long long value = strtoll(number, nullptr, 10);
+      if (errno == 0) {
+        return handler.Int(value) || Stopped();
+      }
+    } else {
+      const unsigned long long value = strtoull(number, nullptr, 10);
+      if (errno == 0) {
+        if (value <= static_cast<unsigned long long>(INT64_MAX)) {
+          return handler.Int(static_cast<int64_t>(value)) || Stopped();
+        }
+        return handler.Uint(value) || Stopped();
+      }
+    }
+    // too big for either, fall back to a double like Json::Reader does
+  }
+
+  return handler.Double(strtod(number, nullptr)) || Stopped();
+}
+
+} // end namespace Util
+} // end namespace Anki
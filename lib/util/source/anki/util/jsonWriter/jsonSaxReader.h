@@ -0,0 +1,103 @@
+/**
+ * File: jsonSaxReader.h
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Event based json reader. Instead of building a Json::Value tree, the document is handed to a
+ *              handler one token at a time, so a loader that only wants a few fields out of a big file keeps
+ *              just those. Accepts what Json::Reader accepts by default, including // and block comments.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Util_JsonWriter_JsonSaxReader_H__
+#define __Util_JsonWriter_JsonSaxReader_H__
+
+#include <stdint.h>
+#include <string>
+
+namespace Anki {
+namespace Util {
+
+// Every callback returns whether to keep reading; returning false stops Parse, which then fails.
+// Strings passed to Key and String are only valid for the duration of the call.
+class IJsonSaxHandler {
+public:
+  virtual ~IJsonSaxHandler() {}
+
+  virtual bool StartObject() = 0;
+  virtual bool EndObject() = 0;
+  virtual bool StartArray() = 0;
+  virtual bool EndArray() = 0;
+  virtual bool Key(const std::string& key) = 0;
+  virtual bool String(const std::string& value) = 0;
+  virtual bool Int(int64_t value) = 0;
+  virtual bool Uint(uint64_t value) = 0;   // only for values too big for Int
+  virtual bool Double(double value) = 0;
+  virtual bool Bool(bool value) = 0;
+  virtual bool Null() = 0;
+};
+
+// Implements every callback as "keep going", for handlers that only care about some of them
+class JsonSaxHandlerBase : public IJsonSaxHandler {
+public:
+  virtual bool StartObject() override { return true; }
+  virtual bool EndObject() override { return true; }
+  virtual bool StartArray() override { return true; }
+  virtual bool EndArray() override { return true; }
+  virtual bool Key(const std::string&) override { return true; }
+  virtual bool String(const std::string&) override { return true; }
+  virtual bool Int(int64_t) override { return true; }
+  virtual bool Uint(uint64_t) override { return true; }
+  virtual bool Double(double) override { return true; }
+  virtual bool Bool(bool) override { return true; }
+  virtual bool Null() override { return true; }
+};
+
+class JsonSaxReader {
+public:
+
+  // Deeper documents are rejected rather than risking the stack
+  static constexpr const uint32_t kMaxDepth = 256;
+
+  // Reads exactly one json value (with optional surrounding whitespace and comments) from data
+  bool Parse(const char* data, size_t size, IJsonSaxHandler& handler);
+  bool Parse(const std::string& data, IJsonSaxHandler& handler) { return Parse(data.data(), data.size(), handler); }
+
+  // Reads the whole file into a buffer kept by the reader, so reading several files reuses it
+  bool ParseFile(const std::string& path, IJsonSaxHandler& handler);
+
+  // Why the last Parse failed, and roughly where, for logging
+  const std::string& GetError() const { return _error; }
+  size_t GetErrorOffset() const { return _errorOffset; }
+
+private:
+
+  bool ParseValue(IJsonSaxHandler& handler, uint32_t depth);
+  bool ParseObject(IJsonSaxHandler& handler, uint32_t depth);
+  bool ParseArray(IJsonSaxHandler& handler, uint32_t depth);
+  bool ParseString(std::string& out);
+  bool ParseNumber(IJsonSaxHandler& handler);
+  bool ParseLiteral(const char* literal, size_t length);
+  bool ParseHex4(uint32_t& out);
+  bool SkipWhitespace();
+  bool Fail(const char* error);
+  bool Stopped();
+
+  const char* _begin = nullptr;
+  const char* _cur = nullptr;
+  const char* _end = nullptr;
+
+  std::string _fileBuffer;
+  std::string _keyBuffer;
+  std::string _stringBuffer;
+  std::string _error;
+  size_t      _errorOffset = 0;
+};
+
+} // end namespace Util
+} // end namespace Anki
+
+#endif // __Util_JsonWriter_JsonSaxReader_H__
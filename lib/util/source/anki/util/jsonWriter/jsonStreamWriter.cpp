@@ -0,0 +1,315 @@
+/**
+ * File: jsonStreamWriter.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Streaming json writer
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "util/jsonWriter/jsonStreamWriter.h"
+#include "util/logging/logging.h"
+#include "json/json.h"
+
+#include <cinttypes>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+namespace Anki {
+namespace Util {
+
+namespace {
+// Same indent as Json::StyledWriter, so files written either way look alike
+constexpr const size_t kIndentSize = 3;
+}
+
+JsonStreamWriter::JsonStreamWriter(std::string& buffer, Style style)
+: _buffer(buffer)
+, _style(style)
+{
+}
+
+void JsonStreamWriter::Fail(const char* what) const
+{
+  PRINT_NAMED_ERROR("JsonStreamWriter.InvalidSequence", "%s", what);
+  throw std::runtime_error(std::string("JsonStreamWriter.InvalidSequence.") + what);
+}
+
+void JsonStreamWriter::NewLine(size_t depth)
+{
+  if (_style == Style::Pretty) {
+    _buffer += '\n';
+    _buffer.append(depth * kIndentSize, ' ');
+  }
+}
+
+void JsonStreamWriter::BeforeValue()
+{
+  if (_containers.empty()) {
+    if (_hasRoot) {
+      Fail("SecondRootValue");
+    }
+    _hasRoot = true;
+    return;
+  }
+
+  Container& container = _containers.back();
+  if (container.isObject) {
+    if (!_expectingValue) {
+      Fail("ValueWithoutKey");
+    }
+    _expectingValue = false;
+    return;
+  }
+
+  if (!container.isEmpty) {
+    _buffer += ',';
+  }
+  container.isEmpty = false;
+  NewLine(_containers.size());
+}
+
+void JsonStreamWriter::StartObject()
+{
+  BeforeValue();
+  _buffer += '{';
+  _containers.push_back({true, true});
+}
+
+void JsonStreamWriter::EndObject()
+{
+  EndContainer(true);
+}
+
+void JsonStreamWriter::StartArray()
+{
+  BeforeValue();
+  _buffer += '[';
+  _containers.push_back({false, true});
+}
+
+void JsonStreamWriter::EndArray()
+{
+  EndContainer(false);
+}
+
+void JsonStreamWriter::EndContainer(bool isObject)
+{
+  if (_containers.empty() || (_containers.back().isObject != isObject)) {
+    Fail(isObject ? "EndObjectOutsideObject" : "EndArrayOutsideArray");
+  }
+  if (_expectingValue) {
+    Fail("KeyWithoutValue");
+  }
+  const bool wasEmpty = _containers.back().isEmpty;
+  _containers.pop_back();
+  if (!wasEmpty) {
+    NewLine(_containers.size());
+  }
+  _buffer += isObject ? '}' : ']';
+  if (_containers.empty() && (_style == Style::Pretty)) {
+    _buffer += '\n';
+  }
+}
+
+void JsonStreamWriter::Key(const char* key)
+{
+  Key(key, strlen(key));
+}
+
+void JsonStreamWriter::Key(const char* key, size_t length)
+{
+  if (_containers.empty() || !_containers.back().isObject || _expectingValue) {
+    Fail("KeyOutsideObject");
+  }
+  Container& container = _containers.back();
+  if (!container.isEmpty) {
+    _buffer += ',';
+  }
+  container.isEmpty = false;
+  NewLine(_containers.size());
+  AppendEscaped(key, length);
+  _buffer += (_style == Style::Pretty) ? " : " : ":";
+  _expectingValue = true;
+}
+
+void JsonStreamWriter::Key(const std::string& key)
+{
+  Key(key.data(), key.size());
+}
+
+void JsonStreamWriter::String(const char* value)
+{
+  String(value, strlen(value));
+}
+
+void JsonStreamWriter::String(const char* value, size_t length)
+{
+  BeforeValue();
+  AppendEscaped(value, length);
+}
+
+void JsonStreamWriter::String(const std::string& value)
+{
+  String(value.data(), value.size());
+}
+
+void JsonStreamWriter::Int(int64_t value)
+{
+  BeforeValue();
+  char number[24];
+  const int length = snprintf(number, sizeof(number), "%" PRId64, value);
+  _buffer.append(number, length);
+}
+
+void JsonStreamWriter::Uint(uint64_t value)
+{
+  BeforeValue();
+  char number[24];
+  const int length = snprintf(number, sizeof(number), "%" PRIu64, value);
+  _buffer.append(number, length);
+}
+
+void JsonStreamWriter::Double(double value)
+{
+  if (!std::isfinite(value)) {
+    Null();
+    return;
+  }
+  BeforeValue();
+  // 17 significant digits round trips any double, as Json::Value's writers do
+  char number[32];
+  int length = snprintf(number, sizeof(number), "%.17g", value);
+  // Keep it a real number when read back, and use '.' whatever the locale
+  bool isInteger = true;
+  for (int i = 0; i < length; ++i) {
+    if (number[i] == ',') {
+      number[i] = '.';
+    }
+    if ((number[i] == '.') || (number[i] == 'e') || (number[i] == 'E')) {
+      isInteger = false;
+    }
+  }
+  _buffer.append(number, length);
+  if (isInteger) {
+    _buffer += ".0";
+  }
+}
+
+void JsonStreamWriter::Bool(bool value)
+{
+  BeforeValue();
+  _buffer += value ? "true" : "false";
+}
+
+void JsonStreamWriter::Null()
+{
+  BeforeValue();
+  _buffer += "null";
+}
+
+void JsonStreamWriter::AppendEscaped(const char* value, size_t length)
+{
+  static const char* const kHexDigits = "0123456789abcdef";
+  _buffer += '"';
+  const char* runStart = value;
+  const char* const end = value + length;
+  for (const char* c = value; c != end; ++c) {
+    const unsigned char ch = static_cast<unsigned char>(*c);
+    const char* escape = nullptr;
+    switch (ch) {
+      case '"':  escape = "\\\""; break;
+      case '\\': escape = "\\\\"; break;
+      case '\b': escape = "\\b";  break;
+      case '\f': escape = "\\f";  break;
+      case '\n': escape = "\\n";  break;
+      case '\r': escape = "\\r";  break;
+      case '\t': escape = "\\t";  break;
+      default:
+        if (ch >= 0x20) {
+          continue;
+        }
+        break;
+    }
+    // Copy the unescaped run before this character in one go
+    _buffer.append(runStart, c - runStart);
+    runStart = c + 1;
+    if (escape != nullptr) {
+      _buffer += escape;
+    } else {
+      const char unicode[] = {'\\', 'u', '0', '0', kHexDigits[ch >> 4], kHexDigits[ch & 0xF]};
+      _buffer.append(unicode, sizeof(unicode));
+    }
+  }
+  _buffer.append(runStart, end - runStart);
+  _buffer += '"';
+}
+
+void JsonStreamWriter::Value(const Json::Value& value)
+{
+  switch (value.type()) {
+    case Json::nullValue:
+      Null();
+      break;
+    case Json::intValue:
+      Int(value.asInt64());
+      break;
+    case Json::uintValue:
+      Uint(value.asUInt64());
+      break;
+    case Json::realValue:
+      Double(value.asDouble());
+      break;
+    case Json::stringValue:
+    {
+      const char* begin = nullptr;
+      const char* end = nullptr;
+      if (value.getString(&begin, &end)) {
+        String(begin, end - begin);
+      } else {
+        String("", 0);
+      }
+      break;
+    }
+    case Json::booleanValue:
+      Bool(value.asBool());
+      break;
+    case Json::arrayValue:
+    {
+      StartArray();
+      const Json::ArrayIndex size = value.size();
+      for (Json::ArrayIndex i = 0; i < size; ++i) {
+        Value(value[i]);
+      }
+      EndArray();
+      break;
+    }
+    case Json::objectValue:
+    {
+      StartObject();
+      for (auto it = value.begin(); it != value.end(); ++it) {
+        const char* nameEnd = nullptr;
+        const char* name = it.memberName(&nameEnd);
+        Key(name, nameEnd - name);
+        Value(*it);
+      }
+      EndObject();
+      break;
+    }
+  }
+}
+
+void JsonStreamWriter::Write(const Json::Value& value, std::string& buffer, Style style)
+{
+  buffer.clear();
+  JsonStreamWriter writer(buffer, style);
+  writer.Value(value);
+}
+
+} // end namespace Util
+} // end namespace Anki
@@ -0,0 +1,100 @@
+/**
+ * File: jsonStreamWriter.h
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Streaming json writer. Values are appended to a caller owned string as they're written, so a
+ *              document is serialized without building a Json::Value tree first, and a buffer kept by the caller
+ *              is reused from one document to the next without reallocating.
+ *
+ *              JsonStreamWriter writer(buffer);
+ *              writer.StartObject();
+ *              writer.Key("name");  writer.String("victor");
+ *              writer.Key("scores"); writer.StartArray(); writer.Int(1); writer.Int(2); writer.EndArray();
+ *              writer.EndObject();
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Util_JsonWriter_JsonStreamWriter_H__
+#define __Util_JsonWriter_JsonStreamWriter_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+namespace Json {
+class Value;
+}
+
+namespace Anki {
+namespace Util {
+
+class JsonStreamWriter {
+public:
+
+  enum class Style {
+    Compact, // no whitespace at all
+    Pretty,  // one member or element per line, indented like Json::StyledWriter
+  };
+
+  // Appends to buffer, which must outlive the writer. Clear it between documents to reuse its capacity.
+  explicit JsonStreamWriter(std::string& buffer, Style style = Style::Compact);
+
+  // Writing a value that doesn't fit where the writer is (a value where a key is expected, ending an array
+  // that wasn't started, a second top level value, ...) logs an error and throws std::runtime_error, like JsonWriter
+
+  void StartObject();
+  void EndObject();
+  void StartArray();
+  void EndArray();
+
+  // Only valid directly inside an object, and must be followed by exactly one value
+  void Key(const char* key);
+  void Key(const char* key, size_t length);
+  void Key(const std::string& key);
+
+  void String(const char* value);
+  void String(const char* value, size_t length);
+  void String(const std::string& value);
+  void Int(int64_t value);
+  void Uint(uint64_t value);
+  void Double(double value); // non finite values are written as null
+  void Bool(bool value);
+  void Null();
+
+  // Streams a whole Json::Value, for callers that have one already
+  void Value(const Json::Value& value);
+
+  // True once a complete top level value has been written
+  bool IsComplete() const { return _containers.empty() && _hasRoot; }
+
+  // Serializes value into buffer (replacing its contents), e.g. to write a document someone else built
+  static void Write(const Json::Value& value, std::string& buffer, Style style = Style::Compact);
+
+private:
+
+  struct Container {
+    bool isObject;
+    bool isEmpty;
+  };
+
+  void BeforeValue();
+  void EndContainer(bool isObject);
+  void NewLine(size_t depth);
+  void AppendEscaped(const char* value, size_t length);
+  [[noreturn]] void Fail(const char* what) const;
+
+  std::string&           _buffer;
+  const Style            _style;
+  std::vector<Container> _containers;
+  bool                   _expectingValue = false; // a key was written, its value hasn't been yet
+  bool                   _hasRoot = false;
+};
+
+} // end namespace Util
+} // end namespace Anki
+
+#endif // __Util_JsonWriter_JsonStreamWriter_H__
@@ -0,0 +1,405 @@
+/**
+* File: asyncLoggerProvider.cpp
+*
+* Author: Victor Rebuild
+* Date:   10/14/2026
+*
+* Description: ILoggerProvider that hands log lines off to a low priority thread
+*
+* Copyright: Victor Rebuild 2026
+*
+**/
+
+#include "util/logging/asyncLoggerProvider.h"
+
+#include "util/threading/threadPriority.h"
+
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+#if defined(__linux__)
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace Anki {
+namespace Util {
+
+namespace {
+
+// how often the drain thread wakes up when nothing asks it to
+const auto kDrainPeriod = std::chrono::milliseconds(20);
+
+// niceness of the drain thread, so it never competes with the threads that log
+const int kDrainThreadNice = 10;
+
+// lines longer than this (counting name, channel and key values) are truncated
+const size_t kMaxRecordSize = 2048;
+
+const uint32_t kPaddingRecord = 0xFFFFFFFF;
+
+std::atomic<uint32_t> sNextProviderId{1};
+
+size_t AlignRecordSize(size_t size)
+{
+  return (size + 7) & ~size_t(7);
+}
+
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Single producer / single consumer ring of variable sized records. A record never wraps around the end of the
+// buffer; if it doesn't fit in what's left, the rest is skipped with a padding record.
+class AsyncLoggerProvider::Ring : private noncopyable
+{
+public:
+  struct RecordHeader {
+    uint32_t size; // including this header, or kPaddingRecord
+    RecordType type;
+    uint8_t numKeyValues;
+    uint16_t unused;
+    uint64_t sequence;
+  };
+
+  explicit Ring(size_t size)
+  : _buffer(size)
+  {
+  }
+
+  // Producer: returns space for a record of the given (aligned) size, or nullptr if the ring is too full
+  uint8_t* Reserve(size_t size)
+  {
+    const size_t head = _head.load(std::memory_order_relaxed);
+    const size_t tail = _tail.load(std::memory_order_acquire);
+    const size_t offset = head % _buffer.size();
+    const size_t untilEnd = _buffer.size() - offset;
+    const size_t padding = (untilEnd < size) ? untilEnd : 0;
+    if (padding + size > _buffer.size() - (head - tail)) {
+      return nullptr;
+    }
+    if (padding > 0) {
+      reinterpret_cast<RecordHeader*>(&_buffer[offset])->size = kPaddingRecord;
+      _head.store(head + padding, std::memory_order_release);
+      return _buffer.data();
+    }
+    return &_buffer[offset];
+  }
+
+  // Producer: publishes the record written into the last Reserve
+  void Commit(size_t size)
+  {
+    _head.store(_head.load(std::memory_order_relaxed) + size, std::memory_order_release);
+  }
+
+  // Consumer: next record, or nullptr if the ring is empty. Stays valid until Pop
+  const RecordHeader* Peek()
+  {
+    while (true) {
+      const size_t tail = _tail.load(std::memory_order_relaxed);
+      if (tail == _head.load(std::memory_order_acquire)) {
+        return nullptr;
+      }
+      const size_t offset = tail % _buffer.size();
+      const auto* header = reinterpret_cast<const RecordHeader*>(&_buffer[offset]);
+      if (header->size != kPaddingRecord) {
+        return header;
+      }
+      _tail.store(tail + (_buffer.size() - offset), std::memory_order_release);
+    }
+  }
+
+  // Consumer: frees the record returned by Peek
+  void Pop(const RecordHeader* header)
+  {
+    _tail.store(_tail.load(std::memory_order_relaxed) + header->size, std::memory_order_release);
+  }
+
+  size_t GetMaxRecordSize() const { return _buffer.size() / 2; }
+
+  std::atomic<uint32_t> numDropped{0};
+
+  // set once the thread that owns this ring has exited
+  std::atomic<bool> isOrphaned{false};
+
+private:
+  std::vector<uint8_t> _buffer;
+  std::atomic<size_t> _head{0};
+  std::atomic<size_t> _tail{0};
+};
+
+namespace {
+
+// the ring this thread logs into, which stays alive until both the thread and the provider are done with it
+struct ThreadRing {
+  uint32_t providerId = 0;
+  std::shared_ptr<void> ring;
+  std::atomic<bool>* isOrphaned = nullptr;
+
+  ~ThreadRing() {
+    if (isOrphaned != nullptr) {
+      *isOrphaned = true;
+    }
+  }
+};
+
+thread_local ThreadRing tThreadRing;
+
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AsyncLoggerProvider::AsyncLoggerProvider(ILoggerProvider* provider, size_t ringSize_bytes)
+: _provider(provider)
+, _ringSize(AlignRecordSize(std::max(ringSize_bytes, 2 * kMaxRecordSize)))
+, _id(sNextProviderId++)
+{
+  _drainThread = std::thread(&AsyncLoggerProvider::DrainThreadLoop, this);
+  SetThreadName(_drainThread.native_handle(), "AsyncLogger");
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AsyncLoggerProvider::~AsyncLoggerProvider()
+{
+  {
+    std::lock_guard<std::mutex> lock(_wakeMutex);
+    _stopping = true;
+  }
+  _wakeCondition.notify_one();
+  _drainThread.join();
+
+  Flush();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::PrintEvent(const char* eventName,
+                                     const std::vector<std::pair<const char*, const char*>>& keyValues,
+                                     const char* eventValue)
+{
+  Push(RecordType::Event, "", eventName, keyValues, eventValue);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::PrintLogE(const char* eventName,
+                                    const std::vector<std::pair<const char*, const char*>>& keyValues,
+                                    const char* eventValue)
+{
+  Push(RecordType::Error, "", eventName, keyValues, eventValue);
+  // get errors out right away rather than on the next period
+  _wakeCondition.notify_one();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::PrintLogW(const char* eventName,
+                                    const std::vector<std::pair<const char*, const char*>>& keyValues,
+                                    const char* eventValue)
+{
+  Push(RecordType::Warning, "", eventName, keyValues, eventValue);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::PrintLogI(const char* channel,
+                                    const char* eventName,
+                                    const std::vector<std::pair<const char*, const char*>>& keyValues,
+                                    const char* eventValue)
+{
+  Push(RecordType::Info, channel, eventName, keyValues, eventValue);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::PrintLogD(const char* channel,
+                                    const char* eventName,
+                                    const std::vector<std::pair<const char*, const char*>>& keyValues,
+                                    const char* eventValue)
+{
+  Push(RecordType::Debug, channel, eventName, keyValues, eventValue);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::Flush()
+{
+  // the wrapped provider flushing (e.g. asserting) while the drain thread writes to it must not wait on itself
+  if (std::this_thread::get_id() != _drainThread.get_id()) {
+    std::lock_guard<std::mutex> lock(_drainMutex);
+    Drain();
+  }
+  _provider->Flush();
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::Push(RecordType type,
+                               const char* channel,
+                               const char* eventName,
+                               const std::vector<std::pair<const char*, const char*>>& keyValues,
+                               const char* eventValue)
+{
+  Ring& ring = GetThreadRing();
+
+  // Record is the header followed by channel, name, key values and value as nul terminated strings. Only the value
+  // gets truncated to fit
+  const size_t numKeyValues = std::min(keyValues.size(), size_t(UINT8_MAX));
+  size_t fixedSize = sizeof(Ring::RecordHeader) + strlen(channel) + strlen(eventName) + 3;
+  for (size_t i = 0; i < numKeyValues; ++i) {
+    fixedSize += strlen(keyValues[i].first) + strlen(keyValues[i].second) + 2;
+  }
+  const size_t maxRecordSize = std::min(kMaxRecordSize, ring.GetMaxRecordSize());
+  if (fixedSize >= maxRecordSize) {
+    ++ring.numDropped;
+    return;
+  }
+  const size_t valueLength = std::min(strlen(eventValue), maxRecordSize - fixedSize);
+  const size_t recordSize = AlignRecordSize(fixedSize + valueLength);
+
+  uint8_t* record = ring.Reserve(recordSize);
+  if (record == nullptr) {
+    ++ring.numDropped;
+    return;
+  }
+
+  auto* header = reinterpret_cast<Ring::RecordHeader*>(record);
+  header->size = static_cast<uint32_t>(recordSize);
+  header->type = type;
+  header->numKeyValues = static_cast<uint8_t>(numKeyValues);
+  header->sequence = _nextSequence++;
+
+  char* strings = reinterpret_cast<char*>(record + sizeof(Ring::RecordHeader));
+  auto append = [&strings](const char* str, size_t length) {
+    memcpy(strings, str, length);
+    strings[length] = '\0';
+    strings += length + 1;
+  };
+  append(channel, strlen(channel));
+  append(eventName, strlen(eventName));
+  for (size_t i = 0; i < numKeyValues; ++i) {
+    append(keyValues[i].first, strlen(keyValues[i].first));
+    append(keyValues[i].second, strlen(keyValues[i].second));
+  }
+  append(eventValue, valueLength);
+
+  ring.Commit(recordSize);
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+AsyncLoggerProvider::Ring& AsyncLoggerProvider::GetThreadRing()
+{
+  if (tThreadRing.providerId != _id) {
+    // first line this thread logs to this provider
+    auto ring = std::make_shared<Ring>(_ringSize);
+    {
+      std::lock_guard<std::mutex> lock(_ringsMutex);
+      _rings.push_back(ring);
+    }
+    _ringsChanged = true;
+
+    if (tThreadRing.isOrphaned != nullptr) {
+      *tThreadRing.isOrphaned = true;
+    }
+    tThreadRing.providerId = _id;
+    tThreadRing.isOrphaned = &ring->isOrphaned;
+    tThreadRing.ring = std::move(ring);
+  }
+  return *static_cast<Ring*>(tThreadRing.ring.get());
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::DrainThreadLoop()
+{
+  #if defined(__linux__)
+  setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), kDrainThreadNice);
+  #endif
+
+  std::unique_lock<std::mutex> wakeLock(_wakeMutex);
+  while (!_stopping) {
+    _wakeCondition.wait_for(wakeLock, kDrainPeriod);
+    wakeLock.unlock();
+    {
+      std::lock_guard<std::mutex> lock(_drainMutex);
+      Drain();
+    }
+    wakeLock.lock();
+  }
+}
+
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void AsyncLoggerProvider::Drain()
+{
+  if (_ringsChanged.exchange(false)) {
+    std::lock_guard<std::mutex> lock(_ringsMutex);
+    // let go of the rings of threads that are gone, once they've been written out
+    _rings.erase(std::remove_if(_rings.begin(), _rings.end(), [](const std::shared_ptr<Ring>& ring) {
+      return ring->isOrphaned && (ring->Peek() == nullptr);
+    }), _rings.end());
+    _drainRings = _rings;
+  }
+
+  std::vector<std::pair<const char*, const char*>> keyValues;
+  while (true) {
+    // write out the oldest line of any ring next, so lines from different threads stay in order
+    Ring* oldestRing = nullptr;
+    const Ring::RecordHeader* oldest = nullptr;
+    for (const auto& ring: _drainRings) {
+      const Ring::RecordHeader* header = ring->Peek();
+      if ((header != nullptr) && ((oldest == nullptr) || (header->sequence < oldest->sequence))) {
+        oldestRing = ring.get();
+        oldest = header;
+      }
+    }
+    if (oldest == nullptr) {
+      break;
+    }
+
+    const char* strings = reinterpret_cast<const char*>(oldest) + sizeof(Ring::RecordHeader);
+    auto next = [&strings]() {
+      const char* str = strings;
+      strings += strlen(str) + 1;
+      return str;
+    };
+    const char* channel = next();
+    const char* eventName = next();
+    keyValues.clear();
+    for (size_t i = 0; i < oldest->numKeyValues; ++i) {
+      const char* key = next();
+      keyValues.emplace_back(key, next());
+    }
+    const char* eventValue = next();
+
+    switch (oldest->type) {
+      case RecordType::Event:   _provider->PrintEvent(eventName, keyValues, eventValue); break;
+      case RecordType::Error:   _provider->PrintLogE(eventName, keyValues, eventValue); break;
+      case RecordType::Warning: _provider->PrintLogW(eventName, keyValues, eventValue); break;
+      case RecordType::Info:    _provider->PrintChanneledLogI(channel, eventName, keyValues, eventValue); break;
+      case RecordType::Debug:   _provider->PrintChanneledLogD(channel, eventName, keyValues, eventValue); break;
+    }
+    oldestRing->Pop(oldest);
+  }
+
+  uint32_t numDropped = 0;
+  for (const auto& ring: _drainRings) {
+    numDropped += ring->numDropped.exchange(0);
+    if (ring->isOrphaned) {
+      _ringsChanged = true;
+    }
+  }
+  if (numDropped > 0) {
+    _numDropped += numDropped;
+    char message[128];
+    snprintf(message, sizeof(message), "Dropped %u log lines because a ring was full (%llu in total)",
+             numDropped, static_cast<unsigned long long>(_numDropped.load()));
+    _provider->PrintLogW("AsyncLoggerProvider.DroppedMessages", {}, message);
+  }
+}
+
+} // namespace Util
+} // namespace Anki
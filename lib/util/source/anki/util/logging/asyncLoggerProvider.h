@@ -0,0 +1,122 @@
+/**
+* File: asyncLoggerProvider.h
+*
+* Author: Victor Rebuild
+* Date:   10/14/2026
+*
+* Description: ILoggerProvider that hands log lines off to a low priority thread, which passes them on to
+*              another provider (e.g. VictorLogger, whose writes to the android log can block).
+*
+*              Each logging thread gets its own lock-free ring, so a log call only copies the already formatted
+*              line into it and returns. A line that doesn't fit because the ring is full is dropped and counted,
+*              and the count is logged once the ring has room again. Lines keep their order across threads.
+*              Flush() (e.g. on asserts) drains everything before returning.
+*
+* Copyright: Victor Rebuild 2026
+*
+**/
+
+#ifndef __Util_Logging_AsyncLoggerProvider_H__
+#define __Util_Logging_AsyncLoggerProvider_H__
+
+#include "util/logging/iLoggerProvider.h"
+#include "util/helpers/noncopyable.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <vector>
+
+namespace Anki {
+namespace Util {
+
+class AsyncLoggerProvider : public ILoggerProvider, private noncopyable {
+public:
+
+  // Doesn't take ownership of provider, which must outlive this. ringSize_bytes is per logging thread
+  explicit AsyncLoggerProvider(ILoggerProvider* provider, size_t ringSize_bytes = kDefaultRingSize_bytes);
+  virtual ~AsyncLoggerProvider();
+
+  virtual void PrintEvent(const char* eventName,
+                          const std::vector<std::pair<const char*, const char*>>& keyValues,
+                          const char* eventValue) override;
+  virtual void PrintLogE(const char* eventName,
+                         const std::vector<std::pair<const char*, const char*>>& keyValues,
+                         const char* eventValue) override;
+  virtual void PrintLogW(const char* eventName,
+                         const std::vector<std::pair<const char*, const char*>>& keyValues,
+                         const char* eventValue) override;
+
+  // Writes out everything logged so far (from any thread), then flushes the wrapped provider
+  virtual void Flush() override;
+
+  // Total number of lines dropped because a ring was full
+  uint64_t GetNumDroppedMessages() const { return _numDropped; }
+
+  static constexpr size_t kDefaultRingSize_bytes = 32 * 1024;
+
+protected:
+
+  virtual void PrintLogI(const char* channel,
+                         const char* eventName,
+                         const std::vector<std::pair<const char*, const char*>>& keyValues,
+                         const char* eventValue) override;
+  virtual void PrintLogD(const char* channel,
+                         const char* eventName,
+                         const std::vector<std::pair<const char*, const char*>>& keyValues,
+                         const char* eventValue) override;
+
+private:
+
+  enum class RecordType : uint8_t {
+    Event,
+    Error,
+    Warning,
+    Info,
+    Debug
+  };
+
+  class Ring;
+
+  ILoggerProvider* const _provider;
+  const size_t _ringSize;
+  const uint32_t _id;
+
+  // order of lines across all the rings
+  std::atomic<uint64_t> _nextSequence{0};
+  std::atomic<uint64_t> _numDropped{0};
+
+  // rings of all threads that have logged, guarded by _ringsMutex
+  std::mutex _ringsMutex;
+  std::vector<std::shared_ptr<Ring>> _rings;
+  std::atomic<bool> _ringsChanged{false};
+
+  // only one thread drains at a time (the drain thread, or whoever calls Flush)
+  std::mutex _drainMutex;
+  std::vector<std::shared_ptr<Ring>> _drainRings;
+
+  std::mutex _wakeMutex;
+  std::condition_variable _wakeCondition;
+  bool _stopping = false;
+  std::thread _drainThread;
+
+  void Push(RecordType type,
+            const char* channel,
+            const char* eventName,
+            const std::vector<std::pair<const char*, const char*>>& keyValues,
+            const char* eventValue);
+  Ring& GetThreadRing();
+
+  void DrainThreadLoop();
+
+  // Must hold _drainMutex
+  void Drain();
+};
+
+} // namespace Util
+} // namespace Anki
+
+#endif // __Util_Logging_AsyncLoggerProvider_H__
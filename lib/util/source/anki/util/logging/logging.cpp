@@ -533,6 +533,7 @@ void sDebugBreakOnError()
 void sAbort()
 {
   LogError("Util.Logging.Abort", {}, "Application abort");
+  sLogFlush();
 
   // Add breakpoint here to inspect application state */
   abort();
@@ -13,10 +13,16 @@
 #include "util/logging/rollingFileLogger.h"
 #include "util/dispatchQueue/dispatchQueue.h"
 #include "util/fileUtils/fileUtils.h"
-#include "assert.h"
 
-#include <sstream>
+#include <algorithm>
+#include <atomic>
+#include <fcntl.h>
 #include <iomanip>
+#include <sstream>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include <ctime>
 #include <time.h> // Needed for the POSIX thread-safe version of local_time and put_time
@@ -30,6 +36,75 @@ namespace Util {
   
 const char * const RollingFileLogger::kDefaultFileExtension = ".log";
 
+constexpr std::size_t RollingFileLogger::kSegmentSize;
+constexpr std::size_t RollingFileLogger::kCommitSize;
+constexpr uint32_t RollingFileLogger::kCommitInterval_ms;
+
+// A mapped piece of the current file. Commits may still be pending on the queue after the logger has moved on to the
+// next segment (or file), so segments are shared with them and unmapped when the last one is done.
+class RollingFileLogger::Segment : noncopyable {
+public:
+  Segment(char* data, std::size_t fileOffset, std::size_t numBytesWritten)
+  : _data(data)
+  , _fileOffset(fileOffset)
+  , _numBytesWritten(numBytesWritten)
+  , _numBytesCommitted(numBytesWritten)
+  {
+  }
+
+  ~Segment()
+  {
+    munmap(_data, kSegmentSize);
+  }
+
+  std::size_t GetFileOffset() const { return _fileOffset; }
+  bool IsFull() const { return _numBytesWritten == kSegmentSize; }
+  std::size_t GetNumUncommittedBytes() const { return _numBytesWritten - _numBytesCommitted; }
+
+  // Copies as much as fits, returns how much that was. Only called by the logger, with its mutex held
+  std::size_t Append(const char* data, std::size_t size)
+  {
+    const std::size_t written = _numBytesWritten;
+    const std::size_t numBytes = std::min(size, kSegmentSize - written);
+    memcpy(_data + written, data, numBytes);
+    _numBytesWritten = written + numBytes;
+    return numBytes;
+  }
+
+  // Returns true if the caller should schedule a commit (one isn't already scheduled)
+  bool MarkCommitScheduled() { return !_commitScheduled.exchange(true); }
+  bool MarkTimedCommitScheduled() { return !_timedCommitScheduled.exchange(true); }
+
+  // Writes out everything appended so far, from any thread
+  void Commit()
+  {
+    std::lock_guard<std::mutex> lock(_commitMutex);
+    _commitScheduled = false;
+    _timedCommitScheduled = false;
+
+    const std::size_t end = _numBytesWritten;
+    const std::size_t committed = _numBytesCommitted;
+    if (end <= committed) {
+      return;
+    }
+    static const std::size_t kPageSize = (std::size_t) sysconf(_SC_PAGESIZE);
+    const std::size_t begin = committed - (committed % kPageSize);
+    if (msync(_data + begin, end - begin, MS_SYNC) != 0) {
+      LOGD("Error committing log segment: %s !!", strerror(errno));
+    }
+    _numBytesCommitted = end;
+  }
+
+private:
+  char* const              _data;
+  const std::size_t        _fileOffset;
+  std::atomic<std::size_t> _numBytesWritten;
+  std::atomic<std::size_t> _numBytesCommitted;
+  std::atomic<bool>        _commitScheduled{false};
+  std::atomic<bool>        _timedCommitScheduled{false};
+  std::mutex               _commitMutex;
+};
+
 RollingFileLogger::RollingFileLogger(Dispatch::Queue* queue, const std::string& baseDirectory, const std::string& extension, std::size_t maxFileSize)
 : _dispatchQueue(queue)
 , _baseDirectory(baseDirectory)
@@ -45,71 +120,168 @@ RollingFileLogger::RollingFileLogger(Dispatch::create_queue_t, const std::string
   _ownedQueue.create("RFL");
   _dispatchQueue = _ownedQueue.get();
 }
-  
+
 RollingFileLogger::~RollingFileLogger()
 {
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    // Commit the last of it here rather than leave it to a queue that may be about to go away
+    _dispatchQueue = nullptr;
+    CloseLogFile();
+  }
   _ownedQueue.reset();
-  _currentLogFileHandle.close();
 }
 
-void RollingFileLogger::ExecuteBlock(const std::function<void ()>& block)
+void RollingFileLogger::Write(std::string message)
 {
-  if (nullptr != _dispatchQueue)
+  std::lock_guard<std::mutex> lock(_mutex);
+  WriteInternal(message.data(), message.size());
+}
+
+void RollingFileLogger::WriteInternal(const char* data, std::size_t size)
+{
+  // If there's no file yet or we've run out of space, open a new one
+  if (_fd < 0 || (size + _numBytesWritten) > _maxFileSize)
   {
-    Dispatch::Async(_dispatchQueue, block);
+    RollLogFile();
   }
-  else
+
+  if (_fd < 0)
+  {
+    return;
+  }
+
+  while (size > 0)
   {
-    block();
+    if ((!_segment || _segment->IsFull()) && !MapNextSegment())
+    {
+      return;
+    }
+    const std::size_t numBytes = _segment->Append(data, size);
+    data += numBytes;
+    size -= numBytes;
+    _numBytesWritten += numBytes;
   }
+
+  ScheduleCommit();
 }
 
-void RollingFileLogger::Write(std::string message)
+bool RollingFileLogger::MapNextSegment()
 {
-  ExecuteBlock([this, message = std::move(message)] {
-    WriteInternal(message);
-  });
-}
+  // Segments are aligned to their size in the file, the first one may start partway in if the file already existed
+  const std::size_t fileOffset = _segment ? (_segment->GetFileOffset() + kSegmentSize)
+                                          : (_numBytesWritten - (_numBytesWritten % kSegmentSize));
+  if (_segment)
+  {
+    CommitSegment(_segment);
+    _segment.reset();
+  }
 
+  // The file is grown a segment at a time, so at most one segment is left unused if the process dies
+  if (ftruncate(_fd, (off_t) (fileOffset + kSegmentSize)) != 0)
+  {
+    LOGD("Error growing log file: %s !!", strerror(errno));
+    return false;
+  }
+
+  void* data = mmap(nullptr, kSegmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, (off_t) fileOffset);
+  if (data == MAP_FAILED)
+  {
+    LOGD("Error mapping log file: %s !!", strerror(errno));
+    return false;
+  }
+
+  _segment = std::make_shared<Segment>((char*) data, fileOffset, _numBytesWritten - fileOffset);
+  return true;
+}
 
-// Note that WriteInternal and everything it calls will occur on another thread.
-void RollingFileLogger::WriteInternal(const std::string& message)
+void RollingFileLogger::ScheduleCommit()
 {
-  auto messageSize = message.length();
-  // If file handle is closed or we've run out of space, open a new one
-  if (!_currentLogFileHandle.is_open() || (messageSize + _numBytesWritten) > _maxFileSize)
+  if (!_segment)
   {
-    RollLogFile();
-    _numBytesWritten = 0;
+    return;
   }
-  
-  assert(_currentLogFileHandle);
-  
-  if(!_currentLogFileHandle.is_open())
+
+  const bool commitNow = (_segment->GetNumUncommittedBytes() >= kCommitSize);
+  if (nullptr == _dispatchQueue)
   {
+    // Nowhere to put off the commit to, so it's done by the writer once enough has piled up
+    if (commitNow)
+    {
+      _segment->Commit();
+    }
     return;
   }
-  
-  _currentLogFileHandle << message;
-  _currentLogFileHandle.flush();
-  _numBytesWritten += messageSize;
+
+  std::shared_ptr<Segment> segment = _segment;
+  if (commitNow)
+  {
+    if (segment->MarkCommitScheduled())
+    {
+      Dispatch::Async(_dispatchQueue, [segment] {
+        segment->Commit();
+      });
+    }
+  }
+  else if (segment->MarkTimedCommitScheduled())
+  {
+    Dispatch::After(_dispatchQueue, std::chrono::milliseconds(kCommitInterval_ms), [segment] {
+      segment->Commit();
+    });
+  }
 }
-  
-void RollingFileLogger::RollLogFile()
+
+void RollingFileLogger::CommitSegment(const std::shared_ptr<Segment>& segment)
 {
-  if (_currentLogFileHandle.is_open())
+  if (nullptr != _dispatchQueue)
+  {
+    Dispatch::Async(_dispatchQueue, [segment] {
+      segment->Commit();
+    });
+  }
+  else
   {
-    _currentLogFileHandle.close();
+    segment->Commit();
   }
+}
+
+void RollingFileLogger::CloseLogFile()
+{
+  if (_segment)
+  {
+    CommitSegment(_segment);
+    _segment.reset();
+  }
+
+  if (_fd >= 0)
+  {
+    // Drop the part of the last segment that wasn't used
+    if (ftruncate(_fd, (off_t) _numBytesWritten) != 0)
+    {
+      LOGD("Error trimming log file: %s !!", strerror(errno));
+    }
+    close(_fd);
+    _fd = -1;
+  }
+}
+
+void RollingFileLogger::RollLogFile()
+{
+  CloseLogFile();
+
   std::string nextFilename = GetNextFileName();
-  _currentLogFileHandle.open(nextFilename, std::ofstream::out | std::ofstream::app);
-  
-  if (!_currentLogFileHandle)
+  _fd = open(nextFilename.c_str(), O_RDWR | O_CREAT, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+
+  if (_fd < 0)
   {
     LOGD("Error getting handle for file %s: %s !!", nextFilename.c_str(), strerror(errno));
-  } else {
-    LOGO("New log file created '%s'", nextFilename.c_str());
+    return;
   }
+
+  // Append to a file of the same name, as a stream opened for append would have
+  struct stat st;
+  _numBytesWritten = (fstat(_fd, &st) == 0) ? (std::size_t) st.st_size : 0;
+  LOGO("New log file created '%s'", nextFilename.c_str());
 }
 
 std::string RollingFileLogger::GetNextFileName()
@@ -157,24 +329,28 @@ std::chrono::system_clock::time_point RollingFileLogger::GetSystemClockTimePoint
   return systemClockNow + timeDiff;
 }
   
-void RollingFileLogger::FlushInternal()
-{
-  if (_currentLogFileHandle.is_open()) {
-    _currentLogFileHandle.flush();
-  }
-}
-  
 void RollingFileLogger::Flush()
 {
+  std::shared_ptr<Segment> segment;
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    segment = _segment;
+  }
+  if (!segment)
+  {
+    return;
+  }
+
   if (nullptr != _dispatchQueue)
   {
-    Dispatch::Sync(_dispatchQueue, [this] {
-      FlushInternal();
+    // Queued behind the commits of segments that were already finished
+    Dispatch::Sync(_dispatchQueue, [segment] {
+      segment->Commit();
     });
   }
   else
   {
-    FlushInternal();
+    segment->Commit();
   }
 }
 
@@ -4,7 +4,12 @@
 * Author: Lee Crippen
 * Created: 3/29/2016
 *
-* Description: 
+* Description: Writes messages to a series of timestamped files, starting a new one when maxFileSize is reached.
+*              The current file is mapped into memory a segment at a time, so Write is a memcpy on the calling
+*              thread. Written bytes are committed to storage in groups, once enough have piled up or some time
+*              after the first uncommitted write, on the dispatch queue if there is one. If the process dies, what
+*              was written is still in the page cache and reaches the file; the unused part of the last segment
+*              may be left as zeros at the end.
 *
 * Copyright: Anki, inc. 2016
 *
@@ -15,8 +20,10 @@
 #include "util/dispatchQueue/dispatchQueue.h"
 #include "util/helpers/noncopyable.h"
 
-#include <fstream>
+#include <cstdint>
 #include <cstdlib>
+#include <memory>
+#include <mutex>
 #include <string>
 
 namespace Anki {
@@ -28,6 +35,12 @@ public:
 
   static constexpr std::size_t  kDefaultMaxFileSize = 1024 * 1024 * 20;
   static const char * const     kDefaultFileExtension;
+
+  // How much of a file is mapped at a time
+  static constexpr std::size_t  kSegmentSize = 256 * 1024;
+  // Uncommitted bytes that trigger a commit right away, and how long after a write it's committed otherwise
+  static constexpr std::size_t  kCommitSize = 64 * 1024;
+  static constexpr uint32_t     kCommitInterval_ms = 5000;
   
   // use an existing queue for the file logger
   RollingFileLogger(Dispatch::Queue* queue, const std::string& baseDirectory, const std::string& extension = kDefaultFileExtension, std::size_t maxFileSize = kDefaultMaxFileSize);
@@ -35,7 +48,10 @@ public:
   RollingFileLogger(Dispatch::create_queue_t, const std::string& baseDirectory, const std::string& extension = kDefaultFileExtension, std::size_t maxFileSize = kDefaultMaxFileSize);
   virtual ~RollingFileLogger();
   
+  // Thread safe
   void Write(std::string message);
+
+  // Commits everything written so far before returning
   void Flush();
   
   static std::string GetDateTimeString(const ClockType::time_point& time);
@@ -43,20 +59,28 @@ public:
   static std::chrono::system_clock::time_point GetSystemClockTimePoint(const ClockType::time_point& time);
   
 private:
-  void ExecuteBlock(const std::function<void()>& block);
-  
+  class Segment;
+
   Dispatch::Queue*      _dispatchQueue;
   Dispatch::QueueHandle _ownedQueue;
   std::string       _baseDirectory;
   std::string       _extension;
-  std::string       _currentFileName;
   std::size_t       _maxFileSize;
+
+  // Current file, guarded by _mutex
+  std::mutex        _mutex;
+  int               _fd = -1;
   std::size_t       _numBytesWritten = 0;
-  std::ofstream     _currentLogFileHandle;
-  
-  void WriteInternal(const std::string& message);
-  void FlushInternal();
+  std::shared_ptr<Segment> _segment;
+
+  // Must hold _mutex
+  void WriteInternal(const char* data, std::size_t size);
+  bool MapNextSegment();
+  void ScheduleCommit();
+  void CommitSegment(const std::shared_ptr<Segment>& segment);
   void RollLogFile();
+  void CloseLogFile();
+
   std::string GetNextFileName();
 };
 
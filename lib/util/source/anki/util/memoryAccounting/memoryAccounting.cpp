@@ -0,0 +1,253 @@
+/**
+ * File: memoryAccounting
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "memoryAccounting.h"
+
+#include "json/json.h"
+#include "util/console/consoleInterface.h"
+#include "util/logging/DAS.h"
+#include "util/logging/logging.h"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+
+#define LOG_CHANNEL "MemoryAccounting"
+
+namespace Anki {
+namespace Util {
+
+namespace {
+
+  constexpr size_t kNumTags = static_cast<size_t>(MemoryTag::Count);
+
+  struct Counter
+  {
+    std::atomic<size_t> bytes{0};
+    std::atomic<size_t> highWaterMark{0};
+  };
+
+  std::array<Counter, kNumTags> sCounters;
+  Counter sTotal;
+
+  // High water marks as of the last ReportNewHighWaterMarks
+  std::mutex sReportMutex;
+  std::array<size_t, kNumTags> sReportedHighWaterMarks{};
+  size_t sReportedTotalHighWaterMark = 0;
+
+  void RaiseHighWaterMark(std::atomic<size_t>& highWaterMark, size_t numBytes)
+  {
+    size_t prev = highWaterMark.load(std::memory_order_relaxed);
+    while ((prev < numBytes) &&
+           !highWaterMark.compare_exchange_weak(prev, numBytes, std::memory_order_relaxed)) {
+    }
+  }
+
+  void AddToCounter(Counter& counter, size_t numBytes)
+  {
+    const size_t newBytes = counter.bytes.fetch_add(numBytes, std::memory_order_relaxed) + numBytes;
+    RaiseHighWaterMark(counter.highWaterMark, newBytes);
+  }
+
+  size_t ToKB(size_t numBytes)
+  {
+    return (numBytes + 1023) / 1024;
+  }
+
+#if REMOTE_CONSOLE_ENABLED
+  void LogMemoryAccounting(ConsoleFunctionContextRef context)
+  {
+    MemoryAccounting::LogStats();
+  }
+  CONSOLE_FUNC(LogMemoryAccounting, "Memory");
+
+  void ResetMemoryHighWaterMarks(ConsoleFunctionContextRef context)
+  {
+    MemoryAccounting::ResetHighWaterMarks();
+  }
+  CONSOLE_FUNC(ResetMemoryHighWaterMarks, "Memory");
+#endif
+
+}
+
+const char* MemoryTagToString(MemoryTag tag)
+{
+  switch (tag) {
+    case MemoryTag::ImageCache:       return "ImageCache";
+    case MemoryTag::CannedAnimations: return "CannedAnimations";
+    case MemoryTag::Sprites:          return "Sprites";
+    case MemoryTag::MemoryMap:        return "MemoryMap";
+    case MemoryTag::BlockWorld:       return "BlockWorld";
+    case MemoryTag::FaceAlbum:        return "FaceAlbum";
+    case MemoryTag::AudioBanks:       return "AudioBanks";
+    case MemoryTag::NeuralNets:       return "NeuralNets";
+    case MemoryTag::VisionScratch:    return "VisionScratch";
+    case MemoryTag::Count:            break;
+  }
+  return "Invalid";
+}
+
+// ================================================================================
+// MemoryAccounting
+
+size_t MemoryAccounting::GetBytes(MemoryTag tag)
+{
+  return sCounters[static_cast<size_t>(tag)].bytes.load(std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::GetHighWaterMark(MemoryTag tag)
+{
+  return sCounters[static_cast<size_t>(tag)].highWaterMark.load(std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::GetTotalBytes()
+{
+  return sTotal.bytes.load(std::memory_order_relaxed);
+}
+
+size_t MemoryAccounting::GetTotalHighWaterMark()
+{
+  return sTotal.highWaterMark.load(std::memory_order_relaxed);
+}
+
+void MemoryAccounting::Add(MemoryTag tag, size_t numBytes)
+{
+  AddToCounter(sCounters[static_cast<size_t>(tag)], numBytes);
+  AddToCounter(sTotal, numBytes);
+}
+
+void MemoryAccounting::Subtract(MemoryTag tag, size_t numBytes)
+{
+  // Accounts never give back more than they added, so these can't wrap
+  sCounters[static_cast<size_t>(tag)].bytes.fetch_sub(numBytes, std::memory_order_relaxed);
+  sTotal.bytes.fetch_sub(numBytes, std::memory_order_relaxed);
+}
+
+void MemoryAccounting::GetStatsAsJson(Json::Value& outJson)
+{
+  outJson = Json::Value(Json::objectValue);
+  outJson["bytes"] = (Json::UInt64) GetTotalBytes();
+  outJson["highWaterMark"] = (Json::UInt64) GetTotalHighWaterMark();
+
+  Json::Value& tags = outJson["tags"];
+  tags = Json::Value(Json::arrayValue);
+  for (size_t i = 0; i < kNumTags; ++i) {
+    const MemoryTag tag = static_cast<MemoryTag>(i);
+    Json::Value tagJson;
+    tagJson["tag"] = MemoryTagToString(tag);
+    tagJson["bytes"] = (Json::UInt64) GetBytes(tag);
+    tagJson["highWaterMark"] = (Json::UInt64) GetHighWaterMark(tag);
+    tags.append(tagJson);
+  }
+}
+
+void MemoryAccounting::LogStats()
+{
+  LOG_INFO("MemoryAccounting.Total", "%zu kB (high water %zu kB)",
+           ToKB(GetTotalBytes()), ToKB(GetTotalHighWaterMark()));
+  for (size_t i = 0; i < kNumTags; ++i) {
+    const MemoryTag tag = static_cast<MemoryTag>(i);
+    if (GetHighWaterMark(tag) == 0) {
+      // Not used in this process
+      continue;
+    }
+    LOG_INFO("MemoryAccounting.Tag", "%s: %zu kB (high water %zu kB)",
+             MemoryTagToString(tag), ToKB(GetBytes(tag)), ToKB(GetHighWaterMark(tag)));
+  }
+}
+
+bool MemoryAccounting::ReportNewHighWaterMarks()
+{
+  std::lock_guard<std::mutex> lock(sReportMutex);
+
+  bool hasNewHighWaterMark = false;
+  std::array<size_t, kNumTags> highWaterMarks;
+  for (size_t i = 0; i < kNumTags; ++i) {
+    highWaterMarks[i] = GetHighWaterMark(static_cast<MemoryTag>(i));
+    hasNewHighWaterMark |= (highWaterMarks[i] > sReportedHighWaterMarks[i]);
+  }
+  const size_t totalHighWaterMark = GetTotalHighWaterMark();
+  hasNewHighWaterMark |= (totalHighWaterMark > sReportedTotalHighWaterMark);
+
+  if (!hasNewHighWaterMark) {
+    return false;
+  }
+
+  LogStats();
+
+  // Every tag in use as "tag:current/highWater" in kB, which is short enough to fit a DAS string
+  std::string summary;
+  size_t topTag = 0;
+  for (size_t i = 0; i < kNumTags; ++i) {
+    if (highWaterMarks[i] == 0) {
+      continue;
+    }
+    if (highWaterMarks[i] > highWaterMarks[topTag]) {
+      topTag = i;
+    }
+    const MemoryTag tag = static_cast<MemoryTag>(i);
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%s%s:%zu/%zu", summary.empty() ? "" : ",",
+             MemoryTagToString(tag), ToKB(GetBytes(tag)), ToKB(highWaterMarks[i]));
+    summary += buffer;
+  }
+
+  DASMSG(memory_accounting_high_water, "memory_accounting.high_water",
+         "Sent when a subsystem's or the process's accounted memory reaches a new high");
+  DASMSG_SET(s1, MemoryTagToString(static_cast<MemoryTag>(topTag)), "Tag with the highest high water mark");
+  DASMSG_SET(s2, summary, "Every tag in use as tag:current/highWater (kB)");
+  DASMSG_SET(i1, ToKB(GetTotalBytes()), "Total accounted memory (kB)");
+  DASMSG_SET(i2, ToKB(totalHighWaterMark), "Total high water mark (kB)");
+  DASMSG_SET(i3, ToKB(highWaterMarks[topTag]), "High water mark of the top tag (kB)");
+  DASMSG_SEND();
+
+  sReportedHighWaterMarks = highWaterMarks;
+  sReportedTotalHighWaterMark = totalHighWaterMark;
+  return true;
+}
+
+void MemoryAccounting::ResetHighWaterMarks()
+{
+  for (auto& counter : sCounters) {
+    counter.highWaterMark.store(counter.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+  }
+  sTotal.highWaterMark.store(sTotal.bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+  std::lock_guard<std::mutex> lock(sReportMutex);
+  sReportedHighWaterMarks.fill(0);
+  sReportedTotalHighWaterMark = 0;
+}
+
+// ================================================================================
+// MemoryAccount
+
+void MemoryAccount::Set(size_t numBytes)
+{
+  if (numBytes > _numBytes) {
+    MemoryAccounting::Add(_tag, numBytes - _numBytes);
+  }
+  else if (numBytes < _numBytes) {
+    MemoryAccounting::Subtract(_tag, _numBytes - numBytes);
+  }
+  _numBytes = numBytes;
+}
+
+void MemoryAccount::Add(size_t numBytes)
+{
+  Set(_numBytes + numBytes);
+}
+
+void MemoryAccount::Subtract(size_t numBytes)
+{
+  Set((numBytes < _numBytes) ? (_numBytes - numBytes) : 0);
+}
+
+} // namespace Util
+} // namespace Anki
@@ -0,0 +1,124 @@
+/**
+ * File: memoryAccounting
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Process-wide byte counts of the big memory consumers, with high water marks, so we can see where a
+ *              process's RSS goes and budget it by subsystem. Rather than hooking the allocator, each subsystem
+ *              owns a MemoryAccount and tells it how much it's holding whenever it loads or frees data. The counts
+ *              are the subsystems' own estimates of their large buffers, not exact heap usage.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+
+#ifndef __Util_MemoryAccounting_MemoryAccounting_H__
+#define __Util_MemoryAccounting_MemoryAccounting_H__
+
+
+#include "util/helpers/noncopyable.h"
+#include <cstddef>
+#include <stdint.h>
+
+
+namespace Json {
+  class Value;
+}
+
+namespace Anki {
+namespace Util {
+
+
+// Keep in sync with MemoryTagToString
+enum class MemoryTag : uint8_t
+{
+  ImageCache,
+  CannedAnimations,
+  Sprites,
+  MemoryMap,
+  BlockWorld,
+  FaceAlbum,
+  AudioBanks,
+  NeuralNets,
+  VisionScratch,
+  Count
+};
+
+const char* MemoryTagToString(MemoryTag tag);
+
+
+// ================================================================================
+// MemoryAccounting
+
+class MemoryAccounting
+{
+public:
+
+  // Totals of every MemoryAccount with the tag. Safe to read from any thread
+  static size_t GetBytes(MemoryTag tag);
+  static size_t GetHighWaterMark(MemoryTag tag);
+
+  // All tags together. The total's high water mark is the most held at once, which can be well below the sum of the
+  // individual high water marks
+  static size_t GetTotalBytes();
+  static size_t GetTotalHighWaterMark();
+
+  // Current bytes and high water mark of the total and every tag
+  static void GetStatsAsJson(Json::Value& outJson);
+
+  // Logs every tag with its high water mark
+  static void LogStats();
+
+  // If any high water mark has grown since the last call, logs the stats and sends them to DAS. Meant to be called
+  // periodically, so DAS only hears about new peaks. Returns true if it reported
+  static bool ReportNewHighWaterMarks();
+
+  // Resets the high water marks to the current counts (for tests, and measuring a single activity from the console)
+  static void ResetHighWaterMarks();
+
+private:
+
+  friend class MemoryAccount;
+
+  static void Add(MemoryTag tag, size_t numBytes);
+  static void Subtract(MemoryTag tag, size_t numBytes);
+};
+
+
+// ================================================================================
+// MemoryAccount
+//
+// One subsystem instance's share of its tag. Whatever is still counted is given back on destruction. Not thread
+// safe, owners update it wherever they already update the data it accounts for
+
+class MemoryAccount : private noncopyable
+{
+public:
+
+  explicit MemoryAccount(MemoryTag tag) : _tag(tag) { }
+  ~MemoryAccount() { Set(0); }
+
+  // Replaces the count, for owners that can add up what they hold
+  void Set(size_t numBytes);
+
+  // For owners that track loads and frees one at a time. Subtracting more than is counted clamps to zero
+  void Add(size_t numBytes);
+  void Subtract(size_t numBytes);
+
+  size_t GetBytes() const { return _numBytes; }
+  MemoryTag GetTag() const { return _tag; }
+
+private:
+
+  const MemoryTag _tag;
+  size_t          _numBytes = 0;
+};
+
+
+} // namespace Util
+} // namespace Anki
+
+
+#endif // __Util_MemoryAccounting_MemoryAccounting_H__
@@ -7,9 +7,14 @@
 
 #include "messageProfiler.h"
 
+#include "json/json.h"
+#include "util/logging/DAS.h"
 #include "util/logging/logging.h"
 #include "util/console/consoleInterface.h"
 
+#include <algorithm>
+#include <numeric>
+
 #define LOG_CHANNEL "MessageProfiler"
 
 namespace Anki {
@@ -19,32 +24,65 @@ namespace Util {
 
   CONSOLE_VAR_RANGED(float, kMessageProfilerDuration, "CpuProfiler", 0.f, 0.f, 60.f*60.f);
 
+  // How many of the top tags (by bytes) are logged for each window
+  CONSOLE_VAR_RANGED(int, kMessageProfilerNumTagsToLog, "CpuProfiler", 10, 1, 256);
+
+  namespace {
+    std::function<void(const Json::Value&)> sWebVizCallback;
+  }
+
   // ================================================================================
   // MessageProfiler
-  
-  MessageProfiler::MessageProfiler(const std::string& prefix)
+
+  MessageProfiler::MessageProfiler(const std::string& prefix, TagNameFunc tagNameFunc, int maxTags)
   : m_prefix(prefix)
-  , m_start(clock())
+  , m_tagNameFunc(tagNameFunc)
+  , m_start(Clock::now())
   , m_started(false)
-  , m_failed(false) {
-    memset(m_count, 0, sizeof(m_count));
+  , m_failed(false)
+  , m_stats(std::max(maxTags, 0) + 1) {
   }
 
-  void MessageProfiler::Update(int msg, size_t size) {
-    m_started = true;
+  MessageProfiler::TagStats& MessageProfiler::GetTagStats(int msg) {
+    if ((msg >= 0) && (msg < (int)m_stats.size() - 1)) {
+      return m_stats[msg];
+    }
+    return m_stats.back();
+  }
 
-    if (msg < kMaxMessages) {
-      ++m_count[msg];
-      m_size[msg] = size;
+  std::string MessageProfiler::GetTagName(int msg) const {
+    if (msg == (int)m_stats.size() - 1) {
+      return "other";
+    }
+    const char* name = (m_tagNameFunc != nullptr) ? m_tagNameFunc(msg) : nullptr;
+    if (name != nullptr) {
+      return name;
     }
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "0x%02X", msg);
+    return buffer;
+  }
 
-    clock_t end = clock();
-    float duration = ((float)(end - m_start)) / CLOCKS_PER_SEC;
-    if (kMessageProfilerDuration > 0.0f && duration >= kMessageProfilerDuration) {
-      Report();
+  void MessageProfiler::Update(int msg, size_t size, int64_t serializeTime_us) {
+    m_started = true;
+
+    TagStats& stats = GetTagStats(msg);
+    ++stats.count;
+    stats.bytes += size;
+    stats.serializeTime_us += serializeTime_us;
+
+    if (kMessageProfilerDuration > 0.0f) {
+      const float duration = std::chrono::duration<float>(Clock::now() - m_start).count();
+      if (duration >= kMessageProfilerDuration) {
+        Report();
+      }
     }
   }
 
+  void MessageProfiler::AddHandlerTime(int msg, int64_t handlerTime_us) {
+    GetTagStats(msg).handlerTime_us += handlerTime_us;
+  }
+
   void MessageProfiler::ReportOnFailure() {
     if (m_started) {
       // have recieved at least one good message
@@ -58,41 +96,136 @@ namespace Util {
       // failed, prevent repeat messages
       return;
     }
-  
-    clock_t end = clock();
-    float duration = ((float)(end - m_start)) / CLOCKS_PER_SEC;
+
+    const Clock::time_point end = Clock::now();
+    float duration = std::chrono::duration<float>(end - m_start).count();
     if (duration == 0.0f) {
       // avoid division by zero later
       duration = 1.0f;
     }
 
+    // Chattiest tags first
+    std::vector<int> order(m_stats.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [this](int a, int b) { return m_stats[a].bytes > m_stats[b].bytes; });
+
     LOG_INFO(m_prefix.c_str(), "duration: %0.2f", duration);
-    for(int i = 0; i < kMaxMessages; ++i) {
-      if (m_count[i] > 0) {
-        LOG_INFO(m_prefix.c_str(), "Tag: 0x%02X %0.2f messages/s = %zu bytes/message (%0.2f bytes/sec)",
-                 i,
-                 m_count[i] / duration,
-                 m_size[i],
-                 m_count[i] * m_size[i] / duration);
+    const int numToLog = std::min((int)order.size(), (int)kMessageProfilerNumTagsToLog);
+    for (int i = 0; i < numToLog; ++i) {
+      const TagStats& stats = m_stats[order[i]];
+      if (stats.count == 0) {
+        break;
       }
+      LOG_INFO(m_prefix.c_str(), "Tag: %s %0.2f messages/s = %0.1f bytes/message (%0.2f bytes/sec) "
+               "serialize %0.1f us/message, handler %0.1f us/message",
+               GetTagName(order[i]).c_str(),
+               stats.count / duration,
+               (float)stats.bytes / stats.count,
+               stats.bytes / duration,
+               (float)stats.serializeTime_us / stats.count,
+               (float)stats.handlerTime_us / stats.count);
     }
-    
+
+    {
+      std::lock_guard<std::mutex> lock(m_windowMutex);
+      m_windowStats = m_stats;
+      m_windowDuration = duration;
+    }
+
+    SendWindowToDAS(duration);
+
+    if (sWebVizCallback) {
+      Json::Value json;
+      GetWindowStatsAsJson(json);
+      sWebVizCallback(json);
+    }
+
     m_start = end;
-    memset(m_count, 0, sizeof(m_count));
+    std::fill(m_stats.begin(), m_stats.end(), TagStats());
+  }
+
+  void MessageProfiler::SendWindowToDAS(float duration) const {
+    uint64_t totalBytes = 0;
+    uint32_t totalCount = 0;
+    int64_t totalHandlerTime_us = 0;
+    int topTag = 0;
+    for (int i = 0; i < (int)m_stats.size(); ++i) {
+      totalBytes += m_stats[i].bytes;
+      totalCount += m_stats[i].count;
+      totalHandlerTime_us += m_stats[i].handlerTime_us;
+      if (m_stats[i].bytes > m_stats[topTag].bytes) {
+        topTag = i;
+      }
+    }
+    if (totalCount == 0) {
+      return;
+    }
+
+    DASMSG(message_profiler_window, "message_profiler.window",
+           "Message traffic on one link over the last kMessageProfilerDuration seconds");
+    DASMSG_SET(s1, m_prefix, "Link and direction");
+    DASMSG_SET(s2, GetTagName(topTag), "Tag with the most bytes");
+    DASMSG_SET(i1, (int64_t) (totalCount / duration), "Messages per second");
+    DASMSG_SET(i2, (int64_t) (totalBytes / duration), "Bytes per second");
+    DASMSG_SET(i3, (int64_t) (m_stats[topTag].bytes / duration), "Bytes per second of the top tag");
+    DASMSG_SET(i4, totalHandlerTime_us, "Total handler time in microseconds");
+    DASMSG_SEND();
+  }
+
+  void MessageProfiler::GetWindowStatsAsJson(Json::Value& outJson) const {
+    std::lock_guard<std::mutex> lock(m_windowMutex);
+
+    outJson = Json::Value(Json::objectValue);
+    outJson["name"] = m_prefix;
+    outJson["duration_s"] = m_windowDuration;
+
+    Json::Value& tags = outJson["tags"];
+    tags = Json::Value(Json::arrayValue);
+    if (m_windowDuration <= 0.0f) {
+      return;
+    }
+    for (int i = 0; i < (int)m_windowStats.size(); ++i) {
+      const TagStats& stats = m_windowStats[i];
+      if (stats.count == 0) {
+        continue;
+      }
+      Json::Value tag;
+      tag["tag"] = GetTagName(i);
+      tag["count"] = stats.count;
+      tag["bytes"] = (Json::UInt64) stats.bytes;
+      tag["messagesPerSec"] = stats.count / m_windowDuration;
+      tag["bytesPerSec"] = stats.bytes / m_windowDuration;
+      tag["serializeTime_us"] = (Json::Int64) stats.serializeTime_us;
+      tag["handlerTime_us"] = (Json::Int64) stats.handlerTime_us;
+      tags.append(tag);
+    }
+  }
+
+  void MessageProfiler::SendToWebVizCallback(const std::function<void(const Json::Value&)>& callback) {
+    sWebVizCallback = callback;
   }
 
 #else // ANKI_MESSAGE_PROFILER_ENABLED
 
-  MessageProfiler::MessageProfiler(const std::string& /*prefix*/) {
+  MessageProfiler::MessageProfiler(const std::string& /*prefix*/, TagNameFunc /*tagNameFunc*/, int /*maxTags*/) {
+  }
+
+  void MessageProfiler::Update(int /*msg*/, size_t /*size*/, int64_t /*serializeTime_us*/) {
   }
 
-  void MessageProfiler::Update(int /*msg*/, size_t /*size*/) {
+  void MessageProfiler::AddHandlerTime(int /*msg*/, int64_t /*handlerTime_us*/) {
   }
 
   void MessageProfiler::ReportOnFailure() {
   }
 
-  void Report() {
+  void MessageProfiler::Report() {
+  }
+
+  void MessageProfiler::GetWindowStatsAsJson(Json::Value& /*outJson*/) const {
+  }
+
+  void MessageProfiler::SendToWebVizCallback(const std::function<void(const Json::Value&)>& /*callback*/) {
   }
 
 #endif // ANKI_MESSAGE_PROFILER_ENABLED
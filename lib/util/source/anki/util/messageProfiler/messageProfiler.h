@@ -1,6 +1,10 @@
 /**
  * File: messageProfiler
  *
+ * Description: Per-tag message counts, bytes, serialization time and handler time for one direction of a
+ * message link (e.g. engine to robot), reported every kMessageProfilerDuration seconds (console var, 0 = off).
+ * Each completed window is logged, summarized to DAS, and passed to the webViz callback if one is set.
+ *
  * Copyright: Anki, Inc. 2018
  *
  **/
@@ -15,44 +19,114 @@
 #ifndef __Util_MessageProfiler_MessageProfiler_H__
 #define __Util_MessageProfiler_MessageProfiler_H__
 
+#include <chrono>
+#include <functional>
+#include <mutex>
+#include <stdint.h>
 #include <string>
-#include <time.h>
+#include <vector>
+
+namespace Json {
+  class Value;
+}
 
 namespace Anki {
 namespace Util {
 
-#if defined(ANKI_MESSAGE_PROFILER_ENABLED)
+#if ANKI_MESSAGE_PROFILER_ENABLED
 
   // ================================================================================
   // MessageProfiler
-  
+
   class MessageProfiler {
   public:
-    MessageProfiler(const std::string& prefix);
-    void Update(int msg, size_t size);
+    // Returns a printable name for a tag, or nullptr if it has none
+    using TagNameFunc = const char* (*)(int tag);
+
+    static const constexpr int kDefaultMaxTags = 256;
+
+    // Tags from maxTags up are counted together as "other"
+    explicit MessageProfiler(const std::string& prefix, TagNameFunc tagNameFunc = nullptr, int maxTags = kDefaultMaxTags);
+
+    // Counts one message. serializeTime_us is the time spent packing and sending it (or receiving and unpacking
+    // it), when the caller measures that
+    void Update(int msg, size_t size, int64_t serializeTime_us = 0);
+
+    // Adds time spent handling a received message
+    void AddHandlerTime(int msg, int64_t handlerTime_us);
+
     void ReportOnFailure();
     void Report();
 
+    // The last completed window, or an empty one if none has completed yet
+    void GetWindowStatsAsJson(Json::Value& outJson) const;
+
+    // Called with each completed window of any profiler
+    static void SendToWebVizCallback(const std::function<void(const Json::Value&)>& callback);
+
+    // Adds the lifetime of the scope as handler time for msg
+    class ScopedHandlerTimer {
+    public:
+      ScopedHandlerTimer(MessageProfiler& profiler, int msg)
+      : m_profiler(profiler), m_msg(msg), m_start(std::chrono::steady_clock::now()) {}
+      ~ScopedHandlerTimer() {
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        m_profiler.AddHandlerTime(m_msg, std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+      }
+    private:
+      MessageProfiler& m_profiler;
+      const int m_msg;
+      const std::chrono::steady_clock::time_point m_start;
+    };
+
   private:
-    static const constexpr int kMaxMessages = 256;
+    using Clock = std::chrono::steady_clock;
+
+    struct TagStats {
+      uint32_t count = 0;
+      uint64_t bytes = 0;
+      int64_t serializeTime_us = 0;
+      int64_t handlerTime_us = 0;
+    };
+
+    TagStats& GetTagStats(int msg);
+    std::string GetTagName(int msg) const;
+    void SendWindowToDAS(float duration) const;
 
     std::string m_prefix;
-    clock_t m_start;
+    TagNameFunc m_tagNameFunc;
+    Clock::time_point m_start;
     bool m_started;
     bool m_failed;
 
-    int m_count[kMaxMessages];
-    size_t m_size[kMaxMessages];
+    // One per tag, plus "other" at the end
+    std::vector<TagStats> m_stats;
+
+    // Last completed window, read from other threads for webViz
+    mutable std::mutex m_windowMutex;
+    std::vector<TagStats> m_windowStats;
+    float m_windowDuration = 0.0f;
   };
 
 #else // ANKI_MESSAGE_PROFILER_ENABLED
 
   class MessageProfiler {
   public:
-    MessageProfiler(const std::string& prefix);
-    void Update(int msg, size_t size);
+    using TagNameFunc = const char* (*)(int tag);
+    static const constexpr int kDefaultMaxTags = 256;
+
+    explicit MessageProfiler(const std::string& prefix, TagNameFunc tagNameFunc = nullptr, int maxTags = kDefaultMaxTags);
+    void Update(int msg, size_t size, int64_t serializeTime_us = 0);
+    void AddHandlerTime(int msg, int64_t handlerTime_us);
     void ReportOnFailure();
     void Report();
+    void GetWindowStatsAsJson(Json::Value& outJson) const;
+    static void SendToWebVizCallback(const std::function<void(const Json::Value&)>& callback);
+
+    class ScopedHandlerTimer {
+    public:
+      ScopedHandlerTimer(MessageProfiler&, int) {}
+    };
   };
 
 #endif // ANKI_MESSAGE_PROFILER_ENABLED
@@ -32,6 +32,10 @@ public:
   
   virtual bool IsSatisfied(QuestEngine& questEngine, std::tm& eventTime) const = 0;
 
+  // Looks up the counters of the events this condition reads in questEngine ahead of time, so IsSatisfied()
+  // doesn't have to find them by name every time the engine evaluates it
+  virtual void BindEvents(QuestEngine& questEngine) {}
+
 };
   
 } // namespace QuestEngine
@@ -68,6 +68,19 @@ bool CombinationCondition::IsSatisfied(QuestEngine& questEngine, std::tm& eventT
   }
   return triggered;
 }
+
+void CombinationCondition::BindEvents(QuestEngine& questEngine)
+{
+  if( _conditionA != nullptr ) {
+    _conditionA->BindEvents(questEngine);
+  }
+  if( _conditionB != nullptr ) {
+    _conditionB->BindEvents(questEngine);
+  }
+  for (auto& condition : _conditions) {
+    condition->BindEvents(questEngine);
+  }
+}
   
 
 } // namespace StatEngine
@@ -44,6 +44,8 @@ public:
   void AddCondition(AbstractCondition* condition);
   
   bool IsSatisfied(QuestEngine& questEngine, std::tm& eventTime) const override;
+
+  void BindEvents(QuestEngine& questEngine) override;
   
 private:
   
@@ -23,13 +23,21 @@ CountThresholdCondition::CountThresholdCondition(CountThresholdOperator countOpe
 , _targetValue(targetValue)
 , _operator(countOperator)
 , _triggerKey(triggerKey)
+, _boundEngine(nullptr)
+, _eventIndex(0)
 {
 }
+
+void CountThresholdCondition::BindEvents(QuestEngine& questEngine)
+{
+  _eventIndex = questEngine.GetEventIndex(_triggerKey);
+  _boundEngine = &questEngine;
+}
   
 bool CountThresholdCondition::IsSatisfied(QuestEngine& questEngine, std::tm& eventTime) const
 {
-  const std::string& eventName = _triggerKey;
-  uint32_t count = questEngine.GetEventCount(eventName);
+  const uint32_t count = (&questEngine == _boundEngine) ? questEngine.GetEventCount(_eventIndex)
+                                                         : questEngine.GetEventCount(_triggerKey);
   bool isTriggered = false;
   switch (_operator) {
     case CountThresholdOperatorEquals:
@@ -37,6 +37,8 @@ public:
   ~CountThresholdCondition() override {}
   
   bool IsSatisfied(QuestEngine& questEngine, std::tm& eventTime) const override;
+
+  void BindEvents(QuestEngine& questEngine) override;
   
 private:
   
@@ -46,6 +48,11 @@ private:
   
   std::string _triggerKey;
 
+  // Counter of _triggerKey in the engine BindEvents() was last called with
+  const QuestEngine* _boundEngine;
+
+  size_t _eventIndex;
+
 };
  
 } // namespace QuestEngine
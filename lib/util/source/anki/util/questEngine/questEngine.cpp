@@ -51,26 +51,45 @@ QuestEngine::~QuestEngine()
 
 void QuestEngine::IncrementEvent(const std::string& eventName, const uint16_t count)
 {
-  _countMap[eventName] += count;
-  ProcessRules(eventName);
+  const size_t eventIndex = GetEventIndex(eventName);
+  _eventCounts[eventIndex] += count;
+  ProcessRules(eventIndex);
 }
 
 void QuestEngine::ResetEvent(const std::string& eventName)
 {
-  _countMap.erase(eventName);
+  const auto it = _eventIndexMap.find(eventName);
+  if( it != _eventIndexMap.end() ) {
+    _eventCounts[it->second] = 0;
+  }
 }
 
 uint32_t QuestEngine::GetEventCount(const std::string& eventName)
 {
-  const auto it = _countMap.find(eventName);
+  const auto it = _eventIndexMap.find(eventName);
 
-  if( it != _countMap.end() ) {
-    return it->second;
+  if( it != _eventIndexMap.end() ) {
+    return _eventCounts[it->second];
   }
 
   return 0;
 }
 
+size_t QuestEngine::GetEventIndex(const std::string& eventName)
+{
+  const auto it = _eventIndexMap.find(eventName);
+  if( it != _eventIndexMap.end() ) {
+    return it->second;
+  }
+
+  const size_t eventIndex = _eventNames.size();
+  _eventIndexMap.emplace(eventName, eventIndex);
+  _eventNames.push_back(eventName);
+  _eventCounts.push_back(0);
+  _eventRules.emplace_back();
+  return eventIndex;
+}
+
 void QuestEngine::Load()
 {
   std::vector<uint8_t> body;
@@ -97,10 +116,11 @@ void QuestEngine::Load()
       QuestStore store;
       store.Unpack(buffer+1, body.size()-1);
 
-      _countMap.clear();
+      // Counters already bound to conditions keep their indices
+      std::fill(_eventCounts.begin(), _eventCounts.end(), 0);
       for (auto eventIterator = store.eventStats.begin(); eventIterator != store.eventStats.end(); ++eventIterator) {
         const std::string& eventName = eventIterator->eventName;
-        _countMap[eventName] = eventIterator->count;
+        _eventCounts[GetEventIndex(eventName)] = eventIterator->count;
       }
 
       _notices.clear();
@@ -135,8 +155,10 @@ void QuestEngine::Load()
 void QuestEngine::Save()
 {
   QuestStore store;
-  for (auto eventIterator = _countMap.begin(); eventIterator != _countMap.end(); ++eventIterator) {
-    store.eventStats.emplace_back(eventIterator->first, eventIterator->second);
+  for (size_t eventIndex = 0; eventIndex < _eventCounts.size(); ++eventIndex) {
+    if( _eventCounts[eventIndex] != 0 ) {
+      store.eventStats.emplace_back(_eventNames[eventIndex], _eventCounts[eventIndex]);
+    }
   }
   for (auto noticeIterator = _notices.begin(); noticeIterator != _notices.end(); ++noticeIterator) {
     const QuestNotice& questNotice = *noticeIterator;
@@ -185,17 +207,9 @@ bool QuestEngine::AddRule(QuestRule* rule)
     _rules.push_back(rule);
     _ruleIds.insert(ruleId);
     for (auto eventNamesIterator = eventNames.begin(); eventNamesIterator != eventNames.end(); ++eventNamesIterator) {
-      const auto eventRulesIterator = _eventRulesMap.find(*eventNamesIterator);
-      if( eventRulesIterator == _eventRulesMap.end() ) {
-        std::vector<QuestRule*> eventRules;
-        eventRules.push_back(rule);
-        _eventRulesMap.emplace( *eventNamesIterator,std::move(eventRules) );
-      }else{
-        std::vector<QuestRule*>& eventRules = eventRulesIterator->second;
-        eventRules.push_back(rule);
-      }
-
+      _eventRules[GetEventIndex(*eventNamesIterator)].push_back(rule);
     }
+    rule->BindEvents(*this);
     _addedSignal->emit(*rule);
     return true;
   }
@@ -208,6 +222,10 @@ void QuestEngine::ClearRules()
     delete *it;
   }
   _rules.clear();
+  _ruleIds.clear();
+  for (auto& eventRules : _eventRules) {
+    eventRules.clear();
+  }
 }
 
 const std::vector<Util::QuestEngine::QuestRule*> QuestEngine::GetAvailableRules(std::tm &time)
@@ -257,37 +275,37 @@ void QuestEngine::AppendTriggerHistory(const std::string& ruleId, const time_t t
   ruleHistory.push_back(triggerTime);
 }
 
-void QuestEngine::ProcessRules(const std::string& eventName)
+void QuestEngine::ProcessRules(const size_t eventIndex)
 {
-  auto eventRulesIterator = _eventRulesMap.find(eventName);
-  std::time_t now = std::time(nullptr);
-  std::tm localNow = *std::localtime(&now);
-  if( eventRulesIterator != _eventRulesMap.end() ) {
-    _eventSignal->emit(eventName);
-    const std::vector<QuestRule*>& rules = eventRulesIterator->second;
-    for (auto it = rules.begin(); it != rules.end(); ++it) {
-      bool isRepeatable = (*it)->IsRepeatable();
-      bool hasTriggered = HasTriggered((*it)->GetId());
+  if( !_eventRules[eventIndex].empty() ) {
+    std::time_t now = std::time(nullptr);
+    std::tm localNow = *std::localtime(&now);
+    _eventSignal->emit(_eventNames[eventIndex]);
+    // Looked up by index every time, since signal handlers and actions may add events, which moves the lists
+    for (size_t ruleIndex = 0; ruleIndex < _eventRules[eventIndex].size(); ++ruleIndex) {
+      QuestRule* rule = _eventRules[eventIndex][ruleIndex];
+      bool isRepeatable = rule->IsRepeatable();
+      bool hasTriggered = HasTriggered(rule->GetId());
       if( !isRepeatable && hasTriggered ) {
         continue;
       }
 
-      bool isAvailable = (*it)->IsAvailable(*this, localNow);
+      bool isAvailable = rule->IsAvailable(*this, localNow);
       if( !isAvailable ) {
-        _availableSignal->emit(**it, false);
+        _availableSignal->emit(*rule, false);
         continue;
       }
-      _availableSignal->emit(**it, true);
+      _availableSignal->emit(*rule, true);
 
-      bool isTriggered = (*it)->IsTriggered(*this, localNow);
+      bool isTriggered = rule->IsTriggered(*this, localNow);
       if( !isTriggered ) {
         continue;
       }
-      _triggeredSignal->emit(**it);
+      _triggeredSignal->emit(*rule);
 
-      AbstractAction* action = (*it)->GetAction();
+      AbstractAction* action = rule->GetAction();
       action->PerformAction(*this);
-      AppendTriggerHistory((*it)->GetId(), now);
+      AppendTriggerHistory(rule->GetId(), now);
     }
   }
 }
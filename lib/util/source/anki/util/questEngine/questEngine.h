@@ -20,6 +20,7 @@
 #include <map>
 #include <vector>
 #include <set>
+#include <unordered_map>
 #include <ctime>
 
 namespace Anki {
@@ -53,6 +54,12 @@ public:
   void ResetEvent(const std::string& eventName);
   
   uint32_t GetEventCount(const std::string& eventName);
+
+  // Index of the event's counter, adding one if the event hasn't been seen yet. Indices stay valid for the
+  // lifetime of the engine, so conditions can look their counters up once instead of by name on every event.
+  size_t GetEventIndex(const std::string& eventName);
+
+  uint32_t GetEventCount(size_t eventIndex) const { return _eventCounts[eventIndex]; }
   
   
   void AddNotice(const QuestNotice& QuestNotice);
@@ -90,12 +97,18 @@ private:
   
   void AppendTriggerHistory(const std::string& ruleId, const std::time_t triggerTime);
   
-  void ProcessRules(const std::string& eventName);
+  void ProcessRules(const size_t eventIndex);
   
 
-  std::map<std::string,uint32_t> _countMap;
+  // One counter per event ever seen, indexed by GetEventIndex(). A count of zero isn't saved.
+  std::unordered_map<std::string,size_t> _eventIndexMap;
+  
+  std::vector<std::string> _eventNames;
+  
+  std::vector<uint32_t> _eventCounts;
   
-  std::map<std::string,std::vector<QuestRule*>> _eventRulesMap;
+  // Rules to evaluate when each event fires, indexed like the counters
+  std::vector<std::vector<QuestRule*>> _eventRules;
   
   std::set<QuestNotice> _notices;
   
@@ -66,6 +66,16 @@ bool QuestRule::IsTriggered(QuestEngine& questEngine, std::tm& eventTime)
   }
   return isTriggered;
 }
+
+void QuestRule::BindEvents(QuestEngine& questEngine)
+{
+  if( _availabilityCondition != nullptr ) {
+    _availabilityCondition->BindEvents(questEngine);
+  }
+  if( _triggerCondition != nullptr ) {
+    _triggerCondition->BindEvents(questEngine);
+  }
+}
   
   
 } // namespace QuestEngine
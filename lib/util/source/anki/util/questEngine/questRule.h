@@ -55,6 +55,9 @@ public:
   bool IsRepeatable() const { return _isRepeatable; };
   
   bool IsTriggered(QuestEngine& questEngine, std::tm& eventTime);
+
+  // Binds both conditions to the counters of the events they read in questEngine
+  void BindEvents(QuestEngine& questEngine);
   
   void SetRepeatable(bool repeatable) { _isRepeatable = repeatable; };
 
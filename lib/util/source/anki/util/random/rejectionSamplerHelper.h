@@ -19,6 +19,7 @@
 #include "util/helpers/templateHelpers.h"
 #include "util/random/rejectionSamplerHelper_fwd.h"
 
+#include <algorithm>
 #include <functional>
 #include <list>
 #include <vector>
@@ -88,15 +89,24 @@ public:
   // If no conditions exist, this returns true for any sample!
   bool Evaluate( RandomGenerator& rng, const T& sample );
   
+  // Batch version of Evaluate. Sets accepted[i] if samples[i] should be accepted and returns the number accepted.
+  // Conditions run one at a time over the whole batch, each seeing only the samples all earlier conditions
+  // accepted, so conditions with per-call setup (or a batch implementation) pay for it once per batch.
+  size_t EvaluateBatch( RandomGenerator& rng, const std::vector<T>& samples, std::vector<bool>& accepted );
+  
   // Generate N accepted samples by supplying a generator of initial samples. The generator will be
   // run a maximum of maxAttempts times before returning whatever samples have been accepted so far,
   // which may be less than N, so be sure to check the return size.
+  // Samples are generated and evaluated batchSize at a time (see EvaluateBatch). Generation stops after
+  // the batch in which the Nth sample is accepted, so a larger batch may run the generator a few more times
+  // than needed.
   // If no conditions exist, this returns true for any sample!
   using GeneratorFunc = std::function<T()>;
   std::vector<T> Generate( RandomGenerator& rng,
                            unsigned int N,
                            const GeneratorFunc& generatorFunc,
-                           unsigned int maxAttempts = 1000 );
+                           unsigned int maxAttempts = 1000,
+                           unsigned int batchSize = 1 );
   
   // If you need to verify that there are conditions remaining after removing some, use this.
   size_t GetNumConditions() { return _conditions.size(); }
@@ -108,6 +118,7 @@ private:
                                         bool scoped );
   
   bool EvaluateInternal( RandomGenerator& rng, const T& sample ) const;
+  size_t EvaluateBatchInternal( RandomGenerator& rng, const std::vector<T>& samples, std::vector<bool>& accepted ) const;
   
   void PruneOutOfScopeConditions();
   
@@ -141,6 +152,16 @@ public:
   virtual ~RejectionSamplingCondition() = default;
   // should return true if the sample T is to be accepted, false otherwise
   virtual bool operator()(const T&) = 0; // non-const for flexibility, like a mutable lambda
+  
+  // Clears accepted[i] for each samples[i] this condition rejects. Samples already rejected are skipped. Override
+  // if the condition can evaluate many samples more cheaply than calling operator() on each.
+  virtual void EvaluateBatch(const std::vector<T>& samples, std::vector<bool>& accepted) {
+    for( size_t i=0; i<samples.size(); ++i ) {
+      if( accepted[i] && !operator()( samples[i] ) ) {
+        accepted[i] = false;
+      }
+    }
+  }
 };
   
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -243,12 +264,25 @@ bool RejectionSamplerHelper<T,B>::Evaluate( RandomGenerator& rng, const T& sampl
   return EvaluateInternal( rng, sample );
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename T, bool B>
+size_t RejectionSamplerHelper<T,B>::EvaluateBatch( RandomGenerator& rng,
+                                                   const std::vector<T>& samples,
+                                                   std::vector<bool>& accepted )
+{
+  if( _hasScopedConditions ) {
+    PruneOutOfScopeConditions();
+  }
+  return EvaluateBatchInternal( rng, samples, accepted );
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template <typename T, bool B>
 std::vector<T> RejectionSamplerHelper<T,B>::Generate( RandomGenerator& rng,
                                                       unsigned int N,
                                                       const RejectionSamplerHelper<T,B>::GeneratorFunc& generatorFunc,
-                                                      unsigned int maxAttempts )
+                                                      unsigned int maxAttempts,
+                                                      unsigned int batchSize )
 {
   std::vector<T> acceptedSamples;
   acceptedSamples.reserve( N );
@@ -257,14 +291,42 @@ std::vector<T> RejectionSamplerHelper<T,B>::Generate( RandomGenerator& rng,
     PruneOutOfScopeConditions();
   }
   
-  unsigned int numAccepted = 0;
-  for( unsigned int i=0; i<maxAttempts; ++i ) {
-    T sample = generatorFunc();
-    if( Evaluate(rng, sample) ) {
-      acceptedSamples.push_back( std::move(sample) );
-      ++numAccepted;
-      if( numAccepted >= N ) {
-        break;
+  if( batchSize <= 1 ) {
+    unsigned int numAccepted = 0;
+    for( unsigned int i=0; i<maxAttempts; ++i ) {
+      T sample = generatorFunc();
+      if( Evaluate(rng, sample) ) {
+        acceptedSamples.push_back( std::move(sample) );
+        ++numAccepted;
+        if( numAccepted >= N ) {
+          break;
+        }
+      }
+    }
+    return acceptedSamples;
+  }
+  
+  std::vector<T> batch;
+  batch.reserve( batchSize );
+  std::vector<bool> accepted;
+  unsigned int numAttempts = 0;
+  while( (numAttempts < maxAttempts) && (acceptedSamples.size() < N) ) {
+    const unsigned int numToGenerate = std::min( batchSize, maxAttempts - numAttempts );
+    batch.clear();
+    for( unsigned int i=0; i<numToGenerate; ++i ) {
+      batch.push_back( generatorFunc() );
+    }
+    numAttempts += numToGenerate;
+    
+    if( EvaluateBatchInternal(rng, batch, accepted) == 0 ) {
+      continue;
+    }
+    for( size_t i=0; i<batch.size(); ++i ) {
+      if( accepted[i] ) {
+        acceptedSamples.push_back( std::move(batch[i]) );
+        if( acceptedSamples.size() >= N ) {
+          break;
+        }
       }
     }
   }
@@ -284,6 +346,24 @@ bool RejectionSamplerHelper<T,B>::EvaluateInternal( RandomGenerator& rng, const
   return true;
 }
   
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename T, bool B>
+size_t RejectionSamplerHelper<T,B>::EvaluateBatchInternal( RandomGenerator& rng,
+                                                           const std::vector<T>& samples,
+                                                           std::vector<bool>& accepted ) const
+{
+  accepted.assign( samples.size(), true );
+  size_t numAccepted = samples.size();
+  for( const auto& condition : _conditions ) {
+    if( numAccepted == 0 ) {
+      break;
+    }
+    condition.cond->EvaluateBatch( samples, accepted );
+    numAccepted = std::count( accepted.begin(), accepted.end(), true );
+  }
+  return numAccepted;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 template <typename T, bool B>
 void RejectionSamplerHelper<T,B>::PruneOutOfScopeConditions()
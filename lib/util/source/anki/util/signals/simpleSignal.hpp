@@ -10,10 +10,12 @@
 #define __SIMPLE_SIGNAL_HH__
 
 #include "simpleSignal_fwd.h"
+#include "slotFunction.h"
 
 #include <unistd.h>
 #include <assert.h>
 #include <stdint.h>
+#include <algorithm>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -56,7 +58,7 @@ namespace Signal {
     template<class Collector, class R, class... Args>
     struct CollectorInvocation<Collector, R (Args...)> {
       inline bool
-      invoke (Collector &collector, const std::function<R (Args...)> &cbf, Args... args)
+      invoke (Collector &collector, const SlotFunction<R (Args...)> &cbf, const Args&... args)
       {
         return collector (cbf (args...));
       }
@@ -66,157 +68,142 @@ namespace Signal {
     template<class Collector, class... Args>
     struct CollectorInvocation<Collector, void (Args...)> {
       inline bool
-      invoke (Collector &collector, const std::function<void (Args...)> &cbf, Args... args)
+      invoke (Collector &collector, const SlotFunction<void (Args...)> &cbf, const Args&... args)
       {
         cbf (args...); return collector();
       }
     };
 
-    class HandleBase
-    {
-    public:
-      virtual ~HandleBase() {}
-      virtual void Unlink() = 0;
-    };
-
+    /// ScopedHandleContainer unsubscribes its handler when destroyed, unless the signal is already gone.
     class ScopedHandleContainer
     {
     public:
-      ScopedHandleContainer(HandleBase* handle) : _handle(handle) {}
-      ~ScopedHandleContainer() { _handle->Unlink(); delete _handle; }
+      typedef void (*UnsubscribeFunction) (void* signal, uint64_t slotId);
+      ScopedHandleContainer(void* signal, uint64_t slotId, UnsubscribeFunction unsubscribe, const std::shared_ptr<void>& heartbeat)
+        : _signal(signal)
+        , _slotId(slotId)
+        , _unsubscribe(unsubscribe)
+        , _heartbeatRef(heartbeat)
+      {}
+      ~ScopedHandleContainer() { if (_heartbeatRef.lock()) { _unsubscribe(_signal, _slotId); } }
+      ScopedHandleContainer(const ScopedHandleContainer&) = delete;
+      ScopedHandleContainer& operator=(const ScopedHandleContainer&) = delete;
     private:
-      HandleBase* _handle;
+      void* _signal;
+      uint64_t _slotId;
+      UnsubscribeFunction _unsubscribe;
+      std::weak_ptr<void> _heartbeatRef;
     };
 
     /// ProtoSignal template specialised for the callback signature and collector.
     template<class Collector, class R, class... Args>
     class ProtoSignal<R (Args...), Collector> : private CollectorInvocation<Collector, R (Args...)> {
     protected:
-      typedef std::function<R (Args...)> CbFunction;
-      typedef typename CbFunction::result_type Result;
+      typedef SlotFunction<R (Args...)> CbFunction;
+      typedef R Result;
       typedef typename Collector::CollectorResult CollectorResult;
     private:
-      /// ProtoHandle maintains a handle to this signal
-      class ProtoHandle : public HandleBase {
-      public:
-        virtual void Unlink() {
-          if (_heartbeatRef.lock()) {
-            _subject->Unsubscribe(_link);
-          }
-        }
-        ProtoHandle(ProtoSignal<R (Args...), Collector>* signalOwner, size_t signalId, std::shared_ptr<void> heartbeat)
-          : _subject(signalOwner)
-          , _link(signalId)
-          , _heartbeatRef(heartbeat)
-        {}
-        virtual ~ProtoHandle() {}
-      private:
-        ProtoSignal<R (Args...), Collector>* _subject;
-        size_t _link;
-        std::weak_ptr<void> _heartbeatRef;
+      /// Slot holds one handler. Slots are kept in subscription order, so ids are ascending.
+      struct Slot {
+        Slot (uint64_t slotId, CbFunction&& cbf) : id (slotId), removed (false), function (std::move (cbf)) {}
+        uint64_t   id;
+        bool       removed; // tombstone, left in place until the outermost emission is done with it
+        CbFunction function;
       };
 
-      /// SignalLink implements a doubly-linked ring with ref-counted nodes containing the signal handlers.
-      struct SignalLink {
-        SignalLink *next, *prev;
-        CbFunction  function;
-        int         ref_count;
-        explicit    SignalLink (const CbFunction &cbf) : next (NULL), prev (NULL), function (cbf), ref_count (1) {}
-        /*dtor*/   ~SignalLink ()           { assert (ref_count == 0); }
-        void        incref     ()           { ref_count += 1; assert (ref_count > 0); }
-        void        decref     ()           { ref_count -= 1; if (!ref_count) delete this; else assert (ref_count > 0); }
-        void
-        unlink ()
+      /// EmissionScope keeps slots_ from being reshaped while any emission (including recursive ones) is walking it.
+      struct EmissionScope {
+        explicit EmissionScope (ProtoSignal& signal) : signal_ (signal) { ++signal_.emit_depth_; }
+        ~EmissionScope ()
         {
-          function = NULL;
-          if (next)
-            next->prev = prev;
-          if (prev)
-            prev->next = next;
-          decref();
-          // leave intact ->next, ->prev for stale iterators
-        }
-        size_t
-        add_before (const CbFunction &cb)
-        {
-          SignalLink *link = new SignalLink (cb);
-          link->prev = prev; // link to last
-          link->next = this;
-          prev->next = link; // link from last
-          prev = link;
-          static_assert (sizeof (link) == sizeof (size_t), "sizeof size_t");
-          return size_t (link);
-        }
-        bool
-        deactivate (const CbFunction &cbf)
-        {
-          if (cbf == function)
-          {
-            function = NULL;      // deactivate static head
-            return true;
-          }
-          for (SignalLink *link = this->next ? this->next : this; link != this; link = link->next)
-            if (cbf == link->function)
-            {
-              link->unlink();     // deactivate and unlink sibling
-              return true;
-            }
-          return false;
-        }
-        bool
-        remove_sibling (size_t id)
-        {
-          for (SignalLink *link = this->next ? this->next : this; link != this; link = link->next)
-            if (id == size_t (link))
-            {
-              link->unlink();     // deactivate and unlink sibling
-              return true;
-            }
-          return false;
+          if (--signal_.emit_depth_ == 0 && signal_.needs_compact_)
+            signal_.compact();
         }
+        ProtoSignal& signal_;
       };
-      SignalLink   *callback_ring_; // linked ring of callback nodes
+
+      std::vector<Slot>     slots_;         // handlers emit() calls, in subscription order
+      std::vector<Slot>     pending_;       // handlers subscribed during an emission, moved to slots_ after it
+      uint64_t              next_id_;
+      uint32_t              emit_depth_;
+      uint32_t              num_subscribers_;
+      bool                  needs_compact_;
       std::shared_ptr<void> heartbeat_; // for observers to tell if this signal is still alive
       /*copy-ctor*/ ProtoSignal (const ProtoSignal&) = delete;
       ProtoSignal&  operator=   (const ProtoSignal&) = delete;
-      void
-      ensure_ring ()
+
+      uint64_t
+      add (CbFunction&& cb)
       {
-        if (!callback_ring_)
+        const uint64_t id = next_id_++;
+        if (!cb)
+          return id;
+        if (emit_depth_ > 0)
         {
-          callback_ring_ = new SignalLink (CbFunction()); // ref_count = 1
-          callback_ring_->incref(); // ref_count = 2, head of ring, can be deactivated but not removed
-          callback_ring_->next = callback_ring_; // ring head initialization
-          callback_ring_->prev = callback_ring_; // ring tail initialization
+          pending_.emplace_back (id, std::move (cb));
+          needs_compact_ = true;
         }
+        else
+          slots_.emplace_back (id, std::move (cb));
+        ++num_subscribers_;
+        return id;
       }
 
-      /// Function to remove a signal handler through its connection ID, returns if a handler was removed.
-      bool Unsubscribe(size_t connection) { return callback_ring_ ? callback_ring_->remove_sibling (connection) : false; }
-      friend class ProtoHandle;
-    public:
-      /// ProtoSignal constructor, connects default callback if non-NULL.
-      ProtoSignal (const CbFunction &method) :
-      callback_ring_ (NULL),
-      heartbeat_( (void*)0x12345678, [] (void*) {} ) // pointer isn't actually valid, so give deleter that won't delete anything
+      static bool
+      remove_from (std::vector<Slot>& slots, uint64_t id, bool erase)
       {
-        if (method != NULL)
-        {
-          ensure_ring();
-          callback_ring_->function = method;
-        }
+        auto it = std::lower_bound (slots.begin(), slots.end(), id, [] (const Slot& slot, uint64_t slotId) { return slot.id < slotId; });
+        if (it == slots.end() || it->id != id || it->removed)
+          return false;
+        if (erase)
+          slots.erase (it);
+        else
+          it->removed = true;
+        return true;
+      }
+
+      /// Function to remove a signal handler through its slot ID, returns if a handler was removed.
+      /// During an emission the slot only becomes a tombstone, since its handler may be the one running.
+      bool
+      Unsubscribe (uint64_t id)
+      {
+        const bool erase = (emit_depth_ == 0);
+        if (!remove_from (slots_, id, erase) && !remove_from (pending_, id, erase))
+          return false;
+        if (!erase)
+          needs_compact_ = true;
+        --num_subscribers_;
+        return true;
+      }
+
+      static void
+      UnsubscribeSlot (void* signal, uint64_t id)
+      {
+        static_cast<ProtoSignal*> (signal)->Unsubscribe (id);
       }
-      /// ProtoSignal destructor releases all resources associated with this signal.
-      ~ProtoSignal ()
+
+      void
+      compact ()
       {
-        if (callback_ring_)
+        slots_.erase (std::remove_if (slots_.begin(), slots_.end(), [] (const Slot& slot) { return slot.removed; }), slots_.end());
+        for (Slot& slot : pending_)
         {
-          while (callback_ring_->next != callback_ring_)
-            callback_ring_->next->unlink();
-          assert (callback_ring_->ref_count >= 2);
-          callback_ring_->decref();
-          callback_ring_->decref();
+          if (!slot.removed)
+            slots_.emplace_back (std::move (slot));
         }
+        pending_.clear();
+        needs_compact_ = false;
+      }
+    public:
+      /// ProtoSignal constructor, connects default callback if non-NULL.
+      ProtoSignal (CbFunction &&method) :
+      next_id_ (1),
+      emit_depth_ (0),
+      num_subscribers_ (0),
+      needs_compact_ (false),
+      heartbeat_( (void*)0x12345678, [] (void*) {} ) // pointer isn't actually valid, so give deleter that won't delete anything
+      {
+        add (std::move (method));
       }
 
       /// Function to add a new function or lambda as signal handler.
@@ -224,42 +211,43 @@ namespace Signal {
       /// ***YOUR CALLBACK WILL BE UNREGISTERED WHEN THIS HANDLE IS DESTROYED.***
       /// If you call this function and don't store the return value, you're almost certainly doing it wrong.
       /// This handle can also be manually unsubscribed by assigning it nullptr.
-      SmartHandle ScopedSubscribe(const CbFunction &cb) __attribute__((warn_unused_result)) {
-        ensure_ring();
-        return SmartHandle(new ScopedHandleContainer(new ProtoHandle(this, callback_ring_->add_before(cb), heartbeat_)));
+      SmartHandle ScopedSubscribe(CbFunction cb) __attribute__((warn_unused_result)) {
+        return std::make_shared<ScopedHandleContainer>(this, add(std::move(cb)), &UnsubscribeSlot, heartbeat_);
       }
 
       /// Add callback to this signal dispatcher. If the signal dispatcher ever emit()s after your callback
       /// is no longer valid, very bad things will happen. ScopedSubscribe (above) is recommended.
-      void SubscribeForever(const CbFunction &cb) {
-        ensure_ring();
-        callback_ring_->add_before(cb);
+      void SubscribeForever(CbFunction cb) {
+        add(std::move(cb));
+      }
+
+      /// Returns true if emit() would invoke at least one callback.
+      bool HasSubscribers() const {
+        return num_subscribers_ > 0;
       }
 
       /// Emit a signal, i.e. invoke all its callbacks and collect return types with the Collector.
+      /// Arguments are handed to each callback by reference; only callbacks taking them by value copy them.
       CollectorResult
-      emit (Args... args)
+      emit (const Args&... args)
       {
         Collector collector;
-        if (!callback_ring_)
+        if (slots_.empty())
           return collector.result();
-        SignalLink *link = callback_ring_;
-        link->incref();
-        do
+        EmissionScope scope (*this);
+        // slots_ doesn't grow or shrink until the outermost emission ends, so neither the
+        // count nor the handler running can move under us
+        const size_t count = slots_.size();
+        for (size_t i = 0; i < count; ++i)
         {
-          if (link->function != NULL)
+          const Slot& slot = slots_[i];
+          if (!slot.removed)
           {
-            const bool continue_emission = this->invoke (collector, link->function, args...);
+            const bool continue_emission = this->invoke (collector, slot.function, args...);
             if (!continue_emission)
               break;
           }
-          SignalLink *old = link;
-          link = old->next;
-          link->incref();
-          old->decref();
         }
-        while (link != callback_ring_);
-        link->decref();
         return collector.result();
       }
     };
@@ -278,8 +266,11 @@ namespace Signal {
    * the last callback is returned from emit(). Collectors can be implemented to accumulate callback
    * results or to halt a running emissions in correspondance to callback results.
    * The signal implementation is safe against recursion, so callbacks may be removed and
-   * added during a signal emission and recursive emit() calls are also safe.
-   * The overhead of an unused signal is intentionally kept very low, around the size of a single pointer.
+   * added during a signal emission and recursive emit() calls are also safe. A callback removed
+   * during an emission is not called again, even by that emission; one added during an emission
+   * is first called by the next emit().
+   * Callbacks are held in a contiguous array of small inline callables, so neither subscribing
+   * a typical lambda nor emitting allocates.
    * Note that the Signal template types is non-copyable.
    */
   template <typename SignalSignature, class Collector = Lib::CollectorDefault<typename std::function<SignalSignature>::result_type> >
@@ -289,7 +280,7 @@ namespace Signal {
     typedef Lib::ProtoSignal<SignalSignature, Collector> ProtoSignal;
     typedef typename ProtoSignal::CbFunction             CbFunction;
     /// Signal constructor, supports a default callback as argument.
-    Signal (const CbFunction &method = CbFunction()) : ProtoSignal (method) {}
+    Signal (CbFunction method = CbFunction()) : ProtoSignal (std::move (method)) {}
   };
 
   /// This function creates a std::function by binding @a object to the member function pointer @a method.
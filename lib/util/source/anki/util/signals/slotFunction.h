@@ -0,0 +1,165 @@
+/**
+ * File: slotFunction
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Move-only callable holding a signal handler. Handlers up to kInlineSize
+ * bytes (lambdas capturing a few pointers, a std::function, most std::binds) are stored
+ * in the object itself, so subscribing one doesn't allocate. Arguments are passed through
+ * by reference, and only copied if the handler itself takes them by value.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+#ifndef __Util_Signals_SlotFunction_H__
+#define __Util_Signals_SlotFunction_H__
+
+#include <cstddef>
+#include <functional>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace Signal {
+
+  namespace Lib {
+
+    template<typename> class SlotFunction;   // undefined
+
+    template<class R, class... Args>
+    class SlotFunction<R (Args...)> {
+    public:
+      static constexpr size_t kInlineSize = 48;
+
+      SlotFunction() = default;
+      SlotFunction(std::nullptr_t) {}
+
+      template <typename F,
+                typename = typename std::enable_if<!std::is_same<typename std::decay<F>::type, SlotFunction>::value>::type>
+      SlotFunction(F&& f)
+      {
+        using Callable = typename std::decay<F>::type;
+        if (!IsNull(f)) {
+          Construct<Callable>(std::forward<F>(f), std::integral_constant<bool, FitsInline<Callable>()>());
+        }
+      }
+
+      SlotFunction(SlotFunction&& other) noexcept
+      {
+        MoveFrom(other);
+      }
+
+      SlotFunction& operator=(SlotFunction&& other) noexcept
+      {
+        if (this != &other) {
+          Reset();
+          MoveFrom(other);
+        }
+        return *this;
+      }
+
+      SlotFunction(const SlotFunction&) = delete;
+      SlotFunction& operator=(const SlotFunction&) = delete;
+
+      ~SlotFunction() { Reset(); }
+
+      R operator()(const Args&... args) const { return _ops->invoke(&_storage, args...); }
+
+      explicit operator bool() const { return _ops != nullptr; }
+
+      void Reset()
+      {
+        if (_ops != nullptr) {
+          _ops->destroy(&_storage);
+          _ops = nullptr;
+        }
+      }
+
+    private:
+      using Storage = typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type;
+
+      struct Ops {
+        R (*invoke)(void* storage, const Args&... args);
+        void (*move)(void* dest, void* src); // leaves src destroyed
+        void (*destroy)(void* storage);
+      };
+
+      // An empty std::function or null function pointer subscribes nothing, as it did when handlers were std::functions
+      template <typename Sig>
+      static bool IsNull(const std::function<Sig>& f) { return !f; }
+      template <typename Ret, typename... Params>
+      static bool IsNull(Ret (*f)(Params...)) { return f == nullptr; }
+      template <typename F>
+      static bool IsNull(const F&) { return false; }
+
+      template <typename Callable>
+      static constexpr bool FitsInline()
+      {
+        return (sizeof(Callable) <= kInlineSize) &&
+               (alignof(Callable) <= alignof(std::max_align_t)) &&
+               std::is_nothrow_move_constructible<Callable>::value;
+      }
+
+      template <typename Callable>
+      struct InlineOps {
+        static Callable* Get(void* storage) { return static_cast<Callable*>(storage); }
+        static R Invoke(void* storage, const Args&... args) { return (*Get(storage))(args...); }
+        static void Move(void* dest, void* src)
+        {
+          new (dest) Callable(std::move(*Get(src)));
+          Get(src)->~Callable();
+        }
+        static void Destroy(void* storage) { Get(storage)->~Callable(); }
+        static constexpr Ops kOps = {&Invoke, &Move, &Destroy};
+      };
+
+      template <typename Callable>
+      struct HeapOps {
+        static Callable*& Get(void* storage) { return *static_cast<Callable**>(storage); }
+        static R Invoke(void* storage, const Args&... args) { return (*Get(storage))(args...); }
+        static void Move(void* dest, void* src) { new (dest) Callable*(Get(src)); }
+        static void Destroy(void* storage) { delete Get(storage); }
+        static constexpr Ops kOps = {&Invoke, &Move, &Destroy};
+      };
+
+      template <typename Callable, typename F>
+      void Construct(F&& f, std::true_type /* inline */)
+      {
+        new (&_storage) Callable(std::forward<F>(f));
+        _ops = &InlineOps<Callable>::kOps;
+      }
+
+      template <typename Callable, typename F>
+      void Construct(F&& f, std::false_type /* inline */)
+      {
+        new (&_storage) Callable*(new Callable(std::forward<F>(f)));
+        _ops = &HeapOps<Callable>::kOps;
+      }
+
+      void MoveFrom(SlotFunction& other)
+      {
+        if (other._ops != nullptr) {
+          other._ops->move(&_storage, &other._storage);
+          _ops = other._ops;
+          other._ops = nullptr;
+        }
+      }
+
+      const Ops* _ops = nullptr;
+      mutable Storage _storage; // handlers are called through const signals' slots, like std::function
+    };
+
+    template<class R, class... Args>
+    template <typename Callable>
+    constexpr typename SlotFunction<R (Args...)>::Ops SlotFunction<R (Args...)>::InlineOps<Callable>::kOps;
+
+    template<class R, class... Args>
+    template <typename Callable>
+    constexpr typename SlotFunction<R (Args...)>::Ops SlotFunction<R (Args...)>::HeapOps<Callable>::kOps;
+
+  } // Lib
+
+} // Signal
+
+#endif // __Util_Signals_SlotFunction_H__
@@ -10,6 +10,8 @@
 
 #include "util/stringTable/stringID.h"
 
+#include <mutex>
+
 
 namespace Anki{ namespace Util
 {
@@ -24,19 +26,21 @@ StringTable& StringID::GetStringTable()
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-StringID::StringID() :
-  id_( StringTable::STRID_INDEX_NONE )
+// Names are interned by loading threads while others look them up. Function static, like the table, so ids can be
+// created during static initialization.
+static std::mutex& GetStringTableMutex()
 {
-  
+  static std::mutex mutex_;
+  return mutex_;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-StringID::StringID( const StringID& other ) :
-  id_( other.id_ )
+StringID::StringID() :
+  id_( StringTable::STRID_INDEX_NONE )
 {
   
 }
-  
+
 //----------------------------------------------------------------------------------------------------------------------
 StringID::StringID( const std::string& name )
 {
@@ -44,20 +48,26 @@ StringID::StringID( const std::string& name )
 }
 
 //----------------------------------------------------------------------------------------------------------------------
-StringID::~StringID()
+StringID StringID::Find( const std::string& name )
 {
-  
+  StringID stringID;
+  std::lock_guard<std::mutex> lock( GetStringTableMutex() );
+  stringID.id_ = GetStringTable().GetStringID( name );
+  return stringID;
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 void StringID::Set( const std::string& name )
 {
+  std::lock_guard<std::mutex> lock( GetStringTableMutex() );
   id_ = GetStringTable().AddStringID( name );
 }
 
 //----------------------------------------------------------------------------------------------------------------------
 const std::string& StringID::ToString() const
 {
+  // The table never removes strings and the storage of the ones it has doesn't move, so the reference outlives the lock
+  std::lock_guard<std::mutex> lock( GetStringTableMutex() );
   return GetStringTable().GetString( id_ );
 }
 
@@ -86,5 +96,7 @@ unsigned int StringID_Create( const char* name )
 //----------------------------------------------------------------------------------------------------------------------
 const char* StringID_ToString( unsigned int id )
 {
-  return StringID::GetStringTable().GetString( id ).c_str();
+  StringID stringID;
+  stringID.id_ = id;
+  return stringID.c_str();
 }
\ No newline at end of file
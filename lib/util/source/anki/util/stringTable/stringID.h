@@ -9,6 +9,8 @@
  *  Description:
  *  - A unique ID to represent a string
  *  - Fast conversion between string and id
+ *  - Strings are interned once, in a process wide table that's safe to use from any thread, so keys built from
+ *    them compare and hash as integers
  *
  ***********************************************************************************************************************/
 
@@ -60,11 +62,14 @@ class StringID
   //--------------------------------------------------------------------------------------------------------------------
 public:
   StringID();
-  StringID( const StringID& other );
   explicit StringID( const std::string& name );
-  ~StringID();
-  
+
+  // Returns the id of name if it has been interned, or STRID_None. Unlike constructing one, this never adds to the table,
+  // so looking up names that may not exist doesn't grow it.
+  static StringID Find( const std::string& name );
+
   void Set( const std::string& name );
+  bool IsNone() const { return ( id_ == StringTable::STRID_INDEX_NONE ); }
   StringTable::STRID GetID() const { return id_; }
   const std::string& ToString() const;
   const char* c_str() const;
@@ -73,7 +78,6 @@ public:
   bool operator!=( const StringID& rhs ) const { return ( id_ != rhs.id_ ); }
   bool operator<( const StringID& rhs ) const { return ( id_ < rhs.id_ ); }
   bool operator>( const StringID& rhs ) const { return ( id_ > rhs.id_ ); }
-  StringID& operator=( const StringID& rhs ) { id_ = rhs.id_; return *this; }
   StringID& operator=( const std::string& rhs ) { Set( rhs ); return *this; }
   
   //--------------------------------------------------------------------------------------------------------------------
@@ -15,9 +15,9 @@
 #ifndef UTIL_STRINGTABLE
 #define UTIL_STRINGTABLE
 
+#include <deque>
 #include <string>
 #include <unordered_map>
-#include <vector>
 
 namespace Anki{
 namespace Util{
@@ -42,7 +42,8 @@ public:
 private:
   typedef std::unordered_map<std::string, STRID> StringTableType;
   StringTableType stringtable_;
-  std::vector<std::string> stringMap_;
+  // a deque so GetString references stay valid as strings are added
+  std::deque<std::string> stringMap_;
 
   StringTable( const StringTable& );
 };
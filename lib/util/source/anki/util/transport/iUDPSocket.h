@@ -18,6 +18,8 @@
 #include <sys/socket.h> // for socklen_t
 #include <netinet/in.h>
 #include <stdint.h>
+#include <string.h>
+#include <vector>
 
 
 struct msghdr;
@@ -43,6 +45,32 @@ namespace Util {
     virtual int CloseSocket(int socketId) = 0;
     virtual ssize_t SendTo(int socketId, const void* messageData, size_t messageDataSize, int flags, const sockaddr* destSockAddress, socklen_t destSockAddressLength) = 0;
     virtual ssize_t ReceiveMessage(int socketId, msghdr* messageHeader, int flags) = 0;
+    
+    // Scatter/gather send of msg_iov to msg_name - sockets that can't send from several buffers at once
+    // just combine them and use SendTo
+    virtual ssize_t SendMessage(int socketId, const msghdr* messageHeader, int flags)
+    {
+      size_t messageDataSize = 0;
+      for (size_t i=0; i < messageHeader->msg_iovlen; ++i)
+      {
+        messageDataSize += messageHeader->msg_iov[i].iov_len;
+      }
+      
+      std::vector<uint8_t> messageData(messageDataSize);
+      size_t bytesWritten = 0;
+      for (size_t i=0; i < messageHeader->msg_iovlen; ++i)
+      {
+        const iovec& ioVec = messageHeader->msg_iov[i];
+        if (ioVec.iov_len > 0)
+        {
+          memcpy(&messageData[bytesWritten], ioVec.iov_base, ioVec.iov_len);
+          bytesWritten += ioVec.iov_len;
+        }
+      }
+      
+      return SendTo(socketId, messageData.data(), messageDataSize, flags,
+                    reinterpret_cast<const sockaddr*>(messageHeader->msg_name), messageHeader->msg_namelen);
+    }
     virtual uint32_t GetLocalIpAddress() = 0;
     virtual struct in6_addr GetLocalIpv6LinkLocalAddress() = 0;
     
@@ -373,6 +373,12 @@ ssize_t NetEmulatorUDPSocket::SendTo(int socketId, const void* messageData, size
 }
 
 
+ssize_t NetEmulatorUDPSocket::SendMessage(int socketId, const msghdr* messageHeader, int flags)
+{
+  return _udpSocketImpl->SendMessage(socketId, messageHeader, flags);
+}
+
+
 ssize_t NetEmulatorUDPSocket::ReceiveMessage(int socketId, msghdr* messageHeader, int flags)
 {
   const msghdr inMessageHeader = *messageHeader;
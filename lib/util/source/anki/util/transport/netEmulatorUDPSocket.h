@@ -101,6 +101,7 @@ public:
   virtual int SetSocketOpt(int socketId, int level, int optname, const void* optVal, socklen_t optlen) override;
   virtual int CloseSocket(int socketId) override;
   virtual ssize_t SendTo(int socketId, const void* messageData, size_t messageDataSize, int flags, const sockaddr* destSockAddress, socklen_t destSockAddressLength) override;
+  virtual ssize_t SendMessage(int socketId, const msghdr* messageHeader, int flags) override;
   virtual ssize_t ReceiveMessage(int socketId, msghdr* messageHeader, int flags) override;
   virtual uint32_t GetLocalIpAddress() override;
   virtual struct in6_addr GetLocalIpv6LinkLocalAddress() override;
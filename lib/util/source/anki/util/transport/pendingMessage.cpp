@@ -27,9 +27,11 @@ PendingMessage::PendingMessage()
   , _lastSentTime(kNetTimeStampZero)
   , _message(nullptr)
   , _messageSize(0)
+  , _messageCapacity(0)
   , _sequenceNumber(k_InvalidReliableSeqId)
   , _messageType(eRMT_Invalid)
   , _flushPacket(false)
+  , _isSelectivelyAcked(false)
 {
 }
 
@@ -43,18 +45,30 @@ PendingMessage::~PendingMessage()
 void PendingMessage::Set(const SrcBufferSet& srcBuffers, EReliableMessageType messageType, ReliableSequenceId seqId,
                          bool flushPacket, NetTimeStamp externalQueuedTime)
 {
-  assert(_message == nullptr);
-  DestroyMessage();
+  assert(_messageSize == 0);
+
+  const uint32_t messageSize = srcBuffers.CalculateTotalSize();
+  if (messageSize > _messageCapacity)
+  {
+    // Only grow the buffer, a pooled message re-uses the one it already has
+    DestroyMessage();
+    _message         = new uint8_t[messageSize];
+    _messageCapacity = messageSize;
+  }
+  if (messageSize > 0)
+  {
+    srcBuffers.CopyCombinedBufferInto(_message);
+  }
 
   _externalQueuedTime = externalQueuedTime;
   _queuedTime     = GetCurrentNetTimeStamp();
   _firstSentTime  = kNetTimeStampZero;
   _lastSentTime   = kNetTimeStampZero;
-  _message        = srcBuffers.CreateCombinedBuffer();
-  _messageSize    = srcBuffers.CalculateTotalSize();
+  _messageSize    = messageSize;
   _sequenceNumber = seqId;
   _messageType    = messageType;
   _flushPacket    = flushPacket;
+  _isSelectivelyAcked = false;
   
   // seqId == invalid implies unreliable message, this must be in sync with reliability of type
   // (otherwise multi-messages will incorrectly determine if that message contributes to the seqId increment)
@@ -71,6 +85,17 @@ void PendingMessage::DestroyMessage()
     SrcBufferSet::DestroyCombinedBuffer(_message);
     _message = nullptr;
   }
+  _messageSize     = 0;
+  _messageCapacity = 0;
+}
+
+
+void PendingMessage::Clear()
+{
+  _messageSize    = 0;
+  _sequenceNumber = k_InvalidReliableSeqId;
+  _messageType    = eRMT_Invalid;
+  _isSelectivelyAcked = false;
 }
   
   
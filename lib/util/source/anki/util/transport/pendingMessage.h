@@ -39,6 +39,9 @@ public:
 
   void DestroyMessage();
 
+  // Returns a pooled message to an unused state, keeping its buffer for re-use by the next Set()
+  void Clear();
+
   const uint8_t*        GetMessageBytes() const { return _message; }
   uint32_t              GetMessageSize()  const { return _messageSize; }
   ReliableSequenceId    GetSequenceId()   const { return _sequenceNumber; }
@@ -57,6 +60,10 @@ public:
   
   bool                  ShouldFlushPacket() const { return _flushPacket; }
   
+  // Other end has received it, but not all of the messages before it, so it's pending a cumulative ack
+  bool                  IsSelectivelyAcked() const { return _isSelectivelyAcked; }
+  void                  SetSelectivelyAcked()      { _isSelectivelyAcked = true; }
+  
 private:
   
   // Prevent copy-construct/assignment
@@ -69,9 +76,11 @@ private:
   NetTimeStamp        _lastSentTime;       // Most recent time that message was sent over a socket
   uint8_t*            _message;
   uint32_t            _messageSize;
+  uint32_t            _messageCapacity;
   ReliableSequenceId  _sequenceNumber;
   uint8_t             _messageType;
   bool                _flushPacket; // is the message important enough to send even without a full packet of stuff
+  bool                _isSelectivelyAcked;
 };
 
 
@@ -50,6 +50,10 @@ bool PendingMultiPartMessage::AddMessagePart(const uint8_t* message, uint32_t me
         // start new
         ANKI_NET_PRINT_VERBOSE("MultiPartMessage", "new message %d of %d", messageIndex, messageCount);
         _lastExpectedPart = messageCount;
+        
+        // Every part but the last is as big as this one, so this is room for the whole message
+        // (capacity is kept by Clear(), so it's usually already big enough)
+        _bytes.reserve(messageCount * messageSize);
       }
       
       if (messageCount != _lastExpectedPart)
@@ -61,10 +65,8 @@ bool PendingMultiPartMessage::AddMessagePart(const uint8_t* message, uint32_t me
       
       ANKI_NET_PRINT_VERBOSE("MultiPartMessage", "Message part %d of %d - adding %u bytes to %u existing", messageIndex, messageCount, messageSize, (uint32_t)_bytes.size());
       
-      // Resize the buffer and copy all the bytes in one go
-      const size_t oldSize = _bytes.size();
-      _bytes.resize(oldSize + messageSize);
-      memcpy(&_bytes[oldSize], message, messageSize);
+      // Copy straight onto the end (no re-allocation, the first part reserved room for them all)
+      _bytes.insert(_bytes.end(), message, message + messageSize);
       
       ++_nextExpectedPart;
       
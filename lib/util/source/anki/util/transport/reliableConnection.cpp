@@ -96,6 +96,7 @@ ReliableConnection::~ReliableConnection()
   ANKI_NET_PRINT_VERBOSE("ReliableConnection.Destructor", "%p '%s' Destructed _nextOutSequenceId = %u, %zu (%d..%d)", this, _transportAddress.ToString().c_str(), _nextOutSequenceId, _pendingMessageList.size(), (int)GetFirstUnackedOutId(), (int)GetLastUnackedOutId());
 
   DestroyPendingMessageList(_pendingMessageList);
+  DestroyPendingMessageList(_freePendingMessages);
 }
 
 
@@ -109,10 +110,37 @@ void ReliableConnection::DestroyPendingMessageList(PendingMessageList& messageLi
 }
 
 
+PendingMessage* ReliableConnection::AllocPendingMessage()
+{
+  if (_freePendingMessages.empty())
+  {
+    return new PendingMessage();
+  }
+  
+  PendingMessage* pendingMessage = _freePendingMessages.back();
+  _freePendingMessages.pop_back();
+  return pendingMessage;
+}
+
+
+void ReliableConnection::FreePendingMessage(PendingMessage* pendingMessage)
+{
+  if (_freePendingMessages.size() < kMaxFreePendingMessages)
+  {
+    pendingMessage->Clear();
+    _freePendingMessages.push_back(pendingMessage);
+  }
+  else
+  {
+    delete pendingMessage;
+  }
+}
+
+
 void ReliableConnection::AddMessage(const SrcBufferSet& srcBuffers, EReliableMessageType messageType,
                                     ReliableSequenceId seqId, bool flushPacket, NetTimeStamp queuedTime)
 {
-  PendingMessage* newPendingMessage = new PendingMessage();
+  PendingMessage* newPendingMessage = AllocPendingMessage();
   newPendingMessage->Set(srcBuffers, messageType, seqId, flushPacket, queuedTime);
 
   #if ENABLE_RC_PACKET_TIME_DIAGNOSTICS
@@ -155,7 +183,29 @@ ReliableSequenceId ReliableConnection::GetNextOutSequenceNumber()
 
 bool ReliableConnection::IsWaitingForAnyInRange(ReliableSequenceId minSeqId, ReliableSequenceId maxSeqId) const
 {
-  return IsSequenceIdInRange(_nextInSequenceId, minSeqId, maxSeqId);
+  if (IsSequenceIdInRange(_nextInSequenceId, minSeqId, maxSeqId))
+  {
+    return true;
+  }
+  
+  // Otherwise the whole range is either behind us (all repeats), or ahead of us
+  for (ReliableSequenceId seqId = minSeqId; ; seqId = NextSequenceId(seqId))
+  {
+    const uint16_t distanceAhead = SequenceIdDistance(_nextInSequenceId, seqId);
+    if (distanceAhead > kMaxHeldInMessages)
+    {
+      // behind us, or too far ahead to hold
+      return false;
+    }
+    if (!IsHoldingInMessage(seqId))
+    {
+      return true;
+    }
+    if (seqId == maxSeqId)
+    {
+      return false;
+    }
+  }
 }
 
 
@@ -171,7 +221,85 @@ void ReliableConnection::AdvanceNextInSequenceId()
 }
 
 
-bool ReliableConnection::UpdateLastAckedMessage(ReliableSequenceId seqId)
+bool ReliableConnection::IsHoldingInMessage(ReliableSequenceId seqId) const
+{
+  for (const HeldInMessage& heldMessage : _heldInMessages)
+  {
+    if (heldMessage._seqId == seqId)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+bool ReliableConnection::HoldOutOfOrderMessage(const uint8_t* message, uint32_t messageSize, uint8_t messageType, ReliableSequenceId seqId)
+{
+  const uint16_t distanceAhead = SequenceIdDistance(_nextInSequenceId, seqId);
+  if ((distanceAhead == 0) || (distanceAhead > kMaxHeldInMessages) || IsHoldingInMessage(seqId))
+  {
+    // a repeat, or too far ahead to hold (the other end will resend it)
+    return false;
+  }
+  
+  _heldInMessages.emplace_back();
+  HeldInMessage& heldMessage = _heldInMessages.back();
+  heldMessage._bytes.assign(message, message + messageSize);
+  heldMessage._seqId = seqId;
+  heldMessage._type  = messageType;
+  
+  ANKI_NET_PRINT_VERBOSE("ReliableConnection.HoldOutOfOrderMessage", "%p '%s' Holding %u (waiting for %u, %zu held)",
+                         this, _transportAddress.ToString().c_str(), seqId, _nextInSequenceId, _heldInMessages.size());
+  
+  return true;
+}
+
+
+bool ReliableConnection::PopHeldNextInMessage(std::vector<uint8_t>& outMessage, uint8_t& outMessageType)
+{
+  for (size_t i=0; i < _heldInMessages.size(); ++i)
+  {
+    HeldInMessage& heldMessage = _heldInMessages[i];
+    if (heldMessage._seqId == _nextInSequenceId)
+    {
+      outMessage.swap(heldMessage._bytes);
+      outMessageType = heldMessage._type;
+      
+      // order of held messages doesn't matter
+      if ((i + 1) < _heldInMessages.size())
+      {
+        heldMessage = std::move(_heldInMessages.back());
+      }
+      _heldInMessages.pop_back();
+      
+      AdvanceNextInSequenceId();
+      return true;
+    }
+  }
+  return false;
+}
+
+
+uint32_t ReliableConnection::GetInSelectiveAckBits() const
+{
+  // Bits are relative to the message after the last one we acked, as that's what the header says we're waiting for
+  const ReliableSequenceId waitingForSeqId = (_lastInAckedMessageId != k_InvalidReliableSeqId) ? NextSequenceId(_lastInAckedMessageId) : k_MinReliableSeqId;
+  
+  uint32_t selectiveAckBits = 0;
+  for (const HeldInMessage& heldMessage : _heldInMessages)
+  {
+    const uint16_t distanceAhead = SequenceIdDistance(waitingForSeqId, heldMessage._seqId);
+    if ((distanceAhead > 0) && (distanceAhead <= kMaxHeldInMessages))
+    {
+      selectiveAckBits |= (1u << (distanceAhead - 1));
+    }
+  }
+  return selectiveAckBits;
+}
+
+
+bool ReliableConnection::UpdateLastAckedMessage(ReliableSequenceId seqId, uint32_t selectiveAckBits)
 {
   bool updatedLastAckedMessage = false;
   
@@ -187,16 +315,24 @@ bool ReliableConnection::UpdateLastAckedMessage(ReliableSequenceId seqId)
       PendingMessage* readMessage = _pendingMessageList[0];
       assert(readMessage->IsReliable() && (readMessage->GetLastSentTime() > kNetTimeStampZero));
       
-      // use time since the first time we sent this message, we don't know which send attempt is being acked
-      const NetTimeStamp timeForMessageToBeAcked = currentNetTimeStamp - readMessage->GetFirstSentTime();
-      _ackRoundTripTimes.AddStat(timeForMessageToBeAcked);
+      if (!readMessage->IsSelectivelyAcked())
+      {
+        // use time since the first time we sent this message, we don't know which send attempt is being acked
+        const NetTimeStamp timeForMessageToBeAcked = currentNetTimeStamp - readMessage->GetFirstSentTime();
+        _ackRoundTripTimes.AddStat(timeForMessageToBeAcked);
+      }
       
-      delete readMessage;
+      FreePendingMessage(readMessage);
       _pendingMessageList.erase( _pendingMessageList.begin() );
       updatedLastAckedMessage = true;
     }
   }
   
+  if (UpdateSelectiveAcks(seqId, selectiveAckBits, currentNetTimeStamp))
+  {
+    updatedLastAckedMessage = true;
+  }
+  
   #if ENABLE_RC_PACKET_TIME_DIAGNOSTICS
   {
     const NetTimeStamp timeSinceLast = (currentNetTimeStamp - _latestRecvTime);
@@ -235,6 +371,37 @@ bool ReliableConnection::UpdateLastAckedMessage(ReliableSequenceId seqId)
 }
 
 
+bool ReliableConnection::UpdateSelectiveAcks(ReliableSequenceId lastAckedSeqId, uint32_t selectiveAckBits, NetTimeStamp currentTime)
+{
+  if (selectiveAckBits == 0)
+  {
+    return false;
+  }
+  
+  // bit 0 is the message after the one the other end is still waiting for
+  const ReliableSequenceId waitingForSeqId = (lastAckedSeqId != k_InvalidReliableSeqId) ? NextSequenceId(lastAckedSeqId) : k_MinReliableSeqId;
+  
+  bool anyNewSelectiveAcks = false;
+  for (PendingMessage* pendingMessage : _pendingMessageList)
+  {
+    if (!pendingMessage->IsReliable() || !pendingMessage->HasBeenSent() || pendingMessage->IsSelectivelyAcked())
+    {
+      continue;
+    }
+    
+    const uint16_t distanceAhead = SequenceIdDistance(waitingForSeqId, pendingMessage->GetSequenceId());
+    if ((distanceAhead > 0) && (distanceAhead <= kMaxHeldInMessages) && ((selectiveAckBits >> (distanceAhead - 1)) & 1u))
+    {
+      pendingMessage->SetSelectivelyAcked();
+      _ackRoundTripTimes.AddStat(currentTime - pendingMessage->GetFirstSentTime());
+      anyNewSelectiveAcks = true;
+    }
+  }
+  
+  return anyNewSelectiveAcks;
+}
+
+
 struct PingPayload
 {
   PingPayload(const uint8_t* message, uint32_t messageSize)
@@ -427,6 +594,17 @@ size_t ReliableConnection::SendUnAckedMessages(ReliableTransport* reliableTransp
   ReliableSequenceId seqIdMax = seqIdMin;
 
   numBytesToSend += k_ExtraBytesPerMultiSubMessage;
+
+  // Messages the other end already holds are only sent to fill the gap between ones it's missing (so several
+  // gaps can share one packet), the packet is cut back to end on the last message that's actually needed
+  assert(!firstPendingMessage->IsSelectivelyAcked());
+  size_t   numMessagesNeeded = numMessagesToSend;
+  uint32_t numBytesNeeded    = numBytesToSend;
+  bool sentReliableMessagesNeeded   = sentReliableMessages;
+  bool sentUnreliableMessagesNeeded = sentUnreliableMessages;
+  ReliableSequenceId seqIdMinNeeded = seqIdMin;
+  ReliableSequenceId seqIdMaxNeeded = seqIdMax;
+
   for (size_t i=(firstToSend+1); i < pendingMessageListSize; ++i)
   {
     const PendingMessage* pendingMessage = _pendingMessageList[i];
@@ -451,6 +629,16 @@ size_t ReliableConnection::SendUnAckedMessages(ReliableTransport* reliableTransp
       {
         sentUnreliableMessages = true;
       }
+
+      if (!pendingMessage->IsSelectivelyAcked())
+      {
+        numMessagesNeeded = numMessagesToSend;
+        numBytesNeeded    = numBytesToSend;
+        sentReliableMessagesNeeded   = sentReliableMessages;
+        sentUnreliableMessagesNeeded = sentUnreliableMessages;
+        seqIdMinNeeded = seqIdMin;
+        seqIdMaxNeeded = seqIdMax;
+      }
     }
     else
     {
@@ -458,7 +646,14 @@ size_t ReliableConnection::SendUnAckedMessages(ReliableTransport* reliableTransp
       break;
     }
   }
-  
+
+  numMessagesToSend = numMessagesNeeded;
+  numBytesToSend    = numBytesNeeded;
+  sentReliableMessages   = sentReliableMessagesNeeded;
+  sentUnreliableMessages = sentUnreliableMessagesNeeded;
+  seqIdMin = seqIdMinNeeded;
+  seqIdMax = seqIdMaxNeeded;
+
   // See if there's room to pack any earlier messages into the start of this packet too
   // (improves chance of messages making it over)
   
@@ -468,7 +663,7 @@ size_t ReliableConnection::SendUnAckedMessages(ReliableTransport* reliableTransp
     const PendingMessage* pendingMessage = _pendingMessageList[firstToSend - 1];
     
     const uint32_t numBytesToSendIfAdded = numBytesToSend + k_ExtraBytesPerMultiSubMessage + pendingMessage->GetMessageSize();
-    if (numBytesToSendIfAdded <= maxPayloadPerMessage)
+    if ((numBytesToSendIfAdded <= maxPayloadPerMessage) && !pendingMessage->IsSelectivelyAcked())
     {
       // Add message (moves first message one earlier)
       
@@ -578,30 +773,40 @@ size_t ReliableConnection::SendUnAckedMessages(ReliableTransport* reliableTransp
   // Update last-sent time for any reliable messages, and delete and remove any unreliable messages
   // iterate and remove in reverse order to reduce amount of shuffling
 
+  uint32_t firstSendBytes = 0;
+  uint32_t resendBytes    = 0;
   for (size_t i=firstToSend + numMessagesToSend; i > firstToSend; )
   {
     --i;
     PendingMessage* pendingMessage = _pendingMessageList[i];
-    
+
     if (!pendingMessage->HasBeenSent())
     {
+      firstSendBytes += pendingMessage->GetMessageSize();
+
       const NetTimeStamp extTimeQueued_ms = pendingMessage->GetExternalQueuedDuration();
       _externalQueuedTimes_ms.AddStat(extTimeQueued_ms);
       const NetTimeStamp timeQueued_ms = currentNetTimeStamp - pendingMessage->GetQueuedTime();
       _queuedTimes_ms.AddStat(timeQueued_ms);
     }
-    
+    else
+    {
+      resendBytes += pendingMessage->GetMessageSize();
+    }
+
     if (pendingMessage->IsReliable())
     {
       pendingMessage->UpdateLatestSentTime(currentNetTimeStamp);
     }
     else
     {
-      delete pendingMessage;
+      FreePendingMessage(pendingMessage);
       _pendingMessageList.erase(_pendingMessageList.begin() + i);
     }
   }
-  
+
+  reliableTransport->AddSentPayloadStats(firstSendBytes, resendBytes);
+
   // don't count any earlier messages that we secretly managed to pack in
   const size_t numRequestedMessagesSent = numMessagesToSend - numEarlierMessagesToSend;
 
@@ -741,6 +946,12 @@ uint32_t ReliableConnection::SendUnAckedPackets(ReliableTransport* reliableTrans
   size_t numMessagesSentThisPacket = 0;
   do
   {
+    // the other end already has these
+    while ((firstToSend < _pendingMessageList.size()) && _pendingMessageList[firstToSend]->IsSelectivelyAcked())
+    {
+      ++firstToSend;
+    }
+
     numMessagesSentThisPacket = SendUnAckedMessages(reliableTransport, firstToSend);
     if (numMessagesSentThisPacket > 0)
     {
@@ -777,6 +988,11 @@ bool ReliableConnection::IsPacketWorthSending(const ReliableTransport* reliableT
   {
     const PendingMessage* pendingMessage = _pendingMessageList[i];
     
+    if (pendingMessage->IsSelectivelyAcked())
+    {
+      continue;
+    }
+    
     if (pendingMessage->ShouldFlushPacket())
     {
       return true;
@@ -823,8 +1039,15 @@ uint32_t ReliableConnection::SendOptimalUnAckedPackets(ReliableTransport* reliab
   NetTimeStamp lastSentTimeForOldestMessage = kNetTimeStampZero;
   
   size_t oldestMessageIdx = 0;
+  bool foundMessageToSend = false;
   for (size_t i=0; i < _pendingMessageList.size(); ++i)
   {
+    if (_pendingMessageList[i]->IsSelectivelyAcked())
+    {
+      // the other end already has it
+      continue;
+    }
+    
     NetTimeStamp messageSentTime = _pendingMessageList[i]->GetLastSentTime();
     if (messageSentTime == kNetTimeStampZero)
     {
@@ -838,16 +1061,17 @@ uint32_t ReliableConnection::SendOptimalUnAckedPackets(ReliableTransport* reliab
       messageSentTime -= sTimeBetweenResendsInMS;
     }
     
-    if ((i==0) || (messageSentTime < lastSentTimeForOldestMessage))
+    if (!foundMessageToSend || (messageSentTime < lastSentTimeForOldestMessage))
     {
       lastSentTimeForOldestMessage = messageSentTime;
       oldestMessageIdx = i;
+      foundMessageToSend = true;
     }
   }
   
   uint32_t numPacketsSent = 0;
   
-  if (IsPacketWorthSending(reliableTransport, currentTime, oldestMessageIdx) && (currentTime > (lastSentTimeForOldestMessage + sTimeBetweenResendsInMS)))
+  if (foundMessageToSend && IsPacketWorthSending(reliableTransport, currentTime, oldestMessageIdx) && (currentTime > (lastSentTimeForOldestMessage + sTimeBetweenResendsInMS)))
   {
     // Re-send any un-acked messages starting with oldestMessageIdx, up to maxPacketsToSend combined packets
     
@@ -54,20 +54,32 @@ public:
   ReliableSequenceId GetLastInAckedMessageId() const { return _lastInAckedMessageId; }
 
   ReliableSequenceId GetNextInSequenceId() const { return _nextInSequenceId; }
+  // true if the range has the next message, or one after it that we could hold onto and haven't already
   bool IsWaitingForAnyInRange(ReliableSequenceId minSeqId, ReliableSequenceId maxSeqId) const;
   bool IsNextInSequenceId(ReliableSequenceId sequenceNum) const;
 
   void AdvanceNextInSequenceId();
 
+  // Hold a message that arrived ahead of the next one, so the other end only has to resend the missing ones
+  //     returns false if it's a repeat (or too far ahead to hold) and was ignored
+  bool HoldOutOfOrderMessage(const uint8_t* message, uint32_t messageSize, uint8_t messageType, ReliableSequenceId seqId);
+  // If the next message is being held, moves it into outMessage, advances the next id and returns true
+  bool PopHeldNextInMessage(std::vector<uint8_t>& outMessage, uint8_t& outMessageType);
+
+  // Which messages after the one following GetLastInAckedMessageId() we already hold: bit N is set if
+  // (LastInAcked + 2 + N) has arrived - lets the other end skip those when resending
+  uint32_t GetInSelectiveAckBits() const;
+  static constexpr uint32_t kMaxHeldInMessages = 32; // one per selective ack bit
+
   void SendPing(ReliableTransport* reliableTransport, NetTimeStamp incomingPingTime = kNetTimeStampZero, bool isReply = false);
   void ReceivePing(ReliableTransport* reliableTransport, const uint8_t* message, uint32_t messageSize);
 
   void AckMessage(ReliableSequenceId seqId);              // i.e. we're saying "yes, we saw up to that message"
   void NotifyAckingMessageSent();             // whenever we send an outbound message that can ack something new
 
-  // UpdateLastAckedMessage: i.e. we heard the other end say "yes, we saw up to that message"
+  // UpdateLastAckedMessage: i.e. we heard the other end say "yes, we saw up to that message" (and these ones after it)
   //     returns true if that updated the reliable queue (i.e. newer messages can now be sent/
-  bool UpdateLastAckedMessage(ReliableSequenceId seqId);
+  bool UpdateLastAckedMessage(ReliableSequenceId seqId, uint32_t selectiveAckBits);
 
   // returns number of packets sent (where each packet is >= 1 message), sends up to maxPacketsToSend packets
   uint32_t SendOptimalUnAckedPackets(ReliableTransport* reliableTransport, uint32_t maxPacketsToSend);
@@ -161,6 +173,23 @@ private:
   typedef std::vector<PendingMessage*> PendingMessageList;
   void      DestroyPendingMessageList(PendingMessageList& messageList);
 
+  // Pending messages (and their buffers) are recycled rather than allocated for every message
+  PendingMessage* AllocPendingMessage();
+  void            FreePendingMessage(PendingMessage* pendingMessage);
+  static constexpr size_t kMaxFreePendingMessages = 64;
+
+  // Marks any pending messages the other end says it holds, returns true if there were new ones
+  bool      UpdateSelectiveAcks(ReliableSequenceId lastAckedSeqId, uint32_t selectiveAckBits, NetTimeStamp currentTime);
+
+  // Reliable message that arrived ahead of _nextInSequenceId
+  struct HeldInMessage
+  {
+    std::vector<uint8_t> _bytes;
+    ReliableSequenceId   _seqId;
+    uint8_t              _type;
+  };
+  bool      IsHoldingInMessage(ReliableSequenceId seqId) const;
+
   // ============================== Static Member Vars ==============================
 
   static NetTimeStamp sTimeBetweenPingsInMS;
@@ -187,6 +216,7 @@ private:
 
   PendingMultiPartMessage     _pendingMultiPartMessage;
   PendingMessageList          _pendingMessageList;
+  PendingMessageList          _freePendingMessages;
 
   // Track messages we've sent
   ReliableSequenceId          _nextOutSequenceId;     // sequence id for next outbound reliable message we send
@@ -194,6 +224,7 @@ private:
   // Track incoming messages
   ReliableSequenceId          _lastInAckedMessageId;  // the last message we've acknowledged receiving
   ReliableSequenceId          _nextInSequenceId;
+  std::vector<HeldInMessage>  _heldInMessages;
 
   NetTimeStamp                _latestMessageSentTime;
   NetTimeStamp                _latestRecvTime;
@@ -73,5 +73,23 @@ bool IsSequenceIdInRange(ReliableSequenceId seqId, ReliableSequenceId minSeqId,
 }
 
 
+uint16_t SequenceIdDistance(ReliableSequenceId fromSeqId, ReliableSequenceId toSeqId)
+{
+  assert ((fromSeqId >= k_MinReliableSeqId) && (fromSeqId <= k_MaxReliableSeqId));
+  assert ((toSeqId >= k_MinReliableSeqId) && (toSeqId <= k_MaxReliableSeqId));
+  
+  if (toSeqId >= fromSeqId)
+  {
+    return toSeqId - fromSeqId;
+  }
+  else
+  {
+    // Ids have looped around
+    const uint16_t numSequenceIds = (k_MaxReliableSeqId - k_MinReliableSeqId) + 1;
+    return (toSeqId + numSequenceIds) - fromSeqId;
+  }
+}
+
+
 } // end namespace Util
 } // end namespace Anki
@@ -35,6 +35,8 @@ static const ReliableSequenceId k_MaxReliableSeqId = 65534;
 ReliableSequenceId PreviousSequenceId(ReliableSequenceId inSeqId);
 ReliableSequenceId NextSequenceId(ReliableSequenceId inSeqId);
 bool IsSequenceIdInRange(ReliableSequenceId seqId, ReliableSequenceId minSeqId, ReliableSequenceId maxSeqId);
+// Number of NextSequenceId steps needed to get from fromSeqId to toSeqId
+uint16_t SequenceIdDistance(ReliableSequenceId fromSeqId, ReliableSequenceId toSeqId);
 
 #ifdef __cplusplus
 } // end extern "C"
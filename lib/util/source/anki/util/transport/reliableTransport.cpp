@@ -34,16 +34,18 @@ CONSOLE_VAR_RANGED(uint32_t,  kPrintNetworkStatsTimeSpacingMS, "Network", 1000,
 
 
 // Packet headers for ensuring that the messages are of the correct type. (Used for unreliable messages sent via this transport too)
-static const uint8_t k_AnkiReliablePacketHeaderPrefix[3] = {'R', 'E', 01}; // i.e. "Reliable Transport Layer 1"
+static const uint8_t k_AnkiReliablePacketHeaderPrefix[3] = {'R', 'E', 02}; // i.e. "Reliable Transport Layer 2" (2 added selective acks)
   
 struct AnkiReliablePacketHeader
 {
-  explicit AnkiReliablePacketHeader(uint8_t messageType, ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax, ReliableSequenceId lastReceivedId)
+  explicit AnkiReliablePacketHeader(uint8_t messageType, ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax, ReliableSequenceId lastReceivedId,
+                                    uint32_t selectiveAckBits)
   {
-    Set(messageType, seqIdMin, seqIdMax, lastReceivedId);
+    Set(messageType, seqIdMin, seqIdMax, lastReceivedId, selectiveAckBits);
   }
   
-  void Set(uint8_t messageType, ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax, ReliableSequenceId lastReceivedId)
+  void Set(uint8_t messageType, ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax, ReliableSequenceId lastReceivedId,
+           uint32_t selectiveAckBits)
   {
     for (uint32_t i = 0; i < sizeof(k_AnkiReliablePacketHeaderPrefix); ++i)
     {
@@ -53,6 +55,8 @@ struct AnkiReliablePacketHeader
     _seqIdMin          = seqIdMin;
     _seqIdMax          = seqIdMax;
     _seqIdLastReceived = lastReceivedId;
+    _selectiveAckBits[0] = (uint16_t)(selectiveAckBits & 0xffff);
+    _selectiveAckBits[1] = (uint16_t)(selectiveAckBits >> 16);
   }
   
   bool HasCorrectPrefix() const
@@ -84,6 +88,12 @@ struct AnkiReliablePacketHeader
     return _seqIdLastReceived;
   }
   
+  // See ReliableConnection::GetInSelectiveAckBits()
+  uint32_t GetSelectiveAckBits() const
+  {
+    return (uint32_t)_selectiveAckBits[0] | ((uint32_t)_selectiveAckBits[1] << 16);
+  }
+  
   uint8_t GetType() const
   {
     return _type;
@@ -99,11 +109,12 @@ struct AnkiReliablePacketHeader
   ReliableSequenceId  _seqIdMin;                // 2:  4+2 = 6
   ReliableSequenceId  _seqIdMax;                // 2:  6+2 = 8
   ReliableSequenceId  _seqIdLastReceived;       // 2:  8+2 = 10
+  uint16_t            _selectiveAckBits[2];     // 4: 10+4 = 14 // split to keep the header 2 byte aligned
 };
-static_assert(sizeof(AnkiReliablePacketHeader) == 10, "Expected size mismatch, check layout and padding" );
+static_assert(sizeof(AnkiReliablePacketHeader) == 14, "Expected size mismatch, check layout and padding" );
 
 
-#define RELIABLE_HEADER_DESCRIPTOR_TEXT   "3cPrefix|Ty|SqMin|SqMax|SqRec|"
+#define RELIABLE_HEADER_DESCRIPTOR_TEXT   "3cPrefix|Ty|SqMin|SqMax|SqRec|SAckLo|SAckHi|"
 static const char* k_ReliableHeaderDescriptor = SIZED_SRC_BUFFER_DESCRIPTOR( RELIABLE_HEADER_DESCRIPTOR_TEXT );
 
   
@@ -158,7 +169,8 @@ void ReliableTransport::ReSendReliableMessage(ReliableConnection* connectionInfo
                                               ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax)
 {
   uint8_t  headerBuffer[ sizeof(AnkiReliablePacketHeader) ];
-  const uint32_t headerSize = BuildHeader(headerBuffer, sizeof(headerBuffer), messageType, seqIdMin, seqIdMax, connectionInfo->GetLastInAckedMessageId());
+  const uint32_t headerSize = BuildHeader(headerBuffer, sizeof(headerBuffer), messageType, seqIdMin, seqIdMax, connectionInfo->GetLastInAckedMessageId(),
+                                           connectionInfo->GetInSelectiveAckBits());
   
   SrcBufferSet srcBuffers;
   srcBuffers.AddBuffer( SizedSrcBuffer(headerBuffer, headerSize, k_ReliableHeaderDescriptor) );
@@ -262,7 +274,8 @@ void ReliableTransport::SendMessage(bool reliable, const TransportAddress& destA
     if (unreliableAndSendImmediately)
     {
       // only need header if we're sending immediately (i.e. unreliably)
-      uint32_t headerSize = BuildHeader(headerBuffer, sizeof(headerBuffer), messageType, seqId, seqId, connectionInfo->GetLastInAckedMessageId());
+      uint32_t headerSize = BuildHeader(headerBuffer, sizeof(headerBuffer), messageType, seqId, seqId, connectionInfo->GetLastInAckedMessageId(),
+                                        connectionInfo->GetInSelectiveAckBits());
       srcBuffers.AddBuffer( SizedSrcBuffer(headerBuffer, headerSize, k_ReliableHeaderDescriptor) );
     }
     
@@ -389,20 +402,48 @@ unsigned int ReliableTransport::FillAddressFromAdvertisement(TransportAddress& a
 void ReliableTransport::HandleSubMessage(const uint8_t* innerMessage, uint32_t innerMessageSize, uint8_t messageType, ReliableSequenceId reliableSequenceId, ReliableConnection* connectionInfo, const TransportAddress& sourceAddress)
 {
   const bool isReliable = (reliableSequenceId != k_InvalidReliableSeqId);
-  const bool isNextReliable = isReliable && connectionInfo->IsNextInSequenceId(reliableSequenceId);
-  const bool ignoreMessage = isReliable && !isNextReliable; // message is a repeat or out of order
+  
+  if (isReliable && !connectionInfo->IsNextInSequenceId(reliableSequenceId))
+  {
+    // message is a repeat or out of order - hold onto it if it's new and ahead of a missing one (so the sender
+    // doesn't have to resend it) until the missing ones arrive
+    const bool isNewMessage = connectionInfo->HoldOutOfOrderMessage(innerMessage, innerMessageSize, messageType, reliableSequenceId);
+    connectionInfo->AddRecvMessageStats(innerMessageSize, isReliable, isNewMessage);
+    return;
+  }
 
-  connectionInfo->AddRecvMessageStats(innerMessageSize, isReliable, !ignoreMessage);
+  connectionInfo->AddRecvMessageStats(innerMessageSize, isReliable, true);
   
-  if (isNextReliable)
+  if (isReliable)
   {
     connectionInfo->AdvanceNextInSequenceId();
   }
-  else if (ignoreMessage)
+  
+  if (!DispatchSubMessage(innerMessage, innerMessageSize, messageType, connectionInfo, sourceAddress))
   {
     return;
   }
   
+  if (isReliable)
+  {
+    // Deliver any held messages that were only waiting on this one
+    std::vector<uint8_t> heldMessageBytes;
+    uint8_t heldMessageType = eRMT_Invalid;
+    while (connectionInfo->PopHeldNextInMessage(heldMessageBytes, heldMessageType))
+    {
+      const uint32_t heldMessageSize = static_cast<uint32_t>(heldMessageBytes.size());
+      const uint8_t* heldMessage = (heldMessageSize > 0) ? heldMessageBytes.data() : nullptr;
+      if (!DispatchSubMessage(heldMessage, heldMessageSize, heldMessageType, connectionInfo, sourceAddress))
+      {
+        return;
+      }
+    }
+  }
+}
+
+
+bool ReliableTransport::DispatchSubMessage(const uint8_t* innerMessage, uint32_t innerMessageSize, uint8_t messageType, ReliableConnection* connectionInfo, const TransportAddress& sourceAddress)
+{
   switch (messageType)
   {
     case eRMT_ConnectionRequest:
@@ -425,7 +466,7 @@ void ReliableTransport::HandleSubMessage(const uint8_t* innerMessage, uint32_t i
         _dataReceiver->ReceiveData(INetTransportDataReceiver::OnDisconnected, 0, sourceAddress);
       }
       DeleteConnection(sourceAddress);
-      break;
+      return false;
     case eRMT_SingleReliableMessage:
     case eRMT_SingleUnreliableMessage:
       if (_dataReceiver)
@@ -466,6 +507,8 @@ void ReliableTransport::HandleSubMessage(const uint8_t* innerMessage, uint32_t i
       PRINT_NAMED_ERROR("ReliableTransport.Sub.BadType", "unknown reliable message type: %u", messageType);
       break;
   }
+  
+  return true;
 }
 
 
@@ -515,7 +558,7 @@ void ReliableTransport::ReceiveData(const uint8_t* buffer, unsigned int size, co
       }
 
       // tell reliable layer any messages the other end has received
-      if (connectionInfo->UpdateLastAckedMessage( reliablePacketHeader->GetSequenceIdLastReceived() ))
+      if (connectionInfo->UpdateLastAckedMessage( reliablePacketHeader->GetSequenceIdLastReceived(), reliablePacketHeader->GetSelectiveAckBits() ))
       {
         // the list of reliable messages was updated - give connection a chance to send latest reliable messages now
         if (sMaxPacketsToReSendOnAck > 0)
@@ -553,15 +596,17 @@ void ReliableTransport::ReceiveData(const uint8_t* buffer, unsigned int size, co
         else
         {
           assert(reliablePacketHeader->GetType() != eRMT_ACK);
-          connectionInfo->AckMessage(maxSeqId);
-          if (sSendAckOnReceipt)
+          if (!IsSequenceIdInRange(connectionInfo->GetNextInSequenceId(), minSeqId, maxSeqId))
           {
-            SendMessage(false, sourceAddress, nullptr, 0, eRMT_ACK, true);
+            // Arrived ahead of a missing message, will be held until that's resent - it's in the selective acks
+            _transportStats.AddRecvError(eME_OutOfOrder);
           }
         }
       }
       
       connectionInfo->AddRecvPacketStats(size, anyMessagesToReceive);
+      
+      const ReliableSequenceId nextInSeqIdBefore = connectionInfo->GetNextInSequenceId();
 
       if (isMultipleMessages)
       {
@@ -615,6 +660,25 @@ void ReliableTransport::ReceiveData(const uint8_t* buffer, unsigned int size, co
         assert(minSeqId == maxSeqId);
         HandleSubMessage(innerMessage, innerMessageSize, messageType, minSeqId, connectionInfo, sourceAddress);
       }
+      
+      if (isReliable && anyMessagesToReceive)
+      {
+        // Ack once everything delivered is known (including held messages it released and any it added to
+        // the selective acks) - the connection is gone if this contained a disconnect request
+        connectionInfo = FindConnection(sourceAddress, false);
+        if (nullptr != connectionInfo)
+        {
+          const ReliableSequenceId nextInSeqId = connectionInfo->GetNextInSequenceId();
+          if (nextInSeqId != nextInSeqIdBefore)
+          {
+            connectionInfo->AckMessage(PreviousSequenceId(nextInSeqId));
+          }
+          if (sSendAckOnReceipt)
+          {
+            SendMessage(false, sourceAddress, nullptr, 0, eRMT_ACK, true);
+          }
+        }
+      }
     }
     else
     {
@@ -648,12 +712,13 @@ void ReliableTransport::ReceiveData(const uint8_t* buffer, unsigned int size, co
 }
 
 
-uint32_t ReliableTransport::BuildHeader(uint8_t* outBuffer, uint32_t outBufferCapacity, uint8_t type, ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax, ReliableSequenceId lastReceivedId)
+uint32_t ReliableTransport::BuildHeader(uint8_t* outBuffer, uint32_t outBufferCapacity, uint8_t type, ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax,
+                                        ReliableSequenceId lastReceivedId, uint32_t selectiveAckBits)
 {
   ASSERT_AND_RETURN_VALUE_IF_FAIL(outBufferCapacity >= sizeof(AnkiReliablePacketHeader), 0);
 
   AnkiReliablePacketHeader* packetHeader = reinterpret_cast<AnkiReliablePacketHeader*>(outBuffer);
-  packetHeader->Set(type, seqIdMin, seqIdMax, lastReceivedId);
+  packetHeader->Set(type, seqIdMin, seqIdMax, lastReceivedId, selectiveAckBits);
   
   return sizeof(AnkiReliablePacketHeader);
 }
@@ -80,6 +80,7 @@ public:
   uint32_t MaxTotalBytesPerMessage() const;
 
   const TransportStats& GetTransportStats() const { return _transportStats; }
+  void AddSentPayloadStats(uint32_t firstSendBytes, uint32_t resendBytes) { _transportStats.AddSentPayload(firstSendBytes, resendBytes); }
 
   static void  SetSendAckOnReceipt(bool newVal)                  { sSendAckOnReceipt = newVal; }
   static void  SetSendUnreliableMessagesImmediately(bool newVal) { sSendUnreliableMessagesImmediately = newVal; }
@@ -108,8 +109,11 @@ private:
   void QueueAction(std::function<void()> action);
 
   void HandleSubMessage(const uint8_t* innerMessage, uint32_t innerMessageSize, uint8_t messageType, ReliableSequenceId reliableSequenceId, ReliableConnection* connectionInfo, const TransportAddress& sourceAddress);
+  // returns false if the message deleted the connection
+  bool DispatchSubMessage(const uint8_t* innerMessage, uint32_t innerMessageSize, uint8_t messageType, ReliableConnection* connectionInfo, const TransportAddress& sourceAddress);
 
-  uint32_t BuildHeader(uint8_t* outBuffer, uint32_t outBufferCapacity, uint8_t type, ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax, ReliableSequenceId lastReceivedId);
+  uint32_t BuildHeader(uint8_t* outBuffer, uint32_t outBufferCapacity, uint8_t type, ReliableSequenceId seqIdMin, ReliableSequenceId seqIdMax,
+                       ReliableSequenceId lastReceivedId, uint32_t selectiveAckBits);
 
   ReliableConnection*   FindConnection(const TransportAddress& sourceAddressIn, bool createIfNew);
   void                  DeleteConnection(const TransportAddress& sourceAddress);
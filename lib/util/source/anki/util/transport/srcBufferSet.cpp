@@ -91,6 +91,23 @@ uint32_t SrcBufferSet::CalculateTotalSize() const
 }
   
   
+void SrcBufferSet::CopyCombinedBufferInto(uint8_t* outBuffer) const
+{
+  uint32_t bytesWritten = 0;
+  for (uint32_t i=0 ; i < _bufferCount; ++i)
+  {
+    const SizedSrcBuffer& srcBuffer = GetBuffer(i);
+    const uint32_t srcBufferSize = srcBuffer.GetSize();
+    if (srcBufferSize > 0)
+    {
+      memcpy(&outBuffer[bytesWritten], srcBuffer.GetBuffer(), srcBufferSize);
+      bytesWritten += srcBufferSize;
+    }
+  }
+  assert(bytesWritten == CalculateTotalSize());
+}
+
+
 uint8_t* SrcBufferSet::CreateCombinedBuffer() const
 {
   const uint32_t totalSize = CalculateTotalSize();
@@ -99,18 +116,7 @@ uint8_t* SrcBufferSet::CreateCombinedBuffer() const
   {
     uint8_t* buffer = new uint8_t[totalSize];
     
-    uint32_t bytesWritten = 0;
-    for (uint32_t i=0 ; i < _bufferCount; ++i)
-    {
-      const SizedSrcBuffer& srcBuffer = GetBuffer(i);
-      const uint32_t srcBufferSize = srcBuffer.GetSize();
-      if (srcBufferSize > 0)
-      {
-        memcpy(&buffer[bytesWritten], srcBuffer.GetBuffer(), srcBufferSize);
-        bytesWritten += srcBufferSize;
-      }
-    }
-    assert(bytesWritten == totalSize);
+    CopyCombinedBufferInto(buffer);
     
     return buffer;
   }
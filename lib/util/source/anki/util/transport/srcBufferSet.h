@@ -95,6 +95,9 @@ public:
     return _buffers[index];
   }
   
+  // Copies all buffers, in order, into outBuffer (which must have room for CalculateTotalSize() bytes)
+  void CopyCombinedBufferInto(uint8_t* outBuffer) const;
+  
   uint8_t* CreateCombinedBuffer() const;
   static void DestroyCombinedBuffer(uint8_t* combinedBuffer);
   
@@ -127,6 +127,8 @@ void MessageStats::Print(const char* inName) const
 TransportStats::TransportStats(const char* inName)
   : _sentStats("Sent")
   , _recvStats("Recv")
+  , _goodputBytes(0)
+  , _retransmitBytes(0)
   , _name(inName)
 {
 }
@@ -136,6 +138,8 @@ void TransportStats::Reset()
 {
   _sentStats.Reset();
   _recvStats.Reset();
+  _goodputBytes    = 0;
+  _retransmitBytes = 0;
 }
 
 
@@ -150,6 +154,13 @@ void TransportStats::AddSentMessage(uint32_t messageSize)
   _sentStats.AddMessage(messageSize);
 }
 
+
+void TransportStats::AddSentPayload(uint32_t firstSendBytes, uint32_t resendBytes)
+{
+  _goodputBytes    += firstSendBytes;
+  _retransmitBytes += resendBytes;
+}
+
   
 void TransportStats::AddRecvError(EMessageError messageError)
 {
@@ -167,6 +178,14 @@ void TransportStats::Print() const
 {
   _sentStats.Print(_name);
   _recvStats.Print(_name);
+  
+  const uint64_t totalPayloadBytes = _goodputBytes + _retransmitBytes;
+  if (totalPayloadBytes > 0)
+  {
+    const double retransmitPercent = 100.0 * (double)_retransmitBytes / (double)totalPayloadBytes;
+    PRINT_CH_INFO("Network", "TransportStats", "[%s] payload: %llu goodput bytes, %llu retransmit bytes (%.1f%% retransmitted)",
+                  _name, _goodputBytes, _retransmitBytes, retransmitPercent);
+  }
 }
 
 
@@ -86,6 +86,8 @@ public:
   
   void AddRecvMessage(uint32_t messageSize);
   void AddSentMessage(uint32_t messageSize);
+  // Payload bytes put on the wire, split by whether it's the first time they were sent or a retransmit
+  void AddSentPayload(uint32_t firstSendBytes, uint32_t resendBytes);
   
   void AddRecvError(EMessageError messageError);
   void AddSendError(EMessageError messageError);
@@ -95,11 +97,17 @@ public:
   const MessageStats& GetSentStats() const { return _sentStats; }
   const MessageStats& GetRecvStats() const { return _recvStats; }
   
+  uint64_t  GetGoodputBytes()    const { return _goodputBytes; }
+  uint64_t  GetRetransmitBytes() const { return _retransmitBytes; }
+  
 private:
   
   MessageStats  _sentStats;
   MessageStats  _recvStats;
   
+  uint64_t      _goodputBytes;
+  uint64_t      _retransmitBytes;
+  
   const char* _name;
 };
 
@@ -99,6 +99,11 @@ public:
     return sendto(socketId, messageData, messageDataSize, flags, destSockAddress, destSockAddressLength);
   }
 
+  virtual ssize_t SendMessage(int socketId, const msghdr* messageHeader, int flags) override
+  {
+    return sendmsg(socketId, messageHeader, flags);
+  }
+
   virtual ssize_t ReceiveMessage(int socketId, msghdr* messageHeader, int flags) override
   {
     return recvmsg(socketId, messageHeader, flags);
@@ -713,18 +718,11 @@ uint32_t BuildPacketHeader(uint8_t* outBuffer, const SrcBufferSet& srcBuffers)
 }
 
 
-uint32_t BuildPacket(uint8_t* outBuffer, uint32_t outBufferCapacity, const SrcBufferSet& srcBuffers)
+ssize_t UDPTransport::SendDataToSockAddress(const sockaddr& destSockAddress, uint32_t destSockAddressLengthIn, const SrcBufferSet& srcBuffers)
 {
-  const uint32_t headerSize = UDPTransport::GetHeaderSize();
-  
-  if (outBufferCapacity < headerSize)
-  {
-    // Not even enough room to write the header!
-    assert(0);
-    return 0;
-  }
-  
-  if (outBufferCapacity < (headerSize + srcBuffers.CalculateTotalSize()))
+  const uint32_t headerSize = GetHeaderSize();
+  const uint32_t bufferWithHeaderSize = headerSize + srcBuffers.CalculateTotalSize();
+  if (bufferWithHeaderSize > kMaxNetMessageSize)
   {
     // Not big enough for header and entire message...
     // Should have been split at higher network level (e.g. reliablity level)
@@ -732,38 +730,38 @@ uint32_t BuildPacket(uint8_t* outBuffer, uint32_t outBufferCapacity, const SrcBu
     return 0;
   }
   
-  uint32_t outBufferSize = BuildPacketHeader(outBuffer, srcBuffers);
-  assert(outBufferSize == headerSize);
-
+  uint8_t header[HeaderPrefix::kMaxLength + sizeof(HeaderCRCType)];
+  const uint32_t headerBytesWritten = BuildPacketHeader(header, srcBuffers);
+  assert(headerBytesWritten == headerSize);
+  
+  // Send the header and each source buffer as they are, rather than first copying them all into one packet
+  iovec iov[1 + SrcBufferSet::k_MaxBuffers];
+  iov[0].iov_base = header;
+  iov[0].iov_len  = headerBytesWritten;
+  int numIoVecs = 1;
   for (uint32_t i=0; i < srcBuffers.GetCount(); ++i)
   {
     const SizedSrcBuffer& srcBuffer = srcBuffers.GetBuffer(i);
-    const uint32_t srcBufferSize = srcBuffer.GetSize();
-    if (srcBufferSize > 0)
+    if (srcBuffer.GetSize() > 0)
     {
-      memcpy(&outBuffer[outBufferSize], srcBuffer.GetBuffer(), srcBufferSize);
-      outBufferSize += srcBufferSize;
+      iov[numIoVecs].iov_base = const_cast<uint8_t*>(srcBuffer.GetBuffer());
+      iov[numIoVecs].iov_len  = srcBuffer.GetSize();
+      ++numIoVecs;
     }
   }
   
-  assert(outBufferSize <= outBufferCapacity);
-  
-  return outBufferSize;
-}
-
-
-ssize_t UDPTransport::SendDataToSockAddress(const sockaddr& destSockAddress, uint32_t destSockAddressLengthIn, const SrcBufferSet& srcBuffers)
-{
-  socklen_t destSockAddressLength = destSockAddressLengthIn;
-  
-  uint8_t bufferWithHeader[kMaxNetMessageSize];
-  uint32_t bufferWithHeaderSize = BuildPacket(bufferWithHeader, sizeof(bufferWithHeader), srcBuffers);
+  msghdr message;
+  memset(&message, 0, sizeof(message));
+  message.msg_name       = const_cast<sockaddr*>(&destSockAddress);
+  message.msg_namelen    = destSockAddressLengthIn;
+  message.msg_iov        = iov;
+  message.msg_iovlen     = numIoVecs;
  
-  ANKI_NET_MESSAGE_VERBOSE(("UDP Send", GetAnkiPacketHeaderDescriptor(), bufferWithHeader, bufferWithHeaderSize, &srcBuffers));
+  ANKI_NET_MESSAGE_VERBOSE(("UDP Send Header", GetAnkiPacketHeaderDescriptor(), header, headerBytesWritten));
   
   _transportStats.AddSentMessage(bufferWithHeaderSize);
   
-  ssize_t sentBytes = _udpSocketImpl->SendTo( _socketId, bufferWithHeader, bufferWithHeaderSize, 0, &destSockAddress, destSockAddressLength );
+  ssize_t sentBytes = _udpSocketImpl->SendMessage( _socketId, &message, 0 );
   
   if (sentBytes != bufferWithHeaderSize)
   {
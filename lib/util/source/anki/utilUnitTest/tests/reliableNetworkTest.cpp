@@ -679,10 +679,17 @@ static void HugePacketTest()
   
   printf("HugePacketTest: Simulated %u packets arrived out of order requiring resends. (host1: %u, client2: %u)\n",
          totalOutOfOrder, outOfOrderHost1, outOfOrderClient2);
-  
+
   // not a test fail as such, but we want to make sure the deterministic random values we're giving result in at least
   // 1 out of order message (from packet lost or reorder) otherwise we weren't really stressing anything
   EXPECT_GE( totalOutOfOrder, 1 );
+
+  // Every part was sent at least once, and losses mean some were sent again
+  const TransportStats& host1Stats = host1._reliableTransport.GetTransportStats();
+  printf("HugePacketTest: host1 sent %llu goodput bytes, %llu retransmit bytes\n",
+         (unsigned long long)host1Stats.GetGoodputBytes(), (unsigned long long)host1Stats.GetRetransmitBytes());
+  EXPECT_GE( host1Stats.GetGoodputBytes(), k_SizeOfHugeMessageBuffer );
+  EXPECT_GT( host1Stats.GetRetransmitBytes(), 0 );
 }
 
 
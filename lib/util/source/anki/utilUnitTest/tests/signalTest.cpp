@@ -10,7 +10,9 @@
 #include "util/helpers/includeGTest.h"
 
 #include "util/signals/simpleSignal.hpp"
+#include <functional>
 #include <iostream>
+#include <vector>
 
 TEST(SignalTest, ScopedHandles)
 {
@@ -109,3 +111,93 @@ TEST(SignalTest, ClassUsage)
     delete observer;
   }
 }
+
+TEST(SignalTest, UnsubscribeDuringEmit)
+{
+  // handlers removed during an emission, including the running one, shouldn't be called again
+  {
+    using TestSignal = Signal::Signal<void(void)>;
+    TestSignal signal;
+
+    int a = 0;
+    int b = 0;
+    Signal::SmartHandle handleB;
+    Signal::SmartHandle handleA = signal.ScopedSubscribe( [&] { ++a; handleA = nullptr; handleB = nullptr; } );
+    handleB = signal.ScopedSubscribe( [&b] { ++b; } );
+    signal.emit();
+    ASSERT_EQ(a, 1);
+    ASSERT_EQ(b, 0);
+    ASSERT_FALSE(signal.HasSubscribers());
+    signal.emit();
+    ASSERT_EQ(a, 1);
+  }
+}
+
+TEST(SignalTest, SubscribeDuringEmit)
+{
+  // handlers added during an emission are called from the next one
+  {
+    using TestSignal = Signal::Signal<void(int)>;
+    TestSignal signal;
+
+    std::vector<int> calls;
+    std::vector<Signal::SmartHandle> handles;
+    handles.push_back(signal.ScopedSubscribe( [&] (int i) {
+      calls.push_back(i);
+      if (i == 0) {
+        for (int j = 0; j < 16; ++j) {
+          handles.push_back(signal.ScopedSubscribe( [&calls] (int i) { calls.push_back(100 + i); } ));
+        }
+        signal.emit(1);
+      }
+    } ));
+    signal.emit(0);
+    ASSERT_EQ(calls, (std::vector<int>{0, 1}));
+
+    calls.clear();
+    signal.emit(2);
+    ASSERT_EQ(calls.size(), 17);
+    ASSERT_EQ(calls[0], 2);
+    ASSERT_EQ(calls[16], 102);
+  }
+}
+
+TEST(SignalTest, ArgumentsAreNotCopied)
+{
+  // handlers taking references get the emitted object itself
+  {
+    struct CopyCounter {
+      CopyCounter() = default;
+      CopyCounter(const CopyCounter& other) : copies(other.copies + 1) {}
+      int copies = 0;
+    };
+    using TestSignal = Signal::Signal<void(const CopyCounter&)>;
+    TestSignal signal;
+
+    const CopyCounter counter;
+    int seen = 0;
+    std::function<void(const CopyCounter&)> wrapped = [&seen, &counter] (const CopyCounter& c) { seen += (&c == &counter); };
+    Signal::SmartHandle handle1 = signal.ScopedSubscribe( [&seen, &counter] (const CopyCounter& c) { seen += (&c == &counter); } );
+    Signal::SmartHandle handle2 = signal.ScopedSubscribe( wrapped );
+    signal.emit(counter);
+    ASSERT_EQ(seen, 2);
+  }
+}
+
+TEST(SignalTest, EmptyFunctionsAreNotSubscribed)
+{
+  {
+    using TestSignal = Signal::Signal<void(void)>;
+    TestSignal signal;
+    ASSERT_FALSE(signal.HasSubscribers());
+    Signal::SmartHandle handle = signal.ScopedSubscribe( std::function<void()>() );
+    ASSERT_FALSE(signal.HasSubscribers());
+    signal.emit();
+
+    int a = 0;
+    TestSignal withDefault( [&a] { ++a; } );
+    ASSERT_TRUE(withDefault.HasSubscribers());
+    withDefault.emit();
+    ASSERT_EQ(a, 1);
+  }
+}
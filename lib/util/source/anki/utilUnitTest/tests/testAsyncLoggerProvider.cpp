@@ -0,0 +1,136 @@
+/**
+ * File: testAsyncLoggerProvider
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for AsyncLoggerProvider
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=AsyncLoggerProvider*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/logging/asyncLoggerProvider.h"
+
+#include <stdio.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Anki::Util;
+
+namespace {
+
+class TestLoggerProvider : public ILoggerProvider
+{
+public:
+  std::vector<std::string> lines;
+
+  void PrintEvent(const char* eventName, const KVPairVector& keyValues, const char* eventValue) override {
+    std::string line = std::string("E ") + eventName + " " + eventValue;
+    for (const auto& kv: keyValues) {
+      line += std::string(" ") + kv.first + "=" + kv.second;
+    }
+    lines.push_back(line);
+  }
+  void PrintLogE(const char* eventName, const KVPairVector& keyValues, const char* eventValue) override {
+    lines.push_back(std::string("ERR ") + eventName + " " + eventValue);
+  }
+  void PrintLogW(const char* eventName, const KVPairVector& keyValues, const char* eventValue) override {
+    lines.push_back(std::string("W ") + eventName + " " + eventValue);
+  }
+
+protected:
+  void PrintLogI(const char* channel, const char* eventName, const KVPairVector& keyValues, const char* eventValue) override {
+    lines.push_back(std::string("I ") + channel + " " + eventName + " " + eventValue);
+  }
+  void PrintLogD(const char* channel, const char* eventName, const KVPairVector& keyValues, const char* eventValue) override {
+    lines.push_back(std::string("D ") + channel + " " + eventName + " " + eventValue);
+  }
+};
+
+}
+
+
+TEST(AsyncLoggerProvider, FlushWritesEverythingInOrder)
+{
+  TestLoggerProvider output;
+  AsyncLoggerProvider logger(&output);
+
+  logger.PrintEvent("robot.boot", {{"s1", "ok"}}, "");
+  logger.PrintLogW("Test.Warning", {}, "first");
+  logger.PrintChanneledLogI("Channel", "Test.Info", {}, "second");
+  logger.PrintChanneledLogD("Channel", "Test.Debug", {}, "third");
+
+  std::thread otherThread([&logger] {
+    logger.PrintLogE("Test.Error", {}, "fourth");
+  });
+  otherThread.join();
+
+  logger.Flush();
+  const std::vector<std::string> expected = {
+    "E robot.boot  s1=ok",
+    "W Test.Warning first",
+    "I Channel Test.Info second",
+    "D Channel Test.Debug third",
+    "ERR Test.Error fourth",
+  };
+  EXPECT_EQ(expected, output.lines);
+  EXPECT_EQ(0, logger.GetNumDroppedMessages());
+}
+
+
+TEST(AsyncLoggerProvider, FullRingDropsAndReports)
+{
+  TestLoggerProvider output;
+  const int numLines = 2000;
+  uint64_t numDropped = 0;
+  {
+    // the smallest ring there is, so a burst from one thread is bound to overflow it
+    AsyncLoggerProvider logger(&output, 0);
+    for (int i = 0; i < numLines; ++i) {
+      char line[32];
+      snprintf(line, sizeof(line), "%d", i);
+      logger.PrintChanneledLogI("Channel", "Test.Line", {}, line);
+    }
+    logger.Flush();
+    numDropped = logger.GetNumDroppedMessages();
+  }
+  EXPECT_LT(0, numDropped);
+
+  // the lines that made it are in order, and the drops were reported
+  int lastLine = -1;
+  int numWritten = 0;
+  int numReports = 0;
+  for (const auto& line: output.lines) {
+    int lineNum = -1;
+    if (sscanf(line.c_str(), "I Channel Test.Line %d", &lineNum) == 1) {
+      EXPECT_LT(lastLine, lineNum);
+      lastLine = lineNum;
+      ++numWritten;
+    } else {
+      EXPECT_EQ(0, line.find("W AsyncLoggerProvider.DroppedMessages"));
+      ++numReports;
+    }
+  }
+  EXPECT_EQ(numLines, numWritten + numDropped);
+  EXPECT_LE(1, numReports);
+}
+
+
+TEST(AsyncLoggerProvider, LongLinesAreTruncated)
+{
+  TestLoggerProvider output;
+  AsyncLoggerProvider logger(&output);
+
+  const std::string longValue(10000, 'x');
+  logger.PrintLogW("Test.Long", {}, longValue.c_str());
+  logger.Flush();
+
+  ASSERT_EQ(1, output.lines.size());
+  EXPECT_GT(longValue.size(), output.lines[0].size());
+  EXPECT_EQ(0, output.lines[0].find("W Test.Long xxxx"));
+}
@@ -0,0 +1,270 @@
+/**
+ * File: testCpuHitchRecorder
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for CpuHitchRecorder
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=CpuHitchRecorder*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/cpuProfiler/cpuProfiler.h"
+#include "util/fileUtils/fileUtils.h"
+
+#include <atomic>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if ANKI_CPU_HITCH_RECORDER_ENABLED
+
+using namespace Anki::Util;
+
+namespace {
+
+const std::string kTestDirectory = "cpuHitchRecorderTest";
+
+struct DumpRecord {
+  std::string name;
+  bool isTick;
+  uint32_t start_us;
+  uint32_t duration_us;
+};
+
+struct DumpThread {
+  std::string tickName;
+  std::vector<DumpRecord> records;
+};
+
+struct Dump {
+  uint16_t triggerThread = 0;
+  std::vector<DumpThread> threads;
+
+  const DumpThread* FindThread(const std::string& tickName) const
+  {
+    for (const auto& thread : threads) {
+      if (thread.tickName == tickName) {
+        return &thread;
+      }
+    }
+    return nullptr;
+  }
+};
+
+template <typename T>
+T Read(const std::vector<uint8_t>& bytes, size_t& offset)
+{
+  T value{};
+  if (offset + sizeof(T) <= bytes.size()) {
+    memcpy(&value, &bytes[offset], sizeof(T));
+  }
+  offset += sizeof(T);
+  return value;
+}
+
+bool ReadDump(const std::string& path, Dump& dump)
+{
+  const std::vector<uint8_t> bytes = FileUtils::ReadFileAsBinary(path);
+  size_t offset = 0;
+  if ((Read<uint32_t>(bytes, offset) != CpuHitchRecorder::kDumpFileMagic) ||
+      (Read<uint16_t>(bytes, offset) != CpuHitchRecorder::kDumpFileVersion)) {
+    return false;
+  }
+  const uint16_t numNames = Read<uint16_t>(bytes, offset);
+  const uint16_t numThreads = Read<uint16_t>(bytes, offset);
+  dump.triggerThread = Read<uint16_t>(bytes, offset);
+  Read<int64_t>(bytes, offset);  // wall clock
+  Read<uint32_t>(bytes, offset); // window
+
+  std::vector<std::string> names;
+  for (uint16_t i = 0; i < numNames; ++i) {
+    const uint8_t length = Read<uint8_t>(bytes, offset);
+    names.emplace_back(reinterpret_cast<const char*>(&bytes[offset]), length);
+    offset += length;
+  }
+
+  for (uint16_t i = 0; (i < numThreads) && (offset < bytes.size()); ++i) {
+    DumpThread thread;
+    thread.tickName = names.at(Read<uint16_t>(bytes, offset));
+    const uint32_t numRecords = Read<uint32_t>(bytes, offset);
+    for (uint32_t r = 0; r < numRecords; ++r) {
+      DumpRecord record;
+      record.name = names.at(Read<uint16_t>(bytes, offset));
+      record.isTick = (Read<uint8_t>(bytes, offset) != 0);
+      record.start_us = Read<uint32_t>(bytes, offset);
+      record.duration_us = Read<uint32_t>(bytes, offset);
+      thread.records.push_back(record);
+    }
+    dump.threads.push_back(std::move(thread));
+  }
+  return offset == bytes.size();
+}
+
+void Spin(std::chrono::microseconds duration)
+{
+  const auto end = CpuProfileClock::now() + duration;
+  while (CpuProfileClock::now() < end) {
+  }
+}
+
+class CpuHitchRecorderTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    FileUtils::RemoveDirectory(kTestDirectory);
+    CpuHitchRecorder::SetDumpDirectory(kTestDirectory, "test");
+  }
+
+  void TearDown() override
+  {
+    CpuHitchRecorder::SetDumpDirectory("", "");
+    FileUtils::RemoveDirectory(kTestDirectory);
+  }
+};
+
+} // namespace
+
+
+TEST_F(CpuHitchRecorderTest, DumpHoldsRecentTicksAndSamples)
+{
+  std::thread thread([] {
+    for (int i = 0; i < 3; ++i) {
+      ANKI_CPU_TICK("HitchTestTick", 1000.0, UINT32_MAX);
+      {
+        ANKI_CPU_PROFILE("HitchTestOuter");
+        Spin(std::chrono::microseconds(200));
+        {
+          ANKI_CPU_PROFILE("HitchTestInner");
+          Spin(std::chrono::microseconds(100));
+        }
+      }
+      {
+        ANKI_CPU_PROFILE("HitchTestTooQuick");
+      }
+    }
+    ANKI_CPU_REMOVE_THIS_THREAD();
+  });
+  thread.join();
+
+  const std::string path = FileUtils::FullFilePath({kTestDirectory, "manual.cpuh"});
+  ASSERT_TRUE(CpuHitchRecorder::WriteDump(path, CpuProfileClock::now(), 0));
+
+  Dump dump;
+  ASSERT_TRUE(ReadDump(path, dump));
+  const DumpThread* ticked = dump.FindThread("HitchTestTick");
+  ASSERT_NE(ticked, nullptr);
+  ASSERT_EQ(ticked->records.size(), 9u);
+
+  // Records are in the order they finished: inner, outer, then the tick that holds them
+  for (size_t i = 0; i < 9; i += 3) {
+    const DumpRecord& inner = ticked->records[i];
+    const DumpRecord& outer = ticked->records[i + 1];
+    const DumpRecord& tick = ticked->records[i + 2];
+    EXPECT_EQ(inner.name, "HitchTestInner");
+    EXPECT_EQ(outer.name, "HitchTestOuter");
+    EXPECT_EQ(tick.name, "HitchTestTick");
+    EXPECT_FALSE(inner.isTick);
+    EXPECT_TRUE(tick.isTick);
+    EXPECT_GE(inner.duration_us, 100);
+    EXPECT_GE(outer.duration_us, 300);
+    EXPECT_LE(outer.start_us, inner.start_us);
+    EXPECT_GE(outer.start_us + outer.duration_us, inner.start_us + inner.duration_us);
+    EXPECT_LE(tick.start_us, outer.start_us);
+  }
+}
+
+TEST_F(CpuHitchRecorderTest, ThreadsWithoutATickAreNotRecorded)
+{
+  std::thread thread([] {
+    ANKI_CPU_PROFILE("HitchTestUntracked");
+    EXPECT_FALSE(CpuHitchRecorder::IsRecordingThread());
+  });
+  thread.join();
+
+  const std::string path = FileUtils::FullFilePath({kTestDirectory, "manual.cpuh"});
+  ASSERT_TRUE(CpuHitchRecorder::WriteDump(path, CpuProfileClock::now(), 0));
+  Dump dump;
+  ASSERT_TRUE(ReadDump(path, dump));
+  for (const auto& thread : dump.threads) {
+    for (const auto& record : thread.records) {
+      EXPECT_NE(record.name, "HitchTestUntracked");
+    }
+  }
+}
+
+TEST_F(CpuHitchRecorderTest, OverrunWritesDumpFile)
+{
+  std::thread thread([] {
+    for (int i = 0; i < 3; ++i) {
+      ANKI_CPU_TICK("HitchTestOverrun", 1.0, UINT32_MAX);
+      ANKI_CPU_PROFILE("HitchTestSlow");
+      Spin(std::chrono::microseconds(i == 2 ? 3000 : 100));
+    }
+    ANKI_CPU_REMOVE_THIS_THREAD();
+  });
+  thread.join();
+
+  std::vector<std::string> dumps;
+  for (int i = 0; (i < 200) && dumps.empty(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    dumps = FileUtils::FilesInDirectory(kTestDirectory, true, CpuHitchRecorder::kDumpFileExtension);
+  }
+  ASSERT_EQ(dumps.size(), 1u);
+  EXPECT_EQ(FileUtils::GetFileName(dumps[0]).find("test-"), 0u);
+
+  Dump dump;
+  ASSERT_TRUE(ReadDump(dumps[0], dump));
+  const DumpThread* overran = dump.FindThread("HitchTestOverrun");
+  ASSERT_NE(overran, nullptr);
+  ASSERT_LT(dump.triggerThread, dump.threads.size());
+  EXPECT_EQ(dump.threads[dump.triggerThread].tickName, "HitchTestOverrun");
+  ASSERT_EQ(overran->records.size(), 6u);
+  EXPECT_GE(overran->records[5].duration_us, 3000);
+}
+
+TEST_F(CpuHitchRecorderTest, DumpWhileRecordingKeepsOnlyIntactRecords)
+{
+  std::atomic<bool> stop{false};
+  std::thread thread([&stop] {
+    while (!stop) {
+      ANKI_CPU_TICK("HitchTestBusy", 1000.0, UINT32_MAX);
+      for (int i = 0; i < 100; ++i) {
+        const auto start = CpuProfileClock::now();
+        CpuHitchRecorder::AddSample("HitchTestBusySample", start, start + std::chrono::microseconds(20));
+      }
+    }
+    ANKI_CPU_REMOVE_THIS_THREAD();
+  });
+
+  const std::string path = FileUtils::FullFilePath({kTestDirectory, "busy.cpuh"});
+  for (int i = 0; i < 20; ++i) {
+    ASSERT_TRUE(CpuHitchRecorder::WriteDump(path, CpuProfileClock::now(), 0));
+    Dump dump;
+    ASSERT_TRUE(ReadDump(path, dump));
+    const DumpThread* busy = dump.FindThread("HitchTestBusy");
+    if (busy == nullptr) {
+      continue; // not registered yet
+    }
+    EXPECT_LE(busy->records.size(), CpuHitchRecorder::kRecordsPerThread);
+    for (const auto& record : busy->records) {
+      if (record.isTick) {
+        ASSERT_EQ(record.name, "HitchTestBusy");
+      } else {
+        ASSERT_EQ(record.name, "HitchTestBusySample");
+        ASSERT_EQ(record.duration_us, 20);
+      }
+    }
+  }
+
+  stop = true;
+  thread.join();
+}
+
+#endif // ANKI_CPU_HITCH_RECORDER_ENABLED
@@ -0,0 +1,148 @@
+/**
+ * File: testDependencyManagedEntity
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for the update order of DependencyManagedEntity, with and without parallel batches
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=DependencyManagedEntity*
+ **/
+
+
+#include "util/entityComponent/dependencyManagedEntity.h"
+#include "util/helpers/includeGTest.h"
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+enum class TestEntityCompID {
+  A,
+  B,
+  C,
+  D,
+  Count
+};
+
+template<TestEntityCompID kID>
+class TestEntityComp : public IDependencyManagedComponent<TestEntityCompID>
+{
+public:
+  TestEntityComp(std::set<TestEntityCompID>&& dependencies, bool canUpdateInParallel, std::vector<TestEntityCompID>& log, std::mutex& logMutex)
+  : IDependencyManagedComponent<TestEntityCompID>(this, kID)
+  , _dependencies(std::move(dependencies))
+  , _canUpdateInParallel(canUpdateInParallel)
+  , _log(log)
+  , _logMutex(logMutex) {}
+
+  virtual void GetUpdateDependencies(std::set<TestEntityCompID>& dependencies) const override {
+    dependencies = _dependencies;
+  }
+  virtual bool CanUpdateInParallel() const override { return _canUpdateInParallel; }
+  virtual void UpdateDependent(const DependencyManagedEntity<TestEntityCompID>& dependentComps) override {
+    std::lock_guard<std::mutex> lock(_logMutex);
+    _log.push_back(kID);
+  }
+
+private:
+  const std::set<TestEntityCompID> _dependencies;
+  const bool _canUpdateInParallel;
+  std::vector<TestEntityCompID>& _log;
+  std::mutex& _logMutex;
+};
+
+using TestEntityCompA = TestEntityComp<TestEntityCompID::A>;
+using TestEntityCompB = TestEntityComp<TestEntityCompID::B>;
+using TestEntityCompC = TestEntityComp<TestEntityCompID::C>;
+using TestEntityCompD = TestEntityComp<TestEntityCompID::D>;
+
+} // namespace Vector
+
+LINK_COMPONENT_TYPE_TO_ENUM(TestEntityCompA, TestEntityCompID, A)
+LINK_COMPONENT_TYPE_TO_ENUM(TestEntityCompB, TestEntityCompID, B)
+LINK_COMPONENT_TYPE_TO_ENUM(TestEntityCompC, TestEntityCompID, C)
+LINK_COMPONENT_TYPE_TO_ENUM(TestEntityCompD, TestEntityCompID, D)
+
+template<>
+std::string GetComponentStringForID<Vector::TestEntityCompID>(Vector::TestEntityCompID enumID)
+{
+  return std::to_string(static_cast<int>(enumID));
+}
+
+} // namespace Anki
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+TEST(DependencyManagedEntity, ParallelBatchesKeepDeclaredOrder)
+{
+  using ID = TestEntityCompID;
+  for (const size_t numWorkers: {0, 3}) {
+    std::vector<ID> log;
+    std::mutex logMutex;
+
+    // A and B can update in parallel, C depends on A, and D (parallel) depends on C
+    DependencyManagedEntity<ID> entity;
+    entity.AddDependentComponent(ID::A, new TestEntityCompA({}, true, log, logMutex));
+    entity.AddDependentComponent(ID::B, new TestEntityCompB({}, true, log, logMutex));
+    entity.AddDependentComponent(ID::C, new TestEntityCompC({ID::A}, false, log, logMutex));
+    entity.AddDependentComponent(ID::D, new TestEntityCompD({ID::C}, true, log, logMutex));
+    entity.SetNumUpdateWorkers(numWorkers);
+
+    for (int tick = 0; tick < 20; ++tick) {
+      log.clear();
+      entity.UpdateComponents();
+      ASSERT_EQ(4, log.size());
+      auto indexOf = [&log](ID id) { return std::find(log.begin(), log.end(), id) - log.begin(); };
+      EXPECT_LT(indexOf(ID::A), indexOf(ID::C));
+      EXPECT_LT(indexOf(ID::C), indexOf(ID::D));
+      // A and B share the first batch, so both are done before C
+      EXPECT_LT(indexOf(ID::B), indexOf(ID::C));
+    }
+  }
+}
+
+TEST(DependencyManagedEntity, UpdateTiming)
+{
+  using ID = TestEntityCompID;
+  for (const size_t numWorkers: {0, 3}) {
+    std::vector<ID> log;
+    std::mutex logMutex;
+
+    DependencyManagedEntity<ID> entity;
+    entity.AddDependentComponent(ID::A, new TestEntityCompA({}, true, log, logMutex));
+    entity.AddDependentComponent(ID::B, new TestEntityCompB({}, true, log, logMutex));
+    entity.AddDependentComponent(ID::C, new TestEntityCompC({ID::A}, false, log, logMutex));
+    entity.AddDependentComponent(ID::D, new TestEntityCompD({ID::C}, true, log, logMutex));
+    entity.SetNumUpdateWorkers(numWorkers);
+
+    // off by default
+    entity.UpdateComponents();
+    EXPECT_TRUE(entity.GetUpdateTimes().empty());
+
+    entity.SetUpdateTimingEnabled(true);
+    for (int tick = 0; tick < 5; ++tick) {
+      entity.UpdateComponents();
+    }
+    const auto times = entity.GetUpdateTimes();
+    ASSERT_EQ(4, times.size());
+    for (const ID id: {ID::A, ID::B, ID::C, ID::D}) {
+      ASSERT_EQ(1, times.count(id));
+      EXPECT_GT(times.at(id).count(), 0);
+    }
+
+    // totals only grow while enabled
+    entity.SetUpdateTimingEnabled(false);
+    entity.UpdateComponents();
+    EXPECT_EQ(times, entity.GetUpdateTimes());
+
+    entity.ResetUpdateTimes();
+    EXPECT_TRUE(entity.GetUpdateTimes().empty());
+  }
+}
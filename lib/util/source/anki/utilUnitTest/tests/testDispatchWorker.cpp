@@ -16,8 +16,11 @@
 #include "util/dispatchWorker/dispatchWorker.h"
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
+#include <thread>
+#include <vector>
 
 TEST(DispatchWorker, ProcessNoArgs)
 {
@@ -210,3 +213,38 @@ TEST(DispatchWorker, ProcessWithArgs)
     #endif
   }
 }
+
+
+TEST(DispatchWorker, ProcessInOrderAcrossThreads)
+{
+  using namespace Anki::Util;
+
+  // A slow first job should not hold up the jobs pushed after it, and every job runs exactly once
+  const int kNumJobs = 1000;
+  std::vector<std::atomic_int> runCounts(kNumJobs);
+  std::atomic_int numDone(0);
+  bool othersDoneDuringFirst = false;
+
+  using MyDispatchWorker = DispatchWorker<3, int>;
+  MyDispatchWorker::FunctionType workerFunction = [&] (int jobIdx)
+  {
+    if (jobIdx == 0)
+    {
+      const auto timeout = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+      while ((numDone.load() < kNumJobs - 1) && (std::chrono::steady_clock::now() < timeout))
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+      othersDoneDuringFirst = (numDone.load() == kNumJobs - 1);
+    }
+    std::atomic_fetch_add(&runCounts[jobIdx], 1);
+    std::atomic_fetch_add(&numDone, 1);
+  };
+
+  MyDispatchWorker myWorker(workerFunction);
+  for (int i=0; i<kNumJobs; ++i) { myWorker.PushJob(i); }
+  myWorker.Process();
+
+  EXPECT_TRUE(othersDoneDuringFirst);
+  for (int i=0; i<kNumJobs; ++i) { EXPECT_EQ(runCounts[i].load(), 1); }
+}
@@ -0,0 +1,72 @@
+/**
+ * File: testFlatMap
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for FlatMap
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=FlatMap*
+ **/
+
+#include "util/helpers/includeGTest.h"
+#include "util/container/flatMap.h"
+
+#include <functional>
+#include <map>
+#include <string>
+
+using Anki::Util::FlatMap;
+
+TEST(FlatMap, MatchesStdMap)
+{
+  FlatMap<int, std::string> flat;
+  std::map<int, std::string> reference;
+
+  // insert in a scrambled order, duplicates included
+  for (int i = 0; i < 200; ++i) {
+    const int key = (i * 37) % 101;
+    const std::string value = std::to_string(i);
+    EXPECT_EQ(flat.insert({key, value}).second, reference.insert({key, value}).second);
+  }
+  ASSERT_EQ(flat.size(), reference.size());
+  auto refIt = reference.begin();
+  for (const auto& entry : flat) {
+    EXPECT_EQ(entry.first, refIt->first);
+    EXPECT_EQ(entry.second, refIt->second);
+    ++refIt;
+  }
+
+  for (int key = 0; key < 101; key += 3) {
+    EXPECT_EQ(flat.erase(key), reference.erase(key));
+  }
+  EXPECT_EQ(flat.erase(1000), 0);
+  ASSERT_EQ(flat.size(), reference.size());
+  for (const auto& entry : reference) {
+    const auto it = flat.find(entry.first);
+    ASSERT_NE(it, flat.end());
+    EXPECT_EQ(it->second, entry.second);
+  }
+  EXPECT_EQ(flat.find(0), flat.end());
+  EXPECT_EQ(flat.count(0), 0);
+  EXPECT_EQ(flat.count(1), 1);
+}
+
+TEST(FlatMap, AccessAndCompare)
+{
+  FlatMap<std::string, int, std::greater<std::string>> flat{{"a", 1}, {"c", 3}};
+  flat["b"] += 2;
+  flat["a"] += 10;
+  EXPECT_EQ(flat.at("a"), 11);
+  EXPECT_EQ(flat.at("b"), 2);
+  EXPECT_THROW(flat.at("z"), std::out_of_range);
+  EXPECT_FALSE(flat.try_emplace("c", 30).second);
+  EXPECT_EQ(flat.at("c"), 3);
+
+  // ordered by the comparator
+  ASSERT_EQ(flat.size(), 3);
+  EXPECT_EQ(flat.begin()->first, "c");
+  EXPECT_EQ((flat.end() - 1)->first, "a");
+}
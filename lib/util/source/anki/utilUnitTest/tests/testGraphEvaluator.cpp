@@ -15,6 +15,7 @@
 #include "util/graphEvaluator/graphEvaluator2d.h"
 #include "util/helpers/includeGTest.h"
 #include "util/logging/logging.h"
+#include "util/math/math.h"
 #include "json/json.h"
 
 
@@ -629,3 +630,88 @@ TEST(GraphEvaluator2d, EqualityOperators)
 }
 
 
+
+
+namespace {
+  // Straightforward node search, as EvaluateY used to do it
+  float SearchNodesForY(const Anki::Util::GraphEvaluator2d& graph, float x)
+  {
+    const Anki::Util::GraphEvaluator2d::Node* prevNode = &graph.GetNode(0);
+    if (x < prevNode->_x)
+    {
+      return prevNode->_y;
+    }
+    for (size_t i = 1; i < graph.GetNumNodes(); ++i)
+    {
+      const Anki::Util::GraphEvaluator2d::Node* nextNode = &graph.GetNode(i);
+      if (x <= nextNode->_x)
+      {
+        const float xRange = (nextNode->_x - prevNode->_x);
+        return FLT_GT(xRange, 0.0f) ? (prevNode->_y + ((x - prevNode->_x) / xRange) * (nextNode->_y - prevNode->_y))
+                                    : prevNode->_y;
+      }
+      prevNode = nextNode;
+    }
+    return prevNode->_y;
+  }
+}
+
+
+TEST(GraphEvaluator2d, MatchesNodeSearch)
+{
+  // Evenly spaced, unevenly spaced with a vertical step, and too many nodes to check every span
+  Anki::Util::GraphEvaluator2d evenGraph( {{0.0f, 1.0f}, {0.25f, 3.0f}, {0.5f, -2.0f}, {0.75f, 0.0f}, {1.0f, 0.5f}} );
+  Anki::Util::GraphEvaluator2d unevenGraph( {{-5.0f,  -10.0f}, {-3.0f,  -2.0f}, {-1.0f,   0.0f}, { -1.0f, 100.0f},
+                                             { 1.0f, -100.0f}, { 3.0f, -90.0f}, { 5.0f, -90.0f}, { 7.0f, -91.0f}} );
+  Anki::Util::GraphEvaluator2d bigGraph;
+  for (int i = 0; i < 40; ++i)
+  {
+    bigGraph.AddNode(0.1f * (i * i), (i % 3) - 1.0f);
+  }
+  
+  for (const Anki::Util::GraphEvaluator2d* graph : {&evenGraph, &unevenGraph, &bigGraph})
+  {
+    const float minX = graph->GetNode(0)._x - 1.0f;
+    const float maxX = graph->GetNode(graph->GetNumNodes() - 1)._x + 1.0f;
+    for (int i = 0; i <= 1000; ++i)
+    {
+      const float x = minX + (maxX - minX) * (i / 1000.0f);
+      EXPECT_NEAR(SearchNodesForY(*graph, x), graph->EvaluateY(x), 1e-4f) << "x = " << x;
+    }
+    
+    // Exactly on the nodes
+    for (size_t i = 0; i < graph->GetNumNodes(); ++i)
+    {
+      const float x = graph->GetNode(i)._x;
+      EXPECT_NEAR(SearchNodesForY(*graph, x), graph->EvaluateY(x), 1e-4f) << "x = " << x;
+    }
+  }
+  
+  // Clearing and reading nodes again rebuilds everything
+  Json::Value json;
+  EXPECT_TRUE(unevenGraph.WriteToJson(json));
+  evenGraph.Clear();
+  EXPECT_TRUE(evenGraph.ReadFromJson(json));
+  EXPECT_FLOAT_EQ(evenGraph.EvaluateY(-0.5f), 50.0f);
+  EXPECT_FLOAT_EQ(evenGraph.EvaluateY(6.0f), -90.5f);
+}
+
+
+TEST(GraphEvaluator2d, BatchEvaluate)
+{
+  Anki::Util::GraphEvaluator2d testGraph( {{-5.0f,  -10.0f}, {-3.0f,  -2.0f}, {-1.0f,   0.0f}, { -1.0f, 100.0f},
+                                           { 1.0f, -100.0f}, { 3.0f, -90.0f}, { 5.0f, -90.0f}, { 7.0f, -91.0f}} );
+  
+  const std::vector<float> xs = {-1000.0f, -4.5f, -1.0f, -0.5f, 2.5f, 6.0f, 10000.0f};
+  std::vector<float> ys = {1.0f};
+  testGraph.EvaluateY(xs, ys);
+  
+  ASSERT_EQ(xs.size(), ys.size());
+  for (size_t i = 0; i < xs.size(); ++i)
+  {
+    EXPECT_EQ(testGraph.EvaluateY(xs[i]), ys[i]);
+  }
+  
+  testGraph.EvaluateY({}, ys);
+  EXPECT_TRUE(ys.empty());
+}
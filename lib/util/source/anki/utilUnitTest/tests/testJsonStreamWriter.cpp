@@ -0,0 +1,199 @@
+/**
+ * File: testJsonStreamWriter
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for JsonStreamWriter and JsonSaxReader
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=JsonStream*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/jsonWriter/jsonSaxReader.h"
+#include "util/jsonWriter/jsonStreamWriter.h"
+#include "json/json.h"
+
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace Anki::Util;
+
+namespace {
+
+// Rebuilds a Json::Value from reader events, to compare against Json::Reader
+class ValueBuilder : public IJsonSaxHandler {
+public:
+  Json::Value root;
+
+  virtual bool StartObject() override { return Push(Json::Value(Json::objectValue)); }
+  virtual bool EndObject() override { _stack.pop_back(); return true; }
+  virtual bool StartArray() override { return Push(Json::Value(Json::arrayValue)); }
+  virtual bool EndArray() override { _stack.pop_back(); return true; }
+  virtual bool Key(const std::string& key) override { _key = key; return true; }
+  virtual bool String(const std::string& value) override { Add(Json::Value(value)); return true; }
+  virtual bool Int(int64_t value) override { Add(Json::Value(static_cast<Json::Int64>(value))); return true; }
+  virtual bool Uint(uint64_t value) override { Add(Json::Value(static_cast<Json::UInt64>(value))); return true; }
+  virtual bool Double(double value) override { Add(Json::Value(value)); return true; }
+  virtual bool Bool(bool value) override { Add(Json::Value(value)); return true; }
+  virtual bool Null() override { Add(Json::Value()); return true; }
+
+private:
+  Json::Value& Add(const Json::Value& value)
+  {
+    if (_stack.empty()) {
+      root = value;
+      return root;
+    }
+    Json::Value& parent = *_stack.back();
+    return parent.isArray() ? parent.append(value) : (parent[_key] = value);
+  }
+
+  bool Push(const Json::Value& value)
+  {
+    _stack.push_back(&Add(value));
+    return true;
+  }
+
+  std::vector<Json::Value*> _stack;
+  std::string _key;
+};
+
+const char* const kDocument = R"json(
+  // comments are allowed, as Json::Reader allows them
+  {
+    "name" : "vic\"tor\\ \u00e9\ud83d\ude00\n",
+    "ints" : [0, -1, 42, 9223372036854775807, 18446744073709551615, -9223372036854775808],
+    "reals" : [0.5, -2.25e3, 1E-3, 3.0],
+    /* block
+       comment */
+    "flags" : {"on" : true, "off" : false, "none" : null},
+    "empty" : {"object" : {}, "array" : []},
+    "nested" : [[1, [2, [3]]], {"a" : [{"b" : "c"}]}]
+  }
+)json";
+
+} // namespace
+
+TEST(JsonStreamWriter, WritesCompactAndPretty)
+{
+  std::string buffer;
+  {
+    JsonStreamWriter writer(buffer);
+    writer.StartObject();
+    writer.Key("s");     writer.String("a\"b\\c\n\x01");
+    writer.Key("i");     writer.Int(-3);
+    writer.Key("d");     writer.Double(2.0);
+    writer.Key("list");
+    writer.StartArray();
+    writer.Bool(true);
+    writer.Null();
+    writer.StartObject();
+    writer.EndObject();
+    writer.EndArray();
+    writer.EndObject();
+    EXPECT_TRUE(writer.IsComplete());
+  }
+  EXPECT_EQ(buffer, R"({"s":"a\"b\\c\n\u0001","i":-3,"d":2.0,"list":[true,null,{}]})");
+
+  buffer.clear();
+  {
+    JsonStreamWriter writer(buffer, JsonStreamWriter::Style::Pretty);
+    writer.StartObject();
+    writer.Key("a"); writer.Int(1);
+    writer.Key("b");
+    writer.StartArray();
+    writer.Int(2);
+    writer.EndArray();
+    writer.EndObject();
+  }
+  EXPECT_EQ(buffer, "{\n   \"a\" : 1,\n   \"b\" : [\n      2\n   ]\n}\n");
+}
+
+TEST(JsonStreamWriter, RejectsInvalidSequences)
+{
+  std::string buffer;
+  {
+    JsonStreamWriter writer(buffer);
+    writer.StartObject();
+    EXPECT_THROW(writer.Int(1), std::runtime_error);
+  }
+  {
+    JsonStreamWriter writer(buffer);
+    writer.StartArray();
+    EXPECT_THROW(writer.Key("k"), std::runtime_error);
+    EXPECT_THROW(writer.EndObject(), std::runtime_error);
+  }
+  {
+    JsonStreamWriter writer(buffer);
+    writer.Int(1);
+    EXPECT_TRUE(writer.IsComplete());
+    EXPECT_THROW(writer.Int(2), std::runtime_error);
+  }
+}
+
+TEST(JsonStreamWriter, RoundTripsThroughJsonReader)
+{
+  Json::Value expected;
+  ASSERT_TRUE(Json::Reader().parse(kDocument, expected));
+
+  for (const auto style : {JsonStreamWriter::Style::Compact, JsonStreamWriter::Style::Pretty}) {
+    std::string buffer;
+    JsonStreamWriter::Write(expected, buffer, style);
+    Json::Value actual;
+    ASSERT_TRUE(Json::Reader().parse(buffer, actual)) << buffer;
+    EXPECT_EQ(expected, actual) << buffer;
+  }
+}
+
+TEST(JsonSaxReader, MatchesJsonReader)
+{
+  Json::Value expected;
+  ASSERT_TRUE(Json::Reader().parse(kDocument, expected));
+
+  JsonSaxReader reader;
+  ValueBuilder builder;
+  ASSERT_TRUE(reader.Parse(kDocument, builder)) << reader.GetError() << " at " << reader.GetErrorOffset();
+  // Json::Reader makes some values that fit in an int64 unsigned, so compare what they serialize to
+  EXPECT_EQ(Json::FastWriter().write(expected), Json::FastWriter().write(builder.root));
+  EXPECT_EQ(builder.root["name"].asString(), "vic\"tor\\ \xc3\xa9\xf0\x9f\x98\x80\n");
+  EXPECT_TRUE(builder.root["ints"][4].isUInt64());
+}
+
+TEST(JsonSaxReader, RejectsInvalidDocuments)
+{
+  const char* const invalid[] = {
+    "", "{", "[1,]", "{\"a\" 1}", "{\"a\":1,}", "[1 2]", "tru", "01x", "\"\\x\"", "\"abc", "1 2", "/* open",
+    "\"\\ud800\"", "-", "1.", "1e",
+  };
+  JsonSaxReader reader;
+  for (const char* document : invalid) {
+    JsonSaxHandlerBase handler;
+    EXPECT_FALSE(reader.Parse(document, strlen(document), handler)) << document;
+    EXPECT_FALSE(reader.GetError().empty()) << document;
+  }
+
+  std::string deep(JsonSaxReader::kMaxDepth + 1, '[');
+  deep.append(JsonSaxReader::kMaxDepth + 1, ']');
+  JsonSaxHandlerBase handler;
+  EXPECT_FALSE(reader.Parse(deep, handler));
+  EXPECT_EQ(reader.GetError(), "TooDeep");
+}
+
+TEST(JsonSaxReader, HandlerCanStopEarly)
+{
+  struct FirstKey : public JsonSaxHandlerBase {
+    std::string key;
+    virtual bool Key(const std::string& k) override { key = k; return false; }
+  } handler;
+
+  JsonSaxReader reader;
+  EXPECT_FALSE(reader.Parse(kDocument, handler));
+  EXPECT_EQ(handler.key, "name");
+  EXPECT_EQ(reader.GetError(), "StoppedByHandler");
+}
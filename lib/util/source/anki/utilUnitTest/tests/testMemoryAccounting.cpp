@@ -0,0 +1,96 @@
+/**
+ * File: testMemoryAccounting
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for MemoryAccounting
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=MemoryAccounting*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/memoryAccounting/memoryAccounting.h"
+
+#include "json/json.h"
+
+using namespace Anki::Util;
+
+TEST(MemoryAccounting, CountsAndHighWaterMarks)
+{
+  MemoryAccounting::ResetHighWaterMarks();
+  const size_t startCacheBytes = MemoryAccounting::GetBytes(MemoryTag::ImageCache);
+  const size_t startTotalBytes = MemoryAccounting::GetTotalBytes();
+
+  {
+    MemoryAccount cache(MemoryTag::ImageCache);
+    MemoryAccount album(MemoryTag::FaceAlbum);
+
+    cache.Set(1000);
+    album.Add(300);
+    album.Add(200);
+    EXPECT_EQ(1000, cache.GetBytes());
+    EXPECT_EQ(500, album.GetBytes());
+    EXPECT_EQ(startCacheBytes + 1000, MemoryAccounting::GetBytes(MemoryTag::ImageCache));
+    EXPECT_EQ(startTotalBytes + 1500, MemoryAccounting::GetTotalBytes());
+
+    // Coming down keeps the high water marks
+    cache.Set(400);
+    EXPECT_EQ(startCacheBytes + 400, MemoryAccounting::GetBytes(MemoryTag::ImageCache));
+    EXPECT_EQ(startCacheBytes + 1000, MemoryAccounting::GetHighWaterMark(MemoryTag::ImageCache));
+    EXPECT_EQ(startTotalBytes + 1500, MemoryAccounting::GetTotalHighWaterMark());
+
+    // The total's high water mark is the most held at once, not the sum of the tags' marks
+    album.Add(200);
+    EXPECT_EQ(startTotalBytes + 1500, MemoryAccounting::GetTotalHighWaterMark());
+    album.Add(1000);
+    EXPECT_EQ(startTotalBytes + 2100, MemoryAccounting::GetTotalHighWaterMark());
+
+    // Can't give back more than was counted
+    album.Subtract(5000);
+    EXPECT_EQ(0, album.GetBytes());
+
+    // A second account adds to the same tag
+    MemoryAccount otherCache(MemoryTag::ImageCache);
+    otherCache.Set(100);
+    EXPECT_EQ(startCacheBytes + 500, MemoryAccounting::GetBytes(MemoryTag::ImageCache));
+  }
+
+  // Destroyed accounts give everything back
+  EXPECT_EQ(startCacheBytes, MemoryAccounting::GetBytes(MemoryTag::ImageCache));
+  EXPECT_EQ(startTotalBytes, MemoryAccounting::GetTotalBytes());
+  EXPECT_EQ(startCacheBytes + 1000, MemoryAccounting::GetHighWaterMark(MemoryTag::ImageCache));
+
+  MemoryAccounting::ResetHighWaterMarks();
+  EXPECT_EQ(startCacheBytes, MemoryAccounting::GetHighWaterMark(MemoryTag::ImageCache));
+  EXPECT_EQ(startTotalBytes, MemoryAccounting::GetTotalHighWaterMark());
+}
+
+TEST(MemoryAccounting, ReportsOnlyNewHighWaterMarks)
+{
+  MemoryAccounting::ResetHighWaterMarks();
+  MemoryAccount sprites(MemoryTag::Sprites);
+
+  sprites.Set(4096);
+  EXPECT_TRUE(MemoryAccounting::ReportNewHighWaterMarks());
+  EXPECT_FALSE(MemoryAccounting::ReportNewHighWaterMarks());
+
+  // Freeing and reloading up to the same peak is nothing new
+  sprites.Set(0);
+  sprites.Set(4096);
+  EXPECT_FALSE(MemoryAccounting::ReportNewHighWaterMarks());
+
+  sprites.Set(8192);
+  EXPECT_TRUE(MemoryAccounting::ReportNewHighWaterMarks());
+
+  Json::Value json;
+  MemoryAccounting::GetStatsAsJson(json);
+  ASSERT_EQ(static_cast<int>(MemoryTag::Count), json["tags"].size());
+  const Json::Value& spritesJson = json["tags"][static_cast<int>(MemoryTag::Sprites)];
+  EXPECT_EQ("Sprites", spritesJson["tag"].asString());
+  EXPECT_EQ(8192, spritesJson["bytes"].asUInt64());
+  EXPECT_EQ(8192, spritesJson["highWaterMark"].asUInt64());
+}
@@ -0,0 +1,102 @@
+/**
+ * File: testMessageProfiler
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for MessageProfiler
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=MessageProfiler*
+ **/
+
+#include "util/messageProfiler/messageProfiler.h"
+#include "util/helpers/includeGTest.h"
+
+#include "json/json.h"
+
+#include <string.h>
+
+using namespace Anki;
+using namespace Util;
+
+#if ANKI_MESSAGE_PROFILER_ENABLED
+
+namespace {
+  const char* TestTagName(int tag) { return (tag == 1) ? "One" : nullptr; }
+}
+
+TEST(MessageProfiler, ReportsWindowPerTag)
+{
+  MessageProfiler profiler("Test", TestTagName, 4);
+
+  Json::Value json;
+  profiler.GetWindowStatsAsJson(json);
+  EXPECT_EQ(0u, json["tags"].size());
+
+  profiler.Update(1, 10, 5);
+  profiler.Update(1, 30, 5);
+  profiler.AddHandlerTime(1, 100);
+  profiler.Update(2, 7);
+  // Past maxTags
+  profiler.Update(9, 3);
+  profiler.Update(200, 4);
+
+  // Nothing is published until the window completes
+  profiler.GetWindowStatsAsJson(json);
+  EXPECT_EQ(0u, json["tags"].size());
+
+  Json::Value webVizJson;
+  MessageProfiler::SendToWebVizCallback([&webVizJson](const Json::Value& data) { webVizJson = data; });
+  profiler.Report();
+  MessageProfiler::SendToWebVizCallback(nullptr);
+
+  profiler.GetWindowStatsAsJson(json);
+  EXPECT_EQ(json, webVizJson);
+  EXPECT_EQ("Test", json["name"].asString());
+  ASSERT_EQ(3u, json["tags"].size());
+
+  const Json::Value& one = json["tags"][0];
+  EXPECT_EQ("One", one["tag"].asString());
+  EXPECT_EQ(2u, one["count"].asUInt());
+  EXPECT_EQ(40u, one["bytes"].asUInt64());
+  EXPECT_EQ(10, one["serializeTime_us"].asInt64());
+  EXPECT_EQ(100, one["handlerTime_us"].asInt64());
+
+  EXPECT_EQ("0x02", json["tags"][1]["tag"].asString());
+  EXPECT_EQ(7u, json["tags"][1]["bytes"].asUInt64());
+
+  const Json::Value& other = json["tags"][2];
+  EXPECT_EQ("other", other["tag"].asString());
+  EXPECT_EQ(2u, other["count"].asUInt());
+  EXPECT_EQ(7u, other["bytes"].asUInt64());
+
+  // The next window starts empty
+  profiler.Update(1, 1);
+  profiler.Report();
+  profiler.GetWindowStatsAsJson(json);
+  ASSERT_EQ(1u, json["tags"].size());
+  EXPECT_EQ(1u, json["tags"][0]["bytes"].asUInt64());
+}
+
+TEST(MessageProfiler, ScopedHandlerTimer)
+{
+  MessageProfiler profiler("Test");
+  profiler.Update(3, 1);
+  {
+    MessageProfiler::ScopedHandlerTimer timer(profiler, 3);
+    volatile int sum = 0;
+    for (int i=0; i<100000; ++i) {
+      sum += i;
+    }
+  }
+  profiler.Report();
+
+  Json::Value json;
+  profiler.GetWindowStatsAsJson(json);
+  ASSERT_EQ(1u, json["tags"].size());
+  EXPECT_GE(json["tags"][0]["handlerTime_us"].asInt64(), 0);
+}
+
+#endif // ANKI_MESSAGE_PROFILER_ENABLED
@@ -0,0 +1,72 @@
+/**
+ * File: testObjectPool
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for ObjectPool
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=ObjectPool*
+ **/
+
+#include "util/helpers/includeGTest.h"
+#include "util/container/objectPool.h"
+
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using Anki::Util::ObjectPool;
+
+TEST(ObjectPool, ReusesFreedSlots)
+{
+  ObjectPool<std::string, 4> pool;
+  std::vector<std::string*> objects;
+  for (int i = 0; i < 10; ++i) {
+    objects.push_back(pool.Create(std::to_string(i)));
+  }
+  EXPECT_EQ(pool.GetNumLive(), 10);
+  EXPECT_EQ(pool.Capacity(), 12);
+  for (int i = 0; i < 10; ++i) {
+    EXPECT_EQ(*objects[i], std::to_string(i));
+  }
+
+  const std::set<std::string*> freed{objects[2], objects[7]};
+  pool.Destroy(objects[2]);
+  pool.Destroy(objects[7]);
+  EXPECT_EQ(pool.GetNumLive(), 8);
+
+  // freed memory is handed out again before the pool grows
+  std::string* reused1 = pool.Create("x");
+  std::string* reused2 = pool.Create("y");
+  EXPECT_EQ(freed, (std::set<std::string*>{reused1, reused2}));
+  EXPECT_EQ(pool.Capacity(), 12);
+
+  objects[2] = reused1;
+  objects[7] = reused2;
+  for (std::string* object : objects) {
+    pool.Destroy(object);
+  }
+  EXPECT_EQ(pool.GetNumLive(), 0);
+}
+
+TEST(ObjectPool, UniquePtrAndThrowingConstructor)
+{
+  struct Throws
+  {
+    explicit Throws(bool shouldThrow) { if (shouldThrow) { throw std::runtime_error("Throws"); } }
+  };
+
+  ObjectPool<Throws> pool(1);
+  EXPECT_EQ(pool.Capacity(), 32);
+  {
+    auto object = pool.MakeUnique(false);
+    EXPECT_EQ(pool.GetNumLive(), 1);
+    EXPECT_THROW(pool.Create(true), std::runtime_error);
+    EXPECT_EQ(pool.GetNumLive(), 1);
+  }
+  EXPECT_EQ(pool.GetNumLive(), 0);
+}
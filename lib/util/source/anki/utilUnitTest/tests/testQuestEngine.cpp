@@ -184,6 +184,66 @@ TEST_F(QuestEngineTest, Clear)
   delete questEngine;
 }
 
+TEST_F(QuestEngineTest, ClearAndReAddRule)
+{
+  QuestEngine* questEngine = new QuestEngine(StatFile());
+
+  std::string triggerKey("game.event");
+  std::vector<std::string> eventNames;
+  eventNames.push_back(triggerKey);
+  NoticeAction* clearedAction = new NoticeAction(false, 0, "", "cleared.title", "cleared.description", "", "");
+  CountThresholdCondition* clearedLimit = new CountThresholdCondition(CountThresholdOperatorEquals, 1, triggerKey);
+  QuestRule* clearedRule = new QuestRule("test.clear", eventNames, "test.clear.title", "test.clear.description", "", "", "", nullptr, clearedLimit, clearedAction);
+  EXPECT_TRUE(questEngine->AddRule(clearedRule));
+
+  questEngine->ClearRules();
+  EXPECT_TRUE(questEngine->GetRuleIds().empty());
+
+  // The cleared rule is never evaluated again, and its id is free to use
+  NoticeAction* triggeredAction = new NoticeAction(false, 0, "", "results.notice.title", "results.notice.description", "", "");
+  CountThresholdCondition* limitTwo = new CountThresholdCondition(CountThresholdOperatorEquals, 2, triggerKey);
+  QuestRule* rule = new QuestRule("test.clear", eventNames, "test.clear.title", "test.clear.description", "", "", "", nullptr, limitTwo, triggeredAction);
+  EXPECT_TRUE(questEngine->AddRule(rule));
+
+  questEngine->IncrementEvent(triggerKey);
+  EXPECT_EQ(0, questEngine->GetNotices().size());
+  questEngine->IncrementEvent(triggerKey);
+  const std::set<QuestNotice>& notices = questEngine->GetNotices();
+  ASSERT_EQ(1, notices.size());
+  EXPECT_EQ("results.notice.title", notices.begin()->GetTitleKey());
+
+  delete questEngine;
+}
+
+TEST_F(QuestEngineTest, LoadIntoBoundRule)
+{
+  QuestEngine* questEngine = new QuestEngine(StatFile());
+  questEngine->IncrementEvent("game.win");
+  questEngine->IncrementEvent("game.win");
+  questEngine->Save();
+  delete questEngine;
+
+  // Rules bound before counts are loaded see the loaded counts
+  questEngine = new QuestEngine(StatFile());
+  std::string triggerKey("game.win");
+  std::vector<std::string> eventNames;
+  eventNames.push_back(triggerKey);
+  NoticeAction* triggeredAction = new NoticeAction(false, 0, "", "results.notice.title", "results.notice.description", "", "");
+  CountThresholdCondition* limitThree = new CountThresholdCondition(CountThresholdOperatorEquals, 3, triggerKey);
+  QuestRule* rule = new QuestRule("test.load", eventNames, "test.load.title", "test.load.description", "", "", "", nullptr, limitThree, triggeredAction);
+  questEngine->AddRule(rule);
+  questEngine->Load();
+
+  questEngine->IncrementEvent(triggerKey);
+  EXPECT_EQ(3, questEngine->GetEventCount(triggerKey));
+  EXPECT_EQ(1, questEngine->GetNotices().size());
+
+  delete questEngine;
+
+  Anki::Util::FileUtils::DeleteFile(StatFile());
+  FileShouldNotExist(StatFile());
+}
+
 TEST_F(QuestEngineTest, CountThresholdRule)
 {
   QuestEngine* questEngine = new QuestEngine(StatFile());
@@ -16,6 +16,8 @@
 #include "util/random/rejectionSamplerHelper.h"
 #include "util/random/randomGenerator.h"
 
+#include <algorithm>
+
 using namespace Anki::Util;
 
 TEST(RejectionSamplerHelper, Test)
@@ -136,3 +138,66 @@ TEST(RejectionSamplerHelper, Test)
   
 }
 
+
+TEST(RejectionSamplerHelper, Batch)
+{
+  RandomGenerator rng(123);
+  using Type = int;
+  RejectionSamplerHelper<Type> sampler;
+  
+  std::vector<Type> samples;
+  for( Type i=0; i<20; ++i ) {
+    samples.push_back(i);
+  }
+  
+  // without conditions, it accepts everything
+  std::vector<bool> accepted;
+  EXPECT_EQ( sampler.EvaluateBatch(rng, samples, accepted), samples.size() );
+  ASSERT_EQ( accepted.size(), samples.size() );
+  EXPECT_TRUE( std::all_of(accepted.begin(), accepted.end(), [](bool b){ return b; }) );
+  
+  // a condition that counts how many samples it is asked about
+  class ConditionRejectOdd : public RejectionSamplingCondition<Type> {
+  public:
+    virtual bool operator()(const Type& sample) override {
+      ++_numCalls;
+      return (sample % 2) == 0;
+    }
+    int _numCalls = 0;
+  };
+  
+  auto rejectOddHandle = sampler.AddCondition( std::make_shared<ConditionRejectOdd>() );
+  auto rejectSmallHandle = sampler.AddCondition( [](const Type& sample){ return sample >= 10; } );
+  
+  EXPECT_EQ( sampler.EvaluateBatch(rng, samples, accepted), 5 );
+  ASSERT_EQ( accepted.size(), samples.size() );
+  for( size_t i=0; i<samples.size(); ++i ) {
+    EXPECT_EQ( accepted[i], sampler.Evaluate(rng, samples[i]) ) << "sample " << samples[i];
+  }
+  
+  // the second condition rejects everything left, so a third never gets called
+  rejectOddHandle->_numCalls = 0;
+  auto rejectAllHandle = sampler.AddCondition( [](const Type&){ return false; } );
+  auto neverCalledHandle = sampler.AddCondition( std::make_shared<ConditionRejectOdd>() );
+  EXPECT_EQ( sampler.EvaluateBatch(rng, samples, accepted), 0 );
+  EXPECT_EQ( rejectOddHandle->_numCalls, samples.size() );
+  EXPECT_EQ( neverCalledHandle->_numCalls, 0 );
+  sampler.RemoveCondition( rejectAllHandle );
+  sampler.RemoveCondition( neverCalledHandle );
+  
+  // batched generation stops after the batch that accepts enough samples
+  Type next = 0;
+  auto generator = [&next](){ return next++; };
+  std::vector<Type> generated = sampler.Generate( rng, 3, generator, 1000, 8 );
+  ASSERT_EQ( generated.size(), 3 );
+  EXPECT_EQ( generated[0], 10 );
+  EXPECT_EQ( generated[1], 12 );
+  EXPECT_EQ( generated[2], 14 );
+  EXPECT_EQ( next, 16 );
+  
+  // and never runs the generator more than maxAttempts times
+  next = 0;
+  generated = sampler.Generate( rng, 100, generator, 13, 8 );
+  EXPECT_EQ( next, 13 );
+  EXPECT_EQ( generated.size(), 2 );
+}
@@ -339,3 +339,47 @@ TEST(RingBuffContiguousRead, WrappedWriteAndRead)
   
 }
 
+
+TEST(RingBuffContiguousRead, InPlaceWrite)
+{
+  // writing in place should leave the buffer just as AddData() does, including the copy past the end
+  RingBuffContiguousRead<int> addedBuff{ 10, 5 };
+  RingBuffContiguousRead<int> inPlaceBuff{ 10, 5 };
+  
+  int nextValue = 0;
+  const std::vector<unsigned int> writeSizes = {8, 4, 7, 3, 10, 1, 6};
+  for( const unsigned int writeSize : writeSizes ) {
+    // make room for this write
+    const unsigned int toRead = (unsigned int)std::max<int>( 0, (int)(addedBuff.Size() + writeSize) - 10 );
+    EXPECT_EQ( addedBuff.AdvanceCursor( toRead ), toRead > 0 );
+    EXPECT_EQ( inPlaceBuff.AdvanceCursor( toRead ), toRead > 0 );
+    
+    std::vector<int> data(writeSize);
+    std::iota( std::begin(data), std::end(data), nextValue );
+    nextValue += writeSize;
+    EXPECT_EQ( addedBuff.AddData( data.data(), writeSize ), writeSize );
+    
+    // in place writes stop at the end of the ring, so it may take two
+    size_t numWritten = 0;
+    while( numWritten < writeSize ) {
+      size_t space = 0;
+      int* dest = inPlaceBuff.GetWriteData( space );
+      ASSERT_GT( space, 0 );
+      const size_t toWrite = std::min( space, writeSize - numWritten );
+      std::copy( data.begin() + numWritten, data.begin() + numWritten + toWrite, dest );
+      EXPECT_EQ( inPlaceBuff.CommitData( (unsigned int)toWrite ), toWrite );
+      numWritten += toWrite;
+    }
+    
+    EXPECT_EQ( addedBuff.Size(), inPlaceBuff.Size() );
+    EXPECT_EQ( addedBuff.GetContiguousSize(), inPlaceBuff.GetContiguousSize() );
+    const unsigned int contiguousSize = (unsigned int)inPlaceBuff.GetContiguousSize();
+    EXPECT_TRUE( CompareData( addedBuff.ReadData( contiguousSize ), inPlaceBuff.ReadData( contiguousSize ), contiguousSize ) );
+  }
+  
+  // full, so nothing can be written in place
+  size_t space = 1;
+  inPlaceBuff.GetWriteData( space );
+  EXPECT_EQ( space, 0 );
+  EXPECT_EQ( inPlaceBuff.CommitData( 1 ), 0 );
+}
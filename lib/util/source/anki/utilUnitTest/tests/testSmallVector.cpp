@@ -0,0 +1,119 @@
+/**
+ * File: testSmallVector
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for SmallVector
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=SmallVector*
+ **/
+
+#include "util/helpers/includeGTest.h"
+#include "util/container/smallVector.h"
+
+#include <string>
+
+using Anki::Util::SmallVector;
+
+namespace {
+
+// Counts live instances so tests can check nothing leaks or is destroyed twice
+struct Counted
+{
+  Counted(int v) : value(v) { ++numLive; }
+  Counted(const Counted& other) : value(other.value) { ++numLive; }
+  Counted(Counted&& other) noexcept : value(other.value) { other.value = -1; ++numLive; }
+  Counted& operator=(const Counted& other) = default;
+  Counted& operator=(Counted&& other) noexcept { value = other.value; other.value = -1; return *this; }
+  ~Counted() { --numLive; }
+
+  int value;
+  static int numLive;
+};
+int Counted::numLive = 0;
+
+} // namespace
+
+TEST(SmallVector, StaysInlineUntilFull)
+{
+  SmallVector<int, 4> vec;
+  EXPECT_TRUE(vec.empty());
+  EXPECT_TRUE(vec.IsInline());
+  for (int i = 0; i < 4; ++i) {
+    vec.push_back(i);
+  }
+  EXPECT_TRUE(vec.IsInline());
+  EXPECT_EQ(vec.capacity(), 4);
+
+  vec.push_back(4);
+  EXPECT_FALSE(vec.IsInline());
+  ASSERT_EQ(vec.size(), 5);
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(vec[i], i);
+  }
+
+  // growing from an element of itself
+  vec.push_back(vec[0]);
+  EXPECT_EQ(vec.back(), 0);
+}
+
+TEST(SmallVector, EraseWhileIterating)
+{
+  SmallVector<std::string, 2> vec{"a", "b", "c", "d", "e"};
+  auto it = vec.begin();
+  while (it != vec.end()) {
+    if ((*it == "b") || (*it == "d")) {
+      it = vec.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  EXPECT_EQ(vec, (SmallVector<std::string, 2>{"a", "c", "e"}));
+
+  vec.erase(vec.begin(), vec.begin() + 2);
+  ASSERT_EQ(vec.size(), 1);
+  EXPECT_EQ(vec.front(), "e");
+}
+
+TEST(SmallVector, CopyAndMove)
+{
+  {
+    SmallVector<Counted, 2> inlineVec;
+    inlineVec.emplace_back(1);
+    inlineVec.emplace_back(2);
+    SmallVector<Counted, 2> heapVec;
+    for (int i = 0; i < 5; ++i) {
+      heapVec.emplace_back(i);
+    }
+    EXPECT_EQ(Counted::numLive, 7);
+
+    SmallVector<Counted, 2> copy(heapVec);
+    EXPECT_EQ(copy.size(), 5);
+    EXPECT_EQ(copy[4].value, 4);
+
+    // moving a heap vector steals its buffer, moving an inline one moves each element
+    const Counted* heapData = heapVec.data();
+    SmallVector<Counted, 2> movedHeap(std::move(heapVec));
+    EXPECT_EQ(movedHeap.data(), heapData);
+    EXPECT_TRUE(heapVec.empty());
+    EXPECT_TRUE(heapVec.IsInline());
+
+    SmallVector<Counted, 2> movedInline(std::move(inlineVec));
+    EXPECT_TRUE(movedInline.IsInline());
+    EXPECT_EQ(movedInline[1].value, 2);
+    EXPECT_TRUE(inlineVec.empty());
+
+    movedInline = copy;
+    EXPECT_EQ(movedInline.size(), 5);
+    copy = std::move(movedHeap);
+    EXPECT_EQ(copy.data(), heapData);
+
+    copy.erase(copy.begin() + 1, copy.end());
+    copy.pop_back();
+    EXPECT_TRUE(copy.empty());
+  }
+  EXPECT_EQ(Counted::numLive, 0);
+}
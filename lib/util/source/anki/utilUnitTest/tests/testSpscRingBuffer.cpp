@@ -0,0 +1,101 @@
+/**
+ * File: testSpscRingBuffer
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for SpscRingBuffer
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=SpscRingBuffer*
+ **/
+
+
+#include "util/container/spscRingBuffer.h"
+#include "util/helpers/includeGTest.h"
+
+#include <thread>
+
+
+TEST(SpscRingBuffer, PushPop)
+{
+  Anki::Util::SpscRingBuffer<int, 4> testBuff;
+
+  EXPECT_TRUE(testBuff.empty());
+  EXPECT_EQ(testBuff.capacity(), 4);
+  EXPECT_EQ(testBuff.front(), nullptr);
+
+  EXPECT_TRUE(testBuff.push_back(101));
+  EXPECT_TRUE(testBuff.push_back(102));
+  EXPECT_EQ(testBuff.size(), 2);
+  ASSERT_NE(testBuff.front(), nullptr);
+  EXPECT_EQ(*testBuff.front(), 101);
+
+  testBuff.pop_front();
+  EXPECT_EQ(*testBuff.front(), 102);
+
+  // Fill in place, across the wrap
+  for (int i = 0; i < 3; ++i)
+  {
+    int* slot = testBuff.push_begin();
+    ASSERT_NE(slot, nullptr);
+    *slot = 103 + i;
+    testBuff.push_commit();
+  }
+  EXPECT_EQ(testBuff.size(), 4);
+  EXPECT_EQ(testBuff.GetNumOverruns(), 0);
+
+  // Full: the new entry is dropped and counted, and the old ones are untouched
+  EXPECT_FALSE(testBuff.push_back(200));
+  EXPECT_EQ(testBuff.push_begin(), nullptr);
+  EXPECT_EQ(testBuff.GetNumOverruns(), 2);
+
+  for (int expected = 102; expected <= 105; ++expected)
+  {
+    ASSERT_NE(testBuff.front(), nullptr);
+    EXPECT_EQ(*testBuff.front(), expected);
+    testBuff.pop_front();
+  }
+  EXPECT_TRUE(testBuff.empty());
+  EXPECT_EQ(testBuff.front(), nullptr);
+}
+
+
+TEST(SpscRingBuffer, TwoThreads)
+{
+  constexpr int kNumEntries = 200000;
+  Anki::Util::SpscRingBuffer<int, 64> testBuff;
+
+  std::thread producer([&testBuff]() {
+    for (int i = 0; i < kNumEntries; )
+    {
+      if (testBuff.push_back(i))
+      {
+        ++i;
+      }
+      else
+      {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  // Every entry arrives exactly once and in order, however the two threads interleave
+  int expected = 0;
+  while (expected < kNumEntries)
+  {
+    const int* entry = testBuff.front();
+    if (nullptr == entry)
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(*entry, expected);
+    testBuff.pop_front();
+    ++expected;
+  }
+  producer.join();
+
+  EXPECT_TRUE(testBuff.empty());
+}
@@ -0,0 +1,81 @@
+/**
+ * File: testStringID
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for StringID
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=StringID*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/stringTable/stringID.h"
+
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace Anki::Util;
+
+TEST(StringID, SameNameSameID)
+{
+  const StringID first(std::string("stringIDTest_same"));
+  const StringID second(std::string("stringIDTest_same"));
+  const StringID other(std::string("stringIDTest_other"));
+  EXPECT_EQ(first, second);
+  EXPECT_NE(first, other);
+  EXPECT_EQ(first.ToString(), "stringIDTest_same");
+  EXPECT_FALSE(first.IsNone());
+
+  std::unordered_map<StringID, int> map;
+  map[first] = 1;
+  map[other] = 2;
+  EXPECT_EQ(map[second], 1);
+}
+
+TEST(StringID, FindDoesNotIntern)
+{
+  EXPECT_TRUE(StringID::Find("stringIDTest_neverInterned").IsNone());
+  EXPECT_TRUE(StringID::Find("stringIDTest_neverInterned").IsNone());
+  EXPECT_TRUE(StringID::Find("").IsNone());
+
+  const StringID interned(std::string("stringIDTest_interned"));
+  EXPECT_EQ(StringID::Find("stringIDTest_interned"), interned);
+}
+
+TEST(StringID, ReferencesStayValidWhileInterning)
+{
+  const StringID first(std::string("stringIDTest_stable"));
+  const std::string& name = first.ToString();
+  const char* chars = first.c_str();
+
+  constexpr int kNumThreads = 4;
+  constexpr int kNumNames = 2000;
+  std::vector<std::thread> threads;
+  std::vector<std::vector<StringID>> ids(kNumThreads);
+  for (int t = 0; t < kNumThreads; ++t) {
+    threads.emplace_back([t, &ids] {
+      for (int i = 0; i < kNumNames; ++i) {
+        ids[t].emplace_back("stringIDTest_" + std::to_string(i));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(&name, &first.ToString());
+  EXPECT_EQ(chars, first.c_str());
+  EXPECT_EQ(name, "stringIDTest_stable");
+  for (int t = 1; t < kNumThreads; ++t) {
+    ASSERT_EQ(ids[t], ids[0]);
+  }
+  for (int i = 0; i < kNumNames; ++i) {
+    ASSERT_EQ(ids[0][i].ToString(), "stringIDTest_" + std::to_string(i));
+  }
+}
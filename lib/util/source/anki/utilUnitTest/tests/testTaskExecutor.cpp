@@ -0,0 +1,181 @@
+/**
+ * File: testTaskExecutor
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Unit tests for TaskExecutor, and the Task, TaskPool and TaskTimer under it
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=TaskExecutor*
+ **/
+
+
+#include "util/helpers/includeGTest.h"
+#include "util/dispatchQueue/task.h"
+#include "util/dispatchQueue/taskExecutor.h"
+#include "util/dispatchQueue/taskPool.h"
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace Anki::Util;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Counts live copies, so tests can tell whether a Task destroyed what it held
+struct Tracked {
+  explicit Tracked(int* count) : _count(count) { ++*_count; }
+  Tracked(const Tracked& other) : _count(other._count) { ++*_count; }
+  Tracked(Tracked&& other) noexcept : _count(other._count) { ++*_count; }
+  ~Tracked() { --*_count; }
+  int* _count;
+};
+
+} // namespace
+
+TEST(TaskExecutor, TaskHoldsSmallAndLargeCallables)
+{
+  int live = 0;
+  int calls = 0;
+  {
+    Tracked tracked(&live);
+    Task small([tracked, &calls] { ++calls; });
+    char padding[2 * Task::kInlineSize] = {};
+    Task large([tracked, padding, &calls] { calls += 1 + padding[0]; });
+    EXPECT_EQ(live, 3);
+
+    Task moved(std::move(large));
+    EXPECT_FALSE(large);
+    EXPECT_TRUE(moved);
+    small();
+    moved();
+    moved();
+    EXPECT_EQ(calls, 3);
+
+    small = std::move(moved);
+    EXPECT_EQ(live, 2);
+  }
+  EXPECT_EQ(live, 0);
+}
+
+TEST(TaskExecutor, TasksRunInOrderOnePerQueue)
+{
+  constexpr int kNumQueues = 8;
+  constexpr int kNumTasks = 2000;
+
+  std::vector<std::unique_ptr<TaskExecutor>> executors;
+  std::vector<std::vector<int>> results(kNumQueues);
+  std::vector<std::atomic<int>> running(kNumQueues);
+  std::atomic<bool> overlapped{false};
+  for (int q = 0; q < kNumQueues; ++q) {
+    executors.emplace_back(new TaskExecutor("test"));
+    running[q] = 0;
+  }
+
+  for (int i = 0; i < kNumTasks; ++i) {
+    for (int q = 0; q < kNumQueues; ++q) {
+      executors[q]->Wake([&, q, i] {
+        if (running[q]++ != 0) {
+          overlapped = true;
+        }
+        results[q].push_back(i);
+        --running[q];
+      }, nullptr);
+    }
+  }
+  for (auto& executor : executors) {
+    executor->WakeSync([] {}, nullptr);
+  }
+
+  EXPECT_FALSE(overlapped);
+  for (const auto& result : results) {
+    ASSERT_EQ(result.size(), kNumTasks);
+    for (int i = 0; i < kNumTasks; ++i) {
+      ASSERT_EQ(result[i], i);
+    }
+  }
+  EXPECT_LE(TaskPool::GetShared().GetNumWorkers(), 2 * std::thread::hardware_concurrency() + 4);
+}
+
+TEST(TaskExecutor, WakeSyncFromOwnTaskRunsInline)
+{
+  TaskExecutor executor("test");
+  int value = 0;
+  executor.WakeSync([&] {
+    executor.WakeSync([&] { value = 1; }, nullptr);
+    EXPECT_EQ(value, 1);
+    value = 2;
+  }, nullptr);
+  EXPECT_EQ(value, 2);
+}
+
+TEST(TaskExecutor, WakeAfterWaitsUntilDue)
+{
+  TaskExecutor executor("test");
+  std::atomic<bool> ran{false};
+  const auto start = Clock::now();
+  Clock::time_point ranAt;
+  executor.WakeAfter([&] { ranAt = Clock::now(); ran = true; }, start + std::chrono::milliseconds(50), nullptr);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_FALSE(ran);
+  for (int i = 0; (i < 100) && !ran; ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  ASSERT_TRUE(ran);
+  EXPECT_GE(ranAt - start, std::chrono::milliseconds(50));
+}
+
+TEST(TaskExecutor, RepeatingTaskStopsWhenHandleIsInvalidated)
+{
+  TaskExecutor executor("test");
+  std::atomic<int> count{0};
+  TaskHandle handle = executor.WakeAfterRepeat([&] { ++count; }, std::chrono::milliseconds(10), nullptr);
+
+  for (int i = 0; (i < 200) && (count < 3); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  ASSERT_GE(count, 3);
+
+  handle->Invalidate();
+  executor.WakeSync([] {}, nullptr);
+  const int stoppedAt = count;
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(count, stoppedAt);
+}
+
+TEST(TaskExecutor, StopWaitsForRunningTaskAndDropsTheRest)
+{
+  int live = 0;
+  std::atomic<bool> started{false};
+  std::atomic<bool> finished{false};
+  std::atomic<int> ranAfter{0};
+  {
+    TaskExecutor executor("test");
+    executor.Wake([&] {
+      started = true;
+      std::this_thread::sleep_for(std::chrono::milliseconds(50));
+      finished = true;
+    }, nullptr);
+    Tracked tracked(&live);
+    for (int i = 0; i < 10; ++i) {
+      executor.Wake([&, tracked] { ++ranAfter; }, nullptr);
+    }
+    executor.WakeAfter([tracked] {}, Clock::now() + std::chrono::seconds(10), nullptr);
+
+    while (!started) {
+      std::this_thread::yield();
+    }
+    executor.StopExecution();
+    EXPECT_TRUE(finished);
+  }
+  EXPECT_EQ(ranAfter, 0);
+  EXPECT_EQ(live, 0);
+}
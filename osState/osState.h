@@ -100,15 +100,17 @@ public:
   void SetRobotID(RobotID_t robotID);
 
   // Set how often state should be updated.
-  // Affects how often the freq and temperature is updated.
-  // Default is 0 ms which means never update.
-  // You should leave this at zero only if you don't
-  // ever care about CPU freq and temperature.
+  // Affects how often the freq, temperature, uptime, memory info and CPU time stats are updated.
+  // On vicos a sampler thread re-reads, once per period, whichever of those have been asked for in the
+  // last few periods, so getters just copy the latest values. Anything not asked for lately is read
+  // on the spot the next time it is.
+  // Default is 0 ms, which means no sampler and every call reads on the spot.
   void SetUpdatePeriod(uint32_t milliseconds);
 
   void SendToWebVizCallback(const std::function<void(const Json::Value&)>& callback);
 
-  // Returns true if CPU frequency falls below kNominalCPUFreq_kHz
+  // Returns true if the kernel has capped the CPU frequency below kNominalCPUFreq_kHz, or if it is running below the
+  // manual frequency last set by SetDesiredCPUFrequency. Updated along with the CPU frequency.
   bool IsCPUThrottling() const;
 
   // Returns current CPU frequency
@@ -120,6 +122,9 @@ public:
   // set specific CPU frequency, or reset to automatic
   void SetDesiredCPUFrequency(DesiredCPUFrequency freq);
 
+  // Returns the frequency last set successfully
+  DesiredCPUFrequency GetDesiredCPUFrequency() const { return _desiredCPUFreq; }
+
   // Returns uptime (and idle time) in seconds
   float GetUptimeAndIdleTime(float &idleTime_s) const;
 
@@ -244,6 +249,7 @@ private:
   void UpdateCPUTimeStats() const;
 
   uint32_t kNominalCPUFreq_kHz = 800000;
+  DesiredCPUFrequency _desiredCPUFreq = DesiredCPUFrequency::Automatic;
 
   std::string _ipAddress       = "";
   std::string _ssid            = "";
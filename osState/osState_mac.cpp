@@ -195,7 +195,8 @@ void OSState::UpdateCPUFreq_kHz() const
 
 void OSState::SetDesiredCPUFrequency(DesiredCPUFrequency freq)
 {
-  // not supported on mac
+  // not supported on mac, but remember what was asked for
+  _desiredCPUFreq = freq;
 }
 
 void OSState::UpdateTemperature_C() const
@@ -13,6 +13,7 @@
  **/
 
 #include "osState/osState.h"
+#include "osState/sysFileReader.h"
 #include "anki/cozmo/shared/cozmoConfig.h"
 #include "util/console/consoleInterface.h"
 #include "util/console/consoleInterface.h"
@@ -20,6 +21,7 @@
 #include "util/helpers/templateHelpers.h"
 #include "util/logging/logging.h"
 #include "util/string/stringUtils.h"
+#include "util/threading/threadPriority.h"
 #include "util/time/universalTime.h"
 
 #include "cutils/properties.h"
@@ -42,9 +44,14 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <fstream>
 #include <array>
 #include <iomanip>
+#include <thread>
 
 
 #ifdef SIMULATOR
@@ -84,18 +91,7 @@ namespace {
 
   uint32_t kPeriodEnumToMS[] = {0, 10, 100, 1000, 10000};
 
-  std::ifstream _cpuFile;
-  std::ifstream _temperatureFile;
-  std::ifstream _uptimeFile;
-  std::ifstream _memInfoFile;
-  std::ifstream _cpuTimeStatsFile;
-
-  std::mutex _cpuMutex;
-  std::mutex _temperatureMutex;
   std::mutex _MACAddressMutex;
-  std::mutex _uptimeMutex;
-  std::mutex _memInfoMutex;
-  std::mutex _cpuTimeStatsMutex;
 
   const char* kNominalCPUFreqFile = "/sys/devices/system/cpu/cpu0/cpufreq/scaling_max_freq";
   const char* kCPUFreqFile        = "/sys/devices/system/cpu/cpu0/cpufreq/cpuinfo_cur_freq";
@@ -123,16 +119,213 @@ namespace {
 
   const char* const kWifiInterfaceName = "wlan0";
 
-  // System vars
-  uint32_t _cpuFreq_kHz;      // CPU freq
-  uint32_t _cpuTemp_C;        // Temperature in Celsius
-  float _uptime_s;            // Uptime in seconds
-  float _idleTime_s;          // Idle time in seconds
-  uint32_t _totalMem_kB;      // Total memory in kB
-  uint32_t _availMem_kB;      // Available memory in kB
-  uint32_t _freeMem_kB;       // Free memory in kB
+  // Sampled files stay open for the life of the process
+  SysFileReader _cpuFreqReader(kCPUFreqFile);
+  SysFileReader _cpuMaxFreqReader(kNominalCPUFreqFile);
+  SysFileReader _temperatureReader(kTemperatureFile);
+  SysFileReader _uptimeReader(kUptimeFile);
+  SysFileReader _memInfoReader(kMemInfoFile);
+  SysFileReader _cpuTimeStatsReader(kCPUTimeStatsFile);
+  SysFileReader _wifiTxBytesReader(kWifiTxBytesFile);
+  SysFileReader _wifiRxBytesReader(kWifiRxBytesFile);
+  SysFileReader _wifiTxErrorsReader(kWifiTxErrorsFile);
+  SysFileReader _wifiRxErrorsReader(kWifiRxErrorsFile);
+
+  // Readers are shared by the sampler thread and callers
+  std::mutex _readMutex;
+
+  // System vars, as last sampled
+  struct Snapshot {
+    uint32_t cpuFreq_kHz = 0;     // CPU freq
+    uint32_t cpuMaxFreq_kHz = 0;  // CPU freq cap, which the kernel lowers when it throttles
+    uint32_t cpuTemp_C = 0;       // Temperature in Celsius
+    float uptime_s = 0.f;         // Uptime in seconds
+    float idleTime_s = 0.f;       // Idle time in seconds
+    uint32_t totalMem_kB = 0;     // Total memory in kB
+    uint32_t availMem_kB = 0;     // Available memory in kB
+    uint32_t freeMem_kB = 0;      // Free memory in kB
+    std::vector<std::string> cpuTimeStats; // CPU time stats lines
+  };
+  Snapshot _snapshot;
+  std::mutex _snapshotMutex;
+
+  // Things to sample. Each is only sampled while someone keeps asking for it
+  enum SampleItem : uint32_t {
+    kSampleCPUFreq      = 1 << 0,
+    kSampleTemperature  = 1 << 1,
+    kSampleUptime       = 1 << 2,
+    kSampleMemoryInfo   = 1 << 3,
+    kSampleCPUTimeStats = 1 << 4,
+  };
+  constexpr int kNumSampleItems = 5;
+
+  // The overall line and one per core. The rest of /proc/stat (interrupt counts especially) is long and unused
+  constexpr int kNumCPUTimeStatLines = 5;
+
+  // An item is dropped by the sampler once it hasn't been asked for in this many update periods
+  constexpr uint64_t kSampleInterestPeriods = 4;
+
+  // When each item was last asked for, in steady clock ms (0 for never)
+  std::atomic<uint64_t> _lastRequested_ms[kNumSampleItems];
+
+  uint64_t GetSteadyTime_ms()
+  {
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+  }
+
+  int GetSampleItemIndex(SampleItem item)
+  {
+    return __builtin_ctz(item);
+  }
+
+  // Reads the items and publishes them to the snapshot, which is only locked to copy values in
+  void SampleItems(uint32_t items)
+  {
+    std::lock_guard<std::mutex> readLock(_readMutex);
+
+    if (items & kSampleCPUFreq) {
+      uint32_t cpuFreq_kHz = 0;
+      uint32_t cpuMaxFreq_kHz = 0;
+      const bool gotFreq = _cpuFreqReader.ReadUint32(cpuFreq_kHz);
+      const bool gotMaxFreq = _cpuMaxFreqReader.ReadUint32(cpuMaxFreq_kHz);
+      std::lock_guard<std::mutex> lock(_snapshotMutex);
+      if (gotFreq) {
+        _snapshot.cpuFreq_kHz = cpuFreq_kHz;
+      }
+      if (gotMaxFreq) {
+        _snapshot.cpuMaxFreq_kHz = cpuMaxFreq_kHz;
+      }
+    }
+
+    if (items & kSampleTemperature) {
+      uint32_t cpuTemp_C = 0;
+      if (_temperatureReader.ReadUint32(cpuTemp_C)) {
+        std::lock_guard<std::mutex> lock(_snapshotMutex);
+        _snapshot.cpuTemp_C = cpuTemp_C;
+      }
+    }
+
+    if (items & kSampleUptime) {
+      char buffer[64];
+      const char* cursor = buffer;
+      float uptime_s = 0.f;
+      float idleTime_s = 0.f;
+      if ((_uptimeReader.Read(buffer, sizeof(buffer)) > 0) &&
+          SysFileReader::ParseFloat(cursor, uptime_s) &&
+          SysFileReader::ParseFloat(cursor, idleTime_s)) {
+        std::lock_guard<std::mutex> lock(_snapshotMutex);
+        _snapshot.uptime_s = uptime_s;
+        _snapshot.idleTime_s = idleTime_s;
+      }
+    }
+
+    if (items & kSampleMemoryInfo) {
+      // These are the first three lines
+      char buffer[256];
+      uint64_t totalMem_kB = 0;
+      uint64_t freeMem_kB = 0;
+      uint64_t availMem_kB = 0;
+      if ((_memInfoReader.Read(buffer, sizeof(buffer)) > 0) &&
+          SysFileReader::FindKeyValue(buffer, "MemTotal", totalMem_kB) &&
+          SysFileReader::FindKeyValue(buffer, "MemFree", freeMem_kB) &&
+          SysFileReader::FindKeyValue(buffer, "MemAvailable", availMem_kB)) {
+        std::lock_guard<std::mutex> lock(_snapshotMutex);
+        _snapshot.totalMem_kB = static_cast<uint32_t>(totalMem_kB);
+        _snapshot.freeMem_kB = static_cast<uint32_t>(freeMem_kB);
+        _snapshot.availMem_kB = static_cast<uint32_t>(availMem_kB);
+      }
+    }
+
+    if (items & kSampleCPUTimeStats) {
+      char buffer[1024];
+      if (_cpuTimeStatsReader.Read(buffer, sizeof(buffer)) > 0) {
+        std::lock_guard<std::mutex> lock(_snapshotMutex);
+        _snapshot.cpuTimeStats.resize(kNumCPUTimeStatLines);
+        const char* line = buffer;
+        for (auto& stats : _snapshot.cpuTimeStats) {
+          const char* lineEnd = strchr(line, '\n');
+          if (lineEnd == nullptr) {
+            lineEnd = line + strlen(line);
+          }
+          // Reuses the storage from the last sample
+          stats.assign(line, lineEnd - line);
+          line = (*lineEnd == '\0') ? lineEnd : lineEnd + 1;
+        }
+      }
+    }
+  }
+
+  // Called by every getter. Marks the item as wanted, so the sampler thread keeps it fresh, and reads it right
+  // away unless the sampler is already doing so
+  void RequestSample(SampleItem item, uint64_t updatePeriod_ms)
+  {
+    const uint64_t now_ms = GetSteadyTime_ms();
+    const uint64_t lastRequested_ms = _lastRequested_ms[GetSampleItemIndex(item)].exchange(now_ms);
+    const bool isBeingSampled = (updatePeriod_ms != 0) &&
+                                (lastRequested_ms != 0) &&
+                                (now_ms - lastRequested_ms < kSampleInterestPeriods * updatePeriod_ms);
+    if (!isBeingSampled) {
+      SampleItems(item);
+    }
+  }
+
+  // Samples whatever is wanted once per update period, off the threads that ask for it
+  class Sampler
+  {
+  public:
+    ~Sampler() { Stop(); }
+
+    void Start(uint64_t updatePeriod_ms)
+    {
+      Stop();
+      _thread = std::thread(&Sampler::Run, this, updatePeriod_ms);
+    }
+
+    void Stop()
+    {
+      if (!_thread.joinable()) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _shouldStop = true;
+      }
+      _condition.notify_all();
+      _thread.join();
+      _shouldStop = false;
+    }
+
+  private:
+    void Run(uint64_t updatePeriod_ms)
+    {
+      Anki::Util::SetThreadName(pthread_self(), "OSStateSampler");
+      std::unique_lock<std::mutex> lock(_mutex);
+      while (!_condition.wait_for(lock, std::chrono::milliseconds(updatePeriod_ms), [this] { return _shouldStop; })) {
+        lock.unlock();
+        const uint64_t now_ms = GetSteadyTime_ms();
+        uint32_t items = 0;
+        for (int i = 0; i < kNumSampleItems; ++i) {
+          const uint64_t lastRequested_ms = _lastRequested_ms[i];
+          if ((lastRequested_ms != 0) && (now_ms - lastRequested_ms < kSampleInterestPeriods * updatePeriod_ms)) {
+            items |= (1u << i);
+          }
+        }
+        if (items != 0) {
+          SampleItems(items);
+        }
+        lock.lock();
+      }
+    }
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _condition;
+    bool _shouldStop = false;
+  };
 
-  std::vector<std::string> _CPUTimeStats; // CPU time stats lines
+  // Defined after everything it reads, so that it's stopped before they're destroyed
+  Sampler _sampler;
 
 
   // How often state variables are updated
@@ -188,8 +381,8 @@ OSState::OSState()
     LOG_ERROR("OSState.Constructor.FailedToOpenNominalCPUFreqFile", "%s", kNominalCPUFreqFile);
   }
 
-  _cpuFreq_kHz = kNominalCPUFreq_kHz;
-  _cpuTemp_C = 0;
+  _snapshot.cpuFreq_kHz = kNominalCPUFreq_kHz;
+  _snapshot.cpuMaxFreq_kHz = kNominalCPUFreq_kHz;
 
   _buildSha = ANKI_BUILD_SHA;
   _buildBranch = ANKI_BUILD_BRANCH;
@@ -232,6 +425,7 @@ OSState::OSState()
 
 OSState::~OSState()
 {
+  _sampler.Stop();
 }
 
 RobotID_t OSState::GetRobotID() const
@@ -244,17 +438,15 @@ void OSState::Update(BaseStationTime_t currTime_nanosec)
   _currentTime_ms = currTime_nanosec/1000000;
   if (kWebvizUpdatePeriod != 0 && _webServiceCallback) {
     if (_currentTime_ms - _lastWebvizUpdateTime_ms > kPeriodEnumToMS[kWebvizUpdatePeriod]) {
-      UpdateCPUTimeStats();
+      static std::vector<std::string> sCPUTimeStats;
+      GetCPUTimeStats(sCPUTimeStats);
 
       Json::Value json;
       json["deltaTime_ms"] = _currentTime_ms - _lastWebvizUpdateTime_ms;
 
-      {
-        auto& usage = json["usage"];
-        std::lock_guard<std::mutex> lock(_cpuTimeStatsMutex);
-        for(size_t i = 0; i < _CPUTimeStats.size(); ++i) {
-          usage.append( _CPUTimeStats[i] );
-        }
+      auto& usage = json["usage"];
+      for(const auto& stats : sCPUTimeStats) {
+        usage.append( stats );
       }
 
       _webServiceCallback(json);
@@ -266,7 +458,14 @@ void OSState::Update(BaseStationTime_t currTime_nanosec)
 
 void OSState::SetUpdatePeriod(uint32_t milliseconds)
 {
+  if (milliseconds == _updatePeriod_ms) {
+    return;
+  }
+  _sampler.Stop();
   _updatePeriod_ms = milliseconds;
+  if (_updatePeriod_ms != 0) {
+    _sampler.Start(_updatePeriod_ms);
+  }
 }
 
 void OSState::SendToWebVizCallback(const std::function<void(const Json::Value&)>& callback) {
@@ -275,16 +474,7 @@ void OSState::SendToWebVizCallback(const std::function<void(const Json::Value&)>
 
 void OSState::UpdateCPUFreq_kHz() const
 {
-  // Update cpu freq
-  std::lock_guard<std::mutex> lock(_cpuMutex);
-  _cpuFile.open(kCPUFreqFile, std::ifstream::in);
-  if (_cpuFile.is_open()) {
-    _cpuFile >> _cpuFreq_kHz;
-    _cpuFile.close();
-  }
-  else {
-    LOG_ERROR("OSState.UpdateCPUFreq_kHz.FailedToOpenCPUFreqFile", "%s", kCPUFreqFile);
-  }
+  SampleItems(kSampleCPUFreq);
 }
 
 void OSState::SetDesiredCPUFrequency(DesiredCPUFrequency freq)
@@ -329,6 +519,8 @@ void OSState::SetDesiredCPUFrequency(DesiredCPUFrequency freq)
     LOG_INFO("OSState.SetDesiredCPUFrequency.Automatic", "Set to automatic cpu frequency management");
   }
 
+  _desiredCPUFreq = freq;
+
 
   // NOTE: not returning success / fail because all I know is that the file got written to. It's up to the OS
   // to actually change the frequency, and that could take some time or be overruled by something else
@@ -337,122 +529,75 @@ void OSState::SetDesiredCPUFrequency(DesiredCPUFrequency freq)
 
 void OSState::UpdateTemperature_C() const
 {
-  // Update temperature reading
-  std::lock_guard<std::mutex> lock(_temperatureMutex);
-  _temperatureFile.open(kTemperatureFile, std::ifstream::in);
-  if (_temperatureFile.is_open()) {
-    _temperatureFile >> _cpuTemp_C;
-    _temperatureFile.close();
-  }
-  else {
-    LOG_ERROR("OSState.UpdateTemperature_C.FailedToOpenTemperatureFile", "%s", kTemperatureFile);
-  }
+  SampleItems(kSampleTemperature);
 }
 
 void OSState::UpdateUptimeAndIdleTime() const
 {
-  // Update uptime and idle time data
-  std::lock_guard<std::mutex> lock(_uptimeMutex);
-  _uptimeFile.open(kUptimeFile, std::ifstream::in);
-  if (_uptimeFile.is_open()) {
-    _uptimeFile >> _uptime_s >> _idleTime_s;
-    _uptimeFile.close();
-  }
-  else {
-    LOG_ERROR("OSState.UpdateUptimeAndIdleTime.FailedToOpenUptimeFile", "%s", kUptimeFile);
-  }
+  SampleItems(kSampleUptime);
 }
 
 void OSState::UpdateMemoryInfo() const
 {
-  // Update total and free memory
-  std::lock_guard<std::mutex> lock(_memInfoMutex);
-  _memInfoFile.open(kMemInfoFile, std::ifstream::in);
-  if (_memInfoFile.is_open()) {
-    std::string discard;
-    _memInfoFile >> discard >> _totalMem_kB >> discard >> discard >> _freeMem_kB >> discard >> discard >> _availMem_kB;
-    _memInfoFile.close();
-  }
-  else {
-    LOG_ERROR("OSState.UpdateMemoryInfo.FailedToOpenMemInfoFile", "%s", kMemInfoFile);
-  }
+  SampleItems(kSampleMemoryInfo);
 }
 
 void OSState::UpdateCPUTimeStats() const
 {
-  // Update CPU time stats lines
-  std::lock_guard<std::mutex> lock(_cpuTimeStatsMutex);
-  _cpuTimeStatsFile.open(kCPUTimeStatsFile, std::ifstream::in);
-  if (_cpuTimeStatsFile.is_open()) {
-    static const int kNumCPUTimeStatLines = 5;
-    _CPUTimeStats.resize(kNumCPUTimeStatLines);
-    for (int i = 0; i < kNumCPUTimeStatLines; i++) {
-      std::getline(_cpuTimeStatsFile, _CPUTimeStats[i]);
-    }
-    _cpuTimeStatsFile.close();
-  }
-  else {
-    LOG_ERROR("OSState.UpdateCPUTimeStats.FailedToOpenCPUTimeStatsFile", "%s", kCPUTimeStatsFile);
-  }
+  SampleItems(kSampleCPUTimeStats);
 }
 
 uint32_t OSState::GetCPUFreq_kHz() const
 {
-  static uint64_t lastUpdate_ms = 0;
-  if ((_currentTime_ms - lastUpdate_ms > _updatePeriod_ms) || (_updatePeriod_ms == 0)) {
-    UpdateCPUFreq_kHz();
-    lastUpdate_ms = _currentTime_ms;
-  }
-
-  return _cpuFreq_kHz;
+  RequestSample(kSampleCPUFreq, _updatePeriod_ms);
+  std::lock_guard<std::mutex> lock(_snapshotMutex);
+  return _snapshot.cpuFreq_kHz;
 }
 
 
 bool OSState::IsCPUThrottling() const
 {
   DEV_ASSERT(_updatePeriod_ms != 0, "OSState.IsCPUThrottling.ZeroUpdate");
-  return (_cpuFreq_kHz < kNominalCPUFreq_kHz);
+  RequestSample(kSampleCPUFreq, _updatePeriod_ms);
+  std::lock_guard<std::mutex> lock(_snapshotMutex);
+  // The automatic governor idles below nominal, so only a lowered cap counts then. A manual frequency it can't hold
+  // is throttling too
+  if (_snapshot.cpuMaxFreq_kHz < kNominalCPUFreq_kHz) {
+    return true;
+  }
+  return (_desiredCPUFreq != DesiredCPUFrequency::Automatic) &&
+         (_snapshot.cpuFreq_kHz < std::min(kNominalCPUFreq_kHz, Util::EnumToUnderlying(_desiredCPUFreq)));
 }
 
 uint32_t OSState::GetTemperature_C() const
 {
-  static uint64_t lastUpdate_ms = 0;
-  if ((_currentTime_ms - lastUpdate_ms > _updatePeriod_ms) || (_updatePeriod_ms == 0)) {
-    UpdateTemperature_C();
-    lastUpdate_ms = _currentTime_ms;
-  }
-
   if(kSendFakeCpuTemperature) {
     return kFakeCpuTemperature_degC;
   }
-  return _cpuTemp_C;
+  RequestSample(kSampleTemperature, _updatePeriod_ms);
+  std::lock_guard<std::mutex> lock(_snapshotMutex);
+  return _snapshot.cpuTemp_C;
 }
 
 float OSState::GetUptimeAndIdleTime(float &idleTime_s) const
 {
-  static uint64_t lastUpdate_ms = 0;
-  if ((_currentTime_ms - lastUpdate_ms > _updatePeriod_ms) || (_updatePeriod_ms == 0)) {
-    UpdateUptimeAndIdleTime();
-    lastUpdate_ms = _currentTime_ms;
-  }
-
-  idleTime_s = _idleTime_s;
-  return _uptime_s;
+  RequestSample(kSampleUptime, _updatePeriod_ms);
+  std::lock_guard<std::mutex> lock(_snapshotMutex);
+  idleTime_s = _snapshot.idleTime_s;
+  return _snapshot.uptime_s;
 }
 
 void OSState::GetMemoryInfo(MemoryInfo & info) const
 {
-  // Update current stats?
-  static uint64_t lastUpdate_ms = 0;
-  if ((_currentTime_ms - lastUpdate_ms > _updatePeriod_ms) || (_updatePeriod_ms == 0)) {
-    UpdateMemoryInfo();
-    lastUpdate_ms = _currentTime_ms;
-  }
+  RequestSample(kSampleMemoryInfo, _updatePeriod_ms);
 
   // Populate return struct
-  info.totalMem_kB = _totalMem_kB;
-  info.availMem_kB = _availMem_kB;
-  info.freeMem_kB = _freeMem_kB;
+  {
+    std::lock_guard<std::mutex> lock(_snapshotMutex);
+    info.totalMem_kB = _snapshot.totalMem_kB;
+    info.availMem_kB = _snapshot.availMem_kB;
+    info.freeMem_kB = _snapshot.freeMem_kB;
+  }
   info.pressure = GetPressure(info.availMem_kB, info.totalMem_kB);
   info.alert = GetAlert(info.pressure, kMediumMemPressureMultiple, kHighMemPressureMultiple);
 
@@ -478,16 +623,9 @@ bool OSState::GetDiskInfo(const std::string & path, DiskInfo & info) const
 
 void OSState::GetCPUTimeStats(std::vector<std::string> & stats) const
 {
-  static uint64_t lastUpdate_ms = 0;
-  if ((_currentTime_ms - lastUpdate_ms > _updatePeriod_ms) || (_updatePeriod_ms == 0)) {
-    UpdateCPUTimeStats();
-    lastUpdate_ms = _currentTime_ms;
-  }
-
-  {
-    std::lock_guard<std::mutex> lock(_cpuTimeStatsMutex);
-    stats = _CPUTimeStats;
-  }
+  RequestSample(kSampleCPUTimeStats, _updatePeriod_ms);
+  std::lock_guard<std::mutex> lock(_snapshotMutex);
+  stats = _snapshot.cpuTimeStats;
 }
 
 
@@ -686,19 +824,10 @@ std::string OSState::GetMACAddress() const
   return "";
 }
 
-static bool GetCounter(const char * path, uint64_t & val)
+static bool GetCounter(SysFileReader& reader, uint64_t & val)
 {
-  std::ifstream rxFile;
-  rxFile.open(path);
-  if (rxFile.is_open()) {
-    rxFile >> val;
-    rxFile.close();
-    return true;
-  }
-  else {
-    LOG_ERROR("OSState.GetCounter.FailedToOpenCounterFile", "%s", path);
-  }
-  return false;
+  std::lock_guard<std::mutex> lock(_readMutex);
+  return reader.ReadUint64(val);
 }
 
 static OSState::Alert GetWifiAlert(uint64_t errors, uint64_t bytes)
@@ -724,32 +853,32 @@ static OSState::Alert GetWifiAlert(uint64_t errors, uint64_t bytes)
 uint64_t OSState::GetWifiTxBytes() const
 {
   uint64_t numBytes = 0;
-  GetCounter(kWifiTxBytesFile, numBytes);
+  GetCounter(_wifiTxBytesReader, numBytes);
   return numBytes;
 }
 
 uint64_t OSState::GetWifiRxBytes() const
 {
   uint64_t numBytes = 0;
-  GetCounter(kWifiRxBytesFile, numBytes);
+  GetCounter(_wifiRxBytesReader, numBytes);
   return numBytes;
 }
 
 bool OSState::GetWifiInfo(WifiInfo & wifiInfo) const
 {
-  if (!GetCounter(kWifiRxBytesFile, wifiInfo.rx_bytes)) {
+  if (!GetCounter(_wifiRxBytesReader, wifiInfo.rx_bytes)) {
     return false;
   }
 
-  if (!GetCounter(kWifiTxBytesFile, wifiInfo.tx_bytes)) {
+  if (!GetCounter(_wifiTxBytesReader, wifiInfo.tx_bytes)) {
     return false;
   }
 
-  if (!GetCounter(kWifiRxErrorsFile, wifiInfo.rx_errors)) {
+  if (!GetCounter(_wifiRxErrorsReader, wifiInfo.rx_errors)) {
     return false;
   }
 
-  if (!GetCounter(kWifiTxErrorsFile, wifiInfo.tx_errors)) {
+  if (!GetCounter(_wifiTxErrorsReader, wifiInfo.tx_errors)) {
     return false;
   }
 
@@ -0,0 +1,161 @@
+/**
+ * File: sysFileReader.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Reads small /proc and /sys files through a persistent file descriptor
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "osState/sysFileReader.h"
+
+#include "util/logging/logging.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+
+#define LOG_CHANNEL "OsState"
+
+namespace Anki {
+namespace Vector {
+
+SysFileReader::SysFileReader(const char* path)
+: _path(path)
+{
+}
+
+SysFileReader::~SysFileReader()
+{
+  Close();
+}
+
+bool SysFileReader::Open()
+{
+  _fd = open(_path, O_RDONLY | O_CLOEXEC);
+  if (_fd < 0) {
+    // Only log the first failure, since this gets retried on every read
+    if (!_hasLoggedError) {
+      LOG_ERROR("SysFileReader.Open.Failed", "%s (errno %d)", _path, errno);
+      _hasLoggedError = true;
+    }
+    return false;
+  }
+  return true;
+}
+
+void SysFileReader::Close()
+{
+  if (_fd >= 0) {
+    close(_fd);
+    _fd = -1;
+  }
+}
+
+int SysFileReader::Read(char* buffer, size_t bufferSize)
+{
+  if ((buffer == nullptr) || (bufferSize == 0)) {
+    return -1;
+  }
+  buffer[0] = '\0';
+
+  // A file whose kernel object went away keeps failing on the old descriptor, so try once more on a fresh one
+  for (int attempt = 0; attempt < 2; ++attempt) {
+    if ((_fd < 0) && !Open()) {
+      return -1;
+    }
+
+    // Reading from offset zero gets the kernel to regenerate the contents, without a seek or reopen
+    const ssize_t numRead = pread(_fd, buffer, bufferSize - 1, 0);
+    if (numRead >= 0) {
+      buffer[numRead] = '\0';
+      return static_cast<int>(numRead);
+    }
+    Close();
+  }
+
+  if (!_hasLoggedError) {
+    LOG_ERROR("SysFileReader.Read.Failed", "%s (errno %d)", _path, errno);
+    _hasLoggedError = true;
+  }
+  return -1;
+}
+
+bool SysFileReader::ReadUint32(uint32_t& value)
+{
+  uint64_t value64 = 0;
+  if (!ReadUint64(value64)) {
+    return false;
+  }
+  value = static_cast<uint32_t>(value64);
+  return true;
+}
+
+bool SysFileReader::ReadUint64(uint64_t& value)
+{
+  char buffer[32];
+  if (Read(buffer, sizeof(buffer)) <= 0) {
+    return false;
+  }
+  const char* cursor = buffer;
+  return ParseUint64(cursor, value);
+}
+
+bool SysFileReader::ParseUint64(const char*& cursor, uint64_t& value)
+{
+  // strtoull would also take a sign, which no counter has
+  const char* start = cursor;
+  while ((*start == ' ') || (*start == '\t')) {
+    ++start;
+  }
+  if ((*start < '0') || (*start > '9')) {
+    return false;
+  }
+
+  char* end = nullptr;
+  errno = 0;
+  const unsigned long long parsed = strtoull(start, &end, 10);
+  if (errno != 0) {
+    return false;
+  }
+  value = static_cast<uint64_t>(parsed);
+  cursor = end;
+  return true;
+}
+
+bool SysFileReader::ParseFloat(const char*& cursor, float& value)
+{
+  char* end = nullptr;
+  const float parsed = strtof(cursor, &end);
+  if (end == cursor) {
+    return false;
+  }
+  value = parsed;
+  cursor = end;
+  return true;
+}
+
+bool SysFileReader::FindKeyValue(const char* text, const char* key, uint64_t& value)
+{
+  const size_t keyLength = strlen(key);
+  const char* line = text;
+  while ((line != nullptr) && (*line != '\0')) {
+    if ((strncmp(line, key, keyLength) == 0) && (line[keyLength] == ':')) {
+      const char* cursor = line + keyLength + 1;
+      return ParseUint64(cursor, value);
+    }
+    line = strchr(line, '\n');
+    if (line != nullptr) {
+      ++line;
+    }
+  }
+  return false;
+}
+
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,64 @@
+/**
+ * File: sysFileReader.h
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Reads small /proc and /sys files through a file descriptor that stays open between reads, plus
+ *              parsers that work in place on the text read. Neither allocates, so they're cheap enough to sample
+ *              OS state often
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Victor_SysFileReader_H__
+#define __Victor_SysFileReader_H__
+
+#include "util/helpers/noncopyable.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace Anki {
+namespace Vector {
+
+class SysFileReader : private Util::noncopyable
+{
+public:
+  // path must outlive the reader (in practice, it's a string literal)
+  explicit SysFileReader(const char* path);
+  ~SysFileReader();
+
+  // Reads the file from the start into buffer and null terminates it. Files too big for buffer are cut short.
+  // The file is opened on first use, and reopened if a read fails (e.g. a network interface went away and came
+  // back). Returns the number of bytes read, or -1 on failure
+  int Read(char* buffer, size_t bufferSize);
+
+  // Reads a file holding a single number, like most of /sys
+  bool ReadUint32(uint32_t& value);
+  bool ReadUint64(uint64_t& value);
+
+  const char* GetPath() const { return _path; }
+
+  // Parse the number at cursor, skipping leading whitespace, and move cursor past it. Return false (leaving cursor
+  // alone) if there isn't one
+  static bool ParseUint64(const char*& cursor, uint64_t& value);
+  static bool ParseFloat(const char*& cursor, float& value);
+
+  // Find the line starting with key in text laid out like /proc/meminfo ("Key:   value kB") and parse its value
+  static bool FindKeyValue(const char* text, const char* key, uint64_t& value);
+
+private:
+  bool Open();
+  void Close();
+
+  const char* _path;
+  int         _fd = -1;
+  bool        _hasLoggedError = false;
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Victor_SysFileReader_H__
@@ -46,6 +46,22 @@ TRACEPOINT_EVENT(
     TP_FIELDS(ctf_integer(long long, duration, duration))
 )
 
+TRACEPOINT_EVENT(
+    anki_ust,
+    vic_engine_vision_stage_latency,
+    TP_ARGS(int, stage, long long, latency),
+    TP_FIELDS(ctf_integer(int, stage, stage)
+              ctf_integer(long long, latency, latency))
+)
+
+TRACEPOINT_EVENT(
+    anki_ust,
+    vic_engine_vision_mode_duration,
+    TP_ARGS(int, mode, long long, duration),
+    TP_FIELDS(ctf_integer(int, mode, mode)
+              ctf_integer(long long, duration, duration))
+)
+
 #endif /* ANKITRACE */
 #endif /* ANKI_UST_H */
 
@@ -0,0 +1,39 @@
+/**
+ * File: cameraService.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Platform-independent parts of CameraService
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "camera/cameraService.h"
+
+namespace Anki {
+namespace Vector {
+
+bool CameraService::CameraGetSharedFrame(u32 atTimestamp_ms, Vision::ImageBuffer& buffer)
+{
+  if(!CameraGetFrame(atTimestamp_ms, buffer))
+  {
+    return false;
+  }
+
+  // The owner holds no pointer of its own; its deleter just unlocks the frame once the last copy lets go of it.
+  // The camera may have been torn down by then (e.g. at shutdown), in which case there is nothing to release.
+  const u32 imageID = buffer.GetImageId();
+  buffer.SetDataOwner(Vision::ImageBuffer::DataOwner(nullptr, [imageID](void*) {
+    if(CameraService::hasInstance())
+    {
+      CameraService::getInstance()->CameraReleaseFrame(imageID);
+    }
+  }));
+
+  return true;
+}
+
+} // namespace Vector
+} // namespace Anki
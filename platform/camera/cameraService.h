@@ -62,6 +62,10 @@ namespace Anki
       // Unit test processes must call SetSupervisor(nullptr) to run without a supervisor.
       static void SetSupervisor(webots::Supervisor *sup);
 
+      // Whether the simulated head camera renders images (the default). Tests that do not need vision can turn it
+      // off, since rendering is most of the cost of a simulation step. Call before the first getInstance().
+      static void SetRenderingEnabled(bool enabled);
+
 #endif
 
 // #pragma mark --- Cameras ---
@@ -94,6 +98,11 @@ namespace Anki
       // Releases lock on buffer for specified frameID acquired by calling CameraGetFrame.
       bool CameraReleaseFrame(u32 imageID);
 
+      // Same as CameraGetFrame, but the buffer owns the frame lock (see ImageBuffer::SetDataOwner), so the frame is
+      // released automatically once the buffer and every copy of it (e.g. in an ImageCache) are gone. The buffer
+      // can be handed straight to the vision system without copying. Do not call CameraReleaseFrame for it.
+      bool CameraGetSharedFrame(u32 atTimestamp_ms, Vision::ImageBuffer& buffer);
+
       u16 CameraGetHeight() const {return _imageCaptureHeight;}
       u16 CameraGetWidth()  const {return _imageCaptureWidth; }
 
@@ -50,6 +50,9 @@ namespace Anki {
       // Current supervisor (if any)
       webots::Supervisor* _engineSupervisor = nullptr;
 
+      // Whether the head camera is rendered at all (see SetRenderingEnabled())
+      bool _renderingEnabled = true;
+
       // Const parameters / settings
       const u32 VISION_TIME_STEP = 65; // This should be a multiple of the world's basic time step!
 
@@ -123,6 +126,12 @@ namespace Anki {
       _engineSupervisorSet = true;
     }
 
+    void CameraService::SetRenderingEnabled(bool enabled)
+    {
+      DEV_ASSERT(nullptr == _instance, "cameraService_mac.SetRenderingEnabled.AlreadyCreated");
+      _renderingEnabled = enabled;
+    }
+
     CameraService::CameraService()
     : _imageSensorCaptureHeight(DEFAULT_CAMERA_RESOLUTION_HEIGHT)
     , _imageSensorCaptureWidth(DEFAULT_CAMERA_RESOLUTION_WIDTH)
@@ -144,7 +153,12 @@ namespace Anki {
         // Head Camera
         headCam_ = _engineSupervisor->getCamera("HeadCamera");
         if (nullptr != headCam_) {
-          headCam_->enable(VISION_TIME_STEP);
+          // Calibration comes from the camera's properties, so is still filled in when it is not rendering
+          if (_renderingEnabled) {
+            headCam_->enable(VISION_TIME_STEP);
+          } else {
+            PRINT_NAMED_INFO("cameraService_mac.RenderingDisabled", "Head camera will not produce images");
+          }
           FillCameraInfo(headCam_, headCamInfo_);
 
           // HACK: Figure out when first camera image will actually be taken (next
@@ -347,7 +361,7 @@ namespace Anki {
       {
         headCam_->disable();
       }
-      else
+      else if (_renderingEnabled)
       {
         headCam_->enable(VISION_TIME_STEP);
       }
@@ -362,7 +376,7 @@ namespace Anki {
     // Returns true and popuates buffer if we have an available image from at or before atTimestamp_ms.
     bool CameraService::CameraGetFrame(u32 atTimestamp_ms, Vision::ImageBuffer& buffer)
     {
-      if (nullptr == headCam_) {
+      if ((nullptr == headCam_) || !_renderingEnabled) {
         return false;
       }
 
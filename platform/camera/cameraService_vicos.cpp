@@ -59,6 +59,17 @@ namespace Anki {
       bool _skipNextImage = false;
       bool _cameraPaused = false;
       bool _temporaryUnpause = false;
+
+      // Exposure last asked of the camera, 0 until then
+      u16 _exposure_ms = 0;
+
+      // Frame timestamps are nanoseconds of CLOCK_MONOTONIC, which is also what steady_clock (and so GetTimeStamp())
+      // reads here. Converting directly rather than measuring the offset between two clock reads keeps the
+      // image-to-pose alignment free of scheduling jitter
+      TimeStamp_t MonotonicNsToTimeStamp(uint64_t timestamp_ns)
+      {
+        return static_cast<TimeStamp_t>(timestamp_ns / 1000000LL);
+      }
     } // "private" namespace
 
 #pragma mark --- Hardware Method Implementations ---
@@ -329,6 +340,7 @@ namespace Anki {
 
       UnpauseForCameraSetting();
       
+      _exposure_ms = exposure_ms;
       camera_set_exposure(_camera, exposure_ms, gain);
     }
 
@@ -404,20 +416,17 @@ namespace Anki {
         return false;
       }
 
+      // Nothing new since the last frame: skip locking every slot just to find that out
+      if(!camera_frame_available(_camera)) {
+        return false;
+      }
+
       std::lock_guard<std::mutex> lock(_lock);
       anki_camera_frame_t* capture_frame = NULL;
 
-      uint64_t desiredImageTimestamp_ns = 0;
-      if(atTimestamp_ms != 0)
-      {
-        // Frame timestamp is nanoseconds of uptime (based on CLOCK_MONOTONIC)
-        // Calculate an offset to convert TimeStamp_t(u32) to time base
-        struct timespec now_ts = {0,0};
-        clock_gettime(CLOCK_MONOTONIC, &now_ts);
-        const uint64_t now_ns = (now_ts.tv_nsec + now_ts.tv_sec*1000000000LL);
-        const uint64_t now_ms = GetTimeStamp();
-        desiredImageTimestamp_ns = ((((int64_t)atTimestamp_ms - (int64_t)now_ms))*1000000LL) + now_ns;
-      }
+      // Any frame captured during the millisecond atTimestamp_ms will do
+      const uint64_t desiredImageTimestamp_ns = (atTimestamp_ms != 0 ?
+                                                 ((uint64_t)atTimestamp_ms + 1) * 1000000LL - 1 : 0);
 
       int rc = camera_frame_acquire(_camera, desiredImageTimestamp_ns, &capture_frame);
       if (rc != 0) {
@@ -433,23 +442,11 @@ namespace Anki {
         return false;
       }
 
-      u32 timestamp = 0;
-      if (capture_frame->timestamp != 0) {
-        // Frame timestamp is nanoseconds of uptime (based on CLOCK_MONOTONIC)
-        // Calculate an offset to convert to TimeStamp_t time base
-        struct timespec now_ts = {0,0};
-        clock_gettime(CLOCK_MONOTONIC, &now_ts);
-        const uint64_t now_ns = (now_ts.tv_nsec + now_ts.tv_sec*1000000000LL);
-        const uint64_t offset_ns = now_ns - capture_frame->timestamp;
-
-        // Apply offset
-        const TimeStamp_t now_ms = GetTimeStamp();
-        const TimeStamp_t frame_time_ms = now_ms - static_cast<TimeStamp_t>(offset_ns / 1000000LL);
-
-        timestamp = frame_time_ms;
-      } else {
-        timestamp = GetTimeStamp();
-      }
+      // The frame timestamp is when the sensor started reading out the frame, so the first row started exposing
+      // one exposure time before that
+      const TimeStamp_t timestamp = (capture_frame->timestamp != 0 ?
+                                     MonotonicNsToTimeStamp(capture_frame->timestamp) : GetTimeStamp());
+      const TimeStamp_t exposureStartTimestamp = (timestamp > _exposure_ms ? timestamp - _exposure_ms : timestamp);
 
       _imageFrameID = capture_frame->frame_id;
 
@@ -484,6 +481,7 @@ namespace Anki {
                                    _curFormat,
                                    timestamp,
                                    _imageFrameID);
+      buffer.SetExposureStartTimestamp(exposureStartTimestamp);
       
       return true;
     } // CameraGetFrame()
@@ -1093,6 +1093,25 @@ UNLOCK:
   return rc;
 }
 
+int camera_frame_available(struct anki_camera_handle *camera)
+{
+  if(camera == NULL)
+  {
+    return 0;
+  }
+
+  struct client_ctx *client = &CAMERA_HANDLE_P(camera)->camera_client;
+  uint8_t *data = client->camera_buf.data;
+  if (data == NULL) {
+    return 0;
+  }
+  anki_camera_buf_header_t *header = (anki_camera_buf_header_t *)data;
+
+  // Same check camera_frame_acquire makes after locking every slot
+  const uint32_t wSlot = atomic_load(&header->locks.write_idx);
+  return (wSlot < ANKI_CAMERA_MAX_FRAME_COUNT) && (wSlot != CAMERA_HANDLE_P(camera)->last_frame_slot);
+}
+
 // Release (unlock) frame to camera system
 int camera_frame_release(struct anki_camera_handle *camera, uint32_t frame_id)
 {
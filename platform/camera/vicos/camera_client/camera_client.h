@@ -148,6 +148,10 @@ int camera_frame_acquire(struct anki_camera_handle* camera,
                          uint64_t frame_timestamp,
                          anki_camera_frame_t** out_frame);
 
+// Returns 1 if a frame has been written since the last one acquired, 0 otherwise. Takes no locks, so it is cheap
+// enough to call before every camera_frame_acquire
+int camera_frame_available(struct anki_camera_handle* camera);
+
 // Release (unlock) frame to camera system
 int camera_frame_release(struct anki_camera_handle* camera, uint32_t frame_id);
 
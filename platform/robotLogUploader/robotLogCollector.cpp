@@ -0,0 +1,261 @@
+/**
+* File: robotLogCollector.cpp
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Incremental robot log collector
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+
+#include "robotLogCollector.h"
+#include "robotLogUploader.h"
+
+#include "util/fileUtils/fileUtils.h"
+#include "util/logging/logging.h"
+#include "util/logging/rollingFileLogger.h"
+
+#include <algorithm>
+#include <fcntl.h>
+#include <zlib.h>
+
+#define LOG_CHANNEL "RobotLogCollector"
+
+namespace Anki {
+namespace Vector {
+
+const char * const RobotLogCollector::kDefaultSpoolDirectory = "/data/data/com.anki.victor/cache/logSegments";
+const char * const RobotLogCollector::kSegmentExtension = ".log.gz";
+
+constexpr size_t RobotLogCollector::kMaxSegmentSize;
+constexpr size_t RobotLogCollector::kMaxSpoolSize;
+
+namespace {
+
+  // Same source as RobotLogDumper, without the shell gzip
+  const char * kLogCommand = "/usr/bin/sudo /anki/bin/vic-log-cat";
+
+  // Cursor is the last line collected
+  const char * kCursorFileName = "cursor";
+
+  // Each segment is written under a temporary name and only renamed into place once it's complete, so a collection
+  // that dies part way never leaves a truncated segment to be uploaded
+  class SegmentWriter
+  {
+  public:
+    explicit SegmentWriter(const std::string & spoolDirectory)
+    : _spoolDirectory(spoolDirectory)
+    , _baseName(Util::RollingFileLogger::GetDateTimeString(Util::RollingFileLogger::ClockType::now()))
+    {
+    }
+
+    ~SegmentWriter()
+    {
+      // Anything still open wasn't finished
+      if (_gz != nullptr) {
+        gzclose(_gz);
+        Util::FileUtils::DeleteFile(_tmpPath);
+      }
+    }
+
+    bool Write(const std::string & line)
+    {
+      if (_gz == nullptr && !Open()) {
+        return false;
+      }
+      if (gzwrite(_gz, line.data(), (unsigned) line.size()) != (int) line.size()) {
+        LOG_ERROR("RobotLogCollector.SegmentWriter.Write", "Unable to write %s", _tmpPath.c_str());
+        return false;
+      }
+      _numBytes += line.size();
+      if (_numBytes >= RobotLogCollector::kMaxSegmentSize) {
+        return Close();
+      }
+      return true;
+    }
+
+    bool Close()
+    {
+      if (_gz == nullptr) {
+        return true;
+      }
+      const int status = gzclose(_gz);
+      _gz = nullptr;
+      if (status != Z_OK || rename(_tmpPath.c_str(), _path.c_str()) != 0) {
+        LOG_ERROR("RobotLogCollector.SegmentWriter.Close", "Unable to finish %s (status %d errno %d)",
+                  _path.c_str(), status, errno);
+        Util::FileUtils::DeleteFile(_tmpPath);
+        return false;
+      }
+      ++_numSegments;
+      return true;
+    }
+
+    size_t GetNumSegments() const { return _numSegments; }
+
+  private:
+    const std::string _spoolDirectory;
+    const std::string _baseName;
+    std::string       _path;
+    std::string       _tmpPath;
+    gzFile            _gz = nullptr;
+    size_t            _numBytes = 0;
+    size_t            _numSegments = 0;
+
+    bool Open()
+    {
+      // Segments of one collection share its time, the index keeps them in order
+      char suffix[16];
+      snprintf(suffix, sizeof(suffix), "-%03zu", _numSegments);
+      _path = _spoolDirectory + "/" + _baseName + suffix + RobotLogCollector::kSegmentExtension;
+      _tmpPath = _path + "~";
+      _numBytes = 0;
+
+      const int fd = open(_tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd < 0) {
+        LOG_ERROR("RobotLogCollector.SegmentWriter.Open", "Unable to create %s (errno %d)", _tmpPath.c_str(), errno);
+        return false;
+      }
+      // Fastest level: most of the cost of a collection is compression, and segments are small anyway
+      _gz = gzdopen(fd, "wb1");
+      if (_gz == nullptr) {
+        LOG_ERROR("RobotLogCollector.SegmentWriter.Open", "Unable to compress %s", _tmpPath.c_str());
+        close(fd);
+        Util::FileUtils::DeleteFile(_tmpPath);
+        return false;
+      }
+      return true;
+    }
+  };
+
+}
+
+RobotLogCollector::RobotLogCollector(const std::string & spoolDirectory)
+: _spoolDirectory(spoolDirectory)
+, _cursorPath(spoolDirectory + "/" + kCursorFileName)
+{
+}
+
+Result RobotLogCollector::Scan(const std::string & cursor, bool skipToCursor, bool & foundCursor, std::string & lastLine)
+{
+  foundCursor = false;
+
+  FILE * fp = popen(kLogCommand, "r");
+  if (fp == nullptr) {
+    LOG_ERROR("RobotLogCollector.Scan", "Unable to run %s (errno %d)", kLogCommand, errno);
+    return RESULT_FAIL;
+  }
+
+  SegmentWriter writer(_spoolDirectory);
+  bool ok = true;
+  char * buf = nullptr;
+  size_t bufSize = 0;
+  ssize_t len;
+  // Keep reading on a write error, so the command isn't left blocked on a full pipe
+  while ((len = getline(&buf, &bufSize, fp)) > 0) {
+    lastLine.assign(buf, (size_t) len);
+    if (skipToCursor && !foundCursor) {
+      // Lines before the cursor have been collected already, so they're only compared, never compressed
+      foundCursor = (lastLine == cursor);
+      continue;
+    }
+    ok = ok && writer.Write(lastLine);
+  }
+  free(buf);
+
+  const int status = pclose(fp);
+  if (status != 0) {
+    LOG_ERROR("RobotLogCollector.Scan", "Log process exit status %d", status);
+    return RESULT_FAIL;
+  }
+
+  if (!ok || !writer.Close()) {
+    return RESULT_FAIL;
+  }
+
+  LOG_INFO("RobotLogCollector.Scan", "Wrote %zu segments", writer.GetNumSegments());
+  return RESULT_OK;
+}
+
+Result RobotLogCollector::Collect()
+{
+  using namespace Anki::Util;
+
+  if (!FileUtils::CreateDirectory(_spoolDirectory)) {
+    LOG_ERROR("RobotLogCollector.Collect", "Unable to create %s", _spoolDirectory.c_str());
+    return RESULT_FAIL;
+  }
+
+  const std::string & cursor = FileUtils::ReadFile(_cursorPath);
+  bool foundCursor = false;
+  std::string lastLine;
+
+  Result result = Scan(cursor, !cursor.empty(), foundCursor, lastLine);
+  if (result == RESULT_OK && !cursor.empty() && !foundCursor) {
+    // The log has rolled past the cursor since the last collection, so all of it is new
+    LOG_INFO("RobotLogCollector.Collect", "Cursor not found, collecting the whole log");
+    result = Scan(cursor, false, foundCursor, lastLine);
+  }
+
+  if (result != RESULT_OK) {
+    return result;
+  }
+
+  if (!lastLine.empty() && !FileUtils::WriteFileAtomic(_cursorPath, lastLine)) {
+    LOG_WARNING("RobotLogCollector.Collect", "Unable to write %s", _cursorPath.c_str());
+  }
+
+  TrimSpool();
+  return RESULT_OK;
+}
+
+std::vector<std::string> RobotLogCollector::GetPendingSegments() const
+{
+  auto segments = Util::FileUtils::FilesInDirectory(_spoolDirectory, true, kSegmentExtension);
+  // Names start with the collection time
+  std::sort(segments.begin(), segments.end());
+  return segments;
+}
+
+Result RobotLogCollector::UploadPending(RobotLogUploader & uploader, std::vector<std::string> & urls)
+{
+  const auto & segments = GetPendingSegments();
+  if (segments.empty()) {
+    urls.clear();
+    return RESULT_OK;
+  }
+
+  const Result result = uploader.Upload(segments, urls);
+  for (size_t i = 0; i < urls.size(); ++i) {
+    Util::FileUtils::DeleteFile(segments[i]);
+  }
+  if (result != RESULT_OK) {
+    LOG_WARNING("RobotLogCollector.UploadPending", "Uploaded %zu of %zu segments", urls.size(), segments.size());
+  }
+  return result;
+}
+
+void RobotLogCollector::TrimSpool()
+{
+  const auto & segments = GetPendingSegments();
+  size_t spoolSize = 0;
+  for (const auto & segment : segments) {
+    const ssize_t size = Util::FileUtils::GetFileSize(segment);
+    spoolSize += (size > 0) ? (size_t) size : 0;
+  }
+
+  for (const auto & segment : segments) {
+    if (spoolSize <= kMaxSpoolSize) {
+      break;
+    }
+    const ssize_t size = Util::FileUtils::GetFileSize(segment);
+    spoolSize -= std::min(spoolSize, (size > 0) ? (size_t) size : 0);
+    LOG_WARNING("RobotLogCollector.TrimSpool", "Dropping %s", segment.c_str());
+    Util::FileUtils::DeleteFile(segment);
+  }
+}
+
+} // end namespace Vector
+} // end namespace Anki
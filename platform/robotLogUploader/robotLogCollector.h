@@ -0,0 +1,67 @@
+/**
+* File: robotLogCollector.h
+*
+* Author: Victor Rebuild
+* Created: 10/14/2026
+*
+* Description: Incremental robot log collector. Each collection reads the system log, skips the lines that were
+*              already collected and compresses the new ones into segments in a spool directory, rolling to a new
+*              segment every kMaxSegmentSize bytes. Segments stay in the spool until they're uploaded, so a support
+*              request only has to compress what was logged since the last collection and send what hasn't gone.
+*
+* Copyright: Victor Rebuild 2026
+*
+*/
+
+#ifndef __anki_vector_robotLogCollector_h
+#define __anki_vector_robotLogCollector_h
+
+#include "coretech/common/shared/types.h"
+#include <string>
+#include <vector>
+
+namespace Anki {
+namespace Vector {
+
+class RobotLogUploader;
+
+class RobotLogCollector
+{
+public:
+  static const char * const kDefaultSpoolDirectory;
+  static const char * const kSegmentExtension;
+
+  // Uncompressed bytes per segment
+  static constexpr size_t kMaxSegmentSize = 1024 * 1024;
+
+  // Compressed bytes kept in the spool. The oldest segments are dropped past this, uploaded or not
+  static constexpr size_t kMaxSpoolSize = 8 * 1024 * 1024;
+
+  explicit RobotLogCollector(const std::string & spoolDirectory = kDefaultSpoolDirectory);
+
+  // Compress lines logged since the last collection into new segments
+  Result Collect();
+
+  // Segments waiting to be uploaded, oldest first
+  std::vector<std::string> GetPendingSegments() const;
+
+  // Upload pending segments in order over one connection, deleting each one that was uploaded.
+  // urls holds the url of each segment uploaded.
+  Result UploadPending(RobotLogUploader & uploader, std::vector<std::string> & urls);
+
+private:
+  std::string _spoolDirectory;
+  std::string _cursorPath;
+
+  // Reads the system log into segments. If skipToCursor, lines up to and including the cursor line are skipped,
+  // and foundCursor says whether it was seen. lastLine is the last line read.
+  Result Scan(const std::string & cursor, bool skipToCursor, bool & foundCursor, std::string & lastLine);
+
+  void TrimSpool();
+
+};
+
+} // end namespace Vector
+} // end namespace Anki
+
+#endif
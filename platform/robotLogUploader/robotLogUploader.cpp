@@ -8,10 +8,11 @@
 */
 
 #include "robotLogUploader.h"
-#include "robotLogDumper.h"
+#include "robotLogCollector.h"
 
 #include "clad/cloud/logcollector.h"
 #include "coretech/messaging/shared/socketConstants.h"
+#include "util/cpuProfiler/cpuHitchRecorder.h"
 #include "util/fileUtils/fileUtils.h"
 #include "util/logging/logging.h"
 #include "util/string/stringUtils.h"
@@ -24,6 +25,11 @@
 namespace Anki {
 namespace Vector {
 
+namespace {
+  // Where vic-engine and vic-anim leave CpuHitchRecorder dumps
+  const char * kCpuHitchDirectory = "/data/data/com.anki.victor/cache/cpuHitches";
+}
+
 Result RobotLogUploader::Connect()
 {
   // Construct client path with PID so it will be unique on this host
@@ -81,19 +87,46 @@ Result RobotLogUploader::Disconnect()
 
 Result RobotLogUploader::Upload(const std::string & path, std::string & url)
 {
+  std::vector<std::string> urls;
+  const Result result = Upload({path}, urls);
+  if (result == RESULT_OK) {
+    url = urls.front();
+  }
+  return result;
+}
+
+Result RobotLogUploader::Upload(const std::vector<std::string> & paths, std::vector<std::string> & urls)
+{
+  urls.clear();
+
   Result result = Connect();
   if (result != RESULT_OK) {
     LOG_ERROR("RobotLogUploader.Upload", "Unable to connect to log collector service");
     return result;
   }
 
+  // One connection for the whole batch, one request at a time
+  for (const auto & path : paths) {
+    std::string url;
+    result = UploadConnected(path, url);
+    if (result != RESULT_OK) {
+      break;
+    }
+    urls.push_back(std::move(url));
+  }
+
+  Disconnect();
+  return result;
+}
+
+Result RobotLogUploader::UploadConnected(const std::string & path, std::string & url)
+{
   LogCollector::UploadRequest request;
   request.logFileName = path;
 
-  result  = Send(LogCollector::LogCollectorRequest(std::move(request)));
+  Result result = Send(LogCollector::LogCollectorRequest(std::move(request)));
   if (result != RESULT_OK) {
     LOG_ERROR("RobotLogUploader.Upload", "Unable to send upload request (error %d)", result);
-    Disconnect();
     return result;
   }
 
@@ -125,8 +158,6 @@ Result RobotLogUploader::Upload(const std::string & path, std::string & url)
   LogCollectorResponse response;
   result = Receive(response);
 
-  Disconnect();
-
   if (result != RESULT_OK) {
     LOG_ERROR("RobotLogUploader.Upload", "Unable to receive log collector response (error %d)", result);
     return result;
@@ -167,27 +198,41 @@ Result RobotLogUploader::Upload(const std::string & path, std::string & url)
 Result RobotLogUploader::UploadDebugLogs(std::string & status)
 {
   using namespace Anki::Util;
-  const std::string & logpath = "/tmp/" + GetUUIDString() + ".gz";
-  std::string url;
 
-  RobotLogDumper logDumper;
-  Result result = logDumper.Dump(logpath);
+  // Only what was logged since the last collection needs compressing, earlier segments are already waiting
+  RobotLogCollector logCollector;
+  Result result = logCollector.Collect();
   if (result != RESULT_OK) {
-    FileUtils::DeleteFile(logpath);
     status = "Unable to dump logs";
     return result;
   }
 
   RobotLogUploader logUploader;
-  result = logUploader.Upload(logpath, url);
+  std::vector<std::string> urls;
+  result = logCollector.UploadPending(logUploader, urls);
   if (result != RESULT_OK) {
-    FileUtils::DeleteFile(logpath);
     status = "Unable to upload logs";
     return result;
   }
 
-  FileUtils::DeleteFile(logpath);
-  status = url;
+  status = StringJoin(urls);
+
+  #if ANKI_CPU_HITCH_RECORDER_ENABLED
+  // Send any hitch dumps along with the logs. They're only deleted once they've gone.
+  const auto & hitchPaths = FileUtils::FilesInDirectory(kCpuHitchDirectory, true, CpuHitchRecorder::kDumpFileExtension);
+  if (!hitchPaths.empty()) {
+    std::vector<std::string> hitchUrls;
+    if (logUploader.Upload(hitchPaths, hitchUrls) != RESULT_OK) {
+      LOG_WARNING("RobotLogUploader.UploadDebugLogs", "Uploaded %zu of %zu hitch dumps",
+                  hitchUrls.size(), hitchPaths.size());
+    }
+    // The batch goes in order and stops at the first failure
+    for (size_t i = 0; i < hitchUrls.size(); ++i) {
+      FileUtils::DeleteFile(hitchPaths[i]);
+    }
+  }
+  #endif
+
   return RESULT_OK;
 }
 
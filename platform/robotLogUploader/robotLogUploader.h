@@ -13,6 +13,7 @@
 #include "coretech/common/shared/types.h"
 #include "coretech/messaging/shared/LocalUdpClient.h"
 #include <string>
+#include <vector>
 
 // Forward declarations
 namespace Anki {
@@ -35,8 +36,12 @@ public:
   // Returns RESULT_OK and url on success, else error.
   Result Upload(const std::string & path, std::string & url);
 
-  // All-in-one version of above.
-  // If return value is RESULT_OK, status contains URL.
+  // Upload each of the given paths in order over a single connection, stopping at the first failure.
+  // Returns RESULT_OK if all were uploaded. urls holds the url of each path uploaded.
+  Result Upload(const std::vector<std::string> & paths, std::vector<std::string> & urls);
+
+  // All-in-one version of above. Collects logs since the last call and uploads every segment still waiting.
+  // If return value is RESULT_OK, status contains the comma-separated URLs of the segments uploaded.
   // If return value indicates error, status contains error string.
   static Result UploadDebugLogs(std::string & status);
 
@@ -57,6 +62,9 @@ private:
   Result Receive(LogCollectorResponse & response);
   Result Disconnect();
 
+  // Upload one path over the current connection
+  Result UploadConnected(const std::string & path, std::string & url);
+
 };
 
 } // end namespace Vector
@@ -24,21 +24,44 @@ bool BleClient::SendEncrypted(uint8_t* msg, size_t length) {
   return Send(msg, length, kAppReadCharacteristicUUID.c_str());
 }
 
-bool BleClient::Send(uint8_t* msg, size_t length, std::string charUuid) {
+const size_t BleClient::kMaxHeldPackets;
+
+bool BleClient::Send(uint8_t* msg, size_t length, const std::string& charUuid) {
   if(_connectionId == -1) {
     return false;
   }
 
-  std::vector<uint8_t> msgVector(msg, msg+length);
+  if(_congested || !_heldPackets.empty()) {
+    // Keep packets in order behind any already held
+    if(_heldPackets.size() >= kMaxHeldPackets) {
+      Log::Error("BleClient: dropping packet, %zu packets already held for congestion", _heldPackets.size());
+      return false;
+    }
+    _heldPackets.push_back({charUuid, std::vector<uint8_t>(msg, msg+length)});
+    return true;
+  }
 
   SendMessage(_connectionId,
               charUuid,
               true,
-              msgVector);
+              msg,
+              length);
 
   return true;
 }
 
+void BleClient::FlushHeldPackets() {
+  while(!_congested && !_heldPackets.empty() && (_connectionId != -1)) {
+    const HeldPacket& packet = _heldPackets.front();
+    SendMessage(_connectionId,
+                packet.charUuid,
+                true,
+                packet.bytes.data(),
+                packet.bytes.size());
+    _heldPackets.pop_front();
+  }
+}
+
 void BleClient::OnReceiveMessage(const int connection_id,
                                  const std::string& characteristic_uuid,
                                  const std::vector<uint8_t>& value) {
@@ -74,6 +97,7 @@ void BleClient::OnInboundConnectionChange(int connection_id, int connected) {
   } else {
     _disconnectedSignal.emit(_connectionId, _stream);
     _connectionId = -1;
+    _heldPackets.clear();
   }
 }
 
@@ -81,10 +105,12 @@ void BleClient::OnPeripheralStateUpdate(const bool advertising,
                                         const int connection_id,
                                         const int connected,
                                         const bool congested) {
-  (void)congested; // unused
+  _congested = congested;
   OnInboundConnectionChange(connection_id, connected);
 
   _advertisingUpdateSignal.emit(advertising);
+
+  FlushHeldPackets();
 }
 
 void BleClient::OnPeerClose(const int sockfd) {
@@ -16,7 +16,9 @@
 #include "signals/simpleSignal.hpp"
 #include "bleClient/ipcBleStream.h"
 
+#include <deque>
 #include <string>
+#include <vector>
 
 namespace Anki {
 namespace Switchboard { 
@@ -26,7 +28,8 @@ namespace Switchboard {
     BleClient(struct ev_loop* loop)
       : IPCClient(loop)
       , _connectionId(-1)
-      , _stream(nullptr) {
+      , _stream(nullptr)
+      , _congested(false) {
     }
 
     // Types
@@ -61,14 +64,25 @@ namespace Switchboard {
                                         const bool congested);
 
   private:
-    bool Send(uint8_t* msg, size_t length, std::string charUuid);
+    bool Send(uint8_t* msg, size_t length, const std::string& charUuid);
     bool SendPlainText(uint8_t* msg, size_t length);
     bool SendEncrypted(uint8_t* msg, size_t length);
+    void FlushHeldPackets();
 
     virtual void OnPeerClose(const int sockfd);
     
+    // Packets are written without waiting on each other. While the stack reports congestion they
+    // are held here, in order, and written once it clears.
+    struct HeldPacket {
+      std::string charUuid;
+      std::vector<uint8_t> bytes;
+    };
+    static const size_t kMaxHeldPackets = 1024;
+
     int _connectionId;
     IpcBleStream* _stream;
+    bool _congested;
+    std::deque<HeldPacket> _heldPackets;
 
     AdvertisingSignal _advertisingUpdateSignal;
 
@@ -16,16 +16,47 @@ namespace Anki {
 namespace Switchboard {
 
 const uint8_t Anki::Switchboard::IpcBleStream::kMaxPacketSize;
+constexpr std::chrono::seconds Anki::Switchboard::IpcBleStream::kStatsLogInterval;
+
+void IpcBleStream::LogStatsIfDue() {
+  using namespace std::chrono;
+  const steady_clock::time_point now = steady_clock::now();
+  const steady_clock::duration elapsed = now - _statsStartTime;
+  if(elapsed < kStatsLogInterval) {
+    return;
+  }
+
+  const bool hadTraffic = (_stats.packetsSent.count > 0) || (_stats.packetsReceived.count > 0);
+  if(hadTraffic) {
+    const double elapsed_s = duration_cast<duration<double>>(elapsed).count();
+    Log::Write("IpcBleStream throughput over %.1fs: "
+               "encrypt %u msgs %llu B in %lld us, "
+               "send %u pkts %.0f B/s, "
+               "recv %u pkts %.0f B/s, %u msgs",
+               elapsed_s,
+               _stats.encrypted.count, (unsigned long long)_stats.encrypted.bytes,
+               (long long)duration_cast<microseconds>(_stats.encryptTime).count(),
+               _stats.packetsSent.count, _stats.packetsSent.bytes / elapsed_s,
+               _stats.packetsReceived.count, _stats.packetsReceived.bytes / elapsed_s,
+               _stats.messagesReceived.count);
+  }
+
+  _stats = ThroughputStats();
+  _statsStartTime = now;
+}
 
 void IpcBleStream::HandleSendRawPlainText(uint8_t* buffer, size_t size){
+  _stats.packetsSent.Add(size);
   _sendSignal.emit(buffer, (int)size, false);
 }
 
 void IpcBleStream::HandleSendRawEncrypted(uint8_t* buffer, size_t size){
+  _stats.packetsSent.Add(size);
   _sendSignal.emit(buffer, (int)size, true);
 }
 
 void IpcBleStream::HandleReceivePlainText(uint8_t* buffer, size_t size) {
+  _stats.messagesReceived.Add(size);
   if(_encryptedChannelEstablished) {
     INetworkStream::ReceiveEncrypted(buffer, (int)size);
   } else {
@@ -34,6 +65,7 @@ void IpcBleStream::HandleReceivePlainText(uint8_t* buffer, size_t size) {
 }
 
 void IpcBleStream::HandleReceiveEncrypted(uint8_t* buffer, size_t size) {
+  _stats.messagesReceived.Add(size);
   INetworkStream::ReceiveEncrypted(buffer, (int)size);
 }
 
@@ -42,29 +74,37 @@ int IpcBleStream::SendPlainText(uint8_t* bytes, int length) {
     return SendEncrypted(bytes, length);
   } else {
     _bleMessageProtocolPlainText->SendMessage(bytes, (size_t)length);
+    LogStatsIfDue();
   }
   return 0;
 }
 
 int IpcBleStream::SendEncrypted(uint8_t* bytes, int length) {
-  uint8_t* bytesWithExtension = (uint8_t*)malloc(length + crypto_aead_xchacha20poly1305_ietf_ABYTES);
+  // The whole message is encrypted once, then fragmented into packets
+  const size_t maxEncryptedLength = length + crypto_aead_xchacha20poly1305_ietf_ABYTES;
+  if(_encryptBuffer.size() < maxEncryptedLength) {
+    _encryptBuffer.resize(maxEncryptedLength);
+  }
   
   uint64_t encryptedLength = 0;
   
-  int encryptResult = Encrypt(bytes, length, bytesWithExtension, &encryptedLength);
+  const auto encryptStart = std::chrono::steady_clock::now();
+  int encryptResult = Encrypt(bytes, length, _encryptBuffer.data(), &encryptedLength);
+  _stats.encryptTime += std::chrono::steady_clock::now() - encryptStart;
   
   if(encryptResult != ENCRYPTION_SUCCESS) {
-    free(bytesWithExtension);
     return NetworkResult::MsgFailure;
   }
+  _stats.encrypted.Add(length);
   
-  _bleMessageProtocolEncrypted->SendMessage(bytesWithExtension, (size_t)encryptedLength);
+  _bleMessageProtocolEncrypted->SendMessage(_encryptBuffer.data(), (size_t)encryptedLength);
   
-  free(bytesWithExtension);
+  LogStatsIfDue();
   return 0;
 }
 
 void IpcBleStream::ReceivePlainText(uint8_t* bytes, int length) {
+  _stats.packetsReceived.Add(length);
   if(_encryptedChannelEstablished) {
     _bleMessageProtocolEncrypted->ReceiveRawBuffer(bytes, (size_t)length);
   } else {
@@ -73,6 +113,7 @@ void IpcBleStream::ReceivePlainText(uint8_t* bytes, int length) {
 }
 
 void IpcBleStream::ReceiveEncrypted(uint8_t* bytes, int length) {
+  _stats.packetsReceived.Add(length);
   _bleMessageProtocolEncrypted->ReceiveRawBuffer(bytes, (size_t)length);
 }
 
@@ -16,6 +16,9 @@
 #include "switchboardd/INetworkStream.h"
 #include "switchboardd/bleMessageProtocol.h"
 
+#include <chrono>
+#include <vector>
+
 namespace Anki {
 namespace Switchboard {
   class IpcBleStream : public INetworkStream {
@@ -50,6 +53,23 @@ namespace Switchboard {
   private:
     static const uint8_t kMaxPacketSize = 20;
 
+    // Throughput of each stage, logged periodically while there is traffic
+    struct StageStats {
+      uint64_t bytes = 0;
+      uint32_t count = 0;
+      void Add(size_t numBytes) { bytes += numBytes; ++count; }
+    };
+    struct ThroughputStats {
+      StageStats encrypted;
+      StageStats packetsSent;
+      StageStats packetsReceived;
+      StageStats messagesReceived;
+      std::chrono::steady_clock::duration encryptTime = std::chrono::steady_clock::duration::zero();
+    };
+    static constexpr std::chrono::seconds kStatsLogInterval{5};
+
+    void LogStatsIfDue();
+
     void HandleSendRawPlainText(uint8_t* buffer, size_t size);
     void HandleSendRawEncrypted(uint8_t* buffer, size_t size);
     void HandleReceivePlainText(uint8_t* buffer, size_t size);
@@ -64,6 +84,12 @@ namespace Switchboard {
     Signal::SmartHandle _onReceivePlainHandle;
     
     SendSignal _sendSignal;
+
+    // Reused for every encrypted message, rather than allocating one per message
+    std::vector<uint8_t> _encryptBuffer;
+
+    ThroughputStats _stats;
+    std::chrono::steady_clock::time_point _statsStartTime = std::chrono::steady_clock::now();
   };
 } // Switchboard
 } // Anki
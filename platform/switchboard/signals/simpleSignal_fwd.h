@@ -1,16 +1,6 @@
-#ifndef __SIMPLE_SIGNAL_FWD_H__
-#define __SIMPLE_SIGNAL_FWD_H__
+#ifndef __SWITCHBOARD_SIMPLE_SIGNAL_FWD_H__
+#define __SWITCHBOARD_SIMPLE_SIGNAL_FWD_H__
 
-#include <cstddef>
-#include <memory>
+#include "util/signals/simpleSignal_fwd.h"
 
-namespace Signal {
-  
-  namespace Lib {
-    class ScopedHandleContainer;
-  }
-  using SmartHandle = std::shared_ptr<Lib::ScopedHandleContainer>;
-  
-}
-
-#endif // __SIMPLE_SIGNAL_FWD_H__
+#endif // __SWITCHBOARD_SIMPLE_SIGNAL_FWD_H__
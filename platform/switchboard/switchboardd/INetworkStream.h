@@ -16,6 +16,7 @@
 #include "log.h"
 #include "signals/simpleSignal.hpp"
 #include <sodium.h>
+#include <vector>
 
 namespace Anki {
 namespace Switchboard {
@@ -80,17 +81,23 @@ namespace Switchboard {
         return;
       }
       
-      uint8_t* buffer = (uint8_t*)malloc(length);
+      // Decrypt into the pooled buffer. It's taken out of the pool while the message is handled, so a
+      // handler that receives another message gets a buffer of its own
+      std::vector<uint8_t> buffer;
+      buffer.swap(_decryptBuffer);
+      if(buffer.size() < (size_t)length) {
+        buffer.resize(length);
+      }
       
-      // insert decrypted chunk into new buffer
+      // insert decrypted chunk into buffer
       uint64_t msgLength = 0;
-      int decryptStatus = Decrypt(bytes, length, buffer, &msgLength);
+      int decryptStatus = Decrypt(bytes, length, buffer.data(), &msgLength);
       
       if(decryptStatus == ENCRYPTION_SUCCESS) {
-        _receivedEncryptedSignal.emit(buffer, (int)msgLength);
+        _receivedEncryptedSignal.emit(buffer.data(), (int)msgLength);
       }
       
-      free(buffer);
+      buffer.swap(_decryptBuffer);
     }
     
   protected:
@@ -121,8 +128,8 @@ namespace Switchboard {
     ReceivedSignal _receivedEncryptedSignal;
     NotificationSignal _failedDecryptionSignal;
     
-    std::vector<uint8_t*> _buffers;
-    std::vector<int> _bufferSizes;
+    // Reused for every decrypted message, rather than allocating one per message
+    std::vector<uint8_t> _decryptBuffer;
   
     uint8_t _DecryptKey[crypto_kx_SESSIONKEYBYTES];
     uint8_t _EncryptKey[crypto_kx_SESSIONKEYBYTES];
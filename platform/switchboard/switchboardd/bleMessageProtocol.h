@@ -14,6 +14,8 @@
 
 #include <cstdio>
 #include <stdlib.h>
+#include <string.h>
+#include <vector>
 #include "signals/simpleSignal.hpp"
 
 namespace Anki {
@@ -51,7 +53,7 @@ namespace Switchboard {
     std::vector<uint8_t> _buffer;
     
     void Append(uint8_t* buffer, size_t size) {
-      std::copy((buffer + 1), (buffer + 1) + size - 1, std::back_inserter(_buffer));
+      _buffer.insert(_buffer.end(), buffer + 1, buffer + size);
     }
     
     void SendRawMessage(uint8_t multipart, uint8_t* buffer, size_t msgSize) {
@@ -34,6 +34,7 @@
 #include "anki-wifi/wifi.h"
 #include "anki-wifi/exec_command.h"
 #include "auto-test/autoTest.h"
+#include "coretech/messaging/shared/bootStatus.h"
 #include "cutils/properties.h"
 #include "switchboardd/christen.h"
 #include "platform/victorCrashReports/victorCrashReporter.h"
@@ -63,6 +64,8 @@ void Daemon::Start() {
   _taskExecutor = std::make_shared<Anki::TaskExecutor>(_loop);
   _connectionIdManager = std::make_shared<ConnectionIdManager>();
 
+  Anki::Vector::BootStatus::Clear(Anki::Vector::BootMilestone::SwitchboardReady);
+
   // Saved session manager
   int rc = SavedSessionManager::MigrateKeys();
   if (rc) {
@@ -111,6 +114,8 @@ void Daemon::Stop() {
 
   ev_timer_stop(_loop, &_engineTimer);
   ev_timer_stop(_loop, &_handleOtaTimer.timer);
+
+  Anki::Vector::BootStatus::Clear(Anki::Vector::BootMilestone::SwitchboardReady);
 }
 
 void Daemon::OnWifiChanged(bool connected, std::string manufacturerMac) {
@@ -290,6 +295,9 @@ void Daemon::OnConnected(int connId, INetworkStream* stream) {
     Log::Write("Connected to a BLE central.");
     _connectionId = connId;
 
+    // Someone opening the app counts as interacting, which lets the engine's deferred startup work run
+    Anki::Vector::BootStatus::Publish(Anki::Vector::BootMilestone::FirstInteraction);
+
     if(_securePairing == nullptr) {
       _securePairing = std::make_unique<Anki::Switchboard::RtsComms>(stream, _loop, _engineMessagingClient, _gatewayMessagingServer, _tokenClient, _connectionIdManager, _wifiWatcher, _taskExecutor, _isPairing, _isOtaUpdating, _hasCloudOwner);
       _pinHandle = _securePairing->OnUpdatedPinEvent().ScopedSubscribe(std::bind(&Daemon::OnPinUpdated, this, std::placeholders::_1));
@@ -703,6 +711,7 @@ void Daemon::HandleAnkibtdTimer(struct ev_loop* loop, struct ev_timer* w, int re
   if(connected) {
     ev_timer_stop(loop, w);
     Log::Write("Initialization complete.");
+    Anki::Vector::BootStatus::Publish(Anki::Vector::BootMilestone::SwitchboardReady);
   }
 }
 
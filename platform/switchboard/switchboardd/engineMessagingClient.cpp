@@ -32,7 +32,7 @@ using EMessage = Anki::Vector::ExternalInterface::MessageEngineToGame;
 namespace Anki {
 namespace Switchboard {
 
-uint8_t EngineMessagingClient::sMessageData[2048];
+uint8_t EngineMessagingClient::sMessageData[Anki::Messaging::kLocalUdpMaxFrameSize];
 
 EngineMessagingClient::EngineMessagingClient(struct ev_loop* evloop)
 : loop_(evloop)
@@ -72,14 +72,18 @@ void EngineMessagingClient::sEvEngineMessageHandler(struct ev_loop* loop, struct
 
   int recvSize;
   
-  while((recvSize = wData->client->Recv((char*)sMessageData, sizeof(sMessageData))) > kMessageHeaderLength) {
-    // Get message tag, and adjust for header size
-    const uint8_t* msgPayload = (const uint8_t*)&sMessageData[kMessageHeaderLength];
+  while((recvSize = wData->client->Recv((char*)sMessageData, sizeof(sMessageData))) > (int)Anki::Messaging::kLocalUdpFrameHeaderSize) {
+    // Unpack straight out of the receive buffer
+    const uint8_t* msgPayload = nullptr;
+    size_t msgSize = 0;
+    if(!Anki::Messaging::GetLocalUdpFramePayload(sMessageData, recvSize, msgPayload, msgSize) || (msgSize == 0)) {
+      Log::Error("Received message from engine shorter than its size.");
+      continue;
+    }
 
     const EMessageTag messageTag = (EMessageTag)*msgPayload;
 
     EMessage message;
-    uint16_t msgSize = *(uint16_t*)sMessageData;
     size_t unpackedSize = message.Unpack(msgPayload, msgSize);
 
     if(unpackedSize != (size_t)msgSize) {
@@ -196,12 +200,11 @@ void EngineMessagingClient::HandleHasBleKeysRequest() {
 }
 
 void EngineMessagingClient::SendMessage(const GMessage& message) {
-  uint16_t message_size = message.Size();
-  uint8_t buffer[message_size + kMessageHeaderLength];
-  message.Pack(buffer + kMessageHeaderLength, message_size);
-  memcpy(buffer, &message_size, kMessageHeaderLength);
+  const size_t message_size = message.Size();
+  uint8_t buffer[message_size];
+  message.Pack(buffer, message_size);
 
-  _client.Send((char*)buffer, sizeof(buffer));
+  _client.SendFrame(buffer, message_size);
 }
 
 void EngineMessagingClient::SetPairingPin(std::string pin) {
@@ -21,6 +21,7 @@
 #include "ev++.h"
 #include "coretech/messaging/shared/socketConstants.h"
 #include "coretech/messaging/shared/LocalUdpClient.h"
+#include "coretech/messaging/shared/LocalUdpFrame.h"
 #include "clad/externalInterface/messageEngineToGame.h"
 #include "clad/externalInterface/messageGameToEngine.h"
 #include "switchboardd/ISwitchboardCommandClient.h"
@@ -69,8 +70,7 @@ private:
     EngineMessageSignal* signal;
   } _handleEngineMessageTimer;
 
-  static uint8_t sMessageData[2048];
-  static const unsigned int kMessageHeaderLength = 2;
+  static uint8_t sMessageData[Anki::Messaging::kLocalUdpMaxFrameSize];
   const float kEngineMessageFrequency_s = 0.1;
 };
 } // Switchboard
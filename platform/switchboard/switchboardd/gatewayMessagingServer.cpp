@@ -24,8 +24,9 @@ namespace Anki {
 namespace Switchboard {
 
 using namespace Anki::Vector::ExternalComms;
+using namespace Anki::Messaging;
 
-uint8_t GatewayMessagingServer::sMessageData[2048];
+uint8_t GatewayMessagingServer::sMessageData[kLocalUdpMaxFrameSize];
 
 GatewayMessagingServer::GatewayMessagingServer(struct ev_loop* evloop, std::shared_ptr<TaskExecutor> taskExecutor, std::shared_ptr<TokenClient> tokenClient, std::shared_ptr<ConnectionIdManager> connectionIdManager)
 : _tokenClient(tokenClient)
@@ -230,21 +231,19 @@ void GatewayMessagingServer::sEvGatewayMessageHandler(struct ev_loop* loop, stru
   GatewayMessagingServer* self = wData->messagingServer;
   int recvSize;
 
-  while((recvSize = wData->server->Recv((char*)sMessageData, sizeof(sMessageData))) > kMessageHeaderLength) {
-    // Get message tag, and adjust for header size
-    const uint8_t* msgPayload = (const uint8_t*)&sMessageData[kMessageHeaderLength];
+  while((recvSize = wData->server->Recv((char*)sMessageData, sizeof(sMessageData))) > (int)kLocalUdpFrameHeaderSize) {
+    // Unpack straight out of the receive buffer
+    const uint8_t* msgPayload = nullptr;
+    size_t msgSize = 0;
+    if(!GetLocalUdpFramePayload(sMessageData, recvSize, msgPayload, msgSize) || (msgSize == 0)) {
+      // if the size is greater than what we received, than don't try to read
+      Log::Write("GatewayMessagingServer received message from vic-gateway that didn't match its size.");
+      continue;
+    }
 
     const SwitchboardRequestTag messageTag = (SwitchboardRequestTag)*msgPayload;
 
     SwitchboardRequest message;
-    uint16_t msgSize = *(uint16_t*)sMessageData;
-
-    if(msgSize > (sizeof(sMessageData) - sizeof(msgSize))) {
-      // if the size is greater than the buffer we support, than don't try to read
-      Log::Write("GatewayMessagingServer received message from vic-gateway that didn't fit into our buffer.");
-      continue;
-    }
-
     size_t unpackedSize = message.Unpack(msgPayload, msgSize);
 
     if(unpackedSize != (size_t)msgSize) {
@@ -285,12 +284,11 @@ void GatewayMessagingServer::sEvGatewayMessageHandler(struct ev_loop* loop, stru
 
 bool GatewayMessagingServer::SendMessage(const SwitchboardResponse& message) {
   if (_server.HasClient()) {
-    uint16_t message_size = message.Size();
-    uint8_t buffer[message_size + kMessageHeaderLength];
-    message.Pack(buffer + kMessageHeaderLength, message_size);
-    memcpy(buffer, &message_size, kMessageHeaderLength);
+    const size_t message_size = message.Size();
+    uint8_t buffer[message_size];
+    message.Pack(buffer, message_size);
 
-    const ssize_t res = _server.Send((const char*)buffer, sizeof(buffer));
+    const ssize_t res = _server.SendFrame(buffer, message_size);
     if (res < 0) {
       _server.Disconnect();
       return false;
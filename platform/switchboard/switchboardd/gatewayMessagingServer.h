@@ -22,6 +22,7 @@
 #include <signals/simpleSignal.hpp>
 #include "ev++.h"
 #include "coretech/messaging/shared/socketConstants.h"
+#include "coretech/messaging/shared/LocalUdpFrame.h"
 #include "coretech/messaging/shared/LocalUdpServer.h"
 #include "switchboardd/connectionIdManager.h"
 #include "switchboardd/taskExecutor.h"
@@ -84,8 +85,7 @@ private:
     GatewayMessagingServer* messagingServer;
   } _handleGatewayMessageTimer;
 
-  static uint8_t sMessageData[2048];
-  static const unsigned int kMessageHeaderLength = 2;
+  static uint8_t sMessageData[Anki::Messaging::kLocalUdpMaxFrameSize];
   const float kGatewayMessageFrequency_s = 0.1;
 };
 } // Switchboard
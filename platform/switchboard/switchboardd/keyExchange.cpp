@@ -19,6 +19,14 @@
 namespace Anki {
 namespace Switchboard {
 
+namespace {
+  // The robot's own key pair is validated on every connection, but it only changes when it's regenerated, so
+  // remember the last pair that passed rather than doing three more curve25519 operations each time
+  bool sHasValidatedKeys = false;
+  uint8_t sValidatedPublicKey[crypto_kx_PUBLICKEYBYTES];
+  uint8_t sValidatedSecretKey[crypto_kx_SECRETKEYBYTES];
+}
+
 uint8_t* KeyExchange::GenerateKeys() {
   crypto_kx_keypair(_publicKey, _secretKey);
   return _publicKey;
@@ -34,6 +42,12 @@ void KeyExchange::Reset() {
 }
 
 bool KeyExchange::ValidateKeys(uint8_t* publicKey, uint8_t* privateKey) {
+  if(sHasValidatedKeys &&
+     (sodium_memcmp(sValidatedPublicKey, publicKey, sizeof(sValidatedPublicKey)) == 0) &&
+     (sodium_memcmp(sValidatedSecretKey, privateKey, sizeof(sValidatedSecretKey)) == 0)) {
+    return true;
+  }
+
   uint8_t encryptServer[crypto_kx_SESSIONKEYBYTES];
   uint8_t decryptServer[crypto_kx_SESSIONKEYBYTES];
   uint8_t encryptClient[crypto_kx_SESSIONKEYBYTES];
@@ -51,8 +65,16 @@ bool KeyExchange::ValidateKeys(uint8_t* publicKey, uint8_t* privateKey) {
     return false;
   }
 
-  return (memcmp(decryptServer, encryptClient, crypto_kx_SESSIONKEYBYTES) == 0) &&
+  const bool valid = (memcmp(decryptServer, encryptClient, crypto_kx_SESSIONKEYBYTES) == 0) &&
     (memcmp(decryptClient, encryptServer, crypto_kx_SESSIONKEYBYTES) == 0);
+
+  if(valid) {
+    memcpy(sValidatedPublicKey, publicKey, sizeof(sValidatedPublicKey));
+    memcpy(sValidatedSecretKey, privateKey, sizeof(sValidatedSecretKey));
+    sHasValidatedKeys = true;
+  }
+
+  return valid;
 }
 
 std::string KeyExchange::GeneratePin() const {
@@ -107,31 +129,40 @@ void KeyExchange::SetRemotePublicKey(const uint8_t* pubKey) {
   memcpy(_remotePublicKey, pubKey, crypto_kx_PUBLICKEYBYTES);
 }
 
-bool KeyExchange::CalculateSharedKeysServer(const uint8_t* pin) {
-  //
-  // Messages from the robot will be encrypted with a hash that incorporates
-  // a random pin
-  // server_tx (encryptKey) needs to be sha-256'ed
-  // client_rx (client's decrypt key) needs to be sha-256'ed
-  //
-  bool success = crypto_kx_server_session_keys(
-    _decryptKey, _encryptKey, _publicKey, _secretKey, _remotePublicKey) == 0;
-  
+void KeyExchange::MixPinIntoSessionKeys(const uint8_t* pin) {
   // Save tmp version of encryptKey
-  std::vector<uint8_t> tmpEncryptKey(_encryptKey, _encryptKey + sizeof(_encryptKey));
+  uint8_t tmpEncryptKey[crypto_kx_SESSIONKEYBYTES];
+  memcpy(tmpEncryptKey, _encryptKey, sizeof(tmpEncryptKey));
 
-  // Save tmp version of encryptKey
-  std::vector<uint8_t> tmpDecryptKey(_decryptKey, _decryptKey + sizeof(_decryptKey));
+  // Save tmp version of decryptKey
+  uint8_t tmpDecryptKey[crypto_kx_SESSIONKEYBYTES];
+  memcpy(tmpDecryptKey, _decryptKey, sizeof(tmpDecryptKey));
   
   // Hash mix of pin and encryptKey to form new encryptKey
   crypto_generichash(_encryptKey, crypto_kx_SESSIONKEYBYTES, 
-    tmpEncryptKey.data(), crypto_kx_SESSIONKEYBYTES, 
+    tmpEncryptKey, crypto_kx_SESSIONKEYBYTES, 
     pin, _numPinDigits);
 
   // Hash mix of pin and decryptKey to form new decryptKey
   crypto_generichash(_decryptKey, crypto_kx_SESSIONKEYBYTES, 
-    tmpDecryptKey.data(), crypto_kx_SESSIONKEYBYTES, 
+    tmpDecryptKey, crypto_kx_SESSIONKEYBYTES, 
     pin, _numPinDigits);
+
+  sodium_memzero(tmpEncryptKey, sizeof(tmpEncryptKey));
+  sodium_memzero(tmpDecryptKey, sizeof(tmpDecryptKey));
+}
+
+bool KeyExchange::CalculateSharedKeysServer(const uint8_t* pin) {
+  //
+  // Messages from the robot will be encrypted with a hash that incorporates
+  // a random pin
+  // server_tx (encryptKey) needs to be sha-256'ed
+  // client_rx (client's decrypt key) needs to be sha-256'ed
+  //
+  bool success = crypto_kx_server_session_keys(
+    _decryptKey, _encryptKey, _publicKey, _secretKey, _remotePublicKey) == 0;
+  
+  MixPinIntoSessionKeys(pin);
   
   return success;
 }
@@ -146,21 +177,7 @@ bool KeyExchange::CalculateSharedKeysClient(const uint8_t* pin) {
   bool success = crypto_kx_client_session_keys(
     _decryptKey, _encryptKey, _publicKey, _secretKey, _remotePublicKey) == 0;
   
-  // Save tmp version of encryptKey
-  std::vector<uint8_t> tmpEncryptKey(_encryptKey, _encryptKey + sizeof(_encryptKey));
-
-  // Save tmp version of encryptKey
-  std::vector<uint8_t> tmpDecryptKey(_decryptKey, _decryptKey + sizeof(_decryptKey));
-  
-  // Hash mix of pin and encryptKey to form new encryptKey
-  crypto_generichash(_encryptKey, crypto_kx_SESSIONKEYBYTES, 
-    tmpEncryptKey.data(), crypto_kx_SESSIONKEYBYTES, 
-    pin, _numPinDigits);
-
-  // Hash mix of pin and decryptKey to form new decryptKey
-  crypto_generichash(_decryptKey, crypto_kx_SESSIONKEYBYTES, 
-    tmpDecryptKey.data(), crypto_kx_SESSIONKEYBYTES, 
-    pin, _numPinDigits);
+  MixPinIntoSessionKeys(pin);
   
   return success;
 }
@@ -76,6 +76,8 @@ namespace Switchboard {
     bool ValidateKeys(uint8_t* publicKey, uint8_t* privateKey);
     
   private:
+    void MixPinIntoSessionKeys(const uint8_t* pin);
+
     // Variables
     uint8_t _secretKey [crypto_kx_SECRETKEYBYTES];   // our secret key
     uint8_t _decryptKey [crypto_kx_SESSIONKEYBYTES]; // rx
@@ -951,13 +951,13 @@ void RtsHandlerV5::SendWifiConnectResult(Wifi::ConnectWifiResult result) {
   SendRtsMessage<RtsWifiConnectResponse_3>(wifiState.ssid, wifiState.connState, (uint8_t)result);
 }
 
-void RtsHandlerV5::SendFile(uint32_t fileId, std::vector<uint8_t> fileBytes) {
+void RtsHandlerV5::SendFile(uint32_t fileId, const std::vector<uint8_t>& fileBytes) {
   if(!AssertState(RtsCommsType::Encrypted)) {
     return;
   }
 
   // Send File
-  const size_t chunkSize = 256; // can't be more than 2^16
+  const size_t chunkSize = kFileChunkSize;
   size_t fileSizeBytes = fileBytes.size();
   uint8_t status = 0; // not sure if we need status byte, but reserving so I don't regret ~PRA
 
@@ -967,11 +967,10 @@ void RtsHandlerV5::SendFile(uint32_t fileId, std::vector<uint8_t> fileBytes) {
     size_t msgSize = remaining >= chunkSize? chunkSize : remaining;
     size_t bytesWritten = fileSizeBytes - remaining;
 
-    std::vector<uint8_t> dataChunk;
     auto fileIter = fileBytes.begin() + bytesWritten;
-    std::copy(fileIter, fileIter + msgSize, back_inserter(dataChunk));
+    _fileChunkBuffer.assign(fileIter, fileIter + msgSize);
 
-    SendRtsMessage<RtsFileDownload>(status, fileId, bytesWritten + msgSize, fileSizeBytes, dataChunk);
+    SendRtsMessage<RtsFileDownload>(status, fileId, bytesWritten + msgSize, fileSizeBytes, _fileChunkBuffer);
 
     remaining -= msgSize;
   }
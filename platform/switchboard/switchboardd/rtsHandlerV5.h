@@ -80,7 +80,7 @@ private:
   void SendWifiConnectResult(Wifi::ConnectWifiResult result);
   void SendWifiAccessPointResponse(bool success, std::string ssid, std::string pw);
   void SendStatusResponse();
-  void SendFile(uint32_t fileId, std::vector<uint8_t> fileBytes);
+  void SendFile(uint32_t fileId, const std::vector<uint8_t>& fileBytes);
 
   void HandleMessageReceived(uint8_t* bytes, uint32_t length);
   void HandleDecryptionFailed();
@@ -119,6 +119,9 @@ private:
   const uint8_t kWifiConnectInterval_s = 1;
   const uint8_t kMinMessageSize = 2;
   const uint8_t kSdkRequestIdSize = 32;
+  // Every message is encrypted and authenticated on its own, so bigger chunks mean fewer of them to a file.
+  // The app appends whatever size it gets
+  const size_t kFileChunkSize = 1024; // can't be more than 2^16
   
   std::string _pin;
   uint8_t _challengeAttempts;
@@ -153,6 +156,10 @@ private:
   std::vector<std::shared_ptr<SafeHandle>> _handles;
   std::unordered_map<std::string, std::string> _sdkRequestIds;
 
+  // Reused for every message packed by SendRtsMessage, and for the chunks of a file being sent
+  std::vector<uint8_t> _messageBuffer;
+  std::vector<uint8_t> _fileChunkBuffer;
+
   //
   // V3 Request to Listen for
   //
@@ -215,13 +222,15 @@ private:
   int SendRtsMessage(Args&&... args) {
     Anki::Vector::ExternalComms::ExternalComms msg = Anki::Vector::ExternalComms::ExternalComms(
       Anki::Vector::ExternalComms::RtsConnection(Anki::Vector::ExternalComms::RtsConnection_5(T(std::forward<Args>(args)...))));
-    std::vector<uint8_t> messageData(msg.Size());
-    const size_t packedSize = msg.Pack(messageData.data(), msg.Size());
+    if(_messageBuffer.size() < msg.Size()) {
+      _messageBuffer.resize(msg.Size());
+    }
+    const size_t packedSize = msg.Pack(_messageBuffer.data(), msg.Size());
 
     if(_type == RtsCommsType::Unencrypted) {
-      return _stream->SendPlainText(messageData.data(), packedSize);
+      return _stream->SendPlainText(_messageBuffer.data(), packedSize);
     } else if(_type == RtsCommsType::Encrypted) {
-      return _stream->SendEncrypted(messageData.data(), packedSize);
+      return _stream->SendEncrypted(_messageBuffer.data(), packedSize);
     } else {
       Log::Write("Tried to send clad message when state was already set back to RAW.");
     }
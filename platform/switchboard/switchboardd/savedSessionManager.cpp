@@ -30,6 +30,10 @@ const uint32_t SavedSessionManager::kMagicVersionNumber = 2; // MAGIC number tha
 const uint32_t SavedSessionManager::kInvalidVersionNumber = (uint32_t) -1;
 const char* SavedSessionManager::kPrefix = "ANKIBITS";
 
+std::mutex SavedSessionManager::sCacheMutex;
+bool SavedSessionManager::sHasCachedKeys = false;
+RtsKeys SavedSessionManager::sCachedKeys;
+
 int SavedSessionManager::MigrateKeys() {
   // If we can successfully load data from kRtsKeyDataFile, then migration is complete
   RtsKeys rtsKeys = LoadRtsKeys();
@@ -142,7 +146,19 @@ RtsKeys SavedSessionManager::LoadRtsKeysFactory() {
 }
 
 RtsKeys SavedSessionManager::LoadRtsKeys() {
-  return LoadRtsKeysFromFile(kRtsKeyDataFile, SIZE_MAX);
+  std::lock_guard<std::mutex> lock(sCacheMutex);
+  if (sHasCachedKeys) {
+    return sCachedKeys;
+  }
+
+  RtsKeys keys = LoadRtsKeysFromFile(kRtsKeyDataFile, SIZE_MAX);
+
+  // Missing or invalid data isn't cached, so it keeps being retried from the file until something valid is saved
+  if (keys.keys.version == kMagicVersionNumber) {
+    sCachedKeys = keys;
+    sHasCachedKeys = true;
+  }
+  return keys;
 }
 
 int SavedSessionManager::SaveRtsKeysToFile(RtsKeys& saveData,
@@ -228,8 +244,17 @@ int SavedSessionManager::SaveRtsKeys(RtsKeys& saveData) {
   if (rename(tmpFileName.c_str(), kRtsKeyDataFile.c_str())) {
     Log::Error("Failed to rename %s to %s", tmpFileName.c_str(), kRtsKeyDataFile.c_str());
     Anki::Util::FileUtils::DeleteFile(tmpFileName);
+
+    // Don't know what's on disk any more, so the next load goes to the file
+    std::lock_guard<std::mutex> lock(sCacheMutex);
+    sHasCachedKeys = false;
     return -3;
   }
+
+  // SaveRtsKeysToFile has brought saveData into line with what was written
+  std::lock_guard<std::mutex> lock(sCacheMutex);
+  sCachedKeys = saveData;
+  sHasCachedKeys = true;
   return 0;
 }
 
@@ -16,6 +16,7 @@
 #include <string>
 #include <stdlib.h>
 #include <fstream>
+#include <mutex>
 #include <vector>
 
 #pragma once
@@ -64,6 +65,12 @@ private:
   static RtsKeys LoadRtsKeysFactory();
   static int ClearRtsKeysFactory(const std::string& name);
 
+  // The saved sessions are only ever written through SaveRtsKeys, so after the first good load (or any save)
+  // they're served from memory and reconnecting doesn't wait on flash
+  static std::mutex sCacheMutex;
+  static bool sHasCachedKeys;
+  static RtsKeys sCachedKeys;
+
   static const std::string kRtsKeyPath;
   static const std::string kRtsKeyDataFile;
   static const uint8_t kMaxNumberClients;
@@ -7,7 +7,7 @@
 *
 */
 
-#include "platform/robotLogUploader/robotLogDumper.h"
+#include "platform/robotLogUploader/robotLogCollector.h"
 #include "platform/robotLogUploader/robotLogUploader.h"
 
 #include "json/json.h"
@@ -17,7 +17,7 @@
 #include "util/logging/victorLogger.h"
 #include "util/string/stringUtils.h"
 
-#include <list>
+#include <vector>
 
 #define LOG_PROCNAME "vic-log-upload"
 #define LOG_CHANNEL "VicLogUpload"
@@ -29,7 +29,9 @@ static void Error(const std::string & s)
 
 static void Usage(FILE * f)
 {
-  fprintf(f, "Usage: %s [-h] file\n", LOG_PROCNAME);
+  fprintf(f, "Usage: %s [-h] file [file ...]\n", LOG_PROCNAME);
+  fprintf(f, "       %s -c\n", LOG_PROCNAME);
+  fprintf(f, "  -c  collect new system log lines into segments to be uploaded later\n");
 }
 
 //
@@ -46,6 +48,26 @@ static void Report(const std::string & status, const std::string & value)
   fprintf(stdout, "%s", writer.write(json).c_str());
 }
 
+//
+// Report urls of a multi-file upload, plus an error if the batch stopped early
+//
+static void Report(const std::vector<std::string> & urls, const std::string & error)
+{
+  Json::Value json;
+  json["result"]["success"] = Json::Value(Json::arrayValue);
+  for (const auto & url : urls) {
+    json["result"]["success"].append(url);
+  }
+  if (!error.empty()) {
+    LOG_INFO("VicLogUpload.Report", "result[error] = %s", error.c_str());
+    json["result"]["error"] = error;
+  }
+  LOG_INFO("VicLogUpload.Report", "result[success] = %zu urls", urls.size());
+
+  Json::StyledWriter writer;
+  fprintf(stdout, "%s", writer.write(json).c_str());
+}
+
 int main(int argc, const char * argv[])
 {
   using namespace Anki;
@@ -61,13 +83,18 @@ int main(int argc, const char * argv[])
   CrashReporter crashReporter(LOG_PROCNAME);
 
   // Process arguments
-  std::list<std::string> paths;
+  std::vector<std::string> paths;
+  bool collect = false;
   for (int i = 1; i < argc; ++i) {
     const std::string & arg = argv[i];
     if (arg == "-h" || arg == "--help") {
       Usage(stdout);
       return 0;
     }
+    if (arg == "-c") {
+      collect = true;
+      continue;
+    }
     if (arg[0] == '-') {
       Usage(stderr);
       return 1;
@@ -75,25 +102,52 @@ int main(int argc, const char * argv[])
     paths.push_back(arg);
   }
 
+  // Run periodically, so a later upload has little left to compress
+  if (collect && paths.empty()) {
+    RobotLogCollector logCollector;
+    if (logCollector.Collect() != RESULT_OK) {
+      Report("error", "Unable to collect logs");
+      return 1;
+    }
+    Report("success", std::to_string(logCollector.GetPendingSegments().size()));
+    return 0;
+  }
+
   // Validate arguments
-  if (paths.size() != 1) {
+  if (collect || paths.empty()) {
     Error("Invalid arguments");
     Usage(stderr);
     return 1;
   }
 
   // Do the thing
-  const std::string & path = paths.front();
   RobotLogUploader logUploader;
-  std::string url;
 
-  const Result result = logUploader.Upload(path, url);
+  if (paths.size() == 1) {
+    const std::string & path = paths.front();
+    std::string url;
+
+    const Result result = logUploader.Upload(path, url);
+    if (result != RESULT_OK) {
+      LOG_ERROR("VicLogUpload", "Unable to upload file %s (error %d)", path.c_str(), result);
+      Report("error", "Unable to upload file");
+      return 1;
+    }
+
+    Report("success", url);
+    return 0;
+  }
+
+  // Several files share one connection to the log collector
+  std::vector<std::string> urls;
+  const Result result = logUploader.Upload(paths, urls);
   if (result != RESULT_OK) {
+    const std::string & path = paths[urls.size()];
     LOG_ERROR("VicLogUpload", "Unable to upload file %s (error %d)", path.c_str(), result);
-    Report("error", "Unable to upload file");
+    Report(urls, "Unable to upload file " + path);
     return 1;
   }
 
-  Report("success", url);
+  Report(urls, "");
 
 }
@@ -17,8 +17,10 @@
 #include "util/logging/DAS.h"
 
 #if (defined(VICOS) && defined(USE_GOOGLE_BREAKPAD))
+#include <client/linux/crash_generation/crash_generation_server.h>
 #include <client/linux/handler/exception_handler.h>
 #include <client/linux/handler/minidump_descriptor.h>
+#include <client/linux/minidump_writer/minidump_writer.h>
 #include "util/string/stringUtils.h"
 
 #include <chrono>
@@ -26,9 +28,17 @@
 #include <fstream>
 #include <iomanip>
 #include <fcntl.h>
+#include <poll.h>
 #include <unistd.h>
 #include <string.h>
+#include <thread>
+#include <sys/prctl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <zlib.h>
 #endif
 
 namespace GoogleBreakpad {
@@ -46,6 +56,12 @@ std::string tmpDumpPath;
 static int fd = -1;
 static google_breakpad::ExceptionHandler* exceptionHandler;
 
+// Out-of-process dumping: the crash dump helper's pid, our end of breakpad's report channel, and the write end of a
+// pipe the helper watches to know when we've gone away
+static pid_t helperPid = -1;
+static int helperClientFd = -1;
+static int helperLifelineFd = -1;
+
 sighandler_t gSavedQuitHandler = nullptr;
 
 constexpr const char* kRobotVersionFile = "/anki/etc/version";
@@ -82,6 +98,15 @@ const std::string & GetDumpDirectory()
   return dump_directory;
 }
 
+//
+// Where this service's crash dump helper writes raw dumps before compressing them into the crash report
+// directory, so nothing picks up a dump that's still being written
+//
+std::string GetPendingDumpDirectory()
+{
+  return GetDumpDirectory() + "-pending/" + dumpTag;
+}
+
 //
 // Generate unique dump name for given prefix
 //
@@ -157,6 +182,311 @@ bool DumpCallback(const google_breakpad::MinidumpDescriptor& descriptor,
   return false;
 }
 
+//
+// Gzip src into a new file at dst
+//
+bool CompressFile(const std::string & src, const std::string & dst)
+{
+  const int srcFd = open(src.c_str(), O_RDONLY | O_CLOEXEC);
+  if (srcFd < 0) {
+    return false;
+  }
+  const int dstFd = open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+  gzFile gz = (dstFd >= 0 ? gzdopen(dstFd, "wb") : nullptr);
+  if (gz == nullptr) {
+    if (dstFd >= 0) {
+      close(dstFd);
+    }
+    close(srcFd);
+    return false;
+  }
+
+  bool ok = true;
+  char buffer[64*1024];
+  ssize_t numRead = 0;
+  while ((numRead = read(srcFd, buffer, sizeof(buffer))) > 0) {
+    if (gzwrite(gz, buffer, (unsigned) numRead) != numRead) {
+      ok = false;
+      break;
+    }
+  }
+  ok &= (numRead == 0);
+  ok &= (gzclose(gz) == Z_OK);
+  close(srcFd);
+  return ok;
+}
+
+//
+// Move a raw dump written by the crash dump helper into the crash report directory
+//
+void StoreDump(const std::string & rawDumpPath)
+{
+  const std::string & dump_name = GetDumpName(dumpTag);
+  const std::string & dump_path = GetDumpDirectory() + "/" + dump_name + ".gz";
+  const std::string & tmp_path = dump_path + "~";
+
+  std::string stored_path = dump_path;
+  if (CompressFile(rawDumpPath, tmp_path)) {
+    rename(tmp_path.c_str(), dump_path.c_str());
+    unlink(rawDumpPath.c_str());
+  } else {
+    // An uncompressed dump is still better than none
+    LOG_WARNING("GoogleBreakpad.StoreDump", "Unable to compress %s", rawDumpPath.c_str());
+    unlink(tmp_path.c_str());
+    stored_path = GetDumpDirectory() + "/" + dump_name;
+    rename(rawDumpPath.c_str(), stored_path.c_str());
+  }
+
+  LOG_INFO("GoogleBreakpad.StoreDump", "Dump path: '%s'", stored_path.c_str());
+
+  // Report the crash to DAS
+  DASMSG(robot_crash, "robot.crash", "Robot service crash");
+  DASMSG_SET(s1, dumpTag.c_str(), "Service name");
+  DASMSG_SET(s2, dump_name.c_str(), "Crash name");
+  DASMSG_SEND_ERROR();
+
+  // Flush logs to file system, see DumpCallback
+  sync();
+
+  // Capture recent log messages
+  DumpLogMessages(stored_path);
+}
+
+//
+// Read whole lines of dump paths from the pipe and store each dump. Returns false once the pipe is closed.
+//
+bool StoreReadyDumps(int pipeFd, std::string & partialLine)
+{
+  char buffer[1024];
+  const ssize_t numRead = read(pipeFd, buffer, sizeof(buffer));
+  if (numRead < 0 && errno == EINTR) {
+    return true;
+  }
+  if (numRead <= 0) {
+    return false;
+  }
+  partialLine.append(buffer, (size_t) numRead);
+  size_t end = 0;
+  while ((end = partialLine.find('\n')) != std::string::npos) {
+    StoreDump(partialLine.substr(0, end));
+    partialLine.erase(0, end + 1);
+  }
+  return true;
+}
+
+//
+// Runs on its own thread in the crash dump helper, at low priority so compressing doesn't hold up the restarted
+// service. Dump paths arrive on the pipe, which is closed when the helper is done.
+//
+void RunDumpStorage(int pipeFd)
+{
+  setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), 10);
+
+  // Anything a previous helper didn't get to. Recent ones may still be in the hands of the helper of the instance
+  // that just crashed, which is allowed to finish
+  constexpr long kAbandonedDumpAge_s = 60;
+  const long now_s = (long) time(nullptr);
+  for (const auto & path : Anki::Util::FileUtils::FilesInDirectory(GetPendingDumpDirectory(), true)) {
+    if (now_s - Anki::Util::FileUtils::GetFileLastModificationTime(path) >= kAbandonedDumpAge_s) {
+      StoreDump(path);
+    }
+  }
+
+  std::string partialLine;
+  while (StoreReadyDumps(pipeFd, partialLine)) {
+  }
+  close(pipeFd);
+}
+
+//
+// Receive a dump request from breakpad's CrashGenerationClient in the crashing process: the crash context, the
+// crashing pid (from the socket credentials) and a pipe to close once it may carry on crashing. Writes the dump with
+// the same options as the in-process path, then lets the crashed process go. Returns the path written, or empty.
+//
+std::string HandleDumpRequest(int serverFd)
+{
+  google_breakpad::ExceptionHandler::CrashContext crashContext;
+  struct iovec iov;
+  iov.iov_base = &crashContext;
+  iov.iov_len = sizeof(crashContext);
+
+  char control[CMSG_SPACE(sizeof(int)) + CMSG_SPACE(sizeof(struct ucred))];
+  struct msghdr msg;
+  memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control;
+  msg.msg_controllen = sizeof(control);
+
+  const ssize_t msgSize = recvmsg(serverFd, &msg, 0);
+
+  pid_t crashingPid = -1;
+  int signalFd = -1;
+  for (struct cmsghdr* hdr = CMSG_FIRSTHDR(&msg); hdr != nullptr; hdr = CMSG_NXTHDR(&msg, hdr)) {
+    if (hdr->cmsg_level != SOL_SOCKET) {
+      continue;
+    }
+    if (hdr->cmsg_type == SCM_RIGHTS) {
+      const int numFds = (int) ((hdr->cmsg_len - CMSG_LEN(0)) / sizeof(int));
+      const int* fds = reinterpret_cast<const int*>(CMSG_DATA(hdr));
+      for (int i = 0; i < numFds; ++i) {
+        if (signalFd < 0) {
+          signalFd = fds[i];
+        } else {
+          close(fds[i]);
+        }
+      }
+    } else if (hdr->cmsg_type == SCM_CREDENTIALS) {
+      const struct ucred* cred = reinterpret_cast<const struct ucred*>(CMSG_DATA(hdr));
+      crashingPid = cred->pid;
+    }
+  }
+
+  std::string path;
+  if (msgSize == (ssize_t) sizeof(crashContext) && crashingPid > 0 && signalFd >= 0) {
+    path = GetPendingDumpDirectory() + "/" + dumpTag + "-" + std::to_string(crashingPid) + "-" +
+           GetDateTimeString() + ".dmp";
+    const int dumpFd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    const bool ok = (dumpFd >= 0) &&
+                    google_breakpad::WriteMinidump(dumpFd, crashingPid, &crashContext, sizeof(crashContext),
+                                                   false, 0, true);
+    if (dumpFd >= 0) {
+      close(dumpFd);
+    }
+    if (!ok) {
+      LOG_ERROR("GoogleBreakpad.HandleDumpRequest", "Unable to write minidump %s", path.c_str());
+      unlink(path.c_str());
+      path.clear();
+    }
+  } else if (msgSize >= 0) {
+    LOG_ERROR("GoogleBreakpad.HandleDumpRequest", "Bad dump request (%zd bytes, pid %d, fd %d)",
+              msgSize, crashingPid, signalFd);
+  }
+
+  // Closing the pipe is the crashed process's signal to carry on
+  if (signalFd >= 0) {
+    close(signalFd);
+  }
+  return path;
+}
+
+//
+// Main of the crash dump helper process. A crashing process only captures its state and waits for this to write
+// the dump, which it does while ptracing it; compressing and storing happen afterwards on a separate thread.
+// Exits once the lifeline closes, which happens when the process we're serving uninstalls, exits or dies.
+//
+[[noreturn]] void RunCrashDumpHelper(int serverFd, int lifelineFd)
+{
+  prctl(PR_SET_NAME, "vic-crashdump", 0, 0, 0);
+
+  int readyPipe[2];
+  if (pipe2(readyPipe, O_CLOEXEC) != 0) {
+    LOG_ERROR("GoogleBreakpad.RunCrashDumpHelper", "Unable to create pipe (errno %d)", errno);
+    _exit(EXIT_FAILURE);
+  }
+  std::thread storageThread(RunDumpStorage, readyPipe[0]);
+
+  while (true) {
+    struct pollfd fds[2];
+    fds[0].fd = serverFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = lifelineFd;
+    fds[1].events = POLLIN;
+    const int n = poll(fds, 2, -1);
+    if (n < 0 && errno == EINTR) {
+      continue;
+    }
+    if (n < 0) {
+      break;
+    }
+    if (fds[0].revents & POLLIN) {
+      const std::string & path = HandleDumpRequest(serverFd);
+      if (!path.empty()) {
+        const std::string & line = path + "\n";
+        (void) write(readyPipe[1], line.c_str(), line.size());
+      }
+    }
+    if (fds[1].revents & (POLLIN | POLLHUP | POLLERR)) {
+      break;
+    }
+  }
+
+  // Let the storage thread finish whatever it has
+  close(readyPipe[1]);
+  storageThread.join();
+
+  // Skip the static destructors and atexit handlers we got from the process we forked from
+  _exit(EXIT_SUCCESS);
+}
+
+//
+// Fork the crash dump helper. Returns our end of the report channel to hand to breakpad, or -1 if the helper
+// couldn't be started.
+//
+int StartCrashDumpHelper()
+{
+  Anki::Util::FileUtils::CreateDirectory(GetPendingDumpDirectory());
+
+  int serverFd = -1;
+  int clientFd = -1;
+  if (!google_breakpad::CrashGenerationServer::CreateReportChannel(&serverFd, &clientFd)) {
+    LOG_ERROR("GoogleBreakpad.StartCrashDumpHelper", "Unable to create report channel");
+    return -1;
+  }
+
+  int lifeline[2];
+  if (pipe2(lifeline, O_CLOEXEC) != 0) {
+    LOG_ERROR("GoogleBreakpad.StartCrashDumpHelper", "Unable to create lifeline (errno %d)", errno);
+    close(serverFd);
+    close(clientFd);
+    return -1;
+  }
+
+  const pid_t pid = fork();
+  if (pid < 0) {
+    LOG_ERROR("GoogleBreakpad.StartCrashDumpHelper", "Unable to fork (errno %d)", errno);
+    close(serverFd);
+    close(clientFd);
+    close(lifeline[0]);
+    close(lifeline[1]);
+    return -1;
+  }
+
+  if (pid == 0) {
+    close(clientFd);
+    close(lifeline[1]);
+    RunCrashDumpHelper(serverFd, lifeline[0]);
+  }
+
+  close(serverFd);
+  close(lifeline[0]);
+
+  // With yama, only ancestors may ptrace by default, and the helper is our child
+#ifdef PR_SET_PTRACER
+  prctl(PR_SET_PTRACER, pid, 0, 0, 0);
+#endif
+
+  helperPid = pid;
+  helperLifelineFd = lifeline[1];
+  return clientFd;
+}
+
+void StopCrashDumpHelper()
+{
+  if (helperLifelineFd >= 0) {
+    (void) close(helperLifelineFd);
+    helperLifelineFd = -1;
+  }
+  if (helperClientFd >= 0) {
+    (void) close(helperClientFd);
+    helperClientFd = -1;
+  }
+  if (helperPid > 0) {
+    (void) waitpid(helperPid, nullptr, 0);
+    helperPid = -1;
+  }
+}
+
 } // anon namespace
 
 static void QuitHandler(int signum)
@@ -181,10 +511,18 @@ void InstallGoogleBreakpad(const char* filenamePrefix)
 
   Anki::Util::FileUtils::CreateDirectory(dump_directory);
 
-  fd = open(tmpDumpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_EXCL, 0600);
-  google_breakpad::MinidumpDescriptor descriptor(fd);
-  descriptor.set_sanitize_stacks(true);
-  exceptionHandler = new google_breakpad::ExceptionHandler(descriptor, NULL, DumpCallback, NULL, true, -1);
+  // Hand dump writing to a helper process, so a crash costs this process only the time to capture its state.
+  // If the helper can't be started, write the dump from the signal handler as before.
+  helperClientFd = StartCrashDumpHelper();
+  if (helperClientFd >= 0) {
+    google_breakpad::MinidumpDescriptor descriptor(GetPendingDumpDirectory());
+    exceptionHandler = new google_breakpad::ExceptionHandler(descriptor, NULL, NULL, NULL, true, helperClientFd);
+  } else {
+    fd = open(tmpDumpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_EXCL, 0600);
+    google_breakpad::MinidumpDescriptor descriptor(fd);
+    descriptor.set_sanitize_stacks(true);
+    exceptionHandler = new google_breakpad::ExceptionHandler(descriptor, NULL, DumpCallback, NULL, true, -1);
+  }
 
   gSavedQuitHandler = signal(SIGQUIT, QuitHandler);
 }
@@ -195,6 +533,7 @@ void UnInstallGoogleBreakpad()
 
   delete exceptionHandler;
   exceptionHandler = nullptr;
+  StopCrashDumpHelper();
   if (fd >= 0) {
     (void) close(fd);
     fd = -1;
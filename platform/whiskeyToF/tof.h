@@ -16,6 +16,9 @@
 #include "coretech/common/shared/types.h"
 #include "clad/types/tofTypes.h"
 
+#include <functional>
+#include <vector>
+
 namespace webots {
   class Supervisor;
 }
@@ -47,6 +50,22 @@ public:
   // Data is only updated while ranging is enabled
   RangeDataRaw GetData(bool& hasDataUpdatedSinceLastCall);
 
+  // A single ranging measurement. The sensor measures one ROI at a time while scanning, so each
+  // frame is the reading from one ROI (data.roi) along with when it was read
+  struct RangeFrame
+  {
+    // std::chrono::steady_clock time the reading was taken at
+    uint64_t timestamp_ms = 0;
+    RangingData data;
+  };
+
+  // Number of frames kept between calls to GetNewFrames. Older frames are dropped first
+  static constexpr size_t kMaxBufferedFrames = 32;
+
+  // Replaces the contents of frames with every frame read since the last call, oldest first
+  // Like GetData, frames are only produced while ranging is enabled
+  void GetNewFrames(std::vector<RangeFrame>& frames);
+
   enum class CommandResult
   {
     Success = 0,
@@ -69,6 +88,17 @@ public:
   // Stop ranging
   int StopRanging(const CommandCallback& callback);
 
+  // Number of ROIs in the grid, and a mask with all of them set
+  static constexpr int kNumRois = 16;
+  static constexpr uint16_t kAllRois = 0xFFFF;
+
+  // Request that only the ROIs whose bits are set in roiMask (bit i is ROI i) be ranged, so that each
+  // of them is measured more often. The ROIs that are left out keep their last reading in GetData
+  int SetActiveRois(uint16_t roiMask, const CommandCallback& callback);
+
+  // The ROIs currently being ranged (or about to be, once a SetActiveRois request is processed)
+  uint16_t GetActiveRois() const;
+
   // Whether or not the device is actively ranging
   bool IsRanging() const;
 
@@ -140,10 +140,16 @@ int close_dev(VL53L1_Dev_t* dev)
 
 /// Setup grid of ROIs for scanning
 int setup_roi_grid(VL53L1_Dev_t* dev, const int rows, const int cols)
+{
+  return setup_roi_subset(dev, rows, cols, 0xFFFF, nullptr);
+}
+
+/// Setup only some of the cells of a grid of ROIs for scanning
+int setup_roi_subset(VL53L1_Dev_t* dev, const int rows, const int cols, const uint16_t roiMask, uint8_t* gridIndices)
 {
   VL53L1_RoiConfig_t roiConfig;
   int i, r, c;
-  const int n_roi = rows*cols;
+  const int n_grid = rows*cols;
   const int row_step = SPAD_ROWS / rows;
   const int col_step = SPAD_COLS / cols;
 
@@ -171,27 +177,45 @@ int setup_roi_grid(VL53L1_Dev_t* dev, const int rows, const int cols)
     return -1;
   }
   
-  if (n_roi > VL53L1_MAX_USER_ZONES)
+  if (n_grid > VL53L1_MAX_USER_ZONES)
   {
     LOG_ERROR("ToF.setup_roi_grid", "%drows * %dcols = %d > %d max user zones",
-              rows, cols, n_roi, VL53L1_MAX_USER_ZONES);
+              rows, cols, n_grid, VL53L1_MAX_USER_ZONES);
     return -1;
   }
 
+  // The sensor numbers ROIs in the order they are configured, so skipping cells of the grid
+  // changes which cell each RoiNumber refers to
   i = 0;
   for (r=0; r<rows; ++r)
   {
     for (c=0; c<cols; ++c)
     {
+      const int gridIndex = (r * cols) + c;
+      if ((roiMask & (1 << gridIndex)) == 0)
+      {
+        continue;
+      }
+
       roiConfig.UserRois[i].TopLeftX = c * col_step;
       roiConfig.UserRois[i].TopLeftY = ((r+1) * row_step) - 1;
       roiConfig.UserRois[i].BotRightX = ((c+1) * col_step) - 1;
       roiConfig.UserRois[i].BotRightY = r * row_step;
+      if (gridIndices != nullptr)
+      {
+        gridIndices[i] = gridIndex;
+      }
       ++i;
     }
   }
 
-  roiConfig.NumberOfRoi = n_roi;
+  if (i == 0)
+  {
+    LOG_ERROR("ToF.setup_roi_subset", "ROI mask 0x%04x selects none of the %d ROIs", roiMask, n_grid);
+    return -1;
+  }
+
+  roiConfig.NumberOfRoi = i;
   
   return VL53L1_SetROI(dev, &roiConfig);
 }
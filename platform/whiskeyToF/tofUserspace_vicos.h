@@ -28,6 +28,11 @@ int setup(VL53L1_Dev_t* dev);
 // Apply a rows x cols roi grid to the device (for multizone ranging)
 int setup_roi_grid(VL53L1_Dev_t* dev, const int rows, const int cols);
 
+// Apply only the cells of a rows x cols roi grid whose bits are set in roiMask (bit r*cols + c).
+// If gridIndices is not null it is filled with the grid cell of each of the applied ROIs,
+// in the order the sensor numbers them
+int setup_roi_subset(VL53L1_Dev_t* dev, const int rows, const int cols, const uint16_t roiMask, uint8_t* gridIndices);
+
 // Get current multizone ranging data
 int get_mz_data(VL53L1_Dev_t* dev, const int blocking, VL53L1_MultiRangingData_t *data);
 
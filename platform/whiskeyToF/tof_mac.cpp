@@ -23,6 +23,8 @@
 #include <webots/Supervisor.hpp>
 #include <webots/RangeFinder.hpp>
 
+#include <chrono>
+
 #ifndef SIMULATOR
 #error SIMULATOR should be defined by any target using tof_mac.cpp
 #endif
@@ -34,6 +36,29 @@ namespace {
   bool _engineSupervisorSet = false;
   webots::Supervisor* _engineSupervisor = nullptr;
   webots::RangeFinder* leftSensor_;
+
+  uint16_t _activeRois = ToFSensor::kAllRois;
+
+  void ReadRoi(const float* rangeImage, int index, RangingData& rData)
+  {
+    rData.numObjects = 1;
+    rData.roiStatus = 0;
+    rData.spadCount = 90.f;
+
+    rData.roi = index;
+    
+    rData.processedRange_mm = rangeImage[index] * 1000;
+
+    RangeReading reading;
+    reading.signalRate_mcps = 25.f;
+    reading.ambientRate_mcps = 0.25f;
+    reading.sigma_mm = 0.f;
+    reading.status = 0;
+
+    reading.rawRange_mm = rangeImage[index] * 1000;
+    rData.readings.clear();
+    rData.readings.push_back(reading);
+  }
 }
 
 ToFSensor* ToFSensor::_instance = nullptr;
@@ -120,28 +145,52 @@ RangeDataRaw ToFSensor::GetData(bool& dataUpdated)
     for(int j = 0; j < 4; j++)
     {
       int index = i*4 + j;
-      RangingData& rData = rangeData.data[index];
-
-      rData.numObjects = 1;
-      rData.roiStatus = 0;
-      rData.spadCount = 90.f;
+      ReadRoi(leftImage, index, rangeData.data[index]);
+    }
+  }
+  
+  return rangeData;
+}
 
-      rData.roi = index;
-      
-      rData.processedRange_mm = leftImage[i*4 + j] * 1000;
+void ToFSensor::GetNewFrames(std::vector<RangeFrame>& frames)
+{
+  // The simulated sensor has a new reading of every active ROI on every call
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  const uint64_t timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
 
-      RangeReading reading;
-      reading.signalRate_mcps = 25.f;
-      reading.ambientRate_mcps = 0.25f;
-      reading.sigma_mm = 0.f;
-      reading.status = 0;
+  const float* leftImage = leftSensor_->getRangeImage();
+  const int numRois = leftSensor_->getWidth() * 4;
 
-      reading.rawRange_mm = leftImage[i*4 + j] * 1000;
-      rData.readings.push_back(reading);
+  frames.clear();
+  for(int index = 0; index < numRois; index++)
+  {
+    if(_activeRois & (1 << index))
+    {
+      frames.emplace_back();
+      frames.back().timestamp_ms = timestamp_ms;
+      ReadRoi(leftImage, index, frames.back().data);
     }
   }
-  
-  return rangeData;
+}
+
+int ToFSensor::SetActiveRois(uint16_t roiMask, const CommandCallback& callback)
+{
+  if(roiMask == 0)
+  {
+    return -1;
+  }
+
+  _activeRois = roiMask;
+  if(callback != nullptr)
+  {
+    callback(CommandResult::Success);
+  }
+  return 0;
+}
+
+uint16_t ToFSensor::GetActiveRois() const
+{
+  return _activeRois;
 }
 
 int ToFSensor::SetupSensors(const CommandCallback& callback)
@@ -17,8 +17,10 @@
 
 #include "util/console/consoleInterface.h"
 #include "util/console/consoleSystem.h"
+#include "util/container/fixedCircularBuffer.h"
 #include "util/logging/logging.h"
 
+#include "anki/cozmo/shared/cozmoConfig.h"
 #include "anki/cozmo/shared/cozmoEngineConfig.h"
 #include "anki/cozmo/shared/factory/emrHelper.h"
 
@@ -53,6 +55,7 @@ namespace {
      StopRanging,
      SetupSensors,
      PerformCalibration,
+     SetActiveRois,
     };
   std::queue<std::pair<Command, ToFSensor::CommandCallback>> _commandQueue;
 
@@ -68,6 +71,16 @@ namespace {
   // Whether or not _latestData has updated since the last call to get it
   bool _dataUpdatedSinceLastGetCall = false;
 
+  // Every reading since the last call to GetNewFrames, guarded by _mutex like _latestData
+  Util::FixedCircularBuffer<ToFSensor::RangeFrame, ToFSensor::kMaxBufferedFrames> _newFrames;
+
+  // ROIs being ranged, and the ROIs requested by the latest SetActiveRois command
+  std::atomic<uint16_t> _activeRois{ToFSensor::kAllRois};
+  uint16_t _requestedRois = ToFSensor::kAllRois;
+
+  // Grid index of each RoiNumber the sensor reports. Only used from the processing thread
+  uint8_t _roiGridIndices[ToFSensor::kNumRois] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15};
+
   // Settings for calibration
   uint32_t _distanceToCalibTarget_mm = 0;
   float _calibTargetReflectance = 0;
@@ -143,10 +156,16 @@ int ToFSensor::PerformCalibration(uint32_t distanceToTarget_mm,
 #define CONVERT_1616_TO_FLOAT(fixed) ((float)(fixed) * (float)(1/(2<<16))) 
 
 // Parses and converts VL53L1_MultiRangingData_t into RangeDataRaw
-void ParseData(VL53L1_MultiRangingData_t& mz_data,
-               RangeDataRaw& rangeData)
+// Returns the index of the ROI that was updated
+int ParseData(VL53L1_MultiRangingData_t& mz_data,
+              RangeDataRaw& rangeData)
 {
-  const int index = mz_data.RoiNumber;
+  if(mz_data.RoiNumber >= ToFSensor::kNumRois)
+  {
+    PRINT_NAMED_ERROR("ParseData.InvalidRoiNumber", "%u", mz_data.RoiNumber);
+    return -1;
+  }
+  const int index = _roiGridIndices[mz_data.RoiNumber];
 
   RangingData& roiData = rangeData.data[index];
   // Populate singular data from this ROI
@@ -187,17 +206,23 @@ void ParseData(VL53L1_MultiRangingData_t& mz_data,
     roiData.processedRange_mm = minDist;
   }
 
+  return index;
 }
 
 // Get the most recent ranging data and parse it to a useable format
-int ReadDataFromSensor(RangeDataRaw& rangeData)
+// roiIndex is set to the ROI that was read
+int ReadDataFromSensor(RangeDataRaw& rangeData, int& roiIndex)
 {
   int rc = 0;  
   VL53L1_MultiRangingData_t mz_data;
   rc = get_mz_data(&_dev, 1, &mz_data);
   if(rc == 0)
   {
-    ParseData(mz_data, rangeData);
+    roiIndex = ParseData(mz_data, rangeData);
+    if(roiIndex < 0)
+    {
+      rc = -1;
+    }
   }
   else
   {
@@ -239,6 +264,64 @@ int ToFSensor::SetupSensors(const CommandCallback& callback)
   return 0;
 }
 
+// Changing the ROIs requires ranging to be stopped, so this is subject to the same issues as Start/StopRanging
+int ToFSensor::SetActiveRois(uint16_t roiMask, const CommandCallback& callback)
+{
+  if(roiMask == 0)
+  {
+    PRINT_NAMED_WARNING("ToFSensor.SetActiveRois.EmptyMask", "Ignoring request to range no ROIs");
+    return -1;
+  }
+
+  std::lock_guard<std::mutex> lock(_commandLock);
+  _requestedRois = roiMask;
+  _commandQueue.push({Command::SetActiveRois, callback});
+  return 0;
+}
+
+uint16_t ToFSensor::GetActiveRois() const
+{
+  return _activeRois;
+}
+
+// Program the sensor with the ROIs in roiMask, stopping and restarting ranging around it if needed
+ToFSensor::CommandResult ApplyActiveRois(uint16_t roiMask)
+{
+  const bool wasRanging = _rangingEnabled;
+  if(wasRanging)
+  {
+    if(stop_ranging(&_dev) < 0)
+    {
+      return ToFSensor::CommandResult::StopRangingFailed;
+    }
+    _rangingEnabled = false;
+  }
+
+  uint8_t gridIndices[ToFSensor::kNumRois];
+  ToFSensor::CommandResult res = ToFSensor::CommandResult::Success;
+  if(setup_roi_subset(&_dev, TOF_RESOLUTION, TOF_RESOLUTION, roiMask, gridIndices) < 0)
+  {
+    PRINT_NAMED_ERROR("ToF.ApplyActiveRois.Failed", "Failed to set ROIs 0x%04x", roiMask);
+    res = ToFSensor::CommandResult::SetupFailed;
+  }
+  else
+  {
+    memcpy(_roiGridIndices, gridIndices, sizeof(_roiGridIndices));
+    _activeRois = roiMask;
+  }
+
+  if(wasRanging)
+  {
+    if(start_ranging(&_dev) < 0)
+    {
+      return ToFSensor::CommandResult::StartRangingFailed;
+    }
+    _rangingEnabled = true;
+  }
+
+  return res;
+}
+
 void ProcessLoop()
 {
   while(!_stopProcessing)
@@ -305,6 +388,15 @@ void ProcessLoop()
               res = ToFSensor::CommandResult::SetupFailed;
               PRINT_NAMED_ERROR("ToF.ProcessLoop.SetupFailed","Failed to setup sensor");
             }
+            else
+            {
+              // setup() ranges the full grid
+              for(int i = 0; i < ToFSensor::kNumRois; i++)
+              {
+                _roiGridIndices[i] = i;
+              }
+              _activeRois = ToFSensor::kAllRois;
+            }
 
           }
           break;
@@ -315,6 +407,20 @@ void ProcessLoop()
             res = run_calibration(_distanceToCalibTarget_mm, _calibTargetReflectance);
           }
           break;
+        case Command::SetActiveRois:
+          {
+            _commandLock.lock();
+            const uint16_t roiMask = _requestedRois;
+            _commandLock.unlock();
+
+            // Several requests may be queued up, only the latest matters
+            if(roiMask != _activeRois)
+            {
+              PRINT_NAMED_INFO("ToF.ProcessLoop.SetActiveRois", "0x%04x", roiMask);
+              res = ApplyActiveRois(roiMask);
+            }
+          }
+          break;
       }
 
       // Call command callback
@@ -334,7 +440,8 @@ void ProcessLoop()
       // Note: static is important here in order to preserve previous readings
       // as, typically, only one ROI is read at a time
       static RangeDataRaw data;
-      const int rc = ReadDataFromSensor(data);
+      int roiIndex = -1;
+      const int rc = ReadDataFromSensor(data, roiIndex);
 
       // static RangeDataRaw lastValid = data;
       // std::stringstream ss;
@@ -360,9 +467,15 @@ void ProcessLoop()
       // Got a valid reading so update our latest data
       if(rc >= 0)
       {
+        const auto now = std::chrono::steady_clock::now().time_since_epoch();
+
         std::lock_guard<std::mutex> lock(_mutex);
         _dataUpdatedSinceLastGetCall = true;
         _latestData = data;
+
+        ToFSensor::RangeFrame& frame = _newFrames.push_back();
+        frame.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+        frame.data = data.data[roiIndex];
       }
     }
     // Ranging is not enabled so sleep
@@ -419,6 +532,18 @@ RangeDataRaw ToFSensor::GetData(bool& hasDataUpdatedSinceLastCall)
   return _latestData;
 }
 
+void ToFSensor::GetNewFrames(std::vector<RangeFrame>& frames)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+  frames.resize(_newFrames.size());
+  for(size_t i = 0; i < _newFrames.size(); i++)
+  {
+    // Swap rather than copy so that the buffered frames' readings are reused
+    std::swap(frames[i], _newFrames[i]);
+  }
+  _newFrames.clear();
+}
+
 bool ToFSensor::IsValidRoiStatus(uint8_t status) const
 {
   return (status != VL53L1_ROISTATUS_NOT_VALID);
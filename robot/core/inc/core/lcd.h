@@ -46,6 +46,8 @@ int lcd_init(void);
 void lcd_clear_screen(void);
 void lcd_draw_frame(const LcdFrame* frame);
 void lcd_draw_frame2(const uint16_t* frame, size_t size);
+// Only send the window of frame (a whole frame, row by row) at x,y that is width x height pixels
+void lcd_draw_frame2_rect(const uint16_t* frame, int x, int y, int width, int height);
 int lcd_set_brightness(int b); //0..20
 void lcd_shutdown(void);
 
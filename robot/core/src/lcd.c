@@ -245,6 +245,37 @@ static void lcd_run_script(const INIT_SCRIPT* script)
   }
 }
 
+// Whether the RAM window of the display was set to a part of the screen by lcd_draw_frame2_rect
+static bool lcd_window_is_partial;
+
+// Set the RAM window the next WRITE_RAM fills, in display coordinates (inclusive)
+static void lcd_set_window(int x0, int y0, int x1, int y1)
+{
+  static const uint8_t COLUMN_ADDRESS_SET = 0x2A;
+  static const uint8_t ROW_ADDRESS_SET = 0x2B;
+  const uint8_t columns[4] = { MSB(x0), LSB(x0), MSB(x1), LSB(x1) };
+  const uint8_t rows[4] = { MSB(y0), LSB(y0), MSB(y1), LSB(y1) };
+
+  lcd_spi_transfer(TRUE, 1, &COLUMN_ADDRESS_SET);
+  lcd_spi_transfer(FALSE, sizeof(columns), columns);
+  lcd_spi_transfer(TRUE, 1, &ROW_ADDRESS_SET);
+  lcd_spi_transfer(FALSE, sizeof(rows), rows);
+}
+
+// Set the RAM window back to the whole screen, as the init scripts leave it, before drawing a whole frame
+static void lcd_restore_window(void)
+{
+  if (!lcd_window_is_partial) {
+    return;
+  }
+  if (LCD_DISPLAY_MAN == SANTEK) {
+    lcd_set_window(RSHIFT, 0, LCD_FRAME_WIDTH_SANTEK + RSHIFT - 1, LCD_FRAME_HEIGHT_SANTEK - 1);
+  } else {
+    lcd_set_window(XSHIFT, YSHIFT, LCD_FRAME_WIDTH_MIDAS + XSHIFT - 1, LCD_FRAME_HEIGHT_MIDAS + YSHIFT - 1);
+  }
+  lcd_window_is_partial = FALSE;
+}
+
 /************ LCD Framebuffer device *************/
 static int lcd_fb_init(void)
 {
@@ -292,6 +323,7 @@ void lcd_draw_frame(const LcdFrame* frame) {
       (void)write(lcd_fd, frame->data, sizeof(frame->data));
    } else {
       static const uint8_t WRITE_RAM = 0x2C;
+      lcd_restore_window();
       lcd_spi_transfer(TRUE, 1, &WRITE_RAM);
       lcd_spi_transfer(FALSE, sizeof(frame->data), frame->data);
    }
@@ -306,6 +338,7 @@ void lcd_draw_frame2_midas_crop(const uint16_t* frame, size_t size)
 {
   static const uint8_t WRITE_RAM = 0x2C;
 
+  lcd_restore_window();
   lcd_spi_transfer(TRUE, 1, &WRITE_RAM);
 
   uint16_t new_row[LCD_FRAME_WIDTH_MIDAS];
@@ -331,6 +364,7 @@ void lcd_draw_frame2_midas(const uint16_t* frame, size_t size) {
     (void)write(lcd_fd, buffer, size);
   } else {
     static const uint8_t WRITE_RAM = 0x2C;
+    lcd_restore_window();
     lcd_spi_transfer(TRUE, 1, &WRITE_RAM);
     lcd_spi_transfer(FALSE, size, buffer);
   }
@@ -342,6 +376,7 @@ void lcd_draw_frame2_santek(const uint16_t* frame, size_t size) {
       (void)write(lcd_fd, frame, size);
    } else {
       static const uint8_t WRITE_RAM = 0x2C;
+      lcd_restore_window();
       lcd_spi_transfer(TRUE, 1, &WRITE_RAM);
       lcd_spi_transfer(FALSE, size, frame);
    }
@@ -360,6 +395,58 @@ void lcd_draw_frame2(const uint16_t* frame, size_t size) {
   }
 }
 
+void lcd_draw_frame2_rect(const uint16_t* frame, int x, int y, int width, int height) {
+  const bool santek = (LCD_DISPLAY_MAN == SANTEK);
+  const int frame_width = santek ? LCD_FRAME_WIDTH_SANTEK : LCD_FRAME_WIDTH_MIDAS;
+  const int frame_height = santek ? LCD_FRAME_HEIGHT_SANTEK : LCD_FRAME_HEIGHT_MIDAS;
+
+  x = MAX(x, 0);
+  y = MAX(y, 0);
+  width = MIN(width, frame_width - x);
+  height = MIN(height, frame_height - y);
+  if (width <= 0 || height <= 0) {
+    return;
+  }
+
+  if (santek && lcd_use_fb) {
+    // The framebuffer is as wide as the frame, so write the changed part of each row in place
+    int row;
+    for (row = y; row < y + height; row++) {
+      const size_t offset = ((size_t)row * frame_width + x) * sizeof(uint16_t);
+      (void)pwrite(lcd_fd, frame + row * frame_width + x, width * sizeof(uint16_t), offset);
+    }
+    return;
+  }
+
+  if (!santek && lcd_use_midas_crop()) {
+    // The cropped frame does not line up with the display, so send all of it
+    lcd_draw_frame2(frame, (size_t)LCD_FRAME_WIDTH_SANTEK * LCD_FRAME_HEIGHT_SANTEK * sizeof(uint16_t));
+    return;
+  }
+
+  // Pack the window into one buffer so it goes out in as few transfers as a whole frame would
+  static uint16_t buffer[LCD_FRAME_WIDTH_SANTEK * LCD_FRAME_HEIGHT_SANTEK];
+  uint16_t* out = buffer;
+  int row, col;
+  for (row = y; row < y + height; row++) {
+    const uint16_t* in = frame + row * frame_width + x;
+    for (col = 0; col < width; col++) {
+      *out++ = santek ? in[col] : __builtin_bswap16(in[col]);
+    }
+  }
+
+  if (santek) {
+    lcd_set_window(RSHIFT + x, y, RSHIFT + x + width - 1, y + height - 1);
+  } else {
+    lcd_set_window(XSHIFT + x, YSHIFT + y, XSHIFT + x + width - 1, YSHIFT + y + height - 1);
+  }
+  lcd_window_is_partial = TRUE;
+
+  static const uint8_t WRITE_RAM = 0x2C;
+  lcd_spi_transfer(TRUE, 1, &WRITE_RAM);
+  lcd_spi_transfer(FALSE, width * height * sizeof(uint16_t), buffer);
+}
+
 #define MAX(a,b) (((a)>(b))?(a):(b))
 #define MIN(a,b) (((a)<(b))?(a):(b))
 
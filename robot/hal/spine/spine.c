@@ -28,6 +28,7 @@ void spine_init(spine_ctx_t spine)
 {
     memset(spine, 0, sizeof(struct spine_ctx));
     spine->fd = -1;
+    spine->rx_retained = -1;
 }
 
 void spine_destroy(spine_ctx_t spine)
@@ -35,6 +36,7 @@ void spine_destroy(spine_ctx_t spine)
     spine_close(spine);
     memset(spine, 0, sizeof(struct spine_ctx));
     spine->fd = -1;
+    spine->rx_retained = -1;
 }
 
 static SpineErr spine_open_internal(spine_ctx_t spine, struct spine_params params)
@@ -143,26 +145,64 @@ ssize_t spine_read_all(int fd, void* buf, size_t buf_len)
     return bytes_read;
 }
 
+// Returns where to write at least `len` more bytes of received data. If the active rx buffer doesn't have
+// that much room left, its unparsed data is moved to the start of a buffer which doesn't hold the retained
+// frame. Data which still doesn't leave enough room is dropped. Returns NULL if len can never fit.
+static uint8_t* spine_rx_reserve(spine_ctx_t spine, size_t len)
+{
+    // Start over at the beginning of the buffer once everything has been parsed, unless that would
+    // overwrite the retained frame
+    if ((spine->rx_head == spine->rx_cursor) && (spine->rx_retained != spine->rx_active)) {
+        spine->rx_head = 0;
+        spine->rx_cursor = 0;
+    }
+
+    if (SPINE_BUFFER_MAX_LEN - spine->rx_cursor < len) {
+        const uint32_t pending = spine->rx_cursor - spine->rx_head;
+        const uint8_t* unparsed = spine->buf_rx[spine->rx_active] + spine->rx_head;
+        if (spine->rx_retained == spine->rx_active) {
+            spine->rx_active ^= 1;
+            memcpy(spine->buf_rx[spine->rx_active], unparsed, pending);
+        } else {
+            memmove(spine->buf_rx[spine->rx_active], unparsed, pending);
+        }
+        spine->rx_head = 0;
+        spine->rx_cursor = pending;
+
+        if (SPINE_BUFFER_MAX_LEN - pending < len) {
+            LOGE("spine_receive_data.overflow :: %u", len - (SPINE_BUFFER_MAX_LEN - pending));
+            spine->rx_cursor = 0;
+            // BRC: add a flag to indicate a reset (for using in parsing?)
+            if (len > SPINE_BUFFER_MAX_LEN) {
+                return NULL;
+            }
+        }
+    }
+    return spine->buf_rx[spine->rx_active] + spine->rx_cursor;
+}
+
 ssize_t spine_read(spine_ctx_t spine)
 {
-    return spine_read_all(spine->fd, spine->buf_rx, sizeof(spine->buf_rx));
+    // Only make room once less than half of the buffer is left, so that data is rarely moved and a
+    // read is never limited to a sliver at the end of the buffer
+    uint8_t* rx = spine_rx_reserve(spine, SPINE_BUFFER_MAX_LEN / 2);
+    ssize_t r = read(spine->fd, rx, SPINE_BUFFER_MAX_LEN - spine->rx_cursor);
+    if (r > 0) {
+        spine->rx_cursor += r;
+    }
+    return r;
 }
 
 // send data into spine for processing
 ssize_t spine_receive_data(spine_ctx_t spine, const void* bytes, size_t len)
 {
-    size_t next_offset = spine->rx_cursor;
-    size_t remaining = sizeof(spine->buf_rx) - next_offset;
-
-    if (len > remaining) {
-        LOGE("spine_receive_data.overflow :: %u", len - remaining);
-        spine->rx_cursor = 0;
-        // BRC: add a flag to indicate a reset (for using in parsing?)
+    uint8_t* rx = spine_rx_reserve(spine, len);
+    if (rx == NULL) {
+        return -1;
     }
 
-    uint8_t* rx = spine->buf_rx + next_offset;
     memcpy(rx, bytes, len);
-    spine->rx_cursor = next_offset + len;
+    spine->rx_cursor += len;
 
     // printf("spine_receive_data %u :: rx_cursor at %u\n", len, spine->rx_cursor);
 
@@ -281,28 +321,49 @@ int spine_get_payload_len(PayloadId payload_type, enum MsgDir dir)
   return -1;
 }
 
+// Marks `offset` bytes of unparsed data as consumed (all of it if offset < 0). Parsed data is left in place,
+// so that frames parsed in place stay valid
 void spine_set_rx_cursor(spine_ctx_t spine, ssize_t offset)
 {
     if (offset > 0) {
-        ssize_t remaining = sizeof(spine->buf_rx) - offset;
-        assert(remaining >= 0);
-        if (remaining >= 0) {
-            const uint8_t* rx = (const uint8_t*)spine->buf_rx + offset;
-            memmove(spine->buf_rx, rx, remaining);
-        }
-        spine->rx_cursor -= offset;
-        memset(spine->buf_rx + spine->rx_cursor, 0x55, sizeof(spine->buf_rx) - spine->rx_cursor);
+        assert(spine->rx_head + offset <= spine->rx_cursor);
+        spine->rx_head += offset;
     } else if (offset < 0) {
         // discard all data
-        spine->rx_cursor = 0;
-        memset(spine->buf_rx, 0x55, sizeof(spine->buf_rx));
+        spine->rx_head = spine->rx_cursor;
+    }
+}
+
+void spine_retain_frame(spine_ctx_t spine, const void* frame)
+{
+    const uint8_t* bytes = (const uint8_t*)frame;
+    spine->rx_retained = -1;
+    int i;
+    for (i = 0; i < 2; ++i) {
+        if (bytes >= spine->buf_rx[i] && bytes < spine->buf_rx[i] + SPINE_BUFFER_MAX_LEN) {
+            spine->rx_retained = i;
+        }
     }
 }
 
 ssize_t spine_parse_frame(spine_ctx_t spine, void *out_buf, size_t out_buf_len, size_t* out_len)
 {
-    // printf("spine_parse_frame: bytes available %u\n", spine->rx_cursor);
-    const size_t rx_len = spine->rx_cursor;
+    const uint8_t* frame = NULL;
+    ssize_t frame_len = spine_parse_frame_inplace(spine, &frame);
+
+    // Copy data to output buffer
+    if (frame_len > 0 && out_buf != NULL) {
+        assert(out_buf_len >= frame_len);
+        memcpy(out_buf, frame, frame_len);
+    }
+
+    return frame_len;
+}
+
+ssize_t spine_parse_frame_inplace(spine_ctx_t spine, const uint8_t** out_frame)
+{
+    // printf("spine_parse_frame: bytes available %u\n", spine->rx_cursor - spine->rx_head);
+    const size_t rx_len = spine->rx_cursor - spine->rx_head;
 
     // Is there any data to process?
     if (rx_len == 0) {
@@ -311,8 +372,9 @@ ssize_t spine_parse_frame(spine_ctx_t spine, void *out_buf, size_t out_buf_len,
         return 0;
     }
 
-    // Start from the beginning of the rx buffer
-    uint8_t* rx = spine->buf_rx;
+    // Start from the beginning of the unparsed data
+    uint8_t* const rx_start = spine->buf_rx[spine->rx_active] + spine->rx_head;
+    uint8_t* rx = rx_start;
 
     // Search for a valid sync sequence
     ssize_t search_len = rx_len - sizeof(SYNC_BODY_TO_HEAD);
@@ -358,7 +420,7 @@ ssize_t spine_parse_frame(spine_ctx_t spine, void *out_buf, size_t out_buf_len,
 
     // set `rx` to the beginning of the packet
     // offset
-    rx = (spine->buf_rx + sync_index);
+    rx = (rx_start + sync_index);
 
     // Validate payload data
     const struct SpineMessageHeader* header = (const struct SpineMessageHeader*)rx;
@@ -417,19 +479,17 @@ ssize_t spine_parse_frame(spine_ctx_t spine, void *out_buf, size_t out_buf_len,
     if (true_crc != expected_crc) {
         // throw away header
         LOGW("invalid crc: expected=%08x | observed=%08x [type %x]", expected_crc, true_crc, header->payload_type);
+        ++spine->crc_errcount;
         spine_set_rx_cursor(spine, sync_index + sizeof(SYNC_BODY_TO_HEAD));
         return -1;
     }
 
     // At this point we have a valid frame.
-
-    // Copy data to output buffer
-    if (out_buf != NULL) {
-        assert(out_buf_len >= frame_len);
-        memcpy(out_buf, rx, frame_len);
+    if (out_frame != NULL) {
+        *out_frame = rx;
     }
 
-    // Reset RX buffer
+    // Consume the frame, which stays where it is
     spine_set_rx_cursor(spine, sync_index + frame_len);
 
     spine_debug_x("==> found frame %x \n", header->payload_type);
@@ -56,9 +56,15 @@ static const size_t SPINE_CCC_FRAME_LEN =
 struct spine_ctx {
     int fd;
     int errcount;
-    uint32_t rx_cursor;
+    uint32_t crc_errcount;  // frames dropped for a bad crc since init
+    uint32_t rx_head;       // start of unparsed data in the active rx buffer
+    uint32_t rx_cursor;     // end of received data in the active rx buffer
     uint32_t rx_size;
-    uint8_t buf_rx[SPINE_BUFFER_MAX_LEN];
+    uint8_t rx_active;      // index of the rx buffer data is received into
+    int8_t rx_retained;     // index of the rx buffer holding the retained frame, or -1
+    // Frames are parsed in place, so received data is double buffered: when the active buffer runs out
+    // of space its unparsed data moves to the start of the other one, unless that holds the retained frame
+    uint8_t buf_rx[2][SPINE_BUFFER_MAX_LEN];
     uint8_t buf_tx[SPINE_BUFFER_MAX_LEN];
 };
 typedef struct spine_ctx* spine_ctx_t;
@@ -73,7 +79,8 @@ int spine_close(spine_ctx_t spine);
 // get file descriptor associated with spine I/O
 int spine_get_fd(spine_ctx_t spine);
 
-// read all available data from spine
+// read available data from spine straight into the rx buffer, with a single read()
+// returns the result of read()
 ssize_t spine_read(spine_ctx_t spine);
 
 // send data into spine for processing
@@ -99,6 +106,14 @@ ssize_t spine_shutdown(spine_ctx_t spine);
 // -1 if buffered data is invalid
 ssize_t spine_parse_frame(spine_ctx_t spine, void *out_buf, size_t out_buf_len, size_t* out_len);
 
+// Same as spine_parse_frame, but instead of copying the frame points out_frame at it in the rx buffer.
+// The frame is valid until the next spine_read or spine_receive_data call, unless it is retained.
+ssize_t spine_parse_frame_inplace(spine_ctx_t spine, const uint8_t** out_frame);
+
+// Keeps a frame returned by spine_parse_frame_inplace valid until another one is retained (or NULL is
+// passed), however much more data is received meanwhile. Only one frame at a time can be retained.
+void spine_retain_frame(spine_ctx_t spine, const void* frame);
+
 //
 // spine_protocol parsing
 //
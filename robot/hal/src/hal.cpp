@@ -7,8 +7,10 @@
 
 
 // System Includes
+#include <algorithm>
 #include <chrono>
 #include <assert.h>
+#include <cstdlib>
 #include <cstdio>
 #include <cstring>
 
@@ -30,6 +32,7 @@
 #include "clad/types/proxMessages.h"
 
 #include <errno.h>
+#include <sys/epoll.h>
 
 // will log all the touch sensor data to /data/misc/touch.csv
 // disable when you aren't trying to debug the touch sensor
@@ -95,8 +98,8 @@ namespace { // "Private members"
 
   static const f32 kBatteryScale = 2.8f / 2048.f;
   struct spine_ctx spine_;
-  uint8_t frameBuffer_[SPINE_B2H_FRAME_LEN];
-  uint8_t readBuffer_[4096];
+  // Waits for data on the spine fd
+  int spineEpollFd_ = -1;
   BodyToHead BootBodyData_ = { //dummy data for boot stub frames
     .framecounter         = 0,
     .flags                = RUNNING_FLAGS_SENSORS_VALID,  // emulate active power mode
@@ -118,6 +121,21 @@ namespace { // "Private members"
   const u32 SELECT_TIMEOUT_SEC = 1;
   const u32 SELECT_TIMEOUT_ATTEMPTS = 5;
   const u32 SPINE_GET_FRAME_TIMEOUT_MS = 1000 * SELECT_TIMEOUT_SEC * (SELECT_TIMEOUT_ATTEMPTS + 1);
+
+  // Spine timing and integrity, logged once per SPINE_STATS_REPORT_PERIOD_MS if anything was off.
+  // Body data frames pace the main loop, so how far each one arrives from ROBOT_TIME_STEP_MS after
+  // the previous one is the jitter the control loop sees. Bins are upper limits, the last one is everything above.
+  const u32 SPINE_STATS_REPORT_PERIOD_MS = 60000;
+  const u32 SPINE_JITTER_BIN_LIMITS_US[] = {250, 500, 1000, 2000, 5000};
+  const u32 NUM_SPINE_JITTER_BINS = sizeof(SPINE_JITTER_BIN_LIMITS_US) / sizeof(SPINE_JITTER_BIN_LIMITS_US[0]) + 1;
+  const u32 SPINE_JITTER_WARN_BIN = 3;  // Frames more than 1ms off are worth reporting
+  u32 spineJitterHist_[NUM_SPINE_JITTER_BINS] = {0};
+  // Number of frames dropped for a bad crc between consecutive data frames: 0, 1, 2, 3 or more
+  const u32 NUM_SPINE_CRC_FAIL_BINS = 4;
+  u32 spineCrcFailHist_[NUM_SPINE_CRC_FAIL_BINS] = {0};
+  u32 lastDataFrameTime_us_ = 0;
+  u32 lastSpineCrcErrCount_ = 0;
+  TimeStamp_t nextSpineStatsReportTime_ms_ = 0;
   const int* shutdownSignal_ = 0;
 
 } // "private" namespace
@@ -147,14 +165,12 @@ extern "C" {
   }
 }
 
-// Tries to select from the spine fd
+// Waits for data on the spine fd
 // If it times out too many times then
 // syscon must be hosed or there is no spine
 // connection
 bool check_select_timeout(spine_ctx_t spine)
 {
-  int fd = spine_get_fd(spine);
-
   static u8 selectTimeoutCount = 0;
   if(selectTimeoutCount >= SELECT_TIMEOUT_ATTEMPTS)
   {
@@ -164,13 +180,8 @@ bool check_select_timeout(spine_ctx_t spine)
     return true;
   }
 
-  static fd_set fdSet;
-  FD_ZERO(&fdSet);
-  FD_SET(fd, &fdSet);
-  static timeval timeout;
-  timeout.tv_sec = SELECT_TIMEOUT_SEC;
-  timeout.tv_usec = 0;
-  ssize_t s = select(FD_SETSIZE, &fdSet, NULL, NULL, &timeout);
+  struct epoll_event event;
+  const int s = epoll_wait(spineEpollFd_, &event, 1, SELECT_TIMEOUT_SEC * 1000);
   if(s == 0)
   {
     selectTimeoutCount++;
@@ -189,8 +200,6 @@ bool check_select_timeout(spine_ctx_t spine)
 
 ssize_t robot_io(spine_ctx_t spine)
 {
-  int fd = spine_get_fd(spine);
-
   EventStart(EventType::ROBOT_IO_READ);
 
   if(check_select_timeout(spine))
@@ -198,18 +207,13 @@ ssize_t robot_io(spine_ctx_t spine)
     return -1;
   }
 
-  ssize_t r = read(fd, readBuffer_, sizeof(readBuffer_));
+  // Reads straight into the spine's rx buffer, where frames are then parsed in place
+  ssize_t r = spine_read(spine);
 
   EventAddToMisc(EventType::ROBOT_IO_READ, (uint32_t)r);
   EventStop(EventType::ROBOT_IO_READ);
 
-  if (r > 0)
-  {
-    EventStart(EventType::ROBOT_IO_RECEIVE);
-    r = spine_receive_data(spine, (const void*)readBuffer_, r);
-    EventStop(EventType::ROBOT_IO_RECEIVE);
-  }
-  else if (r < 0)
+  if (r < 0)
   {
     if (errno == EAGAIN) {
       r = 0;
@@ -293,15 +297,17 @@ Result spine_wait_for_first_frame(spine_ctx_t spine, const int * shutdownSignal)
       break;
     }
 
-    ssize_t r = spine_parse_frame(spine, &frameBuffer_, sizeof(frameBuffer_), NULL);
+    const uint8_t* frameBuffer = nullptr;
+    ssize_t r = spine_parse_frame_inplace(spine, &frameBuffer);
 
     if (r < 0) {
       continue;
     } else if (r > 0) {
-      const struct SpineMessageHeader* hdr = (const struct SpineMessageHeader*)frameBuffer_;
+      const struct SpineMessageHeader* hdr = (const struct SpineMessageHeader*)frameBuffer;
       if (hdr->payload_type == PAYLOAD_DATA_FRAME) {
         initialized = true;
-        const struct spine_frame_b2h* frame = (const struct spine_frame_b2h*)frameBuffer_;
+        spine_retain_frame(spine, frameBuffer);
+        const struct spine_frame_b2h* frame = (const struct spine_frame_b2h*)frameBuffer;
         bodyData_ = (BodyToHead*)&frame->payload;
       }
       else if (hdr->payload_type == PAYLOAD_CONT_DATA) {
@@ -389,6 +395,17 @@ Result HAL::Init(const int * shutdownSignal)
     if (errCode != err_OK) {
       return RESULT_FAIL;
     }
+
+    spineEpollFd_ = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = spine_get_fd(&spine_);
+    if (spineEpollFd_ < 0 || epoll_ctl(spineEpollFd_, EPOLL_CTL_ADD, event.data.fd, &event) != 0) {
+      AnkiError("HAL.Init.SpineEpollFailed", "%s", strerror(errno));
+      return RESULT_FAIL;
+    }
+    nextSpineStatsReportTime_ms_ = GetTimeStamp() + SPINE_STATS_REPORT_PERIOD_MS;
+
     AnkiDebug("HAL.Init.SettingRunMode", "");
 
     spine_set_mode(&spine_, RobotMode_RUN);
@@ -419,10 +436,50 @@ Result HAL::Init(const int * shutdownSignal)
   return RESULT_OK;
 }  // Init()
 
+void record_spine_stats() {
+  const u32 now_us = HAL::GetMicroCounter();
+  if (lastDataFrameTime_us_ != 0) {
+    const s32 jitter_us = std::abs((s32)(now_us - lastDataFrameTime_us_) - (s32)(ROBOT_TIME_STEP_MS * 1000));
+    u32 bin = 0;
+    while (bin < NUM_SPINE_JITTER_BINS - 1 && jitter_us > SPINE_JITTER_BIN_LIMITS_US[bin]) {
+      ++bin;
+    }
+    ++spineJitterHist_[bin];
+  }
+  lastDataFrameTime_us_ = now_us;
+
+  const u32 numCrcFails = spine_.crc_errcount - lastSpineCrcErrCount_;
+  ++spineCrcFailHist_[std::min(numCrcFails, NUM_SPINE_CRC_FAIL_BINS - 1)];
+  lastSpineCrcErrCount_ = spine_.crc_errcount;
+}
+
+void report_spine_stats() {
+  u32 numLate = 0;
+  for (u32 i = SPINE_JITTER_WARN_BIN; i < NUM_SPINE_JITTER_BINS; ++i) {
+    numLate += spineJitterHist_[i];
+  }
+  const u32 numWithCrcFails = spineCrcFailHist_[1] + spineCrcFailHist_[2] + spineCrcFailHist_[3];
+
+  if (numLate > 0 || numWithCrcFails > 0) {
+    AnkiInfo("HAL.SpineStats",
+             "jitter <=250us: %u, <=500us: %u, <=1ms: %u, <=2ms: %u, <=5ms: %u, >5ms: %u | "
+             "crc fails between frames 0: %u, 1: %u, 2: %u, 3+: %u",
+             spineJitterHist_[0], spineJitterHist_[1], spineJitterHist_[2],
+             spineJitterHist_[3], spineJitterHist_[4], spineJitterHist_[5],
+             spineCrcFailHist_[0], spineCrcFailHist_[1], spineCrcFailHist_[2], spineCrcFailHist_[3]);
+  }
+
+  memset(spineJitterHist_, 0, sizeof(spineJitterHist_));
+  memset(spineCrcFailHist_, 0, sizeof(spineCrcFailHist_));
+}
+
 void handle_payload_data(const uint8_t frame_buffer[]) {
 
-  memcpy(frameBuffer_, frame_buffer, sizeof(frameBuffer_));
-  bodyData_ = (BodyToHead*)(frameBuffer_ + sizeof(struct SpineMessageHeader));
+  // The frame stays where it was parsed until the next data frame replaces it
+  spine_retain_frame(&spine_, frame_buffer);
+  bodyData_ = (BodyToHead*)(frame_buffer + sizeof(struct SpineMessageHeader));
+
+  record_spine_stats();
 
   if (ccc_commander_is_active()) {
     ccc_payload_process(bodyData_);
@@ -433,12 +490,12 @@ void handle_payload_data(const uint8_t frame_buffer[]) {
 
 Result spine_get_frame() {
   Result result = RESULT_FAIL_IO;
-  uint8_t frame_buffer[SPINE_B2H_FRAME_LEN];
+  const uint8_t* frame_buffer = nullptr;
 
   ssize_t r = 0;
   do {
     EventStart(EventType::PARSE_FRAME);
-    r = spine_parse_frame(&spine_, frame_buffer, sizeof(frame_buffer), NULL);
+    r = spine_parse_frame_inplace(&spine_, &frame_buffer);
     EventStop(EventType::PARSE_FRAME);
 
     if (r < 0)
@@ -599,6 +656,11 @@ Result HAL::Step(void)
       ReportRecentInvalidProxDataReadings();
     }
 
+    if (now_ms > nextSpineStatsReportTime_ms_) {
+      report_spine_stats();
+      nextSpineStatsReportTime_ms_ = now_ms + SPINE_STATS_REPORT_PERIOD_MS;
+    }
+
     struct ContactData* ccc_response = ccc_text_response();
     if (ccc_response) {
       spine_write_ccc_frame(&spine_, ccc_response);
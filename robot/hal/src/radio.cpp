@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <string>
 
+#include "coretech/messaging/shared/bootStatus.h"
 #include "coretech/messaging/shared/LocalUdpServer.h"
 #include "coretech/messaging/shared/socketConstants.h"
 
@@ -42,18 +43,24 @@ namespace Anki {
       const RobotID_t robotID = HAL::GetID();
       const std::string & server_path = std::string(ANIM_ROBOT_SERVER_PATH) + std::to_string(robotID);
 
+      BootStatus::Clear(BootMilestone::RobotCommsReady);
+
       AnkiInfo("HAL.InitRadio.StartListening", "Start listening at %s", server_path.c_str());
       if (!server.StartListening(server_path.c_str())) {
         AnkiError("HAL.InitRadio.UDPServerFailed", "Unable to listen at %s", server_path.c_str());
         return RESULT_FAIL_IO;
       }
 
+      // vic-anim waits for this before connecting
+      BootStatus::Publish(BootMilestone::RobotCommsReady);
+
       return RESULT_OK;
     }
 
     void StopRadio()
     {
       AnkiInfo("HAL.RadioStop", "");
+      BootStatus::Clear(BootMilestone::RobotCommsReady);
       server.StopListening();
     }
 
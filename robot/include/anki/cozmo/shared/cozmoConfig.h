@@ -385,6 +385,11 @@ namespace Vector {
   // How frequently to send state messages in calm mode
   const s32 STATE_MESSAGE_FREQUENCY_CALM = 50;
 
+  // Send robot state messages as deltas against the previous one (see robotStateDelta.h),
+  // with a full keyframe every ROBOT_STATE_KEYFRAME_PERIOD messages
+  const bool ROBOT_STATE_DELTA_ENCODING_ENABLED = true;
+  const u32 ROBOT_STATE_KEYFRAME_PERIOD = 30;
+
   // UI device server port which listens for basestation/game clients
   const u32 UI_MESSAGE_SERVER_LISTEN_PORT = 5200;
 
@@ -0,0 +1,124 @@
+/**
+ * File: engineAnimMessageBatch.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Several packed EngineToRobot messages carried in one engine->anim datagram, so that the messages
+ *              the engine sends during a tick cost one send()/recv() pair instead of one per message.
+ *
+ *              A batch starts with kEngineAnimBatchMarker, which is the INVALID tag of the EngineToRobot union and so
+ *              can never start a single message. Each message follows as a little-endian u16 size and the packed
+ *              message itself. Anything not starting with the marker is a single message, as before.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Cozmo_EngineAnimMessageBatch_H__
+#define __Anki_Cozmo_EngineAnimMessageBatch_H__
+
+#include <stdint.h>
+
+#include <array>
+#include <cstring>
+
+namespace Anki {
+namespace Vector {
+
+static const uint8_t  kEngineAnimBatchMarker = 0xFF;
+
+// Largest datagram either side sends or expects on the engine<->anim socket. Well under the 256k socket buffers, and
+// large enough to carry all the chunks of a face image in a few datagrams
+static const uint32_t kEngineAnimMaxDatagramSize = 16 * 1024;
+
+static const uint32_t kEngineAnimBatchHeaderSize      = 1;
+static const uint32_t kEngineAnimBatchEntryHeaderSize = 2;
+
+class EngineAnimMessageBatch
+{
+public:
+
+  // Largest message Append() will take
+  static constexpr uint32_t kMaxMessageSize = kEngineAnimMaxDatagramSize - kEngineAnimBatchHeaderSize - kEngineAnimBatchEntryHeaderSize;
+
+  EngineAnimMessageBatch() { Clear(); }
+
+  // Returns false, leaving the batch unchanged, if the message does not fit in what is left of the batch
+  bool Append(const uint8_t* data, uint32_t size)
+  {
+    if((size == 0) || (_size + kEngineAnimBatchEntryHeaderSize + size > kEngineAnimMaxDatagramSize)) {
+      return false;
+    }
+    _buffer[_size++] = static_cast<uint8_t>(size & 0xFF);
+    _buffer[_size++] = static_cast<uint8_t>(size >> 8);
+    std::memcpy(_buffer.data() + _size, data, size);
+    _size += size;
+    if(_numMessages == 0) {
+      _firstMessageSize = size;
+    }
+    ++_numMessages;
+    return true;
+  }
+
+  void Clear()
+  {
+    _buffer[0] = kEngineAnimBatchMarker;
+    _size = kEngineAnimBatchHeaderSize;
+    _numMessages = 0;
+    _firstMessageSize = 0;
+  }
+
+  bool     IsEmpty()        const { return _numMessages == 0; }
+  uint32_t GetNumMessages() const { return _numMessages; }
+
+  // The datagram to send. A batch of one is sent as the bare message, which needs no unpacking on the other side
+  const uint8_t* GetDatagram() const
+  {
+    return (_numMessages == 1) ? _buffer.data() + kEngineAnimBatchHeaderSize + kEngineAnimBatchEntryHeaderSize : _buffer.data();
+  }
+  uint32_t GetDatagramSize() const
+  {
+    return (_numMessages == 1) ? _firstMessageSize : (IsEmpty() ? 0 : _size);
+  }
+
+private:
+
+  std::array<uint8_t, kEngineAnimMaxDatagramSize> _buffer;
+  uint32_t _size;
+  uint32_t _numMessages;
+  uint32_t _firstMessageSize;
+};
+
+inline bool IsEngineAnimMessageBatch(const uint8_t* data, uint32_t size)
+{
+  return (size >= kEngineAnimBatchHeaderSize) && (data[0] == kEngineAnimBatchMarker);
+}
+
+// Calls func(data, size) for each message of a batch, in the order they were appended. Returns false if the batch
+// is malformed, after calling func for the messages before the bad entry.
+template<typename Func>
+bool ForEachMessageInBatch(const uint8_t* data, uint32_t size, Func&& func)
+{
+  if(!IsEngineAnimMessageBatch(data, size)) {
+    return false;
+  }
+  uint32_t offset = kEngineAnimBatchHeaderSize;
+  while(offset < size) {
+    if(offset + kEngineAnimBatchEntryHeaderSize > size) {
+      return false;
+    }
+    const uint32_t msgSize = static_cast<uint32_t>(data[offset]) | (static_cast<uint32_t>(data[offset+1]) << 8);
+    offset += kEngineAnimBatchEntryHeaderSize;
+    if((msgSize == 0) || (offset + msgSize > size)) {
+      return false;
+    }
+    func(data + offset, msgSize);
+    offset += msgSize;
+  }
+  return true;
+}
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Cozmo_EngineAnimMessageBatch_H__
@@ -0,0 +1,202 @@
+/**
+ * File: robotStateDelta.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Compact encoding of the periodic RobotState message sent from vic-robot through vic-anim to the
+ *              engine. Most of RobotState changes little or not at all from one message to the next, so instead of
+ *              the full packed message each datagram usually carries only how it differs from the previous one.
+ *
+ *              A compact datagram starts with kRobotStateDeltaMarker, which is the INVALID tag of the RobotToEngine
+ *              union and so can never start a single message, followed by a type byte and a sequence number.
+ *
+ *              A keyframe carries the packed RobotToEngine message verbatim. A delta carries the packed message
+ *              XORed with the previous one, as runs of [u8 number of zero bytes][u8 number of literal bytes][literal
+ *              bytes]. Unchanged fields, and the unchanged high-order bytes of fields that drift slowly, become
+ *              zero runs. The encoding is lossless, so the engine sees exactly the state the robot sent.
+ *
+ *              Keyframes are sent every keyframePeriod messages and whenever the encoder is told a send failed.
+ *              A decoder that sees a gap in the sequence (or has no keyframe yet) drops deltas until the next
+ *              keyframe. Anything not starting with the marker is a normal message, as before.
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#ifndef __Anki_Cozmo_RobotStateDelta_H__
+#define __Anki_Cozmo_RobotStateDelta_H__
+
+#include <stdint.h>
+
+#include <cstring>
+
+namespace Anki {
+namespace Vector {
+
+static const uint8_t  kRobotStateDeltaMarker = 0xFF;
+
+static const uint8_t  kRobotStateDeltaTypeKeyframe = 0;
+static const uint8_t  kRobotStateDeltaTypeDelta    = 1;
+
+static const uint32_t kRobotStateDeltaHeaderSize = 3;
+
+// Largest packed message the codec takes. RobotState packs to well under this
+static const uint32_t kRobotStateDeltaMaxMessageSize = 512;
+
+// Worst case, every byte differs and each run of 255 literal bytes costs two bytes of run header
+static const uint32_t kRobotStateDeltaMaxDatagramSize = kRobotStateDeltaHeaderSize + kRobotStateDeltaMaxMessageSize +
+                                                        2 * ((kRobotStateDeltaMaxMessageSize + 254) / 255);
+
+inline bool IsRobotStateDelta(const uint8_t* data, uint32_t size)
+{
+  return (size >= kRobotStateDeltaHeaderSize) && (data[0] == kRobotStateDeltaMarker);
+}
+
+class RobotStateDeltaEncoder
+{
+public:
+
+  explicit RobotStateDeltaEncoder(uint32_t keyframePeriod)
+  : _keyframePeriod(keyframePeriod)
+  {
+  }
+
+  // Encodes a packed RobotToEngine message. Returns the size of the datagram to send, or 0 if the message is too
+  // large for the codec, in which case send it as a normal message.
+  uint32_t Encode(const uint8_t* msg, uint32_t size)
+  {
+    if((size == 0) || (size > kRobotStateDeltaMaxMessageSize)) {
+      return 0;
+    }
+
+    const bool isKeyframe = (_prevSize != size) || (_numSinceKeyframe + 1 >= _keyframePeriod);
+
+    _datagram[0] = kRobotStateDeltaMarker;
+    _datagram[1] = isKeyframe ? kRobotStateDeltaTypeKeyframe : kRobotStateDeltaTypeDelta;
+    _datagram[2] = ++_sequence;
+    uint32_t datagramSize = kRobotStateDeltaHeaderSize;
+
+    if(isKeyframe) {
+      std::memcpy(_datagram + datagramSize, msg, size);
+      datagramSize += size;
+      _numSinceKeyframe = 0;
+    } else {
+      uint32_t i = 0;
+      while(i < size) {
+        uint8_t numZeros = 0;
+        while((i < size) && (numZeros < 255) && (msg[i] == _prev[i])) {
+          ++numZeros;
+          ++i;
+        }
+        uint8_t numLiterals = 0;
+        uint8_t* literals = _datagram + datagramSize + 2;
+        while((i < size) && (numLiterals < 255) && (msg[i] != _prev[i])) {
+          literals[numLiterals++] = msg[i] ^ _prev[i];
+          ++i;
+        }
+        _datagram[datagramSize]     = numZeros;
+        _datagram[datagramSize + 1] = numLiterals;
+        datagramSize += 2 + numLiterals;
+      }
+      ++_numSinceKeyframe;
+    }
+
+    std::memcpy(_prev, msg, size);
+    _prevSize = size;
+    _datagramSize = datagramSize;
+    return datagramSize;
+  }
+
+  // The last datagram Encode() produced
+  const uint8_t* GetDatagram()     const { return _datagram; }
+  uint32_t       GetDatagramSize() const { return _datagramSize; }
+
+  // Makes the next message a keyframe, e.g. because the last datagram was not sent or the peer reconnected
+  void RequestKeyframe() { _prevSize = 0; }
+
+private:
+
+  const uint32_t _keyframePeriod;
+  uint32_t _numSinceKeyframe = 0;
+  uint8_t  _sequence = 0;
+
+  uint8_t  _prev[kRobotStateDeltaMaxMessageSize];
+  uint32_t _prevSize = 0;
+
+  uint8_t  _datagram[kRobotStateDeltaMaxDatagramSize];
+  uint32_t _datagramSize = 0;
+};
+
+class RobotStateDeltaDecoder
+{
+public:
+
+  // Decodes a compact datagram into the packed RobotToEngine message it stands for. Returns false if the datagram is
+  // malformed, or is a delta without the message it applies to, in which case it should be dropped.
+  bool Decode(const uint8_t* data, uint32_t size)
+  {
+    if(!IsRobotStateDelta(data, size)) {
+      return false;
+    }
+
+    const uint8_t type     = data[1];
+    const uint8_t sequence = data[2];
+    const uint8_t* payload = data + kRobotStateDeltaHeaderSize;
+    const uint32_t payloadSize = size - kRobotStateDeltaHeaderSize;
+
+    if(type == kRobotStateDeltaTypeKeyframe) {
+      if((payloadSize == 0) || (payloadSize > kRobotStateDeltaMaxMessageSize)) {
+        _msgSize = 0;
+        return false;
+      }
+      std::memcpy(_msg, payload, payloadSize);
+      _msgSize = payloadSize;
+      _sequence = sequence;
+      return true;
+    }
+
+    // A delta only applies on top of the message right before it
+    if((type != kRobotStateDeltaTypeDelta) || (_msgSize == 0) || (sequence != static_cast<uint8_t>(_sequence + 1))) {
+      _msgSize = 0;
+      return false;
+    }
+
+    uint32_t offset = 0;
+    uint32_t i = 0;
+    while(offset < payloadSize) {
+      if(offset + 2 > payloadSize) {
+        _msgSize = 0;
+        return false;
+      }
+      const uint32_t numZeros    = payload[offset];
+      const uint32_t numLiterals = payload[offset + 1];
+      offset += 2;
+      if((offset + numLiterals > payloadSize) || (i + numZeros + numLiterals > _msgSize)) {
+        _msgSize = 0;
+        return false;
+      }
+      i += numZeros;
+      for(uint32_t j = 0; j < numLiterals; ++j) {
+        _msg[i++] ^= payload[offset++];
+      }
+    }
+
+    _sequence = sequence;
+    return true;
+  }
+
+  // The message the last successful Decode() produced
+  const uint8_t* GetMessage()     const { return _msg; }
+  uint32_t       GetMessageSize() const { return _msgSize; }
+
+private:
+
+  uint8_t  _msg[kRobotStateDeltaMaxMessageSize];
+  uint32_t _msgSize = 0;
+  uint8_t  _sequence = 0;
+};
+
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Anki_Cozmo_RobotStateDelta_H__
@@ -0,0 +1,225 @@
+#include "controlTimingStats.h"
+#include "anki/cozmo/robot/hal.h"
+#include "anki/cozmo/robot/logging.h"
+#include "anki/cozmo/robot/DAS.h"
+
+#include <stdio.h>
+#include <string.h>
+
+namespace Anki {
+namespace Vector {
+namespace ControlTimingStats {
+
+namespace {
+
+  // Durations are binned at this resolution, which is what the reported percentiles are accurate to.
+  // The last bin collects everything at or above (NUM_BINS-1)*BIN_WIDTH_USEC. Max is always exact.
+  const u32 BIN_WIDTH_USEC = 4;
+  const u32 NUM_BINS = 256;
+
+  const u32 REPORTING_PERIOD_USEC = 60000000;
+
+  // At most one overrun breakdown is logged per this period. The rest are still counted.
+  const u32 OVERRUN_LOG_PERIOD_USEC = 1000000;
+
+  const size_t NUM_SECTIONS = static_cast<size_t>(Section::Count);
+
+  const char* const SECTION_NAMES[NUM_SECTIONS] = {
+    "IMUFilter",
+    "ProxSensors",
+    "HeadController",
+    "LiftController",
+    "PathFollower",
+    "DockingController",
+    "SteeringController",
+    "WheelController",
+  };
+
+  struct SectionStats {
+    u32 histogram[NUM_BINS];
+    u32 max_usec;
+    u64 total_usec;
+    // Number of overrun ticks in which this was the slowest section
+    u32 numOverrunsSlowest;
+  };
+
+  SectionStats stats_[NUM_SECTIONS];
+
+  // Current tick
+  u32 sectionStartTime_usec_[NUM_SECTIONS] = {0};
+  u32 tickDuration_usec_[NUM_SECTIONS] = {0};
+
+  u32 numTicks_ = 0;
+  u32 numOverruns_ = 0;
+  u32 numOverrunLogsSuppressed_ = 0;
+
+  bool hasReportTime_ = false;
+  u32 nextReportTime_usec_ = 0;
+  u32 nextOverrunLogTime_usec_ = 0;
+
+  // True if time has reached deadline. Handles wraparound of the micro counter.
+  inline bool HasReached(u32 time_usec, u32 deadline_usec)
+  {
+    return static_cast<s32>(time_usec - deadline_usec) >= 0;
+  }
+
+  // Upper edge of the bin holding the given percentile, capped at the exact max.
+  // The last bin has no upper edge, so the max is returned for it.
+  u32 GetPercentile(const SectionStats& stats, u32 numSamples, f32 percentile)
+  {
+    if (numSamples == 0) {
+      return 0;
+    }
+    const u32 target = static_cast<u32>(percentile * static_cast<f32>(numSamples) + 0.5f);
+    u32 count = 0;
+    for (u32 bin = 0; bin < NUM_BINS; ++bin) {
+      count += stats.histogram[bin];
+      if (count >= target && count > 0 && bin < NUM_BINS - 1) {
+        const u32 upperEdge_usec = (bin + 1) * BIN_WIDTH_USEC;
+        return (upperEdge_usec < stats.max_usec ? upperEdge_usec : stats.max_usec);
+      }
+    }
+    return stats.max_usec;
+  }
+
+  void LogOverrun(u32 cycleTime_usec, u32 sectionsTotal_usec, size_t slowest)
+  {
+    char breakdown[256];
+    size_t len = 0;
+    for (size_t i = 0; i < NUM_SECTIONS && len < sizeof(breakdown); ++i) {
+      len += snprintf(breakdown + len, sizeof(breakdown) - len, "%s%s %u",
+                      (i == 0 ? "" : ", "), SECTION_NAMES[i], tickDuration_usec_[i]);
+    }
+
+    AnkiWarn("ControlTimingStats.Overrun",
+             "Tick took %u us, slowest: %s, untimed: %u us, sections (us): %s, suppressed since last: %u",
+             cycleTime_usec,
+             SECTION_NAMES[slowest],
+             (cycleTime_usec > sectionsTotal_usec ? cycleTime_usec - sectionsTotal_usec : 0),
+             breakdown,
+             numOverrunLogsSuppressed_);
+  }
+
+  void ResetPeriod()
+  {
+    memset(stats_, 0, sizeof(stats_));
+    numTicks_ = 0;
+    numOverruns_ = 0;
+  }
+
+  void Report()
+  {
+    char summary[256];
+    size_t len = 0;
+    size_t worstSection = 0;
+    u32 worstP99_usec = 0;
+    u32 worstMax_usec = 0;
+
+    for (size_t i = 0; i < NUM_SECTIONS; ++i) {
+      const SectionStats& stats = stats_[i];
+      const u32 p50_usec = GetPercentile(stats, numTicks_, 0.5f);
+      const u32 p90_usec = GetPercentile(stats, numTicks_, 0.9f);
+      const u32 p99_usec = GetPercentile(stats, numTicks_, 0.99f);
+      const u32 avg_usec = (numTicks_ > 0 ? static_cast<u32>(stats.total_usec / numTicks_) : 0);
+
+      AnkiInfo("ControlTimingStats.Section",
+               "%s: avg %u us, p50 %u us, p90 %u us, p99 %u us, max %u us, slowest in %u of %u overruns",
+               SECTION_NAMES[i], avg_usec, p50_usec, p90_usec, p99_usec, stats.max_usec,
+               stats.numOverrunsSlowest, numOverruns_);
+
+      if (len < sizeof(summary)) {
+        len += snprintf(summary + len, sizeof(summary) - len, "%s%s:%u/%u/%u",
+                        (i == 0 ? "" : ","), SECTION_NAMES[i], p50_usec, p99_usec, stats.max_usec);
+      }
+
+      if (p99_usec > worstP99_usec) {
+        worstP99_usec = p99_usec;
+        worstSection = i;
+      }
+      if (stats.max_usec > worstMax_usec) {
+        worstMax_usec = stats.max_usec;
+      }
+    }
+
+    DASMSG(vectorbot_control_timing,            "vectorbot.control_timing", "Report once/min of the time spent in each controller of the robot tick");
+    DASMSG_SET(s1, summary,                     "Per controller p50/p99/max durations (usec), comma separated");
+    DASMSG_SET(s2, SECTION_NAMES[worstSection], "Controller with the largest p99 duration");
+    DASMSG_SET(i1, numTicks_,                   "Number of ticks in the reporting period");
+    DASMSG_SET(i2, numOverruns_,                "Number of ticks that exceeded the too long threshold");
+    DASMSG_SET(i3, worstP99_usec,               "Largest p99 duration of any controller (usec)");
+    DASMSG_SET(i4, worstMax_usec,               "Largest max duration of any controller (usec)");
+    DASMSG_SEND();
+  }
+
+} // "private" members
+
+
+void Reset()
+{
+  ResetPeriod();
+  memset(tickDuration_usec_, 0, sizeof(tickDuration_usec_));
+  numOverrunLogsSuppressed_ = 0;
+  hasReportTime_ = false;
+}
+
+void StartSection(Section section)
+{
+  sectionStartTime_usec_[static_cast<size_t>(section)] = HAL::GetMicroCounter();
+}
+
+void EndSection(Section section)
+{
+  const size_t i = static_cast<size_t>(section);
+  tickDuration_usec_[i] += HAL::GetMicroCounter() - sectionStartTime_usec_[i];
+}
+
+void EndTick(u32 cycleStartTime_usec, u32 cycleEndTime_usec, bool isOverrun)
+{
+  if (!hasReportTime_) {
+    nextReportTime_usec_ = cycleEndTime_usec + REPORTING_PERIOD_USEC;
+    nextOverrunLogTime_usec_ = cycleEndTime_usec;
+    hasReportTime_ = true;
+  }
+
+  ++numTicks_;
+  u32 sectionsTotal_usec = 0;
+  size_t slowest = 0;
+  for (size_t i = 0; i < NUM_SECTIONS; ++i) {
+    const u32 duration_usec = tickDuration_usec_[i];
+    SectionStats& stats = stats_[i];
+    const u32 bin = duration_usec / BIN_WIDTH_USEC;
+    ++stats.histogram[bin < NUM_BINS ? bin : NUM_BINS - 1];
+    stats.total_usec += duration_usec;
+    if (duration_usec > stats.max_usec) {
+      stats.max_usec = duration_usec;
+    }
+    if (duration_usec > tickDuration_usec_[slowest]) {
+      slowest = i;
+    }
+    sectionsTotal_usec += duration_usec;
+  }
+
+  if (isOverrun) {
+    ++numOverruns_;
+    ++stats_[slowest].numOverrunsSlowest;
+    if (HasReached(cycleEndTime_usec, nextOverrunLogTime_usec_)) {
+      LogOverrun(cycleEndTime_usec - cycleStartTime_usec, sectionsTotal_usec, slowest);
+      numOverrunLogsSuppressed_ = 0;
+      nextOverrunLogTime_usec_ = cycleEndTime_usec + OVERRUN_LOG_PERIOD_USEC;
+    } else {
+      ++numOverrunLogsSuppressed_;
+    }
+  }
+
+  memset(tickDuration_usec_, 0, sizeof(tickDuration_usec_));
+
+  if (HasReached(cycleEndTime_usec, nextReportTime_usec_)) {
+    Report();
+    ResetPeriod();
+    nextReportTime_usec_ = cycleEndTime_usec + REPORTING_PERIOD_USEC;
+  }
+}
+
+} // namespace ControlTimingStats
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,74 @@
+/**
+ * File: controlTimingStats.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description:
+ *
+ *   Always-on timing of the individual controllers in the main execution tick.
+ *   Keeps a per-controller histogram of durations over each reporting period, from which
+ *   percentiles are reported along with the exact max. Ticks which run too long are logged
+ *   with the duration of every section in that tick, so that overruns can be attributed.
+ *
+ * Usage:
+ *   { ControlTimingStats::ScopedSection s(ControlTimingStats::Section::IMUFilter); IMUFilter::Update(); }
+ *   ...
+ *   ControlTimingStats::EndTick(cycleStartTime_usec, cycleEndTime_usec, isOverrun);
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef COZMO_CONTROL_TIMING_STATS_H_
+#define COZMO_CONTROL_TIMING_STATS_H_
+
+#include "coretech/common/shared/types.h"
+
+namespace Anki {
+  namespace Vector {
+    namespace ControlTimingStats {
+
+      enum class Section : u8 {
+        IMUFilter = 0,
+        ProxSensors,
+        HeadController,
+        LiftController,
+        PathFollower,
+        DockingController,
+        SteeringController,
+        WheelController,
+        Count
+      };
+
+      // Clears all accumulated stats and starts a new reporting period
+      void Reset();
+
+      // Marks the start/end of section for the current tick. A section may be entered
+      // more than once per tick, in which case its durations are summed.
+      void StartSection(Section section);
+      void EndSection(Section section);
+
+      // Call once at the end of every tick, after all sections have ended.
+      // If isOverrun, the section breakdown of this tick is logged (rate limited).
+      // Periodically logs and sends the accumulated stats to DAS and resets them.
+      void EndTick(u32 cycleStartTime_usec, u32 cycleEndTime_usec, bool isOverrun);
+
+      class ScopedSection
+      {
+      public:
+        explicit ScopedSection(Section section) : _section(section) { StartSection(_section); }
+        ~ScopedSection() { EndSection(_section); }
+
+        ScopedSection(const ScopedSection&) = delete;
+        ScopedSection& operator=(const ScopedSection&) = delete;
+
+      private:
+        const Section _section;
+      };
+
+    } // namespace ControlTimingStats
+  } // namespace Vector
+} // namespace Anki
+
+#endif // COZMO_CONTROL_TIMING_STATS_H_
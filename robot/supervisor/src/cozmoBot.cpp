@@ -13,6 +13,7 @@
 #include "platform/anki-trace/tracing.h"
 
 #include "backpackLightController.h"
+#include "controlTimingStats.h"
 #include "dockingController.h"
 #include "liftController.h"
 #include "localization.h"
@@ -187,6 +188,8 @@ namespace Anki {
         lastResult = LiftController::Init();
         AnkiConditionalErrorAndReturnValue(lastResult == RESULT_OK, lastResult, "CozmoBot.InitFail.LiftController", "");
 
+        ControlTimingStats::Reset();
+
         // Calibrate motors
         const bool autoStarted = true;
         const auto reason = MotorCalibrationReason::Startup;
@@ -569,29 +572,53 @@ namespace Anki {
         // Sensor updates
         //////////////////////////////////////////////////////////////
         MARK_NEXT_TIME_PROFILE(CozmoBot, IMU);
-        IMUFilter::Update();
-        ProxSensors::Update();
+        {
+          ControlTimingStats::ScopedSection s(ControlTimingStats::Section::IMUFilter);
+          IMUFilter::Update();
+        }
+        {
+          ControlTimingStats::ScopedSection s(ControlTimingStats::Section::ProxSensors);
+          ProxSensors::Update();
+        }
 
         //////////////////////////////////////////////////////////////
         // Head & Lift Position Updates
         //////////////////////////////////////////////////////////////
 
         MARK_NEXT_TIME_PROFILE(CozmoBot, EYEHEADLIFT);
-        HeadController::Update();
-        LiftController::Update();
+        {
+          ControlTimingStats::ScopedSection s(ControlTimingStats::Section::HeadController);
+          HeadController::Update();
+        }
+        {
+          ControlTimingStats::ScopedSection s(ControlTimingStats::Section::LiftController);
+          LiftController::Update();
+        }
 
         MARK_NEXT_TIME_PROFILE(CozmoBot, LIGHTS);
         BackpackLightController::Update();
 
         MARK_NEXT_TIME_PROFILE(CozmoBot, PATHDOCK);
-        PathFollower::Update();
+        {
+          ControlTimingStats::ScopedSection s(ControlTimingStats::Section::PathFollower);
+          PathFollower::Update();
+        }
         PickAndPlaceController::Update();
-        DockingController::Update();
+        {
+          ControlTimingStats::ScopedSection s(ControlTimingStats::Section::DockingController);
+          DockingController::Update();
+        }
 
         // Manage the various motion controllers:
         SpeedController::Manage();
-        SteeringController::Manage();
-        WheelController::Manage();
+        {
+          ControlTimingStats::ScopedSection s(ControlTimingStats::Section::SteeringController);
+          SteeringController::Manage();
+        }
+        {
+          ControlTimingStats::ScopedSection s(ControlTimingStats::Section::WheelController);
+          WheelController::Manage();
+        }
 
         //////////////////////////////////////////////////////////////
         // Power management
@@ -631,7 +658,9 @@ namespace Anki {
         u32 cycleEndTime = HAL::GetMicroCounter();
         u32 cycleTime = cycleEndTime - cycleStartTime;
         tracepoint(anki_ust, vic_robot_loop_duration, cycleTime);
-        if (cycleTime > MAIN_TOO_LONG_TIME_THRESH_USEC) {
+        const bool isCycleTooLong = (cycleTime > MAIN_TOO_LONG_TIME_THRESH_USEC);
+        ControlTimingStats::EndTick(cycleStartTime, cycleEndTime, isCycleTooLong);
+        if (isCycleTooLong) {
           EventStart(EventType::MAIN_CYCLE_TOO_LONG);
           ++mainTooLongCnt_;
           EventStop(EventType::MAIN_CYCLE_TOO_LONG);
@@ -0,0 +1,71 @@
+#include "imuBatch.h"
+#include "trig_fast.h"
+
+#include <math.h>
+
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
+namespace Anki {
+namespace Vector {
+namespace IMUFilter {
+
+HeadAngleTrig::HeadAngleTrig(f32 headAngle)
+: angle(headAngle)
+, cosAngle(cosf(headAngle))
+, sinAngle(sinf(headAngle))
+, tanAngle(tanf(headAngle))
+{
+}
+
+void ComputeBatchAccel(const HeadAngleTrig& head, IMUBatch& batch)
+{
+  const int n = batch.numSamples;
+  const f32* ax = batch.accel[0];
+  const f32* ay = batch.accel[1];
+  const f32* az = batch.accel[2];
+
+  // Rotating the XZ components of acceleration by the head angle is equivalent to
+  // (magnitude, angle) = (hypot(ax,az), atan2(az,ax)) followed by converting back with cos/sin of (angle + head)
+  f32 rollDenominator[MAX_IMU_BATCH_SIZE];
+  int i = 0;
+
+#ifdef __ARM_NEON__
+  for (; i <= n - 4; i += 4) {
+    const float32x4_t x = vld1q_f32(ax + i);
+    const float32x4_t y = vld1q_f32(ay + i);
+    const float32x4_t z = vld1q_f32(az + i);
+
+    vst1q_f32(batch.accelRobotFrame[0] + i, vmlsq_n_f32(vmulq_n_f32(x, head.cosAngle), z, head.sinAngle));
+    vst1q_f32(batch.accelRobotFrame[1] + i, y);
+    vst1q_f32(batch.accelRobotFrame[2] + i, vmlaq_n_f32(vmulq_n_f32(z, head.cosAngle), x, head.sinAngle));
+
+    float32x4_t magSqrd = vmulq_f32(x, x);
+    magSqrd = vmlaq_f32(magSqrd, y, y);
+    magSqrd = vmlaq_f32(magSqrd, z, z);
+    vst1q_f32(batch.accelMagnitudeSqrd + i, magSqrd);
+
+    vst1q_f32(rollDenominator + i, vmulq_n_f32(z, head.cosAngle));
+  }
+#endif
+
+  for (; i < n; ++i) {
+    batch.accelRobotFrame[0][i] = ax[i] * head.cosAngle - az[i] * head.sinAngle;
+    batch.accelRobotFrame[1][i] = ay[i];
+    batch.accelRobotFrame[2][i] = az[i] * head.cosAngle + ax[i] * head.sinAngle;
+    batch.accelMagnitudeSqrd[i] = ax[i] * ax[i] + ay[i] * ay[i] + az[i] * az[i];
+    rollDenominator[i] = az[i] * head.cosAngle;
+  }
+
+  atan2_poly_array(ax, az, batch.accelBasedPitch, n);
+  atan2_poly_array(ay, rollDenominator, batch.accelBasedRoll, n);
+
+  for (i = 0; i < n; ++i) {
+    batch.accelBasedPitch[i] -= head.angle;
+  }
+}
+
+} // namespace IMUFilter
+} // namespace Vector
+} // namespace Anki
@@ -0,0 +1,63 @@
+/**
+ * File: imuBatch.h
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description:
+ *
+ *   Batched front end of IMUFilter. The accelerometer quantities which only depend on the raw sample
+ *   and the head angle (robot frame acceleration, magnitude and accel based pitch and roll) are computed
+ *   for all the IMU samples read in a tick in one pass, so that the serial part of the filter only has
+ *   to do its IIR updates and detection logic per sample.
+ *   Kept free of HAL and controller dependencies so that it can be benchmarked off the robot.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef IMU_BATCH_H_
+#define IMU_BATCH_H_
+
+#include "coretech/common/shared/types.h"
+
+namespace Anki {
+  namespace Vector {
+    namespace IMUFilter {
+
+      // Most samples processed in one pass. The HAL buffers fewer than this between ticks,
+      // and anything beyond it is simply processed in another batch.
+      const int MAX_IMU_BATCH_SIZE = 8;
+
+      // Trig of the head angle, which is constant over a tick and so over every sample in a batch
+      struct HeadAngleTrig {
+        explicit HeadAngleTrig(f32 headAngle);
+
+        f32 angle;
+        f32 cosAngle;
+        f32 sinAngle;
+        f32 tanAngle;
+      };
+
+      // Structure-of-arrays so that samples can be processed a vector at a time
+      struct IMUBatch {
+        int numSamples = 0;
+
+        // Input: raw accelerometer data in IMU frame (mm/s^2)
+        f32 accel[3][MAX_IMU_BATCH_SIZE];
+
+        // Outputs of ComputeBatchAccel()
+        f32 accelRobotFrame[3][MAX_IMU_BATCH_SIZE];   // mm/s^2
+        f32 accelMagnitudeSqrd[MAX_IMU_BATCH_SIZE];   // (mm/s^2)^2
+        f32 accelBasedPitch[MAX_IMU_BATCH_SIZE];      // rad, pitch of gravity wrt robot body
+        f32 accelBasedRoll[MAX_IMU_BATCH_SIZE];       // rad, roll of gravity wrt robot body
+      };
+
+      // Fills in all outputs of batch for its first numSamples inputs
+      void ComputeBatchAccel(const HeadAngleTrig& head, IMUBatch& batch);
+
+    } // namespace IMUFilter
+  } // namespace Vector
+} // namespace Anki
+
+#endif // IMU_BATCH_H_
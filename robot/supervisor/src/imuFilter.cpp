@@ -16,6 +16,7 @@
 
 #include "trig_fast.h"
 #include "imuFilter.h"
+#include "imuBatch.h"
 #include <math.h>
 #include "headController.h"
 #include "liftController.h"
@@ -56,6 +57,10 @@ namespace Anki {
         // Last read IMU data
         HAL::IMU_DataStructure imu_data_;
 
+        // IMU data read in the current tick, and the accelerometer quantities computed from it up front
+        HAL::IMU_DataStructure imuBatchData_[MAX_IMU_BATCH_SIZE];
+        IMUBatch imuBatch_;
+
         // Orientation and speed in XY-plane (i.e. horizontal plane) of robot
         Radians rot_ = 0;   // radians
         f32 rotSpeed_ = 0; // rad/s
@@ -871,12 +876,9 @@ namespace Anki {
 
       // This pitch measurement isn't precise to begin with, but it's extra imprecise when the head is moving
       // so be careful relying on it when the head is moving!
-      void UpdatePitch()
+      void UpdatePitch(const f32 headAngle, const f32 accelBasedPitch)
       {
-        f32 headAngle = HeadController::GetAngleRad();
-
         if (prevHeadAngle_ != UNINIT_HEAD_ANGLE) {
-          const f32 accelBasedPitch = atan2f(imu_data_.accel[0], imu_data_.accel[2]) - headAngle;
           const f32 gyroBasedPitch = pitch_ - (gyro_robot_frame[1] * CONTROL_DT) - (headAngle - prevHeadAngle_);
 
           // Complementary filter to mostly trust gyro integration for current pitch in the short term
@@ -894,10 +896,8 @@ namespace Anki {
         //AnkiDebugPeriodic(50, "RobotPitch", "%f deg (motion %d, gyro %f)", RAD_TO_DEG_F32(pitch_), MotionDetected(), gyro_robot_frame_filt[1]);
       }
 
-      void UpdateRoll()
+      void UpdateRoll(const f32 accelBasedRoll)
       {
-        const f32 headAngle = HeadController::GetAngleRad();
-        const f32 accelBasedRoll = atan2f(imu_data_.accel[1], imu_data_.accel[2] * cosf(headAngle));
         const f32 gyroBasedRoll = roll_ - (gyro_robot_frame[0] * CONTROL_DT);
 
         // Complementary filter to mostly trust gyro integration for current roll in the short term
@@ -913,13 +913,10 @@ namespace Anki {
 //                         isMoving);
       }
 
-      Result Update()
+      // Serial part of the filter update for sample k of imuBatch_, which ComputeBatchAccel() has already been run on
+      void UpdateSample(const int k, const HeadAngleTrig& head)
       {
-        Result retVal = RESULT_OK;
-
-        // Get IMU data
-        // NB: Only call IMUReadData once per mainExecution tic!
-        while (HAL::IMUReadData(imu_data_)) {
+        imu_data_ = imuBatchData_[k];
 
         // IMU temperature-induced bias correction
         //
@@ -971,17 +968,13 @@ namespace Anki {
           pitch_ = 0.f;
           prevHeadAngle_ = UNINIT_HEAD_ANGLE;
           ResetPickupVars();
-          return retVal;
+          return;
         }
 
         if (!IsBiasFilterComplete()) {
-          return retVal;
+          return;
         }
 
-        // Compute head angle wrt to world horizontal plane
-        const f32 headAngle = HeadController::GetAngleRad();  // TODO: Use encoders or accelerometer data? If encoders,
-                                                              // may need to use accelerometer data anyway for when it's on ramps.
-
         // Compute rotation speeds in robot XY-plane.
         // https://www.chrobotics.com/library/understanding-euler-angles
         // http://ocw.mit.edu/courses/mechanical-engineering/2-017j-design-of-electromechanical-robotic-systems-fall-2009/course-text/MIT2_017JF09_ch09.pdf
@@ -996,9 +989,9 @@ namespace Anki {
         // In our case, we only care about yaw. In other words, it's always true that r = y = 0.
         // (NOTE: This is true as long as we don't start turning on ramps!!!)
         // So the result simplifies to...
-        gyro_robot_frame[0] = gyro_[0] + gyro_[2] * tanf(headAngle);
+        gyro_robot_frame[0] = gyro_[0] + gyro_[2] * head.tanAngle;
         gyro_robot_frame[1] = gyro_[1];
-        gyro_robot_frame[2] = gyro_[2] / cosf(headAngle);
+        gyro_robot_frame[2] = gyro_[2] / head.cosAngle;
         // TODO: We actually only care about gyro_robot_frame_filt[2]. Any point in computing the others?
 
         for(u8 i = 0; i < 3; ++i)
@@ -1014,14 +1007,10 @@ namespace Anki {
 
         LowPassFilter(accel_filt, imu_data_.accel, ACCEL_FILT_COEFF);
 
-        // Compute accelerations in robot frame
-        const f32 xzAccelMagnitude = std::hypot(imu_data_.accel[0], imu_data_.accel[2]);
-        const f32 accel_angle_imu_frame = atan2_fast(imu_data_.accel[2], imu_data_.accel[0]);
-        const f32 accel_angle_robot_frame = accel_angle_imu_frame + headAngle;
-
-        accel_robot_frame[0] = xzAccelMagnitude * cosf(accel_angle_robot_frame);
-        accel_robot_frame[1] = imu_data_.accel[1];
-        accel_robot_frame[2] = xzAccelMagnitude * sinf(accel_angle_robot_frame);
+        // Accelerations in robot frame
+        for (int i=0 ; i<3 ; i++) {
+          accel_robot_frame[i] = imuBatch_.accelRobotFrame[i][k];
+        }
 
 
         f32 prev_accel_robot_frame_filt[3] = { accel_robot_frame_filt[0],
@@ -1035,22 +1024,20 @@ namespace Anki {
         HighPassFilter(accel_robot_frame_high_pass, accel_robot_frame_filt, prev_accel_robot_frame_filt, HP_ACCEL_FILT_COEFF);
 
         // Absolute values (fall-detection)
-        accelMagnitudeSqrd_ = 0;
+        accelMagnitudeSqrd_ = imuBatch_.accelMagnitudeSqrd[k];
         for (int i=0 ; i<3 ; i++) {
           abs_accel_robot_frame_filt[i] = ABS(accel_robot_frame_filt[i]);
-          accelMagnitudeSqrd_ += (imu_data_.accel[i] * imu_data_.accel[i]);
         }
 
 #if(DEBUG_IMU_FILTER)
-        PERIODIC_PRINT(200, "Accel angle %f %f\n", accel_angle_imu_frame, accel_angle_robot_frame);
         PERIODIC_PRINT(200, "Accel (robot frame): %f %f %f\n",
                        accel_robot_frame_filt[0],
                        accel_robot_frame_filt[1],
                        accel_robot_frame_filt[2]);
 #endif
 
-        UpdatePitch();
-        UpdateRoll();
+        UpdatePitch(head.angle, imuBatch_.accelBasedPitch[k]);
+        UpdateRoll(imuBatch_.accelBasedRoll[k]);
 
         // XY-plane rotation rate is robot frame z-axis rotation rate
         rotSpeed_ = gyro_robot_frame_filt[2];
@@ -1126,9 +1113,35 @@ namespace Anki {
 
         }
 
-        } // while (HAL::IMUReadData())
+      } // UpdateSample()
+
+      Result Update()
+      {
+        // Compute head angle wrt to world horizontal plane. It doesn't change during this update, so its trig is shared by every sample.
+        const HeadAngleTrig head(HeadController::GetAngleRad());  // TODO: Use encoders or accelerometer data? If encoders,
+                                                                  // may need to use accelerometer data anyway for when it's on ramps.
 
-        return retVal;
+        // Get IMU data
+        // NB: Only call IMUReadData once per mainExecution tic!
+        bool moreData = true;
+        while (moreData) {
+          imuBatch_.numSamples = 0;
+          while (imuBatch_.numSamples < MAX_IMU_BATCH_SIZE && HAL::IMUReadData(imuBatchData_[imuBatch_.numSamples])) {
+            for (int i=0 ; i<3 ; i++) {
+              imuBatch_.accel[i][imuBatch_.numSamples] = imuBatchData_[imuBatch_.numSamples].accel[i];
+            }
+            ++imuBatch_.numSamples;
+          }
+          moreData = (imuBatch_.numSamples == MAX_IMU_BATCH_SIZE);
+
+          ComputeBatchAccel(head, imuBatch_);
+
+          for (int k=0 ; k<imuBatch_.numSamples ; k++) {
+            UpdateSample(k, head);
+          }
+        }
+
+        return RESULT_OK;
 
       } // Update()
 
@@ -1,6 +1,8 @@
 #include "messages.h"
 #include "anki/cozmo/robot/cozmoBot.h"
 #include "anki/cozmo/robot/hal.h"
+#include "anki/cozmo/shared/cozmoConfig.h"
+#include "anki/cozmo/shared/robotStateDelta.h"
 #include <math.h>
 
 #include "clad/robotInterface/messageRobotToEngine.h"
@@ -40,6 +42,10 @@ namespace Anki {
 
         static RobotState robotState_;
 
+        // Packs robotState_ for the delta encoder
+        RobotInterface::RobotToEngine robotStateMsg_;
+        RobotStateDeltaEncoder robotStateEncoder_(ROBOT_STATE_KEYFRAME_PERIOD);
+
         // Flag for receipt of sync message
         bool syncRobotReceived_ = false;
         bool syncRobotAckSent_ = false;
@@ -645,7 +651,24 @@ namespace Anki {
         }
 
 
-        if(RobotInterface::SendMessage(robotState_) == true) {
+        bool sent = false;
+        uint32_t compactSize = 0;
+        if (ROBOT_STATE_DELTA_ENCODING_ENABLED) {
+          robotStateMsg_.tag = RobotInterface::RobotToEngine::Tag_state;
+          robotStateMsg_.state = robotState_;
+          compactSize = robotStateEncoder_.Encode(robotStateMsg_.GetBuffer(), robotStateMsg_.Size());
+        }
+        if (compactSize > 0) {
+          sent = HAL::RadioSendPacket(robotStateEncoder_.GetDatagram(), compactSize);
+          if (!sent) {
+            // The anim process and engine now have a stale reference for the next delta
+            robotStateEncoder_.RequestKeyframe();
+          }
+        } else {
+          sent = RobotInterface::SendMessage(robotState_);
+        }
+
+        if(sent) {
           #ifdef SIMULATOR
           {
             isForcedDelocalizing_ = false;
@@ -738,6 +761,7 @@ namespace Anki {
       {
         syncRobotReceived_ = false;
         syncRobotAckSent_ = false;
+        robotStateEncoder_.RequestKeyframe();
       }
 
     } // namespace Messages
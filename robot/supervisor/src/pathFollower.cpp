@@ -9,6 +9,7 @@
 #include <float.h>
 #include "trig_fast.h"
 #include "velocityProfileGenerator.h"
+#include "coretech/planning/shared/pathSegmentLookup.h"
 #include "anki/cozmo/robot/logging.h"
 #include "anki/cozmo/robot/hal.h"
 #include "clad/robotInterface/messageRobotToEngine.h"
@@ -49,6 +50,9 @@ namespace Anki
         s8 currPathSegment_ = -1;  // Segment index within local path array.
         s8 realPathSegment_ = -1;  // Segment index of the global path. Reset only on StartPathTraversal().
 
+        // Precomputed geometry of path_[currPathSegment_], set whenever currPathSegment_ moves to a new segment
+        Planning::PathSegmentLookup currSegmentLookup_;
+
         // Shortest distance to path
         f32 distToPath_mm_ = 0;
 
@@ -247,6 +251,7 @@ namespace Anki
 
           currPathSegment_ = 0;
           realPathSegment_ = currPathSegment_;
+          currSegmentLookup_.Set(path_[currPathSegment_]);
           startedDecelOnSegment_ = false;
 
 
@@ -316,7 +321,7 @@ namespace Anki
           }
         }
 
-        Planning::SegmentRangeStatus status = path_[currPathSegment_].GetDistToSegment(lookaheadX,lookaheadY,angle.ToFloat(),shortestDistanceToPath_mm,radDiff, &distToEnd);
+        Planning::SegmentRangeStatus status = currSegmentLookup_.GetDistToSegment(lookaheadX,lookaheadY,angle.ToFloat(),shortestDistanceToPath_mm,radDiff, &distToEnd);
 
         // If this is the last segment or the next segment is a point turn we need to
         // (1) check if the lookahead point is out of range and if so, use the
@@ -329,7 +334,7 @@ namespace Anki
           if (status == Planning::OOR_NEAR_END) {
             if (LOOK_AHEAD_DIST_MM != 0) {
               f32 junk_mm, junk_rad;
-              status = path_[currPathSegment_].GetDistToSegment(x,y,angle.ToFloat(),junk_mm, junk_rad, &distToEnd);
+              status = currSegmentLookup_.GetDistToSegment(x,y,angle.ToFloat(),junk_mm, junk_rad, &distToEnd);
               //PRINT("PATH-OOR: status %d (distToEnd %f, currCmdSpeed %d mm/s, currSpeed %d mm/s)\n", status, distToEnd, (s32)
               //      SpeedController::GetUserCommandedCurrentVehicleSpeed(), (s32)SpeedController::GetCurrentMeasuredVehicleSpeed());
             }
@@ -471,6 +476,7 @@ namespace Anki
             return RESULT_OK;
           }
           ++realPathSegment_;
+          currSegmentLookup_.Set(path_[currPathSegment_]);
           startedDecelOnSegment_ = false;
 
           // Command new speed for segment
@@ -18,6 +18,10 @@
 #include "trig_fast.h"
 #include "anki/cozmo/robot/logging.h"
 
+#ifdef __ARM_NEON__
+#include <arm_neon.h>
+#endif
+
 // For larger input values to atan, use approximations
 // at fixed steps. (Essentially extends the LUT with courser
 // resolution at higher input values.)
@@ -285,3 +289,87 @@ float atan2_acc(float y, float x)
   return -M_PI_2_F;
   //}
 }
+
+// Odd minimax polynomial for atan(a) on [0,1]. Larger ratios are folded into this range
+// using atan(a) = pi/2 - atan(1/a), and the quadrant is restored from the signs of the inputs.
+#define ATAN_POLY_C1  0.99997726f
+#define ATAN_POLY_C3 -0.33262347f
+#define ATAN_POLY_C5  0.19354346f
+#define ATAN_POLY_C7 -0.11643287f
+#define ATAN_POLY_C9  0.05265332f
+#define ATAN_POLY_C11 -0.01172120f
+
+float atan2_poly(float y, float x)
+{
+  const float absx = ABS(x);
+  const float absy = ABS(y);
+  const float maxAbs = MAX(absx, absy);
+  if (maxAbs == 0) {
+    return 0;
+  }
+
+  const float a = MIN(absx, absy) / maxAbs;
+  const float s = a*a;
+  float res = a * (ATAN_POLY_C1 + s * (ATAN_POLY_C3 + s * (ATAN_POLY_C5 +
+                   s * (ATAN_POLY_C7 + s * (ATAN_POLY_C9 + s * ATAN_POLY_C11)))));
+
+  if (absy > absx) {
+    res = M_PI_2_F - res;
+  }
+  if (x < 0) {
+    res = M_PI_F - res;
+  }
+  // Sign bit rather than y < 0, so that like atan2 -0 gives -pi rather than pi for x < 0
+  if (signbit(y)) {
+    res = -res;
+  }
+  return res;
+}
+
+void atan2_poly_array(const float* y, const float* x, float* out, int n)
+{
+  int i = 0;
+
+#ifdef __ARM_NEON__
+  const float32x4_t zero = vdupq_n_f32(0.f);
+  const float32x4_t halfPi = vdupq_n_f32(M_PI_2_F);
+  const float32x4_t pi = vdupq_n_f32(M_PI_F);
+  const uint32x4_t signMask = vdupq_n_u32(0x80000000);
+  for (; i <= n - 4; i += 4) {
+    const float32x4_t yv = vld1q_f32(y + i);
+    const float32x4_t xv = vld1q_f32(x + i);
+    const float32x4_t absx = vabsq_f32(xv);
+    const float32x4_t absy = vabsq_f32(yv);
+    const float32x4_t maxAbs = vmaxq_f32(absx, absy);
+
+    // Reciprocal estimate refined with two Newton-Raphson steps. Lanes where both inputs are 0
+    // would be 0 * inf, so they are forced to 0 like the scalar version.
+    float32x4_t invMax = vrecpeq_f32(maxAbs);
+    invMax = vmulq_f32(vrecpsq_f32(maxAbs, invMax), invMax);
+    invMax = vmulq_f32(vrecpsq_f32(maxAbs, invMax), invMax);
+    float32x4_t a = vmulq_f32(vminq_f32(absx, absy), invMax);
+    a = vbslq_f32(vcgtq_f32(maxAbs, zero), a, zero);
+
+    const float32x4_t s = vmulq_f32(a, a);
+    float32x4_t poly = vmlaq_n_f32(vdupq_n_f32(ATAN_POLY_C9), s, ATAN_POLY_C11);
+    poly = vmlaq_f32(vdupq_n_f32(ATAN_POLY_C7), s, poly);
+    poly = vmlaq_f32(vdupq_n_f32(ATAN_POLY_C5), s, poly);
+    poly = vmlaq_f32(vdupq_n_f32(ATAN_POLY_C3), s, poly);
+    poly = vmlaq_f32(vdupq_n_f32(ATAN_POLY_C1), s, poly);
+    float32x4_t res = vmulq_f32(a, poly);
+
+    res = vbslq_f32(vcgtq_f32(absy, absx), vsubq_f32(halfPi, res), res);
+    res = vbslq_f32(vcltq_f32(xv, zero), vsubq_f32(pi, res), res);
+
+    // Negate where y is negative by copying its sign bit
+    const uint32x4_t signY = vandq_u32(vreinterpretq_u32_f32(yv), signMask);
+    res = vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(res), signY));
+
+    vst1q_f32(out + i, res);
+  }
+#endif
+
+  for (; i < n; ++i) {
+    out[i] = atan2_poly(y[i], x[i]);
+  }
+}
@@ -39,4 +39,13 @@ float atan2_fast(float y, float x);
 // returns answer in radians
 float atan2_acc(float y, float x);
 
+// Arctangent function based on a minimax polynomial
+// Error is less than +/- 3e-6, so unlike atan2_fast it can stand in for atan2 from math.h.
+// returns answer in radians, and 0 when both inputs are 0
+float atan2_poly(float y, float x);
+
+// atan2_poly of n pairs of inputs: out[i] = atan2_poly(y[i], x[i])
+// Uses NEON when available to process 4 inputs at a time
+void atan2_poly_array(const float* y, const float* x, float* out, int n);
+
 #endif
@@ -0,0 +1,183 @@
+/**
+ * File: imu_batch_bench.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Replays a recorded IMU log (imuRawLog_*.dat, as written by the engine from IMURawDataChunk
+ *              messages) through IMUFilter's batched accelerometer front end and through the per sample trig
+ *              it replaced, and reports the time per sample of each along with the largest difference in
+ *              their outputs, at a few head angles.
+ *
+ *              Usage: imu_batch_bench <imuRawLog.dat> [batchSize]
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "imuBatch.h"
+#include "trig_fast.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+using namespace Anki::Vector::IMUFilter;
+
+namespace {
+
+  struct Sample {
+    f32 accel[3];
+  };
+
+  struct Outputs {
+    f32 accelRobotFrame[3];
+    f32 accelMagnitudeSqrd;
+    f32 accelBasedPitch;
+    f32 accelBasedRoll;
+  };
+
+  // Number of times the log is replayed for timing
+  const int NUM_REPETITIONS = 200;
+
+  bool LoadLog(const char* filename, std::vector<Sample>& samples)
+  {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+      return false;
+    }
+
+    std::string line;
+    std::getline(file, line); // header: timestamp aX aY aZ gX gY gZ
+    while (std::getline(file, line)) {
+      std::istringstream ss(line);
+      f32 timestamp;
+      Sample sample;
+      if (ss >> timestamp >> sample.accel[0] >> sample.accel[1] >> sample.accel[2]) {
+        samples.push_back(sample);
+      }
+    }
+    return !samples.empty();
+  }
+
+  // What IMUFilter::Update() computed for every sample before batching
+  void ComputeReference(const std::vector<Sample>& samples, f32 headAngle, std::vector<Outputs>& outputs)
+  {
+    for (size_t i = 0; i < samples.size(); ++i) {
+      const f32* accel = samples[i].accel;
+      Outputs& out = outputs[i];
+
+      const f32 xzAccelMagnitude = std::hypot(accel[0], accel[2]);
+      const f32 accel_angle_imu_frame = atan2_fast(accel[2], accel[0]);
+      const f32 accel_angle_robot_frame = accel_angle_imu_frame + headAngle;
+      out.accelRobotFrame[0] = xzAccelMagnitude * cosf(accel_angle_robot_frame);
+      out.accelRobotFrame[1] = accel[1];
+      out.accelRobotFrame[2] = xzAccelMagnitude * sinf(accel_angle_robot_frame);
+
+      out.accelMagnitudeSqrd = 0;
+      for (int j = 0; j < 3; ++j) {
+        out.accelMagnitudeSqrd += accel[j] * accel[j];
+      }
+
+      out.accelBasedPitch = atan2f(accel[0], accel[2]) - headAngle;
+      out.accelBasedRoll = atan2f(accel[1], accel[2] * cosf(headAngle));
+    }
+  }
+
+  void ComputeBatched(const std::vector<Sample>& samples, f32 headAngle, int batchSize, std::vector<Outputs>& outputs)
+  {
+    // Like IMUFilter::Update(), head angle trig is done once per tick, i.e. once per batch
+    IMUBatch batch;
+    for (size_t start = 0; start < samples.size(); start += batchSize) {
+      const HeadAngleTrig head(headAngle);
+      batch.numSamples = (int) std::min(samples.size() - start, (size_t) batchSize);
+      for (int k = 0; k < batch.numSamples; ++k) {
+        for (int j = 0; j < 3; ++j) {
+          batch.accel[j][k] = samples[start + k].accel[j];
+        }
+      }
+
+      ComputeBatchAccel(head, batch);
+
+      for (int k = 0; k < batch.numSamples; ++k) {
+        Outputs& out = outputs[start + k];
+        for (int j = 0; j < 3; ++j) {
+          out.accelRobotFrame[j] = batch.accelRobotFrame[j][k];
+        }
+        out.accelMagnitudeSqrd = batch.accelMagnitudeSqrd[k];
+        out.accelBasedPitch = batch.accelBasedPitch[k];
+        out.accelBasedRoll = batch.accelBasedRoll[k];
+      }
+    }
+  }
+
+  template <typename Func>
+  double TimePerSample_ns(size_t numSamples, Func func)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    for (int rep = 0; rep < NUM_REPETITIONS; ++rep) {
+      func();
+    }
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / (NUM_REPETITIONS * numSamples);
+  }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  if (argc < 2) {
+    printf("Usage: %s <imuRawLog.dat> [batchSize]\n", argv[0]);
+    return 1;
+  }
+
+  std::vector<Sample> samples;
+  if (!LoadLog(argv[1], samples)) {
+    printf("Failed to load any samples from %s\n", argv[1]);
+    return 1;
+  }
+
+  const int batchSize = (argc > 2 ? atoi(argv[2]) : 4);
+  if (batchSize < 1 || batchSize > MAX_IMU_BATCH_SIZE) {
+    printf("batchSize must be in [1, %d]\n", MAX_IMU_BATCH_SIZE);
+    return 1;
+  }
+
+  printf("%zu samples, batches of %d\n", samples.size(), batchSize);
+  printf("%10s %14s %14s %16s %16s %16s\n",
+         "head deg", "reference ns", "batched ns", "max accel diff", "max pitch diff", "max roll diff");
+
+  std::vector<Outputs> reference(samples.size());
+  std::vector<Outputs> batched(samples.size());
+  for (const f32 headAngle_deg : {-22.f, 0.f, 20.f, 44.5f}) {
+    const f32 headAngle = headAngle_deg * (f32) M_PI / 180.f;
+
+    const double referenceTime_ns = TimePerSample_ns(samples.size(), [&]() {
+      ComputeReference(samples, headAngle, reference);
+    });
+    const double batchedTime_ns = TimePerSample_ns(samples.size(), [&]() {
+      ComputeBatched(samples, headAngle, batchSize, batched);
+    });
+
+    // The reference robot frame acceleration goes through atan2_fast, so that is where it differs most
+    f32 maxAccelDiff = 0, maxPitchDiff = 0, maxRollDiff = 0;
+    for (size_t i = 0; i < samples.size(); ++i) {
+      for (int j = 0; j < 3; ++j) {
+        maxAccelDiff = std::max(maxAccelDiff, std::abs(reference[i].accelRobotFrame[j] - batched[i].accelRobotFrame[j]));
+      }
+      maxPitchDiff = std::max(maxPitchDiff, std::abs(reference[i].accelBasedPitch - batched[i].accelBasedPitch));
+      maxRollDiff = std::max(maxRollDiff, std::abs(reference[i].accelBasedRoll - batched[i].accelBasedRoll));
+    }
+
+    printf("%10.1f %14.1f %14.1f %16.3f %16.7f %16.7f\n",
+           headAngle_deg, referenceTime_ns, batchedTime_ns, maxAccelDiff, maxPitchDiff, maxRollDiff);
+  }
+
+  return 0;
+}
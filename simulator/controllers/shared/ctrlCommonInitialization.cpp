@@ -38,6 +38,8 @@ ParsedCommandLine ParseCommandLine(int argc, char** argv)
     const std::string kFilterParam = "--applyLogFilter";
     const std::string kColorizeParam = "--colorizeStderrOutput";
     const std::string kWhiskeyParam = "--whiskey";
+    const std::string kFastForwardParam = "--fastForward";
+    const std::string kNoRenderingParam = "--noRendering";
     for( int i=1; i<argc; ++i) {
       if ( kFilterParam == argv[i] ) {
         ret.filterLog = true;
@@ -45,6 +47,10 @@ ParsedCommandLine ParseCommandLine(int argc, char** argv)
         ret.colorizeStderrOutput = true;
       } else if ( kWhiskeyParam == argv[i] ) {
         Vector::Factory::SetWhiskey(true);
+      } else if ( kFastForwardParam == argv[i] ) {
+        ret.fastForward = true;
+      } else if ( kNoRenderingParam == argv[i] ) {
+        ret.noRendering = true;
       }
     }
   }
@@ -33,6 +33,10 @@ namespace WebotsCtrlShared {
 struct ParsedCommandLine {
   bool filterLog = false;
   bool colorizeStderrOutput = false;
+  // run the simulation as fast as it will go instead of in real time (only a supervisor can change this)
+  bool fastForward = false;
+  // don't render the simulated head camera, for tests that do not need vision
+  bool noRendering = false;
 };
 
 // parses the parameters from a command line into ParseCommandLine struct
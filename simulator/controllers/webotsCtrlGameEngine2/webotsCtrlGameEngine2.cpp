@@ -62,6 +62,13 @@ int main(int argc, char **argv)
   // parse commands
   WebotsCtrlShared::ParsedCommandLine params = WebotsCtrlShared::ParseCommandLine(argc, argv);
 
+  // Every controller steps on the simulation clock, so the engine, anim and robot processes stay in lockstep however
+  // fast the simulation runs. Fast mode lets it run as fast as they can keep up (and stops the 3D view rendering).
+  if (params.fastForward) {
+    engineSupervisor.simulationSetMode(webots::Supervisor::SIMULATION_MODE_FAST);
+  }
+  CameraService::SetRenderingEnabled(!params.noRendering);
+
   // create platform.
   // Unfortunately, CozmoAPI does not properly receive a const DataPlatform, and that change
   // is too big of a change, since it involves changing down to the context, so create a non-const platform
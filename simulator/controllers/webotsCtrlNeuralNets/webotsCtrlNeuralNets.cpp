@@ -52,7 +52,9 @@ protected:
   
   virtual void Step(int pollPeriod_ms) override
   {
-    const int rc = _webotsSupervisor.step(pollPeriod_ms);
+    // Webots can't step for zero time, so use the basic time step when we've already waited on shared memory
+    const int stepTime_ms = (pollPeriod_ms > 0 ? pollPeriod_ms : (int)_webotsSupervisor.getBasicTimeStep());
+    const int rc = _webotsSupervisor.step(stepTime_ms);
     _shouldStop = (rc == -1);
   }
   
@@ -0,0 +1,282 @@
+/**
+ * File: micPipelineBenchmark.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Feeds 4 channel mic captures (as saved by RecordRawAudio) through the mic data pipeline: SE
+ *              processing, the trigger word recognizer and the beat detector, as fast as the pipeline takes them.
+ *              Reports the processing time spent in each stage, trigger and beat counts, and how far into the audio
+ *              the trigger was recognized. Captures are read from resources/test/micCaptures, each one optionally
+ *              with a <capture>.json next to it listing where trigger words end: {"triggerWordEnd_ms": [1234, ...]}.
+ *              Disabled by default, run it with
+ *                test_animprocess --gtest_also_run_disabled_tests --gtest_filter=MicPipelineBenchmark.*
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "audioUtil/speechRecognizer.h"
+#include "audioUtil/waveFile.h"
+#include "clad/robotInterface/messageRobotToEngine.h"
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "cozmoAnim/animContext.h"
+#include "cozmoAnim/micData/micDataProcessor.h"
+#include "cozmoAnim/micData/micDataSystem.h"
+#include "cozmoAnim/robotDataLoader.h"
+#include "util/fileUtils/fileUtils.h"
+#include "json/json.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+extern std::string resourcePath;
+
+using namespace Anki;
+using namespace Anki::Vector;
+using namespace Anki::Vector::MicData;
+
+namespace {
+
+const char* const kCaptureFolder = "test/micCaptures";
+const std::string kWorkPath = "/tmp/micPipelineBenchmark";
+
+// A recognized trigger word within this much audio after a labelled one is counted as hearing it
+const uint32_t kMaxTriggerLatency_ms = 1000;
+
+// Blocks the Beat stage may fall behind Raw before feeding waits for it, well below its queue size so that the
+// benchmark doesn't make it drop blocks
+const uint32_t kMaxBeatStageLag = 32;
+
+// Silence between two captures, so that one's trailing audio can't trigger in the next
+const uint32_t kCaptureGap_ms = 500;
+
+using PipelineStage = MicDataProcessor::PipelineStage;
+
+struct Capture {
+  std::string              name;
+  AudioUtil::AudioChunkList chunks; // kIncomingAudioChunkSize interleaved samples each
+  std::vector<uint32_t>    triggerWordEnds_ms;
+};
+
+struct Detection {
+  uint32_t audioTime_ms; // where in the fed audio, from the Trigger stage's block
+  float    score;
+};
+
+struct StageTotals {
+  uint64_t process_us = 0;
+  uint32_t numBlocks  = 0;
+};
+
+float Percentile(std::vector<float> values, float p)
+{
+  if (values.empty()) { return 0.f; }
+  std::sort(values.begin(), values.end());
+  const size_t idx = std::min(values.size() - 1, (size_t) std::round(p * (values.size() - 1)));
+  return values[idx];
+}
+
+StageTotals GetTotals(const MicDataProcessor& processor, PipelineStage stage)
+{
+  StageTotals totals;
+  processor.GetPipelineStageTotals(stage, totals.process_us, totals.numBlocks);
+  return totals;
+}
+
+// RecordRawAudio interleaves the channels, incoming mic data has them one after the other
+void Deinterleave(const AudioUtil::AudioChunk& chunk, RobotInterface::MicData& out_payload)
+{
+  for (size_t sample=0; sample<kSamplesPerBlockPerChannel; ++sample) {
+    for (size_t channel=0; channel<kNumInputChannels; ++channel) {
+      out_payload.data[channel*kSamplesPerBlockPerChannel + sample] = chunk[kNumInputChannels*sample + channel];
+    }
+  }
+}
+
+// Hand the chunk to the pipeline, waiting whenever Raw's queue is full or Beat has fallen too far behind
+void Feed(MicDataSystem& micDataSystem, MicDataProcessor& processor, const RobotInterface::MicData& payload)
+{
+  const auto beatLagDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(1);
+  while ((GetTotals(processor, PipelineStage::Raw).numBlocks - GetTotals(processor, PipelineStage::Beat).numBlocks
+          > kMaxBeatStageLag) && (std::chrono::steady_clock::now() < beatLagDeadline)) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  uint32_t numOverruns = processor.GetNumIncomingMicDataOverruns();
+  micDataSystem.ProcessMicDataPayload(payload);
+  while (processor.GetNumIncomingMicDataOverruns() != numOverruns) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    numOverruns = processor.GetNumIncomingMicDataOverruns();
+    micDataSystem.ProcessMicDataPayload(payload);
+  }
+}
+
+// Wait for the Raw and Trigger stages to get through everything fed so far
+bool WaitForDrain(const MicDataProcessor& processor, uint32_t numFed)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while ((GetTotals(processor, PipelineStage::Raw).numBlocks < numFed) ||
+         (GetTotals(processor, PipelineStage::Trigger).numBlocks < numFed)) {
+    if (std::chrono::steady_clock::now() > deadline) {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  }
+  return true;
+}
+
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(MicPipelineBenchmark, DISABLED_RecordedCaptures)
+{
+  Util::FileUtils::RemoveDirectory(kWorkPath);
+  Util::Data::DataPlatform platform(kWorkPath + "/persistent", kWorkPath + "/cache", resourcePath);
+
+  const std::string folder = platform.pathToResource(Util::Data::Scope::Resources, kCaptureFolder);
+  std::vector<Capture> captures;
+  for (const auto& file : Util::FileUtils::FilesInDirectory(folder, true, ".wav")) {
+    Capture capture;
+    capture.name = Util::FileUtils::GetFileName(file, true, true);
+    capture.chunks = AudioUtil::WaveFile::ReadFile(file, kSamplesPerBlockPerChannel);
+    // Drop a partial final chunk, and skip anything that isn't a 4 channel capture
+    if (!capture.chunks.empty() && capture.chunks.back().size() != kIncomingAudioChunkSize) {
+      capture.chunks.pop_back();
+    }
+    if (capture.chunks.empty() || capture.chunks.front().size() != kIncomingAudioChunkSize) {
+      printf("Skipping %s, not a %u channel capture\n", file.c_str(), kNumInputChannels);
+      continue;
+    }
+
+    Json::Value labels;
+    const std::string labelPath = Util::FileUtils::FullFilePath({folder, capture.name + ".json"});
+    if (Util::FileUtils::FileExists(labelPath) && platform.readAsJson(labelPath, labels)) {
+      for (const auto& end : labels["triggerWordEnd_ms"]) {
+        capture.triggerWordEnds_ms.push_back(end.asUInt());
+      }
+    }
+    captures.push_back(std::move(capture));
+  }
+
+  if (captures.empty()) {
+    printf("No mic captures in %s, nothing to benchmark\n", folder.c_str());
+    return;
+  }
+
+  Anim::AnimContext context(&platform);
+  context.GetDataLoader()->LoadConfigData();
+  MicDataSystem& micDataSystem = *context.GetMicDataSystem();
+
+  std::mutex detectionMutex;
+  std::vector<Detection> detections;
+  micDataSystem.SetTriggerWordRecognizedCallback(
+    [&] (const AudioUtil::SpeechRecognizerCallbackInfo& info) {
+      // Called on the Trigger stage thread, still on the block that completed the trigger word
+      const auto timestamp = micDataSystem.GetMicDataProcessor()->GetTriggerStageTimestamp();
+      std::lock_guard<std::mutex> lock(detectionMutex);
+      detections.push_back({(TimeStamp_t) timestamp, info.score});
+    });
+  micDataSystem.Init(*context.GetDataLoader());
+  MicDataProcessor& processor = *micDataSystem.GetMicDataProcessor();
+
+  // Captures are fed back to back as one stream, with a gap of silence in between
+  RobotInterface::MicData silence{};
+  RobotInterface::MicData payload{};
+  uint32_t numFed = 0;
+  std::vector<uint32_t> triggerWordEnds_ms;
+  const auto startTime = std::chrono::steady_clock::now();
+  for (const auto& capture : captures) {
+    const uint32_t captureStart_ms = numFed * kTimePerChunk_ms;
+    for (const uint32_t end_ms : capture.triggerWordEnds_ms) {
+      triggerWordEnds_ms.push_back(captureStart_ms + end_ms);
+    }
+    for (const auto& chunk : capture.chunks) {
+      Deinterleave(chunk, payload);
+      payload.timestamp = (++numFed) * kTimePerChunk_ms;
+      Feed(micDataSystem, processor, payload);
+    }
+    for (uint32_t i=0; i<kCaptureGap_ms / kTimePerChunk_ms; ++i) {
+      silence.timestamp = (++numFed) * kTimePerChunk_ms;
+      Feed(micDataSystem, processor, silence);
+    }
+  }
+  ASSERT_TRUE(WaitForDrain(processor, numFed)) << "mic pipeline stopped processing";
+  const float wallTime_ms = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+  const float audioTime_ms = numFed * kTimePerChunk_ms;
+
+  // Match each labelled trigger word with the first recognition after it
+  std::vector<Detection> heard;
+  {
+    std::lock_guard<std::mutex> lock(detectionMutex);
+    heard = detections;
+  }
+  std::sort(heard.begin(), heard.end(), [](const Detection& a, const Detection& b) {
+    return a.audioTime_ms < b.audioTime_ms;
+  });
+  std::sort(triggerWordEnds_ms.begin(), triggerWordEnds_ms.end());
+  std::vector<bool> matched(heard.size(), false);
+  std::vector<float> latencies_ms;
+  size_t numMissed = 0;
+  for (const uint32_t end_ms : triggerWordEnds_ms) {
+    const auto it = std::find_if(heard.begin(), heard.end(), [&](const Detection& d) {
+      return !matched[&d - heard.data()] && (d.audioTime_ms >= end_ms) && (d.audioTime_ms - end_ms <= kMaxTriggerLatency_ms);
+    });
+    if (it == heard.end()) {
+      ++numMissed;
+      continue;
+    }
+    matched[it - heard.begin()] = true;
+    latencies_ms.push_back(it->audioTime_ms - end_ms);
+  }
+  const size_t numUnlabelled = std::count(matched.begin(), matched.end(), false);
+
+  // Report, and keep a copy to compare runs against each other
+  Json::Value report;
+  printf("%zu captures, %.1f s of audio in %.1f s (%.1fx real time)\n",
+         captures.size(), audioTime_ms / 1000.f, wallTime_ms / 1000.f, audioTime_ms / std::max(1.f, wallTime_ms));
+  printf("%-8s %10s %10s %12s\n", "stage", "blocks", "us/block", "% of 1 core");
+  const std::pair<PipelineStage, const char*> stages[] = {
+    {PipelineStage::Raw, "raw"}, {PipelineStage::Trigger, "trigger"}, {PipelineStage::Beat, "beat"}
+  };
+  for (const auto& stage : stages) {
+    const StageTotals totals = GetTotals(processor, stage.first);
+    // At real time every block has kTimePerChunk_ms to get through each stage
+    const float perBlock_us = totals.process_us / std::max(1.f, (float) totals.numBlocks);
+    Json::Value& json = report["stages"][stage.second];
+    json["blocks"]       = totals.numBlocks;
+    json["us_per_block"] = perBlock_us;
+    json["core_percent"] = 100.f * perBlock_us / (kTimePerChunk_ms * 1000.f);
+    printf("%-8s %10u %10.1f %12.2f\n", stage.second, totals.numBlocks, perBlock_us, json["core_percent"].asFloat());
+  }
+
+  report["audio_s"]           = audioTime_ms / 1000.f;
+  report["wall_s"]            = wallTime_ms / 1000.f;
+  report["triggers"]          = (Json::UInt) heard.size();
+  report["triggers_labelled"] = (Json::UInt) triggerWordEnds_ms.size();
+  report["triggers_missed"]   = (Json::UInt) numMissed;
+  report["triggers_extra"]    = (Json::UInt) numUnlabelled;
+  report["latency_p50_ms"]    = Percentile(latencies_ms, .5f);
+  report["latency_p90_ms"]    = Percentile(latencies_ms, .9f);
+  report["latency_max_ms"]    = Percentile(latencies_ms, 1.f);
+  report["beats"]             = processor.GetNumBeatsDetected();
+
+  printf("%zu triggers: %zu of %zu labelled heard, %zu unlabelled. %u beats\n",
+         heard.size(), triggerWordEnds_ms.size() - numMissed, triggerWordEnds_ms.size(), numUnlabelled,
+         processor.GetNumBeatsDetected());
+  if (!latencies_ms.empty()) {
+    // Audio after the end of the trigger word before it was recognized. Running at real time, the time blocks
+    // spend queued for and processed by the Raw and Trigger stages adds to this
+    printf("trigger latency p50 %.0f ms, p90 %.0f ms, max %.0f ms\n", report["latency_p50_ms"].asFloat(),
+           report["latency_p90_ms"].asFloat(), report["latency_max_ms"].asFloat());
+  }
+
+  EXPECT_TRUE( platform.writeAsJson(Util::Data::Scope::Cache, "micPipelineBenchmark/report.json", report) );
+}
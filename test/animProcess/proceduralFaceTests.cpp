@@ -297,3 +297,30 @@ TEST(ProceduralFace, RenderParamsCheck)
   testFaceAgainstStoredVersion(procFace, Util::FileUtils::FullFilePath({resourcePath, "test", "animProcessTests", "anim_eyes_neutral_hotspot.png"}));
 
 } // TEST(ProceduralFace, RenderParamsCheck)
+
+// Drawing a face again after others should copy its eyes from the render cache and give the same image
+TEST(ProceduralFace, EyeRenderCache)
+{
+  // Same noise image for every draw, see the note on determinism above
+  const auto drawFace = [](const ProceduralFace& face, Vision::ImageRGB565& img) {
+    Util::RandomGenerator rng(1);
+    ProceduralFaceDrawer::DrawFace(face, rng, img);
+  };
+
+  ProceduralFace neutral;
+  ProceduralFace lookRight;
+  lookRight.SetParameterBothEyes(ProceduralFace::Parameter::EyeCenterX, FACE_DISPLAY_WIDTH/8);
+
+  Vision::ImageRGB565 first(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+  Vision::ImageRGB565 other(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+  Vision::ImageRGB565 again(FACE_DISPLAY_HEIGHT, FACE_DISPLAY_WIDTH);
+
+  ProceduralFaceDrawer::ResetEyeRenderCacheStats();
+  drawFace(neutral, first);
+  drawFace(lookRight, other);
+  drawFace(neutral, again);
+
+  EXPECT_GT(ProceduralFaceDrawer::GetEyeRenderCacheHitRate(), 0.f);
+  EXPECT_LT(ImageDifferenceFraction(again, first), 0.01);
+  EXPECT_GT(ImageDifferenceFraction(other, first), 0.01);
+}
@@ -0,0 +1,120 @@
+/**
+ * File: testAnimationTickStats.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for AnimationTickStats
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=AnimationTickStats*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cozmoAnim/animation/animationTickStats.h"
+
+using namespace Anki;
+using namespace Anki::Vector;
+using namespace Anki::Vector::Anim;
+
+TEST(AnimationTickStats, StagesAndPercentiles)
+{
+  AnimationTickStats stats;
+
+  // 100 ticks on schedule, with face compositing taking i/10 ms on tick i
+  s64 start_us = 1000000;
+  for(int i=1; i<=100; ++i)
+  {
+    stats.StartTick(start_us);
+    stats.AddStageTime(AnimTickStage::FaceCompositing, 100 * i);
+    stats.AddStageTime(AnimTickStage::MessageSend, 200);
+    stats.AddStageTime(AnimTickStage::MessageSend, 300); // summed within the tick
+    stats.EndTick(start_us + 100 * i + 500);
+    start_us += 33000;
+  }
+
+  EXPECT_EQ(100u, stats.GetNumTicks());
+  EXPECT_EQ(0u, stats.GetNumMissedDeadlines());
+  EXPECT_FLOAT_EQ(10.f,  stats.GetLastStageDuration_ms(AnimTickStage::FaceCompositing));
+  EXPECT_FLOAT_EQ(0.5f,  stats.GetLastStageDuration_ms(AnimTickStage::MessageSend));
+  EXPECT_FLOAT_EQ(0.f,   stats.GetLastStageDuration_ms(AnimTickStage::AudioPost));
+  EXPECT_FLOAT_EQ(10.5f, stats.GetLastTickDuration_ms());
+
+  const Json::Value json = stats.GetJson();
+  const Json::Value& face = json["stages"]["FaceCompositing"];
+  EXPECT_NEAR(5.1f,  face["p50_ms"].asFloat(), 1e-4f);
+  EXPECT_NEAR(9.1f,  face["p90_ms"].asFloat(), 1e-4f);
+  EXPECT_NEAR(10.f,  face["p99_ms"].asFloat(), 1e-4f);
+  EXPECT_NEAR(10.f,  face["max_ms"].asFloat(), 1e-4f);
+  EXPECT_NEAR(33.f,  json["interval"]["max_ms"].asFloat(), 1e-4f);
+  EXPECT_EQ(0u, json["numOverruns"].asUInt());
+
+  stats.ClearWindow();
+  EXPECT_EQ(0u, stats.GetNumTicks());
+}
+
+TEST(AnimationTickStats, MissedDeadlines)
+{
+  AnimationTickStats stats(5.f);
+
+  // Intervals: 33 (on time), 38 (within tolerance), 39 (late), 70 (late)
+  s64 start_us = 1000;
+  for(s64 interval_ms : {0, 33, 38, 39, 70})
+  {
+    start_us += 1000 * interval_ms;
+    stats.StartTick(start_us);
+    stats.EndTick(start_us + 1000);
+  }
+  EXPECT_EQ(5u, stats.GetNumTicks());
+  EXPECT_EQ(2u, stats.GetNumMissedDeadlines());
+  EXPECT_TRUE(stats.WasLastTickLate());
+
+  // Update itself taking longer than a time step is an overrun
+  stats.StartTick(start_us + 33000);
+  stats.EndTick(start_us + 33000 + 40000);
+  EXPECT_FALSE(stats.WasLastTickLate());
+  EXPECT_EQ(1u, stats.GetJson()["numOverruns"].asUInt());
+}
+
+TEST(AnimationTickStats, HeapAllocations)
+{
+  AnimationTickStats stats;
+
+  s64 start_us = 1000;
+  for(u32 numAllocations : {0u, 3u, 0u, 2u})
+  {
+    stats.StartTick(start_us);
+    stats.AddHeapAllocations(numAllocations);
+    stats.EndTick(start_us + 1000);
+    start_us += 33000;
+  }
+  EXPECT_EQ(2u, stats.GetLastTickHeapAllocations());
+
+  const Json::Value json = stats.GetJson();
+  EXPECT_EQ(2u, json["numTicksWithHeapAllocations"].asUInt());
+  EXPECT_EQ(5u, json["numHeapAllocations"].asUInt());
+
+  stats.ClearWindow();
+  EXPECT_EQ(0u, stats.GetJson()["numHeapAllocations"].asUInt());
+}
+
+TEST(AnimationTickStats, DroppedFaces)
+{
+  AnimationTickStats stats;
+
+  s64 start_us = 1000;
+  for(u32 numDropped : {0u, 1u, 1u, 0u})
+  {
+    stats.StartTick(start_us);
+    stats.AddDroppedFaces(numDropped);
+    stats.EndTick(start_us + 1000);
+    start_us += 33000;
+  }
+  EXPECT_EQ(2u, stats.GetJson()["numDroppedFaces"].asUInt());
+
+  stats.ClearWindow();
+  EXPECT_EQ(0u, stats.GetJson()["numDroppedFaces"].asUInt());
+}
@@ -2,6 +2,10 @@
 
 #include <math.h>
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
 #define private public
 #include "cozmoAnim/micData/audioFFT.h"
 
@@ -68,3 +72,61 @@ TEST(AudioFFT, SineWave)
   
 }
 
+
+TEST(AudioFFT, ValidLength)
+{
+  EXPECT_EQ( 512,   AudioFFT::GetLargestValidLength(512) );
+  EXPECT_EQ( 480,   AudioFFT::GetLargestValidLength(500) );   // 32*15
+  EXPECT_EQ( 32000, AudioFFT::GetLargestValidLength(32010) ); // 32*1000
+  EXPECT_EQ( 7776,  AudioFFT::GetLargestValidLength(7900) );  // 32*243, skipping 32*245 = 32*5*7*7
+  EXPECT_EQ( 0,     AudioFFT::GetLargestValidLength(31) );
+}
+
+TEST(AudioFFT, PowerInPlace)
+{
+  constexpr int windowSize = 256;
+  AudioFFT fft{windowSize};
+  
+  std::vector<float> power;
+  fft.GetPower( power );
+  EXPECT_TRUE( power.empty() );
+  
+  std::vector<short> samples(windowSize);
+  for( int i=0; i<windowSize; ++i ) {
+    samples[i] = sin( 2 * M_PI * 8 * i / windowSize ) * std::numeric_limits<short>::max();
+  }
+  fft.AddSamples( samples.data(), samples.size() );
+  fft.GetPower( power );
+  ASSERT_EQ( power.size(), windowSize/2 );
+  const float* storage = power.data();
+  EXPECT_EQ( power, fft.GetPower() );
+  
+  // filling it again reuses its storage
+  fft.AddSamples( samples.data(), samples.size() );
+  fft.GetPower( power );
+  EXPECT_EQ( storage, power.data() );
+  EXPECT_EQ( 8, std::max_element(power.begin(), power.end()) - power.begin() );
+}
+
+// Time per transform at the notch detector's and the factory mic test's lengths. Disabled by default, run it with
+//   test_animprocess --gtest_also_run_disabled_tests --gtest_filter=AudioFFT.DISABLED_Benchmark
+TEST(AudioFFT, DISABLED_Benchmark)
+{
+  for( const unsigned int windowSize : {256u, 32000u} ) {
+    AudioFFT fft{windowSize};
+    std::vector<short> samples(windowSize);
+    for( int i=0; i<windowSize; ++i ) {
+      samples[i] = sin( 2 * M_PI * 100 * i / windowSize ) * std::numeric_limits<short>::max();
+    }
+    std::vector<float> power;
+    
+    const int numIterations = (windowSize > 1000) ? 50 : 5000;
+    const auto start = std::chrono::steady_clock::now();
+    for( int i=0; i<numIterations; ++i ) {
+      fft.AddSamples( samples.data(), 1 ); // dirty, so each GetPower transforms
+      fft.GetPower( power );
+    }
+    const auto elapsed_us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "AudioFFT N=" << windowSize << ": " << (float)elapsed_us / numIterations << " us per transform" << std::endl;
+  }
+}
@@ -0,0 +1,102 @@
+/**
+ * File: testEngineAnimMessageBatch.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for EngineAnimMessageBatch
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=EngineAnimMessageBatch*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "anki/cozmo/shared/engineAnimMessageBatch.h"
+
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+  std::vector<std::vector<uint8_t>> Unpack(const uint8_t* data, uint32_t size, bool& isValid)
+  {
+    std::vector<std::vector<uint8_t>> msgs;
+    isValid = ForEachMessageInBatch(data, size, [&msgs](const uint8_t* msgData, uint32_t msgSize) {
+      msgs.emplace_back(msgData, msgData + msgSize);
+    });
+    return msgs;
+  }
+}
+
+TEST(EngineAnimMessageBatch, RoundTrip)
+{
+  EngineAnimMessageBatch batch;
+  EXPECT_TRUE(batch.IsEmpty());
+  EXPECT_EQ(0u, batch.GetDatagramSize());
+
+  const std::vector<uint8_t> first{0x10, 1, 2, 3};
+  const std::vector<uint8_t> second(1200, 0x42);
+  const std::vector<uint8_t> third{0x20};
+  ASSERT_TRUE(batch.Append(first.data(),  (uint32_t)first.size()));
+  ASSERT_TRUE(batch.Append(second.data(), (uint32_t)second.size()));
+  ASSERT_TRUE(batch.Append(third.data(),  (uint32_t)third.size()));
+  EXPECT_EQ(3u, batch.GetNumMessages());
+  EXPECT_TRUE(IsEngineAnimMessageBatch(batch.GetDatagram(), batch.GetDatagramSize()));
+
+  bool isValid = false;
+  const auto msgs = Unpack(batch.GetDatagram(), batch.GetDatagramSize(), isValid);
+  EXPECT_TRUE(isValid);
+  ASSERT_EQ(3u, msgs.size());
+  EXPECT_EQ(first,  msgs[0]);
+  EXPECT_EQ(second, msgs[1]);
+  EXPECT_EQ(third,  msgs[2]);
+
+  batch.Clear();
+  EXPECT_TRUE(batch.IsEmpty());
+}
+
+TEST(EngineAnimMessageBatch, SingleMessageIsSentBare)
+{
+  EngineAnimMessageBatch batch;
+  const std::vector<uint8_t> msg{0x10, 7, 8};
+  ASSERT_TRUE(batch.Append(msg.data(), (uint32_t)msg.size()));
+
+  ASSERT_EQ(msg.size(), batch.GetDatagramSize());
+  const std::vector<uint8_t> datagram(batch.GetDatagram(), batch.GetDatagram() + batch.GetDatagramSize());
+  EXPECT_EQ(msg, datagram);
+  EXPECT_FALSE(IsEngineAnimMessageBatch(datagram.data(), (uint32_t)datagram.size()));
+}
+
+TEST(EngineAnimMessageBatch, Full)
+{
+  EngineAnimMessageBatch batch;
+  const std::vector<uint8_t> big(EngineAnimMessageBatch::kMaxMessageSize, 0x01);
+  EXPECT_FALSE(batch.Append(big.data(), (uint32_t)big.size() + 1));
+  ASSERT_TRUE(batch.Append(big.data(), (uint32_t)big.size()));
+
+  // No room left, and a failed append leaves the batch as it was
+  EXPECT_FALSE(batch.Append(big.data(), 1));
+  EXPECT_EQ(1u, batch.GetNumMessages());
+}
+
+TEST(EngineAnimMessageBatch, Malformed)
+{
+  EngineAnimMessageBatch batch;
+  const std::vector<uint8_t> msg(10, 0x05);
+  ASSERT_TRUE(batch.Append(msg.data(), (uint32_t)msg.size()));
+  ASSERT_TRUE(batch.Append(msg.data(), (uint32_t)msg.size()));
+
+  // Cut short in the middle of the second message: the first one still comes out
+  bool isValid = true;
+  const auto msgs = Unpack(batch.GetDatagram(), batch.GetDatagramSize() - 1, isValid);
+  EXPECT_FALSE(isValid);
+  EXPECT_EQ(1u, msgs.size());
+
+  const uint8_t zeroLength[] = {kEngineAnimBatchMarker, 0, 0};
+  EXPECT_TRUE(Unpack(zeroLength, sizeof(zeroLength), isValid).empty());
+  EXPECT_FALSE(isValid);
+}
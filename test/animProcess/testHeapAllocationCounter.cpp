@@ -0,0 +1,60 @@
+/**
+ * File: testHeapAllocationCounter.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for ScopedHeapAllocationCounter
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=HeapAllocationCounter*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cozmoAnim/animation/heapAllocationCounter.h"
+#include "util/global/globalDefinitions.h"
+
+#include <memory>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+using namespace Anki::Vector::Anim;
+
+TEST(HeapAllocationCounter, CountsAllocationsInScope)
+{
+  if(!ANKI_DEV_CHEATS)
+  {
+    return;
+  }
+
+  std::vector<int> reserved;
+  reserved.reserve(16);
+
+  u32 numAllocations = 0;
+  {
+    ScopedHeapAllocationCounter counter(numAllocations);
+    std::unique_ptr<int> value(new int(1));
+    std::unique_ptr<int[]> values(new int[4]);
+  }
+  EXPECT_EQ(2u, numAllocations);
+
+  // Work within storage allocated up front is not counted, and counts accumulate across scopes
+  {
+    ScopedHeapAllocationCounter counter(numAllocations);
+    for(int i=0; i<16; ++i)
+    {
+      reserved.push_back(i);
+    }
+  }
+  EXPECT_EQ(2u, numAllocations);
+
+  {
+    ScopedHeapAllocationCounter counter(numAllocations);
+    reserved.push_back(16);
+  }
+  EXPECT_EQ(3u, numAllocations);
+}
@@ -0,0 +1,102 @@
+/**
+ * File: testMicStreamEncoder.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for MicStreamEncoder
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=MicStreamEncoder*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cozmoAnim/micData/micStreamEncoder.h"
+
+#include <cmath>
+
+using namespace Anki;
+using namespace Anki::Vector;
+using namespace Anki::Vector::MicData;
+
+namespace {
+  constexpr size_t kChunkSize = 160;
+
+  AudioUtil::AudioChunk MakeTone(size_t numSamples)
+  {
+    AudioUtil::AudioChunk samples(numSamples);
+    for (size_t i=0; i<numSamples; ++i) {
+      samples[i] = (AudioUtil::AudioSample) (8000.0 * std::sin(2.0 * M_PI * 440.0 * i / 16000.0)
+                                             + 2000.0 * std::sin(2.0 * M_PI * 1700.0 * i / 16000.0));
+    }
+    return samples;
+  }
+}
+
+TEST(MicStreamEncoder, PCMPassesThrough)
+{
+  const auto tone = MakeTone(kChunkSize);
+  MicStreamEncoder encoder;
+  AudioUtil::AudioChunk encoded;
+  encoder.Encode(tone.data(), tone.size(), encoded);
+  EXPECT_EQ(tone, encoded);
+}
+
+TEST(MicStreamEncoder, ImaAdpcmRoundTrip)
+{
+  const auto tone = MakeTone(50 * kChunkSize);
+  MicStreamEncoder encoder(MicStreamCodec::ImaAdpcm);
+
+  double signal = 0.0;
+  double noise = 0.0;
+  AudioUtil::AudioChunk encoded;
+  AudioUtil::AudioChunk decoded;
+  for (size_t offset=0; offset<tone.size(); offset+=kChunkSize) {
+    encoder.Encode(tone.data() + offset, kChunkSize, encoded);
+    ASSERT_EQ(MicStreamEncoder::GetEncodedSize(MicStreamCodec::ImaAdpcm, kChunkSize), encoded.size());
+    EXPECT_EQ(42u, encoded.size());
+
+    // Every chunk decodes on its own
+    ASSERT_TRUE(MicStreamEncoder::DecodeImaAdpcm(encoded.data(), encoded.size(), decoded));
+    ASSERT_EQ(kChunkSize, decoded.size());
+
+    // Skip the first chunk, while the step size ramps up from silence
+    if (offset > 0) {
+      for (size_t i=0; i<kChunkSize; ++i) {
+        const double error = decoded[i] - tone[offset + i];
+        signal += (double) tone[offset + i] * tone[offset + i];
+        noise  += error * error;
+      }
+    }
+  }
+  EXPECT_GT(10.0 * std::log10(signal / noise), 20.0);
+}
+
+TEST(MicStreamEncoder, ResetRestartsThePredictor)
+{
+  const auto tone = MakeTone(2 * kChunkSize);
+  MicStreamEncoder encoder(MicStreamCodec::ImaAdpcm);
+  AudioUtil::AudioChunk first;
+  encoder.Encode(tone.data(), kChunkSize, first);
+
+  AudioUtil::AudioChunk second;
+  encoder.Encode(tone.data() + kChunkSize, kChunkSize, second);
+  EXPECT_NE(0, second[1]);
+
+  encoder.Reset(MicStreamCodec::ImaAdpcm);
+  AudioUtil::AudioChunk again;
+  encoder.Encode(tone.data(), kChunkSize, again);
+  EXPECT_EQ(first, again);
+}
+
+TEST(MicStreamEncoder, Malformed)
+{
+  AudioUtil::AudioChunk decoded;
+  const AudioUtil::AudioSample tooShort[] = { 0 };
+  EXPECT_FALSE(MicStreamEncoder::DecodeImaAdpcm(tooShort, 1, decoded));
+  const AudioUtil::AudioSample badStepIndex[] = { 0, 89, 0 };
+  EXPECT_FALSE(MicStreamEncoder::DecodeImaAdpcm(badStepIndex, 3, decoded));
+}
@@ -0,0 +1,135 @@
+/**
+ * File: testRobotStateDelta.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for RobotStateDeltaEncoder and RobotStateDeltaDecoder
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=RobotStateDelta*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "anki/cozmo/shared/robotStateDelta.h"
+
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+  std::vector<uint8_t> MakeState(uint32_t tick)
+  {
+    // Tag, a timestamp that changes every tick, a slowly drifting float and a long run of fields that never change
+    std::vector<uint8_t> msg(200, 0x5A);
+    msg[0] = 0x10;
+    std::memcpy(&msg[1], &tick, sizeof(tick));
+    const float angle = 0.01f * tick;
+    std::memcpy(&msg[8], &angle, sizeof(angle));
+    return msg;
+  }
+
+  bool Decode(RobotStateDeltaDecoder& decoder, const RobotStateDeltaEncoder& encoder, std::vector<uint8_t>& outMsg)
+  {
+    if (!decoder.Decode(encoder.GetDatagram(), encoder.GetDatagramSize())) {
+      return false;
+    }
+    outMsg.assign(decoder.GetMessage(), decoder.GetMessage() + decoder.GetMessageSize());
+    return true;
+  }
+}
+
+TEST(RobotStateDelta, RoundTrip)
+{
+  RobotStateDeltaEncoder encoder(10);
+  RobotStateDeltaDecoder decoder;
+
+  for (uint32_t tick = 0; tick < 25; ++tick) {
+    const std::vector<uint8_t> state = MakeState(tick);
+    const uint32_t size = encoder.Encode(state.data(), (uint32_t)state.size());
+    ASSERT_GT(size, 0u);
+    EXPECT_TRUE(IsRobotStateDelta(encoder.GetDatagram(), size));
+
+    // Keyframes every 10 messages, deltas in between that are much smaller than the message
+    const bool isKeyframe = (tick % 10 == 0);
+    EXPECT_EQ(isKeyframe ? kRobotStateDeltaTypeKeyframe : kRobotStateDeltaTypeDelta, encoder.GetDatagram()[1]);
+    if (!isKeyframe) {
+      EXPECT_LT(size, state.size() / 4);
+    }
+
+    std::vector<uint8_t> decoded;
+    ASSERT_TRUE(Decode(decoder, encoder, decoded));
+    EXPECT_EQ(state, decoded);
+  }
+}
+
+TEST(RobotStateDelta, LostDatagramWaitsForKeyframe)
+{
+  RobotStateDeltaEncoder encoder(5);
+  RobotStateDeltaDecoder decoder;
+  std::vector<uint8_t> decoded;
+
+  // A delta before any keyframe can't be decoded
+  std::vector<uint8_t> state = MakeState(0);
+  encoder.Encode(state.data(), (uint32_t)state.size());
+  state = MakeState(1);
+  encoder.Encode(state.data(), (uint32_t)state.size());
+  EXPECT_FALSE(Decode(decoder, encoder, decoded));
+
+  // Skip ahead to the next keyframe
+  for (uint32_t tick = 2; tick < 5; ++tick) {
+    state = MakeState(tick);
+    encoder.Encode(state.data(), (uint32_t)state.size());
+  }
+  state = MakeState(5);
+  encoder.Encode(state.data(), (uint32_t)state.size());
+  ASSERT_TRUE(Decode(decoder, encoder, decoded));
+  EXPECT_EQ(state, decoded);
+
+  // Drop one delta; the one after it no longer applies
+  state = MakeState(6);
+  encoder.Encode(state.data(), (uint32_t)state.size());
+  state = MakeState(7);
+  encoder.Encode(state.data(), (uint32_t)state.size());
+  EXPECT_FALSE(Decode(decoder, encoder, decoded));
+
+  // A requested keyframe resyncs without waiting for the period
+  encoder.RequestKeyframe();
+  state = MakeState(8);
+  encoder.Encode(state.data(), (uint32_t)state.size());
+  EXPECT_EQ(kRobotStateDeltaTypeKeyframe, encoder.GetDatagram()[1]);
+  ASSERT_TRUE(Decode(decoder, encoder, decoded));
+  EXPECT_EQ(state, decoded);
+}
+
+TEST(RobotStateDelta, RejectsBadInput)
+{
+  RobotStateDeltaEncoder encoder(10);
+  RobotStateDeltaDecoder decoder;
+
+  // Too large for the codec, sent as a normal message instead
+  const std::vector<uint8_t> tooLarge(kRobotStateDeltaMaxMessageSize + 1, 1);
+  EXPECT_EQ(0u, encoder.Encode(tooLarge.data(), (uint32_t)tooLarge.size()));
+
+  std::vector<uint8_t> state = MakeState(0);
+  encoder.Encode(state.data(), (uint32_t)state.size());
+  ASSERT_TRUE(decoder.Decode(encoder.GetDatagram(), encoder.GetDatagramSize()));
+
+  // A delta whose runs go past the end of the message
+  state = MakeState(1);
+  encoder.Encode(state.data(), (uint32_t)state.size());
+  std::vector<uint8_t> datagram(encoder.GetDatagram(), encoder.GetDatagram() + encoder.GetDatagramSize());
+  datagram.push_back(255);
+  datagram.push_back(0);
+  EXPECT_FALSE(decoder.Decode(datagram.data(), (uint32_t)datagram.size()));
+  EXPECT_EQ(0u, decoder.GetMessageSize());
+
+  // Not a compact datagram at all
+  const uint8_t single[] = {0x10, 0x01, 0x02};
+  EXPECT_FALSE(IsRobotStateDelta(single, sizeof(single)));
+  EXPECT_FALSE(decoder.Decode(single, sizeof(single)));
+}
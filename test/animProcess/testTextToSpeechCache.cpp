@@ -0,0 +1,104 @@
+/**
+ * File: testTextToSpeechCache.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for TextToSpeechCache
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=TextToSpeechCache*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "cozmoAnim/textToSpeech/textToSpeechCache.h"
+#include "util/fileUtils/fileUtils.h"
+
+using namespace Anki;
+using namespace Anki::Vector::TextToSpeech;
+
+namespace {
+  const std::string kCachePath = "/tmp/testTextToSpeechCache";
+
+  TextToSpeechCache::Utterance MakeUtterance(size_t numSamples, int16_t first)
+  {
+    TextToSpeechCache::Utterance utterance;
+    utterance.sampleRate = 22050;
+    utterance.numChannels = 1;
+    for (size_t i=0; i<numSamples; ++i) {
+      utterance.samples.push_back(static_cast<int16_t>(first + i));
+    }
+    return utterance;
+  }
+
+  class TextToSpeechCacheTest : public ::testing::Test
+  {
+  protected:
+    void SetUp() override { Util::FileUtils::RemoveDirectory(kCachePath); }
+    void TearDown() override { Util::FileUtils::RemoveDirectory(kCachePath); }
+  };
+}
+
+TEST_F(TextToSpeechCacheTest, StoreAndLoad)
+{
+  TextToSpeechCache cache(kCachePath, 1024 * 1024);
+  const auto hello = MakeUtterance(1000, -500);
+  EXPECT_FALSE(cache.Contains("en-US/hello"));
+  ASSERT_TRUE(cache.Store("en-US/hello", hello));
+  EXPECT_TRUE(cache.Contains("en-US/hello"));
+  EXPECT_FALSE(cache.Contains("en-US/hello."));
+
+  TextToSpeechCache::Utterance loaded;
+  ASSERT_TRUE(cache.Load("en-US/hello", loaded));
+  EXPECT_EQ(hello.sampleRate, loaded.sampleRate);
+  EXPECT_EQ(hello.numChannels, loaded.numChannels);
+  EXPECT_EQ(hello.samples, loaded.samples);
+  EXPECT_FALSE(cache.Load("de-DE/hello", loaded));
+
+  // Still there for the next run
+  TextToSpeechCache reopened(kCachePath, 1024 * 1024);
+  EXPECT_EQ(1u, reopened.GetNumEntries());
+  EXPECT_EQ(cache.GetSize_bytes(), reopened.GetSize_bytes());
+  ASSERT_TRUE(reopened.Load("en-US/hello", loaded));
+  EXPECT_EQ(hello.samples, loaded.samples);
+}
+
+TEST_F(TextToSpeechCacheTest, EvictsLeastRecentlyUsed)
+{
+  // Room for two of these
+  TextToSpeechCache cache(kCachePath, 5000);
+  ASSERT_TRUE(cache.Store("a", MakeUtterance(1000, 0)));
+  ASSERT_TRUE(cache.Store("b", MakeUtterance(1000, 0)));
+
+  TextToSpeechCache::Utterance loaded;
+  ASSERT_TRUE(cache.Load("a", loaded));
+  ASSERT_TRUE(cache.Store("c", MakeUtterance(1000, 0)));
+
+  EXPECT_TRUE(cache.Contains("a"));
+  EXPECT_FALSE(cache.Contains("b"));
+  EXPECT_TRUE(cache.Contains("c"));
+  EXPECT_LE(cache.GetSize_bytes(), cache.GetMaxSize_bytes());
+
+  // Larger than the whole budget
+  EXPECT_FALSE(cache.Store("d", MakeUtterance(5000, 0)));
+  EXPECT_EQ(2u, cache.GetNumEntries());
+}
+
+TEST_F(TextToSpeechCacheTest, UnreadableFileIsDeleted)
+{
+  {
+    TextToSpeechCache cache(kCachePath, 1024 * 1024);
+    ASSERT_TRUE(cache.Store("hello", MakeUtterance(100, 0)));
+  }
+  const std::string filePath = Util::FileUtils::FullFilePath({kCachePath, TextToSpeechCache::GetFileName("hello")});
+  ASSERT_TRUE(Util::FileUtils::WriteFile(filePath, std::string("not audio")));
+
+  TextToSpeechCache cache(kCachePath, 1024 * 1024);
+  TextToSpeechCache::Utterance loaded;
+  EXPECT_FALSE(cache.Load("hello", loaded));
+  EXPECT_FALSE(cache.Contains("hello"));
+  EXPECT_FALSE(Util::FileUtils::FileExists(filePath));
+}
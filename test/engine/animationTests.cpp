@@ -174,3 +174,96 @@ TEST(AnimationTest, AnimationCopying)
   
 } // AnimationTest.AnimationCopying
 
+
+
+// Animations defined lazily from binary files should come back the same after being released
+TEST(AnimationTest, ReleaseColdAnimations)
+{
+  const auto kPathToDevData = "assets/dev_animation_data";
+  const auto fullPath = cozmoContext->GetDataPlatform()->GetResourcePath(kPathToDevData);
+  const bool useFullPath = true;
+  const bool shouldRecurse = false;
+
+  Robot robot(0, cozmoContext);
+  auto platform = cozmoContext->GetDataPlatform();
+  auto spriteSequenceContainer = robot.GetComponent<DataAccessorComponent>().GetSpriteSequenceContainer();
+  std::atomic<float> loadingCompleteRatio(0);
+  std::atomic<bool>  abortLoad(false);
+
+  CannedAnimationContainer binaryAnimContainer;
+  {
+    const std::vector<const char*> binExt = {"bin"};
+    auto binaryFilePaths = Util::FileUtils::FilesInDirectory(fullPath, useFullPath, binExt, shouldRecurse);
+
+    CannedAnimationLoader animLoader(platform,
+                                     spriteSequenceContainer,
+                                     loadingCompleteRatio, abortLoad);
+    for(const auto& fullPath : binaryFilePaths){
+      animLoader.LoadAnimationIntoContainer(fullPath, &binaryAnimContainer);
+    }
+  }
+
+  const auto binaryAnimNames = binaryAnimContainer.GetAnimationNames();
+  ASSERT_FALSE(binaryAnimNames.empty());
+
+  // Nothing is decoded until it is requested
+  EXPECT_EQ(0u, binaryAnimContainer.GetNumDecodedLazyAnimations());
+
+  std::vector<Animation> copies;
+  for(const auto& name: binaryAnimNames){
+    EXPECT_TRUE(binaryAnimContainer.HasAnimation(name));
+    const Animation* anim = binaryAnimContainer.GetAnimation(name);
+    ASSERT_TRUE(anim != nullptr);
+    copies.push_back(*anim);
+  }
+  EXPECT_EQ(binaryAnimNames.size(), binaryAnimContainer.GetNumDecodedLazyAnimations());
+
+  // Animations in use are kept
+  const std::set<std::string> animsInUse = {binaryAnimNames.front()};
+  EXPECT_EQ(binaryAnimNames.size() - 1, binaryAnimContainer.ReleaseColdAnimations(animsInUse));
+  EXPECT_EQ(1u, binaryAnimContainer.GetNumDecodedLazyAnimations());
+
+  EXPECT_EQ(1u, binaryAnimContainer.ReleaseColdAnimations({}));
+  EXPECT_EQ(0u, binaryAnimContainer.GetNumDecodedLazyAnimations());
+
+  for(size_t i = 0; i < binaryAnimNames.size(); ++i){
+    const Animation* anim = binaryAnimContainer.GetAnimation(binaryAnimNames[i]);
+    ASSERT_TRUE(anim != nullptr);
+    EXPECT_TRUE(*anim == copies[i]);
+  }
+
+} // AnimationTest.ReleaseColdAnimations
+
+
+// Critical animation files are moved to the front, in the order of their prefixes, and the rest keep their order
+TEST(AnimationTest, PrioritizeAnimFiles)
+{
+  CannedAnimationLoader::AnimDirInfo info;
+  info.jsonFiles = {
+    "/anims/anim_bored_01.bin",
+    "/anims/anim_pairing_icon_wifi.bin",
+    "/anims/anim_happy_01.json",
+    "/anims/anim_neutral_eyes_01.bin",
+    "/anims/anim_pairing_icon_update.bin",
+    "/anims/anim_sad_01.bin",
+  };
+
+  CannedAnimationLoader::PrioritizeAnimFiles(info, {"anim_neutral_eyes_", "anim_pairing_icon_", "anim_missing_"});
+
+  const std::vector<std::string> expected = {
+    "/anims/anim_neutral_eyes_01.bin",
+    "/anims/anim_pairing_icon_wifi.bin",
+    "/anims/anim_pairing_icon_update.bin",
+    "/anims/anim_bored_01.bin",
+    "/anims/anim_happy_01.json",
+    "/anims/anim_sad_01.bin",
+  };
+  EXPECT_EQ(expected, info.jsonFiles);
+  EXPECT_EQ(3u, info.numCriticalFiles);
+
+  // Without prefixes nothing is critical
+  CannedAnimationLoader::PrioritizeAnimFiles(info, {});
+  EXPECT_EQ(expected, info.jsonFiles);
+  EXPECT_EQ(0u, info.numCriticalFiles);
+
+} // AnimationTest.PrioritizeAnimFiles
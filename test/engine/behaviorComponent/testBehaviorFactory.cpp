@@ -85,3 +85,31 @@ TEST(BehaviorFactory, CreateAndDestroyBehaviors)
   
   VerifyBehavior(newBehavior, behaviorContainer, kBaseBehaviorCount + 1);
 }
+
+
+TEST(BehaviorFactory, ConstructBehaviorsOnFirstLookup)
+{
+  Json::Value  testBehaviorJson;
+  Json::Reader reader;
+  const bool parsedOK = reader.parse(kTestBehaviorJson, testBehaviorJson, false);
+  ASSERT_TRUE(parsedOK);
+
+  BehaviorContainer::BehaviorIDJsonMap behaviorData;
+  behaviorData.emplace(expectedID, testBehaviorJson);
+  BehaviorContainer behaviorContainer(behaviorData);
+
+  // registered, but not constructed until something asks for it
+  EXPECT_EQ(behaviorContainer.GetNumRegisteredBehaviors(), 1u);
+  EXPECT_EQ(behaviorContainer.GetNumConstructedBehaviors(), 0u);
+
+  const auto byClass = behaviorContainer.FindBehaviorsByClass(BehaviorClass::AnimSequence);
+  ASSERT_EQ(byClass.size(), 1u);
+  EXPECT_EQ(behaviorContainer.GetNumConstructedBehaviors(), 1u);
+  EXPECT_EQ(behaviorContainer.GetNumRegisteredBehaviors(), 1u);
+
+  const ICozmoBehaviorPtr behavior = behaviorContainer.FindBehaviorByID(expectedID);
+  ASSERT_NE(behavior, nullptr);
+  EXPECT_EQ(*byClass.begin(), behavior);
+  EXPECT_EQ(behavior->GetID(), expectedID);
+  EXPECT_TRUE(behaviorContainer.FindBehaviorsByClass(BehaviorClass::Wait).empty());
+}
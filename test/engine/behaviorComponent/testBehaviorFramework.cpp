@@ -635,7 +635,7 @@ void InjectAndDelegate(TestBehaviorFramework& testFramework,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void TestSuperPoweredBehavior::GetAllDelegates(std::set<IBehavior*>& delegates) const {
-  for(auto& entry: _bc->_idToBehaviorMap){
+  for(auto& entry: _bc->GetBehaviorMap()){
     delegates.insert(entry.second.get());
   }
 }
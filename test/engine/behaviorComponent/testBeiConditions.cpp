@@ -1072,6 +1072,135 @@ TEST(BeiConditions, OnCharger)
   EXPECT_FALSE( cond->AreConditionsMet(bei) );
 }
 
+TEST(BeiConditions, SharedResults)
+{
+  const std::string json = R"json(
+  {
+    "conditionType": "OnCharger"
+  })json";
+
+  IBEIConditionPtr cond1;
+  IBEIConditionPtr cond2;
+  CreateBEI(json, cond1);
+  CreateBEI(json, cond2);
+
+  TestBehaviorFramework testBehaviorFramework(1, nullptr);
+  testBehaviorFramework.InitializeStandardBehaviorComponent();
+  BehaviorExternalInterface& bei = testBehaviorFramework.GetBehaviorExternalInterface();
+
+  TestBehaviorFramework tbf(1, nullptr);
+  Robot& robot = tbf.GetRobot();
+
+  BEIRobotInfo info(robot);
+  InitBEIPartial( { {BEIComponentID::RobotInfo, &info} }, bei );
+
+  for( auto& cond : {cond1, cond2} ) {
+    cond->Init(bei);
+    cond->SetActive(bei, true);
+  }
+
+  {
+    // within a scope, the second condition reuses the result of the first, even though the state changed
+    BEIConditionResultSharingScope scope;
+    EXPECT_FALSE( cond1->AreConditionsMet(bei) );
+    robot.GetBatteryComponent().SetOnChargeContacts(true);
+    EXPECT_FALSE( cond2->AreConditionsMet(bei) );
+  }
+
+  {
+    // a new scope evaluates again
+    BEIConditionResultSharingScope scope;
+    EXPECT_TRUE( cond2->AreConditionsMet(bei) );
+    EXPECT_TRUE( cond1->AreConditionsMet(bei) );
+  }
+
+  // outside of any scope, each evaluation is independent
+  robot.GetBatteryComponent().SetOnChargeContacts(false);
+  EXPECT_FALSE( cond1->AreConditionsMet(bei) );
+}
+
+
+TEST(BeiConditions, InputDependencies)
+{
+  BaseStationTimer::getInstance()->UpdateTime(0);
+
+  const std::string json = R"json(
+  {
+    "conditionType": "OnCharger"
+  })json";
+  const std::string jsonCompound = R"json(
+  {
+    "conditionType": "Compound",
+    "and": [
+      {
+        "conditionType": "OnCharger"
+      },
+      {
+        "conditionType": "UserIntentPending",
+        "list": [ { "type": "test_user_intent_1" } ]
+      }
+    ]
+  })json";
+  const std::string jsonCompoundWithTimer = R"json(
+  {
+    "conditionType": "Compound",
+    "or": [
+      {
+        "conditionType": "OnCharger"
+      },
+      {
+        "conditionType": "TimerInRange",
+        "begin_s": 10.0,
+        "end_s": 20.0
+      }
+    ]
+  })json";
+
+  IBEIConditionPtr cond;
+  IBEIConditionPtr condCompound;
+  IBEIConditionPtr condCompoundWithTimer;
+  CreateBEI(json, cond);
+  CreateBEI(jsonCompound, condCompound);
+  CreateBEI(jsonCompoundWithTimer, condCompoundWithTimer);
+
+  const BEIConditionInputMask batteryAndUserIntent = BEIConditionInput::Battery | BEIConditionInput::UserIntent;
+  EXPECT_EQ( (int)BEIConditionInput::Battery, (int)cond->GetInputDependencies() );
+  EXPECT_EQ( batteryAndUserIntent, condCompound->GetInputDependencies() );
+  EXPECT_EQ( 0, (int)condCompoundWithTimer->GetInputDependencies() );
+
+  TestBehaviorFramework testBehaviorFramework(1, nullptr);
+  testBehaviorFramework.InitializeStandardBehaviorComponent();
+  BehaviorExternalInterface& bei = testBehaviorFramework.GetBehaviorExternalInterface();
+
+  TestBehaviorFramework tbf(1, nullptr);
+  Robot& robot = tbf.GetRobot();
+
+  BEIRobotInfo info(robot);
+  InitBEIPartial( { {BEIComponentID::RobotInfo, &info} }, bei );
+
+  cond->Init(bei);
+  cond->SetActive(bei, true);
+
+  EXPECT_FALSE( cond->AreConditionsMet(bei) );
+
+  // changing the state without bumping the battery generation isn't noticed until the fallback interval passes
+  robot.GetBatteryComponent()._isOnChargerContacts = true;
+  EXPECT_FALSE( cond->AreConditionsMet(bei) );
+  BaseStationTimer::getInstance()->UpdateTime(Util::SecToNanoSec(2.0));
+  EXPECT_TRUE( cond->AreConditionsMet(bei) );
+
+  // changes that bump the generation are noticed right away
+  robot.GetBatteryComponent().SetOnChargeContacts(false);
+  EXPECT_FALSE( cond->AreConditionsMet(bei) );
+  robot.GetBatteryComponent().SetOnChargeContacts(true);
+  EXPECT_TRUE( cond->AreConditionsMet(bei) );
+
+  // reactivating always evaluates again
+  robot.GetBatteryComponent()._isOnChargerContacts = false;
+  cond->SetActive(bei, false);
+  cond->SetActive(bei, true);
+  EXPECT_FALSE( cond->AreConditionsMet(bei) );
+}
 
 TEST(BeiConditions, RobotInHabitat)
 {
@@ -1550,7 +1679,8 @@ TEST(BeiConditions, FaceKnown)
   facePose.SetTranslation(Vec3f(200, 0, 0));
   face1.SetHeadPose(facePose);
   FaceWorld::FaceEntry face1Entry(face1);
-  robot.GetFaceWorld()._faceEntries.insert({1, face1Entry});
+  robot.GetFaceWorld()._faceEntries.push_back(face1Entry);
+  ++robot.GetFaceWorld()._facesGeneration;
 
   EXPECT_TRUE(condDefault->AreConditionsMet(bei));
   EXPECT_TRUE(condMaxDist400mm->AreConditionsMet(bei));
@@ -1565,7 +1695,8 @@ TEST(BeiConditions, FaceKnown)
   face1.SetHeadPose(facePose);
   face1Entry = FaceWorld::FaceEntry(face1);
   robot.GetFaceWorld()._faceEntries.clear();
-  robot.GetFaceWorld()._faceEntries.insert({1, face1Entry});
+  robot.GetFaceWorld()._faceEntries.push_back(face1Entry);
+  ++robot.GetFaceWorld()._facesGeneration;
 
   EXPECT_TRUE(condDefault->AreConditionsMet(bei));
   EXPECT_FALSE(condMaxDist400mm->AreConditionsMet(bei));
@@ -1581,7 +1712,8 @@ TEST(BeiConditions, FaceKnown)
   EXPECT_FALSE(condMustBeNamed->AreConditionsMet(bei));
 
   // Add a name to the existing face
-  robot.GetFaceWorld()._faceEntries.begin()->second.face.SetName("Bob");
+  robot.GetFaceWorld()._faceEntries.begin()->face.SetName("Bob");
+  ++robot.GetFaceWorld()._facesGeneration;
 
   EXPECT_TRUE(condDefault->AreConditionsMet(bei));
   EXPECT_FALSE(condMaxDist400mm->AreConditionsMet(bei));
@@ -1590,6 +1722,7 @@ TEST(BeiConditions, FaceKnown)
 
   // Remove the face
   robot.GetFaceWorld()._faceEntries.clear();
+  ++robot.GetFaceWorld()._facesGeneration;
 
   EXPECT_FALSE(condDefault->AreConditionsMet(bei));
   EXPECT_FALSE(condMaxDist400mm->AreConditionsMet(bei));
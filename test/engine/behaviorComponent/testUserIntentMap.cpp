@@ -214,6 +214,39 @@ TEST(UserIntentMap, UserIntent)
   EXPECT_FALSE(comp->IsUserIntentActive(USER_INTENT(unmatched_intent)));
 }
 
+TEST(UserIntentMap, UserIntentTagMask)
+{
+  TestBehaviorFramework testBehaviorFramework(1, nullptr);
+  const Robot& robot = testBehaviorFramework.GetRobot();
+  std::unique_ptr<UserIntentComponent> comp;
+  CreateComponent(testMapConfig, comp, robot);
+
+  UserIntentTagMask tags;
+  tags.set(static_cast<size_t>(USER_INTENT(test_user_intent_1)));
+  tags.set(static_cast<size_t>(USER_INTENT(unmatched_intent)));
+  UserIntentTagMask otherTags;
+  otherTags.set(static_cast<size_t>(USER_INTENT(test_user_intent_2)));
+
+  EXPECT_EQ(nullptr, comp->GetPendingUserIntentIfAnyOf(tags));
+
+  comp->DevSetUserIntentPending(USER_INTENT(test_user_intent_1), UserIntentSource::Voice);
+  const UserIntent* pending = comp->GetPendingUserIntentIfAnyOf(tags);
+  ASSERT_NE(nullptr, pending);
+  EXPECT_EQ(USER_INTENT(test_user_intent_1), pending->GetTag());
+  EXPECT_EQ(nullptr, comp->GetPendingUserIntentIfAnyOf(otherTags));
+  EXPECT_EQ(nullptr, comp->GetActiveUserIntentIfAnyOf(tags));
+
+  comp->ActivateUserIntent(USER_INTENT(test_user_intent_1), "test", false);
+  EXPECT_EQ(nullptr, comp->GetPendingUserIntentIfAnyOf(tags));
+  const UserIntent* active = comp->GetActiveUserIntentIfAnyOf(tags);
+  ASSERT_NE(nullptr, active);
+  EXPECT_EQ(USER_INTENT(test_user_intent_1), active->GetTag());
+  EXPECT_EQ(nullptr, comp->GetActiveUserIntentIfAnyOf(otherTags));
+
+  comp->DeactivateUserIntent(USER_INTENT(test_user_intent_1));
+  EXPECT_EQ(nullptr, comp->GetActiveUserIntentIfAnyOf(tags));
+}
+
 TEST(UserIntentMap, CloudIntent)
 {
   TestBehaviorFramework testBehaviorFramework(1, nullptr);
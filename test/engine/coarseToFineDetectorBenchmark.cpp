@@ -0,0 +1,252 @@
+/**
+ * File: coarseToFineDetectorBenchmark.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Runs LaserPointDetector and BrightColorDetector over recorded sequences of camera frames, each in
+ *              its current mode and its coarse-to-fine mode, and reports per frame detect time, detection rate
+ *              and how many detections the coarse-to-fine mode missed or added. Frames are read in name order from
+ *              resources/test/laserPointFrames and resources/test/brightColorFrames. Disabled by default, run it with
+ *                test_engine --gtest_also_run_disabled_tests --gtest_filter=CoarseToFineDetectorBenchmark.*
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "util/helpers/includeGTest.h"
+
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/vision/engine/brightColorDetector.h"
+#include "coretech/vision/engine/camera.h"
+#include "coretech/vision/engine/imageCache.h"
+#include "coretech/vision/engine/scratchArena.h"
+#include "engine/cozmoContext.h"
+#include "engine/vision/laserPointDetector.h"
+#include "util/console/consoleSystem.h"
+#include "util/fileUtils/fileUtils.h"
+#include "json/json.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+extern CozmoContext* cozmoContext;
+
+namespace {
+
+const char* const kLaserFrameFolder       = "test/laserPointFrames";
+const char* const kBrightColorFrameFolder = "test/brightColorFrames";
+
+// Laser points found by both modes closer than this (in full-size image pixels) count as the same detection
+const f32 kLaserMatchDist_pix = 3.f;
+
+struct RunStats {
+  std::vector<float> times_ms;
+  size_t             numFramesWithDetections = 0;
+  size_t             numDetections = 0;
+};
+
+// Detections for each frame, as image positions
+using FrameDetections = std::vector<std::vector<Point2f>>;
+
+float Percentile(std::vector<float> values, float p)
+{
+  if (values.empty()) { return 0.f; }
+  std::sort(values.begin(), values.end());
+  const size_t idx = std::min(values.size() - 1, (size_t) std::round(p * (values.size() - 1)));
+  return values[idx];
+}
+
+std::vector<Vision::ImageRGB> LoadFrames(const char* frameFolder)
+{
+  const auto* platform = cozmoContext->GetDataPlatform();
+  const std::string folder = platform->pathToResource(Util::Data::Scope::Resources, frameFolder);
+
+  std::vector<std::string> files = Util::FileUtils::FilesInDirectory(folder, true, ".jpg");
+  const std::vector<std::string> pngFiles = Util::FileUtils::FilesInDirectory(folder, true, ".png");
+  files.insert(files.end(), pngFiles.begin(), pngFiles.end());
+  std::sort(files.begin(), files.end());
+
+  std::vector<Vision::ImageRGB> frames;
+  for (const auto& file : files) {
+    Vision::ImageRGB frame;
+    if (frame.Load(file) != RESULT_OK) {
+      printf("Skipping %s, could not be loaded\n", file.c_str());
+      continue;
+    }
+    frame.SetTimestamp((TimeStamp_t) frames.size() + 1);
+    frames.push_back(frame);
+  }
+
+  if (frames.empty()) {
+    printf("No recorded frames in %s, nothing to benchmark\n", folder.c_str());
+  }
+  return frames;
+}
+
+// Counts detections in lhs with no detection in rhs within maxDist on the same frame
+size_t CountUnmatched(const FrameDetections& lhs, const FrameDetections& rhs, f32 maxDist)
+{
+  size_t numUnmatched = 0;
+  for (size_t iFrame = 0; iFrame < lhs.size(); ++iFrame) {
+    for (const auto& point : lhs[iFrame]) {
+      const bool isMatched = std::any_of(rhs[iFrame].begin(), rhs[iFrame].end(), [&point, maxDist](const Point2f& other) {
+        return (ComputeDistanceBetween(point, other) <= maxDist);
+      });
+      if (!isMatched) {
+        ++numUnmatched;
+      }
+    }
+  }
+  return numUnmatched;
+}
+
+RunStats RunLaser(const std::vector<Vision::ImageRGB>& frames, bool useCoarseToFine, FrameDetections& detections)
+{
+  Util::IConsoleVariable* coarseToFineVar = Util::ConsoleSystem::Instance().FindVariable("kLaser_UseCoarseToFine");
+  if (coarseToFineVar != nullptr) {
+    coarseToFineVar->ParseText(useCoarseToFine ? "1" : "0");
+  }
+
+  Vision::ScratchArena scratchArena;
+  LaserPointDetector laserPointDetector(nullptr, scratchArena);
+
+  RunStats stats;
+  detections.clear();
+  Vision::ImageCache imageCache;
+  for (const auto& frame : frames) {
+    imageCache.Reset(frame);
+    scratchArena.Reset();
+
+    // Without pose data the whole image is searched, so this is the cost of a frame with the ground plane in view
+    const bool kIsDarkExposure = false;
+    std::list<ExternalInterface::RobotObservedLaserPoint> points;
+    Vision::DebugImageList<Vision::CompressedImage> debugImages;
+    const auto startTime = std::chrono::steady_clock::now();
+    EXPECT_EQ(RESULT_OK, laserPointDetector.Detect(imageCache, kIsDarkExposure, points, debugImages));
+    const auto endTime = std::chrono::steady_clock::now();
+
+    stats.times_ms.push_back(std::chrono::duration<float, std::milli>(endTime - startTime).count());
+    stats.numDetections += points.size();
+    stats.numFramesWithDetections += (points.empty() ? 0 : 1);
+
+    detections.emplace_back();
+    for (const auto& point : points) {
+      detections.back().emplace_back((f32) point.ground_x_mm, (f32) point.ground_y_mm);
+    }
+  }
+
+  if (coarseToFineVar != nullptr) {
+    coarseToFineVar->ParseText("0");
+  }
+  return stats;
+}
+
+RunStats RunBrightColors(const std::vector<Vision::ImageRGB>& frames, bool useCoarseToFine, FrameDetections& detections)
+{
+  const Vision::Camera camera;
+  Vision::BrightColorDetector brightColorDetector(camera);
+  EXPECT_EQ(RESULT_OK, brightColorDetector.Init());
+
+  RunStats stats;
+  detections.clear();
+  Vision::ImageCache imageCache;
+  for (const auto& frame : frames) {
+    imageCache.Reset(frame);
+
+    // Same sizes VisionSystem uses, computed up front so that only the detection itself is timed
+    const Vision::ImageRGB& image = imageCache.GetRGB();
+    const Vision::ImageRGB& coarseImage = imageCache.GetRGB(Vision::ImageCacheSize::Quarter);
+
+    std::list<Vision::SalientPoint> salientPoints;
+    const auto startTime = std::chrono::steady_clock::now();
+    const Result result = (useCoarseToFine ?
+                           brightColorDetector.Detect(image, coarseImage, salientPoints) :
+                           brightColorDetector.Detect(image, salientPoints));
+    const auto endTime = std::chrono::steady_clock::now();
+    EXPECT_EQ(RESULT_OK, result);
+
+    stats.times_ms.push_back(std::chrono::duration<float, std::milli>(endTime - startTime).count());
+    stats.numDetections += salientPoints.size();
+    stats.numFramesWithDetections += (salientPoints.empty() ? 0 : 1);
+
+    detections.emplace_back();
+    for (const auto& salientPoint : salientPoints) {
+      detections.back().emplace_back(salientPoint.x_img, salientPoint.y_img);
+    }
+  }
+  return stats;
+}
+
+void Report(const char* detectorName, size_t numFrames, const RunStats& current, const RunStats& coarseToFine,
+            size_t numMissed, size_t numAdded)
+{
+  Json::Value report;
+  printf("%s: %zu frames\n", detectorName, numFrames);
+  printf("%-14s %8s %8s %8s %8s %10s %10s\n", "mode", "p50 ms", "p90 ms", "p99 ms", "max ms", "det. rate", "detections");
+  for (const auto& run : {std::make_pair("current", &current), std::make_pair("coarseToFine", &coarseToFine)}) {
+    const RunStats& stats = *run.second;
+    Json::Value& json = report[run.first];
+    json["p50_ms"]         = Percentile(stats.times_ms, .5f);
+    json["p90_ms"]         = Percentile(stats.times_ms, .9f);
+    json["p99_ms"]         = Percentile(stats.times_ms, .99f);
+    json["max_ms"]         = Percentile(stats.times_ms, 1.f);
+    json["detectionRate"]  = (f32) stats.numFramesWithDetections / (f32) numFrames;
+    json["numDetections"]  = (Json::UInt) stats.numDetections;
+
+    printf("%-14s %8.2f %8.2f %8.2f %8.2f %10.3f %10zu\n", run.first,
+           json["p50_ms"].asFloat(), json["p90_ms"].asFloat(), json["p99_ms"].asFloat(), json["max_ms"].asFloat(),
+           json["detectionRate"].asFloat(), stats.numDetections);
+  }
+  report["coarseToFine"]["numMissed"] = (Json::UInt) numMissed;
+  report["coarseToFine"]["numAdded"]  = (Json::UInt) numAdded;
+  printf("coarseToFine missed %zu and added %zu detections\n", numMissed, numAdded);
+
+  const auto* platform = cozmoContext->GetDataPlatform();
+  const std::string filename = std::string("coarseToFineDetectorBenchmark/") + detectorName + ".json";
+  EXPECT_TRUE( platform->writeAsJson(Util::Data::Scope::Cache, filename, report) );
+}
+
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(CoarseToFineDetectorBenchmark, DISABLED_LaserPoints)
+{
+  ASSERT_TRUE(cozmoContext->GetDataPlatform() != nullptr);
+  const std::vector<Vision::ImageRGB> frames = LoadFrames(kLaserFrameFolder);
+  if (frames.empty()) {
+    return;
+  }
+
+  FrameDetections currentDetections, coarseToFineDetections;
+  const RunStats current      = RunLaser(frames, false, currentDetections);
+  const RunStats coarseToFine = RunLaser(frames, true,  coarseToFineDetections);
+
+  Report("laserPoints", frames.size(), current, coarseToFine,
+         CountUnmatched(currentDetections, coarseToFineDetections, kLaserMatchDist_pix),
+         CountUnmatched(coarseToFineDetections, currentDetections, kLaserMatchDist_pix));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(CoarseToFineDetectorBenchmark, DISABLED_BrightColors)
+{
+  ASSERT_TRUE(cozmoContext->GetDataPlatform() != nullptr);
+  const std::vector<Vision::ImageRGB> frames = LoadFrames(kBrightColorFrameFolder);
+  if (frames.empty()) {
+    return;
+  }
+
+  FrameDetections currentDetections, coarseToFineDetections;
+  const RunStats current      = RunBrightColors(frames, false, currentDetections);
+  const RunStats coarseToFine = RunBrightColors(frames, true,  coarseToFineDetections);
+
+  // Both modes report regions at the same positions, so matches are exact
+  const f32 kMatchDist = 1e-4f;
+  Report("brightColors", frames.size(), current, coarseToFine,
+         CountUnmatched(currentDetections, coarseToFineDetections, kMatchDist),
+         CountUnmatched(coarseToFineDetections, currentDetections, kMatchDist));
+}
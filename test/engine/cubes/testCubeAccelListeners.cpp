@@ -0,0 +1,166 @@
+/**
+ * File: testCubeAccelListeners.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Unit tests for cube accel listeners and the filter stages they share
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=CubeAccelListeners*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "clad/types/activeObjectAccel.h"
+
+#include "engine/components/cubes/cubeAccelListeners/cubeAccelBatch.h"
+#include "engine/components/cubes/cubeAccelListeners/highPassFilterListener.h"
+#include "engine/components/cubes/cubeAccelListeners/lowPassFilterListener.h"
+#include "engine/components/cubes/cubeAccelListeners/movementStartStopListener.h"
+
+#include <cmath>
+
+using namespace Anki;
+using namespace Anki::Vector;
+using namespace Anki::Vector::CubeAccelListeners;
+
+namespace {
+
+  // Cube sitting still with gravity along -z, plus an oscillation along x of the given amplitude
+  std::vector<ActiveAccel> MakeSamples(const size_t numSamples, const float amplitude, const size_t phase = 0)
+  {
+    std::vector<ActiveAccel> samples;
+    for (size_t i = 0 ; i < numSamples ; ++i) {
+      const float x = amplitude * std::sin(0.9f * static_cast<float>(i + phase));
+      samples.emplace_back(x, 15.f, -9810.f);
+    }
+    return samples;
+  }
+
+}
+
+TEST(CubeAccelListeners, FilterStagesMatchPerSampleFilters)
+{
+  const Vec3f lpCoeffs(0.1f, 0.2f, 0.3f);
+  const Vec3f hpCoeffs(0.8f);
+
+  CubeAccelFilterBank filters;
+  const auto samples = MakeSamples(30, 2000.f);
+
+  ActiveAccel lowPass;
+  ActiveAccel highPass;
+  ActiveAccel prevInput;
+  for (size_t start = 0 ; start < samples.size() ; start += 3) {
+    const std::vector<ActiveAccel> batchSamples(samples.begin() + start, samples.begin() + start + 3);
+    const CubeAccelBatch batch(batchSamples, filters);
+
+    // Ask for the high pass filter twice to make sure asking again doesn't run it again
+    const auto& lowPassOutput = batch.GetLowPass(lpCoeffs);
+    const auto& highPassOutput = batch.GetHighPass(hpCoeffs);
+    ASSERT_EQ(&highPassOutput, &batch.GetHighPass(hpCoeffs));
+    ASSERT_EQ(batchSamples.size(), lowPassOutput.accel.size());
+    ASSERT_EQ(batchSamples.size(), highPassOutput.magnitudeSq.size());
+
+    for (size_t i = 0 ; i < batchSamples.size() ; ++i) {
+      const ActiveAccel& accel = batchSamples[i];
+      if ((start == 0) && (i == 0)) {
+        lowPass = accel;
+        highPass = ActiveAccel(0.f, 0.f, 0.f);
+      } else {
+        lowPass.x = accel.x * lpCoeffs.x() + lowPass.x * (1.f - lpCoeffs.x());
+        lowPass.y = accel.y * lpCoeffs.y() + lowPass.y * (1.f - lpCoeffs.y());
+        lowPass.z = accel.z * lpCoeffs.z() + lowPass.z * (1.f - lpCoeffs.z());
+        highPass.x = hpCoeffs.x() * (highPass.x + accel.x - prevInput.x);
+        highPass.y = hpCoeffs.y() * (highPass.y + accel.y - prevInput.y);
+        highPass.z = hpCoeffs.z() * (highPass.z + accel.z - prevInput.z);
+      }
+      prevInput = accel;
+
+      EXPECT_FLOAT_EQ(lowPass.x, lowPassOutput.accel[i].x);
+      EXPECT_FLOAT_EQ(lowPass.y, lowPassOutput.accel[i].y);
+      EXPECT_FLOAT_EQ(lowPass.z, lowPassOutput.accel[i].z);
+      EXPECT_FLOAT_EQ(highPass.x, highPassOutput.accel[i].x);
+      EXPECT_FLOAT_EQ(highPass.y, highPassOutput.accel[i].y);
+      EXPECT_FLOAT_EQ(highPass.z, highPassOutput.accel[i].z);
+      EXPECT_NEAR(highPass.x * highPass.x + highPass.y * highPass.y + highPass.z * highPass.z,
+                  highPassOutput.magnitudeSq[i], 1.f);
+    }
+  }
+}
+
+TEST(CubeAccelListeners, FilterStageRestartsAfterMissedBatch)
+{
+  const Vec3f hpCoeffs(0.8f);
+
+  CubeAccelFilterBank filters;
+  const auto samples = MakeSamples(3, 2000.f);
+  {
+    const CubeAccelBatch batch(samples, filters);
+    batch.GetHighPass(hpCoeffs);
+  }
+  {
+    // Nothing uses the high pass filter on this batch
+    const CubeAccelBatch batch(samples, filters);
+  }
+  {
+    const CubeAccelBatch batch(samples, filters);
+    const auto& output = batch.GetHighPass(hpCoeffs);
+    EXPECT_FLOAT_EQ(0.f, output.magnitudeSq[0]);
+    EXPECT_GT(output.magnitudeSq[1], 0.f);
+  }
+}
+
+TEST(CubeAccelListeners, ListenersShareFilterStages)
+{
+  const Vec3f hpCoeffs(0.8f);
+
+  auto output1 = std::make_shared<ActiveAccel>();
+  auto output2 = std::make_shared<ActiveAccel>();
+  HighPassFilterListener listener1(hpCoeffs, output1);
+  HighPassFilterListener listener2(hpCoeffs, output2);
+
+  CubeAccelFilterBank filters;
+  for (size_t phase = 0 ; phase < 30 ; phase += 3) {
+    const auto samples = MakeSamples(3, 2000.f, phase);
+    const CubeAccelBatch batch(samples, filters);
+    listener1.Update(batch);
+    listener2.Update(batch);
+
+    const auto& expected = batch.GetHighPass(hpCoeffs).accel.back();
+    EXPECT_FLOAT_EQ(expected.x, output1->x);
+    EXPECT_FLOAT_EQ(expected.x, output2->x);
+  }
+}
+
+TEST(CubeAccelListeners, MovementStartStop)
+{
+  bool startedMoving = false;
+  bool stoppedMoving = false;
+  MovementStartStopListener listener([&startedMoving]() { startedMoving = true; },
+                                     [&stoppedMoving]() { stoppedMoving = true; });
+
+  CubeAccelFilterBank filters;
+  auto runSamples = [&](const float amplitude, const size_t numBatches) {
+    for (size_t i = 0 ; i < numBatches ; ++i) {
+      const auto samples = MakeSamples(3, amplitude, 3*i);
+      const CubeAccelBatch batch(samples, filters);
+      listener.Update(batch);
+    }
+  };
+
+  // Still
+  runSamples(0.f, 20);
+  EXPECT_FALSE(startedMoving);
+
+  // Shaken
+  runSamples(3000.f, 40);
+  EXPECT_TRUE(startedMoving);
+  EXPECT_FALSE(stoppedMoving);
+
+  // Still again
+  runSamples(0.f, 40);
+  EXPECT_TRUE(stoppedMoving);
+}
@@ -0,0 +1,63 @@
+/**
+ * File: allocationCounter.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Test helper counting heap allocations for benchmarks
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#include "test/engine/helpers/allocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+  std::atomic<bool>   gCountAllocations(false);
+  std::atomic<size_t> gNumAllocations(0);
+  std::atomic<size_t> gNumBytes(0);
+}
+
+void* operator new(std::size_t size)
+{
+  if (gCountAllocations) {
+    ++gNumAllocations;
+    gNumBytes += size;
+  }
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) { throw std::bad_alloc(); }
+  return p;
+}
+void* operator new[](std::size_t size)           { return operator new(size); }
+void  operator delete(void* p) noexcept          { std::free(p); }
+void  operator delete[](void* p) noexcept        { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept   { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+namespace Anki {
+namespace Vector {
+namespace AllocationCounter {
+
+void Start()
+{
+  gNumAllocations = 0;
+  gNumBytes = 0;
+  gCountAllocations = true;
+}
+
+Counts Stop()
+{
+  gCountAllocations = false;
+  Counts counts;
+  counts.numAllocations = gNumAllocations;
+  counts.numBytes       = gNumBytes;
+  return counts;
+}
+
+} // namespace AllocationCounter
+} // namespace Vector
+} // namespace Anki
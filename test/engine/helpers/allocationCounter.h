@@ -0,0 +1,40 @@
+/**
+ * File: allocationCounter.h
+ *
+ * Author: Victor Rebuild
+ * Created: 10/14/2026
+ *
+ * Description: Test helper counting heap allocations for benchmarks. allocationCounter.cpp replaces the global
+ *              operator new of the whole test binary, which only counts between Start() and Stop(), on any thread.
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ **/
+
+#ifndef __Test_Helpers_AllocationCounter_H__
+#define __Test_Helpers_AllocationCounter_H__
+#pragma once
+
+#include <cstddef>
+
+namespace Anki {
+namespace Vector {
+namespace AllocationCounter {
+
+struct Counts
+{
+  size_t numAllocations = 0;
+  size_t numBytes       = 0;
+};
+
+// Zeroes the counts and starts counting. Not reentrant: one measurement at a time.
+void Start();
+
+// Stops counting and returns what was allocated since Start()
+Counts Stop();
+
+} // namespace AllocationCounter
+} // namespace Vector
+} // namespace Anki
+
+#endif // __Test_Helpers_AllocationCounter_H__
@@ -38,6 +38,10 @@ public:
     return Result::RESULT_OK;
   }
 
+  virtual Result FlushMessages() override {
+    return RESULT_OK;
+  }
+
   // return true if there's an execute path message in the outgoing queue, and set the path id in arguments
   bool FindStartedExecutePathMsg(int& pathID) {
     for( const auto& msg : _msgsToRobot ) {
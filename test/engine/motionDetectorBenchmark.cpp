@@ -0,0 +1,153 @@
+/**
+ * File: motionDetectorBenchmark.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Runs MotionDetector over a recorded sequence of camera frames with the scalar kernels and, where
+ *              they are built in, the NEON ones, and reports per frame detect time and how many motion messages
+ *              each produced. Frames are read in name order from resources/test/motionDetectionFrames. Disabled by
+ *              default, run it with
+ *                test_engine --gtest_also_run_disabled_tests --gtest_filter=MotionDetectorBenchmark.*
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "util/helpers/includeGTest.h"
+
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/vision/engine/camera.h"
+#include "coretech/vision/engine/imageCache.h"
+#include "coretech/vision/engine/scratchArena.h"
+#include "engine/cozmoContext.h"
+#include "engine/robotDataLoader.h"
+#include "engine/vision/motionDetector.h"
+#include "engine/vision/visionPoseData.h"
+#include "util/console/consoleSystem.h"
+#include "util/fileUtils/fileUtils.h"
+#include "json/json.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+extern CozmoContext* cozmoContext;
+
+namespace {
+
+const char* const kFrameFolder = "test/motionDetectionFrames";
+
+// Frames are stamped this far apart so that every pair is far enough from the last detection to be differenced
+const TimeStamp_t kFramePeriod_ms = 1000;
+
+struct RunStats {
+  std::vector<float> times_ms;
+  size_t             numMotions = 0;
+};
+
+float Percentile(std::vector<float> values, float p)
+{
+  if (values.empty()) { return 0.f; }
+  std::sort(values.begin(), values.end());
+  const size_t idx = std::min(values.size() - 1, (size_t) std::round(p * (values.size() - 1)));
+  return values[idx];
+}
+
+RunStats Run(const std::vector<Vision::ImageRGB>& frames, bool useNeon)
+{
+  Util::IConsoleVariable* useNeonVar = Util::ConsoleSystem::Instance().FindVariable("kMotionDetection_UseNeon");
+  if (useNeonVar != nullptr) {
+    useNeonVar->ParseText(useNeon ? "1" : "0");
+  }
+
+  const Vision::Camera camera;
+  Vision::ScratchArena scratchArena;
+  MotionDetector motionDetector(camera, nullptr, cozmoContext->GetDataLoader()->GetRobotVisionConfig(), scratchArena);
+
+  VisionPoseData poseData; // robot held still, so every frame gets differenced
+  poseData.cameraPose.SetParent(poseData.histState.GetPose());
+
+  RunStats stats;
+  Vision::ImageCache imageCache;
+  for (const auto& frame : frames) {
+    imageCache.Reset(frame);
+    scratchArena.Reset();
+
+    std::list<ExternalInterface::RobotObservedMotion> observedMotions;
+    Vision::DebugImageList<Vision::CompressedImage> debugImages;
+    const auto startTime = std::chrono::steady_clock::now();
+    EXPECT_EQ(RESULT_OK, motionDetector.Detect(imageCache, poseData, poseData, observedMotions, debugImages));
+    const auto endTime = std::chrono::steady_clock::now();
+
+    stats.times_ms.push_back(std::chrono::duration<float, std::milli>(endTime - startTime).count());
+    stats.numMotions += observedMotions.size();
+  }
+
+  if (useNeonVar != nullptr) {
+    useNeonVar->ParseText("1");
+  }
+  return stats;
+}
+
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(MotionDetectorBenchmark, DISABLED_RecordedFrames)
+{
+  const auto* platform = cozmoContext->GetDataPlatform();
+  ASSERT_TRUE(platform != nullptr);
+  const std::string folder = platform->pathToResource(Util::Data::Scope::Resources, kFrameFolder);
+
+  std::vector<std::string> files = Util::FileUtils::FilesInDirectory(folder, true, ".jpg");
+  const std::vector<std::string> pngFiles = Util::FileUtils::FilesInDirectory(folder, true, ".png");
+  files.insert(files.end(), pngFiles.begin(), pngFiles.end());
+  std::sort(files.begin(), files.end());
+
+  std::vector<Vision::ImageRGB> frames;
+  for (const auto& file : files) {
+    Vision::ImageRGB frame;
+    if (frame.Load(file) != RESULT_OK) {
+      printf("Skipping %s, could not be loaded\n", file.c_str());
+      continue;
+    }
+    frame.SetTimestamp((TimeStamp_t) (frames.size() + 1) * kFramePeriod_ms);
+    frames.push_back(frame);
+  }
+
+  if (frames.size() < 2) {
+    printf("Fewer than 2 recorded frames in %s, nothing to benchmark\n", folder.c_str());
+    return;
+  }
+
+  std::vector<std::pair<std::string, RunStats>> runs;
+  runs.emplace_back("scalar", Run(frames, false));
+#ifdef __ARM_NEON__
+  runs.emplace_back("neon", Run(frames, true));
+#else
+  printf("Not built with NEON, only the scalar kernels are benchmarked\n");
+#endif
+
+  // report, and keep a copy to compare runs against each other
+  Json::Value report;
+  printf("%zu frames of %dx%d\n", frames.size(), frames.front().GetNumCols(), frames.front().GetNumRows());
+  printf("%-8s %8s %8s %8s %8s %8s\n", "kernels", "p50 ms", "p90 ms", "p99 ms", "max ms", "motions");
+  for (const auto& run : runs) {
+    const RunStats& stats = run.second;
+    Json::Value& json = report[run.first];
+    json["p50_ms"]  = Percentile(stats.times_ms, .5f);
+    json["p90_ms"]  = Percentile(stats.times_ms, .9f);
+    json["p99_ms"]  = Percentile(stats.times_ms, .99f);
+    json["max_ms"]  = Percentile(stats.times_ms, 1.f);
+    json["motions"] = (Json::UInt) stats.numMotions;
+
+    printf("%-8s %8.2f %8.2f %8.2f %8.2f %8zu\n", run.first.c_str(),
+           json["p50_ms"].asFloat(), json["p90_ms"].asFloat(), json["p99_ms"].asFloat(), json["max_ms"].asFloat(),
+           stats.numMotions);
+  }
+
+  EXPECT_TRUE( platform->writeAsJson(Util::Data::Scope::Cache, "motionDetectorBenchmark/report.json", report) );
+}
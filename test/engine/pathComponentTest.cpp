@@ -17,11 +17,16 @@
 
 #include "engine/components/pathComponent.h"
 #include "engine/cozmoContext.h"
+#include "engine/navMap/mapComponent.h"
+#include "engine/navMap/memoryMap/data/memoryMapData.h"
+#include "engine/pathFootprintCache.h"
 #include "engine/xyPlanner.h"
 #include "engine/robot.h"
 #include "engine/robotInterface/messageHandler.h"
 #include "engine/robotManager.h"
 
+#include "coretech/common/engine/math/polygon_impl.h"
+
 #include "test/engine/helpers/messaging/stubRobotMessageHandler.h"
 
 using namespace Anki;
@@ -370,3 +375,72 @@ TEST_F(PathComponentTest, AbortPlanComplex)
 
   EXPECT_STATUS_EQ(_pathComponent->GetDriveToPoseStatus(), ERobotDriveToPoseStatus::FollowingPath);
 }
+
+TEST_F(PathComponentTest, MultiGoalNearestBlocked)
+{
+  // wall in the nearest goal, so only the farther ones can be reached
+  MapComponent& map = _robot->GetMapComponent();
+  const MemoryMapData obstacle( MemoryMapTypes::EContentType::ObstacleUnrecognized, 0 );
+  map.InsertData( Poly2f( {{220, -80}, {380, -80}, {380, -60}, {220, -60}} ), obstacle );
+  map.InsertData( Poly2f( {{220,  60}, {380,  60}, {380,  80}, {220,  80}} ), obstacle );
+  map.InsertData( Poly2f( {{220, -80}, {240, -80}, {240,  80}, {220,  80}} ), obstacle );
+  map.InsertData( Poly2f( {{360, -80}, {380, -80}, {380,  80}, {360,  80}} ), obstacle );
+
+  const std::vector<Pose3d> goals = {
+    Pose3d( 0, Z_AXIS_3D(), Vec3f(300,0,0),    _robot->GetPose() ),
+    Pose3d( 0, Z_AXIS_3D(), Vec3f(0,400,0),    _robot->GetPose() ),
+    Pose3d( 0, Z_AXIS_3D(), Vec3f(-600,0,0),   _robot->GetPose() ),
+    Pose3d( 0, Z_AXIS_3D(), Vec3f(0,-800,0),   _robot->GetPose() ),
+  };
+
+  auto selectedPoseIndex = std::make_shared<Planning::GoalID>(0);
+  _pathComponent->StartDrivingToPose( goals, selectedPoseIndex );
+
+  Update(_pathComponent);
+
+  EXPECT_STATUS_EQ(_pathComponent->GetDriveToPoseStatus(), ERobotDriveToPoseStatus::WaitingToBeginPath)
+    << "planning should now be complete";
+  EXPECT_EQ(*selectedPoseIndex, 1) << "should pick the nearest goal that can be reached";
+
+  int pathID = -1;
+  EXPECT_TRUE(_msgHandler->FindStartedExecutePathMsg(pathID)) << "should have send execute path message";
+}
+
+TEST_F(PathComponentTest, FootprintCache)
+{
+  Planning::Path path;
+  path.AppendLine(0, 0, 200, 0, 100, 200, 200);
+  path.AppendPointTurn(200, 0, 0, M_PI_2_F, 2, 10, 10, 0.1f, true);
+  path.AppendLine(200, 0, 200, 300, 100, 200, 200);
+  path.AppendArc(300, 300, 100, M_PI_F, -M_PI_2_F, 100, 200, 200);
+
+  const size_t numSegments = path.GetNumSegments();
+  const MapComponent& map = _robot->GetMapComponent();
+  PathFootprintCache cache;
+  cache.SetPath(path);
+  EXPECT_EQ(numSegments, cache.GetNumSafeSegments()) << "a new path should be safe";
+  EXPECT_EQ(numSegments, cache.Update(map));
+
+  // block the second line
+  const MemoryMapData obstacle( MemoryMapTypes::EContentType::ObstacleUnrecognized, 0 );
+  _robot->GetMapComponent().InsertData( Poly2f( {{180, 140}, {220, 140}, {220, 160}, {180, 160}} ), obstacle );
+  EXPECT_EQ(2, cache.Update(map));
+  EXPECT_EQ(2, cache.Update(map)) << "nothing changed since the last update";
+
+  // something far away from the path changes nothing
+  _robot->GetMapComponent().InsertData( Poly2f( {{-500, -500}, {-480, -500}, {-480, -480}, {-500, -480}} ), obstacle );
+  EXPECT_EQ(2, cache.Update(map));
+
+  // clear it again
+  const MemoryMapData clear( MemoryMapTypes::EContentType::ClearOfObstacle, 0 );
+  _robot->GetMapComponent().InsertData( Poly2f( {{160, 120}, {240, 120}, {240, 180}, {160, 180}} ), clear );
+  EXPECT_EQ(numSegments, cache.Update(map));
+
+  // the arc reaches y=400 at its end
+  _robot->GetMapComponent().InsertData( Poly2f( {{280, 380}, {320, 380}, {320, 420}, {280, 420}} ), obstacle );
+  EXPECT_EQ(numSegments - 1, cache.Update(map));
+
+  cache.Truncate(2);
+  EXPECT_EQ(2, cache.GetNumSegments());
+  EXPECT_EQ(2, cache.Update(map));
+}
@@ -0,0 +1,278 @@
+/**
+ * File: plannerBenchmark.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Replays planner scenarios recorded on robots (see kRecordPlannerScenarios in PathComponent) against
+ *              every planner, and reports plan time percentiles, expansions, allocations and path cost. Scenarios
+ *              are read from resources/test/plannerScenarios. Disabled by default, run it with
+ *                test_engine --gtest_also_run_disabled_tests --gtest_filter=PlannerBenchmark.*
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "util/helpers/includeGTest.h"
+
+#include "anki/cozmo/shared/cozmoEngineConfig.h"
+#include "coretech/common/engine/math/polygon_impl.h"
+#include "coretech/common/engine/math/rotatedRect.h"
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/planning/engine/xythetaEnvironment.h"
+#include "coretech/planning/engine/xythetaPlanner.h"
+#include "coretech/planning/engine/xythetaPlannerContext.h"
+#include "engine/cozmoContext.h"
+#include "engine/faceAndApproachPlanner.h"
+#include "engine/minimalAnglePlanner.h"
+#include "engine/navMap/mapComponent.h"
+#include "engine/navMap/memoryMap/memoryMap.h"
+#include "engine/navMap/memoryMap/data/memoryMapData.h"
+#include "engine/robot.h"
+#include "engine/xyPlanner.h"
+#include "test/engine/helpers/allocationCounter.h"
+#include "util/fileUtils/fileUtils.h"
+#include "json/json.h"
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+extern CozmoContext* cozmoContext;
+
+namespace {
+
+// times every plan is repeated, for more stable percentiles
+const int kRepetitions = 5;
+
+const char* const kScenarioFolder = "test/plannerScenarios";
+
+// optional motion primitives for the xytheta planner, next to the scenarios
+const char* const kMotionPrimitivesFile = "mprim.json";
+
+struct Scenario {
+  std::string          name;
+  std::string          mapPath;
+  Pose3d               start;
+  std::vector<Pose3d>  goals;
+};
+
+struct PlanResult {
+  float  time_ms        = 0.f;
+  size_t numExpansions  = 0;
+  size_t numAllocations = 0;
+  float  cost           = 0.f;
+  bool   hasPlan        = false;
+};
+
+struct PlannerStats {
+  std::vector<PlanResult> results;
+  size_t                  numFailed = 0;
+};
+
+Pose3d PoseFromJson(const Json::Value& json, const Pose3d& origin)
+{
+  return Pose3d( json["angle_rad"].asFloat(), Z_AXIS_3D(),
+                 {json["x_mm"].asFloat(), json["y_mm"].asFloat(), 0.f}, origin );
+}
+
+float Percentile(std::vector<float> values, float p)
+{
+  if (values.empty()) { return 0.f; }
+  std::sort(values.begin(), values.end());
+  const size_t idx = std::min(values.size() - 1, (size_t) std::round(p * (values.size() - 1)));
+  return values[idx];
+}
+
+float GetPathLength(const Planning::Path& path)
+{
+  float length = 0.f;
+  for (u8 i = 0; i < path.GetNumSegments(); ++i) {
+    length += std::fabs(path.GetSegmentConstRef(i).GetLength());
+  }
+  return length;
+}
+
+// run plan once with allocation counting and timing around it
+PlanResult Measure(const std::function<bool (PlanResult&)>& plan)
+{
+  PlanResult result;
+  AllocationCounter::Start();
+  const auto startTime = std::chrono::steady_clock::now();
+  result.hasPlan = plan(result);
+  const auto endTime = std::chrono::steady_clock::now();
+  result.numAllocations = AllocationCounter::Stop().numAllocations;
+  result.time_ms = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+  return result;
+}
+
+// plan with one of the engine planners. They all finish within ComputePath when they run synchronously
+bool RunEnginePlanner(IPathPlanner& planner, const Scenario& scenario, PlanResult& result)
+{
+  if (planner.ComputePath(scenario.start, scenario.goals) == EComputePathStatus::Error) {
+    return false;
+  }
+  if (planner.CheckPlanningStatus() != EPlannerStatus::CompleteWithPlan) {
+    return false;
+  }
+  result.cost = GetPathLength(planner.GetCompletePath());
+  return true;
+}
+
+// plan with the xytheta planner, with every collision leaf of the map as an obstacle in its c-space
+bool RunXYThetaPlanner(const std::string& mprimPath, const INavMap& map, const Scenario& scenario, PlanResult& result)
+{
+  using namespace Planning;
+  xythetaPlannerContext context;
+  if (!context.env.ReadMotionPrimitives(mprimPath.c_str())) {
+    return false;
+  }
+
+  const float halfSize = ROBOT_BOUNDING_Y * .5f;
+  const ConvexPolygon robot( Poly2f({{-halfSize, -halfSize}, {halfSize, -halfSize}, {halfSize, halfSize}, {-halfSize, halfSize}}) );
+  map.ForEachLeaf( [&](const AxisAlignedQuad& bounds, const MemoryMapTypes::MemoryMapDataPtr& data) {
+    if (!data->IsCollisionType()) { return; }
+    const Point2f& lo = bounds.GetMinVertex();
+    const Point2f& hi = bounds.GetMaxVertex();
+    const ConvexPolygon obstacle( Poly2f({{lo.x(), lo.y()}, {hi.x(), lo.y()}, {hi.x(), hi.y()}, {lo.x(), hi.y()}}) );
+    for (GraphTheta theta = 0; theta < GraphState::numAngles_; ++theta) {
+      context.env.AddObstacleWithExpansion(obstacle, robot, theta);
+    }
+  });
+
+  const auto toState = [](const Pose3d& p) {
+    return State_c(p.GetTranslation().x(), p.GetTranslation().y(), p.GetRotationAngle<'Z'>().ToFloat());
+  };
+  context.start = toState(scenario.start);
+  for (size_t i = 0; i < scenario.goals.size(); ++i) {
+    context.goals_c.emplace_back( (GoalID) i, toState(scenario.goals[i]) );
+  }
+
+  xythetaPlanner planner(context);
+  if (!planner.StartIsValid() || !planner.GoalsAreValid()) {
+    return false;
+  }
+  context.env.PrepareForPlanning();
+  const bool planned = planner.Replan();
+  result.numExpansions = planner.GetLastNumExpansions();
+  result.cost = planner.GetFinalCost();
+  return planned;
+}
+
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(PlannerBenchmark, DISABLED_RecordedScenarios)
+{
+  const auto* platform = cozmoContext->GetDataPlatform();
+  ASSERT_TRUE(platform != nullptr);
+  const std::string folder = platform->pathToResource(Util::Data::Scope::Resources, kScenarioFolder);
+  const std::vector<std::string> files = Util::FileUtils::FilesInDirectory(folder, true, ".json");
+
+  Robot robot(0, cozmoContext);
+  const auto memoryMap = std::dynamic_pointer_cast<MemoryMap>( robot.GetMapComponent().GetCurrentMemoryMap() );
+  ASSERT_TRUE(memoryMap != nullptr);
+
+  // read every scenario, skipping the motion primitives
+  std::vector<Scenario> scenarios;
+  for (const auto& file : files) {
+    Json::Value json;
+    if (Util::FileUtils::GetFileName(file) == kMotionPrimitivesFile) { continue; }
+    if (!platform->readAsJson(file, json) || !json.isMember("map") || !json["goals"].isArray()) {
+      printf("Skipping %s, not a planner scenario\n", file.c_str());
+      continue;
+    }
+
+    Scenario scenario;
+    scenario.name = Util::FileUtils::GetFileName(file, true, true);
+    scenario.mapPath = Util::FileUtils::FullFilePath({folder, json["map"].asString()});
+    scenario.start = PoseFromJson(json["start"], robot.GetWorldOrigin());
+    for (const auto& goal : json["goals"]) {
+      scenario.goals.push_back( PoseFromJson(goal, robot.GetWorldOrigin()) );
+    }
+    if (!scenario.goals.empty()) {
+      scenarios.push_back( std::move(scenario) );
+    }
+  }
+
+  if (scenarios.empty()) {
+    printf("No recorded planner scenarios in %s, nothing to benchmark\n", folder.c_str());
+    return;
+  }
+
+  const std::string mprimPath = Util::FileUtils::FullFilePath({folder, kMotionPrimitivesFile});
+  const bool hasMotionPrimitives = Util::FileUtils::FileExists(mprimPath);
+  if (!hasMotionPrimitives) {
+    printf("No %s in %s, skipping xythetaPlanner\n", kMotionPrimitivesFile, folder.c_str());
+  }
+
+  std::map<std::string, PlannerStats> stats;
+  const auto record = [&stats](const std::string& plannerName, const PlanResult& result) {
+    PlannerStats& s = stats[plannerName];
+    s.results.push_back(result);
+    s.numFailed += result.hasPlan ? 0 : 1;
+  };
+
+  for (const auto& scenario : scenarios) {
+    ASSERT_TRUE( memoryMap->Load(scenario.mapPath, robot.GetWorldOrigin()) ) << "could not load " << scenario.mapPath;
+
+    for (int rep = 0; rep < kRepetitions; ++rep) {
+      // a fresh planner every time, so the anytime search cannot reuse the previous plan
+      {
+        XYPlanner planner(&robot, true);
+        PlanResult result = Measure([&](PlanResult& r) { return RunEnginePlanner(planner, scenario, r); });
+        result.numExpansions = planner.GetLastNumExpansions();
+        record(planner.GetName(), result);
+      }
+      {
+        MinimalAnglePlanner planner;
+        record(planner.GetName(), Measure([&](PlanResult& r) { return RunEnginePlanner(planner, scenario, r); }));
+      }
+      {
+        FaceAndApproachPlanner planner;
+        record(planner.GetName(), Measure([&](PlanResult& r) { return RunEnginePlanner(planner, scenario, r); }));
+      }
+      if (hasMotionPrimitives) {
+        record("xythetaPlanner", Measure([&](PlanResult& r) { return RunXYThetaPlanner(mprimPath, *memoryMap, scenario, r); }));
+      }
+    }
+  }
+
+  // report, and keep a copy to compare runs against each other
+  Json::Value report;
+  printf("%zu scenarios, %d repetitions\n", scenarios.size(), kRepetitions);
+  printf("%-16s %8s %8s %8s %8s %10s %10s %10s\n",
+         "planner", "p50 ms", "p90 ms", "p99 ms", "max ms", "exp/plan", "alloc/plan", "cost/plan");
+  for (const auto& entry : stats) {
+    const auto& results = entry.second.results;
+    std::vector<float> times;
+    float expansions = 0.f, allocations = 0.f, cost = 0.f;
+    for (const auto& r : results) {
+      times.push_back(r.time_ms);
+      expansions  += r.numExpansions;
+      allocations += r.numAllocations;
+      cost        += r.hasPlan ? r.cost : 0.f;
+    }
+    const size_t numPlans = results.size() - entry.second.numFailed;
+    const float n = std::max<float>(1.f, results.size());
+
+    Json::Value& json = report[entry.first];
+    json["p50_ms"]          = Percentile(times, .5f);
+    json["p90_ms"]          = Percentile(times, .9f);
+    json["p99_ms"]          = Percentile(times, .99f);
+    json["max_ms"]          = Percentile(times, 1.f);
+    json["expansions"]      = expansions / n;
+    json["allocations"]     = allocations / n;
+    json["cost"]            = cost / std::max<float>(1.f, numPlans);
+    json["failed"]          = (Json::UInt) entry.second.numFailed;
+
+    printf("%-16s %8.2f %8.2f %8.2f %8.2f %10.0f %10.0f %10.1f  (%zu failed)\n", entry.first.c_str(),
+           json["p50_ms"].asFloat(), json["p90_ms"].asFloat(), json["p99_ms"].asFloat(), json["max_ms"].asFloat(),
+           json["expansions"].asFloat(), json["allocations"].asFloat(), json["cost"].asFloat(), entry.second.numFailed);
+  }
+
+  EXPECT_TRUE( platform->writeAsJson(Util::Data::Scope::Cache, "plannerBenchmark/report.json", report) );
+}
@@ -234,7 +234,7 @@ TEST(BlockWorld, AddAndRemoveObject)
   // by BlockWorld
 
   // Tick BlockWorld, which will use the queued marker
-  std::list<Vision::ObservedMarker> markers{marker};
+  std::vector<Vision::ObservedMarker> markers{marker};
   lastResult = robot.GetBlockWorld().UpdateObservedMarkers(markers);
   ASSERT_EQ(lastResult, RESULT_OK);
 
@@ -285,7 +285,7 @@ TEST(BlockWorld, AddAndRemoveObject)
 
   // After NOT seeing the object three times, it should still be known
   // because we don't yet have evidence that actually isn't there
-  std::list<Vision::ObservedMarker> emptyMarkersList;
+  std::vector<Vision::ObservedMarker> emptyMarkersList;
   const s32 kNumObservations = 3;
   for(s32 i=0; i<kNumObservations; ++i)
   {
@@ -338,7 +338,7 @@ TEST(BlockWorld, AddAndRemoveObject)
     lastResult = robot.UpdateFullRobotState(fakeRobotState(stateMsgTimestamp));
     ASSERT_EQ(RESULT_OK, lastResult);
     Vision::ObservedMarker markerFar(stateMsgTimestamp, testCode, corners, robot.GetVisionComponent().GetCamera());
-    std::list<Vision::ObservedMarker> markersFar{markerFar};
+    std::vector<Vision::ObservedMarker> markersFar{markerFar};
     lastResult = robot.GetBlockWorld().UpdateObservedMarkers(markersFar);
     ASSERT_EQ(lastResult, RESULT_OK);
   }
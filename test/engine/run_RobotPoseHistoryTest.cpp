@@ -283,20 +283,129 @@ TEST(RobotStateHistory, CullToWindowSizeTest)
     }
   }
 
-  printf("CullToWindowSizeTest: raw %zu, vis %zu, comp %zu, keyByTs %zu, tsByKey %zu\n",
+  printf("CullToWindowSizeTest: raw %zu, vis %zu, comp %zu\n",
          hist._states.size(),
          hist._visStates.size(),
-         hist._computedStates.size(),
-         hist._keyByTsMap.size(),
-         hist._tsByKeyMap.size());
+         hist.GetNumComputedStates());
 
   
   // Verify that history stays at size no larger than 3s
   ASSERT_TRUE(hist._states.size() == 31);
   
   ASSERT_TRUE(hist._visStates.size() == 0);
-  ASSERT_TRUE(hist._computedStates.size() == 3);
-  ASSERT_TRUE(hist._keyByTsMap.size() == 3);
-  ASSERT_TRUE(hist._tsByKeyMap.size() == 3);
+  ASSERT_TRUE(hist.GetNumComputedStates() == 3);
   
 }
+
+TEST(RobotStateHistory, OutOfOrderRawStates)
+{
+  using namespace Anki;
+  using namespace Vector;
+  
+  RobotStateHistory hist;
+  hist.SetTimeWindow(1000);
+  
+  const Pose3d p(0, Z_AXIS_3D(), Vec3f(0,0,0), origin );
+  RobotState state(Robot::GetDefaultRobotState());
+  
+  // States are kept sorted by time however they arrive
+  for (const TimeStamp_t t : {20, 10, 40, 30, 0}) {
+    state.headAngle = 0.01f * t;
+    ASSERT_TRUE(hist.AddRawOdomState(t, HistRobotState(p, state, proxSensorValid)) == RESULT_OK);
+  }
+  ASSERT_TRUE(hist.AddRawOdomState(30, HistRobotState(p, state, proxSensorValid)) == RESULT_FAIL);
+  ASSERT_EQ(5u, hist.GetNumRawStates());
+  
+  TimeStamp_t expectedTime = 0;
+  for (const auto& entry : hist.GetRawStates()) {
+    EXPECT_EQ(expectedTime, (TimeStamp_t)entry.first);
+    EXPECT_FLOAT_EQ(0.01f * expectedTime, entry.second.GetHeadAngle_rad());
+    expectedTime += 10;
+  }
+  
+  // Interpolated lookup between two of them
+  RobotTimeStamp_t t;
+  HistRobotState histState;
+  ASSERT_TRUE(hist.GetRawStateAt(25, t, histState, true) == RESULT_OK);
+  EXPECT_EQ(25, (TimeStamp_t)t);
+  EXPECT_NEAR(0.25f, histState.GetHeadAngle_rad(), 1e-5f);
+}
+
+TEST(RobotStateHistory, ComputedStateKeys)
+{
+  using namespace Anki;
+  using namespace Vector;
+  
+  RobotStateHistory hist;
+  hist.SetTimeWindow(1000);
+  
+  const Pose3d p(0, Z_AXIS_3D(), Vec3f(0,0,0), origin );
+  RobotState state(Robot::GetDefaultRobotState());
+  HistRobotState histState(p, state, proxSensorValid);
+  for (TimeStamp_t t = 0; t <= 500; t += 10) {
+    hist.AddRawOdomState(t, histState);
+  }
+  
+  RobotTimeStamp_t t;
+  HistRobotState* firstPtr = nullptr;
+  HistStateKey firstKey = 0;
+  ASSERT_TRUE(hist.ComputeAndInsertStateAt(100, t, &firstPtr, &firstKey) == RESULT_OK);
+  EXPECT_TRUE(hist.IsValidKey(firstKey));
+  
+  // Inserting more computed states doesn't move the first one, and recomputing it keeps its key
+  for (TimeStamp_t tc = 110; tc <= 300; tc += 10) {
+    HistRobotState* statePtr = nullptr;
+    ASSERT_TRUE(hist.ComputeAndInsertStateAt(tc, t, &statePtr) == RESULT_OK);
+  }
+  HistRobotState* againPtr = nullptr;
+  HistStateKey againKey = 0;
+  ASSERT_TRUE(hist.ComputeAndInsertStateAt(100, t, &againPtr, &againKey) == RESULT_OK);
+  EXPECT_EQ(firstPtr, againPtr);
+  EXPECT_EQ(firstKey, againKey);
+  EXPECT_EQ(21u, hist.GetNumComputedStates());
+  
+  // Culled along with the raw states
+  for (TimeStamp_t tr = 510; tr <= 1150; tr += 10) {
+    hist.AddRawOdomState(tr, histState);
+  }
+  EXPECT_FALSE(hist.IsValidKey(firstKey));
+  const HistRobotState* culledPtr = nullptr;
+  EXPECT_TRUE(hist.GetComputedStateAt(100, &culledPtr) == RESULT_FAIL);
+  EXPECT_EQ(16u, hist.GetNumComputedStates());
+}
+
+TEST(RobotStateHistory, MultipleOrigins)
+{
+  using namespace Anki;
+  using namespace Vector;
+  
+  // Outlives the history, which refers to it
+  const Pose3d otherOrigin(0, Z_AXIS_3D(), {0,0,0}, "OtherOrigin");
+  
+  RobotStateHistory hist;
+  hist.SetTimeWindow(1000);
+  
+  const Pose3d p1(0.1f, Z_AXIS_3D(), Vec3f(10,0,0), origin);
+  const Pose3d p2(0.2f, Z_AXIS_3D(), Vec3f(20,0,0), otherOrigin);
+  RobotState state(Robot::GetDefaultRobotState());
+  
+  ASSERT_TRUE(hist.AddRawOdomState(0,  HistRobotState(p1, state, proxSensorValid)) == RESULT_OK);
+  ASSERT_TRUE(hist.AddRawOdomState(10, HistRobotState(p1, state, proxSensorValid)) == RESULT_OK);
+  ASSERT_TRUE(hist.AddRawOdomState(20, HistRobotState(p2, state, proxSensorValid)) == RESULT_OK);
+  
+  // Poses come back w.r.t. the origin they were added w.r.t.
+  RobotTimeStamp_t t;
+  HistRobotState histState;
+  ASSERT_TRUE(hist.GetRawStateAt(10, t, histState) == RESULT_OK);
+  EXPECT_TRUE(histState.GetPose().IsChildOf(origin));
+  EXPECT_TRUE(histState.GetPose().IsSameAs(p1, DIST_EQ_THRESH, ANGLE_EQ_THRESH));
+  
+  ASSERT_TRUE(hist.GetRawStateAt(20, t, histState) == RESULT_OK);
+  EXPECT_TRUE(histState.GetPose().IsChildOf(otherOrigin));
+  EXPECT_TRUE(histState.GetPose().IsSameAs(p2, DIST_EQ_THRESH, ANGLE_EQ_THRESH));
+  
+  EXPECT_TRUE(hist.GetPose(hist.GetRawStates().begin()->second).IsChildOf(origin));
+  
+  // Can't interpolate between the two origins
+  EXPECT_TRUE(hist.GetRawStateAt(15, t, histState, true) == RESULT_FAIL_ORIGIN_MISMATCH);
+}
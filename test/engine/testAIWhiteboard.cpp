@@ -0,0 +1,85 @@
+/**
+ * File: testAIWhiteboard.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for the object failure tracking in AIWhiteboard
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=AIWhiteboard*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "coretech/common/engine/utils/timer.h"
+#include "engine/aiComponent/aiComponent.h"
+#include "engine/aiComponent/aiWhiteboard.h"
+#include "engine/block.h"
+#include "engine/cozmoContext.h"
+#include "engine/robot.h"
+#include "util/math/math.h"
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+extern CozmoContext* cozmoContext;
+
+namespace {
+  void AdvanceTime_s(float seconds)
+  {
+    auto* timer = BaseStationTimer::getInstance();
+    const BaseStationTime_t elapsed_ns = static_cast<BaseStationTime_t>(Util::SecToNanoSec(seconds));
+    timer->UpdateTime(timer->GetCurrentTimeInNanoSeconds() + elapsed_ns);
+  }
+}
+
+TEST(AIWhiteboard, FailuresKeepNewestPerObject)
+{
+  using Failure = AIWhiteboard::ObjectActionFailure;
+
+  Robot robot(0, cozmoContext);
+  AIWhiteboard& whiteboard = robot.GetAIComponent().GetComponent<AIWhiteboard>();
+
+  Block block(ObjectType::Block_LIGHTCUBE1);
+  block.SetID();
+  Pose3d blockPose;
+  blockPose.SetParent(robot.GetWorldOrigin());
+  block.InitPose(blockPose, PoseState::Known);
+  const int objectID = block.GetID().GetValue();
+
+  EXPECT_FALSE(whiteboard.DidFailToUse(objectID, Failure::PickUpObject));
+  EXPECT_FALSE(whiteboard.DidFailToUse(AIWhiteboard::ANY_OBJECT, {Failure::PickUpObject, Failure::PlaceObjectAt}));
+
+  // PlaceObjectAt keeps the newest 10 per object, so the oldest locations fall out
+  const size_t numPlaceFailures = 12;
+  for( size_t i = 0; i < numPlaceFailures; ++i ) {
+    const Pose3d location(0.0f, Z_AXIS_3D(), {100.0f * i, 0.0f, 0.0f}, robot.GetWorldOrigin());
+    whiteboard.SetFailedToUse(block, Failure::PlaceObjectAt, location);
+    AdvanceTime_s(1.0f);
+  }
+  EXPECT_EQ(numPlaceFailures, whiteboard.GetFailuresGeneration());
+
+  auto failedAt = [&](size_t i, float recentSecs) {
+    const Pose3d location(0.0f, Z_AXIS_3D(), {100.0f * i, 0.0f, 0.0f}, robot.GetWorldOrigin());
+    return whiteboard.DidFailToUse(objectID, Failure::PlaceObjectAt, recentSecs, location, 10.0f, M_PI_F);
+  };
+  EXPECT_FALSE(failedAt(0, -1.0f));
+  EXPECT_FALSE(failedAt(1, -1.0f));
+  EXPECT_TRUE(failedAt(2, -1.0f));
+  EXPECT_TRUE(failedAt(numPlaceFailures - 1, -1.0f));
+  // the newest one was a second ago
+  EXPECT_TRUE(failedAt(numPlaceFailures - 1, 1.5f));
+  EXPECT_FALSE(failedAt(numPlaceFailures - 1, 0.5f));
+
+  // other actions only keep the newest failure, and are tracked separately
+  EXPECT_FALSE(whiteboard.DidFailToUse(objectID, Failure::PickUpObject));
+  whiteboard.SetFailedToUse(block, Failure::PickUpObject);
+  whiteboard.SetFailedToUse(block, Failure::PickUpObject);
+  EXPECT_TRUE(whiteboard.DidFailToUse(objectID, Failure::PickUpObject, 0.5f));
+  EXPECT_TRUE(whiteboard.DidFailToUse(AIWhiteboard::ANY_OBJECT, {Failure::StackOnObject, Failure::PickUpObject}));
+  EXPECT_FALSE(whiteboard.DidFailToUse(objectID, {Failure::StackOnObject, Failure::RollOrPopAWheelie}));
+  EXPECT_FALSE(whiteboard.DidFailToUse(objectID + 1, Failure::PickUpObject));
+}
@@ -42,10 +42,12 @@ class TestAction : public IAction
     TestAction(Robot& r, const std::string & name, RobotActionType type, u8 tracks = 0);
     virtual ~TestAction() { actionsDestroyed.push_back(GetName()); }
     int _numRetries = 0;
+    int _numPrepares = 0;
     bool _complete = false;
   protected:
     virtual ActionResult Init() override;
     virtual ActionResult CheckIfDone() override;
+    virtual void PrepareInternal() override { ++_numPrepares; }
 };
 
 TestAction::TestAction(Robot& r, const std::string & name, RobotActionType type, u8 tracks)
@@ -108,7 +110,7 @@ public:
                                const std::initializer_list<IActionRunner*> & actions,
                                const std::string & name);
   virtual ~TestCompoundActionSequential() { actionsDestroyed.push_back(_name); }
-  virtual std::list<std::shared_ptr<IActionRunner>>& GetActions() { return _actions; }
+  virtual ChildActionList& GetActions() { return _actions; }
 private:
   std::string _name;
 };
@@ -129,7 +131,7 @@ class TestCompoundActionParallel : public CompoundActionParallel
 public:
   TestCompoundActionParallel(Robot& r, const std::initializer_list<IActionRunner*> & actions, const std::string & name);
   virtual ~TestCompoundActionParallel() { actionsDestroyed.push_back(_name); }
-  virtual std::list<std::shared_ptr<IActionRunner>>& GetActions() { return _actions; }
+  virtual ChildActionList& GetActions() { return _actions; }
 private:
   std::string _name;
 };
@@ -1510,6 +1512,58 @@ TEST(QueueAction, ComplexNestedAction)
 }
 
 
+// Tests that only the action expected to run next is prepared, and only until it starts
+TEST(QueueAction, PrepareNextAction)
+{
+  Robot r(0, cozmoContext);
+  auto * testAction1 = new TestAction(r, "Test1", RobotActionType::WAIT, track1);
+  auto * testAction2 = new TestAction(r, "Test2", RobotActionType::WAIT, track2);
+  auto * testAction3 = new TestAction(r, "Test3", RobotActionType::WAIT, track3);
+  auto * testAction4 = new TestAction(r, "Test4", RobotActionType::WAIT, track3);
+  auto * compoundAction = new TestCompoundActionSequential(r, {testAction3, testAction4}, "Comp1");
+
+  auto & actionList = r.GetActionList();
+
+  actionList.QueueAction(QueueActionPosition::AT_END, testAction1);
+  actionList.QueueAction(QueueActionPosition::AT_END, testAction2);
+  actionList.QueueAction(QueueActionPosition::AT_END, compoundAction);
+
+  Update(actionList);
+  Update(actionList);
+
+  EXPECT_EQ(testAction1->_numPrepares, 0);
+  EXPECT_EQ(testAction2->_numPrepares, 2);
+  EXPECT_EQ(testAction3->_numPrepares, 0);
+
+  testAction1->_complete = true;
+  Update(actionList);
+  Update(actionList);
+
+  // Test2 has started, and the first action of the compound action is next
+  EXPECT_TRUE(actionList.IsCurrAction("Test2"));
+  EXPECT_EQ(testAction2->_numPrepares, 2);
+  EXPECT_EQ(testAction3->_numPrepares, 1);
+  EXPECT_EQ(testAction4->_numPrepares, 0);
+
+  testAction2->_complete = true;
+  Update(actionList);
+  Update(actionList);
+
+  // Within the compound action, Test4 is prepared while Test3 runs
+  EXPECT_TRUE(actionList.IsCurrAction("Comp1"));
+  EXPECT_EQ(testAction3->_numPrepares, 1);
+  EXPECT_EQ(testAction4->_numPrepares, 1);
+
+  testAction3->_complete = true;
+  testAction4->_complete = true;
+  Update(actionList);
+  Update(actionList);
+
+  EXPECT_EQ(actionList.GetQueueLength(0), 0);
+  CheckActionDestroyed({"Test1", "Test2", "Test3", "Test4", "Comp1"});
+}
+
+
 // Tests setting two unique tags
 TEST(ActionTag, UniqueUnityTags)
 {
@@ -0,0 +1,67 @@
+/**
+ * File: testAnkiDenseEventMgr.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for AnkiDenseEventMgr
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=AnkiDenseEventMgr*
+ **/
+
+#include "engine/events/ankiEventMgr.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+TEST(AnkiDenseEventMgr, DeliversByType)
+{
+  AnkiDenseEventMgr<int> eventMgr;
+  std::vector<uint32_t> received;
+  auto handler = [&received](const AnkiEvent<int>& event) {
+    received.push_back(event.GetType());
+    EXPECT_EQ(event.GetType() * 10, event.GetData());
+  };
+
+  EXPECT_FALSE(eventMgr.HasSubscribers(3));
+  Signal::SmartHandle handle3 = eventMgr.Subscribe(3, handler);
+  Signal::SmartHandle handle0 = eventMgr.Subscribe(0, handler);
+  EXPECT_TRUE(eventMgr.HasSubscribers(3));
+  EXPECT_TRUE(eventMgr.HasSubscribers(0));
+  EXPECT_FALSE(eventMgr.HasSubscribers(1));
+  EXPECT_FALSE(eventMgr.HasSubscribers(200));
+
+  for (uint32_t type=0; type<5; ++type) {
+    eventMgr.Broadcast(AnkiEvent<int>(type, static_cast<int>(type * 10)));
+  }
+  // Past the end of the table
+  eventMgr.Broadcast(AnkiEvent<int>(200, 2000));
+
+  const std::vector<uint32_t> expected{0, 3};
+  EXPECT_EQ(expected, received);
+}
+
+TEST(AnkiDenseEventMgr, UnsubscribesWithHandle)
+{
+  AnkiDenseEventMgr<int> eventMgr;
+  int numReceived = 0;
+  Signal::SmartHandle handle = eventMgr.Subscribe(2, [&numReceived](const AnkiEvent<int>&) { ++numReceived; });
+
+  // Growing the table must not invalidate the handle
+  Signal::SmartHandle otherHandle = eventMgr.Subscribe(100, [](const AnkiEvent<int>&) {});
+
+  eventMgr.Broadcast(AnkiEvent<int>(2, 20));
+  EXPECT_EQ(1, numReceived);
+
+  handle = nullptr;
+  EXPECT_FALSE(eventMgr.HasSubscribers(2));
+  EXPECT_TRUE(eventMgr.HasSubscribers(100));
+  eventMgr.Broadcast(AnkiEvent<int>(2, 20));
+  EXPECT_EQ(1, numReceived);
+}
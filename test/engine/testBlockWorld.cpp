@@ -441,3 +441,54 @@ TEST_F(BlockWorldTest, ObservationDistance)
   ASSERT_EQ(object->GetLastObservedTime(), fakeTimestamp_ms);
 }
 
+
+TEST_F(BlockWorldTest, IndexedLocatedObjectSearches)
+{
+  auto& blockWorld = _robot->GetBlockWorld();
+  const Pose3d& origin = _robot->GetWorldOrigin();
+  
+  // A row of small fixed obstacles along x
+  std::vector<ObjectID> ids;
+  for(int i = 0; i < 5; ++i) {
+    const Pose3d pose(0, Z_AXIS_3D(), {200.f * i, 100.f, 0.f});
+    ids.push_back(blockWorld.CreateFixedCustomObject(pose, 20.f, 20.f, 20.f));
+    ASSERT_TRUE(ids.back().IsSet());
+  }
+  
+  BlockWorldFilter filter;
+  filter.AddAllowedType(ObjectType::CustomFixedObstacle);
+  
+  // Closest to a point between the second and third obstacle, nearer the third
+  const Pose3d queryPose(0, Z_AXIS_3D(), {330.f, 100.f, 0.f}, origin);
+  const auto* closest = blockWorld.FindLocatedObjectClosestTo(queryPose, filter);
+  ASSERT_NE(nullptr, closest);
+  EXPECT_EQ(ids[2], closest->GetID());
+  
+  // Nothing within the threshold
+  EXPECT_EQ(nullptr, blockWorld.FindLocatedObjectClosestTo(queryPose, Vec3f{50.f}, filter));
+  
+  // No objects of a type the origin doesn't have
+  BlockWorldFilter chargerFilter;
+  chargerFilter.AddAllowedType(ObjectType::Charger_Basic);
+  EXPECT_EQ(nullptr, blockWorld.FindLocatedObjectClosestTo(queryPose, chargerFilter));
+  
+  // Region search around the fourth obstacle
+  const Quad2f quad{Point2f(580.f, 80.f), Point2f(580.f, 120.f), Point2f(620.f, 80.f), Point2f(620.f, 120.f)};
+  std::vector<const ObservableObject*> intersecting;
+  blockWorld.FindLocatedIntersectingObjects(quad, intersecting, 0.f, filter);
+  ASSERT_EQ(1, intersecting.size());
+  EXPECT_EQ(ids[3], intersecting.front()->GetID());
+  
+  // Moving an object shows up in the next searches
+  const Pose3d newPose(0, Z_AXIS_3D(), {325.f, 100.f, 0.f}, origin);
+  ASSERT_EQ(RESULT_OK, blockWorld.SetObjectPose(ids[0], newPose, PoseState::Known));
+  closest = blockWorld.FindLocatedObjectClosestTo(queryPose, filter);
+  ASSERT_NE(nullptr, closest);
+  EXPECT_EQ(ids[0], closest->GetID());
+  
+  const Quad2f quad2{Point2f(300.f, 80.f), Point2f(300.f, 120.f), Point2f(340.f, 80.f), Point2f(340.f, 120.f)};
+  intersecting.clear();
+  blockWorld.FindLocatedIntersectingObjects(quad2, intersecting, 0.f, filter);
+  ASSERT_EQ(1, intersecting.size());
+  EXPECT_EQ(ids[0], intersecting.front()->GetID());
+}
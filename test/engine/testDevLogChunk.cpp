@@ -0,0 +1,126 @@
+/**
+ * File: testDevLogChunk.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for writing and replaying chunked dev logs
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=DevLogChunk*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "engine/cozmoContext.h"
+#include "engine/debug/devLogChunkWriter.h"
+#include "engine/debug/devLogReaderChunked.h"
+#include "util/fileUtils/fileUtils.h"
+
+#include <cstring>
+#include <memory>
+
+extern Anki::Vector::CozmoContext* cozmoContext;
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+  constexpr uint32_t kNumRecords = 300;
+  constexpr uint32_t kRecordSpacing_ms = 10;
+
+  // a record in the raw log layout (size, timestamp, then the message, whose first byte is its tag). Big enough that
+  // the test spans several chunks
+  std::string MakeRecord(uint32_t timestamp_ms, uint8_t tag)
+  {
+    std::string record(1024, '\0');
+    const uint32_t size = static_cast<uint32_t>(record.size());
+    std::memcpy(&record[0], &size, sizeof(size));
+    std::memcpy(&record[sizeof(size)], &timestamp_ms, sizeof(timestamp_ms));
+    record[2 * sizeof(uint32_t)] = static_cast<char>(tag);
+    return record;
+  }
+
+  uint8_t TagForRecord(uint32_t index) { return (index % 2 == 0) ? 1 : 2; }
+
+  std::string WriteTestLog(const std::string& name, bool compress)
+  {
+    const std::string directory = cozmoContext->GetDataPlatform()->pathToResource(Util::Data::Scope::Cache, name);
+    Util::FileUtils::RemoveDirectory(directory);
+
+    DevLogChunkWriter writer(nullptr, directory, compress);
+    for (uint32_t i = 0; i < kNumRecords; ++i)
+    {
+      writer.Write(TagForRecord(i), i * kRecordSpacing_ms, MakeRecord(i * kRecordSpacing_ms, TagForRecord(i)));
+    }
+    return directory;
+  }
+
+}
+
+TEST(DevLogChunk, ReplayAndSeek)
+{
+  for (const bool compress : {true, false})
+  {
+    const std::string directory = WriteTestLog("testDevLogChunk", compress);
+    ASSERT_TRUE(DevLogReaderChunked::HasChunkedLogs(directory));
+
+    DevLogReaderChunked reader(directory);
+    reader.Init();
+    EXPECT_EQ((kNumRecords - 1) * kRecordSpacing_ms, reader.GetFinalTime());
+
+    std::vector<uint32_t> timestamps;
+    reader.SetDataCallback([&timestamps](const DevLogReader::LogData& logData) {
+      EXPECT_EQ(1024 - 2 * sizeof(uint32_t), logData._data.size());
+      timestamps.push_back(logData._timestamp_ms);
+    });
+
+    reader.AdvanceTime(100);
+    ASSERT_EQ(11, timestamps.size());
+    EXPECT_EQ(100, timestamps.back());
+
+    // forward, past several chunks
+    timestamps.clear();
+    reader.SeekToTime(2005);
+    reader.AdvanceTime(0);
+    EXPECT_TRUE(timestamps.empty());
+    reader.AdvanceTime(5);
+    ASSERT_EQ(1, timestamps.size());
+    EXPECT_EQ(2010, timestamps.front());
+
+    // and back to the start
+    timestamps.clear();
+    reader.SeekToTime(0);
+    reader.AdvanceTime(0);
+    ASSERT_EQ(1, timestamps.size());
+    EXPECT_EQ(0, timestamps.front());
+
+    // to the end
+    timestamps.clear();
+    reader.AdvanceTime(kNumRecords * kRecordSpacing_ms);
+    EXPECT_EQ(kNumRecords - 1, timestamps.size());
+  }
+}
+
+TEST(DevLogChunk, TagFilter)
+{
+  const std::string directory = WriteTestLog("testDevLogChunkTags", true);
+
+  DevLogReaderChunked reader(directory);
+  reader.Init();
+  reader.SetTagFilter({2});
+
+  std::vector<uint32_t> timestamps;
+  reader.SetDataCallback([&timestamps](const DevLogReader::LogData& logData) {
+    EXPECT_EQ(2, logData._data[0]);
+    timestamps.push_back(logData._timestamp_ms);
+  });
+
+  reader.AdvanceTime(kNumRecords * kRecordSpacing_ms);
+  ASSERT_EQ(kNumRecords / 2, timestamps.size());
+  EXPECT_EQ(kRecordSpacing_ms, timestamps.front());
+}
@@ -0,0 +1,129 @@
+/**
+ * File: testEngineTickScheduler.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-15
+ *
+ * Description: Unit tests for the EngineTickScheduler
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=EngineTickScheduler*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/engineTickScheduler.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+  constexpr uint32_t kTickPeriod_ms = 60;
+}
+
+TEST(EngineTickScheduler, RunsTasksAtTheirRates)
+{
+  EngineTickScheduler scheduler(kTickPeriod_ms);
+
+  int everyTick = 0;
+  int fastTask = 0;
+  int twoHz = 0;
+  int oneHz = 0;
+  scheduler.RegisterTask("everyTick", EngineTickScheduler::kEveryTick, [&everyTick]() { ++everyTick; });
+  scheduler.RegisterTask("fast", 100.f, [&fastTask]() { ++fastTask; });
+  const auto twoHzHandle = scheduler.RegisterTask("twoHz", 2.f, [&twoHz]() { ++twoHz; });
+  const auto oneHzHandle = scheduler.RegisterTask("oneHz", 1.f, [&oneHz]() { ++oneHz; });
+
+  EXPECT_EQ(8, scheduler.GetTaskPeriod_ticks(twoHzHandle));
+  EXPECT_EQ(17, scheduler.GetTaskPeriod_ticks(oneHzHandle));
+
+  const int numTicks = 17 * 8;
+  for (int i = 0; i < numTicks; ++i) {
+    scheduler.RunDueTasks();
+  }
+
+  EXPECT_EQ(numTicks, everyTick);
+  EXPECT_EQ(numTicks, fastTask);
+  EXPECT_EQ(17, twoHz);
+  EXPECT_EQ(8, oneHz);
+}
+
+TEST(EngineTickScheduler, StaggersLowRateTasks)
+{
+  EngineTickScheduler scheduler(kTickPeriod_ms);
+
+  // Five tasks at the same rate should each get a tick of their own
+  const float rate_hz = 1000.f / (5 * kTickPeriod_ms);
+  std::vector<int> ranOnTick;
+  int tick = 0;
+  for (int i = 0; i < 5; ++i) {
+    const auto handle = scheduler.RegisterTask("task", rate_hz, [&ranOnTick, &tick]() { ranOnTick.push_back(tick); });
+    EXPECT_EQ(5, scheduler.GetTaskPeriod_ticks(handle));
+  }
+
+  for (tick = 0; tick < 5; ++tick) {
+    scheduler.RunDueTasks();
+  }
+
+  ASSERT_EQ(5, ranOnTick.size());
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(i, ranOnTick[i]);
+  }
+}
+
+TEST(EngineTickScheduler, UnregisterFromWithinTask)
+{
+  EngineTickScheduler scheduler(kTickPeriod_ms);
+
+  int numRuns = 0;
+  EngineTickScheduler::TaskHandle handle = EngineTickScheduler::kInvalidTaskHandle;
+  handle = scheduler.RegisterTask("once", EngineTickScheduler::kEveryTick, [&]() {
+    ++numRuns;
+    scheduler.UnregisterTask(handle);
+  });
+
+  scheduler.RunDueTasks();
+  scheduler.RunDueTasks();
+  EXPECT_EQ(1, numRuns);
+  EXPECT_EQ(0, scheduler.GetTaskPeriod_ticks(handle));
+}
+
+TEST(EngineTickScheduler, WakesEarlyOnlyForUrgentData)
+{
+  using Clock = EngineTickScheduler::Clock;
+
+  int sockets[2];
+  ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_DGRAM, 0, sockets));
+
+  EngineTickScheduler scheduler(kTickPeriod_ms);
+  scheduler.SetWakeSocket(sockets[0]);
+
+  // Receives one datagram, urgent if it starts with a 1
+  auto onReadable = [&sockets]() {
+    char data = 0;
+    return (recv(sockets[0], &data, 1, 0) == 1) && (data == 1);
+  };
+
+  const char notUrgent = 0;
+  ASSERT_EQ(1, send(sockets[1], &notUrgent, 1, 0));
+  auto start = Clock::now();
+  EXPECT_FALSE(scheduler.WaitForNextTick(start, start + std::chrono::milliseconds(50), onReadable));
+  EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(50));
+
+  const char urgent = 1;
+  ASSERT_EQ(1, send(sockets[1], &urgent, 1, 0));
+  start = Clock::now();
+  EXPECT_TRUE(scheduler.WaitForNextTick(start + std::chrono::milliseconds(5), start + std::chrono::seconds(5), onReadable));
+  EXPECT_LT(Clock::now() - start, std::chrono::seconds(1));
+  EXPECT_EQ(1, scheduler.GetNumEarlyTicks());
+
+  close(sockets[0]);
+  close(sockets[1]);
+}
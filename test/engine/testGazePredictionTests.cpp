@@ -73,7 +73,7 @@ TEST(EyeContact, GazeEstimationInterface)
     lastResult = image.Load(filename);
 
     // Do the gaze estimation
-    std::list<TrackedFace> faces;
+    std::vector<TrackedFace> faces;
     std::list<UpdatedFaceID> updatedIDs;
     DebugImageList<CompressedImage> debugImages;
     const float cropFactor = 1.f;
@@ -0,0 +1,47 @@
+/**
+ * File: testImageSaver.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-15
+ *
+ * Description: Unit tests for picking the sharpest frame of a photo burst
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=ImageSaver*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "coretech/vision/engine/image.h"
+#include "engine/vision/imageSaver.h"
+
+#include "opencv2/imgproc/imgproc.hpp"
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+TEST(ImageSaver, SharpnessPrefersInFocusImages)
+{
+  // Checkerboard
+  Vision::Image sharp(120, 160, u8(0));
+  for (s32 i = 0; i < sharp.GetNumRows(); ++i) {
+    u8* row = sharp.GetRow(i);
+    for (s32 j = 0; j < sharp.GetNumCols(); ++j) {
+      row[j] = (((i / 10) + (j / 10)) % 2 == 0) ? 255 : 0;
+    }
+  }
+
+  Vision::Image blurry(sharp.GetNumRows(), sharp.GetNumCols());
+  cv::GaussianBlur(sharp.get_CvMat_(), blurry.get_CvMat_(), cv::Size(9, 9), 3.0);
+
+  const Vision::Image flat(sharp.GetNumRows(), sharp.GetNumCols(), u8(128));
+
+  const f32 sharpScore  = ImageSaver::ComputeSharpness(sharp);
+  const f32 blurryScore = ImageSaver::ComputeSharpness(blurry);
+  EXPECT_GT(sharpScore, blurryScore);
+  EXPECT_GT(blurryScore, 0.f);
+  EXPECT_FLOAT_EQ(0.f, ImageSaver::ComputeSharpness(flat));
+  EXPECT_FLOAT_EQ(0.f, ImageSaver::ComputeSharpness(Vision::Image()));
+}
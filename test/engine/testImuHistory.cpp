@@ -0,0 +1,74 @@
+/**
+ * File: testImuHistory.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-15
+ *
+ * Description: Unit tests for timestamp queries on ImuHistory
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=ImuHistory*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/components/sensors/imuComponent.h"
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+  ImuHistory MakeHistory()
+  {
+    // One frame every 5ms, with the body turning faster and faster
+    ImuHistory history;
+    for (int i = 1; i <= 10; ++i) {
+      history.AddData(IMUDataFrame{static_cast<uint32_t>(100 + 5*i), {0.f, 0.1f, 0.01f * i}});
+    }
+    return history;
+  }
+}
+
+TEST(ImuHistory, GyroAt)
+{
+  const ImuHistory history = MakeHistory();
+
+  Vec3f gyro;
+  ASSERT_TRUE(history.GetGyroAt(110, gyro));
+  EXPECT_FLOAT_EQ(0.02f, gyro.z());
+
+  // Between frames
+  ASSERT_TRUE(history.GetGyroAt(112, gyro));
+  EXPECT_NEAR(0.024f, gyro.z(), 1e-6f);
+  EXPECT_FLOAT_EQ(0.1f, gyro.y());
+
+  // Before all of history
+  EXPECT_FALSE(history.GetGyroAt(100, gyro));
+
+  // After all of history, only if the newest frame is recent enough
+  EXPECT_FALSE(history.GetGyroAt(160, gyro));
+  ASSERT_TRUE(history.GetGyroAt(160, gyro, 20));
+  EXPECT_FLOAT_EQ(0.1f, gyro.z());
+}
+
+TEST(ImuHistory, GyroStats)
+{
+  const ImuHistory history = MakeHistory();
+
+  // Frames at 115, 120 and 125
+  ImuHistory::GyroStats stats;
+  ASSERT_TRUE(history.GetGyroStats(110, 125, stats));
+  EXPECT_EQ(3, stats.numFrames);
+  EXPECT_FLOAT_EQ(0.03f, stats.min.z());
+  EXPECT_FLOAT_EQ(0.05f, stats.max.z());
+  EXPECT_NEAR(0.04f, stats.mean.z(), 1e-6f);
+
+  EXPECT_FALSE(history.GetGyroStats(150, 200, stats));
+  EXPECT_EQ(0, stats.numFrames);
+
+  // Rotation checks use the same lookups
+  EXPECT_TRUE(history.WasBodyRotatingTooFast(140, 0.05f));
+  EXPECT_FALSE(history.WasBodyRotatingTooFast(112, 0.05f));
+}
@@ -0,0 +1,118 @@
+/**
+ * File: testJsonConfigCache.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for JsonConfigCache
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=JsonConfigCache*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "engine/cozmoContext.h"
+#include "engine/utils/jsonConfigCache.h"
+#include "util/fileUtils/fileUtils.h"
+
+#include "json/json.h"
+
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+extern CozmoContext* cozmoContext;
+
+namespace {
+  Json::Value MakeConfig()
+  {
+    Json::Value config;
+    config["behaviorID"] = "Wait_TestInjectable";
+    config["behaviorClass"] = "Wait";
+    config["enabled"] = true;
+    config["count"] = -3;
+    config["big"] = Json::Value((Json::LargestUInt) 0xFFFFFFFFFFull);
+    config["score"] = 0.25;
+    config["nothing"] = Json::Value();
+    config["withNul"] = std::string("a\0b", 3);
+    config["emptyList"] = Json::Value(Json::arrayValue);
+    Json::Value& condition = config["wantsToBeActivatedCondition"];
+    condition["conditionType"] = "Compound";
+    condition["and"].append("TrueCondition");
+    condition["and"].append(Json::Value(Json::objectValue));
+    return config;
+  }
+}
+
+TEST(JsonConfigCache, EncodeDecode)
+{
+  const Json::Value config = MakeConfig();
+  std::vector<uint8_t> buffer;
+  JsonConfigCache::EncodeValue(config, buffer);
+
+  const uint8_t* data = buffer.data();
+  Json::Value decoded;
+  ASSERT_TRUE(JsonConfigCache::DecodeValue(data, buffer.data() + buffer.size(), decoded));
+  EXPECT_EQ(data, buffer.data() + buffer.size());
+  EXPECT_EQ(config, decoded);
+  EXPECT_EQ(Json::intValue, decoded["count"].type());
+  EXPECT_EQ(Json::uintValue, decoded["big"].type());
+
+  // Every truncation must be rejected rather than read past the end
+  for( size_t size = 0; size < buffer.size(); ++size ) {
+    const uint8_t* truncated = buffer.data();
+    Json::Value ignored;
+    EXPECT_FALSE(JsonConfigCache::DecodeValue(truncated, buffer.data() + size, ignored)) << "size " << size;
+  }
+}
+
+TEST(JsonConfigCache, SaveAndReload)
+{
+  const auto* platform = cozmoContext->GetDataPlatform();
+  const std::string sourcePath = platform->pathToResource(Util::Data::Scope::Cache, "testJsonConfigCache/source.json");
+  const std::string cachePath = platform->pathToResource(Util::Data::Scope::Cache, "testJsonConfigCache/cache.bin");
+  Util::FileUtils::DeleteFile(cachePath);
+  ASSERT_TRUE(Util::FileUtils::CreateDirectory(sourcePath, true, true));
+  ASSERT_TRUE(Util::FileUtils::WriteFile(sourcePath, "{}"));
+
+  const Json::Value config = MakeConfig();
+  const std::vector<std::string> sources = {sourcePath};
+  {
+    JsonConfigCache cache(cachePath, sources);
+    EXPECT_FALSE(cache.IsValid());
+    cache.Add(sourcePath, config);
+    EXPECT_TRUE(cache.Save());
+  }
+
+  {
+    JsonConfigCache cache(cachePath, sources);
+    ASSERT_TRUE(cache.IsValid());
+    Json::Value cached;
+    ASSERT_TRUE(cache.Get(sourcePath, cached));
+    EXPECT_EQ(config, cached);
+    EXPECT_FALSE(cache.Get(sourcePath + ".missing", cached));
+    EXPECT_FALSE(cache.Save());
+  }
+
+  // A different set of sources doesn't match
+  {
+    const std::vector<std::string> otherSources = {sourcePath, sourcePath + ".other"};
+    JsonConfigCache cache(cachePath, otherSources);
+    EXPECT_FALSE(cache.IsValid());
+  }
+
+  // Changing a source (its size, here) invalidates the cache too
+  ASSERT_TRUE(Util::FileUtils::WriteFile(sourcePath, "{ }"));
+  {
+    JsonConfigCache cache(cachePath, sources);
+    EXPECT_FALSE(cache.IsValid());
+  }
+
+  Util::FileUtils::DeleteFile(cachePath);
+  Util::FileUtils::DeleteFile(sourcePath);
+}
@@ -285,3 +285,47 @@ TEST(SUITE, MicDirectionHistory_GetHistoryAtTime)
   ASSERT_EQ(history[0].count, 1);
   ASSERT_EQ(history[0].timestampEnd, 1610);
 } // MicDirectionHistory_GetHistoryAtTime
+
+TEST(SUITE, MicDirectionHistory_GetRecentConfidence)
+{
+  const auto directionFirst = kFirstMicDirectionIndex;
+  const auto directionSecond = directionFirst + 1;
+  const auto historyLen = MicDirectionHistory::kMicDirectionHistoryLen;
+  const auto maxTimeLength_ms = std::numeric_limits<uint32_t>::max();
+  const auto isVadActive = true;
+
+  uint32_t t = 0;
+  auto nextT = [&t] { t += 10; return t; };
+
+  MicDirectionHistory newHistory{};
+
+  // Verify empty history has no confidence
+  ASSERT_EQ(0, newHistory.GetRecentConfidence(directionFirst, 0));
+  ASSERT_EQ(0, newHistory.GetRecentConfidence(directionFirst, maxTimeLength_ms));
+
+  for (uint32_t i=0; i<10; ++i) { newHistory.AddDirectionSample(nextT(), isVadActive, directionFirst, 100, directionFirst); } // ts 10 : 100
+  for (uint32_t i=0; i<10; ++i) { newHistory.AddDirectionSample(nextT(), isVadActive, directionSecond, 300, directionSecond); } // ts 110 : 200
+  for (uint32_t i=0; i<10; ++i) { newHistory.AddDirectionSample(nextT(), isVadActive, directionFirst, 200, directionFirst); } // ts 210 : 300
+
+  // Only the latest sample counts for no time at all
+  ASSERT_EQ(200, newHistory.GetRecentConfidence(directionFirst, 0));
+  ASSERT_EQ(0, newHistory.GetRecentConfidence(directionSecond, 0));
+
+  // Average over every sample from the direction, ignoring the others
+  ASSERT_EQ(150, newHistory.GetRecentConfidence(directionFirst, maxTimeLength_ms));
+  ASSERT_EQ(300, newHistory.GetRecentConfidence(directionSecond, maxTimeLength_ms));
+
+  // Only the most recent run is within the time length
+  ASSERT_EQ(200, newHistory.GetRecentConfidence(directionFirst, 50));
+  ASSERT_EQ(0, newHistory.GetRecentConfidence(directionSecond, 50));
+  ASSERT_EQ(0, newHistory.GetRecentConfidence(kMicDirectionUnknown, maxTimeLength_ms));
+
+  // Once the history has wrapped around, only what is still in it counts
+  for (uint32_t i = 0; i < historyLen; ++i)
+  {
+    const auto direction = (i % 2 == 0) ? directionFirst : directionSecond;
+    newHistory.AddDirectionSample(nextT(), isVadActive, direction, 50, direction);
+  }
+  ASSERT_EQ(50, newHistory.GetRecentConfidence(directionFirst, maxTimeLength_ms));
+  ASSERT_EQ(50, newHistory.GetRecentConfidence(directionSecond, maxTimeLength_ms));
+} // MicDirectionHistory_GetRecentConfidence
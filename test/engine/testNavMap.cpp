@@ -21,7 +21,9 @@
 #include "engine/navMap/memoryMap/data/memoryMapData_Cliff.h"
 #include "engine/navMap/memoryMap/data/memoryMapData_ProxObstacle.h"
 #include "engine/navMap/memoryMap/memoryMapTypes.h"
+#include "engine/navMap/occupancySnapshot.h"
 #include "engine/robot.h"
+#include "util/fileUtils/fileUtils.h"
 
 using namespace Anki;
 using namespace Anki::Vector;
@@ -186,3 +188,247 @@ TEST( TestNavMap, FillBorder)
   
 }
 
+TEST( TestNavMap, BatchInsert)
+{
+  // inserting a batch of overlapping regions should leave the map exactly as inserting them one at a time, in order
+  MemoryMap sequentialMap;
+  MemoryMap batchMap;
+
+  FastPolygon clearQuad( {{0, 0}, {300, 0}, {300, 300}, {0, 300}} );
+  FastPolygon edgeQuad( {{100, 100}, {250, 100}, {250, 250}, {100, 250}} );
+  FastPolygon proxQuad( {{140, 140}, {150, 140}, {150, 150}, {140, 150}} );
+  FastPolygon cliffQuad( {{-40, -40}, {20, -40}, {20, 20}, {-40, 20}} ); // forces the root to expand
+
+  MemoryMapData clearData( EContentType::ClearOfObstacle, 0 );
+  MemoryMapData edgeData( EContentType::InterestingEdge, 0 );
+  MemoryMapData_ProxObstacle proxData( MemoryMapData_ProxObstacle::EXPLORED, {0.0f, 0.0f, 0.0f}, 0 );
+  MemoryMapData_Cliff cliffData( Pose3d{""}, 0 );
+
+  sequentialMap.Insert( clearQuad, clearData );
+  sequentialMap.Insert( edgeQuad,  edgeData );
+  sequentialMap.Insert( proxQuad,  proxData );
+  sequentialMap.Insert( cliffQuad, cliffData );
+
+  const bool changed = batchMap.Insert({
+    {clearQuad, clearData.Clone()},
+    {edgeQuad,  edgeData.Clone()},
+    {proxQuad,  proxData.Clone()},
+    {cliffQuad, cliffData.Clone()}
+  });
+  EXPECT_TRUE( changed );
+
+  // same leaves, after merging
+  MemoryMapTypes::MapBroadcastData sequentialInfo;
+  MemoryMapTypes::MapBroadcastData batchInfo;
+  sequentialMap.GetBroadcastInfo( sequentialInfo );
+  batchMap.GetBroadcastInfo( batchInfo );
+  EXPECT_EQ( sequentialInfo.quadInfo.size(), batchInfo.quadInfo.size() );
+  EXPECT_FLOAT_EQ( sequentialMap.GetExploredRegionAreaM2(), batchMap.GetExploredRegionAreaM2() );
+
+  // and the same content wherever we look
+  for ( float x = -35.f; x < 300.f; x += 10.f ) {
+    for ( float y = -35.f; y < 300.f; y += 10.f ) {
+      FastPolygon probe( {{x, y}, {x + 1, y}, {x + 1, y + 1}, {x, y + 1}} );
+      EContentType sequentialType = EContentType::Unknown;
+      EContentType batchType = EContentType::Unknown;
+      sequentialMap.AnyOf( probe, [&](MemoryMapDataConstPtr ptr) { sequentialType = ptr->type; return false; } );
+      batchMap.AnyOf( probe, [&](MemoryMapDataConstPtr ptr) { batchType = ptr->type; return false; } );
+      EXPECT_EQ( sequentialType, batchType ) << "at (" << x << ", " << y << ")";
+    }
+  }
+}
+
+TEST( TestNavMap, AnyOfRays)
+{
+  // a wall of interesting edges across clear ground
+  MemoryMap memoryMap;
+  memoryMap.Insert( FastPolygon( {{-200, -200}, {300, -200}, {300, 300}, {-200, 300}} ), MemoryMapData( EContentType::ClearOfObstacle, 0 ) );
+  memoryMap.Insert( FastPolygon( {{100, -100}, {150, -100}, {150, 200}, {100, 200}} ), MemoryMapData( EContentType::InterestingEdge, 0 ) );
+
+  const Point2f start( 0, 0 );
+  const std::vector<Point2f> ends = {
+    {250, 0},     // straight through the wall
+    {250, 150},   // diagonally through the wall
+    {80, 0},      // stops short of the wall
+    {80, 150},
+    {-150, -150}, // away from the wall
+    {120, 280},   // passes above the end of the wall
+    {125, 0},     // ends inside the wall
+    {0, 0},       // zero length, in the clear
+    {500, 0},     // leaves the map after crossing the wall
+  };
+
+  const auto isEdge = [](MemoryMapDataConstPtr ptr) { return ptr->type == EContentType::InterestingEdge; };
+  const std::vector<bool> results = memoryMap.AnyOf( start, ends, isEdge );
+  ASSERT_EQ( ends.size(), results.size() );
+  const std::vector<bool> expected = { true, true, false, false, false, false, true, false, true };
+  for ( size_t i = 0; i < ends.size(); ++i ) {
+    EXPECT_EQ( expected[i], results[i] ) << "ray to " << ends[i].ToString();
+  }
+
+  // a ray starting inside the wall hits it right away
+  const std::vector<bool> fromWall = memoryMap.AnyOf( Point2f(125, 50), {{125, 50}, {-100, 50}}, isEdge );
+  EXPECT_TRUE( fromWall[0] );
+  EXPECT_TRUE( fromWall[1] );
+}
+
+TEST( TestNavMap, OccupancySnapshot)
+{
+  MemoryMap memoryMap;
+  memoryMap.Insert( FastPolygon( {{-300, -300}, {500, -300}, {500, 500}, {-300, 500}} ), MemoryMapData( EContentType::ClearOfObstacle, 0 ) );
+  memoryMap.Insert( FastPolygon( {{100, 100}, {140, 100}, {140, 180}, {100, 180}} ), MemoryMapData( EContentType::ObstacleUnrecognized, 0 ) );
+
+  u32 stamp = 0;
+  std::vector<AxisAlignedQuad> regions;
+  memoryMap.GetChangedRegions( stamp, regions );
+
+  const auto snapshot = OccupancySnapshot::Build( memoryMap, 1 );
+  ASSERT_TRUE( snapshot != nullptr );
+  EXPECT_EQ( 1u, snapshot->GetVersion() );
+  EXPECT_TRUE( snapshot->IsCollision( {120, 140} ) );
+  EXPECT_FALSE( snapshot->IsCollision( {0, 0} ) );
+  EXPECT_FALSE( snapshot->IsCollision( {5000, 5000} ) );
+  EXPECT_FLOAT_EQ( 0.f, snapshot->GetClearance_mm( {120, 140} ) );
+  EXPECT_LT( 0.f, snapshot->GetClearance_mm( {-250, -250} ) );
+
+  // the snapshot never rules out a collision that the map finds
+  const auto isCollision = [](MemoryMapDataConstPtr ptr) { return ptr->IsCollisionType(); };
+  const auto checkAgainstMap = [&](const OccupancySnapshot& s, const MemoryMap& map) {
+    for ( float x = -280.f; x < 480.f; x += 13.f ) {
+      for ( float y = -280.f; y < 480.f; y += 13.f ) {
+        const Ball2f ball( {x, y}, 30.f );
+        if ( map.AnyOf( ball, isCollision ) ) {
+          EXPECT_TRUE( s.MayCollide(ball) ) << "at (" << x << ", " << y << ")";
+        }
+      }
+    }
+  };
+  checkAgainstMap( *snapshot, memoryMap );
+
+  // far from the obstacle the map is not needed
+  EXPECT_FALSE( snapshot->MayCollide( Ball2f( {-200, -200}, 30.f ) ) );
+  EXPECT_FALSE( snapshot->MayCollide( Ball2f( {120, 60}, 20.f ) ) );
+  EXPECT_TRUE( snapshot->MayCollide( Ball2f( {120, 60}, 45.f ) ) );
+
+  // an incremental update only redraws what changed, and matches a full build
+  memoryMap.Insert( FastPolygon( {{-100, 300}, {0, 300}, {0, 340}, {-100, 340}} ), MemoryMapData( EContentType::ObstacleUnrecognized, 0 ) );
+  memoryMap.Insert( FastPolygon( {{100, 100}, {140, 100}, {140, 180}, {100, 180}} ), MemoryMapData( EContentType::ClearOfObstacle, 0 ) );
+  ASSERT_TRUE( memoryMap.GetChangedRegions( stamp, regions ) );
+  ASSERT_FALSE( regions.empty() );
+
+  const auto updated = OccupancySnapshot::Update( *snapshot, memoryMap, regions, 2 );
+  const auto rebuilt = OccupancySnapshot::Build( memoryMap, 2 );
+  EXPECT_EQ( 2u, updated->GetVersion() );
+  EXPECT_TRUE( snapshot->IsCollision( {120, 140} ) ); // the old snapshot is untouched
+  EXPECT_FALSE( updated->IsCollision( {120, 140} ) );
+  EXPECT_TRUE( updated->IsCollision( {-50, 320} ) );
+  for ( float x = -280.f; x < 480.f; x += 8.f ) {
+    for ( float y = -280.f; y < 480.f; y += 8.f ) {
+      EXPECT_EQ( rebuilt->IsCollision( {x, y} ), updated->IsCollision( {x, y} ) ) << "at (" << x << ", " << y << ")";
+      EXPECT_FLOAT_EQ( rebuilt->GetClearance_mm( {x, y} ), updated->GetClearance_mm( {x, y} ) );
+    }
+  }
+  checkAgainstMap( *updated, memoryMap );
+}
+
+TEST( TestNavMap, BroadcastDelta)
+{
+  MemoryMap memoryMap;
+  memoryMap.Insert( FastPolygon( {{-300, -300}, {500, -300}, {500, 500}, {-300, 500}} ), MemoryMapData( EContentType::ClearOfObstacle, 0 ) );
+
+  MemoryMapTypes::MapBroadcastData full;
+  memoryMap.GetBroadcastInfo( full );
+  ASSERT_FALSE( full.quadInfoFull.empty() );
+
+  u32 stamp = 0;
+  std::vector<AxisAlignedQuad> regions;
+  memoryMap.GetChangedRegions( stamp, regions );
+  regions.clear();
+
+  memoryMap.Insert( FastPolygon( {{100, 100}, {140, 100}, {140, 180}, {100, 180}} ), MemoryMapData( EContentType::ObstacleUnrecognized, 0 ) );
+  ASSERT_TRUE( memoryMap.GetChangedRegions( stamp, regions ) );
+  ASSERT_FALSE( regions.empty() );
+
+  MemoryMapTypes::MapBroadcastData delta;
+  memoryMap.GetBroadcastInfo( delta, regions );
+  memoryMap.GetBroadcastInfo( full );
+  EXPECT_TRUE( delta.quadInfo.empty() );
+  EXPECT_EQ( full.mapInfo.rootSize_mm, delta.mapInfo.rootSize_mm );
+  EXPECT_LT( delta.quadInfoFull.size(), full.quadInfoFull.size() );
+
+  // the delta covers the changed regions, and has every leaf of the full map that overlaps them
+  float deltaArea = 0.f;
+  for ( const auto& quad : delta.quadInfoFull ) {
+    deltaArea += quad.edgeLen_mm * quad.edgeLen_mm;
+  }
+  float regionArea = 0.f;
+  for ( const auto& region : regions ) {
+    const Point2f size = region.GetMaxVertex() - region.GetMinVertex();
+    regionArea += size.x() * size.y();
+  }
+  EXPECT_GE( deltaArea, regionArea );
+
+  size_t numTouching = 0;
+  for ( const auto& quad : full.quadInfoFull ) {
+    const float half = quad.edgeLen_mm * 0.5f;
+    const AxisAlignedQuad bounds( {quad.centerX_mm - half, quad.centerY_mm - half}, {quad.centerX_mm + half, quad.centerY_mm + half} );
+    for ( const auto& region : regions ) {
+      if ( (bounds.GetMinVertex().x() < region.GetMaxVertex().x()) && (region.GetMinVertex().x() < bounds.GetMaxVertex().x()) &&
+           (bounds.GetMinVertex().y() < region.GetMaxVertex().y()) && (region.GetMinVertex().y() < bounds.GetMaxVertex().y()) ) {
+        ++numTouching;
+        break;
+      }
+    }
+  }
+  EXPECT_LE( numTouching, delta.quadInfoFull.size() );
+}
+
+TEST( TestNavMap, SaveLoad)
+{
+  const Pose3d origin( 0, Z_AXIS_3D(), {0, 0, 0} );
+  const Pose3d cliffPose( M_PI_2_F, Z_AXIS_3D(), {210, 20, 0}, origin );
+
+  MemoryMap memoryMap;
+  memoryMap.Insert( FastPolygon( {{-300, -300}, {500, -300}, {500, 500}, {-300, 500}} ), MemoryMapData( EContentType::ClearOfObstacle, 0 ) );
+  memoryMap.Insert( FastPolygon( {{100, 100}, {140, 100}, {140, 180}, {100, 180}} ), MemoryMapData( EContentType::ObstacleUnrecognized, 10 ) );
+  memoryMap.Insert( FastPolygon( {{-200, 0}, {-150, 0}, {-150, 40}, {-200, 40}} ),
+                    MemoryMapData_ProxObstacle( MemoryMapData_ProxObstacle::EXPLORED, {0.0f, 0.0f, 0.0f}, 20 ) );
+  memoryMap.Insert( FastPolygon( {{200, 0}, {220, 0}, {220, 40}, {200, 40}} ), MemoryMapData_Cliff( cliffPose, 30 ) );
+
+  const std::string path = cozmoContext->GetDataPlatform()->pathToResource( Util::Data::Scope::Cache, "testNavMap/saveLoad.nmap" );
+  ASSERT_TRUE( memoryMap.Save( path ) );
+
+  const Pose3d newOrigin( 0, Z_AXIS_3D(), {0, 0, 0} );
+  MemoryMap loaded;
+  ASSERT_TRUE( loaded.Load( path, newOrigin ) );
+
+  // same leaves with the same contents
+  MemoryMapTypes::MapBroadcastData before, after;
+  memoryMap.GetBroadcastInfo( before );
+  loaded.GetBroadcastInfo( after );
+  EXPECT_EQ( before.mapInfo.rootSize_mm, after.mapInfo.rootSize_mm );
+  ASSERT_EQ( before.quadInfoFull.size(), after.quadInfoFull.size() );
+  for ( size_t i = 0; i < before.quadInfoFull.size(); ++i ) {
+    EXPECT_EQ( before.quadInfoFull[i].content, after.quadInfoFull[i].content );
+    EXPECT_FLOAT_EQ( before.quadInfoFull[i].centerX_mm, after.quadInfoFull[i].centerX_mm );
+    EXPECT_FLOAT_EQ( before.quadInfoFull[i].centerY_mm, after.quadInfoFull[i].centerY_mm );
+    EXPECT_FLOAT_EQ( before.quadInfoFull[i].edgeLen_mm, after.quadInfoFull[i].edgeLen_mm );
+  }
+
+  const MemoryMapRegion everywhere = FastPolygon( {{-1000, -1000}, {1000, -1000}, {1000, 1000}, {-1000, 1000}} );
+  const auto isCollision = [] (const auto& data) { return data->IsCollisionType(); };
+  EXPECT_FLOAT_EQ( memoryMap.GetArea( isCollision, everywhere ), loaded.GetArea( isCollision, everywhere ) );
+
+  // the cliff keeps its pose, now relative to the new origin
+  MemoryMapTypes::MemoryMapDataConstList cliffs;
+  loaded.FindContentIf( [] (MemoryMapTypes::MemoryMapDataConstPtr data) { return data->type == EContentType::Cliff; }, cliffs );
+  ASSERT_FALSE( cliffs.empty() );
+  const auto cliff = MemoryMapData::MemoryMapDataCast<const MemoryMapData_Cliff>( *cliffs.begin() );
+  EXPECT_TRUE( cliff->pose.HasSameRootAs( newOrigin ) );
+  EXPECT_TRUE( IsNearlyEqual( cliffPose.GetTranslation(), cliff->pose.GetTranslation(), 0.01f ) );
+
+  // a corrupt file leaves the map empty
+  Util::FileUtils::WriteFile( path, "NMAP" );
+  EXPECT_FALSE( loaded.Load( path, newOrigin ) );
+  Util::FileUtils::DeleteFile( path );
+}
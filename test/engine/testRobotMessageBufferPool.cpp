@@ -0,0 +1,114 @@
+/**
+ * File: testRobotMessageBufferPool.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for RobotMessageBufferPool and the robot message queue in RobotConnectionData
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=RobotMessageBufferPool*
+ **/
+
+#include "engine/comms/robotConnectionData.h"
+#include "engine/comms/robotMessageBufferPool.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+TEST(RobotMessageBufferPool, ReusesBuffers)
+{
+  RobotMessageBufferPool pool(2);
+
+  const RobotMessageBuffer* first = nullptr;
+  {
+    RobotMessageBufferPtr buffer = pool.Acquire();
+    ASSERT_TRUE(buffer != nullptr);
+    buffer->size = 10;
+    first = buffer.get();
+    EXPECT_EQ(1u, pool.GetNumInUse());
+  }
+  EXPECT_EQ(0u, pool.GetNumInUse());
+
+  // Comes back empty
+  RobotMessageBufferPtr again = pool.Acquire();
+  EXPECT_EQ(first, again.get());
+  EXPECT_EQ(0u, again->size);
+
+  EXPECT_EQ(2u, pool.GetNumAcquired());
+  EXPECT_EQ(1u, pool.GetPeakInUse());
+  EXPECT_EQ(0u, pool.GetNumHeapAllocations());
+}
+
+TEST(RobotMessageBufferPool, FallsBackToHeapWhenExhausted)
+{
+  RobotMessageBufferPool pool(2);
+  {
+    std::vector<RobotMessageBufferPtr> buffers;
+    for (int i=0; i<3; ++i) {
+      buffers.push_back(pool.Acquire());
+      ASSERT_TRUE(buffers.back() != nullptr);
+    }
+    EXPECT_EQ(3u, pool.GetNumInUse());
+    EXPECT_EQ(1u, pool.GetNumHeapAllocations());
+  }
+
+  // The heap buffer was deleted rather than added to the pool
+  EXPECT_EQ(0u, pool.GetNumInUse());
+  std::vector<RobotMessageBufferPtr> buffers;
+  buffers.push_back(pool.Acquire());
+  buffers.push_back(pool.Acquire());
+  EXPECT_EQ(1u, pool.GetNumHeapAllocations());
+  EXPECT_EQ(3u, pool.GetPeakInUse());
+}
+
+TEST(RobotMessageBufferPool, ConnectionDataQueuesInOrder)
+{
+  RobotConnectionData connectionData;
+  RobotMessageBufferPool& pool = connectionData.GetBufferPool();
+  const Util::TransportAddress address;
+
+  // Several rounds of filling and draining the queue, as every engine tick does
+  for (uint8_t round=0; round<3; ++round) {
+    for (uint8_t i=0; i<100; ++i) {
+      if (i % 2 == 0) {
+        // Received straight into a buffer
+        RobotMessageBufferPtr buffer = pool.Acquire();
+        buffer->data[0] = i;
+        buffer->size = 1;
+        connectionData.PushArrivedMessage(std::move(buffer), address);
+      }
+      else {
+        // Copied into one
+        const uint8_t data[2] = {i, round};
+        connectionData.PushArrivedMessage(data, sizeof(data), address);
+      }
+    }
+    EXPECT_EQ(100u, pool.GetNumInUse());
+
+    for (uint8_t i=0; i<100; ++i) {
+      ASSERT_TRUE(connectionData.HasMessages());
+      RobotConnectionMessageData message = connectionData.PopNextMessage();
+      ASSERT_EQ(RobotConnectionMessageType::Data, message.GetType());
+      const RobotMessageBufferPtr& buffer = message.GetBuffer();
+      ASSERT_TRUE(buffer != nullptr);
+      EXPECT_EQ(i, buffer->data[0]);
+      EXPECT_EQ((i % 2 == 0) ? 1u : 2u, buffer->size);
+    }
+    EXPECT_FALSE(connectionData.HasMessages());
+    EXPECT_EQ(0u, connectionData.GetIncomingQueueSize());
+    EXPECT_EQ(0u, pool.GetNumInUse());
+  }
+
+  EXPECT_EQ(0u, pool.GetNumHeapAllocations());
+
+  // Too large for a buffer, dropped
+  const std::vector<uint8_t> tooLarge(RobotMessageBuffer::kCapacity + 1, 0);
+  connectionData.PushArrivedMessage(tooLarge.data(), (uint32_t) tooLarge.size(), address);
+  EXPECT_FALSE(connectionData.HasMessages());
+}
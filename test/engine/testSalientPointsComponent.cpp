@@ -0,0 +1,107 @@
+/**
+ * File: testSalientPointsComponent.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-15
+ *
+ * Description: Unit tests for merging and querying salient points in SalientPointsComponent
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=SalientPointsComponent*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/aiComponent/salientPointsComponent.h"
+
+#include <list>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+  Vision::SalientPoint MakePoint(TimeStamp_t timestamp, float x, float y, float area,
+                                 Vision::SalientPointType type = Vision::SalientPointType::Person)
+  {
+    return Vision::SalientPoint(timestamp, x, y, 1.f, area, type, EnumToString(type), {}, 0);
+  }
+}
+
+TEST(SalientPointsComponent, RepeatedDetectionsMerge)
+{
+  SalientPointsComponent component;
+
+  // The same person drifting a little across three images, and a second person elsewhere in the last one
+  component.AddSalientPoints({MakePoint(100, 0.50f, 0.50f, 0.1f)});
+  component.AddSalientPoints({MakePoint(165, 0.52f, 0.50f, 0.1f)});
+  component.AddSalientPoints({MakePoint(230, 0.54f, 0.51f, 0.1f),
+                              MakePoint(230, 0.10f, 0.20f, 0.2f)});
+
+  std::list<Vision::SalientPoint> points;
+  component.GetSalientPointSinceTime(points, Vision::SalientPointType::Person);
+  ASSERT_EQ(2, points.size());
+  for (const auto& point : points) {
+    EXPECT_EQ(230, point.timestamp);
+  }
+
+  // Other types are kept apart
+  component.AddSalientPoints({MakePoint(300, 0.54f, 0.51f, 0.1f, Vision::SalientPointType::Hand)});
+  points.clear();
+  component.GetSalientPointSinceTime(points, Vision::SalientPointType::Person);
+  EXPECT_EQ(2, points.size());
+  EXPECT_TRUE(component.SalientPointDetected(Vision::SalientPointType::Hand, 230));
+}
+
+TEST(SalientPointsComponent, LatestByType)
+{
+  SalientPointsComponent component;
+  EXPECT_EQ(nullptr, component.GetLatestSalientPoint(Vision::SalientPointType::Person));
+  EXPECT_FALSE(component.SalientPointDetected(Vision::SalientPointType::Person));
+
+  component.AddSalientPoints({MakePoint(100, 0.2f, 0.2f, 0.3f),
+                              MakePoint(100, 0.8f, 0.8f, 0.5f),
+                              MakePoint(100, 0.5f, 0.2f, 0.1f)});
+
+  // Largest of the most recent image
+  const Vision::SalientPoint* latest = component.GetLatestSalientPoint(Vision::SalientPointType::Person);
+  ASSERT_NE(nullptr, latest);
+  EXPECT_FLOAT_EQ(0.5f, latest->area_fraction);
+
+  EXPECT_TRUE(component.SalientPointDetected(Vision::SalientPointType::Person, 99));
+  EXPECT_FALSE(component.SalientPointDetected(Vision::SalientPointType::Person, 100));
+  EXPECT_EQ(nullptr, component.GetLatestSalientPoint(Vision::SalientPointType::Person, 100));
+
+  // A later, smaller detection is still the latest
+  component.AddSalientPoints({MakePoint(200, 0.2f, 0.8f, 0.05f)});
+  latest = component.GetLatestSalientPoint(Vision::SalientPointType::Person, 100);
+  ASSERT_NE(nullptr, latest);
+  EXPECT_EQ(200, latest->timestamp);
+}
+
+TEST(SalientPointsComponent, OldPointsAreForgotten)
+{
+  SalientPointsComponent component;
+
+  // Far apart, so none merge
+  component.AddSalientPoints({MakePoint(100, 0.1f, 0.1f, 0.1f)});
+  component.AddSalientPoints({MakePoint(5000, 0.9f, 0.9f, 0.1f)});
+  component.AddSalientPoints({MakePoint(20000, 0.1f, 0.9f, 0.1f)});
+
+  std::list<Vision::SalientPoint> points;
+  component.GetSalientPointSinceTime(points, Vision::SalientPointType::Person);
+  ASSERT_EQ(1, points.size());
+  EXPECT_EQ(20000, points.front().timestamp);
+
+  // Points too long apart are not merged, even in the same place
+  component.AddSalientPoints({MakePoint(30000, 0.1f, 0.9f, 0.1f)});
+  points.clear();
+  component.GetSalientPointSinceTime(points, Vision::SalientPointType::Person);
+  ASSERT_EQ(2, points.size());
+  EXPECT_EQ(20000, points.front().timestamp);
+  EXPECT_EQ(30000, points.back().timestamp);
+  points.clear();
+  component.GetSalientPointSinceTime(points, Vision::SalientPointType::Person, 20000);
+  EXPECT_EQ(1, points.size());
+}
@@ -12,6 +12,7 @@
 
 #include "coretech/common/engine/math/logisticRegression.h"
 #include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/vision/engine/scratchArena.h"
 #include "engine/components/visionComponent.h"
 #include "engine/cozmoContext.h"
 #include "engine/overheadEdge.h"
@@ -509,7 +510,8 @@ TEST(SurfaceClassifier, DISABLED_GroundClassifier_NoiseRemoval)
     config["FileOrDirName"] = "config/engine/vision/groundClassifier/deskClassifier.yaml";
   }
 
-  Anki::Vector::GroundPlaneClassifier groundPlaneClassifier(config, cozmoContext);
+  Anki::Vision::ScratchArena scratchArena;
+  Anki::Vector::GroundPlaneClassifier groundPlaneClassifier(config, cozmoContext, scratchArena);
 
   Anki::Vision::DebugImageList<Anki::Vision::CompressedImage> debugImageList;
   std::list<Anki::Vector::OverheadEdgeFrame> outEdges;
@@ -529,6 +531,7 @@ TEST(SurfaceClassifier, DISABLED_GroundClassifier_NoiseRemoval)
     Anki::Vision::ImageRGB testImg;
     ASSERT_EQ(testImg.Load(imagepath), Anki::RESULT_OK);
 
+    scratchArena.Reset();
     Anki::Result result = groundPlaneClassifier.Update(testImg, poseData, debugImageList, outEdges);
     ASSERT_EQ(result, Anki::RESULT_OK);
 
@@ -0,0 +1,83 @@
+/**
+ * File: testSysFileReader.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for reading and parsing /proc and /sys style files
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=SysFileReader*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "engine/cozmoContext.h"
+#include "osState/sysFileReader.h"
+#include "util/fileUtils/fileUtils.h"
+
+extern Anki::Vector::CozmoContext* cozmoContext;
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+TEST(SysFileReader, Parse)
+{
+  const char* text = " 1234 56.5\t7";
+  const char* cursor = text;
+  uint64_t integer = 0;
+  float real = 0.f;
+  EXPECT_TRUE(SysFileReader::ParseUint64(cursor, integer));
+  EXPECT_EQ(1234, integer);
+  EXPECT_TRUE(SysFileReader::ParseFloat(cursor, real));
+  EXPECT_FLOAT_EQ(56.5f, real);
+  EXPECT_TRUE(SysFileReader::ParseUint64(cursor, integer));
+  EXPECT_EQ(7, integer);
+  EXPECT_FALSE(SysFileReader::ParseUint64(cursor, integer));
+
+  cursor = "-3";
+  EXPECT_FALSE(SysFileReader::ParseUint64(cursor, integer));
+  EXPECT_EQ('-', *cursor);
+
+  const char* memInfo = "MemTotal:         507412 kB\n"
+                        "MemFree:           81996 kB\n"
+                        "MemAvailable:     263012 kB\n";
+  EXPECT_TRUE(SysFileReader::FindKeyValue(memInfo, "MemTotal", integer));
+  EXPECT_EQ(507412, integer);
+  EXPECT_TRUE(SysFileReader::FindKeyValue(memInfo, "MemAvailable", integer));
+  EXPECT_EQ(263012, integer);
+  // Keys have to match all the way up to the colon
+  EXPECT_FALSE(SysFileReader::FindKeyValue(memInfo, "Mem", integer));
+  EXPECT_FALSE(SysFileReader::FindKeyValue(memInfo, "SwapTotal", integer));
+}
+
+TEST(SysFileReader, ReadsFreshContents)
+{
+  const std::string path = cozmoContext->GetDataPlatform()->pathToResource(Util::Data::Scope::Cache,
+                                                                           "testSysFileReader");
+  ASSERT_TRUE(Util::FileUtils::WriteFile(path, "42\n"));
+
+  SysFileReader reader(path.c_str());
+  uint32_t value = 0;
+  EXPECT_TRUE(reader.ReadUint32(value));
+  EXPECT_EQ(42, value);
+
+  // Read again through the same descriptor
+  ASSERT_TRUE(Util::FileUtils::WriteFile(path, "1234567\n"));
+  EXPECT_TRUE(reader.ReadUint32(value));
+  EXPECT_EQ(1234567, value);
+
+  // Cut short, but still terminated
+  char buffer[4];
+  EXPECT_EQ(3, reader.Read(buffer, sizeof(buffer)));
+  EXPECT_STREQ("123", buffer);
+
+  Util::FileUtils::DeleteFile(path);
+
+  SysFileReader missingReader("/this/file/does/not/exist");
+  EXPECT_EQ(-1, missingReader.Read(buffer, sizeof(buffer)));
+  EXPECT_STREQ("", buffer);
+}
@@ -0,0 +1,108 @@
+/**
+ * File: testThermalGovernor.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for the ThermalGovernor
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=ThermalGovernor*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/components/thermalGovernor.h"
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+
+  ThermalGovernor::Inputs MakeInputs(uint32_t temperature_C, float micBufferFullness = 0.f)
+  {
+    ThermalGovernor::Inputs inputs;
+    inputs.temperature_C = temperature_C;
+    inputs.micBufferFullness = micBufferFullness;
+    return inputs;
+  }
+
+}
+
+TEST(ThermalGovernor, LevelsWithHysteresis)
+{
+  ThermalGovernor governor;
+  float time_s = 0.f;
+
+  EXPECT_FALSE(governor.Update(time_s, MakeInputs(60)));
+  EXPECT_EQ(ThermalLevel::Normal, governor.GetLevel());
+  EXPECT_EQ(DesiredCPUFrequency::Automatic, governor.GetDesiredCPUFrequency());
+  EXPECT_EQ(1, governor.GetVisionStretch());
+  EXPECT_EQ(1, governor.GetNeuralNetStretch());
+
+  EXPECT_TRUE(governor.Update(time_s += 1.f, MakeInputs(76)));
+  EXPECT_EQ(ThermalLevel::Warm, governor.GetLevel());
+  EXPECT_EQ(DesiredCPUFrequency::Manual533Mhz, governor.GetDesiredCPUFrequency());
+  EXPECT_EQ(2, governor.GetVisionStretch());
+  EXPECT_EQ(1, governor.GetNeuralNetStretch());
+
+  // Straight up to hot, there's no waiting on the way up
+  EXPECT_TRUE(governor.Update(time_s += 1.f, MakeInputs(86)));
+  EXPECT_EQ(ThermalLevel::Hot, governor.GetLevel());
+  EXPECT_EQ(DesiredCPUFrequency::Manual400Mhz, governor.GetDesiredCPUFrequency());
+  EXPECT_EQ(4, governor.GetVisionStretch());
+  EXPECT_EQ(2, governor.GetNeuralNetStretch());
+
+  // Cool, but too soon after the last change
+  EXPECT_FALSE(governor.Update(time_s += 1.f, MakeInputs(60)));
+  EXPECT_EQ(ThermalLevel::Hot, governor.GetLevel());
+
+  // Just under the threshold isn't enough to come back down, even after a long time
+  EXPECT_FALSE(governor.Update(time_s += 100.f, MakeInputs(84)));
+  EXPECT_EQ(ThermalLevel::Hot, governor.GetLevel());
+
+  // Then one level at a time
+  EXPECT_TRUE(governor.Update(time_s += 30.f, MakeInputs(60)));
+  EXPECT_EQ(ThermalLevel::Warm, governor.GetLevel());
+  EXPECT_TRUE(governor.Update(time_s += 30.f, MakeInputs(60)));
+  EXPECT_EQ(ThermalLevel::Normal, governor.GetLevel());
+}
+
+TEST(ThermalGovernor, DemandAndThrottling)
+{
+  ThermalGovernor governor;
+  float time_s = 0.f;
+
+  EXPECT_TRUE(governor.Update(time_s += 1.f, MakeInputs(80)));
+  EXPECT_EQ(DesiredCPUFrequency::Manual533Mhz, governor.GetDesiredCPUFrequency());
+
+  // Mic data backing up buys back a step, until it drains below the low mark
+  EXPECT_TRUE(governor.Update(time_s += 1.f, MakeInputs(80, 0.7f)));
+  EXPECT_TRUE(governor.HasHighDemand());
+  EXPECT_EQ(DesiredCPUFrequency::Automatic, governor.GetDesiredCPUFrequency());
+  EXPECT_FALSE(governor.Update(time_s += 1.f, MakeInputs(80, 0.3f)));
+  EXPECT_TRUE(governor.HasHighDemand());
+  EXPECT_TRUE(governor.Update(time_s += 1.f, MakeInputs(80, 0.05f)));
+  EXPECT_FALSE(governor.HasHighDemand());
+  EXPECT_EQ(DesiredCPUFrequency::Manual533Mhz, governor.GetDesiredCPUFrequency());
+
+  // Vision falling behind counts too
+  ThermalGovernor::Inputs inputs = MakeInputs(80);
+  inputs.visionDropFraction = 0.3f;
+  EXPECT_TRUE(governor.Update(time_s += 1.f, inputs));
+  EXPECT_EQ(DesiredCPUFrequency::Automatic, governor.GetDesiredCPUFrequency());
+
+  // Once the kernel throttles, go to hot whatever the temperature, and demand no longer buys anything back
+  inputs.isCPUThrottling = true;
+  EXPECT_TRUE(governor.Update(time_s += 1.f, inputs));
+  EXPECT_EQ(ThermalLevel::Hot, governor.GetLevel());
+  EXPECT_TRUE(governor.HasHighDemand());
+  EXPECT_EQ(DesiredCPUFrequency::Manual400Mhz, governor.GetDesiredCPUFrequency());
+
+  inputs.isCPUThrottling = false;
+  EXPECT_TRUE(governor.Update(time_s += 1.f, inputs));
+  EXPECT_EQ(ThermalLevel::Hot, governor.GetLevel());
+  EXPECT_EQ(DesiredCPUFrequency::Manual533Mhz, governor.GetDesiredCPUFrequency());
+}
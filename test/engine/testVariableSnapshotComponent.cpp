@@ -21,6 +21,7 @@
 #include "coretech/common/engine/utils/data/dataPlatform.h"
 #include "engine/components/variableSnapshot/variableSnapshotComponent.h"
 #include "engine/components/variableSnapshot/variableSnapshotEncoder.h"
+#include "engine/components/variableSnapshot/variableSnapshotJournal.h"
 #include "engine/cozmoContext.h"
 #include "engine/robot.h"
 #include "gtest/gtest.h"
@@ -154,6 +155,55 @@ TEST(VariableSnapshotComponent, BasicFunctionalityTest)
   RemoveTestDataAfter();
 };
 
+// tests that only changed variables are journaled, and that a torn record at the end of the journal is dropped
+TEST(VariableSnapshotComponent, JournalChangedVariables)
+{
+  using namespace Anki::Vector;
+
+  std::string journalPath;
+  {
+    auto robot0 = std::make_unique<Robot>(kRobotId, cozmoContext);
+    RemoveTestDataPrior(robot0);
+    auto& variableSnapshotComp = robot0->GetVariableSnapshotComponent();
+    journalPath = VariableSnapshotComponent::GetJournalPath(robot0->GetContextDataPlatform(),
+                                                            VariableSnapshotComponent::kVariableSnapshotFolder,
+                                                            VariableSnapshotComponent::kVariableSnapshotFilename);
+    Anki::Util::FileUtils::DeleteFile(journalPath);
+
+    std::shared_ptr<int> testIntPtr0 = std::make_shared<int>(5);
+    std::shared_ptr<bool> testBoolPtr0 = std::make_shared<bool>(false);
+    variableSnapshotComp.InitVariable<int>(VariableSnapshotId::UnitTestInt0, testIntPtr0);
+    variableSnapshotComp.InitVariable<bool>(VariableSnapshotId::UnitTestBool0, testBoolPtr0);
+
+    // nothing has been saved yet, so both are new
+    EXPECT_EQ(2u, variableSnapshotComp.JournalChangedVariables());
+    EXPECT_EQ(0u, variableSnapshotComp.JournalChangedVariables());
+
+    *testIntPtr0 = 6;
+    EXPECT_EQ(1u, variableSnapshotComp.JournalChangedVariables());
+
+    // simulate losing power part way through appending a record
+    Anki::Util::FileUtils::WriteFile(journalPath, std::vector<uint8_t>{7, 0, 0}, true);
+
+    int journaledInt = 0;
+    const size_t numReplayed = VariableSnapshotJournal::Replay(journalPath, [&journaledInt](Json::Value&& entry) {
+      if(entry[VariableSnapshotEncoder::kVariableSnapshotIdKey].asString() ==
+         VariableSnapshotIdToString(VariableSnapshotId::UnitTestInt0)) {
+        auto value = std::make_shared<int>(0);
+        VariableSnapshotEncoder::Deserialize<int>(value, entry);
+        journaledInt = *value;
+      }
+    });
+    EXPECT_EQ(3u, numReplayed);
+    EXPECT_EQ(6, journaledInt);
+  }
+
+  // shutting down writes the full snapshot, which makes the journal redundant
+  EXPECT_FALSE(Anki::Util::FileUtils::FileExists(journalPath));
+
+  RemoveTestDataAfter();
+};
+
 // test that passing in a nullptr results in an error
 TEST(VariableSnapshotComponent, NullPointerError)
 {
@@ -0,0 +1,79 @@
+/**
+ * File: testVisionFrameTrace.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for VisionFrameTrace and VisionFrameTraceStats
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=VisionFrameTrace*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/vision/visionFrameTrace.h"
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+TEST(VisionFrameTrace, LatencyFromCapture)
+{
+  VisionFrameTrace trace;
+  EXPECT_EQ(-1, trace.GetLatencyFromCapture_us(VisionFrameStage::Dequeued));
+
+  trace.Stamp(VisionFrameStage::Dequeued, 1500);
+  EXPECT_EQ(-1, trace.GetLatencyFromCapture_us(VisionFrameStage::Dequeued)); // no capture time yet
+
+  trace.Stamp(VisionFrameStage::Captured, 1000);
+  EXPECT_EQ(500, trace.GetLatencyFromCapture_us(VisionFrameStage::Dequeued));
+  EXPECT_EQ(-1,  trace.GetLatencyFromCapture_us(VisionFrameStage::WorldUpdated));
+}
+
+TEST(VisionFrameTrace, StatsHistograms)
+{
+  VisionFrameTraceStats stats;
+
+  for(s64 worldLatency_ms : {4, 40, 40, 1000})
+  {
+    VisionFrameTrace trace;
+    trace.Stamp(VisionFrameStage::Captured, 1000);
+    trace.Stamp(VisionFrameStage::WorldUpdated, 1000 + 1000*worldLatency_ms);
+    trace.modeDuration_us.emplace_back(VisionMode::Markers, 12000);
+    stats.Add(trace);
+  }
+  ASSERT_EQ(4u, stats.GetNumFrames());
+
+  const Json::Value json = stats.GetJson();
+  EXPECT_EQ(4u, json["numFrames"].asUInt());
+
+  const Json::Value& world = json["latencyFromCapture"]["WorldUpdated"];
+  EXPECT_EQ(4u, world["num"].asUInt());
+  EXPECT_FLOAT_EQ(4.f,    world["min_ms"].asFloat());
+  EXPECT_FLOAT_EQ(1000.f, world["max_ms"].asFloat());
+
+  const Json::Value& buckets = world["buckets"];
+  ASSERT_TRUE(buckets.isArray());
+  u32 total = 0;
+  for(const auto& bucket : buckets)
+  {
+    total += bucket["count"].asUInt();
+  }
+  EXPECT_EQ(4u, total);
+  EXPECT_EQ(1u, buckets[0]["count"].asUInt());             // 4ms, up to 5ms
+  EXPECT_EQ(2u, buckets[4]["count"].asUInt());             // 40ms, up to 50ms
+  EXPECT_EQ(1u, buckets[buckets.size()-1]["count"].asUInt()); // 1000ms, beyond the last bound
+
+  // Stages that were never stamped are still reported, but empty
+  EXPECT_EQ(0u, json["latencyFromCapture"]["CacheBuilt"]["num"].asUInt());
+
+  const Json::Value& markers = json["modeDuration"][EnumToString(VisionMode::Markers)];
+  EXPECT_EQ(4u, markers["num"].asUInt());
+  EXPECT_FLOAT_EQ(12.f, markers["mean_ms"].asFloat());
+
+  stats.Clear();
+  EXPECT_EQ(0u, stats.GetNumFrames());
+  EXPECT_TRUE(stats.GetJson()["modeDuration"].isNull());
+}
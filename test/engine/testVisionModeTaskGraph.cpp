@@ -0,0 +1,103 @@
+/**
+ * File: testVisionModeTaskGraph.cpp
+ *
+ * Author: Victor Rebuild
+ * Created: 2026-10-14
+ *
+ * Description: Unit tests for the VisionModeTaskGraph
+ *
+ * Copyright: Victor Rebuild 2026
+ *
+ * --gtest_filter=VisionModeTaskGraph*
+ *
+ **/
+
+#include "gtest/gtest.h"
+
+#include "engine/vision/visionModeTaskGraph.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+namespace {
+  constexpr VisionModeTaskGraph::ResourceSet kResourceA = 1 << 0;
+  constexpr VisionModeTaskGraph::ResourceSet kResourceB = 1 << 1;
+  constexpr VisionModeTaskGraph::ResourceSet kResourceC = 1 << 2;
+}
+
+TEST(VisionModeTaskGraph, ConflictingTasksRunInOrder)
+{
+  for(s32 numWorkers : {0, 1, 3})
+  {
+    VisionModeTaskGraph graph(numWorkers);
+
+    // Run the same graph a few times, since it is emptied by each Run
+    for(s32 iter=0; iter<5; ++iter)
+    {
+      std::mutex orderMutex;
+      std::vector<s32> order;
+      auto record = [&orderMutex,&order](s32 index) {
+        // Give a task that ignored its dependencies a chance to sneak in
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(index);
+      };
+
+      graph.AddTask(0,          kResourceA, [&record]() { record(0); }); // writes A
+      graph.AddTask(kResourceA, kResourceB, [&record]() { record(1); }); // reads A, so after 0
+      graph.AddTask(0,          kResourceA, [&record]() { record(2); }); // writes A, so after 0 and 1
+      graph.AddTask(kResourceB, 0,          [&record]() { record(3); }); // reads B, so after 1
+      graph.Run();
+
+      ASSERT_EQ(4u, order.size());
+      auto positionOf = [&order](s32 index) {
+        return std::find(order.begin(), order.end(), index) - order.begin();
+      };
+      EXPECT_LT(positionOf(0), positionOf(1));
+      EXPECT_LT(positionOf(1), positionOf(2));
+      EXPECT_LT(positionOf(1), positionOf(3));
+
+      if(0 == numWorkers)
+      {
+        EXPECT_EQ((std::vector<s32>{0, 1, 2, 3}), order);
+      }
+    }
+  }
+}
+
+TEST(VisionModeTaskGraph, IndependentTasksRunInParallel)
+{
+  VisionModeTaskGraph graph(2);
+  ASSERT_EQ(2, graph.GetNumWorkerThreads());
+
+  // Three independent tasks, which each wait for the others to be running, can only finish if the calling
+  // thread and both workers run them at the same time
+  std::atomic<s32> numRunning{0};
+  std::atomic<s32> numFinished{0};
+  auto task = [&numRunning,&numFinished]() {
+    ++numRunning;
+    const auto giveUpTime = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while(numRunning < 3 && std::chrono::steady_clock::now() < giveUpTime)
+    {
+      std::this_thread::yield();
+    }
+    if(numRunning == 3)
+    {
+      ++numFinished;
+    }
+  };
+
+  graph.AddTask(0, kResourceA, task);
+  graph.AddTask(0, kResourceB, task);
+  graph.AddTask(0, kResourceC, task);
+  graph.Run();
+
+  EXPECT_EQ(3, numFinished);
+}
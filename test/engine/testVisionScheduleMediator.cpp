@@ -234,3 +234,177 @@ TEST(VisionScheduleMediator, Interleaving)
   vsm.UpdateVisionSchedule(visionComponent, nullptr);
   scheduleList = vsm.GenerateBalancedSchedule(visionComponent);
 }
+
+TEST(VisionScheduleMediator, AdaptToLoad)
+{
+  std::string configString = R"json(
+  {
+    "VisionModeSettings" :
+    [
+      {
+        "mode"         : "Markers",
+        "low"          : 4,
+        "med"          : 2,
+        "high"         : 1,
+        "standard"     : 1,
+        "relativeCost" : 16
+      },
+      {
+        "mode"         : "Illumination",
+        "low"          : 8,
+        "med"          : 4,
+        "high"         : 1,
+        "standard"     : 2,
+        "relativeCost" : 2
+      },
+      {
+        "mode"         : "BrightColors",
+        "low"          : 4,
+        "med"          : 2,
+        "high"         : 1,
+        "standard"     : 2,
+        "relativeCost" : 4,
+        "stretchable"  : false
+      }
+    ]
+  })json";
+  Json::Value config;
+  CreateVSMConfig(configString, config);
+  VisionComponent visionComponent;
+  VisionScheduleMediator vsm;
+  vsm.Init(config);
+
+  Robot robot(0, cozmoContext);
+  DependencyManagedEntity<RobotComponentID> dependencies;
+  dependencies.AddDependentComponent(RobotComponentID::CozmoContextWrapper, robot.GetComponentPtr<ContextWrapper>(), false);
+  visionComponent.InitDependent( &robot, dependencies);
+
+  TestSubscriber subscriber(&vsm, { { VisionMode::Markers,      EVisionUpdateFrequency::Standard },
+                                    { VisionMode::Illumination, EVisionUpdateFrequency::Standard },
+                                    { VisionMode::BrightColors, EVisionUpdateFrequency::Standard } });
+  subscriber.Subscribe();
+  vsm.UpdateVisionSchedule(visionComponent, nullptr);
+
+  EXPECT_EQ(1, vsm.GetEffectiveUpdatePeriod(VisionMode::Markers));
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::BrightColors));
+  EXPECT_EQ(0, vsm.GetEffectiveUpdatePeriod(VisionMode::Faces));
+
+  // At least as many frames as the longest allowed load window
+  const u32 kNumFramesPerWindow = 300;
+  auto runLoadWindow = [&](u32 numDroppedPerFrame) {
+    for(u32 i=0; i<kNumFramesPerWindow; ++i)
+    {
+      vsm.ReportCapturedFrame(numDroppedPerFrame);
+    }
+    const bool changed = vsm.AdaptToLoad();
+    vsm._stretchIsDirty |= changed;
+    vsm.UpdateVisionSchedule(visionComponent, nullptr);
+    return changed;
+  };
+
+  // Dropping every other frame: only the stretchable mode slows down, and not past its low frequency
+  EXPECT_TRUE(runLoadWindow(1));
+  EXPECT_EQ(4, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_TRUE(vsm.GetSchedule().IsTimeToProcess(VisionMode::Illumination, vsm._modeDataMap[VisionMode::Illumination].offset));
+  EXPECT_FALSE(vsm.GetSchedule().IsTimeToProcess(VisionMode::Illumination, vsm._modeDataMap[VisionMode::Illumination].offset + 2));
+
+  EXPECT_TRUE(runLoadWindow(1));
+  EXPECT_EQ(8, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+
+  EXPECT_FALSE(runLoadWindow(1));
+  EXPECT_EQ(8, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_EQ(1, vsm.GetEffectiveUpdatePeriod(VisionMode::Markers));
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::BrightColors));
+
+  // No drops: restored one step per window
+  EXPECT_TRUE(runLoadWindow(0));
+  EXPECT_EQ(4, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_TRUE(runLoadWindow(0));
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_FALSE(runLoadWindow(0));
+
+  // Stretch is forgotten once the mode is released
+  EXPECT_TRUE(runLoadWindow(1));
+  subscriber.Unsubscribe();
+  vsm.UpdateVisionSchedule(visionComponent, nullptr);
+  EXPECT_EQ(0, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  subscriber.Subscribe();
+  vsm.UpdateVisionSchedule(visionComponent, nullptr);
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+}
+
+TEST(VisionScheduleMediator, ThermalStretch)
+{
+  std::string configString = R"json(
+  {
+    "VisionModeSettings" :
+    [
+      {
+        "mode"         : "Markers",
+        "low"          : 4,
+        "med"          : 2,
+        "high"         : 1,
+        "standard"     : 1,
+        "relativeCost" : 16
+      },
+      {
+        "mode"         : "Illumination",
+        "low"          : 8,
+        "med"          : 4,
+        "high"         : 1,
+        "standard"     : 2,
+        "relativeCost" : 2
+      },
+      {
+        "mode"         : "People",
+        "low"          : 8,
+        "med"          : 4,
+        "high"         : 1,
+        "standard"     : 2,
+        "relativeCost" : 8
+      }
+    ]
+  })json";
+  Json::Value config;
+  CreateVSMConfig(configString, config);
+  VisionComponent visionComponent;
+  VisionScheduleMediator vsm;
+  vsm.Init(config);
+
+  Robot robot(0, cozmoContext);
+  DependencyManagedEntity<RobotComponentID> dependencies;
+  dependencies.AddDependentComponent(RobotComponentID::CozmoContextWrapper, robot.GetComponentPtr<ContextWrapper>(), false);
+  visionComponent.InitDependent( &robot, dependencies);
+
+  TestSubscriber subscriber(&vsm, { { VisionMode::Markers,      EVisionUpdateFrequency::Standard },
+                                    { VisionMode::Illumination, EVisionUpdateFrequency::Standard },
+                                    { VisionMode::People,       EVisionUpdateFrequency::Standard } });
+  subscriber.Subscribe();
+  vsm.UpdateVisionSchedule(visionComponent, nullptr);
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::People));
+
+  // Stretchable and neural net modes are slowed separately, and never the others
+  vsm.SetThermalStretch(4, 2);
+  EXPECT_TRUE(vsm._stretchIsDirty);
+  vsm.UpdateVisionSchedule(visionComponent, nullptr);
+  EXPECT_EQ(1, vsm.GetEffectiveUpdatePeriod(VisionMode::Markers));
+  EXPECT_EQ(8, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_EQ(4, vsm.GetEffectiveUpdatePeriod(VisionMode::People));
+
+  // Still capped at the low frequency
+  vsm.SetThermalStretch(8, 8);
+  vsm.UpdateVisionSchedule(visionComponent, nullptr);
+  EXPECT_EQ(8, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_EQ(8, vsm.GetEffectiveUpdatePeriod(VisionMode::People));
+
+  // Setting the same again is a no-op
+  vsm.SetThermalStretch(8, 8);
+  EXPECT_FALSE(vsm._stretchIsDirty);
+
+  vsm.SetThermalStretch(1, 1);
+  vsm.UpdateVisionSchedule(visionComponent, nullptr);
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::Illumination));
+  EXPECT_EQ(2, vsm.GetEffectiveUpdatePeriod(VisionMode::People));
+}
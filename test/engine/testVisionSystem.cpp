@@ -28,6 +28,7 @@
 
 #include "coretech/vision/engine/imageCache.h"
 #include "coretech/vision/engine/neuralNetRunner.h"
+#include "coretech/vision/engine/scratchArena.h"
 #include "coretech/vision/shared/MarkerCodeDefinitions.h"
 
 #include "util/console/consoleSystem.h"
@@ -272,7 +273,7 @@ TEST(VisionSystem, ImageCompositing_MarkerDetection)
                                                                                    "test/markerDetectionTests/ImageCompositing");
   
   // we only care about detecting the charger in the dark
-  const auto isChargerDetected = [](const std::list<Vision::ObservedMarker>& markers) -> bool {
+  const auto isChargerDetected = [](const Vision::ObservedMarkerList& markers) -> bool {
     return !markers.empty() && 
            strncmp("MARKER_CHARGER_HOME", markers.front().GetCodeName(), 19)==0;
   };
@@ -389,12 +390,12 @@ TEST(VisionSystem, MarkerDetectionTests)
   {
     std::string subDir;
     f32         expectedFailureRate;
-    std::function<bool(const std::list<Vision::ObservedMarker>&, const std::string& filename)> didSucceedFcn;
+    std::function<bool(const Vision::ObservedMarkerList&, const std::string& filename)> didSucceedFcn;
   };
 
   // Helper to check success by verifying exactly one marker was detected and its name matches the filename
   // (ignoring trailing number)
-  auto matchFilenameFcn = [](const std::list<Vision::ObservedMarker>& markers, const std::string& filename) -> bool
+  auto matchFilenameFcn = [](const Vision::ObservedMarkerList& markers, const std::string& filename) -> bool
   {
     if(markers.size() != 1)
     {
@@ -409,7 +410,7 @@ TEST(VisionSystem, MarkerDetectionTests)
     TestDefinition{
       .subDir = "NoMarkers",
       .expectedFailureRate = 0.f,
-      .didSucceedFcn = [](const std::list<Vision::ObservedMarker>& markers, const std::string&) -> bool
+      .didSucceedFcn = [](const Vision::ObservedMarkerList& markers, const std::string&) -> bool
       {
         return markers.empty();
       }
@@ -430,7 +431,7 @@ TEST(VisionSystem, MarkerDetectionTests)
     TestDefinition{
       .subDir = "LightOnDark_Charger",
       .expectedFailureRate = 0.05f, // Should be 0 VIC-1165
-      .didSucceedFcn = [](const std::list<Vision::ObservedMarker>& markers, const std::string& filename) -> bool
+      .didSucceedFcn = [](const Vision::ObservedMarkerList& markers, const std::string& filename) -> bool
       {
         return (markers.size() == 1) && (strncmp("MARKER_CHARGER_HOME", markers.front().GetCodeName(), 19) == 0);
       }
@@ -449,7 +450,7 @@ TEST(VisionSystem, MarkerDetectionTests)
     testDefinitions.push_back(TestDefinition{
       .subDir = markerDir,
       .expectedFailureRate = 0.1f, // Can we get this to 0? (VIC-1165)
-      .didSucceedFcn = [&markerDir](const std::list<Vision::ObservedMarker>& markers, const std::string& filename) -> bool
+      .didSucceedFcn = [&markerDir](const Vision::ObservedMarkerList& markers, const std::string& filename) -> bool
       {
         return (markers.size() == 1) && (markerDir.compare(0, markerDir.length(), markers.front().GetCodeName()) == 0);
       }
@@ -713,7 +714,8 @@ GTEST_TEST(LaserPointDetector, LaserDetect)
     Vision::DebugImageList<Vision::CompressedImage> debugImageList;
     std::list<Vector::ExternalInterface::RobotObservedLaserPoint> points;
 
-    Vector::LaserPointDetector detector(nullptr);
+    Vision::ScratchArena scratchArena;
+    Vector::LaserPointDetector detector(nullptr, scratchArena);
     result = detector.Detect(imageCache, false, points, debugImageList);
     ASSERT_EQ(RESULT_OK, result);
     EXPECT_EQ(expectedPoints, points.size()) << "Image: "<<imageName;
@@ -0,0 +1,490 @@
+/**
+ * File: visionSystemBenchmark.cpp
+ *
+ * Author: Victor Rebuild
+ * Date:   10/14/2026
+ *
+ * Description: Replays recorded camera sequences through VisionSystem, the way VisionComponent feeds it, and
+ *              reports per frame time, heap allocations and (on Linux, where perf counters are available)
+ *              instructions and cache misses for:
+ *                - no modes at all, i.e. the fixed cost of an Update
+ *                - every VisionMode on its own
+ *                - full schedules of modes, run serially and on the mode worker threads
+ *
+ *              Each subfolder of resources/test/visionBenchmark is one sequence, of either .raw files (RAW10 BAYER
+ *              frames at the camera sensor's resolution, as captured by the camera service) or .jpg/.png files
+ *              (RGB frames), replayed in name order. Schedules are read from visionBenchmark/schedules.json, with
+ *              one entry per schedule of the form {"<VisionMode>": <schedule>} (see VisionModeSchedule::SetFromJSON).
+ *              Without that file, every mode is run on every frame.
+ *
+ *              The report is also written as JSON to the cache's visionSystemBenchmark/report.json, to diff
+ *              between builds. Disabled by default, run it with
+ *                test_engine --gtest_also_run_disabled_tests --gtest_filter=VisionSystemBenchmark.*
+ *
+ * Copyright: Victor Rebuild 2026
+ **/
+
+#include "util/helpers/includeGTest.h"
+
+#include "anki/cozmo/shared/cozmoConfig.h"
+#include "coretech/common/engine/utils/data/dataPlatform.h"
+#include "coretech/vision/engine/cameraCalibration.h"
+#include "coretech/vision/engine/image.h"
+#include "coretech/vision/engine/imageBuffer/imageBuffer.h"
+#include "engine/cozmoContext.h"
+#include "engine/robotDataLoader.h"
+#include "engine/vision/visionModeSchedule.h"
+#include "engine/vision/visionSystem.h"
+#include "engine/vision/visionSystemInput.h"
+#include "test/engine/helpers/allocationCounter.h"
+#include "util/console/consoleSystem.h"
+#include "util/fileUtils/fileUtils.h"
+#include "json/json.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <vector>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+using namespace Anki;
+using namespace Anki::Vector;
+
+extern CozmoContext* cozmoContext;
+
+namespace {
+
+const char* const kDatasetFolder = "test/visionBenchmark";
+const char* const kSchedulesFile = "schedules.json";
+const char* const kReportFile    = "visionSystemBenchmark/report.json";
+
+// Frames are stamped at the camera's frame rate
+const TimeStamp_t kFramePeriod_ms = 65;
+
+// Frames run before measuring, so that pools and scratch memory have grown to the sequence's needs
+const size_t kNumWarmUpFrames = 1;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Hardware counters of the calling thread. Work done on the mode worker threads is not counted, which is why anything
+// measured with counters is run with no worker threads.
+class PerfCounters
+{
+public:
+
+  enum Counter : size_t {
+    Instructions,
+    CacheReferences,
+    CacheMisses,
+    NumCounters
+  };
+
+  using Values = std::array<u64, NumCounters>;
+
+  PerfCounters()
+  {
+    _fds.fill(-1);
+#if defined(__linux__)
+    const std::array<u64, NumCounters> kConfigs{{
+      PERF_COUNT_HW_INSTRUCTIONS,
+      PERF_COUNT_HW_CACHE_REFERENCES,
+      PERF_COUNT_HW_CACHE_MISSES,
+    }};
+    _isAvailable = true;
+    for (size_t i = 0; i < NumCounters; ++i) {
+      perf_event_attr attr;
+      memset(&attr, 0, sizeof(attr));
+      attr.type           = PERF_TYPE_HARDWARE;
+      attr.size           = sizeof(attr);
+      attr.config         = kConfigs[i];
+      attr.exclude_kernel = 1;
+      attr.exclude_hv     = 1;
+      _fds[i] = (int) syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+      _isAvailable &= (_fds[i] >= 0);
+    }
+#endif
+  }
+
+  ~PerfCounters()
+  {
+#if defined(__linux__)
+    for (int fd : _fds) {
+      if (fd >= 0) { close(fd); }
+    }
+#endif
+  }
+
+  // Not available off Linux, or where the kernel doesn't allow user space to read them (see perf_event_paranoid)
+  bool IsAvailable() const { return _isAvailable; }
+
+  // Counts since the counters were opened
+  Values Read() const
+  {
+    Values values{};
+#if defined(__linux__)
+    for (size_t i = 0; i < NumCounters && _isAvailable; ++i) {
+      u64 value = 0;
+      if (read(_fds[i], &value, sizeof(value)) == sizeof(value)) {
+        values[i] = value;
+      }
+    }
+#endif
+    return values;
+  }
+
+  static const char* GetName(size_t counter)
+  {
+    switch (counter) {
+      case Instructions:    return "instructions";
+      case CacheReferences: return "cacheReferences";
+      case CacheMisses:     return "cacheMisses";
+      default:              return "unknown";
+    }
+  }
+
+private:
+  std::array<int, NumCounters> _fds;
+  bool _isAvailable = false;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct Sequence {
+  std::string                  name;
+  Vision::ImageEncoding        format = Vision::ImageEncoding::NoneImageEncoding;
+  s32                          numRows = 0;
+  s32                          numCols = 0;
+  std::vector<std::vector<u8>> frames;
+};
+
+struct FrameStats {
+  float                     time_ms = 0.f;
+  AllocationCounter::Counts allocations;
+  PerfCounters::Values      counters{};
+};
+
+struct RunStats {
+  std::vector<FrameStats> frames;
+  size_t                  numFailedFrames = 0;
+  bool                    hasCounters = false;
+};
+
+// Which modes to process for the given frame index
+using ModeSelector = std::function<VisionModeSet(size_t)>;
+
+float Percentile(std::vector<float> values, float p)
+{
+  if (values.empty()) { return 0.f; }
+  std::sort(values.begin(), values.end());
+  const size_t idx = std::min(values.size() - 1, (size_t) std::round(p * (values.size() - 1)));
+  return values[idx];
+}
+
+bool LoadSequence(const std::string& folder, const std::string& name, Sequence& sequence)
+{
+  sequence.name = name;
+
+  std::vector<std::string> rawFiles = Util::FileUtils::FilesInDirectory(folder, true, ".raw");
+  std::vector<std::string> rgbFiles = Util::FileUtils::FilesInDirectory(folder, true,
+                                                                        std::vector<const char*>{".jpg", ".png"});
+  if (!rawFiles.empty() && !rgbFiles.empty()) {
+    printf("Skipping %s, it mixes RAW10 and RGB frames\n", name.c_str());
+    return false;
+  }
+
+  if (!rawFiles.empty()) {
+    // RAW10 packs 4 pixels into 5 bytes
+    sequence.format  = Vision::ImageEncoding::BAYER;
+    sequence.numRows = CAMERA_SENSOR_RESOLUTION_HEIGHT;
+    sequence.numCols = CAMERA_SENSOR_RESOLUTION_WIDTH;
+    const size_t expectedSize = (size_t) sequence.numRows * sequence.numCols * 5 / 4;
+
+    std::sort(rawFiles.begin(), rawFiles.end());
+    for (const auto& file : rawFiles) {
+      std::vector<u8> data = Util::FileUtils::ReadFileAsBinary(file);
+      if (data.size() != expectedSize) {
+        printf("Skipping %s, expected %zu bytes of RAW10 data, got %zu\n", file.c_str(), expectedSize, data.size());
+        continue;
+      }
+      sequence.frames.push_back(std::move(data));
+    }
+  } else {
+    sequence.format = Vision::ImageEncoding::RawRGB;
+
+    std::sort(rgbFiles.begin(), rgbFiles.end());
+    for (const auto& file : rgbFiles) {
+      Vision::ImageRGB frame;
+      if (frame.Load(file) != RESULT_OK) {
+        printf("Skipping %s, could not be loaded\n", file.c_str());
+        continue;
+      }
+      if (sequence.frames.empty()) {
+        sequence.numRows = frame.GetNumRows();
+        sequence.numCols = frame.GetNumCols();
+      } else if (frame.GetNumRows() != sequence.numRows || frame.GetNumCols() != sequence.numCols) {
+        printf("Skipping %s, frames must all be %dx%d\n", file.c_str(), sequence.numCols, sequence.numRows);
+        continue;
+      }
+      const u8* data = reinterpret_cast<const u8*>(frame.GetDataPointer());
+      sequence.frames.emplace_back(data, data + frame.GetNumElements() * 3);
+    }
+  }
+
+  return !sequence.frames.empty();
+}
+
+// Reads the schedules file, if there is one. Modes it doesn't mention never run.
+bool LoadSchedules(const Util::Data::DataPlatform& platform,
+                   std::vector<std::pair<std::string, AllVisionModesSchedule>>& schedules)
+{
+  const std::string file = Util::FileUtils::FullFilePath({kDatasetFolder, kSchedulesFile});
+  Json::Value json;
+  if (!Util::FileUtils::FileExists(platform.pathToResource(Util::Data::Scope::Resources, file)) ||
+      !platform.readAsJson(Util::Data::Scope::Resources, file, json)) {
+    return false;
+  }
+
+  for (const auto& scheduleName : json.getMemberNames()) {
+    const Json::Value& jsonSchedule = json[scheduleName];
+    AllVisionModesSchedule schedule(false);
+    bool isValid = true;
+    for (const auto& modeName : jsonSchedule.getMemberNames()) {
+      VisionMode mode;
+      if (!VisionModeFromString(modeName, mode) ||
+          (RESULT_OK != schedule.GetScheduleForMode(mode).SetFromJSON(jsonSchedule[modeName]))) {
+        printf("Skipping schedule %s, bad entry for %s\n", scheduleName.c_str(), modeName.c_str());
+        isValid = false;
+        break;
+      }
+    }
+    if (isValid) {
+      schedules.emplace_back(scheduleName, std::move(schedule));
+    }
+  }
+  return true;
+}
+
+RunStats Run(Sequence& sequence, const ModeSelector& selectModes, s32 numWorkerThreads,
+             const PerfCounters& perfCounters)
+{
+  // The worker threads are created by Init
+  Util::IConsoleVariable* threadsVar = Util::ConsoleSystem::Instance().FindVariable("kVisionModeNumWorkerThreads");
+  std::string prevNumThreads;
+  if (threadsVar != nullptr) {
+    prevNumThreads = threadsVar->ToString();
+    threadsVar->ParseText(std::to_string(numWorkerThreads).c_str());
+  }
+
+  RunStats stats;
+  stats.hasCounters = perfCounters.IsAvailable() && (numWorkerThreads == 0);
+
+  VisionSystem visionSystem(cozmoContext);
+  EXPECT_EQ(RESULT_OK, visionSystem.Init(cozmoContext->GetDataLoader()->GetRobotVisionConfig()));
+
+  // Don't need a real calibration, just one at the resolution VisionSystem processes
+  const s32 calibNumRows = DEFAULT_CAMERA_RESOLUTION_HEIGHT;
+  const s32 calibNumCols = DEFAULT_CAMERA_RESOLUTION_WIDTH;
+  auto calib = std::make_shared<Vision::CameraCalibration>(calibNumRows, calibNumCols, 290.f, 290.f,
+                                                           0.5f*calibNumCols, 0.5f*calibNumRows, 0.f);
+  EXPECT_EQ(RESULT_OK, visionSystem.UpdateCameraCalibration(calib));
+
+  VisionPoseData poseData; // robot held still
+  poseData.cameraPose.SetParent(poseData.histState.GetPose());
+
+  const size_t numWarmUpFrames = (sequence.frames.size() > kNumWarmUpFrames ? kNumWarmUpFrames : 0);
+  for (size_t index = 0; index < sequence.frames.size(); ++index) {
+    const TimeStamp_t timestamp = (TimeStamp_t) (index + 1) * kFramePeriod_ms;
+
+    VisionSystemInput input;
+    input.imageBuffer = Vision::ImageBuffer(sequence.frames[index].data(), sequence.numRows, sequence.numCols,
+                                            sequence.format, timestamp, (s32) index + 1);
+    input.imageBuffer.SetSensorResolution(CAMERA_SENSOR_RESOLUTION_HEIGHT, CAMERA_SENSOR_RESOLUTION_WIDTH);
+    input.modesToProcess = selectModes(index);
+    input.poseData = poseData;
+    input.poseData.timeStamp = timestamp;
+
+    FrameStats frameStats;
+    const PerfCounters::Values countersBefore = perfCounters.Read();
+    AllocationCounter::Start();
+    const auto startTime = std::chrono::steady_clock::now();
+    const Result result = visionSystem.Update(input);
+    const auto endTime = std::chrono::steady_clock::now();
+    frameStats.allocations = AllocationCounter::Stop();
+    const PerfCounters::Values countersAfter = perfCounters.Read();
+
+    frameStats.time_ms = std::chrono::duration<float, std::milli>(endTime - startTime).count();
+    for (size_t i = 0; i < PerfCounters::NumCounters; ++i) {
+      frameStats.counters[i] = countersAfter[i] - countersBefore[i];
+    }
+
+    // Keep the result queue from growing
+    VisionProcessingResult processingResult;
+    while (visionSystem.CheckMailbox(processingResult)) { }
+
+    if (index < numWarmUpFrames) {
+      continue;
+    }
+    if (result != RESULT_OK) {
+      ++stats.numFailedFrames;
+    }
+    stats.frames.push_back(frameStats);
+  }
+
+  if (threadsVar != nullptr) {
+    threadsVar->ParseText(prevNumThreads.c_str());
+  }
+  return stats;
+}
+
+Json::Value ReportRun(const std::string& name, const RunStats& stats)
+{
+  std::vector<float> times_ms;
+  double sumTime_ms = 0.;
+  double sumAllocations = 0., sumBytes = 0.;
+  std::array<double, PerfCounters::NumCounters> sumCounters{};
+  for (const auto& frame : stats.frames) {
+    times_ms.push_back(frame.time_ms);
+    sumTime_ms     += frame.time_ms;
+    sumAllocations += frame.allocations.numAllocations;
+    sumBytes       += frame.allocations.numBytes;
+    for (size_t i = 0; i < PerfCounters::NumCounters; ++i) {
+      sumCounters[i] += frame.counters[i];
+    }
+  }
+  const double numFrames = std::max<size_t>(1, stats.frames.size());
+
+  Json::Value json;
+  json["numFrames"]       = (Json::UInt) stats.frames.size();
+  json["numFailedFrames"] = (Json::UInt) stats.numFailedFrames;
+  json["mean_ms"]         = sumTime_ms / numFrames;
+  json["p50_ms"]          = Percentile(times_ms, .5f);
+  json["p90_ms"]          = Percentile(times_ms, .9f);
+  json["p99_ms"]          = Percentile(times_ms, .99f);
+  json["max_ms"]          = Percentile(times_ms, 1.f);
+  json["allocationsPerFrame"]    = sumAllocations / numFrames;
+  json["allocatedBytesPerFrame"] = sumBytes / numFrames;
+  if (stats.hasCounters) {
+    for (size_t i = 0; i < PerfCounters::NumCounters; ++i) {
+      json[std::string(PerfCounters::GetName(i)) + "PerFrame"] = sumCounters[i] / numFrames;
+    }
+  }
+
+  const double cacheMissesPerFrame = sumCounters[PerfCounters::CacheMisses] / numFrames;
+  printf("%-32s %8.2f %8.2f %8.2f %10.1f %12.0f %6zu\n", name.c_str(),
+         json["p50_ms"].asFloat(), json["p90_ms"].asFloat(), json["max_ms"].asFloat(),
+         json["allocationsPerFrame"].asDouble(), (stats.hasCounters ? cacheMissesPerFrame : 0.),
+         stats.numFailedFrames);
+  return json;
+}
+
+void PrintHeader(const char* title)
+{
+  printf("%-32s %8s %8s %8s %10s %12s %6s\n", title, "p50 ms", "p90 ms", "max ms", "allocs", "cache miss", "failed");
+}
+
+} // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(VisionSystemBenchmark, DISABLED_RecordedSequences)
+{
+  const auto* platform = cozmoContext->GetDataPlatform();
+  ASSERT_TRUE(platform != nullptr);
+  const std::string datasetFolder = platform->pathToResource(Util::Data::Scope::Resources, kDatasetFolder);
+
+  std::vector<std::string> sequenceNames;
+  Util::FileUtils::ListAllDirectories(datasetFolder, sequenceNames);
+  std::sort(sequenceNames.begin(), sequenceNames.end());
+
+  std::vector<Sequence> sequences;
+  for (const auto& name : sequenceNames) {
+    Sequence sequence;
+    if (LoadSequence(Util::FileUtils::FullFilePath({datasetFolder, name}), name, sequence)) {
+      sequences.push_back(std::move(sequence));
+    }
+  }
+  if (sequences.empty()) {
+    printf("No recorded sequences in %s, nothing to benchmark\n", datasetFolder.c_str());
+    return;
+  }
+
+  std::vector<std::pair<std::string, AllVisionModesSchedule>> schedules;
+  if (!LoadSchedules(*platform, schedules)) {
+    AllVisionModesSchedule everyFrame(false);
+    for (VisionMode mode = VisionMode(0); mode < VisionMode::Count; mode++) {
+      everyFrame.GetScheduleForMode(mode) = VisionModeSchedule(true);
+    }
+    schedules.emplace_back("AllModesEveryFrame", std::move(everyFrame));
+  }
+
+  const PerfCounters perfCounters;
+  if (!perfCounters.IsAvailable()) {
+    printf("Perf counters not available, only reporting time and allocations\n");
+  }
+
+  // Default number of mode worker threads, for the parallel schedule runs
+  s32 numWorkerThreads = 0;
+  Util::IConsoleVariable* threadsVar = Util::ConsoleSystem::Instance().FindVariable("kVisionModeNumWorkerThreads");
+  if (threadsVar != nullptr) {
+    numWorkerThreads = (s32) threadsVar->GetAsInt64();
+  }
+
+  Json::Value report;
+  report["perfCountersAvailable"] = perfCounters.IsAvailable();
+  report["numWorkerThreads"]      = numWorkerThreads;
+
+  for (auto& sequence : sequences) {
+    printf("\n%s: %zu %s frames of %dx%d\n", sequence.name.c_str(), sequence.frames.size(),
+           (sequence.format == Vision::ImageEncoding::BAYER ? "RAW10" : "RGB"), sequence.numCols, sequence.numRows);
+
+    Json::Value& jsonSequence = report["sequences"][sequence.name];
+    jsonSequence["format"]    = (sequence.format == Vision::ImageEncoding::BAYER ? "RAW10" : "RGB");
+    jsonSequence["numFrames"] = (Json::UInt) sequence.frames.size();
+    jsonSequence["numRows"]   = sequence.numRows;
+    jsonSequence["numCols"]   = sequence.numCols;
+
+    // Single modes run serially so that all their work is on this thread, and counted
+    PrintHeader("mode");
+    jsonSequence["noModes"] = ReportRun("(none)", Run(sequence, [](size_t) { return VisionModeSet(); },
+                                                      0, perfCounters));
+    for (VisionMode mode = VisionMode(0); mode < VisionMode::Count; mode++) {
+      const ModeSelector justThisMode = [mode](size_t) {
+        VisionModeSet modes;
+        modes.Insert(mode);
+        return modes;
+      };
+      jsonSequence["modes"][EnumToString(mode)] = ReportRun(EnumToString(mode),
+                                                            Run(sequence, justThisMode, 0, perfCounters));
+    }
+
+    PrintHeader("schedule");
+    for (const auto& schedule : schedules) {
+      const AllVisionModesSchedule& modeSchedule = schedule.second;
+      const ModeSelector scheduledModes = [&modeSchedule](size_t index) {
+        VisionModeSet modes;
+        for (VisionMode mode = VisionMode(0); mode < VisionMode::Count; mode++) {
+          if (modeSchedule.IsTimeToProcess(mode, (u32) index)) {
+            modes.Insert(mode);
+          }
+        }
+        return modes;
+      };
+
+      Json::Value& jsonSchedule = jsonSequence["schedules"][schedule.first];
+      jsonSchedule["serial"] = ReportRun(schedule.first + " (serial)",
+                                         Run(sequence, scheduledModes, 0, perfCounters));
+      if (numWorkerThreads > 0) {
+        jsonSchedule["parallel"] = ReportRun(schedule.first + " (parallel)",
+                                             Run(sequence, scheduledModes, numWorkerThreads, perfCounters));
+      }
+    }
+  }
+
+  EXPECT_TRUE( platform->writeAsJson(Util::Data::Scope::Cache, kReportFile, report) );
+}
@@ -31,6 +31,7 @@
 #include "util/global/globalDefinitions.h"
 #include "util/helpers/ankiDefines.h"
 #include "util/helpers/templateHelpers.h"
+#include "util/jsonWriter/jsonStreamWriter.h"
 #include "util/string/stringUtils.h"
 
 #include "osState/osState.h"
@@ -45,6 +46,7 @@
 #include <thread>
 #include <fstream>
 #include <iomanip>
+#include <limits>
 
 #define LOG_CHANNEL "WebService"
 
@@ -63,6 +65,7 @@ namespace {
 // http://tools.ietf.org/html/rfc6455#section-5.2
 enum {
   WebSocketsTypeText            = 0x1,
+  WebSocketsTypeBinary          = 0x2,
   WebSocketsTypeCloseConnection = 0x8
 };
 
@@ -1187,10 +1190,7 @@ void WebService::Update()
               if( (idx < _webSocketConnections.size())
                  && (_webSocketConnections[idx].subscribedModules.count( moduleName ) > 0) )
               {
-                Json::Value payload;
-                payload["module"] = moduleName;
-                payload["data"] = toSend;
-                SendToWebSocket( _webSocketConnections[idx].conn, payload );
+                SendToWebSocket( _webSocketConnections[idx].conn, MakeWebVizPayload( moduleName, toSend ) );
               }
             };
 
@@ -1477,32 +1477,109 @@ void WebService::GenerateConsoleVarsUI(std::string& page, const std::string& cat
 
 void WebService::SendToWebSockets(const std::string& moduleName, const Json::Value& data) const
 {
+  if( _numWebVizSubscriptions == 0 ) {
+    return;
+  }
+
   std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
-  Json::Value payload;
-  bool hasAssigned = false; // don't copy payload unless there is >= 1 client for this module
+  std::shared_ptr<const std::string> payload; // serialized once, and only if there is >= 1 client for this module
   for( const auto& connData : _webSocketConnections ) {
     if( connData.subscribedModules.find( moduleName ) != connData.subscribedModules.end() ) {
-      if( !hasAssigned ) {
-        payload["module"] = moduleName;
-        payload["data"] = data;
-        hasAssigned = true;
+      if( payload == nullptr ) {
+        payload = MakeWebVizPayload(moduleName, data);
       }
       SendToWebSocket(connData.conn, payload);
     }
   }
 }
 
-bool WebService::IsWebVizClientSubscribed(const std::string& moduleName) const
+void WebService::SendBinaryToWebViz(const std::string& moduleName, const std::vector<uint8_t>& data) const
 {
+  if( _numWebVizSubscriptions == 0 ) {
+    return;
+  }
+
+  DEV_ASSERT(moduleName.size() <= std::numeric_limits<uint8_t>::max(), "WebService.SendBinaryToWebViz.ModuleNameTooLong");
+
   std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
+  std::shared_ptr<const std::string> payload; // built once, and only if there is >= 1 client for this module
   for( const auto& connData : _webSocketConnections ) {
-    if( (connData.subscribedModules.find( moduleName ) != connData.subscribedModules.end())
-        || (moduleName.empty() && !connData.subscribedModules.empty()) ) // any module subscribed
-    {
-      return true;
+    if( connData.subscribedModules.find( moduleName ) != connData.subscribedModules.end() ) {
+      if( payload == nullptr ) {
+        auto frame = std::make_shared<std::string>();
+        frame->reserve(1 + moduleName.size() + data.size());
+        frame->push_back( static_cast<char>(moduleName.size()) );
+        frame->append( moduleName );
+        frame->append( reinterpret_cast<const char*>(data.data()), data.size() );
+        payload = std::move(frame);
+      }
+      SendToWebSocket(connData.conn, payload, true);
     }
   }
-  return false;
+}
+
+bool WebService::IsWebVizClientSubscribed(const std::string& moduleName) const
+{
+  if( _numWebVizSubscriptions == 0 ) {
+    return false;
+  }
+  if( moduleName.empty() ) { // any module subscribed
+    return true;
+  }
+
+  std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
+  return _webVizSubscriberCounts.find( moduleName ) != _webVizSubscriberCounts.end();
+}
+
+void WebService::SetWebVizMaxRate(const std::string& moduleName, float maxRate_hz)
+{
+  std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
+  if( maxRate_hz > 0.0f ) {
+    const std::chrono::duration<float> minPeriod_s( 1.0f / maxRate_hz );
+    _webVizRateCaps[moduleName].minPeriod = std::chrono::duration_cast<std::chrono::steady_clock::duration>(minPeriod_s);
+  } else {
+    _webVizRateCaps.erase( moduleName );
+  }
+}
+
+bool WebService::ShouldSendToWebViz(const std::string& moduleName)
+{
+  if( _numWebVizSubscriptions == 0 ) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(s_wsConnectionsMutex);
+  if( _webVizSubscriberCounts.find( moduleName ) == _webVizSubscriberCounts.end() ) {
+    return false;
+  }
+
+  auto capIt = _webVizRateCaps.find( moduleName );
+  if( capIt != _webVizRateCaps.end() ) {
+    const auto now = std::chrono::steady_clock::now();
+    auto& cap = capIt->second;
+    if( now - cap.lastSendTime < cap.minPeriod ) {
+      return false;
+    }
+    cap.lastSendTime = now;
+  }
+  return true;
+}
+
+void WebService::AddWebVizSubscriber(const std::string& moduleName)
+{
+  ++_webVizSubscriberCounts[moduleName];
+  ++_numWebVizSubscriptions;
+}
+
+void WebService::RemoveWebVizSubscriber(const std::string& moduleName)
+{
+  auto it = _webVizSubscriberCounts.find( moduleName );
+  if( it != _webVizSubscriberCounts.end() ) {
+    if( --it->second <= 0 ) {
+      _webVizSubscriberCounts.erase( it );
+    }
+    --_numWebVizSubscriptions;
+  }
 }
 
 int WebService::HandleWebSocketsConnect(const struct mg_connection* conn, void* cbparams)
@@ -1571,16 +1648,34 @@ void WebService::HandleWebSocketsClose(const struct mg_connection* conn, void* c
 // This is always called in the main thread (whether we're sending or receiving)
 void WebService::SendToWebSocket(struct mg_connection* conn, const Json::Value& data) const
 {
-  // Dispatch work onto another thread (note we copy 'data' by value here)
-  Util::Dispatch::Async(_dispatchQueue, [conn, data] {
-    std::stringstream ss;
-    ss << data;
-    const std::string& str = ss.str();
+  auto text = std::make_shared<std::string>();
+  Util::JsonStreamWriter::Write(data, *text);
+  SendToWebSocket(conn, std::shared_ptr<const std::string>(std::move(text)));
+}
 
-    mg_websocket_write(conn, WebSocketsTypeText, str.c_str(), str.size());
+void WebService::SendToWebSocket(struct mg_connection* conn, const std::shared_ptr<const std::string>& text,
+                                 bool isBinary) const
+{
+  // Dispatch the write onto another thread. The text is shared by every connection it's sent to.
+  const int opcode = isBinary ? WebSocketsTypeBinary : WebSocketsTypeText;
+  Util::Dispatch::Async(_dispatchQueue, [conn, text, opcode] {
+    mg_websocket_write(conn, opcode, text->c_str(), text->size());
   });
 }
 
+std::shared_ptr<const std::string> WebService::MakeWebVizPayload(const std::string& moduleName, const Json::Value& data)
+{
+  auto text = std::make_shared<std::string>();
+  Util::JsonStreamWriter writer(*text);
+  writer.StartObject();
+  writer.Key("module");
+  writer.String(moduleName);
+  writer.Key("data");
+  writer.Value(data);
+  writer.EndObject();
+  return text;
+}
+
 
 const std::string& WebService::getConsoleVarsTemplate()
 {
@@ -1611,7 +1706,9 @@ void WebService::OnReceiveWebSocket(struct mg_connection* conn, const Json::Valu
       const size_t idx = it - _webSocketConnections.begin();
 
       if( data["type"].asString() == "subscribe" ) {
-        it->subscribedModules.insert( moduleName );
+        if( it->subscribedModules.insert( moduleName ).second ) {
+          AddWebVizSubscriber( moduleName );
+        }
 
         const bool waitAndSendResponse = false;
         ProcessRequest(conn,
@@ -1622,7 +1719,9 @@ void WebService::OnReceiveWebSocket(struct mg_connection* conn, const Json::Valu
                        waitAndSendResponse);
       }
       else if( data["type"].asString() == "unsubscribe" ) {
-        it->subscribedModules.erase( moduleName );
+        if( it->subscribedModules.erase( moduleName ) > 0 ) {
+          RemoveWebVizSubscriber( moduleName );
+        }
       }
       else if( (data["type"].asString() == "data") && !data["data"].isNull() ) {
         const bool waitAndSendResponse = false;
@@ -1656,6 +1755,14 @@ void WebService::OnCloseWebSocket(const struct mg_connection* conn)
     return perConnData.conn == conn;
   });
 
+  if( it == _webSocketConnections.end() ) {
+    return;
+  }
+
+  for( const auto& moduleName : it->subscribedModules ) {
+    RemoveWebVizSubscriber( moduleName );
+  }
+
   // erase it
   auto& data = *it;
   std::swap(data, _webSocketConnections.back());
@@ -1696,11 +1803,24 @@ namespace WebService {
   {
   }
 
+  void WebService::SendBinaryToWebViz(const std::string& /*moduleName*/, const std::vector<uint8_t>& /*data*/) const
+  {
+  }
+
   bool WebService::IsWebVizClientSubscribed(const std::string& /*moduleName*/) const
   {
     return false;
   }
 
+  void WebService::SetWebVizMaxRate(const std::string& /*moduleName*/, float /*maxRate_hz*/)
+  {
+  }
+
+  bool WebService::ShouldSendToWebViz(const std::string& /*moduleName*/)
+  {
+    return false;
+  }
+
   void WebService::RegisterRequestHandler(std::string /*uri*/, mg_request_handler /*handler*/, void* /*cbdata*/)
   {
   }
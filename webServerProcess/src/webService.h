@@ -17,6 +17,9 @@
 
 #include "json/json.h"
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <string>
 #include <vector>
 #include <mutex>
@@ -65,9 +68,21 @@ public:
   
   inline void SendToWebViz(const std::string& moduleName, const Json::Value& data) const { SendToWebSockets(moduleName, data); }
   
-  // returns true if a client has subscribed to a given module name (or any module if empty)
+  // send data to any client subscribed to moduleName as a single binary frame, for bulk data that would be
+  // much larger as json. The frame is the length of moduleName (one byte), moduleName, then data
+  void SendBinaryToWebViz(const std::string& moduleName, const std::vector<uint8_t>& data) const;
+  
+  // returns true if a client has subscribed to a given module name (or any module if empty). Cheap enough to
+  // call every tick, and free when no client is subscribed to anything
   bool IsWebVizClientSubscribed(const std::string& moduleName = {}) const;
   
+  // caps how often ShouldSendToWebViz lets moduleName send. A rate of 0 removes the cap
+  void SetWebVizMaxRate(const std::string& moduleName, float maxRate_hz);
+  
+  // returns true if a client has subscribed to moduleName and sending now stays within its rate cap (if any).
+  // A true result counts as a send, so call this right before building the data, not just to peek
+  bool ShouldSendToWebViz(const std::string& moduleName);
+  
   // subscribe to when a client connects and notifies the webservice that they want data for moduleName
   using SendToClientFunc = std::function<void(const Json::Value&)>;
   using OnWebVizSubscribedType = Signal::Signal<void(const SendToClientFunc&)>;
@@ -163,6 +178,16 @@ private:
   void OnCloseWebSocket(const struct mg_connection* conn);
 
   void SendToWebSocket(struct mg_connection* conn, const Json::Value& data) const;
+  void SendToWebSocket(struct mg_connection* conn, const std::shared_ptr<const std::string>& text,
+                       bool isBinary = false) const;
+
+  // must be called with s_wsConnectionsMutex held
+  void AddWebVizSubscriber(const std::string& moduleName);
+  void RemoveWebVizSubscriber(const std::string& moduleName);
+
+  // Serializes the {"module", "data"} envelope webViz clients expect straight from data, without copying it into
+  // an envelope Json::Value first. The result can be sent to any number of connections.
+  static std::shared_ptr<const std::string> MakeWebVizPayload(const std::string& moduleName, const Json::Value& data);
 
   // todo: OTA update somehow?
 
@@ -171,6 +196,18 @@ private:
   std::vector<WebSocketConnectionData> _webSocketConnections;
   mutable std::mutex s_wsConnectionsMutex;
 
+  // number of connections subscribed to each module, and the total over all modules (readable without the
+  // mutex, so the common case of nobody watching costs nothing). Guarded by s_wsConnectionsMutex
+  std::unordered_map<std::string, int> _webVizSubscriberCounts;
+  std::atomic<int> _numWebVizSubscriptions{0};
+
+  struct WebVizRateCap {
+    std::chrono::steady_clock::duration minPeriod{};
+    std::chrono::steady_clock::time_point lastSendTime{};
+  };
+  // guarded by s_wsConnectionsMutex
+  std::unordered_map<std::string, WebVizRateCap> _webVizRateCaps;
+
   std::string _consoleVarsUIHTMLTemplate;
 
   std::vector<Request*> _requests;